@@ -51,7 +51,10 @@ private:
 // 1: start from doris 1.2
 //    a. remove ColumnString terminating zero.
 //    b. runtime filter use new hash method.
-inline const int BeExecVersionManager::max_be_exec_version = 1;
+// 2: each column of PBlock is compressed separately.
+// 3: several blocks may be sent in one PTransmitDataParams.
+// 4: the strings of few distinct values are serialized as a dictionary and the codes.
+inline const int BeExecVersionManager::max_be_exec_version = 4;
 inline const int BeExecVersionManager::min_be_exec_version = 0;
 
 } // namespace doris
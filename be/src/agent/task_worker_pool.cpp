@@ -53,10 +53,13 @@
 #include "runtime/snapshot_loader.h"
 #include "service/backend_options.h"
 #include "util/doris_metrics.h"
+#include "util/hash_util.hpp"
 #include "util/random.h"
 #include "util/scoped_cleanup.h"
 #include "util/stopwatch.hpp"
+#include "util/thrift_util.h"
 #include "util/threadpool.h"
+#include "util/time.h"
 #include "util/trace.h"
 
 namespace doris {
@@ -808,7 +811,10 @@ void TaskWorkerPool::_publish_version_worker_thread_callback() {
             error_tablet_ids.clear();
             EnginePublishVersionTask engine_task(publish_version_req, &error_tablet_ids,
                                                  &succ_tablet_ids);
+            int64_t publish_start_ns = MonotonicNanos();
             status = _env->storage_engine()->execute_task(&engine_task);
+            DorisMetrics::instance()->publish_version_latency_us->add(
+                    (MonotonicNanos() - publish_start_ns) / NANOS_PER_MICRO);
             if (status.ok()) {
                 break;
             } else if (status.is<PUBLISH_VERSION_NOT_CONTINUOUS>()) {
@@ -1375,11 +1381,66 @@ void TaskWorkerPool::_report_tablet_worker_thread_callback() {
         }
         request.__isset.resource = true;
 
-        _handle_report(request, ReportType::TABLET);
+        std::unordered_map<TTabletId, uint64_t> fingerprints;
+        bool is_incremental = _diff_report_tablets(&request.tablets, &fingerprints);
+        request.__set_is_incremental_tablets(is_incremental);
+        if (_handle_report(request, ReportType::TABLET) && !is_incremental) {
+            _full_reported_tablet_fingerprints.swap(fingerprints);
+            _last_full_tablet_report_time = MonotonicSeconds();
+        }
     }
     StorageEngine::instance()->deregister_report_listener(this);
 }
 
+bool TaskWorkerPool::_diff_report_tablets(std::map<TTabletId, TTablet>* tablets,
+                                          std::unordered_map<TTabletId, uint64_t>* fingerprints) {
+    ThriftSerializer serializer(false, 1024);
+    fingerprints->reserve(tablets->size());
+    for (auto& [tablet_id, tablet] : *tablets) {
+        uint32_t len = 0;
+        uint8_t* buffer = nullptr;
+        // 0 is for a tablet failed to serialize, which is always taken as changed
+        uint64_t fingerprint = 0;
+        if (serializer.serialize(&tablet, &len, &buffer).ok()) {
+            fingerprint = HashUtil::hash64(buffer, len, 0) | 1;
+        }
+        fingerprints->emplace(tablet_id, fingerprint);
+    }
+
+    if (!config::enable_incremental_tablet_report || _last_full_tablet_report_time == 0 ||
+        MonotonicSeconds() - _last_full_tablet_report_time >=
+                config::report_full_tablet_interval_seconds) {
+        return false;
+    }
+    // the dropped tablets are only found by FE as the ones missing in a full report
+    for (auto& [tablet_id, fingerprint] : _full_reported_tablet_fingerprints) {
+        if (fingerprints->count(tablet_id) == 0) {
+            return false;
+        }
+    }
+    // the changes are since the last full report instead of the last incremental one, so a
+    // report dropped by FE, e.g. of an out of date report version, loses no changes
+    std::vector<TTabletId> changed_tablet_ids;
+    for (auto& [tablet_id, fingerprint] : *fingerprints) {
+        auto iter = _full_reported_tablet_fingerprints.find(tablet_id);
+        if (fingerprint == 0 || iter == _full_reported_tablet_fingerprints.end() ||
+            iter->second != fingerprint) {
+            changed_tablet_ids.push_back(tablet_id);
+        }
+    }
+    if (changed_tablet_ids.size() * 2 > tablets->size()) {
+        return false;
+    }
+    std::map<TTabletId, TTablet> changed_tablets;
+    for (auto tablet_id : changed_tablet_ids) {
+        changed_tablets.emplace(tablet_id, std::move((*tablets)[tablet_id]));
+    }
+    LOG(INFO) << "report " << changed_tablets.size() << " changed tablets of " << tablets->size()
+              << " tablets since the last full report";
+    tablets->swap(changed_tablets);
+    return true;
+}
+
 void TaskWorkerPool::_upload_worker_thread_callback() {
     while (_is_work) {
         TAgentTaskRequest agent_task_req;
@@ -1662,7 +1723,7 @@ Status TaskWorkerPool::_move_dir(const TTabletId tablet_id, const std::string& s
     return loader.move(src, tablet, overwrite);
 }
 
-void TaskWorkerPool::_handle_report(const TReportRequest& request, ReportType type) {
+bool TaskWorkerPool::_handle_report(const TReportRequest& request, ReportType type) {
     TMasterResult result;
     Status status = MasterServerClient::instance()->report(request, &result);
     bool is_report_success = false;
@@ -1704,6 +1765,7 @@ void TaskWorkerPool::_handle_report(const TReportRequest& request, ReportType ty
     default:
         break;
     }
+    return is_report_success;
 }
 
 void TaskWorkerPool::_random_sleep(int second) {
@@ -20,6 +20,7 @@
 #include <atomic>
 #include <deque>
 #include <memory>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -203,7 +204,14 @@ private:
 
     void _alter_tablet(const TAgentTaskRequest& alter_tablet_request, int64_t signature,
                        const TTaskType::type task_type, TFinishTaskRequest* finish_task_request);
-    void _handle_report(const TReportRequest& request, ReportType type);
+    // return whether the report is received by FE
+    bool _handle_report(const TReportRequest& request, ReportType type);
+
+    // Leave in `tablets' only the tablets changed since the last successful full tablet report,
+    // or return false if all the tablets should be reported. `fingerprints' is set to the
+    // fingerprints of all the tablets.
+    bool _diff_report_tablets(std::map<TTabletId, TTablet>* tablets,
+                              std::unordered_map<TTabletId, uint64_t>* fingerprints);
 
     Status _get_tablet_info(const TTabletId tablet_id, const TSchemaHash schema_hash,
                             int64_t signature, TTabletInfo* tablet_info);
@@ -245,6 +253,11 @@ private:
     uint32_t _worker_count;
     TaskWorkerType _task_worker_type;
 
+    // Only meaningful for REPORT_OLAP_TABLE, the fingerprints of the tablets in the last
+    // successful full tablet report, and its time in seconds
+    std::unordered_map<TTabletId, uint64_t> _full_reported_tablet_fingerprints;
+    int64_t _last_full_tablet_report_time = 0;
+
     static std::atomic_ulong _s_report_version;
 
     static std::mutex _s_task_signatures_lock;
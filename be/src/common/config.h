@@ -76,6 +76,62 @@ CONF_mInt32(hash_table_double_grow_degree, "31");
 // There are many duplicate keys, and the hash table filled bucket is far less than the hash table build bucket.
 CONF_mInt64(hash_table_pre_expanse_max_rows, "65535");
 
+// When a build block of hash join has at least so many rows, its rows are partitioned by the
+// sub tables of the hash table, and the sub tables are filled in parallel. 0 disables it.
+CONF_mInt64(hash_join_parallel_build_min_rows, "1048576");
+// The same for the hash tables of INTERSECT and EXCEPT, which are filled on the thread pool of
+// hash joins. 0 disables it.
+CONF_mInt64(set_operation_parallel_build_min_rows, "1048576");
+// number of threads to fill the sub tables of the hash tables of hash joins
+CONF_Int32(hash_join_build_thread_pool_thread_num, "16");
+// queue size of the thread pool to fill the sub tables of hash tables, the sub tables are
+// filled by the building thread itself when the queue is full
+CONF_Int32(hash_join_build_thread_pool_queue_size, "1024");
+
+// When the only build block of a hash join on a single integer key has keys in a range no wider
+// than the rows of the block times this ratio, the hash table maps each key to a bucket of its
+// own instead of hashing it. 0 disables it.
+CONF_mInt32(hash_join_direct_mapping_max_range_ratio, "2");
+
+// Whether a nested loop join on range predicates of a probe value, e.g. `a.v between b.x and b.y`,
+// joins each probe row only with the build rows whose ranges contain its value, found by an
+// interval tree of the build rows.
+CONF_mBool(enable_nested_loop_range_join, "true");
+
+// A streaming preaggregation samples the reduction (input rows / new groups) of every so many
+// rows it aggregates. When a sample is reduced less than streaming_agg_bypass_min_reduction,
+// the preaggregation passes through the next streaming_agg_bypass_reprobe_rows rows without
+// aggregating them, then takes a new sample. 0 sample rows disables it.
+CONF_mInt64(streaming_agg_bypass_sample_rows, "65536");
+CONF_mDouble(streaming_agg_bypass_min_reduction, "1.1");
+CONF_mInt64(streaming_agg_bypass_reprobe_rows, "1048576");
+
+// In the merge phase of an aggregation with group by keys, the input blocks are buffered until
+// they have so many rows, then the aggregate states of the buffered rows are merged in parallel,
+// each group by one thread. It pays off for expensive states like bitmap or hll. 0 disables it.
+CONF_mInt64(agg_parallel_merge_min_rows, "0");
+// number of threads to merge the aggregate states in parallel
+CONF_Int32(agg_merge_thread_pool_thread_num, "16");
+// queue size of the thread pool to merge the aggregate states in parallel, the states are
+// merged by the aggregating thread itself when the queue is full
+CONF_Int32(agg_merge_thread_pool_queue_size, "1024");
+
+// When spilling is enabled for the query, the analytic node spills its buffered input blocks to
+// disk after they use more memory than this, only the partition by and order by columns are
+// kept in memory to find the boundaries of the partitions and the peer groups.
+CONF_mInt64(analytic_spill_bytes_threshold, "1073741824");
+
+// Whether the memory GC asks the operators which can spill (aggregation, hash join and sort) to
+// spill to release memory when the process memory is short, before it cancels queries.
+CONF_mBool(enable_spill_revoke_memory, "true");
+// The operators which use less memory than this are not asked to spill by the memory GC, since
+// spilling them costs more than it releases.
+CONF_mInt64(spill_revocable_min_bytes, "33554432");
+
+// Sort and merge by multiple integer, date, decimal or string columns with the memcmp of the
+// normalized keys of the rows, instead of comparing column by column.
+CONF_mBool(enable_sort_normalized_key, "true");
+
 // The maximum low water mark of the system `/proc/meminfo/MemAvailable`, Unit byte, default 1.6G,
 // actual low water mark=min(1.6G, MemTotal * 10%), avoid wasting too much memory on machines
 // with large memory larger than 16G.
@@ -112,6 +168,25 @@ CONF_Int32(push_worker_count_high_priority, "3");
 CONF_Int32(publish_version_worker_count, "8");
 // the count of tablet thread to publish version
 CONF_Int32(tablet_publish_txn_max_thread, "32");
+// the count of thread to calculate the delete bitmaps of the segments of a rowset in parallel,
+// for the unique key tables with merge-on-write
+CONF_Int32(calc_delete_bitmap_max_thread, "8");
+// the count of thread to convert and encode the columns of a block in parallel when a segment is
+// written by a load or a compaction, including the writing thread. 1 or less means the columns
+// are encoded one by one.
+CONF_Int32(segment_column_encode_max_thread, "8");
+// the columns of a block are encoded in parallel only if the block has at least this count of
+// columns, and every thread takes about this count of columns
+CONF_mInt32(segment_parallel_encode_min_columns, "64");
+CONF_Validator(segment_parallel_encode_min_columns,
+               [](const int config) -> bool { return config >= 1; });
+// a segment of a merge-on-write table keeps its primary keys in memory after this count of key
+// lookups, so the later lookups skip decoding the index pages. 0 means disabled.
+CONF_mInt64(pk_memory_index_min_lookups, "4096");
+// the max bytes of the in-memory primary key index of a segment
+CONF_mInt64(pk_memory_index_max_bytes_per_segment, "67108864");
+// the max bytes of the in-memory primary key indexes of all the segments
+CONF_mInt64(pk_memory_index_total_max_bytes, "1073741824");
 // the count of thread to clear transaction task
 CONF_Int32(clear_transaction_task_worker_count, "1");
 // the count of thread to delete
@@ -142,12 +217,24 @@ CONF_mInt32(storage_refresh_storage_policy_task_interval_seconds, "5");
 CONF_mInt32(report_disk_state_interval_seconds, "60");
 // the interval time(seconds) for agent report olap table to FE
 CONF_mInt32(report_tablet_interval_seconds, "60");
+// whether to report only the tablets changed since the last full tablet report, which needs the
+// FE to support it
+CONF_mBool(enable_incremental_tablet_report, "false");
+// the interval time(seconds) for agent report all the tablets to FE when the tablet report is
+// incremental
+CONF_mInt32(report_full_tablet_interval_seconds, "3600");
 // the max download speed(KB/s)
 CONF_mInt32(max_download_speed_kbps, "50000");
 // download low speed limit(KB/s)
 CONF_mInt32(download_low_speed_limit_kbps, "50");
 // download low speed time(seconds)
 CONF_mInt32(download_low_speed_time, "300");
+// the count of the files of a clone task downloaded at the same time
+CONF_mInt32(clone_download_file_parallelism, "4");
+CONF_Validator(clone_download_file_parallelism,
+               [](const int config) -> bool { return config >= 1; });
+// the max total download speed(KB/s) of all the clone tasks, 0 for unlimited
+CONF_mInt32(clone_max_total_download_speed_kbps, "0");
 // sleep time for one second
 CONF_Int32(sleep_one_second, "1");
 
@@ -176,6 +263,15 @@ CONF_Int32(be_service_threads, "64");
 CONF_Int32(num_threads_per_core, "3");
 // if true, compresses tuple data in Serialize
 CONF_mBool(compress_rowbatches, "true");
+// Since be_exec_version 2, every column of a serialized block is compressed separately.
+// A column smaller than this is sent uncompressed.
+CONF_mInt64(block_column_compression_min_bytes, "1024");
+// A column is sent uncompressed if compression does not shrink it by at least this ratio,
+// so that the receiver does not spend time on decompressing columns such as random ints.
+CONF_mDouble(block_column_compression_min_ratio, "1.1");
+// Since be_exec_version 4, a string column of a serialized block whose values repeat many times
+// is sent as the dictionary of its values and the codes of its rows.
+CONF_mBool(enable_string_dictionary_serialization, "true");
 CONF_mBool(rowbatch_align_tuple_offset, "false");
 // interval between profile reports; in seconds
 CONF_mInt32(status_report_interval, "5");
@@ -193,6 +289,11 @@ CONF_Int32(doris_scanner_thread_pool_queue_size, "102400");
 // default thrift client connect timeout(in seconds)
 CONF_mInt32(thrift_connect_timeout_seconds, "3");
 CONF_mInt32(fetch_rpc_timeout_seconds, "20");
+// number of threads to read the rows of the segments in parallel for a fetch by row ids
+CONF_Int32(multiget_thread_pool_thread_num, "16");
+// queue size of the thread pool to read the rows by row ids, the segments are read by the rpc
+// thread itself when the queue is full
+CONF_Int32(multiget_thread_pool_queue_size, "1024");
 // default thrift client retry interval (in milliseconds)
 CONF_mInt64(thrift_client_retry_interval_ms, "1000");
 // max row count number for single scan range, used in segmentv1
@@ -201,10 +302,16 @@ CONF_mInt32(doris_scan_range_row_count, "524288");
 CONF_mInt32(doris_scan_range_max_mb, "1024");
 // max bytes number for single scan block, used in segmentv2
 CONF_mInt32(doris_scan_block_max_mb, "67108864");
+// if true, the columns only used by short circuit predicates are read after the other
+// predicates are evaluated, only for the surviving rows, most selective column first.
+CONF_mBool(enable_segment_late_predicate_materialization, "true");
 // size of scanner queue between scanner thread and compute thread
 CONF_mInt32(doris_scanner_queue_size, "1024");
 // single read execute fragment row number
 CONF_mInt32(doris_scanner_row_num, "16384");
+// if true, the number of running scanners of a scan node grows or shrinks at runtime,
+// by the fullness of the blocks queue and the memory left of the query.
+CONF_mBool(enable_adaptive_scanner_concurrency, "true");
 // single read execute fragment row bytes
 CONF_mInt32(doris_scanner_row_bytes, "10485760");
 // number of max scan keys
@@ -221,6 +328,12 @@ CONF_mInt64(column_dictionary_key_ratio_threshold, "0");
 CONF_mInt64(column_dictionary_key_size_threshold, "0");
 // memory_limitation_per_thread_for_schema_change_bytes unit bytes
 CONF_mInt64(memory_limitation_per_thread_for_schema_change_bytes, "2147483648");
+// the count of the threads to convert the historical rowsets of a tablet in a schema change,
+// each of which takes up to memory_limitation_per_thread_for_schema_change_bytes to sort
+CONF_mInt32(schema_change_convert_rowset_thread_num, "4");
+// whether a longer VARCHAR or STRING, or a wider integer of a value column, is changed by a linked
+// schema change, whose data is converted on read instead of rewritten
+CONF_mBool(enable_linked_schema_change_for_widening, "true");
 CONF_mInt64(memory_limitation_per_thread_for_storage_migration_bytes, "100000000");
 
 // the clean interval of file descriptor cache and segment cache
@@ -255,6 +368,17 @@ CONF_mInt32(trash_file_expire_time_sec, "259200");
 CONF_Int32(min_file_descriptor_number, "60000");
 CONF_Int64(index_stream_cache_capacity, "10737418240");
 CONF_String(row_cache_mem_limit, "20%");
+// Cache for the output blocks of the olap scanners of the queries with enable_scan_cache, per
+// tablet and version. 0 disables it.
+CONF_String(scan_cache_limit, "5%");
+// The output of an olap scanner larger than this is not cached
+CONF_mInt64(scan_cache_max_bytes_per_scanner, "16777216");
+// The bytes of the blocks of a scanner shared by another query which are not taken yet, the
+// follower reads by itself if exceeded
+CONF_mInt64(shared_scan_max_queued_bytes, "16777216");
+// The milliseconds a follower of a shared scan waits for the next block of the leader before it
+// reads by itself, which bounds the time a scan thread is held by a slow leader
+CONF_mInt32(shared_scan_max_wait_ms, "100");
 
 // Cache for storage page size
 CONF_String(storage_page_cache_limit, "20%");
@@ -266,10 +390,42 @@ CONF_Int32(storage_page_cache_shard_size, "16");
 CONF_Int32(index_page_cache_percentage, "10");
 // whether to disable page cache feature in storage
 CONF_Bool(disable_storage_page_cache, "false");
+// percentage of the page cache kept for the pages which are hit after inserted, the pages
+// read only once (e.g. by large scans) are evicted first. 0 means plain LRU.
+CONF_Int32(storage_page_cache_protected_percentage, "80");
+// whether the page caches, segment cache and row cache evict by CLOCK instead of LRU, then
+// cache hits only take shared locks, which helps the high QPS point queries on hot segments.
+// storage_page_cache_protected_percentage is ignored if it is enabled.
+CONF_Bool(enable_cache_clock_eviction, "false");
+// whether local segment files are mapped into memory, then the data pages which are neither
+// compressed nor pre-decoded are read without copy and are not inserted into page cache.
+// Every open segment takes a memory mapping, check vm.max_map_count before enabling it.
+CONF_Bool(enable_segment_mmap_read, "false");
+// whether the pages read by load jobs are inserted into page cache
+CONF_mBool(enable_page_cache_fill_for_load, "false");
+// memory limit of the compressed page cache, which keeps data pages in their compressed form
+// below the page cache, so the evicted pages can be decompressed again without IO.
+// 0 disables it.
+CONF_String(storage_compressed_page_cache_limit, "0");
 // whether to disable row cache feature in storage
 CONF_Bool(disable_storage_row_cache, "true");
+// number of data pages a column iterator prefetches ahead of the current page into page
+// cache, when the segment is on remote storage (S3/HDFS). 0 disables the prefetching.
+CONF_mInt32(remote_page_prefetch_depth, "4");
+// number of threads to prefetch data pages of remote segments
+CONF_Int32(remote_page_prefetch_thread_pool_thread_num, "32");
+// queue size of the thread pool to prefetch data pages of remote segments
+CONF_Int32(remote_page_prefetch_thread_pool_queue_size, "102400");
+// data pages of the columns in a segment which are at most this many bytes apart are
+// loaded into page cache by one read. -1 disables the merging.
+CONF_mInt32(segment_page_read_merge_gap_bytes, "16384");
+// max bytes of one merged read of data pages
+CONF_mInt32(segment_page_read_merge_max_bytes, "8388608");
 
 CONF_Bool(enable_low_cardinality_optimize, "true");
+// whether only the offsets of the array and map columns are read by the scans that only take
+// their sizes, e.g. size(arr), with the elements filled by the default values
+CONF_mBool(enable_offsets_only_nested_read, "true");
 
 // be policy
 // whether check compaction checksum
@@ -286,6 +442,11 @@ CONF_mInt32(vertical_compaction_num_columns_per_group, "5");
 CONF_Int32(vertical_compaction_max_row_source_memory_mb, "200");
 // In vertical compaction, max dest segment file size
 CONF_mInt64(vertical_compaction_max_segment_size, "268435456");
+// In vertical base compaction, max number of the value column groups merged in parallel by
+// a compaction task after the key group, 1 means the groups are merged one by one
+CONF_mInt32(vertical_compaction_max_parallel_groups, "4");
+// Number of threads merging the value column groups of vertical base compactions
+CONF_Int32(vertical_compaction_group_thread_num, "8");
 
 // In ordered data compaction, min segment size for input rowset
 CONF_mInt32(ordered_data_compaction_min_segment_size, "10485760");
@@ -321,15 +482,57 @@ CONF_mInt64(compaction_min_size_mbytes, "64");
 CONF_mInt64(cumulative_compaction_min_deltas, "5");
 CONF_mInt64(cumulative_compaction_max_deltas, "100");
 
+// cumulative compaction policy, size_based or time_series. time_series is for the append only
+// tables partitioned by time: a rowset is compacted at most once by cumulative compaction, the
+// output is given to base directly and no base compaction is done.
+CONF_mString(cumulative_compaction_policy, "size_based");
+// In time_series policy, the cumulative rowsets are compacted once their total disk size reaches
+// this goal, and the rowsets larger than it are not compacted. The unit is m byte.
+CONF_mInt64(time_series_compaction_goal_size_mbytes, "1024");
+// In time_series policy, the cumulative rowsets are compacted once their number reaches this
+// threshold, even if their total size does not reach the goal.
+CONF_mInt64(time_series_compaction_file_count_threshold, "2000");
+// In time_series policy, the cumulative rowsets are compacted once the oldest of them is created
+// longer than this threshold, even if their total size does not reach the goal.
+CONF_mInt64(time_series_compaction_time_threshold_seconds, "3600");
+
 // This config can be set to limit thread number in  segcompaction thread pool.
 CONF_mInt32(seg_compaction_max_threads, "10");
 
 // This config can be set to limit thread number in  multiget thread pool.
 CONF_mInt32(multi_get_max_threads, "10");
+// The keys of a point query are looked up in parallel by the multiget thread pool if they are
+// more than this count, and this count of keys are looked up by each task.
+CONF_mInt32(point_query_lookup_batch_size, "64");
 
 // The upper limit of "permits" held by all compaction tasks. This config can be set to limit memory consumption for compaction.
 CONF_mInt64(total_permits_for_compaction_score, "10000");
 
+// The bytes read and written by the compaction tasks started on a disk per second, 0 means
+// unlimited. When it's set, the tablets are also picked by the benefit of the compaction over
+// its estimated bytes, instead of the compaction score only.
+CONF_mInt64(compaction_io_budget_mb_per_sec_per_disk, "0");
+// The budget shrinks linearly while the queries scan more bytes per second. It's down to
+// compaction_io_budget_min_ratio of it when the queries scan
+// compaction_io_budget_full_query_load_mb_per_sec.
+CONF_mDouble(compaction_io_budget_min_ratio, "0.2");
+CONF_mInt64(compaction_io_budget_full_query_load_mb_per_sec, "1024");
+
+// The disk reads and writes of the local files running at the same time on a data dir, 0 means
+// unlimited. The waiting ones are started by the classes of their tasks: the queries, the loads,
+// the compactions, then the schema changes and the clones.
+CONF_mInt32(local_io_max_concurrency_per_dir, "0");
+// The bytes read and written by the compactions, and by the schema changes and the clones, on a
+// data dir per second, 0 means unlimited.
+CONF_mInt64(local_io_compaction_mb_per_sec_per_dir, "0");
+CONF_mInt64(local_io_migration_mb_per_sec_per_dir, "0");
+// Whether the batches of the reads of the local files, e.g. the merged reads of the data pages
+// planned for a block, are issued together by io_uring, falling back to reading them one by one
+// if it's not supported by the kernel.
+CONF_mBool(enable_io_uring, "false");
+// the number of the entries of the io_uring of each thread
+CONF_Int32(io_uring_queue_depth, "64");
+
 // sleep interval in ms after generated compaction tasks
 CONF_mInt32(generate_compaction_tasks_interval_ms, "10");
 
@@ -401,6 +604,17 @@ CONF_mInt64(streaming_load_max_mb, "10240");
 // Therefore, it is necessary to limit the maximum number of
 // such data when using stream load to prevent excessive memory consumption.
 CONF_mInt64(streaming_load_json_max_mb, "100");
+// The max number of scanners that parse the body of a single stream load in parallel,
+// when the load sets the "parse_parallelism" header.
+CONF_mInt32(stream_load_max_parse_parallelism, "8");
+// The max number of the free 128KB chunks kept to receive the bodies of the stream loads,
+// the chunks are reused instead of allocated for each piece of the body.
+CONF_Int32(stream_load_max_pooled_chunks, "256");
+// The stream loads which set the "group_commit" header, and load to the same table with the
+// same properties, are merged into one load. It's committed after it's open for
+// group_commit_interval_ms, or it receives group_commit_max_bytes.
+CONF_mInt32(group_commit_interval_ms, "1000");
+CONF_mInt64(group_commit_max_bytes, "67108864");
 // the alive time of a TabletsChannel.
 // If the channel does not receive any data till this time,
 // the channel will be removed.
@@ -410,6 +624,13 @@ CONF_mInt32(streaming_load_rpc_max_alive_time_sec, "1200");
 CONF_Int32(tablet_writer_open_rpc_timeout_sec, "60");
 // You can ignore brpc error '[E1011]The server is overcrowded' when writing data.
 CONF_mBool(tablet_writer_ignore_eovercrowded, "false");
+// The max number of add_block rpcs in flight of a node channel of OlapTableSink. A larger value
+// overlaps the network transfer of the next blocks with the write of the former ones on the
+// receiver. 1 means the next rpc is sent only after the former one is responded.
+CONF_mInt32(tablet_writer_add_block_max_in_flight, "1");
+// The max time a tablet writer waits for the former packets of the same sender to be written,
+// when the packets arrive out of order. The packet is treated as lost after that.
+CONF_mInt32(tablet_writer_wait_former_packet_timeout_ms, "60000");
 CONF_mInt32(slave_replica_writer_rpc_timeout_sec, "60");
 // Whether to enable stream load record function, the default is false.
 // False: disable stream load record
@@ -431,6 +652,11 @@ CONF_mInt32(olap_table_sink_send_interval_ms, "1");
 CONF_Int32(fragment_pool_thread_num_min, "64");
 CONF_Int32(fragment_pool_thread_num_max, "512");
 CONF_Int32(fragment_pool_queue_size, "2048");
+// The instances of a pipeline fragment on this backend are prepared in parallel if there are at
+// least this many of them, since preparing dozens of instances one by one is most of the start up
+// time of a short query. 0 to disable.
+CONF_mInt32(fragment_parallel_prepare_min_instances, "4");
+CONF_Int32(fragment_prepare_thread_pool_thread_num, "32");
 
 // Control the number of disks on the machine.  If 0, this comes from the system settings.
 CONF_Int32(num_disks, "0");
@@ -459,6 +685,11 @@ CONF_Bool(disable_mem_pools, "false");
 CONF_mString(chunk_reserved_bytes_limit, "0");
 // 1024, The minimum chunk allocator size (in bytes)
 CONF_Int32(min_chunk_reserved_bytes, "1024");
+// Whether the Chunk Allocator is NUMA aware if there are more than one NUMA nodes. The chunks
+// are allocated on the local node, kept in the arenas of the node where their memory is, stolen
+// from the arenas of the same node first, and each node reserves its share of
+// chunk_reserved_bytes_limit at most.
+CONF_Bool(enable_numa_aware_chunk_allocator, "false");
 // Disable Chunk Allocator in Vectorized Allocator, this will reduce memory cache.
 // For high concurrent queries, using Chunk Allocator with vectorized Allocator can reduce the impact
 // of gperftools tcmalloc central lock.
@@ -466,6 +697,13 @@ CONF_Int32(min_chunk_reserved_bytes, "1024");
 // gperftools tcmalloc.
 CONF_mBool(disable_chunk_allocator_in_vec, "false");
 
+// Whether to keep the buffers freed by the vectorized Allocator in the query, and reuse them for
+// the later allocations of the query, instead of returning them to malloc or Chunk Allocator.
+CONF_Bool(enable_query_memory_region, "false");
+// The max bytes of the freed buffers kept by each query, the kept buffers are counted in the query
+// memory and released when the query finishes.
+CONF_mInt64(query_memory_region_max_bytes, "67108864");
+
 // The probing algorithm of partitioned hash table.
 // Enable quadratic probing hash table
 CONF_Bool(enable_quadratic_probing, "false");
@@ -474,6 +712,21 @@ CONF_Bool(enable_quadratic_probing, "false");
 CONF_String(pprof_profile_dir, "${DORIS_HOME}/log");
 // for jeprofile in jemalloc
 CONF_mString(jeprofile_dir, "${DORIS_HOME}/log");
+// The samples per CPU second of the stacks of the query threads, which are aggregated into the
+// flame graphs of the queries, see /api/query_cpu_profile. 0 means disabled.
+CONF_mInt32(query_cpu_sampling_frequency, "0");
+// The max number of the queries whose CPU samples are kept, the least recently sampled ones are
+// dropped first.
+CONF_mInt32(query_cpu_sampling_max_queries, "100");
+
+// Whether to save the params of the query fragments received by this backend into
+// fragment_capture_dir, to be replayed on a backend with the same tablets by
+// POST /api/fragment_replay.
+CONF_mBool(enable_fragment_capture, "false");
+CONF_String(fragment_capture_dir, "${DORIS_HOME}/log/fragment_capture");
+// The max number of the queries captured, the fragments of the new queries are not saved once
+// exceeded.
+CONF_mInt32(fragment_capture_max_queries, "100");
 
 // to forward compatibility, will be removed later
 CONF_mBool(enable_token_check, "true");
@@ -492,7 +745,16 @@ CONF_Int32(num_cores, "0");
 CONF_Bool(ignore_broken_disk, "false");
 
 // linux transparent huge page
+// Whether the hash tables larger than huge_page_alloc_min_bytes are backed by huge pages, see
+// HugePagePool.
 CONF_Bool(madvise_huge_pages, "false");
+// Whether to try the explicit huge pages of hugetlbfs (mmap with MAP_HUGETLB) first for the huge
+// page allocations, the transparent huge pages are used if there are not enough reserved.
+CONF_Bool(use_hugetlb_pages, "false");
+// The min bytes of the allocations backed by huge pages, at least the size of a huge page.
+CONF_Int64(huge_page_alloc_min_bytes, "4194304");
+// The max bytes of the freed huge page buffers kept for reuse.
+CONF_mInt64(huge_page_pool_max_bytes, "1073741824");
 
 // whether use mmap to allocate memory
 CONF_Bool(mmap_buffers, "false");
@@ -514,6 +776,14 @@ CONF_Int32(memory_max_alignment, "16");
 CONF_mInt64(write_buffer_size, "209715200");
 // max buffer size used in memtable for the aggregated table, default 400MB
 CONF_mInt64(write_buffer_size_for_agg, "419430400");
+// append the rows of the duplicate and unique key memtables and sort them once on flush,
+// instead of inserting every row into a skiplist
+CONF_mBool(enable_memtable_sort_on_flush, "true");
+// the max number of segments that a flushed memtable is split into and encoded concurrently,
+// 1 means the segments of a memtable are written one by one
+CONF_mInt32(memtable_flush_segment_parallelism, "4");
+// the min rows of the segments that a memtable is split into when flushed concurrently
+CONF_mInt64(memtable_flush_min_rows_per_segment, "262144");
 
 CONF_Int32(load_process_max_memory_limit_percent, "50"); // 50%
 
@@ -523,6 +793,18 @@ CONF_Int32(load_process_max_memory_limit_percent, "50"); // 50%
 // consumes lagest memory size before we reach the hard limit. The soft limit
 // might avoid all load jobs hang at the same time.
 CONF_Int32(load_process_soft_mem_limit_percent, "80");
+// The memtables of the load channels are flushed in the background, the largest first, once
+// the load mem consumption exceeds this percent of the soft limit, so that the load rpcs
+// rarely reach the soft limit and wait for the flushes themselves.
+CONF_mInt32(load_proactive_flush_mem_percent, "80");
+// A memtable written for more than this seconds is flushed in the background, even if the
+// load mem consumption is low, 0 means never.
+CONF_mInt32(memtable_flush_max_age_sec, "300");
+// Interval in milliseconds of the background flush of memtables.
+CONF_mInt32(load_proactive_flush_interval_ms, "200");
+// The load rpcs between the soft and the hard limit sleep up to this milliseconds, longer
+// when closer to the hard limit, while the memtables are flushed by another thread.
+CONF_mInt32(load_mem_throttle_max_sleep_ms, "100");
 
 // result buffer cancelled time (unit: second)
 CONF_mInt32(result_buffer_cancelled_interval_time, "300");
@@ -556,6 +838,9 @@ CONF_mInt32(max_memory_sink_batch_count, "20");
 // This configuration is used for the context gc thread schedule period
 // note: unit is minute, default is 5min
 CONF_mInt32(scan_context_gc_interval_min, "5");
+// The max bytes of the record batches returned by one request of /api/arrow_stream, which
+// streams the results of an external scan to the clients in Arrow IPC format
+CONF_mInt64(arrow_stream_max_bytes_per_request, "67108864");
 
 // es scroll keep-alive
 CONF_String(es_scroll_keepalive, "5m");
@@ -563,6 +848,10 @@ CONF_String(es_scroll_keepalive, "5m");
 // HTTP connection timeout for es
 CONF_mInt32(es_http_timeout_ms, "5000");
 
+// The scroll of an es shard is split into this many slices read by different scanners in
+// parallel, 1 to read a shard by one scroll.
+CONF_mInt32(es_scroll_slices_per_shard, "1");
+
 // the max client cache number per each host
 // There are variety of client cache in BE, but currently we use the
 // same cache size configuration.
@@ -593,6 +882,10 @@ CONF_Int32(high_priority_flush_thread_num_per_store, "6");
 // config for tablet meta checkpoint
 CONF_mInt32(tablet_meta_checkpoint_min_new_rowsets_num, "10");
 CONF_mInt32(tablet_meta_checkpoint_min_interval_secs, "600");
+// Whether to save the delete bitmap published into a merge-on-write tablet as a delta of the
+// tablet meta, which is merged by the next checkpoint, instead of saving the whole tablet meta.
+// Disable it and wait for the checkpoints before downgrading to a version without the deltas.
+CONF_mBool(enable_delete_bitmap_delta_meta, "true");
 CONF_Int32(generate_tablet_meta_checkpoint_tasks_interval_secs, "600");
 
 // config for default rowset type
@@ -609,6 +902,18 @@ CONF_Int64(brpc_socket_max_unwritten_bytes, "1073741824");
 // is greater than 1.8G. This is to avoid the error of Request length overflow (2G).
 CONF_mBool(transfer_large_data_by_brpc, "false");
 
+// Whether to reference the serialized block data in the brpc attachment instead of copying it
+// into the request when the pipeline exchange sends a block through "baidu_std" brpc.
+CONF_mBool(exchange_transfer_block_by_attachment_ref, "true");
+
+// The pipeline exchange coalesces the blocks queued for a destination while its last rpc is in
+// flight into one rpc, up to this number of bytes. 0 means do not coalesce.
+CONF_mInt64(exchange_sink_max_coalesce_bytes, "1048576");
+
+// The hash partitioned exchange samples one of this number of rows to detect the hot keys,
+// which are shown in the profile of the sender. 0 means do not detect.
+CONF_mInt32(exchange_hot_key_sample_interval, "64");
+
 // max number of txns for every txn_partition_map in txn manager
 // this is a self protection to avoid too many txns saving in manager
 CONF_mInt64(max_runnings_transactions_per_txn_map, "100");
@@ -628,6 +933,10 @@ CONF_Int32(txn_shard_size, "1024");
 // Whether to continue to start be when load tablet from header failed.
 CONF_Bool(ignore_load_tablet_failure, "false");
 
+// The number of threads of each data dir to load the tablets and rowsets from the meta at startup.
+CONF_Int32(load_data_dir_thread_num, "8");
+CONF_Validator(load_data_dir_thread_num, [](const int config) -> bool { return config >= 1; });
+
 // Whether to continue to start be when load tablet from header failed.
 CONF_mBool(ignore_rowset_stale_unconsistent_delete, "false");
 
@@ -652,6 +961,35 @@ CONF_String(thrift_server_type_of_fe, "THREAD_POOL");
 // disable zone map index when page row is too few
 CONF_mInt32(zone_map_row_num_threshold, "20");
 
+// if true, the integer and date columns of the default encoding are written in frame of reference
+// encoding instead when it takes less space than the default one for the first page of the column.
+// The segments written so are not readable by the BEs of older versions.
+CONF_mBool(enable_adaptive_integer_encoding, "false");
+// the objective to choose the encoding of the sampled data pages of a column by, among the
+// encodings of its type other than the dictionary one: "size" for the smallest compressed page,
+// "decode_speed" for the fastest to decode page at most a quarter larger than the smallest one.
+// Empty keeps the encoding of the column for all its pages, otherwise the pages of other encodings
+// than their column's are recorded in the page footers, which the BEs of older versions can't read.
+CONF_mString(data_page_encoding_objective, "");
+CONF_Validator(data_page_encoding_objective, [](const std::string& config) -> bool {
+    return config.empty() || config == "size" || config == "decode_speed";
+});
+// one in this many data pages of a column is trial encoded to choose the encoding of it and the
+// following pages by data_page_encoding_objective
+CONF_mInt32(data_page_encoding_sample_interval, "8");
+CONF_Validator(data_page_encoding_sample_interval,
+               [](const int config) -> bool { return config >= 1; });
+
+// if true, the string columns of the ZSTD compression are compressed with a ZSTD dictionary of
+// the column of the segment, which is trained from the first pages of the column and stored in
+// the segment footer. It helps the pages of short strings, which the BEs of older versions can't
+// decompress.
+CONF_mBool(enable_zstd_dictionary_compression, "false");
+// the bytes of the first data pages of a column to train its ZSTD dictionary from
+CONF_mInt64(zstd_dictionary_sample_bytes, "1048576");
+// the max bytes of the ZSTD dictionary of a column
+CONF_mInt32(zstd_dictionary_max_bytes, "32768");
+
 // aws sdk log level
 //    Off = 0,
 //    Fatal = 1,
@@ -676,6 +1014,11 @@ CONF_mBool(memory_debug, "false");
 // Decreasing this value will increase the frequency of consume/release.
 // Increasing this value will cause MemTracker statistics to be inaccurate.
 CONF_mInt32(mem_tracker_consume_min_size_bytes, "1048576");
+// The maximum length when TCMalloc Hook consumes/releases MemTracker. The length of a thread adapts
+// between mem_tracker_consume_min_size_bytes and this value by the spare capacity of its limiter
+// tracker, the consumption far from the limit is accumulated longer, and the limit is still
+// enforced with a bounded error.
+CONF_mInt32(mem_tracker_consume_max_size_bytes, "4194304");
 
 // The version information of the tablet will be stored in the memory
 // in an adjacency graph data structure.
@@ -691,6 +1034,13 @@ CONF_mDouble(tablet_version_graph_orphan_vertex_ratio, "0.1");
 // else we will call sync method
 CONF_mBool(runtime_filter_use_async_rpc, "true");
 
+// The bloom filter of a runtime filter whose targets are all local is sized by the number of
+// distinct build keys with this false positive rate, instead of the size planned by FE.
+// Set to 0 to always use the planned size.
+CONF_mDouble(runtime_filter_bloom_filter_fpp, "0.05");
+// The max bytes of a runtime filter bloom filter which is sized by the build side.
+CONF_mInt64(runtime_filter_max_bloom_filter_bytes, "16777216");
+
 // max send batch parallelism for OlapTableSink
 // The value set by the user for send_batch_parallelism is not allowed to exceed max_send_batch_parallelism_per_job,
 // if exceed, the value of send_batch_parallelism would be max_send_batch_parallelism_per_job
@@ -738,6 +1088,15 @@ CONF_String(kafka_broker_version_fallback, "0.10.0");
 // Change this size to 0 to fix it temporarily.
 CONF_Int32(routine_load_consumer_pool_size, "10");
 
+// The max number of the kafka messages which a routine load consumer takes at a time, the first
+// one is waited for and the rest are the ones already fetched by librdkafka. The batch is put into
+// the queue of the consumer group, and taken by the group, under one lock.
+CONF_mInt32(routine_load_kafka_consume_batch_size, "64");
+
+// The max number of scanners that parse the kafka messages of a single routine load task in
+// parallel, the messages of each partition are parsed by one of them. 1 means a single scanner.
+CONF_mInt32(routine_load_max_parse_parallelism, "1");
+
 // When the timeout of a load task is less than this threshold,
 // Doris treats it as a high priority task.
 // high priority tasks use a separate thread pool for flush and do not block rpc by memory cleanup logic.
@@ -808,8 +1167,31 @@ CONF_Int32(parquet_reader_max_buffer_size, "50");
 CONF_mInt32(parquet_header_max_size_mb, "1");
 // Max buffer size for parquet row group
 CONF_mInt32(parquet_rowgroup_max_buffer_mb, "128");
+// Whether to filter the parquet row groups by the bloom filters of the column chunks, for the IN
+// and EQ predicates
+CONF_mBool(enable_parquet_bloom_filter, "true");
+// the bloom filters of parquet column chunks larger than this are not used
+CONF_mInt32(parquet_bloom_filter_max_size_mb, "16");
+// Whether to read the column chunks of a parquet row group on remote storage by merging the
+// nearby chunks into larger requests, and fetching the requests ahead in parallel
+CONF_mBool(enable_parquet_merge_range_read, "true");
+// the ranges to read closer than this are fetched by one request
+CONF_mInt32(merge_range_read_max_gap_kb, "512");
+// max size of a request fetching the merged ranges
+CONF_mInt32(merge_range_read_max_request_mb, "8");
+// max number of requests of a reader fetching ahead at the same time
+CONF_mInt32(merge_range_read_parallelism, "4");
+// number of threads fetching the merged ranges ahead
+CONF_Int32(merge_range_read_thread_pool_thread_num, "64");
 // Max buffer size for parquet chunk column
 CONF_mInt32(parquet_column_max_buffer_mb, "8");
+// Memory limit of the cache of the parsed parquet and orc footers shared by the queries, a cache
+// entry is identified by the path, the modification time and the size of the file. 0 to disable.
+CONF_String(external_file_meta_cache_limit, "1%");
+// The file scan ranges of parquet, orc and uncompressed csv files larger than twice this are split
+// into ranges of this size on the BE, and the ranges of a scan range are taken by its scanners one
+// at a time, so a large file is read by several scanners. 0 to disable.
+CONF_mInt64(file_scan_split_size_bytes, "134217728");
 
 // OrcReader
 CONF_mInt32(orc_natural_read_size_mb, "8");
@@ -830,6 +1212,11 @@ CONF_mInt32(cold_data_compaction_interval_sec, "1800");
 CONF_mInt64(generate_cache_cleaner_task_interval_sec, "43200"); // 12 h
 CONF_Int32(concurrency_per_dir, "2");
 CONF_mInt64(cooldown_lag_time_sec, "10800");       // 3h
+// pack the segment files of a rowset into one remote object when it's cooled down, which saves
+// the requests of many small objects. The BEs of older versions can't read the packed rowsets.
+CONF_mBool(enable_pack_cooldown_segments, "false");
+// the max total upload speed(KB/s) of all the cooldown tasks, 0 for unlimited
+CONF_mInt32(cooldown_max_total_upload_speed_kbps, "0");
 CONF_mInt64(max_sub_cache_file_size, "104857600"); // 100MB
 CONF_mInt64(file_cache_alive_time_sec, "604800");  // 1 week
 // file_cache_type is used to set the type of file cache for remote files.
@@ -843,11 +1230,44 @@ CONF_Validator(file_cache_type, [](const std::string config) -> bool {
 CONF_mInt64(file_cache_max_size_per_disk, "0"); // zero for no limit
 
 CONF_Int32(s3_transfer_executor_pool_size, "2");
+// number of threads to upload the parts of the files written to S3
+CONF_Int32(s3_file_upload_thread_pool_thread_num, "32");
+// number of parts of a file written to S3 being uploaded at the same time, 1 uploads the parts
+// one by one in the writing thread
+CONF_mInt32(s3_file_writer_upload_parallelism, "4");
+// max memory of the parts being uploaded to S3 by all the writers, the writers wait for the
+// uploads when the limit is reached
+CONF_mInt64(s3_file_writer_max_buffer_mb, "512");
+// max number of retries to upload a part to S3
+CONF_mInt32(s3_file_writer_max_part_retries, "3");
+
+// The parquet and orc writers of SELECT INTO OUTFILE encode the columns of a block in parallel if
+// it has at least so many rows and more than one column. 0 disables it.
+CONF_mInt64(outfile_parallel_encode_min_rows, "1024");
+// number of threads to encode the columns of the outfiles in parallel
+CONF_Int32(outfile_encode_thread_pool_thread_num, "16");
 
 CONF_Bool(enable_time_lut, "true");
-CONF_Bool(enable_simdjson_reader, "false");
+// Parse the json load data by the simdjson ondemand api, the jsonpaths that it does not
+// support, like "$.k1[*].k2", fall back to rapidjson.
+CONF_Bool(enable_simdjson_reader, "true");
 
 CONF_mBool(enable_query_like_bloom_filter, "true");
+// the size in bytes of the per-page ngram bloom filters written for the string columns without a
+// bloom filter or an ngram bloom filter index, which prune the pages for the infix LIKE and the
+// MATCH predicates. 0 means not to write them.
+CONF_mInt32(string_column_ngram_bf_size, "0");
+CONF_Validator(string_column_ngram_bf_size,
+               [](const int config) -> bool { return config >= 0 && config <= 65535; });
+// whether the subcolumns extracted from the variant column of a dynamic table are written with
+// bloom filter indexes, so that the point predicates on the paths prune the pages as the zone
+// maps do for the range ones. The string subcolumns are written with the per-page ngram bloom
+// filters instead if string_column_ngram_bf_size is set.
+CONF_mBool(enable_dynamic_subcolumn_bloom_filter, "false");
+// the size of the grams of the per-page ngram bloom filters of the string columns
+CONF_mInt32(string_column_ngram_bf_gram_size, "3");
+CONF_Validator(string_column_ngram_bf_gram_size,
+               [](const int config) -> bool { return config >= 1 && config <= 255; });
 // number of s3 scanner thread pool size
 CONF_Int32(doris_remote_scanner_thread_pool_thread_num, "48");
 // number of s3 scanner thread pool queue size
@@ -879,6 +1299,10 @@ CONF_Int32(segcompaction_threshold_segment_num, "10");
 // The segment whose row number above the threshold will be compacted during segcompaction
 CONF_Int32(segcompaction_small_threshold, "1048576");
 
+// The max data size of the segments compacted by a segcompaction task, the others are left to the
+// next task, so that a task of the wide rows doesn't hold the thread and the memory too long.
+CONF_mInt64(segcompaction_task_max_bytes, "1073741824");
+
 CONF_String(jvm_max_heap_size, "1024M");
 
 // enable java udf and jdbc scannode
@@ -887,8 +1311,17 @@ CONF_Bool(enable_java_support, "true");
 // Set config randomly to check more issues in github workflow
 CONF_Bool(enable_fuzzy_mode, "false");
 
+// The number of the pipeline executor threads, 0 is the cpus available to the process, i.e. the
+// cpu quota of its cgroup if any, otherwise the cores.
 CONF_Int32(pipeline_executor_size, "0");
+// Bind each pipeline executor thread to the cpus of its NUMA node, only take effect
+// when there are more than one NUMA nodes.
+CONF_Bool(enable_pipeline_task_numa_affinity, "true");
 CONF_mInt16(pipeline_short_query_timeout_s, "20");
+// If true, the scanners of the pipeline queries run in the scan thread pools of their
+// task group, the number of threads of each pool is proportional to the cpu share of
+// the task group. So that the scans of one task group do not starve the others.
+CONF_Bool(enable_task_group_scan_thread_pool, "false");
 
 // Temp config. True to use optimization for bitmap_index apply predicate except leaf node of the and node.
 // Will remove after fully test.
@@ -904,6 +1337,21 @@ CONF_Validator(file_cache_max_file_segment_size,
                [](const int64_t config) -> bool { return config >= 4096; }); // 4KB
 CONF_Bool(clear_file_cache, "false");
 CONF_Bool(enable_file_cache_query_limit, "false");
+// the number of the independent caches a file cache path is split into by file key, each one
+// has its own lock, LRU queues and 1/n of the capacity of the path
+CONF_Int32(file_cache_num_shards, "8");
+CONF_Validator(file_cache_num_shards, [](const int config) -> bool { return config >= 1; });
+// whether to keep a log of the cached blocks in each file cache path, so the cache is restored
+// from the log at startup instead of scanning the cache directory
+CONF_Bool(enable_file_cache_meta_log, "true");
+// whether the data downloaded for the file cache is returned to the reader before it is written
+// into the cache, the write is done by the file cache write thread pool then
+CONF_mBool(enable_file_cache_async_write, "false");
+// number of threads to write the downloaded data into the file cache
+CONF_Int32(file_cache_write_thread_pool_thread_num, "16");
+// queue size of the thread pool to write the file cache, the data is written synchronously
+// when the queue is full, which bounds the memory of the pending writes
+CONF_Int32(file_cache_write_thread_pool_queue_size, "1024");
 
 // inverted index searcher cache
 // cache entry stay time after lookup, default 1h
@@ -917,12 +1365,24 @@ CONF_Int32(inverted_index_fd_number_limit_percent, "50"); // 50%
 
 // inverted index match bitmap cache size
 CONF_String(inverted_index_query_cache_limit, "10%");
+// Only cache the match bitmap of a query on its second miss, so that the queries run once don't
+// evict the ones repeated.
+CONF_mBool(enable_inverted_index_query_cache_admission, "true");
 
 // inverted index
 CONF_mDouble(inverted_index_ram_buffer_size, "512");
 CONF_Int32(query_bkd_inverted_index_limit_percent, "5"); // 5%
 // dict path for chinese analyzer
 CONF_String(inverted_index_dict_path, "${DORIS_HOME}/dict");
+// whether the loads skip the fulltext inverted indexes of the string columns, so the values are
+// not tokenized on the write path. The indexes are built when the rowsets are compacted, and the
+// match predicates on the segments without them are evaluated on the data.
+CONF_mBool(enable_deferred_fulltext_index_build, "false");
+// whether the inverted indexes of the numeric and the untokenized string columns are written as
+// bitmap indexes inside the segments, i.e. the roaring bitmaps of the rows of every value, which
+// are read through the page cache instead of the CLucene files and the searcher cache. It suits
+// the columns of low or medium cardinality, the range predicates union the bitmaps of the values.
+CONF_mBool(enable_native_inverted_index, "false");
 CONF_Int32(inverted_index_read_buffer_size, "4096");
 // tree depth for bkd index
 CONF_Int32(max_depth_in_bkd_tree, "32");
@@ -934,6 +1394,14 @@ CONF_Bool(enable_parse_multi_dimession_array, "true");
 // max depth of expression tree allowed.
 CONF_Int32(max_depth_of_expr_tree, "600");
 
+// Whether to evaluate the trees of arithmetic and comparison functions on non-nullable doubles
+// in one pass over batches of rows, instead of a column per function.
+CONF_mBool(enable_fused_expr, "true");
+
+// Whether to match the OR'ed LIKE and REGEXP predicates on the same column with one hyperscan
+// database of all their patterns, instead of a pass over the column per predicate.
+CONF_mBool(enable_multi_match_predicate, "true");
+
 // Report a tablet as bad when io errors occurs more than this value.
 CONF_mInt64(max_tablet_io_errors, "-1");
 
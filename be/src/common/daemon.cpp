@@ -40,6 +40,8 @@
 #include "util/doris_metrics.h"
 #include "util/mem_info.h"
 #include "util/network_util.h"
+#include "util/query_cpu_sampler.h"
+#include "util/stopwatch.hpp"
 #include "util/system_metrics.h"
 #include "util/thrift_util.h"
 #include "util/time.h"
@@ -341,6 +343,15 @@ void Daemon::block_spill_gc_thread() {
     }
 }
 
+void Daemon::query_cpu_sampler_thread() {
+    auto* sampler = QueryCpuSampler::instance();
+    do {
+        sampler->set_frequency(config::query_cpu_sampling_frequency);
+        sampler->collect();
+    } while (!_stop_background_threads_latch.wait_for(std::chrono::milliseconds(200)));
+    sampler->set_frequency(0);
+}
+
 static void init_doris_metrics(const std::vector<StorePath>& store_paths) {
     bool init_system_metrics = config::enable_system_metrics;
     std::set<std::string> disk_devices;
@@ -407,6 +418,8 @@ void Daemon::init(int argc, char** argv, const std::vector<StorePath>& paths) {
     CpuInfo::init();
     DiskInfo::init();
     MemInfo::init();
+    // calibrates the TSC before the timers of the queries use it
+    LOG(INFO) << "nanosec per tick of TscClock: " << TscClock::nanosec_per_tick();
     UserFunctionCache::instance()->init(config::user_function_dir);
 
     LOG(INFO) << CpuInfo::debug_string();
@@ -452,6 +465,10 @@ void Daemon::start() {
             "Daemon", "block_spill_gc_thread", [this]() { this->block_spill_gc_thread(); },
             &_block_spill_gc_thread);
     CHECK(st.ok()) << st;
+    st = Thread::create(
+            "Daemon", "query_cpu_sampler_thread",
+            [this]() { this->query_cpu_sampler_thread(); }, &_query_cpu_sampler_thread);
+    CHECK(st.ok()) << st;
 }
 
 void Daemon::stop() {
@@ -478,6 +495,9 @@ void Daemon::stop() {
     if (_block_spill_gc_thread) {
         _block_spill_gc_thread->join();
     }
+    if (_query_cpu_sampler_thread) {
+        _query_cpu_sampler_thread->join();
+    }
 }
 
 } // namespace doris
@@ -52,6 +52,7 @@ private:
     void memory_tracker_profile_refresh_thread();
     void calculate_metrics_thread();
     void block_spill_gc_thread();
+    void query_cpu_sampler_thread();
 
     CountDownLatch _stop_background_threads_latch;
     scoped_refptr<Thread> _tcmalloc_gc_thread;
@@ -61,5 +62,6 @@ private:
     scoped_refptr<Thread> _memory_tracker_profile_refresh_thread;
     scoped_refptr<Thread> _calculate_metrics_thread;
     scoped_refptr<Thread> _block_spill_gc_thread;
+    scoped_refptr<Thread> _query_cpu_sampler_thread;
 };
 } // namespace doris
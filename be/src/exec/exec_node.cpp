@@ -34,6 +34,7 @@
 #include "util/runtime_profile.h"
 #include "vec/core/block.h"
 #include "vec/exec/join/vhash_join_node.h"
+#include "vec/exec/join/vmerge_join_node.h"
 #include "vec/exec/join/vnested_loop_join_node.h"
 #include "vec/exec/scan/new_es_scan_node.h"
 #include "vec/exec/scan/new_file_scan_node.h"
@@ -279,6 +280,7 @@ Status ExecNode::create_node(RuntimeState* state, ObjectPool* pool, const TPlanN
     case TPlanNodeType::OLAP_SCAN_NODE:
     case TPlanNodeType::ASSERT_NUM_ROWS_NODE:
     case TPlanNodeType::HASH_JOIN_NODE:
+    case TPlanNodeType::MERGE_JOIN_NODE:
     case TPlanNodeType::AGGREGATION_NODE:
     case TPlanNodeType::UNION_NODE:
     case TPlanNodeType::CROSS_JOIN_NODE:
@@ -364,6 +366,10 @@ Status ExecNode::create_node(RuntimeState* state, ObjectPool* pool, const TPlanN
         *node = pool->add(new vectorized::VNestedLoopJoinNode(pool, tnode, descs));
         return Status::OK();
 
+    case TPlanNodeType::MERGE_JOIN_NODE:
+        *node = pool->add(new vectorized::VMergeJoinNode(pool, tnode, descs));
+        return Status::OK();
+
     case TPlanNodeType::EMPTY_SET_NODE:
         *node = pool->add(new vectorized::VEmptySetNode(pool, tnode, descs));
         return Status::OK();
@@ -318,6 +318,66 @@ uint32_t VOlapTablePartitionParam::find_tablet(BlockRow* block_row,
     return _compute_tablet_index(block_row, partition.num_buckets);
 }
 
+void VOlapTablePartitionParam::find_partitions(
+        vectorized::Block* block, size_t num_rows,
+        std::vector<const VOlapTablePartition*>* partitions) const {
+    partitions->assign(num_rows, nullptr);
+    VOlapTablePartKeyComparator comparator(_partition_slot_locs);
+    const VOlapTablePartition* last_partition = nullptr;
+    BlockRow last_row = {block, -1};
+    for (int i = 0; i < num_rows; ++i) {
+        BlockRow block_row = {block, i};
+        if (last_partition != nullptr) {
+            // a list partition contains the row if it has the same keys as the former row,
+            // a range partition if its start key <= row < end key
+            bool same_partition = false;
+            if (_is_in_partition) {
+                same_partition = !comparator(&last_row, &block_row) &&
+                                 !comparator(&block_row, &last_row);
+            } else {
+                same_partition = _part_contains(last_partition, &block_row) &&
+                                 comparator(&block_row, &last_partition->end_key);
+            }
+            if (same_partition) {
+                (*partitions)[i] = last_partition;
+                last_row = block_row;
+                continue;
+            }
+        }
+        const VOlapTablePartition* partition = nullptr;
+        find_partition(&block_row, &partition);
+        (*partitions)[i] = partition;
+        last_partition = partition;
+        last_row = block_row;
+    }
+}
+
+void VOlapTablePartitionParam::find_tablets(
+        vectorized::Block* block, size_t num_rows,
+        const std::vector<const VOlapTablePartition*>& partitions,
+        std::vector<uint32_t>* tablet_indexes) const {
+    tablet_indexes->assign(num_rows, 0);
+    if (_distributed_slot_locs.empty()) {
+        for (size_t i = 0; i < num_rows; ++i) {
+            if (partitions[i] != nullptr) {
+                (*tablet_indexes)[i] = butil::fast_rand() % partitions[i]->num_buckets;
+            }
+        }
+        return;
+    }
+    // the same crc32 as _compute_tablet_index, which is also used by the bucket shuffle
+    std::vector<uint64_t> hashes(num_rows, 0);
+    for (auto slot_loc : _distributed_slot_locs) {
+        block->get_by_position(slot_loc).column->update_crcs_with_value(
+                hashes, _slots[slot_loc]->type().type);
+    }
+    for (size_t i = 0; i < num_rows; ++i) {
+        if (partitions[i] != nullptr) {
+            (*tablet_indexes)[i] = hashes[i] % partitions[i]->num_buckets;
+        }
+    }
+}
+
 Status VOlapTablePartitionParam::_create_partition_keys(const std::vector<TExprNode>& t_exprs,
                                                         BlockRow* part_key) {
     for (int i = 0; i < t_exprs.size(); i++) {
@@ -156,6 +156,18 @@ public:
 
     uint32_t find_tablet(BlockRow* block_row, const VOlapTablePartition& partition) const;
 
+    // find the partitions of the first num_rows rows of block, nullptr if a row has no
+    // partition. The loaded rows are often clustered by partition keys, so the partition of
+    // the former row is checked before the lookup.
+    void find_partitions(vectorized::Block* block, size_t num_rows,
+                         std::vector<const VOlapTablePartition*>* partitions) const;
+
+    // find the tablet indexes of the rows in their partitions, the distributed columns are
+    // hashed a column at a time rather than a row at a time
+    void find_tablets(vectorized::Block* block, size_t num_rows,
+                      const std::vector<const VOlapTablePartition*>& partitions,
+                      std::vector<uint32_t>* tablet_indexes) const;
+
     const std::vector<VOlapTablePartition*>& get_partitions() const { return _partitions; }
 
 private:
@@ -166,7 +178,7 @@ private:
     std::function<uint32_t(BlockRow*, int64_t)> _compute_tablet_index;
 
     // check if this partition contain this key
-    bool _part_contains(VOlapTablePartition* part, BlockRow* key) const {
+    bool _part_contains(const VOlapTablePartition* part, BlockRow* key) const {
         // start_key.second == -1 means only single partition
         VOlapTablePartKeyComparator comparator(_partition_slot_locs);
         return part->start_key.second == -1 || !comparator(key, &part->start_key);
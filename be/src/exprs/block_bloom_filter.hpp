@@ -80,6 +80,11 @@ public:
         }
     }
 
+    // Same as calling find() for each of the n hashes, results[i] is set to 1 when hashes[i]
+    // is found and 0 otherwise. The buckets are prefetched ahead of the probe, and two keys are
+    // probed at a time with AVX-512.
+    void find_batch(const uint32_t* hashes, size_t n, uint8_t* results) const noexcept;
+
     // Computes the logical OR of this filter with 'other' and stores the result in this
     // filter.
     // Notes:
@@ -176,6 +181,13 @@ private:
     bool bucket_find_avx2(uint32_t bucket_idx, uint32_t hash) const noexcept
             __attribute__((__target__("avx2")));
 
+#ifdef __AVX512F__
+    // Probe the buckets of hashes[i] and hashes[i + 1] with one AVX-512 register.
+    void bucket_find_two_avx512(uint32_t bucket_idx0, uint32_t hash0, uint32_t bucket_idx1,
+                                uint32_t hash1, uint8_t* results) const noexcept
+            __attribute__((__target__("avx512f")));
+#endif
+
     // Computes out[i] |= in[i] for the arrays 'in' and 'out' of length 'n' using AVX2
     // instructions. 'n' must be a multiple of 32.
     static void or_equal_array_avx2(size_t n, const uint8_t* __restrict__ in,
@@ -62,6 +62,31 @@ bool BlockBloomFilter::bucket_find_avx2(const uint32_t bucket_idx,
     return result;
 }
 
+#ifdef __AVX512F__
+void BlockBloomFilter::bucket_find_two_avx512(const uint32_t bucket_idx0, const uint32_t hash0,
+                                              const uint32_t bucket_idx1, const uint32_t hash1,
+                                              uint8_t* results) const noexcept {
+    const __m512i ones = _mm512_set1_epi32(1);
+    const __m512i rehash = _mm512_broadcast_i64x4(_mm256_setr_epi32(BLOOM_HASH_CONSTANTS));
+    // The lower 8 lanes are for hash0 and the upper 8 lanes are for hash1, same as make_mark()
+    __m512i hash_data = _mm512_inserti64x4(_mm512_castsi256_si512(_mm256_set1_epi32(hash0)),
+                                           _mm256_set1_epi32(hash1), 1);
+    hash_data = _mm512_mullo_epi32(rehash, hash_data);
+    hash_data = _mm512_srli_epi32(hash_data, 27);
+    const __m512i mask = _mm512_sllv_epi32(ones, hash_data);
+
+    const __m256i* directory = reinterpret_cast<const __m256i*>(_directory);
+    const __m512i buckets = _mm512_inserti64x4(
+            _mm512_castsi256_si512(_mm256_load_si256(directory + bucket_idx0)),
+            _mm256_load_si256(directory + bucket_idx1), 1);
+    // A lane is set when 'buckets' has a one wherever 'mask' does
+    const __mmask16 found = _mm512_cmpeq_epi32_mask(_mm512_and_si512(buckets, mask), mask);
+    results[0] = (found & 0xff) == 0xff;
+    results[1] = (found >> 8) == 0xff;
+    _mm256_zeroupper();
+}
+#endif
+
 void BlockBloomFilter::insert_avx2(const uint32_t hash) noexcept {
     _always_false = false;
     const uint32_t bucket_idx = rehash32to32(hash) & _directory_mask;
@@ -139,6 +139,20 @@ void BlockBloomFilter::bucket_insert(const uint32_t bucket_idx, const uint32_t h
 }
 
 bool BlockBloomFilter::bucket_find(const uint32_t bucket_idx, const uint32_t hash) const noexcept {
+#ifdef __aarch64__
+    // Same as the loop below, the 8 words are probed by two NEON registers.
+    const uint32x4_t ones = vdupq_n_u32(1);
+    const uint32x4_t hash_data = vdupq_n_u32(hash);
+    uint32x4_t found = vdupq_n_u32(UINT32_MAX);
+    for (int i = 0; i < 2; ++i) {
+        const uint32x4_t shift = vshrq_n_u32(vmulq_u32(vld1q_u32(kRehash + 4 * i), hash_data),
+                                             (1 << kLogBucketWordBits) - kLogBucketWordBits);
+        const uint32x4_t mask = vshlq_u32(ones, vreinterpretq_s32_u32(shift));
+        const uint32x4_t bucket = vld1q_u32(&DCHECK_NOTNULL(_directory)[bucket_idx][4 * i]);
+        found = vandq_u32(found, vceqq_u32(vandq_u32(bucket, mask), mask));
+    }
+    return vminvq_u32(found) != 0;
+#else
     for (int i = 0; i < kBucketWords; ++i) {
         BucketWord hval = (kRehash[i] * hash) >> ((1 << kLogBucketWordBits) - kLogBucketWordBits);
         hval = 1U << hval;
@@ -147,6 +161,7 @@ bool BlockBloomFilter::bucket_find(const uint32_t bucket_idx, const uint32_t has
         }
     }
     return true;
+#endif
 }
 
 void BlockBloomFilter::insert_no_avx2(const uint32_t hash) noexcept {
@@ -182,6 +197,44 @@ bool BlockBloomFilter::find(const uint32_t hash) const noexcept {
 #endif
 }
 
+void BlockBloomFilter::find_batch(const uint32_t* hashes, size_t n,
+                                  uint8_t* results) const noexcept {
+    if (_always_false) {
+        memset(results, 0, n);
+        return;
+    }
+    // The directory is usually much larger than the cache when the filter is strong, so
+    // prefetch the buckets of the keys which will be probed later.
+    static constexpr size_t kPrefetchDistance = 16;
+    auto prefetch = [&](size_t i) {
+        if (i < n) {
+            __builtin_prefetch(&_directory[rehash32to32(hashes[i]) & _directory_mask]);
+        }
+    };
+    for (size_t i = 0; i < std::min(n, kPrefetchDistance); ++i) {
+        prefetch(i);
+    }
+    size_t i = 0;
+#ifdef __AVX512F__
+    for (; i + 1 < n; i += 2) {
+        prefetch(i + kPrefetchDistance);
+        prefetch(i + 1 + kPrefetchDistance);
+        bucket_find_two_avx512(rehash32to32(hashes[i]) & _directory_mask, hashes[i],
+                               rehash32to32(hashes[i + 1]) & _directory_mask, hashes[i + 1],
+                               results + i);
+    }
+#endif
+    for (; i < n; ++i) {
+        prefetch(i + kPrefetchDistance);
+        const uint32_t bucket_idx = rehash32to32(hashes[i]) & _directory_mask;
+#ifdef __AVX2__
+        results[i] = bucket_find_avx2(bucket_idx, hashes[i]);
+#else
+        results[i] = bucket_find(bucket_idx, hashes[i]);
+#endif
+    }
+}
+
 void BlockBloomFilter::or_equal_array_internal(size_t n, const uint8_t* __restrict__ in,
                                                uint8_t* __restrict__ out) {
 #ifdef __AVX2__
@@ -64,6 +64,12 @@ public:
         }
     }
 
+    // Same as test_element() for a batch of fixed length elements which are already hashed by
+    // HashUtil::fixed_len_to_uint32().
+    void test_hashes(const uint32_t* hashes, size_t n, uint8_t* results) const {
+        _bloom_filter->find_batch(hashes, n, results);
+    }
+
     template <typename T>
     void add_element(T element) {
         if constexpr (std::is_same_v<T, Slice>) {
@@ -89,6 +95,16 @@ public:
         return init_with_fixed_length(filter_size);
     }
 
+    // Size the bloom filter by the actual number of distinct values instead of the planned
+    // length, but not larger than max_length.
+    Status init_with_cardinality(int64_t cardinality, double fpp, int64_t max_length) {
+        int64_t filter_size = BloomFilterAdaptor::optimal_bit_num(cardinality, fpp);
+        while (filter_size > max_length && filter_size > 1) {
+            filter_size >>= 1;
+        }
+        return init_with_fixed_length(filter_size);
+    }
+
     void set_length(int64_t bloom_filter_length) { _bloom_filter_length = bloom_filter_length; }
 
     Status init_with_fixed_length() { return init_with_fixed_length(_bloom_filter_length); }
@@ -212,33 +228,49 @@ struct CommonFindOp {
         bloom_filter.add_element(*((T*)data));
     }
 
+    // The elements are hashed and probed in chunks, so that the bloom filter can probe a chunk
+    // of hashes together.
+    static constexpr int FIND_BATCH_SIZE = 256;
+
     uint16_t find_batch_olap_engine(const BloomFilterAdaptor& bloom_filter, const char* data,
                                     const uint8* nullmap, uint16_t* offsets, int number) const {
+        uint32_t hashes[FIND_BATCH_SIZE];
+        uint8_t results[FIND_BATCH_SIZE];
         uint16_t new_size = 0;
-        for (int i = 0; i < number; i++) {
-            uint16_t idx = offsets[i];
-            if (nullmap != nullptr && nullmap[idx]) {
-                continue;
+        for (int begin = 0; begin < number; begin += FIND_BATCH_SIZE) {
+            int size = std::min(FIND_BATCH_SIZE, number - begin);
+            for (int i = 0; i < size; i++) {
+                hashes[i] = HashUtil::fixed_len_to_uint32(*((T*)data + offsets[begin + i]));
             }
-            if (!bloom_filter.test_element(*((T*)data + idx))) {
-                continue;
+            bloom_filter.test_hashes(hashes, size, results);
+            for (int i = 0; i < size; i++) {
+                uint16_t idx = offsets[begin + i];
+                if (nullmap != nullptr && nullmap[idx]) {
+                    continue;
+                }
+                if (!results[i]) {
+                    continue;
+                }
+                offsets[new_size++] = idx;
             }
-            offsets[new_size++] = idx;
         }
         return new_size;
     }
 
     void find_batch(const BloomFilterAdaptor& bloom_filter, const char* data, const uint8* nullmap,
                     int number, uint8* results) const {
-        for (int i = 0; i < number; i++) {
-            results[i] = false;
-            if (nullmap != nullptr && nullmap[i]) {
-                continue;
+        uint32_t hashes[FIND_BATCH_SIZE];
+        for (int begin = 0; begin < number; begin += FIND_BATCH_SIZE) {
+            int size = std::min(FIND_BATCH_SIZE, number - begin);
+            for (int i = 0; i < size; i++) {
+                hashes[i] = HashUtil::fixed_len_to_uint32(*((T*)data + begin + i));
             }
-            if (!bloom_filter.test_element(*((T*)data + i))) {
-                continue;
+            bloom_filter.test_hashes(hashes, size, results + begin);
+        }
+        if (nullmap != nullptr) {
+            for (int i = 0; i < number; i++) {
+                results[i] &= !nullmap[i];
             }
-            results[i] = true;
         }
     }
 
@@ -295,8 +295,20 @@ Status JsonFunctions::extract_from_object(simdjson::ondemand::object& obj,
                                   fmt::format("unable to find field: {}", col));
         }
 
-        // TODO support [*] which idex == -2
-        if (index != -1) {
+        if (index == -2) {
+            // [*] is only supported at the end of the path, it selects the whole array,
+            // so the value is kept as is after checking it is an array.
+            if (UNLIKELY(i + 1 != jsonpath.size())) {
+                return Status::DataQualityError(
+                        fmt::format("[*] is only supported at the end of json path: {}", col));
+            }
+            simdjson::ondemand::json_type type;
+            HANDLE_SIMDJSON_ERROR(tvalue.type().get(type),
+                                  fmt::format("failed to get the type of field: {}", col));
+            if (type != simdjson::ondemand::json_type::array) {
+                return Status::NotFound(fmt::format("field is not an array, field: {}", col));
+            }
+        } else if (index != -1) {
             // try to access tvalue as array.
             // If the index is beyond the length of array, simdjson::INDEX_OUT_OF_BOUNDS would be returned.
             simdjson::ondemand::array arr;
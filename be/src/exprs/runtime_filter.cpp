@@ -19,6 +19,7 @@
 
 #include <memory>
 
+#include "common/config.h"
 #include "common/object_pool.h"
 #include "common/status.h"
 #include "exprs/bitmapfilter_predicate.h"
@@ -26,6 +27,7 @@
 #include "exprs/hybrid_set.h"
 #include "exprs/minmax_predicate.h"
 #include "gen_cpp/internal_service.pb.h"
+#include "pipeline/dependency.h"
 #include "runtime/define_primitive_type.h"
 #include "runtime/large_int_value.h"
 #include "runtime/primitive_type.h"
@@ -1215,12 +1217,43 @@ void IRuntimeFilter::signal() {
         _profile->add_info_string("BitmapSize", std::to_string(bitmap_filter->size()));
         _profile->add_info_string("IsNotIn", bitmap_filter->is_not_in() ? "true" : "false");
     }
+
+    std::vector<std::shared_ptr<pipeline::Dependency>> dependencies;
+    {
+        std::lock_guard<std::mutex> l(_dependency_mutex);
+        dependencies = _ready_dependencies;
+    }
+    for (auto& dependency : dependencies) {
+        dependency->notify();
+    }
+}
+
+void IRuntimeFilter::add_ready_dependency(std::shared_ptr<pipeline::Dependency> dependency) {
+    std::lock_guard<std::mutex> l(_dependency_mutex);
+    _ready_dependencies.emplace_back(std::move(dependency));
 }
 
 BloomFilterFuncBase* IRuntimeFilter::get_bloomfilter() const {
     return _wrapper->get_bloomfilter();
 }
 
+bool IRuntimeFilter::is_bloom_filter_sized_by_build() const {
+    return is_producer() && !_has_remote_target && config::runtime_filter_bloom_filter_fpp > 0;
+}
+
+Status IRuntimeFilter::init_bloom_filter(size_t build_bf_cardinality) {
+    auto bf = get_bloomfilter();
+    if (bf == nullptr) {
+        return Status::OK();
+    }
+    if (is_bloom_filter_sized_by_build()) {
+        return bf->init_with_cardinality(build_bf_cardinality,
+                                         config::runtime_filter_bloom_filter_fpp,
+                                         config::runtime_filter_max_bloom_filter_bytes);
+    }
+    return bf->init_with_fixed_length();
+}
+
 Status IRuntimeFilter::init_with_desc(const TRuntimeFilterDesc* desc, const TQueryOptions* options,
                                       UniqueId fragment_instance_id, int node_id) {
     // if node_id == -1 , it shouldn't be a consumer
@@ -43,6 +43,10 @@ class RuntimeProfile;
 class BloomFilterFuncBase;
 class BitmapFilterFuncBase;
 
+namespace pipeline {
+class Dependency;
+}
+
 namespace vectorized {
 class VExpr;
 class VExprContext;
@@ -205,12 +209,24 @@ public:
     // it will nodify all wait threads
     void signal();
 
+    // the dependency will be notified when the filter is signaled, used by pipeline
+    void add_ready_dependency(std::shared_ptr<pipeline::Dependency> dependency);
+
     // init filter with desc
     Status init_with_desc(const TRuntimeFilterDesc* desc, const TQueryOptions* options,
                           UniqueId fragment_id, int node_id = -1);
 
     BloomFilterFuncBase* get_bloomfilter() const;
 
+    // Whether the bloom filter is allocated after the build side is finished, and sized by the
+    // number of distinct build keys. Only for filters without remote targets, because the merged
+    // filters must have the same size.
+    bool is_bloom_filter_sized_by_build() const;
+
+    // Allocate the bloom filter, build_bf_cardinality is only used when
+    // is_bloom_filter_sized_by_build() is true.
+    Status init_bloom_filter(size_t build_bf_cardinality);
+
     // serialize _wrapper to protobuf
     Status serialize(PMergeFilterRequest* request, void** data, int* len);
     Status serialize(PPublishFilterRequest* request, void** data = nullptr, int* len = nullptr);
@@ -323,6 +339,8 @@ protected:
     // used for await or signal
     doris::Mutex _inner_mutex;
     doris::ConditionVariable _inner_cv;
+    std::mutex _dependency_mutex;
+    std::vector<std::shared_ptr<pipeline::Dependency>> _ready_dependencies;
 
     bool _is_push_down = false;
 
@@ -149,6 +149,8 @@ public:
                  !over_max_in_num)) {
                 has_in_filter[runtime_filter->expr_order()] = true;
             }
+            // the number of distinct values of a build column is not larger than hash_table_size
+            RETURN_IF_ERROR(runtime_filter->init_bloom_filter(hash_table_size));
             _runtime_filters[runtime_filter->expr_order()].push_back(runtime_filter);
         }
 
@@ -15,6 +15,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <charconv>
+#include <cmath>
 #include <limits>
 using std::numeric_limits;
 #include <string>
@@ -1270,7 +1272,89 @@ int FloatToBuffer(float value, int width, char* buffer) {
     return snprintf_result;
 }
 
+// Formats `value` as printf("%.<precision>g") does, if its shortest representation which parses
+// back to it has no more than `precision` digits, and returns the length, otherwise returns -1.
+//
+// The shortest representation is computed by std::to_chars without any parsing, and it's the
+// one printed by %.<precision>g since the decimals of `precision` digits are sparser than the
+// normal values of T, i.e. only one of them may round to the value. It's not true for the
+// subnormal values, whose gaps are fixed.
+template <typename T>
+static int ShortestToBuffer(T value, int precision, char* buffer) {
+    char sci[64];
+    auto [end, ec] = std::to_chars(sci, sci + sizeof(sci), value, std::chars_format::scientific);
+    if (ec != std::errc()) {
+        return -1;
+    }
+    const char* p = sci;
+    char* out = buffer;
+    if (*p == '-') {
+        *out++ = *p++;
+    }
+    // the digits of "d.ddde+XX"
+    char digits[32];
+    int num_digits = 0;
+    for (; p != end && *p != 'e'; ++p) {
+        if (*p != '.') {
+            digits[num_digits++] = *p;
+        }
+    }
+    if (p == end || num_digits > precision) {
+        return -1;
+    }
+    int exponent = 0;
+    std::from_chars(p + (p[1] == '+' ? 2 : 1), end, exponent);
+
+    if (exponent < -4 || exponent >= precision) {
+        *out++ = digits[0];
+        if (num_digits > 1) {
+            *out++ = '.';
+            memcpy(out, digits + 1, num_digits - 1);
+            out += num_digits - 1;
+        }
+        *out++ = 'e';
+        *out++ = exponent < 0 ? '-' : '+';
+        int abs_exponent = exponent < 0 ? -exponent : exponent;
+        if (abs_exponent < 10) {
+            *out++ = '0';
+        }
+        out = std::to_chars(out, out + 4, abs_exponent).ptr;
+    } else if (exponent < 0) {
+        *out++ = '0';
+        *out++ = '.';
+        memset(out, '0', -exponent - 1);
+        out += -exponent - 1;
+        memcpy(out, digits, num_digits);
+        out += num_digits;
+    } else {
+        int int_digits = exponent + 1;
+        if (num_digits <= int_digits) {
+            memcpy(out, digits, num_digits);
+            out += num_digits;
+            memset(out, '0', int_digits - num_digits);
+            out += int_digits - num_digits;
+        } else {
+            memcpy(out, digits, int_digits);
+            out += int_digits;
+            *out++ = '.';
+            memcpy(out, digits + int_digits, num_digits - int_digits);
+            out += num_digits - int_digits;
+        }
+    }
+    *out = '\0';
+    return out - buffer;
+}
+
 int FastDoubleToBuffer(double value, char* buffer) {
+    if (std::isnormal(value) || value == 0) {
+        int length = ShortestToBuffer(value, 15, buffer);
+        if (length >= 0) {
+            return length;
+        }
+        auto end = fmt::format_to(buffer, "{:.17g}", value);
+        *end = '\0';
+        return end - buffer;
+    }
     auto end = fmt::format_to(buffer, "{:.15g}", value);
     *end = '\0';
     if (strtod(buffer, nullptr) != value) {
@@ -1280,6 +1364,15 @@ int FastDoubleToBuffer(double value, char* buffer) {
 }
 
 int FastFloatToBuffer(float value, char* buffer) {
+    if (std::isnormal(value) || value == 0) {
+        int length = ShortestToBuffer(value, 6, buffer);
+        if (length >= 0) {
+            return length;
+        }
+        auto end = fmt::format_to(buffer, "{:.8g}", value);
+        *end = '\0';
+        return end - buffer;
+    }
     auto end = fmt::format_to(buffer, "{:.6g}", value);
     *end = '\0';
 #ifdef _MSC_VER // has no strtof()
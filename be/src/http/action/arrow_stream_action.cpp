@@ -0,0 +1,135 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "http/action/arrow_stream_action.h"
+
+#include <arrow/buffer.h>
+#include <arrow/io/memory.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/record_batch.h>
+#include <arrow/result.h>
+#include <fmt/format.h>
+
+#include <mutex>
+#include <string>
+
+#include "common/config.h"
+#include "http/http_channel.h"
+#include "http/http_headers.h"
+#include "http/http_request.h"
+#include "http/http_status.h"
+#include "runtime/exec_env.h"
+#include "runtime/external_scan_context_mgr.h"
+#include "runtime/result_queue_mgr.h"
+#include "util/arrow/utils.h"
+#include "util/uid_util.h"
+
+namespace doris {
+
+const static std::string HEADER_ARROW_STREAM = "application/vnd.apache.arrow.stream";
+const static std::string HEADER_EOS = "X-Doris-Eos";
+const static std::string HEADER_OFFSET = "X-Doris-Offset";
+const static std::string PARAM_TICKET = "ticket";
+const static std::string PARAM_OFFSET = "offset";
+
+void ArrowStreamAction::handle(HttpRequest* req) {
+    std::shared_ptr<ScanContext> context;
+    Status st = _exec_env->external_scan_context_mgr()->get_scan_context(req->param(PARAM_TICKET),
+                                                                         &context);
+    if (!st.ok()) {
+        HttpChannel::send_reply(req, HttpStatus::NOT_FOUND, st.to_json());
+        return;
+    }
+    // the batches of a context are read by one request at a time
+    std::unique_lock<std::mutex> l(context->_local_lock);
+    const std::string& offset = req->param(PARAM_OFFSET);
+    if (!offset.empty() && offset != std::to_string(context->offset)) {
+        HttpChannel::send_reply(req, HttpStatus::BAD_REQUEST,
+                                fmt::format("ticket={}, send_offset={}, context_offset={}",
+                                            context->context_id, offset, context->offset));
+        return;
+    }
+    // during accessing, should disabled last_access_time
+    context->last_access_time = -1;
+    std::shared_ptr<arrow::Buffer> buffer;
+    int64_t num_rows = 0;
+    bool eos = false;
+    st = _fetch_batches(context->fragment_instance_id, &buffer, &num_rows, &eos);
+    context->last_access_time = time(nullptr);
+    if (!st.ok()) {
+        LOG(WARNING) << "fragment_instance_id [" << print_id(context->fragment_instance_id)
+                     << "] fetch arrow stream status [" << st.to_string() << "]";
+        HttpChannel::send_reply(req, HttpStatus::INTERNAL_SERVER_ERROR, st.to_json());
+        return;
+    }
+    context->offset += num_rows;
+
+    req->add_output_header(HttpHeaders::CONTENT_TYPE, HEADER_ARROW_STREAM.c_str());
+    req->add_output_header(HEADER_EOS.c_str(), eos ? "true" : "false");
+    req->add_output_header(HEADER_OFFSET.c_str(), std::to_string(context->offset).c_str());
+    if (buffer == nullptr) {
+        HttpChannel::send_reply(req, HttpStatus::OK);
+        return;
+    }
+    // the body refers to the buffer until it's sent
+    auto* holder = new std::shared_ptr<arrow::Buffer>(std::move(buffer));
+    HttpChannel::send_reference(
+            req, reinterpret_cast<const char*>((*holder)->data()), (*holder)->size(),
+            [](const void*, size_t, void* arg) {
+                delete static_cast<std::shared_ptr<arrow::Buffer>*>(arg);
+            },
+            holder);
+}
+
+Status ArrowStreamAction::_fetch_batches(const TUniqueId& fragment_instance_id,
+                                         std::shared_ptr<arrow::Buffer>* buffer,
+                                         int64_t* num_rows, bool* eos) {
+    std::shared_ptr<arrow::io::BufferOutputStream> sink;
+    std::shared_ptr<arrow::ipc::RecordBatchWriter> writer;
+    int64_t written_bytes = 0;
+    while (written_bytes < config::arrow_stream_max_bytes_per_request) {
+        std::shared_ptr<arrow::RecordBatch> record_batch;
+        RETURN_IF_ERROR(_exec_env->result_queue_mgr()->fetch_result(fragment_instance_id,
+                                                                    &record_batch, eos));
+        if (*eos) {
+            break;
+        }
+        if (writer == nullptr) {
+            auto sink_res = arrow::io::BufferOutputStream::Create();
+            RETURN_IF_ERROR(to_status(sink_res.status()));
+            sink = std::move(sink_res).ValueOrDie();
+            auto writer_res = arrow::ipc::MakeStreamWriter(sink.get(), record_batch->schema());
+            RETURN_IF_ERROR(to_status(writer_res.status()));
+            writer = std::move(writer_res).ValueOrDie();
+        }
+        RETURN_IF_ERROR(to_status(writer->WriteRecordBatch(*record_batch)));
+        *num_rows += record_batch->num_rows();
+        auto tell_res = sink->Tell();
+        RETURN_IF_ERROR(to_status(tell_res.status()));
+        written_bytes = tell_res.ValueOrDie();
+    }
+    if (writer == nullptr) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(to_status(writer->Close()));
+    auto finish_res = sink->Finish();
+    RETURN_IF_ERROR(to_status(finish_res.status()));
+    *buffer = std::move(finish_res).ValueOrDie();
+    return Status::OK();
+}
+
+} // end namespace doris
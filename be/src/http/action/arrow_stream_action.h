@@ -0,0 +1,59 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+
+#include "common/status.h"
+#include "http/http_handler.h"
+
+namespace arrow {
+class Buffer;
+} // namespace arrow
+
+namespace doris {
+
+class ExecEnv;
+class TUniqueId;
+
+// Streams the results of an external scan as an Arrow IPC stream, so that the clients, e.g.
+// pyarrow, read the record batches without the thrift of get_next.
+//
+// GET /api/arrow_stream/{ticket}?offset=N
+//
+// The ticket is the context id returned by open_scanner. Each request returns the next record
+// batches of up to `config::arrow_stream_max_bytes_per_request` as a stream of its own, and the
+// clients request again until the header X-Doris-Eos is true. The header X-Doris-Offset is the
+// number of rows sent so far, which is passed as `offset` of the next request to detect the
+// retries, like get_next.
+class ArrowStreamAction : public HttpHandler {
+public:
+    ArrowStreamAction(ExecEnv* exec_env) : _exec_env(exec_env) {}
+
+    ~ArrowStreamAction() override = default;
+
+    void handle(HttpRequest* req) override;
+
+private:
+    Status _fetch_batches(const TUniqueId& fragment_instance_id,
+                          std::shared_ptr<arrow::Buffer>* buffer, int64_t* num_rows, bool* eos);
+
+    ExecEnv* _exec_env;
+};
+
+} // end namespace doris
@@ -0,0 +1,59 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "http/action/file_cache_action.h"
+
+#include <string>
+
+#include "http/http_channel.h"
+#include "http/http_headers.h"
+#include "http/http_request.h"
+#include "http/http_status.h"
+#include "io/cache/block/block_file_cache_factory.h"
+#include "util/easy_json.h"
+#include "util/url_coding.h"
+
+namespace doris {
+
+const static std::string HEADER_JSON = "application/json";
+const static std::string PARAM_FPP = "fpp";
+
+void FileCacheSummaryAction::handle(HttpRequest* req) {
+    double fpp = 0.01;
+    const std::string& fpp_str = req->param(PARAM_FPP);
+    if (!fpp_str.empty()) {
+        try {
+            fpp = std::stod(fpp_str);
+        } catch (...) {
+            HttpChannel::send_reply(req, HttpStatus::BAD_REQUEST, "invalid fpp: " + fpp_str);
+            return;
+        }
+    }
+    auto summary = io::FileCacheFactory::instance().get_cached_key_summary(fpp);
+    std::string bits;
+    base64_encode(summary.bits, &bits);
+
+    EasyJson result;
+    result["num_keys"] = summary.num_keys;
+    result["num_hashes"] = summary.num_hashes;
+    result["num_bits"] = summary.bits.size() * 8;
+    result["bits"] = bits;
+    req->add_output_header(HttpHeaders::CONTENT_TYPE, HEADER_JSON.c_str());
+    HttpChannel::send_reply(req, HttpStatus::OK, result.ToString());
+}
+
+} // end namespace doris
@@ -0,0 +1,113 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "http/action/fragment_replay_action.h"
+
+#include <algorithm>
+#include <string>
+
+#include "common/config.h"
+#include "http/http_channel.h"
+#include "http/http_headers.h"
+#include "http/http_request.h"
+#include "http/http_status.h"
+#include "runtime/fragment_replayer.h"
+#include "util/easy_json.h"
+#include "util/uid_util.h"
+
+namespace doris {
+
+const static std::string HEADER_JSON = "application/json";
+const static std::string PARAM_QUERY_ID = "query_id";
+const static std::string PARAM_REPEAT = "repeat";
+const static std::string PARAM_TIMEOUT = "timeout";
+const static std::string PARAM_PROFILE = "profile";
+
+void FragmentReplayAction::handle(HttpRequest* req) {
+    req->add_output_header(HttpHeaders::CONTENT_TYPE, HEADER_JSON.c_str());
+    if (req->method() == HttpMethod::GET) {
+        EasyJson result;
+        result["enable_fragment_capture"] = config::enable_fragment_capture;
+        EasyJson queries = result.Set("queries", EasyJson::kArray);
+        for (const auto& query_id : FragmentCapturer::instance()->list_queries()) {
+            queries.PushBack(query_id);
+        }
+        HttpChannel::send_reply(req, HttpStatus::OK, result.ToString());
+        return;
+    }
+
+    const std::string& query_id_str = req->param(PARAM_QUERY_ID);
+    TUniqueId query_id;
+    if (!parse_id(query_id_str, &query_id)) {
+        HttpChannel::send_reply(req, HttpStatus::BAD_REQUEST, "invalid query_id: " + query_id_str);
+        return;
+    }
+    int64_t repeat = 1;
+    int64_t timeout_s = 300;
+    try {
+        if (!req->param(PARAM_REPEAT).empty()) {
+            repeat = std::stol(req->param(PARAM_REPEAT));
+        }
+        if (!req->param(PARAM_TIMEOUT).empty()) {
+            timeout_s = std::stol(req->param(PARAM_TIMEOUT));
+        }
+    } catch (const std::exception& e) {
+        HttpChannel::send_reply(req, HttpStatus::BAD_REQUEST,
+                                std::string("invalid repeat or timeout: ") + e.what());
+        return;
+    }
+    repeat = std::clamp<int64_t>(repeat, 1, 1000);
+    timeout_s = std::max<int64_t>(timeout_s, 1);
+    bool collect_profile = req->param(PARAM_PROFILE) == "true";
+
+    FragmentReplayer replayer(_exec_env,
+                              config::fragment_capture_dir + "/" + print_id(query_id));
+    Status st = replayer.init();
+    if (!st.ok()) {
+        HttpChannel::send_reply(req, HttpStatus::NOT_FOUND, st.to_json());
+        return;
+    }
+
+    EasyJson result;
+    result["query_id"] = print_id(query_id);
+    result["instances"] = static_cast<int64_t>(replayer.num_instances());
+    EasyJson runs = result.Set("runs", EasyJson::kArray);
+    for (int64_t i = 0; i < repeat; ++i) {
+        FragmentReplayer::Result run_result;
+        st = replayer.replay(collect_profile, timeout_s, &run_result);
+        if (!st.ok()) {
+            result["status"] = st.to_string();
+            break;
+        }
+        EasyJson run = runs.PushBack(EasyJson::kObject);
+        run["latency_ms"] = run_result.latency_ns / 1000000;
+        run["user_cpu_ms"] = run_result.user_cpu_ns / 1000000;
+        run["sys_cpu_ms"] = run_result.sys_cpu_ns / 1000000;
+        run["result_rows"] = run_result.result_rows;
+        run["result_bytes"] = run_result.result_bytes;
+        if (collect_profile) {
+            run["profile"] = run_result.profile;
+        }
+    }
+    if (st.ok()) {
+        result["status"] = "OK";
+    }
+    HttpChannel::send_reply(req, st.ok() ? HttpStatus::OK : HttpStatus::INTERNAL_SERVER_ERROR,
+                            result.ToString());
+}
+
+} // end namespace doris
@@ -0,0 +1,42 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "http/http_handler.h"
+
+namespace doris {
+
+class ExecEnv;
+
+// Replay the captured fragments of the queries, see FragmentReplayer.
+// GET /api/fragment_replay lists the captured queries.
+// POST /api/fragment_replay?query_id=xxx&repeat=N&timeout=S&profile=true runs the fragments of
+// the query N times and returns the latency and the CPU time of each run.
+class FragmentReplayAction : public HttpHandler {
+public:
+    FragmentReplayAction(ExecEnv* exec_env) : _exec_env(exec_env) {}
+
+    ~FragmentReplayAction() override = default;
+
+    void handle(HttpRequest* req) override;
+
+private:
+    ExecEnv* _exec_env;
+};
+
+} // end namespace doris
@@ -40,6 +40,7 @@
 #include "runtime/exec_env.h"
 #include "util/bfd_parser.h"
 #include "util/pprof_utils.h"
+#include "util/query_cpu_sampler.h"
 
 namespace doris {
 
@@ -154,9 +155,12 @@ void ProfileAction::handle(HttpRequest* req) {
         std::ostringstream tmp_prof_file_name;
         tmp_prof_file_name << config::pprof_profile_dir << "/doris_profile." << getpid() << "."
                            << rand();
+        // gperftools samples on SIGPROF too
+        QueryCpuSampler::instance()->pause();
         ProfilerStart(tmp_prof_file_name.str().c_str());
         sleep(seconds);
         ProfilerStop();
+        QueryCpuSampler::instance()->resume();
 
         if (type_str != "text") {
             // return raw content via http response directly
@@ -0,0 +1,91 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "http/action/query_cpu_profile_action.h"
+
+#include <cstdlib>
+#include <string>
+
+#include "common/config.h"
+#include "http/http_channel.h"
+#include "http/http_headers.h"
+#include "http/http_request.h"
+#include "http/http_status.h"
+#include "util/easy_json.h"
+#include "util/pprof_utils.h"
+#include "util/query_cpu_sampler.h"
+#include "util/uid_util.h"
+
+namespace doris {
+
+const static std::string HEADER_JSON = "application/json";
+const static std::string HEADER_SVG = "image/svg+xml";
+const static std::string PARAM_QUERY_ID = "query_id";
+const static std::string PARAM_TYPE = "type";
+
+void QueryCpuProfileAction::handle(HttpRequest* req) {
+    auto* sampler = QueryCpuSampler::instance();
+    const std::string& query_id_str = req->param(PARAM_QUERY_ID);
+    if (query_id_str.empty()) {
+        EasyJson result;
+        result["frequency"] = sampler->frequency();
+        result["dropped_samples"] = sampler->dropped_samples();
+        EasyJson queries = result.Set("queries", EasyJson::kArray);
+        for (const auto& query : sampler->list_queries()) {
+            EasyJson entry = queries.PushBack(EasyJson::kObject);
+            entry["query_id"] = print_id(query.query_id);
+            entry["samples"] = query.samples;
+            entry["last_sample_time"] = static_cast<int64_t>(query.last_sample_time);
+        }
+        req->add_output_header(HttpHeaders::CONTENT_TYPE, HEADER_JSON.c_str());
+        HttpChannel::send_reply(req, HttpStatus::OK, result.ToString());
+        return;
+    }
+
+    TUniqueId query_id;
+    if (!parse_id(query_id_str, &query_id)) {
+        HttpChannel::send_reply(req, HttpStatus::BAD_REQUEST, "invalid query_id: " + query_id_str);
+        return;
+    }
+    // the samples not drained yet
+    sampler->collect();
+    std::string folded_stacks;
+    Status st = sampler->get_folded_stacks(query_id, &folded_stacks);
+    if (!st.ok()) {
+        HttpChannel::send_reply(req, HttpStatus::NOT_FOUND, st.to_string());
+        return;
+    }
+    if (req->param(PARAM_TYPE) != "flamegraph") {
+        HttpChannel::send_reply(req, HttpStatus::OK, folded_stacks);
+        return;
+    }
+
+    std::string flamegraph_install_dir =
+            std::string(std::getenv("DORIS_HOME")) + "/tools/FlameGraph/";
+    std::string svg_content;
+    st = PprofUtils::generate_flamegraph_of_folded_stacks(
+            folded_stacks, flamegraph_install_dir, "CPU of query " + print_id(query_id),
+            &svg_content);
+    if (!st.ok()) {
+        HttpChannel::send_reply(req, HttpStatus::INTERNAL_SERVER_ERROR, st.to_string());
+        return;
+    }
+    req->add_output_header(HttpHeaders::CONTENT_TYPE, HEADER_SVG.c_str());
+    HttpChannel::send_reply(req, HttpStatus::OK, svg_content);
+}
+
+} // end namespace doris
@@ -17,8 +17,10 @@
 
 #include "http/action/stream_load.h"
 
+#include <algorithm>
 #include <deque>
 #include <future>
+#include <set>
 #include <sstream>
 
 // use string iequal
@@ -47,7 +49,9 @@
 #include "runtime/exec_env.h"
 #include "runtime/fragment_mgr.h"
 #include "runtime/load_path_mgr.h"
+#include "runtime/message_body_sink.h"
 #include "runtime/plan_fragment_executor.h"
+#include "runtime/stream_load/group_commit_mgr.h"
 #include "runtime/stream_load/new_load_stream_mgr.h"
 #include "runtime/stream_load/stream_load_context.h"
 #include "runtime/stream_load/stream_load_executor.h"
@@ -154,7 +158,7 @@ void StreamLoadAction::handle(HttpRequest* req) {
 
     // status already set to fail
     if (ctx->status.ok()) {
-        ctx->status = _handle(ctx);
+        ctx->status = ctx->group_commit ? _handle_group_commit(req, ctx) : _handle(ctx);
         if (!ctx->status.ok() && !ctx->status.is<PUBLISH_TIMEOUT>()) {
             LOG(WARNING) << "handle streaming load failed, id=" << ctx->id
                          << ", errmsg=" << ctx->status;
@@ -220,6 +224,83 @@ Status StreamLoadAction::_handle(std::shared_ptr<StreamLoadContext> ctx) {
     return Status::OK();
 }
 
+// The loads can be merged only if their plans are the same, so the key has all the headers
+// except the ones about the http request itself.
+static std::string group_commit_key(HttpRequest* http_req, const StreamLoadContext& ctx) {
+    static const std::set<std::string> ignored_headers = {
+            to_lower(HttpHeaders::ACCEPT),
+            to_lower(HttpHeaders::CONNECTION),
+            to_lower(HttpHeaders::CONTENT_LENGTH),
+            to_lower(HttpHeaders::EXPECT),
+            to_lower(HttpHeaders::HOST),
+            to_lower(HttpHeaders::TRANSFER_ENCODING),
+            to_lower(HttpHeaders::USER_AGENT),
+            HTTP_TIMEOUT,
+            HTTP_COMMENT};
+    std::vector<std::string> headers;
+    for (const auto& header : http_req->headers()) {
+        auto name = to_lower(header.first);
+        if (ignored_headers.count(name) == 0) {
+            headers.push_back(name + ":" + header.second);
+        }
+    }
+    std::sort(headers.begin(), headers.end());
+    std::string key = ctx.db + "." + ctx.table;
+    for (const auto& header : headers) {
+        key += "\n" + header;
+    }
+    return key;
+}
+
+Status StreamLoadAction::_handle_group_commit(HttpRequest* http_req,
+                                              std::shared_ptr<StreamLoadContext> ctx) {
+    if (ctx->body_bytes > 0 && ctx->receive_bytes != ctx->body_bytes) {
+        LOG(WARNING) << "recevie body don't equal with body bytes, body_bytes=" << ctx->body_bytes
+                     << ", receive_bytes=" << ctx->receive_bytes << ", id=" << ctx->id;
+        return Status::InternalError("receive body don't equal with body bytes");
+    }
+    auto body = static_cast<MessageBodyStringSink*>(ctx->body_sink.get())->take_data();
+    if (!body.empty() && body.back() != '\n') {
+        body.push_back('\n');
+    }
+    // the first load of the group begins the transaction and plans the load by its headers
+    return _exec_env->group_commit_mgr()->commit(
+            group_commit_key(http_req, *ctx), ctx, body,
+            [this, http_req](std::shared_ptr<StreamLoadContext> group_ctx) {
+                int64_t begin_txn_start_time = MonotonicNanos();
+                RETURN_IF_ERROR(_exec_env->stream_load_executor()->begin_txn(group_ctx.get()));
+                group_ctx->begin_txn_cost_nanos = MonotonicNanos() - begin_txn_start_time;
+                return _process_put(http_req, group_ctx);
+            });
+}
+
+// Only the small loads whose bodies can be concatenated by lines can use group commit.
+static Status check_group_commit(HttpRequest* http_req, const StreamLoadContext& ctx) {
+    if (!http_req->header(HTTP_LABEL_KEY).empty() || ctx.two_phase_commit) {
+        return Status::InvalidArgument(
+                "label and two phase commit are not supported by group commit");
+    }
+    if (!http_req->header(HTTP_LINE_DELIMITER).empty() ||
+        !http_req->header(HTTP_SKIP_LINES).empty() ||
+        !http_req->header(HTTP_PARSE_PARALLELISM).empty()) {
+        return Status::InvalidArgument(
+                "line_delimiter, skip_lines and parse_parallelism are not supported by group "
+                "commit");
+    }
+    bool by_line = (ctx.format == TFileFormatType::FORMAT_CSV_PLAIN && ctx.header_type.empty()) ||
+                   (ctx.format == TFileFormatType::FORMAT_JSON &&
+                    iequal(http_req->header(HTTP_READ_JSON_BY_LINE), "true"));
+    if (!by_line) {
+        return Status::InvalidArgument(
+                "only plain csv and json read by line are supported by group commit");
+    }
+    if (ctx.body_bytes > static_cast<size_t>(config::group_commit_max_bytes)) {
+        return Status::InvalidArgument("body exceed the max size of group commit: {}, data: {}",
+                                       config::group_commit_max_bytes, ctx.body_bytes);
+    }
+    return Status::OK();
+}
+
 int StreamLoadAction::on_header(HttpRequest* req) {
     streaming_load_current_processing->increment(1);
 
@@ -336,6 +417,20 @@ Status StreamLoadAction::_on_header(HttpRequest* http_req, std::shared_ptr<Strea
     if (!http_req->header(HTTP_COMMENT).empty()) {
         ctx->load_comment = http_req->header(HTTP_COMMENT);
     }
+    if (iequal(http_req->header(HTTP_GROUP_COMMIT), "true")) {
+        RETURN_IF_ERROR(check_group_commit(http_req, *ctx));
+#ifndef BE_TEST
+        if (ctx->body_bytes == 0) {
+            evhttp_connection_set_max_body_size(
+                    evhttp_request_get_connection(http_req->get_evhttp_request()),
+                    config::group_commit_max_bytes);
+        }
+#endif
+        // the body is kept in memory, and loaded with the others in handle()
+        ctx->group_commit = true;
+        ctx->body_sink = std::make_shared<MessageBodyStringSink>();
+        return Status::OK();
+    }
     // begin transaction
     int64_t begin_txn_start_time = MonotonicNanos();
     RETURN_IF_ERROR(_exec_env->stream_load_executor()->begin_txn(ctx.get()));
@@ -345,6 +440,13 @@ Status StreamLoadAction::_on_header(HttpRequest* http_req, std::shared_ptr<Strea
     return _process_put(http_req, ctx);
 }
 
+// The chunks are released by the scanners after they are parsed, maybe after the action
+// is destroyed, so the pool is never freed.
+static ByteBufferPool* chunk_buffer_pool() {
+    static auto* pool = new ByteBufferPool(128 * 1024, config::stream_load_max_pooled_chunks);
+    return pool;
+}
+
 void StreamLoadAction::on_chunk_data(HttpRequest* req) {
     std::shared_ptr<StreamLoadContext> ctx =
             std::static_pointer_cast<StreamLoadContext>(req->handler_ctx());
@@ -357,7 +459,7 @@ void StreamLoadAction::on_chunk_data(HttpRequest* req) {
 
     int64_t start_read_data_time = MonotonicNanos();
     while (evbuffer_get_length(evbuf) > 0) {
-        auto bb = ByteBuffer::allocate(128 * 1024);
+        auto bb = chunk_buffer_pool()->allocate();
         auto remove_bytes = evbuffer_remove(evbuf, bb->ptr, bb->capacity);
         bb->pos = remove_bytes;
         bb->flip();
@@ -385,6 +487,31 @@ void StreamLoadAction::free_handler_ctx(std::shared_ptr<void> param) {
     ctx->exec_env()->new_load_stream_mgr()->remove(ctx->id);
 }
 
+// The body can be split by lines and parsed by several scanners only if its lines are
+// independent, that is a plain csv without header lines, or a json with an object per line.
+// The lines of different chunks are not loaded in their order in the body, so the loads to
+// a unique key table without sequence column should not set the header.
+static int get_parse_parallelism(HttpRequest* http_req, const StreamLoadContext& ctx) {
+    if (http_req->header(HTTP_PARSE_PARALLELISM).empty()) {
+        return 1;
+    }
+    int parallelism = std::min(std::atoi(http_req->header(HTTP_PARSE_PARALLELISM).c_str()),
+                               config::stream_load_max_parse_parallelism);
+    // only the default line delimiter is supported
+    if (parallelism <= 1 || !http_req->header(HTTP_LINE_DELIMITER).empty() ||
+        !http_req->header(HTTP_SKIP_LINES).empty()) {
+        return 1;
+    }
+    if (ctx.format == TFileFormatType::FORMAT_CSV_PLAIN && ctx.header_type.empty()) {
+        return parallelism;
+    }
+    if (ctx.format == TFileFormatType::FORMAT_JSON &&
+        iequal(http_req->header(HTTP_READ_JSON_BY_LINE), "true")) {
+        return parallelism;
+    }
+    return 1;
+}
+
 Status StreamLoadAction::_process_put(HttpRequest* http_req,
                                       std::shared_ptr<StreamLoadContext> ctx) {
     // Now we use stream
@@ -401,9 +528,15 @@ Status StreamLoadAction::_process_put(HttpRequest* http_req,
     request.__set_header_type(ctx->header_type);
     request.__set_loadId(ctx->id.to_thrift());
     if (ctx->use_streaming) {
-        auto pipe = std::make_shared<io::StreamLoadPipe>(
-                io::kMaxPipeBufferedBytes /* max_buffered_bytes */, 64 * 1024 /* min_chunk_size */,
-                ctx->body_bytes /* total_length */);
+        std::shared_ptr<io::StreamLoadPipe> pipe;
+        int parse_parallelism = get_parse_parallelism(http_req, *ctx);
+        if (parse_parallelism > 1) {
+            pipe = std::make_shared<io::LineSplitStreamLoadPipe>(parse_parallelism, "\n");
+        } else {
+            pipe = std::make_shared<io::StreamLoadPipe>(
+                    io::kMaxPipeBufferedBytes /* max_buffered_bytes */,
+                    64 * 1024 /* min_chunk_size */, ctx->body_bytes /* total_length */);
+        }
         request.fileType = TFileType::FILE_STREAM;
         ctx->body_sink = pipe;
         ctx->pipe = pipe;
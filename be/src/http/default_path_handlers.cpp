@@ -37,7 +37,9 @@
 #include "util/debug_util.h"
 #include "util/perf_counters.h"
 #include "util/pretty_printer.h"
+#include "util/query_cpu_sampler.h"
 #include "util/thread.h"
+#include "util/time.h"
 
 using std::vector;
 using std::shared_ptr;
@@ -371,6 +373,50 @@ void cpu_handler(const WebPageHandler::ArgumentMap& args, std::stringstream* out
 #endif
 }
 
+void query_cpu_handler(const WebPageHandler::ArgumentMap& args, std::stringstream* output) {
+    (*output) << "<h2>Query CPU Profile</h2>" << std::endl;
+    auto* sampler = QueryCpuSampler::instance();
+    (*output) << "<pre>" << std::endl;
+    if (sampler->frequency() == 0) {
+        (*output) << "The stacks of the queries are not sampled, set the BE config "
+                     "'query_cpu_sampling_frequency' to enable it, e.g."
+                  << std::endl;
+        (*output) << std::endl;
+        (*output) << "    curl -X POST \"http://localhost:" << config::webserver_port
+                  << "/api/update_config?query_cpu_sampling_frequency=99\"" << std::endl;
+    } else {
+        (*output) << "The stacks of the queries are sampled " << sampler->frequency()
+                  << " times per CPU second, " << sampler->dropped_samples()
+                  << " samples are dropped." << std::endl;
+    }
+    (*output) << std::endl;
+    (*output) << "The flame graph needs the FlameGraph placed under 'be/tools/FlameGraph'."
+              << std::endl;
+    (*output) << "</pre>" << std::endl;
+
+    (*output) << "<table data-toggle='table' "
+                 "       data-pagination='true' "
+                 "       data-search='true' "
+                 "       class='table table-striped'>\n";
+    (*output) << "<thead><tr>"
+                 "<th>Query Id</th>"
+                 "<th data-sortable='true'>Samples</th>"
+                 "<th data-sortable='true'>Last Sample Time</th>"
+                 "<th>Flame Graph</th>"
+                 "<th>Folded Stacks</th>"
+                 "</tr></thead>";
+    (*output) << "<tbody>\n";
+    for (const auto& query : sampler->list_queries()) {
+        std::string query_id = print_id(query.query_id);
+        (*output) << strings::Substitute(
+                "<tr><td>$0</td><td>$1</td><td>$2</td>"
+                "<td><a href='/api/query_cpu_profile?query_id=$0&type=flamegraph'>svg</a></td>"
+                "<td><a href='/api/query_cpu_profile?query_id=$0'>text</a></td></tr>\n",
+                query_id, query.samples, ToStringFromUnix(query.last_sample_time));
+    }
+    (*output) << "</tbody></table>\n";
+}
+
 void add_default_path_handlers(WebPageHandler* web_page_handler) {
     // TODO(yingchun): logs_handler is not implemented yet, so not show it on navigate bar
     web_page_handler->register_page("/logs", "Logs", logs_handler, false /* is_on_nav_bar */);
@@ -386,6 +432,8 @@ void add_default_path_handlers(WebPageHandler* web_page_handler) {
     web_page_handler->register_page("/heap", "Heap Profile", heap_handler,
                                     true /* is_on_nav_bar */);
     web_page_handler->register_page("/cpu", "CPU Profile", cpu_handler, true /* is_on_nav_bar */);
+    web_page_handler->register_page("/query_cpu", "Query CPU Profile", query_cpu_handler,
+                                    true /* is_on_nav_bar */);
     register_thread_display_page(web_page_handler);
     web_page_handler->register_template_page(
             "/tablets_page", "Tablets",
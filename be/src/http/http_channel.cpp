@@ -74,6 +74,16 @@ void HttpChannel::send_file(HttpRequest* request, int fd, size_t off, size_t siz
     evbuffer_free(evb);
 }
 
+void HttpChannel::send_reference(HttpRequest* request, const char* data, size_t size,
+                                 void (*cleanup)(const void* data, size_t size, void* arg),
+                                 void* arg) {
+    auto evb = evbuffer_new();
+    evbuffer_add_reference(evb, data, size, cleanup, arg);
+    evhttp_send_reply(request->get_evhttp_request(), HttpStatus::OK,
+                      default_reason(HttpStatus::OK).c_str(), evb);
+    evbuffer_free(evb);
+}
+
 bool HttpChannel::compress_content(const std::string& accept_encoding, const std::string& input,
                                    std::string* output) {
     // Don't bother compressing empty content.
@@ -46,6 +46,12 @@ public:
 
     static void send_file(HttpRequest* request, int fd, size_t off, size_t size);
 
+    // send 200(OK) reply with the data without copying it, `cleanup(data, size, arg)` is called
+    // after the data is sent
+    static void send_reference(HttpRequest* request, const char* data, size_t size,
+                               void (*cleanup)(const void* data, size_t size, void* arg),
+                               void* arg);
+
     static bool compress_content(const std::string& accept_encoding, const std::string& input,
                                  std::string* output);
 };
@@ -170,7 +170,8 @@ Status HttpClient::execute(const std::function<bool(const void* data, size_t len
     return Status::OK();
 }
 
-Status HttpClient::download(const std::string& local_path) {
+Status HttpClient::download(const std::string& local_path,
+                            const std::function<void(size_t length)>& on_data) {
     // set method to GET
     set_method(GET);
 
@@ -187,7 +188,7 @@ Status HttpClient::download(const std::string& local_path) {
         return Status::InternalError("open file failed");
     }
     Status status;
-    auto callback = [&status, &fp, &local_path](const void* data, size_t length) {
+    auto callback = [&status, &fp, &local_path, &on_data](const void* data, size_t length) {
         auto res = fwrite(data, length, 1, fp.get());
         if (res != 1) {
             LOG(WARNING) << "fail to write data to file, file=" << local_path
@@ -195,6 +196,9 @@ Status HttpClient::download(const std::string& local_path) {
             status = Status::InternalError("fail to write data when download");
             return false;
         }
+        if (on_data) {
+            on_data(length);
+        }
         return true;
     };
     RETURN_IF_ERROR(execute(callback));
@@ -20,6 +20,7 @@
 #include <curl/curl.h>
 
 #include <cstdio>
+#include <functional>
 #include <string>
 
 #include "common/status.h"
@@ -122,8 +123,10 @@ public:
     }
 
     // helper function to download a file, you can call this function to download
-    // a file to local_path
-    Status download(const std::string& local_path);
+    // a file to local_path. `on_data` is called with the length of each piece of the data after
+    // it's written, e.g. to throttle the download.
+    Status download(const std::string& local_path,
+                    const std::function<void(size_t length)>& on_data = {});
 
     Status execute_post_request(const std::string& payload, std::string* response);
 
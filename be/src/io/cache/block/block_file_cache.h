@@ -75,6 +75,10 @@ public:
 
     static Key hash(const std::string& path);
 
+    /// The shard of the key among the caches of a cache path. The key is a hash itself, its high
+    /// half is used since the cache path of a key is chosen by KeyHash of both halves.
+    static size_t shard_of(const Key& key, size_t num_shards) { return key.key.high % num_shards; }
+
     std::string get_path_in_local_cache(const Key& key, size_t offset, bool is_persistent) const;
 
     std::string get_path_in_local_cache(const Key& key) const;
@@ -106,6 +110,9 @@ public:
 
     virtual size_t get_file_segments_num(bool is_persistent) const = 0;
 
+    /// Appends the keys of the files having downloaded segments in the cache.
+    virtual void get_cached_keys(std::vector<Key>* keys) const = 0;
+
     IFileCache& operator=(const IFileCache&) = delete;
     IFileCache(const IFileCache&) = delete;
 
@@ -130,6 +137,10 @@ protected:
                         std::lock_guard<std::mutex>& cache_lock,
                         std::lock_guard<std::mutex>& segment_lock) = 0;
 
+    /// Called without the cache lock when the file of a block is fully written.
+    virtual void on_file_block_downloaded(const Key& key, size_t offset, size_t size,
+                                          bool is_persistent) {}
+
     class LRUQueue {
     public:
         struct FileKeyAndOffset {
@@ -20,6 +20,8 @@
 
 #include "io/cache/block/block_file_cache_factory.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
 
 #include "common/config.h"
@@ -48,21 +50,33 @@ Status FileCacheFactory::create_file_cache(const std::string& cache_base_path,
         }
     }
 
-    std::unique_ptr<IFileCache> cache =
-            std::make_unique<LRUFileCache>(cache_base_path, file_cache_settings);
-    RETURN_IF_ERROR(cache->initialize());
+    // Every shard takes an equal part of the limits, the keys are spread evenly among them.
+    FileCacheSettings shard_settings = file_cache_settings;
+    auto split = [this](size_t limit) { return (limit + _num_shards - 1) / _num_shards; };
+    shard_settings.max_size = split(file_cache_settings.max_size);
+    shard_settings.max_elements = split(file_cache_settings.max_elements);
+    shard_settings.persistent_max_size = split(file_cache_settings.persistent_max_size);
+    shard_settings.persistent_max_elements = split(file_cache_settings.persistent_max_elements);
+    shard_settings.max_query_cache_size = split(file_cache_settings.max_query_cache_size);
+
     std::string file_cache_type;
-    switch (type) {
-    case NORMAL:
-        _caches.push_back(std::move(cache));
-        file_cache_type = "NORMAL";
-        break;
-    case DISPOSABLE:
-        _disposable_cache.push_back(std::move(cache));
-        file_cache_type = "DISPOSABLE";
-        break;
+    for (size_t shard_idx = 0; shard_idx < _num_shards; ++shard_idx) {
+        std::unique_ptr<IFileCache> cache = std::make_unique<LRUFileCache>(
+                cache_base_path, shard_settings, shard_idx, _num_shards);
+        RETURN_IF_ERROR(cache->initialize());
+        switch (type) {
+        case NORMAL:
+            _caches.push_back(std::move(cache));
+            file_cache_type = "NORMAL";
+            break;
+        case DISPOSABLE:
+            _disposable_cache.push_back(std::move(cache));
+            file_cache_type = "DISPOSABLE";
+            break;
+        }
     }
     LOG(INFO) << "[FileCache] path: " << cache_base_path << " type: " << file_cache_type
+              << " shards: " << _num_shards
               << " normal_size: " << file_cache_settings.max_size
               << " normal_element_size: " << file_cache_settings.max_elements
               << " persistent_size: " << file_cache_settings.persistent_max_size
@@ -70,15 +84,23 @@ Status FileCacheFactory::create_file_cache(const std::string& cache_base_path,
     return Status::OK();
 }
 
+CloudFileCachePtr FileCacheFactory::_get_shard(
+        const std::vector<std::unique_ptr<IFileCache>>& caches, const IFileCache::Key& key) {
+    // the shards of a path are adjacent, the path is chosen in the same way as without shards
+    size_t num_paths = caches.size() / _num_shards;
+    size_t path_idx = KeyHash()(key) % num_paths;
+    return caches[path_idx * _num_shards + IFileCache::shard_of(key, _num_shards)].get();
+}
+
 CloudFileCachePtr FileCacheFactory::get_by_path(const IFileCache::Key& key) {
-    return _caches[KeyHash()(key) % _caches.size()].get();
+    return _get_shard(_caches, key);
 }
 
 CloudFileCachePtr FileCacheFactory::get_disposable_cache(const IFileCache::Key& key) {
     if (_disposable_cache.empty()) {
         return nullptr;
     }
-    return _disposable_cache[KeyHash()(key) % _caches.size()].get();
+    return _get_shard(_disposable_cache, key);
 }
 
 std::vector<IFileCache::QueryFileCacheContextHolderPtr> FileCacheFactory::get_query_context_holders(
@@ -90,5 +112,39 @@ std::vector<IFileCache::QueryFileCacheContextHolderPtr> FileCacheFactory::get_qu
     return holders;
 }
 
+FileCacheFactory::CachedKeySummary FileCacheFactory::get_cached_key_summary(double fpp) {
+    std::vector<IFileCache::Key> keys;
+    for (const auto& cache : _caches) {
+        cache->get_cached_keys(&keys);
+    }
+    // the persistent and the normal segments of a file share the key
+    std::sort(keys.begin(), keys.end(),
+              [](const IFileCache::Key& l, const IFileCache::Key& r) { return l.key < r.key; });
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    return build_cached_key_summary(keys, fpp);
+}
+
+FileCacheFactory::CachedKeySummary FileCacheFactory::build_cached_key_summary(
+        const std::vector<IFileCache::Key>& keys, double fpp) {
+    fpp = std::clamp(fpp, 1e-6, 0.5);
+    CachedKeySummary summary;
+    summary.num_keys = keys.size();
+    // the optimal bloom filter: m = -n * ln(p) / ln(2)^2 bits and k = m / n * ln(2) hashes
+    double num_bits = -std::max<double>(keys.size(), 1) * std::log(fpp) / (M_LN2 * M_LN2);
+    size_t num_bytes = std::max<size_t>(8, (static_cast<size_t>(num_bits) + 7) / 8);
+    summary.num_hashes = std::clamp<size_t>(
+            std::lround(num_bytes * 8.0 / std::max<double>(keys.size(), 1) * M_LN2), 1, 16);
+    summary.bits.assign(num_bytes, '\0');
+    uint64_t total_bits = num_bytes * 8;
+    for (const auto& key : keys) {
+        // the key is a hash already, its halves are used as two independent hashes
+        for (size_t i = 0; i < summary.num_hashes; ++i) {
+            uint64_t bit = (key.key.low + i * key.key.high) % total_bits;
+            summary.bits[bit / 8] |= static_cast<char>(1 << (bit % 8));
+        }
+    }
+    return summary;
+}
+
 } // namespace io
 } // namespace doris
@@ -46,11 +46,31 @@ public:
     CloudFileCachePtr get_disposable_cache(const IFileCache::Key& key);
     std::vector<IFileCache::QueryFileCacheContextHolderPtr> get_query_context_holders(
             const TUniqueId& query_id);
+
+    /// A bloom filter of the files cached by this BE, so the file ranges of a file can be
+    /// assigned to the BE caching it. The key of a file is IFileCache::hash of its cache path,
+    /// and for i in [0, num_hashes), bit (key.low + i * key.high) % (bits.size() * 8) is set,
+    /// where bit j is (bits[j / 8] >> (j % 8)) & 1.
+    struct CachedKeySummary {
+        size_t num_keys = 0;
+        size_t num_hashes = 0;
+        std::string bits;
+    };
+    CachedKeySummary get_cached_key_summary(double fpp);
+
+    /// Builds the summary of the keys with the false positive probability fpp.
+    static CachedKeySummary build_cached_key_summary(const std::vector<IFileCache::Key>& keys,
+                                                     double fpp);
     FileCacheFactory() = default;
     FileCacheFactory& operator=(const FileCacheFactory&) = delete;
     FileCacheFactory(const FileCacheFactory&) = delete;
 
 private:
+    CloudFileCachePtr _get_shard(const std::vector<std::unique_ptr<IFileCache>>& caches,
+                                 const IFileCache::Key& key);
+
+    // read once, the shards of the cached keys must not change after the caches are created
+    const size_t _num_shards = config::file_cache_num_shards;
     std::vector<std::unique_ptr<IFileCache>> _caches;
     std::vector<std::unique_ptr<IFileCache>> _disposable_cache;
 };
@@ -0,0 +1,179 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "io/cache/block/block_file_cache_meta_log.h"
+
+#include <filesystem>
+#include <map>
+#include <tuple>
+
+#include "io/fs/local_file_system.h"
+#include "util/coding.h"
+
+namespace doris {
+namespace io {
+
+namespace {
+
+constexpr char MAGIC[] = "DFCMLOG1";
+constexpr size_t MAGIC_SIZE = sizeof(MAGIC) - 1;
+constexpr size_t RECORD_SIZE = 1 + 16 + 8 + 8 + 1;
+constexpr uint8_t OP_ADD = 1;
+constexpr uint8_t OP_REMOVE = 2;
+
+void encode_record(uint8_t* buf, uint8_t op, const IFileCache::Key& key, size_t offset,
+                   size_t size, bool is_persistent) {
+    buf[0] = op;
+    encode_fixed64_le(buf + 1, key.key.low);
+    encode_fixed64_le(buf + 9, key.key.high);
+    encode_fixed64_le(buf + 17, offset);
+    encode_fixed64_le(buf + 25, size);
+    buf[33] = is_persistent;
+}
+
+} // namespace
+
+FileCacheMetaLog::~FileCacheMetaLog() {
+    if (_writer != nullptr) {
+        _writer->close();
+    }
+}
+
+Status FileCacheMetaLog::load(std::vector<Entry>* entries) const {
+    const FileSystemSPtr& fs = global_local_filesystem();
+    bool exists = false;
+    RETURN_IF_ERROR(fs->exists(_path, &exists));
+    if (!exists) {
+        return Status::NotFound("no file cache meta log {}", _path);
+    }
+    int64_t file_size = 0;
+    RETURN_IF_ERROR(fs->file_size(_path, &file_size));
+    if (file_size < static_cast<int64_t>(MAGIC_SIZE)) {
+        return Status::NotFound("broken file cache meta log {}", _path);
+    }
+    std::string data(file_size, '\0');
+    FileReaderSPtr reader;
+    RETURN_IF_ERROR(fs->open_file(_path, &reader));
+    size_t bytes_read = 0;
+    RETURN_IF_ERROR(reader->read_at(0, Slice(data.data(), data.size()), &bytes_read));
+    RETURN_IF_ERROR(reader->close());
+    if (bytes_read != data.size() || data.compare(0, MAGIC_SIZE, MAGIC) != 0) {
+        return Status::NotFound("broken file cache meta log {}", _path);
+    }
+
+    // (key, is_persistent, offset) -> size, the later records override the earlier ones
+    std::map<std::tuple<uint128_t, bool, size_t>, size_t> blocks;
+    const auto* buf = reinterpret_cast<const uint8_t*>(data.data());
+    for (size_t pos = MAGIC_SIZE; pos + RECORD_SIZE <= data.size(); pos += RECORD_SIZE) {
+        const uint8_t* record = buf + pos;
+        uint128_t key(decode_fixed64_le(record + 1), decode_fixed64_le(record + 9));
+        size_t offset = decode_fixed64_le(record + 17);
+        size_t size = decode_fixed64_le(record + 25);
+        bool is_persistent = record[33] != 0;
+        if (record[0] == OP_ADD) {
+            blocks[{key, is_persistent, offset}] = size;
+        } else if (record[0] == OP_REMOVE) {
+            blocks.erase({key, is_persistent, offset});
+        } else {
+            return Status::NotFound("broken file cache meta log {}, unknown op {} at {}", _path,
+                                    record[0], pos);
+        }
+    }
+    entries->reserve(blocks.size());
+    for (auto& [block, size] : blocks) {
+        entries->emplace_back(IFileCache::Key(std::get<0>(block)), std::get<2>(block), size,
+                              std::get<1>(block));
+    }
+    return Status::OK();
+}
+
+Status FileCacheMetaLog::reset(const std::function<void(std::vector<Entry>*)>& get_entries) {
+    std::lock_guard l(_mutex);
+    if (_writer != nullptr) {
+        RETURN_IF_ERROR(_writer->close());
+        _writer.reset();
+    }
+    std::vector<Entry> entries;
+    get_entries(&entries);
+    std::string tmp_path = _path + ".tmp";
+    FileWriterPtr writer;
+    RETURN_IF_ERROR(global_local_filesystem()->create_file(tmp_path, &writer));
+
+    std::string data(MAGIC, MAGIC_SIZE);
+    data.resize(MAGIC_SIZE + entries.size() * RECORD_SIZE);
+    auto* buf = reinterpret_cast<uint8_t*>(data.data()) + MAGIC_SIZE;
+    for (auto& entry : entries) {
+        encode_record(buf, OP_ADD, entry.key, entry.offset, entry.size, entry.is_persistent);
+        buf += RECORD_SIZE;
+    }
+    RETURN_IF_ERROR(writer->append(Slice(data)));
+    RETURN_IF_ERROR(writer->finalize());
+
+    // The writer keeps appending to the renamed file.
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, _path, ec);
+    if (ec) {
+        writer->abort();
+        return Status::IOError("cannot rename {} to {}: {}", tmp_path, _path, ec.message());
+    }
+    _writer = std::move(writer);
+    _num_records = entries.size();
+    return Status::OK();
+}
+
+Status FileCacheMetaLog::remove() {
+    std::lock_guard l(_mutex);
+    if (_writer != nullptr) {
+        RETURN_IF_ERROR(_writer->close());
+        _writer.reset();
+    }
+    bool exists = false;
+    RETURN_IF_ERROR(global_local_filesystem()->exists(_path, &exists));
+    return exists ? global_local_filesystem()->delete_file(_path) : Status::OK();
+}
+
+void FileCacheMetaLog::add(const IFileCache::Key& key, size_t offset, size_t size,
+                           bool is_persistent) {
+    _append(OP_ADD, key, offset, size, is_persistent);
+}
+
+void FileCacheMetaLog::remove(const IFileCache::Key& key, size_t offset, bool is_persistent) {
+    _append(OP_REMOVE, key, offset, 0, is_persistent);
+}
+
+void FileCacheMetaLog::_append(uint8_t op, const IFileCache::Key& key, size_t offset, size_t size,
+                               bool is_persistent) {
+    uint8_t record[RECORD_SIZE];
+    encode_record(record, op, key, offset, size, is_persistent);
+    std::lock_guard l(_mutex);
+    if (_writer == nullptr) {
+        return;
+    }
+    Status st = _writer->append(Slice(record, RECORD_SIZE));
+    if (!st.ok()) {
+        // Stop logging and drop the log, so the next startup scans the cache directory.
+        LOG(WARNING) << "failed to append file cache meta log " << _path << ": " << st;
+        _writer->close();
+        _writer.reset();
+        global_local_filesystem()->delete_file(_path);
+        return;
+    }
+    ++_num_records;
+}
+
+} // namespace io
+} // namespace doris
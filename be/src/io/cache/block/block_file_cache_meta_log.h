@@ -0,0 +1,90 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "io/cache/block/block_file_cache.h"
+#include "io/fs/file_writer.h"
+
+namespace doris {
+namespace io {
+
+// An append-only log of the downloaded file blocks of a file cache, so that the cache is restored
+// at startup by reading the log instead of scanning the whole cache directory.
+//
+// A block is added to the log after its file is written, and removed after its file is deleted.
+// After a crash the log may miss the last added blocks, whose files are left unused, or still have
+// the last removed blocks, which the cache drops when it finds their files missing.
+//
+// The log is a header followed by fixed size records:
+//   | op (1) | key (16) | offset (8) | size (8) | is_persistent (1) |
+// A torn record at the end is ignored.
+class FileCacheMetaLog {
+public:
+    struct Entry {
+        IFileCache::Key key;
+        size_t offset;
+        size_t size;
+        bool is_persistent;
+
+        Entry(const IFileCache::Key& key_, size_t offset_, size_t size_, bool is_persistent_)
+                : key(key_), offset(offset_), size(size_), is_persistent(is_persistent_) {}
+    };
+
+    explicit FileCacheMetaLog(std::string path) : _path(std::move(path)) {}
+    ~FileCacheMetaLog();
+
+    // Reads the blocks in the log. Returns NotFound if there is no valid log.
+    Status load(std::vector<Entry>* entries) const;
+
+    // Replaces the log with the blocks from get_entries and opens it for appending. get_entries
+    // is called with the appends blocked, so a block is either in its result or appended later.
+    Status reset(const std::function<void(std::vector<Entry>*)>& get_entries);
+
+    // Deletes the log, it stays closed.
+    Status remove();
+
+    void add(const IFileCache::Key& key, size_t offset, size_t size, bool is_persistent);
+
+    void remove(const IFileCache::Key& key, size_t offset, bool is_persistent);
+
+    // The number of the records appended since the last reset(), including its blocks.
+    size_t num_records() const {
+        std::lock_guard l(_mutex);
+        return _num_records;
+    }
+
+    const std::string& path() const { return _path; }
+
+private:
+    void _append(uint8_t op, const IFileCache::Key& key, size_t offset, size_t size,
+                 bool is_persistent);
+
+    const std::string _path;
+    mutable std::mutex _mutex;
+    FileWriterPtr _writer;
+    size_t _num_records = 0;
+};
+
+} // namespace io
+} // namespace doris
@@ -121,6 +121,21 @@ void FileBlock::reset_downloader(std::lock_guard<std::mutex>& segment_lock) {
     reset_downloader_impl(segment_lock);
 }
 
+void FileBlock::set_async_downloader() {
+    std::lock_guard segment_lock(_mutex);
+    DCHECK(_download_state == State::DOWNLOADING);
+    DCHECK(is_downloader_impl(segment_lock)) << "Only the downloader can hand the download over";
+    _downloader_id = ASYNC_DOWNLOADER_ID;
+}
+
+void FileBlock::finish_async_download() {
+    std::lock_guard segment_lock(_mutex);
+    if (_downloader_id == ASYNC_DOWNLOADER_ID) {
+        reset_downloader_impl(segment_lock);
+    }
+    _cv.notify_all();
+}
+
 void FileBlock::reset_downloader_impl(std::lock_guard<std::mutex>& segment_lock) {
     if (_downloaded_size == range().size()) {
         set_downloaded(segment_lock);
@@ -217,6 +232,7 @@ Status FileBlock::set_downloaded(std::lock_guard<std::mutex>& /* segment_lock */
     _download_state = State::DOWNLOADED;
     _is_downloaded = true;
     _downloader_id.clear();
+    _cache->on_file_block_downloaded(key(), offset(), range().size(), _is_persistent);
     return Status::OK();
 }
 
@@ -285,6 +301,14 @@ FileBlocksHolder::~FileBlocksHolder() {
         auto current_file_segment_it = file_segment_it;
         auto& file_segment = *current_file_segment_it;
 
+        if (file_segment->is_downloaded()) {
+            /// A downloaded segment has no downloader to reset, so complete() is a no-op and the
+            /// cache lock is not needed. Releasing the pointer concurrently with the eviction only
+            /// makes the segment look unreleasable for one more round.
+            file_segment_it = file_segments.erase(current_file_segment_it);
+            continue;
+        }
+
         if (!cache) {
             cache = file_segment->_cache;
         }
@@ -114,6 +114,14 @@ public:
 
     void reset_downloader(std::lock_guard<std::mutex>& segment_lock);
 
+    /// Hands the download of the caller over to a background writer, the segment stays in
+    /// DOWNLOADING until finish_async_download() is called.
+    void set_async_downloader();
+
+    /// Called by the background writer after finalize_write() or a failed write, the segment
+    /// becomes EMPTY if it is not fully downloaded.
+    void finish_async_download();
+
     bool is_downloader() const;
 
     bool is_downloaded() const { return _is_downloaded.load(); }
@@ -122,6 +130,8 @@ public:
 
     static std::string get_caller_id();
 
+    static constexpr const char* ASYNC_DOWNLOADER_ID = "async_writer";
+
     size_t get_download_offset() const;
 
     size_t get_downloaded_size() const;
@@ -27,6 +27,7 @@
 
 #include "common/status.h"
 #include "io/cache/block/block_file_cache.h"
+#include "io/cache/block/block_file_cache_meta_log.h"
 #include "io/cache/block/block_file_cache_settings.h"
 #include "io/fs/local_file_system.h"
 #include "olap/iterators.h"
@@ -40,8 +41,18 @@ namespace doris {
 namespace io {
 
 LRUFileCache::LRUFileCache(const std::string& cache_base_path_,
-                           const FileCacheSettings& cache_settings_)
-        : IFileCache(cache_base_path_, cache_settings_) {}
+                           const FileCacheSettings& cache_settings_, size_t shard_idx,
+                           size_t num_shards)
+        : IFileCache(cache_base_path_, cache_settings_),
+          _shard_idx(shard_idx),
+          _num_shards(num_shards) {
+    DCHECK_LT(_shard_idx, _num_shards);
+    if (config::enable_file_cache_meta_log) {
+        _meta_log = std::make_unique<FileCacheMetaLog>(
+                fs::path(_cache_base_path) /
+                fmt::format("{}{}.{}", META_LOG_PREFIX, _shard_idx, _num_shards));
+    }
+}
 
 Status LRUFileCache::initialize() {
     std::lock_guard cache_lock(_mutex);
@@ -57,6 +68,7 @@ Status LRUFileCache::initialize() {
             }
             RETURN_IF_ERROR(write_file_cache_version());
         }
+        init_meta_log(cache_lock);
     }
     _is_initialized = true;
     return Status::OK();
@@ -102,6 +114,10 @@ FileBlocks LRUFileCache::get_impl(const Key& key, const TUniqueId& query_id, boo
                                   std::lock_guard<std::mutex>& cache_lock) {
     /// Given range = [left, right] and non-overlapping ordered set of file segments,
     /// find list [segment1, ..., segmentN] of segments which intersect with given range.
+    if (_num_unverified_cells > 0) {
+        verify_cells(key, is_persistent, range, cache_lock);
+    }
+
     auto file_key = std::make_pair(key, is_persistent);
     auto it = _files.find(file_key);
     if (it == _files.end()) {
@@ -607,6 +623,10 @@ void LRUFileCache::remove(const Key& key, bool is_persistent, size_t offset,
     if (cell->queue_iterator) {
         queue->remove(*cell->queue_iterator, cache_lock);
     }
+    if (cell->need_verify) {
+        --_num_unverified_cells;
+    }
+    bool is_downloaded = cell->file_segment->is_downloaded();
     auto file_key = std::make_pair(key, is_persistent);
     auto& offsets = _files[file_key];
     offsets.erase(offset);
@@ -634,9 +654,166 @@ void LRUFileCache::remove(const Key& key, bool is_persistent, size_t offset,
             }
         }
     }
+
+    if (_meta_log != nullptr && is_downloaded && _is_initialized) {
+        _meta_log->remove(key, offset, is_persistent);
+        // Rewrite the log when most of its records are stale.
+        size_t num_blocks = _queue.get_elements_num(cache_lock) +
+                            _persistent_queue.get_elements_num(cache_lock);
+        if (_meta_log->num_records() > 2 * num_blocks + META_LOG_MIN_STALE_RECORDS) {
+            reset_meta_log(cache_lock);
+        }
+    }
+}
+
+void LRUFileCache::on_file_block_downloaded(const Key& key, size_t offset, size_t size,
+                                            bool is_persistent) {
+    if (_meta_log != nullptr) {
+        _meta_log->add(key, offset, size, is_persistent);
+    }
+}
+
+bool LRUFileCache::load_cache_info_from_meta_log(
+        std::vector<std::pair<LRUQueue::Iterator, bool>>* queue_entries,
+        std::lock_guard<std::mutex>& cache_lock) {
+    if (_meta_log == nullptr || read_file_cache_version() != "2.0") {
+        return false;
+    }
+    std::vector<FileCacheMetaLog::Entry> entries;
+    Status st = _meta_log->load(&entries);
+    if (!st.ok()) {
+        LOG(INFO) << "scan the file cache directory " << _cache_base_path << ", " << st;
+        return false;
+    }
+    // The files of the blocks are checked when the blocks are first read, see verify_cells.
+    for (auto& entry : entries) {
+        if (shard_of(entry.key, _num_shards) != _shard_idx) {
+            continue;
+        }
+        if (!try_reserve(entry.key, TUniqueId(), entry.is_persistent, entry.offset, entry.size,
+                         cache_lock)) {
+            LOG(WARNING) << "Cache capacity changed (max size: " << _max_size << "), cached file "
+                         << get_path_in_local_cache(entry.key, entry.offset, entry.is_persistent)
+                         << " does not fit in cache anymore (size: " << entry.size << ")";
+            std::error_code ec;
+            fs::remove(get_path_in_local_cache(entry.key, entry.offset, entry.is_persistent), ec);
+            continue;
+        }
+        auto* cell = add_cell(entry.key, entry.is_persistent, entry.offset, entry.size,
+                              FileBlock::State::DOWNLOADED, cache_lock);
+        if (cell) {
+            cell->need_verify = true;
+            ++_num_unverified_cells;
+            queue_entries->emplace_back(*cell->queue_iterator, entry.is_persistent);
+        }
+    }
+    LOG(INFO) << "loaded " << queue_entries->size() << " file cache blocks from "
+              << _meta_log->path();
+    return true;
+}
+
+void LRUFileCache::init_meta_log(std::lock_guard<std::mutex>& cache_lock) {
+    if (_meta_log == nullptr) {
+        // a log left by the runs with the log enabled is stale now
+        remove_meta_logs(true);
+        return;
+    }
+    // the logs of the other shard numbers are stale
+    remove_meta_logs(false);
+    reset_meta_log(cache_lock);
+}
+
+void LRUFileCache::remove_meta_logs(bool all_shard_nums) {
+    std::string own_suffix = fmt::format(".{}", _num_shards);
+    std::error_code ec;
+    for (fs::directory_iterator it {_cache_base_path, ec}; !ec && it != fs::directory_iterator();
+         it.increment(ec)) {
+        std::string name = it->path().filename().native();
+        if (name.rfind(META_LOG_PREFIX, 0) != 0) {
+            continue;
+        }
+        bool own_shard_num = name.size() > own_suffix.size() &&
+                             name.compare(name.size() - own_suffix.size(), own_suffix.size(),
+                                          own_suffix) == 0;
+        if (all_shard_nums || !own_shard_num) {
+            std::error_code remove_ec;
+            fs::remove(it->path(), remove_ec);
+        }
+    }
+}
+
+void LRUFileCache::reset_meta_log(std::lock_guard<std::mutex>& /* cache_lock */) {
+    Status st = _meta_log->reset([this](std::vector<FileCacheMetaLog::Entry>* entries) {
+        for (auto& [file_key, cells] : _files) {
+            for (auto& [offset, cell] : cells) {
+                // is_downloaded() is set before the block is appended to the log, it's fine to
+                // log a block twice
+                if (cell.file_segment->is_downloaded()) {
+                    entries->emplace_back(file_key.first, offset, cell.size(), file_key.second);
+                }
+            }
+        }
+    });
+    if (!st.ok()) {
+        LOG(WARNING) << "failed to reset file cache meta log " << _meta_log->path() << ": " << st;
+        _meta_log->remove();
+    }
+}
+
+void LRUFileCache::verify_cells(const Key& key, bool is_persistent,
+                                const FileBlock::Range& range,
+                                std::lock_guard<std::mutex>& cache_lock) {
+    auto it = _files.find(std::make_pair(key, is_persistent));
+    if (it == _files.end()) {
+        return;
+    }
+    auto& cells = it->second;
+    auto cell_it = cells.lower_bound(range.left);
+    if (cell_it != cells.begin()) {
+        --cell_it;
+    }
+    std::vector<size_t> missed_offsets;
+    for (; cell_it != cells.end() && cell_it->first <= range.right; ++cell_it) {
+        auto& cell = cell_it->second;
+        if (!cell.need_verify) {
+            continue;
+        }
+        cell.need_verify = false;
+        --_num_unverified_cells;
+        std::error_code ec;
+        auto file_size =
+                fs::file_size(get_path_in_local_cache(key, cell_it->first, is_persistent), ec);
+        if ((ec || file_size != cell.size()) && cell.releasable()) {
+            missed_offsets.push_back(cell_it->first);
+        }
+    }
+    for (size_t offset : missed_offsets) {
+        LOG(WARNING) << "drop the file cache block with a missed or broken file, "
+                     << get_path_in_local_cache(key, offset, is_persistent);
+        auto file_segment = get_cell(key, is_persistent, offset, cache_lock)->file_segment;
+        std::lock_guard segment_lock(file_segment->_mutex);
+        remove(key, is_persistent, offset, cache_lock, segment_lock);
+    }
 }
 
 void LRUFileCache::load_cache_info_into_memory(std::lock_guard<std::mutex>& cache_lock) {
+    std::vector<std::pair<LRUQueue::Iterator, bool>> queue_entries;
+    if (!load_cache_info_from_meta_log(&queue_entries, cache_lock)) {
+        scan_cache_info(&queue_entries, cache_lock);
+    }
+
+    /// Shuffle cells to have random order in LRUQueue as at startup all cells have the same priority.
+    auto rng = std::default_random_engine(
+            static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::shuffle(queue_entries.begin(), queue_entries.end(), rng);
+    for (const auto& [it, is_persistent] : queue_entries) {
+        LRUQueue* queue = is_persistent ? &_persistent_queue : &_queue;
+        queue->move_to_end(it, cache_lock);
+    }
+}
+
+void LRUFileCache::scan_cache_info(std::vector<std::pair<LRUQueue::Iterator, bool>>* queue_entries,
+                                   std::lock_guard<std::mutex>& cache_lock) {
     /// version 1.0: cache_base_path / key / offset
     /// version 2.0: cache_base_path / key_prefix / key / offset
     if (USE_CACHE_VERSION2 && read_file_cache_version() != "2.0") {
@@ -674,11 +851,14 @@ void LRUFileCache::load_cache_info_into_memory(std::lock_guard<std::mutex>& cach
     Key key;
     uint64_t offset = 0;
     size_t size = 0;
-    std::vector<std::pair<LRUQueue::Iterator, bool>> queue_entries;
     auto scan_file_cache = [&](fs::directory_iterator& key_it) {
         for (; key_it != fs::directory_iterator(); ++key_it) {
             key = Key(
                     vectorized::unhex_uint<uint128_t>(key_it->path().filename().native().c_str()));
+            if (shard_of(key, _num_shards) != _shard_idx) {
+                // loaded by the other shards of the path
+                continue;
+            }
 
             fs::directory_iterator offset_it {key_it->path()};
             for (; offset_it != fs::directory_iterator(); ++offset_it) {
@@ -716,7 +896,7 @@ void LRUFileCache::load_cache_info_into_memory(std::lock_guard<std::mutex>& cach
                     auto* cell = add_cell(key, is_persistent, offset, size,
                                           FileBlock::State::DOWNLOADED, cache_lock);
                     if (cell) {
-                        queue_entries.emplace_back(*cell->queue_iterator, is_persistent);
+                        queue_entries->emplace_back(*cell->queue_iterator, is_persistent);
                     }
                 } else {
                     LOG(WARNING) << "Cache capacity changed (max size: " << _max_size
@@ -754,15 +934,6 @@ void LRUFileCache::load_cache_info_into_memory(std::lock_guard<std::mutex>& cach
         fs::directory_iterator key_it {_cache_base_path};
         scan_file_cache(key_it);
     }
-
-    /// Shuffle cells to have random order in LRUQueue as at startup all cells have the same priority.
-    auto rng = std::default_random_engine(
-            static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()));
-    std::shuffle(queue_entries.begin(), queue_entries.end(), rng);
-    for (const auto& [it, is_persistent] : queue_entries) {
-        LRUQueue* queue = is_persistent ? &_persistent_queue : &_queue;
-        queue->move_to_end(it, cache_lock);
-    }
 }
 
 Status LRUFileCache::write_file_cache_version() const {
@@ -835,6 +1006,18 @@ size_t LRUFileCache::get_available_cache_size_unlocked(
     return max_size - get_used_cache_size_unlocked(is_persistent, cache_lock);
 }
 
+void LRUFileCache::get_cached_keys(std::vector<Key>* keys) const {
+    std::lock_guard cache_lock(_mutex);
+    for (auto& [file_key, cells] : _files) {
+        for (auto& [_, cell] : cells) {
+            if (cell.file_segment->is_downloaded()) {
+                keys->push_back(file_key.first);
+                break;
+            }
+        }
+    }
+}
+
 size_t LRUFileCache::get_file_segments_num(bool is_persistent) const {
     std::lock_guard cache_lock(_mutex);
     return get_file_segments_num_unlocked(is_persistent, cache_lock);
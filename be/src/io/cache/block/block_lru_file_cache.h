@@ -31,6 +31,7 @@
 
 namespace doris {
 namespace io {
+class FileCacheMetaLog;
 
 /**
  * Local cache for remote filesystem files, represented as a set of non-overlapping non-empty file segments.
@@ -41,8 +42,11 @@ public:
     /**
      * cache_base_path: the file cache path
      * cache_settings: the file cache setttings
+     * shard_idx, num_shards: the cache only holds the keys of the shard among the num_shards
+     * caches sharing cache_base_path, see IFileCache::shard_of
      */
-    LRUFileCache(const std::string& cache_base_path, const FileCacheSettings& cache_settings);
+    LRUFileCache(const std::string& cache_base_path, const FileCacheSettings& cache_settings,
+                 size_t shard_idx = 0, size_t num_shards = 1);
 
     /**
      * get the files which range contain [offset, offset+size-1]
@@ -65,6 +69,8 @@ public:
 
     size_t get_file_segments_num(bool is_persistent) const override;
 
+    void get_cached_keys(std::vector<Key>* keys) const override;
+
 private:
     struct FileBlockCell {
         FileBlockSPtr file_segment;
@@ -82,9 +88,13 @@ private:
         FileBlockCell(FileBlockSPtr file_segment_, LRUFileCache* cache,
                       std::lock_guard<std::mutex>& cache_lock);
 
+        /// Set if the cell is loaded from the meta log, its file is checked when first read.
+        bool need_verify = false;
+
         FileBlockCell(FileBlockCell&& other) noexcept
                 : file_segment(std::move(other.file_segment)),
-                  queue_iterator(other.queue_iterator) {}
+                  queue_iterator(other.queue_iterator),
+                  need_verify(other.need_verify) {}
 
         FileBlockCell& operator=(const FileBlockCell&) = delete;
         FileBlockCell(const FileBlockCell&) = delete;
@@ -99,6 +109,15 @@ private:
     using CachedFiles =
             std::unordered_map<std::pair<Key, bool>, FileBlocksByOffset, HashCachedFileKey>;
 
+    const size_t _shard_idx;
+    const size_t _num_shards;
+
+    static constexpr const char* META_LOG_PREFIX = "meta_log.";
+    /// the meta log is rewritten if it has more stale records than this and the live ones
+    static constexpr size_t META_LOG_MIN_STALE_RECORDS = 100000;
+    std::unique_ptr<FileCacheMetaLog> _meta_log;
+    size_t _num_unverified_cells = 0;
+
     CachedFiles _files;
     LRUQueue _queue;
     LRUQueue _persistent_queue;
@@ -130,6 +149,25 @@ private:
 
     void load_cache_info_into_memory(std::lock_guard<std::mutex>& cache_lock);
 
+    void scan_cache_info(std::vector<std::pair<LRUQueue::Iterator, bool>>* queue_entries,
+                         std::lock_guard<std::mutex>& cache_lock);
+
+    bool load_cache_info_from_meta_log(
+            std::vector<std::pair<LRUQueue::Iterator, bool>>* queue_entries,
+            std::lock_guard<std::mutex>& cache_lock);
+
+    void init_meta_log(std::lock_guard<std::mutex>& cache_lock);
+
+    void remove_meta_logs(bool all_shard_nums);
+
+    void reset_meta_log(std::lock_guard<std::mutex>& cache_lock);
+
+    void verify_cells(const Key& key, bool is_persistent, const FileBlock::Range& range,
+                      std::lock_guard<std::mutex>& cache_lock);
+
+    void on_file_block_downloaded(const Key& key, size_t offset, size_t size,
+                                  bool is_persistent) override;
+
     Status write_file_cache_version() const;
 
     std::string read_file_cache_version() const;
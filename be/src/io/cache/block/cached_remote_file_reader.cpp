@@ -22,7 +22,13 @@
 #include "io/fs/file_reader.h"
 #include "olap/iterators.h"
 #include "olap/olap_common.h"
+#include "runtime/exec_env.h"
+#include "runtime/thread_context.h"
 #include "util/async_io.h"
+#include "util/doris_metrics.h"
+#include "util/stopwatch.hpp"
+#include "util/threadpool.h"
+#include "util/time.h"
 
 namespace doris {
 namespace io {
@@ -77,6 +83,8 @@ Status CachedRemoteFileReader::read_at_impl(size_t offset, Slice result, size_t*
     if (cache == nullptr) {
         return _remote_file_reader->read_at(offset, result, bytes_read, io_ctx);
     }
+    MonotonicStopWatch watch;
+    watch.start();
     ReadStatistics stats;
     stats.bytes_read = bytes_req;
     // if state == nullptr, the method is called for read footer
@@ -106,21 +114,27 @@ Status CachedRemoteFileReader::read_at_impl(size_t offset, Slice result, size_t*
 
     size_t empty_start = 0;
     size_t empty_end = 0;
+    std::unique_ptr<char[]> buffer;
+    ThreadPool* write_pool = config::enable_file_cache_async_write
+                                     ? ExecEnv::GetInstance()->file_cache_write_thread_pool()
+                                     : nullptr;
     if (!empty_segments.empty()) {
         empty_start = empty_segments.front()->range().left;
         empty_end = empty_segments.back()->range().right;
         size_t size = empty_end - empty_start + 1;
-        std::unique_ptr<char[]> buffer(new char[size]);
+        buffer.reset(new char[size]);
         RETURN_IF_ERROR(_remote_file_reader->read_at(empty_start, Slice(buffer.get(), size), &size,
                                                      io_ctx));
         for (auto& segment : empty_segments) {
             if (segment->state() == FileBlock::State::SKIP_CACHE) {
                 continue;
             }
-            char* cur_ptr = buffer.get() + segment->range().left - empty_start;
             size_t segment_size = segment->range().size();
-            RETURN_IF_ERROR(segment->append(Slice(cur_ptr, segment_size)));
-            RETURN_IF_ERROR(segment->finalize_write());
+            if (write_pool == nullptr) {
+                char* cur_ptr = buffer.get() + segment->range().left - empty_start;
+                RETURN_IF_ERROR(segment->append(Slice(cur_ptr, segment_size)));
+                RETURN_IF_ERROR(segment->finalize_write());
+            }
             stats.write_in_file_cache++;
             stats.bytes_write_in_file_cache += segment_size;
         }
@@ -183,11 +197,60 @@ Status CachedRemoteFileReader::read_at_impl(size_t offset, Slice result, size_t*
         current_offset = right + 1;
     }
     DCHECK(*bytes_read == bytes_req);
+    if (write_pool != nullptr && buffer != nullptr) {
+        _write_cache_async(write_pool, &holder, std::move(buffer), empty_start);
+    }
     _update_state(stats, io_ctx->file_cache_stats);
+    if (IOStatistics* io_stats = thread_context()->io_statistics; io_stats != nullptr) {
+        IOStatistics::add(stats.hit_cache ? io_stats->file_cache_hits : io_stats->file_cache_misses,
+                          1);
+        IOStatistics::add(io_stats->file_cache_bytes_read, stats.bytes_read_from_file_cache);
+    }
     DorisMetrics::instance()->s3_bytes_read_total->increment(*bytes_read);
+    DorisMetrics::instance()->file_cache_read_latency_us->add(watch.elapsed_time() /
+                                                              NANOS_PER_MICRO);
     return Status::OK();
 }
 
+void CachedRemoteFileReader::_write_cache_async(ThreadPool* write_pool, FileBlocksHolder* holder,
+                                                std::unique_ptr<char[]> buffer,
+                                                size_t buffer_offset) {
+    // The segments downloaded by the caller are moved out of its holder and stay in DOWNLOADING
+    // until they are written, so the readers of the other queries wait for them instead of
+    // downloading them again.
+    FileBlocks segments;
+    for (auto it = holder->file_segments.begin(); it != holder->file_segments.end();) {
+        auto cur = it++;
+        if ((*cur)->state() == FileBlock::State::DOWNLOADING && (*cur)->is_downloader()) {
+            (*cur)->set_async_downloader();
+            segments.splice(segments.end(), holder->file_segments, cur);
+        }
+    }
+    if (segments.empty()) {
+        return;
+    }
+    auto write_holder = std::make_shared<FileBlocksHolder>(std::move(segments));
+    std::shared_ptr<char[]> data(std::move(buffer));
+    auto write = [write_holder, data, buffer_offset]() {
+        for (auto& segment : write_holder->file_segments) {
+            char* cur_ptr = data.get() + segment->range().left - buffer_offset;
+            Status st = segment->append(Slice(cur_ptr, segment->range().size()));
+            if (st.ok()) {
+                st = segment->finalize_write();
+            }
+            if (!st.ok()) {
+                LOG(WARNING) << "failed to write file cache, " << segment->get_info_for_log()
+                             << ", status: " << st;
+            }
+            segment->finish_async_download();
+        }
+    };
+    if (!write_pool->submit_func(write).ok()) {
+        // the queue is full
+        write();
+    }
+}
+
 void CachedRemoteFileReader::_update_state(const ReadStatistics& read_stats,
                                            FileCacheStatistics* statis) const {
     if (statis == nullptr) {
@@ -27,6 +27,8 @@
 #include "io/fs/s3_file_system.h"
 
 namespace doris {
+class ThreadPool;
+
 namespace io {
 
 class CachedRemoteFileReader final : public FileReader {
@@ -52,6 +54,11 @@ protected:
 private:
     std::pair<size_t, size_t> _align_size(size_t offset, size_t size) const;
 
+    // Writes the segments the caller is downloading from buffer, which starts at buffer_offset
+    // of the file, in the background.
+    static void _write_cache_async(ThreadPool* write_pool, FileBlocksHolder* holder,
+                                   std::unique_ptr<char[]> buffer, size_t buffer_offset);
+
     FileReaderSPtr _remote_file_reader;
     IFileCache::Key _cache_key;
     CloudFileCachePtr _cache;
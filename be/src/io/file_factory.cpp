@@ -125,6 +125,10 @@ Status FileFactory::create_pipe_reader(const TUniqueId& load_id, io::FileReaderS
     if (!stream_load_ctx) {
         return Status::InternalError("unknown stream load id: {}", UniqueId(load_id).to_string());
     }
+    // the body is parsed by several scanners, each one reads a sub pipe
+    if (stream_load_ctx->pipe != nullptr && stream_load_ctx->pipe->num_sub_pipes() > 0) {
+        return stream_load_ctx->pipe->take_sub_pipe(file_reader);
+    }
     *file_reader = stream_load_ctx->pipe;
     return Status::OK();
 }
@@ -23,7 +23,9 @@
 #include "common/config.h"
 #include "olap/iterators.h"
 #include "olap/olap_define.h"
+#include "runtime/exec_env.h"
 #include "util/bit_util.h"
+#include "util/threadpool.h"
 
 namespace doris {
 namespace io {
@@ -88,5 +90,234 @@ Status BufferedFileStreamReader::read_bytes(Slice& slice, uint64_t offset) {
     return read_bytes((const uint8_t**)&slice.data, offset, slice.size);
 }
 
+MergeRangeFileReader::MergeRangeFileReader(FileReaderSPtr reader, std::vector<PrefetchRange> ranges,
+                                           size_t max_buffer_bytes)
+        : _reader(std::move(reader)), _max_buffer_bytes(max_buffer_bytes) {
+    std::sort(ranges.begin(), ranges.end(), [](const PrefetchRange& lhs, const PrefetchRange& rhs) {
+        return lhs.start_offset < rhs.start_offset;
+    });
+    // union the overlapped ranges
+    std::vector<PrefetchRange> disjoint_ranges;
+    for (auto& range : ranges) {
+        if (range.end_offset <= range.start_offset) {
+            continue;
+        }
+        if (!disjoint_ranges.empty() && range.start_offset <= disjoint_ranges.back().end_offset) {
+            disjoint_ranges.back().end_offset =
+                    std::max(disjoint_ranges.back().end_offset, range.end_offset);
+        } else {
+            disjoint_ranges.push_back(range);
+        }
+    }
+    const size_t max_gap = static_cast<size_t>(config::merge_range_read_max_gap_kb) << 10;
+    const size_t max_request_size =
+            std::max<size_t>(config::merge_range_read_max_request_mb, 1) << 20;
+    for (auto& range : disjoint_ranges) {
+        for (size_t start = range.start_offset; start < range.end_offset;) {
+            size_t end = std::min(range.end_offset, start + max_request_size);
+            if (!_requests.empty() && start - _requests.back().end_offset <= max_gap &&
+                end - _requests.back().start_offset <= max_request_size) {
+                _requests.back().range_bytes += end - start;
+                _requests.back().end_offset = end;
+            } else {
+                _requests.emplace_back(start, end);
+            }
+            start = end;
+        }
+    }
+    ThreadPool* pool = ExecEnv::GetInstance()->merge_range_read_thread_pool();
+    if (pool != nullptr && config::merge_range_read_parallelism > 0 && _requests.size() > 1) {
+        _prefetch_token = pool->new_token(ThreadPool::ExecutionMode::CONCURRENT,
+                                          config::merge_range_read_parallelism);
+    }
+}
+
+MergeRangeFileReader::~MergeRangeFileReader() {
+    close();
+}
+
+Status MergeRangeFileReader::close() {
+    if (_prefetch_token != nullptr) {
+        // waits for the running fetches, which reference the buffers
+        _prefetch_token->shutdown();
+    }
+    std::lock_guard l(_mutex);
+    for (auto& request : _requests) {
+        request.buffer = Buffer();
+    }
+    _free_buffers.clear();
+    _closed = true;
+    return Status::OK();
+}
+
+Status MergeRangeFileReader::read_at_impl(size_t offset, Slice result, size_t* bytes_read,
+                                          const IOContext* io_ctx) {
+    if (offset > size()) {
+        return Status::IOError("offset exceeds file size(offset: {}, file size: {}, path: {})",
+                               offset, size(), path().native());
+    }
+    const size_t end_offset = std::min(offset + result.size, size());
+    std::unique_lock l(_mutex);
+    if (_closed) {
+        return Status::IOError("read a closed file {}", path().native());
+    }
+    for (size_t cur = offset; cur < end_offset;) {
+        char* to = result.data + (cur - offset);
+        int index = _find_request(cur);
+        if (index < 0) {
+            // read the bytes before the next request directly
+            auto next = std::upper_bound(
+                    _requests.begin(), _requests.end(), cur,
+                    [](size_t off, const Request& request) { return off < request.start_offset; });
+            size_t end = next == _requests.end() ? end_offset
+                                                 : std::min(end_offset, next->start_offset);
+            ++_statistics.direct_read_count;
+            _statistics.direct_read_bytes += end - cur;
+            l.unlock();
+            RETURN_IF_ERROR(_read_fully(cur, to, end - cur, io_ctx));
+            l.lock();
+            cur = end;
+            continue;
+        }
+        Request& request = _requests[index];
+        if (request.state == RequestState::NOT_FETCHED) {
+            _start_fetch(request);
+            char* buf = request.buffer.data.get();
+            l.unlock();
+            Status st = _read_fully(request.start_offset, buf, request.size(), io_ctx);
+            l.lock();
+            _finish_fetch(request, st);
+        }
+        _prefetch_after(index);
+        _cv.wait(l, [&] { return request.state == RequestState::FETCHED; });
+        RETURN_IF_ERROR(request.status);
+        size_t end = std::min(end_offset, request.end_offset);
+        memcpy(to, request.buffer.data.get() + (cur - request.start_offset), end - cur);
+        request.unread_bytes -= std::min(request.unread_bytes, end - cur);
+        if (request.unread_bytes == 0) {
+            _release(request);
+        }
+        cur = end;
+    }
+    *bytes_read = end_offset - offset;
+    return Status::OK();
+}
+
+int MergeRangeFileReader::_find_request(size_t offset) const {
+    auto it = std::upper_bound(
+            _requests.begin(), _requests.end(), offset,
+            [](size_t off, const Request& request) { return off < request.start_offset; });
+    if (it == _requests.begin()) {
+        return -1;
+    }
+    --it;
+    return offset < it->end_offset ? it - _requests.begin() : -1;
+}
+
+Status MergeRangeFileReader::_read_fully(size_t offset, char* buf, size_t len,
+                                         const IOContext* io_ctx) const {
+    size_t has_read = 0;
+    while (has_read < len) {
+        size_t loop_read = 0;
+        RETURN_IF_ERROR(_reader->read_at(offset + has_read, Slice(buf + has_read, len - has_read),
+                                         &loop_read, io_ctx));
+        if (loop_read == 0) {
+            break;
+        }
+        has_read += loop_read;
+    }
+    if (has_read != len) {
+        return Status::Corruption("Try to read {} bytes, but received {} bytes", len, has_read);
+    }
+    return Status::OK();
+}
+
+void MergeRangeFileReader::_start_fetch(Request& request) {
+    DCHECK(request.state == RequestState::NOT_FETCHED);
+    size_t size = request.size();
+    auto it = std::find_if(_free_buffers.begin(), _free_buffers.end(),
+                           [size](const Buffer& buffer) { return buffer.capacity >= size; });
+    if (it != _free_buffers.end()) {
+        request.buffer = std::move(*it);
+        _free_buffers.erase(it);
+    } else {
+        request.buffer.data.reset(new char[size]);
+        request.buffer.capacity = size;
+    }
+    request.state = RequestState::FETCHING;
+    request.unread_bytes = request.range_bytes;
+    _buffered_bytes += request.buffer.capacity;
+    ++_statistics.request_count;
+    _statistics.request_bytes += size;
+}
+
+void MergeRangeFileReader::_finish_fetch(Request& request, const Status& st) {
+    request.state = RequestState::FETCHED;
+    request.status = st;
+    _cv.notify_all();
+}
+
+void MergeRangeFileReader::_release(Request& request) {
+    _buffered_bytes -= request.buffer.capacity;
+    // keep a few buffers for the next requests
+    if (_free_buffers.size() <= static_cast<size_t>(config::merge_range_read_parallelism)) {
+        _free_buffers.push_back(std::move(request.buffer));
+    }
+    request.buffer = Buffer();
+    request.state = RequestState::NOT_FETCHED;
+    request.status = Status::OK();
+}
+
+void MergeRangeFileReader::_prefetch_after(size_t index) {
+    if (_prefetch_token == nullptr) {
+        return;
+    }
+    for (size_t i = index + 1;
+         i < _requests.size() && _num_prefetching < config::merge_range_read_parallelism; ++i) {
+        Request& request = _requests[i];
+        if (request.state != RequestState::NOT_FETCHED) {
+            continue;
+        }
+        if (_buffered_bytes + request.size() > _max_buffer_bytes) {
+            break;
+        }
+        _start_fetch(request);
+        ++_num_prefetching;
+        ++_statistics.prefetch_count;
+        char* buf = request.buffer.data.get();
+        Status st = _prefetch_token->submit_func([this, i, buf]() {
+            Request& request = _requests[i];
+            // the IOContext of the read may be gone when the prefetch runs
+            Status st = _read_fully(request.start_offset, buf, request.size(), nullptr);
+            std::lock_guard l(_mutex);
+            --_num_prefetching;
+            _finish_fetch(request, st);
+        });
+        if (!st.ok()) {
+            --_num_prefetching;
+            _release(request);
+            break;
+        }
+    }
+}
+
+Status RangeFileReader::close() {
+    if (!_closed) {
+        _closed = true;
+        return _reader->close();
+    }
+    return Status::OK();
+}
+
+Status RangeFileReader::read_at_impl(size_t offset, Slice result, size_t* bytes_read,
+                                     const IOContext* io_ctx) {
+    if (offset >= _size) {
+        *bytes_read = 0;
+        return Status::OK();
+    }
+    Slice range_result(result.data, std::min(result.size, _size - offset));
+    return _reader->read_at(_offset + offset, range_result, bytes_read, io_ctx);
+}
+
 } // namespace io
 } // namespace doris
@@ -19,7 +19,10 @@
 
 #include <stdint.h>
 
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "common/status.h"
 #include "io/fs/file_reader.h"
@@ -27,8 +30,145 @@
 #include "util/runtime_profile.h"
 
 namespace doris {
+class ThreadPoolToken;
+
 namespace io {
 
+struct PrefetchRange {
+    size_t start_offset;
+    size_t end_offset;
+
+    PrefetchRange(size_t start_offset_, size_t end_offset_)
+            : start_offset(start_offset_), end_offset(end_offset_) {}
+};
+
+/**
+ * A file reader for the ranges known to be read, e.g. the column chunks of a parquet row group.
+ *
+ * The nearby ranges are merged into requests of at most config::merge_range_read_max_request_mb,
+ * and when a request is read, the next requests are fetched ahead by up to
+ * config::merge_range_read_parallelism concurrent reads, as long as the fetched requests take less
+ * than max_buffer_bytes. The buffer of a request is released (and reused) when all its ranges are
+ * read. The reads out of the ranges go to the underlying reader directly.
+ */
+class MergeRangeFileReader : public FileReader {
+public:
+    struct Statistics {
+        int64_t request_count = 0;
+        int64_t request_bytes = 0;
+        // the requests fetched ahead
+        int64_t prefetch_count = 0;
+        int64_t direct_read_count = 0;
+        int64_t direct_read_bytes = 0;
+    };
+
+    MergeRangeFileReader(FileReaderSPtr reader, std::vector<PrefetchRange> ranges,
+                         size_t max_buffer_bytes);
+    ~MergeRangeFileReader() override;
+
+    // Does not close the underlying reader.
+    Status close() override;
+
+    const Path& path() const override { return _reader->path(); }
+
+    size_t size() const override { return _reader->size(); }
+
+    bool closed() const override { return _closed; }
+
+    std::shared_ptr<FileSystem> fs() const override { return _reader->fs(); }
+
+    Statistics statistics() const {
+        std::lock_guard l(_mutex);
+        return _statistics;
+    }
+
+    size_t num_requests() const { return _requests.size(); }
+
+protected:
+    Status read_at_impl(size_t offset, Slice result, size_t* bytes_read,
+                        const IOContext* io_ctx) override;
+
+private:
+    enum class RequestState { NOT_FETCHED, FETCHING, FETCHED };
+
+    struct Buffer {
+        std::unique_ptr<char[]> data;
+        size_t capacity = 0;
+    };
+
+    struct Request {
+        size_t start_offset;
+        size_t end_offset;
+        // the bytes of the ranges in the request
+        size_t range_bytes;
+        // the bytes of the ranges not read yet since the request is fetched
+        size_t unread_bytes = 0;
+        RequestState state = RequestState::NOT_FETCHED;
+        Status status;
+        Buffer buffer;
+
+        Request(size_t start, size_t end)
+                : start_offset(start), end_offset(end), range_bytes(end - start) {}
+        size_t size() const { return end_offset - start_offset; }
+    };
+
+    // The index of the request containing the offset, or -1.
+    int _find_request(size_t offset) const;
+    Status _read_fully(size_t offset, char* buf, size_t len, const IOContext* io_ctx) const;
+    // The following functions are called with _mutex held.
+    void _start_fetch(Request& request);
+    void _finish_fetch(Request& request, const Status& st);
+    void _release(Request& request);
+    void _prefetch_after(size_t index);
+
+    FileReaderSPtr _reader;
+    const size_t _max_buffer_bytes;
+    std::vector<Request> _requests;
+    std::unique_ptr<ThreadPoolToken> _prefetch_token;
+    bool _closed = false;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _cv;
+    // the bytes of the buffers of the requests being fetched or fetched
+    size_t _buffered_bytes = 0;
+    int _num_prefetching = 0;
+    std::vector<Buffer> _free_buffers;
+    Statistics _statistics;
+};
+
+/**
+ * A file reader for the range [offset, offset + size) of the underlying file, which it reads as a
+ * whole file, e.g. a segment packed into a larger remote object.
+ */
+class RangeFileReader : public FileReader {
+public:
+    RangeFileReader(FileReaderSPtr reader, size_t offset, size_t size)
+            : _reader(std::move(reader)), _offset(offset), _size(size) {}
+
+    ~RangeFileReader() override { close(); }
+
+    // Closes the underlying reader too.
+    Status close() override;
+
+    const Path& path() const override { return _reader->path(); }
+
+    size_t size() const override { return _size; }
+
+    bool closed() const override { return _closed; }
+
+    std::shared_ptr<FileSystem> fs() const override { return _reader->fs(); }
+
+protected:
+    Status read_at_impl(size_t offset, Slice result, size_t* bytes_read,
+                        const IOContext* io_ctx) override;
+
+private:
+    FileReaderSPtr _reader;
+    const size_t _offset;
+    const size_t _size;
+    bool _closed = false;
+};
+
 /**
  * Load all the needed data in underlying buffer, so the caller does not need to prepare the data container.
  */
@@ -39,5 +39,26 @@ Status FileReader::read_at(size_t offset, Slice result, size_t* bytes_read,
     return st;
 }
 
+Status FileReader::read_ranges(std::vector<ReadRange>* ranges, const IOContext* io_ctx) {
+    Status st;
+    if (bthread_self() == 0) {
+        st = read_ranges_impl(ranges, io_ctx);
+    } else {
+        auto task = [&] { st = read_ranges_impl(ranges, io_ctx); };
+        AsyncIO::run_task(task, fs()->type());
+    }
+    if (!st) {
+        LOG(WARNING) << st;
+    }
+    return st;
+}
+
+Status FileReader::read_ranges_impl(std::vector<ReadRange>* ranges, const IOContext* io_ctx) {
+    for (auto& range : *ranges) {
+        RETURN_IF_ERROR(read_at_impl(range.offset, range.result, &range.bytes_read, io_ctx));
+    }
+    return Status::OK();
+}
+
 } // namespace io
 } // namespace doris
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "common/status.h"
 #include "gutil/macros.h"
 #include "io/fs/file_reader_writer_fwd.h"
@@ -32,6 +34,12 @@ class IOContext;
 
 class FileReader {
 public:
+    struct ReadRange {
+        size_t offset;
+        Slice result;
+        size_t bytes_read = 0;
+    };
+
     FileReader() = default;
     virtual ~FileReader() = default;
 
@@ -42,6 +50,9 @@ public:
     Status read_at(size_t offset, Slice result, size_t* bytes_read,
                    const IOContext* io_ctx = nullptr);
 
+    // Reads all the ranges, which may be issued together by the reader.
+    Status read_ranges(std::vector<ReadRange>* ranges, const IOContext* io_ctx = nullptr);
+
     virtual Status close() = 0;
 
     virtual const Path& path() const = 0;
@@ -52,9 +63,16 @@ public:
 
     virtual std::shared_ptr<FileSystem> fs() const = 0;
 
+    // The whole file mapped into memory, or nullptr if it is not mapped.
+    // The mapping is valid until the reader is destroyed.
+    virtual const char* mapped_data() const { return nullptr; }
+
 protected:
     virtual Status read_at_impl(size_t offset, Slice result, size_t* bytes_read,
                                 const IOContext* io_ctx) = 0;
+
+    // reads the ranges one by one by default
+    virtual Status read_ranges_impl(std::vector<ReadRange>* ranges, const IOContext* io_ctx);
 };
 
 } // namespace io
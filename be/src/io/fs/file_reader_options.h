@@ -76,6 +76,10 @@ public:
     // -1 means unset.
     // If the file length is not set, the file length will be fetched from the file system.
     int64_t file_size = -1;
+    // the offset of the file in the object it's packed into, for the remote files only.
+    // If it's set, the file is the range [file_offset, file_offset + file_size) of the object,
+    // and file_size must be set too.
+    int64_t file_offset = 0;
 
     static FileReaderOptions DEFAULT;
 };
@@ -18,8 +18,11 @@
 #include "io/fs/hdfs_file_reader.h"
 
 #include "io/fs/hdfs_file_system.h"
+#include "runtime/thread_context.h"
 #include "service/backend_options.h"
+#include "util/defer_op.h"
 #include "util/doris_metrics.h"
+#include "util/stopwatch.hpp"
 namespace doris {
 namespace io {
 HdfsFileReader::HdfsFileReader(Path path, size_t file_size, const std::string& name_node,
@@ -62,6 +65,19 @@ Status HdfsFileReader::read_at_impl(size_t offset, Slice result, size_t* bytes_r
                                offset, _file_size, _path.native());
     }
 
+    MonotonicStopWatch watch;
+    watch.start();
+    IOStatistics* io_stats = thread_context()->io_statistics;
+    if (io_stats != nullptr) {
+        IOStatistics::add(io_stats->remote_read_requests, 1);
+    }
+    Defer defer {[&]() {
+        if (io_stats != nullptr) {
+            IOStatistics::add(io_stats->remote_bytes_read, *bytes_read);
+            IOStatistics::add(io_stats->remote_read_ns, watch.elapsed_time());
+        }
+    }};
+    *bytes_read = 0;
     auto handle = _fs->get_handle();
     int res = hdfsSeek(handle->hdfs_fs, _hdfs_file, offset);
     if (res != 0) {
@@ -72,7 +88,6 @@ Status HdfsFileReader::read_at_impl(size_t offset, Slice result, size_t* bytes_r
     size_t bytes_req = result.size;
     char* to = result.data;
     bytes_req = std::min(bytes_req, _file_size - offset);
-    *bytes_read = 0;
     if (UNLIKELY(bytes_req == 0)) {
         return Status::OK();
     }
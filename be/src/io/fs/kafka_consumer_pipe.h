@@ -17,6 +17,12 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "io/fs/stream_load_pipe.h"
 
 namespace doris {
@@ -40,6 +46,65 @@ public:
     }
 
     Status append_json(const char* data, size_t size) { return append_and_flush(data, size); }
+
+    // the pipe to append the messages of the partition
+    virtual KafkaConsumerPipe* pipe_of_partition(int32_t partition) { return this; }
+};
+
+// The messages of the partitions are appended to several sub pipes, which are parsed by
+// different scanners for the same load. All the messages of a partition are appended to the same
+// sub pipe, so they are still loaded in order.
+class MultiPartitionKafkaConsumerPipe : public KafkaConsumerPipe {
+public:
+    MultiPartitionKafkaConsumerPipe(int num_sub_pipes, const std::vector<int32_t>& partitions) {
+        DCHECK_GT(num_sub_pipes, 0);
+        for (int i = 0; i < num_sub_pipes; ++i) {
+            _sub_pipes.push_back(std::make_shared<KafkaConsumerPipe>());
+        }
+        for (size_t i = 0; i < partitions.size(); ++i) {
+            _partition_to_sub_pipe[partitions[i]] = _sub_pipes[i % num_sub_pipes].get();
+        }
+    }
+
+    ~MultiPartitionKafkaConsumerPipe() override = default;
+
+    KafkaConsumerPipe* pipe_of_partition(int32_t partition) override {
+        auto it = _partition_to_sub_pipe.find(partition);
+        // the partitions are all known when the pipe is created
+        DCHECK(it != _partition_to_sub_pipe.end());
+        return it == _partition_to_sub_pipe.end() ? _sub_pipes[0].get() : it->second;
+    }
+
+    Status finish() override {
+        for (auto& sub_pipe : _sub_pipes) {
+            RETURN_IF_ERROR(sub_pipe->finish());
+        }
+        return StreamLoadPipe::finish();
+    }
+
+    void cancel(const std::string& reason) override {
+        for (auto& sub_pipe : _sub_pipes) {
+            sub_pipe->cancel(reason);
+        }
+        StreamLoadPipe::cancel(reason);
+    }
+
+    int num_sub_pipes() const override { return _sub_pipes.size(); }
+
+    Status take_sub_pipe(FileReaderSPtr* reader) override {
+        int idx = _num_taken_sub_pipes++;
+        if (idx >= _sub_pipes.size()) {
+            return Status::InternalError("all the {} sub pipes of the routine load are taken",
+                                         _sub_pipes.size());
+        }
+        *reader = _sub_pipes[idx];
+        return Status::OK();
+    }
+
+private:
+    std::vector<std::shared_ptr<KafkaConsumerPipe>> _sub_pipes;
+    std::unordered_map<int32_t, KafkaConsumerPipe*> _partition_to_sub_pipe;
+    std::atomic<int> _num_taken_sub_pipes = 0;
 };
 } // namespace io
 } // end namespace doris
@@ -17,24 +17,77 @@
 
 #include "io/fs/local_file_reader.h"
 
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
 #include <atomic>
 
+#include "common/config.h"
 #include "io/fs/err_utils.h"
+#include "io/fs/local_io_uring.h"
+#include "runtime/thread_context.h"
 #include "util/async_io.h"
 #include "util/doris_metrics.h"
 
+#ifndef RWF_NOWAIT
+#define RWF_NOWAIT 0x00000008
+#endif
+
 namespace doris {
 namespace io {
 
+namespace {
+
+// cleared if the kernel or the file system doesn't support RWF_NOWAIT
+std::atomic<bool> nowait_read_supported {true};
+
+// Reads only what is in the OS page cache, returns -1 with EAGAIN if the first page is not cached.
+// The syscall is used since preadv2() is missing in old glibc.
+ssize_t pread_from_page_cache(int fd, char* to, size_t bytes_req, size_t offset) {
+#ifdef SYS_preadv2
+    struct iovec iov = {to, bytes_req};
+    // the offset is passed as the low and the high words, the high one is ignored on 64-bit
+    return ::syscall(SYS_preadv2, fd, &iov, 1, offset, 0, RWF_NOWAIT);
+#else
+    errno = EOPNOTSUPP;
+    return -1;
+#endif
+}
+
+} // namespace
+
 LocalFileReader::LocalFileReader(Path path, size_t file_size, int fd,
                                  std::shared_ptr<LocalFileSystem> fs)
-        : _fd(fd), _path(std::move(path)), _file_size(file_size), _fs(std::move(fs)) {
+        : _fd(fd),
+          _path(std::move(path)),
+          _file_size(file_size),
+          _fs(std::move(fs)),
+          _io_scheduler(LocalIOScheduler::find(_path.native())) {
     DorisMetrics::instance()->local_file_open_reading->increment(1);
     DorisMetrics::instance()->local_file_reader_total->increment(1);
 }
 
 LocalFileReader::~LocalFileReader() {
     WARN_IF_ERROR(close(), fmt::format("Failed to close file {}", _path.native()));
+    if (_mapped_data != nullptr) {
+        ::munmap(_mapped_data, _file_size);
+    }
+}
+
+Status LocalFileReader::map() {
+    DCHECK(!closed());
+    if (_mapped_data != nullptr || _file_size == 0) {
+        return Status::OK();
+    }
+    void* addr = ::mmap(nullptr, _file_size, PROT_READ, MAP_SHARED, _fd, 0);
+    if (addr == MAP_FAILED) {
+        return Status::IOError("failed to mmap {}: {}", _path.native(), errno_to_str());
+    }
+    _mapped_data = static_cast<char*>(addr);
+    return Status::OK();
 }
 
 Status LocalFileReader::close() {
@@ -70,8 +123,33 @@ Status LocalFileReader::read_at_impl(size_t offset, Slice result, size_t* bytes_
     bytes_req = std::min(bytes_req, _file_size - offset);
     *bytes_read = 0;
 
+    // The bytes read without blocking come from the page cache, and the others are counted as read
+    // from the disk, though the kernel may read ahead a part of them.
+    IOStatistics* io_stats = thread_context()->io_statistics;
+    if (io_stats != nullptr) {
+        IOStatistics::add(io_stats->local_read_requests, 1);
+    }
     while (bytes_req != 0) {
-        auto res = ::pread(_fd, to, bytes_req, offset);
+        if (io_stats != nullptr && nowait_read_supported.load(std::memory_order_relaxed)) {
+            auto res = pread_from_page_cache(_fd, to, bytes_req, offset);
+            if (res > 0) {
+                IOStatistics::add(io_stats->local_bytes_read_from_page_cache, res);
+                to += res;
+                offset += res;
+                bytes_req -= res;
+                *bytes_read += res;
+                continue;
+            }
+            if (res == -1 && (errno == EOPNOTSUPP || errno == EINVAL || errno == ENOSYS)) {
+                LOG(INFO) << "reading with RWF_NOWAIT is not supported, errno=" << errno;
+                nowait_read_supported = false;
+            }
+        }
+        ssize_t res;
+        {
+            LocalIOScheduler::ScopedIO io(_io_scheduler.get(), bytes_req);
+            res = ::pread(_fd, to, bytes_req, offset);
+        }
         if (UNLIKELY(-1 == res && errno != EINTR)) {
             return Status::IOError("cannot read from {}: {}", _path.native(), std::strerror(errno));
         }
@@ -79,6 +157,9 @@ Status LocalFileReader::read_at_impl(size_t offset, Slice result, size_t* bytes_
             return Status::IOError("cannot read from {}: unexpected EOF", _path.native());
         }
         if (res > 0) {
+            if (io_stats != nullptr) {
+                IOStatistics::add(io_stats->local_bytes_read_from_disk, res);
+            }
             to += res;
             offset += res;
             bytes_req -= res;
@@ -89,5 +170,52 @@ Status LocalFileReader::read_at_impl(size_t offset, Slice result, size_t* bytes_
     return Status::OK();
 }
 
+Status LocalFileReader::read_ranges_impl(std::vector<ReadRange>* ranges,
+                                         const IOContext* io_ctx) {
+    if (!config::enable_io_uring || ranges->size() < 2 || !IOUring::available()) {
+        return FileReader::read_ranges_impl(ranges, io_ctx);
+    }
+    DCHECK(!closed());
+    std::vector<IOUring::Read> reads;
+    reads.reserve(ranges->size());
+    size_t bytes_req = 0;
+    for (auto& range : *ranges) {
+        if (range.offset > _file_size) {
+            return Status::IOError("offset exceeds file size(offset: {}, file size: {}, path: {})",
+                                   range.offset, _file_size, _path.native());
+        }
+        size_t len = std::min(range.result.size, _file_size - range.offset);
+        reads.push_back({_fd, range.offset, range.result.data, len});
+        bytes_req += len;
+    }
+
+    Status st;
+    {
+        LocalIOScheduler::ScopedIO io(_io_scheduler.get(), bytes_req);
+        st = IOUring::read(&reads);
+    }
+    if (st.is<NOT_IMPLEMENTED_ERROR>()) {
+        return FileReader::read_ranges_impl(ranges, io_ctx);
+    }
+    RETURN_IF_ERROR(st);
+
+    size_t bytes_read = 0;
+    for (size_t i = 0; i < reads.size(); ++i) {
+        if (UNLIKELY(reads[i].bytes_read < reads[i].len)) {
+            return Status::IOError("cannot read from {}: unexpected EOF", _path.native());
+        }
+        (*ranges)[i].bytes_read = reads[i].bytes_read;
+        bytes_read += reads[i].bytes_read;
+    }
+    // the page cache isn't tried first, so all are counted as read from the disk
+    IOStatistics* io_stats = thread_context()->io_statistics;
+    if (io_stats != nullptr) {
+        IOStatistics::add(io_stats->local_read_requests, reads.size());
+        IOStatistics::add(io_stats->local_bytes_read_from_disk, bytes_read);
+    }
+    DorisMetrics::instance()->local_bytes_read_total->increment(bytes_read);
+    return Status::OK();
+}
+
 } // namespace io
 } // namespace doris
@@ -21,6 +21,7 @@
 
 #include "io/fs/file_reader.h"
 #include "io/fs/local_file_system.h"
+#include "io/fs/local_io_scheduler.h"
 #include "io/fs/path.h"
 
 namespace doris {
@@ -42,16 +43,27 @@ public:
 
     FileSystemSPtr fs() const override { return _fs; }
 
+    // Map the whole file into memory, it is not thread safe and should be called before
+    // the reader is shared. It is kept after close() until the reader is destroyed.
+    Status map();
+
+    const char* mapped_data() const override { return _mapped_data; }
+
 private:
     Status read_at_impl(size_t offset, Slice result, size_t* bytes_read,
                         const IOContext* io_ctx) override;
 
+    // by io_uring if config::enable_io_uring
+    Status read_ranges_impl(std::vector<ReadRange>* ranges, const IOContext* io_ctx) override;
+
 private:
     int _fd = -1; // owned
     Path _path;
     size_t _file_size;
     std::atomic<bool> _closed = false;
     std::shared_ptr<LocalFileSystem> _fs;
+    char* _mapped_data = nullptr;
+    std::shared_ptr<LocalIOScheduler> _io_scheduler;
 };
 
 } // namespace io
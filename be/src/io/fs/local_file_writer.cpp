@@ -57,7 +57,9 @@ Status sync_dir(const io::Path& dirname) {
 namespace io {
 
 LocalFileWriter::LocalFileWriter(Path path, int fd, FileSystemSPtr fs)
-        : FileWriter(std::move(path), fs), _fd(fd) {
+        : FileWriter(std::move(path), fs),
+          _fd(fd),
+          _io_scheduler(LocalIOScheduler::find(_path.native())) {
     _opened = true;
     DorisMetrics::instance()->local_file_open_writing->increment(1);
     DorisMetrics::instance()->local_file_writer_total->increment(1);
@@ -96,6 +98,7 @@ Status LocalFileWriter::appendv(const Slice* data, size_t data_cnt) {
         iov[i] = {result.data, result.size};
     }
 
+    LocalIOScheduler::ScopedIO io(_io_scheduler.get(), bytes_req);
     size_t completed_iov = 0;
     size_t n_left = bytes_req;
     while (n_left > 0) {
@@ -141,6 +144,7 @@ Status LocalFileWriter::write_at(size_t offset, const Slice& data) {
     size_t bytes_req = data.size;
     char* from = data.data;
 
+    LocalIOScheduler::ScopedIO io(_io_scheduler.get(), bytes_req);
     while (bytes_req != 0) {
         auto res = ::pwrite(_fd, from, bytes_req, offset);
         if (-1 == res && errno != EINTR) {
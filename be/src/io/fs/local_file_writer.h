@@ -22,6 +22,7 @@
 #include "io/fs/file_system.h"
 #include "io/fs/file_writer.h"
 #include "io/fs/local_file_system.h"
+#include "io/fs/local_io_scheduler.h"
 
 namespace doris {
 namespace io {
@@ -44,6 +45,7 @@ private:
 private:
     int _fd; // owned
     bool _dirty = false;
+    std::shared_ptr<LocalIOScheduler> _io_scheduler;
 };
 
 } // namespace io
@@ -0,0 +1,226 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "io/fs/local_io_scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+#include <vector>
+
+#include "common/config.h"
+#include "runtime/memory/mem_tracker_limiter.h"
+#include "runtime/thread_context.h"
+#include "util/stopwatch.hpp"
+
+namespace doris {
+namespace io {
+
+DEFINE_COUNTER_METRIC_PROTOTYPE_5ARG(disks_query_io_bytes, MetricUnit::BYTES, "", disks_io_bytes,
+                                     Labels({{"class", "query"}}));
+DEFINE_COUNTER_METRIC_PROTOTYPE_5ARG(disks_load_io_bytes, MetricUnit::BYTES, "", disks_io_bytes,
+                                     Labels({{"class", "load"}}));
+DEFINE_COUNTER_METRIC_PROTOTYPE_5ARG(disks_compaction_io_bytes, MetricUnit::BYTES, "",
+                                     disks_io_bytes, Labels({{"class", "compaction"}}));
+DEFINE_COUNTER_METRIC_PROTOTYPE_5ARG(disks_migration_io_bytes, MetricUnit::BYTES, "",
+                                     disks_io_bytes, Labels({{"class", "migration"}}));
+DEFINE_COUNTER_METRIC_PROTOTYPE_5ARG(disks_other_io_bytes, MetricUnit::BYTES, "", disks_io_bytes,
+                                     Labels({{"class", "other"}}));
+
+DEFINE_COUNTER_METRIC_PROTOTYPE_5ARG(disks_query_io_wait_us, MetricUnit::MICROSECONDS, "",
+                                     disks_io_wait_us, Labels({{"class", "query"}}));
+DEFINE_COUNTER_METRIC_PROTOTYPE_5ARG(disks_load_io_wait_us, MetricUnit::MICROSECONDS, "",
+                                     disks_io_wait_us, Labels({{"class", "load"}}));
+DEFINE_COUNTER_METRIC_PROTOTYPE_5ARG(disks_compaction_io_wait_us, MetricUnit::MICROSECONDS, "",
+                                     disks_io_wait_us, Labels({{"class", "compaction"}}));
+DEFINE_COUNTER_METRIC_PROTOTYPE_5ARG(disks_migration_io_wait_us, MetricUnit::MICROSECONDS, "",
+                                     disks_io_wait_us, Labels({{"class", "migration"}}));
+
+namespace {
+
+std::mutex& schedulers_lock() {
+    static std::mutex lock;
+    return lock;
+}
+
+std::vector<std::shared_ptr<LocalIOScheduler>>& schedulers() {
+    static std::vector<std::shared_ptr<LocalIOScheduler>> schedulers;
+    return schedulers;
+}
+
+bool is_under(const std::string& path, const std::string& root) {
+    if (root.empty() || path.size() < root.size() || path.compare(0, root.size(), root) != 0) {
+        return false;
+    }
+    return path.size() == root.size() || root.back() == '/' || path[root.size()] == '/';
+}
+
+} // namespace
+
+LocalIOScheduler::ScopedIO::ScopedIO(LocalIOScheduler* scheduler, int64_t bytes)
+        : _scheduler(scheduler) {
+    if (_scheduler != nullptr) {
+        _io_class = current_class();
+        _started = _scheduler->start(_io_class, bytes);
+    }
+}
+
+LocalIOScheduler::ScopedIO::~ScopedIO() {
+    if (_started) {
+        _scheduler->finish();
+    }
+}
+
+LocalIOScheduler::LocalIOScheduler(std::string root_path, std::shared_ptr<MetricEntity> entity)
+        : _root_path(std::move(root_path)), _entity(std::move(entity)) {
+    if (_entity == nullptr) {
+        return;
+    }
+    _bytes[QUERY] = (IntCounter*)(_entity->register_metric<IntCounter>(
+            &METRIC_disks_query_io_bytes));
+    _bytes[LOAD] =
+            (IntCounter*)(_entity->register_metric<IntCounter>(&METRIC_disks_load_io_bytes));
+    _bytes[COMPACTION] = (IntCounter*)(_entity->register_metric<IntCounter>(
+            &METRIC_disks_compaction_io_bytes));
+    _bytes[MIGRATION] = (IntCounter*)(_entity->register_metric<IntCounter>(
+            &METRIC_disks_migration_io_bytes));
+    _bytes[OTHER] =
+            (IntCounter*)(_entity->register_metric<IntCounter>(&METRIC_disks_other_io_bytes));
+    _wait_us[QUERY] = (IntCounter*)(_entity->register_metric<IntCounter>(
+            &METRIC_disks_query_io_wait_us));
+    _wait_us[LOAD] = (IntCounter*)(_entity->register_metric<IntCounter>(
+            &METRIC_disks_load_io_wait_us));
+    _wait_us[COMPACTION] = (IntCounter*)(_entity->register_metric<IntCounter>(
+            &METRIC_disks_compaction_io_wait_us));
+    _wait_us[MIGRATION] = (IntCounter*)(_entity->register_metric<IntCounter>(
+            &METRIC_disks_migration_io_wait_us));
+}
+
+std::shared_ptr<LocalIOScheduler> LocalIOScheduler::find(const std::string& path) {
+    std::lock_guard<std::mutex> l(schedulers_lock());
+    std::shared_ptr<LocalIOScheduler> found;
+    for (auto& scheduler : schedulers()) {
+        // the data dirs may be nested in the test environments
+        if (is_under(path, scheduler->root_path()) &&
+            (found == nullptr || scheduler->root_path().size() > found->root_path().size())) {
+            found = scheduler;
+        }
+    }
+    return found;
+}
+
+void LocalIOScheduler::register_scheduler(std::shared_ptr<LocalIOScheduler> scheduler) {
+    std::lock_guard<std::mutex> l(schedulers_lock());
+    schedulers().push_back(std::move(scheduler));
+}
+
+void LocalIOScheduler::deregister_scheduler(const LocalIOScheduler* scheduler) {
+    std::lock_guard<std::mutex> l(schedulers_lock());
+    auto& all = schedulers();
+    all.erase(std::remove_if(all.begin(), all.end(),
+                             [&](const auto& s) { return s.get() == scheduler; }),
+              all.end());
+}
+
+LocalIOScheduler::IOClass LocalIOScheduler::current_class() {
+    MemTrackerLimiter* tracker = thread_context()->thread_mem_tracker();
+    if (tracker == nullptr) {
+        return OTHER;
+    }
+    switch (tracker->type()) {
+    case MemTrackerLimiter::Type::QUERY:
+        return QUERY;
+    case MemTrackerLimiter::Type::LOAD:
+        return LOAD;
+    case MemTrackerLimiter::Type::COMPACTION:
+        return COMPACTION;
+    case MemTrackerLimiter::Type::SCHEMA_CHANGE:
+    case MemTrackerLimiter::Type::CLONE:
+        return MIGRATION;
+    default:
+        return OTHER;
+    }
+}
+
+bool LocalIOScheduler::start(IOClass io_class, int64_t bytes) {
+    if (_bytes[io_class] != nullptr) {
+        _bytes[io_class]->increment(bytes);
+    }
+    if (io_class == OTHER) {
+        return false;
+    }
+
+    MonotonicStopWatch watch;
+    watch.start();
+    if (io_class == COMPACTION) {
+        _compaction_bandwidth.acquire(
+                bytes, config::local_io_compaction_mb_per_sec_per_dir * 1024 * 1024);
+    } else if (io_class == MIGRATION) {
+        _migration_bandwidth.acquire(bytes,
+                                     config::local_io_migration_mb_per_sec_per_dir * 1024 * 1024);
+    }
+
+    bool started = false;
+    if (config::local_io_max_concurrency_per_dir > 0) {
+        std::unique_lock<std::mutex> l(_lock);
+        if (!_can_start(io_class, false)) {
+            ++_num_waiting[io_class];
+            auto deadline = std::chrono::steady_clock::now() +
+                            std::chrono::milliseconds(MAX_PRIORITY_WAIT_MS);
+            bool waited_too_long = false;
+            while (!_can_start(io_class, waited_too_long)) {
+                if (waited_too_long) {
+                    _cv.wait(l);
+                } else {
+                    waited_too_long = _cv.wait_until(l, deadline) == std::cv_status::timeout;
+                }
+            }
+            --_num_waiting[io_class];
+        }
+        ++_num_running;
+        started = true;
+    }
+
+    if (_wait_us[io_class] != nullptr) {
+        _wait_us[io_class]->increment(watch.elapsed_time() / 1000);
+    }
+    return started;
+}
+
+void LocalIOScheduler::finish() {
+    std::lock_guard<std::mutex> l(_lock);
+    --_num_running;
+    if (std::any_of(_num_waiting.begin(), _num_waiting.end(), [](int64_t n) { return n > 0; })) {
+        _cv.notify_all();
+    }
+}
+
+bool LocalIOScheduler::_can_start(IOClass io_class, bool waited_too_long) const {
+    int64_t max_running = config::local_io_max_concurrency_per_dir;
+    if (max_running > 0 && _num_running >= max_running) {
+        return false;
+    }
+    if (waited_too_long) {
+        return true;
+    }
+    // the waiting ones of the higher classes go first
+    return std::none_of(_num_waiting.begin(), _num_waiting.begin() + io_class,
+                        [](int64_t n) { return n > 0; });
+}
+
+} // namespace io
+} // namespace doris
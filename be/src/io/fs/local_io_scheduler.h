@@ -0,0 +1,112 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "util/bandwidth_limiter.h"
+#include "util/metrics.h"
+
+namespace doris {
+namespace io {
+
+// Arbitrates the disk reads and writes of the local files under a data dir between the classes
+// of the tasks issuing them, by the type of the task attached to the thread.
+//
+// At most config::local_io_max_concurrency_per_dir disk I/Os run at the same time, and the
+// waiting ones are started by the priority of their classes, while one waiting longer than
+// MAX_PRIORITY_WAIT_MS is started in its turn, so the compactions are not starved by the
+// queries. The compactions and the migrations are limited in bandwidth as well.
+//
+// The I/Os of the threads not attached to a task are only counted.
+class LocalIOScheduler {
+public:
+    // in the order of priority
+    enum IOClass {
+        QUERY = 0,
+        LOAD = 1,
+        COMPACTION = 2,
+        // schema changes and clones
+        MIGRATION = 3,
+        OTHER = 4,
+        NUM_CLASSES = 5
+    };
+
+    static constexpr int64_t MAX_PRIORITY_WAIT_MS = 1000;
+
+    // Starts an I/O of `bytes` on the scheduler if it's not null, and finishes it when destroyed.
+    class ScopedIO {
+    public:
+        ScopedIO(LocalIOScheduler* scheduler, int64_t bytes);
+        ~ScopedIO();
+
+    private:
+        LocalIOScheduler* _scheduler;
+        IOClass _io_class = OTHER;
+        bool _started = false;
+    };
+
+    // The per class metrics are registered in the entity of the data dir.
+    LocalIOScheduler(std::string root_path, std::shared_ptr<MetricEntity> entity);
+
+    const std::string& root_path() const { return _root_path; }
+
+    // The scheduler of the data dir that the file is in, found once when the file is opened.
+    static std::shared_ptr<LocalIOScheduler> find(const std::string& path);
+    static void register_scheduler(std::shared_ptr<LocalIOScheduler> scheduler);
+    static void deregister_scheduler(const LocalIOScheduler* scheduler);
+
+    // the class of the I/Os issued by the current thread
+    static IOClass current_class();
+
+    // Waits until an I/O of the class could be issued, and returns whether it's counted in the
+    // running ones, then it must be finished by `finish`.
+    bool start(IOClass io_class, int64_t bytes);
+    void finish();
+
+    int64_t num_running() const {
+        std::lock_guard<std::mutex> l(_lock);
+        return _num_running;
+    }
+
+private:
+    // Caller should hold _lock.
+    bool _can_start(IOClass io_class, bool waited_too_long) const;
+
+    const std::string _root_path;
+    std::shared_ptr<MetricEntity> _entity;
+
+    mutable std::mutex _lock;
+    std::condition_variable _cv;
+    int64_t _num_running = 0;
+    std::array<int64_t, NUM_CLASSES> _num_waiting {};
+
+    BandwidthLimiter _compaction_bandwidth;
+    BandwidthLimiter _migration_bandwidth;
+
+    std::array<IntCounter*, NUM_CLASSES> _bytes {};
+    std::array<IntCounter*, NUM_CLASSES> _wait_us {};
+};
+
+} // namespace io
+} // namespace doris
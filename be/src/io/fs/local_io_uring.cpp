@@ -0,0 +1,288 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "io/fs/local_io_uring.h"
+
+#include <atomic>
+
+#include "common/config.h"
+#include "common/logging.h"
+
+// liburing is not a dependency, the ring is set up by the syscalls of the kernel headers
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+
+#include "io/fs/err_utils.h"
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define DORIS_HAVE_IO_URING 1
+#endif
+#endif
+#endif
+
+namespace doris {
+namespace io {
+
+namespace {
+
+#ifdef DORIS_HAVE_IO_URING
+std::atomic<bool> io_uring_available {true};
+#else
+std::atomic<bool> io_uring_available {false};
+#endif
+
+#ifdef DORIS_HAVE_IO_URING
+
+class Ring {
+public:
+    Ring() = default;
+
+    ~Ring() {
+        if (_sqes != MAP_FAILED) {
+            ::munmap(_sqes, _sqes_size);
+        }
+        if (_cq_ptr != MAP_FAILED && _cq_ptr != _sq_ptr) {
+            ::munmap(_cq_ptr, _cq_size);
+        }
+        if (_sq_ptr != MAP_FAILED) {
+            ::munmap(_sq_ptr, _sq_size);
+        }
+        if (_fd >= 0) {
+            ::close(_fd);
+        }
+    }
+
+    Status init(unsigned entries) {
+        io_uring_params params;
+        memset(&params, 0, sizeof(params));
+        _fd = ::syscall(__NR_io_uring_setup, entries, &params);
+        if (_fd < 0) {
+            return Status::IOError("io_uring_setup failed: {}", errno_to_str());
+        }
+        _sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        _cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single_mmap = false;
+#ifdef IORING_FEAT_SINGLE_MMAP
+        if (params.features & IORING_FEAT_SINGLE_MMAP) {
+            single_mmap = true;
+            _sq_size = _cq_size = std::max(_sq_size, _cq_size);
+        }
+#endif
+        _sq_ptr = ::mmap(nullptr, _sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd,
+                         IORING_OFF_SQ_RING);
+        if (_sq_ptr == MAP_FAILED) {
+            return Status::IOError("failed to mmap the submission queue: {}", errno_to_str());
+        }
+        if (single_mmap) {
+            _cq_ptr = _sq_ptr;
+        } else {
+            _cq_ptr = ::mmap(nullptr, _cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                             _fd, IORING_OFF_CQ_RING);
+            if (_cq_ptr == MAP_FAILED) {
+                return Status::IOError("failed to mmap the completion queue: {}", errno_to_str());
+            }
+        }
+        _sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = ::mmap(nullptr, _sqes_size, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) {
+            return Status::IOError("failed to mmap the submission entries: {}", errno_to_str());
+        }
+        _sqes = static_cast<io_uring_sqe*>(sqes);
+
+        char* sq = static_cast<char*>(_sq_ptr);
+        _sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        _sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        _sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        char* cq = static_cast<char*>(_cq_ptr);
+        _cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        _cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        _cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        _cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        // the completion queue is at least as large, so it can't overflow
+        _entries = params.sq_entries;
+        return Status::OK();
+    }
+
+    unsigned entries() const { return _entries; }
+
+    // The caller keeps the in flight reads within the entries, and `iov` alive until it's reaped.
+    void prepare_read(int fd, const iovec* iov, uint64_t offset, uint64_t user_data) {
+        // only this thread moves the tail
+        unsigned tail = *_sq_tail;
+        unsigned index = tail & _sq_mask;
+        io_uring_sqe* sqe = &_sqes[index];
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_READV;
+        sqe->fd = fd;
+        sqe->off = offset;
+        sqe->addr = reinterpret_cast<uint64_t>(iov);
+        sqe->len = 1;
+        sqe->user_data = user_data;
+        _sq_array[index] = index;
+        __atomic_store_n(_sq_tail, tail + 1, __ATOMIC_RELEASE);
+    }
+
+    // Submits the prepared reads, and waits until at least one read is completed.
+    Status submit_and_wait(unsigned to_submit) {
+        while (true) {
+            int res = ::syscall(__NR_io_uring_enter, _fd, to_submit, 1, IORING_ENTER_GETEVENTS,
+                                nullptr, 0);
+            if (res >= 0) {
+                if (static_cast<unsigned>(res) >= to_submit) {
+                    return Status::OK();
+                }
+                // the others are left in the submission queue
+                to_submit -= res;
+                continue;
+            }
+            if (errno != EINTR) {
+                return Status::IOError("io_uring_enter failed: {}", errno_to_str());
+            }
+        }
+    }
+
+    // Calls `fn(user_data, res)` for each completed read, and returns their number.
+    template <typename Fn>
+    unsigned reap(Fn&& fn) {
+        unsigned head = *_cq_head;
+        unsigned tail = __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE);
+        unsigned num = 0;
+        for (; head != tail; ++head, ++num) {
+            const io_uring_cqe& cqe = _cqes[head & _cq_mask];
+            fn(cqe.user_data, cqe.res);
+        }
+        __atomic_store_n(_cq_head, head, __ATOMIC_RELEASE);
+        return num;
+    }
+
+private:
+    int _fd = -1;
+    void* _sq_ptr = MAP_FAILED;
+    size_t _sq_size = 0;
+    void* _cq_ptr = MAP_FAILED;
+    size_t _cq_size = 0;
+    io_uring_sqe* _sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+    size_t _sqes_size = 0;
+
+    unsigned* _sq_tail = nullptr;
+    unsigned _sq_mask = 0;
+    unsigned* _sq_array = nullptr;
+    unsigned* _cq_head = nullptr;
+    unsigned* _cq_tail = nullptr;
+    unsigned _cq_mask = 0;
+    io_uring_cqe* _cqes = nullptr;
+    unsigned _entries = 0;
+};
+
+// nullptr if it fails to be set up
+Ring* thread_ring() {
+    static thread_local std::unique_ptr<Ring> ring;
+    static thread_local bool inited = false;
+    if (!inited) {
+        inited = true;
+        auto new_ring = std::make_unique<Ring>();
+        Status st = new_ring->init(std::max(config::io_uring_queue_depth, 1));
+        if (st.ok()) {
+            ring = std::move(new_ring);
+        } else {
+            LOG(WARNING) << "io_uring is disabled, since " << st;
+            io_uring_available = false;
+        }
+    }
+    return ring.get();
+}
+
+#endif
+
+} // namespace
+
+bool IOUring::available() {
+    return io_uring_available.load(std::memory_order_relaxed);
+}
+
+Status IOUring::read(std::vector<Read>* reads) {
+#ifdef DORIS_HAVE_IO_URING
+    Ring* ring = available() ? thread_ring() : nullptr;
+    if (ring == nullptr) {
+        return Status::NotSupported("io_uring is not available");
+    }
+
+    // the buffers of the reads in flight, the short reads are submitted again for the rest
+    std::vector<iovec> iovs(reads->size());
+    std::vector<size_t> to_retry;
+    size_t next = 0;
+    unsigned in_flight = 0;
+    Status st;
+    while (true) {
+        unsigned to_submit = 0;
+        while (st.ok() && in_flight + to_submit < ring->entries()) {
+            size_t i;
+            if (!to_retry.empty()) {
+                i = to_retry.back();
+                to_retry.pop_back();
+            } else if (next < reads->size()) {
+                i = next++;
+            } else {
+                break;
+            }
+            Read& read = (*reads)[i];
+            iovs[i] = {read.buf + read.bytes_read, read.len - read.bytes_read};
+            ring->prepare_read(read.fd, &iovs[i], read.offset + read.bytes_read, i);
+            ++to_submit;
+        }
+        if (in_flight + to_submit == 0) {
+            break;
+        }
+        Status submit_st = ring->submit_and_wait(to_submit);
+        if (!submit_st.ok()) {
+            // the kernel may still write into the buffers, they can't be released
+            LOG(FATAL) << "failed to wait for the reads by io_uring: " << submit_st;
+        }
+        in_flight += to_submit;
+        in_flight -= ring->reap([&](uint64_t i, int res) {
+            Read& read = (*reads)[i];
+            if (res > 0) {
+                read.bytes_read += res;
+                if (read.bytes_read < read.len) {
+                    to_retry.push_back(i);
+                }
+            } else if (res == -EINTR || res == -EAGAIN) {
+                to_retry.push_back(i);
+            } else if (res < 0 && st.ok()) {
+                st = Status::IOError("failed to read by io_uring: {}", std::strerror(-res));
+            }
+            // 0 is the end of the file
+        });
+    }
+    return st;
+#else
+    return Status::NotSupported("io_uring is not supported by the build");
+#endif
+}
+
+} // namespace io
+} // namespace doris
@@ -0,0 +1,54 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "common/status.h"
+
+namespace doris {
+namespace io {
+
+// Issues a batch of reads of the local files by io_uring, so that a thread keeps many reads in
+// flight, instead of waiting for each pread() in turn.
+//
+// Each thread has its own ring of config::io_uring_queue_depth entries, set up by the raw
+// syscalls when it's first used, and the reads are submitted and reaped by one io_uring_enter()
+// as long as there are free entries.
+class IOUring {
+public:
+    struct Read {
+        int fd;
+        size_t offset;
+        char* buf;
+        size_t len;
+        // less than `len` only at the end of the file
+        size_t bytes_read = 0;
+    };
+
+    // Whether io_uring is supported by the build and the kernel as far as known, it turns false
+    // once a ring fails to be set up.
+    static bool available();
+
+    // Reads all the requests, and returns NotSupported if there's no ring, then nothing is read.
+    static Status read(std::vector<Read>* reads);
+};
+
+} // namespace io
+} // namespace doris
@@ -20,6 +20,7 @@
 #include "gutil/strings/stringpiece.h"
 #include "io/cache/block/cached_remote_file_reader.h"
 #include "io/cache/file_cache_manager.h"
+#include "io/fs/buffered_reader.h"
 #include "io/fs/file_reader_options.h"
 #include "util/async_io.h"
 
@@ -68,7 +69,16 @@ Status RemoteFileSystem::connect() {
 Status RemoteFileSystem::open_file_impl(const Path& path, const FileReaderOptions& reader_options,
                                         FileReaderSPtr* reader) {
     FileReaderSPtr raw_reader;
-    RETURN_IF_ERROR(open_file_internal(path, reader_options.file_size, &raw_reader));
+    if (reader_options.file_offset > 0) {
+        DCHECK_GE(reader_options.file_size, 0);
+        RETURN_IF_ERROR(open_file_internal(
+                path, reader_options.file_offset + reader_options.file_size, &raw_reader));
+        // the cache wraps the range, so the files packed into one object are cached separately
+        raw_reader = std::make_shared<RangeFileReader>(
+                std::move(raw_reader), reader_options.file_offset, reader_options.file_size);
+    } else {
+        RETURN_IF_ERROR(open_file_internal(path, reader_options.file_size, &raw_reader));
+    }
     switch (reader_options.cache_type) {
     case io::FileCachePolicy::NO_CACHE: {
         *reader = raw_reader;
@@ -21,8 +21,11 @@
 #include <aws/s3/model/GetObjectRequest.h>
 
 #include "io/fs/s3_common.h"
+#include "runtime/thread_context.h"
 #include "util/async_io.h"
 #include "util/doris_metrics.h"
+#include "util/stopwatch.hpp"
+#include "util/time.h"
 
 namespace doris {
 namespace io {
@@ -74,7 +77,15 @@ Status S3FileReader::read_at_impl(size_t offset, Slice result, size_t* bytes_rea
     if (!client) {
         return Status::InternalError("init s3 client error");
     }
+    MonotonicStopWatch watch;
+    watch.start();
     auto outcome = client->GetObject(request);
+    DorisMetrics::instance()->s3_get_latency_us->add(watch.elapsed_time() / NANOS_PER_MICRO);
+    IOStatistics* io_stats = thread_context()->io_statistics;
+    if (io_stats != nullptr) {
+        IOStatistics::add(io_stats->remote_read_requests, 1);
+        IOStatistics::add(io_stats->remote_read_ns, watch.elapsed_time());
+    }
     if (!outcome.IsSuccess()) {
         return Status::IOError("failed to read from {}: {}", _path.native(),
                                outcome.GetError().GetMessage());
@@ -84,6 +95,9 @@ Status S3FileReader::read_at_impl(size_t offset, Slice result, size_t* bytes_rea
         return Status::IOError("failed to read from {}(bytes read: {}, bytes req: {})",
                                _path.native(), *bytes_read, bytes_req);
     }
+    if (io_stats != nullptr) {
+        IOStatistics::add(io_stats->remote_bytes_read, *bytes_read);
+    }
     DorisMetrics::instance()->s3_bytes_read_total->increment(*bytes_read);
     return Status::OK();
 }
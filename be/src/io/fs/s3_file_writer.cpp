@@ -31,14 +31,18 @@
 #include <sys/uio.h>
 
 #include <cerrno>
+#include <condition_variable>
 
 #include "common/compiler_util.h"
+#include "common/config.h"
 #include "common/status.h"
 #include "gutil/macros.h"
 #include "io/fs/file_writer.h"
 #include "io/fs/path.h"
 #include "io/fs/s3_file_system.h"
+#include "runtime/exec_env.h"
 #include "util/doris_metrics.h"
+#include "util/threadpool.h"
 
 using Aws::S3::Model::AbortMultipartUploadRequest;
 using Aws::S3::Model::CompletedPart;
@@ -56,6 +60,39 @@ namespace io {
 static const int MAX_SIZE_EACH_PART = 5 * 1024 * 1024;
 static const char* STREAM_TAG = "S3FileWriter";
 
+namespace {
+
+// Bounds the memory of the parts being uploaded by all the writers to
+// config::s3_file_writer_max_buffer_mb. A part is always let go if there's no other part being
+// uploaded, so a part larger than the limit doesn't wait forever.
+class PartBufferLimiter {
+public:
+    void acquire(int64_t bytes) {
+        std::unique_lock l(_mutex);
+        _cv.wait(l, [&] {
+            return _used == 0 || _used + bytes <= config::s3_file_writer_max_buffer_mb << 20;
+        });
+        _used += bytes;
+    }
+
+    void release(int64_t bytes) {
+        {
+            std::lock_guard l(_mutex);
+            _used -= bytes;
+        }
+        _cv.notify_all();
+    }
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    int64_t _used = 0;
+};
+
+PartBufferLimiter s_part_buffer_limiter;
+
+} // namespace
+
 S3FileWriter::S3FileWriter(Path path, std::shared_ptr<Aws::S3::S3Client> client,
                            const S3Conf& s3_conf, FileSystemSPtr fs)
         : FileWriter(std::move(path), fs), _client(client), _s3_conf(s3_conf) {
@@ -67,6 +104,8 @@ S3FileWriter::~S3FileWriter() {
     if (_opened) {
         close();
     }
+    // the uploads reference this writer
+    _wait_uploads();
     CHECK(!_opened || _closed) << "open: " << _opened << ", closed: " << _closed;
 }
 
@@ -75,6 +114,8 @@ Status S3FileWriter::close() {
 }
 
 Status S3FileWriter::abort() {
+    // the parts finishing after the abort would be kept by S3
+    _wait_uploads();
     AbortMultipartUploadRequest request;
     request.WithBucket(_s3_conf.bucket).WithKey(_path.native()).WithUploadId(_upload_id);
     auto outcome = _client->AbortMultipartUpload(request);
@@ -107,7 +148,7 @@ Status S3FileWriter::appendv(const Slice* data, size_t data_cnt) {
         _stream_ptr->seekg(0LL, _stream_ptr->end);
         _stream_ptr->seekg(start_pos);
     }
-    if (_stream_ptr->str().size() >= MAX_SIZE_EACH_PART) {
+    if (_stream_ptr->tellp() >= MAX_SIZE_EACH_PART) {
         RETURN_IF_ERROR(_upload_part());
     }
     return Status::OK();
@@ -142,53 +183,112 @@ Status S3FileWriter::_open() {
 }
 
 Status S3FileWriter::_upload_part() {
-    if (_stream_ptr->str().size() == 0) {
+    if (_stream_ptr->tellp() <= 0) {
         return Status::OK();
     }
-    ++_cur_part_num;
+    int part_num = ++_cur_part_num;
+    std::shared_ptr<Aws::StringStream> stream = std::move(_stream_ptr);
+    _reset_stream();
+
+    ThreadPool* pool = ExecEnv::GetInstance()->s3_file_upload_thread_pool();
+    if (pool == nullptr || config::s3_file_writer_upload_parallelism <= 1) {
+        RETURN_IF_ERROR(_wait_uploads());
+        return _upload_one_part(part_num, stream);
+    }
+    {
+        // fail early if a previous part failed
+        std::lock_guard l(_completed_lock);
+        RETURN_IF_ERROR(_upload_status);
+    }
+    if (_upload_token == nullptr) {
+        _upload_token = pool->new_token(ThreadPool::ExecutionMode::CONCURRENT,
+                                        config::s3_file_writer_upload_parallelism);
+    }
+    int64_t bytes = stream->tellp();
+    s_part_buffer_limiter.acquire(bytes);
+    Status st = _upload_token->submit_func([this, part_num, stream, bytes]() {
+        Status upload_st;
+        {
+            std::lock_guard l(_completed_lock);
+            upload_st = _upload_status;
+        }
+        // skip the part if the upload already failed
+        if (upload_st.ok()) {
+            upload_st = _upload_one_part(part_num, stream);
+        }
+        s_part_buffer_limiter.release(bytes);
+        if (!upload_st.ok()) {
+            std::lock_guard l(_completed_lock);
+            if (_upload_status.ok()) {
+                _upload_status = upload_st;
+            }
+        }
+    });
+    if (!st.ok()) {
+        s_part_buffer_limiter.release(bytes);
+    }
+    return st;
+}
 
+Status S3FileWriter::_upload_one_part(int part_num,
+                                      const std::shared_ptr<Aws::StringStream>& stream) {
     UploadPartRequest upload_request;
     upload_request.WithBucket(_s3_conf.bucket)
             .WithKey(_path.native())
-            .WithPartNumber(_cur_part_num)
+            .WithPartNumber(part_num)
             .WithUploadId(_upload_id);
 
-    upload_request.SetBody(_stream_ptr);
+    upload_request.SetBody(stream);
 
-    Aws::Utils::ByteBuffer part_md5(Aws::Utils::HashingUtils::CalculateMD5(*_stream_ptr));
+    Aws::Utils::ByteBuffer part_md5(Aws::Utils::HashingUtils::CalculateMD5(*stream));
     upload_request.SetContentMD5(Aws::Utils::HashingUtils::Base64Encode(part_md5));
-
-    auto start_pos = _stream_ptr->tellg();
-    _stream_ptr->seekg(0LL, _stream_ptr->end);
-    upload_request.SetContentLength(static_cast<long>(_stream_ptr->tellg()));
-    _stream_ptr->seekg(start_pos);
-
-    auto upload_part_callable = _client->UploadPartCallable(upload_request);
-
-    UploadPartOutcome upload_part_outcome = upload_part_callable.get();
-    _reset_stream();
+    upload_request.SetContentLength(static_cast<long>(stream->tellp()));
+
+    UploadPartOutcome upload_part_outcome;
+    for (int retry = 0;; ++retry) {
+        // a failed attempt may have consumed the stream
+        stream->clear();
+        stream->seekg(0);
+        upload_part_outcome = _client->UploadPart(upload_request);
+        if (upload_part_outcome.IsSuccess() || retry >= config::s3_file_writer_max_part_retries) {
+            break;
+        }
+        LOG(WARNING) << "failed to upload part, retry " << retry + 1
+                     << " (endpoint=" << _s3_conf.endpoint << ", bucket=" << _s3_conf.bucket
+                     << ", key=" << _path.native() << ", part_num=" << part_num
+                     << ") Error msg: " << upload_part_outcome.GetError().GetMessage();
+    }
     if (!upload_part_outcome.IsSuccess()) {
         LOG(ERROR) << "failed to upload part (endpoint=" << _s3_conf.endpoint
                    << ", bucket=" << _s3_conf.bucket << ", key=" << _path.native()
-                   << ", part_num=" << _cur_part_num
+                   << ", part_num=" << part_num
                    << ") Error msg: " << upload_part_outcome.GetError().GetMessage();
         return Status::IOError("failed to upload part.");
     }
 
     std::shared_ptr<CompletedPart> completed_part = std::make_shared<CompletedPart>();
-    completed_part->SetPartNumber(_cur_part_num);
+    completed_part->SetPartNumber(part_num);
     auto etag = upload_part_outcome.GetResult().GetETag();
     if (etag.empty()) {
         LOG(ERROR) << "upload part success but etag is empty (endpoint=" << _s3_conf.endpoint
                    << ", bucket=" << _s3_conf.bucket << ", key=" << _path.native()
-                   << ", part_num=" << _cur_part_num << ")";
+                   << ", part_num=" << part_num << ")";
         return Status::IOError("upload part success but etag is empty.");
     }
     completed_part->SetETag(etag);
+    std::lock_guard l(_completed_lock);
     _completed_parts.emplace_back(completed_part);
     return Status::OK();
 }
 
+Status S3FileWriter::_wait_uploads() {
+    if (_upload_token != nullptr) {
+        _upload_token->wait();
+    }
+    std::lock_guard l(_completed_lock);
+    return _upload_status;
+}
+
 void S3FileWriter::_reset_stream() {
     _stream_ptr = Aws::MakeShared<Aws::StringStream>(STREAM_TAG, "");
 }
@@ -198,7 +298,14 @@ Status S3FileWriter::_close() {
         return Status::OK();
     }
     if (_is_open) {
-        RETURN_IF_ERROR(_upload_part());
+        Status st = _upload_part();
+        Status wait_st = _wait_uploads();
+        RETURN_IF_ERROR(st);
+        RETURN_IF_ERROR(wait_st);
+        // the parts must be in ascending order of their numbers
+        _completed_parts.sort([](const auto& lhs, const auto& rhs) {
+            return lhs->GetPartNumber() < rhs->GetPartNumber();
+        });
 
         CompleteMultipartUploadRequest complete_request;
         complete_request.WithBucket(_s3_conf.bucket)
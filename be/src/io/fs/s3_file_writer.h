@@ -19,6 +19,7 @@
 
 #include <cstddef>
 #include <list>
+#include <mutex>
 
 #include "io/fs/file_writer.h"
 #include "io/fs/s3_file_system.h"
@@ -32,6 +33,8 @@ class S3Client;
 } // namespace Aws::S3
 
 namespace doris {
+class ThreadPoolToken;
+
 namespace io {
 
 class S3FileWriter final : public FileWriter {
@@ -51,7 +54,11 @@ public:
 private:
     Status _close();
     Status _open();
+    // Uploads the buffered data as the next part, in the upload thread pool if there's one.
     Status _upload_part();
+    Status _upload_one_part(int part_num, const std::shared_ptr<Aws::StringStream>& stream);
+    // Waits for the parts being uploaded, returns the first error of them.
+    Status _wait_uploads();
     void _reset_stream();
 
 private:
@@ -64,7 +71,14 @@ private:
     std::shared_ptr<Aws::StringStream> _stream_ptr;
     // Current Part Num for CompletedPart
     int _cur_part_num = 0;
+    // The parts are uploaded concurrently through the token, up to
+    // config::s3_file_writer_upload_parallelism at a time.
+    std::unique_ptr<ThreadPoolToken> _upload_token;
+    std::mutex _completed_lock;
+    // Guarded by _completed_lock, in the order the uploads finish.
     std::list<std::shared_ptr<Aws::S3::Model::CompletedPart>> _completed_parts;
+    // The first error of the uploads, guarded by _completed_lock.
+    Status _upload_status;
 };
 
 } // namespace io
@@ -17,6 +17,8 @@
 
 #include "stream_load_pipe.h"
 
+#include <algorithm>
+
 #include "olap/iterators.h"
 #include "runtime/thread_context.h"
 #include "util/bit_util.h"
@@ -102,6 +104,57 @@ Status StreamLoadPipe::read_one_message(std::unique_ptr<uint8_t[]>* data, size_t
     return st;
 }
 
+Status StreamLoadPipe::read_one_message(ByteBufferPtr* buf) {
+    if (_total_length < -1) {
+        return Status::InternalError("invalid, _total_length is: {}", _total_length);
+    } else if (_total_length == 0) {
+        // no data
+        buf->reset();
+        return Status::OK();
+    }
+
+    if (_total_length == -1) {
+        return read_buffer(buf);
+    }
+
+    // _total_length > 0, read the entire data
+    *buf = ByteBuffer::allocate(_total_length);
+    size_t length = 0;
+    RETURN_IF_ERROR(read_at(0, Slice((*buf)->ptr, _total_length), &length));
+    (*buf)->limit = length;
+    return Status::OK();
+}
+
+Status StreamLoadPipe::read_buffer(ByteBufferPtr* buf) {
+    if (_use_proto) {
+        return Status::InternalError("the buffers of a proto pipe can not be read directly");
+    }
+    std::unique_lock<std::mutex> l(_lock);
+    while (!_cancelled && !_finished && _buf_queue.empty()) {
+        _get_cond.wait(l);
+    }
+    // cancelled
+    if (_cancelled) {
+        return Status::InternalError("cancelled: {}", _cancelled_reason);
+    }
+    // finished
+    if (_buf_queue.empty()) {
+        DCHECK(_finished);
+        buf->reset();
+        return Status::OK();
+    }
+    *buf = std::move(_buf_queue.front());
+    _buf_queue.pop_front();
+    _buffered_bytes -= (*buf)->limit;
+    _put_cond.notify_one();
+    return Status::OK();
+}
+
+size_t StreamLoadPipe::buffered_bytes() {
+    std::lock_guard<std::mutex> l(_lock);
+    return _buffered_bytes;
+}
+
 Status StreamLoadPipe::append_and_flush(const char* data, size_t size, size_t proto_byte_size) {
     ByteBufferPtr buf = ByteBuffer::allocate(BitUtil::RoundUpToPowerOfTwo(size + 1));
     buf->put_bytes(data, size);
@@ -240,5 +293,75 @@ void StreamLoadPipe::cancel(const std::string& reason) {
     _put_cond.notify_all();
 }
 
+LineSplitStreamLoadPipe::LineSplitStreamLoadPipe(int num_sub_pipes, std::string line_delimiter,
+                                                 size_t chunk_size)
+        : _line_delimiter(std::move(line_delimiter)), _chunk_size(chunk_size) {
+    DCHECK_GT(num_sub_pipes, 0);
+    DCHECK(!_line_delimiter.empty());
+    for (int i = 0; i < num_sub_pipes; ++i) {
+        _sub_pipes.push_back(std::make_shared<StreamLoadPipe>());
+    }
+}
+
+Status LineSplitStreamLoadPipe::append(const char* data, size_t size) {
+    if (_cancelled) {
+        return Status::InternalError("cancelled: {}", _cancelled_reason);
+    }
+    _pending.append(data, size);
+    if (_pending.size() < _chunk_size) {
+        return Status::OK();
+    }
+    // a line longer than the chunk stays in _pending until its delimiter arrives
+    size_t pos = _pending.rfind(_line_delimiter);
+    if (pos == std::string::npos) {
+        return Status::OK();
+    }
+    size_t chunk_end = pos + _line_delimiter.size();
+    RETURN_IF_ERROR(_append_chunk(_pending.data(), chunk_end));
+    _pending.erase(0, chunk_end);
+    return Status::OK();
+}
+
+Status LineSplitStreamLoadPipe::append(const ByteBufferPtr& buf) {
+    return append(buf->ptr + buf->pos, buf->remaining());
+}
+
+Status LineSplitStreamLoadPipe::_append_chunk(const char* data, size_t size) {
+    auto* sub_pipe = std::min_element(_sub_pipes.begin(), _sub_pipes.end(),
+                                      [](const auto& lhs, const auto& rhs) {
+                                          return lhs->buffered_bytes() < rhs->buffered_bytes();
+                                      })
+                             ->get();
+    return sub_pipe->append_and_flush(data, size);
+}
+
+Status LineSplitStreamLoadPipe::finish() {
+    if (!_pending.empty()) {
+        RETURN_IF_ERROR(_append_chunk(_pending.data(), _pending.size()));
+        _pending.clear();
+    }
+    for (auto& sub_pipe : _sub_pipes) {
+        RETURN_IF_ERROR(sub_pipe->finish());
+    }
+    return StreamLoadPipe::finish();
+}
+
+void LineSplitStreamLoadPipe::cancel(const std::string& reason) {
+    for (auto& sub_pipe : _sub_pipes) {
+        sub_pipe->cancel(reason);
+    }
+    StreamLoadPipe::cancel(reason);
+}
+
+Status LineSplitStreamLoadPipe::take_sub_pipe(FileReaderSPtr* reader) {
+    int idx = _num_taken_sub_pipes++;
+    if (idx >= _sub_pipes.size()) {
+        return Status::InternalError("all the {} sub pipes of the stream load are taken",
+                                     _sub_pipes.size());
+    }
+    *reader = _sub_pipes[idx];
+    return Status::OK();
+}
+
 } // namespace io
 } // namespace doris
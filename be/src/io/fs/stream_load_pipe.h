@@ -19,8 +19,11 @@
 
 #include <gen_cpp/internal_service.pb.h>
 
+#include <atomic>
 #include <condition_variable>
 #include <deque>
+#include <string>
+#include <vector>
 
 #include "io/fs/file_reader.h"
 #include "io/fs/file_system.h"
@@ -67,6 +70,28 @@ public:
 
     Status read_one_message(std::unique_ptr<uint8_t[]>* data, size_t* length);
 
+    // The same as the one above, but a message which is a whole buffer, e.g. a kafka message of
+    // a routine load, is taken without copying. The remaining bytes of *buf are the message, and
+    // it is set to nullptr if there is no more data.
+    Status read_one_message(ByteBufferPtr* buf);
+
+    // Take the next buffer without copying it, the remaining bytes of *buf are the data,
+    // and it is set to nullptr when the pipe is finished. The reader owns the buffer, and
+    // only one of read_buffer() and read_at() should be used for a pipe.
+    Status read_buffer(ByteBufferPtr* buf);
+
+    // the bytes appended but not read yet
+    size_t buffered_bytes();
+
+    // The number of the sub pipes which are read by different scanners instead of this pipe,
+    // or 0 if this pipe is read by a single scanner.
+    virtual int num_sub_pipes() const { return 0; }
+
+    // each reader of a pipe with sub pipes takes a different sub pipe
+    virtual Status take_sub_pipe(FileReaderSPtr* reader) {
+        return Status::NotSupported("the stream load pipe has no sub pipes");
+    }
+
     FileSystemSPtr fs() const override { return nullptr; }
 
 protected:
@@ -104,5 +129,40 @@ private:
     // no use, only for compatibility with the `Path` interface
     Path _path = "";
 };
+
+// Split the body into chunks which end with the line delimiter, and append each chunk
+// to the sub pipe with the least buffered bytes. Each sub pipe is read by a different
+// scanner, so that a single body can be parsed in parallel. Only the formats which are
+// split by lines can use it, and the lines of different chunks are not loaded in the
+// order of the body.
+class LineSplitStreamLoadPipe : public StreamLoadPipe {
+public:
+    LineSplitStreamLoadPipe(int num_sub_pipes, std::string line_delimiter,
+                            size_t chunk_size = 1024 * 1024);
+
+    ~LineSplitStreamLoadPipe() override = default;
+
+    Status append(const char* data, size_t size) override;
+
+    Status append(const ByteBufferPtr& buf) override;
+
+    Status finish() override;
+
+    void cancel(const std::string& reason) override;
+
+    int num_sub_pipes() const override { return _sub_pipes.size(); }
+
+    Status take_sub_pipe(FileReaderSPtr* reader) override;
+
+private:
+    Status _append_chunk(const char* data, size_t size);
+
+    std::vector<std::shared_ptr<StreamLoadPipe>> _sub_pipes;
+    std::atomic<int> _num_taken_sub_pipes = 0;
+    const std::string _line_delimiter;
+    const size_t _chunk_size;
+    // the bytes not appended to the sub pipes yet, only accessed by the producer
+    std::string _pending;
+};
 } // namespace io
 } // namespace doris
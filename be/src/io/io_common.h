@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "gen_cpp/Types_types.h"
 
 namespace doris {
@@ -44,6 +46,30 @@ struct FileCacheStatistics {
     int64_t num_io_bytes_skip_cache = 0;
 };
 
+// The I/O of a fragment instance, accumulated by the readers on the threads attached to it, see
+// `ThreadContext::io_statistics`. The counters are updated concurrently by the scanner threads.
+struct IOStatistics {
+    // reads of LocalFileReader, split by whether the data was in the OS page cache
+    std::atomic<int64_t> local_read_requests = 0;
+    std::atomic<int64_t> local_bytes_read_from_page_cache = 0;
+    std::atomic<int64_t> local_bytes_read_from_disk = 0;
+    // lookups of the StoragePageCache
+    std::atomic<int64_t> storage_page_cache_hits = 0;
+    std::atomic<int64_t> storage_page_cache_misses = 0;
+    // reads of the block file cache
+    std::atomic<int64_t> file_cache_hits = 0;
+    std::atomic<int64_t> file_cache_misses = 0;
+    std::atomic<int64_t> file_cache_bytes_read = 0;
+    // GETs of S3 and HDFS
+    std::atomic<int64_t> remote_read_requests = 0;
+    std::atomic<int64_t> remote_bytes_read = 0;
+    std::atomic<int64_t> remote_read_ns = 0;
+
+    static void add(std::atomic<int64_t>& counter, int64_t delta) {
+        counter.fetch_add(delta, std::memory_order_relaxed);
+    }
+};
+
 class IOContext {
 public:
     IOContext() = default;
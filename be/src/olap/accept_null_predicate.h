@@ -104,6 +104,10 @@ public:
         return _nested->evaluate_del(statistic);
     }
 
+    bool may_delete(const std::pair<WrapperField*, WrapperField*>& statistic) const override {
+        return _nested->may_delete(statistic);
+    }
+
     bool evaluate_and(const BloomFilter* bf) const override { return _nested->evaluate_and(bf); }
 
     bool can_do_bloom_filter() const override { return _nested->can_do_bloom_filter(); }
@@ -118,6 +118,10 @@ public:
 
     size_t num_of_column_predicate() const { return _block_column_predicate_vec.size(); }
 
+    const BlockColumnPredicate* column_predicate(size_t i) const {
+        return _block_column_predicate_vec[i];
+    }
+
     void get_all_column_ids(std::set<ColumnId>& column_id_set) const override {
         for (auto child_block_predicate : _block_column_predicate_vec) {
             child_block_predicate->get_all_column_ids(column_id_set);
@@ -24,6 +24,7 @@
 #include "olap/rowset/segment_v2/inverted_index_reader.h"
 #include "olap/schema.h"
 #include "olap/selection_vector.h"
+#include "util/simd/bits.h"
 #include "vec/columns/column.h"
 
 using namespace doris::segment_v2;
@@ -162,6 +163,12 @@ public:
         return false;
     }
 
+    // Only for the delete predicates, which are the opposite of the delete conditions: whether
+    // any row in the zone may match the origin delete condition, i.e. may be deleted by it.
+    virtual bool may_delete(const std::pair<WrapperField*, WrapperField*>& statistic) const {
+        return true;
+    }
+
     virtual bool evaluate_and(const BloomFilter* bf) const { return true; }
 
     virtual bool can_do_bloom_filter() const { return false; }
@@ -233,6 +240,37 @@ public:
     }
 
 protected:
+    // If the rows in sel are dense, i.e. they cover at least half of the range
+    // [sel[0], sel[size - 1]], evaluate the whole range by `eval_flags(first, count, flags)`,
+    // which writes the 0/1 flags of rows [first, first + count) with a branchless loop that
+    // the compiler can vectorize, then convert the flags to sel at the end.
+    // Return -1 if the rows are sparse, the caller should evaluate them one by one.
+    template <typename EvalFlags>
+    static int32_t _evaluate_dense_sel(uint16_t* sel, uint16_t size, EvalFlags&& eval_flags) {
+        static constexpr uint16_t MIN_DENSE_SEL_SIZE = 32;
+        if (size < MIN_DENSE_SEL_SIZE) {
+            return -1;
+        }
+        uint16_t first = sel[0];
+        uint32_t span = sel[size - 1] - first + 1;
+        if (span > 2 * (uint32_t)size) {
+            return -1;
+        }
+        uint8_t flags[span];
+        eval_flags(first, (uint16_t)span, flags);
+        if (span == size) {
+            // sel is [first, first + size)
+            return simd::flags_to_sel(flags, size, first, sel);
+        }
+        uint16_t new_size = 0;
+        for (uint16_t i = 0; i < size; ++i) {
+            uint16_t idx = sel[i];
+            sel[new_size] = idx;
+            new_size += flags[idx - first];
+        }
+        return new_size;
+    }
+
     // Just prevent access not align memory address coredump
     template <class T>
     T _get_zone_map_value(void* data_ptr) const {
@@ -25,6 +25,7 @@
 #include "olap/rowset/rowset_writer_context.h"
 #include "olap/tablet.h"
 #include "olap/task/engine_checksum_task.h"
+#include "util/doris_metrics.h"
 #include "util/time.h"
 #include "util/trace.h"
 
@@ -71,7 +72,9 @@ Status Compaction::do_compaction(int64_t permits) {
 
     _tablet->data_dir()->disks_compaction_score_increment(permits);
     _tablet->data_dir()->disks_compaction_num_increment(1);
+    int64_t start_ns = MonotonicNanos();
     Status st = do_compaction_impl(permits);
+    update_latency_metric((MonotonicNanos() - start_ns) / NANOS_PER_MICRO);
     _tablet->data_dir()->disks_compaction_score_increment(-permits);
     _tablet->data_dir()->disks_compaction_num_increment(-1);
 
@@ -88,6 +91,22 @@ Status Compaction::do_compaction(int64_t permits) {
     return st;
 }
 
+void Compaction::update_latency_metric(int64_t latency_us) {
+    switch (compaction_type()) {
+    case ReaderType::READER_BASE_COMPACTION:
+        DorisMetrics::instance()->base_compaction_latency_us->add(latency_us);
+        break;
+    case ReaderType::READER_CUMULATIVE_COMPACTION:
+        DorisMetrics::instance()->cumulative_compaction_latency_us->add(latency_us);
+        break;
+    case ReaderType::READER_COLD_DATA_COMPACTION:
+        DorisMetrics::instance()->cold_data_compaction_latency_us->add(latency_us);
+        break;
+    default:
+        break;
+    }
+}
+
 bool Compaction::should_vertical_compaction() {
     // some conditions that not use vertical compaction
     if (!config::enable_vertical_compaction) {
@@ -425,8 +444,25 @@ Status Compaction::modify_rowsets(const Merger::Statistics* stats) {
             }
         }
 
+        // The output rowset is only read at its end version or later, so the bitmaps of the
+        // earlier versions are kept as one.
+        output_rowset_delete_bitmap.aggregate(0, _output_rowset->end_version());
+
         RETURN_IF_ERROR(_tablet->check_rowid_conversion(_output_rowset, location_map));
         location_map.clear();
+
+        // Catch up with the loads published during the conversion above without any lock, so
+        // that only the ones published after the catch up are converted under the lock.
+        Version catch_up_version = _tablet->max_version();
+        if (catch_up_version.second > version.second) {
+            _tablet->calc_compaction_output_rowset_delete_bitmap(
+                    _input_rowsets, _rowid_conversion, version.second,
+                    catch_up_version.second + 1, &missed_rows, &location_map,
+                    &output_rowset_delete_bitmap);
+            RETURN_IF_ERROR(_tablet->check_rowid_conversion(_output_rowset, location_map));
+            location_map.clear();
+            version = catch_up_version;
+        }
         {
             std::lock_guard<std::mutex> wrlock_(_tablet->get_rowset_update_lock());
             std::lock_guard<std::shared_mutex> wrlock(_tablet->get_header_lock());
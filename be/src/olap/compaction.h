@@ -83,6 +83,7 @@ protected:
     Status do_compact_ordered_rowsets();
     bool is_rowset_tidy(std::string& pre_max_key, const RowsetSharedPtr& rhs);
     void build_basic_info();
+    void update_latency_metric(int64_t latency_us);
 
 protected:
     // the root tracker for this compaction
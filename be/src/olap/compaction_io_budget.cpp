@@ -0,0 +1,79 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/compaction_io_budget.h"
+
+#include <algorithm>
+
+#include "common/config.h"
+#include "util/doris_metrics.h"
+#include "util/time.h"
+
+namespace doris {
+
+int64_t CompactionIOBudget::bytes_per_sec() {
+    int64_t budget = config::compaction_io_budget_mb_per_sec_per_disk * 1024 * 1024;
+    if (budget <= 0) {
+        return 0;
+    }
+    int64_t full_load = config::compaction_io_budget_full_query_load_mb_per_sec * 1024 * 1024;
+    double min_ratio = std::clamp(config::compaction_io_budget_min_ratio, 0.0, 1.0);
+    double ratio = 1.0;
+    if (full_load > 0) {
+        double load = static_cast<double>(
+                              DorisMetrics::instance()->query_scan_bytes_per_second->value()) /
+                      full_load;
+        ratio = 1.0 - std::min(load, 1.0) * (1.0 - min_ratio);
+    }
+    return std::max<int64_t>(budget * ratio, 1);
+}
+
+CompactionIOBudget::Bucket& CompactionIOBudget::_refill(DataDir* data_dir, int64_t bytes_per_sec) {
+    int64_t now_ms = MonotonicMillis();
+    auto [it, inserted] = _buckets.try_emplace(data_dir);
+    Bucket& bucket = it->second;
+    if (inserted) {
+        bucket.tokens = bytes_per_sec;
+    } else {
+        // at most one second of burst
+        bucket.tokens = std::min<double>(
+                bucket.tokens + bytes_per_sec * (now_ms - bucket.last_refill_ms) / 1000.0,
+                bytes_per_sec);
+    }
+    bucket.last_refill_ms = now_ms;
+    return bucket;
+}
+
+bool CompactionIOBudget::has_budget(DataDir* data_dir) {
+    int64_t rate = bytes_per_sec();
+    if (rate == 0) {
+        return true;
+    }
+    std::lock_guard l(_lock);
+    return _refill(data_dir, rate).tokens > 0;
+}
+
+void CompactionIOBudget::consume(DataDir* data_dir, int64_t bytes) {
+    int64_t rate = bytes_per_sec();
+    if (rate == 0) {
+        return;
+    }
+    std::lock_guard l(_lock);
+    _refill(data_dir, rate).tokens -= bytes;
+}
+
+} // namespace doris
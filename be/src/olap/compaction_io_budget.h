@@ -0,0 +1,58 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+namespace doris {
+
+class DataDir;
+
+// The bandwidth budget of the compaction tasks on each disk, a token bucket refilled with
+// config::compaction_io_budget_mb_per_sec_per_disk per second, which shrinks while the queries
+// scan more bytes.
+//
+// A task takes the bytes it reads and writes from the bucket of its disk when it starts, and
+// no more task is picked for the disk until the bucket is refilled, so a large task is not
+// starved, but delays the tasks after it.
+class CompactionIOBudget {
+public:
+    // the budget per second of a disk for now, 0 if unlimited
+    static int64_t bytes_per_sec();
+
+    // whether a new task could be started on the disk
+    bool has_budget(DataDir* data_dir);
+
+    void consume(DataDir* data_dir, int64_t bytes);
+
+private:
+    struct Bucket {
+        double tokens = 0;
+        int64_t last_refill_ms = 0;
+    };
+
+    // Caller should hold _lock.
+    Bucket& _refill(DataDir* data_dir, int64_t bytes_per_sec);
+
+    std::mutex _lock;
+    std::unordered_map<DataDir*, Bucket> _buckets;
+};
+
+} // namespace doris
@@ -189,6 +189,11 @@ public:
         }
     }
 
+    // evaluate_and ignores the opposite flag, so it's of the origin delete condition
+    bool may_delete(const std::pair<WrapperField*, WrapperField*>& statistic) const override {
+        return evaluate_and(statistic);
+    }
+
     bool evaluate_del(const std::pair<WrapperField*, WrapperField*>& statistic) const override {
         if (statistic.first->is_null() || statistic.second->is_null()) {
             return false;
@@ -505,6 +510,29 @@ private:
     template <bool is_nullable, typename TArray, typename TValue>
     uint16_t _base_loop(uint16_t* sel, uint16_t size, const uint8_t* __restrict null_map,
                         const TArray* __restrict data_array, const TValue& value) const {
+        // numbers and dictionary codes are cheap to compare, evaluate dense rows by SIMD
+        if constexpr (std::is_arithmetic_v<TArray>) {
+            auto dense_size = _evaluate_dense_sel(
+                    sel, size, [&](uint16_t first, uint16_t count, uint8_t* flags) {
+                        if constexpr (is_nullable) {
+                            _base_loop_vec<true, false>(count, reinterpret_cast<bool*>(flags),
+                                                        null_map + first, data_array + first,
+                                                        value);
+                        } else {
+                            _base_loop_vec<false, false>(count, reinterpret_cast<bool*>(flags),
+                                                         nullptr, data_array + first, value);
+                        }
+                        if (_opposite) {
+                            for (uint16_t i = 0; i < count; ++i) {
+                                flags[i] ^= 1;
+                            }
+                        }
+                    });
+            if (dense_size >= 0) {
+                return dense_size;
+            }
+        }
+
         uint16_t new_size = 0;
         for (uint16_t i = 0; i < size; ++i) {
             uint16_t idx = sel[i];
@@ -17,6 +17,7 @@
 
 #include "olap/cumulative_compaction_policy.h"
 
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
 #include <string>
 
@@ -338,8 +339,214 @@ int64_t SizeBasedCumulativeCompactionPolicy::_level_size(const int64_t size) {
     return (int64_t)1 << (sizeof(size) * 8 - 1 - __builtin_clzl(size));
 }
 
+TimeSeriesCumulativeCompactionPolicy::TimeSeriesCumulativeCompactionPolicy(
+        int64_t goal_size, int64_t file_count_threshold, int64_t time_threshold_seconds)
+        : _goal_size(goal_size),
+          _file_count_threshold(file_count_threshold),
+          _time_threshold_seconds(time_threshold_seconds) {}
+
+void TimeSeriesCumulativeCompactionPolicy::calculate_cumulative_point(
+        Tablet* tablet, const std::vector<RowsetMetaSharedPtr>& all_metas,
+        int64_t current_cumulative_point, int64_t* ret_cumulative_point) {
+    *ret_cumulative_point = Tablet::K_INVALID_CUMULATIVE_POINT;
+    if (current_cumulative_point != Tablet::K_INVALID_CUMULATIVE_POINT) {
+        // only calculate the point once.
+        // after that, cumulative point will be updated along with compaction process.
+        return;
+    }
+    // empty return
+    if (all_metas.empty()) {
+        return;
+    }
+
+    std::vector<RowsetMetaSharedPtr> existing_rss(all_metas.begin(), all_metas.end());
+    // sort the existing rowsets by version in ascending order
+    std::sort(existing_rss.begin(), existing_rss.end(), RowsetMeta::comparator);
+
+    if (tablet->tablet_state() == TABLET_RUNNING) {
+        // check base rowset first version must be zero
+        // for tablet which state is not TABLET_RUNNING, there may not have base version.
+        CHECK(existing_rss.front()->start_version() == 0);
+
+        int64_t prev_version = -1;
+        for (const RowsetMetaSharedPtr& rs : existing_rss) {
+            if (rs->version().first > prev_version + 1) {
+                // There is a hole, do not continue
+                break;
+            }
+            // the output rowsets of compaction have been compacted once, and the big rowsets
+            // are not compacted
+            bool is_compacted = rs->version().first != rs->version().second;
+            if (!rs->has_delete_predicate() && rs->version().first != 0 &&
+                (rs->is_segments_overlapping() || !(is_compacted || _is_big_rowset(rs)))) {
+                *ret_cumulative_point = rs->version().first;
+                break;
+            }
+            prev_version = rs->version().second;
+            *ret_cumulative_point = prev_version + 1;
+        }
+        VLOG_NOTICE
+                << "cumulative compaction time_series policy, calculate cumulative point value = "
+                << *ret_cumulative_point << " tablet = " << tablet->full_name();
+    } else if (tablet->tablet_state() == TABLET_NOTREADY) {
+        // tablet under alter process
+        // we choose version next to the base version as cumulative point
+        for (const RowsetMetaSharedPtr& rs : existing_rss) {
+            if (rs->version().first > 0) {
+                *ret_cumulative_point = rs->version().first;
+                break;
+            }
+        }
+    }
+}
+
+void TimeSeriesCumulativeCompactionPolicy::update_cumulative_point(
+        Tablet* tablet, const std::vector<RowsetSharedPtr>& input_rowsets,
+        RowsetSharedPtr output_rowset, Version& last_delete_version) {
+    if (tablet->tablet_state() != TABLET_RUNNING) {
+        // if tablet under alter process, do not update cumulative point
+        return;
+    }
+    // the output rowset is never compacted again by cumulative compaction
+    tablet->set_cumulative_layer_point(output_rowset->end_version() + 1);
+}
+
+uint32_t TimeSeriesCumulativeCompactionPolicy::calc_cumulative_compaction_score(Tablet* tablet) {
+    uint32_t score = 0;
+    bool base_rowset_exist = false;
+    const int64_t point = tablet->cumulative_layer_point();
+    int64_t total_size = 0;
+    int64_t num_rowsets = 0;
+    int64_t min_creation_time = INT64_MAX;
+    // NOTE: tablet._meta_lock is hold
+    for (auto& rs_meta : tablet->tablet_meta()->all_rs_metas()) {
+        // check base rowset
+        if (rs_meta->start_version() == 0) {
+            base_rowset_exist = true;
+        }
+        if (rs_meta->end_version() < point || !rs_meta->is_local()) {
+            // all_rs_metas() is not sorted, so we use _continue_ other than _break_ here.
+            continue;
+        }
+        total_size += rs_meta->total_disk_size();
+        score += rs_meta->get_compaction_score();
+        ++num_rowsets;
+        min_creation_time = std::min(min_creation_time, rs_meta->creation_time());
+    }
+
+    // If base version does not exist, but its state is RUNNING.
+    // It is abnormal, do not select it and set *score = 0
+    if (!base_rowset_exist && tablet->tablet_state() == TABLET_RUNNING) {
+        LOG(WARNING) << "tablet state is running but have no base version";
+        return 0;
+    }
+
+    if (total_size >= _goal_size || num_rowsets >= _file_count_threshold) {
+        return score;
+    }
+    // a single non overlapping rowset does not need compaction
+    if (score > 1 && UnixSeconds() - min_creation_time >= _time_threshold_seconds) {
+        return score;
+    }
+    return 0;
+}
+
+int TimeSeriesCumulativeCompactionPolicy::pick_input_rowsets(
+        Tablet* tablet, const std::vector<RowsetSharedPtr>& candidate_rowsets,
+        const int64_t max_compaction_score, const int64_t min_compaction_score,
+        std::vector<RowsetSharedPtr>* input_rowsets, Version* last_delete_version,
+        size_t* compaction_score) {
+    auto max_version = tablet->max_version().first;
+    int transient_size = 0;
+    *compaction_score = 0;
+    int64_t total_size = 0;
+    for (auto& rowset : candidate_rowsets) {
+        // check whether this rowset is delete version
+        if (rowset->rowset_meta()->has_delete_predicate()) {
+            *last_delete_version = rowset->version();
+            if (!input_rowsets->empty()) {
+                // we meet a delete version, and there were other versions before.
+                // we should compact those version before handling them over to base compaction
+                break;
+            } else {
+                // we meet a delete version, and no other versions before, skip it and continue
+                input_rowsets->clear();
+                *compaction_score = 0;
+                transient_size = 0;
+                continue;
+            }
+        }
+        if (tablet->tablet_state() == TABLET_NOTREADY) {
+            // If tablet under alter, keep latest 10 version so that base tablet max version
+            // not merged in new tablet, and then we can copy data from base tablet
+            if (rowset->version().second < max_version - 10) {
+                continue;
+            }
+        }
+        if (_is_big_rowset(rowset->rowset_meta())) {
+            if (!input_rowsets->empty()) {
+                // compact the rowsets before it, and it will be given to base next time
+                break;
+            }
+            if (tablet->tablet_state() == TABLET_RUNNING &&
+                rowset->start_version() == tablet->cumulative_layer_point()) {
+                // the big rowset is never rewritten, give it to base directly
+                tablet->set_cumulative_layer_point(rowset->end_version() + 1);
+            }
+            continue;
+        }
+        if (*compaction_score >= max_compaction_score || total_size >= _goal_size) {
+            // got enough rowsets
+            break;
+        }
+        *compaction_score += rowset->rowset_meta()->get_compaction_score();
+        total_size += rowset->rowset_meta()->total_disk_size();
+
+        transient_size += 1;
+        input_rowsets->push_back(rowset);
+    }
+
+    // empty return
+    if (input_rowsets->empty()) {
+        return transient_size;
+    }
+
+    // do compaction if any threshold is reached, or there is delete version, whose previous
+    // versions should be compacted before handling them over to base compaction
+    bool reach_threshold = total_size >= _goal_size ||
+                           *compaction_score >= max_compaction_score ||
+                           input_rowsets->size() >= _file_count_threshold;
+    if (!reach_threshold && last_delete_version->first == -1) {
+        int64_t waited_seconds = UnixSeconds() - input_rowsets->front()->creation_time();
+        if (waited_seconds < _time_threshold_seconds) {
+            input_rowsets->clear();
+            *compaction_score = 0;
+        }
+    }
+    if (input_rowsets->size() == 1) {
+        auto rs_meta = input_rowsets->front()->rowset_meta();
+        // if there is only one rowset and not overlapping,
+        // we do not need to do compaction
+        if (!rs_meta->is_segments_overlapping()) {
+            input_rowsets->clear();
+            *compaction_score = 0;
+        }
+    }
+
+    VLOG_CRITICAL << "cumulative compaction time_series policy, compaction_score = "
+                  << *compaction_score << ", total_size = " << total_size
+                  << ", tablet = " << tablet->full_name() << ", input_rowset size "
+                  << input_rowsets->size();
+    return transient_size;
+}
+
 std::shared_ptr<CumulativeCompactionPolicy>
-CumulativeCompactionPolicyFactory::create_cumulative_compaction_policy() {
+CumulativeCompactionPolicyFactory::create_cumulative_compaction_policy(const std::string& policy) {
+    std::string policy_name = policy.empty() ? config::cumulative_compaction_policy : policy;
+    boost::to_upper(policy_name);
+    if (policy_name == CUMULATIVE_TIME_SERIES_POLICY) {
+        return std::make_shared<TimeSeriesCumulativeCompactionPolicy>();
+    }
     return std::unique_ptr<CumulativeCompactionPolicy>(new SizeBasedCumulativeCompactionPolicy());
 }
 
@@ -30,6 +30,7 @@ namespace doris {
 class Tablet;
 
 const static std::string CUMULATIVE_SIZE_BASED_POLICY = "SIZE_BASED";
+const static std::string CUMULATIVE_TIME_SERIES_POLICY = "TIME_SERIES";
 
 /// This class CumulativeCompactionPolicy is the base class of cumulative compaction policy.
 /// It defines the policy to do cumulative compaction. It has different derived classes, which implements
@@ -167,12 +168,75 @@ private:
     int64_t _compaction_min_size;
 };
 
+/// TimeSeries cumulative compaction policy implementation. It's for the append only tables
+/// partitioned by time, whose write amplification matters more than the read amplification.
+/// The cumulative rowsets are grouped by version until their total size reaches the goal size,
+/// their number reaches the file count threshold or the oldest of them has waited longer than
+/// the time threshold. The output rowset is always given to base directly and the rowsets larger
+/// than the goal size are never rewritten, so a rowset is compacted at most once. Base compaction
+/// is not done for the tablets under this policy.
+class TimeSeriesCumulativeCompactionPolicy final : public CumulativeCompactionPolicy {
+public:
+    TimeSeriesCumulativeCompactionPolicy(
+            int64_t goal_size = config::time_series_compaction_goal_size_mbytes * 1024 * 1024,
+            int64_t file_count_threshold = config::time_series_compaction_file_count_threshold,
+            int64_t time_threshold_seconds =
+                    config::time_series_compaction_time_threshold_seconds);
+
+    ~TimeSeriesCumulativeCompactionPolicy() {}
+
+    /// TimeSeries cumulative compaction policy implements calculate cumulative point function.
+    /// The cumulative point is moved after the rowsets produced by compaction and the rowsets
+    /// larger than the goal size, which do not need compaction any more.
+    void calculate_cumulative_point(Tablet* tablet,
+                                    const std::vector<RowsetMetaSharedPtr>& all_rowsets,
+                                    int64_t current_cumulative_point,
+                                    int64_t* cumulative_point) override;
+
+    /// TimeSeries cumulative compaction policy implements pick input rowsets function.
+    /// It picks the continuous rowsets before a rowset larger than the goal size until the goal
+    /// size is reached, and the leading rowsets larger than the goal size are given to base
+    /// without compaction.
+    int pick_input_rowsets(Tablet* tablet, const std::vector<RowsetSharedPtr>& candidate_rowsets,
+                           const int64_t max_compaction_score, const int64_t min_compaction_score,
+                           std::vector<RowsetSharedPtr>* input_rowsets,
+                           Version* last_delete_version, size_t* compaction_score) override;
+
+    /// TimeSeries cumulative compaction policy implements update cumulative point function.
+    /// The output rowset is always given to base compaction.
+    void update_cumulative_point(Tablet* tablet, const std::vector<RowsetSharedPtr>& input_rowsets,
+                                 RowsetSharedPtr _output_rowset,
+                                 Version& last_delete_version) override;
+
+    /// TimeSeries cumulative compaction policy implements calc cumulative compaction score.
+    /// The score is 0 until the rowsets after the cumulative point reach any of the thresholds.
+    uint32_t calc_cumulative_compaction_score(Tablet* tablet) override;
+
+    std::string name() override { return CUMULATIVE_TIME_SERIES_POLICY; }
+
+private:
+    /// whether the rowset is given to base without compaction
+    bool _is_big_rowset(const RowsetMetaSharedPtr& rs_meta) const {
+        return rs_meta->total_disk_size() >= _goal_size && !rs_meta->is_segments_overlapping();
+    }
+
+private:
+    /// goal size of the output rowset, unit is byte.
+    int64_t _goal_size;
+    /// max number of the rowsets waiting for compaction.
+    int64_t _file_count_threshold;
+    /// max seconds for the rowsets to wait for compaction.
+    int64_t _time_threshold_seconds;
+};
+
 /// The factory of CumulativeCompactionPolicy, it can product different policy according to the `policy` parameter.
 class CumulativeCompactionPolicyFactory {
 public:
     /// Static factory function. It can product different policy according to the `policy` parameter and use tablet ptr
-    /// to construct the policy. Now it can product size based and num based policies.
-    static std::shared_ptr<CumulativeCompactionPolicy> create_cumulative_compaction_policy();
+    /// to construct the policy. Now it can product size based and time series policies.
+    /// config::cumulative_compaction_policy is used if the `policy` is empty.
+    static std::shared_ptr<CumulativeCompactionPolicy> create_cumulative_compaction_policy(
+            const std::string& policy = "");
 };
 
 } // namespace doris
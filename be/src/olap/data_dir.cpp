@@ -39,6 +39,7 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 
 #include "gutil/strings/substitute.h"
 #include "io/fs/fs_utils.h"
@@ -53,6 +54,8 @@
 #include "service/backend_options.h"
 #include "util/errno.h"
 #include "util/string_util.h"
+#include "util/threadpool.h"
+#include "util/time.h"
 
 using strings::Substitute;
 
@@ -66,8 +69,14 @@ DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(disks_remote_used_capacity, MetricUnit::BYTES
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(disks_state, MetricUnit::BYTES);
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(disks_compaction_score, MetricUnit::NOUNIT);
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(disks_compaction_num, MetricUnit::NOUNIT);
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(disks_loaded_tablet_num, MetricUnit::NOUNIT);
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(disks_load_failed_tablet_num, MetricUnit::NOUNIT);
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(disks_load_time_ms, MetricUnit::MILLISECONDS);
 
 static const char* const kTestFilePath = ".testfile";
+// the count of the tablets loaded from the meta by a task
+static const size_t LOAD_BATCH_SIZE = 256;
+static const size_t LOAD_PROGRESS_LOG_INTERVAL = 10000;
 
 DataDir::DataDir(const std::string& path, int64_t capacity_bytes,
                  TStorageMedium::type storage_medium, TabletManager* tablet_manager,
@@ -94,9 +103,15 @@ DataDir::DataDir(const std::string& path, int64_t capacity_bytes,
     INT_GAUGE_METRIC_REGISTER(_data_dir_metric_entity, disks_state);
     INT_GAUGE_METRIC_REGISTER(_data_dir_metric_entity, disks_compaction_score);
     INT_GAUGE_METRIC_REGISTER(_data_dir_metric_entity, disks_compaction_num);
+    INT_GAUGE_METRIC_REGISTER(_data_dir_metric_entity, disks_loaded_tablet_num);
+    INT_GAUGE_METRIC_REGISTER(_data_dir_metric_entity, disks_load_failed_tablet_num);
+    INT_GAUGE_METRIC_REGISTER(_data_dir_metric_entity, disks_load_time_ms);
+    _io_scheduler = std::make_shared<io::LocalIOScheduler>(path, _data_dir_metric_entity);
+    io::LocalIOScheduler::register_scheduler(_io_scheduler);
 }
 
 DataDir::~DataDir() {
+    io::LocalIOScheduler::deregister_scheduler(_io_scheduler.get());
     DorisMetrics::instance()->metric_registry()->deregister_entity(_data_dir_metric_entity);
     delete _id_generator;
     delete _meta;
@@ -382,18 +397,29 @@ Status DataDir::load() {
         LOG(INFO) << "load rowset from meta finished, data dir: " << _path;
     }
 
+    std::unique_ptr<ThreadPool> load_pool;
+    RETURN_IF_ERROR(ThreadPoolBuilder("LoadDataDirThreadPool")
+                            .set_min_threads(config::load_data_dir_thread_num)
+                            .set_max_threads(config::load_data_dir_thread_num)
+                            .build(&load_pool));
+    int64_t start_ms = MonotonicMillis();
+
     // load tablet
     // create tablet from tablet meta and add it to tablet mgr
+    // the tablets are parsed and added in batches by the threads of the pool, and the traversal of
+    // the meta waits for the pool once there are too many pending batches, to bound the memory of
+    // the meta strings
     LOG(INFO) << "begin loading tablet from meta";
+    std::mutex tablet_ids_mutex;
     std::set<int64_t> tablet_ids;
     std::set<int64_t> failed_tablet_ids;
-    auto load_tablet_func = [this, &tablet_ids, &failed_tablet_ids](
-                                    int64_t tablet_id, int32_t schema_hash,
-                                    const std::string& value) -> bool {
+    auto load_tablet = [this, &tablet_ids_mutex, &tablet_ids, &failed_tablet_ids](
+                               int64_t tablet_id, int32_t schema_hash, const std::string& value) {
         Status status = _tablet_manager->load_tablet_from_meta(this, tablet_id, schema_hash, value,
                                                                false, false, false, false);
-        if (!status.ok() && !status.is<TABLE_ALREADY_DELETED_ERROR>() &&
-            !status.is<ENGINE_INSERT_OLD_TABLET>()) {
+        bool failed = !status.ok() && !status.is<TABLE_ALREADY_DELETED_ERROR>() &&
+                      !status.is<ENGINE_INSERT_OLD_TABLET>();
+        if (failed) {
             // load_tablet_from_meta() may return Status::Error<TABLE_ALREADY_DELETED_ERROR>()
             // which means the tablet status is DELETED
             // This may happen when the tablet was just deleted before the BE restarted,
@@ -410,13 +436,65 @@ Status DataDir::load() {
             // failure.
             LOG(WARNING) << "load tablet from header failed. status:" << status
                          << ", tablet=" << tablet_id << "." << schema_hash;
+        } else {
+            TabletSharedPtr tablet = _tablet_manager->get_tablet(tablet_id);
+            if (tablet && tablet->set_tablet_schema_into_rowset_meta()) {
+                TabletMetaManager::save(this, tablet->tablet_id(), tablet->schema_hash(),
+                                        tablet->tablet_meta());
+            }
+        }
+        std::lock_guard<std::mutex> l(tablet_ids_mutex);
+        if (failed) {
             failed_tablet_ids.insert(tablet_id);
+            disks_load_failed_tablet_num->set_value(failed_tablet_ids.size());
         } else {
             tablet_ids.insert(tablet_id);
+            disks_loaded_tablet_num->set_value(tablet_ids.size());
+        }
+        size_t num_tablets = tablet_ids.size() + failed_tablet_ids.size();
+        if (num_tablets % LOAD_PROGRESS_LOG_INTERVAL == 0) {
+            LOG(INFO) << "loading tablets from meta, loaded tablet: " << tablet_ids.size()
+                      << ", error tablet: " << failed_tablet_ids.size() << ", path: " << _path;
+        }
+    };
+
+    struct TabletMetaEntry {
+        int64_t tablet_id;
+        int32_t schema_hash;
+        std::string value;
+    };
+    auto tablet_batch = std::make_shared<std::vector<TabletMetaEntry>>();
+    size_t num_pending_batches = 0;
+    auto submit_tablet_batch = [&]() {
+        auto batch = std::move(tablet_batch);
+        tablet_batch = std::make_shared<std::vector<TabletMetaEntry>>();
+        auto task = [batch, &load_tablet] {
+            for (const auto& entry : *batch) {
+                load_tablet(entry.tablet_id, entry.schema_hash, entry.value);
+            }
+        };
+        if (!load_pool->submit_func(task).ok()) {
+            task();
+        }
+        if (++num_pending_batches >= 2 * static_cast<size_t>(config::load_data_dir_thread_num)) {
+            load_pool->wait();
+            num_pending_batches = 0;
+        }
+    };
+    auto load_tablet_func = [&tablet_batch, &submit_tablet_batch](
+                                    int64_t tablet_id, int32_t schema_hash,
+                                    const std::string& value) -> bool {
+        tablet_batch->push_back({tablet_id, schema_hash, value});
+        if (tablet_batch->size() >= LOAD_BATCH_SIZE) {
+            submit_tablet_batch();
         }
         return true;
     };
     Status load_tablet_status = TabletMetaManager::traverse_headers(_meta, load_tablet_func);
+    if (!tablet_batch->empty()) {
+        submit_tablet_batch();
+    }
+    load_pool->wait();
     if (failed_tablet_ids.size() != 0) {
         LOG(WARNING) << "load tablets from header failed"
                      << ", loaded tablet: " << tablet_ids.size()
@@ -432,99 +510,175 @@ Status DataDir::load() {
     } else {
         LOG(INFO) << "load tablet from meta finished"
                   << ", loaded tablet: " << tablet_ids.size()
-                  << ", error tablet: " << failed_tablet_ids.size() << ", path: " << _path;
-    }
-
-    for (int64_t tablet_id : tablet_ids) {
-        TabletSharedPtr tablet = _tablet_manager->get_tablet(tablet_id);
-        if (tablet && tablet->set_tablet_schema_into_rowset_meta()) {
-            TabletMetaManager::save(this, tablet->tablet_id(), tablet->schema_hash(),
-                                    tablet->tablet_meta());
-        }
+                  << ", error tablet: " << failed_tablet_ids.size() << ", path: " << _path
+                  << ", cost: " << MonotonicMillis() - start_ms << "ms";
     }
 
     // traverse rowset
     // 1. add committed rowset to txn map
     // 2. add visible rowset to tablet
     // ignore any errors when load tablet or rowset, because fe will repair them after report
-    int64_t invalid_rowset_counter = 0;
-    for (auto rowset_meta : dir_rowset_metas) {
-        TabletSharedPtr tablet = _tablet_manager->get_tablet(rowset_meta->tablet_id());
-        // tablet maybe dropped, but not drop related rowset meta
-        if (tablet == nullptr) {
-            VLOG_NOTICE << "could not find tablet id: " << rowset_meta->tablet_id()
-                        << ", schema hash: " << rowset_meta->tablet_schema_hash()
-                        << ", for rowset: " << rowset_meta->rowset_id() << ", skip this rowset";
-            ++invalid_rowset_counter;
-            continue;
+    // the rowsets of a tablet are added in their order in the meta by one thread, and the
+    // tablets are added in batches by the threads of the pool
+    std::unordered_map<int64_t, std::vector<RowsetMetaSharedPtr>> tablet_rowset_metas;
+    for (auto& rowset_meta : dir_rowset_metas) {
+        tablet_rowset_metas[rowset_meta->tablet_id()].push_back(rowset_meta);
+    }
+    std::atomic<int64_t> invalid_rowset_counter {0};
+    std::vector<const std::vector<RowsetMetaSharedPtr>*> rowset_batch;
+    auto submit_rowset_batch = [&]() {
+        auto task = [this, batch = std::move(rowset_batch), &invalid_rowset_counter] {
+            for (const auto* rowset_metas : batch) {
+                for (const auto& rowset_meta : *rowset_metas) {
+                    if (!_load_rowset(rowset_meta)) {
+                        ++invalid_rowset_counter;
+                    }
+                }
+            }
+        };
+        rowset_batch.clear();
+        if (!load_pool->submit_func(task).ok()) {
+            task();
         }
-
-        RowsetSharedPtr rowset;
-        Status create_status = tablet->create_rowset(rowset_meta, &rowset);
-        if (!create_status) {
-            LOG(WARNING) << "could not create rowset from rowsetmeta: "
-                         << " rowset_id: " << rowset_meta->rowset_id()
-                         << " rowset_type: " << rowset_meta->rowset_type()
-                         << " rowset_state: " << rowset_meta->rowset_state();
-            continue;
+    };
+    for (const auto& [tablet_id, rowset_metas] : tablet_rowset_metas) {
+        rowset_batch.push_back(&rowset_metas);
+        if (rowset_batch.size() >= LOAD_BATCH_SIZE) {
+            submit_rowset_batch();
         }
-        if (rowset_meta->rowset_state() == RowsetStatePB::COMMITTED &&
-            rowset_meta->tablet_uid() == tablet->tablet_uid()) {
-            if (!rowset_meta->tablet_schema()) {
-                rowset_meta->set_tablet_schema(tablet->tablet_schema());
-                RowsetMetaManager::save(_meta, rowset_meta->tablet_uid(), rowset_meta->rowset_id(),
-                                        rowset_meta->get_rowset_pb());
-            }
-            Status commit_txn_status = _txn_manager->commit_txn(
-                    _meta, rowset_meta->partition_id(), rowset_meta->txn_id(),
-                    rowset_meta->tablet_id(), rowset_meta->tablet_schema_hash(),
-                    rowset_meta->tablet_uid(), rowset_meta->load_id(), rowset, true);
-            if (!commit_txn_status && !commit_txn_status.is<PUSH_TRANSACTION_ALREADY_EXIST>()) {
-                LOG(WARNING) << "failed to add committed rowset: " << rowset_meta->rowset_id()
-                             << " to tablet: " << rowset_meta->tablet_id()
-                             << " for txn: " << rowset_meta->txn_id();
-            } else {
-                LOG(INFO) << "successfully to add committed rowset: " << rowset_meta->rowset_id()
-                          << " to tablet: " << rowset_meta->tablet_id()
-                          << " schema hash: " << rowset_meta->tablet_schema_hash()
-                          << " for txn: " << rowset_meta->txn_id();
-            }
-        } else if (rowset_meta->rowset_state() == RowsetStatePB::VISIBLE &&
-                   rowset_meta->tablet_uid() == tablet->tablet_uid()) {
-            if (!rowset_meta->tablet_schema()) {
-                rowset_meta->set_tablet_schema(tablet->tablet_schema());
-                RowsetMetaManager::save(_meta, rowset_meta->tablet_uid(), rowset_meta->rowset_id(),
-                                        rowset_meta->get_rowset_pb());
-            }
-            Status publish_status = tablet->add_rowset(rowset);
-            if (!publish_status && !publish_status.is<PUSH_VERSION_ALREADY_EXIST>()) {
-                LOG(WARNING) << "add visible rowset to tablet failed rowset_id:"
-                             << rowset->rowset_id() << " tablet id: " << rowset_meta->tablet_id()
-                             << " txn id:" << rowset_meta->txn_id()
-                             << " start_version: " << rowset_meta->version().first
-                             << " end_version: " << rowset_meta->version().second;
+    }
+    if (!rowset_batch.empty()) {
+        submit_rowset_batch();
+    }
+    load_pool->wait();
+    load_pool->shutdown();
+
+    // merge the delete bitmaps published after the last checkpoints into the tablet metas, whose
+    // rowsets are all added now
+    int64_t num_delete_bitmap_deltas = 0;
+    std::set<int64_t> dropped_tablet_ids;
+    auto load_delete_bitmap_func = [this, &num_delete_bitmap_deltas, &dropped_tablet_ids](
+                                           int64_t tablet_id, int64_t version,
+                                           const std::string& value) -> bool {
+        TabletSharedPtr tablet = _tablet_manager->get_tablet(tablet_id);
+        if (tablet == nullptr || tablet->data_dir() != this) {
+            dropped_tablet_ids.insert(tablet_id);
+            return true;
+        }
+        DeleteBitmapPB delete_bitmap_pb;
+        if (!delete_bitmap_pb.ParseFromString(value)) {
+            LOG(WARNING) << "parse delete bitmap failed, tablet=" << tablet_id
+                         << ", version=" << version;
+            return true;
+        }
+        std::set<RowsetId> rowset_ids;
+        for (const auto& rs_meta : tablet->tablet_meta()->all_rs_metas()) {
+            rowset_ids.insert(rs_meta->rowset_id());
+        }
+        for (int i = 0; i < delete_bitmap_pb.rowset_ids_size(); ++i) {
+            RowsetId rowset_id;
+            rowset_id.init(delete_bitmap_pb.rowset_ids(i));
+            // the rowset may be compacted and removed after the delta is saved
+            if (rowset_ids.count(rowset_id) == 0) {
+                continue;
             }
-        } else {
-            LOG(WARNING) << "find invalid rowset: " << rowset_meta->rowset_id()
-                         << " with tablet id: " << rowset_meta->tablet_id()
-                         << " tablet uid: " << rowset_meta->tablet_uid()
-                         << " schema hash: " << rowset_meta->tablet_schema_hash()
-                         << " txn: " << rowset_meta->txn_id()
-                         << " current valid tablet uid: " << tablet->tablet_uid();
-            ++invalid_rowset_counter;
+            tablet->tablet_meta()->delete_bitmap().merge(
+                    {rowset_id, delete_bitmap_pb.segment_ids(i), delete_bitmap_pb.versions(i)},
+                    roaring::Roaring::read(delete_bitmap_pb.segment_delete_bitmaps(i).data()));
         }
+        ++num_delete_bitmap_deltas;
+        return true;
+    };
+    Status load_delete_bitmap_status =
+            TabletMetaManager::traverse_delete_bitmap(_meta, load_delete_bitmap_func);
+    if (!load_delete_bitmap_status.ok()) {
+        LOG(WARNING) << "there is failure when loading delete bitmaps, path: " << _path
+                     << ", status: " << load_delete_bitmap_status;
     }
+    for (int64_t tablet_id : dropped_tablet_ids) {
+        TabletMetaManager::remove_old_version_delete_bitmap(this, tablet_id, INT64_MAX);
+    }
+    disks_load_time_ms->set_value(MonotonicMillis() - start_ms);
 
     // At startup, we only count these invalid rowset, but do not actually delete it.
     // The actual delete operation is in StorageEngine::_clean_unused_rowset_metas,
     // which is cleaned up uniformly by the background cleanup thread.
     LOG(INFO) << "finish to load tablets from " << _path
               << ", total rowset meta: " << dir_rowset_metas.size()
+              << ", delete bitmap delta: " << num_delete_bitmap_deltas
               << ", invalid rowset num: " << invalid_rowset_counter;
 
     return Status::OK();
 }
 
+// Returns false if the rowset is invalid, i.e. its tablet is dropped or replaced.
+bool DataDir::_load_rowset(const RowsetMetaSharedPtr& rowset_meta) {
+    TabletSharedPtr tablet = _tablet_manager->get_tablet(rowset_meta->tablet_id());
+    // tablet maybe dropped, but not drop related rowset meta
+    if (tablet == nullptr) {
+        VLOG_NOTICE << "could not find tablet id: " << rowset_meta->tablet_id()
+                    << ", schema hash: " << rowset_meta->tablet_schema_hash()
+                    << ", for rowset: " << rowset_meta->rowset_id() << ", skip this rowset";
+        return false;
+    }
+
+    RowsetSharedPtr rowset;
+    Status create_status = tablet->create_rowset(rowset_meta, &rowset);
+    if (!create_status) {
+        LOG(WARNING) << "could not create rowset from rowsetmeta: "
+                     << " rowset_id: " << rowset_meta->rowset_id()
+                     << " rowset_type: " << rowset_meta->rowset_type()
+                     << " rowset_state: " << rowset_meta->rowset_state();
+        return true;
+    }
+    if (rowset_meta->rowset_state() == RowsetStatePB::COMMITTED &&
+        rowset_meta->tablet_uid() == tablet->tablet_uid()) {
+        if (!rowset_meta->tablet_schema()) {
+            rowset_meta->set_tablet_schema(tablet->tablet_schema());
+            RowsetMetaManager::save(_meta, rowset_meta->tablet_uid(), rowset_meta->rowset_id(),
+                                    rowset_meta->get_rowset_pb());
+        }
+        Status commit_txn_status = _txn_manager->commit_txn(
+                _meta, rowset_meta->partition_id(), rowset_meta->txn_id(),
+                rowset_meta->tablet_id(), rowset_meta->tablet_schema_hash(),
+                rowset_meta->tablet_uid(), rowset_meta->load_id(), rowset, true);
+        if (!commit_txn_status && !commit_txn_status.is<PUSH_TRANSACTION_ALREADY_EXIST>()) {
+            LOG(WARNING) << "failed to add committed rowset: " << rowset_meta->rowset_id()
+                         << " to tablet: " << rowset_meta->tablet_id()
+                         << " for txn: " << rowset_meta->txn_id();
+        } else {
+            LOG(INFO) << "successfully to add committed rowset: " << rowset_meta->rowset_id()
+                      << " to tablet: " << rowset_meta->tablet_id()
+                      << " schema hash: " << rowset_meta->tablet_schema_hash()
+                      << " for txn: " << rowset_meta->txn_id();
+        }
+    } else if (rowset_meta->rowset_state() == RowsetStatePB::VISIBLE &&
+               rowset_meta->tablet_uid() == tablet->tablet_uid()) {
+        if (!rowset_meta->tablet_schema()) {
+            rowset_meta->set_tablet_schema(tablet->tablet_schema());
+            RowsetMetaManager::save(_meta, rowset_meta->tablet_uid(), rowset_meta->rowset_id(),
+                                    rowset_meta->get_rowset_pb());
+        }
+        Status publish_status = tablet->add_rowset(rowset);
+        if (!publish_status && !publish_status.is<PUSH_VERSION_ALREADY_EXIST>()) {
+            LOG(WARNING) << "add visible rowset to tablet failed rowset_id:"
+                         << rowset->rowset_id() << " tablet id: " << rowset_meta->tablet_id()
+                         << " txn id:" << rowset_meta->txn_id()
+                         << " start_version: " << rowset_meta->version().first
+                         << " end_version: " << rowset_meta->version().second;
+        }
+    } else {
+        LOG(WARNING) << "find invalid rowset: " << rowset_meta->rowset_id()
+                     << " with tablet id: " << rowset_meta->tablet_id()
+                     << " tablet uid: " << rowset_meta->tablet_uid()
+                     << " schema hash: " << rowset_meta->tablet_schema_hash()
+                     << " txn: " << rowset_meta->txn_id()
+                     << " current valid tablet uid: " << tablet->tablet_uid();
+        return false;
+    }
+    return true;
+}
+
 void DataDir::add_pending_ids(const std::string& id) {
     std::lock_guard<std::shared_mutex> wr_lock(_pending_path_mutex);
     _pending_path_ids.insert(id);
@@ -855,8 +1009,14 @@ void DataDir::perform_remote_rowset_gc() {
         DCHECK(fs->type() != io::FileSystemType::LOCAL);
         std::vector<io::Path> seg_paths;
         seg_paths.reserve(gc_pb.num_segments());
-        for (int i = 0; i < gc_pb.num_segments(); ++i) {
-            seg_paths.push_back(BetaRowset::remote_segment_path(gc_pb.tablet_id(), rowset_id, i));
+        if (gc_pb.packed_segments()) {
+            seg_paths.push_back(
+                    BetaRowset::remote_packed_segments_path(gc_pb.tablet_id(), rowset_id));
+        } else {
+            for (int i = 0; i < gc_pb.num_segments(); ++i) {
+                seg_paths.push_back(
+                        BetaRowset::remote_segment_path(gc_pb.tablet_id(), rowset_id, i));
+            }
         }
         LOG(INFO) << "delete remote rowset. root_path=" << fs->root_path()
                   << ", rowset_id=" << rowset_id;
@@ -29,8 +29,10 @@
 #include "gen_cpp/olap_file.pb.h"
 #include "io/fs/file_system.h"
 #include "io/fs/fs_utils.h"
+#include "io/fs/local_io_scheduler.h"
 #include "olap/olap_common.h"
 #include "olap/rowset/rowset_id_generator.h"
+#include "olap/rowset/rowset_meta.h"
 #include "util/metrics.h"
 
 namespace doris {
@@ -162,6 +164,9 @@ private:
 
     bool _check_pending_ids(const std::string& id);
 
+    // Adds a rowset loaded from the meta to the txn manager or its tablet.
+    bool _load_rowset(const RowsetMetaSharedPtr& rowset_meta);
+
 private:
     std::atomic<bool> _stop_bg_worker = false;
 
@@ -202,6 +207,8 @@ private:
     std::set<std::string> _pending_path_ids;
 
     std::shared_ptr<MetricEntity> _data_dir_metric_entity;
+    // the disk reads and writes of the local files under the dir go through it
+    std::shared_ptr<io::LocalIOScheduler> _io_scheduler;
     IntGauge* disks_total_capacity;
     IntGauge* disks_avail_capacity;
     IntGauge* disks_local_used_capacity;
@@ -209,6 +216,10 @@ private:
     IntGauge* disks_state;
     IntGauge* disks_compaction_score;
     IntGauge* disks_compaction_num;
+    // the progress of loading the tablets at startup
+    IntGauge* disks_loaded_tablet_num;
+    IntGauge* disks_load_failed_tablet_num;
+    IntGauge* disks_load_time_ms;
 };
 
 } // namespace doris
@@ -20,13 +20,16 @@
 #include "common/status.h"
 #include "exec/tablet_info.h"
 #include "olap/data_dir.h"
+#include "olap/inverted_index_parser.h"
 #include "olap/memtable.h"
 #include "olap/memtable_flush_executor.h"
 #include "olap/rowset/beta_rowset_writer.h"
 #include "olap/rowset/rowset_writer_context.h"
 #include "olap/schema.h"
 #include "olap/storage_engine.h"
+#include "olap/utils.h"
 #include "runtime/load_channel_mgr.h"
+#include "runtime/load_statistics.h"
 #include "service/backend_options.h"
 #include "util/brpc_client_cache.h"
 #include "util/ref_count_closure.h"
@@ -143,6 +146,16 @@ Status DeltaWriter::init() {
     context.tablet_id = _tablet->table_id();
     context.is_direct_write = true;
     context.tablet = _tablet;
+    if (config::enable_deferred_fulltext_index_build) {
+        for (const auto& column : _tablet_schema->columns()) {
+            const auto* index = _tablet_schema->get_inverted_index(column.unique_id());
+            if (index != nullptr && is_string_type(column.type()) &&
+                get_inverted_index_parser_type_from_string(get_parser_string_from_properties(
+                        index->properties())) != InvertedIndexParserType::PARSER_NONE) {
+                context.skip_inverted_index.insert(column.unique_id());
+            }
+        }
+    }
     RETURN_NOT_OK(_tablet->create_rowset_writer(context, &_rowset_writer));
     _schema.reset(new Schema(_tablet_schema));
     _reset_mem_table();
@@ -188,6 +201,9 @@ Status DeltaWriter::write(const vectorized::Block* block, const std::vector<int>
         _total_received_rows += row_idxs.size();
     }
     _mem_table->insert(block, row_idxs, is_append);
+    if (_mem_table_first_write_ms == 0) {
+        _mem_table_first_write_ms = MonotonicMillis();
+    }
 
     if (UNLIKELY(_mem_table->need_agg())) {
         _mem_table->shrink_memtable_by_agg();
@@ -280,6 +296,7 @@ void DeltaWriter::_reset_mem_table() {
         _mem_table_tracker.push_back(mem_table_insert_tracker);
         _mem_table_tracker.push_back(mem_table_flush_tracker);
     }
+    _mem_table_first_write_ms = 0;
     _mem_table.reset(new MemTable(_tablet, _schema.get(), _tablet_schema.get(), _req.slots,
                                   _req.tuple_desc, _rowset_writer.get(), _delete_bitmap,
                                   _rowset_ids, _cur_max_version, mem_table_insert_tracker,
@@ -319,6 +336,14 @@ Status DeltaWriter::close() {
 
 Status DeltaWriter::close_wait(const PSlaveTabletNodes& slave_tablet_nodes,
                                const bool write_single_replica) {
+    TabletTxnCommit commit;
+    RETURN_IF_ERROR(build_rowset(&commit));
+    commit.status = _storage_engine->txn_manager()->commit_txn(
+            commit.partition_id, commit.tablet, _req.txn_id, commit.load_id, commit.rowset, false);
+    return finish_commit(commit, slave_tablet_nodes, write_single_replica);
+}
+
+Status DeltaWriter::build_rowset(TabletTxnCommit* commit) {
     std::lock_guard<std::mutex> l(_lock);
     DCHECK(_is_init)
             << "delta writer is supposed be to initialized before close_wait() being called";
@@ -335,7 +360,7 @@ Status DeltaWriter::close_wait(const PSlaveTabletNodes& slave_tablet_nodes,
         LOG(WARNING) << "previous flush failed tablet " << _tablet->tablet_id();
         return st;
     }
-    uint64_t wait_time_ns = timer.elapsed_time();
+    _wait_flush_time_ns = timer.elapsed_time();
 
     _mem_table.reset();
 
@@ -351,8 +376,18 @@ Status DeltaWriter::close_wait(const PSlaveTabletNodes& slave_tablet_nodes,
         LOG(WARNING) << "fail to build rowset";
         return Status::Error<MEM_ALLOC_FAILED>();
     }
-    Status res = _storage_engine->txn_manager()->commit_txn(_req.partition_id, _tablet, _req.txn_id,
-                                                            _req.load_id, _cur_rowset, false);
+    commit->partition_id = _req.partition_id;
+    commit->tablet = _tablet;
+    commit->load_id = _req.load_id;
+    commit->rowset = _cur_rowset;
+    return Status::OK();
+}
+
+Status DeltaWriter::finish_commit(const TabletTxnCommit& commit,
+                                  const PSlaveTabletNodes& slave_tablet_nodes,
+                                  const bool write_single_replica) {
+    std::lock_guard<std::mutex> l(_lock);
+    const Status& res = commit.status;
     if (!res && !res.is<PUSH_TRANSACTION_ALREADY_EXIST>()) {
         LOG(WARNING) << "Failed to commit txn: " << _req.txn_id
                      << " for rowset: " << _cur_rowset->rowset_id();
@@ -369,10 +404,10 @@ Status DeltaWriter::close_wait(const PSlaveTabletNodes& slave_tablet_nodes,
 
     const FlushStatistic& stat = _flush_token->get_stats();
     // print slow log if wait more than 1s
-    if (wait_time_ns > 1000UL * 1000 * 1000) {
+    if (_wait_flush_time_ns > 1000UL * 1000 * 1000) {
         LOG(INFO) << "close delta writer for tablet: " << _tablet->tablet_id()
-                  << ", load id: " << print_id(_req.load_id) << ", wait close for " << wait_time_ns
-                  << "(ns), stats: " << stat;
+                  << ", load id: " << print_id(_req.load_id) << ", wait close for "
+                  << _wait_flush_time_ns << "(ns), stats: " << stat;
     }
 
     if (write_single_replica) {
@@ -440,6 +475,18 @@ int64_t DeltaWriter::get_memtable_consumption_snapshot() const {
     return _memtable_consumption_snapshot;
 }
 
+void DeltaWriter::collect_load_statistics(LoadStatistics* statistics) {
+    if (!_is_init) {
+        return;
+    }
+    const FlushStatistic& stat = _flush_token->get_stats();
+    statistics->flush_wait_ns += stat.flush_wait_time_ns;
+    statistics->flush_ns += stat.flush_time_ns;
+    statistics->flush_count += stat.flush_finish_count;
+    statistics->flush_bytes += stat.flush_size_bytes;
+    _rowset_writer->collect_load_statistics(statistics);
+}
+
 int64_t DeltaWriter::mem_consumption() {
     if (_flush_token == nullptr) {
         // This method may be called before this writer is initialized.
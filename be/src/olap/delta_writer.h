@@ -21,6 +21,7 @@
 #include "olap/rowset/rowset_writer.h"
 #include "olap/tablet.h"
 #include "util/spinlock.h"
+#include "util/time.h"
 
 namespace doris {
 
@@ -31,6 +32,8 @@ class Schema;
 class StorageEngine;
 class TupleDescriptor;
 class SlotDescriptor;
+struct LoadStatistics;
+struct TabletTxnCommit;
 
 enum WriteType { LOAD = 1, LOAD_DELETE = 2, DELETE = 3 };
 
@@ -70,6 +73,13 @@ public:
     // wait for all memtables to be flushed.
     // mem_consumption() should be 0 after this function returns.
     Status close_wait(const PSlaveTabletNodes& slave_tablet_nodes, const bool write_single_replica);
+    // close_wait() in two steps, between which the rowset is committed, so that the rowsets of
+    // many writers of a txn can be committed together by TxnManager::commit_txns().
+    // build_rowset() waits for the flushes, and sets the rowset to commit in `commit'.
+    Status build_rowset(TabletTxnCommit* commit);
+    // finish_commit() finishes the close after the rowset is committed with `commit.status'.
+    Status finish_commit(const TabletTxnCommit& commit, const PSlaveTabletNodes& slave_tablet_nodes,
+                         const bool write_single_replica);
 
     bool check_slave_replicas_done(google::protobuf::Map<int64_t, PSuccessSlaveTabletNodeIds>*
                                            success_slave_tablet_node_ids);
@@ -110,6 +120,15 @@ public:
 
     int64_t total_received_rows() const { return _total_received_rows; }
 
+    // Adds the time of flushing the memtables of this writer, which is called after the close.
+    void collect_load_statistics(LoadStatistics* statistics);
+
+    // milliseconds since the first row was written to the current memtable, 0 if it is empty
+    int64_t memtable_age_ms() const {
+        int64_t first_write_ms = _mem_table_first_write_ms.load();
+        return first_write_ms == 0 ? 0 : MonotonicMillis() - first_write_ms;
+    }
+
 private:
     DeltaWriter(WriteRequest* req, StorageEngine* storage_engine, const UniqueId& load_id);
 
@@ -143,6 +162,8 @@ private:
     // every request will have it's own tablet schema so simple schema change can work
     TabletSchemaSPtr _tablet_schema;
     bool _delta_written_success;
+    // the time build_rowset() waits for the flushes
+    uint64_t _wait_flush_time_ns = 0;
 
     StorageEngine* _storage_engine;
     UniqueId _load_id;
@@ -150,6 +171,7 @@ private:
     std::vector<std::shared_ptr<MemTracker>> _mem_table_tracker;
     SpinLock _mem_table_tracker_lock;
     std::atomic<uint32_t> _mem_table_num = 1;
+    std::atomic<int64_t> _mem_table_first_write_ms = 0;
 
     std::mutex _lock;
 
@@ -35,6 +35,27 @@
 
 namespace doris {
 
+// The max value of a string zone map may have been cut to `MAX_ZONE_MAP_INDEX_SIZE` bytes, which
+// makes it smaller than the original value. Replace it with the shortest string that is greater
+// than every string starting with it: drop the trailing 0xFF bytes and increase the last one
+// left. Return false if all the bytes are 0xFF, then there is no such bound.
+inline bool make_truncated_max_upper_bound(Slice* slice) {
+    if (slice->size != MAX_ZONE_MAP_INDEX_SIZE) {
+        return true;
+    }
+    auto data = reinterpret_cast<uint8_t*>(slice->mutable_data());
+    size_t size = slice->size;
+    while (size > 0 && data[size - 1] == 0xFF) {
+        --size;
+    }
+    if (size == 0) {
+        return false;
+    }
+    data[size - 1] += 1;
+    slice->size = size;
+    return true;
+}
+
 // A Field is used to represent a column in memory format.
 // User can use this class to access or deal with column data in memory.
 class Field {
@@ -80,7 +101,9 @@ public:
 
     virtual size_t get_variable_len() const { return 0; }
 
-    virtual void modify_zone_map_index(char*) const {}
+    // Turn the max value of a zone map into an upper bound of the values before flush. Return
+    // false if there is no such bound, the zone map must pass all then.
+    virtual bool modify_zone_map_index(char*) const { return true; }
 
     virtual Field* clone() const {
         auto* local = new Field();
@@ -346,15 +369,9 @@ public:
         return type_value;
     }
 
-    // only varchar filed need modify zone map index when zone map max_value
-    // index longer than `MAX_ZONE_MAP_INDEX_SIZE`. so here we add one
-    // for the last byte
-    // In UTF8 encoding, here do not appear 0xff in last byte
-    void modify_zone_map_index(char* src) const override {
-        auto slice = reinterpret_cast<Slice*>(src);
-        if (slice->size == MAX_ZONE_MAP_INDEX_SIZE) {
-            slice->mutable_data()[slice->size - 1] += 1;
-        }
+    // the max value is cut to `MAX_ZONE_MAP_INDEX_SIZE` bytes when it is longer
+    bool modify_zone_map_index(char* src) const override {
+        return make_truncated_max_upper_bound(reinterpret_cast<Slice*>(src));
     }
 
     void set_to_zone_map_max(char* ch) const override {
@@ -402,15 +419,9 @@ public:
         return type_value;
     }
 
-    // only varchar/string filed need modify zone map index when zone map max_value
-    // index longer than `MAX_ZONE_MAP_INDEX_SIZE`. so here we add one
-    // for the last byte
-    // In UTF8 encoding, here do not appear 0xff in last byte
-    void modify_zone_map_index(char* src) const override {
-        auto slice = reinterpret_cast<Slice*>(src);
-        if (slice->size == MAX_ZONE_MAP_INDEX_SIZE) {
-            slice->mutable_data()[slice->size - 1] += 1;
-        }
+    // the max value is cut to `MAX_ZONE_MAP_INDEX_SIZE` bytes when it is longer
+    bool modify_zone_map_index(char* src) const override {
+        return make_truncated_max_upper_bound(reinterpret_cast<Slice*>(src));
     }
 
     void set_to_max(char* ch) const override {
@@ -457,15 +468,9 @@ public:
         auto slice = reinterpret_cast<Slice*>(ch);
         memset(slice->data, 0xFF, slice->size);
     }
-    // only varchar/string filed need modify zone map index when zone map max_value
-    // index longer than `MAX_ZONE_MAP_INDEX_SIZE`. so here we add one
-    // for the last byte
-    // In UTF8 encoding, here do not appear 0xff in last byte
-    void modify_zone_map_index(char* src) const override {
-        auto slice = reinterpret_cast<Slice*>(src);
-        if (slice->size == MAX_ZONE_MAP_INDEX_SIZE) {
-            slice->mutable_data()[slice->size - 1] += 1;
-        }
+    // the max value is cut to `MAX_ZONE_MAP_INDEX_SIZE` bytes when it is longer
+    bool modify_zone_map_index(char* src) const override {
+        return make_truncated_max_upper_bound(reinterpret_cast<Slice*>(src));
     }
 
     void set_to_zone_map_max(char* ch) const override {
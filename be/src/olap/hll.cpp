@@ -18,6 +18,7 @@
 #include "olap/hll.h"
 
 #include <algorithm>
+#include <array>
 #include <map>
 
 #include "common/logging.h"
@@ -75,6 +76,60 @@ void HyperLogLog::update(uint64_t hash_value) {
     }
 }
 
+void HyperLogLog::update_batch(const uint64_t* hash_values, size_t num_values) {
+    size_t i = 0;
+    for (; i < num_values && _type != HLL_DATA_SPARSE && _type != HLL_DATA_FULL; ++i) {
+        update(hash_values[i]);
+    }
+    if (i < num_values) {
+        _update_registers_batch(hash_values + i, num_values - i);
+    }
+}
+
+void HyperLogLog::_update_registers_batch(const uint64_t* hash_values, size_t num_values) {
+    // the ranks of a chunk are computed first, so that the loop has no dependency on the
+    // registers and can be vectorized
+    constexpr size_t CHUNK_SIZE = 256;
+    uint8_t ranks[CHUNK_SIZE];
+    for (size_t start = 0; start < num_values; start += CHUNK_SIZE) {
+        const uint64_t* hashes = hash_values + start;
+        const size_t size = std::min(CHUNK_SIZE, num_values - start);
+        size_t i = 0;
+#ifdef __AVX2__
+        // the lowest one bit of x is a power of two below 2^52, which is exactly converted to a
+        // double by putting it in the mantissa of 2^52 and subtracting 2^52, then its exponent
+        // is the number of the trailing zeros of x
+        const __m256i end_bit = _mm256_set1_epi64x((uint64_t)1 << HLL_ZERO_COUNT_BITS);
+        const __m256i magic_bits = _mm256_set1_epi64x(0x4330000000000000ULL);
+        const __m256d magic = _mm256_castsi256_pd(magic_bits);
+        const __m256i zero = _mm256_setzero_si256();
+        for (; i + 4 <= size; i += 4) {
+            __m256i x = _mm256_loadu_si256((const __m256i*)(hashes + i));
+            x = _mm256_or_si256(_mm256_srli_epi64(x, HLL_COLUMN_PRECISION), end_bit);
+            __m256i lowest_bit = _mm256_and_si256(x, _mm256_sub_epi64(zero, x));
+            __m256d value = _mm256_sub_pd(
+                    _mm256_castsi256_pd(_mm256_or_si256(lowest_bit, magic_bits)), magic);
+            // rank = exponent - 1023 + 1
+            __m256i rank = _mm256_sub_epi64(_mm256_srli_epi64(_mm256_castpd_si256(value), 52),
+                                            _mm256_set1_epi64x(1022));
+            alignas(32) uint64_t rank_values[4];
+            _mm256_store_si256((__m256i*)rank_values, rank);
+            for (int j = 0; j < 4; ++j) {
+                ranks[i + j] = (uint8_t)rank_values[j];
+            }
+        }
+#endif
+        for (; i < size; ++i) {
+            uint64_t x = (hashes[i] >> HLL_COLUMN_PRECISION) | ((uint64_t)1 << HLL_ZERO_COUNT_BITS);
+            ranks[i] = __builtin_ctzl(x) + 1;
+        }
+        for (i = 0; i < size; ++i) {
+            uint8_t& reg = _registers[hashes[i] % HLL_REGISTERS_COUNT];
+            reg = std::max(reg, ranks[i]);
+        }
+    }
+}
+
 void HyperLogLog::merge(const HyperLogLog& other) {
     // fast path
     if (other._type == HLL_DATA_EMPTY) {
@@ -335,15 +390,21 @@ int64_t HyperLogLog::estimate_cardinality() const {
         alpha = 0.7213f / (1 + 1.079f / num_streams);
     }
 
+    // 2^-rank of every rank, which is at most HLL_ZERO_COUNT_BITS + 1
+    static const auto inverse_powers = [] {
+        std::array<float, 64> powers {};
+        for (int i = 0; i < powers.size(); ++i) {
+            powers[i] = powf(2.0f, -i);
+        }
+        return powers;
+    }();
+
     float harmonic_mean = 0;
     int num_zero_registers = 0;
 
     for (int i = 0; i < HLL_REGISTERS_COUNT; ++i) {
-        harmonic_mean += powf(2.0f, -_registers[i]);
-
-        if (_registers[i] == 0) {
-            ++num_zero_registers;
-        }
+        harmonic_mean += inverse_powers[_registers[i] & 63];
+        num_zero_registers += (_registers[i] == 0);
     }
 
     harmonic_mean = 1.0f / harmonic_mean;
@@ -207,6 +207,10 @@ public:
     // NOTE: input must be a hash_value
     void update(uint64_t hash_value);
 
+    // Same as calling update() with every hash value, with the ranks of the values computed
+    // four at a time when AVX2 is available.
+    void update_batch(const uint64_t* hash_values, size_t num_values);
+
     void merge(const HyperLogLog& other);
 
     // Return max size of serialized binary
@@ -289,6 +293,9 @@ private:
         _registers[idx] = (_registers[idx] < first_one_bit ? first_one_bit : _registers[idx]);
     }
 
+    // update the hash values into this registers
+    void _update_registers_batch(const uint64_t* hash_values, size_t num_values);
+
     // absorb other registers into this registers
     void _merge_registers(const uint8_t* other_registers) {
 #ifdef __AVX2__
@@ -302,6 +309,17 @@ private:
             src += 32;
             dst += 32;
         }
+#elif defined(__SSE2__)
+        int loop = HLL_REGISTERS_COUNT / 16; // 16 = 128/8
+        uint8_t* dst = _registers;
+        const uint8_t* src = other_registers;
+        for (int i = 0; i < loop; i++) {
+            __m128i xa = _mm_loadu_si128((const __m128i*)dst);
+            __m128i xb = _mm_loadu_si128((const __m128i*)src);
+            _mm_storeu_si128((__m128i*)dst, _mm_max_epu8(xa, xb));
+            src += 16;
+            dst += 16;
+        }
 #else
         for (int i = 0; i < HLL_REGISTERS_COUNT; ++i) {
             _registers[i] =
@@ -335,6 +335,11 @@ public:
         }
     }
 
+    // evaluate_and ignores the opposite flag, so it's of the origin delete condition
+    bool may_delete(const std::pair<WrapperField*, WrapperField*>& statistic) const override {
+        return evaluate_and(statistic);
+    }
+
     bool evaluate_del(const std::pair<WrapperField*, WrapperField*>& statistic) const override {
         if (statistic.first->is_null() || statistic.second->is_null()) {
             return false;
@@ -398,6 +403,22 @@ private:
         }
     }
 
+    // a null row is selected only if is_opposite
+    template <bool is_nullable, bool is_opposite>
+    static void _apply_null_flags(const vectorized::PaddedPODArray<vectorized::UInt8>* null_map,
+                                  uint16_t first, uint16_t count, uint8_t* flags) {
+        if constexpr (is_nullable) {
+            const auto* nulls = null_map->data() + first;
+            for (uint16_t i = 0; i < count; ++i) {
+                if constexpr (is_opposite) {
+                    flags[i] |= nulls[i];
+                } else {
+                    flags[i] &= !nulls[i];
+                }
+            }
+        }
+    }
+
     template <bool is_nullable, bool is_opposite>
     uint16_t _base_evaluate(const vectorized::IColumn* column,
                             const vectorized::PaddedPODArray<vectorized::UInt8>* null_map,
@@ -422,6 +443,20 @@ private:
                         << " rowsetid=" << segid.first << " segmentid=" << segid.second
                         << "dict_info" << nested_col_ptr->dict_debug_string();
 
+                auto dense_size = _evaluate_dense_sel(
+                        sel, size, [&](uint16_t first, uint16_t count, uint8_t* flags) {
+                            const auto* codes = data_array.data() + first;
+                            for (uint16_t i = 0; i < count; ++i) {
+                                flags[i] = (is_opposite != (PT == PredicateType::IN_LIST)) ==
+                                           (bool)value_in_dict_flags[codes[i]];
+                            }
+                            _apply_null_flags<is_nullable, is_opposite>(null_map, first, count,
+                                                                        flags);
+                        });
+                if (dense_size >= 0) {
+                    return dense_size;
+                }
+
                 for (uint16_t i = 0; i < size; i++) {
                     uint16_t idx = sel[i];
                     if constexpr (is_nullable) {
@@ -451,6 +486,24 @@ private:
                     vectorized::PredicateColumnType<PredicateEvaluateType<Type>>>(column);
             auto& data_array = nested_col_ptr->get_data();
 
+            // the small fixed size sets of numbers are cheap to probe without branches
+            if constexpr (std::is_arithmetic_v<T>) {
+                auto dense_size = _evaluate_dense_sel(
+                        sel, size, [&](uint16_t first, uint16_t count, uint8_t* flags) {
+                            const auto* values = data_array.data() + first;
+                            for (uint16_t i = 0; i < count; ++i) {
+                                bool found =
+                                        _values->find(reinterpret_cast<const T*>(&values[i]));
+                                flags[i] = is_opposite != _operator(found, false);
+                            }
+                            _apply_null_flags<is_nullable, is_opposite>(null_map, first, count,
+                                                                        flags);
+                        });
+                if (dense_size >= 0) {
+                    return dense_size;
+                }
+            }
+
             for (uint16_t i = 0; i < size; i++) {
                 uint16_t idx = sel[i];
                 if constexpr (is_nullable) {
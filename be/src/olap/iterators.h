@@ -89,6 +89,8 @@ public:
     // REQUIRED (null is not allowed)
     OlapReaderStatistics* stats = nullptr;
     bool use_page_cache = false;
+    // if false, pages are looked up in page cache, but not inserted into it
+    bool fill_page_cache = true;
     int block_row_max = 4096 - 32; // see https://github.com/apache/doris/pull/11816
 
     TabletSchemaSPtr tablet_schema = nullptr;
@@ -103,6 +105,9 @@ public:
     vectorized::VExpr* remaining_vconjunct_root = nullptr;
     vectorized::VExprContext* common_vexpr_ctxs_pushdown = nullptr;
     const std::set<int32_t>* output_columns = nullptr;
+    // the unique ids of the array and map columns of which only the offsets are read, unless
+    // they are of predicates
+    const std::set<int32_t>* offsets_only_columns = nullptr;
     // runtime state
     RuntimeState* runtime_state = nullptr;
     RowsetId rowset_id;
@@ -18,6 +18,7 @@
 #include "olap/like_column_predicate.h"
 
 #include "olap/field.h"
+#include "olap/wrapper_field.h"
 #include "udf/udf.h"
 #include "vec/common/string_ref.h"
 
@@ -29,6 +30,48 @@ LikeColumnPredicate::LikeColumnPredicate(bool opposite, uint32_t column_id,
     _state = reinterpret_cast<StateType*>(
             fn_ctx->get_function_state(doris::FunctionContext::THREAD_LOCAL));
     _state->search_state.clone(_like_state);
+    for (size_t i = 0; i < pattern.size; ++i) {
+        char c = pattern.data[i];
+        // stop at the escape character too, a shorter prefix is always safe
+        if (c == '%' || c == '_' || c == '\\') {
+            break;
+        }
+        _prefix.push_back(c);
+    }
+}
+
+bool LikeColumnPredicate::evaluate_and(
+        const std::pair<WrapperField*, WrapperField*>& statistic) const {
+    // NOT LIKE or a pattern starting with a wildcard may match values of any range
+    if (_opposite || _prefix.empty() || statistic.first->is_null()) {
+        return true;
+    }
+    auto min = reinterpret_cast<const Slice*>(statistic.first->cell_ptr());
+    auto max = reinterpret_cast<const Slice*>(statistic.second->cell_ptr());
+    Slice prefix(_prefix);
+    // some value in [min, max] starts with prefix iff max >= prefix and min is not greater
+    // than the largest value starting with prefix, i.e. the head of min is <= prefix
+    Slice min_head(min->data, std::min(min->size, prefix.size));
+    return max->compare(prefix) >= 0 && min_head.compare(prefix) <= 0;
+}
+
+bool LikeColumnPredicate::evaluate_and(const BloomFilter* bf) const {
+    if (_opposite || !bf->is_ngram_bf()) {
+        return true;
+    }
+    const auto* ngram_bf = static_cast<const segment_v2::NGramBloomFilter*>(bf);
+    if (ngram_bf->gram_size() == 0) {
+        return _page_ng_bf == nullptr || _page_ng_bf->size() != bf->size() ||
+               bf->contains(*_page_ng_bf);
+    }
+    auto it = _pattern_ng_bfs.find(ngram_bf->layout());
+    if (it == _pattern_ng_bfs.end()) {
+        it = _pattern_ng_bfs
+                     .emplace(ngram_bf->layout(),
+                              ngram_bf->create_query_filter(get_search_str(), true))
+                     .first;
+    }
+    return it->second == nullptr || bf->contains(*it->second);
 }
 
 void LikeColumnPredicate::evaluate_vec(const vectorized::IColumn& column, uint16_t size,
@@ -52,32 +95,18 @@ uint16_t LikeColumnPredicate::evaluate(const vectorized::IColumn& column, uint16
             auto* nested_col_ptr = vectorized::check_and_get_column<
                     vectorized::ColumnDictionary<vectorized::Int32>>(nested_col);
             auto& data_array = nested_col_ptr->get_data();
+            auto& dict_flags = _find_flags_of_dictionary(*nested_col_ptr);
             if (!nullable_col->has_null()) {
                 for (uint16_t i = 0; i != size; i++) {
                     uint16_t idx = sel[i];
                     sel[new_size] = idx;
-                    StringRef cell_value = nested_col_ptr->get_shrink_value(data_array[idx]);
-                    unsigned char flag = 0;
-                    (_state->scalar_function)(
-                            const_cast<vectorized::LikeSearchState*>(&_like_state),
-                            StringRef(cell_value.data, cell_value.size), pattern, &flag);
-                    new_size += _opposite ^ flag;
+                    new_size += dict_flags[data_array[idx]];
                 }
             } else {
                 for (uint16_t i = 0; i != size; i++) {
                     uint16_t idx = sel[i];
                     sel[new_size] = idx;
-                    if (null_map_data[idx]) {
-                        new_size += _opposite;
-                        continue;
-                    }
-
-                    StringRef cell_value = nested_col_ptr->get_shrink_value(data_array[idx]);
-                    unsigned char flag = 0;
-                    (_state->scalar_function)(
-                            const_cast<vectorized::LikeSearchState*>(&_like_state),
-                            StringRef(cell_value.data, cell_value.size), pattern, &flag);
-                    new_size += _opposite ^ flag;
+                    new_size += null_map_data[idx] ? _opposite : dict_flags[data_array[idx]];
                 }
             }
         } else {
@@ -117,15 +146,11 @@ uint16_t LikeColumnPredicate::evaluate(const vectorized::IColumn& column, uint16
             auto* nested_col_ptr = vectorized::check_and_get_column<
                     vectorized::ColumnDictionary<vectorized::Int32>>(column);
             auto& data_array = nested_col_ptr->get_data();
+            auto& dict_flags = _find_flags_of_dictionary(*nested_col_ptr);
             for (uint16_t i = 0; i != size; i++) {
                 uint16_t idx = sel[i];
                 sel[new_size] = idx;
-                StringRef cell_value = nested_col_ptr->get_shrink_value(data_array[idx]);
-                unsigned char flag = 0;
-                (_state->scalar_function)(const_cast<vectorized::LikeSearchState*>(&_like_state),
-                                          StringRef(cell_value.data, cell_value.size), pattern,
-                                          &flag);
-                new_size += _opposite ^ flag;
+                new_size += dict_flags[data_array[idx]];
             }
         } else {
             auto* str_col =
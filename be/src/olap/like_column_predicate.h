@@ -17,6 +17,7 @@
 #pragma once
 
 #include "olap/column_predicate.h"
+#include "olap/rowset/segment_v2/ngram_bloom_filter.h"
 #include "udf/udf.h"
 #include "vec/columns/column_dictionary.h"
 #include "vec/common/string_ref.h"
@@ -53,14 +54,16 @@ public:
     void set_page_ng_bf(std::unique_ptr<segment_v2::BloomFilter> src) override {
         _page_ng_bf = std::move(src);
     }
-    bool evaluate_and(const BloomFilter* bf) const override {
-        if (_page_ng_bf) {
-            return bf->contains(*_page_ng_bf);
-        }
-        return true;
-    }
+    // The ngrams of the literal parts of the pattern are tested against the ngram bloom filter
+    // of a page, in the layout recorded in the segment if known, otherwise by the ngram bloom
+    // filter index of the tablet schema.
+    bool evaluate_and(const BloomFilter* bf) const override;
     bool can_do_bloom_filter() const override { return true; }
 
+    // A pattern with a literal prefix can only match the values starting with the prefix, so
+    // the zone map can be used as the range predicate `prefix <= v < prefix + 1`.
+    bool evaluate_and(const std::pair<WrapperField*, WrapperField*>& statistic) const override;
+
 private:
     template <bool is_and>
     void _evaluate_vec(const vectorized::IColumn& column, uint16_t size, bool* flags) const {
@@ -73,29 +76,13 @@ private:
                 auto* nested_col_ptr = vectorized::check_and_get_column<
                         vectorized::ColumnDictionary<vectorized::Int32>>(nested_col);
                 auto& data_array = nested_col_ptr->get_data();
+                auto& dict_flags = _find_flags_of_dictionary(*nested_col_ptr);
                 for (uint16_t i = 0; i < size; i++) {
-                    if (null_map_data[i]) {
-                        if constexpr (is_and) {
-                            flags[i] &= _opposite;
-                        } else {
-                            flags[i] = _opposite;
-                        }
-                        continue;
-                    }
-
-                    StringRef cell_value = nested_col_ptr->get_shrink_value(data_array[i]);
+                    bool flag = null_map_data[i] ? _opposite : dict_flags[data_array[i]];
                     if constexpr (is_and) {
-                        unsigned char flag = 0;
-                        (_state->scalar_function)(
-                                const_cast<vectorized::LikeSearchState*>(&_like_state),
-                                StringRef(cell_value.data, cell_value.size), pattern, &flag);
-                        flags[i] &= _opposite ^ flag;
+                        flags[i] &= flag;
                     } else {
-                        unsigned char flag = 0;
-                        (_state->scalar_function)(
-                                const_cast<vectorized::LikeSearchState*>(&_like_state),
-                                StringRef(cell_value.data, cell_value.size), pattern, &flag);
-                        flags[i] = _opposite ^ flag;
+                        flags[i] = flag;
                     }
                 }
             } else {
@@ -106,20 +93,12 @@ private:
                 auto* nested_col_ptr = vectorized::check_and_get_column<
                         vectorized::ColumnDictionary<vectorized::Int32>>(column);
                 auto& data_array = nested_col_ptr->get_data();
+                auto& dict_flags = _find_flags_of_dictionary(*nested_col_ptr);
                 for (uint16_t i = 0; i < size; i++) {
-                    StringRef cell_value = nested_col_ptr->get_shrink_value(data_array[i]);
                     if constexpr (is_and) {
-                        unsigned char flag = 0;
-                        (_state->scalar_function)(
-                                const_cast<vectorized::LikeSearchState*>(&_like_state),
-                                StringRef(cell_value.data, cell_value.size), pattern, &flag);
-                        flags[i] &= _opposite ^ flag;
+                        flags[i] &= dict_flags[data_array[i]];
                     } else {
-                        unsigned char flag = 0;
-                        (_state->scalar_function)(
-                                const_cast<vectorized::LikeSearchState*>(&_like_state),
-                                StringRef(cell_value.data, cell_value.size), pattern, &flag);
-                        flags[i] = _opposite ^ flag;
+                        flags[i] = dict_flags[data_array[i]];
                     }
                 }
             } else {
@@ -128,6 +107,26 @@ private:
         }
     }
 
+    // The pattern is matched once against every entry of the dictionary, and the
+    // results (with _opposite applied) are cached per segment, so that the rows are
+    // evaluated by looking up their codes.
+    const std::vector<vectorized::UInt8>& _find_flags_of_dictionary(
+            const vectorized::ColumnDictionary<vectorized::Int32>& column) const {
+        auto& dict_flags = _segment_id_to_dict_flags[column.get_rowset_segment_id()];
+        if (dict_flags.size() != column.dict_size()) {
+            dict_flags.resize(column.dict_size());
+            for (size_t code = 0; code < dict_flags.size(); ++code) {
+                StringRef cell_value = column.get_shrink_value(code);
+                unsigned char flag = 0;
+                (_state->scalar_function)(const_cast<vectorized::LikeSearchState*>(&_like_state),
+                                          StringRef(cell_value.data, cell_value.size), pattern,
+                                          &flag);
+                dict_flags[code] = _opposite ^ flag;
+            }
+        }
+        return dict_flags;
+    }
+
     std::string _debug_string() const override {
         std::string info = "LikeColumnPredicate";
         return info;
@@ -137,6 +136,8 @@ private:
     // lifetime controlled by scan node
     using StateType = vectorized::LikeState;
     StringRef pattern;
+    // the literal characters of pattern before the first wildcard
+    std::string _prefix;
 
     StateType* _state;
 
@@ -145,6 +146,13 @@ private:
     // LikeColumnPredicate.
     vectorized::LikeSearchState _like_state;
     std::unique_ptr<segment_v2::BloomFilter> _page_ng_bf; // for ngram-bf index
+    // the filters of the pattern by the layouts of the ngram bloom filters of the segments,
+    // nullptr if the pattern has no ngram
+    mutable std::map<segment_v2::NGramBloomFilter::Layout,
+                     std::unique_ptr<segment_v2::NGramBloomFilter>>
+            _pattern_ng_bfs;
+    mutable std::map<std::pair<RowsetId, uint32_t>, std::vector<vectorized::UInt8>>
+            _segment_id_to_dict_flags;
 };
 
 } // namespace doris
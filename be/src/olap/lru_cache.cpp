@@ -8,6 +8,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <shared_mutex>
 #include <sstream>
 #include <string>
 
@@ -29,6 +30,8 @@ DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(cache_usage_ratio, MetricUnit::NOUNIT);
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(cache_lookup_count, MetricUnit::OPERATIONS);
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(cache_hit_count, MetricUnit::OPERATIONS);
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(cache_hit_ratio, MetricUnit::NOUNIT);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(cache_promotion_count, MetricUnit::OPERATIONS);
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(cache_protected_usage, MetricUnit::BYTES);
 
 uint32_t CacheKey::hash(const char* data, size_t n, uint32_t seed) const {
     // Similar to murmur hash
@@ -173,16 +176,24 @@ LRUCache::LRUCache(LRUCacheType type) : _type(type) {
     _lru_normal.prev = &_lru_normal;
     _lru_durable.next = &_lru_durable;
     _lru_durable.prev = &_lru_durable;
+    _lru_probation.next = &_lru_probation;
+    _lru_probation.prev = &_lru_probation;
 }
 
 LRUCache::~LRUCache() {
     prune();
 }
 
+void LRUCache::_sub_usage(LRUHandle* e) {
+    _usage -= e->total_size;
+    if (e->priority == CachePriority::NORMAL && !e->in_probation) {
+        _protected_usage -= e->total_size;
+    }
+}
+
 bool LRUCache::_unref(LRUHandle* e) {
     DCHECK(e->refs > 0);
-    e->refs--;
-    return e->refs == 0;
+    return e->refs.fetch_sub(1) == 1;
 }
 
 void LRUCache::_lru_remove(LRUHandle* e) {
@@ -234,6 +245,22 @@ void LRUCache::_lru_append(LRUHandle* list, LRUHandle* e) {
 }
 
 Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash) {
+    if (_clock_eviction) {
+        std::shared_lock l(_mutex);
+        ++_lookup_count;
+        LRUHandle* e = _table.lookup(key, hash);
+        if (e != nullptr) {
+            DCHECK(e->in_cache);
+            e->refs++;
+            // avoid writing the cache line shared by the readers if possible
+            if (!e->visited.load(std::memory_order_relaxed)) {
+                e->visited.store(true, std::memory_order_relaxed);
+            }
+            ++_hit_count;
+        }
+        return reinterpret_cast<Cache::Handle*>(e);
+    }
+
     std::lock_guard l(_mutex);
     ++_lookup_count;
     LRUHandle* e = _table.lookup(key, hash);
@@ -246,6 +273,11 @@ Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash) {
         }
         e->refs++;
         ++_hit_count;
+        if (e->in_probation) {
+            e->in_probation = false;
+            _protected_usage += e->total_size;
+            ++_promotion_count;
+        }
     }
     return reinterpret_cast<Cache::Handle*>(e);
 }
@@ -255,12 +287,20 @@ void LRUCache::release(Cache::Handle* handle) {
         return;
     }
     LRUHandle* e = reinterpret_cast<LRUHandle*>(handle);
+    if (_clock_eviction) {
+        // the entry is kept on the list while in cache, and LRUCache holds a reference of
+        // it, so the last reference is released only after it is removed from cache
+        if (_unref(e)) {
+            e->free();
+        }
+        return;
+    }
     bool last_ref = false;
     {
         std::lock_guard l(_mutex);
         last_ref = _unref(e);
         if (last_ref) {
-            _usage -= e->total_size;
+            _sub_usage(e);
         } else if (e->in_cache && e->refs == 1) {
             // only exists in cache
             if (_usage > _capacity) {
@@ -269,11 +309,13 @@ void LRUCache::release(Cache::Handle* handle) {
                 DCHECK(removed);
                 e->in_cache = false;
                 _unref(e);
-                _usage -= e->total_size;
+                _sub_usage(e);
                 last_ref = true;
             } else {
                 // put it to LRU free list
-                if (e->priority == CachePriority::NORMAL) {
+                if (e->in_probation) {
+                    _lru_append(&_lru_probation, e);
+                } else if (e->priority == CachePriority::NORMAL) {
                     _lru_append(&_lru_normal, e);
                 } else if (e->priority == CachePriority::DURABLE) {
                     _lru_append(&_lru_durable, e);
@@ -315,10 +357,15 @@ void LRUCache::_evict_from_lru_with_time(size_t total_size, LRUHandle** to_remov
 }
 
 void LRUCache::_evict_from_lru(size_t total_size, LRUHandle** to_remove_head) {
-    // 1. evict normal cache entries
+    // 1. evict normal cache entries, the probation ones first unless the protected ones
+    // take too much space
     while ((_usage + total_size > _capacity || _check_element_count_limit()) &&
-           _lru_normal.next != &_lru_normal) {
-        LRUHandle* old = _lru_normal.next;
+           (_lru_probation.next != &_lru_probation || _lru_normal.next != &_lru_normal)) {
+        LRUHandle* old = _lru_probation.next;
+        if (old == &_lru_probation ||
+            (_protected_usage > _protected_capacity && _lru_normal.next != &_lru_normal)) {
+            old = _lru_normal.next;
+        }
         DCHECK(old->priority == CachePriority::NORMAL);
         _evict_one_entry(old);
         old->next = *to_remove_head;
@@ -335,6 +382,35 @@ void LRUCache::_evict_from_lru(size_t total_size, LRUHandle** to_remove_head) {
     }
 }
 
+void LRUCache::_evict_from_clock(LRUHandle* list, size_t total_size,
+                                 LRUHandle** to_remove_head) {
+    // the entries visited in the first round are moved to the newest end, and can be
+    // evicted in the second round
+    for (int round = 0; round < 2; ++round) {
+        LRUHandle* first_moved = nullptr;
+        LRUHandle* p = list->next;
+        while ((_usage + total_size > _capacity || _check_element_count_limit()) && p != list &&
+               p != first_moved) {
+            LRUHandle* next = p->next;
+            if (p->refs > 1) {
+                // in use
+            } else if (p->visited.load(std::memory_order_relaxed)) {
+                p->visited.store(false, std::memory_order_relaxed);
+                _lru_remove(p);
+                _lru_append(list, p);
+                if (first_moved == nullptr) {
+                    first_moved = p;
+                }
+            } else {
+                _evict_one_entry(p);
+                p->next = *to_remove_head;
+                *to_remove_head = p;
+            }
+            p = next;
+        }
+    }
+}
+
 void LRUCache::_evict_one_entry(LRUHandle* e) {
     DCHECK(e->in_cache);
     DCHECK(e->refs == 1); // LRU list contains elements which may be evicted
@@ -343,7 +419,7 @@ void LRUCache::_evict_one_entry(LRUHandle* e) {
     DCHECK(removed);
     e->in_cache = false;
     _unref(e);
-    _usage -= e->total_size;
+    _sub_usage(e);
 }
 
 bool LRUCache::_check_element_count_limit() {
@@ -367,6 +443,9 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
     e->next = e->prev = nullptr;
     e->in_cache = true;
     e->priority = priority;
+    e->in_probation = _protected_capacity > 0 && !_cache_value_check_timestamp &&
+                      !_clock_eviction && priority == CachePriority::NORMAL;
+    e->visited = false;
     e->mem_tracker = tracker;
     e->type = _type;
     memcpy(e->key_data, key.data(), key.size());
@@ -381,6 +460,9 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
         // is freed or the lru list is empty
         if (_cache_value_check_timestamp) {
             _evict_from_lru_with_time(e->total_size, &to_remove_head);
+        } else if (_clock_eviction) {
+            _evict_from_clock(&_lru_normal, e->total_size, &to_remove_head);
+            _evict_from_clock(&_lru_durable, e->total_size, &to_remove_head);
         } else {
             _evict_from_lru(e->total_size, &to_remove_head);
         }
@@ -390,10 +472,24 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
         // space was freed
         auto old = _table.insert(e);
         _usage += e->total_size;
+        if (e->priority == CachePriority::NORMAL && !e->in_probation) {
+            _protected_usage += e->total_size;
+        }
+        if (_clock_eviction) {
+            _lru_append(e->priority == CachePriority::DURABLE ? &_lru_durable : &_lru_normal, e);
+        }
         if (old != nullptr) {
             old->in_cache = false;
-            if (_unref(old)) {
-                _usage -= old->total_size;
+            if (_clock_eviction) {
+                // old is on LRU even if it is in use
+                _lru_remove(old);
+                _sub_usage(old);
+                if (_unref(old)) {
+                    old->next = to_remove_head;
+                    to_remove_head = old;
+                }
+            } else if (_unref(old)) {
+                _sub_usage(old);
                 // old is on LRU because it's in cache and its reference count
                 // was just 1 (Unref returned 0)
                 _lru_remove(old);
@@ -420,10 +516,15 @@ void LRUCache::erase(const CacheKey& key, uint32_t hash) {
     {
         std::lock_guard l(_mutex);
         e = _table.remove(key, hash);
-        if (e != nullptr) {
+        if (e != nullptr && _clock_eviction) {
+            _lru_remove(e);
+            _sub_usage(e);
+            last_ref = _unref(e);
+            e->in_cache = false;
+        } else if (e != nullptr) {
             last_ref = _unref(e);
             if (last_ref) {
-                _usage -= e->total_size;
+                _sub_usage(e);
                 if (e->in_cache) {
                     // locate in free list
                     _lru_remove(e);
@@ -442,17 +543,18 @@ int64_t LRUCache::prune() {
     LRUHandle* to_remove_head = nullptr;
     {
         std::lock_guard l(_mutex);
-        while (_lru_normal.next != &_lru_normal) {
-            LRUHandle* old = _lru_normal.next;
-            _evict_one_entry(old);
-            old->next = to_remove_head;
-            to_remove_head = old;
-        }
-        while (_lru_durable.next != &_lru_durable) {
-            LRUHandle* old = _lru_durable.next;
-            _evict_one_entry(old);
-            old->next = to_remove_head;
-            to_remove_head = old;
+        for (LRUHandle* list : {&_lru_probation, &_lru_normal, &_lru_durable}) {
+            LRUHandle* p = list->next;
+            while (p != list) {
+                LRUHandle* next = p->next;
+                // the entries in use are on the list only with clock eviction
+                if (p->refs == 1) {
+                    _evict_one_entry(p);
+                    p->next = to_remove_head;
+                    to_remove_head = p;
+                }
+                p = next;
+            }
         }
     }
     int64_t pruned_count = 0;
@@ -469,10 +571,27 @@ int64_t LRUCache::prune_if(CacheValuePredicate pred, bool lazy_mode) {
     LRUHandle* to_remove_head = nullptr;
     {
         std::lock_guard l(_mutex);
-        LRUHandle* p = _lru_normal.next;
+        LRUHandle* p = _lru_probation.next;
+        while (p != &_lru_probation) {
+            LRUHandle* next = p->next;
+            if (p->refs > 1) {
+                // in use, only on the list with clock eviction
+            } else if (pred(p->value)) {
+                _evict_one_entry(p);
+                p->next = to_remove_head;
+                to_remove_head = p;
+            } else if (lazy_mode) {
+                break;
+            }
+            p = next;
+        }
+
+        p = _lru_normal.next;
         while (p != &_lru_normal) {
             LRUHandle* next = p->next;
-            if (pred(p->value)) {
+            if (p->refs > 1) {
+                // in use, only on the list with clock eviction
+            } else if (pred(p->value)) {
                 _evict_one_entry(p);
                 p->next = to_remove_head;
                 to_remove_head = p;
@@ -485,7 +604,9 @@ int64_t LRUCache::prune_if(CacheValuePredicate pred, bool lazy_mode) {
         p = _lru_durable.next;
         while (p != &_lru_durable) {
             LRUHandle* next = p->next;
-            if (pred(p->value)) {
+            if (p->refs > 1) {
+                // in use, only on the list with clock eviction
+            } else if (pred(p->value)) {
                 _evict_one_entry(p);
                 p->next = to_remove_head;
                 to_remove_head = p;
@@ -550,6 +671,8 @@ ShardedLRUCache::ShardedLRUCache(const std::string& name, size_t total_capacity,
     INT_ATOMIC_COUNTER_METRIC_REGISTER(_entity, cache_lookup_count);
     INT_ATOMIC_COUNTER_METRIC_REGISTER(_entity, cache_hit_count);
     INT_DOUBLE_METRIC_REGISTER(_entity, cache_hit_ratio);
+    INT_ATOMIC_COUNTER_METRIC_REGISTER(_entity, cache_promotion_count);
+    INT_GAUGE_METRIC_REGISTER(_entity, cache_protected_usage);
 }
 
 ShardedLRUCache::ShardedLRUCache(const std::string& name, size_t total_capacity, LRUCacheType type,
@@ -627,6 +750,21 @@ int64_t ShardedLRUCache::prune_if(CacheValuePredicate pred, bool lazy_mode) {
     return num_prune;
 }
 
+void ShardedLRUCache::set_protected_percentage(uint32_t percentage) {
+    DCHECK_LE(percentage, 100);
+    const size_t per_shard = (_total_capacity + (_num_shards - 1)) / _num_shards;
+    for (int s = 0; s < _num_shards; s++) {
+        _shards[s]->set_protected_capacity(per_shard * percentage / 100);
+    }
+}
+
+void ShardedLRUCache::set_clock_eviction() {
+    for (int s = 0; s < _num_shards; s++) {
+        _shards[s]->set_clock_eviction(true);
+        _shards[s]->set_protected_capacity(0);
+    }
+}
+
 int64_t ShardedLRUCache::mem_consumption() {
     return _mem_tracker->consumption();
 }
@@ -644,25 +782,37 @@ void ShardedLRUCache::update_cache_metrics() const {
     size_t total_usage = 0;
     size_t total_lookup_count = 0;
     size_t total_hit_count = 0;
+    size_t total_promotion_count = 0;
+    size_t total_protected_usage = 0;
     for (int i = 0; i < _num_shards; i++) {
         total_capacity += _shards[i]->get_capacity();
         total_usage += _shards[i]->get_usage();
         total_lookup_count += _shards[i]->get_lookup_count();
         total_hit_count += _shards[i]->get_hit_count();
+        total_promotion_count += _shards[i]->get_promotion_count();
+        total_protected_usage += _shards[i]->get_protected_usage();
     }
 
     cache_capacity->set_value(total_capacity);
     cache_usage->set_value(total_usage);
     cache_lookup_count->set_value(total_lookup_count);
     cache_hit_count->set_value(total_hit_count);
+    cache_promotion_count->set_value(total_promotion_count);
+    cache_protected_usage->set_value(total_protected_usage);
     cache_usage_ratio->set_value(total_capacity == 0 ? 0 : ((double)total_usage / total_capacity));
     cache_hit_ratio->set_value(
             total_lookup_count == 0 ? 0 : ((double)total_hit_count / total_lookup_count));
 }
 
 Cache* new_lru_cache(const std::string& name, size_t capacity, LRUCacheType type,
-                     uint32_t num_shards) {
-    return new ShardedLRUCache(name, capacity, type, num_shards);
+                     uint32_t num_shards, uint32_t protected_percentage, bool clock_eviction) {
+    auto cache = new ShardedLRUCache(name, capacity, type, num_shards);
+    if (clock_eviction) {
+        cache->set_clock_eviction();
+    } else if (protected_percentage > 0) {
+        cache->set_protected_percentage(protected_percentage);
+    }
+    return cache;
 }
 
 } // namespace doris
@@ -9,6 +9,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <atomic>
 #include <functional>
 #include <queue>
 #include <string>
@@ -57,8 +58,12 @@ enum LRUCacheType {
 
 // Create a new cache with a specified name and capacity.
 // This implementation of Cache uses a least-recently-used eviction policy.
+// If protected_percentage is not 0, it is a segmented LRU, see LRUCache.
+// If clock_eviction is true, lookups do not lock the shard exclusively and
+// protected_percentage is ignored, see LRUCache.
 extern Cache* new_lru_cache(const std::string& name, size_t capacity,
-                            LRUCacheType type = LRUCacheType::SIZE, uint32_t num_shards = 16);
+                            LRUCacheType type = LRUCacheType::SIZE, uint32_t num_shards = 16,
+                            uint32_t protected_percentage = 0, bool clock_eviction = false);
 
 class CacheKey {
 public:
@@ -246,9 +251,11 @@ typedef struct LRUHandle {
     size_t total_size; // including key length
     size_t bytes;      // Used by LRUCacheType::NUMBER, LRUCacheType::SIZE equal to total_size.
     bool in_cache;     // Whether entry is in the cache.
-    uint32_t refs;
+    std::atomic<uint32_t> refs;
     uint32_t hash; // Hash of key(); used for fast sharding and comparisons
     CachePriority priority = CachePriority::NORMAL;
+    bool in_probation = false; // Whether entry is not hit since inserted, see LRUCache.
+    std::atomic<bool> visited = false; // Whether entry is hit since last checked by CLOCK.
     MemTrackerLimiter* mem_tracker;
     char key_data[1]; // Beginning of key
     LRUCacheType type;
@@ -320,6 +327,21 @@ private:
 using LRUHandleSortedSet = std::set<std::pair<int64_t, LRUHandle*>>;
 
 // A single shard of sharded cache.
+//
+// If the protected capacity is set, the cache is a segmented LRU (SLRU), which resists
+// the scans reading many entries only once. A NORMAL entry is put on the probation
+// list when it is inserted, and moved to the protected list when it is hit. The
+// probation entries are evicted first, unless the protected entries take more than
+// the protected capacity, so a scan can not evict the entries which are hit again.
+// It can not be used with the cache value timestamp.
+//
+// If the clock eviction is set, a hit only takes the shared lock of the shard, increases
+// the reference count and marks the entry visited, both are atomic. The entries are kept
+// on the lists when they are in use, and the eviction gives a visited entry a second
+// chance by moving it to the newest end (CLOCK), so the lists are only changed by insert,
+// erase and eviction under the exclusive lock. The entries hit once are evicted in the
+// first round, so it also resists scans, the protected capacity is ignored. It can not
+// be used with the cache value timestamp either.
 class LRUCache {
 public:
     LRUCache(LRUCacheType type);
@@ -327,6 +349,10 @@ public:
 
     // Separate from constructor so caller can easily make an array of LRUCache
     void set_capacity(size_t capacity) { _capacity = capacity; }
+    void set_protected_capacity(size_t protected_capacity) {
+        _protected_capacity = protected_capacity;
+    }
+    void set_clock_eviction(bool clock_eviction) { _clock_eviction = clock_eviction; }
     void set_element_count_capacity(uint32_t element_count_capacity) {
         _element_count_capacity = element_count_capacity;
     }
@@ -347,7 +373,9 @@ public:
 
     uint64_t get_lookup_count() const { return _lookup_count; }
     uint64_t get_hit_count() const { return _hit_count; }
+    uint64_t get_promotion_count() const { return _promotion_count; }
     size_t get_usage() const { return _usage; }
+    size_t get_protected_usage() const { return _protected_usage; }
     size_t get_capacity() const { return _capacity; }
 
 private:
@@ -356,8 +384,10 @@ private:
     bool _unref(LRUHandle* e);
     void _evict_from_lru(size_t total_size, LRUHandle** to_remove_head);
     void _evict_from_lru_with_time(size_t total_size, LRUHandle** to_remove_head);
+    void _evict_from_clock(LRUHandle* list, size_t total_size, LRUHandle** to_remove_head);
     void _evict_one_entry(LRUHandle* e);
     bool _check_element_count_limit();
+    void _sub_usage(LRUHandle* e);
 
 private:
     LRUCacheType _type;
@@ -365,21 +395,33 @@ private:
     // Initialized before use.
     size_t _capacity = 0;
 
-    // _mutex protects the following state.
-    doris::Mutex _mutex;
+    bool _clock_eviction = false;
+
+    // _mutex protects the following state, the entries are only changed by atomic
+    // operations under the shared lock.
+    doris::SharedMutex _mutex;
     size_t _usage = 0;
 
     // Dummy head of LRU list.
-    // Entries have refs==1 and in_cache==true.
+    // Entries have refs==1 and in_cache==true, or in_cache==true with clock eviction.
     // _lru_normal.prev is newest entry, _lru_normal.next is oldest entry.
     LRUHandle _lru_normal;
     // _lru_durable.prev is newest entry, _lru_durable.next is oldest entry.
     LRUHandle _lru_durable;
+    // NORMAL entries not hit since inserted, only used when _protected_capacity is set.
+    // _lru_probation.prev is newest entry, _lru_probation.next is oldest entry.
+    LRUHandle _lru_probation;
+
+    // the usage of NORMAL entries out of probation can exceed _protected_capacity only
+    // when there is no probation entry to evict
+    size_t _protected_capacity = 0;
+    size_t _protected_usage = 0;
 
     HandleTable _table;
 
-    uint64_t _lookup_count = 0; // cache查找总次数
-    uint64_t _hit_count = 0;    // 命中cache的总次数
+    std::atomic<uint64_t> _lookup_count = 0; // cache查找总次数
+    std::atomic<uint64_t> _hit_count = 0;    // 命中cache的总次数
+    uint64_t _promotion_count = 0; // entries moved out of probation
 
     CacheValueTimeExtractor _cache_value_time_extractor;
     bool _cache_value_check_timestamp = false;
@@ -415,6 +457,11 @@ public:
     int64_t get_usage() override;
     size_t get_total_capacity() override { return _total_capacity; };
 
+    // Make the shards segmented LRU, with `percentage' of the capacity protected.
+    void set_protected_percentage(uint32_t percentage);
+    // Make the shards evict by CLOCK, so that lookups do not take exclusive locks.
+    void set_clock_eviction();
+
 private:
     void update_cache_metrics() const;
 
@@ -439,6 +486,8 @@ private:
     IntAtomicCounter* cache_lookup_count = nullptr;
     IntAtomicCounter* cache_hit_count = nullptr;
     DoubleGauge* cache_hit_ratio = nullptr;
+    IntAtomicCounter* cache_promotion_count = nullptr;
+    IntGauge* cache_protected_usage = nullptr;
 };
 
 } // namespace doris
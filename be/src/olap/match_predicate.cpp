@@ -19,18 +19,26 @@
 
 #include <string.h>
 
+#include <algorithm>
 #include <memory>
 #include <sstream>
 
 #include "exec/olap_utils.h"
 #include "exprs/string_functions.h"
 #include "olap/schema.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/common/assert_cast.h"
 #include "vec/common/string_ref.h"
 
 namespace doris {
 
-MatchPredicate::MatchPredicate(uint32_t column_id, const std::string& value, MatchType match_type)
-        : ColumnPredicate(column_id), _value(value), _match_type(match_type) {}
+MatchPredicate::MatchPredicate(uint32_t column_id, const std::string& value, MatchType match_type,
+                               InvertedIndexParserType parser_type)
+        : ColumnPredicate(column_id),
+          _value(value),
+          _match_type(match_type),
+          _parser_type(parser_type) {}
 
 PredicateType MatchPredicate::type() const {
     return PredicateType::MATCH;
@@ -66,6 +74,192 @@ Status MatchPredicate::evaluate(const Schema& schema, InvertedIndexIterator* ite
     return s;
 }
 
+Status MatchPredicate::evaluate_top_k(const Schema& schema, InvertedIndexIterator* iterator,
+                                      size_t k, const roaring::Roaring* filter,
+                                      std::vector<ScoredRow>* result) const {
+    if (iterator == nullptr) {
+        return Status::Error<ErrorCode::INVERTED_INDEX_FILE_NOT_FOUND>();
+    }
+    return iterator->read_top_k_from_inverted_index(schema.column(_column_id)->name(), _value,
+                                                    _to_inverted_index_query_type(_match_type), k,
+                                                    filter, result);
+}
+
+Status MatchPredicate::evaluate(BitmapIndexIterator* iterator, uint32_t num_rows,
+                                roaring::Roaring* bitmap) const {
+    if (iterator == nullptr) {
+        return Status::OK();
+    }
+    auto query_type = _to_inverted_index_query_type(_match_type);
+    if (query_type != InvertedIndexQueryType::MATCH_ANY_QUERY &&
+        query_type != InvertedIndexQueryType::MATCH_ALL_QUERY &&
+        query_type != InvertedIndexQueryType::MATCH_PHRASE_QUERY) {
+        return Status::Error<ErrorCode::INVERTED_INDEX_NOT_SUPPORTED>();
+    }
+    StringRef value(_value.c_str(), strnlen(_value.c_str(), _value.size()));
+    bool exact_match = false;
+    Status s = iterator->seek_dictionary(&value, &exact_match);
+    roaring::Roaring roaring;
+    if (s.ok() && exact_match) {
+        RETURN_IF_ERROR(iterator->read_bitmap(iterator->current_ordinal(), &roaring));
+    } else if (!s.ok() && !s.is<ErrorCode::NOT_FOUND>()) {
+        return s;
+    }
+    *bitmap &= roaring;
+    return Status::OK();
+}
+
+Status MatchPredicate::evaluate_without_index(const std::string& column_name,
+                                              InvertedIndexParserType parser_type,
+                                              const vectorized::IColumn& column,
+                                              const rowid_t* rowids, size_t num_rows,
+                                              roaring::Roaring* bitmap) const {
+    auto query_type = _to_inverted_index_query_type(_match_type);
+    if (query_type != InvertedIndexQueryType::MATCH_ANY_QUERY &&
+        query_type != InvertedIndexQueryType::MATCH_ALL_QUERY &&
+        query_type != InvertedIndexQueryType::MATCH_PHRASE_QUERY) {
+        return Status::Error<ErrorCode::INVERTED_INDEX_NOT_SUPPORTED>();
+    }
+    const vectorized::IColumn* values = &column;
+    const vectorized::NullMap* null_map = nullptr;
+    if (const auto* nullable =
+                vectorized::check_and_get_column<vectorized::ColumnNullable>(column)) {
+        values = &nullable->get_nested_column();
+        null_map = &nullable->get_null_map_data();
+    }
+    const auto& strings = assert_cast<const vectorized::ColumnString&>(*values);
+    // the values of CHAR columns are padded with zeros
+    auto get_value = [&](size_t i) {
+        StringRef value = strings.get_data_at(i);
+        return std::string(value.data, strnlen(value.data, value.size));
+    };
+
+    if (parser_type == InvertedIndexParserType::PARSER_NONE) {
+        // the whole value is the only term
+        std::string query_value(_value.c_str(), strnlen(_value.c_str(), _value.size()));
+        for (size_t i = 0; i < num_rows; ++i) {
+            if ((null_map == nullptr || !(*null_map)[i]) && get_value(i) == query_value) {
+                bitmap->add(rowids[i]);
+            }
+        }
+        return Status::OK();
+    }
+
+    try {
+        std::wstring field_ws(column_name.begin(), column_name.end());
+        auto analyzer = FullTextIndexReader::create_analyzer(parser_type);
+        auto query_terms = FullTextIndexReader::get_analyse_result(analyzer.get(), field_ws,
+                                                                   _value, query_type, parser_type);
+        if (query_terms.empty()) {
+            return Status::Error<ErrorCode::INVERTED_INDEX_NO_TERMS>();
+        }
+        for (size_t i = 0; i < num_rows; ++i) {
+            if (null_map != nullptr && (*null_map)[i]) {
+                continue;
+            }
+            // the terms in order, as the phrase query needs
+            auto terms = FullTextIndexReader::get_analyse_result(
+                    analyzer.get(), field_ws, get_value(i),
+                    InvertedIndexQueryType::MATCH_PHRASE_QUERY, parser_type);
+            auto contains = [&](const std::wstring& term) {
+                return std::find(terms.begin(), terms.end(), term) != terms.end();
+            };
+            bool matched = false;
+            if (query_type == InvertedIndexQueryType::MATCH_ANY_QUERY) {
+                matched = std::any_of(query_terms.begin(), query_terms.end(), contains);
+            } else if (query_type == InvertedIndexQueryType::MATCH_ALL_QUERY) {
+                matched = std::all_of(query_terms.begin(), query_terms.end(), contains);
+            } else {
+                matched = std::search(terms.begin(), terms.end(), query_terms.begin(),
+                                      query_terms.end()) != terms.end();
+            }
+            if (matched) {
+                bitmap->add(rowids[i]);
+            }
+        }
+    } catch (const CLuceneError& e) {
+        LOG(WARNING) << "CLuceneError occured, error msg: " << e.what();
+        return Status::Error<ErrorCode::INVERTED_INDEX_CLUCENE_ERROR>();
+    }
+    return Status::OK();
+}
+
+bool MatchPredicate::can_do_bloom_filter() const {
+    return _match_type == MatchType::MATCH_ANY || _match_type == MatchType::MATCH_ALL ||
+           _match_type == MatchType::MATCH_PHRASE;
+}
+
+bool MatchPredicate::evaluate_and(const BloomFilter* bf) const {
+    if (!can_do_bloom_filter() || !bf->is_ngram_bf()) {
+        return true;
+    }
+    const auto* ngram_bf = static_cast<const segment_v2::NGramBloomFilter*>(bf);
+    if (ngram_bf->gram_size() == 0) {
+        return true;
+    }
+    auto it = _term_ng_bfs.find(ngram_bf->layout());
+    if (it == _term_ng_bfs.end()) {
+        it = _term_ng_bfs.emplace(ngram_bf->layout(), _create_term_filters(*ngram_bf)).first;
+    }
+    const auto& term_filters = it->second;
+    if (!term_filters.prunable) {
+        return true;
+    }
+    auto contains = [&](const std::unique_ptr<segment_v2::NGramBloomFilter>& filter) {
+        return bf->contains(*filter);
+    };
+    if (_match_type == MatchType::MATCH_ANY) {
+        return std::any_of(term_filters.filters.begin(), term_filters.filters.end(), contains);
+    }
+    return std::all_of(term_filters.filters.begin(), term_filters.filters.end(), contains);
+}
+
+MatchPredicate::TermFilters MatchPredicate::_create_term_filters(
+        const segment_v2::NGramBloomFilter& bf) const {
+    TermFilters term_filters;
+    if (_parser_type == InvertedIndexParserType::PARSER_NONE) {
+        // the whole value is the only term
+        auto filter = bf.create_query_filter(
+                std::string(_value.c_str(), strnlen(_value.c_str(), _value.size())), false);
+        if (filter != nullptr) {
+            term_filters.filters.push_back(std::move(filter));
+        }
+        term_filters.prunable = !term_filters.filters.empty();
+        return term_filters;
+    }
+    // The english parser splits the values at the non-letters and lowercases the letters, so a
+    // term of ASCII letters is a substring of a matched value, when the case is ignored. The
+    // other parsers may normalize the terms otherwise.
+    if (_parser_type != InvertedIndexParserType::PARSER_ENGLISH || !bf.ignore_case()) {
+        return term_filters;
+    }
+    std::vector<std::wstring> terms;
+    try {
+        auto analyzer = FullTextIndexReader::create_analyzer(_parser_type);
+        terms = FullTextIndexReader::get_analyse_result(analyzer.get(), L"", _value,
+                                                        _to_inverted_index_query_type(_match_type),
+                                                        _parser_type);
+    } catch (const CLuceneError& e) {
+        LOG(WARNING) << "CLuceneError occured, error msg: " << e.what();
+        return term_filters;
+    }
+    for (const auto& term : terms) {
+        std::unique_ptr<segment_v2::NGramBloomFilter> filter;
+        if (std::all_of(term.begin(), term.end(), [](wchar_t c) { return c >= 0 && c < 128; })) {
+            filter = bf.create_query_filter(std::string(term.begin(), term.end()), false);
+        }
+        if (filter != nullptr) {
+            term_filters.filters.push_back(std::move(filter));
+        } else if (_match_type == MatchType::MATCH_ANY) {
+            // a row of this term may be in any page
+            term_filters.filters.clear();
+            break;
+        }
+    }
+    term_filters.prunable = !term_filters.filters.empty();
+    return term_filters;
+}
+
 InvertedIndexQueryType MatchPredicate::_to_inverted_index_query_type(MatchType match_type) const {
     auto ret = InvertedIndexQueryType::UNKNOWN_QUERY;
     switch (match_type) {
@@ -18,11 +18,14 @@
 #ifndef DORIS_BE_SRC_QUERY_EXPRS_MATCH_PREDICATE_H
 #define DORIS_BE_SRC_QUERY_EXPRS_MATCH_PREDICATE_H
 
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "gen_cpp/Exprs_types.h"
 #include "olap/column_predicate.h"
+#include "olap/rowset/segment_v2/ngram_bloom_filter.h"
 #include "runtime/string_search.hpp"
 
 namespace doris {
@@ -31,21 +34,51 @@ enum class MatchType;
 
 class MatchPredicate : public ColumnPredicate {
 public:
-    MatchPredicate(uint32_t column_id, const std::string& value, MatchType match_type);
+    // `parser_type` is of the inverted index of the column, by which the pages may be pruned
+    // with the ngram bloom filters.
+    MatchPredicate(uint32_t column_id, const std::string& value, MatchType match_type,
+                   InvertedIndexParserType parser_type = InvertedIndexParserType::PARSER_UNKNOWN);
 
     virtual PredicateType type() const override;
 
-    //evaluate predicate on Bitmap
-    virtual Status evaluate(BitmapIndexIterator* iterator, uint32_t num_rows,
-                            roaring::Roaring* roaring) const override {
-        LOG(FATAL) << "Not Implemented MatchPredicate::evaluate";
-    }
+    // Evaluates the predicate on the bitmap index of a string column, whose only term of a value
+    // is the whole value, as the inverted index without a parser.
+    Status evaluate(BitmapIndexIterator* iterator, uint32_t num_rows,
+                    roaring::Roaring* bitmap) const override;
 
     //evaluate predicate on inverted
     Status evaluate(const Schema& schema, InvertedIndexIterator* iterator, uint32_t num_rows,
                     roaring::Roaring* bitmap) const override;
 
+    // Collects the `k` rows of `filter` of the highest BM25 relevance to the query, in the
+    // descending order of the scores, with the fulltext index.
+    Status evaluate_top_k(const Schema& schema, InvertedIndexIterator* iterator, size_t k,
+                          const roaring::Roaring* filter, std::vector<ScoredRow>* result) const;
+
+    // Evaluates the predicate on the string values of `column`, which are of the rows `rowids`,
+    // for the segments whose inverted index is not built. The values are parsed as the index
+    // of `parser_type` would be, and the matched rows are added to `bitmap`.
+    Status evaluate_without_index(const std::string& column_name,
+                                  InvertedIndexParserType parser_type,
+                                  const vectorized::IColumn& column, const rowid_t* rowids,
+                                  size_t num_rows, roaring::Roaring* bitmap) const;
+
+    bool can_do_bloom_filter() const override;
+
+    // A page may have a matched row only if its ngram bloom filter contains the ngrams of the
+    // terms of the query, which are tested only for the terms of ASCII letters of the english
+    // parser, if the case of the filter is ignored, or for the whole value without a parser.
+    bool evaluate_and(const BloomFilter* bf) const override;
+
 private:
+    struct TermFilters {
+        // false if any page may have a matched row
+        bool prunable = false;
+        std::vector<std::unique_ptr<segment_v2::NGramBloomFilter>> filters;
+    };
+
+    TermFilters _create_term_filters(const segment_v2::NGramBloomFilter& bf) const;
+
     InvertedIndexQueryType _to_inverted_index_query_type(MatchType match_type) const;
     std::string _debug_string() const override {
         std::string info = "MatchPredicate";
@@ -55,6 +88,9 @@ private:
 private:
     std::string _value;
     MatchType _match_type;
+    InvertedIndexParserType _parser_type;
+    // by the layouts of the ngram bloom filters of the segments
+    mutable std::map<segment_v2::NGramBloomFilter::Layout, TermFilters> _term_ng_bfs;
 };
 
 } // namespace doris
@@ -17,6 +17,10 @@
 
 #include "olap/memtable.h"
 
+#include <pdqsort.h>
+
+#include <numeric>
+
 #include "common/logging.h"
 #include "olap/rowset/beta_rowset.h"
 #include "olap/rowset/rowset_writer.h"
@@ -27,8 +31,10 @@
 #include "vec/aggregate_functions/aggregate_function_reader.h"
 #include "vec/aggregate_functions/aggregate_function_simple_factory.h"
 #include "vec/columns/column_object.h"
+#include "vec/columns/column_string.h"
 #include "vec/core/columns_with_type_and_name.h"
 #include "vec/core/field.h"
+#include "vec/core/sort_key_normalizer.h"
 #include "vec/jsonb/serialize.h"
 
 namespace doris {
@@ -65,10 +71,14 @@ MemTable::MemTable(TabletSharedPtr tablet, Schema* schema, const TabletSchema* t
             fmt::format("MemTableHookInsert:TabletId={}", std::to_string(tablet_id())));
 #endif
     _arena = std::make_unique<vectorized::Arena>();
+    _sort_on_flush =
+            config::enable_memtable_sort_on_flush && _keys_type != KeysType::AGG_KEYS;
     _vec_row_comparator = std::make_shared<RowInBlockComparator>(_schema);
-    // TODO: Support ZOrderComparator in the future
-    _vec_skip_list = std::make_unique<VecTable>(_vec_row_comparator.get(), _arena.get(),
-                                                _keys_type == KeysType::DUP_KEYS);
+    if (!_sort_on_flush) {
+        // TODO: Support ZOrderComparator in the future
+        _vec_skip_list = std::make_unique<VecTable>(_vec_row_comparator.get(), _arena.get(),
+                                                    _keys_type == KeysType::DUP_KEYS);
+    }
     _init_columns_offset_by_slot_descs(slot_descs, tuple_desc);
 }
 void MemTable::_init_columns_offset_by_slot_descs(const std::vector<SlotDescriptor*>* slot_descs,
@@ -181,6 +191,10 @@ void MemTable::insert(const vectorized::Block* input_block, const std::vector<in
     size_t input_size = target_block.allocated_bytes() * num_rows / target_block.rows();
     _mem_usage += input_size;
     _insert_mem_tracker->consume(input_size);
+    if (_sort_on_flush) {
+        _rows += num_rows;
+        return;
+    }
     for (int i = 0; i < num_rows; i++) {
         _row_in_blocks.emplace_back(new RowInBlock {cursor_in_mutableblock + i});
         _insert_one_row_from_block(_row_in_blocks.back());
@@ -302,9 +316,99 @@ void MemTable::_collect_vskiplist_results() {
     }
 }
 
+void MemTable::_collect_sorted_results() {
+    if (_input_mutable_block.rows() == 0) {
+        return;
+    }
+    size_t num_key_columns = _schema->num_key_columns();
+    vectorized::ColumnRawPtrs key_columns(num_key_columns);
+    for (size_t i = 0; i < num_key_columns; ++i) {
+        key_columns[i] = _input_mutable_block.get_column_by_position(i).get();
+    }
+    if (vectorized::SortKeyNormalizer::can_normalize(key_columns)) {
+        // the same order as RowInBlockComparator: ascending, nulls first
+        vectorized::SortDescription desc;
+        for (size_t i = 0; i < num_key_columns; ++i) {
+            desc.emplace_back(i, 1, -1);
+        }
+        auto keys = vectorized::ColumnString::create();
+        if (vectorized::SortKeyNormalizer::normalize(key_columns, desc, keys.get())) {
+            _sort_and_collect_results([&keys](size_t lhs, size_t rhs) {
+                return vectorized::SortKeyNormalizer::compare(*keys, lhs, *keys, rhs);
+            });
+            return;
+        }
+    }
+    _sort_and_collect_results([this, num_key_columns](size_t lhs, size_t rhs) {
+        return _input_mutable_block.compare_at(lhs, rhs, num_key_columns, _input_mutable_block,
+                                               -1);
+    });
+}
+
+template <typename Compare>
+void MemTable::_sort_and_collect_results(const Compare& compare) {
+    size_t rows = _input_mutable_block.rows();
+    DCHECK(rows <= std::numeric_limits<int>::max());
+    std::vector<int> row_pos_vec(rows);
+    std::iota(row_pos_vec.begin(), row_pos_vec.end(), 0);
+    // the rows of the same key keep the order they are inserted, so that the later row
+    // replaces the former one, the same as the skiplist
+    pdqsort(row_pos_vec.begin(), row_pos_vec.end(), [&compare](int lhs, int rhs) {
+        int res = compare(lhs, rhs);
+        return res != 0 ? res < 0 : lhs < rhs;
+    });
+
+    if (_keys_type == KeysType::DUP_KEYS) {
+        vectorized::Block in_block = _input_mutable_block.to_block();
+        _output_mutable_block.add_rows(&in_block, row_pos_vec.data(),
+                                       row_pos_vec.data() + rows);
+        return;
+    }
+
+    auto& columns = _input_mutable_block.mutable_columns();
+    char* agg_places = _arena->aligned_alloc(_total_size_of_aggregate_states, 16);
+    for (size_t begin = 0, end = 0; begin < rows; begin = end) {
+        int row_pos = row_pos_vec[begin];
+        for (auto cid = _schema->num_key_columns(); cid < _schema->num_columns(); cid++) {
+            auto col_ptr = columns[cid].get();
+            auto data = agg_places + _offsets_of_aggregate_states[cid];
+            _agg_functions[cid]->create(data);
+            _agg_functions[cid]->add(data, const_cast<const doris::vectorized::IColumn**>(&col_ptr),
+                                     row_pos, nullptr);
+        }
+        for (end = begin + 1; end < rows && compare(row_pos, row_pos_vec[end]) == 0; ++end) {
+            _merged_rows++;
+            int new_row_pos = row_pos_vec[end];
+            if (_tablet_schema->has_sequence_col()) {
+                auto col_ptr = columns[_tablet_schema->sequence_col_idx()].get();
+                // the sequence of the former row is larger, don't need to update
+                if (col_ptr->compare_at(row_pos, new_row_pos, *col_ptr, -1) > 0) {
+                    continue;
+                }
+                row_pos = new_row_pos;
+            }
+            for (auto cid = _schema->num_key_columns(); cid < _schema->num_columns(); cid++) {
+                auto col_ptr = columns[cid].get();
+                _agg_functions[cid]->add(agg_places + _offsets_of_aggregate_states[cid],
+                                         const_cast<const doris::vectorized::IColumn**>(&col_ptr),
+                                         new_row_pos, nullptr);
+            }
+        }
+        for (size_t i = 0; i < _schema->num_key_columns(); ++i) {
+            _output_mutable_block.get_column_by_position(i)->insert_from(*columns[i], row_pos);
+        }
+        for (size_t i = _schema->num_key_columns(); i < _schema->num_columns(); ++i) {
+            auto agg_place = agg_places + _offsets_of_aggregate_states[i];
+            _agg_functions[i]->insert_result_into(agg_place,
+                                                  *_output_mutable_block.get_column_by_position(i));
+            _agg_functions[i]->destroy(agg_place);
+        }
+    }
+}
+
 void MemTable::shrink_memtable_by_agg() {
     SCOPED_CONSUME_MEM_TRACKER(_insert_mem_tracker_use_hook.get());
-    if (_keys_type == KeysType::DUP_KEYS) {
+    if (_keys_type == KeysType::DUP_KEYS || _sort_on_flush) {
         return;
     }
     _collect_vskiplist_results<false>();
@@ -363,6 +467,7 @@ Status MemTable::flush() {
                                           atomic_num_segments_after_flush));
     DorisMetrics::instance()->memtable_flush_total->increment(1);
     DorisMetrics::instance()->memtable_flush_duration_us->increment(duration_ns / 1000);
+    DorisMetrics::instance()->memtable_flush_latency_us->add(duration_ns / 1000);
     VLOG_CRITICAL << "after flush memtable for tablet: " << tablet_id()
                   << ", flushsize: " << _flush_size;
 
@@ -371,7 +476,11 @@ Status MemTable::flush() {
 
 Status MemTable::_do_flush(int64_t& duration_ns) {
     SCOPED_RAW_TIMER(&duration_ns);
-    _collect_vskiplist_results<true>();
+    if (_sort_on_flush) {
+        _collect_sorted_results();
+    } else {
+        _collect_vskiplist_results<true>();
+    }
     vectorized::Block block = _output_mutable_block.to_block();
     if (_tablet_schema->store_row_column()) {
         // convert block to row store format
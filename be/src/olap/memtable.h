@@ -153,6 +153,10 @@ private:
 
     size_t _schema_size;
 
+    // The rows are appended to _input_mutable_block and sorted once on flush, rather than
+    // inserted into _vec_skip_list one by one. The aggregate keys table still uses the
+    // skiplist, because it is shrunk by aggregation before flush.
+    bool _sort_on_flush;
     std::unique_ptr<VecTable> _vec_skip_list;
     VecTable::Hint _vec_hint;
     void _init_columns_offset_by_slot_descs(const std::vector<SlotDescriptor*>* slot_descs,
@@ -175,6 +179,11 @@ private:
 
     template <bool is_final>
     void _collect_vskiplist_results();
+    // sort the rows of _input_mutable_block by keys and aggregate the rows of the same key
+    // into _output_mutable_block, only used when _sort_on_flush
+    void _collect_sorted_results();
+    template <typename Compare>
+    void _sort_and_collect_results(const Compare& compare);
     bool _is_first_insertion;
 
     void _init_agg_functions(const vectorized::Block* block);
@@ -21,12 +21,16 @@
 
 #include "olap/memtable.h"
 #include "runtime/thread_context.h"
+#include "util/doris_metrics.h"
 #include "util/scoped_cleanup.h"
 #include "util/time.h"
 
 namespace doris {
 using namespace ErrorCode;
 
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(memtable_flush_thread_pool_queue_size, MetricUnit::NOUNIT);
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(memtable_flush_thread_pool_active_threads, MetricUnit::NOUNIT);
+
 class MemtableFlushTask final : public Runnable {
 public:
     MemtableFlushTask(FlushToken* flush_token, std::unique_ptr<MemTable> memtable,
@@ -112,6 +116,13 @@ void FlushToken::_flush_memtable(MemTable* memtable, int64_t submit_task_time) {
     _stats.flush_disk_size_bytes += memtable->flush_size();
 }
 
+MemTableFlushExecutor::~MemTableFlushExecutor() {
+    DEREGISTER_HOOK_METRIC(memtable_flush_thread_pool_queue_size);
+    DEREGISTER_HOOK_METRIC(memtable_flush_thread_pool_active_threads);
+    _flush_pool->shutdown();
+    _high_prio_flush_pool->shutdown();
+}
+
 void MemTableFlushExecutor::init(const std::vector<DataDir*>& data_dirs) {
     int32_t data_dir_num = data_dirs.size();
     size_t min_threads = std::max(1, config::flush_thread_num_per_store);
@@ -127,6 +138,14 @@ void MemTableFlushExecutor::init(const std::vector<DataDir*>& data_dirs) {
             .set_min_threads(min_threads)
             .set_max_threads(max_threads)
             .build(&_high_prio_flush_pool);
+
+    // the flush backlog is the pressure of the load memory
+    REGISTER_HOOK_METRIC(memtable_flush_thread_pool_queue_size, [this]() {
+        return _flush_pool->get_queue_size() + _high_prio_flush_pool->get_queue_size();
+    });
+    REGISTER_HOOK_METRIC(memtable_flush_thread_pool_active_threads, [this]() {
+        return _flush_pool->num_active_threads() + _high_prio_flush_pool->num_active_threads();
+    });
 }
 
 // NOTE: we use SERIAL mode here to ensure all mem-tables from one tablet are flushed in order.
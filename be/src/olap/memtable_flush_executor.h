@@ -96,10 +96,7 @@ private:
 class MemTableFlushExecutor {
 public:
     MemTableFlushExecutor() {}
-    ~MemTableFlushExecutor() {
-        _flush_pool->shutdown();
-        _high_prio_flush_pool->shutdown();
-    }
+    ~MemTableFlushExecutor();
 
     // init should be called after storage engine is opened,
     // because it needs path hash of each data dir.
@@ -108,6 +105,9 @@ public:
     Status create_flush_token(std::unique_ptr<FlushToken>* flush_token, RowsetTypePB rowset_type,
                               bool should_serial, bool is_high_priority);
 
+    // the pool also runs the segments of a large memtable flushed concurrently
+    ThreadPool* flush_pool() { return _flush_pool.get(); }
+
 private:
     std::unique_ptr<ThreadPool> _flush_pool;
     std::unique_ptr<ThreadPool> _high_prio_flush_pool;
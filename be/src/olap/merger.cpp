@@ -24,6 +24,8 @@
 #include "olap/row_cursor.h"
 #include "olap/storage_engine.h"
 #include "olap/tablet.h"
+#include "runtime/thread_context.h"
+#include "util/threadpool.h"
 #include "util/trace.h"
 #include "vec/olap/block_reader.h"
 
@@ -162,7 +164,8 @@ Status Merger::vertical_compact_one_group(
         TabletSharedPtr tablet, ReaderType reader_type, TabletSchemaSPtr tablet_schema, bool is_key,
         const std::vector<uint32_t>& column_group, vectorized::RowSourcesBuffer* row_source_buf,
         const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
-        RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment, Statistics* stats_output) {
+        RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment, Statistics* stats_output,
+        int64_t parallel_group_idx) {
     // build tablet reader
     VLOG_NOTICE << "vertical compact one group, max_rows_per_segment=" << max_rows_per_segment;
     vectorized::VerticalBlockReader reader(row_source_buf);
@@ -216,9 +219,15 @@ Status Merger::vertical_compact_one_group(
         RETURN_NOT_OK_LOG(
                 reader.next_block_with_aggregation(&block, &eof),
                 "failed to read next block when merging rowsets of tablet " + tablet->full_name());
-        RETURN_NOT_OK_LOG(
-                dst_rowset_writer->add_columns(&block, column_group, is_key, max_rows_per_segment),
-                "failed to write block when merging rowsets of tablet " + tablet->full_name());
+        Status st;
+        if (parallel_group_idx < 0) {
+            st = dst_rowset_writer->add_columns(&block, column_group, is_key, max_rows_per_segment);
+        } else {
+            st = dst_rowset_writer->add_group_columns(&block, column_group, parallel_group_idx,
+                                                      max_rows_per_segment);
+        }
+        RETURN_NOT_OK_LOG(st, "failed to write block when merging rowsets of tablet " +
+                                      tablet->full_name());
 
         if (is_key && reader_params.record_rowids && block.rows() > 0) {
             std::vector<uint32_t> segment_num_rows;
@@ -239,8 +248,54 @@ Status Merger::vertical_compact_one_group(
         stats_output->merged_rows = reader.merged_rows();
         stats_output->filtered_rows = reader.filtered_rows();
     }
-    RETURN_IF_ERROR(dst_rowset_writer->flush_columns(is_key));
+    if (parallel_group_idx < 0) {
+        RETURN_IF_ERROR(dst_rowset_writer->flush_columns(is_key));
+    } else {
+        RETURN_IF_ERROR(dst_rowset_writer->flush_group_columns(parallel_group_idx));
+    }
+
+    return Status::OK();
+}
 
+Status Merger::vertical_compact_value_groups_in_parallel(
+        TabletSharedPtr tablet, ReaderType reader_type, TabletSchemaSPtr tablet_schema,
+        const std::vector<std::vector<uint32_t>>& column_groups,
+        const vectorized::RowSourcesBuffer& row_sources_buf,
+        const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
+        RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment, int max_parallel_groups) {
+    auto* thread_pool = StorageEngine::instance()->vertical_compaction_group_thread_pool();
+    DCHECK(thread_pool != nullptr);
+    auto token = thread_pool->new_token(ThreadPool::ExecutionMode::CONCURRENT, max_parallel_groups);
+    auto mem_tracker = thread_context()->thread_mem_tracker_mgr->limiter_mem_tracker();
+    std::vector<Status> statuses(column_groups.size());
+    for (size_t i = 1; i < column_groups.size(); ++i) {
+        Status st = token->submit_func([&, i]() {
+            SCOPED_ATTACH_TASK(mem_tracker);
+            // every group reads the row sources and the source rowsets by itself, and they are
+            // created in the task so only the running groups take memory
+            std::unique_ptr<vectorized::RowSourcesBuffer> group_row_sources_buf;
+            statuses[i] = row_sources_buf.create_reader(&group_row_sources_buf);
+            if (!statuses[i].ok()) {
+                return;
+            }
+            std::vector<RowsetReaderSharedPtr> rs_readers;
+            for (auto& rs_reader : src_rowset_readers) {
+                rs_readers.push_back(rs_reader->clone());
+            }
+            statuses[i] = vertical_compact_one_group(
+                    tablet, reader_type, tablet_schema, false, column_groups[i],
+                    group_row_sources_buf.get(), rs_readers, dst_rowset_writer,
+                    max_rows_per_segment, nullptr, i);
+        });
+        if (!st.ok()) {
+            token->shutdown();
+            return st;
+        }
+    }
+    token->wait();
+    for (auto& st : statuses) {
+        RETURN_IF_ERROR(st);
+    }
     return Status::OK();
 }
 
@@ -303,7 +358,8 @@ Status Merger::vertical_compact_one_group(TabletSharedPtr tablet, ReaderType rea
 // steps to do vertical merge:
 // 1. split columns into column groups
 // 2. compact groups one by one, generate a row_source_buf when compact key group
-// and use this row_source_buf to compact value column groups
+// and use this row_source_buf to compact value column groups. The value column groups
+// of base compaction are compacted in parallel.
 // 3. build output rowset
 Status Merger::vertical_merge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
                                       TabletSchemaSPtr tablet_schema,
@@ -316,6 +372,11 @@ Status Merger::vertical_merge_rowsets(TabletSharedPtr tablet, ReaderType reader_
 
     vectorized::RowSourcesBuffer row_sources_buf(tablet->tablet_id(), tablet->tablet_path(),
                                                  reader_type);
+    int max_parallel_groups = 1;
+    if (reader_type == READER_BASE_COMPACTION &&
+        StorageEngine::instance()->vertical_compaction_group_thread_pool() != nullptr) {
+        max_parallel_groups = config::vertical_compaction_max_parallel_groups;
+    }
     // compact group one by one
     for (auto i = 0; i < column_groups.size(); ++i) {
         VLOG_NOTICE << "row source size: " << row_sources_buf.total_size();
@@ -327,6 +388,14 @@ Status Merger::vertical_merge_rowsets(TabletSharedPtr tablet, ReaderType reader_
             row_sources_buf.flush();
         }
         row_sources_buf.seek_to_begin();
+        // the order of the rows is decided by the key group, so the value groups are independent
+        if (is_key && max_parallel_groups > 1 && column_groups.size() > 2) {
+            RETURN_IF_ERROR(vertical_compact_value_groups_in_parallel(
+                    tablet, reader_type, tablet_schema, column_groups, row_sources_buf,
+                    src_rowset_readers, dst_rowset_writer, max_rows_per_segment,
+                    max_parallel_groups));
+            break;
+        }
     }
 
     // finish compact, build output rowset
@@ -66,7 +66,17 @@ public:
             vectorized::RowSourcesBuffer* row_source_buf,
             const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
             RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment,
-            Statistics* stats_output);
+            Statistics* stats_output, int64_t parallel_group_idx = -1);
+
+    // merge the value column groups concurrently by the row sources of the key group,
+    // at most max_parallel_groups groups at a time
+    static Status vertical_compact_value_groups_in_parallel(
+            TabletSharedPtr tablet, ReaderType reader_type, TabletSchemaSPtr tablet_schema,
+            const std::vector<std::vector<uint32_t>>& column_groups,
+            const vectorized::RowSourcesBuffer& row_sources_buf,
+            const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
+            RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment,
+            int max_parallel_groups);
 
     // for segcompaction
     static Status vertical_compact_one_group(TabletSharedPtr tablet, ReaderType reader_type,
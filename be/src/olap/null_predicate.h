@@ -64,6 +64,15 @@ public:
         }
     }
 
+    bool may_delete(const std::pair<WrapperField*, WrapperField*>& statistic) const override {
+        // same as evaluate_del, _is_null==true means the origin condition is 'is not null'
+        if (_is_null) {
+            return !statistic.second->is_null();
+        } else {
+            return statistic.first->is_null();
+        }
+    }
+
     bool evaluate_and(const segment_v2::BloomFilter* bf) const override {
         if (_is_null) {
             return bf->test_bytes(nullptr, 0);
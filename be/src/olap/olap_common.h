@@ -300,6 +300,8 @@ struct OlapReaderStatistics {
     int64_t rows_short_circuit_cond_filtered = 0;
     int64_t vec_cond_input_rows = 0;
     int64_t short_circuit_cond_input_rows = 0;
+    // times of reordering predicates by the observed selectivity and cost
+    int64_t predicate_reorder_num = 0;
     int64_t rows_vec_del_cond_filtered = 0;
     int64_t vec_cond_ns = 0;
     int64_t short_cond_ns = 0;
@@ -324,6 +326,16 @@ struct OlapReaderStatistics {
 
     int64_t total_pages_num = 0;
     int64_t cached_pages_num = 0;
+    // pages decompressed from the compressed page cache, without IO
+    int64_t compressed_cached_pages_num = 0;
+    // pages pointed into the mapped segment files, without copy
+    int64_t mapped_pages_num = 0;
+    // data pages of remote segments which are prefetched or not when they are read
+    int64_t remote_page_prefetch_hit_num = 0;
+    int64_t remote_page_prefetch_miss_num = 0;
+    // reads which load several data pages at once, and the pages loaded by them
+    int64_t merged_page_read_num = 0;
+    int64_t merged_pages_num = 0;
 
     int64_t rows_bitmap_index_filtered = 0;
     int64_t bitmap_index_filter_timer = 0;
@@ -343,6 +355,8 @@ struct OlapReaderStatistics {
     int64_t filtered_segment_number = 0;
     // total number of segment
     int64_t total_segment_number = 0;
+    // number of delete conditions not evaluated on the segments they can't delete any row of
+    int64_t pruned_delete_condition_number = 0;
     // general_debug_ns is designed for the purpose of DEBUG, to record any infomations of debugging or profiling.
     // different from specific meaningful timer such as index_load_ns, general_debug_ns can be used flexibly.
     // general_debug_ns has associated with OlapScanNode's _general_debug_timer already.
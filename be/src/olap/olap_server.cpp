@@ -91,6 +91,10 @@ Status StorageEngine::start_bg_threads() {
             .set_min_threads(config::cold_data_compaction_thread_num)
             .set_max_threads(config::cold_data_compaction_thread_num)
             .build(&_cold_data_compaction_thread_pool);
+    ThreadPoolBuilder("VerticalCompactionGroupThreadPool")
+            .set_min_threads(config::vertical_compaction_group_thread_num)
+            .set_max_threads(config::vertical_compaction_group_thread_num)
+            .build(&_vertical_compaction_group_thread_pool);
 
     // compaction tasks producer thread
     RETURN_IF_ERROR(Thread::create(
@@ -183,6 +187,18 @@ Status StorageEngine::start_bg_threads() {
             .set_max_threads(config::tablet_publish_txn_max_thread)
             .build(&_tablet_publish_txn_thread_pool);
 
+    ThreadPoolBuilder("CalcDeleteBitmapThreadPool")
+            .set_min_threads(1)
+            .set_max_threads(config::calc_delete_bitmap_max_thread)
+            .build(&_calc_delete_bitmap_thread_pool);
+
+    if (config::segment_column_encode_max_thread > 1) {
+        ThreadPoolBuilder("SegmentColumnEncodeThreadPool")
+                .set_min_threads(1)
+                .set_max_threads(config::segment_column_encode_max_thread)
+                .build(&_segment_column_encode_thread_pool);
+    }
+
     LOG(INFO) << "all storage engine's background threads are started.";
     return Status::OK();
 }
@@ -552,6 +568,14 @@ std::vector<TabletSharedPtr> StorageEngine::_generate_compaction_tasks(
             }
         }
 
+        if (need_pick_tablet && !_compaction_io_budget.has_budget(data_dir)) {
+            // the io budget of the disk is used up by the running tasks
+            need_pick_tablet = false;
+            if (!check_score) {
+                continue;
+            }
+        }
+
         // Even if need_pick_tablet is false, we still need to call find_best_tablet_to_compaction(),
         // So that we can update the max_compaction_score metric.
         if (!data_dir->reach_capacity_limit(0)) {
@@ -591,9 +615,12 @@ std::vector<TabletSharedPtr> StorageEngine::_generate_compaction_tasks(
 }
 
 void StorageEngine::_update_cumulative_compaction_policy() {
-    if (_cumulative_compaction_policy == nullptr) {
-        _cumulative_compaction_policy =
-                CumulativeCompactionPolicyFactory::create_cumulative_compaction_policy();
+    // config::cumulative_compaction_policy is mutable, the tablets switch to the new policy when
+    // their scores are calculated next time
+    auto policy = CumulativeCompactionPolicyFactory::create_cumulative_compaction_policy();
+    if (_cumulative_compaction_policy == nullptr ||
+        _cumulative_compaction_policy->name() != policy->name()) {
+        _cumulative_compaction_policy = policy;
     }
 }
 
@@ -645,8 +672,12 @@ Status StorageEngine::_submit_compaction_task(TabletSharedPtr tablet,
                 tablet->tablet_id(), compaction_type);
     }
     int64_t permits = 0;
-    Status st = tablet->prepare_compaction_and_calculate_permits(compaction_type, tablet, &permits);
+    int64_t input_bytes = 0;
+    Status st = tablet->prepare_compaction_and_calculate_permits(compaction_type, tablet, &permits,
+                                                                 &input_bytes);
     if (st.ok() && permits > 0 && _permit_limiter.request(permits)) {
+        // the input rowsets are read, and about the same bytes are written
+        _compaction_io_budget.consume(tablet->data_dir(), input_bytes * 2);
         std::unique_ptr<ThreadPool>& thread_pool =
                 (compaction_type == CompactionType::CUMULATIVE_COMPACTION)
                         ? _cumu_compaction_thread_pool
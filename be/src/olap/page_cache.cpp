@@ -17,6 +17,7 @@
 
 #include "olap/page_cache.h"
 
+#include "common/config.h"
 #include "runtime/thread_context.h"
 
 namespace doris {
@@ -24,28 +25,41 @@ namespace doris {
 StoragePageCache* StoragePageCache::_s_instance = nullptr;
 
 void StoragePageCache::create_global_cache(size_t capacity, int32_t index_cache_percentage,
-                                           uint32_t num_shards) {
+                                           uint32_t num_shards, uint32_t protected_percentage,
+                                           size_t compressed_capacity) {
     DCHECK(_s_instance == nullptr);
-    static StoragePageCache instance(capacity, index_cache_percentage, num_shards);
+    static StoragePageCache instance(capacity, index_cache_percentage, num_shards,
+                                     protected_percentage, compressed_capacity);
     _s_instance = &instance;
 }
 
 StoragePageCache::StoragePageCache(size_t capacity, int32_t index_cache_percentage,
-                                   uint32_t num_shards)
+                                   uint32_t num_shards, uint32_t protected_percentage,
+                                   size_t compressed_capacity)
         : _index_cache_percentage(index_cache_percentage) {
+    bool clock_eviction = config::enable_cache_clock_eviction;
+    if (compressed_capacity > 0) {
+        _compressed_page_cache = std::unique_ptr<Cache>(
+                new_lru_cache("CompressedPageCache", compressed_capacity, LRUCacheType::SIZE,
+                              num_shards, protected_percentage, clock_eviction));
+    }
     if (index_cache_percentage == 0) {
         _data_page_cache = std::unique_ptr<Cache>(
-                new_lru_cache("DataPageCache", capacity, LRUCacheType::SIZE, num_shards));
+                new_lru_cache("DataPageCache", capacity, LRUCacheType::SIZE, num_shards,
+                              protected_percentage, clock_eviction));
     } else if (index_cache_percentage == 100) {
         _index_page_cache = std::unique_ptr<Cache>(
-                new_lru_cache("IndexPageCache", capacity, LRUCacheType::SIZE, num_shards));
+                new_lru_cache("IndexPageCache", capacity, LRUCacheType::SIZE, num_shards,
+                              protected_percentage, clock_eviction));
     } else if (index_cache_percentage > 0 && index_cache_percentage < 100) {
         _data_page_cache = std::unique_ptr<Cache>(
                 new_lru_cache("DataPageCache", capacity * (100 - index_cache_percentage) / 100,
-                              LRUCacheType::SIZE, num_shards));
+                              LRUCacheType::SIZE, num_shards, protected_percentage,
+                              clock_eviction));
         _index_page_cache = std::unique_ptr<Cache>(
                 new_lru_cache("IndexPageCache", capacity * index_cache_percentage / 100,
-                              LRUCacheType::SIZE, num_shards));
+                              LRUCacheType::SIZE, num_shards, protected_percentage,
+                              clock_eviction));
     } else {
         CHECK(false) << "invalid index page cache percentage";
     }
@@ -76,6 +90,24 @@ void StoragePageCache::insert(const CacheKey& key, const Slice& data, PageCacheH
     *handle = PageCacheHandle(cache, lru_handle);
 }
 
+bool StoragePageCache::lookup_compressed(const CacheKey& key, PageCacheHandle* handle) {
+    auto lru_handle = _compressed_page_cache->lookup(key.encode());
+    if (lru_handle == nullptr) {
+        return false;
+    }
+    *handle = PageCacheHandle(_compressed_page_cache.get(), lru_handle);
+    return true;
+}
+
+void StoragePageCache::insert_compressed(const CacheKey& key, const Slice& data) {
+    auto deleter = [](const doris::CacheKey& key, void* value) { delete[] (uint8_t*)value; };
+    char* buf = new char[data.size];
+    memcpy(buf, data.data, data.size);
+    auto lru_handle = _compressed_page_cache->insert(key.encode(), buf, data.size, deleter,
+                                                     CachePriority::NORMAL);
+    _compressed_page_cache->release(lru_handle);
+}
+
 void StoragePageCache::prune(segment_v2::PageTypePB page_type) {
     auto cache = _get_page_cache(page_type);
     cache->prune();
@@ -32,7 +32,8 @@ class PageCacheHandle;
 
 // Wrapper around Cache, and used for cache page of column data
 // in Segment.
-// TODO(zc): We should add some metric to see cache hit/miss rate.
+// The hit rate of data pages and index pages are reported by the metrics of
+// "DataPageCache" and "IndexPageCache".
 class StoragePageCache {
 public:
     // The unique key identifying entries in the page cache.
@@ -56,15 +57,21 @@ public:
 
     static constexpr uint32_t kDefaultNumShards = 16;
 
-    // Create global instance of this class
+    // Create global instance of this class.
+    // `protected_percentage' of each cache is kept for the pages hit after inserted,
+    // see LRUCache, 0 means plain LRU.
+    // `compressed_capacity' is the capacity of the compressed page tier, 0 disables it.
     static void create_global_cache(size_t capacity, int32_t index_cache_percentage,
-                                    uint32_t num_shards = kDefaultNumShards);
+                                    uint32_t num_shards = kDefaultNumShards,
+                                    uint32_t protected_percentage = 0,
+                                    size_t compressed_capacity = 0);
 
     // Return global instance.
     // Client should call create_global_cache before.
     static StoragePageCache* instance() { return _s_instance; }
 
-    StoragePageCache(size_t capacity, int32_t index_cache_percentage, uint32_t num_shards);
+    StoragePageCache(size_t capacity, int32_t index_cache_percentage, uint32_t num_shards,
+                     uint32_t protected_percentage = 0, size_t compressed_capacity = 0);
 
     // Lookup the given page in the cache.
     //
@@ -93,6 +100,16 @@ public:
 
     void prune(segment_v2::PageTypePB page_type);
 
+    // The compressed tier keeps data pages as they are in file, i.e. compressed and with
+    // footer and checksum, so a page evicted from the data page cache can be decompressed
+    // again without IO. The key is the same as the data page cache.
+    bool is_compressed_cache_available() const { return _compressed_page_cache != nullptr; }
+
+    bool lookup_compressed(const CacheKey& key, PageCacheHandle* handle);
+
+    // Insert a copy of `data'.
+    void insert_compressed(const CacheKey& key, const Slice& data);
+
     int64_t get_page_cache_mem_consumption(segment_v2::PageTypePB page_type) {
         return _get_page_cache(page_type)->mem_consumption();
     }
@@ -104,6 +121,7 @@ private:
     int32_t _index_cache_percentage = 0;
     std::unique_ptr<Cache> _data_page_cache = nullptr;
     std::unique_ptr<Cache> _index_page_cache = nullptr;
+    std::unique_ptr<Cache> _compressed_page_cache = nullptr;
 
     Cache* _get_page_cache(segment_v2::PageTypePB page_type) {
         switch (page_type) {
@@ -27,6 +27,7 @@
 #include "olap/column_predicate.h"
 #include "olap/comparison_predicate.h"
 #include "olap/in_list_predicate.h"
+#include "olap/inverted_index_parser.h"
 #include "olap/match_predicate.h"
 #include "olap/null_predicate.h"
 #include "olap/tablet_schema.h"
@@ -279,8 +280,13 @@ inline ColumnPredicate* parse_to_predicate(TabletSchemaSPtr tablet_schema,
         return new NullPredicate(index, to_lower(condition.condition_values[0]) == "null",
                                  opposite);
     } else if (is_match_condition(condition.condition_op)) {
+        auto parser_type = InvertedIndexParserType::PARSER_UNKNOWN;
+        if (const auto* inverted_index = tablet_schema->get_inverted_index(col_unique_id)) {
+            parser_type = get_inverted_index_parser_type_from_string(
+                    get_parser_string_from_properties(inverted_index->properties()));
+        }
         return new MatchPredicate(index, condition.condition_values[0],
-                                  to_match_type(condition.condition_op));
+                                  to_match_type(condition.condition_op), parser_type);
     }
 
     if ((condition.condition_op == "*=" || condition.condition_op == "!*=") &&
@@ -17,9 +17,13 @@
 
 #include "olap/primary_key_index.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "common/config.h"
 #include "io/fs/file_reader.h"
 #include "olap/rowset/segment_v2/encoding_info.h"
+#include "vec/data_types/data_type_factory.hpp"
 
 namespace doris {
 
@@ -94,4 +98,131 @@ Status PrimaryKeyIndexReader::parse_bf(io::FileReaderSPtr file_reader,
     return Status::OK();
 }
 
+Status PrimaryKeyMemoryIndex::build(const PrimaryKeyIndexReader& reader, int64_t max_bytes) {
+    uint32_t num_rows = reader.num_rows();
+    if (static_cast<int64_t>(num_rows) * (sizeof(uint32_t) + sizeof(uint64_t)) > max_bytes) {
+        return Status::MemoryLimitExceeded("too many primary keys: {}", num_rows);
+    }
+    _offsets.reserve(num_rows + 1);
+    _offsets.push_back(0);
+
+    std::unique_ptr<segment_v2::IndexedColumnIterator> iter;
+    RETURN_IF_ERROR(reader.new_iterator(&iter));
+    RETURN_IF_ERROR(iter->seek_to_ordinal(0));
+    auto index_type = vectorized::DataTypeFactory::instance().create_data_type(
+            reader.type_info()->type(), 1, 0);
+    auto index_column = index_type->create_column();
+    size_t remaining = num_rows;
+    while (remaining > 0) {
+        size_t num_read = std::min<size_t>(remaining, 1024);
+        index_column->clear();
+        RETURN_IF_ERROR(iter->next_batch(&num_read, index_column));
+        DCHECK(num_read > 0);
+        for (size_t i = 0; i < num_read; ++i) {
+            auto key = index_column->get_data_at(i);
+            _data.append(key.data, key.size);
+        }
+        int64_t estimated_bytes = _data.size() + static_cast<int64_t>(num_rows) *
+                                                         (sizeof(uint32_t) + sizeof(uint64_t));
+        if (estimated_bytes > max_bytes || _data.size() > std::numeric_limits<uint32_t>::max()) {
+            return Status::MemoryLimitExceeded("primary keys take more than {} bytes", max_bytes);
+        }
+        for (size_t i = 0; i < num_read; ++i) {
+            _offsets.push_back(_offsets.back() + index_column->get_data_at(i).size);
+        }
+        remaining -= num_read;
+    }
+    _data.shrink_to_fit();
+
+    _prefixes.reserve(num_rows);
+    if (num_rows > 0) {
+        // the keys are sorted, so the common prefix of the first and the last keys
+        // is shared by all the keys
+        Slice first = key_at(0);
+        Slice last = key_at(num_rows - 1);
+        size_t max_length = std::min(first.size, last.size);
+        while (_common_prefix_length < max_length &&
+               first.data[_common_prefix_length] == last.data[_common_prefix_length]) {
+            ++_common_prefix_length;
+        }
+    }
+    for (uint32_t i = 0; i < num_rows; ++i) {
+        _prefixes.push_back(_prefix_of(key_at(i)));
+    }
+    return Status::OK();
+}
+
+uint64_t PrimaryKeyMemoryIndex::_prefix_of(const Slice& key) const {
+    // the bytes after the common prefix in big endian, padded with zero, so the integers are
+    // in the same order as the keys
+    uint64_t prefix = 0;
+    size_t start = std::min(_common_prefix_length, key.size);
+    size_t end = std::min(start + sizeof(uint64_t), key.size);
+    for (size_t i = start; i < end; ++i) {
+        prefix = (prefix << 8) | static_cast<uint8_t>(key.data[i]);
+    }
+    return prefix << (8 * (sizeof(uint64_t) - (end - start)));
+}
+
+uint32_t PrimaryKeyMemoryIndex::_lower_bound_prefix(uint64_t prefix) const {
+    // interpolation search while the range is large, the keys are distributed uniformly in
+    // most cases. Fall back to binary search after some steps in case they are skewed.
+    size_t low = 0;
+    size_t high = _prefixes.size();
+    for (int step = 0; step < 8 && high - low > 16; ++step) {
+        uint64_t low_value = _prefixes[low];
+        uint64_t high_value = _prefixes[high - 1];
+        if (prefix <= low_value) {
+            return low;
+        }
+        if (prefix > high_value) {
+            return high;
+        }
+        size_t mid = low + static_cast<size_t>(static_cast<long double>(prefix - low_value) /
+                                               (high_value - low_value) * (high - 1 - low));
+        mid = std::min(mid, high - 1);
+        if (_prefixes[mid] < prefix) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return std::lower_bound(_prefixes.begin() + low, _prefixes.begin() + high, prefix) -
+           _prefixes.begin();
+}
+
+uint32_t PrimaryKeyMemoryIndex::seek_at_or_after(const Slice& key, bool* exact_match) const {
+    *exact_match = false;
+    uint32_t num_rows = _prefixes.size();
+    if (num_rows == 0) {
+        return 0;
+    }
+    // compare with the common prefix first
+    Slice first = key_at(0);
+    size_t compare_length = std::min(_common_prefix_length, key.size);
+    int res = memcmp(key.data, first.data, compare_length);
+    if (res < 0 || (res == 0 && key.size < _common_prefix_length)) {
+        return 0;
+    }
+    if (res > 0) {
+        return num_rows;
+    }
+
+    uint64_t prefix = _prefix_of(key);
+    uint32_t low = _lower_bound_prefix(prefix);
+    uint32_t high = std::upper_bound(_prefixes.begin() + low, _prefixes.end(), prefix) -
+                    _prefixes.begin();
+    // only the keys with the same prefix need full comparison
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (key_at(mid).compare(key) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    *exact_match = low < num_rows && key_at(low).compare(key) == 0;
+    return low;
+}
+
 } // namespace doris
@@ -114,4 +114,42 @@ private:
     std::unique_ptr<segment_v2::BloomFilter> _bf;
 };
 
+// All the keys of a primary key index in memory, for the segments of the hot tablets.
+//
+// The common prefix of all the keys is stripped, and the following 8 bytes of each key are
+// kept as a big endian integer, so most of the keys are located by an interpolation search on
+// the integers, and only the keys sharing the same 8 bytes are compared in full.
+class PrimaryKeyMemoryIndex {
+public:
+    // Read all the keys of the index. Fails with MEM_LIMIT_EXCEEDED if they take more than
+    // max_bytes, the built index is unusable then.
+    Status build(const PrimaryKeyIndexReader& reader, int64_t max_bytes);
+
+    // Return the ordinal of the first key at or after the key, or num_rows() if there's no such
+    // key. exact_match is set if the key at the ordinal equals to the key.
+    uint32_t seek_at_or_after(const Slice& key, bool* exact_match) const;
+
+    Slice key_at(uint32_t ordinal) const {
+        DCHECK_LT(ordinal, num_rows());
+        return Slice(_data.data() + _offsets[ordinal], _offsets[ordinal + 1] - _offsets[ordinal]);
+    }
+
+    uint32_t num_rows() const { return _prefixes.size(); }
+
+    int64_t memory_size() const {
+        return _data.capacity() + _offsets.capacity() * sizeof(uint32_t) +
+               _prefixes.capacity() * sizeof(uint64_t);
+    }
+
+private:
+    uint64_t _prefix_of(const Slice& key) const;
+    uint32_t _lower_bound_prefix(uint64_t prefix) const;
+
+    std::string _data;
+    // the key of ordinal i is _data[_offsets[i], _offsets[i + 1])
+    std::vector<uint32_t> _offsets;
+    std::vector<uint64_t> _prefixes;
+    size_t _common_prefix_length = 0;
+};
+
 } // namespace doris
@@ -216,6 +216,7 @@ Status TabletReader::_capture_rs_readers(const ReaderParams& read_params) {
     _reader_context.delete_handler = &_delete_handler;
     _reader_context.stats = &_stats;
     _reader_context.use_page_cache = read_params.use_page_cache;
+    _reader_context.fill_page_cache = read_params.fill_page_cache;
     _reader_context.sequence_id_idx = _sequence_col_idx;
     _reader_context.is_unique = tablet()->keys_type() == UNIQUE_KEYS;
     _reader_context.merged_rows = &_merged_rows;
@@ -226,6 +227,7 @@ Status TabletReader::_capture_rs_readers(const ReaderParams& read_params) {
     _reader_context.remaining_vconjunct_root = read_params.remaining_vconjunct_root;
     _reader_context.common_vexpr_ctxs_pushdown = read_params.common_vexpr_ctxs_pushdown;
     _reader_context.output_columns = &read_params.output_columns;
+    _reader_context.offsets_only_columns = &read_params.offsets_only_columns;
 
     return Status::OK();
 }
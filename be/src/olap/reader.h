@@ -84,6 +84,8 @@ public:
         // for compaction, schema_change, check_sum: we don't use page cache
         // for query and config::disable_storage_page_cache is false, we use page cache
         bool use_page_cache = false;
+        // if false, pages are looked up in page cache, but not inserted into it
+        bool fill_page_cache = true;
         Version version = Version(-1, 0);
 
         std::vector<OlapTuple> start_key;
@@ -112,6 +114,8 @@ public:
         std::vector<uint32_t> return_columns;
         // output_columns only contain columns in OrderByExprs and outputExprs
         std::set<int32_t> output_columns;
+        // the array and map columns of which only the sizes are used, see ColumnIterator
+        std::set<int32_t> offsets_only_columns;
         RuntimeProfile* profile = nullptr;
         RuntimeState* runtime_state = nullptr;
 
@@ -25,6 +25,7 @@
 #include "common/status.h"
 #include "gutil/strings/substitute.h"
 #include "io/cache/file_cache_manager.h"
+#include "io/fs/file_writer.h"
 #include "io/fs/fs_utils.h"
 #include "io/fs/s3_file_system.h"
 #include "olap/olap_define.h"
@@ -33,6 +34,7 @@
 #include "olap/rowset/segment_v2/inverted_index_desc.h"
 #include "olap/tablet_schema.h"
 #include "olap/utils.h"
+#include "util/bandwidth_limiter.h"
 #include "util/doris_metrics.h"
 
 namespace doris {
@@ -40,6 +42,9 @@ using namespace ErrorCode;
 
 using io::FileCacheManager;
 
+// limits the total upload speed of all the cooldown tasks
+static BandwidthLimiter s_cooldown_bandwidth_limiter;
+
 std::string BetaRowset::segment_file_path(int segment_id) {
 #ifdef BE_TEST
     if (!config::file_cache_type.empty()) {
@@ -81,6 +86,17 @@ std::string BetaRowset::remote_segment_path(int64_t tablet_id, const std::string
     return fmt::format("{}/{}_{}.dat", remote_tablet_path(tablet_id), rowset_id, segment_id);
 }
 
+std::string BetaRowset::packed_segments_path() {
+    DCHECK(!is_local());
+    return remote_packed_segments_path(_rowset_meta->tablet_id(), rowset_id().to_string());
+}
+
+std::string BetaRowset::remote_packed_segments_path(int64_t tablet_id,
+                                                    const std::string& rowset_id) {
+    // data/{tablet_id}/{rowset_id}_packed.dat
+    return fmt::format("{}/{}_packed.dat", remote_tablet_path(tablet_id), rowset_id);
+}
+
 std::string BetaRowset::local_segment_path_segcompacted(const std::string& tablet_path,
                                                         const RowsetId& rowset_id, int64_t begin,
                                                         int64_t end) {
@@ -116,6 +132,10 @@ Status BetaRowset::get_segments_size(std::vector<size_t>* segments_size) {
         return Status::Error<INIT_FAILED>();
     }
     for (int seg_id = 0; seg_id < num_segments(); ++seg_id) {
+        if (_rowset_meta->is_segments_packed()) {
+            segments_size->push_back(_rowset_meta->packed_segment(seg_id).size());
+            continue;
+        }
         auto seg_path = segment_file_path(seg_id);
         int64_t file_size;
         RETURN_IF_ERROR(fs->file_size(seg_path, &file_size));
@@ -136,17 +156,11 @@ Status BetaRowset::load_segments(int64_t seg_id_begin, int64_t seg_id_end,
     int64_t seg_id = seg_id_begin;
     while (seg_id < seg_id_end) {
         DCHECK(seg_id >= 0);
-        auto seg_path = segment_file_path(seg_id);
         std::shared_ptr<segment_v2::Segment> segment;
-        io::SegmentCachePathPolicy cache_policy;
-        cache_policy.set_cache_path(segment_cache_path(seg_id));
-        io::FileReaderOptions reader_options(io::cache_type_from_string(config::file_cache_type),
-                                             cache_policy);
-        auto s = segment_v2::Segment::open(fs, seg_path, seg_id, rowset_id(), _schema,
-                                           reader_options, &segment);
+        auto s = _open_segment(seg_id, &segment);
         if (!s.ok()) {
-            LOG(WARNING) << "failed to open segment. " << seg_path << " under rowset "
-                         << unique_id() << " : " << s.to_string();
+            LOG(WARNING) << "failed to open segment. " << segment_file_path(seg_id)
+                         << " under rowset " << unique_id() << " : " << s.to_string();
             return s;
         }
         segments->push_back(std::move(segment));
@@ -155,6 +169,22 @@ Status BetaRowset::load_segments(int64_t seg_id_begin, int64_t seg_id_end,
     return Status::OK();
 }
 
+Status BetaRowset::_open_segment(int64_t seg_id, std::shared_ptr<segment_v2::Segment>* segment) {
+    io::SegmentCachePathPolicy cache_policy;
+    cache_policy.set_cache_path(segment_cache_path(seg_id));
+    io::FileReaderOptions reader_options(io::cache_type_from_string(config::file_cache_type),
+                                         cache_policy);
+    if (!_rowset_meta->is_segments_packed()) {
+        return segment_v2::Segment::open(_rowset_meta->fs(), segment_file_path(seg_id), seg_id,
+                                         rowset_id(), _schema, reader_options, segment);
+    }
+    const PackedSegmentPB& packed_segment = _rowset_meta->packed_segment(seg_id);
+    reader_options.file_offset = packed_segment.offset();
+    reader_options.file_size = packed_segment.size();
+    return segment_v2::Segment::open(_rowset_meta->fs(), packed_segments_path(), seg_id,
+                                     rowset_id(), _schema, reader_options, segment);
+}
+
 Status BetaRowset::create_reader(RowsetReaderSharedPtr* result) {
     // NOTE: We use std::static_pointer_cast for performance
     result->reset(new BetaRowsetReader(std::static_pointer_cast<BetaRowset>(shared_from_this())));
@@ -172,14 +202,24 @@ Status BetaRowset::remove() {
     }
     bool success = true;
     Status st;
-    for (int i = 0; i < num_segments(); ++i) {
-        auto seg_path = segment_file_path(i);
-        LOG(INFO) << "deleting " << seg_path;
-        st = fs->delete_file(seg_path);
+    if (_rowset_meta->is_segments_packed()) {
+        LOG(INFO) << "deleting " << packed_segments_path();
+        st = fs->delete_file(packed_segments_path());
         if (!st.ok()) {
             LOG(WARNING) << st.to_string();
             success = false;
         }
+    }
+    for (int i = 0; i < num_segments(); ++i) {
+        auto seg_path = segment_file_path(i);
+        if (!_rowset_meta->is_segments_packed()) {
+            LOG(INFO) << "deleting " << seg_path;
+            st = fs->delete_file(seg_path);
+            if (!st.ok()) {
+                LOG(WARNING) << st.to_string();
+                success = false;
+            }
+        }
         for (auto& column : _schema->columns()) {
             const TabletIndex* index_meta = _schema->get_inverted_index(column.unique_id());
             if (index_meta) {
@@ -246,6 +286,13 @@ Status BetaRowset::link_files_to(const std::string& dir, RowsetId new_rowset_id,
                 std::string inverted_index_dst_file_path =
                         InvertedIndexDescriptor::get_index_file_name(dst_path,
                                                                      index_meta->index_id());
+                // the fulltext indexes of a loaded rowset may be built later by the compaction,
+                // see enable_deferred_fulltext_index_build
+                bool index_exists = false;
+                RETURN_IF_ERROR(local_fs->exists(inverted_index_src_file_path, &index_exists));
+                if (!index_exists) {
+                    continue;
+                }
 
                 if (!local_fs->link_file(inverted_index_src_file_path, inverted_index_dst_file_path)
                              .ok()) {
@@ -286,6 +333,12 @@ Status BetaRowset::copy_files_to(const std::string& dir, const RowsetId& new_row
                 std::string inverted_index_dst_file_path =
                         InvertedIndexDescriptor::get_index_file_name(dst_path,
                                                                      index_meta->index_id());
+                // the index may be not built yet, as in link_files_to()
+                RETURN_IF_ERROR(io::global_local_filesystem()->exists(inverted_index_src_file_path,
+                                                                      &exists));
+                if (!exists) {
+                    continue;
+                }
                 RETURN_IF_ERROR(io::global_local_filesystem()->copy_dirs(
                         inverted_index_src_file_path, inverted_index_dst_file_path));
                 LOG(INFO) << "success to copy file. from=" << inverted_index_src_file_path << ", "
@@ -296,7 +349,8 @@ Status BetaRowset::copy_files_to(const std::string& dir, const RowsetId& new_row
     return Status::OK();
 }
 
-Status BetaRowset::upload_to(io::RemoteFileSystem* dest_fs, const RowsetId& new_rowset_id) {
+Status BetaRowset::upload_to(io::RemoteFileSystem* dest_fs, const RowsetId& new_rowset_id,
+                             std::vector<PackedSegmentPB>* packed_segments) {
     DCHECK(is_local());
     if (num_segments() < 1) {
         return Status::OK();
@@ -309,8 +363,10 @@ Status BetaRowset::upload_to(io::RemoteFileSystem* dest_fs, const RowsetId& new_
         // Note: Here we use relative path for remote.
         auto remote_seg_path = remote_segment_path(_rowset_meta->tablet_id(), new_rowset_id, i);
         auto local_seg_path = segment_file_path(i);
-        dest_paths.push_back(remote_seg_path);
-        local_paths.push_back(local_seg_path);
+        if (packed_segments == nullptr) {
+            dest_paths.push_back(remote_seg_path);
+            local_paths.push_back(local_seg_path);
+        }
         for (auto& column : _schema->columns()) {
             // if (column.has_inverted_index()) {
             const TabletIndex* index_meta = _schema->get_inverted_index(column.unique_id());
@@ -321,12 +377,43 @@ Status BetaRowset::upload_to(io::RemoteFileSystem* dest_fs, const RowsetId& new_
                 std::string local_inverted_index_file =
                         InvertedIndexDescriptor::get_index_file_name(local_seg_path,
                                                                      index_meta->index_id());
+                // the index may be not built yet, as in link_files_to()
+                bool index_exists = false;
+                RETURN_IF_ERROR(io::global_local_filesystem()->exists(local_inverted_index_file,
+                                                                      &index_exists));
+                if (!index_exists) {
+                    continue;
+                }
                 dest_paths.push_back(remote_inverted_index_file);
                 local_paths.push_back(local_inverted_index_file);
             }
         }
     }
-    auto st = dest_fs->batch_upload(local_paths, dest_paths);
+    Status st;
+    if (packed_segments != nullptr) {
+        io::FileWriterPtr file_writer;
+        RETURN_IF_ERROR(dest_fs->create_file(
+                remote_packed_segments_path(_rowset_meta->tablet_id(), new_rowset_id.to_string()),
+                &file_writer));
+        st = _pack_segments(file_writer.get(), packed_segments);
+        if (st.ok()) {
+            st = file_writer->close();
+        } else {
+            WARN_IF_ERROR(file_writer->abort(), "failed to abort the packed segments");
+        }
+    }
+    if (st.ok() && !local_paths.empty()) {
+        if (config::cooldown_max_total_upload_speed_kbps > 0) {
+            // the files are uploaded at once, so their bytes are taken from the bucket ahead
+            for (auto& local_path : local_paths) {
+                int64_t file_size = 0;
+                RETURN_IF_ERROR(io::global_local_filesystem()->file_size(local_path, &file_size));
+                s_cooldown_bandwidth_limiter.acquire(
+                        file_size, config::cooldown_max_total_upload_speed_kbps * 1024L);
+            }
+        }
+        st = dest_fs->batch_upload(local_paths, dest_paths);
+    }
     if (st.ok()) {
         DorisMetrics::instance()->upload_rowset_count->increment(1);
         DorisMetrics::instance()->upload_total_byte->increment(data_disk_size());
@@ -336,6 +423,36 @@ Status BetaRowset::upload_to(io::RemoteFileSystem* dest_fs, const RowsetId& new_
     return st;
 }
 
+Status BetaRowset::_pack_segments(io::FileWriter* file_writer,
+                                  std::vector<PackedSegmentPB>* packed_segments) {
+    constexpr size_t BUFFER_SIZE = 1024 * 1024;
+    auto buffer = std::make_unique<char[]>(BUFFER_SIZE);
+    for (int i = 0; i < num_segments(); ++i) {
+        io::FileReaderSPtr file_reader;
+        RETURN_IF_ERROR(
+                io::global_local_filesystem()->open_file(segment_file_path(i), &file_reader));
+        auto& packed_segment = packed_segments->emplace_back();
+        packed_segment.set_offset(file_writer->bytes_appended());
+        packed_segment.set_size(file_reader->size());
+        size_t offset = 0;
+        while (offset < file_reader->size()) {
+            size_t bytes_read = 0;
+            RETURN_IF_ERROR(file_reader->read_at(
+                    offset, {buffer.get(), std::min(BUFFER_SIZE, file_reader->size() - offset)},
+                    &bytes_read));
+            if (bytes_read == 0) {
+                return Status::IOError("unexpected end of file {}",
+                                       file_reader->path().native());
+            }
+            s_cooldown_bandwidth_limiter.acquire(
+                    bytes_read, config::cooldown_max_total_upload_speed_kbps * 1024L);
+            RETURN_IF_ERROR(file_writer->append({buffer.get(), bytes_read}));
+            offset += bytes_read;
+        }
+    }
+    return Status::OK();
+}
+
 bool BetaRowset::check_path(const std::string& path) {
     for (int i = 0; i < num_segments(); ++i) {
         auto seg_path = segment_file_path(i);
@@ -348,7 +465,12 @@ bool BetaRowset::check_path(const std::string& path) {
 
 bool BetaRowset::check_file_exist() {
     for (int i = 0; i < num_segments(); ++i) {
-        auto seg_path = segment_file_path(i);
+        // the packed segments are checked only once
+        if (_rowset_meta->is_segments_packed() && i > 0) {
+            break;
+        }
+        auto seg_path =
+                _rowset_meta->is_segments_packed() ? packed_segments_path() : segment_file_path(i);
         auto fs = _rowset_meta->fs();
         if (!fs) {
             return false;
@@ -369,16 +491,10 @@ bool BetaRowset::check_current_rowset_segment() {
         return false;
     }
     for (int seg_id = 0; seg_id < num_segments(); ++seg_id) {
-        auto seg_path = segment_file_path(seg_id);
         std::shared_ptr<segment_v2::Segment> segment;
-        io::SegmentCachePathPolicy cache_policy;
-        cache_policy.set_cache_path(segment_cache_path(seg_id));
-        io::FileReaderOptions reader_options(io::cache_type_from_string(config::file_cache_type),
-                                             cache_policy);
-        auto s = segment_v2::Segment::open(fs, seg_path, seg_id, rowset_id(), _schema,
-                                           reader_options, &segment);
+        auto s = _open_segment(seg_id, &segment);
         if (!s.ok()) {
-            LOG(WARNING) << "segment can not be opened. file=" << seg_path;
+            LOG(WARNING) << "segment can not be opened. file=" << segment_file_path(seg_id);
             return false;
         }
     }
@@ -61,6 +61,11 @@ public:
     static std::string remote_segment_path(int64_t tablet_id, const std::string& rowset_id,
                                            int segment_id);
 
+    // the remote object the segments are packed into, see RowsetMeta::is_segments_packed()
+    std::string packed_segments_path();
+
+    static std::string remote_packed_segments_path(int64_t tablet_id, const std::string& rowset_id);
+
     Status remove() override;
 
     Status link_files_to(const std::string& dir, RowsetId new_rowset_id,
@@ -68,7 +73,8 @@ public:
 
     Status copy_files_to(const std::string& dir, const RowsetId& new_rowset_id) override;
 
-    Status upload_to(io::RemoteFileSystem* dest_fs, const RowsetId& new_rowset_id) override;
+    Status upload_to(io::RemoteFileSystem* dest_fs, const RowsetId& new_rowset_id,
+                     std::vector<PackedSegmentPB>* packed_segments) override;
 
     // only applicable to alpha rowset, no op here
     Status remove_old_files(std::vector<std::string>* files_to_remove) override {
@@ -100,6 +106,12 @@ protected:
     bool check_current_rowset_segment() override;
 
 private:
+    Status _open_segment(int64_t seg_id, std::shared_ptr<segment_v2::Segment>* segment);
+
+    // appends the segment files to `file_writer`, and their ranges to `packed_segments`
+    Status _pack_segments(io::FileWriter* file_writer,
+                          std::vector<PackedSegmentPB>* packed_segments);
+
     friend class RowsetFactory;
     friend class BetaRowsetReader;
 };
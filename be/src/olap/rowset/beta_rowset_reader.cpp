@@ -163,6 +163,7 @@ Status BetaRowsetReader::get_segment_iterators(RowsetReaderContext* read_context
         }
     }
     _read_options.use_page_cache = read_context->use_page_cache;
+    _read_options.fill_page_cache = read_context->fill_page_cache;
     _read_options.tablet_schema = read_context->tablet_schema;
     _read_options.record_rowids = read_context->record_rowids;
     _read_options.use_topn_opt = read_context->use_topn_opt;
@@ -171,6 +172,7 @@ Status BetaRowsetReader::get_segment_iterators(RowsetReaderContext* read_context
     _read_options.io_ctx.reader_type = read_context->reader_type;
     _read_options.runtime_state = read_context->runtime_state;
     _read_options.output_columns = read_context->output_columns;
+    _read_options.offsets_only_columns = read_context->offsets_only_columns;
 
     // load segments
     // use cache is true when do vertica compaction
@@ -17,8 +17,11 @@
 
 #include "olap/rowset/beta_rowset_writer.h"
 
+#include <condition_variable>
 #include <ctime> // time
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <sstream>
 
 #include "common/config.h"
@@ -26,6 +29,7 @@
 #include "gutil/strings/substitute.h"
 #include "io/fs/file_writer.h"
 #include "olap/memtable.h"
+#include "olap/memtable_flush_executor.h"
 #include "olap/merger.h"
 #include "olap/olap_define.h"
 #include "olap/row_cursor.h" // RowCursor
@@ -36,8 +40,11 @@
 #include "olap/rowset/segment_v2/segment_writer.h"
 #include "olap/storage_engine.h"
 #include "runtime/exec_env.h"
+#include "runtime/load_statistics.h"
 #include "runtime/memory/mem_tracker_limiter.h"
+#include "runtime/thread_context.h"
 #include "segcompaction.h"
+#include "util/runtime_profile.h"
 #include "vec/common/schema_util.h" // LocalSchemaChangeRecorder
 #include "vec/jsonb/serialize.h"
 
@@ -154,6 +161,10 @@ Status BetaRowsetWriter::_load_noncompacted_segments(
  *     single small
  *  3. if the consecutive smalls end up with small, compact the smalls if the
  *     length is beyond (config::segcompaction_threshold_segment_num / 2)
+ *  4. stop at the smalls of config::segcompaction_task_max_bytes, as if ended
+ *     up with a big
+ *  5. skip the smalls whose key ranges are in order without overlap, merging
+ *     them saves nothing on read, and keeps the rowset nonoverlapping
  */
 Status BetaRowsetWriter::_find_longest_consecutive_small_segment(
         SegCompactionCandidatesSharedPtr segments) {
@@ -173,6 +184,8 @@ Status BetaRowsetWriter::_find_longest_consecutive_small_segment(
     bool is_terminated_by_big = false;
     bool let_big_terminate = false;
     size_t small_threshold = config::segcompaction_small_threshold;
+    int64_t candidate_bytes = 0;
+    std::vector<KeyBoundsPB> candidate_key_bounds;
     for (int64_t i = 0; i < all_segments.size(); ++i) {
         segment_v2::SegmentSharedPtr seg = all_segments[i];
         if (seg->num_rows() > small_threshold) {
@@ -185,6 +198,18 @@ Status BetaRowsetWriter::_find_longest_consecutive_small_segment(
         } else {
             let_big_terminate = true; // break if find a big after small
             segments->push_back(seg);
+            {
+                std::lock_guard<std::mutex> lock(_segid_statistics_map_mutex);
+                auto it = _segid_statistics_map.find(seg->id());
+                if (it != _segid_statistics_map.end()) {
+                    candidate_bytes += it->second.data_size;
+                    candidate_key_bounds.push_back(it->second.key_bounds);
+                }
+            }
+            if (candidate_bytes >= config::segcompaction_task_max_bytes) {
+                is_terminated_by_big = true;
+                break;
+            }
         }
     }
     size_t s = segments->size();
@@ -200,6 +225,14 @@ Status BetaRowsetWriter::_find_longest_consecutive_small_segment(
         segments->clear();
         return Status::OK();
     }
+    if (candidate_key_bounds.size() == s && !_is_segment_overlapping(candidate_key_bounds)) {
+        VLOG_DEBUG << "candidate segments are not overlapping";
+        for (size_t i = 0; i < s; ++i) {
+            RETURN_NOT_OK(_rename_compacted_segment_plain(_segcompacted_point++));
+        }
+        segments->clear();
+        return Status::OK();
+    }
     if (VLOG_DEBUG_IS_ON) {
         vlog_buffer.clear();
         for (auto& segment : (*segments.get())) {
@@ -394,10 +427,15 @@ Status BetaRowsetWriter::_segcompaction_ramaining_if_necessary() {
 
 Status BetaRowsetWriter::_add_block(const vectorized::Block* block,
                                     std::unique_ptr<segment_v2::SegmentWriter>* segment_writer) {
+    return _add_block(block, segment_writer, 0, block->rows());
+}
+
+Status BetaRowsetWriter::_add_block(const vectorized::Block* block,
+                                    std::unique_ptr<segment_v2::SegmentWriter>* segment_writer,
+                                    size_t row_offset, size_t num_rows) {
     size_t block_size_in_bytes = block->bytes();
-    size_t block_row_num = block->rows();
-    size_t row_avg_size_in_bytes = std::max((size_t)1, block_size_in_bytes / block_row_num);
-    size_t row_offset = 0;
+    size_t row_avg_size_in_bytes = std::max((size_t)1, block_size_in_bytes / block->rows());
+    size_t block_row_num = row_offset + num_rows;
 
     do {
         auto max_row_add = (*segment_writer)->max_row_to_add(row_avg_size_in_bytes);
@@ -418,7 +456,7 @@ Status BetaRowsetWriter::_add_block(const vectorized::Block* block,
         row_offset += input_row_num;
     } while (row_offset < block_row_num);
 
-    _raw_num_rows_written += block_row_num;
+    _raw_num_rows_written += num_rows;
     return Status::OK();
 }
 
@@ -455,14 +493,107 @@ Status BetaRowsetWriter::flush_single_memtable(const vectorized::Block* block, i
         return Status::OK();
     }
 
-    std::unique_ptr<segment_v2::SegmentWriter> writer;
-    RETURN_NOT_OK(_create_segment_writer(&writer, block));
-    RETURN_NOT_OK(_add_block(block, &writer));
-    RETURN_NOT_OK(_flush_segment_writer(&writer, flush_size));
+    size_t num_segments = _num_parallel_flush_segments(block);
+    if (num_segments > 1) {
+        RETURN_NOT_OK(_parallel_flush_single_memtable(block, num_segments, flush_size));
+    } else {
+        std::unique_ptr<segment_v2::SegmentWriter> writer;
+        RETURN_NOT_OK(_create_segment_writer(&writer, block));
+        RETURN_NOT_OK(_add_block(block, &writer));
+        RETURN_NOT_OK(_flush_segment_writer(&writer, flush_size));
+    }
     RETURN_NOT_OK(_segcompaction_if_necessary());
     return Status::OK();
 }
 
+size_t BetaRowsetWriter::_num_parallel_flush_segments(const vectorized::Block* block) {
+    // the writers of dynamic schema fetch and record the new columns, do not run them together
+    if (config::memtable_flush_segment_parallelism <= 1 ||
+        _context.tablet_schema->is_dynamic_schema() || StorageEngine::instance() == nullptr ||
+        StorageEngine::instance()->memtable_flush_executor() == nullptr ||
+        StorageEngine::instance()->memtable_flush_executor()->flush_pool() == nullptr) {
+        return 1;
+    }
+    size_t rows = block->rows();
+    size_t min_rows_per_segment = std::max<int64_t>(1, config::memtable_flush_min_rows_per_segment);
+    size_t num_segments = std::min<size_t>(config::memtable_flush_segment_parallelism,
+                                           rows / min_rows_per_segment);
+    if (num_segments <= 1) {
+        return 1;
+    }
+    // every segment should hold all of its rows, so that the ids of the segments, which are
+    // allocated before they are written, are in the order of keys
+    size_t max_rows_per_segment = std::max<uint32_t>(1, _context.max_rows_per_segment);
+    num_segments = std::max(num_segments,
+                            (rows + max_rows_per_segment - 1) / max_rows_per_segment);
+    num_segments = std::max(num_segments, block->bytes() / (segment_v2::MAX_SEGMENT_SIZE / 2) + 1);
+    return num_segments;
+}
+
+Status BetaRowsetWriter::_parallel_flush_single_memtable(const vectorized::Block* block,
+                                                         size_t num_segments, int64* flush_size) {
+    std::vector<std::unique_ptr<segment_v2::SegmentWriter>> writers(num_segments);
+    for (auto& writer : writers) {
+        RETURN_NOT_OK(_create_segment_writer(&writer, block));
+    }
+
+    struct FlushContext {
+        std::atomic<size_t> next_segment = 0;
+        std::mutex lock;
+        std::condition_variable finished_cond;
+        size_t num_finished = 0;
+        Status status;
+    };
+    auto ctx = std::make_shared<FlushContext>();
+    std::vector<int64_t> segment_flush_sizes(num_segments, 0);
+    size_t rows = block->rows();
+    // A task only touches the segments it takes from ctx, so the task started after all the
+    // segments are taken returns without touching the other captures.
+    auto flush_segments = [this, ctx, block, rows, num_segments, &writers,
+                           &segment_flush_sizes]() {
+        size_t i;
+        while ((i = ctx->next_segment.fetch_add(1)) < num_segments) {
+            size_t begin = rows * i / num_segments;
+            size_t end = rows * (i + 1) / num_segments;
+            Status st = _add_block(block, &writers[i], begin, end - begin);
+            if (st.ok()) {
+                st = _flush_segment_writer(&writers[i], &segment_flush_sizes[i]);
+            }
+            std::lock_guard<std::mutex> l(ctx->lock);
+            if (!st.ok() && ctx->status.ok()) {
+                ctx->status = st;
+            }
+            if (++ctx->num_finished == num_segments) {
+                ctx->finished_cond.notify_all();
+            }
+        }
+    };
+
+    auto mem_tracker = thread_context()->thread_mem_tracker_mgr->limiter_mem_tracker();
+    ThreadPool* flush_pool = StorageEngine::instance()->memtable_flush_executor()->flush_pool();
+    size_t num_tasks = std::min<size_t>(num_segments, config::memtable_flush_segment_parallelism);
+    for (size_t i = 1; i < num_tasks; ++i) {
+        auto st = flush_pool->submit_func([flush_segments, mem_tracker]() {
+            SCOPED_ATTACH_TASK(mem_tracker);
+            flush_segments();
+        });
+        if (!st.ok()) {
+            break;
+        }
+    }
+    // This thread writes the segments not taken by the pool, so it never waits for a task
+    // queued behind itself even if all the threads of the pool are flushing.
+    flush_segments();
+    std::unique_lock<std::mutex> l(ctx->lock);
+    ctx->finished_cond.wait(l, [&ctx, num_segments] { return ctx->num_finished == num_segments; });
+    RETURN_NOT_OK(ctx->status);
+    if (flush_size) {
+        *flush_size = std::accumulate(segment_flush_sizes.begin(), segment_flush_sizes.end(),
+                                      int64_t(0));
+    }
+    return Status::OK();
+}
+
 Status BetaRowsetWriter::wait_flying_segcompaction() {
     std::unique_lock<std::mutex> l(_is_doing_segcompaction_lock);
     uint64_t begin_wait = GetCurrentTimeMicros();
@@ -480,6 +611,17 @@ Status BetaRowsetWriter::wait_flying_segcompaction() {
     return Status::OK();
 }
 
+void BetaRowsetWriter::collect_load_statistics(LoadStatistics* statistics) {
+    {
+        std::lock_guard<std::mutex> lock(_segid_statistics_map_mutex);
+        for (const auto& [name, ns] : _column_encode_ns) {
+            statistics->column_encode_ns[name] += ns;
+        }
+    }
+    statistics->segment_close_ns += _segment_close_ns;
+    statistics->segcompaction_ns += _segcompaction_ns;
+}
+
 RowsetSharedPtr BetaRowsetWriter::manual_build(const RowsetMetaSharedPtr& spec_rowset_meta) {
     if (_rowset_meta->newest_write_timestamp() == -1) {
         _rowset_meta->set_newest_write_timestamp(UnixSeconds());
@@ -499,12 +641,15 @@ RowsetSharedPtr BetaRowsetWriter::manual_build(const RowsetMetaSharedPtr& spec_r
 
 RowsetSharedPtr BetaRowsetWriter::build() {
     // TODO(lingbin): move to more better place, or in a CreateBlockBatch?
-    for (auto& file_writer : _file_writers) {
-        Status status = file_writer->close();
-        if (!status.ok()) {
-            LOG(WARNING) << "failed to close file writer, path=" << file_writer->path()
-                         << " res=" << status;
-            return nullptr;
+    {
+        SCOPED_RAW_TIMER(&_segment_close_ns);
+        for (auto& file_writer : _file_writers) {
+            Status status = file_writer->close();
+            if (!status.ok()) {
+                LOG(WARNING) << "failed to close file writer, path=" << file_writer->path()
+                             << " res=" << status;
+                return nullptr;
+            }
         }
     }
     Status status;
@@ -525,6 +670,7 @@ RowsetSharedPtr BetaRowsetWriter::build() {
     }
 
     if (_segcompaction_worker.get_file_writer()) {
+        SCOPED_RAW_TIMER(&_segment_close_ns);
         _segcompaction_worker.get_file_writer()->close();
     }
     // When building a rowset, we must ensure that the current _segment_writer has been
@@ -767,8 +913,12 @@ Status BetaRowsetWriter::_flush_segment_writer(std::unique_ptr<segment_v2::Segme
         std::lock_guard<std::mutex> lock(_segid_statistics_map_mutex);
         CHECK_EQ(_segid_statistics_map.find(segid) == _segid_statistics_map.end(), true);
         _segid_statistics_map.emplace(segid, segstat);
-        _segment_num_rows.resize(_num_segment);
-        _segment_num_rows[_num_segment - 1] = row_num;
+        // the segments of a memtable may be flushed out of order
+        if (_segment_num_rows.size() <= segid) {
+            _segment_num_rows.resize(segid + 1);
+        }
+        _segment_num_rows[segid] = row_num;
+        (*writer)->collect_column_encode_time(&_column_encode_ns);
     }
     VLOG_DEBUG << "_segid_statistics_map add new record. segid:" << segid << " row_num:" << row_num
                << " data_size:" << segment_size << " index_size:" << index_size;
@@ -93,6 +93,8 @@ public:
 
     uint64_t get_num_mow_keys() { return _num_mow_keys; }
 
+    void collect_load_statistics(LoadStatistics* statistics) override;
+
     SegcompactionWorker& get_segcompaction_worker() { return _segcompaction_worker; }
 
     Status flush_segment_writer_for_segcompaction(
@@ -106,6 +108,15 @@ public:
 private:
     Status _add_block(const vectorized::Block* block,
                       std::unique_ptr<segment_v2::SegmentWriter>* writer);
+    Status _add_block(const vectorized::Block* block,
+                      std::unique_ptr<segment_v2::SegmentWriter>* writer, size_t row_offset,
+                      size_t num_rows);
+    // The sorted block of a large memtable is split into segments of consecutive rows, which
+    // are encoded concurrently in the memtable flush thread pool. Returns 1 if the block
+    // should be written by this thread only.
+    size_t _num_parallel_flush_segments(const vectorized::Block* block);
+    Status _parallel_flush_single_memtable(const vectorized::Block* block, size_t num_segments,
+                                           int64* flush_size);
 
     Status _do_create_segment_writer(std::unique_ptr<segment_v2::SegmentWriter>* writer,
                                      bool is_segcompaction, int64_t begin, int64_t end,
@@ -173,6 +184,12 @@ protected:
     };
     std::mutex _segid_statistics_map_mutex;
     std::map<uint32_t, Statistics> _segid_statistics_map;
+    // column name -> the encode time of the flushed segments, protected by the mutex above
+    std::map<std::string, int64_t> _column_encode_ns;
+
+    // the time of closing the segment files and the segcompactions
+    int64_t _segment_close_ns = 0;
+    std::atomic<int64_t> _segcompaction_ns {0};
 
     // used for check correctness of unique key mow keys.
     std::atomic<uint64_t> _num_mow_keys;
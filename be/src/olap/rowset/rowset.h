@@ -193,7 +193,11 @@ public:
     // copy all files to `dir`
     virtual Status copy_files_to(const std::string& dir, const RowsetId& new_rowset_id) = 0;
 
-    virtual Status upload_to(io::RemoteFileSystem* dest_fs, const RowsetId& new_rowset_id) {
+    // upload all files to `dest_fs` as the rowset `new_rowset_id`. If `packed_segments` is not
+    // nullptr, the segment files are packed into one object, and their ranges in it are appended
+    // to `packed_segments`.
+    virtual Status upload_to(io::RemoteFileSystem* dest_fs, const RowsetId& new_rowset_id,
+                             std::vector<PackedSegmentPB>* packed_segments) {
         return Status::OK();
     }
 
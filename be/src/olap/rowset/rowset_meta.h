@@ -259,6 +259,20 @@ public:
 
     void set_num_segments(int64_t num_segments) { _rowset_meta_pb.set_num_segments(num_segments); }
 
+    // whether the segments are packed into one remote object, see RowsetMetaPB.packed_segments
+    bool is_segments_packed() const { return _rowset_meta_pb.packed_segments_size() > 0; }
+
+    const PackedSegmentPB& packed_segment(int64_t segment_id) const {
+        return _rowset_meta_pb.packed_segments(segment_id);
+    }
+
+    void set_packed_segments(const std::vector<PackedSegmentPB>& packed_segments) {
+        _rowset_meta_pb.clear_packed_segments();
+        for (auto& packed_segment : packed_segments) {
+            *_rowset_meta_pb.add_packed_segments() = packed_segment;
+        }
+    }
+
     void to_rowset_pb(RowsetMetaPB* rs_meta_pb) const {
         *rs_meta_pb = _rowset_meta_pb;
         if (_schema) {
@@ -95,6 +95,22 @@ Status RowsetMetaManager::save(OlapMeta* meta, TabletUid tablet_uid, const Rowse
     return status;
 }
 
+Status RowsetMetaManager::save(
+        OlapMeta* meta,
+        const std::vector<std::pair<TabletUid, RowsetMetaSharedPtr>>& rowset_metas) {
+    std::vector<std::pair<std::string, std::string>> entries;
+    entries.reserve(rowset_metas.size());
+    for (auto& [tablet_uid, rowset_meta] : rowset_metas) {
+        auto& [key, value] = entries.emplace_back();
+        key = ROWSET_PREFIX + tablet_uid.to_string() + "_" + rowset_meta->rowset_id().to_string();
+        if (!rowset_meta->get_rowset_pb().SerializeToString(&value)) {
+            LOG(WARNING) << "serialize rowset pb failed. rowset id:" << key;
+            return Status::Error<SERIALIZE_PROTOBUF_ERROR>();
+        }
+    }
+    return meta->put(META_COLUMN_FAMILY_INDEX, entries);
+}
+
 Status RowsetMetaManager::remove(OlapMeta* meta, TabletUid tablet_uid, const RowsetId& rowset_id) {
     std::string key = ROWSET_PREFIX + tablet_uid.to_string() + "_" + rowset_id.to_string();
     VLOG_NOTICE << "start to remove rowset, key:" << key;
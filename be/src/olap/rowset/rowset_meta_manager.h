@@ -19,6 +19,8 @@
 #define DORIS_BE_SRC_OLAP_ROWSET_ROWSET_META_MANAGER_H
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "olap/olap_meta.h"
 #include "olap/rowset/rowset_meta.h"
@@ -41,6 +43,10 @@ public:
     static Status save(OlapMeta* meta, TabletUid tablet_uid, const RowsetId& rowset_id,
                        const RowsetMetaPB& rowset_meta_pb);
 
+    // save the rowset metas of the tablets of the uids in one write batch
+    static Status save(OlapMeta* meta,
+                       const std::vector<std::pair<TabletUid, RowsetMetaSharedPtr>>& rowset_metas);
+
     static Status remove(OlapMeta* meta, TabletUid tablet_uid, const RowsetId& rowset_id);
 
     static Status traverse_rowset_metas(
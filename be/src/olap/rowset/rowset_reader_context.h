@@ -67,6 +67,7 @@ struct RowsetReaderContext {
     vectorized::VExpr* remaining_vconjunct_root = nullptr;
     vectorized::VExprContext* common_vexpr_ctxs_pushdown = nullptr;
     bool use_page_cache = false;
+    bool fill_page_cache = true;
     int sequence_id_idx = -1;
     int batch_size = 1024;
     bool is_unique = false;
@@ -79,6 +80,7 @@ struct RowsetReaderContext {
     bool is_vertical_compaction = false;
     bool is_key_column_group = false;
     const std::set<int32_t>* output_columns = nullptr;
+    const std::set<int32_t>* offsets_only_columns = nullptr;
 };
 
 } // namespace doris
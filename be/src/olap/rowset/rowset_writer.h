@@ -28,6 +28,7 @@
 namespace doris {
 
 class MemTable;
+struct LoadStatistics;
 
 class RowsetWriter {
 public:
@@ -43,6 +44,13 @@ public:
                                bool is_key, uint32_t max_rows_per_segment) {
         return Status::Error<ErrorCode::NOT_IMPLEMENTED_ERROR>();
     }
+    // Add the columns of a value column group after the key group is flushed. Different groups
+    // can be added concurrently, the columns of a group are flushed by flush_group_columns().
+    virtual Status add_group_columns(const vectorized::Block* block,
+                                     const std::vector<uint32_t>& col_ids, size_t group_idx,
+                                     uint32_t max_rows_per_segment) {
+        return Status::Error<ErrorCode::NOT_IMPLEMENTED_ERROR>();
+    }
 
     // Precondition: the input `rowset` should have the same type of the rowset we're building
     virtual Status add_rowset(RowsetSharedPtr rowset) = 0;
@@ -56,6 +64,9 @@ public:
     virtual Status flush_columns(bool is_key) {
         return Status::Error<ErrorCode::NOT_IMPLEMENTED_ERROR>();
     }
+    virtual Status flush_group_columns(size_t group_idx) {
+        return Status::Error<ErrorCode::NOT_IMPLEMENTED_ERROR>();
+    }
     virtual Status final_flush() { return Status::Error<ErrorCode::NOT_IMPLEMENTED_ERROR>(); }
 
     virtual Status flush_single_memtable(const vectorized::Block* block, int64_t* flush_size) {
@@ -92,6 +103,9 @@ public:
 
     virtual Status wait_flying_segcompaction() = 0;
 
+    // Adds the time of encoding the columns, closing the files and segcompaction of this writer.
+    virtual void collect_load_statistics(LoadStatistics* statistics) {}
+
 private:
     DISALLOW_COPY_AND_ASSIGN(RowsetWriter);
 };
@@ -39,6 +39,7 @@
 #include "olap/storage_engine.h"
 #include "runtime/exec_env.h"
 #include "runtime/memory/mem_tracker_limiter.h"
+#include "util/stopwatch.hpp"
 #include "vec/common/schema_util.h" // LocalSchemaChangeRecorder
 #include "vec/jsonb/serialize.h"
 
@@ -272,7 +273,10 @@ Status SegcompactionWorker::_do_compact_segments(SegCompactionCandidatesSharedPt
 }
 
 void SegcompactionWorker::compact_segments(SegCompactionCandidatesSharedPtr segments) {
+    MonotonicStopWatch watch;
+    watch.start();
     Status status = _do_compact_segments(segments);
+    _writer->_segcompaction_ns += watch.elapsed_time();
     if (!status.ok()) {
         int16_t errcode = status.code();
         switch (errcode) {
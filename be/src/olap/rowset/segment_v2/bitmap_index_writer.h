@@ -23,6 +23,7 @@
 #include "common/status.h"
 #include "gen_cpp/segment_v2.pb.h"
 #include "gutil/macros.h"
+#include "olap/olap_common.h"
 
 namespace doris {
 
@@ -38,6 +39,9 @@ class BitmapIndexWriter {
 public:
     static Status create(const TypeInfo* type_info, std::unique_ptr<BitmapIndexWriter>* res);
 
+    // Whether create() supports the type.
+    static bool is_supported_type(FieldType type);
+
     BitmapIndexWriter() = default;
     virtual ~BitmapIndexWriter() = default;
 
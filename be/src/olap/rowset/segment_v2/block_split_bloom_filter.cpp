@@ -60,5 +60,26 @@ bool BlockSplitBloomFilter::test_hash(uint64_t hash) const {
     return true;
 }
 
+bool BlockSplitBloomFilter::test_parquet_hash(const uint8_t* bitset, uint32_t num_bytes,
+                                              uint64_t hash) {
+    DCHECK(num_bytes >= BYTES_PER_BLOCK && num_bytes % BYTES_PER_BLOCK == 0);
+    const uint64_t num_blocks = num_bytes / BYTES_PER_BLOCK;
+    const uint32_t bucket_index = static_cast<uint32_t>(((hash >> 32) * num_blocks) >> 32);
+    uint32_t key = static_cast<uint32_t>(hash);
+
+    BlockMask block_mask;
+    _set_masks(key, block_mask);
+
+    for (int i = 0; i < BITS_SET_PER_BLOCK; ++i) {
+        uint32_t word;
+        memcpy(&word, bitset + (BITS_SET_PER_BLOCK * bucket_index + i) * sizeof(uint32_t),
+               sizeof(uint32_t));
+        if (0 == (word & block_mask.item[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
 } // namespace segment_v2
 } // namespace doris
@@ -34,6 +34,11 @@ public:
     bool test_hash(uint64_t hash) const override;
     bool contains(const BloomFilter&) const override { return true; }
 
+    // Test the hash in the bitset of a parquet split block bloom filter. Parquet locates the tiny
+    // Bloom filter block by the multiply-shift of the high 32 bits of the hash instead of the
+    // mask, so the number of blocks doesn't need to be a power of 2.
+    static bool test_parquet_hash(const uint8_t* bitset, uint32_t num_bytes, uint64_t hash);
+
 private:
     // Bytes in a tiny Bloom filter block.
     static constexpr int BYTES_PER_BLOCK = 32;
@@ -49,7 +54,7 @@ private:
     };
 
 private:
-    void _set_masks(uint32_t key, BlockMask& block_mask) const {
+    static void _set_masks(uint32_t key, BlockMask& block_mask) {
         for (int i = 0; i < BITS_SET_PER_BLOCK; ++i) {
             block_mask.item[i] = key * SALT[i];
         }
@@ -18,6 +18,7 @@
 #include "olap/rowset/segment_v2/bloom_filter_index_reader.h"
 
 #include "olap/rowset/segment_v2/bloom_filter.h"
+#include "olap/rowset/segment_v2/ngram_bloom_filter.h"
 #include "olap/types.h"
 #include "vec/data_types/data_type_factory.hpp"
 
@@ -53,6 +54,11 @@ Status BloomFilterIndexIterator::read_bloom_filter(rowid_t ordinal,
     BloomFilter::create(_reader->_bloom_filter_index_meta->algorithm(), bf, value.size);
     RETURN_IF_ERROR((*bf)->init(value.data, value.size,
                                 _reader->_bloom_filter_index_meta->hash_strategy()));
+    const auto* meta = _reader->_bloom_filter_index_meta;
+    if (meta->algorithm() == NGRAM_BLOOM_FILTER && meta->has_gram_size()) {
+        static_cast<NGramBloomFilter*>(bf->get())->set_gram_options(meta->gram_size(),
+                                                                    meta->ignore_case());
+    }
     return Status::OK();
 }
 
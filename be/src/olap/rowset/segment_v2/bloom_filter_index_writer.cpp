@@ -24,6 +24,7 @@
 #include "olap/rowset/segment_v2/common.h"
 #include "olap/rowset/segment_v2/encoding_info.h"
 #include "olap/rowset/segment_v2/indexed_column_writer.h"
+#include "olap/rowset/segment_v2/ngram_bloom_filter.h"
 #include "olap/types.h"
 #include "util/faststring.h"
 #include "util/slice.h"
@@ -169,10 +170,12 @@ private:
 } // namespace
 
 NGramBloomFilterIndexWriterImpl::NGramBloomFilterIndexWriterImpl(
-        const BloomFilterOptions& bf_options, uint8_t gram_size, uint16_t bf_size)
+        const BloomFilterOptions& bf_options, uint8_t gram_size, uint16_t bf_size,
+        bool ignore_case)
         : _bf_options(bf_options),
           _gram_size(gram_size),
           _bf_size(bf_size),
+          _ignore_case(ignore_case),
           _bf_buffer_size(0),
           _token_extractor(gram_size) {
     BloomFilter::create(NGRAM_BLOOM_FILTER, &_bf, bf_size);
@@ -184,6 +187,11 @@ void NGramBloomFilterIndexWriterImpl::add_values(const void* values, size_t coun
         if (src->size < _gram_size) {
             continue;
         }
+        if (_ignore_case) {
+            NGramBloomFilter::to_lower_ascii(src->data, src->size, &_lowered);
+            _token_extractor.string_to_bloom_filter(_lowered.data(), _lowered.size(), *_bf);
+            continue;
+        }
         _token_extractor.string_to_bloom_filter(src->data, src->size, *_bf);
     }
 }
@@ -202,6 +210,8 @@ Status NGramBloomFilterIndexWriterImpl::finish(io::FileWriter* file_writer,
     BloomFilterIndexPB* meta = index_meta->mutable_bloom_filter_index();
     meta->set_hash_strategy(CITY_HASH_64);
     meta->set_algorithm(NGRAM_BLOOM_FILTER);
+    meta->set_gram_size(_gram_size);
+    meta->set_ignore_case(_ignore_case);
 
     // write bloom filters
     const TypeInfo* bf_typeinfo = get_scalar_type_info(OLAP_FIELD_TYPE_VARCHAR);
@@ -225,6 +235,30 @@ uint64_t NGramBloomFilterIndexWriterImpl::size() {
     return total_size;
 }
 
+bool BloomFilterIndexWriter::is_supported_type(FieldType type) {
+    switch (type) {
+    case OLAP_FIELD_TYPE_SMALLINT:
+    case OLAP_FIELD_TYPE_INT:
+    case OLAP_FIELD_TYPE_UNSIGNED_INT:
+    case OLAP_FIELD_TYPE_BIGINT:
+    case OLAP_FIELD_TYPE_LARGEINT:
+    case OLAP_FIELD_TYPE_CHAR:
+    case OLAP_FIELD_TYPE_VARCHAR:
+    case OLAP_FIELD_TYPE_STRING:
+    case OLAP_FIELD_TYPE_DATE:
+    case OLAP_FIELD_TYPE_DATETIME:
+    case OLAP_FIELD_TYPE_DECIMAL:
+    case OLAP_FIELD_TYPE_DATEV2:
+    case OLAP_FIELD_TYPE_DATETIMEV2:
+    case OLAP_FIELD_TYPE_DECIMAL32:
+    case OLAP_FIELD_TYPE_DECIMAL64:
+    case OLAP_FIELD_TYPE_DECIMAL128I:
+        return true;
+    default:
+        return false;
+    }
+}
+
 // TODO currently we don't support bloom filter index for tinyint/hll/float/double
 Status BloomFilterIndexWriter::create(const BloomFilterOptions& bf_options,
                                       const TypeInfo* type_info,
@@ -260,14 +294,15 @@ Status BloomFilterIndexWriter::create(const BloomFilterOptions& bf_options,
 
 Status NGramBloomFilterIndexWriterImpl::create(const BloomFilterOptions& bf_options,
                                                const TypeInfo* typeinfo, uint8_t gram_size,
-                                               uint16_t gram_bf_size,
+                                               uint16_t gram_bf_size, bool ignore_case,
                                                std::unique_ptr<BloomFilterIndexWriter>* res) {
     FieldType type = typeinfo->type();
     switch (type) {
     case OLAP_FIELD_TYPE_CHAR:
     case OLAP_FIELD_TYPE_VARCHAR:
     case OLAP_FIELD_TYPE_STRING:
-        res->reset(new NGramBloomFilterIndexWriterImpl(bf_options, gram_size, gram_bf_size));
+        res->reset(new NGramBloomFilterIndexWriterImpl(bf_options, gram_size, gram_bf_size,
+                                                       ignore_case));
         break;
     default:
         return Status::NotSupported("unsupported type for ngram bloom filter index:{}",
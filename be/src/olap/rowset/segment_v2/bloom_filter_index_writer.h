@@ -24,6 +24,7 @@
 #include "gen_cpp/segment_v2.pb.h"
 #include "gutil/macros.h"
 #include "olap/itoken_extractor.h"
+#include "olap/olap_common.h"
 #include "vec/common/arena.h"
 
 namespace doris {
@@ -43,6 +44,9 @@ public:
     static Status create(const BloomFilterOptions& bf_options, const TypeInfo* typeinfo,
                          std::unique_ptr<BloomFilterIndexWriter>* res);
 
+    // Whether create() supports the type.
+    static bool is_supported_type(FieldType type);
+
     BloomFilterIndexWriter() = default;
     virtual ~BloomFilterIndexWriter() = default;
 
@@ -63,11 +67,13 @@ private:
 class NGramBloomFilterIndexWriterImpl : public BloomFilterIndexWriter {
 public:
     static Status create(const BloomFilterOptions& bf_options, const TypeInfo* typeinfo,
-                         uint8_t gram_size, uint16_t gram_bf_size,
+                         uint8_t gram_size, uint16_t gram_bf_size, bool ignore_case,
                          std::unique_ptr<BloomFilterIndexWriter>* res);
 
+    // If `ignore_case` is true, the ASCII letters of the values are lowercased before the grams
+    // are added.
     NGramBloomFilterIndexWriterImpl(const BloomFilterOptions& bf_options, uint8_t gram_size,
-                                    uint16_t bf_size);
+                                    uint16_t bf_size, bool ignore_case = false);
     void add_values(const void* values, size_t count) override;
     void add_nulls(uint32_t) override {}
     Status flush() override;
@@ -78,6 +84,8 @@ private:
     BloomFilterOptions _bf_options;
     uint8_t _gram_size;
     uint16_t _bf_size;
+    bool _ignore_case;
+    std::string _lowered;
     vectorized::Arena _arena;
     uint64_t _bf_buffer_size;
     NgramTokenExtractor _token_extractor;
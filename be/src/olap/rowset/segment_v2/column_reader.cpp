@@ -31,7 +31,10 @@
 #include "vec/columns/column.h"
 #include "vec/columns/column_array.h"
 #include "vec/columns/column_map.h"
+#include "vec/columns/column_nullable.h"
 #include "vec/columns/column_struct.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/assert_cast.h"
 #include "vec/core/types.h"
 #include "vec/runtime/vdatetime_value.h" //for VecDateTime
 
@@ -157,6 +160,10 @@ Status ColumnReader::init() {
         return Status::NotSupported("unsupported typeinfo, type={}", _meta.type());
     }
     RETURN_IF_ERROR(EncodingInfo::get(_type_info.get(), _meta.encoding(), &_encoding_info));
+    if (_meta.has_compression_dict()) {
+        RETURN_IF_ERROR(create_zstd_dict_compression_codec(_meta.compression_dict(),
+                                                           &_dict_compress_codec));
+    }
 
     for (int i = 0; i < _meta.indexes_size(); i++) {
         auto& index_meta = _meta.indexes(i);
@@ -187,6 +194,14 @@ Status ColumnReader::init() {
     return Status::OK();
 }
 
+Status ColumnReader::get_compression_codec(BlockCompressionCodec** codec) const {
+    if (_dict_compress_codec != nullptr) {
+        *codec = _dict_compress_codec.get();
+        return Status::OK();
+    }
+    return get_block_compression_codec(_meta.compression(), codec);
+}
+
 Status ColumnReader::new_bitmap_index_iterator(BitmapIndexIterator** iterator) {
     RETURN_IF_ERROR(_ensure_index_loaded());
     RETURN_IF_ERROR(_bitmap_index->new_iterator(iterator));
@@ -203,10 +218,9 @@ Status ColumnReader::new_inverted_index_iterator(const TabletIndex* index_meta,
     return Status::OK();
 }
 
-Status ColumnReader::read_page(const ColumnIteratorOptions& iter_opts, const PagePointer& pp,
-                               PageHandle* handle, Slice* page_body, PageFooterPB* footer,
-                               BlockCompressionCodec* codec) const {
-    iter_opts.sanity_check();
+PageReadOptions ColumnReader::get_page_read_options(const ColumnIteratorOptions& iter_opts,
+                                                   const PagePointer& pp,
+                                                   BlockCompressionCodec* codec) const {
     PageReadOptions opts;
     opts.file_reader = iter_opts.file_reader;
     opts.page_pointer = pp;
@@ -214,6 +228,7 @@ Status ColumnReader::read_page(const ColumnIteratorOptions& iter_opts, const Pag
     opts.stats = iter_opts.stats;
     opts.verify_checksum = _opts.verify_checksum;
     opts.use_page_cache = iter_opts.use_page_cache;
+    opts.fill_page_cache = iter_opts.fill_page_cache;
     opts.kept_in_memory = _opts.kept_in_memory;
     opts.type = iter_opts.type;
     opts.encoding_info = _encoding_info;
@@ -222,7 +237,14 @@ Status ColumnReader::read_page(const ColumnIteratorOptions& iter_opts, const Pag
     if (iter_opts.type == INDEX_PAGE) {
         opts.pre_decode = false;
     }
+    return opts;
+}
 
+Status ColumnReader::read_page(const ColumnIteratorOptions& iter_opts, const PagePointer& pp,
+                               PageHandle* handle, Slice* page_body, PageFooterPB* footer,
+                               BlockCompressionCodec* codec) const {
+    iter_opts.sanity_check();
+    PageReadOptions opts = get_page_read_options(iter_opts, pp, codec);
     return PageIO::read_and_decompress_page(opts, handle, page_body, footer);
 }
 
@@ -288,6 +310,24 @@ bool ColumnReader::match_condition(const AndBlockColumnPredicate* col_predicates
                                      max_value.get(), col_predicates);
 }
 
+bool ColumnReader::may_delete(const ColumnPredicate* del_predicate) const {
+    if (_zone_map_index_meta == nullptr) {
+        return true;
+    }
+    const ZoneMapPB& zone_map = _zone_map_index_meta->segment_zone_map();
+    if (!zone_map.has_not_null() && !zone_map.has_null()) {
+        return false; // no data in this zone
+    }
+    if (zone_map.pass_all()) {
+        return true;
+    }
+    FieldType type = _type_info->type();
+    std::unique_ptr<WrapperField> min_value(WrapperField::create_by_type(type, _meta.length()));
+    std::unique_ptr<WrapperField> max_value(WrapperField::create_by_type(type, _meta.length()));
+    _parse_zone_map(zone_map, min_value.get(), max_value.get());
+    return del_predicate->may_delete({min_value.get(), max_value.get()});
+}
+
 void ColumnReader::_parse_zone_map(const ZoneMapPB& zone_map, WrapperField* min_value_container,
                                    WrapperField* max_value_container) const {
     // min value and max value are valid if has_not_null is true
@@ -588,6 +628,9 @@ Status MapFileColumnIterator::seek_to_ordinal(ordinal_t ord) {
         RETURN_IF_ERROR(_null_iterator->seek_to_ordinal(ord));
     }
     RETURN_IF_ERROR(_offsets_iterator->seek_to_ordinal(ord));
+    if (_offsets_only) {
+        return Status::OK();
+    }
     // here to use offset info
     ordinal_t offset = 0;
     RETURN_IF_ERROR(_offsets_iterator->_peek_one_offset(&offset));
@@ -616,7 +659,10 @@ Status MapFileColumnIterator::next_batch(size_t* n, vectorized::MutableColumnPtr
     auto key_ptr = column_map->get_keys().assume_mutable();
     auto val_ptr = column_map->get_values().assume_mutable();
 
-    if (num_items > 0) {
+    if (_offsets_only) {
+        key_ptr->insert_many_defaults(num_items);
+        val_ptr->insert_many_defaults(num_items);
+    } else if (num_items > 0) {
         size_t num_read = num_items;
         bool key_has_null = false;
         bool val_has_null = false;
@@ -785,6 +831,9 @@ Status ArrayFileColumnIterator::init(const ColumnIteratorOptions& opts) {
 }
 
 Status ArrayFileColumnIterator::_seek_by_offsets(ordinal_t ord) {
+    if (_offsets_only) {
+        return Status::OK();
+    }
     // using offsets info
     ordinal_t offset = 0;
     RETURN_IF_ERROR(_offset_iterator->_peek_one_offset(&offset));
@@ -819,7 +868,9 @@ Status ArrayFileColumnIterator::next_batch(size_t* n, vectorized::MutableColumnP
     size_t num_items =
             column_offsets.get_data().back() - column_offsets.get_data()[start - 1]; // -1 is valid
     auto column_items_ptr = column_array->get_data().assume_mutable();
-    if (num_items > 0) {
+    if (_offsets_only) {
+        column_items_ptr->insert_many_defaults(num_items);
+    } else if (num_items > 0) {
         size_t num_read = num_items;
         bool items_has_null = false;
         RETURN_IF_ERROR(_item_iterator->next_batch(&num_read, column_items_ptr, &items_has_null));
@@ -859,7 +910,14 @@ Status FileColumnIterator::init(const ColumnIteratorOptions& opts) {
     if (!_opts.use_page_cache) {
         _reader->disable_index_meta_cache();
     }
-    RETURN_IF_ERROR(get_block_compression_codec(_reader->get_compression(), &_compress_codec));
+    RETURN_IF_ERROR(_reader->get_compression_codec(&_compress_codec));
+    if (PagePrefetcher::need_prefetch(_opts)) {
+        ColumnIteratorOptions data_page_opts = _opts;
+        data_page_opts.type = DATA_PAGE;
+        _prefetcher = std::make_unique<PagePrefetcher>(
+                _reader->get_page_read_options(data_page_opts, PagePointer(), _compress_codec),
+                config::remote_page_prefetch_depth);
+    }
     if (config::enable_low_cardinality_optimize &&
         _reader->encoding_info()->encoding() == DICT_ENCODING) {
         auto dict_encoding_type = _reader->get_dict_encoding_type();
@@ -1086,19 +1144,29 @@ Status FileColumnIterator::_read_data_page(const OrdinalPageIndexIterator& iter)
     Slice page_body;
     PageFooterPB footer;
     _opts.type = DATA_PAGE;
+    if (_prefetcher) {
+        _prefetcher->wait_for_page(iter.page());
+    }
     RETURN_IF_ERROR(
             _reader->read_page(_opts, iter.page(), &handle, &page_body, &footer, _compress_codec));
     // parse data page
+    const EncodingInfo* encoding_info = _reader->encoding_info();
+    if (footer.data_page_footer().has_encoding()) {
+        RETURN_IF_ERROR(EncodingInfo::get(encoding_info->type(),
+                                          footer.data_page_footer().encoding(), &encoding_info));
+    }
     RETURN_IF_ERROR(ParsedPage::create(std::move(handle), page_body, footer.data_page_footer(),
-                                       _reader->encoding_info(), iter.page(), iter.page_index(),
-                                       &_page));
+                                       encoding_info, iter.page(), iter.page_index(), &_page));
+    if (_prefetcher) {
+        _prefetcher->prefetch_pages_after(iter);
+    }
 
     // dictionary page is read when the first data page that uses it is read,
     // this is to optimize the memory usage: when there is no query on one column, we could
     // release the memory of dictionary page.
     // note that concurrent iterators for the same column won't repeatedly read dictionary page
     // because of page cache.
-    if (_reader->encoding_info()->encoding() == DICT_ENCODING) {
+    if (encoding_info->encoding() == DICT_ENCODING) {
         auto dict_page_decoder = reinterpret_cast<BinaryDictPageDecoder*>(_page.data_decoder);
         if (dict_page_decoder->is_dict_encoding()) {
             if (_dict_decoder == nullptr) {
@@ -1127,6 +1195,48 @@ Status FileColumnIterator::_read_data_page(const OrdinalPageIndexIterator& iter)
     return Status::OK();
 }
 
+Status FileColumnIterator::collect_pages(ordinal_t from, ordinal_t to, PageReadPlanner* planner) {
+    if (from >= to || (_page && _page.contains(from) && _page.contains(to - 1))) {
+        return Status::OK();
+    }
+    OrdinalPageIndexIterator iter;
+    RETURN_IF_ERROR(_reader->seek_at_or_before(from, &iter));
+    for (; iter.valid() && iter.first_ordinal() < to; iter.next()) {
+        _collect_page(iter, planner);
+    }
+    return Status::OK();
+}
+
+Status FileColumnIterator::collect_pages(const rowid_t* rowids, size_t count,
+                                         PageReadPlanner* planner) {
+    const rowid_t* end = rowids + count;
+    while (rowids < end) {
+        if (_page && _page.contains(*rowids)) {
+            rowids = std::upper_bound(rowids, end, _page.first_ordinal + _page.num_rows - 1);
+            continue;
+        }
+        OrdinalPageIndexIterator iter;
+        RETURN_IF_ERROR(_reader->seek_at_or_before(*rowids, &iter));
+        if (!iter.valid()) {
+            break;
+        }
+        _collect_page(iter, planner);
+        rowids = std::upper_bound(rowids, end, iter.last_ordinal());
+    }
+    return Status::OK();
+}
+
+void FileColumnIterator::_collect_page(const OrdinalPageIndexIterator& iter,
+                                       PageReadPlanner* planner) {
+    if ((_page && _page.page_index == static_cast<uint32_t>(iter.page_index())) ||
+        (_prefetcher && _prefetcher->has_page(iter.page()))) {
+        return;
+    }
+    ColumnIteratorOptions data_page_opts = _opts;
+    data_page_opts.type = DATA_PAGE;
+    planner->add_page(_reader->get_page_read_options(data_page_opts, iter.page(), _compress_codec));
+}
+
 Status FileColumnIterator::get_row_ranges_by_zone_map(
         const AndBlockColumnPredicate* col_predicates,
         std::vector<const ColumnPredicate*>* delete_predicates, RowRanges* row_ranges) {
@@ -1296,5 +1406,143 @@ void DefaultValueColumnIterator::_insert_many_default(vectorized::MutableColumnP
     }
 }
 
+namespace {
+
+// the order of the widths of the integer types, or -1 for the other types
+int integer_width_order(FieldType type) {
+    switch (type) {
+    case FieldType::OLAP_FIELD_TYPE_TINYINT:
+        return 0;
+    case FieldType::OLAP_FIELD_TYPE_SMALLINT:
+        return 1;
+    case FieldType::OLAP_FIELD_TYPE_INT:
+        return 2;
+    case FieldType::OLAP_FIELD_TYPE_BIGINT:
+        return 3;
+    case FieldType::OLAP_FIELD_TYPE_LARGEINT:
+        return 4;
+    default:
+        return -1;
+    }
+}
+
+template <typename SrcT>
+vectorized::MutableColumnPtr create_integer_column() {
+    return vectorized::ColumnVector<SrcT>::create();
+}
+
+// `dst' may be a predicate column, so the integers are inserted as the raw data
+template <typename SrcT, typename DstT>
+void widen_integers(const vectorized::IColumn& src, vectorized::IColumn* dst) {
+    const auto& src_data = assert_cast<const vectorized::ColumnVector<SrcT>&>(src).get_data();
+    vectorized::PaddedPODArray<DstT> values(src_data.size());
+    for (size_t i = 0; i < src_data.size(); ++i) {
+        values[i] = src_data[i];
+    }
+    dst->insert_many_fix_len_data(reinterpret_cast<const char*>(values.data()), values.size());
+}
+
+template <typename SrcT>
+void widen_integers(FieldType type, const vectorized::IColumn& src, vectorized::IColumn* dst) {
+    switch (type) {
+    case FieldType::OLAP_FIELD_TYPE_SMALLINT:
+        widen_integers<SrcT, vectorized::Int16>(src, dst);
+        break;
+    case FieldType::OLAP_FIELD_TYPE_INT:
+        widen_integers<SrcT, vectorized::Int32>(src, dst);
+        break;
+    case FieldType::OLAP_FIELD_TYPE_BIGINT:
+        widen_integers<SrcT, vectorized::Int64>(src, dst);
+        break;
+    case FieldType::OLAP_FIELD_TYPE_LARGEINT:
+        widen_integers<SrcT, vectorized::Int128>(src, dst);
+        break;
+    default:
+        LOG(FATAL) << "unsupported type to widen to: " << type;
+    }
+}
+
+} // namespace
+
+bool WideningColumnIterator::can_widen(FieldType file_type, FieldType type) {
+    int file_order = integer_width_order(file_type);
+    return file_order >= 0 && integer_width_order(type) > file_order;
+}
+
+vectorized::MutableColumnPtr& WideningColumnIterator::_file_column(
+        const vectorized::MutableColumnPtr& dst) {
+    if (_file_col == nullptr) {
+        switch (_file_type) {
+        case FieldType::OLAP_FIELD_TYPE_TINYINT:
+            _file_col = create_integer_column<vectorized::Int8>();
+            break;
+        case FieldType::OLAP_FIELD_TYPE_SMALLINT:
+            _file_col = create_integer_column<vectorized::Int16>();
+            break;
+        case FieldType::OLAP_FIELD_TYPE_INT:
+            _file_col = create_integer_column<vectorized::Int32>();
+            break;
+        default:
+            DCHECK_EQ(_file_type, FieldType::OLAP_FIELD_TYPE_BIGINT);
+            _file_col = create_integer_column<vectorized::Int64>();
+            break;
+        }
+        if (dst->is_nullable()) {
+            _file_col = vectorized::ColumnNullable::create(std::move(_file_col),
+                                                           vectorized::ColumnUInt8::create());
+        }
+    }
+    _file_col->clear();
+    return _file_col;
+}
+
+void WideningColumnIterator::_widen(vectorized::MutableColumnPtr& dst) {
+    const vectorized::IColumn* src = _file_col.get();
+    vectorized::IColumn* dst_data = dst.get();
+    if (dst->is_nullable()) {
+        const auto& src_nullable = assert_cast<const vectorized::ColumnNullable&>(*src);
+        auto& dst_nullable = assert_cast<vectorized::ColumnNullable&>(*dst);
+        const auto& null_map = src_nullable.get_null_map_data();
+        dst_nullable.get_null_map_data().insert(null_map.begin(), null_map.end());
+        src = &src_nullable.get_nested_column();
+        dst_data = &dst_nullable.get_nested_column();
+    }
+    switch (_file_type) {
+    case FieldType::OLAP_FIELD_TYPE_TINYINT:
+        widen_integers<vectorized::Int8>(_type, *src, dst_data);
+        break;
+    case FieldType::OLAP_FIELD_TYPE_SMALLINT:
+        widen_integers<vectorized::Int16>(_type, *src, dst_data);
+        break;
+    case FieldType::OLAP_FIELD_TYPE_INT:
+        widen_integers<vectorized::Int32>(_type, *src, dst_data);
+        break;
+    default:
+        widen_integers<vectorized::Int64>(_type, *src, dst_data);
+        break;
+    }
+}
+
+Status WideningColumnIterator::next_batch(size_t* n, vectorized::MutableColumnPtr& dst,
+                                          bool* has_null) {
+    RETURN_IF_ERROR(_file_iter->next_batch(n, _file_column(dst), has_null));
+    _widen(dst);
+    return Status::OK();
+}
+
+Status WideningColumnIterator::next_batch_of_zone_map(size_t* n,
+                                                      vectorized::MutableColumnPtr& dst) {
+    RETURN_IF_ERROR(_file_iter->next_batch_of_zone_map(n, _file_column(dst)));
+    _widen(dst);
+    return Status::OK();
+}
+
+Status WideningColumnIterator::read_by_rowids(const rowid_t* rowids, const size_t count,
+                                              vectorized::MutableColumnPtr& dst) {
+    RETURN_IF_ERROR(_file_iter->read_by_rowids(rowids, count, _file_column(dst)));
+    _widen(dst);
+    return Status::OK();
+}
+
 } // namespace segment_v2
 } // namespace doris
@@ -35,6 +35,9 @@
 #include "olap/rowset/segment_v2/inverted_index_reader.h" // for InvertedIndexReader
 #include "olap/rowset/segment_v2/ordinal_page_index.h"    // for OrdinalPageIndexIterator
 #include "olap/rowset/segment_v2/page_handle.h"           // for PageHandle
+#include "olap/rowset/segment_v2/page_io.h"               // for PageReadOptions
+#include "olap/rowset/segment_v2/page_prefetcher.h"       // for PagePrefetcher
+#include "olap/rowset/segment_v2/page_read_planner.h"     // for PageReadPlanner
 #include "olap/rowset/segment_v2/parsed_page.h"           // for ParsedPage
 #include "olap/rowset/segment_v2/row_ranges.h"            // for RowRanges
 #include "olap/rowset/segment_v2/zone_map_index.h"
@@ -72,6 +75,8 @@ struct ColumnIteratorOptions {
     // reader statistics
     OlapReaderStatistics* stats = nullptr;
     bool use_page_cache = false;
+    // if false, pages are looked up in page cache, but not inserted into it
+    bool fill_page_cache = true;
     // for page cache allocation
     // page types are divided into DATA_PAGE & INDEX_PAGE
     // INDEX_PAGE including index_page, dict_page and short_key_page
@@ -112,6 +117,11 @@ public:
     Status seek_to_first(OrdinalPageIndexIterator* iter);
     Status seek_at_or_before(ordinal_t ordinal, OrdinalPageIndexIterator* iter);
 
+    // options to read the page `pp' with `iter_opts'
+    PageReadOptions get_page_read_options(const ColumnIteratorOptions& iter_opts,
+                                          const PagePointer& pp,
+                                          BlockCompressionCodec* codec) const;
+
     // read a page from file into a page handle
     Status read_page(const ColumnIteratorOptions& iter_opts, const PagePointer& pp,
                      PageHandle* handle, Slice* page_body, PageFooterPB* footer,
@@ -119,6 +129,9 @@ public:
 
     bool is_nullable() const { return _meta.is_nullable(); }
 
+    // the type of the column in the file, which may be narrower than the one in the schema
+    FieldType get_field_type() const { return (FieldType)_meta.type(); }
+
     const EncodingInfo* encoding_info() const { return _encoding_info; }
 
     bool has_zone_map() const { return _zone_map_index_meta != nullptr; }
@@ -130,6 +143,9 @@ public:
     // Return true if segment zone map is absent or `cond' could be satisfied, false otherwise.
     bool match_condition(const AndBlockColumnPredicate* col_predicates) const;
 
+    // whether any row of the segment may be deleted by the delete predicate by the zone map
+    bool may_delete(const ColumnPredicate* del_predicate) const;
+
     Status next_batch_of_zone_map(size_t* n, vectorized::MutableColumnPtr& dst) const;
 
     // get row ranges with zone map
@@ -149,6 +165,9 @@ public:
 
     CompressionTypePB get_compression() const { return _meta.compression(); }
 
+    // the codec to decompress the data pages and the dictionary page of the column with
+    Status get_compression_codec(BlockCompressionCodec** codec) const;
+
     uint64_t num_rows() const { return _num_rows; }
 
     void set_dict_encoding_type(DictEncodingType type) {
@@ -220,6 +239,8 @@ private:
             TypeInfoPtr(nullptr, nullptr); // initialized in init(), may changed by subclasses.
     const EncodingInfo* _encoding_info =
             nullptr; // initialized in init(), used for create PageDecoder
+    // the codec of the ZSTD dictionary of the column if any
+    std::unique_ptr<BlockCompressionCodec> _dict_compress_codec;
 
     // meta for various column indexes (null if the index is absent)
     bool _index_meta_use_page_cache = true;
@@ -295,6 +316,21 @@ public:
 
     virtual bool is_all_dict_encoding() const { return false; }
 
+    // Only the offsets and the null map of an array or a map are read then, and the elements are
+    // filled by the default values, for the readers only taking the sizes.
+    virtual void set_offsets_only() {}
+
+    // Add the data pages holding the rows in [from, to) to `planner', so that they can
+    // be read together with the pages of other columns.
+    virtual Status collect_pages(ordinal_t from, ordinal_t to, PageReadPlanner* planner) {
+        return Status::OK();
+    }
+
+    // Same as above, for the rows `rowids' which are in ascending order.
+    virtual Status collect_pages(const rowid_t* rowids, size_t count, PageReadPlanner* planner) {
+        return Status::OK();
+    }
+
 protected:
     ColumnIteratorOptions _opts;
 };
@@ -339,8 +375,13 @@ public:
 
     bool is_all_dict_encoding() const override { return _is_all_dict_encoding; }
 
+    Status collect_pages(ordinal_t from, ordinal_t to, PageReadPlanner* planner) override;
+
+    Status collect_pages(const rowid_t* rowids, size_t count, PageReadPlanner* planner) override;
+
 private:
     void _seek_to_pos_in_page(ParsedPage* page, ordinal_t offset_in_page) const;
+    void _collect_page(const OrdinalPageIndexIterator& iter, PageReadPlanner* planner);
     Status _load_next_page(bool* eos);
     Status _read_data_page(const OrdinalPageIndexIterator& iter);
 
@@ -371,6 +412,9 @@ private:
     bool _is_all_dict_encoding = false;
 
     std::unique_ptr<StringRef[]> _dict_word_info;
+
+    // prefetch the following data pages, only for the segments on remote storage
+    std::unique_ptr<PagePrefetcher> _prefetcher;
 };
 
 class EmptyFileColumnIterator final : public ColumnIterator {
@@ -430,8 +474,10 @@ public:
     Status read_by_rowids(const rowid_t* rowids, const size_t count,
                           vectorized::MutableColumnPtr& dst) override;
     Status seek_to_first() override {
-        RETURN_IF_ERROR(_key_iterator->seek_to_first());
-        RETURN_IF_ERROR(_val_iterator->seek_to_first());
+        if (!_offsets_only) {
+            RETURN_IF_ERROR(_key_iterator->seek_to_first());
+            RETURN_IF_ERROR(_val_iterator->seek_to_first());
+        }
         RETURN_IF_ERROR(_offsets_iterator->seek_to_first());
         if (_map_reader->is_nullable()) {
             RETURN_IF_ERROR(_null_iterator->seek_to_first());
@@ -445,12 +491,15 @@ public:
         return _offsets_iterator->get_current_ordinal();
     }
 
+    void set_offsets_only() override { _offsets_only = true; }
+
 private:
     ColumnReader* _map_reader;
     std::unique_ptr<ColumnIterator> _null_iterator;
     std::unique_ptr<OffsetFileColumnIterator> _offsets_iterator; //OffsetFileIterator
     std::unique_ptr<ColumnIterator> _key_iterator;
     std::unique_ptr<ColumnIterator> _val_iterator;
+    bool _offsets_only = false;
 };
 
 class StructFileColumnIterator final : public ColumnIterator {
@@ -505,7 +554,9 @@ public:
 
     Status seek_to_first() override {
         RETURN_IF_ERROR(_offset_iterator->seek_to_first());
-        RETURN_IF_ERROR(_item_iterator->seek_to_first()); // lazy???
+        if (!_offsets_only) {
+            RETURN_IF_ERROR(_item_iterator->seek_to_first()); // lazy???
+        }
         if (_array_reader->is_nullable()) {
             RETURN_IF_ERROR(_null_iterator->seek_to_first());
         }
@@ -518,11 +569,14 @@ public:
         return _offset_iterator->get_current_ordinal();
     }
 
+    void set_offsets_only() override { _offsets_only = true; }
+
 private:
     ColumnReader* _array_reader;
     std::unique_ptr<OffsetFileColumnIterator> _offset_iterator;
     std::unique_ptr<ColumnIterator> _null_iterator;
     std::unique_ptr<ColumnIterator> _item_iterator;
+    bool _offsets_only = false;
 
     Status _seek_by_offsets(ordinal_t ord);
 };
@@ -577,6 +631,54 @@ private:
     int32_t _segment_id = 0;
 };
 
+// Reads the integers of a narrower type in the file as a wider type, for a column widened by a
+// linked schema change, e.g. INT to BIGINT. The zone maps and bloom filters are of the type in the
+// file, so they prune no rows.
+class WideningColumnIterator final : public ColumnIterator {
+public:
+    WideningColumnIterator(std::unique_ptr<ColumnIterator> file_iter, FieldType file_type,
+                           FieldType type)
+            : _file_iter(std::move(file_iter)), _file_type(file_type), _type(type) {}
+
+    // whether the integers of `file_type' can be read as `type'
+    static bool can_widen(FieldType file_type, FieldType type);
+
+    Status init(const ColumnIteratorOptions& opts) override { return _file_iter->init(opts); }
+
+    Status seek_to_first() override { return _file_iter->seek_to_first(); }
+
+    Status seek_to_ordinal(ordinal_t ord) override { return _file_iter->seek_to_ordinal(ord); }
+
+    Status next_batch(size_t* n, vectorized::MutableColumnPtr& dst, bool* has_null) override;
+
+    // the min and max values keep the order after widened
+    Status next_batch_of_zone_map(size_t* n, vectorized::MutableColumnPtr& dst) override;
+
+    Status read_by_rowids(const rowid_t* rowids, const size_t count,
+                          vectorized::MutableColumnPtr& dst) override;
+
+    ordinal_t get_current_ordinal() const override { return _file_iter->get_current_ordinal(); }
+
+    Status collect_pages(ordinal_t from, ordinal_t to, PageReadPlanner* planner) override {
+        return _file_iter->collect_pages(from, to, planner);
+    }
+
+    Status collect_pages(const rowid_t* rowids, size_t count, PageReadPlanner* planner) override {
+        return _file_iter->collect_pages(rowids, count, planner);
+    }
+
+private:
+    // the column of the type in the file to read into, of the nullability of `dst'
+    vectorized::MutableColumnPtr& _file_column(const vectorized::MutableColumnPtr& dst);
+    // appends the integers read into `_file_column' to `dst'
+    void _widen(vectorized::MutableColumnPtr& dst);
+
+    std::unique_ptr<ColumnIterator> _file_iter;
+    FieldType _file_type;
+    FieldType _type;
+    vectorized::MutableColumnPtr _file_col;
+};
+
 // This iterator is used to read default value column
 class DefaultValueColumnIterator : public ColumnIterator {
 public:
@@ -19,6 +19,7 @@
 
 #include <cstddef>
 
+#include "common/config.h"
 #include "common/logging.h"
 #include "gutil/strings/substitute.h"
 #include "io/fs/file_writer.h"
@@ -32,6 +33,7 @@
 #include "olap/rowset/segment_v2/page_builder.h"
 #include "olap/rowset/segment_v2/page_io.h"
 #include "olap/rowset/segment_v2/zone_map_index.h"
+#include "olap/utils.h"
 #include "util/block_compression.h"
 #include "util/faststring.h"
 #include "util/rle_encoding.h"
@@ -433,9 +435,13 @@ ScalarColumnWriter::~ScalarColumnWriter() {
 
 Status ScalarColumnWriter::init() {
     RETURN_IF_ERROR(get_block_compression_codec(_opts.meta->compression(), &_compress_codec));
+    _is_sampling_compression_dict =
+            config::enable_zstd_dictionary_compression && _opts.meta->compression() == ZSTD &&
+            (is_string_type(get_field()->type()) || get_field()->type() == OLAP_FIELD_TYPE_JSONB);
 
     PageBuilder* page_builder = nullptr;
 
+    bool is_default_encoding = _opts.meta->encoding() == DEFAULT_ENCODING;
     RETURN_IF_ERROR(
             EncodingInfo::get(get_field()->type_info(), _opts.meta->encoding(), &_encoding_info));
     _opts.meta->set_encoding(_encoding_info->encoding());
@@ -451,6 +457,9 @@ Status ScalarColumnWriter::init() {
     // because the default encoding of a data type can be changed in the future
     DCHECK_NE(_opts.meta->encoding(), DEFAULT_ENCODING);
     _page_builder.reset(page_builder);
+    _page_encoding_info = _encoding_info;
+    RETURN_IF_ERROR(_init_encoding_candidates(opts, is_default_encoding));
+    _is_sampled_page = !_encoding_candidates.empty();
     // create ordinal builder
     _ordinal_index_builder.reset(new OrdinalIndexWriter());
     // create null bitmap builder
@@ -475,7 +484,7 @@ Status ScalarColumnWriter::init() {
         if (_opts.is_ngram_bf_index) {
             RETURN_IF_ERROR(NGramBloomFilterIndexWriterImpl::create(
                     BloomFilterOptions(), get_field()->type_info(), _opts.gram_size,
-                    _opts.gram_bf_size, &_bloom_filter_index_builder));
+                    _opts.gram_bf_size, _opts.ngram_bf_ignore_case, &_bloom_filter_index_builder));
         } else {
             RETURN_IF_ERROR(BloomFilterIndexWriter::create(
                     BloomFilterOptions(), get_field()->type_info(), &_bloom_filter_index_builder));
@@ -522,6 +531,15 @@ Status ScalarColumnWriter::append_data(const uint8_t** ptr, size_t num_rows) {
 
 Status ScalarColumnWriter::append_data_in_current_page(const uint8_t* data, size_t* num_written) {
     RETURN_IF_ERROR(_page_builder->add(data, num_written));
+    if (_is_sampled_page) {
+        for (auto& candidate : _encoding_candidates) {
+            size_t num_candidate_written = *num_written;
+            if (candidate.has_all_values && *num_written > 0) {
+                RETURN_IF_ERROR(candidate.page_builder->add(data, &num_candidate_written));
+                candidate.has_all_values = num_candidate_written == *num_written;
+            }
+        }
+    }
     if (_opts.need_zone_map) {
         _zone_map_index_builder->add_values(data, *num_written);
     }
@@ -572,6 +590,9 @@ uint64_t ScalarColumnWriter::estimate_buffer_size() {
 
 Status ScalarColumnWriter::finish() {
     RETURN_IF_ERROR(finish_current_page());
+    if (_is_sampling_compression_dict) {
+        RETURN_IF_ERROR(_train_compression_dict());
+    }
     _opts.meta->set_num_rows(_next_rowid);
     return Status::OK();
 }
@@ -664,6 +685,11 @@ Status ScalarColumnWriter::finish_current_page() {
     std::vector<Slice> body;
     OwnedSlice encoded_values = _page_builder->finish();
     _page_builder->reset();
+    if (_is_sampled_page) {
+        RETURN_IF_ERROR(_choose_encoding(&encoded_values));
+    }
+    _is_sampled_page = !_encoding_candidates.empty() &&
+                       ++_num_pages % config::data_page_encoding_sample_interval == 0;
     body.push_back(encoded_values.slice());
 
     OwnedSlice nullmap;
@@ -683,24 +709,197 @@ Status ScalarColumnWriter::finish_current_page() {
     data_page_footer->set_first_ordinal(_first_rowid);
     data_page_footer->set_num_values(_next_rowid - _first_rowid);
     data_page_footer->set_nullmap_size(nullmap.slice().size);
+    if (_page_encoding_info != _encoding_info) {
+        data_page_footer->set_encoding(_page_encoding_info->encoding());
+    }
     if (_new_page_callback != nullptr) {
         _new_page_callback->put_extra_info_in_page(data_page_footer);
     }
+    page->data.emplace_back(std::move(encoded_values));
+    page->data.emplace_back(std::move(nullmap));
+    if (_is_sampling_compression_dict) {
+        _sampled_bytes += page->footer.uncompressed_size();
+    } else {
+        RETURN_IF_ERROR(_compress_page(page.get()));
+    }
+
+    _push_back_page(page.release());
+    _first_rowid = _next_rowid;
+    if (_is_sampling_compression_dict &&
+        static_cast<int64_t>(_sampled_bytes) >= config::zstd_dictionary_sample_bytes) {
+        RETURN_IF_ERROR(_train_compression_dict());
+    }
+    return Status::OK();
+}
+
+Status ScalarColumnWriter::_compress_page(Page* page) {
     // trying to compress page body
+    std::vector<Slice> body;
+    for (auto& data : page->data) {
+        if (!data.slice().empty()) {
+            body.push_back(data.slice());
+        }
+    }
     OwnedSlice compressed_body;
     RETURN_IF_ERROR(PageIO::compress_page_body(_compress_codec, _opts.compression_min_space_saving,
                                                body, &compressed_body));
-    if (compressed_body.slice().empty()) {
-        // page body is uncompressed
-        page->data.emplace_back(std::move(encoded_values));
-        page->data.emplace_back(std::move(nullmap));
-    } else {
+    if (!compressed_body.slice().empty()) {
         // page body is compressed
+        page->data.clear();
         page->data.emplace_back(std::move(compressed_body));
     }
+    return Status::OK();
+}
 
-    _push_back_page(page.release());
-    _first_rowid = _next_rowid;
+Status ScalarColumnWriter::_train_compression_dict() {
+    _is_sampling_compression_dict = false;
+    // the dictionary is trained better from more and smaller samples than whole pages
+    constexpr size_t SAMPLE_SIZE = 4096;
+    std::vector<Slice> samples;
+    for (Page* page = _pages.head; page != nullptr; page = page->next) {
+        Slice values = page->data[0].slice();
+        for (size_t offset = 0; offset < values.size; offset += SAMPLE_SIZE) {
+            samples.emplace_back(values.data + offset, std::min(SAMPLE_SIZE, values.size - offset));
+        }
+    }
+    std::string dict;
+    Status st = train_zstd_dictionary(samples, config::zstd_dictionary_max_bytes, &dict);
+    if (st.ok()) {
+        RETURN_IF_ERROR(create_zstd_dict_compression_codec(dict, &_dict_compress_codec));
+        _compress_codec = _dict_compress_codec.get();
+        _opts.meta->set_compression_dict(std::move(dict));
+    } else {
+        // the pages are compressed without a dictionary as before
+        VLOG_DEBUG << "failed to train the compression dictionary of column "
+                   << get_field()->name() << " from " << _sampled_bytes << " bytes: " << st;
+    }
+
+    _data_size = 0;
+    for (Page* page = _pages.head; page != nullptr; page = page->next) {
+        RETURN_IF_ERROR(_compress_page(page));
+        for (auto& data_slice : page->data) {
+            _data_size += data_slice.slice().size;
+        }
+        // estimate (page footer + footer size + checksum) took 20 bytes
+        _data_size += 20;
+    }
+    return Status::OK();
+}
+
+// the size of the page body of the encoded values
+static Status compressed_size(BlockCompressionCodec* codec, double min_space_saving,
+                              const OwnedSlice& encoded_values, size_t* size) {
+    OwnedSlice compressed_body;
+    RETURN_IF_ERROR(PageIO::compress_page_body(codec, min_space_saving, {encoded_values.slice()},
+                                               &compressed_body));
+    *size = compressed_body.slice().empty() ? encoded_values.slice().size
+                                            : compressed_body.slice().size;
+    return Status::OK();
+}
+
+// the lower the faster the pages of the encoding are decoded
+static int decode_cost(EncodingTypePB encoding) {
+    switch (encoding) {
+    case PLAIN_ENCODING:
+        return 0;
+    case BIT_SHUFFLE:
+        return 1;
+    case FOR_ENCODING:
+        return 2;
+    default:
+        return 3;
+    }
+}
+
+Status ScalarColumnWriter::_init_encoding_candidates(const PageBuilderOptions& opts,
+                                                     bool is_default_encoding) {
+    std::vector<EncodingTypePB> encodings;
+    const std::string objective = config::data_page_encoding_objective;
+    if (!objective.empty() && _encoding_info->encoding() != DICT_ENCODING) {
+        // the dictionary pages are of the column, so the pages of a column of the dictionary
+        // encoding, which falls back to the plain encoding by itself, keep it
+        _encoding_objective = objective == "decode_speed" ? EncodingObjective::DECODE_SPEED
+                                                          : EncodingObjective::SIZE;
+        _is_page_encoding_adaptive = true;
+        encodings = {PLAIN_ENCODING, BIT_SHUFFLE, FOR_ENCODING, RLE, PREFIX_ENCODING};
+    } else if (config::enable_adaptive_integer_encoding && is_default_encoding) {
+        encodings = {FOR_ENCODING};
+    }
+    for (auto encoding : encodings) {
+        const EncodingInfo* encoding_info = nullptr;
+        if (encoding == _encoding_info->encoding() ||
+            !EncodingInfo::get(get_field()->type_info(), encoding, &encoding_info).ok()) {
+            continue;
+        }
+        PageBuilder* page_builder = nullptr;
+        RETURN_IF_ERROR(encoding_info->create_page_builder(opts, &page_builder));
+        EncodingCandidate candidate;
+        candidate.encoding_info = encoding_info;
+        candidate.page_builder.reset(page_builder);
+        _encoding_candidates.push_back(std::move(candidate));
+    }
+    return Status::OK();
+}
+
+Status ScalarColumnWriter::_choose_encoding(OwnedSlice* encoded_values) {
+    size_t size = 0;
+    RETURN_IF_ERROR(compressed_size(_compress_codec, _opts.compression_min_space_saving,
+                                    *encoded_values, &size));
+    size_t min_size = size;
+    std::vector<OwnedSlice> candidate_encoded_values(_encoding_candidates.size());
+    std::vector<size_t> candidate_sizes(_encoding_candidates.size(), 0);
+    for (size_t i = 0; i < _encoding_candidates.size(); ++i) {
+        auto& candidate = _encoding_candidates[i];
+        if (candidate.has_all_values) {
+            candidate_encoded_values[i] = candidate.page_builder->finish();
+            RETURN_IF_ERROR(compressed_size(_compress_codec, _opts.compression_min_space_saving,
+                                            candidate_encoded_values[i], &candidate_sizes[i]));
+            min_size = std::min(min_size, candidate_sizes[i]);
+        }
+        candidate.page_builder->reset();
+    }
+
+    // the pages of the decode speed objective may be at most a quarter larger than the smallest
+    const size_t max_size =
+            _encoding_objective == EncodingObjective::SIZE ? min_size : min_size + min_size / 4;
+    auto is_better = [&](EncodingTypePB encoding, size_t encoded_size, EncodingTypePB best,
+                         size_t best_size) {
+        if (encoded_size > max_size) {
+            return false;
+        } else if (best_size > max_size) {
+            return true;
+        } else if (_encoding_objective == EncodingObjective::SIZE) {
+            return encoded_size < best_size;
+        }
+        return decode_cost(encoding) < decode_cost(best);
+    };
+    int chosen = -1;
+    EncodingTypePB chosen_encoding = _page_encoding_info->encoding();
+    size_t chosen_size = size;
+    for (size_t i = 0; i < _encoding_candidates.size(); ++i) {
+        auto& candidate = _encoding_candidates[i];
+        if (candidate.has_all_values &&
+            is_better(candidate.encoding_info->encoding(), candidate_sizes[i], chosen_encoding,
+                      chosen_size)) {
+            chosen = i;
+            chosen_encoding = candidate.encoding_info->encoding();
+            chosen_size = candidate_sizes[i];
+        }
+        candidate.has_all_values = true;
+    }
+    if (chosen >= 0) {
+        auto& candidate = _encoding_candidates[chosen];
+        *encoded_values = std::move(candidate_encoded_values[chosen]);
+        std::swap(_page_builder, candidate.page_builder);
+        std::swap(_page_encoding_info, candidate.encoding_info);
+    }
+
+    if (!_is_page_encoding_adaptive) {
+        // no page is written yet, so all the pages of the column are of the chosen encoding
+        _encoding_info = _page_encoding_info;
+        _opts.meta->set_encoding(_encoding_info->encoding());
+        _encoding_candidates.clear();
+    }
     return Status::OK();
 }
 
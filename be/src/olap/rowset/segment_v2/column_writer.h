@@ -18,6 +18,7 @@
 #pragma once
 
 #include <memory> // for unique_ptr
+#include <vector>
 
 #include "common/status.h"         // for Status
 #include "gen_cpp/segment_v2.pb.h" // for EncodingTypePB
@@ -55,6 +56,7 @@ struct ColumnWriterOptions {
     bool is_ngram_bf_index = false;
     uint8_t gram_size;
     uint16_t gram_bf_size;
+    bool ngram_bf_ignore_case = false;
     std::vector<const TabletIndex*> indexes;
     const TabletIndex* inverted_index = nullptr;
     std::string to_string() const {
@@ -74,6 +76,7 @@ class EncodingInfo;
 class NullBitmapBuilder;
 class OrdinalIndexWriter;
 class PageBuilder;
+struct PageBuilderOptions;
 class BloomFilterIndexWriter;
 class ZoneMapIndexWriter;
 
@@ -200,7 +203,33 @@ public:
     friend class ArrayColumnWriter;
 
 private:
+    enum class EncodingObjective { SIZE, DECODE_SPEED };
+
+    struct EncodingCandidate {
+        const EncodingInfo* encoding_info = nullptr;
+        std::unique_ptr<PageBuilder> page_builder;
+        // false if the page builder could not hold all the values of the sampled page
+        bool has_all_values = true;
+    };
+
+    Status _init_encoding_candidates(const PageBuilderOptions& opts, bool is_default_encoding);
+
+    // Keeps the encoding of the sampled page among its encoding and the candidates by the
+    // objective, for the page and the following ones, or for the column if the encoding is
+    // chosen by the first page only.
+    Status _choose_encoding(OwnedSlice* encoded_values);
+
     std::unique_ptr<PageBuilder> _page_builder;
+    // the encoding of the current page, which is the encoding of the column unless the encodings
+    // are chosen per page
+    const EncodingInfo* _page_encoding_info = nullptr;
+    // the other encodings the sampled pages are also encoded in
+    std::vector<EncodingCandidate> _encoding_candidates;
+    EncodingObjective _encoding_objective = EncodingObjective::SIZE;
+    // whether the encoding is chosen for every sampled page, or for the column by the first page
+    bool _is_page_encoding_adaptive = false;
+    bool _is_sampled_page = false;
+    size_t _num_pages = 0;
 
     std::unique_ptr<NullBitmapBuilder> _null_bitmap_builder;
 
@@ -245,6 +274,13 @@ private:
 
     Status _write_data_page(Page* page);
 
+    // Compresses the body of the page built uncompressed.
+    Status _compress_page(Page* page);
+
+    // Trains the ZSTD dictionary of the column from the uncompressed pages, which are compressed
+    // with it then, as well as the following pages.
+    Status _train_compression_dict();
+
 private:
     io::FileWriter* _file_writer = nullptr;
     // total size of data page list
@@ -255,6 +291,11 @@ private:
     ordinal_t _first_rowid = 0;
 
     BlockCompressionCodec* _compress_codec;
+    // the ZSTD codec of the dictionary of the column
+    std::unique_ptr<BlockCompressionCodec> _dict_compress_codec;
+    // whether the pages are kept uncompressed as the samples to train the dictionary from
+    bool _is_sampling_compression_dict = false;
+    size_t _sampled_bytes = 0;
 
     std::unique_ptr<OrdinalIndexWriter> _ordinal_index_builder;
     std::unique_ptr<ZoneMapIndexWriter> _zone_map_index_builder;
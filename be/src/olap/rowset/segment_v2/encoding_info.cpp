@@ -363,6 +363,10 @@ Status EncodingInfo::get(const TypeInfo* type_info, EncodingTypePB encoding_type
     return s_encoding_info_resolver.get(type_info->type(), encoding_type, out);
 }
 
+Status EncodingInfo::get(FieldType type, EncodingTypePB encoding_type, const EncodingInfo** out) {
+    return s_encoding_info_resolver.get(type, encoding_type, out);
+}
+
 EncodingTypePB EncodingInfo::get_default_encoding(const TypeInfo* type_info,
                                                   bool optimize_value_seek) {
     return s_encoding_info_resolver.get_default_encoding(type_info->type(), optimize_value_seek);
@@ -47,6 +47,8 @@ public:
     // Get EncodingInfo for TypeInfo and EncodingTypePB
     static Status get(const TypeInfo* type_info, EncodingTypePB encoding_type,
                       const EncodingInfo** encoding);
+    static Status get(FieldType type, EncodingTypePB encoding_type,
+                      const EncodingInfo** encoding);
 
     // optimize_value_search: whether the encoding scheme should optimize for ordered data
     // and support fast value seek operation
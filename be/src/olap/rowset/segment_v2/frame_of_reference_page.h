@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "olap/rowset/segment_v2/options.h"      // for PageBuilderOptions/PageDecoderOptions
 #include "olap/rowset/segment_v2/page_builder.h" // for PageBuilder
 #include "olap/rowset/segment_v2/page_decoder.h" // for PageDecoder
@@ -125,7 +127,8 @@ public:
             return Status::OK();
         }
 
-        int32_t skip_num = pos - _cur_index;
+        // the decoder stays at the last value when seeking to the end of the page
+        int32_t skip_num = pos - _decoder->current_index();
         _decoder->skip(skip_num);
         _cur_index = pos;
         return Status::OK();
@@ -141,12 +144,67 @@ public:
         return Status::OK();
     }
 
+    template <bool forward_index = true>
+    Status next_batch(size_t* n, vectorized::MutableColumnPtr& dst) {
+        DCHECK(_parsed) << "Must call init() firstly";
+        if (PREDICT_FALSE(*n == 0 || _cur_index >= _num_elements)) {
+            *n = 0;
+            return Status::OK();
+        }
+
+        size_t max_fetch = std::min(*n, static_cast<size_t>(_num_elements - _cur_index));
+        _values.resize(max_fetch);
+        if (!_decoder->get_batch(_values.data(), max_fetch)) {
+            return Status::Corruption("failed to decode {} values of the frame of reference page",
+                                      max_fetch);
+        }
+        dst->insert_many_fix_len_data(reinterpret_cast<const char*>(_values.data()), max_fetch);
+        *n = max_fetch;
+        if constexpr (forward_index) {
+            _cur_index += max_fetch;
+        } else {
+            _decoder->skip(static_cast<int32_t>(_cur_index - _decoder->current_index()));
+        }
+        return Status::OK();
+    }
+
     Status next_batch(size_t* n, vectorized::MutableColumnPtr& dst) override {
-        return Status::NotSupported("frame page not implement vec op now");
+        return next_batch<>(n, dst);
     }
 
     Status peek_next_batch(size_t* n, vectorized::MutableColumnPtr& dst) override {
-        return Status::NotSupported("frame page not implement vec op now");
+        return next_batch<false>(n, dst);
+    }
+
+    Status read_by_rowids(const rowid_t* rowids, ordinal_t page_first_ordinal, size_t* n,
+                          vectorized::MutableColumnPtr& dst) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        if (PREDICT_FALSE(*n == 0)) {
+            return Status::OK();
+        }
+
+        // the rowids are ascending, so every frame is decoded at most once
+        size_t read_count = 0;
+        _values.resize(*n);
+        for (size_t i = 0; i < *n; ++i) {
+            ordinal_t ord = rowids[i] - page_first_ordinal;
+            if (UNLIKELY(ord >= _num_elements)) {
+                break;
+            }
+            _decoder->skip(static_cast<int32_t>(ord - _decoder->current_index()));
+            if (!_decoder->get(&_values[read_count++])) {
+                return Status::Corruption("failed to decode the value {} of the frame of "
+                                          "reference page",
+                                          ord);
+            }
+        }
+        if (LIKELY(read_count > 0)) {
+            dst->insert_many_fix_len_data(reinterpret_cast<const char*>(_values.data()),
+                                          read_count);
+        }
+        _decoder->skip(static_cast<int32_t>(_cur_index - _decoder->current_index()));
+        *n = read_count;
+        return Status::OK();
     }
 
     size_t count() const override { return _num_elements; }
@@ -161,6 +219,8 @@ private:
     uint32_t _num_elements;
     size_t _cur_index;
     std::unique_ptr<ForDecoder<CppType>> _decoder;
+    // the decoded values of a batch
+    std::vector<CppType> _values;
 };
 
 } // namespace segment_v2
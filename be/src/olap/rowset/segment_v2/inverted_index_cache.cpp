@@ -20,6 +20,7 @@
 #include "olap/rowset/segment_v2/inverted_index_compound_directory.h"
 #include "olap/rowset/segment_v2/inverted_index_compound_reader.h"
 #include "util/defer_op.h"
+#include "util/hash_util.hpp"
 
 namespace doris {
 namespace segment_v2 {
@@ -201,12 +202,36 @@ bool InvertedIndexQueryCache::lookup(const CacheKey& key, InvertedIndexQueryCach
 
 void InvertedIndexQueryCache::insert(const CacheKey& key, roaring::Roaring* bitmap,
                                      InvertedIndexQueryCacheHandle* handle) {
+    std::string encoded_key = key.encode();
+    if (!_admit(encoded_key)) {
+        *handle = InvertedIndexQueryCacheHandle(bitmap);
+        return;
+    }
+    // the containers are allocated for the bitmap being built, release the unused memory
+    bitmap->shrinkToFit();
+
     auto deleter = [](const doris::CacheKey& key, void* value) { delete (roaring::Roaring*)value; };
 
-    auto lru_handle = _cache->insert(key.encode(), (void*)bitmap, bitmap->getSizeInBytes(), deleter,
+    auto lru_handle = _cache->insert(encoded_key, (void*)bitmap, bitmap->getSizeInBytes(), deleter,
                                      CachePriority::NORMAL);
     *handle = InvertedIndexQueryCacheHandle(_cache.get(), lru_handle);
 }
 
+bool InvertedIndexQueryCache::_admit(const std::string& encoded_key) {
+    if (!config::enable_inverted_index_query_cache_admission) {
+        return true;
+    }
+    uint64_t hash = HashUtil::hash64(encoded_key.data(), encoded_key.size(), 0);
+    std::lock_guard<std::mutex> l(_missed_keys_lock);
+    if (_missed_keys.erase(hash) > 0) {
+        return true;
+    }
+    if (_missed_keys.size() >= MAX_MISSED_KEYS) {
+        _missed_keys.clear();
+    }
+    _missed_keys.insert(hash);
+    return false;
+}
+
 } // namespace segment_v2
 } // namespace doris
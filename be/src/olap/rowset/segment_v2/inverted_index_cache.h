@@ -24,6 +24,7 @@
 #include <memory>
 #include <mutex>
 #include <roaring/roaring.hh>
+#include <unordered_set>
 #include <vector>
 
 #include "io/fs/file_system.h"
@@ -213,12 +214,23 @@ public:
 
     bool lookup(const CacheKey& key, InvertedIndexQueryCacheHandle* handle);
 
+    // The bitmap is owned by the handle instead if it's not admitted.
     void insert(const CacheKey& key, roaring::Roaring* bitmap,
                 InvertedIndexQueryCacheHandle* handle);
 
 private:
+    // the max number of the keys missed once that are remembered
+    static constexpr size_t MAX_MISSED_KEYS = 65536;
+
+    // Whether the key is missed the second time since it's remembered, otherwise remembers it.
+    bool _admit(const std::string& encoded_key);
+
     static InvertedIndexQueryCache* _s_instance;
     std::unique_ptr<Cache> _cache {nullptr};
+
+    std::mutex _missed_keys_lock;
+    // the hashes of the keys missed once, cleared when full
+    std::unordered_set<uint64_t> _missed_keys;
 };
 
 class InvertedIndexQueryCacheHandle {
@@ -228,6 +240,9 @@ public:
     InvertedIndexQueryCacheHandle(Cache* cache, Cache::Handle* handle)
             : _cache(cache), _handle(handle) {}
 
+    // the bitmap not admitted into the cache
+    explicit InvertedIndexQueryCacheHandle(roaring::Roaring* bitmap) : _bitmap(bitmap) {}
+
     ~InvertedIndexQueryCacheHandle() {
         if (_handle != nullptr) {
             _cache->release(_handle);
@@ -238,11 +253,13 @@ public:
         // we can use std::exchange if we switch c++14 on
         std::swap(_cache, other._cache);
         std::swap(_handle, other._handle);
+        std::swap(_bitmap, other._bitmap);
     }
 
     InvertedIndexQueryCacheHandle& operator=(InvertedIndexQueryCacheHandle&& other) noexcept {
         std::swap(_cache, other._cache);
         std::swap(_handle, other._handle);
+        std::swap(_bitmap, other._bitmap);
         return *this;
     }
 
@@ -250,12 +267,16 @@ public:
     Slice data() const { return _cache->value_slice(_handle); }
 
     InvertedIndexQueryCache::CacheValue* match_bitmap() const {
+        if (_handle == nullptr) {
+            return _bitmap.get();
+        }
         return ((InvertedIndexQueryCache::CacheValue*)_cache->value(_handle));
     }
 
 private:
     Cache* _cache = nullptr;
     Cache::Handle* _handle = nullptr;
+    std::unique_ptr<roaring::Roaring> _bitmap;
 
     // Don't allow copy and assign
     DISALLOW_COPY_AND_ASSIGN(InvertedIndexQueryCacheHandle);
@@ -53,24 +53,35 @@ bool InvertedIndexReader::indexExists(io::Path& index_file_path) {
 std::vector<std::wstring> FullTextIndexReader::get_analyse_result(
         const std::wstring& field_name, const std::string& value, InvertedIndexQueryType query_type,
         InvertedIndexParserType analyser_type) {
-    std::vector<std::wstring> analyse_result;
-    std::shared_ptr<lucene::analysis::Analyzer> analyzer;
-    std::unique_ptr<lucene::util::Reader> reader;
+    auto analyzer = create_analyzer(analyser_type);
+    return get_analyse_result(analyzer.get(), field_name, value, query_type, analyser_type);
+}
+
+std::unique_ptr<lucene::analysis::Analyzer> FullTextIndexReader::create_analyzer(
+        InvertedIndexParserType analyser_type) {
     if (analyser_type == InvertedIndexParserType::PARSER_STANDARD) {
-        analyzer = std::make_shared<lucene::analysis::standard::StandardAnalyzer>();
-        reader.reset(
-                (new lucene::util::StringReader(std::wstring(value.begin(), value.end()).c_str())));
+        return std::make_unique<lucene::analysis::standard::StandardAnalyzer>();
     } else if (analyser_type == InvertedIndexParserType::PARSER_CHINESE) {
         auto chinese_analyzer =
-                std::make_shared<lucene::analysis::LanguageBasedAnalyzer>(L"chinese", false);
+                std::make_unique<lucene::analysis::LanguageBasedAnalyzer>(L"chinese", false);
         chinese_analyzer->initDict(config::inverted_index_dict_path);
-        analyzer = chinese_analyzer;
+        return chinese_analyzer;
+    }
+    // default
+    return std::make_unique<lucene::analysis::SimpleAnalyzer<TCHAR>>();
+}
+
+std::vector<std::wstring> FullTextIndexReader::get_analyse_result(
+        lucene::analysis::Analyzer* analyzer, const std::wstring& field_name,
+        const std::string& value, InvertedIndexQueryType query_type,
+        InvertedIndexParserType analyser_type) {
+    std::vector<std::wstring> analyse_result;
+    std::unique_ptr<lucene::util::Reader> reader;
+    if (analyser_type == InvertedIndexParserType::PARSER_CHINESE) {
         reader.reset(new lucene::util::SimpleInputStreamReader(
                 new lucene::util::AStringReader(value.c_str()),
                 lucene::util::SimpleInputStreamReader::UTF8));
     } else {
-        // default
-        analyzer = std::make_shared<lucene::analysis::SimpleAnalyzer<TCHAR>>();
         reader.reset(
                 (new lucene::util::StringReader(std::wstring(value.begin(), value.end()).c_str())));
     }
@@ -135,6 +146,7 @@ Status FullTextIndexReader::query(OlapReaderStatistics* stats, const std::string
 
         roaring::Roaring query_match_bitmap;
         bool first = true;
+        bool index_checked = false;
         for (auto token_ws : analyse_result) {
             roaring::Roaring* term_match_bitmap = nullptr;
 
@@ -149,6 +161,15 @@ Status FullTextIndexReader::query(OlapReaderStatistics* stats, const std::string
                 term_match_bitmap = cache_handle.match_bitmap();
             } else {
                 stats->inverted_index_query_cache_miss++;
+                // the index of a segment may be built after it's written
+                if (!index_checked) {
+                    if (!indexExists(index_file_path)) {
+                        LOG(WARNING) << "inverted index path: " << index_file_path.string()
+                                     << " not exist.";
+                        return Status::Error<ErrorCode::INVERTED_INDEX_FILE_NOT_FOUND>();
+                    }
+                    index_checked = true;
+                }
                 term_match_bitmap = new roaring::Roaring();
                 // unique_ptr with custom deleter
                 std::unique_ptr<lucene::index::Term, void (*)(lucene::index::Term*)> term {
@@ -221,6 +242,94 @@ Status FullTextIndexReader::query(OlapReaderStatistics* stats, const std::string
     }
 }
 
+namespace {
+
+class TermDocsCursor : public PostingCursor {
+public:
+    explicit TermDocsCursor(lucene::index::TermDocs* term_docs) : _term_docs(term_docs) {
+        _row = _term_docs->next() ? _term_docs->doc() : NO_MORE_ROWS;
+    }
+    ~TermDocsCursor() override {
+        _term_docs->close();
+        _CLDELETE(_term_docs);
+    }
+
+    rowid_t row() const override { return _row; }
+    uint32_t freq() const override { return _term_docs->freq(); }
+    void advance(rowid_t target) override {
+        _row = _term_docs->skipTo(target) ? _term_docs->doc() : NO_MORE_ROWS;
+    }
+
+private:
+    lucene::index::TermDocs* _term_docs;
+    rowid_t _row;
+};
+
+} // namespace
+
+Status FullTextIndexReader::query_top_k(OlapReaderStatistics* stats,
+                                        const std::string& column_name,
+                                        const std::string& search_str,
+                                        InvertedIndexQueryType query_type,
+                                        InvertedIndexParserType analyser_type, size_t k,
+                                        const roaring::Roaring* filter,
+                                        std::vector<ScoredRow>* result) {
+    SCOPED_RAW_TIMER(&stats->inverted_index_query_timer);
+    if (query_type != InvertedIndexQueryType::MATCH_ANY_QUERY &&
+        query_type != InvertedIndexQueryType::MATCH_ALL_QUERY) {
+        return Status::Error<ErrorCode::INVERTED_INDEX_NOT_SUPPORTED>();
+    }
+
+    io::Path path(_path);
+    auto index_dir = path.parent_path();
+    auto index_file_name = InvertedIndexDescriptor::get_index_file_name(path.filename(), _index_id);
+    auto index_file_path = index_dir / index_file_name;
+    if (!indexExists(index_file_path)) {
+        LOG(WARNING) << "inverted index path: " << index_file_path.string() << " not exist.";
+        return Status::Error<ErrorCode::INVERTED_INDEX_FILE_NOT_FOUND>();
+    }
+
+    std::wstring field_ws = std::wstring(column_name.begin(), column_name.end());
+    try {
+        std::vector<std::wstring> analyse_result =
+                get_analyse_result(field_ws, search_str, query_type, analyser_type);
+        if (analyse_result.empty()) {
+            return Status::Error<ErrorCode::INVERTED_INDEX_NO_TERMS>();
+        }
+
+        InvertedIndexCacheHandle inverted_index_cache_handle;
+        RETURN_IF_ERROR(InvertedIndexSearcherCache::instance()->get_index_searcher(
+                _fs, index_dir.c_str(), index_file_name, &inverted_index_cache_handle, stats));
+        auto index_searcher = inverted_index_cache_handle.get_index_searcher();
+        auto* index_reader = index_searcher->getReader();
+
+        SCOPED_RAW_TIMER(&stats->inverted_index_searcher_search_timer);
+        std::vector<std::unique_ptr<PostingCursor>> cursors;
+        std::vector<BM25Scorer> scorers;
+        for (const auto& token_ws : analyse_result) {
+            std::unique_ptr<lucene::index::Term, void (*)(lucene::index::Term*)> term {
+                    _CLNEW lucene::index::Term(field_ws.c_str(), token_ws.c_str()),
+                    [](lucene::index::Term* term) { _CLDECDELETE(term); }};
+            int32_t doc_freq = index_reader->docFreq(term.get());
+            if (doc_freq == 0) {
+                if (query_type == InvertedIndexQueryType::MATCH_ALL_QUERY) {
+                    result->clear();
+                    return Status::OK();
+                }
+                continue;
+            }
+            scorers.emplace_back(index_reader->maxDoc(), doc_freq);
+            cursors.emplace_back(new TermDocsCursor(index_reader->termDocs(term.get())));
+        }
+        collect_top_k(cursors, scorers, query_type == InvertedIndexQueryType::MATCH_ALL_QUERY, k,
+                      filter, result);
+        return Status::OK();
+    } catch (const CLuceneError& e) {
+        LOG(WARNING) << "CLuceneError occured, error msg: " << e.what();
+        return Status::Error<ErrorCode::INVERTED_INDEX_CLUCENE_ERROR>();
+    }
+}
+
 InvertedIndexReaderType FullTextIndexReader::type() {
     return InvertedIndexReaderType::FULLTEXT;
 }
@@ -258,9 +367,14 @@ Status StringTypeInvertedIndexReader::query(OlapReaderStatistics* stats,
     auto index_file_name = InvertedIndexDescriptor::get_index_file_name(path.filename(), _index_id);
     auto index_file_path = index_dir / index_file_name;
 
-    // try to get query bitmap result from cache and return immediately on cache hit
-    InvertedIndexQueryCache::CacheKey cache_key {index_file_path, column_name, query_type,
-                                                 search_str_ws};
+    // try to get query bitmap result from cache and return immediately on cache hit,
+    // the term queries are cached as EQUAL_QUERY, the same as the terms of the fulltext queries
+    bool is_term_query = query_type == InvertedIndexQueryType::MATCH_ANY_QUERY ||
+                         query_type == InvertedIndexQueryType::MATCH_ALL_QUERY ||
+                         query_type == InvertedIndexQueryType::EQUAL_QUERY;
+    InvertedIndexQueryCache::CacheKey cache_key {
+            index_file_path, column_name,
+            is_term_query ? InvertedIndexQueryType::EQUAL_QUERY : query_type, search_str_ws};
     auto cache = InvertedIndexQueryCache::instance();
     InvertedIndexQueryCacheHandle cache_handle;
     if (cache->lookup(cache_key, &cache_handle)) {
@@ -718,6 +832,19 @@ Status InvertedIndexIterator::try_read_from_inverted_index(const std::string& co
     return Status::OK();
 }
 
+Status InvertedIndexIterator::read_top_k_from_inverted_index(const std::string& column_name,
+                                                             const std::string& search_str,
+                                                             InvertedIndexQueryType query_type,
+                                                             size_t k,
+                                                             const roaring::Roaring* filter,
+                                                             std::vector<ScoredRow>* result) {
+    if (_reader->type() != InvertedIndexReaderType::FULLTEXT) {
+        return Status::Error<ErrorCode::INVERTED_INDEX_NOT_SUPPORTED>();
+    }
+    return static_cast<FullTextIndexReader*>(_reader)->query_top_k(
+            _stats, column_name, search_str, query_type, _analyser_type, k, filter, result);
+}
+
 InvertedIndexParserType InvertedIndexIterator::get_inverted_index_analyser_type() const {
     return _analyser_type;
 }
@@ -31,6 +31,7 @@
 #include "olap/olap_common.h"
 #include "olap/rowset/segment_v2/common.h"
 #include "olap/rowset/segment_v2/inverted_index_compound_reader.h"
+#include "olap/rowset/segment_v2/inverted_index_scorer.h"
 #include "olap/tablet_schema.h"
 
 namespace doris {
@@ -113,6 +114,22 @@ public:
                                                  const std::string& value,
                                                  InvertedIndexQueryType query_type,
                                                  InvertedIndexParserType analyser_type);
+
+    // The analyzer can be reused to parse many values with get_analyse_result().
+    static std::unique_ptr<lucene::analysis::Analyzer> create_analyzer(
+            InvertedIndexParserType analyser_type);
+    static std::vector<std::wstring> get_analyse_result(lucene::analysis::Analyzer* analyzer,
+                                                        const std::wstring& field_name,
+                                                        const std::string& value,
+                                                        InvertedIndexQueryType query_type,
+                                                        InvertedIndexParserType analyser_type);
+
+    // Collects the `k` rows of the highest BM25 scores of the terms of a match any or match all
+    // query among the rows of `filter`, see collect_top_k().
+    Status query_top_k(OlapReaderStatistics* stats, const std::string& column_name,
+                       const std::string& search_str, InvertedIndexQueryType query_type,
+                       InvertedIndexParserType analyser_type, size_t k,
+                       const roaring::Roaring* filter, std::vector<ScoredRow>* result);
 };
 
 class StringTypeInvertedIndexReader : public InvertedIndexReader {
@@ -218,6 +235,12 @@ public:
                                     roaring::Roaring* bit_map, bool skip_try = false);
     Status try_read_from_inverted_index(const std::string& column_name, const void* query_value,
                                         InvertedIndexQueryType query_type, uint32_t* count);
+    // Only the fulltext indexes support it, see FullTextIndexReader::query_top_k().
+    Status read_top_k_from_inverted_index(const std::string& column_name,
+                                          const std::string& search_str,
+                                          InvertedIndexQueryType query_type, size_t k,
+                                          const roaring::Roaring* filter,
+                                          std::vector<ScoredRow>* result);
 
     InvertedIndexParserType get_inverted_index_analyser_type() const;
 
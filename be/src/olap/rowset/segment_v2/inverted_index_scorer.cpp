@@ -0,0 +1,187 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/inverted_index_scorer.h"
+
+#include <algorithm>
+#include <numeric>
+#include <queue>
+
+namespace doris {
+namespace segment_v2 {
+
+namespace {
+
+// The top k rows, whose lowest one is on the top of the heap.
+class TopK {
+public:
+    explicit TopK(size_t k) : _k(k) {}
+
+    // The score a row must exceed to be collected.
+    float threshold() const {
+        return _rows.size() < _k ? -std::numeric_limits<float>::infinity() : _rows.top().score;
+    }
+
+    // Returns whether the threshold is changed. The rows are pushed in the ascending order, so a
+    // row of an equal score is lower than the collected one.
+    bool push(rowid_t row, float score) {
+        if (_rows.size() < _k) {
+            _rows.push({row, score});
+            return _rows.size() == _k;
+        }
+        if (score <= _rows.top().score) {
+            return false;
+        }
+        _rows.pop();
+        _rows.push({row, score});
+        return true;
+    }
+
+    void finish(std::vector<ScoredRow>* result) {
+        result->resize(_rows.size());
+        for (size_t i = _rows.size(); i > 0; --i) {
+            (*result)[i - 1] = _rows.top();
+            _rows.pop();
+        }
+    }
+
+private:
+    struct Lower {
+        bool operator()(const ScoredRow& lhs, const ScoredRow& rhs) const {
+            return lhs.score > rhs.score || (lhs.score == rhs.score && lhs.row < rhs.row);
+        }
+    };
+
+    size_t _k;
+    std::priority_queue<ScoredRow, std::vector<ScoredRow>, Lower> _rows;
+};
+
+void collect_any(std::vector<std::unique_ptr<PostingCursor>>& cursors,
+                 const std::vector<BM25Scorer>& scorers, const roaring::Roaring* filter,
+                 TopK* top_k) {
+    size_t num_terms = cursors.size();
+    // the terms in the ascending order of the max scores, and the sums of the max scores of the
+    // terms up to each one
+    std::vector<size_t> terms(num_terms);
+    std::iota(terms.begin(), terms.end(), 0);
+    std::sort(terms.begin(), terms.end(), [&](size_t lhs, size_t rhs) {
+        return scorers[lhs].max_score() < scorers[rhs].max_score();
+    });
+    std::vector<float> max_score_sums(num_terms);
+    float max_score_sum = 0;
+    for (size_t i = 0; i < num_terms; ++i) {
+        max_score_sum += scorers[terms[i]].max_score();
+        max_score_sums[i] = max_score_sum;
+    }
+
+    // the terms before `num_non_essential` can't make a row of the top k on their own
+    size_t num_non_essential = 0;
+    while (num_non_essential < num_terms) {
+        rowid_t row = PostingCursor::NO_MORE_ROWS;
+        for (size_t i = num_non_essential; i < num_terms; ++i) {
+            row = std::min(row, cursors[terms[i]]->row());
+        }
+        if (row == PostingCursor::NO_MORE_ROWS) {
+            break;
+        }
+        float score = 0;
+        for (size_t i = num_non_essential; i < num_terms; ++i) {
+            auto& cursor = cursors[terms[i]];
+            if (cursor->row() == row) {
+                score += scorers[terms[i]].score(cursor->freq());
+                cursor->advance(row + 1);
+            }
+        }
+        if (filter != nullptr && !filter->contains(row)) {
+            continue;
+        }
+        bool pruned = false;
+        for (size_t i = num_non_essential; i > 0; --i) {
+            if (score + max_score_sums[i - 1] <= top_k->threshold()) {
+                pruned = true;
+                break;
+            }
+            auto& cursor = cursors[terms[i - 1]];
+            if (cursor->row() < row) {
+                cursor->advance(row);
+            }
+            if (cursor->row() == row) {
+                score += scorers[terms[i - 1]].score(cursor->freq());
+            }
+        }
+        if (!pruned && top_k->push(row, score)) {
+            while (num_non_essential < num_terms &&
+                   max_score_sums[num_non_essential] <= top_k->threshold()) {
+                ++num_non_essential;
+            }
+        }
+    }
+}
+
+void collect_all(std::vector<std::unique_ptr<PostingCursor>>& cursors,
+                 const std::vector<BM25Scorer>& scorers, const roaring::Roaring* filter,
+                 TopK* top_k) {
+    rowid_t target = 0;
+    while (true) {
+        bool aligned = true;
+        for (auto& cursor : cursors) {
+            if (cursor->row() < target) {
+                cursor->advance(target);
+            }
+            if (cursor->row() != target) {
+                target = cursor->row();
+                aligned = false;
+                break;
+            }
+        }
+        if (target == PostingCursor::NO_MORE_ROWS) {
+            break;
+        }
+        if (!aligned) {
+            continue;
+        }
+        if (filter == nullptr || filter->contains(target)) {
+            float score = 0;
+            for (size_t i = 0; i < cursors.size(); ++i) {
+                score += scorers[i].score(cursors[i]->freq());
+            }
+            top_k->push(target, score);
+        }
+        ++target;
+    }
+}
+
+} // namespace
+
+void collect_top_k(std::vector<std::unique_ptr<PostingCursor>>& cursors,
+                   const std::vector<BM25Scorer>& scorers, bool all_terms, size_t k,
+                   const roaring::Roaring* filter, std::vector<ScoredRow>* result) {
+    result->clear();
+    if (cursors.empty() || k == 0) {
+        return;
+    }
+    TopK top_k(k);
+    if (all_terms) {
+        collect_all(cursors, scorers, filter, &top_k);
+    } else {
+        collect_any(cursors, scorers, filter, &top_k);
+    }
+    top_k.finish(result);
+}
+
+} // namespace segment_v2
+} // namespace doris
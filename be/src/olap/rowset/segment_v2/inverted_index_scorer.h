@@ -0,0 +1,88 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <roaring/roaring.hh>
+#include <vector>
+
+#include "olap/rowset/segment_v2/common.h"
+
+namespace doris {
+namespace segment_v2 {
+
+// A cursor over the postings of a term in a segment, in the ascending order of the rows.
+class PostingCursor {
+public:
+    static constexpr rowid_t NO_MORE_ROWS = std::numeric_limits<rowid_t>::max();
+
+    virtual ~PostingCursor() = default;
+
+    // The current row, or NO_MORE_ROWS after the last one.
+    virtual rowid_t row() const = 0;
+    // The count of the term in the current row.
+    virtual uint32_t freq() const = 0;
+    // Moves to the first row not less than `target`, which is greater than the current row.
+    virtual void advance(rowid_t target) = 0;
+};
+
+// BM25 relevance of a term in a row.
+//
+// The inverted indexes keep no norms, so the lengths of the rows are unknown and the scores are
+// not normalized by them, i.e. b = 0.
+class BM25Scorer {
+public:
+    static constexpr float DEFAULT_K1 = 1.2;
+
+    // `doc_freq` is the count of the rows of the term among `num_rows` rows.
+    BM25Scorer(uint64_t num_rows, uint64_t doc_freq, float k1 = DEFAULT_K1)
+            : _idf(std::log(1 + (num_rows - doc_freq + 0.5) / (doc_freq + 0.5))), _k1(k1) {}
+
+    float score(uint32_t freq) const { return _idf * freq * (_k1 + 1) / (freq + _k1); }
+
+    // The upper bound of the scores of any frequency.
+    float max_score() const { return _idf * (_k1 + 1); }
+
+private:
+    float _idf;
+    float _k1;
+};
+
+struct ScoredRow {
+    rowid_t row;
+    float score;
+};
+
+// Collects the `k` rows of the highest sums of the scores of the terms, in the descending order
+// of the scores, and the ascending order of the rows for the equal scores. Only the rows in
+// `filter` are collected if it's not nullptr.
+//
+// If `all_terms` is false, a row of any term is a match, and the rows are collected with
+// MaxScore (Turtle & Flood 1995): once k rows are collected, the terms whose max scores sum up to
+// no more than the k-th score can't make a row of the top k on their own, so only the rows of
+// the other terms are visited, and the others are only advanced to those rows.
+// If `all_terms` is true, only the rows of all the terms are matches.
+void collect_top_k(std::vector<std::unique_ptr<PostingCursor>>& cursors,
+                   const std::vector<BM25Scorer>& scorers, bool all_terms, size_t k,
+                   const roaring::Roaring* filter, std::vector<ScoredRow>* result);
+
+} // namespace segment_v2
+} // namespace doris
@@ -17,6 +17,7 @@
 
 #include "olap/rowset/segment_v2/ngram_bloom_filter.h"
 
+#include "olap/itoken_extractor.h"
 #include "util/cityhash102/city.h"
 #include "util/debug_util.h"
 
@@ -70,5 +71,39 @@ bool NGramBloomFilter::contains(const BloomFilter& bf_) const {
     return true;
 }
 
+std::unique_ptr<NGramBloomFilter> NGramBloomFilter::create_query_filter(const std::string& value,
+                                                                        bool like_pattern) const {
+    DCHECK_GT(_gram_size, 0);
+    std::string lowered;
+    const std::string* query = &value;
+    if (_ignore_case) {
+        // the wildcards and the escapes of LIKE are not letters
+        to_lower_ascii(value.data(), value.size(), &lowered);
+        query = &lowered;
+    }
+    auto bf = std::make_unique<NGramBloomFilter>(_size);
+    bf->set_gram_options(_gram_size, _ignore_case);
+    NgramTokenExtractor token_extractor(_gram_size);
+    if (like_pattern) {
+        if (!token_extractor.string_like_to_bloom_filter(query->data(), query->size(), *bf)) {
+            return nullptr;
+        }
+    } else {
+        if (query->size() < _gram_size) {
+            return nullptr;
+        }
+        token_extractor.string_to_bloom_filter(query->data(), query->size(), *bf);
+    }
+    return bf;
+}
+
+void NGramBloomFilter::to_lower_ascii(const char* data, size_t size, std::string* dst) {
+    dst->resize(size);
+    for (size_t i = 0; i < size; ++i) {
+        char c = data[i];
+        (*dst)[i] = (c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c;
+    }
+}
+
 } // namespace segment_v2
 } // namespace doris
@@ -17,6 +17,10 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
+#include <tuple>
+
 #include "olap/rowset/segment_v2/bloom_filter.h"
 
 namespace doris {
@@ -40,10 +44,36 @@ public:
     bool has_null() const override { return true; }
     bool is_ngram_bf() const override { return true; }
 
+    // The grams are known only if they are recorded in the index meta, which is since the
+    // segments of the per-page ngram bloom filters of the string columns.
+    void set_gram_options(uint8_t gram_size, bool ignore_case) {
+        _gram_size = gram_size;
+        _ignore_case = ignore_case;
+    }
+    // 0 if the grams are unknown
+    uint8_t gram_size() const { return _gram_size; }
+    bool ignore_case() const { return _ignore_case; }
+
+    // The filters of a query can only be tested against the filters of the same layout, which
+    // may be different among the segments.
+    using Layout = std::tuple<uint8_t, uint32_t, bool>;
+    Layout layout() const { return {_gram_size, _size, _ignore_case}; }
+
+    // Creates the filter of the ngrams of `value` in the layout of this filter, which is nullptr
+    // if `value` is shorter than a gram. If `like_pattern` is true, `value` is a pattern of LIKE,
+    // and the ngrams of its literal parts are added.
+    std::unique_ptr<NGramBloomFilter> create_query_filter(const std::string& value,
+                                                          bool like_pattern) const;
+
+    // Lowercases the ASCII letters of `data` into `dst`.
+    static void to_lower_ascii(const char* data, size_t size, std::string* dst);
+
 private:
     size_t _size;
     size_t words;
     std::vector<uint64_t> filter;
+    uint8_t _gram_size = 0;
+    bool _ignore_case = false;
 };
 
 } // namespace segment_v2
@@ -42,6 +42,14 @@ public:
     PageHandle(PageCacheHandle cache_data)
             : _is_data_owner(false), _cache_data(std::move(cache_data)) {}
 
+    // The data is not owned, e.g. it points into a mapped file which outlives this handle.
+    static PageHandle view(const Slice& data) {
+        PageHandle handle;
+        handle._is_data_view = true;
+        handle._data = data;
+        return handle;
+    }
+
     // Move constructor
     PageHandle(PageHandle&& other) noexcept
             : _is_data_owner(false),
@@ -49,10 +57,12 @@ public:
               _cache_data(std::move(other._cache_data)) {
         // we can use std::exchange if we switch c++14 on
         std::swap(_is_data_owner, other._is_data_owner);
+        std::swap(_is_data_view, other._is_data_view);
     }
 
     PageHandle& operator=(PageHandle&& other) noexcept {
         std::swap(_is_data_owner, other._is_data_owner);
+        std::swap(_is_data_view, other._is_data_view);
         _data = std::move(other._data);
         _cache_data = std::move(other._cache_data);
         return *this;
@@ -66,7 +76,7 @@ public:
 
     // the return slice contains uncompressed page body, page footer, and footer size
     Slice data() const {
-        if (_is_data_owner) {
+        if (_is_data_owner || _is_data_view) {
             return _data;
         } else {
             return _cache_data.data();
@@ -77,6 +87,8 @@ private:
     // when this is true, it means this struct own data and _data is valid.
     // otherwise _cache_data is valid, and data is belong to cache.
     bool _is_data_owner = false;
+    // when this is true, _data is valid but not owned.
+    bool _is_data_view = false;
     Slice _data;
     PageCacheHandle _cache_data;
 
@@ -22,19 +22,36 @@
 
 #include "common/logging.h"
 #include "gutil/strings/substitute.h"
+#include "io/fs/file_system.h"
 #include "io/fs/file_writer.h"
 #include "olap/page_cache.h"
+#include "runtime/thread_context.h"
 #include "util/block_compression.h"
 #include "util/coding.h"
 #include "util/crc32c.h"
+#include "util/doris_metrics.h"
 #include "util/faststring.h"
 #include "util/runtime_profile.h"
+#include "util/stopwatch.hpp"
+#include "util/time.h"
 
 namespace doris {
 namespace segment_v2 {
 
 using strings::Substitute;
 
+// the encoding of the data page, which may be other than the encoding of its column
+static Status page_encoding_info(const PageReadOptions& opts, const PageFooterPB& footer,
+                                 const EncodingInfo** encoding_info) {
+    *encoding_info = opts.encoding_info;
+    if (opts.encoding_info != nullptr && footer.has_data_page_footer() &&
+        footer.data_page_footer().has_encoding()) {
+        return EncodingInfo::get(opts.encoding_info->type(), footer.data_page_footer().encoding(),
+                                 encoding_info);
+    }
+    return Status::OK();
+}
+
 Status PageIO::compress_page_body(BlockCompressionCodec* codec, double min_space_saving,
                                   const std::vector<Slice>& body, OwnedSlice* compressed_body) {
     size_t uncompressed_size = Slice::compute_total_size(body);
@@ -100,11 +117,27 @@ Status PageIO::write_page(io::FileWriter* writer, const std::vector<Slice>& body
     return Status::OK();
 }
 
+static void count_page_cache_lookup(bool hit) {
+    if (io::IOStatistics* io_stats = thread_context()->io_statistics; io_stats != nullptr) {
+        io::IOStatistics::add(hit ? io_stats->storage_page_cache_hits
+                                  : io_stats->storage_page_cache_misses,
+                              1);
+    }
+}
+
 Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle* handle,
                                         Slice* body, PageFooterPB* footer) {
     opts.sanity_check();
     opts.stats->total_pages_num++;
 
+    if (opts.type == DATA_PAGE && opts.file_reader->mapped_data() != nullptr) {
+        bool mapped = false;
+        RETURN_IF_ERROR(_read_mapped_page(opts, handle, body, footer, &mapped));
+        if (mapped) {
+            return Status::OK();
+        }
+    }
+
     auto cache = StoragePageCache::instance();
     PageCacheHandle cache_handle;
     StoragePageCache::CacheKey cache_key(opts.file_reader->path().native(),
@@ -114,6 +147,7 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
         // we find page in cache, use it
         *handle = PageHandle(std::move(cache_handle));
         opts.stats->cached_pages_num++;
+        count_page_cache_lookup(true);
         // parse body and footer
         Slice page_slice = handle->data();
         uint32_t footer_size = decode_fixed32_le((uint8_t*)page_slice.data + page_slice.size - 4);
@@ -134,14 +168,93 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
     // hold compressed page at first, reset to decompressed page later
     std::unique_ptr<char[]> page(new char[page_size]);
     Slice page_slice(page.get(), page_size);
+    if (opts.use_page_cache && opts.type == DATA_PAGE && cache->is_compressed_cache_available() &&
+        cache->lookup_compressed(cache_key, &cache_handle)) {
+        // decompressed page was evicted, but the compressed one is still in memory
+        DCHECK_EQ(cache_handle.data().size, page_size);
+        memcpy(page_slice.data, cache_handle.data().data, page_size);
+        cache_handle = PageCacheHandle();
+        opts.stats->compressed_cached_pages_num++;
+        count_page_cache_lookup(true);
+        return _decompress_page(opts, std::move(page), handle, body, footer, false);
+    }
+    if (opts.use_page_cache && cache->is_cache_available(opts.type)) {
+        count_page_cache_lookup(false);
+    }
     {
         SCOPED_RAW_TIMER(&opts.stats->io_ns);
+        MonotonicStopWatch watch;
+        watch.start();
         size_t bytes_read = 0;
         RETURN_IF_ERROR(opts.file_reader->read_at(opts.page_pointer.offset, page_slice, &bytes_read,
                                                   &opts.io_ctx));
         DCHECK_EQ(bytes_read, page_size);
+        auto fs = opts.file_reader->fs();
+        auto* latency = fs == nullptr || fs->type() == io::FileSystemType::LOCAL
+                                ? DorisMetrics::instance()->local_page_read_latency_us
+                                : DorisMetrics::instance()->remote_page_read_latency_us;
+        latency->add(watch.elapsed_time() / NANOS_PER_MICRO);
         opts.stats->compressed_bytes_read += page_size;
     }
+    return _decompress_page(opts, std::move(page), handle, body, footer, true);
+}
+
+Status PageIO::_read_mapped_page(const PageReadOptions& opts, PageHandle* handle, Slice* body,
+                                 PageFooterPB* footer, bool* mapped) {
+    *mapped = false;
+    const uint32_t page_size = opts.page_pointer.size;
+    if (page_size < 8) {
+        return Status::Corruption("Bad page: too small size ({})", page_size);
+    }
+    if (opts.page_pointer.offset + page_size > opts.file_reader->size()) {
+        return Status::Corruption("Bad page: offset {} and size {} exceed file size {}",
+                                  opts.page_pointer.offset, page_size, opts.file_reader->size());
+    }
+    Slice page_slice(opts.file_reader->mapped_data() + opts.page_pointer.offset, page_size);
+    if (opts.verify_checksum) {
+        uint32_t expect = decode_fixed32_le((uint8_t*)page_slice.data + page_slice.size - 4);
+        uint32_t actual = crc32c::Value(page_slice.data, page_slice.size - 4);
+        if (expect != actual) {
+            return Status::Corruption("Bad page: checksum mismatch (actual={} vs expect={})",
+                                      actual, expect);
+        }
+    }
+    // remove checksum suffix
+    page_slice.size -= 4;
+    uint32_t footer_size = decode_fixed32_le((uint8_t*)page_slice.data + page_slice.size - 4);
+    if (!footer->ParseFromArray(page_slice.data + page_slice.size - 4 - footer_size, footer_size)) {
+        return Status::Corruption("Bad page: invalid footer");
+    }
+    uint32_t body_size = page_slice.size - 4 - footer_size;
+    if (body_size != footer->uncompressed_size()) {
+        return Status::OK();
+    }
+    const EncodingInfo* encoding_info = nullptr;
+    RETURN_IF_ERROR(page_encoding_info(opts, *footer, &encoding_info));
+    if (opts.pre_decode && encoding_info && encoding_info->get_data_page_pre_decoder() != nullptr) {
+        return Status::OK();
+    }
+    opts.stats->mapped_pages_num++;
+    opts.stats->uncompressed_bytes_read += body_size;
+    *body = Slice(page_slice.data, body_size);
+    *handle = PageHandle::view(page_slice);
+    *mapped = true;
+    return Status::OK();
+}
+
+Status PageIO::decompress_page(const PageReadOptions& opts, std::unique_ptr<char[]> page,
+                               PageHandle* handle, Slice* body, PageFooterPB* footer) {
+    return _decompress_page(opts, std::move(page), handle, body, footer, true);
+}
+
+Status PageIO::_decompress_page(const PageReadOptions& opts, std::unique_ptr<char[]> page,
+                                PageHandle* handle, Slice* body, PageFooterPB* footer,
+                                bool fill_compressed_cache) {
+    const uint32_t page_size = opts.page_pointer.size;
+    if (page_size < 8) {
+        return Status::Corruption("Bad page: too small size ({})", page_size);
+    }
+    Slice page_slice(page.get(), page_size);
 
     if (opts.verify_checksum) {
         uint32_t expect = decode_fixed32_le((uint8_t*)page_slice.data + page_slice.size - 4);
@@ -160,11 +273,18 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
         return Status::Corruption("Bad page: invalid footer");
     }
 
+    auto cache = StoragePageCache::instance();
     uint32_t body_size = page_slice.size - 4 - footer_size;
     if (body_size != footer->uncompressed_size()) { // need decompress body
         if (opts.codec == nullptr) {
             return Status::Corruption("Bad page: page is compressed but codec is NO_COMPRESSION");
         }
+        if (fill_compressed_cache && opts.use_page_cache && opts.fill_page_cache &&
+            opts.type == DATA_PAGE && cache->is_compressed_cache_available()) {
+            StoragePageCache::CacheKey cache_key(opts.file_reader->path().native(),
+                                                 opts.page_pointer.offset);
+            cache->insert_compressed(cache_key, Slice(page_slice.data, page_size));
+        }
         SCOPED_RAW_TIMER(&opts.stats->decompress_ns);
         std::unique_ptr<char[]> decompressed_page(
                 new char[footer->uncompressed_size() + footer_size + 4]);
@@ -189,8 +309,10 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
         opts.stats->uncompressed_bytes_read += body_size;
     }
 
-    if (opts.pre_decode && opts.encoding_info) {
-        auto* pre_decoder = opts.encoding_info->get_data_page_pre_decoder();
+    const EncodingInfo* encoding_info = nullptr;
+    RETURN_IF_ERROR(page_encoding_info(opts, *footer, &encoding_info));
+    if (opts.pre_decode && encoding_info) {
+        auto* pre_decoder = encoding_info->get_data_page_pre_decoder();
         if (pre_decoder) {
             RETURN_IF_ERROR(pre_decoder->decode(
                     &page, &page_slice,
@@ -199,8 +321,11 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
     }
 
     *body = Slice(page_slice.data, page_slice.size - 4 - footer_size);
-    if (opts.use_page_cache && cache->is_cache_available(opts.type)) {
+    if (opts.use_page_cache && opts.fill_page_cache && cache->is_cache_available(opts.type)) {
         // insert this page into cache and return the cache handle
+        PageCacheHandle cache_handle;
+        StoragePageCache::CacheKey cache_key(opts.file_reader->path().native(),
+                                             opts.page_pointer.offset);
         cache->insert(cache_key, page_slice, &cache_handle, opts.type, opts.kept_in_memory);
         *handle = PageHandle(std::move(cache_handle));
     } else {
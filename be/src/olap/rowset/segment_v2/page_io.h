@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "common/logging.h"
@@ -58,6 +59,8 @@ struct PageReadOptions {
     bool verify_checksum = true;
     // whether to use page cache in read path
     bool use_page_cache = true;
+    // if false, the page read from file is not inserted into page cache
+    bool fill_page_cache = true;
     // if true, use DURABLE CachePriority in page cache
     // currently used for in memory olap table
     bool kept_in_memory = false;
@@ -121,6 +124,23 @@ public:
     //     `footer' stores the page footer.
     static Status read_and_decompress_page(const PageReadOptions& opts, PageHandle* handle,
                                            Slice* body, PageFooterPB* footer);
+
+    // Same as read_and_decompress_page, but the raw page located by `opts.page_pointer'
+    // has already been read into `page', e.g. by a coalesced read of several pages.
+    // Page cache is not looked up, but the page is inserted into it if `opts' allows.
+    static Status decompress_page(const PageReadOptions& opts, std::unique_ptr<char[]> page,
+                                  PageHandle* handle, Slice* body, PageFooterPB* footer);
+
+private:
+    // Point `handle' into the mapped file of `opts.file_reader' if the page needs neither
+    // decompression nor pre-decode, `*mapped' is false otherwise.
+    static Status _read_mapped_page(const PageReadOptions& opts, PageHandle* handle, Slice* body,
+                                    PageFooterPB* footer, bool* mapped);
+
+    // `fill_compressed_cache' is false when `page' comes from the compressed page cache.
+    static Status _decompress_page(const PageReadOptions& opts, std::unique_ptr<char[]> page,
+                                   PageHandle* handle, Slice* body, PageFooterPB* footer,
+                                   bool fill_compressed_cache);
 };
 
 } // namespace segment_v2
@@ -0,0 +1,177 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#include "olap/rowset/segment_v2/page_prefetcher.h"
+
+#include <cstring>
+
+#include "common/config.h"
+#include "io/fs/file_system.h"
+#include "olap/olap_common.h"
+#include "olap/page_cache.h"
+#include "olap/rowset/segment_v2/column_reader.h"
+#include "runtime/exec_env.h"
+#include "util/threadpool.h"
+
+namespace doris {
+namespace segment_v2 {
+
+PagePrefetcher::PagePrefetcher(const PageReadOptions& read_opts, int depth)
+        : _read_opts(read_opts), _stats(read_opts.stats), _depth(depth) {
+    // the reads run in other threads, which must not touch the stats of the iterator
+    _read_opts.stats = nullptr;
+    _read_opts.io_ctx.file_cache_stats = nullptr;
+}
+
+PagePrefetcher::~PagePrefetcher() {
+    std::unique_lock<std::mutex> l(_lock);
+    _cv.wait(l, [this] { return _running_tasks == 0; });
+}
+
+bool PagePrefetcher::need_prefetch(const ColumnIteratorOptions& opts) {
+    if (config::remote_page_prefetch_depth <= 0 || !opts.use_page_cache ||
+        !opts.fill_page_cache) {
+        return false;
+    }
+    auto cache = StoragePageCache::instance();
+    if (cache == nullptr || !cache->is_cache_available(DATA_PAGE) ||
+        ExecEnv::GetInstance()->remote_page_prefetch_thread_pool() == nullptr) {
+        return false;
+    }
+    auto fs = opts.file_reader->fs();
+    return fs != nullptr && fs->type() != io::FileSystemType::LOCAL;
+}
+
+void PagePrefetcher::wait_for_page(const PagePointer& pp) {
+    std::unique_lock<std::mutex> l(_lock);
+    _cv.wait(l, [&] { return _reading_pages.count(pp.offset) == 0; });
+    if (_prefetched_pages.erase(pp.offset) > 0) {
+        _stats->remote_page_prefetch_hit_num++;
+    } else {
+        _stats->remote_page_prefetch_miss_num++;
+    }
+}
+
+bool PagePrefetcher::has_page(const PagePointer& pp) {
+    std::lock_guard<std::mutex> l(_lock);
+    return _reading_pages.count(pp.offset) > 0 || _prefetched_pages.count(pp.offset) > 0;
+}
+
+void PagePrefetcher::prefetch_pages_after(const OrdinalPageIndexIterator& iter) {
+    const int end_page_index = iter.page_index() + 1 + _depth;
+    auto next = iter;
+    next.next();
+    std::vector<PagePointer> pages;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        while (next.valid() && next.page_index() < end_page_index &&
+               (_reading_pages.count(next.page().offset) > 0 ||
+                _prefetched_pages.count(next.page().offset) > 0)) {
+            next.next();
+        }
+        if (!next.valid() || next.page_index() > iter.page_index() + (_depth + 1) / 2) {
+            // enough pages ahead
+            return;
+        }
+        auto cache = StoragePageCache::instance();
+        for (; next.valid() && next.page_index() < end_page_index; next.next()) {
+            const PagePointer& pp = next.page();
+            if (_reading_pages.count(pp.offset) > 0 || _prefetched_pages.count(pp.offset) > 0) {
+                continue;
+            }
+            PageCacheHandle cache_handle;
+            StoragePageCache::CacheKey cache_key(_read_opts.file_reader->path().native(),
+                                                 pp.offset);
+            if (cache->lookup(cache_key, &cache_handle, DATA_PAGE) ||
+                (cache->is_compressed_cache_available() &&
+                 cache->lookup_compressed(cache_key, &cache_handle))) {
+                continue;
+            }
+            if (!pages.empty() && pages.back().offset + pages.back().size != pp.offset) {
+                _submit(std::move(pages));
+                pages.clear();
+            }
+            _reading_pages.insert(pp.offset);
+            pages.push_back(pp);
+        }
+        if (!pages.empty()) {
+            _submit(std::move(pages));
+        }
+    }
+}
+
+// _lock is held by the caller
+void PagePrefetcher::_submit(std::vector<PagePointer> pages) {
+    ++_running_tasks;
+    auto st = ExecEnv::GetInstance()->remote_page_prefetch_thread_pool()->submit_func(
+            [this, pages]() { _read_pages(pages); });
+    if (!st.ok()) {
+        --_running_tasks;
+        for (auto& pp : pages) {
+            _reading_pages.erase(pp.offset);
+        }
+    }
+}
+
+void PagePrefetcher::_read_pages(const std::vector<PagePointer>& pages) {
+    Status st = _do_read_pages(pages);
+    if (!st.ok()) {
+        LOG(WARNING) << "failed to prefetch pages of " << _read_opts.file_reader->path().native()
+                     << ", error: " << st;
+    }
+    std::lock_guard<std::mutex> l(_lock);
+    for (auto& pp : pages) {
+        _reading_pages.erase(pp.offset);
+        if (st.ok()) {
+            _prefetched_pages.insert(pp.offset);
+        }
+    }
+    --_running_tasks;
+    // notify under the lock, the prefetcher may be destroyed once the lock is released
+    _cv.notify_all();
+}
+
+Status PagePrefetcher::_do_read_pages(const std::vector<PagePointer>& pages) {
+    const uint64_t offset = pages.front().offset;
+    const size_t size = pages.back().offset + pages.back().size - offset;
+    std::unique_ptr<char[]> buf(new char[size]);
+    size_t bytes_read = 0;
+    RETURN_IF_ERROR(_read_opts.file_reader->read_at(offset, Slice(buf.get(), size), &bytes_read,
+                                                    &_read_opts.io_ctx));
+    if (bytes_read != size) {
+        return Status::IOError("short read at offset {}, expect {} bytes but read {}", offset,
+                               size, bytes_read);
+    }
+
+    OlapReaderStatistics stats;
+    PageReadOptions opts = _read_opts;
+    opts.stats = &stats;
+    for (auto& pp : pages) {
+        std::unique_ptr<char[]> page(new char[pp.size]);
+        memcpy(page.get(), buf.get() + (pp.offset - offset), pp.size);
+        opts.page_pointer = pp;
+        PageHandle handle;
+        Slice body;
+        PageFooterPB footer;
+        RETURN_IF_ERROR(PageIO::decompress_page(opts, std::move(page), &handle, &body, &footer));
+    }
+    return Status::OK();
+}
+
+} // namespace segment_v2
+} // namespace doris
@@ -0,0 +1,90 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#include "common/status.h"
+#include "olap/rowset/segment_v2/ordinal_page_index.h"
+#include "olap/rowset/segment_v2/page_io.h"
+#include "olap/rowset/segment_v2/page_pointer.h"
+
+namespace doris {
+
+struct OlapReaderStatistics;
+
+namespace segment_v2 {
+
+struct ColumnIteratorOptions;
+
+// PagePrefetcher reads the data pages following the current page of a FileColumnIterator
+// in background, when the segment is on remote storage (S3/HDFS), so that the iterator
+// finds them in StoragePageCache instead of waiting for a remote read on every page.
+//
+// The pages to read are located by the ordinal index. Adjacent pages are read by one
+// range read, then verified, decompressed and inserted into page cache one by one.
+//
+// All methods except the destructor are called by the thread of the iterator.
+class PagePrefetcher {
+public:
+    // `read_opts' are the options to read a data page of the column, page_pointer aside.
+    // At most `depth' pages after the current page are prefetched.
+    PagePrefetcher(const PageReadOptions& read_opts, int depth);
+
+    // Waits for the running reads, which refer to the file reader and the stats.
+    ~PagePrefetcher();
+
+    // Whether the data pages read by `opts' should be prefetched.
+    static bool need_prefetch(const ColumnIteratorOptions& opts);
+
+    // Called before the iterator reads the page `pp'. Waits the prefetch of this page if
+    // it is still running, and counts the page as a prefetch hit or miss.
+    void wait_for_page(const PagePointer& pp);
+
+    // Called after the iterator has read the page of `iter', schedules the reads of the
+    // following pages once less than half of the depth is left ahead.
+    void prefetch_pages_after(const OrdinalPageIndexIterator& iter);
+
+    // Whether the page `pp' is being prefetched or has been prefetched.
+    bool has_page(const PagePointer& pp);
+
+private:
+    void _read_pages(const std::vector<PagePointer>& pages);
+    Status _do_read_pages(const std::vector<PagePointer>& pages);
+    void _submit(std::vector<PagePointer> pages);
+
+    PageReadOptions _read_opts;
+    // stats of the iterator, only updated by its thread
+    OlapReaderStatistics* _stats;
+    const int _depth;
+
+    std::mutex _lock;
+    std::condition_variable _cv;
+    // offsets of the pages being read
+    std::unordered_set<uint64_t> _reading_pages;
+    // offsets of the pages put into page cache but not read by the iterator yet
+    std::unordered_set<uint64_t> _prefetched_pages;
+    int _running_tasks = 0;
+};
+
+} // namespace segment_v2
+} // namespace doris
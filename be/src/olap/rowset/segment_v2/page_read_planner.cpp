@@ -0,0 +1,158 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#include "olap/rowset/segment_v2/page_read_planner.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "olap/olap_common.h"
+#include "olap/page_cache.h"
+#include "util/runtime_profile.h"
+
+namespace doris {
+namespace segment_v2 {
+
+void PageReadPlanner::add_page(const PageReadOptions& opts) {
+    auto cache = StoragePageCache::instance();
+    if (!opts.use_page_cache || !opts.fill_page_cache || cache == nullptr ||
+        !cache->is_cache_available(opts.type)) {
+        return;
+    }
+    if (opts.file_reader->mapped_data() != nullptr) {
+        // the pages are read from the mapping
+        return;
+    }
+    PageCacheHandle cache_handle;
+    StoragePageCache::CacheKey cache_key(opts.file_reader->path().native(),
+                                         opts.page_pointer.offset);
+    if (cache->lookup(cache_key, &cache_handle, opts.type)) {
+        return;
+    }
+    if (opts.type == DATA_PAGE && cache->is_compressed_cache_available() &&
+        cache->lookup_compressed(cache_key, &cache_handle)) {
+        // no IO is needed to decompress it again
+        return;
+    }
+    _pages.push_back(opts);
+}
+
+Status PageReadPlanner::read_pages(OlapReaderStatistics* stats) {
+    if (_pages.size() < 2) {
+        _pages.clear();
+        return Status::OK();
+    }
+    std::sort(_pages.begin(), _pages.end(), [](const PageReadOptions& a, const PageReadOptions& b) {
+        return a.page_pointer.offset < b.page_pointer.offset;
+    });
+
+    // [begin, end) of the pages of each merged read
+    std::vector<std::pair<size_t, size_t>> merged_reads;
+    size_t begin = 0;
+    uint64_t read_end = _pages[0].page_pointer.offset + _pages[0].page_pointer.size;
+    for (size_t i = 1; i <= _pages.size(); ++i) {
+        if (i < _pages.size()) {
+            const PagePointer& pp = _pages[i].page_pointer;
+            if (pp.offset < read_end) {
+                // the same page is added twice, or the page is broken
+                _pages[i].page_pointer.size = 0;
+                continue;
+            }
+            if (pp.offset - read_end <= _max_gap &&
+                pp.offset + pp.size - _pages[begin].page_pointer.offset <= _max_read_size) {
+                read_end = pp.offset + pp.size;
+                continue;
+            }
+        }
+        if (i - begin > 1) {
+            merged_reads.emplace_back(begin, i);
+        }
+        if (i < _pages.size()) {
+            begin = i;
+            read_end = _pages[i].page_pointer.offset + _pages[i].page_pointer.size;
+        }
+    }
+    // the merged reads of the same file are issued together
+    Status st;
+    for (size_t i = 0, j = 1; i < merged_reads.size() && st.ok(); i = j++) {
+        auto* file_reader = _pages[merged_reads[i].first].file_reader;
+        while (j < merged_reads.size() &&
+               _pages[merged_reads[j].first].file_reader == file_reader) {
+            ++j;
+        }
+        st = _read_merged_pages(merged_reads.data() + i, j - i, stats);
+    }
+    _pages.clear();
+    return st;
+}
+
+Status PageReadPlanner::_read_merged_pages(const std::pair<size_t, size_t>* merged_reads,
+                                           size_t num_reads, OlapReaderStatistics* stats) {
+    std::vector<std::unique_ptr<char[]>> bufs(num_reads);
+    std::vector<io::FileReader::ReadRange> ranges;
+    ranges.reserve(num_reads);
+    for (size_t r = 0; r < num_reads; ++r) {
+        auto [begin, end] = merged_reads[r];
+        const uint64_t offset = _pages[begin].page_pointer.offset;
+        size_t size = 0;
+        for (size_t i = begin; i < end; ++i) {
+            const PagePointer& pp = _pages[i].page_pointer;
+            size = std::max<size_t>(size, pp.offset + pp.size - offset);
+        }
+        bufs[r].reset(new char[size]);
+        ranges.push_back({offset, Slice(bufs[r].get(), size)});
+    }
+    {
+        SCOPED_RAW_TIMER(&stats->io_ns);
+        const PageReadOptions& first = _pages[merged_reads[0].first];
+        RETURN_IF_ERROR(first.file_reader->read_ranges(&ranges, &first.io_ctx));
+        for (auto& range : ranges) {
+            if (range.bytes_read != range.result.size) {
+                return Status::IOError("short read at offset {}, expect {} bytes but read {}",
+                                       range.offset, range.result.size, range.bytes_read);
+            }
+            stats->compressed_bytes_read += range.result.size;
+        }
+    }
+    stats->merged_page_read_num += num_reads;
+
+    for (size_t r = 0; r < num_reads; ++r) {
+        auto [begin, end] = merged_reads[r];
+        const uint64_t offset = ranges[r].offset;
+        for (size_t i = begin; i < end; ++i) {
+            PageReadOptions& opts = _pages[i];
+            const PagePointer& pp = opts.page_pointer;
+            if (pp.size == 0) {
+                continue;
+            }
+            std::unique_ptr<char[]> page(new char[pp.size]);
+            memcpy(page.get(), bufs[r].get() + (pp.offset - offset), pp.size);
+            opts.stats = stats;
+            PageHandle handle;
+            Slice body;
+            PageFooterPB footer;
+            RETURN_IF_ERROR(
+                    PageIO::decompress_page(opts, std::move(page), &handle, &body, &footer));
+            stats->merged_pages_num++;
+        }
+    }
+    return Status::OK();
+}
+
+} // namespace segment_v2
+} // namespace doris
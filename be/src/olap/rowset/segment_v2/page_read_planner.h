@@ -0,0 +1,65 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "common/status.h"
+#include "olap/rowset/segment_v2/page_io.h"
+
+namespace doris {
+
+struct OlapReaderStatistics;
+
+namespace segment_v2 {
+
+// PageReadPlanner reads the data pages of many columns of a segment with a few large
+// reads instead of one small read per page. The column iterators add the pages they
+// are going to read, then the planner merges the pages which are adjacent or at most
+// `max_gap' bytes apart into one read, decodes them and inserts them into
+// StoragePageCache, where the column iterators find them.
+//
+// Pages which can not be merged with others are left to the column iterators.
+class PageReadPlanner {
+public:
+    // A merged read is not larger than `max_read_size' bytes.
+    PageReadPlanner(size_t max_gap, size_t max_read_size)
+            : _max_gap(max_gap), _max_read_size(max_read_size) {}
+
+    // Add a data page to read, located by `opts.page_pointer'. The page is ignored if
+    // it can not be put into page cache, or it is in page cache already.
+    void add_page(const PageReadOptions& opts);
+
+    // Read the added pages with merged reads, then clear them.
+    Status read_pages(OlapReaderStatistics* stats);
+
+private:
+    // Reads the merged reads of the same file at once, each of which is [begin, end) of _pages.
+    Status _read_merged_pages(const std::pair<size_t, size_t>* merged_reads, size_t num_reads,
+                              OlapReaderStatistics* stats);
+
+    const size_t _max_gap;
+    const size_t _max_read_size;
+    std::vector<PageReadOptions> _pages;
+};
+
+} // namespace segment_v2
+} // namespace doris
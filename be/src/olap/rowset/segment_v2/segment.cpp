@@ -19,7 +19,9 @@
 
 #include <gen_cpp/olap_file.pb.h>
 
+#include <algorithm>
 #include <memory>
+#include <set>
 #include <utility>
 
 #include "common/config.h"
@@ -27,6 +29,7 @@
 #include "io/cache/file_cache_manager.h"
 #include "io/fs/file_reader_options.h"
 #include "io/fs/file_system.h"
+#include "io/fs/local_file_reader.h"
 #include "olap/iterators.h"
 #include "olap/rowset/segment_v2/empty_segment_iterator.h"
 #include "olap/rowset/segment_v2/page_io.h"
@@ -44,6 +47,9 @@ namespace segment_v2 {
 
 using io::FileCacheManager;
 
+// the bytes of the in-memory primary key indexes of all the segments
+static std::atomic<int64_t> s_pk_memory_index_bytes {0};
+
 Status Segment::open(io::FileSystemSPtr fs, const std::string& path, uint32_t segment_id,
                      RowsetId rowset_id, TabletSchemaSPtr tablet_schema,
                      const io::FileReaderOptions& reader_options,
@@ -60,6 +66,12 @@ Status Segment::open(io::FileSystemSPtr fs, const std::string& path, uint32_t se
         RETURN_IF_ERROR(fs->open_file(path, reader_options, &file_reader));
     }
 #endif
+    if (config::enable_segment_mmap_read) {
+        // the data pages can then be read without copy, remote files are read as before
+        if (auto local_reader = dynamic_cast<io::LocalFileReader*>(file_reader.get())) {
+            WARN_IF_ERROR(local_reader->map(), "fall back to pread");
+        }
+    }
 
     std::shared_ptr<Segment> segment(new Segment(segment_id, rowset_id, tablet_schema));
     segment->_file_reader = std::move(file_reader);
@@ -76,6 +88,9 @@ Segment::Segment(uint32_t segment_id, RowsetId rowset_id, TabletSchemaSPtr table
           _segment_meta_mem_tracker(StorageEngine::instance()->segment_meta_mem_tracker()) {}
 
 Segment::~Segment() {
+    if (_pk_memory_index != nullptr) {
+        s_pk_memory_index_bytes.fetch_sub(_pk_memory_index->memory_size());
+    }
 #ifndef BE_TEST
     _segment_meta_mem_tracker->release(_meta_mem_usage);
 #endif
@@ -97,8 +112,10 @@ Status Segment::new_iterator(const Schema& schema, const StorageReadOptions& rea
         if (_tablet_schema->num_columns() <= column_id) {
             continue;
         }
-        int32_t uid = read_options.tablet_schema->column(column_id).unique_id();
-        if (_column_readers.count(uid) < 1 || !_column_readers.at(uid)->has_zone_map()) {
+        const TabletColumn& column = read_options.tablet_schema->column(column_id);
+        int32_t uid = column.unique_id();
+        if (_column_readers.count(uid) < 1 || !_column_readers.at(uid)->has_zone_map() ||
+            _is_widened(column)) {
             continue;
         }
         if (read_options.col_id_to_predicates.count(column_id) > 0 &&
@@ -114,12 +131,13 @@ Status Segment::new_iterator(const Schema& schema, const StorageReadOptions& rea
         auto query_ctx = read_options.runtime_state->get_query_fragments_ctx();
         auto runtime_predicate = query_ctx->get_runtime_predicate().get_predictate();
         if (runtime_predicate) {
-            int32_t uid =
-                    read_options.tablet_schema->column(runtime_predicate->column_id()).unique_id();
+            const TabletColumn& column =
+                    read_options.tablet_schema->column(runtime_predicate->column_id());
+            int32_t uid = column.unique_id();
             AndBlockColumnPredicate and_predicate;
             auto single_predicate = new SingleColumnBlockPredicate(runtime_predicate.get());
             and_predicate.add_column_predicate(single_predicate);
-            if (!_column_readers.at(uid)->match_condition(&and_predicate)) {
+            if (!_is_widened(column) && !_column_readers.at(uid)->match_condition(&and_predicate)) {
                 // any condition not satisfied, return.
                 iter->reset(new EmptySegmentIterator(schema));
                 read_options.stats->filtered_segment_number++;
@@ -128,14 +146,77 @@ Status Segment::new_iterator(const Schema& schema, const StorageReadOptions& rea
         }
     }
 
+    // the delete conditions which can't delete any row of this segment are not evaluated on
+    // its rows
+    const StorageReadOptions* options = &read_options;
+    std::unique_ptr<StorageReadOptions> pruned_options;
+    if (auto delete_conditions = _prune_delete_conditions(read_options)) {
+        pruned_options.reset(new StorageReadOptions(read_options));
+        pruned_options->delete_condition_predicates = std::move(delete_conditions);
+        options = pruned_options.get();
+    }
+
     RETURN_IF_ERROR(load_index());
-    if (read_options.delete_condition_predicates->num_of_column_predicate() == 0 &&
-        read_options.push_down_agg_type_opt != TPushAggOp::NONE) {
+    if (options->delete_condition_predicates->num_of_column_predicate() == 0 &&
+        options->push_down_agg_type_opt != TPushAggOp::NONE) {
         iter->reset(vectorized::new_vstatistics_iterator(this->shared_from_this(), schema));
     } else {
         iter->reset(new SegmentIterator(this->shared_from_this(), schema));
     }
-    return iter->get()->init(read_options);
+    return iter->get()->init(*options);
+}
+
+std::shared_ptr<AndBlockColumnPredicate> Segment::_prune_delete_conditions(
+        const StorageReadOptions& read_options) const {
+    const AndBlockColumnPredicate& delete_conditions = *read_options.delete_condition_predicates;
+    std::vector<std::set<const ColumnPredicate*>> kept_conditions;
+    for (size_t i = 0; i < delete_conditions.num_of_column_predicate(); ++i) {
+        std::set<const ColumnPredicate*> predicates;
+        delete_conditions.column_predicate(i)->get_all_column_predicate(predicates);
+        // the rows deleted by a condition match all of its predicates
+        auto may_delete = [&](const ColumnPredicate* pred) {
+            return _may_delete(read_options, pred);
+        };
+        if (std::all_of(predicates.begin(), predicates.end(), may_delete)) {
+            kept_conditions.push_back(std::move(predicates));
+        }
+    }
+    if (kept_conditions.size() == delete_conditions.num_of_column_predicate()) {
+        return nullptr;
+    }
+
+    // built in the same way as DeleteHandler::get_delete_conditions_after_version
+    auto pruned = std::make_shared<AndBlockColumnPredicate>();
+    for (auto& predicates : kept_conditions) {
+        if (predicates.size() == 1) {
+            pruned->add_column_predicate(new SingleColumnBlockPredicate(*predicates.begin()));
+        } else {
+            auto or_column_predicate = new OrBlockColumnPredicate();
+            for (auto pred : predicates) {
+                or_column_predicate->add_column_predicate(new SingleColumnBlockPredicate(pred));
+            }
+            pruned->add_column_predicate(or_column_predicate);
+        }
+    }
+    read_options.stats->pruned_delete_condition_number +=
+            delete_conditions.num_of_column_predicate() - kept_conditions.size();
+    return pruned;
+}
+
+bool Segment::_may_delete(const StorageReadOptions& read_options,
+                          const ColumnPredicate* pred) const {
+    int32_t column_id = pred->column_id();
+    // schema change
+    if (_tablet_schema->num_columns() <= column_id) {
+        return true;
+    }
+    const TabletColumn& column = read_options.tablet_schema->column(column_id);
+    auto reader = _column_readers.find(column.unique_id());
+    if (reader == _column_readers.end() || !reader->second->has_zone_map() ||
+        _is_widened(column)) {
+        return true;
+    }
+    return reader->second->may_delete(pred);
 }
 
 Status Segment::_parse_footer() {
@@ -285,14 +366,29 @@ Status Segment::new_column_iterator(const TabletColumn& tablet_column, ColumnIte
         *iter = default_value_iter.release();
         return Status::OK();
     }
-    return _column_readers.at(tablet_column.unique_id())->new_iterator(iter);
+    auto& reader = _column_readers.at(tablet_column.unique_id());
+    if (_is_widened(tablet_column)) {
+        ColumnIterator* file_iter = nullptr;
+        RETURN_IF_ERROR(reader->new_iterator(&file_iter));
+        *iter = new WideningColumnIterator(std::unique_ptr<ColumnIterator>(file_iter),
+                                           reader->get_field_type(), tablet_column.type());
+        return Status::OK();
+    }
+    return reader->new_iterator(iter);
+}
+
+bool Segment::_is_widened(const TabletColumn& tablet_column) const {
+    auto iter = _column_readers.find(tablet_column.unique_id());
+    return iter != _column_readers.end() &&
+           WideningColumnIterator::can_widen(iter->second->get_field_type(), tablet_column.type());
 }
 
 Status Segment::new_bitmap_index_iterator(const TabletColumn& tablet_column,
                                           BitmapIndexIterator** iter) {
     auto col_unique_id = tablet_column.unique_id();
+    // the index of a widened column is of the narrower type in the file
     if (_column_readers.count(col_unique_id) > 0 &&
-        _column_readers.at(col_unique_id)->has_bitmap_index()) {
+        _column_readers.at(col_unique_id)->has_bitmap_index() && !_is_widened(tablet_column)) {
         return _column_readers.at(col_unique_id)->new_bitmap_index_iterator(iter);
     }
     return Status::OK();
@@ -303,14 +399,37 @@ Status Segment::new_inverted_index_iterator(const TabletColumn& tablet_column,
                                             OlapReaderStatistics* stats,
                                             InvertedIndexIterator** iter) {
     auto col_unique_id = tablet_column.unique_id();
-    if (_column_readers.count(col_unique_id) > 0 && index_meta) {
+    if (_column_readers.count(col_unique_id) > 0 && index_meta && !_is_widened(tablet_column)) {
         return _column_readers.at(col_unique_id)
                 ->new_inverted_index_iterator(index_meta, stats, iter);
     }
     return Status::OK();
 }
 
-Status Segment::lookup_row_key(const Slice& key, RowLocation* row_location) {
+// check the sought key of a key with the sequence column
+static Status compare_sequence_id(const Slice& key, const Slice& key_without_seq,
+                                  const Slice& sought_key) {
+    size_t seq_col_length = key.get_size() - key_without_seq.get_size();
+    Slice sought_key_without_seq =
+            Slice(sought_key.get_data(), sought_key.get_size() - seq_col_length);
+
+    // compare key
+    if (key_without_seq.compare(sought_key_without_seq) != 0) {
+        return Status::NotFound("Can't find key in the segment");
+    }
+
+    // compare sequence id
+    Slice sequence_id = Slice(key.get_data() + key_without_seq.get_size() + 1, seq_col_length - 1);
+    Slice previous_sequence_id = Slice(
+            sought_key.get_data() + sought_key_without_seq.get_size() + 1, seq_col_length - 1);
+    if (sequence_id.compare(previous_sequence_id) < 0) {
+        return Status::AlreadyExist("key with higher sequence id exists");
+    }
+    return Status::OK();
+}
+
+Status Segment::lookup_row_key(const Slice& key, RowLocation* row_location,
+                               std::unique_ptr<IndexedColumnIterator>* cached_iterator) {
     RETURN_IF_ERROR(load_pk_index_and_bf());
     bool has_seq_col = _tablet_schema->has_sequence_col();
     size_t seq_col_length = 0;
@@ -323,9 +442,27 @@ Status Segment::lookup_row_key(const Slice& key, RowLocation* row_location) {
     if (!_pk_index_reader->check_present(key_without_seq)) {
         return Status::NotFound("Can't find key in the segment");
     }
+    if (const auto* memory_index = _get_pk_memory_index(); memory_index != nullptr) {
+        bool exact_match = false;
+        uint32_t row_id = memory_index->seek_at_or_after(key_without_seq, &exact_match);
+        if (row_id >= memory_index->num_rows() || (!has_seq_col && !exact_match)) {
+            return Status::NotFound("Can't find key in the segment");
+        }
+        row_location->row_id = row_id;
+        row_location->segment_id = _segment_id;
+        if (has_seq_col) {
+            return compare_sequence_id(key, key_without_seq, memory_index->key_at(row_id));
+        }
+        return Status::OK();
+    }
+
     bool exact_match = false;
-    std::unique_ptr<segment_v2::IndexedColumnIterator> index_iterator;
-    RETURN_IF_ERROR(_pk_index_reader->new_iterator(&index_iterator));
+    std::unique_ptr<segment_v2::IndexedColumnIterator> local_iterator;
+    auto* iter_ptr = cached_iterator != nullptr ? cached_iterator : &local_iterator;
+    if (*iter_ptr == nullptr) {
+        RETURN_IF_ERROR(_pk_index_reader->new_iterator(iter_ptr));
+    }
+    auto& index_iterator = *iter_ptr;
     RETURN_IF_ERROR(index_iterator->seek_at_or_after(&key_without_seq, &exact_match));
     if (!has_seq_col && !exact_match) {
         return Status::NotFound("Can't find key in the segment");
@@ -344,29 +481,56 @@ Status Segment::lookup_row_key(const Slice& key, RowLocation* row_location) {
 
         Slice sought_key =
                 Slice(index_column->get_data_at(0).data, index_column->get_data_at(0).size);
-        Slice sought_key_without_seq =
-                Slice(sought_key.get_data(), sought_key.get_size() - seq_col_length);
-
-        // compare key
-        if (key_without_seq.compare(sought_key_without_seq) != 0) {
-            return Status::NotFound("Can't find key in the segment");
-        }
-
-        // compare sequence id
-        Slice sequence_id =
-                Slice(key.get_data() + key_without_seq.get_size() + 1, seq_col_length - 1);
-        Slice previous_sequence_id = Slice(
-                sought_key.get_data() + sought_key_without_seq.get_size() + 1, seq_col_length - 1);
-        if (sequence_id.compare(previous_sequence_id) < 0) {
-            return Status::AlreadyExist("key with higher sequence id exists");
-        }
+        return compare_sequence_id(key, key_without_seq, sought_key);
     }
 
     return Status::OK();
 }
 
+const PrimaryKeyMemoryIndex* Segment::_get_pk_memory_index() {
+    int64_t min_lookups = config::pk_memory_index_min_lookups;
+    if (min_lookups <= 0 ||
+        (!_load_pk_memory_index_once.has_called() &&
+         _num_pk_lookups.fetch_add(1, std::memory_order_relaxed) + 1 < min_lookups)) {
+        return nullptr;
+    }
+    auto st = _load_pk_memory_index_once.call([this] {
+        int64_t max_bytes = std::min(config::pk_memory_index_max_bytes_per_segment,
+                                     config::pk_memory_index_total_max_bytes -
+                                             s_pk_memory_index_bytes.load());
+        if (max_bytes <= 0) {
+            return Status::MemoryLimitExceeded("no memory for the primary key index");
+        }
+        auto memory_index = std::make_unique<PrimaryKeyMemoryIndex>();
+        auto st = memory_index->build(*_pk_index_reader, max_bytes);
+        if (!st.ok()) {
+            if (!st.is<ErrorCode::MEM_LIMIT_EXCEEDED>()) {
+                LOG(WARNING) << "failed to build the primary key index in memory, segment "
+                             << _rowset_id << "_" << _segment_id << ": " << st;
+            }
+            return st;
+        }
+        int64_t bytes = memory_index->memory_size();
+        // the indexes of other segments may be built at the same time
+        if (s_pk_memory_index_bytes.fetch_add(bytes) + bytes >
+            config::pk_memory_index_total_max_bytes) {
+            s_pk_memory_index_bytes.fetch_sub(bytes);
+            return Status::MemoryLimitExceeded("no memory for the primary key index");
+        }
+        _meta_mem_usage += bytes;
+        _segment_meta_mem_tracker->consume(bytes);
+        _pk_memory_index = std::move(memory_index);
+        return Status::OK();
+    });
+    return st.ok() ? _pk_memory_index.get() : nullptr;
+}
+
 Status Segment::read_key_by_rowid(uint32_t row_id, std::string* key) {
     RETURN_IF_ERROR(load_pk_index_and_bf());
+    if (_load_pk_memory_index_once.has_called() && _pk_memory_index != nullptr) {
+        *key = _pk_memory_index->key_at(row_id).to_string();
+        return Status::OK();
+    }
     std::unique_ptr<segment_v2::IndexedColumnIterator> iter;
     RETURN_IF_ERROR(_pk_index_reader->new_iterator(&iter));
 
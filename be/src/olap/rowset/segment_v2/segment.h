@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <memory> // for unique_ptr
 #include <string>
@@ -94,7 +95,10 @@ public:
         return _pk_index_reader.get();
     }
 
-    Status lookup_row_key(const Slice& key, RowLocation* row_location);
+    // If cached_iterator is not null, it's reused by the lookups of a sorted key stream, so
+    // the later keys are sought in the page loaded by the earlier ones.
+    Status lookup_row_key(const Slice& key, RowLocation* row_location,
+                          std::unique_ptr<IndexedColumnIterator>* cached_iterator = nullptr);
 
     Status read_key_by_rowid(uint32_t row_id, std::string* key);
 
@@ -125,7 +129,16 @@ private:
     Status _open();
     Status _parse_footer();
     Status _create_column_readers();
+    // whether the column is of a wider type than the one in the file after a linked schema change
+    bool _is_widened(const TabletColumn& tablet_column) const;
+    // the delete conditions which may delete any row of this segment by the segment zone maps,
+    // nullptr if none of them is dropped
+    std::shared_ptr<AndBlockColumnPredicate> _prune_delete_conditions(
+            const StorageReadOptions& read_options) const;
+    bool _may_delete(const StorageReadOptions& read_options, const ColumnPredicate* pred) const;
     Status _load_pk_bloom_filter();
+    // return nullptr if the segment is not hot enough or there's no memory for the index
+    const PrimaryKeyMemoryIndex* _get_pk_memory_index();
 
 private:
     friend class SegmentIterator;
@@ -159,6 +172,10 @@ private:
     std::unique_ptr<ShortKeyIndexDecoder> _sk_index_decoder;
     // primary key index reader
     std::unique_ptr<PrimaryKeyIndexReader> _pk_index_reader;
+    // the primary keys in memory, built once the segment is looked up frequently
+    std::atomic<int64_t> _num_pk_lookups {0};
+    DorisCallOnce<Status> _load_pk_memory_index_once;
+    std::unique_ptr<PrimaryKeyMemoryIndex> _pk_memory_index;
     // Segment may be destructed after StorageEngine, in order to exit gracefully.
     std::shared_ptr<MemTracker> _segment_meta_mem_tracker;
 };
@@ -17,6 +17,7 @@
 
 #include "olap/rowset/segment_v2/segment_iterator.h"
 
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <utility>
@@ -25,13 +26,16 @@
 #include "common/status.h"
 #include "olap/column_predicate.h"
 #include "olap/like_column_predicate.h"
+#include "olap/match_predicate.h"
 #include "olap/olap_common.h"
 #include "olap/rowset/segment_v2/column_reader.h"
 #include "olap/rowset/segment_v2/segment.h"
 #include "olap/short_key_index.h"
+#include "olap/utils.h"
 #include "util/doris_metrics.h"
 #include "util/key_util.h"
 #include "util/simd/bits.h"
+#include "util/time.h"
 #include "vec/columns/column.h"
 #include "vec/columns/column_const.h"
 #include "vec/data_types/data_type_factory.hpp"
@@ -218,6 +222,11 @@ Status SegmentIterator::_init() {
 
     _row_bitmap.addRange(0, _segment->num_rows());
     RETURN_IF_ERROR(_init_return_column_iterators());
+    if (config::segment_page_read_merge_gap_bytes >= 0 && _opts.use_page_cache) {
+        _page_read_planner = std::make_unique<PageReadPlanner>(
+                config::segment_page_read_merge_gap_bytes,
+                config::segment_page_read_merge_max_bytes);
+    }
     RETURN_IF_ERROR(_init_bitmap_index_iterators());
     RETURN_IF_ERROR(_init_inverted_index_iterators());
     // z-order can not use prefix index
@@ -245,6 +254,29 @@ Status SegmentIterator::_init() {
     return Status::OK();
 }
 
+namespace {
+
+// Compares the ordinals looked up for two keys of the same columns, as far as known by the keys.
+// The ordinal of a key included is the first row not less than it, otherwise the first row
+// greater than it.
+int compare_lookups(const RowCursor& lhs, bool lhs_include, const RowCursor& rhs,
+                    bool rhs_include) {
+    auto num_cids = lhs.schema()->num_column_ids();
+    if (num_cids != rhs.schema()->num_column_ids()) {
+        // the ordinals of the keys of different lengths are not compared
+        return 1;
+    }
+    for (uint32_t cid = 0; cid < num_cids; ++cid) {
+        auto res = lhs.schema()->column(cid)->compare_cell(lhs.cell(cid), rhs.cell(cid));
+        if (res != 0) {
+            return res;
+        }
+    }
+    return lhs_include == rhs_include ? 0 : (lhs_include ? -1 : 1);
+}
+
+} // namespace
+
 Status SegmentIterator::_get_row_ranges_by_keys() {
     DorisMetrics::instance()->segment_row_total->increment(num_rows());
 
@@ -253,28 +285,76 @@ Status SegmentIterator::_get_row_ranges_by_keys() {
         return Status::OK();
     }
 
-    RowRanges result_ranges;
+    // The ranges are swept in the order of their lower keys, then the ordinal of a key is searched
+    // from the ordinal of the previous key instead of the start of its short key block, which is
+    // the common case of the many ranges of an IN list on the key columns.
+    std::vector<const StorageReadOptions::KeyRange*> key_ranges;
+    key_ranges.reserve(_opts.key_ranges.size());
+    bool sortable = true;
     for (auto& key_range : _opts.key_ranges) {
+        key_ranges.push_back(&key_range);
+        const RowCursor* first_lower_key = _opts.key_ranges[0].lower_key;
+        sortable &= key_range.lower_key != nullptr && first_lower_key != nullptr &&
+                    key_range.lower_key->schema()->num_column_ids() ==
+                            first_lower_key->schema()->num_column_ids();
+    }
+    if (sortable && key_ranges.size() > 1) {
+        std::stable_sort(key_ranges.begin(), key_ranges.end(),
+                         [](const auto* lhs, const auto* rhs) {
+                             return compare_lookups(*lhs->lower_key, lhs->include_lower,
+                                                    *rhs->lower_key, rhs->include_lower) < 0;
+                         });
+    }
+
+    const RowCursor* prev_lower_key = nullptr;
+    bool prev_lower_include = false;
+    rowid_t prev_lower_rowid = 0;
+    const RowCursor* prev_upper_key = nullptr;
+    bool prev_upper_include = false;
+    rowid_t prev_upper_rowid = 0;
+    // the ranges are added to the bitmap one by one, rather than merged into the row ranges
+    roaring::Roaring result_bitmap;
+    for (const auto* key_range : key_ranges) {
         rowid_t lower_rowid = 0;
         rowid_t upper_rowid = num_rows();
-        RETURN_IF_ERROR(_prepare_seek(key_range));
-        if (key_range.upper_key != nullptr) {
+        RETURN_IF_ERROR(_prepare_seek(*key_range));
+        if (key_range->upper_key != nullptr) {
             // If client want to read upper_bound, the include_upper is true. So we
             // should get the first ordinal at which key is larger than upper_bound.
             // So we call _lookup_ordinal with include_upper's negate
-            RETURN_IF_ERROR(_lookup_ordinal(*key_range.upper_key, !key_range.include_upper,
-                                            num_rows(), &upper_rowid));
-        }
-        if (upper_rowid > 0 && key_range.lower_key != nullptr) {
-            RETURN_IF_ERROR(_lookup_ordinal(*key_range.lower_key, key_range.include_lower,
+            bool is_include = !key_range->include_upper;
+            rowid_t from = 0;
+            if (prev_upper_key != nullptr &&
+                compare_lookups(*prev_upper_key, prev_upper_include, *key_range->upper_key,
+                                is_include) <= 0) {
+                from = prev_upper_rowid;
+            }
+            RETURN_IF_ERROR(_lookup_ordinal(*key_range->upper_key, is_include, from, num_rows(),
+                                            &upper_rowid));
+            prev_upper_key = key_range->upper_key;
+            prev_upper_include = is_include;
+            prev_upper_rowid = upper_rowid;
+        }
+        if (upper_rowid > 0 && key_range->lower_key != nullptr) {
+            rowid_t from = 0;
+            if (prev_lower_key != nullptr &&
+                compare_lookups(*prev_lower_key, prev_lower_include, *key_range->lower_key,
+                                key_range->include_lower) <= 0) {
+                from = prev_lower_rowid;
+            }
+            RETURN_IF_ERROR(_lookup_ordinal(*key_range->lower_key, key_range->include_lower, from,
                                             upper_rowid, &lower_rowid));
+            prev_lower_key = key_range->lower_key;
+            prev_lower_include = key_range->include_lower;
+            prev_lower_rowid = lower_rowid;
+        }
+        if (lower_rowid < upper_rowid) {
+            result_bitmap.addRange(lower_rowid, upper_rowid);
         }
-        auto row_range = RowRanges::create_single(lower_rowid, upper_rowid);
-        RowRanges::ranges_union(result_ranges, row_range, &result_ranges);
     }
     // pre-condition: _row_ranges == [0, num_rows)
     size_t pre_size = _row_bitmap.cardinality();
-    _row_bitmap = RowRanges::ranges_to_roaring(result_ranges);
+    _row_bitmap = std::move(result_bitmap);
     _opts.stats->rows_key_range_filtered += (pre_size - _row_bitmap.cardinality());
 
     return Status::OK();
@@ -346,14 +426,13 @@ Status SegmentIterator::_get_row_ranges_by_column_conditions() {
     RETURN_IF_ERROR(_apply_bitmap_index());
     RETURN_IF_ERROR(_apply_inverted_index());
 
-    std::shared_ptr<doris::ColumnPredicate> runtime_predicate = nullptr;
     if (_opts.use_topn_opt) {
         auto query_ctx = _opts.runtime_state->get_query_fragments_ctx();
-        runtime_predicate = query_ctx->get_runtime_predicate().get_predictate();
+        _zone_map_runtime_predicate = query_ctx->get_runtime_predicate().get_predictate();
     }
 
     if (!_row_bitmap.isEmpty() &&
-        (runtime_predicate || !_opts.col_id_to_predicates.empty() ||
+        (_zone_map_runtime_predicate || !_opts.col_id_to_predicates.empty() ||
          _opts.delete_condition_predicates->num_of_column_predicate() > 0)) {
         RowRanges condition_row_ranges = RowRanges::create_single(_segment->num_rows());
         RETURN_IF_ERROR(_get_row_ranges_from_conditions(&condition_row_ranges));
@@ -406,24 +485,13 @@ Status SegmentIterator::_get_row_ranges_from_conditions(RowRanges* condition_row
                                        &zone_map_row_ranges);
     }
 
-    std::shared_ptr<doris::ColumnPredicate> runtime_predicate = nullptr;
-    if (_opts.use_topn_opt) {
-        auto query_ctx = _opts.runtime_state->get_query_fragments_ctx();
-        runtime_predicate = query_ctx->get_runtime_predicate().get_predictate();
-        if (runtime_predicate) {
-            int32_t cid = _opts.tablet_schema->column(runtime_predicate->column_id()).unique_id();
-            AndBlockColumnPredicate and_predicate;
-            auto single_predicate = new SingleColumnBlockPredicate(runtime_predicate.get());
-            and_predicate.add_column_predicate(single_predicate);
-
-            RowRanges column_rp_row_ranges = RowRanges::create_single(num_rows());
-            RETURN_IF_ERROR(_column_iterators[_schema.unique_id(cid)]->get_row_ranges_by_zone_map(
-                    &and_predicate, nullptr, &column_rp_row_ranges));
-
-            // intersect different columns's row ranges to get final row ranges by zone map
-            RowRanges::ranges_intersection(zone_map_row_ranges, column_rp_row_ranges,
-                                           &zone_map_row_ranges);
-        }
+    if (_zone_map_runtime_predicate) {
+        RowRanges column_rp_row_ranges = RowRanges::create_single(num_rows());
+        RETURN_IF_ERROR(_get_row_ranges_by_runtime_predicate(_zone_map_runtime_predicate,
+                                                             &column_rp_row_ranges));
+        // intersect different columns's row ranges to get final row ranges by zone map
+        RowRanges::ranges_intersection(zone_map_row_ranges, column_rp_row_ranges,
+                                       &zone_map_row_ranges);
     }
 
     pre_size = condition_row_ranges->count();
@@ -433,6 +501,56 @@ Status SegmentIterator::_get_row_ranges_from_conditions(RowRanges* condition_row
     return Status::OK();
 }
 
+Status SegmentIterator::_get_row_ranges_by_runtime_predicate(
+        const std::shared_ptr<ColumnPredicate>& runtime_predicate, RowRanges* row_ranges) {
+    AndBlockColumnPredicate and_predicate;
+    auto single_predicate = new SingleColumnBlockPredicate(runtime_predicate.get());
+    and_predicate.add_column_predicate(single_predicate);
+    return _column_iterators[_schema.unique_id(runtime_predicate->column_id())]
+            ->get_row_ranges_by_zone_map(&and_predicate, nullptr, row_ranges);
+}
+
+Status SegmentIterator::_apply_tightened_runtime_predicate() {
+    auto runtime_predicate = _opts.runtime_state->get_query_fragments_ctx()
+                                     ->get_runtime_predicate()
+                                     .get_predictate();
+    if (runtime_predicate == nullptr || runtime_predicate == _zone_map_runtime_predicate) {
+        return Status::OK();
+    }
+    _zone_map_runtime_predicate = runtime_predicate;
+
+    // the rows before _cur_rowid have been read, only the remaining rows can be pruned
+    roaring::Roaring remaining_bitmap = _row_bitmap;
+    remaining_bitmap.removeRange(0, _cur_rowid);
+    if (!remaining_bitmap.isEmpty()) {
+        RowRanges row_ranges = RowRanges::create_single(num_rows());
+        RETURN_IF_ERROR(_get_row_ranges_by_runtime_predicate(runtime_predicate, &row_ranges));
+        size_t pre_size = remaining_bitmap.cardinality();
+        remaining_bitmap &= RowRanges::ranges_to_roaring(row_ranges);
+        _opts.stats->rows_stats_filtered += (pre_size - remaining_bitmap.cardinality());
+        // _range_iter references _row_bitmap, so rebuild it after _row_bitmap is replaced
+        _row_bitmap = std::move(remaining_bitmap);
+        _range_iter.reset(new BitmapRangeIterator(_row_bitmap));
+    }
+
+    // evaluate the tightened predicate instead of the one added in _vec_init_lazy_materialization
+    if (_runtime_predicate) {
+        auto replace_predicate = [&](std::vector<ColumnPredicate*>& predicates) {
+            std::replace(predicates.begin(), predicates.end(), _runtime_predicate.get(),
+                         runtime_predicate.get());
+        };
+        replace_predicate(_col_predicates);
+        replace_predicate(_pre_eval_block_predicate);
+        replace_predicate(_short_cir_eval_predicate);
+        for (auto& late_pred_column : _late_pred_columns) {
+            replace_predicate(late_pred_column.predicates);
+        }
+        _predicate_stats.erase(_runtime_predicate.get());
+        _runtime_predicate = runtime_predicate;
+    }
+    return Status::OK();
+}
+
 // filter rows by evaluating column predicates using bitmap indexes.
 // upon return, predicates that've been evaluated by bitmap indexes are removed from _col_predicates.
 Status SegmentIterator::_apply_bitmap_index() {
@@ -443,8 +561,7 @@ Status SegmentIterator::_apply_bitmap_index() {
 
     for (auto pred : _col_predicates) {
         int32_t unique_id = _schema.unique_id(pred->column_id());
-        if (_bitmap_index_iterators.count(unique_id) < 1 ||
-            _bitmap_index_iterators[unique_id] == nullptr || pred->type() == PredicateType::BF) {
+        if (!_check_apply_by_bitmap_index(pred) || pred->type() == PredicateType::BF) {
             // no bitmap index for this column
             remaining_predicates.push_back(pred);
         } else {
@@ -581,7 +698,9 @@ bool SegmentIterator::_check_apply_by_bitmap_index(ColumnPredicate* pred) {
         // no bitmap index for this column
         return false;
     }
-    return true;
+    // the match predicates are applied with the inverted index, see
+    // _evaluate_match_without_index()
+    return pred->type() != PredicateType::MATCH;
 }
 
 bool SegmentIterator::_check_apply_by_inverted_index(ColumnPredicate* pred, bool pred_in_compound) {
@@ -656,6 +775,11 @@ Status SegmentIterator::_apply_index_except_leafnode_of_andnode() {
             res = _apply_bitmap_index_except_leafnode_of_andnode(pred, &bitmap);
         } else if (can_apply_by_inverted_index) {
             res = _apply_inverted_index_except_leafnode_of_andnode(pred, &bitmap);
+            if (res.code() == ErrorCode::INVERTED_INDEX_FILE_NOT_FOUND &&
+                pred->type() == PredicateType::MATCH) {
+                bitmap = _row_bitmap;
+                res = _evaluate_match_without_index(pred, &bitmap);
+            }
         } else {
             continue;
         }
@@ -711,6 +835,72 @@ std::string SegmentIterator::_gen_predicate_result_sign(ColumnPredicateInfo* pre
     return pred_result_sign;
 }
 
+Status SegmentIterator::_evaluate_match_without_index(ColumnPredicate* pred,
+                                                      roaring::Roaring* bitmap) {
+    auto cid = pred->column_id();
+    int32_t unique_id = _schema.unique_id(cid);
+    const auto* column_desc = _schema.column(cid);
+    if (!is_string_type(column_desc->type())) {
+        return Status::Error<ErrorCode::INVERTED_INDEX_FILE_NOT_FOUND>();
+    }
+    auto parser_type = InvertedIndexParserType::PARSER_NONE;
+    if (_column_has_fulltext_index(unique_id)) {
+        parser_type = _inverted_index_iterators[unique_id]->get_inverted_index_analyser_type();
+    } else if (_bitmap_index_iterators.count(unique_id) > 0 &&
+               _bitmap_index_iterators[unique_id] != nullptr) {
+        // the untokenized index may be written as a bitmap index, see enable_native_inverted_index
+        return pred->evaluate(_bitmap_index_iterators[unique_id], num_rows(), bitmap);
+    }
+
+    // the column iterators of the block may be read later from where they are
+    ColumnIterator* iter = nullptr;
+    RETURN_IF_ERROR(_segment->new_column_iterator(_opts.tablet_schema->column(cid), &iter));
+    std::unique_ptr<ColumnIterator> column_iterator(iter);
+    ColumnIteratorOptions iter_opts;
+    iter_opts.stats = _opts.stats;
+    iter_opts.use_page_cache = _opts.use_page_cache;
+    iter_opts.file_reader = _file_reader.get();
+    iter_opts.io_ctx = _opts.io_ctx;
+    RETURN_IF_ERROR(column_iterator->init(iter_opts));
+
+    // the pages whose ngram bloom filters can't contain the terms are not read
+    AndBlockColumnPredicate and_predicate;
+    and_predicate.add_column_predicate(new SingleColumnBlockPredicate(pred));
+    RowRanges bf_row_ranges = RowRanges::create_single(num_rows());
+    RETURN_IF_ERROR(
+            column_iterator->get_row_ranges_by_bloom_filter(&and_predicate, &bf_row_ranges));
+    *bitmap &= RowRanges::ranges_to_roaring(bf_row_ranges);
+
+    auto* match_pred = static_cast<MatchPredicate*>(pred);
+    auto column = Schema::get_column_by_field(*column_desc);
+    roaring::Roaring result;
+    std::vector<rowid_t> rowids;
+    rowids.reserve(_opts.block_row_max);
+    auto evaluate_rows = [&]() -> Status {
+        column->clear();
+        RETURN_IF_ERROR(column_iterator->read_by_rowids(rowids.data(), rowids.size(), column));
+        RETURN_IF_ERROR(match_pred->evaluate_without_index(column_desc->name(), parser_type,
+                                                           *column, rowids.data(), rowids.size(),
+                                                           &result));
+        rowids.clear();
+        return Status::OK();
+    };
+    for (auto rowid : *bitmap) {
+        rowids.push_back(rowid);
+        if (rowids.size() == static_cast<size_t>(_opts.block_row_max)) {
+            RETURN_IF_ERROR(evaluate_rows());
+        }
+    }
+    if (!rowids.empty()) {
+        RETURN_IF_ERROR(evaluate_rows());
+    }
+    VLOG_DEBUG << "evaluated match predicate without inverted index on segment " << segment_id()
+               << ", column " << column_desc->name() << ", rows " << bitmap->cardinality()
+               << ", matched " << result.cardinality();
+    bitmap->swap(result);
+    return Status::OK();
+}
+
 bool SegmentIterator::_column_has_fulltext_index(int32_t unique_id) {
     bool has_fulltext_index =
             _inverted_index_iterators[unique_id] != nullptr &&
@@ -746,6 +936,11 @@ Status SegmentIterator::_apply_inverted_index_on_column_predicate(
         roaring::Roaring bitmap = _row_bitmap;
         Status res =
                 pred->evaluate(_schema, _inverted_index_iterators[unique_id], num_rows(), &bitmap);
+        if (res.code() == ErrorCode::INVERTED_INDEX_FILE_NOT_FOUND &&
+            pred->type() == PredicateType::MATCH) {
+            bitmap = _row_bitmap;
+            res = _evaluate_match_without_index(pred, &bitmap);
+        }
         if (!res.ok()) {
             if ((res.code() == ErrorCode::INVERTED_INDEX_FILE_NOT_FOUND &&
                  pred->type() != PredicateType::MATCH) ||
@@ -753,9 +948,9 @@ Status SegmentIterator::_apply_inverted_index_on_column_predicate(
                 (res.code() == ErrorCode::INVERTED_INDEX_NO_TERMS &&
                  need_remaining_after_evaluate)) {
                 // 1. INVERTED_INDEX_FILE_NOT_FOUND means index file has not been built,
-                //    usually occurs when creating a new index, because match query must
-                //    need index file, queries other than match query can be downgraded
-                //    without index.
+                //    usually occurs when creating a new index or when the build is deferred
+                //    to compaction, queries other than match query can be downgraded
+                //    without index, and match query is evaluated on the data above.
                 // 2. INVERTED_INDEX_FILE_HIT_LIMIT means the hit of condition by index
                 //    has reached the optimal limit, downgrade without index query can
                 //    improve query performance.
@@ -895,6 +1090,18 @@ Status SegmentIterator::_init_return_column_iterators() {
         return Status::OK();
     }
 
+    // the values of the columns of the predicates are evaluated, so they are read in whole
+    std::set<ColumnId> pred_column_ids;
+    if (_opts.offsets_only_columns != nullptr && !_opts.offsets_only_columns->empty()) {
+        for (auto* pred : _col_predicates) {
+            pred_column_ids.insert(pred->column_id());
+        }
+        for (auto* pred : _col_preds_except_leafnode_of_andnode) {
+            pred_column_ids.insert(pred->column_id());
+        }
+        _opts.delete_condition_predicates->get_all_column_ids(pred_column_ids);
+    }
+
     for (auto cid : _schema.column_ids()) {
         int32_t unique_id = _opts.tablet_schema->column(cid).unique_id();
         if (_opts.tablet_schema->column(cid).name() == BeConsts::ROWID_COL) {
@@ -908,9 +1115,15 @@ Status SegmentIterator::_init_return_column_iterators() {
             ColumnIteratorOptions iter_opts;
             iter_opts.stats = _opts.stats;
             iter_opts.use_page_cache = _opts.use_page_cache;
+            iter_opts.fill_page_cache = _opts.fill_page_cache;
             iter_opts.file_reader = _file_reader.get();
             iter_opts.io_ctx = _opts.io_ctx;
             RETURN_IF_ERROR(_column_iterators[unique_id]->init(iter_opts));
+            if (_opts.offsets_only_columns != nullptr &&
+                _opts.offsets_only_columns->count(unique_id) > 0 &&
+                pred_column_ids.count(cid) == 0) {
+                _column_iterators[unique_id]->set_offsets_only();
+            }
         }
     }
     return Status::OK();
@@ -945,18 +1158,20 @@ Status SegmentIterator::_init_inverted_index_iterators() {
     return Status::OK();
 }
 
-Status SegmentIterator::_lookup_ordinal(const RowCursor& key, bool is_include, rowid_t upper_bound,
-                                        rowid_t* rowid) {
+Status SegmentIterator::_lookup_ordinal(const RowCursor& key, bool is_include, rowid_t lower_bound,
+                                        rowid_t upper_bound, rowid_t* rowid) {
     if (_segment->_tablet_schema->keys_type() == UNIQUE_KEYS &&
         _segment->get_primary_key_index() != nullptr) {
         return _lookup_ordinal_from_pk_index(key, is_include, rowid);
     }
-    return _lookup_ordinal_from_sk_index(key, is_include, upper_bound, rowid);
+    return _lookup_ordinal_from_sk_index(key, is_include, lower_bound, upper_bound, rowid);
 }
 
 // look up one key to get its ordinal at which can get data by using short key index.
 // 'upper_bound' is defined the max ordinal the function will search.
-// We use upper_bound to reduce search times.
+// 'lower_bound' is an ordinal known not to be after the key, e.g. the ordinal of a smaller key,
+// then the search gallops from it instead of the start of the short key block.
+// We use them to reduce search times.
 // If we find a valid ordinal, it will be set in rowid and with Status::OK()
 // If we can not find a valid key in this segment, we will set rowid to upper_bound
 // Otherwise return error.
@@ -964,7 +1179,8 @@ Status SegmentIterator::_lookup_ordinal(const RowCursor& key, bool is_include, r
 // 2. binary search to find exact ordinal that match the input condition
 // Make is_include template to reduce branch
 Status SegmentIterator::_lookup_ordinal_from_sk_index(const RowCursor& key, bool is_include,
-                                                      rowid_t upper_bound, rowid_t* rowid) {
+                                                      rowid_t lower_bound, rowid_t upper_bound,
+                                                      rowid_t* rowid) {
     const ShortKeyIndexDecoder* sk_index_decoder = _segment->get_short_key_index();
     DCHECK(sk_index_decoder != nullptr);
 
@@ -998,21 +1214,33 @@ Status SegmentIterator::_lookup_ordinal_from_sk_index(const RowCursor& key, bool
         end = end_iter.ordinal() * sk_index_decoder->num_rows_per_block();
     }
 
+    // whether the peeked row is before the ordinal to find
+    auto peeked_before_key = [&]() {
+        int cmp = _compare_short_key_with_seek_block(key_col_ids);
+        // the lower bound if is_include, otherwise the upper bound
+        return cmp > 0 || (cmp == 0 && !is_include);
+    };
+
+    if (lower_bound > start) {
+        start = std::min(lower_bound, end);
+        // the ordinal is usually close to the one of the previous key
+        for (uint64_t step = 1; start < end; step *= 2) {
+            auto probe = static_cast<rowid_t>(std::min<uint64_t>(start + step - 1, end - 1));
+            RETURN_IF_ERROR(_seek_and_peek(probe));
+            if (!peeked_before_key()) {
+                end = probe;
+                break;
+            }
+            start = probe + 1;
+        }
+    }
+
     // binary search to find the exact key
     while (start < end) {
         rowid_t mid = (start + end) / 2;
         RETURN_IF_ERROR(_seek_and_peek(mid));
-        int cmp = _compare_short_key_with_seek_block(key_col_ids);
-        if (cmp > 0) {
+        if (peeked_before_key()) {
             start = mid + 1;
-        } else if (cmp == 0) {
-            if (is_include) {
-                // lower bound
-                end = mid;
-            } else {
-                // upper bound
-                start = mid + 1;
-            }
         } else {
             end = mid;
         }
@@ -1309,9 +1537,58 @@ Status SegmentIterator::_vec_init_lazy_materialization() {
             }
         }
     }
+
+    // Step 5: move the columns only used by short circuit predicates out of first read columns
+    if (config::enable_segment_late_predicate_materialization && _is_need_short_eval &&
+        !_is_need_expr_eval) {
+        _init_late_predicate_columns(del_cond_id_set);
+    }
     return Status::OK();
 }
 
+void SegmentIterator::_init_late_predicate_columns(const std::set<ColumnId>& del_cond_id_set) {
+    std::set<ColumnId> vec_pred_id_set(_vec_pred_column_ids.begin(), _vec_pred_column_ids.end());
+    std::vector<ColumnId> late_cids;
+    for (auto cid : _short_cir_pred_column_ids) {
+        if (vec_pred_id_set.count(cid) == 0 && del_cond_id_set.count(cid) == 0 &&
+            cid != _schema.version_col_idx()) {
+            late_cids.push_back(cid);
+        }
+    }
+    // If no other predicate filters rows before, reading the first column late only
+    // makes it slower, keep it in first read columns.
+    bool has_early_predicate = !_pre_eval_block_predicate.empty() || !del_cond_id_set.empty() ||
+                               late_cids.size() < _short_cir_pred_column_ids.size();
+    if (!has_early_predicate && !late_cids.empty()) {
+        late_cids.erase(late_cids.begin());
+    }
+    if (late_cids.empty()) {
+        return;
+    }
+
+    for (auto cid : late_cids) {
+        LatePredicateColumn late_column;
+        late_column.cid = cid;
+        for (auto* predicate : _short_cir_eval_predicate) {
+            if (predicate->column_id() == cid) {
+                late_column.predicates.push_back(predicate);
+            }
+        }
+        _late_pred_columns.push_back(std::move(late_column));
+    }
+    std::set<ColumnId> late_cid_set(late_cids.begin(), late_cids.end());
+    auto is_late = [&](ColumnId cid) { return late_cid_set.count(cid) > 0; };
+    _short_cir_eval_predicate.erase(
+            std::remove_if(_short_cir_eval_predicate.begin(), _short_cir_eval_predicate.end(),
+                           [&](ColumnPredicate* predicate) {
+                               return is_late(predicate->column_id());
+                           }),
+            _short_cir_eval_predicate.end());
+    _first_read_column_ids.erase(std::remove_if(_first_read_column_ids.begin(),
+                                                _first_read_column_ids.end(), is_late),
+                                 _first_read_column_ids.end());
+}
+
 bool SegmentIterator::_can_evaluated_by_vectorized(ColumnPredicate* predicate) {
     auto cid = predicate->column_id();
     FieldType field_type = _schema.column(cid)->type();
@@ -1443,6 +1720,16 @@ Status SegmentIterator::_read_columns_by_index(uint32_t nrows_read_limit, uint32
         if (!has_next_range) {
             break;
         }
+        // load the pages of all the columns before the seek, which reads the first page
+        if (_page_read_planner) {
+            for (auto cid : _first_read_column_ids) {
+                if (_need_read_data(cid)) {
+                    RETURN_IF_ERROR(_column_iterators[_schema.unique_id(cid)]->collect_pages(
+                            range_from, range_to, _page_read_planner.get()));
+                }
+            }
+            RETURN_IF_ERROR(_page_read_planner->read_pages(_opts.stats));
+        }
         if (_cur_rowid == 0 || _cur_rowid != range_from) {
             _cur_rowid = range_from;
             _opts.stats->block_first_read_seek_num += 1;
@@ -1509,13 +1796,28 @@ uint16_t SegmentIterator::_evaluate_vectorization_predicate(uint16_t* sel_rowid_
     uint16_t original_size = selected_size;
     bool ret_flags[original_size];
     DCHECK(_pre_eval_block_predicate.size() > 0);
-    auto column_id = _pre_eval_block_predicate[0]->column_id();
-    auto& column = _current_return_columns[column_id];
-    _pre_eval_block_predicate[0]->evaluate_vec(*column, original_size, ret_flags);
-    for (int i = 1; i < _pre_eval_block_predicate.size(); i++) {
-        auto column_id2 = _pre_eval_block_predicate[i]->column_id();
-        auto& column2 = _current_return_columns[column_id2];
-        _pre_eval_block_predicate[i]->evaluate_and_vec(*column2, original_size, ret_flags);
+    size_t input_rows = original_size;
+    for (int i = 0; i < _pre_eval_block_predicate.size(); i++) {
+        auto* predicate = _pre_eval_block_predicate[i];
+        auto& column = _current_return_columns[predicate->column_id()];
+        auto& stats = _predicate_stats[predicate];
+        int64_t start_ns = MonotonicNanos();
+        if (i == 0) {
+            predicate->evaluate_vec(*column, original_size, ret_flags);
+        } else {
+            predicate->evaluate_and_vec(*column, original_size, ret_flags);
+        }
+        stats.cost_ns += MonotonicNanos() - start_ns;
+        stats.evaluated_rows += original_size;
+        size_t output_rows =
+                original_size - simd::count_zero_num((int8_t*)ret_flags, original_size);
+        stats.input_rows += input_rows;
+        stats.output_rows += output_rows;
+        input_rows = output_rows;
+        // all rows are filtered, no need to evaluate the remaining predicates
+        if (output_rows == 0) {
+            break;
+        }
     }
 
     uint16_t new_size = 0;
@@ -1563,9 +1865,19 @@ uint16_t SegmentIterator::_evaluate_short_circuit_predicate(uint16_t* vec_sel_ro
 
     uint16_t original_size = selected_size;
     for (auto predicate : _short_cir_eval_predicate) {
+        if (selected_size == 0) {
+            break;
+        }
         auto column_id = predicate->column_id();
         auto& short_cir_column = _current_return_columns[column_id];
+        auto& stats = _predicate_stats[predicate];
+        int64_t start_ns = MonotonicNanos();
+        auto input_size = selected_size;
         selected_size = predicate->evaluate(*short_cir_column, vec_sel_rowid_idx, selected_size);
+        stats.cost_ns += MonotonicNanos() - start_ns;
+        stats.evaluated_rows += input_size;
+        stats.input_rows += input_size;
+        stats.output_rows += selected_size;
     }
     _opts.stats->short_circuit_cond_input_rows += original_size;
     _opts.stats->rows_short_circuit_cond_filtered += original_size - selected_size;
@@ -1588,6 +1900,16 @@ Status SegmentIterator::_read_columns_by_rowids(std::vector<ColumnId>& read_colu
         rowids[i] = rowid_vector[sel_rowid_idx[i]];
     }
 
+    if (_page_read_planner && select_size > 0) {
+        for (auto cid : read_column_ids) {
+            if (_need_read_data(cid)) {
+                RETURN_IF_ERROR(_column_iterators[_schema.unique_id(cid)]->collect_pages(
+                        rowids.data(), select_size, _page_read_planner.get()));
+            }
+        }
+        RETURN_IF_ERROR(_page_read_planner->read_pages(_opts.stats));
+    }
+
     for (auto cid : read_column_ids) {
         if (_prune_column(cid, (*mutable_columns)[cid], true, select_size)) {
             continue;
@@ -1599,6 +1921,93 @@ Status SegmentIterator::_read_columns_by_rowids(std::vector<ColumnId>& read_colu
     return Status::OK();
 }
 
+void SegmentIterator::_reorder_late_predicate_columns() {
+    // decay the old statistics, so the order can follow the change of data distribution
+    static constexpr uint64_t MAX_STAT_ROWS = 1 << 20;
+    for (auto& late_column : _late_pred_columns) {
+        if (late_column.input_rows > MAX_STAT_ROWS) {
+            late_column.input_rows >>= 1;
+            late_column.output_rows >>= 1;
+        }
+    }
+    // a column not evaluated yet is regarded as selecting all rows
+    auto pass_ratio = [](const LatePredicateColumn& late_column) {
+        return late_column.input_rows == 0
+                       ? 1.0
+                       : (double)late_column.output_rows / (double)late_column.input_rows;
+    };
+    std::stable_sort(_late_pred_columns.begin(), _late_pred_columns.end(),
+                     [&](const LatePredicateColumn& a, const LatePredicateColumn& b) {
+                         return pass_ratio(a) < pass_ratio(b);
+                     });
+}
+
+Status SegmentIterator::_evaluate_late_predicate_columns(uint16_t* sel_rowid_idx,
+                                                         uint16_t& selected_size) {
+    _reorder_late_predicate_columns();
+    std::vector<ColumnId> read_column_ids(1);
+    for (size_t i = 0; i < _late_pred_columns.size(); ++i) {
+        auto& late_column = _late_pred_columns[i];
+        auto& sel_pos = late_column.sel_pos;
+        if (selected_size == 0) {
+            sel_pos.clear();
+            continue;
+        }
+        read_column_ids[0] = late_column.cid;
+        RETURN_IF_ERROR(_read_columns_by_rowids(read_column_ids, _block_rowids, sel_rowid_idx,
+                                                selected_size, &_current_return_columns));
+        for (auto* predicate : late_column.predicates) {
+            _convert_dict_code_for_predicate_if_necessary_impl(predicate);
+        }
+
+        // row j of the column is row sel_rowid_idx[j] of the batch
+        sel_pos.resize(selected_size);
+        std::iota(sel_pos.begin(), sel_pos.end(), 0);
+        uint16_t new_size = selected_size;
+        {
+            SCOPED_RAW_TIMER(&_opts.stats->short_cond_ns);
+            auto& column = _current_return_columns[late_column.cid];
+            for (auto* predicate : late_column.predicates) {
+                new_size = predicate->evaluate(*column, sel_pos.data(), new_size);
+            }
+        }
+        _opts.stats->short_circuit_cond_input_rows += selected_size;
+        _opts.stats->rows_short_circuit_cond_filtered += selected_size - new_size;
+        late_column.input_rows += selected_size;
+        late_column.output_rows += new_size;
+
+        if (new_size < selected_size) {
+            // sel_pos is increasing, so it is safe to remap in place
+            for (size_t j = 0; j < i; ++j) {
+                auto& prev_sel_pos = _late_pred_columns[j].sel_pos;
+                for (uint16_t k = 0; k < new_size; ++k) {
+                    prev_sel_pos[k] = prev_sel_pos[sel_pos[k]];
+                }
+                prev_sel_pos.resize(new_size);
+            }
+            for (uint16_t k = 0; k < new_size; ++k) {
+                sel_rowid_idx[k] = sel_rowid_idx[sel_pos[k]];
+            }
+            sel_pos.resize(new_size);
+            selected_size = new_size;
+        }
+    }
+    return Status::OK();
+}
+
+Status SegmentIterator::_output_late_predicate_columns(vectorized::Block* block,
+                                                       uint16_t select_size) {
+    SCOPED_RAW_TIMER(&_opts.stats->output_col_ns);
+    for (auto& late_column : _late_pred_columns) {
+        DCHECK_EQ(late_column.sel_pos.size(), select_size);
+        int block_cid = _schema_block_id_map[late_column.cid];
+        RETURN_IF_ERROR(block->copy_column_data_to_block(
+                _current_return_columns[late_column.cid].get(), late_column.sel_pos.data(),
+                select_size, block_cid, _opts.block_row_max));
+    }
+    return Status::OK();
+}
+
 Status SegmentIterator::next_batch(vectorized::Block* block) {
     Status st;
     try {
@@ -1617,7 +2026,8 @@ Status SegmentIterator::_next_batch_internal(vectorized::Block* block) {
     if (UNLIKELY(!_inited)) {
         RETURN_IF_ERROR(_init());
         _inited = true;
-        if (_lazy_materialization_read || _opts.record_rowids || _is_need_expr_eval) {
+        if (_lazy_materialization_read || _opts.record_rowids || _is_need_expr_eval ||
+            !_late_pred_columns.empty()) {
             _block_rowids.resize(_opts.block_row_max);
         }
         _current_return_columns.resize(_schema.columns().size());
@@ -1646,6 +2056,17 @@ Status SegmentIterator::_next_batch_internal(vectorized::Block* block) {
 
     _init_current_block(block, _current_return_columns);
 
+    // should NOT apply for order by key, see _vec_init_lazy_materialization
+    if (_opts.use_topn_opt &&
+        !(_opts.read_orderby_key_columns != nullptr && !_opts.read_orderby_key_columns->empty())) {
+        RETURN_IF_ERROR(_apply_tightened_runtime_predicate());
+    }
+
+    if (++_num_batches_since_reorder >= PREDICATE_REORDER_INTERVAL_BATCHES) {
+        _num_batches_since_reorder = 0;
+        _reorder_predicates();
+    }
+
     _current_batch_rows_read = 0;
     uint32_t nrows_read_limit = _opts.block_row_max;
     if (_wait_times_estimate_row_size > 0) {
@@ -1659,7 +2080,8 @@ Status SegmentIterator::_next_batch_internal(vectorized::Block* block) {
     _split_row_ranges.reserve(nrows_read_limit / 2);
     RETURN_IF_ERROR(_read_columns_by_index(
             nrows_read_limit, _current_batch_rows_read,
-            _lazy_materialization_read || _opts.record_rowids || _is_need_expr_eval));
+            _lazy_materialization_read || _opts.record_rowids || _is_need_expr_eval ||
+                    !_late_pred_columns.empty()));
     if (std::find(_first_read_column_ids.begin(), _first_read_column_ids.end(),
                   _schema.version_col_idx()) != _first_read_column_ids.end()) {
         _replace_version_col(_current_batch_rows_read);
@@ -1699,6 +2121,11 @@ Status SegmentIterator::_next_batch_internal(vectorized::Block* block) {
             //          In SSB test, it make no difference; So need more scenarios to test
             selected_size = _evaluate_short_circuit_predicate(sel_rowid_idx, selected_size);
 
+            // step 2.1: read late predicate columns for the selected rows and evaluate them
+            if (!_late_pred_columns.empty()) {
+                RETURN_IF_ERROR(_evaluate_late_predicate_columns(sel_rowid_idx, selected_size));
+            }
+
             if (selected_size > 0) {
                 // step 3.1: output short circuit and predicate column
                 // when lazy materialization enables, _first_read_column_ids = distinct(_short_cir_pred_column_ids + _vec_pred_column_ids)
@@ -1706,6 +2133,7 @@ Status SegmentIterator::_next_batch_internal(vectorized::Block* block) {
                 // todo(wb) need to tell input columnids from output columnids
                 RETURN_IF_ERROR(_output_column_by_sel_idx(block, _first_read_column_ids,
                                                           sel_rowid_idx, selected_size));
+                RETURN_IF_ERROR(_output_late_predicate_columns(block, selected_size));
 
                 // step 3.2: read remaining expr column and evaluate it.
                 if (_is_need_expr_eval) {
@@ -2027,6 +2455,24 @@ void SegmentIterator::_convert_dict_code_for_predicate_if_necessary_impl(
     }
 }
 
+void SegmentIterator::_reorder_predicates() {
+    auto by_rank = [this](const ColumnPredicate* a, const ColumnPredicate* b) {
+        return _predicate_stats[a].rank() < _predicate_stats[b].rank();
+    };
+    auto reorder = [&](std::vector<ColumnPredicate*>& predicates) {
+        if (predicates.size() < 2) {
+            return;
+        }
+        auto old_predicates = predicates;
+        std::stable_sort(predicates.begin(), predicates.end(), by_rank);
+        if (old_predicates != predicates) {
+            _opts.stats->predicate_reorder_num++;
+        }
+    };
+    reorder(_pre_eval_block_predicate);
+    reorder(_short_cir_eval_predicate);
+}
+
 void SegmentIterator::_update_max_row(const vectorized::Block* block) {
     _estimate_row_size = false;
     auto avg_row_size = block->bytes() / block->rows();
@@ -28,6 +28,7 @@
 #include "olap/row_cursor.h"
 #include "olap/rowset/segment_v2/common.h"
 #include "olap/rowset/segment_v2/inverted_index_reader.h"
+#include "olap/rowset/segment_v2/page_read_planner.h"
 #include "olap/rowset/segment_v2/row_ranges.h"
 #include "olap/rowset/segment_v2/segment.h"
 #include "olap/schema.h"
@@ -103,6 +104,14 @@ public:
         bool updated = false;
         updated |= _update_profile(profile, _short_cir_eval_predicate, "ShortCircuitPredicates");
         updated |= _update_profile(profile, _pre_eval_block_predicate, "PreEvaluatePredicates");
+        if (!_late_pred_columns.empty()) {
+            std::vector<ColumnPredicate*> late_predicates;
+            for (auto& late_column : _late_pred_columns) {
+                late_predicates.insert(late_predicates.end(), late_column.predicates.begin(),
+                                       late_column.predicates.end());
+            }
+            updated |= _update_profile(profile, late_predicates, "LateMaterializedPredicates");
+        }
 
         if (_opts.delete_condition_predicates != nullptr) {
             std::set<const ColumnPredicate*> delete_predicate_set;
@@ -125,6 +134,12 @@ private:
         std::string info;
         for (auto pred : predicates) {
             info += "\n" + pred->debug_string();
+            auto it = _predicate_stats.find(pred);
+            if (it != _predicate_stats.end() && it->second.input_rows > 0) {
+                info += fmt::format(", InputRows: {}, OutputRows: {}, NsPerRow: {:.2f}",
+                                    it->second.input_rows, it->second.output_rows,
+                                    it->second.cost_per_row());
+            }
         }
         profile->add_info_string(title, info);
         return true;
@@ -139,11 +154,12 @@ private:
     // calculate row ranges that fall into requested key ranges using short key index
     [[nodiscard]] Status _get_row_ranges_by_keys();
     [[nodiscard]] Status _prepare_seek(const StorageReadOptions::KeyRange& key_range);
-    [[nodiscard]] Status _lookup_ordinal(const RowCursor& key, bool is_include, rowid_t upper_bound,
-                                         rowid_t* rowid);
+    [[nodiscard]] Status _lookup_ordinal(const RowCursor& key, bool is_include, rowid_t lower_bound,
+                                         rowid_t upper_bound, rowid_t* rowid);
     // lookup the ordinal of given key from short key index
     [[nodiscard]] Status _lookup_ordinal_from_sk_index(const RowCursor& key, bool is_include,
-                                                       rowid_t upper_bound, rowid_t* rowid);
+                                                       rowid_t lower_bound, rowid_t upper_bound,
+                                                       rowid_t* rowid);
     // lookup the ordinal of given key from primary key index
     [[nodiscard]] Status _lookup_ordinal_from_pk_index(const RowCursor& key, bool is_include,
                                                        rowid_t* rowid);
@@ -152,6 +168,11 @@ private:
     // calculate row ranges that satisfy requested column conditions using various column index
     [[nodiscard]] Status _get_row_ranges_by_column_conditions();
     [[nodiscard]] Status _get_row_ranges_from_conditions(RowRanges* condition_row_ranges);
+    [[nodiscard]] Status _get_row_ranges_by_runtime_predicate(
+            const std::shared_ptr<ColumnPredicate>& runtime_predicate, RowRanges* row_ranges);
+    // the runtime predicate of topn is tightened while the segment is read, prune the rows not
+    // read yet by the zone map of the new predicate, and evaluate the new predicate on them.
+    [[nodiscard]] Status _apply_tightened_runtime_predicate();
     [[nodiscard]] Status _apply_bitmap_index();
     [[nodiscard]] Status _apply_inverted_index();
     [[nodiscard]] Status _apply_inverted_index_on_column_predicate(
@@ -166,6 +187,10 @@ private:
             ColumnPredicate* pred, roaring::Roaring* output_result);
     [[nodiscard]] Status _apply_inverted_index_except_leafnode_of_andnode(
             ColumnPredicate* pred, roaring::Roaring* output_result);
+    // Evaluates a match predicate on the data of the rows of `bitmap` if the inverted index of
+    // the segment is not built yet, e.g. it's added later or its build is deferred to compaction.
+    [[nodiscard]] Status _evaluate_match_without_index(ColumnPredicate* pred,
+                                                       roaring::Roaring* bitmap);
     bool _column_has_fulltext_index(int32_t unique_id);
     inline bool _inverted_index_not_support_pred_type(const PredicateType& type);
     bool _can_filter_by_preds_except_leafnode_of_andnode();
@@ -195,6 +220,13 @@ private:
     uint16_t _evaluate_vectorization_predicate(uint16_t* sel_rowid_idx, uint16_t selected_size);
     uint16_t _evaluate_short_circuit_predicate(uint16_t* sel_rowid_idx, uint16_t selected_size);
     void _output_non_pred_columns(vectorized::Block* block);
+    void _init_late_predicate_columns(const std::set<ColumnId>& del_cond_id_set);
+    // Read each late predicate column for the selected rows and evaluate its predicates.
+    [[nodiscard]] Status _evaluate_late_predicate_columns(uint16_t* sel_rowid_idx,
+                                                          uint16_t& selected_size);
+    [[nodiscard]] Status _output_late_predicate_columns(vectorized::Block* block,
+                                                        uint16_t select_size);
+    void _reorder_late_predicate_columns();
     [[nodiscard]] Status _read_columns_by_rowids(std::vector<ColumnId>& read_column_ids,
                                                  std::vector<rowid_t>& rowid_vector,
                                                  uint16_t* sel_rowid_idx, size_t select_size,
@@ -229,6 +261,10 @@ private:
 
     void _update_max_row(const vectorized::Block* block);
 
+    // Sort _pre_eval_block_predicate and _short_cir_eval_predicate by the observed
+    // cost and selectivity, the cheapest and most selective first.
+    void _reorder_predicates();
+
     bool _check_apply_by_bitmap_index(ColumnPredicate* pred);
     bool _check_apply_by_inverted_index(ColumnPredicate* pred, bool pred_in_compound = false);
 
@@ -347,8 +383,47 @@ private:
     vectorized::MutableColumns _current_return_columns;
     std::vector<ColumnPredicate*> _pre_eval_block_predicate;
     std::vector<ColumnPredicate*> _short_cir_eval_predicate;
+    // running statistics of each predicate in _pre_eval_block_predicate and
+    // _short_cir_eval_predicate, used to reorder them
+    struct PredicateStats {
+        // rows passed to the predicate and rows selected after it
+        uint64_t input_rows = 0;
+        uint64_t output_rows = 0;
+        // rows actually evaluated, vectorized predicates evaluate all rows of the batch
+        uint64_t evaluated_rows = 0;
+        uint64_t cost_ns = 0;
+
+        double cost_per_row() const {
+            return evaluated_rows == 0 ? 0 : (double)cost_ns / (double)evaluated_rows;
+        }
+        // expected cost to filter out a row, lower is better
+        double rank() const {
+            if (input_rows == 0) {
+                // not evaluated yet, try it first to get statistics
+                return 0;
+            }
+            double filter_ratio = 1 - (double)output_rows / (double)input_rows;
+            return cost_per_row() / std::max(filter_ratio, 1e-3);
+        }
+    };
+    std::unordered_map<const ColumnPredicate*, PredicateStats> _predicate_stats;
+    uint32_t _num_batches_since_reorder = 0;
+    static constexpr uint32_t PREDICATE_REORDER_INTERVAL_BATCHES = 8;
     std::vector<uint32_t> _delete_range_column_ids;
     std::vector<uint32_t> _delete_bloom_filter_column_ids;
+    // A column only used by short circuit predicates, which is not in _first_read_column_ids,
+    // but read after the other predicates are evaluated, only for the selected rows.
+    struct LatePredicateColumn {
+        ColumnId cid;
+        std::vector<ColumnPredicate*> predicates;
+        // observed selectivity, to read the most selective column first
+        uint64_t input_rows = 0;
+        uint64_t output_rows = 0;
+        // the positions in the column of the selected rows of current batch,
+        // because the column only holds the rows selected when it is read.
+        std::vector<uint16_t> sel_pos;
+    };
+    std::vector<LatePredicateColumn> _late_pred_columns;
     // when lazy materialization is enabled, segmentIter need to read data at least twice
     // first, read predicate columns by various index
     // second, read non-predicate columns
@@ -378,6 +453,8 @@ private:
     std::set<ColumnId> _not_apply_index_pred;
 
     std::shared_ptr<ColumnPredicate> _runtime_predicate {nullptr};
+    // the runtime predicate applied to the zone maps of _row_bitmap
+    std::shared_ptr<ColumnPredicate> _zone_map_runtime_predicate {nullptr};
     std::set<int32_t> _output_columns;
 
     // row schema of the key to seek
@@ -392,6 +469,9 @@ private:
 
     io::FileReaderSPtr _file_reader;
 
+    // merge the reads of the data pages of the columns, null if disabled
+    std::unique_ptr<PageReadPlanner> _page_read_planner;
+
     // char_type or array<char> type columns cid
     std::vector<size_t> _char_type_idx;
     std::vector<size_t> _char_type_idx_no_0;
@@ -17,23 +17,32 @@
 
 #include "olap/rowset/segment_v2/segment_writer.h"
 
+#include <atomic>
+
 #include "common/config.h"
 #include "common/consts.h"
 #include "common/logging.h" // LOG
 #include "io/fs/file_writer.h"
 #include "olap/data_dir.h"
+#include "olap/inverted_index_parser.h"
 #include "olap/primary_key_index.h"
 #include "olap/row_cursor.h"                      // RowCursor
 #include "olap/rowset/rowset_writer_context.h"    // RowsetWriterContext
+#include "olap/rowset/segment_v2/bitmap_index_writer.h"
+#include "olap/rowset/segment_v2/bloom_filter_index_writer.h"
 #include "olap/rowset/segment_v2/column_writer.h" // ColumnWriter
 #include "olap/rowset/segment_v2/page_io.h"
 #include "olap/schema.h"
 #include "olap/short_key_index.h"
+#include "olap/storage_engine.h"
+#include "olap/utils.h"
 #include "runtime/memory/mem_tracker.h"
+#include "runtime/thread_context.h"
 #include "service/point_query_executor.h"
 #include "util/crc32c.h"
 #include "util/faststring.h"
 #include "util/key_util.h"
+#include "util/runtime_profile.h"
 #include "vec/common/schema_util.h"
 
 namespace doris {
@@ -134,6 +143,15 @@ Status SegmentWriter::init(const std::vector<uint32_t>& col_ids, bool has_key,
             opts.is_ngram_bf_index = true;
             opts.gram_size = tablet_index->get_gram_size();
             opts.gram_bf_size = tablet_index->get_gram_bf_size();
+        } else if (!opts.need_bloom_filter && opts.need_zone_map &&
+                   is_string_type(column.type()) && config::string_column_ngram_bf_size > 0) {
+            // the case is ignored, so that the pages may also be pruned for the terms of the
+            // MATCH predicates, which are lowercased by the parsers
+            opts.need_bloom_filter = true;
+            opts.is_ngram_bf_index = true;
+            opts.gram_size = config::string_column_ngram_bf_gram_size;
+            opts.gram_bf_size = config::string_column_ngram_bf_size;
+            opts.ngram_bf_ignore_case = true;
         }
 
         opts.need_bitmap_index = column.has_bitmap_index();
@@ -151,6 +169,15 @@ Status SegmentWriter::init(const std::vector<uint32_t>& col_ids, bool has_key,
                 break;
             }
         }
+        // an untokenized inverted index is written as a bitmap index inside the segment, which
+        // is read through the page cache instead of the CLucene files
+        if (opts.inverted_index != nullptr && config::enable_native_inverted_index &&
+            BitmapIndexWriter::is_supported_type(column.type()) &&
+            get_inverted_index_parser_type_from_string(get_parser_string_from_properties(
+                    opts.inverted_index->properties())) == InvertedIndexParserType::PARSER_NONE) {
+            opts.need_bitmap_index = true;
+            opts.inverted_index = nullptr;
+        }
         if (column.type() == FieldType::OLAP_FIELD_TYPE_STRUCT) {
             opts.need_zone_map = false;
             if (opts.need_bloom_filter) {
@@ -197,6 +224,7 @@ Status SegmentWriter::init(const std::vector<uint32_t>& col_ids, bool has_key,
         RETURN_IF_ERROR(ColumnWriter::create(opts, &column, _file_writer, &writer));
         RETURN_IF_ERROR(writer->init());
         _column_writers.push_back(std::move(writer));
+        _column_encode_ns.emplace_back(column.name(), 0);
 
         _olap_data_convertor->add_column_data_convertor(column);
         return Status::OK();
@@ -254,13 +282,20 @@ Status SegmentWriter::_create_writers_with_dynamic_block(
     RETURN_IF_ERROR(vectorized::schema_util::send_fetch_full_base_schema_view_rpc(&schema_view));
     // create writers with static columns
     for (size_t i = 0; i < _tablet_schema->columns().size(); ++i) {
-        create_column_writer(i, _tablet_schema->column(i));
+        RETURN_IF_ERROR(create_column_writer(i, _tablet_schema->column(i)));
     }
     // create writers with auto generated columns
     for (size_t i = _tablet_schema->columns().size(); i < block->columns(); ++i) {
         const auto& column_type_name = block->get_by_position(i);
         const auto& tcolumn = schema_view.column_name_to_column[column_type_name.name];
         TabletColumn new_column(tcolumn);
+        // the extended columns are recorded into the rowset schema, so that the compactions
+        // keep writing the bloom filters
+        if (config::enable_dynamic_subcolumn_bloom_filter && !new_column.is_key() &&
+            BloomFilterIndexWriter::is_supported_type(new_column.type()) &&
+            !(is_string_type(new_column.type()) && config::string_column_ngram_bf_size > 0)) {
+            new_column.set_is_bf_column(true);
+        }
         RETURN_IF_ERROR(create_column_writer(i, new_column));
         _opts.rowset_ctx->schema_change_recorder->add_extended_columns(new_column,
                                                                        schema_view.schema_version);
@@ -279,6 +314,62 @@ void SegmentWriter::_maybe_invalid_row_cache(const std::string& key) {
     }
 }
 
+Status SegmentWriter::_append_columns(
+        size_t num_rows, std::vector<vectorized::IOlapColumnDataAccessor*>* accessors) {
+    size_t num_columns = _column_writers.size();
+    accessors->assign(num_columns, nullptr);
+    auto append_column = [&](size_t id) -> Status {
+        SCOPED_RAW_TIMER(&_column_encode_ns[id].second);
+        auto converted_result = _olap_data_convertor->convert_column_data(id);
+        RETURN_IF_ERROR(converted_result.first);
+        (*accessors)[id] = converted_result.second;
+        return _column_writers[id]->append(converted_result.second->get_nullmap(),
+                                           converted_result.second->get_data(), num_rows);
+    };
+
+    auto* engine = StorageEngine::instance();
+    ThreadPool* thread_pool =
+            engine == nullptr ? nullptr : engine->segment_column_encode_thread_pool();
+    if (thread_pool == nullptr || num_columns < config::segment_parallel_encode_min_columns) {
+        for (size_t id = 0; id < num_columns; ++id) {
+            RETURN_IF_ERROR(append_column(id));
+        }
+        return Status::OK();
+    }
+
+    // The columns are independent, and the column writers keep their pages in memory until
+    // _write_data() writes them one by one, so the layout of the file is the same as before.
+    // The columns are taken one at a time by this thread and the tasks, so the block is done by
+    // this thread alone if the pool is busy.
+    std::vector<Status> statuses(num_columns);
+    std::atomic<size_t> next_id {0};
+    auto append_columns = [&]() {
+        for (size_t id = next_id++; id < num_columns; id = next_id++) {
+            statuses[id] = append_column(id);
+        }
+    };
+    auto token = thread_pool->new_token(ThreadPool::ExecutionMode::CONCURRENT);
+    auto mem_tracker = thread_context()->thread_mem_tracker_mgr->limiter_mem_tracker();
+    size_t num_tasks = std::min<size_t>(num_columns / config::segment_parallel_encode_min_columns,
+                                        config::segment_column_encode_max_thread);
+    for (size_t i = 1; i < num_tasks; ++i) {
+        Status st = token->submit_func([&]() {
+            SCOPED_ATTACH_TASK(mem_tracker);
+            append_columns();
+        });
+        if (!st.ok()) {
+            // the remaining columns are appended by this thread
+            break;
+        }
+    }
+    append_columns();
+    token->wait();
+    for (auto& st : statuses) {
+        RETURN_IF_ERROR(st);
+    }
+    return Status::OK();
+}
+
 Status SegmentWriter::append_block(const vectorized::Block* block, size_t row_pos,
                                    size_t num_rows) {
     CHECK(block->columns() >= _column_writers.size())
@@ -306,21 +397,16 @@ Status SegmentWriter::append_block(const vectorized::Block* block, size_t row_po
     // convert column data from engine format to storage layer format
     std::vector<vectorized::IOlapColumnDataAccessor*> key_columns;
     vectorized::IOlapColumnDataAccessor* seq_column = nullptr;
+    std::vector<vectorized::IOlapColumnDataAccessor*> accessors;
+    RETURN_IF_ERROR(_append_columns(num_rows, &accessors));
     for (size_t id = 0; id < _column_writers.size(); ++id) {
-        // olap data convertor alway start from id = 0
-        auto converted_result = _olap_data_convertor->convert_column_data(id);
-        if (converted_result.first != Status::OK()) {
-            return converted_result.first;
-        }
         auto cid = _column_ids[id];
         if (_has_key && cid < _num_key_columns) {
-            key_columns.push_back(converted_result.second);
+            key_columns.push_back(accessors[id]);
         } else if (_has_key && _tablet_schema->has_sequence_col() &&
                    cid == _tablet_schema->sequence_col_idx()) {
-            seq_column = converted_result.second;
+            seq_column = accessors[id];
         }
-        RETURN_IF_ERROR(_column_writers[id]->append(converted_result.second->get_nullmap(),
-                                                    converted_result.second->get_data(), num_rows));
     }
     if (_has_key) {
         if (_tablet_schema->keys_type() == UNIQUE_KEYS && _opts.enable_unique_key_merge_on_write) {
@@ -538,6 +624,23 @@ Status SegmentWriter::finalize_footer() {
     return Status::OK();
 }
 
+Status SegmentWriter::create_column_group_writer(const std::vector<uint32_t>& col_ids,
+                                                 std::unique_ptr<SegmentWriter>* writer) {
+    DCHECK(_column_writers.empty()) << "the key group is not finalized";
+    writer->reset(new SegmentWriter(_file_writer, _segment_id, _tablet_schema, _data_dir,
+                                    _max_row_per_segment, _opts));
+    (*writer)->_row_count = _row_count;
+    return (*writer)->init(col_ids, false);
+}
+
+void SegmentWriter::add_column_metas(SegmentWriter* group_writer) {
+    auto* metas = group_writer->_footer.mutable_columns();
+    for (auto& meta : *metas) {
+        _footer.add_columns()->Swap(&meta);
+    }
+    metas->Clear();
+}
+
 Status SegmentWriter::finalize(uint64_t* segment_file_size, uint64_t* index_size) {
     // check disk capacity
     if (_data_dir != nullptr && _data_dir->reach_capacity_limit((int64_t)estimate_segment_size())) {
@@ -556,11 +659,19 @@ Status SegmentWriter::finalize(uint64_t* segment_file_size, uint64_t* index_size
     return Status::OK();
 }
 
+void SegmentWriter::collect_column_encode_time(
+        std::map<std::string, int64_t>* column_encode_ns) const {
+    for (const auto& [name, ns] : _column_encode_ns) {
+        (*column_encode_ns)[name] += ns;
+    }
+}
+
 void SegmentWriter::clear() {
     for (auto& column_writer : _column_writers) {
         column_writer.reset();
     }
     _column_writers.clear();
+    _column_encode_ns.clear();
     _column_ids.clear();
     _olap_data_convertor.reset();
 }
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <cstdint>
+#include <map>
 #include <memory> // unique_ptr
 #include <string>
 #include <vector>
@@ -102,6 +103,13 @@ public:
     Status finalize_footer(uint64_t* segment_file_size);
     Status finalize_footer();
 
+    // for parallel vertical compaction, create a writer of a value column group of this segment
+    // after the key group is finalized. The writer shares the file of this segment, and its column
+    // metas are moved into the footer of this segment by add_column_metas() after it's finalized.
+    Status create_column_group_writer(const std::vector<uint32_t>& col_ids,
+                                      std::unique_ptr<SegmentWriter>* writer);
+    void add_column_metas(SegmentWriter* group_writer);
+
     static void init_column_meta(ColumnMetaPB* meta, uint32_t column_id, const TabletColumn& column,
                                  TabletSchemaSPtr tablet_schema);
     Slice min_encoded_key();
@@ -109,6 +117,9 @@ public:
 
     KeySetPtr get_key_set() { return _key_set; }
 
+    // Adds the time of converting and encoding each column into `column_encode_ns` by name.
+    void collect_column_encode_time(std::map<std::string, int64_t>* column_encode_ns) const;
+
     DataDir* get_data_dir() { return _data_dir; }
     bool is_unique_key() { return _tablet_schema->keys_type() == UNIQUE_KEYS; }
 
@@ -130,6 +141,10 @@ private:
     Status _write_primary_key_index();
     Status _write_footer();
     Status _write_raw_data(const std::vector<Slice>& slices);
+    // Converts and appends `num_rows` rows of every column, whose converted data is returned in
+    // `accessors` by the index of the column writer.
+    Status _append_columns(size_t num_rows,
+                           std::vector<vectorized::IOlapColumnDataAccessor*>* accessors);
     void _maybe_invalid_row_cache(const std::string& key);
     std::string _encode_keys(const std::vector<vectorized::IOlapColumnDataAccessor*>& key_columns,
                              size_t pos, bool null_first = true);
@@ -161,6 +176,8 @@ private:
     std::unique_ptr<ShortKeyIndexBuilder> _short_key_index_builder;
     std::unique_ptr<PrimaryKeyIndexBuilder> _primary_key_index_builder;
     std::vector<std::unique_ptr<ColumnWriter>> _column_writers;
+    // the name and the encode time of the column by the index of the column writer
+    std::vector<std::pair<std::string, int64_t>> _column_encode_ns;
     std::unique_ptr<MemTracker> _mem_tracker;
 
     std::unique_ptr<vectorized::OlapBlockDataConvertor> _olap_data_convertor;
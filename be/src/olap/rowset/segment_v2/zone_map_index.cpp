@@ -59,7 +59,9 @@ void TypedZoneMapIndexWriter<Type>::add_values(const void* values, size_t count)
 template <PrimitiveType Type>
 void TypedZoneMapIndexWriter<Type>::moidfy_index_before_flush(
         struct doris::segment_v2::ZoneMap& zone_map) {
-    _field->modify_zone_map_index(zone_map.max_value);
+    if (!zone_map.pass_all && !_field->modify_zone_map_index(zone_map.max_value)) {
+        zone_map.pass_all = true;
+    }
 }
 
 template <PrimitiveType Type>
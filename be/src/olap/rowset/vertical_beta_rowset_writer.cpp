@@ -28,6 +28,7 @@ VerticalBetaRowsetWriter::~VerticalBetaRowsetWriter() {
         if (!fs) {
             return;
         }
+        _group_writers.clear();
         for (auto& segment_writer : _segment_writers) {
             segment_writer.reset();
         }
@@ -101,6 +102,67 @@ Status VerticalBetaRowsetWriter::add_columns(const vectorized::Block* block,
     return Status::OK();
 }
 
+Status VerticalBetaRowsetWriter::add_group_columns(const vectorized::Block* block,
+                                                   const std::vector<uint32_t>& col_ids,
+                                                   size_t group_idx,
+                                                   uint32_t max_rows_per_segment) {
+    size_t num_rows = block->rows();
+    if (num_rows == 0) {
+        return Status::OK();
+    }
+    if (UNLIKELY(max_rows_per_segment > _context.max_rows_per_segment)) {
+        max_rows_per_segment = _context.max_rows_per_segment;
+    }
+    // the key group has been flushed, and the segment writers are not changed any more
+    DCHECK(!_segment_writers.empty());
+    auto* group_writer = _get_group_writer(group_idx);
+    if (group_writer->writer == nullptr) {
+        RETURN_IF_ERROR(_segment_writers[group_writer->cur_writer_idx]->create_column_group_writer(
+                col_ids, &group_writer->writer));
+    } else if (group_writer->writer->num_rows_written() > max_rows_per_segment) {
+        RETURN_IF_ERROR(_flush_group_columns(group_writer));
+        // switch to next segment
+        ++group_writer->cur_writer_idx;
+        if (group_writer->cur_writer_idx >= _segment_writers.size()) {
+            LOG(WARNING) << "more rows in value column group " << group_idx
+                         << " than the key group, segments: " << _segment_writers.size();
+            return Status::InternalError("more rows in value column group than the key group");
+        }
+        RETURN_IF_ERROR(_segment_writers[group_writer->cur_writer_idx]->create_column_group_writer(
+                col_ids, &group_writer->writer));
+    }
+    return group_writer->writer->append_block(block, 0, num_rows);
+}
+
+VerticalBetaRowsetWriter::ColumnGroupWriter* VerticalBetaRowsetWriter::_get_group_writer(
+        size_t group_idx) {
+    std::lock_guard<std::mutex> l(_group_writers_lock);
+    return &_group_writers[group_idx];
+}
+
+Status VerticalBetaRowsetWriter::_flush_group_columns(ColumnGroupWriter* group_writer) {
+    uint64_t index_size = 0;
+    auto& segment_writer = _segment_writers[group_writer->cur_writer_idx];
+    {
+        std::lock_guard<std::mutex> l(*_segment_flush_locks[group_writer->cur_writer_idx]);
+        RETURN_IF_ERROR(group_writer->writer->finalize_columns_data());
+        RETURN_IF_ERROR(group_writer->writer->finalize_columns_index(&index_size));
+        segment_writer->add_column_metas(group_writer->writer.get());
+    }
+    // release the memory of the columns as soon as they are flushed
+    group_writer->writer.reset();
+    _total_index_size += static_cast<int64_t>(index_size);
+    return Status::OK();
+}
+
+Status VerticalBetaRowsetWriter::flush_group_columns(size_t group_idx) {
+    auto* group_writer = _get_group_writer(group_idx);
+    if (group_writer->writer == nullptr) {
+        return Status::OK();
+    }
+    return _flush_group_columns(group_writer);
+}
+
 Status VerticalBetaRowsetWriter::_flush_columns(
         std::unique_ptr<segment_v2::SegmentWriter>* segment_writer, bool is_key) {
     uint64_t index_size = 0;
@@ -159,6 +221,7 @@ Status VerticalBetaRowsetWriter::_create_segment_writer(
         std::lock_guard<SpinLock> l(_lock);
         _file_writers.push_back(std::move(file_writer));
     }
+    _segment_flush_locks.emplace_back(new std::mutex());
 
     auto s = (*writer)->init(column_ids, is_key);
     if (!s.ok()) {
@@ -17,6 +17,9 @@
 
 #pragma once
 
+#include <map>
+#include <mutex>
+
 #include "olap/rowset/beta_rowset_writer.h"
 #include "olap/rowset/segment_v2/segment_writer.h"
 
@@ -31,9 +34,15 @@ public:
     Status add_columns(const vectorized::Block* block, const std::vector<uint32_t>& col_ids,
                        bool is_key, uint32_t max_rows_per_segment);
 
+    // for the value column groups merged in parallel
+    Status add_group_columns(const vectorized::Block* block, const std::vector<uint32_t>& col_ids,
+                             size_t group_idx, uint32_t max_rows_per_segment);
+
     // flush last segment's column
     Status flush_columns(bool is_key);
 
+    Status flush_group_columns(size_t group_idx);
+
     // flush when all column finished, flush column footer
     Status final_flush();
 
@@ -45,9 +54,24 @@ private:
     Status _flush_columns(std::unique_ptr<segment_v2::SegmentWriter>* segment_writer,
                           bool is_key = false);
 
+    // the columns of a value column group in the current segment of the group
+    struct ColumnGroupWriter {
+        std::unique_ptr<segment_v2::SegmentWriter> writer;
+        size_t cur_writer_idx = 0;
+    };
+
+    ColumnGroupWriter* _get_group_writer(size_t group_idx);
+
+    Status _flush_group_columns(ColumnGroupWriter* group_writer);
+
 private:
     std::vector<std::unique_ptr<segment_v2::SegmentWriter>> _segment_writers;
     size_t _cur_writer_idx = 0;
+
+    // the groups write the file of a segment one by one
+    std::vector<std::unique_ptr<std::mutex>> _segment_flush_locks;
+    std::mutex _group_writers_lock;
+    std::map<size_t, ColumnGroupWriter> _group_writers;
 };
 
 } // namespace doris
\ No newline at end of file
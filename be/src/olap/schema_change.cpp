@@ -19,6 +19,10 @@
 
 #include <gen_cpp/olap_file.pb.h>
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 #include "common/config.h"
 #include "common/status.h"
 #include "gutil/integral_types.h"
@@ -38,6 +42,7 @@
 #include "olap/utils.h"
 #include "olap/wrapper_field.h"
 #include "runtime/memory/mem_tracker.h"
+#include "runtime/thread_context.h"
 #include "util/defer_op.h"
 #include "vec/aggregate_functions/aggregate_function.h"
 #include "vec/aggregate_functions/aggregate_function_reader.h"
@@ -1569,10 +1574,8 @@ Status SchemaChangeHandler::_convert_historical_rowsets(const SchemaChangeParams
     }
 
     // b. Generate historical data converter
-    auto sc_procedure = get_sc_procedure(changer, sc_sorting, sc_directly);
-
-    // c.Convert historical data
-    for (auto& rs_reader : sc_params.ref_rowset_readers) {
+    auto convert_rowset = [&](const RowsetReaderSharedPtr& rs_reader,
+                              SchemaChange* sc_procedure) -> Status {
         VLOG_TRACE << "begin to convert a history rowset. version=" << rs_reader->version().first
                    << "-" << rs_reader->version().second;
 
@@ -1592,19 +1595,18 @@ Status SchemaChangeHandler::_convert_historical_rowsets(const SchemaChangeParams
         context.fs = rs_reader->rowset()->rowset_meta()->fs();
         Status status = new_tablet->create_rowset_writer(context, &rowset_writer);
         if (!status.ok()) {
-            res = Status::Error<ROWSET_BUILDER_INIT>();
-            return process_alter_exit();
+            return Status::Error<ROWSET_BUILDER_INIT>();
         }
 
-        if (res = sc_procedure->process(rs_reader, rowset_writer.get(), sc_params.new_tablet,
-                                        sc_params.base_tablet, sc_params.base_tablet_schema);
-            !res) {
+        if (status = sc_procedure->process(rs_reader, rowset_writer.get(), sc_params.new_tablet,
+                                           sc_params.base_tablet, sc_params.base_tablet_schema);
+            !status) {
             LOG(WARNING) << "failed to process the version."
                          << " version=" << rs_reader->version().first << "-"
-                         << rs_reader->version().second << ", " << res.to_string();
+                         << rs_reader->version().second << ", " << status.to_string();
             new_tablet->data_dir()->remove_pending_ids(ROWSET_ID_PREFIX +
                                                        rowset_writer->rowset_id().to_string());
-            return process_alter_exit();
+            return status;
         }
         new_tablet->data_dir()->remove_pending_ids(ROWSET_ID_PREFIX +
                                                    rowset_writer->rowset_id().to_string());
@@ -1614,22 +1616,22 @@ Status SchemaChangeHandler::_convert_historical_rowsets(const SchemaChangeParams
         RowsetSharedPtr new_rowset = rowset_writer->build();
         if (new_rowset == nullptr) {
             LOG(WARNING) << "failed to build rowset, exit alter process";
-            return process_alter_exit();
+            return Status::Error<ROWSET_BUILDER_INIT>();
         }
-        res = sc_params.new_tablet->add_rowset(new_rowset);
-        if (res.is<PUSH_VERSION_ALREADY_EXIST>()) {
+        status = sc_params.new_tablet->add_rowset(new_rowset);
+        if (status.is<PUSH_VERSION_ALREADY_EXIST>()) {
             LOG(WARNING) << "version already exist, version revert occurred. "
                          << "tablet=" << sc_params.new_tablet->full_name() << ", version='"
                          << rs_reader->version().first << "-" << rs_reader->version().second;
             StorageEngine::instance()->add_unused_rowset(new_rowset);
-            res = Status::OK();
-        } else if (!res) {
+            status = Status::OK();
+        } else if (!status) {
             LOG(WARNING) << "failed to register new version. "
                          << " tablet=" << sc_params.new_tablet->full_name()
                          << ", version=" << rs_reader->version().first << "-"
                          << rs_reader->version().second;
             StorageEngine::instance()->add_unused_rowset(new_rowset);
-            return process_alter_exit();
+            return status;
         } else {
             VLOG_NOTICE << "register new version. tablet=" << sc_params.new_tablet->full_name()
                         << ", version=" << rs_reader->version().first << "-"
@@ -1639,6 +1641,48 @@ Status SchemaChangeHandler::_convert_historical_rowsets(const SchemaChangeParams
         VLOG_TRACE << "succeed to convert a history version."
                    << " version=" << rs_reader->version().first << "-"
                    << rs_reader->version().second;
+        return Status::OK();
+    };
+
+    // c.Convert historical data
+    // The rowsets are converted by the threads in parallel, each of which has its own converter,
+    // and the threads stop picking rowsets once any conversion fails. The threads are attached to
+    // the memory tracker of the alter task, so their memory is governed by its limit.
+    const auto& rs_readers = sc_params.ref_rowset_readers;
+    size_t num_threads = std::min<size_t>(
+            std::max(config::schema_change_convert_rowset_thread_num, 1), rs_readers.size());
+    std::atomic<size_t> next_rowset {0};
+    std::mutex res_lock;
+    auto convert_worker = [&]() {
+        auto sc_procedure = get_sc_procedure(changer, sc_sorting, sc_directly);
+        while (true) {
+            size_t i = next_rowset++;
+            if (i >= rs_readers.size()) {
+                return;
+            }
+            auto status = convert_rowset(rs_readers[i], sc_procedure.get());
+            if (!status.ok()) {
+                std::lock_guard<std::mutex> l(res_lock);
+                res = status;
+                next_rowset = rs_readers.size();
+                return;
+            }
+        }
+    };
+    if (num_threads <= 1) {
+        convert_worker();
+    } else {
+        auto mem_tracker = thread_context()->thread_mem_tracker_mgr->limiter_mem_tracker();
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < num_threads; ++i) {
+            threads.emplace_back([&convert_worker, mem_tracker]() {
+                SCOPED_ATTACH_TASK(mem_tracker);
+                convert_worker();
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
     }
 
     // XXX:The SchemaChange state should not be canceled at this time, because the new Delta has to be converted to the old and new Schema version
@@ -1760,12 +1804,11 @@ Status SchemaChangeHandler::_parse_request(const SchemaChangeParams& sc_params,
         } else {
             auto column_new = new_tablet_schema->column(i);
             auto column_old = base_tablet_schema->column(column_mapping->ref_column);
-            if (column_new.type() != column_old.type() ||
-                column_new.precision() != column_old.precision() ||
-                column_new.frac() != column_old.frac() ||
-                column_new.length() != column_old.length() ||
-                column_new.is_bf_column() != column_old.is_bf_column() ||
-                column_new.has_bitmap_index() != column_old.has_bitmap_index()) {
+            // the keys and the sequence column are also encoded in the indexes of the keys
+            bool is_value = i >= new_tablet->num_key_columns() &&
+                            !(new_tablet_schema->has_sequence_col() &&
+                              i == new_tablet_schema->sequence_col_idx());
+            if (!_is_linked_column_change(column_old, column_new, is_value)) {
                 *sc_directly = true;
                 return Status::OK();
             }
@@ -1798,6 +1841,34 @@ Status SchemaChangeHandler::_parse_request(const SchemaChangeParams& sc_params,
     return Status::OK();
 }
 
+// @static
+bool SchemaChangeHandler::_is_linked_column_change(const TabletColumn& column_old,
+                                                   const TabletColumn& column_new, bool is_value) {
+    if (column_new.is_bf_column() != column_old.is_bf_column() ||
+        column_new.has_bitmap_index() != column_old.has_bitmap_index()) {
+        return false;
+    }
+    if (column_new.type() != column_old.type()) {
+        // the wider integers are converted on read, see WideningColumnIterator
+        return config::enable_linked_schema_change_for_widening && is_value &&
+               !column_new.is_bf_column() && !column_new.has_bitmap_index() &&
+               segment_v2::WideningColumnIterator::can_widen(column_old.type(),
+                                                             column_new.type());
+    }
+    if (column_new.precision() != column_old.precision() ||
+        column_new.frac() != column_old.frac()) {
+        return false;
+    }
+    if (column_new.length() == column_old.length()) {
+        return true;
+    }
+    // a longer VARCHAR or STRING is stored the same way, unlike CHAR which is padded
+    return config::enable_linked_schema_change_for_widening && is_value &&
+           (column_new.type() == OLAP_FIELD_TYPE_VARCHAR ||
+            column_new.type() == OLAP_FIELD_TYPE_STRING) &&
+           column_new.length() > column_old.length();
+}
+
 Status SchemaChangeHandler::_init_column_mapping(ColumnMapping* column_mapping,
                                                  const TabletColumn& column_schema,
                                                  const std::string& value) {
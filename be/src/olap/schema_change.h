@@ -275,6 +275,11 @@ private:
     static Status _parse_request(const SchemaChangeParams& sc_params, BlockChanger* changer,
                                  bool* sc_sorting, bool* sc_directly);
 
+    // Whether the data of `column_old' can be linked as `column_new' without a rewrite, which is
+    // unchanged or only widened. `is_value' is false for the keys and the sequence column.
+    static bool _is_linked_column_change(const TabletColumn& column_old,
+                                         const TabletColumn& column_new, bool is_value);
+
     static Status _do_process_alter_inverted_index(TabletSharedPtr tablet,
                                                    const TAlterInvertedIndexReq& request);
 
@@ -33,7 +33,8 @@ void SegmentLoader::create_global_instance(size_t capacity) {
 
 SegmentLoader::SegmentLoader(size_t capacity) {
     _cache = std::unique_ptr<Cache>(
-            new_lru_cache("SegmentMetaCache", capacity, LRUCacheType::NUMBER));
+            new_lru_cache("SegmentMetaCache", capacity, LRUCacheType::NUMBER, 16, 0,
+                          config::enable_cache_clock_eviction));
 }
 
 bool SegmentLoader::_lookup(const SegmentLoader::CacheKey& key, SegmentCacheHandle* handle) {
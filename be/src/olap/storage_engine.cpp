@@ -136,9 +136,18 @@ StorageEngine::~StorageEngine() {
     if (_seg_compaction_thread_pool) {
         _seg_compaction_thread_pool->shutdown();
     }
+    if (_vertical_compaction_group_thread_pool) {
+        _vertical_compaction_group_thread_pool->shutdown();
+    }
     if (_tablet_meta_checkpoint_thread_pool) {
         _tablet_meta_checkpoint_thread_pool->shutdown();
     }
+    if (_calc_delete_bitmap_thread_pool) {
+        _calc_delete_bitmap_thread_pool->shutdown();
+    }
+    if (_segment_column_encode_thread_pool) {
+        _segment_column_encode_thread_pool->shutdown();
+    }
     _s_instance = nullptr;
 }
 
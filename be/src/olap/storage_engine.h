@@ -35,6 +35,7 @@
 #include "gen_cpp/BackendService_types.h"
 #include "gen_cpp/MasterService_types.h"
 #include "gutil/ref_counted.h"
+#include "olap/compaction_io_budget.h"
 #include "olap/compaction_permit_limiter.h"
 #include "olap/olap_common.h"
 #include "olap/olap_define.h"
@@ -189,8 +190,17 @@ public:
     std::unique_ptr<ThreadPool>& tablet_publish_txn_thread_pool() {
         return _tablet_publish_txn_thread_pool;
     }
+    std::unique_ptr<ThreadPool>& calc_delete_bitmap_thread_pool() {
+        return _calc_delete_bitmap_thread_pool;
+    }
     bool stopped() { return _stopped; }
     ThreadPool* get_bg_multiget_threadpool() { return _bg_multi_get_thread_pool.get(); }
+    ThreadPool* vertical_compaction_group_thread_pool() {
+        return _vertical_compaction_group_thread_pool.get();
+    }
+    ThreadPool* segment_column_encode_thread_pool() {
+        return _segment_column_encode_thread_pool.get();
+    }
 
 private:
     // Instance should be inited from `static open()`
@@ -371,13 +381,23 @@ private:
     std::unique_ptr<ThreadPool> _cumu_compaction_thread_pool;
     std::unique_ptr<ThreadPool> _seg_compaction_thread_pool;
     std::unique_ptr<ThreadPool> _cold_data_compaction_thread_pool;
+    // merge the value column groups of a vertical compaction in parallel. It's not the compaction
+    // pools, because the compaction tasks wait for the groups.
+    std::unique_ptr<ThreadPool> _vertical_compaction_group_thread_pool;
 
     std::unique_ptr<ThreadPool> _tablet_publish_txn_thread_pool;
+    // calculate the delete bitmaps of the segments of a rowset in parallel. It's not the
+    // publish pool, because the publish tasks wait for the calculation.
+    std::unique_ptr<ThreadPool> _calc_delete_bitmap_thread_pool;
+    // convert and encode the columns of a block of a segment writer in parallel. It's not the
+    // flush or compaction pools, because their tasks wait for the columns.
+    std::unique_ptr<ThreadPool> _segment_column_encode_thread_pool;
 
     std::unique_ptr<ThreadPool> _tablet_meta_checkpoint_thread_pool;
     std::unique_ptr<ThreadPool> _bg_multi_get_thread_pool;
 
     CompactionPermitLimiter _permit_limiter;
+    CompactionIOBudget _compaction_io_budget;
 
     std::mutex _tablet_submitted_compaction_mutex;
     // a tablet can do base and cumulative compaction at same time
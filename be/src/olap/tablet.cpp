@@ -213,7 +213,8 @@ Status Tablet::_init_once_action() {
 #ifdef BE_TEST
     // init cumulative compaction policy by type
     _cumulative_compaction_policy =
-            CumulativeCompactionPolicyFactory::create_cumulative_compaction_policy();
+            CumulativeCompactionPolicyFactory::create_cumulative_compaction_policy(
+                    _cumulative_compaction_type);
 #endif
 
     RowsetVector rowset_vec;
@@ -749,6 +750,10 @@ void Tablet::delete_expired_stale_rowset() {
         to_delete_iter++;
     }
 
+    if (enable_unique_key_merge_on_write()) {
+        _aggregate_swept_delete_bitmaps(stale_version_path_map);
+    }
+
     bool reconstructed = _reconstruct_version_tracker_if_necessary();
 
     VLOG_NOTICE << "delete stale rowset _stale_rs_version_map tablet=" << full_name()
@@ -762,6 +767,41 @@ void Tablet::delete_expired_stale_rowset() {
 #endif
 }
 
+void Tablet::_aggregate_swept_delete_bitmaps(
+        const std::map<int64_t, PathVersionListSharedPtr>& swept_paths) {
+    // Every load and compaction since the tablet was created leaves a bitmap per segment in
+    // its own version, readers of a version v aggregate all of them <= v. Once the stale paths
+    // are swept, the versions inside a swept range [s, e] can't be read anymore, except the end
+    // version, so the bitmaps of [s, e) are merged into e.
+    size_t num_merged = 0;
+    for (auto& [path_id, path] : swept_paths) {
+        auto& versions = path->timestamped_versions();
+        if (versions.empty()) {
+            continue;
+        }
+        int64_t start_version = versions.front()->version().first;
+        int64_t end_version = versions.back()->version().second;
+        for (auto& timestamped_version : versions) {
+            start_version = std::min(start_version, timestamped_version->version().first);
+            end_version = std::max(end_version, timestamped_version->version().second);
+        }
+        // a remaining stale rowset may still be read at its end version
+        bool readable = false;
+        for (auto& [version, _] : _stale_rs_version_map) {
+            if (version.second >= start_version && version.second < end_version) {
+                readable = true;
+                break;
+            }
+        }
+        if (readable || start_version >= end_version) {
+            continue;
+        }
+        num_merged += _tablet_meta->delete_bitmap().aggregate(start_version, end_version);
+    }
+    VLOG_NOTICE << "aggregate swept delete bitmaps, tablet=" << full_name()
+                << ", merged bitmaps=" << num_merged;
+}
+
 bool Tablet::_reconstruct_version_tracker_if_necessary() {
     double orphan_vertex_ratio = _timestamped_version_tracker.get_orphan_vertex_ratio();
     if (orphan_vertex_ratio >= config::tablet_version_graph_orphan_vertex_ratio) {
@@ -987,6 +1027,11 @@ uint32_t Tablet::_calc_cumulative_compaction_score(
 }
 
 uint32_t Tablet::_calc_base_compaction_score() const {
+    // the rowsets are given to base without base compaction under time series policy
+    if (_cumulative_compaction_policy != nullptr &&
+        _cumulative_compaction_policy->name() == CUMULATIVE_TIME_SERIES_POLICY) {
+        return 0;
+    }
     uint32_t score = 0;
     const int64_t point = cumulative_layer_point();
     bool base_rowset_exist = false;
@@ -1371,6 +1416,15 @@ bool Tablet::do_tablet_meta_checkpoint() {
     }
     VLOG_NOTICE << "start to do tablet meta checkpoint, tablet=" << full_name();
     save_meta();
+    // the delete bitmaps of the visible versions are persistent with the tablet meta now
+    if (keys_type() == UNIQUE_KEYS && enable_unique_key_merge_on_write()) {
+        auto st = TabletMetaManager::remove_old_version_delete_bitmap(
+                _data_dir, tablet_id(), max_version_unlocked().second);
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to remove delete bitmap deltas, tablet=" << full_name()
+                         << ", status=" << st;
+        }
+    }
     // if save meta successfully, then should remove the rowset meta existing in tablet
     // meta from rowset meta store
     for (auto& rs_meta : _tablet_meta->all_rs_metas()) {
@@ -1544,8 +1598,22 @@ void Tablet::generate_tablet_meta_copy_unlocked(TabletMetaSharedPtr new_tablet_m
     new_tablet_meta->init_from_pb(tablet_meta_pb);
 }
 
+int64_t Tablet::estimate_compaction_input_bytes(CompactionType compaction_type) const {
+    std::shared_lock rdlock(_meta_lock);
+    int64_t point = cumulative_layer_point();
+    bool cumulative = compaction_type == CompactionType::CUMULATIVE_COMPACTION;
+    int64_t bytes = 0;
+    for (auto& rs_meta : _tablet_meta->all_rs_metas()) {
+        if ((rs_meta->start_version() >= point) == cumulative) {
+            bytes += rs_meta->total_disk_size();
+        }
+    }
+    return bytes;
+}
+
 Status Tablet::prepare_compaction_and_calculate_permits(CompactionType compaction_type,
-                                                        TabletSharedPtr tablet, int64_t* permits) {
+                                                        TabletSharedPtr tablet, int64_t* permits,
+                                                        int64_t* input_bytes) {
     std::vector<RowsetSharedPtr> compaction_rowsets;
     if (compaction_type == CompactionType::CUMULATIVE_COMPACTION) {
         scoped_refptr<Trace> trace(new Trace);
@@ -1609,6 +1677,12 @@ Status Tablet::prepare_compaction_and_calculate_permits(CompactionType compactio
     for (auto rowset : compaction_rowsets) {
         *permits += rowset->rowset_meta()->get_compaction_score();
     }
+    if (input_bytes != nullptr) {
+        *input_bytes = 0;
+        for (auto& rowset : compaction_rowsets) {
+            *input_bytes += rowset->data_disk_size();
+        }
+    }
     return Status::OK();
 }
 
@@ -1799,16 +1873,27 @@ Status Tablet::_cooldown_data() {
     }
     RowsetId new_rowset_id = StorageEngine::instance()->next_rowset_id();
     add_pending_remote_rowset(new_rowset_id.to_string());
+    // a single segment is uploaded as is. The segments of inverted indexes are not packed either,
+    // as the index files are found by the paths of the segment files.
+    const auto& indexes = old_rowset->tablet_schema()->indexes();
+    bool pack_segments = config::enable_pack_cooldown_segments && old_rowset->num_segments() > 1 &&
+                         std::none_of(indexes.begin(), indexes.end(), [](const TabletIndex& index) {
+                             return index.index_type() == IndexType::INVERTED;
+                         });
     Status st;
     Defer defer {[&] {
         if (!st.ok()) {
             erase_pending_remote_rowset(new_rowset_id.to_string());
             // reclaim the incomplete rowset data in remote storage
-            record_unused_remote_rowset(new_rowset_id, dest_fs->id(), old_rowset->num_segments());
+            record_unused_remote_rowset(new_rowset_id, dest_fs->id(), old_rowset->num_segments(),
+                                        pack_segments);
         }
     }};
     auto start = std::chrono::steady_clock::now();
-    if (st = old_rowset->upload_to(dest_fs.get(), new_rowset_id); !st.ok()) {
+    std::vector<PackedSegmentPB> packed_segments;
+    if (st = old_rowset->upload_to(dest_fs.get(), new_rowset_id,
+                                   pack_segments ? &packed_segments : nullptr);
+        !st.ok()) {
         return st;
     }
 
@@ -1823,6 +1908,7 @@ Status Tablet::_cooldown_data() {
     new_rowset_meta->set_rowset_id(new_rowset_id);
     new_rowset_meta->set_resource_id(dest_fs->id());
     new_rowset_meta->set_fs(dest_fs);
+    new_rowset_meta->set_packed_segments(packed_segments);
     new_rowset_meta->set_creation_time(time(nullptr));
     UniqueId cooldown_meta_id = UniqueId::gen_uid();
     RowsetSharedPtr new_rowset;
@@ -2091,12 +2177,13 @@ bool Tablet::need_cooldown(int64_t* cooldown_timestamp, size_t* file_size) {
 }
 
 void Tablet::record_unused_remote_rowset(const RowsetId& rowset_id, const std::string& resource,
-                                         int64_t num_segments) {
+                                         int64_t num_segments, bool packed_segments) {
     auto gc_key = REMOTE_ROWSET_GC_PREFIX + rowset_id.to_string();
     RemoteRowsetGcPB gc_pb;
     gc_pb.set_resource_id(resource);
     gc_pb.set_tablet_id(tablet_id());
     gc_pb.set_num_segments(num_segments);
+    gc_pb.set_packed_segments(packed_segments);
     auto st =
             _data_dir->get_meta()->put(META_COLUMN_FAMILY_INDEX, gc_key, gc_pb.SerializeAsString());
     if (!st.ok()) {
@@ -2331,11 +2418,40 @@ Status Tablet::lookup_row_data(const Slice& encoded_key, const RowLocation& row_
                                RowsetSharedPtr input_rowset, const TupleDescriptor* desc,
                                OlapReaderStatistics& stats, vectorized::Block* block,
                                bool write_to_cache) {
+    if (!input_rowset) {
+        return Status::NotFound(
+                fmt::format("rowset {} not found", row_location.rowset_id.to_string()));
+    }
+    size_t row_size = 0;
+    MonotonicStopWatch watch;
+    watch.start();
+    Defer _defer([&]() {
+        LOG_EVERY_N(INFO, 500) << "get a single_row, cost(us):" << watch.elapsed_time() / 1000
+                               << ", row_size:" << row_size;
+    });
+    // get and parse tuple row
+    vectorized::MutableColumnPtr column_ptr = vectorized::ColumnString::create();
+    std::vector<segment_v2::rowid_t> rowids {static_cast<segment_v2::rowid_t>(row_location.row_id)};
+    RETURN_IF_ERROR(read_row_store_column(input_rowset, row_location.segment_id, rowids, stats,
+                                          column_ptr));
+    assert(column_ptr->size() == 1);
+    auto string_column = static_cast<vectorized::ColumnString*>(column_ptr.get());
+    if (write_to_cache) {
+        StringRef value = string_column->get_data_at(0);
+        RowCache::instance()->insert({tablet_id(), encoded_key}, Slice {value.data, value.size});
+    }
+    vectorized::JsonbSerializeUtil::jsonb_to_block(*desc, *string_column, *block);
+    return Status::OK();
+}
+
+Status Tablet::read_row_store_column(const RowsetSharedPtr& input_rowset, uint32_t segment_id,
+                                     const std::vector<segment_v2::rowid_t>& rowids,
+                                     OlapReaderStatistics& stats,
+                                     vectorized::MutableColumnPtr& dst) {
     // read row data
     BetaRowsetSharedPtr rowset = std::static_pointer_cast<BetaRowset>(input_rowset);
     if (!rowset) {
-        return Status::NotFound(
-                fmt::format("rowset {} not found", row_location.rowset_id.to_string()));
+        return Status::NotFound("rowset not found");
     }
 
     const TabletSchemaSPtr tablet_schema = rowset->tablet_schema();
@@ -2343,23 +2459,15 @@ Status Tablet::lookup_row_data(const Slice& encoded_key, const RowLocation& row_
     RETURN_IF_ERROR(SegmentLoader::instance()->load_segments(rowset, &segment_cache, true));
     // find segment
     auto it = std::find_if(segment_cache.get_segments().begin(), segment_cache.get_segments().end(),
-                           [&row_location](const segment_v2::SegmentSharedPtr& seg) {
-                               return seg->id() == row_location.segment_id;
+                           [segment_id](const segment_v2::SegmentSharedPtr& seg) {
+                               return seg->id() == segment_id;
                            });
     if (it == segment_cache.get_segments().end()) {
         return Status::NotFound(fmt::format("rowset {} 's segemnt not found, seg_id {}",
-                                            row_location.rowset_id.to_string(),
-                                            row_location.segment_id));
+                                            rowset->rowset_id().to_string(), segment_id));
     }
     // read from segment column by column, row by row
     segment_v2::SegmentSharedPtr segment = *it;
-    size_t row_size = 0;
-    MonotonicStopWatch watch;
-    watch.start();
-    Defer _defer([&]() {
-        LOG_EVERY_N(INFO, 500) << "get a single_row, cost(us):" << watch.elapsed_time() / 1000
-                               << ", row_size:" << row_size;
-    });
     if (tablet_schema->store_row_column()) {
         // create _source column
         segment_v2::ColumnIterator* column_iterator = nullptr;
@@ -2371,27 +2479,43 @@ Status Tablet::lookup_row_data(const Slice& encoded_key, const RowLocation& row_
         opt.stats = &stats;
         opt.use_page_cache = !config::disable_storage_page_cache;
         column_iterator->init(opt);
-        // get and parse tuple row
-        vectorized::MutableColumnPtr column_ptr = vectorized::ColumnString::create();
-        std::vector<segment_v2::rowid_t> rowids {
-                static_cast<segment_v2::rowid_t>(row_location.row_id)};
-        RETURN_IF_ERROR(column_iterator->read_by_rowids(rowids.data(), 1, column_ptr));
-        assert(column_ptr->size() == 1);
-        auto string_column = static_cast<vectorized::ColumnString*>(column_ptr.get());
-        if (write_to_cache) {
-            StringRef value = string_column->get_data_at(0);
-            RowCache::instance()->insert({tablet_id(), encoded_key},
-                                         Slice {value.data, value.size});
-        }
-        vectorized::JsonbSerializeUtil::jsonb_to_block(*desc, *string_column, *block);
-        return Status::OK();
+        return column_iterator->read_by_rowids(rowids.data(), rowids.size(), dst);
     }
     __builtin_unreachable();
 }
 
+// The segments of the rowsets looked up and their primary key index iterators.
+class RowKeyLookupCache {
+public:
+    Status get(const RowsetSharedPtr& rowset, int32_t segment_idx,
+               segment_v2::SegmentSharedPtr* segment,
+               std::unique_ptr<segment_v2::IndexedColumnIterator>** iter) {
+        auto it = _rowsets.find(rowset->rowset_id());
+        if (it == _rowsets.end()) {
+            RowsetSegments rowset_segments;
+            RETURN_NOT_OK(SegmentLoader::instance()->load_segments(
+                    std::static_pointer_cast<BetaRowset>(rowset), &rowset_segments.handle, true));
+            rowset_segments.iters.resize(rowset_segments.handle.get_segments().size());
+            it = _rowsets.emplace(rowset->rowset_id(), std::move(rowset_segments)).first;
+        }
+        auto& segments = it->second.handle.get_segments();
+        DCHECK_GT(segments.size(), segment_idx);
+        *segment = segments[segment_idx];
+        *iter = &it->second.iters[segment_idx];
+        return Status::OK();
+    }
+
+private:
+    struct RowsetSegments {
+        SegmentCacheHandle handle;
+        std::vector<std::unique_ptr<segment_v2::IndexedColumnIterator>> iters;
+    };
+    std::unordered_map<RowsetId, RowsetSegments, HashOfRowsetId> _rowsets;
+};
+
 Status Tablet::lookup_row_key(const Slice& encoded_key, const RowsetIdUnorderedSet* rowset_ids,
                               RowLocation* row_location, uint32_t version,
-                              RowsetSharedPtr* rowset) {
+                              RowsetSharedPtr* rowset, RowKeyLookupCache* cache) {
     std::vector<std::pair<RowsetSharedPtr, int32_t>> selected_rs;
     size_t seq_col_length = 0;
     if (_schema->has_sequence_col()) {
@@ -2416,12 +2540,20 @@ Status Tablet::lookup_row_key(const Slice& encoded_key, const RowsetIdUnorderedS
         if (rs.first->end_version() > version) {
             continue;
         }
-        SegmentCacheHandle segment_cache_handle;
-        RETURN_NOT_OK(SegmentLoader::instance()->load_segments(
-                std::static_pointer_cast<BetaRowset>(rs.first), &segment_cache_handle, true));
-        auto& segments = segment_cache_handle.get_segments();
-        DCHECK_GT(segments.size(), rs.second);
-        Status s = segments[rs.second]->lookup_row_key(encoded_key, &loc);
+        Status s;
+        if (cache != nullptr) {
+            segment_v2::SegmentSharedPtr segment;
+            std::unique_ptr<segment_v2::IndexedColumnIterator>* iter = nullptr;
+            RETURN_NOT_OK(cache->get(rs.first, rs.second, &segment, &iter));
+            s = segment->lookup_row_key(encoded_key, &loc, iter);
+        } else {
+            SegmentCacheHandle segment_cache_handle;
+            RETURN_NOT_OK(SegmentLoader::instance()->load_segments(
+                    std::static_pointer_cast<BetaRowset>(rs.first), &segment_cache_handle, true));
+            auto& segments = segment_cache_handle.get_segments();
+            DCHECK_GT(segments.size(), rs.second);
+            s = segments[rs.second]->lookup_row_key(encoded_key, &loc);
+        }
         if (s.is<NOT_FOUND>()) {
             continue;
         }
@@ -2464,90 +2596,49 @@ Status Tablet::calc_delete_bitmap(RowsetId rowset_id,
                                   const RowsetIdUnorderedSet* specified_rowset_ids,
                                   DeleteBitmapPtr delete_bitmap, int64_t end_version,
                                   bool check_pre_segments) {
-    std::vector<segment_v2::SegmentSharedPtr> pre_segments;
     OlapStopWatch watch;
-
     Version dummy_version(end_version + 1, end_version + 1);
-    for (auto& seg : segments) {
-        seg->load_pk_index_and_bf(); // We need index blocks to iterate
-        auto pk_idx = seg->get_primary_key_index();
-        int total = pk_idx->num_rows();
-        uint32_t row_id = 0;
-        int32_t remaining = total;
-        bool exact_match = false;
-        std::string last_key;
-        int batch_size = 1024;
-        while (remaining > 0) {
-            std::unique_ptr<segment_v2::IndexedColumnIterator> iter;
-            RETURN_IF_ERROR(pk_idx->new_iterator(&iter));
-
-            size_t num_to_read = std::min(batch_size, remaining);
-            auto index_type = vectorized::DataTypeFactory::instance().create_data_type(
-                    pk_idx->type_info()->type(), 1, 0);
-            auto index_column = index_type->create_column();
-            Slice last_key_slice(last_key);
-            RETURN_IF_ERROR(iter->seek_at_or_after(&last_key_slice, &exact_match));
-
-            size_t num_read = num_to_read;
-            RETURN_IF_ERROR(iter->next_batch(&num_read, index_column));
-            DCHECK(num_to_read == num_read);
-            last_key = index_column->get_data_at(num_read - 1).to_string();
-
-            // exclude last_key, last_key will be read in next batch.
-            if (num_read == batch_size && num_read != remaining) {
-                num_read -= 1;
-            }
-            for (size_t i = 0; i < num_read; i++) {
-                Slice key =
-                        Slice(index_column->get_data_at(i).data, index_column->get_data_at(i).size);
-                RowLocation loc;
-                // first check if exist in pre segment
+    auto* thread_pool = StorageEngine::instance() == nullptr
+                                ? nullptr
+                                : StorageEngine::instance()->calc_delete_bitmap_thread_pool().get();
+    // With the sequence column, whether a key of a segment is deleted depends on the
+    // delete bitmap of the previous segments, so the segments are calculated one by one.
+    // Otherwise each segment only looks up the previous segments and the other rowsets,
+    // which are not changed, so they are calculated in parallel.
+    if (segments.size() > 1 && thread_pool != nullptr && !_schema->has_sequence_col()) {
+        std::vector<DeleteBitmapPtr> segment_delete_bitmaps(segments.size());
+        std::vector<Status> statuses(segments.size());
+        auto token = thread_pool->new_token(ThreadPool::ExecutionMode::CONCURRENT);
+        for (size_t i = 0; i < segments.size(); ++i) {
+            segment_delete_bitmaps[i] = std::make_shared<DeleteBitmap>(tablet_id());
+            Status st = token->submit_func([&, i]() {
+                std::vector<segment_v2::SegmentSharedPtr> pre_segments;
                 if (check_pre_segments) {
-                    auto st = _check_pk_in_pre_segments(rowset_id, pre_segments, key, delete_bitmap,
-                                                        &loc);
-                    if (st.ok()) {
-                        delete_bitmap->add({rowset_id, loc.segment_id, 0}, loc.row_id);
-                        ++row_id;
-                        continue;
-                    } else if (st.is<ALREADY_EXIST>()) {
-                        delete_bitmap->add({rowset_id, seg->id(), 0}, row_id);
-                        ++row_id;
-                        continue;
-                    }
-                }
-
-                if (specified_rowset_ids != nullptr && !specified_rowset_ids->empty()) {
-                    auto st = lookup_row_key(key, specified_rowset_ids, &loc,
-                                             dummy_version.first - 1);
-                    CHECK(st.ok() || st.is<NOT_FOUND>() || st.is<ALREADY_EXIST>());
-                    if (st.is<NOT_FOUND>()) {
-                        ++row_id;
-                        continue;
-                    }
-
-                    // sequence id smaller than the previous one, so delete current row
-                    if (st.is<ALREADY_EXIST>()) {
-                        loc.rowset_id = rowset_id;
-                        loc.segment_id = seg->id();
-                        loc.row_id = row_id;
-                    }
-
-                    // delete bitmap will be calculate when memtable flush and
-                    // publish. The two stages may see different versions.
-                    // When there is sequence column, the currently imported data
-                    // of rowset may be marked for deletion at memtablet flush or
-                    // publish because the seq column is smaller than the previous
-                    // rowset.
-                    // just set 0 as a unified temporary version number, and update to
-                    // the real version number later.
-                    delete_bitmap->add({loc.rowset_id, loc.segment_id, 0}, loc.row_id);
+                    pre_segments.assign(segments.begin(), segments.begin() + i);
                 }
-                ++row_id;
+                statuses[i] = _calc_segment_delete_bitmap(rowset_id, segments[i], pre_segments,
+                                                          specified_rowset_ids,
+                                                          segment_delete_bitmaps[i], end_version);
+            });
+            if (!st.ok()) {
+                token->shutdown();
+                return st;
             }
-            remaining -= num_read;
         }
-        if (check_pre_segments) {
-            pre_segments.emplace_back(seg);
+        token->wait();
+        for (size_t i = 0; i < segments.size(); ++i) {
+            RETURN_IF_ERROR(statuses[i]);
+            delete_bitmap->merge(*segment_delete_bitmaps[i]);
+        }
+    } else {
+        std::vector<segment_v2::SegmentSharedPtr> pre_segments;
+        for (auto& seg : segments) {
+            RETURN_IF_ERROR(_calc_segment_delete_bitmap(rowset_id, seg, pre_segments,
+                                                        specified_rowset_ids, delete_bitmap,
+                                                        end_version));
+            if (check_pre_segments) {
+                pre_segments.emplace_back(seg);
+            }
         }
     }
     LOG(INFO) << "construct delete bitmap tablet: " << tablet_id() << " rowset: " << rowset_id
@@ -2557,11 +2648,102 @@ Status Tablet::calc_delete_bitmap(RowsetId rowset_id,
     return Status::OK();
 }
 
+Status Tablet::_calc_segment_delete_bitmap(
+        RowsetId rowset_id, const segment_v2::SegmentSharedPtr& seg,
+        const std::vector<segment_v2::SegmentSharedPtr>& pre_segments,
+        const RowsetIdUnorderedSet* specified_rowset_ids, DeleteBitmapPtr delete_bitmap,
+        int64_t end_version) {
+    Version dummy_version(end_version + 1, end_version + 1);
+    // the keys of the segment are sorted, so the lookups seek forward in the same pages
+    RowKeyLookupCache lookup_cache;
+    std::vector<std::unique_ptr<segment_v2::IndexedColumnIterator>> pre_segment_iters(
+            pre_segments.size());
+    seg->load_pk_index_and_bf(); // We need index blocks to iterate
+    auto pk_idx = seg->get_primary_key_index();
+    int total = pk_idx->num_rows();
+    uint32_t row_id = 0;
+    int32_t remaining = total;
+    bool exact_match = false;
+    std::string last_key;
+    int batch_size = 1024;
+    while (remaining > 0) {
+        std::unique_ptr<segment_v2::IndexedColumnIterator> iter;
+        RETURN_IF_ERROR(pk_idx->new_iterator(&iter));
+
+        size_t num_to_read = std::min(batch_size, remaining);
+        auto index_type = vectorized::DataTypeFactory::instance().create_data_type(
+                pk_idx->type_info()->type(), 1, 0);
+        auto index_column = index_type->create_column();
+        Slice last_key_slice(last_key);
+        RETURN_IF_ERROR(iter->seek_at_or_after(&last_key_slice, &exact_match));
+
+        size_t num_read = num_to_read;
+        RETURN_IF_ERROR(iter->next_batch(&num_read, index_column));
+        DCHECK(num_to_read == num_read);
+        last_key = index_column->get_data_at(num_read - 1).to_string();
+
+        // exclude last_key, last_key will be read in next batch.
+        if (num_read == batch_size && num_read != remaining) {
+            num_read -= 1;
+        }
+        for (size_t i = 0; i < num_read; i++) {
+            Slice key = Slice(index_column->get_data_at(i).data, index_column->get_data_at(i).size);
+            RowLocation loc;
+            // first check if exist in pre segment
+            if (!pre_segments.empty()) {
+                auto st = _check_pk_in_pre_segments(rowset_id, pre_segments, &pre_segment_iters,
+                                                    key, delete_bitmap, &loc);
+                if (st.ok()) {
+                    delete_bitmap->add({rowset_id, loc.segment_id, 0}, loc.row_id);
+                    ++row_id;
+                    continue;
+                } else if (st.is<ALREADY_EXIST>()) {
+                    delete_bitmap->add({rowset_id, seg->id(), 0}, row_id);
+                    ++row_id;
+                    continue;
+                }
+            }
+
+            if (specified_rowset_ids != nullptr && !specified_rowset_ids->empty()) {
+                auto st = lookup_row_key(key, specified_rowset_ids, &loc, dummy_version.first - 1,
+                                         nullptr, &lookup_cache);
+                CHECK(st.ok() || st.is<NOT_FOUND>() || st.is<ALREADY_EXIST>());
+                if (st.is<NOT_FOUND>()) {
+                    ++row_id;
+                    continue;
+                }
+
+                // sequence id smaller than the previous one, so delete current row
+                if (st.is<ALREADY_EXIST>()) {
+                    loc.rowset_id = rowset_id;
+                    loc.segment_id = seg->id();
+                    loc.row_id = row_id;
+                }
+
+                // delete bitmap will be calculate when memtable flush and
+                // publish. The two stages may see different versions.
+                // When there is sequence column, the currently imported data
+                // of rowset may be marked for deletion at memtablet flush or
+                // publish because the seq column is smaller than the previous
+                // rowset.
+                // just set 0 as a unified temporary version number, and update to
+                // the real version number later.
+                delete_bitmap->add({loc.rowset_id, loc.segment_id, 0}, loc.row_id);
+            }
+            ++row_id;
+        }
+        remaining -= num_read;
+    }
+    return Status::OK();
+}
+
 Status Tablet::_check_pk_in_pre_segments(
         RowsetId rowset_id, const std::vector<segment_v2::SegmentSharedPtr>& pre_segments,
+        std::vector<std::unique_ptr<segment_v2::IndexedColumnIterator>>* pre_segment_iters,
         const Slice& key, DeleteBitmapPtr delete_bitmap, RowLocation* loc) {
-    for (auto it = pre_segments.rbegin(); it != pre_segments.rend(); ++it) {
-        auto st = (*it)->lookup_row_key(key, loc);
+    DCHECK_EQ(pre_segments.size(), pre_segment_iters->size());
+    for (int i = pre_segments.size() - 1; i >= 0; --i) {
+        auto st = pre_segments[i]->lookup_row_key(key, loc, &(*pre_segment_iters)[i]);
         CHECK(st.ok() || st.is<NOT_FOUND>() || st.is<ALREADY_EXIST>());
         if (st.is<NOT_FOUND>()) {
             continue;
@@ -2608,6 +2790,10 @@ Status Tablet::update_delete_bitmap_without_lock(const RowsetSharedPtr& rowset)
                 {std::get<0>(iter->first), std::get<1>(iter->first), cur_version}, iter->second);
     }
 
+    if (config::enable_delete_bitmap_delta_meta) {
+        RETURN_IF_ERROR(TabletMetaManager::save_delete_bitmap(_data_dir, tablet_id(), cur_version,
+                                                              *delete_bitmap));
+    }
     return Status::OK();
 }
 
@@ -2671,6 +2857,10 @@ Status Tablet::update_delete_bitmap(const RowsetSharedPtr& rowset, const TabletT
                 {std::get<0>(iter->first), std::get<1>(iter->first), cur_version}, iter->second);
     }
 
+    if (config::enable_delete_bitmap_delta_meta) {
+        RETURN_IF_ERROR(TabletMetaManager::save_delete_bitmap(_data_dir, tablet_id(), cur_version,
+                                                              *delete_bitmap));
+    }
     return Status::OK();
 }
 
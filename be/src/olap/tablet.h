@@ -56,6 +56,7 @@ class CumulativeCompactionPolicy;
 class CumulativeCompaction;
 class BaseCompaction;
 class RowsetWriter;
+class RowKeyLookupCache;
 
 struct TabletTxnInfo;
 struct RowsetWriterContext;
@@ -185,6 +186,9 @@ public:
     uint32_t calc_compaction_score(
             CompactionType compaction_type,
             std::shared_ptr<CumulativeCompactionPolicy> cumulative_compaction_policy);
+    // the bytes a compaction of the type would read, estimated by the rowsets on its side of
+    // the cumulative point
+    int64_t estimate_compaction_input_bytes(CompactionType compaction_type) const;
 
     // operation for clone
     void calc_missed_versions(int64_t spec_version, std::vector<Version>* missed_versions);
@@ -258,8 +262,10 @@ public:
     // return a json string to show the compaction status of this tablet
     void get_compaction_status(std::string* json_result);
 
+    // input_bytes, if not null, is set to the bytes of the input rowsets
     Status prepare_compaction_and_calculate_permits(CompactionType compaction_type,
-                                                    TabletSharedPtr tablet, int64_t* permits);
+                                                    TabletSharedPtr tablet, int64_t* permits,
+                                                    int64_t* input_bytes = nullptr);
     void execute_compaction(CompactionType compaction_type);
     void reset_compaction(CompactionType compaction_type);
 
@@ -350,7 +356,7 @@ public:
     Status remove_all_remote_rowsets();
 
     void record_unused_remote_rowset(const RowsetId& rowset_id, const std::string& resource,
-                                     int64_t num_segments);
+                                     int64_t num_segments, bool packed_segments = false);
 
     static void remove_unused_remote_files();
 
@@ -375,9 +381,12 @@ public:
     // Lookup the row location of `encoded_key`, the function sets `row_location` on success.
     // NOTE: the method only works in unique key model with primary key index, you will got a
     //       not supported error in other data model.
+    // If the sorted keys of a segment are looked up with the same cache in order, the
+    // segments and the primary key index iterators of the rowsets are kept in the cache,
+    // and each iterator seeks forward in the pages it has loaded.
     Status lookup_row_key(const Slice& encoded_key, const RowsetIdUnorderedSet* rowset_ids,
                           RowLocation* row_location, uint32_t version,
-                          RowsetSharedPtr* rowset = nullptr);
+                          RowsetSharedPtr* rowset = nullptr, RowKeyLookupCache* cache = nullptr);
 
     // Lookup a row with TupleDescriptor and fill Block
     Status lookup_row_data(const Slice& encoded_key, const RowLocation& row_location,
@@ -385,6 +394,11 @@ public:
                            OlapReaderStatistics& stats, vectorized::Block* block,
                            bool write_to_cache = false);
 
+    // Read the row store column of the rows of a segment, the row ids should be ascending
+    Status read_row_store_column(const RowsetSharedPtr& rowset, uint32_t segment_id,
+                                 const std::vector<segment_v2::rowid_t>& rowids,
+                                 OlapReaderStatistics& stats, vectorized::MutableColumnPtr& dst);
+
     // calc delete bitmap when flush memtable, use a fake version to calc
     // For example, cur max version is 5, and we use version 6 to calc but
     // finally this rowset publish version with 8, we should make up data
@@ -463,12 +477,23 @@ private:
     // When the proportion of empty edges in the adjacency matrix used to represent the version graph
     // in the version tracker is greater than the threshold, rebuild the version tracker
     bool _reconstruct_version_tracker_if_necessary();
+    void _aggregate_swept_delete_bitmaps(
+            const std::map<int64_t, PathVersionListSharedPtr>& swept_paths);
     void _init_context_common_fields(RowsetWriterContext& context);
 
-    Status _check_pk_in_pre_segments(RowsetId rowset_id,
-                                     const std::vector<segment_v2::SegmentSharedPtr>& pre_segments,
-                                     const Slice& key, DeleteBitmapPtr delete_bitmap,
-                                     RowLocation* loc);
+    // calculate the delete bitmap of a segment, whose keys are looked up in pre_segments of
+    // the same rowset, and then in the rowsets of specified_rowset_ids
+    Status _calc_segment_delete_bitmap(
+            RowsetId rowset_id, const segment_v2::SegmentSharedPtr& seg,
+            const std::vector<segment_v2::SegmentSharedPtr>& pre_segments,
+            const RowsetIdUnorderedSet* specified_rowset_ids, DeleteBitmapPtr delete_bitmap,
+            int64_t end_version);
+    // pre_segment_iters are the primary key index iterators of pre_segments, which are
+    // reused by the lookups of the sorted keys
+    Status _check_pk_in_pre_segments(
+            RowsetId rowset_id, const std::vector<segment_v2::SegmentSharedPtr>& pre_segments,
+            std::vector<std::unique_ptr<segment_v2::IndexedColumnIterator>>* pre_segment_iters,
+            const Slice& key, DeleteBitmapPtr delete_bitmap, RowLocation* loc);
     void _rowset_ids_difference(const RowsetIdUnorderedSet& cur, const RowsetIdUnorderedSet& pre,
                                 RowsetIdUnorderedSet* to_add, RowsetIdUnorderedSet* to_del);
     Status _load_rowset_segments(const RowsetSharedPtr& rowset,
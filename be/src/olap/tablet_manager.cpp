@@ -21,12 +21,14 @@
 #include <re2/re2.h>
 
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <cstdio>
 #include <filesystem>
 
 #include "gutil/strings/strcat.h"
 #include "olap/base_compaction.h"
+#include "olap/compaction_io_budget.h"
 #include "olap/cumulative_compaction.h"
 #include "olap/data_dir.h"
 #include "olap/olap_common.h"
@@ -191,8 +193,7 @@ Status TabletManager::_add_tablet_to_map_unlocked(TTabletId tablet_id,
     // the perspective of root path.
     // Example: unregister all tables when a bad disk found.
     tablet->register_tablet_into_dir();
-    tablet_map_t& tablet_map = _get_tablet_map(tablet_id);
-    tablet_map[tablet_id] = tablet;
+    _put_tablet_map_unlocked(tablet_id, tablet);
     _add_tablet_to_partition(tablet);
     // TODO: remove multiply 2 of tablet meta mem size
     // Because table schema will copy in tablet, there will be double mem cost
@@ -451,8 +452,7 @@ Status TabletManager::_drop_tablet_unlocked(TTabletId tablet_id, TReplicaId repl
                                replica_id);
     }
     _remove_tablet_from_partition(to_drop_tablet);
-    tablet_map_t& tablet_map = _get_tablet_map(tablet_id);
-    tablet_map.erase(tablet_id);
+    _erase_tablet_map_unlocked(tablet_id);
     if (!keep_files) {
         // drop tablet will update tablet meta, should lock
         std::lock_guard<std::shared_mutex> wrlock(to_drop_tablet->get_header_lock());
@@ -508,8 +508,7 @@ Status TabletManager::drop_tablets_on_error_root_path(
                 continue;
             } else {
                 _remove_tablet_from_partition(dropped_tablet);
-                tablet_map_t& tablet_map = _get_tablet_map(tablet_id);
-                tablet_map.erase(tablet_id);
+                _erase_tablet_map_unlocked(tablet_id);
             }
         }
     }
@@ -517,8 +516,13 @@ Status TabletManager::drop_tablets_on_error_root_path(
 }
 
 TabletSharedPtr TabletManager::get_tablet(TTabletId tablet_id, bool include_deleted, string* err) {
-    std::shared_lock rdlock(_get_tablets_shard_lock(tablet_id));
-    return _get_tablet_unlocked(tablet_id, include_deleted, err);
+    TabletSharedPtr tablet = _lookup_tablet(tablet_id);
+    if (tablet == nullptr && include_deleted) {
+        // a dropped tablet is moved to the shutdown tablets with the write lock
+        std::shared_lock rdlock(_get_tablets_shard_lock(tablet_id));
+        return _get_tablet_unlocked(tablet_id, include_deleted, err);
+    }
+    return _check_found_tablet(std::move(tablet), tablet_id, include_deleted, err);
 }
 
 std::pair<TabletSharedPtr, Status> TabletManager::get_tablet_and_status(TTabletId tablet_id,
@@ -536,8 +540,11 @@ std::pair<TabletSharedPtr, Status> TabletManager::get_tablet_and_status(TTabletI
 
 TabletSharedPtr TabletManager::_get_tablet_unlocked(TTabletId tablet_id, bool include_deleted,
                                                     string* err) {
-    TabletSharedPtr tablet;
-    tablet = _get_tablet_unlocked(tablet_id);
+    return _check_found_tablet(_get_tablet_unlocked(tablet_id), tablet_id, include_deleted, err);
+}
+
+TabletSharedPtr TabletManager::_check_found_tablet(TabletSharedPtr tablet, TTabletId tablet_id,
+                                                   bool include_deleted, string* err) {
     if (tablet == nullptr && include_deleted) {
         std::shared_lock rdlock(_shutdown_tablets_lock);
         for (auto& deleted_tablet : _shutdown_tablets) {
@@ -569,8 +576,7 @@ TabletSharedPtr TabletManager::_get_tablet_unlocked(TTabletId tablet_id, bool in
 
 TabletSharedPtr TabletManager::get_tablet(TTabletId tablet_id, TabletUid tablet_uid,
                                           bool include_deleted, string* err) {
-    std::shared_lock rdlock(_get_tablets_shard_lock(tablet_id));
-    TabletSharedPtr tablet = _get_tablet_unlocked(tablet_id, include_deleted, err);
+    TabletSharedPtr tablet = get_tablet(tablet_id, include_deleted, err);
     if (tablet != nullptr && tablet->tablet_uid() == tablet_uid) {
         return tablet;
     }
@@ -642,6 +648,21 @@ void TabletManager::get_tablet_stat(TTabletStatResult* result) {
     result->__set_tablet_stat_list(*local_cache);
 }
 
+// The benefit of a compaction over its cost, to pick the tablets under the compaction io budget.
+// The benefit is the compaction score reduced, plus the delete versions removed by a base
+// compaction, and doubled for the tablets queried 64K times. The cost is the bytes to read and
+// write in log scale, so the large tablets with high scores are not starved.
+static double compaction_priority(const TabletSharedPtr& tablet, CompactionType compaction_type,
+                                  uint32_t compaction_score) {
+    double benefit = compaction_score;
+    if (compaction_type == CompactionType::BASE_COMPACTION) {
+        benefit += tablet->delete_predicates().size();
+    }
+    benefit *= 1 + std::log2(1 + tablet->query_scan_count->value()) / 16;
+    int64_t io_mb = tablet->estimate_compaction_input_bytes(compaction_type) * 2 / (1 << 20);
+    return benefit / std::log2(2 + io_mb);
+}
+
 TabletSharedPtr TabletManager::find_best_tablet_to_compaction(
         CompactionType compaction_type, DataDir* data_dir,
         const std::unordered_set<TTabletId>& tablet_submitted_compaction, uint32_t* score,
@@ -651,6 +672,8 @@ TabletSharedPtr TabletManager::find_best_tablet_to_compaction(
             compaction_type == CompactionType::BASE_COMPACTION ? "base" : "cumulative";
     uint32_t highest_score = 0;
     uint32_t compaction_score = 0;
+    bool cost_based = CompactionIOBudget::bytes_per_sec() > 0;
+    double highest_priority = 0;
     TabletSharedPtr best_tablet;
     for (const auto& tablets_shard : _tablets_shards) {
         std::shared_lock rdlock(tablets_shard.lock);
@@ -702,7 +725,19 @@ TabletSharedPtr TabletManager::find_best_tablet_to_compaction(
             if (current_compaction_score < 5) {
                 tablet_ptr->set_skip_compaction(true, compaction_type, UnixSeconds());
             }
-            if (current_compaction_score > highest_score) {
+            if (cost_based) {
+                highest_score = std::max(highest_score, current_compaction_score);
+                if (current_compaction_score == 0) {
+                    continue;
+                }
+                double priority =
+                        compaction_priority(tablet_ptr, compaction_type, current_compaction_score);
+                if (priority > highest_priority) {
+                    highest_priority = priority;
+                    compaction_score = current_compaction_score;
+                    best_tablet = tablet_ptr;
+                }
+            } else if (current_compaction_score > highest_score) {
                 highest_score = current_compaction_score;
                 compaction_score = current_compaction_score;
                 best_tablet = tablet_ptr;
@@ -716,7 +751,8 @@ TabletSharedPtr TabletManager::find_best_tablet_to_compaction(
                       << ", tablet_id=" << best_tablet->tablet_id() << ", path=" << data_dir->path()
                       << ", compaction_score=" << compaction_score
                       << ", highest_score=" << highest_score;
-        *score = compaction_score;
+        // for the max compaction score metric
+        *score = highest_score;
     }
     return best_tablet;
 }
@@ -1245,6 +1281,39 @@ TabletManager::tablet_map_t& TabletManager::_get_tablet_map(TTabletId tabletId)
     return _get_tablets_shard(tabletId).tablet_map;
 }
 
+void TabletManager::_put_tablet_map_unlocked(TTabletId tablet_id, const TabletSharedPtr& tablet) {
+    tablets_shard& shard = _get_tablets_shard(tablet_id);
+    shard.tablet_map[tablet_id] = tablet;
+    shard.lookup_map.Modify(_put_lookup_map, std::make_pair(tablet_id, tablet));
+}
+
+void TabletManager::_erase_tablet_map_unlocked(TTabletId tablet_id) {
+    tablets_shard& shard = _get_tablets_shard(tablet_id);
+    shard.tablet_map.erase(tablet_id);
+    shard.lookup_map.Modify(_erase_lookup_map, tablet_id);
+}
+
+size_t TabletManager::_put_lookup_map(tablet_map_t& lookup_map,
+                                      const std::pair<TTabletId, TabletSharedPtr>& item) {
+    lookup_map[item.first] = item.second;
+    return 1;
+}
+
+size_t TabletManager::_erase_lookup_map(tablet_map_t& lookup_map, const TTabletId& tablet_id) {
+    return lookup_map.erase(tablet_id);
+}
+
+TabletSharedPtr TabletManager::_lookup_tablet(TTabletId tablet_id) {
+    butil::DoublyBufferedData<tablet_map_t>::ScopedPtr lookup_map;
+    if (_get_tablets_shard(tablet_id).lookup_map.Read(&lookup_map) != 0) {
+        // fall back to the tablet map if the thread local data can't be created
+        std::shared_lock rdlock(_get_tablets_shard_lock(tablet_id));
+        return _get_tablet_unlocked(tablet_id);
+    }
+    auto iter = lookup_map->find(tablet_id);
+    return iter != lookup_map->end() ? iter->second : nullptr;
+}
+
 TabletManager::tablets_shard& TabletManager::_get_tablets_shard(TTabletId tabletId) {
     return _tablets_shards[tabletId & _tablets_shards_mask];
 }
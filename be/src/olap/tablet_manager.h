@@ -28,6 +28,7 @@
 #include <unordered_set>
 #include <vector>
 
+#include "butil/containers/doubly_buffered_data.h"
 #include "common/status.h"
 #include "gen_cpp/AgentService_types.h"
 #include "gen_cpp/BackendService_types.h"
@@ -183,6 +184,11 @@ private:
     TabletSharedPtr _get_tablet_unlocked(TTabletId tablet_id);
     TabletSharedPtr _get_tablet_unlocked(TTabletId tablet_id, bool include_deleted,
                                          std::string* err);
+    // Check `tablet', which is the one of `tablet_id' in the tablet map, or nullptr if absent,
+    // and find it in the shutdown tablets if `include_deleted'.
+    TabletSharedPtr _check_found_tablet(TabletSharedPtr tablet, TTabletId tablet_id,
+                                        bool include_deleted, std::string* err);
+
 
     TabletSharedPtr _internal_create_tablet_unlocked(const TCreateTabletReq& request,
                                                      const bool is_schema_change,
@@ -217,6 +223,10 @@ private:
         // protect tablet_map, tablets_under_clone and tablets_under_restore
         mutable std::shared_mutex lock;
         tablet_map_t tablet_map;
+        // The copy of tablet_map to look up a tablet without the lock, whose readers only lock
+        // the thread local mutexes, so they share no cache lines. It's modified along with
+        // tablet_map with the write lock.
+        butil::DoublyBufferedData<tablet_map_t> lookup_map;
         std::set<int64_t> tablets_under_clone;
     };
 
@@ -242,6 +252,16 @@ private:
 
     tablet_map_t& _get_tablet_map(TTabletId tablet_id);
 
+    // add or remove a tablet in both tablet_map and lookup_map of its shard with the write lock
+    void _put_tablet_map_unlocked(TTabletId tablet_id, const TabletSharedPtr& tablet);
+    void _erase_tablet_map_unlocked(TTabletId tablet_id);
+    static size_t _put_lookup_map(tablet_map_t& lookup_map,
+                                  const std::pair<TTabletId, TabletSharedPtr>& item);
+    static size_t _erase_lookup_map(tablet_map_t& lookup_map, const TTabletId& tablet_id);
+
+    // find a tablet in the tablet map without the lock
+    TabletSharedPtr _lookup_tablet(TTabletId tablet_id);
+
     tablets_shard& _get_tablets_shard(TTabletId tabletId);
 };
 
@@ -974,6 +974,32 @@ void DeleteBitmap::merge(const DeleteBitmap& other) {
     }
 }
 
+size_t DeleteBitmap::aggregate(Version start_version, Version end_version) {
+    DCHECK(start_version < end_version);
+    std::lock_guard l(lock);
+    size_t num_merged = 0;
+    auto it = delete_bitmap.begin();
+    while (it != delete_bitmap.end()) {
+        auto version = std::get<2>(it->first);
+        if (version < start_version || version >= end_version) {
+            ++it;
+            continue;
+        }
+        // the keys of a segment are sorted by version, so the bitmap of end_version, if any,
+        // is right after the ones to merge
+        RowsetId rowset_id = std::get<0>(it->first);
+        SegmentId segment_id = std::get<1>(it->first);
+        auto& target = delete_bitmap[{rowset_id, segment_id, end_version}];
+        while (it != delete_bitmap.end() && std::get<0>(it->first) == rowset_id &&
+               std::get<1>(it->first) == segment_id && std::get<2>(it->first) < end_version) {
+            target |= it->second;
+            it = delete_bitmap.erase(it);
+            ++num_merged;
+        }
+    }
+    return num_merged;
+}
+
 uint64_t DeleteBitmap::cardinality() {
     uint64_t cardinality = 0;
     for (auto entry : delete_bitmap) {
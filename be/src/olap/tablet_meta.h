@@ -376,6 +376,17 @@ public:
      */
     void merge(const DeleteBitmap& other);
 
+    /**
+     * Merges the bitmaps of each segment with Version in [start_version, end_version)
+     * into the bitmap of the segment with end_version, the result of `get_agg` stays the
+     * same for the versions >= end_version.
+     *
+     * Note: only for the version ranges that will never be read again.
+     *
+     * @return the number of the bitmaps merged away
+     */
+    size_t aggregate(Version start_version, Version end_version);
+
     uint64_t cardinality();
 
     /**
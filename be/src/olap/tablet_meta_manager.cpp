@@ -115,6 +115,9 @@ Status TabletMetaManager::remove(DataDir* store, TTabletId tablet_id, TSchemaHas
     OlapMeta* meta = store->get_meta();
     Status res = meta->remove(META_COLUMN_FAMILY_INDEX, key);
     VLOG_NOTICE << "remove tablet_meta, key:" << key << ", res:" << res;
+    if (res.ok() && header_prefix == HEADER_PREFIX) {
+        res = remove_old_version_delete_bitmap(store, tablet_id, INT64_MAX);
+    }
     return res;
 }
 
@@ -162,4 +165,84 @@ Status TabletMetaManager::load_json_meta(DataDir* store, const std::string& meta
     return save(store, tablet_id, schema_hash, meta_binary);
 }
 
+Status TabletMetaManager::save_delete_bitmap(DataDir* store, TTabletId tablet_id, int64_t version,
+                                             const DeleteBitmap& delete_bitmap) {
+    DeleteBitmapPB delete_bitmap_pb;
+    for (auto& [id, bitmap] : delete_bitmap.snapshot().delete_bitmap) {
+        auto& [rowset_id, segment_id, ver] = id;
+        delete_bitmap_pb.add_rowset_ids(rowset_id.to_string());
+        delete_bitmap_pb.add_segment_ids(segment_id);
+        delete_bitmap_pb.add_versions(version);
+        std::string bitmap_data(bitmap.getSizeInBytes(), '\0');
+        bitmap.write(bitmap_data.data());
+        *(delete_bitmap_pb.add_segment_delete_bitmaps()) = std::move(bitmap_data);
+    }
+    if (delete_bitmap_pb.rowset_ids_size() == 0) {
+        return Status::OK();
+    }
+    std::string key = encode_delete_bitmap_key(tablet_id, version);
+    std::string value;
+    delete_bitmap_pb.SerializeToString(&value);
+    VLOG_NOTICE << "save delete bitmap, key:" << key << ", value length:" << value.length();
+    return store->get_meta()->put(META_COLUMN_FAMILY_INDEX, key, value);
+}
+
+Status TabletMetaManager::remove_old_version_delete_bitmap(DataDir* store, TTabletId tablet_id,
+                                                           int64_t version) {
+    OlapMeta* meta = store->get_meta();
+    std::vector<std::string> keys;
+    auto collect_key_func = [&keys, version](const std::string& key,
+                                             const std::string& value) -> bool {
+        TTabletId tablet_id;
+        int64_t delta_version;
+        if (decode_delete_bitmap_key(key, &tablet_id, &delta_version) &&
+            delta_version <= version) {
+            keys.push_back(key);
+        }
+        return true;
+    };
+    std::string prefix = fmt::format("{}{:020}_", DELETE_BITMAP_PREFIX, tablet_id);
+    RETURN_IF_ERROR(meta->iterate(META_COLUMN_FAMILY_INDEX, prefix, collect_key_func));
+    for (const auto& key : keys) {
+        RETURN_IF_ERROR(meta->remove(META_COLUMN_FAMILY_INDEX, key));
+    }
+    VLOG_NOTICE << "remove delete bitmap, tablet_id:" << tablet_id << ", version:" << version
+                << ", removed deltas:" << keys.size();
+    return Status::OK();
+}
+
+Status TabletMetaManager::traverse_delete_bitmap(
+        OlapMeta* meta, std::function<bool(int64_t, int64_t, const std::string&)> const& func) {
+    auto traverse_delete_bitmap_func = [&func](const std::string& key,
+                                               const std::string& value) -> bool {
+        TTabletId tablet_id;
+        int64_t version;
+        if (!decode_delete_bitmap_key(key, &tablet_id, &version)) {
+            LOG(WARNING) << "invalid delete bitmap key:" << key;
+            return true;
+        }
+        return func(tablet_id, version, value);
+    };
+    return meta->iterate(META_COLUMN_FAMILY_INDEX, DELETE_BITMAP_PREFIX,
+                         traverse_delete_bitmap_func);
+}
+
+// The ids and versions are zero-padded so that the deltas of a tablet are in the order of the
+// versions in the meta.
+std::string TabletMetaManager::encode_delete_bitmap_key(TTabletId tablet_id, int64_t version) {
+    return fmt::format("{}{:020}_{:020}", DELETE_BITMAP_PREFIX, tablet_id, version);
+}
+
+bool TabletMetaManager::decode_delete_bitmap_key(const std::string& key, TTabletId* tablet_id,
+                                                 int64_t* version) {
+    std::vector<std::string> parts;
+    split_string<char>(key, '_', &parts);
+    if (parts.size() != 3) {
+        return false;
+    }
+    *tablet_id = std::stol(parts[1], nullptr, 10);
+    *version = std::stol(parts[2], nullptr, 10);
+    return true;
+}
+
 } // namespace doris
@@ -29,6 +29,8 @@ const std::string OLD_HEADER_PREFIX = "hdr_";
 
 const std::string HEADER_PREFIX = "tabletmeta_";
 
+const std::string DELETE_BITMAP_PREFIX = "dlbm_";
+
 // Helper Class for managing tablet headers of one root path.
 class TabletMetaManager {
 public:
@@ -52,6 +54,23 @@ public:
                                    const string& header_prefix = "tabletmeta_");
 
     static Status load_json_meta(DataDir* store, const std::string& meta_path);
+
+    // The delete bitmap published into a merge-on-write tablet of `version` is saved as a delta
+    // of the tablet meta, instead of saving the whole tablet meta. The deltas are merged into the
+    // tablet meta when it's loaded, and removed once the tablet meta is saved by a checkpoint.
+    static Status save_delete_bitmap(DataDir* store, TTabletId tablet_id, int64_t version,
+                                     const DeleteBitmap& delete_bitmap);
+
+    // Removes the delete bitmap deltas of the versions not greater than `version`.
+    static Status remove_old_version_delete_bitmap(DataDir* store, TTabletId tablet_id,
+                                                   int64_t version);
+
+    static Status traverse_delete_bitmap(
+            OlapMeta* meta, std::function<bool(int64_t, int64_t, const std::string&)> const& func);
+
+    static std::string encode_delete_bitmap_key(TTabletId tablet_id, int64_t version);
+    static bool decode_delete_bitmap_key(const std::string& key, TTabletId* tablet_id,
+                                         int64_t* version);
 };
 
 } // namespace doris
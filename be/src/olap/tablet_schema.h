@@ -56,6 +56,7 @@ public:
     bool is_nullable() const { return _is_nullable; }
     bool is_variant_type() const { return _type == OLAP_FIELD_TYPE_VARIANT; }
     bool is_bf_column() const { return _is_bf_column; }
+    void set_is_bf_column(bool is_bf_column) { _is_bf_column = is_bf_column; }
     bool has_bitmap_index() const { return _has_bitmap_index; }
     bool is_array_type() const { return _type == OLAP_FIELD_TYPE_ARRAY; }
     bool is_length_variable_type() const {
@@ -17,9 +17,12 @@
 
 #include "olap/task/engine_clone_task.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <system_error>
+#include <thread>
 
 #include "gen_cpp/BackendService.h"
 #include "gen_cpp/Types_constants.h"
@@ -34,6 +37,7 @@
 #include "olap/tablet_meta.h"
 #include "runtime/client_cache.h"
 #include "runtime/thread_context.h"
+#include "util/bandwidth_limiter.h"
 #include "util/defer_op.h"
 #include "util/network_util.h"
 #include "util/thrift_rpc_helper.h"
@@ -53,6 +57,9 @@ const uint32_t DOWNLOAD_FILE_MAX_RETRY = 3;
 const uint32_t LIST_REMOTE_FILE_TIMEOUT = 15;
 const uint32_t GET_LENGTH_TIMEOUT = 10;
 
+// limits the total download speed of all the clone tasks
+static BandwidthLimiter s_clone_bandwidth_limiter;
+
 EngineCloneTask::EngineCloneTask(const TCloneReq& clone_req, const TMasterInfo& master_info,
                                  int64_t signature, std::vector<TTabletInfo>* tablet_infos)
         : _clone_req(clone_req),
@@ -386,10 +393,10 @@ Status EngineCloneTask::_download_files(DataDir* data_dir, const std::string& re
     }
 
     // Get copy from remote
-    uint64_t total_file_size = 0;
+    std::atomic<uint64_t> total_file_size {0};
     MonotonicStopWatch watch;
     watch.start();
-    for (auto& file_name : file_name_list) {
+    auto download_file = [&](const std::string& file_name) {
         auto remote_file_url = remote_url_prefix + file_name;
 
         // get file length
@@ -424,7 +431,10 @@ Status EngineCloneTask::_download_files(DataDir* data_dir, const std::string& re
                             file_size](HttpClient* client) {
             RETURN_IF_ERROR(client->init(remote_file_url));
             client->set_timeout_ms(estimate_timeout * 1000);
-            RETURN_IF_ERROR(client->download(local_file_path));
+            RETURN_IF_ERROR(client->download(local_file_path, [](size_t length) {
+                s_clone_bandwidth_limiter.acquire(
+                        length, config::clone_max_total_download_speed_kbps * 1024L);
+            }));
 
             std::error_code ec;
             // Check file length
@@ -443,18 +453,55 @@ Status EngineCloneTask::_download_files(DataDir* data_dir, const std::string& re
             chmod(local_file_path.c_str(), S_IRUSR | S_IWUSR);
             return Status::OK();
         };
-        RETURN_IF_ERROR(HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, download_cb));
+        return HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, download_cb);
+    };
+
+    // the files except the header file are downloaded by the threads in parallel, and the
+    // threads stop picking files once any download fails
+    if (!file_name_list.empty()) {
+        size_t num_data_files = file_name_list.size() - 1;
+        std::atomic<size_t> next_file {0};
+        std::mutex status_lock;
+        Status download_status;
+        auto download_worker = [&]() {
+            SCOPED_ATTACH_TASK(_mem_tracker);
+            while (true) {
+                size_t i = next_file++;
+                if (i >= num_data_files) {
+                    return;
+                }
+                auto st = download_file(file_name_list[i]);
+                if (!st.ok()) {
+                    std::lock_guard<std::mutex> l(status_lock);
+                    download_status = st;
+                    next_file = num_data_files;
+                    return;
+                }
+            }
+        };
+        size_t num_threads = std::min<size_t>(config::clone_download_file_parallelism,
+                                              num_data_files);
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < num_threads; ++i) {
+            threads.emplace_back(download_worker);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        RETURN_IF_ERROR(download_status);
+        RETURN_IF_ERROR(download_file(file_name_list.back()));
     } // Clone files from remote backend
 
     uint64_t total_time_ms = watch.elapsed_time() / 1000 / 1000;
     total_time_ms = total_time_ms > 0 ? total_time_ms : 0;
     double copy_rate = 0.0;
     if (total_time_ms > 0) {
-        copy_rate = total_file_size / ((double)total_time_ms) / 1000;
+        copy_rate = total_file_size.load() / ((double)total_time_ms) / 1000;
     }
-    _copy_size = (int64_t)total_file_size;
+    _copy_size = (int64_t)total_file_size.load();
     _copy_time_ms = (int64_t)total_time_ms;
-    LOG(INFO) << "succeed to copy tablet " << _signature << ", total file size: " << total_file_size
+    LOG(INFO) << "succeed to copy tablet " << _signature
+              << ", total file size: " << total_file_size.load()
               << " B"
               << ", cost: " << total_time_ms << " ms"
               << ", rate: " << copy_rate << " MB/s";
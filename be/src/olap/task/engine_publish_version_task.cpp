@@ -31,6 +31,88 @@ using namespace ErrorCode;
 
 using std::map;
 
+namespace {
+
+bool is_merge_on_write(const TabletSharedPtr& tablet) {
+    return tablet->keys_type() == KeysType::UNIQUE_KEYS &&
+           tablet->enable_unique_key_merge_on_write();
+}
+
+// Returns whether `version` is the next version to publish in the merge-on-write tablet.
+bool is_version_continuous(const TabletSharedPtr& tablet, const Version& version) {
+    Version max_version;
+    TabletState tablet_state;
+    {
+        std::shared_lock rdlock(tablet->get_header_lock());
+        max_version = tablet->max_version();
+        tablet_state = tablet->tablet_state();
+    }
+    if (tablet_state == TabletState::TABLET_RUNNING && version.first != max_version.second + 1) {
+        VLOG_NOTICE << "uniq key with merge-on-write version not continuous, current max version="
+                    << max_version.second << ", publish_version=" << version.first
+                    << " tablet_id=" << tablet->tablet_id();
+        return false;
+    }
+    return true;
+}
+
+void submit_tablet_publish_txn_task(const std::shared_ptr<TabletPublishTxnTask>& task) {
+    auto submit_st = StorageEngine::instance()->tablet_publish_txn_thread_pool()->submit_func(
+            [=]() { task->handle(); });
+    CHECK(submit_st.ok());
+}
+
+} // namespace
+
+TabletPublishQueue* TabletPublishQueue::instance() {
+    static TabletPublishQueue queue;
+    return &queue;
+}
+
+void TabletPublishQueue::start(int64_t tablet_id, int64_t version) {
+    std::lock_guard<std::mutex> l(_lock);
+    ++_tablets[tablet_id].publishing[version];
+}
+
+bool TabletPublishQueue::enqueue(int64_t tablet_id, int64_t version, std::function<void()> task) {
+    std::lock_guard<std::mutex> l(_lock);
+    auto it = _tablets.find(tablet_id);
+    if (it == _tablets.end()) {
+        return false;
+    }
+    auto& versions = it->second;
+    if ((versions.publishing.count(version - 1) == 0 && versions.queued.count(version - 1) == 0) ||
+        versions.queued.count(version) != 0) {
+        return false;
+    }
+    versions.queued.emplace(version, std::move(task));
+    return true;
+}
+
+std::function<void()> TabletPublishQueue::finish(int64_t tablet_id, int64_t version) {
+    std::lock_guard<std::mutex> l(_lock);
+    auto it = _tablets.find(tablet_id);
+    if (it == _tablets.end()) {
+        return nullptr;
+    }
+    auto& versions = it->second;
+    auto publishing_it = versions.publishing.find(version);
+    if (publishing_it != versions.publishing.end() && --publishing_it->second == 0) {
+        versions.publishing.erase(publishing_it);
+    }
+    std::function<void()> next;
+    auto queued_it = versions.queued.find(version + 1);
+    if (queued_it != versions.queued.end()) {
+        next = std::move(queued_it->second);
+        versions.queued.erase(queued_it);
+        ++versions.publishing[version + 1];
+    }
+    if (versions.publishing.empty() && versions.queued.empty()) {
+        _tablets.erase(it);
+    }
+    return next;
+}
+
 EnginePublishVersionTask::EnginePublishVersionTask(TPublishVersionRequest& publish_version_req,
                                                    std::vector<TTabletId>* error_tablet_ids,
                                                    std::vector<TTabletId>* succ_tablet_ids)
@@ -111,25 +193,23 @@ Status EnginePublishVersionTask::finish() {
                 res = Status::Error<PUSH_TABLE_NOT_EXIST>();
                 continue;
             }
+            total_task_num.fetch_add(1);
+            auto tablet_publish_txn_ptr = std::make_shared<TabletPublishTxnTask>(
+                    this, tablet, rowset, partition_id, transaction_id, version, tablet_info,
+                    &total_task_num);
             // in uniq key model with merge-on-write, we should see all
             // previous version when update delete bitmap, so add a check
-            // here and wait pre version publish or lock timeout
-            if (tablet->keys_type() == KeysType::UNIQUE_KEYS &&
-                tablet->enable_unique_key_merge_on_write()) {
-                Version max_version;
-                TabletState tablet_state;
-                {
-                    std::shared_lock rdlock(tablet->get_header_lock());
-                    max_version = tablet->max_version();
-                    tablet_state = tablet->tablet_state();
-                }
-                if (tablet_state == TabletState::TABLET_RUNNING &&
-                    version.first != max_version.second + 1) {
-                    VLOG_NOTICE << "uniq key with merge-on-write version not continuous, current "
-                                   "max "
-                                   "version="
-                                << max_version.second << ", publish_version=" << version.first
-                                << " tablet_id=" << tablet->tablet_id();
+            // here and queue it after the publish of the previous version in progress,
+            // or wait pre version publish or lock timeout
+            if (is_merge_on_write(tablet)) {
+                if (!is_version_continuous(tablet, version)) {
+                    if (TabletPublishQueue::instance()->enqueue(
+                                tablet_info.tablet_id, version.first, [tablet_publish_txn_ptr]() {
+                                    submit_tablet_publish_txn_task(tablet_publish_txn_ptr);
+                                })) {
+                        continue;
+                    }
+                    total_task_num.fetch_sub(1);
                     // If a tablet migrates out and back, the previously failed
                     // publish task may retry on the new tablet, so check
                     // whether the version exists. if not exist, then set
@@ -140,21 +220,18 @@ Status EnginePublishVersionTask::finish() {
                     }
                     continue;
                 }
+                TabletPublishQueue::instance()->start(tablet_info.tablet_id, version.first);
             }
-            total_task_num.fetch_add(1);
-            auto tablet_publish_txn_ptr = std::make_shared<TabletPublishTxnTask>(
-                    this, tablet, rowset, partition_id, transaction_id, version, tablet_info,
-                    &total_task_num);
-            auto submit_st =
-                    StorageEngine::instance()->tablet_publish_txn_thread_pool()->submit_func(
-                            [=]() { tablet_publish_txn_ptr->handle(); });
-            CHECK(submit_st.ok());
+            submit_tablet_publish_txn_task(tablet_publish_txn_ptr);
         }
     }
     // wait for all publish txn finished
     while (total_task_num.load() != 0) {
         wait();
     }
+    if (res.ok() && _version_not_continuous) {
+        res = Status::Error<PUBLISH_VERSION_NOT_CONTINUOUS>();
+    }
 
     // check if the related tablet remained all have the version
     for (auto& par_ver_info : _publish_version_req.partition_version_infos) {
@@ -208,11 +285,32 @@ TabletPublishTxnTask::TabletPublishTxnTask(EnginePublishVersionTask* engine_task
           _total_task_num(total_task_num) {}
 
 void TabletPublishTxnTask::handle() {
+    bool merge_on_write = is_merge_on_write(_tablet);
     Defer defer {[&] {
+        if (merge_on_write) {
+            // the queued task belongs to the publish of another transaction
+            auto next = TabletPublishQueue::instance()->finish(_tablet_info.tablet_id,
+                                                               _version.first);
+            if (next) {
+                next();
+            }
+        }
         if (_total_task_num->fetch_sub(1) == 1) {
             _engine_publish_version_task->notify();
         }
     }};
+    _publish();
+}
+
+void TabletPublishTxnTask::_publish() {
+    // the publish of the previous version the task was queued after may fail
+    if (is_merge_on_write(_tablet) && !is_version_continuous(_tablet, _version)) {
+        if (!_tablet->check_version_exist(_version)) {
+            _engine_publish_version_task->add_error_tablet_id(_tablet_info.tablet_id);
+            _engine_publish_version_task->set_version_not_continuous();
+        }
+        return;
+    }
     auto publish_status = StorageEngine::instance()->txn_manager()->publish_txn(
             _partition_id, _tablet, _transaction_id, _version);
     if (publish_status != Status::OK()) {
@@ -18,12 +18,48 @@
 #ifndef DORIS_BE_SRC_OLAP_TASK_ENGINE_PUBLISH_VERSION_TASK_H
 #define DORIS_BE_SRC_OLAP_TASK_ENGINE_PUBLISH_VERSION_TASK_H
 
+#include <functional>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
 #include "gen_cpp/AgentService_types.h"
 #include "olap/olap_define.h"
 #include "olap/task/engine_task.h"
 
 namespace doris {
 
+// The publishes of the versions of the merge-on-write tablets in progress, which must be in the
+// order of the versions on a tablet. The publish of a version whose previous version is in
+// progress on the same tablet is queued after it, instead of failing the publish of the whole
+// transaction with PUBLISH_VERSION_NOT_CONTINUOUS, so the other tablets and transactions proceed
+// and the transaction isn't retried by the worker.
+class TabletPublishQueue {
+public:
+    static TabletPublishQueue* instance();
+
+    // Registers the publish of `version` of the tablet, which is to be run.
+    void start(int64_t tablet_id, int64_t version);
+
+    // Queues `task` to publish `version` of the tablet after the previous version. Returns false
+    // if the previous version is not in progress or queued, i.e. it's unknown when it would be.
+    bool enqueue(int64_t tablet_id, int64_t version, std::function<void()> task);
+
+    // Unregisters the publish of `version` of the tablet, and returns the task queued after it,
+    // which is registered to be run, or nullptr if there isn't any.
+    std::function<void()> finish(int64_t tablet_id, int64_t version);
+
+private:
+    struct TabletVersions {
+        // the counts of the publishes of the versions in progress
+        std::map<int64_t, int> publishing;
+        std::map<int64_t, std::function<void()>> queued;
+    };
+
+    std::mutex _lock;
+    std::unordered_map<int64_t, TabletVersions> _tablets;
+};
+
 class EnginePublishVersionTask;
 class TabletPublishTxnTask {
 public:
@@ -36,6 +72,8 @@ public:
     void handle();
 
 private:
+    void _publish();
+
     EnginePublishVersionTask* _engine_publish_version_task;
 
     TabletSharedPtr _tablet;
@@ -59,6 +97,8 @@ public:
 
     void add_error_tablet_id(int64_t tablet_id);
     void add_succ_tablet_id(int64_t tablet_id);
+    // The previous version of a merge-on-write tablet isn't published yet.
+    void set_version_not_continuous() { _version_not_continuous = true; }
 
     void notify();
     void wait();
@@ -69,6 +109,8 @@ private:
     vector<TTabletId>* _error_tablet_ids;
     vector<TTabletId>* _succ_tablet_ids;
 
+    std::atomic<bool> _version_not_continuous = false;
+
     std::mutex _tablet_finish_sleep_mutex;
     std::condition_variable _tablet_finish_sleep_cond;
 };
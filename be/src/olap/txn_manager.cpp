@@ -216,39 +216,11 @@ Status TxnManager::commit_txn(OlapMeta* meta, TPartitionId partition_id,
     {
         // get tx
         std::shared_lock rdlock(_get_txn_map_lock(transaction_id));
-        txn_tablet_map_t& txn_tablet_map = _get_txn_tablet_map(transaction_id);
-        auto it = txn_tablet_map.find(key);
-        if (it != txn_tablet_map.end()) {
-            auto load_itr = it->second.find(tablet_info);
-            if (load_itr != it->second.end()) {
-                // found load for txn,tablet
-                // case 1: user commit rowset, then the load id must be equal
-                TabletTxnInfo& load_info = load_itr->second;
-                // check if load id is equal
-                if (load_info.load_id.hi() == load_id.hi() &&
-                    load_info.load_id.lo() == load_id.lo() && load_info.rowset != nullptr &&
-                    load_info.rowset->rowset_id() == rowset_ptr->rowset_id()) {
-                    // find a rowset with same rowset id, then it means a duplicate call
-                    LOG(INFO) << "find rowset exists when commit transaction to engine."
-                              << "partition_id: " << key.first << ", transaction_id: " << key.second
-                              << ", tablet: " << tablet_info.to_string()
-                              << ", rowset_id: " << load_info.rowset->rowset_id();
-                    return Status::OK();
-                } else if (load_info.load_id.hi() == load_id.hi() &&
-                           load_info.load_id.lo() == load_id.lo() && load_info.rowset != nullptr &&
-                           load_info.rowset->rowset_id() != rowset_ptr->rowset_id()) {
-                    // find a rowset with different rowset id, then it should not happen, just return errors
-                    LOG(WARNING) << "find rowset exists when commit transaction to engine. but "
-                                    "rowset ids "
-                                    "are not same."
-                                 << "partition_id: " << key.first
-                                 << ", transaction_id: " << key.second
-                                 << ", tablet: " << tablet_info.to_string()
-                                 << ", exist rowset_id: " << load_info.rowset->rowset_id()
-                                 << ", new rowset_id: " << rowset_ptr->rowset_id();
-                    return Status::Error<PUSH_TRANSACTION_ALREADY_EXIST>();
-                }
-            }
+        bool committed = false;
+        RETURN_IF_ERROR(_check_committed_unlocked(_get_txn_tablet_map(transaction_id), key,
+                                                  tablet_info, load_id, rowset_ptr, &committed));
+        if (committed) {
+            return Status::OK();
         }
     }
 
@@ -290,6 +262,115 @@ Status TxnManager::commit_txn(OlapMeta* meta, TPartitionId partition_id,
     return Status::OK();
 }
 
+Status TxnManager::_check_committed_unlocked(txn_tablet_map_t& txn_tablet_map,
+                                             const std::pair<int64_t, int64_t>& key,
+                                             const TabletInfo& tablet_info,
+                                             const PUniqueId& load_id,
+                                             const RowsetSharedPtr& rowset_ptr, bool* committed) {
+    *committed = false;
+    auto it = txn_tablet_map.find(key);
+    if (it == txn_tablet_map.end()) {
+        return Status::OK();
+    }
+    auto load_itr = it->second.find(tablet_info);
+    if (load_itr == it->second.end()) {
+        return Status::OK();
+    }
+    // found load for txn,tablet
+    // case 1: user commit rowset, then the load id must be equal
+    TabletTxnInfo& load_info = load_itr->second;
+    // check if load id is equal
+    if (load_info.load_id.hi() == load_id.hi() && load_info.load_id.lo() == load_id.lo() &&
+        load_info.rowset != nullptr && load_info.rowset->rowset_id() == rowset_ptr->rowset_id()) {
+        // find a rowset with same rowset id, then it means a duplicate call
+        LOG(INFO) << "find rowset exists when commit transaction to engine."
+                  << "partition_id: " << key.first << ", transaction_id: " << key.second
+                  << ", tablet: " << tablet_info.to_string()
+                  << ", rowset_id: " << load_info.rowset->rowset_id();
+        *committed = true;
+    } else if (load_info.load_id.hi() == load_id.hi() && load_info.load_id.lo() == load_id.lo() &&
+               load_info.rowset != nullptr &&
+               load_info.rowset->rowset_id() != rowset_ptr->rowset_id()) {
+        // find a rowset with different rowset id, then it should not happen, just return errors
+        LOG(WARNING) << "find rowset exists when commit transaction to engine. but "
+                        "rowset ids are not same."
+                     << "partition_id: " << key.first << ", transaction_id: " << key.second
+                     << ", tablet: " << tablet_info.to_string()
+                     << ", exist rowset_id: " << load_info.rowset->rowset_id()
+                     << ", new rowset_id: " << rowset_ptr->rowset_id();
+        return Status::Error<PUSH_TRANSACTION_ALREADY_EXIST>();
+    }
+    return Status::OK();
+}
+
+void TxnManager::commit_txns(TTransactionId transaction_id, std::vector<TabletTxnCommit>* commits) {
+    // the commits to save, grouped by the metas of their data dirs
+    std::map<OlapMeta*, std::vector<TabletTxnCommit*>> commits_to_save;
+    std::unique_lock<std::mutex> txn_lock(_get_txn_lock(transaction_id));
+    {
+        std::shared_lock rdlock(_get_txn_map_lock(transaction_id));
+        txn_tablet_map_t& txn_tablet_map = _get_txn_tablet_map(transaction_id);
+        for (auto& commit : *commits) {
+            if (commit.partition_id < 1 || transaction_id < 1) {
+                LOG(FATAL) << "invalid commit req "
+                           << " partition_id=" << commit.partition_id
+                           << " transaction_id=" << transaction_id
+                           << " tablet_id=" << commit.tablet->tablet_id();
+            }
+            if (commit.rowset == nullptr) {
+                LOG(WARNING) << "could not commit txn because rowset ptr is null. "
+                             << "partition_id: " << commit.partition_id
+                             << ", transaction_id: " << transaction_id
+                             << ", tablet: " << commit.tablet->tablet_id();
+                commit.status = Status::Error<ROWSET_INVALID>();
+                continue;
+            }
+            TabletInfo tablet_info(commit.tablet->tablet_id(), commit.tablet->schema_hash(),
+                                   commit.tablet->tablet_uid());
+            bool committed = false;
+            commit.status = _check_committed_unlocked(
+                    txn_tablet_map, {commit.partition_id, transaction_id}, tablet_info,
+                    commit.load_id, commit.rowset, &committed);
+            if (commit.status.ok() && !committed) {
+                commits_to_save[commit.tablet->data_dir()->get_meta()].push_back(&commit);
+            }
+        }
+    }
+
+    // save meta need access disk, it maybe very slow, so that it is not in global txn lock
+    // it is under a single txn lock
+    for (auto& [meta, meta_commits] : commits_to_save) {
+        std::vector<std::pair<TabletUid, RowsetMetaSharedPtr>> rowset_metas;
+        rowset_metas.reserve(meta_commits.size());
+        for (auto* commit : meta_commits) {
+            rowset_metas.emplace_back(commit->tablet->tablet_uid(), commit->rowset->rowset_meta());
+        }
+        Status save_status = RowsetMetaManager::save(meta, rowset_metas);
+        if (!save_status.ok()) {
+            LOG(WARNING) << "save " << rowset_metas.size() << " committed rowsets failed"
+                         << ", txn id: " << transaction_id << ", status: " << save_status;
+            for (auto* commit : meta_commits) {
+                commit->status = Status::Error<ROWSET_SAVE_FAILED>();
+            }
+            meta_commits.clear();
+        }
+    }
+
+    std::lock_guard<std::shared_mutex> wrlock(_get_txn_map_lock(transaction_id));
+    txn_tablet_map_t& txn_tablet_map = _get_txn_tablet_map(transaction_id);
+    for (auto& [meta, meta_commits] : commits_to_save) {
+        for (auto* commit : meta_commits) {
+            TabletInfo tablet_info(commit->tablet->tablet_id(), commit->tablet->schema_hash(),
+                                   commit->tablet->tablet_uid());
+            txn_tablet_map[{commit->partition_id, transaction_id}][tablet_info] =
+                    TabletTxnInfo(commit->load_id, commit->rowset);
+            _insert_txn_partition_map_unlocked(transaction_id, commit->partition_id);
+        }
+    }
+    VLOG_NOTICE << "commit " << commits->size() << " tablets of transaction " << transaction_id
+                << " to engine";
+}
+
 // remove a txn from txn manager
 Status TxnManager::publish_txn(OlapMeta* meta, TPartitionId partition_id,
                                TTransactionId transaction_id, TTabletId tablet_id,
@@ -330,8 +411,11 @@ Status TxnManager::publish_txn(OlapMeta* meta, TPartitionId partition_id,
                         return Status::OK();
                     }
                     RETURN_IF_ERROR(tablet->update_delete_bitmap(rowset_ptr, &load_info));
-                    std::shared_lock rlock(tablet->get_header_lock());
-                    tablet->save_meta();
+                    // the delete bitmap is saved as a delta of the tablet meta
+                    if (!config::enable_delete_bitmap_delta_meta) {
+                        std::shared_lock rlock(tablet->get_header_lock());
+                        tablet->save_meta();
+                    }
                 }
             }
             Status save_status =
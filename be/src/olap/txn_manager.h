@@ -78,6 +78,16 @@ struct TabletTxnInfo {
     TabletTxnInfo() {}
 };
 
+// a rowset of a tablet to commit along with the others of the same txn by TxnManager::commit_txns
+struct TabletTxnCommit {
+    TPartitionId partition_id;
+    TabletSharedPtr tablet;
+    PUniqueId load_id;
+    RowsetSharedPtr rowset;
+    // the result of the commit
+    Status status;
+};
+
 // txn manager is used to manage mapping between tablet and txns
 class TxnManager {
 public:
@@ -99,6 +109,10 @@ public:
                       TTransactionId transaction_id, const PUniqueId& load_id,
                       const RowsetSharedPtr& rowset_ptr, bool is_recovery);
 
+    // Commit the rowsets of many tablets of the txn like commit_txn(), but with a round of each
+    // lock, and the rowset metas of the tablets of the same data dir saved in one write batch.
+    void commit_txns(TTransactionId transaction_id, std::vector<TabletTxnCommit>* commits);
+
     Status publish_txn(TPartitionId partition_id, const TabletSharedPtr& tablet,
                        TTransactionId transaction_id, const Version& version);
 
@@ -207,6 +221,13 @@ private:
 
     txn_tablet_delta_writer_map_t& _get_txn_tablet_delta_writer_map(TTransactionId transactionId);
 
+    // Check whether the rowset is committed already in `txn_tablet_map', and set `committed' if
+    // it's a duplicate commit. Get _txn_map_lock before calling.
+    Status _check_committed_unlocked(txn_tablet_map_t& txn_tablet_map,
+                                     const std::pair<int64_t, int64_t>& key,
+                                     const TabletInfo& tablet_info, const PUniqueId& load_id,
+                                     const RowsetSharedPtr& rowset_ptr, bool* committed);
+
     // Insert or remove (transaction_id, partition_id) from _txn_partition_map
     // get _txn_map_lock before calling.
     void _insert_txn_partition_map_unlocked(int64_t transaction_id, int64_t partition_id);
@@ -0,0 +1,70 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "dependency.h"
+
+#include <algorithm>
+
+#include "task_scheduler.h"
+
+namespace doris::pipeline {
+
+bool Dependency::park(PipelineTask* task, BlockedTaskScheduler* scheduler, uint64_t version) {
+    std::lock_guard<std::mutex> l(_lock);
+    _blocked_tasks.emplace_back(task, scheduler);
+    _num_blocked_tasks = _blocked_tasks.size();
+    // pairs with the fence in notify(): either notify() sees the parked task, or we
+    // see the new version.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_version.load() != version) {
+        _blocked_tasks.pop_back();
+        _num_blocked_tasks = _blocked_tasks.size();
+        return false;
+    }
+    return true;
+}
+
+bool Dependency::remove(PipelineTask* task) {
+    std::lock_guard<std::mutex> l(_lock);
+    auto it = std::find_if(_blocked_tasks.begin(), _blocked_tasks.end(),
+                           [task](const auto& blocked) { return blocked.first == task; });
+    if (it == _blocked_tasks.end()) {
+        return false;
+    }
+    _blocked_tasks.erase(it);
+    _num_blocked_tasks = _blocked_tasks.size();
+    return true;
+}
+
+void Dependency::notify() {
+    _version++;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_num_blocked_tasks.load() == 0) {
+        return;
+    }
+    std::vector<std::pair<PipelineTask*, BlockedTaskScheduler*>> tasks;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        tasks.swap(_blocked_tasks);
+        _num_blocked_tasks = 0;
+    }
+    for (auto& [task, scheduler] : tasks) {
+        scheduler->wake_up(task);
+    }
+}
+
+} // namespace doris::pipeline
@@ -0,0 +1,66 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace doris::pipeline {
+
+class PipelineTask;
+class BlockedTaskScheduler;
+
+// A Dependency lets the producer of some data (exchange receiver, scanner context,
+// runtime filter) wake up the pipeline tasks blocked on it, instead of letting
+// the BlockedTaskScheduler poll them.
+//
+// The producer calls notify() after each change that may make the blocked tasks
+// ready. The woken tasks check their state again, so a spurious wake up is harmless.
+//
+// To avoid losing a notification which happens between checking the task and
+// parking it, the BlockedTaskScheduler reads version() before checking the task,
+// and park() fails if any notify() happened since then.
+class Dependency {
+public:
+    Dependency() = default;
+
+    Dependency(const Dependency&) = delete;
+    Dependency& operator=(const Dependency&) = delete;
+
+    uint64_t version() const { return _version.load(); }
+
+    // Park the task until next notify(). Return false if notified since `version`,
+    // then the task should be checked again.
+    bool park(PipelineTask* task, BlockedTaskScheduler* scheduler, uint64_t version);
+
+    // Remove the task parked on this dependency. Return false if the task is not
+    // parked, e.g. it is just woken up by notify().
+    bool remove(PipelineTask* task);
+
+    void notify();
+
+private:
+    std::atomic<uint64_t> _version = 0;
+    std::atomic<size_t> _num_blocked_tasks = 0;
+    std::mutex _lock;
+    std::vector<std::pair<PipelineTask*, BlockedTaskScheduler*>> _blocked_tasks;
+};
+
+} // namespace doris::pipeline
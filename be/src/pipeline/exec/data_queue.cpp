@@ -120,6 +120,22 @@ Status DataQueue::get_block_from_queue(std::unique_ptr<vectorized::Block>* outpu
     return Status::OK();
 }
 
+Status DataQueue::get_block_from_queue_of_child(int child_idx,
+                                                std::unique_ptr<vectorized::Block>* output_block) {
+    if (_is_canceled[child_idx]) {
+        return Status::InternalError("Current queue of idx {} have beed canceled: ", child_idx);
+    }
+
+    std::lock_guard<std::mutex> l(*_queue_blocks_lock[child_idx]);
+    if (_cur_blocks_nums_in_queue[child_idx] > 0) {
+        *output_block = std::move(_queue_blocks[child_idx].front());
+        _queue_blocks[child_idx].pop_front();
+        _cur_bytes_in_queue[child_idx] -= (*output_block)->allocated_bytes();
+        _cur_blocks_nums_in_queue[child_idx] -= 1;
+    }
+    return Status::OK();
+}
+
 void DataQueue::push_block(std::unique_ptr<vectorized::Block> block, int child_idx) {
     if (!block) {
         return;
@@ -38,6 +38,10 @@ public:
     Status get_block_from_queue(std::unique_ptr<vectorized::Block>* block,
                                 int* child_idx = nullptr);
 
+    // Gets a block of the child, which stays null if the queue of the child is empty.
+    Status get_block_from_queue_of_child(int child_idx,
+                                         std::unique_ptr<vectorized::Block>* block);
+
     void push_block(std::unique_ptr<vectorized::Block> block, int child_idx = 0);
 
     std::unique_ptr<vectorized::Block> get_free_block(int child_idx = 0);
@@ -51,6 +55,9 @@ public:
 
     bool has_enough_space_to_push(int child_idx = 0);
     bool has_data_or_finished(int child_idx = 0);
+    bool has_data_of_child(int child_idx) const {
+        return _cur_blocks_nums_in_queue[child_idx] > 0;
+    }
     bool remaining_has_data();
 
     int64_t max_bytes_in_queue() const { return _max_bytes_in_queue; }
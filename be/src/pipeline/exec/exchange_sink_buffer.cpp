@@ -154,6 +154,7 @@ Status ExchangeSinkBuffer::add_block(TransmitInfo&& request) {
             _instance_to_sending_by_pipeline[ins_id.lo] = false;
         }
         _instance_to_package_queue[ins_id.lo].emplace(std::move(request));
+        _peak_queued_blocks->set(_instance_to_package_queue[ins_id.lo].size());
     }
     if (send_now) {
         RETURN_IF_ERROR(_send_rpc(ins_id.lo));
@@ -177,6 +178,7 @@ Status ExchangeSinkBuffer::add_block(BroadcastTransmitInfo&& request) {
             _instance_to_sending_by_pipeline[ins_id.lo] = false;
         }
         _instance_to_broadcast_package_queue[ins_id.lo].emplace(std::move(request));
+        _peak_queued_blocks->set(_instance_to_broadcast_package_queue[ins_id.lo].size());
     }
     if (send_now) {
         RETURN_IF_ERROR(_send_rpc(ins_id.lo));
@@ -197,6 +199,10 @@ Status ExchangeSinkBuffer::_send_rpc(InstanceLoId id) {
         return Status::OK();
     }
 
+    if (_can_coalesce(id)) {
+        return _send_coalesced_rpc(id);
+    }
+
     if (!q.empty()) {
         // If we have data to shuffle which is not broadcasted
         auto& request = q.front();
@@ -232,12 +238,24 @@ Status ExchangeSinkBuffer::_send_rpc(InstanceLoId id) {
                                                     *brpc_request,
                                                     request.channel->_brpc_dest_addr));
             } else {
+                if (request.block && config::exchange_transfer_block_by_attachment_ref &&
+                    !request.block->column_values().empty()) {
+                    // request.block is destroyed after the rpc is sent, so column_values is
+                    // moved out to be owned by the attachment.
+                    auto* column_values = new std::string();
+                    column_values->swap(*request.block->mutable_column_values());
+                    request_block_transfer_attachment_by_ref(
+                            brpc_request, *column_values,
+                            [column_values]() { delete column_values; }, _closure);
+                }
                 transmit_block(*request.channel->_brpc_stub, _closure, *brpc_request);
             }
         }
         if (request.block) {
             brpc_request->release_block();
         }
+        brpc_request->clear_transfer_by_attachment();
+        COUNTER_UPDATE(_rpc_count, 1);
         q.pop();
     } else if (!broadcast_q.empty()) {
         // If we have data to shuffle which is broadcasted
@@ -248,7 +266,15 @@ Status ExchangeSinkBuffer::_send_rpc(InstanceLoId id) {
         auto brpc_request = _instance_to_request[id];
         brpc_request->set_eos(request.eos);
         brpc_request->set_packet_seq(_instance_to_seq[id]++);
-        if (request.block_holder->get_block()) {
+        // The block is shared by all the channels, if its column_values is detached, only the
+        // other fields are copied into the request, and column_values is referenced by the
+        // attachment.
+        PBlock block_meta;
+        auto column_values = request.block_holder->column_values();
+        if (column_values) {
+            copy_block_without_column_values(*request.block_holder->get_block(), &block_meta);
+            brpc_request->set_allocated_block(&block_meta);
+        } else if (request.block_holder->get_block()) {
             brpc_request->set_allocated_block(request.block_holder->get_block());
         }
         auto* _closure =
@@ -270,17 +296,29 @@ Status ExchangeSinkBuffer::_send_rpc(InstanceLoId id) {
         });
         {
             SCOPED_SWITCH_THREAD_MEM_TRACKER_LIMITER(ExecEnv::GetInstance()->orphan_mem_tracker());
+            if (column_values && config::transfer_large_data_by_brpc &&
+                column_values->size() + brpc_request->ByteSizeLong() >= MIN_HTTP_BRPC_SIZE) {
+                // the http brpc embeds column_values into the attachment by itself
+                block_meta.set_column_values(*column_values);
+            }
             if (enable_http_send_block(*brpc_request)) {
                 RETURN_IF_ERROR(transmit_block_http(_context->get_runtime_state(), _closure,
                                                     *brpc_request,
                                                     request.channel->_brpc_dest_addr));
             } else {
+                if (column_values && !column_values->empty()) {
+                    // the lambda keeps column_values alive until the attachment is released
+                    request_block_transfer_attachment_by_ref(
+                            brpc_request, *column_values, [column_values]() {}, _closure);
+                }
                 transmit_block(*request.channel->_brpc_stub, _closure, *brpc_request);
             }
         }
-        if (request.block_holder->get_block()) {
+        if (column_values || request.block_holder->get_block()) {
             brpc_request->release_block();
         }
+        brpc_request->clear_transfer_by_attachment();
+        COUNTER_UPDATE(_rpc_count, 1);
         broadcast_q.pop();
     } else {
         _instance_to_sending_by_pipeline[id] = true;
@@ -290,6 +328,81 @@ Status ExchangeSinkBuffer::_send_rpc(InstanceLoId id) {
     return Status::OK();
 }
 
+bool ExchangeSinkBuffer::_can_coalesce(InstanceLoId id) {
+    auto& q = _instance_to_package_queue[id];
+    // Only the blocks queued while the last rpc is in flight are coalesced, so coalescing adds
+    // no latency. A receiver before be_exec_version 3 does not know PTransmitDataParams.blocks.
+    return config::exchange_sink_max_coalesce_bytes > 0 && q.size() > 1 && q.front().block &&
+           !q.front().eos && _context->get_runtime_state()->be_exec_version() >= 3 &&
+           q.front().block->ByteSizeLong() < config::exchange_sink_max_coalesce_bytes;
+}
+
+Status ExchangeSinkBuffer::_send_coalesced_rpc(InstanceLoId id) {
+    auto& q = _instance_to_package_queue[id];
+    auto* channel = q.front().channel;
+    std::vector<std::unique_ptr<PBlock>> blocks;
+    int64_t bytes = 0;
+    bool eos = false;
+    while (!q.empty() && !eos) {
+        auto& request = q.front();
+        int64_t block_bytes = request.block ? request.block->ByteSizeLong() : 0;
+        if (!blocks.empty() && bytes + block_bytes > config::exchange_sink_max_coalesce_bytes) {
+            break;
+        }
+        bytes += block_bytes;
+        eos = request.eos;
+        if (request.block) {
+            blocks.emplace_back(std::move(request.block));
+        }
+        q.pop();
+    }
+
+    if (!_instance_to_request[id]) {
+        _construct_request(id);
+    }
+    auto brpc_request = _instance_to_request[id];
+    brpc_request->set_eos(eos);
+    brpc_request->set_packet_seq(_instance_to_seq[id]);
+    _instance_to_seq[id] += blocks.size();
+    for (auto& block : blocks) {
+        brpc_request->mutable_blocks()->AddAllocated(block.get());
+    }
+    auto* _closure = new SelfDeleteClosure<PTransmitDataResult>(id, eos, nullptr);
+    _closure->cntl.set_timeout_ms(channel->_brpc_timeout_ms);
+    _closure->addFailedHandler(
+            [&](const InstanceLoId& id, const std::string& err) { _failed(id, err); });
+    _closure->addSuccessHandler([&](const InstanceLoId& id, const bool& eos,
+                                    const PTransmitDataResult& result) {
+        Status s = Status(result.status());
+        if (!s.ok()) {
+            _failed(id, fmt::format("exchange req success but status isn't ok: {}", s.to_string()));
+        } else if (eos) {
+            _ended(id);
+        } else {
+            _send_rpc(id);
+        }
+    });
+    {
+        SCOPED_SWITCH_THREAD_MEM_TRACKER_LIMITER(ExecEnv::GetInstance()->orphan_mem_tracker());
+        transmit_block(*channel->_brpc_stub, _closure, *brpc_request);
+    }
+    // the request is serialized in transmit_block, and the blocks are still owned by blocks
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        brpc_request->mutable_blocks()->ReleaseLast();
+    }
+    COUNTER_UPDATE(_rpc_count, 1);
+    COUNTER_UPDATE(_coalesced_blocks, blocks.size());
+    _peak_blocks_per_rpc->set(blocks.size());
+    return Status::OK();
+}
+
+void ExchangeSinkBuffer::init_profile(RuntimeProfile* profile) {
+    _rpc_count = ADD_COUNTER(profile, "RpcCount", TUnit::UNIT);
+    _coalesced_blocks = ADD_COUNTER(profile, "CoalescedBlocks", TUnit::UNIT);
+    _peak_blocks_per_rpc = profile->AddHighWaterMarkCounter("PeakBlocksPerRpc", TUnit::UNIT);
+    _peak_queued_blocks = profile->AddHighWaterMarkCounter("PeakQueuedBlocks", TUnit::UNIT);
+}
+
 void ExchangeSinkBuffer::_construct_request(InstanceLoId id) {
     _instance_to_request[id] = new PTransmitDataParams();
     _instance_to_request[id]->set_allocated_finst_id(&_instance_to_finst_id[id]);
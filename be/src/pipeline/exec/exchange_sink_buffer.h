@@ -22,11 +22,13 @@
 #include <list>
 #include <queue>
 #include <shared_mutex>
+#include <vector>
 
 #include "common/global_types.h"
 #include "common/status.h"
 #include "gen_cpp/Types_types.h"
 #include "gen_cpp/internal_service.pb.h"
+#include "util/runtime_profile.h"
 
 namespace doris {
 namespace vectorized {
@@ -56,6 +58,7 @@ public:
     ExchangeSinkBuffer(PUniqueId, int, PlanNodeId, int, PipelineFragmentContext*);
     ~ExchangeSinkBuffer();
     void register_sink(TUniqueId);
+    void init_profile(RuntimeProfile* profile);
     Status add_block(TransmitInfo&& request);
     Status add_block(BroadcastTransmitInfo&& request);
     bool can_write() const;
@@ -88,7 +91,17 @@ private:
 
     PipelineFragmentContext* _context;
 
+    RuntimeProfile::Counter* _rpc_count = nullptr;
+    RuntimeProfile::Counter* _coalesced_blocks = nullptr;
+    RuntimeProfile::HighWaterMarkCounter* _peak_blocks_per_rpc = nullptr;
+    // peak number of blocks queued for one destination, i.e. the send window
+    RuntimeProfile::HighWaterMarkCounter* _peak_queued_blocks = nullptr;
+
     Status _send_rpc(InstanceLoId);
+    // must hold the _instance_to_package_queue_mutex[id] mutex
+    bool _can_coalesce(InstanceLoId id);
+    // must hold the _instance_to_package_queue_mutex[id] mutex
+    Status _send_coalesced_rpc(InstanceLoId id);
     // must hold the _instance_to_package_queue_mutex[id] mutex to opera
     void _construct_request(InstanceLoId id);
     inline void _ended(InstanceLoId id);
@@ -53,6 +53,7 @@ Status ExchangeSinkOperator::prepare(RuntimeState* state) {
                                                         _state->be_number(), _context);
 
     RETURN_IF_ERROR(DataSinkOperator::prepare(state));
+    _sink_buffer->init_profile(_sink->profile());
     _sink->registe_channels(_sink_buffer.get());
     return Status::OK();
 }
@@ -29,6 +29,10 @@ bool ExchangeSourceOperator::can_read() {
     return _node->_stream_recvr->ready_to_read();
 }
 
+Dependency* ExchangeSourceOperator::read_dependency() {
+    return _node->_stream_recvr->read_dependency();
+}
+
 bool ExchangeSourceOperator::is_pending_finish() const {
     // TODO HappenLee
     return false;
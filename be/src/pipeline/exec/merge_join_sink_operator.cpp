@@ -0,0 +1,66 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "merge_join_sink_operator.h"
+
+#include "common/status.h"
+#include "vec/exec/join/vmerge_join_node.h"
+
+namespace doris::pipeline {
+
+MergeJoinSinkOperatorBuilder::MergeJoinSinkOperatorBuilder(int32_t id, int child_id,
+                                                           ExecNode* node,
+                                                           std::shared_ptr<DataQueue> queue)
+        : OperatorBuilder(id, "MergeJoinSinkOperator", node),
+          _child_id(child_id),
+          _data_queue(queue) {}
+
+OperatorPtr MergeJoinSinkOperatorBuilder::build_operator() {
+    return std::make_shared<MergeJoinSinkOperator>(this, _child_id, _node, _data_queue);
+}
+
+MergeJoinSinkOperator::MergeJoinSinkOperator(OperatorBuilderBase* operator_builder, int child_id,
+                                             ExecNode* node, std::shared_ptr<DataQueue> queue)
+        : StreamingOperator(operator_builder, node), _child_id(child_id), _data_queue(queue) {}
+
+bool MergeJoinSinkOperator::can_write() {
+    return _node->merge_finished() || _data_queue->has_enough_space_to_push(_child_id);
+}
+
+Status MergeJoinSinkOperator::sink(RuntimeState* state, vectorized::Block* in_block,
+                                   SourceState source_state) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    if (!_node->merge_finished() && in_block->rows() > 0) {
+        auto block = _data_queue->get_free_block(_child_id);
+        block->swap(*in_block);
+        _data_queue->push_block(std::move(block), _child_id);
+    }
+    if (source_state == SourceState::FINISHED) {
+        _data_queue->set_finish(_child_id);
+    }
+    return Status::OK();
+}
+
+Status MergeJoinSinkOperator::close(RuntimeState* state) {
+    if (_data_queue && !_data_queue->is_finish(_child_id)) {
+        // finish should be set, if not set here means error.
+        _data_queue->set_canceled(_child_id);
+    }
+    return StreamingOperator::close(state);
+}
+
+} // namespace doris::pipeline
@@ -0,0 +1,68 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "operator.h"
+#include "pipeline/exec/data_queue.h"
+
+namespace doris {
+namespace vectorized {
+class VMergeJoinNode;
+class Block;
+} // namespace vectorized
+
+namespace pipeline {
+
+// Queues the blocks of an input of a merge join for MergeJoinSourceOperator, so both inputs are
+// read along with the merge, and drops them once the merge is done.
+class MergeJoinSinkOperatorBuilder final : public OperatorBuilder<vectorized::VMergeJoinNode> {
+public:
+    MergeJoinSinkOperatorBuilder(int32_t id, int child_id, ExecNode* node,
+                                 std::shared_ptr<DataQueue> queue);
+
+    OperatorPtr build_operator() override;
+
+    bool is_sink() const override { return true; }
+
+private:
+    int _child_id;
+    std::shared_ptr<DataQueue> _data_queue;
+};
+
+class MergeJoinSinkOperator final : public StreamingOperator<MergeJoinSinkOperatorBuilder> {
+public:
+    MergeJoinSinkOperator(OperatorBuilderBase* operator_builder, int child_id, ExecNode* node,
+                          std::shared_ptr<DataQueue> queue);
+
+    bool can_write() override;
+
+    Status sink(RuntimeState* state, vectorized::Block* in_block,
+                SourceState source_state) override;
+
+    // the node is opened by the source
+    Status open(RuntimeState* /*state*/) override { return Status::OK(); }
+
+    Status close(RuntimeState* state) override;
+
+private:
+    int _child_id;
+    std::shared_ptr<DataQueue> _data_queue;
+};
+
+} // namespace pipeline
+} // namespace doris
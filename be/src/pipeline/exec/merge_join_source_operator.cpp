@@ -0,0 +1,82 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "merge_join_source_operator.h"
+
+#include "common/status.h"
+#include "vec/exec/join/vmerge_join_node.h"
+
+namespace doris::pipeline {
+
+using vectorized::VMergeJoinNode;
+
+MergeJoinSourceOperatorBuilder::MergeJoinSourceOperatorBuilder(int32_t id, ExecNode* node,
+                                                               std::shared_ptr<DataQueue> queue)
+        : OperatorBuilder(id, "MergeJoinSourceOperator", node), _data_queue(queue) {}
+
+OperatorPtr MergeJoinSourceOperatorBuilder::build_operator() {
+    return std::make_shared<MergeJoinSourceOperator>(this, _node, _data_queue);
+}
+
+MergeJoinSourceOperator::MergeJoinSourceOperator(OperatorBuilderBase* operator_builder,
+                                                 ExecNode* node,
+                                                 std::shared_ptr<DataQueue> queue)
+        : SourceOperator(operator_builder, node), _data_queue(queue) {}
+
+bool MergeJoinSourceOperator::can_read() {
+    for (int side : {VMergeJoinNode::PROBE_SIDE, VMergeJoinNode::BUILD_SIDE}) {
+        if (_node->need_more_input_data(side) && !_data_queue->has_data_of_child(side) &&
+            !_data_queue->is_finish(side)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Status MergeJoinSourceOperator::get_block(RuntimeState* state, vectorized::Block* block,
+                                          SourceState& source_state) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    source_state = SourceState::DEPEND_ON_SOURCE;
+    for (int side : {VMergeJoinNode::PROBE_SIDE, VMergeJoinNode::BUILD_SIDE}) {
+        if (!_node->need_more_input_data(side)) {
+            continue;
+        }
+        // the queue is finished after its last block is pushed
+        bool finished = _data_queue->is_finish(side);
+        std::unique_ptr<vectorized::Block> input_block;
+        RETURN_IF_ERROR(_data_queue->get_block_from_queue_of_child(side, &input_block));
+        if (input_block) {
+            RETURN_IF_ERROR(_node->push(state, side, input_block.get(), false));
+            _data_queue->push_free_block(std::move(input_block), side);
+        } else if (finished) {
+            vectorized::Block empty_block;
+            RETURN_IF_ERROR(_node->push(state, side, &empty_block, true));
+        } else {
+            return Status::OK();
+        }
+    }
+
+    bool eos = false;
+    RETURN_IF_ERROR(_node->get_next_after_projects(
+            state, block, &eos,
+            std::bind(&ExecNode::pull, _node, std::placeholders::_1, std::placeholders::_2,
+                      std::placeholders::_3)));
+    source_state = eos ? SourceState::FINISHED : SourceState::DEPEND_ON_SOURCE;
+    return Status::OK();
+}
+
+} // namespace doris::pipeline
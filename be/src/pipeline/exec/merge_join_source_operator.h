@@ -0,0 +1,59 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "operator.h"
+#include "pipeline/exec/data_queue.h"
+
+namespace doris {
+namespace vectorized {
+class VMergeJoinNode;
+}
+
+namespace pipeline {
+
+// Merges the blocks of both inputs of a merge join queued by MergeJoinSinkOperator, and waits for
+// the input the merge needs next.
+class MergeJoinSourceOperatorBuilder final : public OperatorBuilder<vectorized::VMergeJoinNode> {
+public:
+    MergeJoinSourceOperatorBuilder(int32_t id, ExecNode* node, std::shared_ptr<DataQueue> queue);
+
+    bool is_source() const override { return true; }
+
+    OperatorPtr build_operator() override;
+
+private:
+    std::shared_ptr<DataQueue> _data_queue;
+};
+
+class MergeJoinSourceOperator final : public SourceOperator<MergeJoinSourceOperatorBuilder> {
+public:
+    MergeJoinSourceOperator(OperatorBuilderBase* operator_builder, ExecNode* node,
+                            std::shared_ptr<DataQueue> queue);
+
+    bool can_read() override;
+
+    Status get_block(RuntimeState* state, vectorized::Block* block,
+                     SourceState& source_state) override;
+
+private:
+    std::shared_ptr<DataQueue> _data_queue;
+};
+
+} // namespace pipeline
+} // namespace doris
@@ -22,6 +22,7 @@
 #include "common/status.h"
 #include "exec/data_sink.h"
 #include "exec/exec_node.h"
+#include "pipeline/dependency.h"
 #include "runtime/runtime_state.h"
 #include "vec/core/block.h"
 #include "vec/exec/vdata_gen_scan_node.h"
@@ -180,6 +181,11 @@ public:
 
     virtual bool runtime_filters_are_ready_or_timeout() { return true; } // for source
 
+    // The dependencies to wait on when the source can not read or the runtime filters
+    // are not ready. nullptr means BlockedTaskScheduler should poll the state.
+    virtual Dependency* read_dependency() { return nullptr; }           // for source
+    virtual Dependency* runtime_filter_dependency() { return nullptr; } // for source
+
     virtual bool can_write() { return false; } // for sink
 
     /**
@@ -441,7 +447,8 @@ public:
                 return Status::OK();
             }
             node->prepare_for_next();
-            node->push(state, _child_block.get(), _child_source_state == SourceState::FINISHED);
+            RETURN_IF_ERROR(node->push(state, _child_block.get(),
+                                       _child_source_state == SourceState::FINISHED));
         }
 
         if (!node->need_more_input_data()) {
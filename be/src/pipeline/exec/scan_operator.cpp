@@ -58,6 +58,19 @@ bool ScanOperator::runtime_filters_are_ready_or_timeout() {
     return _node->runtime_filters_are_ready_or_timeout();
 }
 
+// Before opened, the scan node is waiting for the runtime filters or the scanners
+// to be created, which is polled.
+Dependency* ScanOperator::read_dependency() {
+    if (_node->_opened && _node->_scanner_ctx) {
+        return _node->_scanner_ctx->read_dependency();
+    }
+    return nullptr;
+}
+
+Dependency* ScanOperator::runtime_filter_dependency() {
+    return _node->runtime_filter_dependency();
+}
+
 std::string ScanOperator::debug_string() const {
     fmt::memory_buffer debug_string_buffer;
     fmt::format_to(debug_string_buffer, "{}, scanner_ctx is null: {} ",
@@ -44,6 +44,10 @@ public:
 
     bool runtime_filters_are_ready_or_timeout() override;
 
+    Dependency* read_dependency() override;
+
+    Dependency* runtime_filter_dependency() override;
+
     std::string debug_string() const override;
 
     Status try_close() override;
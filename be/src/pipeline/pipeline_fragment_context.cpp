@@ -38,6 +38,8 @@
 #include "pipeline/exec/exchange_source_operator.h"
 #include "pipeline/exec/hashjoin_build_sink.h"
 #include "pipeline/exec/hashjoin_probe_operator.h"
+#include "pipeline/exec/merge_join_sink_operator.h"
+#include "pipeline/exec/merge_join_source_operator.h"
 #include "pipeline/exec/mysql_scan_operator.h"
 #include "pipeline/exec/nested_loop_join_build_operator.h"
 #include "pipeline/exec/nested_loop_join_probe_operator.h"
@@ -63,12 +65,14 @@
 #include "pipeline_task.h"
 #include "runtime/client_cache.h"
 #include "runtime/fragment_mgr.h"
+#include "runtime/query_statistics.h"
 #include "runtime/runtime_state.h"
 #include "runtime/stream_load/new_load_stream_mgr.h"
 #include "runtime/stream_load/stream_load_context.h"
 #include "task_scheduler.h"
 #include "util/container_util.hpp"
 #include "vec/exec/join/vhash_join_node.h"
+#include "vec/exec/join/vmerge_join_node.h"
 #include "vec/exec/join/vnested_loop_join_node.h"
 #include "vec/exec/scan/new_file_scan_node.h"
 #include "vec/exec/scan/new_olap_scan_node.h"
@@ -710,6 +714,21 @@ Status PipelineFragmentContext::_build_pipelines(ExecNode* node, PipelinePtr cur
         cur_pipe->add_dependency(new_pipe);
         break;
     }
+    case TPlanNodeType::MERGE_JOIN_NODE: {
+        // both inputs are read along with the merge, like the children of a union
+        auto data_queue = std::make_shared<DataQueue>(2);
+        for (int child_id = 0; child_id < 2; ++child_id) {
+            auto new_child_pipeline = add_pipeline();
+            RETURN_IF_ERROR(_build_pipelines(node->child(child_id), new_child_pipeline));
+            OperatorBuilderPtr child_sink_builder = std::make_shared<MergeJoinSinkOperatorBuilder>(
+                    next_operator_builder_id(), child_id, node, data_queue);
+            RETURN_IF_ERROR(new_child_pipeline->set_sink(child_sink_builder));
+        }
+        OperatorBuilderPtr source_builder = std::make_shared<MergeJoinSourceOperatorBuilder>(
+                next_operator_builder_id(), node, data_queue);
+        RETURN_IF_ERROR(cur_pipe->add_operator(source_builder));
+        break;
+    }
     case TPlanNodeType::CROSS_JOIN_NODE: {
         auto new_pipe = add_pipeline();
         RETURN_IF_ERROR(_build_pipelines(node->child(1), new_pipe));
@@ -885,6 +904,12 @@ void PipelineFragmentContext::send_report(bool done) {
         return;
     }
 
+    if (_is_report_success) {
+        QueryIOStatistics io_statistics;
+        io_statistics.add(*_runtime_state->io_statistics());
+        io_statistics.update_profile(_runtime_state->runtime_profile());
+    }
+
     _report_status_cb(
             {exec_status, _is_report_success ? _runtime_state->runtime_profile() : nullptr,
              done || !exec_status.ok(), _query_ctx->coord_addr, _query_id, _fragment_id,
@@ -19,6 +19,8 @@
 
 #include "pipeline_fragment_context.h"
 #include "task_queue.h"
+#include "util/doris_metrics.h"
+#include "util/time.h"
 
 namespace doris::pipeline {
 
@@ -42,14 +44,21 @@ void PipelineTask::_init_profile() {
 
     _wait_source_timer = ADD_TIMER(_task_profile, "WaitSourceTime");
     _wait_sink_timer = ADD_TIMER(_task_profile, "WaitSinkTime");
+    _wait_rf_timer = ADD_TIMER(_task_profile, "WaitRuntimeFilterTime");
+    _wait_dependency_timer = ADD_TIMER(_task_profile, "WaitDependencyTime");
     _wait_worker_timer = ADD_TIMER(_task_profile, "WaitWorkerTime");
     _wait_schedule_timer = ADD_TIMER(_task_profile, "WaitScheduleTime");
     _block_counts = ADD_COUNTER(_task_profile, "NumBlockedTimes", TUnit::UNIT);
     _block_by_source_counts = ADD_COUNTER(_task_profile, "NumBlockedBySrcTimes", TUnit::UNIT);
     _block_by_sink_counts = ADD_COUNTER(_task_profile, "NumBlockedBySinkTimes", TUnit::UNIT);
+    _block_by_rf_counts = ADD_COUNTER(_task_profile, "NumBlockedByRFTimes", TUnit::UNIT);
+    _block_by_dependency_counts =
+            ADD_COUNTER(_task_profile, "NumBlockedByDependencyTimes", TUnit::UNIT);
     _schedule_counts = ADD_COUNTER(_task_profile, "NumScheduleTimes", TUnit::UNIT);
     _yield_counts = ADD_COUNTER(_task_profile, "NumYieldTimes", TUnit::UNIT);
     _core_change_times = ADD_COUNTER(_task_profile, "CoreChangeTimes", TUnit::UNIT);
+    _steal_counts = ADD_COUNTER(_task_profile, "NumStealTimes", TUnit::UNIT);
+    _cross_numa_steal_counts = ADD_COUNTER(_task_profile, "NumCrossNumaStealTimes", TUnit::UNIT);
 }
 
 Status PipelineTask::prepare(RuntimeState* state) {
@@ -78,6 +87,24 @@ Status PipelineTask::prepare(RuntimeState* state) {
     fmt::format_to(operator_ids_str, "]");
     _task_profile->add_info_string("OperatorIds(source2root)", fmt::to_string(operator_ids_str));
 
+    // the profiles of the operators are created in prepare()
+    if (auto* profile = _source->runtime_profile()) {
+        _source_blocked_timer = ADD_TIMER(profile, "BlockedTime");
+        _source_wait_rf_timer = ADD_TIMER(profile, "WaitRuntimeFilterTime");
+    }
+    if (auto* profile = _sink->runtime_profile()) {
+        _sink_blocked_timer = ADD_TIMER(profile, "BlockedTime");
+    }
+    if (state->enable_hardware_counters()) {
+        _task_hw_counters = std::make_unique<HardwareCounterProfile>(_task_profile.get());
+        if (auto* profile = _root->runtime_profile()) {
+            _get_block_hw_counters = std::make_unique<HardwareCounterProfile>(profile);
+        }
+        if (auto* profile = _sink->runtime_profile()) {
+            _sink_hw_counters = std::make_unique<HardwareCounterProfile>(profile);
+        }
+    }
+
     _block.reset(new doris::vectorized::Block());
 
     // We should make sure initial state for task are runnable so that we can do some preparation jobs (e.g. initialize runtime filters).
@@ -131,10 +158,28 @@ Status PipelineTask::execute(bool* eos) {
     SCOPED_TIMER(_exec_timer);
     SCOPED_ATTACH_TASK(_state);
     int64_t time_spent = 0;
+    ThreadPerfCounters* hw_counters = _task_hw_counters ? ThreadPerfCounters::current() : nullptr;
+    ThreadPerfCounters::Values hw_start {}, hw_last {}, hw_now {};
+    if (hw_counters != nullptr && !hw_counters->read(&hw_start)) {
+        hw_counters = nullptr;
+    }
+    hw_last = hw_start;
+    // counts the events since the last read into the profile
+    auto update_hw_counters = [&](HardwareCounterProfile* profile) {
+        if (hw_counters != nullptr && hw_counters->read(&hw_now)) {
+            if (profile != nullptr) {
+                profile->update(hw_last, hw_now);
+            }
+            hw_last = hw_now;
+        }
+    };
     Defer defer {[&]() {
         if (_task_queue) {
             _task_queue->update_statistics(this, time_spent);
         }
+        if (hw_counters != nullptr && hw_counters->read(&hw_now)) {
+            _task_hw_counters->update(hw_start, hw_now);
+        }
     }};
     // The status must be runnable
     *eos = false;
@@ -165,6 +210,7 @@ Status PipelineTask::execute(bool* eos) {
         }
     }
 
+    update_hw_counters(nullptr);
     while (!_fragment_context->is_canceled()) {
         if (_data_state != SourceState::MORE_DATA && !_source->can_read()) {
             set_state(PipelineTaskState::BLOCKED_FOR_SOURCE);
@@ -187,10 +233,12 @@ Status PipelineTask::execute(bool* eos) {
             SCOPED_TIMER(_get_block_timer);
             RETURN_IF_ERROR(_root->get_block(_state, block, _data_state));
         }
+        update_hw_counters(_get_block_hw_counters.get());
         *eos = _data_state == SourceState::FINISHED;
         if (_block->rows() != 0 || *eos) {
             SCOPED_TIMER(_sink_timer);
             RETURN_IF_ERROR(_sink->sink(_state, block, _data_state));
+            update_hw_counters(_sink_hw_counters.get());
             if (*eos) { // just return, the scheduler will do finish work
                 break;
             }
@@ -235,9 +283,7 @@ Status PipelineTask::close() {
         }
     }
     if (_opened) {
-        COUNTER_UPDATE(_wait_source_timer, _wait_source_watcher.elapsed_time());
         COUNTER_UPDATE(_schedule_counts, _schedule_time);
-        COUNTER_UPDATE(_wait_sink_timer, _wait_sink_watcher.elapsed_time());
         COUNTER_UPDATE(_wait_worker_timer, _wait_worker_watcher.elapsed_time());
         COUNTER_UPDATE(_wait_schedule_timer, _wait_schedule_watcher.elapsed_time());
         COUNTER_UPDATE(_close_timer, close_ns);
@@ -255,27 +301,60 @@ void PipelineTask::set_state(PipelineTaskState state) {
     if (_cur_state == state) {
         return;
     }
-    if (_cur_state == PipelineTaskState::BLOCKED_FOR_SOURCE) {
-        if (state == PipelineTaskState::RUNNABLE) {
-            _wait_source_watcher.stop();
-        }
-    } else if (_cur_state == PipelineTaskState::BLOCKED_FOR_SINK) {
-        if (state == PipelineTaskState::RUNNABLE) {
-            _wait_sink_watcher.stop();
-        }
+    if (_cur_state == PipelineTaskState::BLOCKED_FOR_SOURCE ||
+        _cur_state == PipelineTaskState::BLOCKED_FOR_SINK ||
+        _cur_state == PipelineTaskState::BLOCKED_FOR_RF ||
+        _cur_state == PipelineTaskState::BLOCKED_FOR_DEPENDENCY) {
+        _update_blocked_time(_cur_state, MonotonicNanos() - _blocked_start_ns);
     } else if (_cur_state == PipelineTaskState::RUNNABLE) {
         COUNTER_UPDATE(_block_counts, 1);
         if (state == PipelineTaskState::BLOCKED_FOR_SOURCE) {
-            _wait_source_watcher.start();
             COUNTER_UPDATE(_block_by_source_counts, 1);
         } else if (state == PipelineTaskState::BLOCKED_FOR_SINK) {
-            _wait_sink_watcher.start();
             COUNTER_UPDATE(_block_by_sink_counts, 1);
+        } else if (state == PipelineTaskState::BLOCKED_FOR_RF) {
+            COUNTER_UPDATE(_block_by_rf_counts, 1);
+        } else if (state == PipelineTaskState::BLOCKED_FOR_DEPENDENCY) {
+            COUNTER_UPDATE(_block_by_dependency_counts, 1);
         }
     }
+    _blocked_start_ns = MonotonicNanos();
     _cur_state = state;
 }
 
+void PipelineTask::_update_blocked_time(PipelineTaskState state, int64_t blocked_ns) {
+    auto* metrics = DorisMetrics::instance();
+    switch (state) {
+    case PipelineTaskState::BLOCKED_FOR_SOURCE:
+        COUNTER_UPDATE(_wait_source_timer, blocked_ns);
+        if (_source_blocked_timer) {
+            COUNTER_UPDATE(_source_blocked_timer, blocked_ns);
+        }
+        metrics->pipeline_task_blocked_by_source_time_us->increment(blocked_ns / 1000);
+        break;
+    case PipelineTaskState::BLOCKED_FOR_SINK:
+        COUNTER_UPDATE(_wait_sink_timer, blocked_ns);
+        if (_sink_blocked_timer) {
+            COUNTER_UPDATE(_sink_blocked_timer, blocked_ns);
+        }
+        metrics->pipeline_task_blocked_by_sink_time_us->increment(blocked_ns / 1000);
+        break;
+    case PipelineTaskState::BLOCKED_FOR_RF:
+        COUNTER_UPDATE(_wait_rf_timer, blocked_ns);
+        if (_source_wait_rf_timer) {
+            COUNTER_UPDATE(_source_wait_rf_timer, blocked_ns);
+        }
+        metrics->pipeline_task_blocked_by_runtime_filter_time_us->increment(blocked_ns / 1000);
+        break;
+    case PipelineTaskState::BLOCKED_FOR_DEPENDENCY:
+        COUNTER_UPDATE(_wait_dependency_timer, blocked_ns);
+        metrics->pipeline_task_blocked_by_dependency_time_us->increment(blocked_ns / 1000);
+        break;
+    default:
+        break;
+    }
+}
+
 std::string PipelineTask::debug_string() const {
     fmt::memory_buffer debug_string_buffer;
     fmt::format_to(debug_string_buffer, "PipelineTask[id = {}, state = {}]\noperators: ", _index,
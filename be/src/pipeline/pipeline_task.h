@@ -19,6 +19,7 @@
 
 #include "exec/operator.h"
 #include "pipeline.h"
+#include "util/perf_counters.h"
 #include "util/stopwatch.hpp"
 
 namespace doris::pipeline {
@@ -123,7 +124,12 @@ public:
         _schedule_time++;
         _wait_worker_watcher.start();
     }
-    void pop_out_runnable_queue() { _wait_worker_watcher.stop(); }
+    // Returns the time the task waited in the runnable queue this time.
+    uint64_t pop_out_runnable_queue() {
+        auto wait_ns = _wait_worker_watcher.elapsed_time();
+        _wait_worker_watcher.stop();
+        return wait_ns;
+    }
     void start_schedule_watcher() { _wait_schedule_watcher.start(); }
     void stop_schedule_watcher() { _wait_schedule_watcher.stop(); }
 
@@ -135,6 +141,8 @@ public:
     bool is_pending_finish() { return _source->is_pending_finish() || _sink->is_pending_finish(); }
 
     bool source_can_read() { return _source->can_read(); }
+    Dependency* read_dependency() { return _source->read_dependency(); }
+    Dependency* runtime_filter_dependency() { return _source->runtime_filter_dependency(); }
 
     bool runtime_filters_are_ready_or_timeout() {
         return _source->runtime_filters_are_ready_or_timeout();
@@ -171,6 +179,14 @@ public:
         _previous_schedule_id = id;
     }
 
+    // `cross_numa_node` is true if the task is stolen by a worker of another NUMA node.
+    void update_steal_counter(bool cross_numa_node) {
+        COUNTER_UPDATE(_steal_counts, 1);
+        if (cross_numa_node) {
+            COUNTER_UPDATE(_cross_numa_steal_counts, 1);
+        }
+    }
+
     bool has_dependency();
 
     uint32_t index() const { return _index; }
@@ -181,6 +197,15 @@ public:
 
     uint32_t total_schedule_time() const { return _schedule_time; }
 
+    void inc_runtime_ns(int64_t delta_time) { _runtime_ns += delta_time; }
+    int64_t get_runtime_ns() const { return _runtime_ns; }
+
+    // level and worker of the NormalTaskQueue the task is put in
+    void set_queue_level(int level) { _queue_level = level; }
+    int get_queue_level() const { return _queue_level; }
+    void set_core_id(int core_id) { _core_id = core_id; }
+    int get_core_id() const { return _core_id; }
+
     taskgroup::TaskGroup* get_task_group() const;
 
     void set_task_queue(TaskQueue* task_queue);
@@ -190,6 +215,9 @@ public:
 private:
     Status _open();
     void _init_profile();
+    // Adds the time the task is blocked in the state to the counters of the task, the operators
+    // and the metrics.
+    void _update_blocked_time(PipelineTaskState state, int64_t blocked_ns);
 
     uint32_t _index;
     PipelinePtr _pipeline;
@@ -205,6 +233,9 @@ private:
     RuntimeState* _state;
     int _previous_schedule_id = -1;
     uint32_t _schedule_time = 0;
+    int64_t _runtime_ns = 0;
+    int _queue_level = 0;
+    int _core_id = 0;
     PipelineTaskState _cur_state;
     SourceState _data_state;
     std::unique_ptr<doris::vectorized::Block> _block;
@@ -225,10 +256,18 @@ private:
     RuntimeProfile::Counter* _block_by_source_counts;
     RuntimeProfile::Counter* _block_by_sink_counts;
     RuntimeProfile::Counter* _schedule_counts;
-    MonotonicStopWatch _wait_source_watcher;
+    RuntimeProfile::Counter* _block_by_rf_counts;
+    RuntimeProfile::Counter* _block_by_dependency_counts;
+    // when the task is blocked in the current state
+    int64_t _blocked_start_ns = 0;
     RuntimeProfile::Counter* _wait_source_timer;
-    MonotonicStopWatch _wait_sink_watcher;
     RuntimeProfile::Counter* _wait_sink_timer;
+    RuntimeProfile::Counter* _wait_rf_timer;
+    RuntimeProfile::Counter* _wait_dependency_timer;
+    // the time the task is blocked on the source and the sink, in the profiles of the operators
+    RuntimeProfile::Counter* _source_blocked_timer = nullptr;
+    RuntimeProfile::Counter* _source_wait_rf_timer = nullptr;
+    RuntimeProfile::Counter* _sink_blocked_timer = nullptr;
     MonotonicStopWatch _wait_worker_watcher;
     RuntimeProfile::Counter* _wait_worker_timer;
     // TODO we should calculate the time between when really runnable and runnable
@@ -236,5 +275,13 @@ private:
     RuntimeProfile::Counter* _wait_schedule_timer;
     RuntimeProfile::Counter* _yield_counts;
     RuntimeProfile::Counter* _core_change_times;
+    RuntimeProfile::Counter* _steal_counts;
+    RuntimeProfile::Counter* _cross_numa_steal_counts;
+
+    // With enable_hardware_counters, the hardware counters of the task, which are read when it's
+    // switched onto a worker and off, and of the operator chain below the root and the sink.
+    std::unique_ptr<HardwareCounterProfile> _task_hw_counters;
+    std::unique_ptr<HardwareCounterProfile> _get_block_hw_counters;
+    std::unique_ptr<HardwareCounterProfile> _sink_hw_counters;
 };
 } // namespace doris::pipeline
\ No newline at end of file
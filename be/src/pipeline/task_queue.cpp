@@ -17,23 +17,63 @@
 
 #include "task_queue.h"
 
+#include <pthread.h>
+#include <sched.h>
+
+#include "common/config.h"
 #include "runtime/task_group/task_group.h"
+#include "util/cpu_info.h"
+#include "util/doris_metrics.h"
 
 namespace doris {
+
+DEFINE_HISTOGRAM_METRIC_PROTOTYPE_2ARG(pipeline_task_wait_time_us, MetricUnit::MICROSECONDS);
+DEFINE_HISTOGRAM_METRIC_PROTOTYPE_2ARG(pipeline_task_run_time_us, MetricUnit::MICROSECONDS);
+
 namespace pipeline {
 
 TaskQueue::~TaskQueue() = default;
 
 PipelineTask* SubWorkTaskQueue::try_take(bool is_steal) {
-    if (_queue.empty()) {
+    if (_size == 0) {
         return nullptr;
     }
-    auto task = _queue.front();
+    PipelineTask* task = nullptr;
+    if ((_take_times++ & 1) == 0) {
+        task = _try_take_remote(is_steal);
+        if (!task) {
+            task = _local_queue.steal();
+        }
+    } else {
+        task = _local_queue.steal();
+        if (!task) {
+            task = _try_take_remote(is_steal);
+        }
+    }
+    if (task) {
+        --_size;
+    }
+    return task;
+}
+
+PipelineTask* SubWorkTaskQueue::_try_take_remote(bool is_steal) {
+    // the thieves do not wait for the lock
+    std::unique_lock<std::mutex> lock(_remote_queue_mutex, std::defer_lock);
+    if (is_steal) {
+        if (!lock.try_lock()) {
+            return nullptr;
+        }
+    } else {
+        lock.lock();
+    }
+    if (_remote_queue.empty()) {
+        return nullptr;
+    }
+    auto task = _remote_queue.front();
     if (!task->can_steal() && is_steal) {
         return nullptr;
     }
-    ++_schedule_time;
-    _queue.pop();
+    _remote_queue.pop();
     return task;
 }
 
@@ -45,12 +85,6 @@ NormalWorkTaskQueue::NormalWorkTaskQueue() : _closed(false) {
         _sub_queues[i].set_factor_for_normal(factor);
         factor *= LEVEL_QUEUE_TIME_FACTOR;
     }
-
-    int i = 0;
-    _task_schedule_limit[i] = BASE_LIMIT * (i + 1);
-    for (i = 1; i < SUB_QUEUE_LEVEL - 1; ++i) {
-        _task_schedule_limit[i] = _task_schedule_limit[i - 1] + BASE_LIMIT * (i + 1);
-    }
 }
 
 void NormalWorkTaskQueue::close() {
@@ -59,7 +93,7 @@ void NormalWorkTaskQueue::close() {
     _wait_task.notify_all();
 }
 
-PipelineTask* NormalWorkTaskQueue::try_take_unprotected(bool is_steal) {
+PipelineTask* NormalWorkTaskQueue::try_take(bool is_steal) {
     if (_total_task_size == 0 || _closed) {
         return nullptr;
     }
@@ -75,7 +109,10 @@ PipelineTask* NormalWorkTaskQueue::try_take_unprotected(bool is_steal) {
             }
         }
     }
-    DCHECK(idx != -1);
+    // all the tasks may be taken by the other threads
+    if (idx == -1) {
+        return nullptr;
+    }
     // update empty queue's schedule time, to avoid too high priority
     for (int i = 0; i < SUB_QUEUE_LEVEL; ++i) {
         if (_sub_queues[i].empty() && normal_schedule_times[i] < min_schedule_time) {
@@ -91,52 +128,122 @@ PipelineTask* NormalWorkTaskQueue::try_take_unprotected(bool is_steal) {
 }
 
 int NormalWorkTaskQueue::_compute_level(PipelineTask* task) {
-    uint32_t schedule_time = task->total_schedule_time();
+    auto run_time = task->get_runtime_ns();
     for (int i = 0; i < SUB_QUEUE_LEVEL - 1; ++i) {
-        if (schedule_time <= _task_schedule_limit[i]) {
+        if (run_time <= LEVEL_RUN_TIME_LIMIT_NS[i]) {
             return i;
         }
     }
     return SUB_QUEUE_LEVEL - 1;
 }
 
-PipelineTask* NormalWorkTaskQueue::try_take(bool is_steal) {
-    // TODO other efficient lock? e.g. if get lock fail, return null_ptr
-    std::unique_lock<std::mutex> lock(_work_size_mutex);
-    return try_take_unprotected(is_steal);
+void NormalWorkTaskQueue::update_statistics(PipelineTask* task, int64_t time_spent) {
+    _sub_queues[task->get_queue_level()].inc_schedule_time(time_spent);
 }
 
 PipelineTask* NormalWorkTaskQueue::take(uint32_t timeout_ms) {
-    std::unique_lock<std::mutex> lock(_work_size_mutex);
-    auto task = try_take_unprotected(false);
+    auto task = try_take(false);
     if (task) {
         return task;
-    } else {
-        if (timeout_ms > 0) {
-            _wait_task.wait_for(lock, std::chrono::milliseconds(timeout_ms));
-        } else {
-            _wait_task.wait(lock);
+    }
+    {
+        std::unique_lock<std::mutex> lock(_work_size_mutex);
+        ++_num_waiters;
+        // check again after registered as waiter, the pusher notifies only when
+        // there are waiters.
+        if (_total_task_size == 0 && !_closed) {
+            if (timeout_ms > 0) {
+                _wait_task.wait_for(lock, std::chrono::milliseconds(timeout_ms));
+            } else {
+                _wait_task.wait(lock);
+            }
         }
-        return try_take_unprotected(false);
+        --_num_waiters;
     }
+    return try_take(false);
 }
 
-Status NormalWorkTaskQueue::push(PipelineTask* task) {
+Status NormalWorkTaskQueue::push(PipelineTask* task, bool from_owner) {
     if (_closed) {
         return Status::InternalError("WorkTaskQueue closed");
     }
     auto level = _compute_level(task);
-    std::unique_lock<std::mutex> lock(_work_size_mutex);
-    _sub_queues[level].push_back(task);
+    task->set_queue_level(level);
+    if (from_owner && task->can_steal()) {
+        _sub_queues[level].push_back_local(task);
+    } else {
+        _sub_queues[level].push_back(task);
+    }
     _total_task_size++;
-    _wait_task.notify_one();
+    if (_num_waiters > 0) {
+        std::unique_lock<std::mutex> lock(_work_size_mutex);
+        _wait_task.notify_one();
+    }
     return Status::OK();
 }
 
-NormalTaskQueue::~NormalTaskQueue() = default;
+NormalTaskQueue::~NormalTaskQueue() {
+    for (auto& metrics : _level_metrics) {
+        DorisMetrics::instance()->metric_registry()->deregister_entity(metrics.entity);
+    }
+}
 
 NormalTaskQueue::NormalTaskQueue(size_t core_size) : TaskQueue(core_size), _closed(false) {
     _async_queue.reset(new NormalWorkTaskQueue[core_size]);
+    _init_numa_groups();
+    for (int i = 0; i < NormalWorkTaskQueue::SUB_QUEUE_LEVEL; ++i) {
+        auto& metrics = _level_metrics[i];
+        metrics.entity = DorisMetrics::instance()->metric_registry()->register_entity(
+                "pipeline_task_queue.level" + std::to_string(i), {{"level", std::to_string(i)}});
+        metrics.wait_time_us = (HistogramMetric*)metrics.entity->register_metric<HistogramMetric>(
+                &METRIC_pipeline_task_wait_time_us);
+        metrics.run_time_us = (HistogramMetric*)metrics.entity->register_metric<HistogramMetric>(
+                &METRIC_pipeline_task_run_time_us);
+    }
+}
+
+// Assign the workers to NUMA nodes in proportion to the cores of each node, e.g.
+// with 2 nodes of 48 cores each, workers [0, 48) belong to node 0 and [48, 96) to node 1.
+void NormalTaskQueue::_init_numa_groups() {
+    std::vector<int> cores;
+    int max_num_nodes = CpuInfo::get_max_num_numa_nodes();
+    for (int node = 0; node < max_num_nodes; ++node) {
+        const auto& node_cores = CpuInfo::get_cores_of_numa_node(node);
+        cores.insert(cores.end(), node_cores.begin(), node_cores.end());
+    }
+
+    _worker_numa_node.resize(_core_size, 0);
+    _numa_node_workers.resize(std::max(max_num_nodes, 1));
+    for (size_t i = 0; i < _core_size; ++i) {
+        if (!cores.empty()) {
+            auto core = cores[i * cores.size() / _core_size];
+            _worker_numa_node[i] = CpuInfo::get_numa_node_of_core(core);
+        }
+        _numa_node_workers[_worker_numa_node[i]].push_back(i);
+    }
+    _num_numa_nodes = 0;
+    for (const auto& workers : _numa_node_workers) {
+        _num_numa_nodes += !workers.empty();
+    }
+    LOG(INFO) << "NormalTaskQueue has " << _core_size << " workers on " << _num_numa_nodes
+              << " NUMA nodes";
+}
+
+void NormalTaskQueue::init_worker(size_t core_id) {
+    DCHECK(core_id < _core_size);
+    if (!config::enable_pipeline_task_numa_affinity || _num_numa_nodes <= 1) {
+        return;
+    }
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (auto core : CpuInfo::get_cores_of_numa_node(_worker_numa_node[core_id])) {
+        CPU_SET(core, &cpu_set);
+    }
+    int ret = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+    if (ret != 0) {
+        LOG(WARNING) << "failed to bind pipeline worker " << core_id << " to NUMA node "
+                     << _worker_numa_node[core_id] << ", errno=" << ret;
+    }
 }
 
 void NormalTaskQueue::close() {
@@ -163,18 +270,50 @@ PipelineTask* NormalTaskQueue::take(size_t core_id) {
         }
     }
     if (task) {
-        task->pop_out_runnable_queue();
+        auto wait_ns = task->pop_out_runnable_queue();
+        _level_metrics[task->get_queue_level()].wait_time_us->add(wait_ns / 1000);
     }
     return task;
 }
 
+void NormalTaskQueue::update_statistics(PipelineTask* task, int64_t time_spent) {
+    task->inc_runtime_ns(time_spent);
+    _async_queue[task->get_core_id()].update_statistics(task, time_spent);
+    _level_metrics[task->get_queue_level()].run_time_us->add(time_spent / 1000);
+}
+
+// Steal from the workers of the local NUMA node first, then from the other nodes.
 PipelineTask* NormalTaskQueue::_steal_take(size_t core_id) {
     DCHECK(core_id < _core_size);
-    size_t next_id = core_id;
-    for (size_t i = 1; i < _core_size; ++i) {
-        ++next_id;
-        if (next_id == _core_size) {
-            next_id = 0;
+    int local_node = _worker_numa_node[core_id];
+    auto task = _steal_take_from_node(core_id, local_node);
+    if (task) {
+        task->update_steal_counter(false);
+        return task;
+    }
+    int num_nodes = _numa_node_workers.size();
+    for (int i = 1; i < num_nodes; ++i) {
+        task = _steal_take_from_node(core_id, (local_node + i) % num_nodes);
+        if (task) {
+            task->update_steal_counter(true);
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+PipelineTask* NormalTaskQueue::_steal_take_from_node(size_t core_id, int node) {
+    const auto& workers = _numa_node_workers[node];
+    size_t num_workers = workers.size();
+    if (num_workers == 0) {
+        return nullptr;
+    }
+    // start from the worker next to `core_id` to spread the steals of different workers
+    size_t start = core_id % num_workers;
+    for (size_t i = 0; i < num_workers; ++i) {
+        auto next_id = workers[(start + i + 1) % num_workers];
+        if (next_id == core_id) {
+            continue;
         }
         DCHECK(next_id < _core_size);
         auto task = _async_queue[next_id].try_take(true);
@@ -190,13 +329,17 @@ Status NormalTaskQueue::push_back(PipelineTask* task) {
     if (core_id < 0) {
         core_id = _next_core.fetch_add(1) % _core_size;
     }
-    return push_back(task, core_id);
+    DCHECK(core_id < _core_size);
+    task->put_in_runnable_queue();
+    task->set_core_id(core_id);
+    return _async_queue[core_id].push(task, false);
 }
 
 Status NormalTaskQueue::push_back(PipelineTask* task, size_t core_id) {
     DCHECK(core_id < _core_size);
     task->put_in_runnable_queue();
-    return _async_queue[core_id].push(task);
+    task->set_core_id(core_id);
+    return _async_queue[core_id].push(task, true);
 }
 
 bool TaskGroupTaskQueue::TaskGroupSchedEntityComparator::operator()(
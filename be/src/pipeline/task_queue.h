@@ -19,6 +19,8 @@
 #include <queue>
 
 #include "pipeline_task.h"
+#include "util/metrics.h"
+#include "util/work_stealing_deque.h"
 
 namespace doris {
 namespace taskgroup {
@@ -39,11 +41,14 @@ public:
     // push from scheduler
     virtual Status push_back(PipelineTask* task) = 0;
 
-    // push from worker
+    // push from worker, `core_id` must be the worker itself
     virtual Status push_back(PipelineTask* task, size_t core_id) = 0;
 
     virtual void update_statistics(PipelineTask* task, int64_t time_spent) {}
 
+    // Called by the worker thread `core_id` before it starts to take tasks.
+    virtual void init_worker(size_t core_id) {}
+
     int cores() const { return _core_size; }
 
 protected:
@@ -51,12 +56,26 @@ protected:
     static constexpr auto WAIT_CORE_TASK_TIMEOUT_MS = 100;
 };
 
+// The tasks pushed by the owner worker go to a lock free work stealing deque, and
+// the other ones (from the scheduler, the blocked task scheduler, or can not be
+// stolen) go to a queue protected by a mutex. The worker takes the tasks of the deque
+// from the top as the thieves do, to keep FIFO order among the tasks of one level.
 class SubWorkTaskQueue {
     friend class WorkTaskQueue;
     friend class NormalWorkTaskQueue;
 
 public:
-    void push_back(PipelineTask* task) { _queue.emplace(task); }
+    // push from the owner worker
+    void push_back_local(PipelineTask* task) {
+        _local_queue.push(task);
+        ++_size;
+    }
+
+    void push_back(PipelineTask* task) {
+        std::unique_lock<std::mutex> lock(_remote_queue_mutex);
+        _remote_queue.emplace(task);
+        ++_size;
+    }
 
     PipelineTask* try_take(bool is_steal);
 
@@ -64,13 +83,22 @@ public:
 
     double schedule_time_after_normal() { return _schedule_time * _factor_for_normal; }
 
-    bool empty() { return _queue.empty(); }
+    void inc_schedule_time(uint64_t time_spent) { _schedule_time += time_spent; }
+
+    bool empty() { return _size == 0; }
 
 private:
-    std::queue<PipelineTask*> _queue;
+    PipelineTask* _try_take_remote(bool is_steal);
+
+    WorkStealingDeque<PipelineTask> _local_queue;
+    std::mutex _remote_queue_mutex;
+    std::queue<PipelineTask*> _remote_queue;
+    std::atomic<size_t> _size = 0;
+    // take from the two queues in turn
+    std::atomic<uint32_t> _take_times = 0;
     // factor for normalization
     double _factor_for_normal = 1;
-    // the value cal the queue task time consume, the WorkTaskQueue
+    // the value cal the queue task time consume(ns), the WorkTaskQueue
     // use it to find the min queue to take task work
     std::atomic<uint64_t> _schedule_time = 0;
 };
@@ -82,30 +110,40 @@ public:
 
     void close();
 
-    PipelineTask* try_take_unprotected(bool is_steal);
-
     PipelineTask* try_take(bool is_steal);
 
     PipelineTask* take(uint32_t timeout_ms = 0);
 
-    Status push(PipelineTask* task);
+    // `from_owner` is true if pushed by the worker thread owning this queue.
+    Status push(PipelineTask* task, bool from_owner);
+
+    // Charge the time the task really ran to the level it was taken from.
+    void update_statistics(PipelineTask* task, int64_t time_spent);
+
+    static constexpr size_t SUB_QUEUE_LEVEL = 5;
 
 private:
     static constexpr auto LEVEL_QUEUE_TIME_FACTOR = 1.5;
-    static constexpr size_t SUB_QUEUE_LEVEL = 5;
-    // 3, 6, 9, 12
-    static constexpr uint32_t BASE_LIMIT = 3;
+    // A task goes down one level each time its total run time exceeds the limit of the
+    // current level: 1s, 10s, 60s, 300s. So short queries stay in the upper levels and
+    // are not blocked by the long running ones.
+    static constexpr int64_t LEVEL_RUN_TIME_LIMIT_NS[SUB_QUEUE_LEVEL - 1] = {
+            1'000'000'000L, 10'000'000'000L, 60'000'000'000L, 300'000'000'000L};
     SubWorkTaskQueue _sub_queues[SUB_QUEUE_LEVEL];
-    uint32_t _task_schedule_limit[SUB_QUEUE_LEVEL - 1];
+    // only used to wait for tasks when the queue is empty
     std::mutex _work_size_mutex;
     std::condition_variable _wait_task;
+    std::atomic<int> _num_waiters = 0;
     std::atomic<size_t> _total_task_size = 0;
-    bool _closed;
+    std::atomic<bool> _closed;
 
     int _compute_level(PipelineTask* task);
 };
 
-// Need consider NUMA architecture
+// The workers are divided into groups by NUMA node, in proportion to the cores of
+// each node. A worker steals tasks from the workers of its own node first, and only
+// goes to the other nodes when they are all idle, so a task tends to stay close to
+// the memory it has touched.
 class NormalTaskQueue : public TaskQueue {
 public:
     explicit NormalTaskQueue(size_t core_size);
@@ -123,15 +161,37 @@ public:
 
     Status push_back(PipelineTask* task, size_t core_id) override;
 
-    // TODO pipeline update NormalWorkTaskQueue by time_spent.
-    // void update_statistics(PipelineTask* task, int64_t time_spent) override;
+    void update_statistics(PipelineTask* task, int64_t time_spent) override;
+
+    // Bind the worker thread to the cpus of its NUMA node.
+    void init_worker(size_t core_id) override;
+
+    int numa_node_of_worker(size_t core_id) const { return _worker_numa_node[core_id]; }
 
 private:
+    void _init_numa_groups();
+
     PipelineTask* _steal_take(size_t core_id);
 
+    PipelineTask* _steal_take_from_node(size_t core_id, int node);
+
     std::unique_ptr<NormalWorkTaskQueue[]> _async_queue;
     std::atomic<size_t> _next_core = 0;
     std::atomic<bool> _closed;
+
+    int _num_numa_nodes = 1;
+    // NUMA node of each worker
+    std::vector<int> _worker_numa_node;
+    // workers of each NUMA node
+    std::vector<std::vector<size_t>> _numa_node_workers;
+
+    // wait time and run time of the tasks of each level
+    struct LevelMetrics {
+        std::shared_ptr<MetricEntity> entity;
+        HistogramMetric* wait_time_us = nullptr;
+        HistogramMetric* run_time_us = nullptr;
+    };
+    LevelMetrics _level_metrics[NormalWorkTaskQueue::SUB_QUEUE_LEVEL];
 };
 
 class TaskGroupTaskQueue : public TaskQueue {
@@ -19,6 +19,7 @@
 
 #include "common/signal_handler.h"
 #include "pipeline_fragment_context.h"
+#include "util/query_cpu_sampler.h"
 #include "util/thread.h"
 
 namespace doris::pipeline {
@@ -59,32 +60,62 @@ Status BlockedTaskScheduler::add_blocked_task(PipelineTask* task) {
     return Status::OK();
 }
 
+void BlockedTaskScheduler::wake_up(PipelineTask* task) {
+    std::unique_lock<std::mutex> lock(_task_mutex);
+    _woken_tasks.push_back(task);
+    _task_cond.notify_one();
+}
+
 void BlockedTaskScheduler::_schedule() {
     _started.store(true);
     std::list<PipelineTask*> local_blocked_tasks;
     int empty_times = 0;
     std::vector<PipelineTask*> ready_tasks;
 
+    auto last_check_time = std::chrono::steady_clock::now();
+
     while (!_shutdown) {
+        std::list<PipelineTask*> woken_tasks;
         {
             std::unique_lock<std::mutex> lock(this->_task_mutex);
             local_blocked_tasks.splice(local_blocked_tasks.end(), _blocked_tasks);
-            if (local_blocked_tasks.empty()) {
-                while (!_shutdown.load() && _blocked_tasks.empty()) {
-                    _task_cond.wait_for(lock, std::chrono::milliseconds(10));
+            if (local_blocked_tasks.empty() && _woken_tasks.empty()) {
+                if (_parked_tasks.empty()) {
+                    while (!_shutdown.load() && _blocked_tasks.empty() && _woken_tasks.empty()) {
+                        _task_cond.wait_for(lock, std::chrono::milliseconds(10));
+                    }
+                } else {
+                    // wake up to check the parked tasks
+                    _task_cond.wait_for(lock,
+                                        std::chrono::milliseconds(PARKED_TASK_CHECK_INTERVAL_MS));
                 }
 
                 if (_shutdown.load()) {
                     break;
                 }
 
-                DCHECK(!_blocked_tasks.empty());
                 local_blocked_tasks.splice(local_blocked_tasks.end(), _blocked_tasks);
             }
+            woken_tasks.swap(_woken_tasks);
+        }
+
+        for (auto* task : woken_tasks) {
+            if (_parked_tasks.erase(task)) {
+                local_blocked_tasks.push_back(task);
+            }
         }
 
-        auto iter = local_blocked_tasks.begin();
         vectorized::VecDateTimeValue now = vectorized::VecDateTimeValue::local_time();
+        if (!_parked_tasks.empty()) {
+            auto steady_now = std::chrono::steady_clock::now();
+            if (steady_now - last_check_time >=
+                std::chrono::milliseconds(PARKED_TASK_CHECK_INTERVAL_MS)) {
+                last_check_time = steady_now;
+                _check_parked_tasks(local_blocked_tasks, now);
+            }
+        }
+
+        auto iter = local_blocked_tasks.begin();
         while (iter != local_blocked_tasks.end()) {
             auto* task = *iter;
             auto state = task->get_state();
@@ -124,14 +155,23 @@ void BlockedTaskScheduler::_schedule() {
                     _make_task_run(local_blocked_tasks, iter, ready_tasks);
                 }
             } else if (state == PipelineTaskState::BLOCKED_FOR_SOURCE) {
+                // read the version before checking, see Dependency
+                auto* dependency = task->read_dependency();
+                auto version = dependency ? dependency->version() : 0;
                 if (task->source_can_read()) {
                     _make_task_run(local_blocked_tasks, iter, ready_tasks);
+                } else if (dependency) {
+                    _park_task(dependency, version, local_blocked_tasks, iter, ready_tasks);
                 } else {
                     iter++;
                 }
             } else if (state == PipelineTaskState::BLOCKED_FOR_RF) {
+                auto* dependency = task->runtime_filter_dependency();
+                auto version = dependency ? dependency->version() : 0;
                 if (task->runtime_filters_are_ready_or_timeout()) {
                     _make_task_run(local_blocked_tasks, iter, ready_tasks);
+                } else if (dependency) {
+                    _park_task(dependency, version, local_blocked_tasks, iter, ready_tasks);
                 } else {
                     iter++;
                 }
@@ -173,6 +213,46 @@ void BlockedTaskScheduler::_schedule() {
     LOG(INFO) << "BlockedTaskScheduler schedule thread stop";
 }
 
+void BlockedTaskScheduler::_park_task(Dependency* dependency, uint64_t version,
+                                      std::list<PipelineTask*>& local_tasks,
+                                      std::list<PipelineTask*>::iterator& task_itr,
+                                      std::vector<PipelineTask*>& ready_tasks) {
+    auto* task = *task_itr;
+    if (dependency->park(task, this, version)) {
+        _parked_tasks.emplace(task, dependency);
+        task_itr = local_tasks.erase(task_itr);
+    } else {
+        // notified during the check, the task may be ready now
+        _make_task_run(local_tasks, task_itr, ready_tasks);
+    }
+}
+
+void BlockedTaskScheduler::_check_parked_tasks(std::list<PipelineTask*>& local_tasks,
+                                               const vectorized::VecDateTimeValue& now) {
+    auto iter = _parked_tasks.begin();
+    while (iter != _parked_tasks.end()) {
+        auto* task = iter->first;
+        bool need_check = task->fragment_context()->is_canceled() ||
+                          task->query_fragments_context()->is_timeout(now);
+        if (!need_check) {
+            // the runtime filter wait timeout is not notified, and the ready check is a
+            // safety net for the producers which do not notify the dependency.
+            if (task->get_state() == PipelineTaskState::BLOCKED_FOR_RF) {
+                need_check = task->runtime_filters_are_ready_or_timeout();
+            } else {
+                need_check = task->source_can_read();
+            }
+        }
+        // if remove() fails, the task is being woken up by notify()
+        if (need_check && iter->second->remove(task)) {
+            local_tasks.push_back(task);
+            iter = _parked_tasks.erase(iter);
+        } else {
+            iter++;
+        }
+    }
+}
+
 void BlockedTaskScheduler::_make_task_run(std::list<PipelineTask*>& local_tasks,
                                           std::list<PipelineTask*>::iterator& task_itr,
                                           std::vector<PipelineTask*>& ready_tasks,
@@ -213,6 +293,7 @@ Status TaskScheduler::schedule_task(PipelineTask* task) {
 }
 
 void TaskScheduler::_do_work(size_t index) {
+    _task_queue->init_worker(index);
     const auto& marker = _markers[index];
     while (*marker) {
         auto* task = _task_queue->take(index);
@@ -246,7 +327,11 @@ void TaskScheduler::_do_work(size_t index) {
         DCHECK(check_state == PipelineTaskState::RUNNABLE);
         // task exec
         bool eos = false;
+        QueryCpuSampler::set_tag(fragment_ctx->get_query_id(),
+                                 fragment_ctx->get_fragment_instance_id(), task->pipeline_id(),
+                                 task->index());
         auto status = task->execute(&eos);
+        QueryCpuSampler::clear_tag();
         task->set_previous_core_id(index);
         if (!status.ok()) {
             LOG(WARNING) << fmt::format("Pipeline task [{}] failed: {}", task->debug_string(),
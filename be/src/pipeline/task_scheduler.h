@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include "common/status.h"
 #include "pipeline.h"
 #include "pipeline_task.h"
@@ -34,6 +36,8 @@ public:
     Status start();
     void shutdown();
     Status add_blocked_task(PipelineTask* task);
+    // called by Dependency::notify() for the task parked on the dependency
+    void wake_up(PipelineTask* task);
 
 private:
     std::shared_ptr<TaskQueue> _task_queue;
@@ -41,12 +45,20 @@ private:
     std::mutex _task_mutex;
     std::condition_variable _task_cond;
     std::list<PipelineTask*> _blocked_tasks;
+    std::list<PipelineTask*> _woken_tasks;
+
+    // Tasks parked on a dependency, they are not polled until woken up.
+    // Only accessed by the schedule thread.
+    std::unordered_map<PipelineTask*, Dependency*> _parked_tasks;
 
     scoped_refptr<Thread> _thread;
     std::atomic<bool> _started;
     std::atomic<bool> _shutdown;
 
     static constexpr auto EMPTY_TIMES_TO_YIELD = 64;
+    // The parked tasks are checked at this interval for cancel, timeout and the
+    // runtime filter wait timeout, which are not notified by the dependencies.
+    static constexpr auto PARKED_TASK_CHECK_INTERVAL_MS = 20;
 
 private:
     void _schedule();
@@ -54,6 +66,14 @@ private:
                         std::list<PipelineTask*>::iterator& task_itr,
                         std::vector<PipelineTask*>& ready_tasks,
                         PipelineTaskState state = PipelineTaskState::RUNNABLE);
+    // Park the task on the dependency, or make it run if the dependency is notified
+    // after `version` is read.
+    void _park_task(Dependency* dependency, uint64_t version,
+                    std::list<PipelineTask*>& local_tasks,
+                    std::list<PipelineTask*>::iterator& task_itr,
+                    std::vector<PipelineTask*>& ready_tasks);
+    void _check_parked_tasks(std::list<PipelineTask*>& local_tasks,
+                             const vectorized::VecDateTimeValue& now);
 };
 
 class TaskScheduler {
@@ -17,11 +17,17 @@
 
 #include "runtime/block_spill_manager.h"
 
+#include <algorithm>
 #include <boost/uuid/random_generator.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <random>
 
+#include "common/config.h"
 #include "io/fs/local_file_system.h"
+#include "runtime/exec_env.h"
+#include "runtime/query_fragments_ctx.h"
+#include "runtime/runtime_state.h"
+#include "runtime/task_group/task_group_manager.h"
 #include "util/time.h"
 #include "vec/core/block_spill_reader.h"
 #include "vec/core/block_spill_writer.h"
@@ -29,6 +35,24 @@
 namespace doris {
 static const std::string BLOCK_SPILL_DIR = "spill";
 static const std::string BLOCK_SPILL_GC_DIR = "spill_gc";
+
+RevocableMemory::RevocableMemory(std::string label, RuntimeState* state)
+        : _label(std::move(label)), _priority(taskgroup::TaskGroupManager::DEFAULT_TG_CPU_SHARE) {
+    auto* query_ctx = state->get_query_fragments_ctx();
+    if (query_ctx != nullptr && query_ctx->get_task_group() != nullptr) {
+        _priority = query_ctx->get_task_group()->share();
+    }
+    if (auto* spill_mgr = ExecEnv::GetInstance()->block_spill_mgr()) {
+        spill_mgr->register_revocable_memory(this);
+    }
+}
+
+RevocableMemory::~RevocableMemory() {
+    if (auto* spill_mgr = ExecEnv::GetInstance()->block_spill_mgr()) {
+        spill_mgr->deregister_revocable_memory(this);
+    }
+}
+
 BlockSpillManager::BlockSpillManager(const std::vector<StorePath>& paths) : _store_paths(paths) {}
 
 Status BlockSpillManager::init() {
@@ -133,4 +157,46 @@ void BlockSpillManager::remove(int64_t stream_id) {
     std::lock_guard<std::mutex> l(lock_);
     id_to_file_paths_.erase(stream_id);
 }
+
+void BlockSpillManager::register_revocable_memory(RevocableMemory* memory) {
+    std::lock_guard<std::mutex> l(_revocable_lock);
+    _revocable_memories.insert(memory);
+}
+
+void BlockSpillManager::deregister_revocable_memory(RevocableMemory* memory) {
+    std::lock_guard<std::mutex> l(_revocable_lock);
+    _revocable_memories.erase(memory);
+}
+
+int64_t BlockSpillManager::revoke_memory(int64_t bytes) {
+    std::lock_guard<std::mutex> l(_revocable_lock);
+    // the bytes are updated by the operators concurrently, so they are taken once for sorting
+    std::vector<std::pair<int64_t, RevocableMemory*>> candidates;
+    for (auto* memory : _revocable_memories) {
+        int64_t memory_bytes = memory->bytes();
+        // spilling the small ones costs more than it releases
+        if (memory_bytes >= config::spill_revocable_min_bytes) {
+            candidates.emplace_back(memory_bytes, memory);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) {
+        if (lhs.second->priority() != rhs.second->priority()) {
+            return lhs.second->priority() < rhs.second->priority();
+        }
+        return lhs.first > rhs.first;
+    });
+    int64_t requested_bytes = 0;
+    for (const auto& candidate : candidates) {
+        if (requested_bytes >= bytes) {
+            break;
+        }
+        if (candidate.second->request_revoke()) {
+            requested_bytes += candidate.first;
+            LOG(INFO) << "request to revoke " << candidate.first << " bytes of "
+                      << candidate.second->label() << " by spilling";
+        }
+    }
+    return requested_bytes;
+}
+
 } // namespace doris
@@ -17,9 +17,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "olap/options.h"
@@ -35,6 +37,44 @@ using BlockSpillReaderUPtr = std::unique_ptr<BlockSpillReader>;
 } // namespace vectorized
 
 class ExecEnv;
+class RuntimeState;
+
+// The memory of an operator which can be released by spilling it to disk, e.g. the hash table of
+// an aggregation, the build side of a hash join or the sorted blocks of a sort. It is registered
+// to the BlockSpillManager while it lives, and the memory GC asks it to be revoked when the process
+// memory is short, the operator spills at its next chance and calls revoked().
+class RevocableMemory {
+public:
+    RevocableMemory(std::string label, RuntimeState* state);
+    ~RevocableMemory();
+
+    RevocableMemory(const RevocableMemory&) = delete;
+    RevocableMemory& operator=(const RevocableMemory&) = delete;
+
+    const std::string& label() const { return _label; }
+    // The cpu share of the workload group of the query, the lower ones are revoked first.
+    uint64_t priority() const { return _priority; }
+
+    // The bytes which can be released by spilling, updated by the operator.
+    int64_t bytes() const { return _bytes.load(std::memory_order_relaxed); }
+    void set_bytes(int64_t bytes) { _bytes.store(bytes, std::memory_order_relaxed); }
+
+    bool revoke_requested() const { return _revoke_requested.load(std::memory_order_acquire); }
+    // Returns false if it is requested already, which is not served yet.
+    bool request_revoke() { return !_revoke_requested.exchange(true, std::memory_order_acq_rel); }
+    // Called by the operator after it spills.
+    void revoked() {
+        _bytes.store(0, std::memory_order_relaxed);
+        _revoke_requested.store(false, std::memory_order_release);
+    }
+
+private:
+    const std::string _label;
+    uint64_t _priority;
+    std::atomic<int64_t> _bytes {0};
+    std::atomic<bool> _revoke_requested {false};
+};
+
 class BlockSpillManager {
 public:
     BlockSpillManager(const std::vector<StorePath>& paths);
@@ -51,7 +91,19 @@ public:
 
     void gc(int64_t max_file_count);
 
+    void register_revocable_memory(RevocableMemory* memory);
+    void deregister_revocable_memory(RevocableMemory* memory);
+
+    // Asks the registered operators to spill, by the lower priority and the larger memory first,
+    // until at least `bytes` are requested. Returns the requested bytes, which do not count the
+    // operators whose previous requests are not served yet, since they can not spill for now,
+    // e.g. they are not scheduled, so that the memory GC goes on to cancel queries.
+    int64_t revoke_memory(int64_t bytes);
+
 private:
+    std::mutex _revocable_lock;
+    std::unordered_set<RevocableMemory*> _revocable_memories;
+
     std::vector<StorePath> _store_paths;
     std::mutex lock_;
     int64_t id_ = 0;
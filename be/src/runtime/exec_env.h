@@ -44,6 +44,7 @@ class DataStreamMgr;
 class EvHttpServer;
 class ExternalScanContextMgr;
 class FragmentMgr;
+class GroupCommitMgr;
 class ResultCache;
 class LoadPathMgr;
 class NewLoadStreamMgr;
@@ -127,6 +128,17 @@ public:
     ThreadPool* download_cache_thread_pool() { return _download_cache_thread_pool.get(); }
     ThreadPool* send_report_thread_pool() { return _send_report_thread_pool.get(); }
     ThreadPool* join_node_thread_pool() { return _join_node_thread_pool.get(); }
+    ThreadPool* hash_join_build_thread_pool() { return _hash_join_build_thread_pool.get(); }
+    ThreadPool* agg_merge_thread_pool() { return _agg_merge_thread_pool.get(); }
+    ThreadPool* multiget_thread_pool() { return _multiget_thread_pool.get(); }
+    ThreadPool* remote_page_prefetch_thread_pool() {
+        return _remote_page_prefetch_thread_pool.get();
+    }
+    ThreadPool* file_cache_write_thread_pool() { return _file_cache_write_thread_pool.get(); }
+    ThreadPool* s3_file_upload_thread_pool() { return _s3_file_upload_thread_pool.get(); }
+    ThreadPool* merge_range_read_thread_pool() { return _merge_range_read_thread_pool.get(); }
+    ThreadPool* outfile_encode_thread_pool() { return _outfile_encode_thread_pool.get(); }
+    ThreadPool* fragment_prepare_thread_pool() { return _fragment_prepare_thread_pool.get(); }
 
     void set_serial_download_cache_thread_token() {
         _serial_download_cache_thread_token =
@@ -158,6 +170,7 @@ public:
     }
     LoadChannelMgr* load_channel_mgr() { return _load_channel_mgr; }
     NewLoadStreamMgr* new_load_stream_mgr() { return _new_load_stream_mgr; }
+    GroupCommitMgr* group_commit_mgr() { return _group_commit_mgr; }
     SmallFileMgr* small_file_mgr() { return _small_file_mgr; }
     BlockSpillManager* block_spill_mgr() { return _block_spill_mgr; }
 
@@ -221,6 +234,24 @@ private:
     std::unique_ptr<ThreadPool> _send_report_thread_pool;
     // Pool used by join node to build hash table
     std::unique_ptr<ThreadPool> _join_node_thread_pool;
+    // Pool used to fill the sub tables of the hash table of a hash join in parallel
+    std::unique_ptr<ThreadPool> _hash_join_build_thread_pool;
+    // Pool used to merge the aggregate states of an aggregation in parallel
+    std::unique_ptr<ThreadPool> _agg_merge_thread_pool;
+    // Pool used to read the rows of the segments in parallel for a fetch by row ids
+    std::unique_ptr<ThreadPool> _multiget_thread_pool;
+    // Pool used to prefetch data pages of the segments on remote storage
+    std::unique_ptr<ThreadPool> _remote_page_prefetch_thread_pool;
+    // Pool used to write the data downloaded from remote storage into the file cache
+    std::unique_ptr<ThreadPool> _file_cache_write_thread_pool;
+    // Pool used to upload the parts of the files written to S3 in parallel
+    std::unique_ptr<ThreadPool> _s3_file_upload_thread_pool;
+    // Pool used to fetch the merged ranges of the remote files ahead
+    std::unique_ptr<ThreadPool> _merge_range_read_thread_pool;
+    // Pool used to encode the columns of the outfiles in parallel
+    std::unique_ptr<ThreadPool> _outfile_encode_thread_pool;
+    // Pool used to prepare the instances of a pipeline fragment in parallel
+    std::unique_ptr<ThreadPool> _fragment_prepare_thread_pool;
     // ThreadPoolToken -> buffer
     std::unordered_map<ThreadPoolToken*, std::unique_ptr<char[]>> _download_cache_buf_map;
     FragmentMgr* _fragment_mgr = nullptr;
@@ -241,6 +272,7 @@ private:
     StorageEngine* _storage_engine = nullptr;
 
     StreamLoadExecutor* _stream_load_executor = nullptr;
+    GroupCommitMgr* _group_commit_mgr = nullptr;
     RoutineLoadTaskExecutor* _routine_load_task_executor = nullptr;
     SmallFileMgr* _small_file_mgr = nullptr;
     HeartbeatFlags* _heartbeat_flags = nullptr;
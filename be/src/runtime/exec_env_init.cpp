@@ -15,6 +15,9 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include <algorithm>
+#include <cmath>
+
 #include "common/config.h"
 #include "common/logging.h"
 #include "gen_cpp/BackendService.h"
@@ -41,11 +44,13 @@
 #include "runtime/result_queue_mgr.h"
 #include "runtime/routine_load/routine_load_task_executor.h"
 #include "runtime/small_file_mgr.h"
+#include "runtime/stream_load/group_commit_mgr.h"
 #include "runtime/stream_load/new_load_stream_mgr.h"
 #include "runtime/stream_load/stream_load_executor.h"
 #include "service/point_query_executor.h"
 #include "util/bfd_parser.h"
 #include "util/brpc_client_cache.h"
+#include "util/cgroup_util.h"
 #include "util/doris_metrics.h"
 #include "util/mem_info.h"
 #include "util/metrics.h"
@@ -53,6 +58,8 @@
 #include "util/pretty_printer.h"
 #include "util/priority_thread_pool.hpp"
 #include "util/priority_work_stealing_thread_pool.hpp"
+#include "vec/exec/format/file_meta_cache.h"
+#include "vec/exec/scan/scan_cache.h"
 #include "vec/exec/scan/scanner_scheduler.h"
 #include "vec/runtime/vdata_stream_mgr.h"
 
@@ -115,6 +122,56 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
             .set_max_queue_size(config::fragment_pool_queue_size)
             .build(&_join_node_thread_pool);
 
+    ThreadPoolBuilder("HashJoinBuildThreadPool")
+            .set_min_threads(1)
+            .set_max_threads(config::hash_join_build_thread_pool_thread_num)
+            .set_max_queue_size(config::hash_join_build_thread_pool_queue_size)
+            .build(&_hash_join_build_thread_pool);
+
+    ThreadPoolBuilder("AggMergeThreadPool")
+            .set_min_threads(1)
+            .set_max_threads(config::agg_merge_thread_pool_thread_num)
+            .set_max_queue_size(config::agg_merge_thread_pool_queue_size)
+            .build(&_agg_merge_thread_pool);
+
+    ThreadPoolBuilder("MultigetThreadPool")
+            .set_min_threads(1)
+            .set_max_threads(config::multiget_thread_pool_thread_num)
+            .set_max_queue_size(config::multiget_thread_pool_queue_size)
+            .build(&_multiget_thread_pool);
+
+    ThreadPoolBuilder("RemotePagePrefetchThreadPool")
+            .set_min_threads(1)
+            .set_max_threads(config::remote_page_prefetch_thread_pool_thread_num)
+            .set_max_queue_size(config::remote_page_prefetch_thread_pool_queue_size)
+            .build(&_remote_page_prefetch_thread_pool);
+
+    ThreadPoolBuilder("FileCacheWriteThreadPool")
+            .set_min_threads(1)
+            .set_max_threads(config::file_cache_write_thread_pool_thread_num)
+            .set_max_queue_size(config::file_cache_write_thread_pool_queue_size)
+            .build(&_file_cache_write_thread_pool);
+
+    ThreadPoolBuilder("S3FileUploadThreadPool")
+            .set_min_threads(1)
+            .set_max_threads(config::s3_file_upload_thread_pool_thread_num)
+            .build(&_s3_file_upload_thread_pool);
+
+    ThreadPoolBuilder("MergeRangeReadThreadPool")
+            .set_min_threads(1)
+            .set_max_threads(config::merge_range_read_thread_pool_thread_num)
+            .build(&_merge_range_read_thread_pool);
+
+    ThreadPoolBuilder("OutfileEncodeThreadPool")
+            .set_min_threads(1)
+            .set_max_threads(config::outfile_encode_thread_pool_thread_num)
+            .build(&_outfile_encode_thread_pool);
+
+    ThreadPoolBuilder("FragmentPrepareThreadPool")
+            .set_min_threads(1)
+            .set_max_threads(config::fragment_prepare_thread_pool_thread_num)
+            .build(&_fragment_prepare_thread_pool);
+
     RETURN_IF_ERROR(init_pipeline_task_scheduler());
     _scanner_scheduler = new doris::vectorized::ScannerScheduler();
     _fragment_mgr = new FragmentMgr(this);
@@ -129,6 +186,7 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
     _internal_client_cache = new BrpcClientCache<PBackendService_Stub>();
     _function_client_cache = new BrpcClientCache<PFunctionService_Stub>();
     _stream_load_executor = new StreamLoadExecutor(this);
+    _group_commit_mgr = new GroupCommitMgr(this);
     _routine_load_task_executor = new RoutineLoadTaskExecutor(this);
     _small_file_mgr = new SmallFileMgr(this, config::small_file_dir);
     _block_spill_mgr = new BlockSpillManager(_store_paths);
@@ -159,6 +217,14 @@ Status ExecEnv::init_pipeline_task_scheduler() {
     auto executors_size = config::pipeline_executor_size;
     if (executors_size <= 0) {
         executors_size = CpuInfo::num_cores();
+        // the executors beyond the cpu quota only preempt each other
+        float cpu_limit = 0;
+        if (config::num_cores <= 0 && CGroupUtil::find_cgroup_cpu_limit(&cpu_limit).ok() &&
+            cpu_limit > 0) {
+            executors_size = std::min(executors_size, static_cast<int>(std::ceil(cpu_limit)));
+            LOG(INFO) << "pipeline executor size: " << executors_size
+                      << ", limited by the cpu quota of the cgroup: " << cpu_limit;
+        }
     }
 
     // TODO pipeline task group combie two blocked schedulers.
@@ -203,10 +269,20 @@ Status ExecEnv::_init_mem_env() {
     }
     int32_t index_percentage = config::index_page_cache_percentage;
     uint32_t num_shards = config::storage_page_cache_shard_size;
-    StoragePageCache::create_global_cache(storage_cache_limit, index_percentage, num_shards);
+    int64_t compressed_cache_limit = ParseUtil::parse_mem_spec(
+            config::storage_compressed_page_cache_limit, MemInfo::mem_limit(),
+            MemInfo::physical_mem(), &is_percent);
+    if (compressed_cache_limit < 0) {
+        compressed_cache_limit = 0;
+    }
+    StoragePageCache::create_global_cache(storage_cache_limit, index_percentage, num_shards,
+                                          config::storage_page_cache_protected_percentage,
+                                          compressed_cache_limit);
     LOG(INFO) << "Storage page cache memory limit: "
               << PrettyPrinter::print(storage_cache_limit, TUnit::BYTES)
-              << ", origin config value: " << config::storage_page_cache_limit;
+              << ", origin config value: " << config::storage_page_cache_limit
+              << ", compressed page cache memory limit: "
+              << PrettyPrinter::print(compressed_cache_limit, TUnit::BYTES);
 
     // Init row cache
     int64_t row_cache_mem_limit =
@@ -221,6 +297,26 @@ Status ExecEnv::_init_mem_env() {
               << PrettyPrinter::print(row_cache_mem_limit, TUnit::BYTES)
               << ", origin config value: " << config::row_cache_mem_limit;
 
+    int64_t scan_cache_limit =
+            ParseUtil::parse_mem_spec(config::scan_cache_limit, MemInfo::mem_limit(),
+                                      MemInfo::physical_mem(), &is_percent);
+    while (!is_percent && scan_cache_limit > MemInfo::mem_limit() / 2) {
+        // Reason same as buffer_pool_limit
+        scan_cache_limit = scan_cache_limit / 2;
+    }
+    vectorized::ScanCache::create_global_cache(std::max<int64_t>(scan_cache_limit, 0));
+    LOG(INFO) << "Scan cache memory limit: "
+              << PrettyPrinter::print(scan_cache_limit, TUnit::BYTES)
+              << ", origin config value: " << config::scan_cache_limit;
+
+    int64_t file_meta_cache_limit =
+            ParseUtil::parse_mem_spec(config::external_file_meta_cache_limit,
+                                      MemInfo::mem_limit(), MemInfo::physical_mem(), &is_percent);
+    vectorized::FileMetaCache::create_global_instance(std::max<int64_t>(file_meta_cache_limit, 0));
+    LOG(INFO) << "External file meta cache memory limit: "
+              << PrettyPrinter::print(file_meta_cache_limit, TUnit::BYTES)
+              << ", origin config value: " << config::external_file_meta_cache_limit;
+
     uint64_t fd_number = config::min_file_descriptor_number;
     struct rlimit l;
     int ret = getrlimit(RLIMIT_NOFILE, &l);
@@ -353,6 +449,7 @@ void ExecEnv::_destroy() {
     SAFE_DELETE(_backend_client_cache);
     SAFE_DELETE(_result_mgr);
     SAFE_DELETE(_result_queue_mgr);
+    SAFE_DELETE(_group_commit_mgr);
     SAFE_DELETE(_stream_load_executor);
     SAFE_DELETE(_routine_load_task_executor);
     SAFE_DELETE(_external_scan_context_mgr);
@@ -39,6 +39,7 @@
 #include "runtime/datetime_value.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
+#include "runtime/fragment_replayer.h"
 #include "runtime/plan_fragment_executor.h"
 #include "runtime/runtime_filter_mgr.h"
 #include "runtime/stream_load/new_load_stream_mgr.h"
@@ -46,6 +47,7 @@
 #include "runtime/task_group/task_group_manager.h"
 #include "runtime/thread_context.h"
 #include "service/backend_options.h"
+#include "util/countdown_latch.h"
 #include "util/doris_metrics.h"
 #include "util/network_util.h"
 #include "util/stopwatch.hpp"
@@ -518,6 +520,9 @@ void FragmentMgr::_exec_actual(std::shared_ptr<FragmentExecState> exec_state,
 }
 
 Status FragmentMgr::exec_plan_fragment(const TExecPlanFragmentParams& params) {
+    if (config::enable_fragment_capture && !params.txn_conf.need_txn) {
+        FragmentCapturer::instance()->capture(params);
+    }
     if (params.txn_conf.need_txn) {
         std::shared_ptr<StreamLoadContext> stream_load_ctx =
                 std::make_shared<StreamLoadContext>(_exec_env);
@@ -554,7 +559,9 @@ Status FragmentMgr::exec_plan_fragment(const TExecPlanFragmentParams& params) {
 }
 
 Status FragmentMgr::exec_plan_fragment(const TPipelineFragmentParams& params) {
-    // TODO
+    if (config::enable_fragment_capture) {
+        FragmentCapturer::instance()->capture(params);
+    }
     return exec_plan_fragment(params, empty_function);
 }
 
@@ -651,6 +658,10 @@ Status FragmentMgr::_get_query_ctx(const Params& params, TUniqueId query_id, boo
             params.query_options.is_report_success) {
             fragments_ctx->query_mem_tracker->enable_print_log_usage();
         }
+        if (config::enable_query_memory_region) {
+            fragments_ctx->memory_region = std::make_shared<MemoryRegion>(
+                    fragments_ctx->query_mem_tracker, config::query_memory_region_max_bytes);
+        }
 
         if (pipeline) {
             int ts = fragments_ctx->timeout_second;
@@ -812,6 +823,8 @@ Status FragmentMgr::exec_plan_fragment(const TPipelineFragmentParams& params,
     std::shared_ptr<QueryFragmentsCtx> fragments_ctx;
     RETURN_IF_ERROR(_get_query_ctx(params, params.query_id, true, fragments_ctx));
 
+    std::vector<size_t> instance_indices;
+    std::vector<std::shared_ptr<pipeline::PipelineFragmentContext>> contexts;
     for (size_t i = 0; i < params.local_params.size(); i++) {
         const auto& local_params = params.local_params[i];
 
@@ -838,27 +851,31 @@ Status FragmentMgr::exec_plan_fragment(const TPipelineFragmentParams& params,
             exec_state->set_need_wait_execution_trigger();
         }
 
-        int64_t duration_ns = 0;
         if (!params.__isset.need_wait_execution_trigger || !params.need_wait_execution_trigger) {
             fragments_ctx->set_ready_to_execute_only();
         }
         _setup_shared_hashtable_for_broadcast_join(
                 params, local_params, exec_state->executor()->runtime_state(), fragments_ctx.get());
-        std::shared_ptr<pipeline::PipelineFragmentContext> context =
-                std::make_shared<pipeline::PipelineFragmentContext>(
-                        fragments_ctx->query_id, fragment_instance_id, params.fragment_id,
-                        local_params.backend_num, fragments_ctx, _exec_env, cb,
-                        std::bind<void>(std::mem_fn(&FragmentMgr::coordinator_callback), this,
-                                        std::placeholders::_1));
-        {
-            SCOPED_RAW_TIMER(&duration_ns);
-            auto prepare_st = context->prepare(params, i);
-            if (!prepare_st.ok()) {
-                context->close_if_prepare_failed();
-                return prepare_st;
+        instance_indices.push_back(i);
+        contexts.push_back(std::make_shared<pipeline::PipelineFragmentContext>(
+                fragments_ctx->query_id, fragment_instance_id, params.fragment_id,
+                local_params.backend_num, fragments_ctx, _exec_env, cb,
+                std::bind<void>(std::mem_fn(&FragmentMgr::coordinator_callback), this,
+                                std::placeholders::_1)));
+    }
+
+    std::vector<Status> prepare_statuses(contexts.size());
+    _prepare_pipeline_contexts(params, instance_indices, contexts, &prepare_statuses);
+    for (size_t i = 0; i < contexts.size(); i++) {
+        if (!prepare_statuses[i].ok()) {
+            // the instances not submitted yet are closed as well
+            for (size_t j = i; j < contexts.size(); j++) {
+                contexts[j]->close_if_prepare_failed();
             }
+            return prepare_statuses[i];
         }
-        g_fragmentmgr_prepare_latency << (duration_ns / 1000);
+        auto& context = contexts[i];
+        const auto& local_params = params.local_params[instance_indices[i]];
 
         std::shared_ptr<RuntimeFilterMergeControllerEntity> handler;
         _runtimefilter_controller.add_entity(params, local_params, &handler,
@@ -867,7 +884,7 @@ Status FragmentMgr::exec_plan_fragment(const TPipelineFragmentParams& params,
 
         {
             std::lock_guard<std::mutex> lock(_lock);
-            _pipeline_map.insert(std::make_pair(fragment_instance_id, context));
+            _pipeline_map.insert(std::make_pair(local_params.fragment_instance_id, context));
             _cv.notify_all();
         }
         RETURN_IF_ERROR(context->submit());
@@ -876,6 +893,53 @@ Status FragmentMgr::exec_plan_fragment(const TPipelineFragmentParams& params,
     return Status::OK();
 }
 
+void FragmentMgr::_prepare_pipeline_contexts(
+        const TPipelineFragmentParams& params, const std::vector<size_t>& instance_indices,
+        const std::vector<std::shared_ptr<pipeline::PipelineFragmentContext>>& contexts,
+        std::vector<Status>* statuses) {
+    auto prepare = [&](size_t i) {
+        int64_t duration_ns = 0;
+        {
+            SCOPED_RAW_TIMER(&duration_ns);
+            (*statuses)[i] = contexts[i]->prepare(params, instance_indices[i]);
+        }
+        g_fragmentmgr_prepare_latency << (duration_ns / 1000);
+    };
+
+    // The instances sharing a scan are prepared in order, since the first one to prepare the
+    // scan node creates the scanners of all of them.
+    auto* thread_pool = _exec_env->fragment_prepare_thread_pool();
+    size_t num_contexts = contexts.size();
+    if (thread_pool == nullptr || config::fragment_parallel_prepare_min_instances <= 0 ||
+        static_cast<int>(num_contexts) < config::fragment_parallel_prepare_min_instances ||
+        (params.__isset.shared_scan_opt && params.shared_scan_opt)) {
+        for (size_t i = 0; i < num_contexts; i++) {
+            prepare(i);
+        }
+        return;
+    }
+
+    CountDownLatch latch(num_contexts);
+    for (size_t i = 0; i < num_contexts; i++) {
+        // the rpc thread prepares the last instance itself, and the ones which can not be
+        // submitted
+        bool submitted = false;
+        if (i + 1 < num_contexts) {
+            submitted = thread_pool
+                                ->submit_func([&, i]() {
+                                    prepare(i);
+                                    latch.count_down();
+                                })
+                                .ok();
+        }
+        if (!submitted) {
+            prepare(i);
+            latch.count_down();
+        }
+    }
+    latch.wait();
+}
+
 void FragmentMgr::_set_scan_concurrency(const TExecPlanFragmentParams& params,
                                         QueryFragmentsCtx* fragments_ctx) {
 #ifndef BE_TEST
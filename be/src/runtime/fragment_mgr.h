@@ -151,6 +151,13 @@ private:
                                                     RuntimeState* state,
                                                     QueryFragmentsCtx* fragments_ctx);
 
+    // Prepares the contexts of the instances params.local_params[instance_indices[i]], in
+    // parallel if there are many of them.
+    void _prepare_pipeline_contexts(
+            const TPipelineFragmentParams& params, const std::vector<size_t>& instance_indices,
+            const std::vector<std::shared_ptr<pipeline::PipelineFragmentContext>>& contexts,
+            std::vector<Status>* statuses);
+
     template <typename Params>
     Status _get_query_ctx(const Params& params, TUniqueId query_id, bool pipeline,
                           std::shared_ptr<QueryFragmentsCtx>& fragments_ctx);
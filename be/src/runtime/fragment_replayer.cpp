@@ -0,0 +1,487 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/fragment_replayer.h"
+
+#include <brpc/controller.h>
+#include <fmt/format.h>
+#include <gen_cpp/Data_types.h>
+#include <gen_cpp/internal_service.pb.h>
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "runtime/buffer_control_block.h"
+#include "runtime/exec_env.h"
+#include "runtime/fragment_mgr.h"
+#include "runtime/result_buffer_mgr.h"
+#include "runtime/runtime_state.h"
+#include "service/backend_options.h"
+#include "util/network_util.h"
+#include "util/runtime_profile.h"
+#include "util/stopwatch.hpp"
+#include "util/string_util.h"
+#include "util/thrift_util.h"
+
+namespace doris {
+
+namespace {
+
+const std::string FRAGMENT_SUFFIX = ".fragment";
+const std::string PIPELINE_FRAGMENT_SUFFIX = ".pipeline";
+
+// Only the queries returning the results to the client are captured, e.g. not the ones writing
+// files by SELECT INTO OUTFILE, so that replaying them has no side effect.
+bool is_replayable(const TQueryOptions& query_options, const TPlanFragment& fragment) {
+    if (query_options.__isset.query_type && query_options.query_type != TQueryType::SELECT) {
+        return false;
+    }
+    if (!fragment.__isset.output_sink) {
+        return false;
+    }
+    auto type = fragment.output_sink.type;
+    return type == TDataSinkType::RESULT_SINK || type == TDataSinkType::DATA_STREAM_SINK;
+}
+
+template <typename Params>
+Status read_params(const std::string& path, Params* params) {
+    std::ifstream file(path, std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (!file.good() && !file.eof()) {
+        return Status::IOError("failed to read {}", path);
+    }
+    uint32_t len = content.size();
+    return deserialize_thrift_msg(reinterpret_cast<const uint8_t*>(content.data()), &len, true,
+                                  params);
+}
+
+int64_t timeval_to_ns(const timeval& tv) {
+    return tv.tv_sec * 1000000000L + tv.tv_usec * 1000L;
+}
+
+// The instances done, counted by the finish callbacks of FragmentMgr.
+struct ReplayState {
+    std::mutex lock;
+    std::condition_variable cv;
+    size_t finished = 0;
+    Status status;
+    bool collect_profile = false;
+    std::stringstream profile;
+
+    void on_finish(RuntimeState* state, Status* status) {
+        std::lock_guard<std::mutex> l(lock);
+        if (!status->ok() && this->status.ok()) {
+            this->status = *status;
+        }
+        if (collect_profile && state != nullptr && state->runtime_profile() != nullptr) {
+            state->runtime_profile()->pretty_print(&profile);
+        }
+        ++finished;
+        cv.notify_all();
+    }
+
+    bool wait(size_t num_instances, int64_t timeout_s) {
+        std::unique_lock<std::mutex> l(lock);
+        return cv.wait_for(l, std::chrono::seconds(timeout_s),
+                           [&]() { return finished >= num_instances; });
+    }
+};
+
+class FetchDataClosure : public google::protobuf::Closure {
+public:
+    void Run() override {
+        std::lock_guard<std::mutex> l(_lock);
+        _done = true;
+        _cv.notify_all();
+    }
+
+    bool wait(int64_t deadline_ms) {
+        std::unique_lock<std::mutex> l(_lock);
+        return _cv.wait_until(l,
+                              std::chrono::steady_clock::time_point(
+                                      std::chrono::milliseconds(deadline_ms)),
+                              [this]() { return _done; });
+    }
+
+private:
+    std::mutex _lock;
+    std::condition_variable _cv;
+    bool _done = false;
+};
+
+int64_t steady_now_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+}
+
+} // namespace
+
+void FragmentCapturer::capture(const TExecPlanFragmentParams& params) {
+    if (!is_replayable(params.query_options, params.fragment)) {
+        return;
+    }
+    _capture(params.params.query_id, params.params.fragment_instance_id, FRAGMENT_SUFFIX.c_str(),
+             params);
+}
+
+void FragmentCapturer::capture(const TPipelineFragmentParams& params) {
+    if (params.local_params.empty() || !is_replayable(params.query_options, params.fragment)) {
+        return;
+    }
+    _capture(params.query_id, params.local_params[0].fragment_instance_id,
+             PIPELINE_FRAGMENT_SUFFIX.c_str(), params);
+}
+
+template <typename Params>
+void FragmentCapturer::_capture(const TUniqueId& query_id, const TUniqueId& instance_id,
+                                const char* suffix, const Params& params) {
+    std::string query_dir = fmt::format("{}/{}", config::fragment_capture_dir, print_id(query_id));
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        if (!_loaded) {
+            // the queries captured before restarting
+            std::error_code ec;
+            for (const auto& entry :
+                 std::filesystem::directory_iterator(config::fragment_capture_dir, ec)) {
+                _queries.insert(entry.path().filename().string());
+            }
+            _loaded = true;
+        }
+        if (_queries.count(print_id(query_id)) == 0) {
+            int32_t max_queries = config::fragment_capture_max_queries;
+            if (max_queries <= 0 || _queries.size() >= static_cast<size_t>(max_queries)) {
+                return;
+            }
+            std::error_code ec;
+            std::filesystem::create_directories(query_dir, ec);
+            if (ec) {
+                LOG(WARNING) << "failed to create " << query_dir << ": " << ec.message();
+                return;
+            }
+            _queries.insert(print_id(query_id));
+        }
+    }
+
+    std::string content;
+    ThriftSerializer serializer(true, 4096);
+    Status st = serializer.serialize(const_cast<Params*>(&params), &content);
+    if (!st.ok()) {
+        LOG(WARNING) << "failed to serialize the fragment " << print_id(instance_id) << ": " << st;
+        return;
+    }
+    // the order of receiving the fragments is kept, since only the first one of the query carries
+    // the common params if `is_simplified_param`
+    std::string path = fmt::format("{}/{:08d}_{}{}", query_dir, _next_seq.fetch_add(1),
+                                   print_id(instance_id), suffix);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(content.data(), content.size());
+    if (!file.good()) {
+        LOG(WARNING) << "failed to write " << path;
+    }
+}
+
+std::vector<std::string> FragmentCapturer::list_queries() {
+    std::vector<std::string> queries;
+    std::error_code ec;
+    for (const auto& entry :
+         std::filesystem::directory_iterator(config::fragment_capture_dir, ec)) {
+        if (entry.is_directory()) {
+            queries.push_back(entry.path().filename().string());
+        }
+    }
+    std::sort(queries.begin(), queries.end());
+    return queries;
+}
+
+Status FragmentReplayer::init() {
+    std::vector<std::string> paths;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(_dir, ec)) {
+        paths.push_back(entry.path().string());
+    }
+    if (ec) {
+        return Status::NotFound("failed to list {}: {}", _dir, ec.message());
+    }
+    std::sort(paths.begin(), paths.end());
+
+    for (const auto& path : paths) {
+        if (ends_with(path, FRAGMENT_SUFFIX)) {
+            TExecPlanFragmentParams params;
+            RETURN_IF_ERROR(read_params(path, &params));
+            _fragments.push_back(std::move(params));
+        } else if (ends_with(path, PIPELINE_FRAGMENT_SUFFIX)) {
+            TPipelineFragmentParams params;
+            RETURN_IF_ERROR(read_params(path, &params));
+            _pipeline_fragments.push_back(std::move(params));
+        }
+    }
+    if (_fragments.empty() == _pipeline_fragments.empty()) {
+        return Status::InvalidArgument("no fragments or fragments of both engines in {}", _dir);
+    }
+
+    auto add_instance = [this](const TUniqueId& instance_id, const TPlanFragment& fragment) {
+        _instance_ids.insert(instance_id);
+        if (fragment.output_sink.type == TDataSinkType::RESULT_SINK) {
+            _result_instance_ids.push_back(instance_id);
+        }
+        ++_num_instances;
+    };
+    for (const auto& params : _fragments) {
+        _query_id = params.params.query_id;
+        add_instance(params.params.fragment_instance_id, params.fragment);
+    }
+    for (const auto& params : _pipeline_fragments) {
+        _query_id = params.query_id;
+        for (const auto& local_params : params.local_params) {
+            add_instance(local_params.fragment_instance_id, params.fragment);
+        }
+    }
+
+    // the fragments captured on different backends are run as the ones of a single backend, so
+    // the common params are only taken from the first one
+    auto is_full_param = [](const auto& params) {
+        return !params.__isset.is_simplified_param || !params.is_simplified_param;
+    };
+    auto sort_params = [&](auto* fragments) {
+        std::stable_partition(fragments->begin(), fragments->end(), is_full_param);
+        if (fragments->empty() || !is_full_param(fragments->front())) {
+            return Status::InvalidArgument("the first fragment of the query is not in {}", _dir);
+        }
+        for (size_t i = 1; i < fragments->size(); ++i) {
+            (*fragments)[i].__set_is_simplified_param(true);
+        }
+        return Status::OK();
+    };
+    if (!_fragments.empty()) {
+        RETURN_IF_ERROR(sort_params(&_fragments));
+    } else {
+        RETURN_IF_ERROR(sort_params(&_pipeline_fragments));
+    }
+    return Status::OK();
+}
+
+Status FragmentReplayer::_rewrite_id(const TUniqueId& query_id, TUniqueId* id) const {
+    // -1 is for the destinations without any instance
+    if (id->lo == -1) {
+        return Status::OK();
+    }
+    if (_instance_ids.count(*id) == 0) {
+        return Status::NotFound(
+                "instance {} of query {} is not captured, the fragments of all the backends are "
+                "needed",
+                print_id(*id), print_id(_query_id));
+    }
+    // the instance ids are derived from the query id by the coordinator
+    id->__set_hi(query_id.hi);
+    id->__set_lo(query_id.lo + (id->lo - _query_id.lo));
+    return Status::OK();
+}
+
+Status FragmentReplayer::_rewrite_destinations(
+        const TUniqueId& query_id, std::vector<TPlanFragmentDestination>* destinations) const {
+    for (auto& destination : *destinations) {
+        RETURN_IF_ERROR(_rewrite_id(query_id, &destination.fragment_instance_id));
+        destination.__set_server(
+                make_network_address(BackendOptions::get_localhost(), config::be_port));
+        destination.__set_brpc_server(
+                make_network_address(BackendOptions::get_localhost(), config::brpc_port));
+    }
+    return Status::OK();
+}
+
+Status FragmentReplayer::_rewrite_runtime_filter_params(const TUniqueId& query_id,
+                                                        TRuntimeFilterParams* params) const {
+    auto local_brpc_addr = make_network_address(BackendOptions::get_localhost(), config::brpc_port);
+    if (params->__isset.runtime_filter_merge_addr) {
+        params->__set_runtime_filter_merge_addr(local_brpc_addr);
+    }
+    for (auto& [filter_id, targets] : params->rid_to_target_param) {
+        for (auto& target : targets) {
+            RETURN_IF_ERROR(_rewrite_id(query_id, &target.target_fragment_instance_id));
+            target.__set_target_fragment_instance_addr(local_brpc_addr);
+        }
+    }
+    return Status::OK();
+}
+
+Status FragmentReplayer::_rewrite(const TUniqueId& query_id,
+                                  TExecPlanFragmentParams* params) const {
+    auto& exec_params = params->params;
+    exec_params.__set_query_id(query_id);
+    RETURN_IF_ERROR(_rewrite_id(query_id, &exec_params.fragment_instance_id));
+    RETURN_IF_ERROR(_rewrite_destinations(query_id, &exec_params.destinations));
+    if (exec_params.__isset.runtime_filter_params) {
+        RETURN_IF_ERROR(
+                _rewrite_runtime_filter_params(query_id, &exec_params.runtime_filter_params));
+    }
+    for (auto& instance_id : params->instances_sharing_hash_table) {
+        RETURN_IF_ERROR(_rewrite_id(query_id, &instance_id));
+    }
+    params->__set_fragment_num_on_host(_num_instances);
+    params->__set_need_wait_execution_trigger(false);
+    params->__set_is_report_success(false);
+    params->query_options.__set_is_report_success(false);
+    return Status::OK();
+}
+
+Status FragmentReplayer::_rewrite(const TUniqueId& query_id,
+                                  TPipelineFragmentParams* params) const {
+    params->__set_query_id(query_id);
+    RETURN_IF_ERROR(_rewrite_destinations(query_id, &params->destinations));
+    for (auto& local_params : params->local_params) {
+        RETURN_IF_ERROR(_rewrite_id(query_id, &local_params.fragment_instance_id));
+        if (local_params.__isset.runtime_filter_params) {
+            RETURN_IF_ERROR(
+                    _rewrite_runtime_filter_params(query_id, &local_params.runtime_filter_params));
+        }
+    }
+    for (auto& instance_id : params->instances_sharing_hash_table) {
+        RETURN_IF_ERROR(_rewrite_id(query_id, &instance_id));
+    }
+    params->__set_fragment_num_on_host(_num_instances);
+    params->__set_need_wait_execution_trigger(false);
+    params->query_options.__set_is_report_success(false);
+    return Status::OK();
+}
+
+Status FragmentReplayer::replay(bool collect_profile, int64_t timeout_s, Result* result) {
+    TUniqueId query_id = UniqueId::gen_uid().to_thrift();
+    // the ids are rewritten before running any fragment, so that nothing is left running if the
+    // capture is incomplete
+    std::vector<TExecPlanFragmentParams> fragments = _fragments;
+    for (auto& params : fragments) {
+        RETURN_IF_ERROR(_rewrite(query_id, &params));
+    }
+    std::vector<TPipelineFragmentParams> pipeline_fragments = _pipeline_fragments;
+    for (auto& params : pipeline_fragments) {
+        RETURN_IF_ERROR(_rewrite(query_id, &params));
+    }
+    std::vector<TUniqueId> result_instance_ids = _result_instance_ids;
+    for (auto& instance_id : result_instance_ids) {
+        RETURN_IF_ERROR(_rewrite_id(query_id, &instance_id));
+    }
+
+    auto* fragment_mgr = _exec_env->fragment_mgr();
+    // the callbacks may be called after returning on timeout
+    auto state = std::make_shared<ReplayState>();
+    state->collect_profile = collect_profile;
+    auto cb = [state](RuntimeState* runtime_state, Status* status) {
+        state->on_finish(runtime_state, status);
+    };
+    auto cancel_all = [&](const std::string& msg) {
+        fragment_mgr->cancel_query(query_id, PPlanFragmentCancelReason::INTERNAL_ERROR, msg);
+        for (const auto& instance_id : result_instance_ids) {
+            static_cast<void>(_exec_env->result_mgr()->cancel(instance_id));
+        }
+    };
+
+    rusage start_usage;
+    getrusage(RUSAGE_SELF, &start_usage);
+    MonotonicStopWatch watch;
+    watch.start();
+
+    Status st;
+    for (auto& params : fragments) {
+        st = fragment_mgr->exec_plan_fragment(params, cb);
+        if (!st.ok()) {
+            break;
+        }
+    }
+    for (auto& params : pipeline_fragments) {
+        if (!st.ok()) {
+            break;
+        }
+        st = fragment_mgr->exec_plan_fragment(params, cb);
+    }
+    if (!st.ok()) {
+        cancel_all("failed to replay the fragments");
+        // only the instances started call back
+        state->wait(_num_instances, std::min<int64_t>(timeout_s, 10));
+        return st;
+    }
+
+    // drain the results, or the result sinks are blocked once the buffers are full
+    int64_t deadline_ms = steady_now_ms() + timeout_s * 1000;
+    for (const auto& instance_id : result_instance_ids) {
+        PUniqueId finst_id;
+        finst_id.set_hi(instance_id.hi);
+        finst_id.set_lo(instance_id.lo);
+        bool eos = false;
+        while (st.ok() && !eos) {
+            brpc::Controller cntl;
+            PFetchDataResult fetch_result;
+            FetchDataClosure done;
+            // deleted by itself once done
+            auto* ctx = new GetResultBatchCtx(&cntl, &fetch_result, &done);
+            _exec_env->result_mgr()->fetch_data(finst_id, ctx);
+            if (!done.wait(deadline_ms)) {
+                st = Status::TimedOut("replaying query {} timed out", print_id(_query_id));
+                cancel_all("replaying timed out");
+                // the waiting fetch fails on cancelling
+                done.wait(steady_now_ms() + 10000);
+                break;
+            }
+            st = Status(fetch_result.status());
+            if (!st.ok()) {
+                break;
+            }
+            eos = fetch_result.eos();
+            if (fetch_result.has_row_batch()) {
+                TResultBatch batch;
+                uint32_t len = fetch_result.row_batch().size();
+                st = deserialize_thrift_msg(
+                        reinterpret_cast<const uint8_t*>(fetch_result.row_batch().data()), &len,
+                        false, &batch);
+                result->result_rows += batch.rows.size();
+                result->result_bytes += fetch_result.row_batch().size();
+            }
+        }
+    }
+    if (!st.ok()) {
+        cancel_all("failed to fetch the results of replaying");
+        state->wait(_num_instances, std::min<int64_t>(timeout_s, 10));
+        return st;
+    }
+    int64_t remaining_s = std::max<int64_t>((deadline_ms - steady_now_ms()) / 1000, 1);
+    if (!state->wait(_num_instances, remaining_s)) {
+        cancel_all("replaying timed out");
+        return Status::TimedOut("replaying query {} timed out", print_id(_query_id));
+    }
+
+    watch.stop();
+    rusage end_usage;
+    getrusage(RUSAGE_SELF, &end_usage);
+    result->latency_ns = watch.elapsed_time();
+    result->user_cpu_ns = timeval_to_ns(end_usage.ru_utime) - timeval_to_ns(start_usage.ru_utime);
+    result->sys_cpu_ns = timeval_to_ns(end_usage.ru_stime) - timeval_to_ns(start_usage.ru_stime);
+    std::lock_guard<std::mutex> l(state->lock);
+    if (collect_profile) {
+        result->profile = state->profile.str();
+    }
+    return state->status;
+}
+
+} // namespace doris
@@ -0,0 +1,115 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <gen_cpp/PaloInternalService_types.h>
+#include <gen_cpp/Types_types.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "util/uid_util.h"
+
+namespace doris {
+
+class ExecEnv;
+
+// Saves the params of the query fragments received by this backend, including their scan ranges,
+// into `config::fragment_capture_dir`/<query_id>/ if `config::enable_fragment_capture` is on.
+class FragmentCapturer {
+public:
+    static FragmentCapturer* instance() {
+        static FragmentCapturer capturer;
+        return &capturer;
+    }
+
+    void capture(const TExecPlanFragmentParams& params);
+    void capture(const TPipelineFragmentParams& params);
+
+    // The ids of the captured queries.
+    std::vector<std::string> list_queries();
+
+private:
+    FragmentCapturer() = default;
+
+    template <typename Params>
+    void _capture(const TUniqueId& query_id, const TUniqueId& instance_id, const char* suffix,
+                  const Params& params);
+
+    std::mutex _lock;
+    bool _loaded = false;
+    std::set<std::string> _queries;
+    std::atomic<int64_t> _next_seq {0};
+};
+
+// Replays the captured fragments of a query on this backend, which must have the tablets scanned
+// by them, e.g. the fragments of all the backends are copied into one directory and replayed on a
+// backend with the copies of the data.
+//
+// Each run gets a new query id and new instance ids, the exchanges and the runtime filters are
+// redirected to this backend, and the fragments don't report to the coordinator on success.
+class FragmentReplayer {
+public:
+    struct Result {
+        int64_t latency_ns = 0;
+        // of the whole process, so it's only accurate on an otherwise idle backend
+        int64_t user_cpu_ns = 0;
+        int64_t sys_cpu_ns = 0;
+        int64_t result_rows = 0;
+        int64_t result_bytes = 0;
+        // the runtime profiles of the instances if asked
+        std::string profile;
+    };
+
+    FragmentReplayer(ExecEnv* exec_env, std::string dir) : _exec_env(exec_env), _dir(dir) {}
+
+    // Reads the captured fragments in the directory.
+    Status init();
+
+    // Runs the fragments once and waits for them to finish in `timeout_s`.
+    Status replay(bool collect_profile, int64_t timeout_s, Result* result);
+
+    size_t num_instances() const { return _num_instances; }
+
+private:
+    // Rewrites the ids and the addresses in the params for a new run of the query.
+    Status _rewrite(const TUniqueId& query_id, TExecPlanFragmentParams* params) const;
+    Status _rewrite(const TUniqueId& query_id, TPipelineFragmentParams* params) const;
+    Status _rewrite_id(const TUniqueId& query_id, TUniqueId* id) const;
+    Status _rewrite_destinations(const TUniqueId& query_id,
+                                 std::vector<TPlanFragmentDestination>* destinations) const;
+    Status _rewrite_runtime_filter_params(const TUniqueId& query_id,
+                                          TRuntimeFilterParams* params) const;
+
+    ExecEnv* _exec_env;
+    std::string _dir;
+
+    TUniqueId _query_id;
+    std::vector<TExecPlanFragmentParams> _fragments;
+    std::vector<TPipelineFragmentParams> _pipeline_fragments;
+    std::set<UniqueId> _instance_ids;
+    std::vector<TUniqueId> _result_instance_ids;
+    size_t _num_instances = 0;
+};
+
+} // namespace doris
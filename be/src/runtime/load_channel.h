@@ -81,6 +81,20 @@ public:
         }
     }
 
+    // pair<index_id, tablet_id> of the writers whose memtable has been written for max_age_ms
+    // or longer
+    void get_writers_with_aged_memtable(int64_t max_age_ms,
+                                        std::vector<std::pair<int64_t, int64_t>>* writers) {
+        std::lock_guard<SpinLock> l(_tablets_channels_lock);
+        for (auto& it : _tablets_channels) {
+            std::vector<int64_t> tablet_ids;
+            it.second->get_writers_with_aged_memtable(max_age_ms, &tablet_ids);
+            for (auto tablet_id : tablet_ids) {
+                writers->emplace_back(it.first, tablet_id);
+            }
+        }
+    }
+
     int64_t timeout() const { return _timeout_s; }
 
     bool is_high_priority() const { return _is_high_priority; }
@@ -114,7 +128,7 @@ protected:
                 this, request.sender_id(), request.backend_id(), &finished, request.partition_ids(),
                 response->mutable_tablet_vec(), response->mutable_tablet_errors(),
                 request.slave_tablet_nodes(), response->mutable_success_slave_tablet_node_ids(),
-                request.write_single_replica()));
+                request.write_single_replica(), response->mutable_load_statistics()));
         if (finished) {
             std::lock_guard<std::mutex> l(_lock);
             {
@@ -35,6 +35,8 @@ namespace doris {
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(load_channel_count, MetricUnit::NOUNIT);
 DEFINE_GAUGE_METRIC_PROTOTYPE_5ARG(load_channel_mem_consumption, MetricUnit::BYTES, "",
                                    mem_consumption, Labels({{"type", "load"}}));
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(load_channel_proactive_flush_writer_count, MetricUnit::NOUNIT);
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(load_channel_throttled_time_ms, MetricUnit::MILLISECONDS);
 
 // Calculate the total memory limit of all load tasks on this BE
 static int64_t calc_process_max_load_memory(int64_t process_mem_limit) {
@@ -59,15 +61,24 @@ LoadChannelMgr::LoadChannelMgr() : _stop_background_threads_latch(1) {
         // std::lock_guard<std::mutex> l(_lock);
         return _load_channels.size();
     });
+    REGISTER_HOOK_METRIC(load_channel_proactive_flush_writer_count,
+                         [this]() { return _proactive_flush_writer_count.load(); });
+    REGISTER_HOOK_METRIC(load_channel_throttled_time_ms,
+                         [this]() { return _throttled_time_ms.load(); });
 }
 
 LoadChannelMgr::~LoadChannelMgr() {
     DEREGISTER_HOOK_METRIC(load_channel_count);
     DEREGISTER_HOOK_METRIC(load_channel_mem_consumption);
+    DEREGISTER_HOOK_METRIC(load_channel_proactive_flush_writer_count);
+    DEREGISTER_HOOK_METRIC(load_channel_throttled_time_ms);
     _stop_background_threads_latch.count_down();
     if (_load_channels_clean_thread) {
         _load_channels_clean_thread->join();
     }
+    if (_proactive_flush_thread) {
+        _proactive_flush_thread->join();
+    }
     delete _last_success_channel;
 }
 
@@ -168,6 +179,16 @@ Status LoadChannelMgr::_start_bg_worker() {
             },
             &_load_channels_clean_thread));
 
+    RETURN_IF_ERROR(Thread::create(
+            "LoadChannelMgr", "proactive_flush_memtables",
+            [this]() {
+                while (!_stop_background_threads_latch.wait_for(
+                        std::chrono::milliseconds(config::load_proactive_flush_interval_ms))) {
+                    _proactive_flush_memtables();
+                }
+            },
+            &_proactive_flush_thread));
+
     return Status::OK();
 }
 
@@ -213,6 +234,129 @@ Status LoadChannelMgr::_start_load_channels_clean() {
     return Status::OK();
 }
 
+int64_t LoadChannelMgr::_flush_largest_writers_without_lock(
+        int64_t mem_to_flushed, std::vector<WriterToReduceMem>* writers) {
+    // tuple<LoadChannel, index_id, multimap<mem size, tablet_id>>
+    using WritersMem = std::tuple<std::shared_ptr<LoadChannel>, int64_t,
+                                  std::multimap<int64_t, int64_t, std::greater<int64_t>>>;
+    std::vector<WritersMem> all_writers_mem;
+
+    // tuple<current iterator in multimap, end iterator in multimap, pos in all_writers_mem>
+    using WriterMemItem =
+            std::tuple<std::multimap<int64_t, int64_t, std::greater<int64_t>>::iterator,
+                       std::multimap<int64_t, int64_t, std::greater<int64_t>>::iterator, size_t>;
+    auto cmp = [](WriterMemItem& lhs, WriterMemItem& rhs) {
+        return std::get<0>(lhs)->first < std::get<0>(rhs)->first;
+    };
+    std::priority_queue<WriterMemItem, std::vector<WriterMemItem>, decltype(cmp)>
+            tablets_mem_heap(cmp);
+
+    for (auto& kv : _load_channels) {
+        if (kv.second->is_high_priority()) {
+            // do not select high priority channel to reduce memory
+            // to avoid blocking them.
+            continue;
+        }
+        std::vector<std::pair<int64_t, std::multimap<int64_t, int64_t, std::greater<int64_t>>>>
+                writers_mem_snap;
+        kv.second->get_writers_mem_consumption_snapshot(&writers_mem_snap);
+        for (auto item : writers_mem_snap) {
+            // multimap is empty
+            if (item.second.empty()) {
+                continue;
+            }
+            all_writers_mem.emplace_back(kv.second, item.first, std::move(item.second));
+            size_t pos = all_writers_mem.size() - 1;
+            tablets_mem_heap.emplace(std::get<2>(all_writers_mem[pos]).begin(),
+                                     std::get<2>(all_writers_mem[pos]).end(), pos);
+        }
+    }
+
+    int64_t mem_consumption_in_picked_writer = 0;
+    while (!tablets_mem_heap.empty()) {
+        WriterMemItem tablet_mem_item = tablets_mem_heap.top();
+        size_t pos = std::get<2>(tablet_mem_item);
+        auto load_channel = std::get<0>(all_writers_mem[pos]);
+        int64_t index_id = std::get<1>(all_writers_mem[pos]);
+        int64_t tablet_id = std::get<0>(tablet_mem_item)->second;
+        int64_t mem_size = std::get<0>(tablet_mem_item)->first;
+        writers->emplace_back(load_channel, index_id, tablet_id, mem_size);
+        load_channel->flush_memtable_async(index_id, tablet_id);
+        mem_consumption_in_picked_writer += std::get<0>(tablet_mem_item)->first;
+        if (mem_consumption_in_picked_writer > mem_to_flushed) {
+            break;
+        }
+        tablets_mem_heap.pop();
+        if (std::get<0>(tablet_mem_item)++ != std::get<1>(tablet_mem_item)) {
+            tablets_mem_heap.push(tablet_mem_item);
+        }
+    }
+    return mem_consumption_in_picked_writer;
+}
+
+void LoadChannelMgr::_proactive_flush_memtables() {
+    std::vector<WriterToReduceMem> writers_to_flush;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        // some load rpc is reducing the memory
+        if (_soft_reduce_mem_in_progress || _should_wait_flush) {
+            return;
+        }
+        int64_t max_age_ms = config::memtable_flush_max_age_sec * 1000L;
+        if (max_age_ms > 0) {
+            for (auto& kv : _load_channels) {
+                if (kv.second->is_high_priority()) {
+                    continue;
+                }
+                std::vector<std::pair<int64_t, int64_t>> aged_writers;
+                kv.second->get_writers_with_aged_memtable(max_age_ms, &aged_writers);
+                for (auto& writer : aged_writers) {
+                    kv.second->flush_memtable_async(writer.first, writer.second);
+                    writers_to_flush.emplace_back(kv.second, writer.first, writer.second, 0);
+                }
+            }
+        }
+        if (_load_soft_mem_limit > 0 &&
+            _mem_tracker->consumption() >=
+                    _load_soft_mem_limit * config::load_proactive_flush_mem_percent / 100) {
+            _flush_largest_writers_without_lock(_mem_tracker->consumption() / 10,
+                                                &writers_to_flush);
+        }
+        if (writers_to_flush.empty()) {
+            return;
+        }
+        // the load rpcs below the hard limit are throttled instead of picking more writers
+        _soft_reduce_mem_in_progress = true;
+    }
+
+    _proactive_flush_writer_count += writers_to_flush.size();
+    for (auto& item : writers_to_flush) {
+        std::get<0>(item)->wait_flush(std::get<1>(item), std::get<2>(item));
+    }
+
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        _soft_reduce_mem_in_progress = false;
+        _refresh_mem_tracker_without_lock();
+    }
+}
+
+void LoadChannelMgr::_throttle_on_soft_limit() {
+    int64_t consumption = _mem_tracker->consumption();
+    if (config::load_mem_throttle_max_sleep_ms <= 0 || consumption <= _load_soft_mem_limit ||
+        _load_hard_mem_limit <= _load_soft_mem_limit) {
+        return;
+    }
+    int64_t sleep_ms = std::min<int64_t>(
+            config::load_mem_throttle_max_sleep_ms,
+            config::load_mem_throttle_max_sleep_ms * (consumption - _load_soft_mem_limit) /
+                    (_load_hard_mem_limit - _load_soft_mem_limit));
+    if (sleep_ms > 0) {
+        _throttled_time_ms += sleep_ms;
+        std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms));
+    }
+}
+
 void LoadChannelMgr::_handle_mem_exceed_limit() {
     // Check the soft limit.
     DCHECK(_load_soft_mem_limit > 0);
@@ -227,9 +371,7 @@ void LoadChannelMgr::_handle_mem_exceed_limit() {
     }
     // Indicate whether current thread is reducing mem on hard limit.
     bool reducing_mem_on_hard_limit = false;
-    // tuple<LoadChannel, index_id, tablet_id, mem_size>
-    std::vector<std::tuple<std::shared_ptr<LoadChannel>, int64_t, int64_t, int64_t>>
-            writers_to_reduce_mem;
+    std::vector<WriterToReduceMem> writers_to_reduce_mem;
     {
         std::unique_lock<std::mutex> l(_lock);
         while (_should_wait_flush) {
@@ -242,67 +384,14 @@ void LoadChannelMgr::_handle_mem_exceed_limit() {
         // Some other thread is flushing data, and not reached hard limit now,
         // we don't need to handle mem limit in current thread.
         if (_soft_reduce_mem_in_progress && !hard_limit_reached) {
+            l.unlock();
+            _throttle_on_soft_limit();
             return;
         }
 
-        // tuple<LoadChannel, index_id, multimap<mem size, tablet_id>>
-        using WritersMem = std::tuple<std::shared_ptr<LoadChannel>, int64_t,
-                                      std::multimap<int64_t, int64_t, std::greater<int64_t>>>;
-        std::vector<WritersMem> all_writers_mem;
-
-        // tuple<current iterator in multimap, end iterator in multimap, pos in all_writers_mem>
-        using WriterMemItem =
-                std::tuple<std::multimap<int64_t, int64_t, std::greater<int64_t>>::iterator,
-                           std::multimap<int64_t, int64_t, std::greater<int64_t>>::iterator,
-                           size_t>;
-        auto cmp = [](WriterMemItem& lhs, WriterMemItem& rhs) {
-            return std::get<0>(lhs)->first < std::get<0>(rhs)->first;
-        };
-        std::priority_queue<WriterMemItem, std::vector<WriterMemItem>, decltype(cmp)>
-                tablets_mem_heap(cmp);
-
-        for (auto& kv : _load_channels) {
-            if (kv.second->is_high_priority()) {
-                // do not select high priority channel to reduce memory
-                // to avoid blocking them.
-                continue;
-            }
-            std::vector<std::pair<int64_t, std::multimap<int64_t, int64_t, std::greater<int64_t>>>>
-                    writers_mem_snap;
-            kv.second->get_writers_mem_consumption_snapshot(&writers_mem_snap);
-            for (auto item : writers_mem_snap) {
-                // multimap is empty
-                if (item.second.empty()) {
-                    continue;
-                }
-                all_writers_mem.emplace_back(kv.second, item.first, std::move(item.second));
-                size_t pos = all_writers_mem.size() - 1;
-                tablets_mem_heap.emplace(std::get<2>(all_writers_mem[pos]).begin(),
-                                         std::get<2>(all_writers_mem[pos]).end(), pos);
-            }
-        }
-
         // reduce 1/10 memory every time
-        int64_t mem_to_flushed = _mem_tracker->consumption() / 10;
-        int64_t mem_consumption_in_picked_writer = 0;
-        while (!tablets_mem_heap.empty()) {
-            WriterMemItem tablet_mem_item = tablets_mem_heap.top();
-            size_t pos = std::get<2>(tablet_mem_item);
-            auto load_channel = std::get<0>(all_writers_mem[pos]);
-            int64_t index_id = std::get<1>(all_writers_mem[pos]);
-            int64_t tablet_id = std::get<0>(tablet_mem_item)->second;
-            int64_t mem_size = std::get<0>(tablet_mem_item)->first;
-            writers_to_reduce_mem.emplace_back(load_channel, index_id, tablet_id, mem_size);
-            load_channel->flush_memtable_async(index_id, tablet_id);
-            mem_consumption_in_picked_writer += std::get<0>(tablet_mem_item)->first;
-            if (mem_consumption_in_picked_writer > mem_to_flushed) {
-                break;
-            }
-            tablets_mem_heap.pop();
-            if (std::get<0>(tablet_mem_item)++ != std::get<1>(tablet_mem_item)) {
-                tablets_mem_heap.push(tablet_mem_item);
-            }
-        }
+        int64_t mem_consumption_in_picked_writer = _flush_largest_writers_without_lock(
+                _mem_tracker->consumption() / 10, &writers_to_reduce_mem);
 
         if (writers_to_reduce_mem.empty()) {
             // should not happen, add log to observe
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <ctime>
 #include <memory>
 #include <mutex>
@@ -29,7 +30,9 @@
 #include "olap/lru_cache.h"
 #include "runtime/load_channel.h"
 #include "util/countdown_latch.h"
+#include "util/runtime_profile.h"
 #include "util/thread.h"
+#include "util/time.h"
 #include "util/uid_util.h"
 
 namespace doris {
@@ -70,6 +73,20 @@ private:
     // If yes, it will pick a load channel to try to reduce memory consumption.
     void _handle_mem_exceed_limit();
 
+    // tuple<LoadChannel, index_id, tablet_id, mem_size>
+    using WriterToReduceMem = std::tuple<std::shared_ptr<LoadChannel>, int64_t, int64_t, int64_t>;
+    // lock should be held when calling this method.
+    // Flush the memtables of the largest writers of the non high priority channels
+    // asynchronously, until the memory of the picked writers exceeds mem_to_flushed.
+    // Returns the memory of the picked writers.
+    int64_t _flush_largest_writers_without_lock(int64_t mem_to_flushed,
+                                                std::vector<WriterToReduceMem>* writers);
+    // Run by the background thread. Flush the aged memtables, and the largest ones once the
+    // consumption is close to the soft limit, so that the load rpcs rarely flush themselves.
+    void _proactive_flush_memtables();
+    // sleep longer when the consumption is closer to the hard limit
+    void _throttle_on_soft_limit();
+
     Status _start_bg_worker();
 
     // lock should be held when calling this method
@@ -105,6 +122,11 @@ protected:
     // thread to clean timeout load channels
     scoped_refptr<Thread> _load_channels_clean_thread;
     Status _start_load_channels_clean();
+    scoped_refptr<Thread> _proactive_flush_thread;
+
+    // the pressure metrics of load memory
+    std::atomic<int64_t> _proactive_flush_writer_count = 0;
+    std::atomic<int64_t> _throttled_time_ms = 0;
 };
 
 template <typename Request>
@@ -146,7 +168,12 @@ Status LoadChannelMgr::add_batch(const TabletWriterAddRequest& request,
         // 2. check if mem consumption exceed limit
         // If this is a high priority load task, do not handle this.
         // because this may block for a while, which may lead to rpc timeout.
-        _handle_mem_exceed_limit();
+        int64_t mem_limit_wait_ns = 0;
+        {
+            SCOPED_RAW_TIMER(&mem_limit_wait_ns);
+            _handle_mem_exceed_limit();
+        }
+        response->set_mem_limit_wait_time_us(mem_limit_wait_ns / NANOS_PER_MICRO);
     }
 
     // 3. add batch to load channel
@@ -0,0 +1,103 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/load_statistics.h"
+
+#include <glog/logging.h>
+
+#include "gen_cpp/internal_service.pb.h"
+#include "util/runtime_profile.h"
+
+namespace doris {
+
+void LoadStatistics::merge(const LoadStatistics& other) {
+    mem_limit_wait_ns += other.mem_limit_wait_ns;
+    flush_wait_ns += other.flush_wait_ns;
+    flush_ns += other.flush_ns;
+    flush_count += other.flush_count;
+    flush_bytes += other.flush_bytes;
+    for (const auto& [name, ns] : other.column_encode_ns) {
+        column_encode_ns[name] += ns;
+    }
+    segment_close_ns += other.segment_close_ns;
+    segcompaction_ns += other.segcompaction_ns;
+    rpc_ns += other.rpc_ns;
+    rpc_pending_wait_ns += other.rpc_pending_wait_ns;
+}
+
+void LoadStatistics::to_pb(PLoadStatistics* load_statistics) const {
+    DCHECK(load_statistics != nullptr);
+    load_statistics->set_mem_limit_wait_ns(mem_limit_wait_ns);
+    load_statistics->set_flush_wait_ns(flush_wait_ns);
+    load_statistics->set_flush_ns(flush_ns);
+    load_statistics->set_flush_count(flush_count);
+    load_statistics->set_flush_bytes(flush_bytes);
+    auto* column_encode = load_statistics->mutable_column_encode_ns();
+    for (const auto& [name, ns] : column_encode_ns) {
+        (*column_encode)[name] = ns;
+    }
+    load_statistics->set_segment_close_ns(segment_close_ns);
+    load_statistics->set_segcompaction_ns(segcompaction_ns);
+    load_statistics->set_rpc_ns(rpc_ns);
+    load_statistics->set_rpc_pending_wait_ns(rpc_pending_wait_ns);
+}
+
+void LoadStatistics::from_pb(const PLoadStatistics& load_statistics) {
+    mem_limit_wait_ns = load_statistics.mem_limit_wait_ns();
+    flush_wait_ns = load_statistics.flush_wait_ns();
+    flush_ns = load_statistics.flush_ns();
+    flush_count = load_statistics.flush_count();
+    flush_bytes = load_statistics.flush_bytes();
+    column_encode_ns.clear();
+    for (const auto& [name, ns] : load_statistics.column_encode_ns()) {
+        column_encode_ns[name] = ns;
+    }
+    segment_close_ns = load_statistics.segment_close_ns();
+    segcompaction_ns = load_statistics.segcompaction_ns();
+    rpc_ns = load_statistics.rpc_ns();
+    rpc_pending_wait_ns = load_statistics.rpc_pending_wait_ns();
+}
+
+void LoadStatistics::update_profile(RuntimeProfile* profile) const {
+    static const char* load_profile = "LoadStatistics";
+    static const char* column_encode_profile = "ColumnEncodeTime";
+    ADD_COUNTER(profile, load_profile, TUnit::NONE);
+    auto set = [&](const char* name, TUnit::type type, int64_t value, const char* parent) {
+        ADD_CHILD_COUNTER(profile, name, type, parent)->set(value);
+    };
+    set("MemLimitWaitTime", TUnit::TIME_NS, mem_limit_wait_ns, load_profile);
+    set("FlushWaitTime", TUnit::TIME_NS, flush_wait_ns, load_profile);
+    set("FlushTime", TUnit::TIME_NS, flush_ns, load_profile);
+    set("FlushCount", TUnit::UNIT, flush_count, load_profile);
+    set("FlushBytes", TUnit::BYTES, flush_bytes, load_profile);
+    int64_t total_column_encode_ns = 0;
+    for (const auto& [name, ns] : column_encode_ns) {
+        total_column_encode_ns += ns;
+    }
+    set(column_encode_profile, TUnit::TIME_NS, total_column_encode_ns, load_profile);
+    // the names of the columns are prefixed to not collide with the other counters of the profile
+    for (const auto& [name, ns] : column_encode_ns) {
+        ADD_CHILD_COUNTER(profile, "Column:" + name, TUnit::TIME_NS, column_encode_profile)
+                ->set(ns);
+    }
+    set("SegmentCloseTime", TUnit::TIME_NS, segment_close_ns, load_profile);
+    set("SegcompactionTime", TUnit::TIME_NS, segcompaction_ns, load_profile);
+    set("RpcTime", TUnit::TIME_NS, rpc_ns, load_profile);
+    set("RpcPendingWaitTime", TUnit::TIME_NS, rpc_pending_wait_ns, load_profile);
+}
+
+} // namespace doris
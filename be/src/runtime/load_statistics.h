@@ -0,0 +1,59 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace doris {
+
+class PLoadStatistics;
+class RuntimeProfile;
+
+// The time of a load spent on the write path, summed over the tablets and the backends, which is
+// reported in the profile of the tablet sink and returned in the stream load response.
+struct LoadStatistics {
+    // the add_block requests blocked on the load memory limit of the backends
+    int64_t mem_limit_wait_ns = 0;
+    // the memtables queued in MemTableFlushExecutor before being flushed
+    int64_t flush_wait_ns = 0;
+    int64_t flush_ns = 0;
+    int64_t flush_count = 0;
+    int64_t flush_bytes = 0;
+    // column name -> the time of converting and encoding the column into segments
+    std::map<std::string, int64_t> column_encode_ns;
+    // closing the segment files, which is mostly fsync for the local ones
+    int64_t segment_close_ns = 0;
+    int64_t segcompaction_ns = 0;
+    // the round trips of the add_block rpcs of the node channels
+    int64_t rpc_ns = 0;
+    // the node channels blocked on too many bytes pending for the rpcs
+    int64_t rpc_pending_wait_ns = 0;
+
+    void merge(const LoadStatistics& other);
+
+    void to_pb(PLoadStatistics* load_statistics) const;
+
+    void from_pb(const PLoadStatistics& load_statistics);
+
+    // Sets the counters under "LoadStatistics" of the profile.
+    void update_profile(RuntimeProfile* profile) const;
+};
+
+} // namespace doris
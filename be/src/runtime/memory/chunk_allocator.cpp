@@ -18,6 +18,8 @@
 #include "runtime/memory/chunk_allocator.h"
 
 #include <sanitizer/asan_interface.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 
 #include <list>
 #include <mutex>
@@ -41,6 +43,32 @@ static constexpr size_t MAX_CHUNK_SIZE = 64 * (1ULL << 20); // 64M
 
 ChunkAllocator* ChunkAllocator::_s_instance = nullptr;
 
+// The values in <numaif.h>, which is not available without libnuma.
+static constexpr int MPOL_PREFERRED_MODE = 1;
+static constexpr int MPOL_F_NODE_FLAG = 1 << 0;
+static constexpr int MPOL_F_ADDR_FLAG = 1 << 1;
+static constexpr int MAX_NUMA_NODES = sizeof(unsigned long) * 8;
+
+// Prefers the memory of the node for the pages of the chunk which are not faulted in yet.
+static void prefer_numa_node(uint8_t* data, size_t size, int node) {
+#if defined(OS_LINUX) && defined(SYS_mbind)
+    unsigned long node_mask = 1UL << node;
+    syscall(SYS_mbind, data, size, MPOL_PREFERRED_MODE, &node_mask, MAX_NUMA_NODES, 0);
+#endif
+}
+
+// Returns the node of the memory of the first page of the chunk, or -1 if it is unknown.
+static int numa_node_of_memory(uint8_t* data) {
+#if defined(OS_LINUX) && defined(SYS_get_mempolicy)
+    int node = -1;
+    if (syscall(SYS_get_mempolicy, &node, nullptr, 0, data,
+                MPOL_F_NODE_FLAG | MPOL_F_ADDR_FLAG) == 0) {
+        return node;
+    }
+#endif
+    return -1;
+}
+
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(chunk_pool_local_core_alloc_count, MetricUnit::NOUNIT);
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(chunk_pool_other_core_alloc_count, MetricUnit::NOUNIT);
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(chunk_pool_system_alloc_count, MetricUnit::NOUNIT);
@@ -48,6 +76,7 @@ DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(chunk_pool_system_free_count, MetricUnit::N
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(chunk_pool_system_alloc_cost_ns, MetricUnit::NANOSECONDS);
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(chunk_pool_system_free_cost_ns, MetricUnit::NANOSECONDS);
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(chunk_pool_reserved_bytes, MetricUnit::NOUNIT);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(chunk_pool_other_numa_node_alloc_count, MetricUnit::NOUNIT);
 
 static IntCounter* chunk_pool_local_core_alloc_count;
 static IntCounter* chunk_pool_other_core_alloc_count;
@@ -56,6 +85,7 @@ static IntCounter* chunk_pool_system_free_count;
 static IntCounter* chunk_pool_system_alloc_cost_ns;
 static IntCounter* chunk_pool_system_free_cost_ns;
 static IntGauge* chunk_pool_reserved_bytes;
+static IntCounter* chunk_pool_other_numa_node_alloc_count;
 
 #ifdef BE_TEST
 static std::mutex s_mutex;
@@ -153,6 +183,16 @@ ChunkAllocator::ChunkAllocator(size_t reserve_limit)
     for (int i = 0; i < _arenas.size(); ++i) {
         _arenas[i].reset(new ChunkArena());
     }
+    int num_numa_nodes = CpuInfo::get_max_num_numa_nodes();
+    _numa_aware = config::enable_numa_aware_chunk_allocator && num_numa_nodes > 1 &&
+                  num_numa_nodes <= MAX_NUMA_NODES;
+    if (_numa_aware) {
+        _node_reserve_bytes_limit = reserve_limit / num_numa_nodes;
+        _node_reserved_bytes.reset(new std::atomic<int64_t>[num_numa_nodes]);
+        for (int i = 0; i < num_numa_nodes; ++i) {
+            _node_reserved_bytes[i] = 0;
+        }
+    }
 
     _chunk_allocator_metric_entity =
             DorisMetrics::instance()->metric_registry()->register_entity("chunk_allocator");
@@ -163,6 +203,23 @@ ChunkAllocator::ChunkAllocator(size_t reserve_limit)
     INT_COUNTER_METRIC_REGISTER(_chunk_allocator_metric_entity, chunk_pool_system_alloc_cost_ns);
     INT_COUNTER_METRIC_REGISTER(_chunk_allocator_metric_entity, chunk_pool_system_free_cost_ns);
     INT_GAUGE_METRIC_REGISTER(_chunk_allocator_metric_entity, chunk_pool_reserved_bytes);
+    INT_COUNTER_METRIC_REGISTER(_chunk_allocator_metric_entity,
+                                chunk_pool_other_numa_node_alloc_count);
+}
+
+bool ChunkAllocator::_pop_free_chunk(int core_id, size_t size, Chunk* chunk) {
+    if (!_arenas[core_id]->pop_free_chunk(size, &chunk->data)) {
+        return false;
+    }
+    DCHECK_GE(_reserved_bytes, 0);
+    _reserved_bytes.fetch_sub(size);
+    if (_numa_aware) {
+        _node_reserved_bytes[CpuInfo::get_numa_node_of_core(core_id)].fetch_sub(size);
+    }
+    chunk->core_id = core_id;
+    // transfer the memory ownership of allocate from ChunkAllocator::tracker to the tls tracker.
+    THREAD_MEM_TRACKER_TRANSFER_FROM(size, _mem_tracker.get());
+    return true;
 }
 
 Status ChunkAllocator::allocate_align(size_t size, Chunk* chunk) {
@@ -179,12 +236,8 @@ Status ChunkAllocator::allocate_align(size_t size, Chunk* chunk) {
         return Status::OK();
     }
 
-    if (_arenas[core_id]->pop_free_chunk(size, &chunk->data)) {
-        DCHECK_GE(_reserved_bytes, 0);
-        _reserved_bytes.fetch_sub(size);
+    if (_pop_free_chunk(core_id, size, chunk)) {
         chunk_pool_local_core_alloc_count->increment(1);
-        // transfer the memory ownership of allocate from ChunkAllocator::tracker to the tls tracker.
-        THREAD_MEM_TRACKER_TRANSFER_FROM(size, _mem_tracker.get());
         return Status::OK();
     }
     // Second path: try to allocate from other core's arena
@@ -192,16 +245,27 @@ Status ChunkAllocator::allocate_align(size_t size, Chunk* chunk) {
     // Otherwise, it is allocated from the system first, which can reserve enough memory as soon as possible.
     // After that, allocate from current core arena as much as possible.
     if (_reserved_bytes > _steal_arena_limit) {
-        ++core_id;
-        for (int i = 1; i < _arenas.size(); ++i, ++core_id) {
-            if (_arenas[core_id % _arenas.size()]->pop_free_chunk(size, &chunk->data)) {
-                DCHECK_GE(_reserved_bytes, 0);
-                _reserved_bytes.fetch_sub(size);
+        int node = _numa_aware ? CpuInfo::get_numa_node_of_core(core_id) : 0;
+        if (_numa_aware) {
+            // steal from the cores of the same NUMA node first
+            for (int other_core : CpuInfo::get_cores_of_numa_node(node)) {
+                if (other_core != core_id && _pop_free_chunk(other_core, size, chunk)) {
+                    chunk_pool_other_core_alloc_count->increment(1);
+                    return Status::OK();
+                }
+            }
+        }
+        int other_core = core_id + 1;
+        for (int i = 1; i < _arenas.size(); ++i, ++other_core) {
+            int arena_core = other_core % _arenas.size();
+            if (_numa_aware && CpuInfo::get_numa_node_of_core(arena_core) == node) {
+                continue;
+            }
+            if (_pop_free_chunk(arena_core, size, chunk)) {
                 chunk_pool_other_core_alloc_count->increment(1);
-                // reset chunk's core_id to other
-                chunk->core_id = core_id % _arenas.size();
-                // transfer the memory ownership of allocate from ChunkAllocator::tracker to the tls tracker.
-                THREAD_MEM_TRACKER_TRANSFER_FROM(size, _mem_tracker.get());
+                if (_numa_aware) {
+                    chunk_pool_other_numa_node_alloc_count->increment(1);
+                }
                 return Status::OK();
             }
         }
@@ -218,6 +282,9 @@ Status ChunkAllocator::allocate_align(size_t size, Chunk* chunk) {
     if (chunk->data == nullptr) {
         return Status::MemoryAllocFailed("ChunkAllocator failed to allocate chunk {} bytes", size);
     }
+    if (_numa_aware) {
+        prefer_numa_node(chunk->data, size, CpuInfo::get_numa_node_of_core(core_id));
+    }
     return Status::OK();
 }
 
@@ -229,12 +296,15 @@ void ChunkAllocator::free(const Chunk& chunk) {
         return;
     }
 
+    int node = _numa_aware ? CpuInfo::get_numa_node_of_core(chunk.core_id) : 0;
     int64_t old_reserved_bytes = _reserved_bytes;
     int64_t new_reserved_bytes = 0;
     do {
         new_reserved_bytes = old_reserved_bytes + chunk.size;
         if (chunk.size <= MIN_CHUNK_SIZE || chunk.size >= MAX_CHUNK_SIZE ||
-            new_reserved_bytes > _reserve_bytes_limit) {
+            new_reserved_bytes > _reserve_bytes_limit ||
+            (_numa_aware &&
+             _node_reserved_bytes[node] + chunk.size > _node_reserve_bytes_limit)) {
             int64_t cost_ns = 0;
             {
                 SCOPED_RAW_TIMER(&cost_ns);
@@ -256,6 +326,9 @@ void ChunkAllocator::free(const Chunk& chunk) {
     if (_reserved_bytes % 100 == 32) {
         chunk_pool_reserved_bytes->set_value(_reserved_bytes);
     }
+    if (_numa_aware) {
+        _node_reserved_bytes[node].fetch_add(chunk.size);
+    }
     // The chunk's memory ownership is transferred from tls tracker to ChunkAllocator.
     THREAD_MEM_TRACKER_TRANSFER_TO(chunk.size, _mem_tracker.get());
     _arenas[chunk.core_id]->push_free_chunk(chunk.data, chunk.size);
@@ -266,6 +339,18 @@ void ChunkAllocator::free(uint8_t* data, size_t size) {
     chunk.data = data;
     chunk.size = size;
     chunk.core_id = CpuInfo::get_current_core();
+    if (_numa_aware) {
+        // Keep the chunk in an arena of the node where its memory is, so that it is reused by the
+        // cores of that node, rather than the node of the freeing core.
+        int node = numa_node_of_memory(data);
+        if (node >= 0 && node < CpuInfo::get_max_num_numa_nodes() &&
+            node != CpuInfo::get_numa_node_of_core(chunk.core_id)) {
+            const auto& cores = CpuInfo::get_cores_of_numa_node(node);
+            if (!cores.empty()) {
+                chunk.core_id = cores[chunk.core_id % cores.size()];
+            }
+        }
+    }
     free(chunk);
 }
 
@@ -273,6 +358,11 @@ void ChunkAllocator::clear() {
     for (int i = 0; i < _arenas.size(); ++i) {
         _arenas[i]->clear();
     }
+    if (_numa_aware) {
+        for (int i = 0; i < CpuInfo::get_max_num_numa_nodes(); ++i) {
+            _node_reserved_bytes[i] = 0;
+        }
+    }
     THREAD_MEM_TRACKER_TRANSFER_FROM(_mem_tracker->consumption(), _mem_tracker.get());
 }
 
@@ -48,6 +48,12 @@ class Status;
 // ChunkArena will keep a separate free list for each chunk size. In common case, chunk will
 // be allocated from current core arena. In this case, there is no lock contention.
 //
+// NUMA awareness
+// If config::enable_numa_aware_chunk_allocator and there are more than one NUMA nodes, the chunks
+// allocated from system prefer the memory of the local node, the freed chunks are kept in the
+// arenas of the node where their memory is, the chunks are stolen from the arenas of the same node
+// before the other nodes, and each node reserves its share of the reserve limit.
+//
 // Must call CpuInfo::init() and DorisMetrics::instance()->initialize() to achieve good performance
 // before first object is created. And call init_instance() before use instance is called.
 class ChunkAllocator {
@@ -79,6 +85,9 @@ public:
 private:
     ChunkAllocator(size_t reserve_limit);
 
+    // Pops a free chunk from the arena of the core.
+    bool _pop_free_chunk(int core_id, size_t size, Chunk* chunk);
+
 private:
     static ChunkAllocator* _s_instance;
 
@@ -90,6 +99,11 @@ private:
     // each core has a ChunkArena
     std::vector<std::unique_ptr<ChunkArena>> _arenas;
 
+    bool _numa_aware = false;
+    size_t _node_reserve_bytes_limit = 0;
+    // the reserved bytes of each NUMA node, only if _numa_aware
+    std::unique_ptr<std::atomic<int64_t>[]> _node_reserved_bytes;
+
     std::shared_ptr<MetricEntity> _chunk_allocator_metric_entity;
 
     std::unique_ptr<MemTrackerLimiter> _mem_tracker;
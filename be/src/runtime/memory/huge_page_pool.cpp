@@ -0,0 +1,154 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/memory/huge_page_pool.h"
+
+#include <sys/mman.h>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "runtime/memory/mem_tracker_limiter.h"
+#include "util/doris_metrics.h"
+
+namespace doris {
+
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(huge_page_mapped_bytes, MetricUnit::BYTES);
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(huge_page_pooled_bytes, MetricUnit::BYTES);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(huge_page_pool_alloc_count, MetricUnit::NOUNIT);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(huge_page_system_alloc_count, MetricUnit::NOUNIT);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(huge_page_hugetlb_alloc_count, MetricUnit::NOUNIT);
+
+static IntGauge* huge_page_mapped_bytes;
+static IntGauge* huge_page_pooled_bytes;
+static IntCounter* huge_page_pool_alloc_count;
+static IntCounter* huge_page_system_alloc_count;
+static IntCounter* huge_page_hugetlb_alloc_count;
+
+HugePagePool* HugePagePool::instance() {
+    static HugePagePool instance;
+    return &instance;
+}
+
+HugePagePool::HugePagePool() {
+    _mem_tracker =
+            std::make_unique<MemTrackerLimiter>(MemTrackerLimiter::Type::GLOBAL, "HugePagePool");
+    _metric_entity = DorisMetrics::instance()->metric_registry()->register_entity("huge_page_pool");
+    INT_GAUGE_METRIC_REGISTER(_metric_entity, huge_page_mapped_bytes);
+    INT_GAUGE_METRIC_REGISTER(_metric_entity, huge_page_pooled_bytes);
+    INT_COUNTER_METRIC_REGISTER(_metric_entity, huge_page_pool_alloc_count);
+    INT_COUNTER_METRIC_REGISTER(_metric_entity, huge_page_system_alloc_count);
+    INT_COUNTER_METRIC_REGISTER(_metric_entity, huge_page_hugetlb_alloc_count);
+}
+
+void* HugePagePool::allocate(size_t size, bool* zeroed) {
+    size = round_up(size);
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        auto it = _free_buffers.find(size);
+        if (it != _free_buffers.end() && !it->second.empty()) {
+            void* buf = it->second.back();
+            it->second.pop_back();
+            _pooled_bytes.fetch_sub(size, std::memory_order_relaxed);
+            huge_page_pooled_bytes->set_value(_pooled_bytes);
+            huge_page_pool_alloc_count->increment(1);
+            // The caller tracks the buffer from now on.
+            _mem_tracker->release(size);
+            *zeroed = false;
+            return buf;
+        }
+    }
+    *zeroed = true;
+    return _map(size);
+}
+
+void HugePagePool::free(void* buf, size_t size) {
+    size = round_up(size);
+    if (_pooled_bytes.fetch_add(size, std::memory_order_relaxed) + size >
+        config::huge_page_pool_max_bytes) {
+        _pooled_bytes.fetch_sub(size, std::memory_order_relaxed);
+        _unmap(buf, size);
+        return;
+    }
+    _mem_tracker->consume(size);
+    std::lock_guard<std::mutex> l(_lock);
+    _free_buffers[size].push_back(buf);
+    huge_page_pooled_bytes->set_value(_pooled_bytes);
+}
+
+void HugePagePool::clear() {
+    std::lock_guard<std::mutex> l(_lock);
+    for (auto& [size, buffers] : _free_buffers) {
+        for (void* buf : buffers) {
+            _unmap(buf, size);
+            _pooled_bytes.fetch_sub(size, std::memory_order_relaxed);
+            _mem_tracker->release(size);
+        }
+    }
+    _free_buffers.clear();
+    huge_page_pooled_bytes->set_value(_pooled_bytes);
+}
+
+void* HugePagePool::_map(size_t size) {
+#if defined(OS_LINUX) && defined(MAP_HUGETLB)
+    if (config::use_hugetlb_pages) {
+        // Fails if there are not enough huge pages reserved in /proc/sys/vm/nr_hugepages.
+        void* buf = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (buf != MAP_FAILED) {
+            huge_page_hugetlb_alloc_count->increment(1);
+            huge_page_mapped_bytes->increment(size);
+            return buf;
+        }
+    }
+#endif
+    // Map one more huge page and unmap the unaligned head and tail, so that the buffer can be
+    // backed by the transparent huge pages entirely.
+    size_t map_size = size + HUGE_PAGE_SIZE;
+    void* map_buf = mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                         -1, 0);
+    if (map_buf == MAP_FAILED) {
+        return nullptr;
+    }
+    auto addr = reinterpret_cast<uintptr_t>(map_buf);
+    uintptr_t aligned = (addr + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+    if (aligned > addr) {
+        munmap(map_buf, aligned - addr);
+    }
+    size_t tail = addr + map_size - (aligned + size);
+    if (tail > 0) {
+        munmap(reinterpret_cast<void*>(aligned + size), tail);
+    }
+    void* buf = reinterpret_cast<void*>(aligned);
+#ifdef MADV_HUGEPAGE
+    if (madvise(buf, size, MADV_HUGEPAGE) != 0) {
+        LOG_EVERY_N(WARNING, 1000) << "madvise MADV_HUGEPAGE failed, errno=" << errno;
+    }
+#endif
+    huge_page_system_alloc_count->increment(1);
+    huge_page_mapped_bytes->increment(size);
+    return buf;
+}
+
+void HugePagePool::_unmap(void* buf, size_t size) {
+    if (munmap(buf, size) != 0) {
+        LOG(ERROR) << "HugePagePool cannot munmap " << size << ", errno=" << errno;
+        return;
+    }
+    huge_page_mapped_bytes->increment(-static_cast<int64_t>(size));
+}
+
+} // namespace doris
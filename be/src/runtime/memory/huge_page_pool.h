@@ -0,0 +1,78 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace doris {
+
+class MetricEntity;
+class MemTrackerLimiter;
+
+// Used to allocate the large buffers backed by huge pages, e.g. the hash tables of joins and
+// aggregations, whose random probes suffer from TLB misses with the 4KB pages.
+//
+// The buffers are mmapped in multiples of HUGE_PAGE_SIZE and aligned to HUGE_PAGE_SIZE. They are
+// backed by the explicit huge pages of hugetlbfs if config::use_hugetlb_pages is set and there
+// are enough reserved, otherwise by the transparent huge pages with madvise(MADV_HUGEPAGE).
+//
+// The freed buffers are kept for reuse up to config::huge_page_pool_max_bytes, since the page
+// faults of the fresh huge pages are expensive. The kept buffers are consumed by the tracker of
+// the pool, the callers track the buffers in use themselves, as the mmap path of the Allocator.
+class HugePagePool {
+public:
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * (1ULL << 20);
+
+    static HugePagePool* instance();
+
+    static size_t round_up(size_t size) {
+        return (size + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+    }
+
+    // Returns a buffer of at least the size, or nullptr if it fails. `zeroed` is set if the
+    // buffer is freshly mapped and filled with zeros.
+    void* allocate(size_t size, bool* zeroed);
+
+    void free(void* buf, size_t size);
+
+    // Unmaps all the kept buffers.
+    void clear();
+
+    size_t pooled_bytes() const { return _pooled_bytes.load(std::memory_order_relaxed); }
+
+private:
+    HugePagePool();
+
+    void* _map(size_t size);
+    void _unmap(void* buf, size_t size);
+
+    std::unique_ptr<MemTrackerLimiter> _mem_tracker;
+    std::shared_ptr<MetricEntity> _metric_entity;
+
+    std::mutex _lock;
+    // rounded size -> the kept buffers
+    std::unordered_map<size_t, std::vector<void*>> _free_buffers;
+    std::atomic<size_t> _pooled_bytes {0};
+};
+
+} // namespace doris
@@ -0,0 +1,112 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/memory/memory_region.h"
+
+#include <sanitizer/asan_interface.h>
+
+#include <mutex>
+
+#include "runtime/memory/mem_tracker_limiter.h"
+#include "runtime/thread_context.h"
+#include "util/cpu_info.h"
+#include "vec/common/allocator.h"
+
+namespace doris {
+
+MemoryRegion::MemoryRegion(std::shared_ptr<MemTrackerLimiter> mem_tracker, size_t capacity)
+        : _mem_tracker(std::move(mem_tracker)), _capacity(capacity) {
+    DCHECK(_mem_tracker != nullptr);
+}
+
+MemoryRegion::~MemoryRegion() {
+    release();
+}
+
+MemoryRegion::Shard& MemoryRegion::_current_shard() {
+    return _shards[CpuInfo::get_current_core() % NUM_SHARDS];
+}
+
+void* MemoryRegion::allocate(size_t size) {
+    Shard& shard = _current_shard();
+    int size_class = _size_class(size);
+    FreeBuffer* buf = nullptr;
+    {
+        std::lock_guard l(shard.lock);
+        buf = shard.free_lists[size_class];
+        if (buf == nullptr) {
+            return nullptr;
+        }
+        ASAN_UNPOISON_MEMORY_REGION(buf, size);
+        shard.free_lists[size_class] = buf->next;
+    }
+    _cached_bytes.fetch_sub(size, std::memory_order_relaxed);
+    return buf;
+}
+
+bool MemoryRegion::free(void* buf, size_t size) {
+    if (_cached_bytes.fetch_add(size, std::memory_order_relaxed) + size > _capacity) {
+        _cached_bytes.fetch_sub(size, std::memory_order_relaxed);
+        return false;
+    }
+    Shard& shard = _current_shard();
+    int size_class = _size_class(size);
+    auto* free_buf = static_cast<FreeBuffer*>(buf);
+    {
+        std::lock_guard l(shard.lock);
+        free_buf->next = shard.free_lists[size_class];
+        ASAN_POISON_MEMORY_REGION(buf, size);
+        shard.free_lists[size_class] = free_buf;
+    }
+    return true;
+}
+
+void MemoryRegion::release() {
+    auto free_all = [this]() {
+        Allocator<false> allocator;
+        for (auto& shard : _shards) {
+            std::lock_guard l(shard.lock);
+            for (int i = 0; i < NUM_SIZE_CLASSES; ++i) {
+                size_t size = 1ULL << (i + MIN_SIZE_CLASS);
+                FreeBuffer* buf = shard.free_lists[i];
+                while (buf != nullptr) {
+                    ASAN_UNPOISON_MEMORY_REGION(buf, size);
+                    FreeBuffer* next = buf->next;
+                    allocator.free(buf, size);
+                    _cached_bytes.fetch_sub(size, std::memory_order_relaxed);
+                    buf = next;
+                }
+                shard.free_lists[i] = nullptr;
+            }
+        }
+    };
+    if (!thread_context_ptr.init) {
+        free_all();
+        return;
+    }
+    // The buffers are freed by the Allocator as they were allocated, and released from the
+    // query mem tracker which they are consumed by. The region of the thread is detached
+    // meanwhile, so that they are not kept again.
+    std::shared_ptr<MemoryRegion> thread_region = std::move(thread_context()->memory_region);
+    {
+        SCOPED_SWITCH_THREAD_MEM_TRACKER_LIMITER(_mem_tracker);
+        free_all();
+    }
+    thread_context()->memory_region = std::move(thread_region);
+}
+
+} // namespace doris
@@ -0,0 +1,96 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "util/spinlock.h"
+
+namespace doris {
+
+class MemTrackerLimiter;
+
+// The freed memory of a query, kept for its later allocations.
+//
+// The blocks and columns of a query allocate their buffers through the vectorized Allocator and
+// free them soon after. If a region is attached to the thread (see AttachTask), the freed buffers
+// of power-of-two sizes are kept in the region, and the later allocations of the same sizes reuse
+// them, instead of going to malloc or ChunkAllocator and the memory hooks every time.
+//
+// The kept buffers stay consumed by the query mem tracker. They are all released when the region
+// is destroyed with the query, or when they are more than the capacity.
+//
+// The buffers are kept in the free lists of the shards by the current core, a buffer freed on one
+// core is not found by the allocations on the other cores.
+class MemoryRegion {
+public:
+    // 512B ~ 32MB, the larger ones are mmapped by the Allocator.
+    static constexpr int MIN_SIZE_CLASS = 9;
+    static constexpr int MAX_SIZE_CLASS = 25;
+
+    MemoryRegion(std::shared_ptr<MemTrackerLimiter> mem_tracker, size_t capacity);
+
+    ~MemoryRegion();
+
+    MemoryRegion(const MemoryRegion&) = delete;
+    MemoryRegion& operator=(const MemoryRegion&) = delete;
+
+    static bool is_cacheable(size_t size) {
+        return (size & (size - 1)) == 0 && size >= (1ULL << MIN_SIZE_CLASS) &&
+               size <= (1ULL << MAX_SIZE_CLASS);
+    }
+
+    // Returns a kept buffer of the size, or nullptr if there is none.
+    void* allocate(size_t size);
+
+    // Keeps the buffer, returns false if it is not kept and should be freed by the caller.
+    bool free(void* buf, size_t size);
+
+    // Releases all the kept buffers.
+    void release();
+
+    size_t cached_bytes() const { return _cached_bytes.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr int NUM_SIZE_CLASSES = MAX_SIZE_CLASS - MIN_SIZE_CLASS + 1;
+    static constexpr int NUM_SHARDS = 16;
+
+    // The free buffers are linked by the pointers written in them.
+    struct FreeBuffer {
+        FreeBuffer* next;
+    };
+
+    struct alignas(64) Shard {
+        SpinLock lock;
+        FreeBuffer* free_lists[NUM_SIZE_CLASSES] = {};
+    };
+
+    static int _size_class(size_t size) { return __builtin_ctzll(size) - MIN_SIZE_CLASS; }
+
+    Shard& _current_shard();
+
+    const std::shared_ptr<MemTrackerLimiter> _mem_tracker;
+    const size_t _capacity;
+    std::atomic<size_t> _cached_bytes {0};
+    Shard _shards[NUM_SHARDS];
+};
+
+} // namespace doris
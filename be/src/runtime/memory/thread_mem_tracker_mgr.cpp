@@ -35,6 +35,7 @@ void ThreadMemTrackerMgr::attach_limiter_tracker(
     _limiter_tracker = mem_tracker;
     _limiter_tracker_raw = mem_tracker.get();
     _check_limit = true;
+    update_flush_threshold();
 }
 
 void ThreadMemTrackerMgr::detach_limiter_tracker(
@@ -43,6 +44,7 @@ void ThreadMemTrackerMgr::detach_limiter_tracker(
     _fragment_instance_id = TUniqueId();
     _limiter_tracker = old_mem_tracker;
     _limiter_tracker_raw = old_mem_tracker.get();
+    update_flush_threshold();
 }
 
 void ThreadMemTrackerMgr::cancel_fragment(const std::string& exceed_msg) {
@@ -20,6 +20,8 @@
 #include <bthread/bthread.h>
 #include <fmt/format.h>
 
+#include <algorithm>
+
 #include "gutil/macros.h"
 #include "runtime/memory/mem_tracker.h"
 #include "runtime/memory/mem_tracker_limiter.h"
@@ -115,6 +117,8 @@ public:
 private:
     void exceeded(int64_t size);
 
+    void update_flush_threshold();
+
     void save_exceed_mem_limit_msg() {
         _exceed_mem_limit_msg = _limiter_tracker_raw->mem_limit_exceeded(
                 fmt::format("execute:<{}>", last_consumer_tracker()), _failed_consume_msg);
@@ -126,6 +130,9 @@ private:
     // Cache untracked mem.
     int64_t _untracked_mem = 0;
     int64_t old_untracked_mem = 0;
+    // The untracked mem is flushed when its absolute value reaches the threshold, which is updated
+    // after each flush, see config::mem_tracker_consume_max_size_bytes.
+    int64_t _flush_threshold = 0;
 
     bool _count_scope_mem = false;
     int64_t _scope_mem = 0;
@@ -155,6 +162,19 @@ inline void ThreadMemTrackerMgr::init() {
     _init = true;
 }
 
+inline void ThreadMemTrackerMgr::update_flush_threshold() {
+    int64_t min_size = config::mem_tracker_consume_min_size_bytes;
+    int64_t max_size = std::max<int64_t>(min_size, config::mem_tracker_consume_max_size_bytes);
+    // A thread keeps at most 1/64 of the spare capacity of its limiter tracker untracked, so the
+    // untracked mem of the threads exceeds the limit only if more than 64 threads are near it.
+    if (_limiter_tracker_raw != nullptr && _limiter_tracker_raw->has_limit()) {
+        int64_t spare_capacity = _limiter_tracker_raw->spare_capacity();
+        _flush_threshold = std::clamp<int64_t>(spare_capacity / 64, min_size, max_size);
+    } else {
+        _flush_threshold = max_size;
+    }
+}
+
 inline bool ThreadMemTrackerMgr::push_consumer_tracker(MemTracker* tracker) {
     DCHECK(tracker) << print_debug_string();
     if (std::count(_consumer_tracker_stack.begin(), _consumer_tracker_stack.end(), tracker)) {
@@ -173,12 +193,11 @@ inline void ThreadMemTrackerMgr::pop_consumer_tracker() {
 
 inline void ThreadMemTrackerMgr::consume(int64_t size) {
     _untracked_mem += size;
-    // When some threads `0 < _untracked_mem < config::mem_tracker_consume_min_size_bytes`
-    // and some threads `_untracked_mem <= -config::mem_tracker_consume_min_size_bytes` trigger consumption(),
+    // When some threads `0 < _untracked_mem < _flush_threshold`
+    // and some threads `_untracked_mem <= -_flush_threshold` trigger consumption(),
     // it will cause tracker->consumption to be temporarily less than 0.
     // After the jemalloc hook is loaded, before ExecEnv init, _limiter_tracker=nullptr.
-    if ((_untracked_mem >= config::mem_tracker_consume_min_size_bytes ||
-         _untracked_mem <= -config::mem_tracker_consume_min_size_bytes) &&
+    if ((_untracked_mem >= _flush_threshold || _untracked_mem <= -_flush_threshold) &&
         !_stop_consume && ExecEnv::GetInstance()->initialized()) {
         if (_check_limit) {
             flush_untracked_mem<true, true>();
@@ -190,8 +209,7 @@ inline void ThreadMemTrackerMgr::consume(int64_t size) {
 
 inline bool ThreadMemTrackerMgr::try_consume(int64_t size) {
     _untracked_mem += size;
-    if ((_untracked_mem >= config::mem_tracker_consume_min_size_bytes ||
-         _untracked_mem <= -config::mem_tracker_consume_min_size_bytes) &&
+    if ((_untracked_mem >= _flush_threshold || _untracked_mem <= -_flush_threshold) &&
         !_stop_consume && ExecEnv::GetInstance()->initialized()) {
         if (_check_limit) {
             return flush_untracked_mem<true, false>();
@@ -217,7 +235,10 @@ bool ThreadMemTrackerMgr::flush_untracked_mem() {
             if (Force) _limiter_tracker_raw->consume(old_untracked_mem);
             save_exceed_mem_limit_msg();
             exceeded(old_untracked_mem);
-            if (!Force) return false;
+            if (!Force) {
+                _stop_consume = false;
+                return false;
+            }
         }
     } else {
         _limiter_tracker_raw->consume(old_untracked_mem);
@@ -226,6 +247,7 @@ bool ThreadMemTrackerMgr::flush_untracked_mem() {
         tracker->consume(old_untracked_mem);
     }
     _untracked_mem -= old_untracked_mem;
+    update_flush_threshold();
     _stop_consume = false;
     return true;
 }
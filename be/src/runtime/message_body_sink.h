@@ -41,6 +41,20 @@ protected:
     std::string _cancelled_reason = "";
 };
 
+// keep the message in memory, for the small loads of group commit
+class MessageBodyStringSink : public MessageBodySink {
+public:
+    Status append(const char* data, size_t size) override {
+        _data.append(data, size);
+        return Status::OK();
+    }
+
+    std::string take_data() { return std::move(_data); }
+
+private:
+    std::string _data;
+};
+
 // write message to a local file
 class MessageBodyFileSink : public MessageBodySink {
 public:
@@ -352,6 +352,7 @@ void PlanFragmentExecutor::_collect_query_statistics() {
     _query_statistics->clear();
     _plan->collect_query_statistics(_query_statistics.get());
     _query_statistics->add_cpu_ms(_fragment_cpu_timer->value() / NANOS_PER_MILLIS);
+    _query_statistics->add_io_statistics(*_runtime_state->io_statistics());
     if (_runtime_state->backend_id() != -1) {
         _collect_node_statistics();
     }
@@ -436,6 +437,12 @@ void PlanFragmentExecutor::send_report(bool done) {
         return;
     }
 
+    if (_is_report_success) {
+        QueryIOStatistics io_statistics;
+        io_statistics.add(*_runtime_state->io_statistics());
+        io_statistics.update_profile(profile());
+    }
+
     // This will send a report even if we are cancelled.  If the query completed correctly
     // but fragments still need to be cancelled (e.g. limit reached), the coordinator will
     // be waiting for a final report and profile.
@@ -28,6 +28,7 @@
 #include "runtime/datetime_value.h"
 #include "runtime/exec_env.h"
 #include "runtime/memory/mem_tracker_limiter.h"
+#include "runtime/memory/memory_region.h"
 #include "runtime/runtime_predicate.h"
 #include "task_group/task_group.h"
 #include "util/pretty_printer.h"
@@ -52,6 +53,8 @@ public:
     }
 
     ~QueryFragmentsCtx() {
+        // release the kept buffers before the consumption is checked
+        memory_region.reset();
         // query mem tracker consumption is equal to 0, it means that after QueryFragmentsCtx is created,
         // it is found that query already exists in _fragments_ctx_map, and query mem tracker is not used.
         // query mem tracker consumption is not equal to 0 after use, because there is memory consumed
@@ -156,6 +159,8 @@ public:
     ObjectPool obj_pool;
     // MemTracker that is shared by all fragment instances running on this host.
     std::shared_ptr<MemTrackerLimiter> query_mem_tracker;
+    // The freed memory of the query kept for reuse, nullptr if enable_query_memory_region is false.
+    std::shared_ptr<MemoryRegion> memory_region;
 
     std::vector<TUniqueId> fragment_ids;
 
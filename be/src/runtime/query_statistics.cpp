@@ -19,6 +19,8 @@
 
 #include <glog/logging.h>
 
+#include "util/runtime_profile.h"
+
 namespace doris {
 
 void NodeStatistics::merge(const NodeStatistics& other) {
@@ -34,10 +36,90 @@ void NodeStatistics::from_pb(const PNodeStatistics& node_statistics) {
     peak_memory_bytes = node_statistics.peak_memory_bytes();
 }
 
+void QueryIOStatistics::add(const io::IOStatistics& other) {
+    auto load = [](const std::atomic<int64_t>& counter) {
+        return counter.load(std::memory_order_relaxed);
+    };
+    local_read_requests += load(other.local_read_requests);
+    local_bytes_read_from_page_cache += load(other.local_bytes_read_from_page_cache);
+    local_bytes_read_from_disk += load(other.local_bytes_read_from_disk);
+    storage_page_cache_hits += load(other.storage_page_cache_hits);
+    storage_page_cache_misses += load(other.storage_page_cache_misses);
+    file_cache_hits += load(other.file_cache_hits);
+    file_cache_misses += load(other.file_cache_misses);
+    file_cache_bytes_read += load(other.file_cache_bytes_read);
+    remote_read_requests += load(other.remote_read_requests);
+    remote_bytes_read += load(other.remote_bytes_read);
+    remote_read_ns += load(other.remote_read_ns);
+}
+
+void QueryIOStatistics::merge(const QueryIOStatistics& other) {
+    local_read_requests += other.local_read_requests;
+    local_bytes_read_from_page_cache += other.local_bytes_read_from_page_cache;
+    local_bytes_read_from_disk += other.local_bytes_read_from_disk;
+    storage_page_cache_hits += other.storage_page_cache_hits;
+    storage_page_cache_misses += other.storage_page_cache_misses;
+    file_cache_hits += other.file_cache_hits;
+    file_cache_misses += other.file_cache_misses;
+    file_cache_bytes_read += other.file_cache_bytes_read;
+    remote_read_requests += other.remote_read_requests;
+    remote_bytes_read += other.remote_bytes_read;
+    remote_read_ns += other.remote_read_ns;
+}
+
+void QueryIOStatistics::to_pb(PQueryIOStatistics* io_statistics) const {
+    DCHECK(io_statistics != nullptr);
+    io_statistics->set_local_read_requests(local_read_requests);
+    io_statistics->set_local_bytes_read_from_page_cache(local_bytes_read_from_page_cache);
+    io_statistics->set_local_bytes_read_from_disk(local_bytes_read_from_disk);
+    io_statistics->set_storage_page_cache_hits(storage_page_cache_hits);
+    io_statistics->set_storage_page_cache_misses(storage_page_cache_misses);
+    io_statistics->set_file_cache_hits(file_cache_hits);
+    io_statistics->set_file_cache_misses(file_cache_misses);
+    io_statistics->set_file_cache_bytes_read(file_cache_bytes_read);
+    io_statistics->set_remote_read_requests(remote_read_requests);
+    io_statistics->set_remote_bytes_read(remote_bytes_read);
+    io_statistics->set_remote_read_ns(remote_read_ns);
+}
+
+void QueryIOStatistics::from_pb(const PQueryIOStatistics& io_statistics) {
+    local_read_requests = io_statistics.local_read_requests();
+    local_bytes_read_from_page_cache = io_statistics.local_bytes_read_from_page_cache();
+    local_bytes_read_from_disk = io_statistics.local_bytes_read_from_disk();
+    storage_page_cache_hits = io_statistics.storage_page_cache_hits();
+    storage_page_cache_misses = io_statistics.storage_page_cache_misses();
+    file_cache_hits = io_statistics.file_cache_hits();
+    file_cache_misses = io_statistics.file_cache_misses();
+    file_cache_bytes_read = io_statistics.file_cache_bytes_read();
+    remote_read_requests = io_statistics.remote_read_requests();
+    remote_bytes_read = io_statistics.remote_bytes_read();
+    remote_read_ns = io_statistics.remote_read_ns();
+}
+
+void QueryIOStatistics::update_profile(RuntimeProfile* profile) const {
+    static const char* io_profile = "IOStatistics";
+    ADD_COUNTER(profile, io_profile, TUnit::NONE);
+    auto set = [&](const char* name, TUnit::type type, int64_t value) {
+        ADD_CHILD_COUNTER(profile, name, type, io_profile)->set(value);
+    };
+    set("LocalReadRequests", TUnit::UNIT, local_read_requests);
+    set("LocalBytesReadFromPageCache", TUnit::BYTES, local_bytes_read_from_page_cache);
+    set("LocalBytesReadFromDisk", TUnit::BYTES, local_bytes_read_from_disk);
+    set("StoragePageCacheHits", TUnit::UNIT, storage_page_cache_hits);
+    set("StoragePageCacheMisses", TUnit::UNIT, storage_page_cache_misses);
+    set("FileCacheHits", TUnit::UNIT, file_cache_hits);
+    set("FileCacheMisses", TUnit::UNIT, file_cache_misses);
+    set("FileCacheBytesRead", TUnit::BYTES, file_cache_bytes_read);
+    set("RemoteReadRequests", TUnit::UNIT, remote_read_requests);
+    set("RemoteBytesRead", TUnit::BYTES, remote_bytes_read);
+    set("RemoteReadTime", TUnit::TIME_NS, remote_read_ns);
+}
+
 void QueryStatistics::merge(const QueryStatistics& other) {
     scan_rows += other.scan_rows;
     scan_bytes += other.scan_bytes;
     cpu_ms += other.cpu_ms;
+    io_statistics.merge(other.io_statistics);
     for (auto& other_node_statistics : other._nodes_statistics_map) {
         int64_t node_id = other_node_statistics.first;
         auto node_statistics = add_nodes_statistics(node_id);
@@ -52,6 +134,7 @@ void QueryStatistics::to_pb(PQueryStatistics* statistics) {
     statistics->set_cpu_ms(cpu_ms);
     statistics->set_returned_rows(returned_rows);
     statistics->set_max_peak_memory_bytes(max_peak_memory_bytes);
+    io_statistics.to_pb(statistics->mutable_io_statistics());
     for (auto iter = _nodes_statistics_map.begin(); iter != _nodes_statistics_map.end(); ++iter) {
         auto node_statistics = statistics->add_nodes_statistics();
         node_statistics->set_node_id(iter->first);
@@ -63,6 +146,7 @@ void QueryStatistics::from_pb(const PQueryStatistics& statistics) {
     scan_rows = statistics.scan_rows();
     scan_bytes = statistics.scan_bytes();
     cpu_ms = statistics.cpu_ms();
+    io_statistics.from_pb(statistics.io_statistics());
     for (auto& p_node_statistics : statistics.nodes_statistics()) {
         int64_t node_id = p_node_statistics.node_id();
         auto node_statistics = add_nodes_statistics(node_id);
@@ -20,12 +20,14 @@
 #include <mutex>
 
 #include "gen_cpp/data.pb.h"
+#include "io/io_common.h"
 #include "util/spinlock.h"
 
 namespace doris {
 
 class QueryStatistics;
 class QueryStatisticsRecvr;
+class RuntimeProfile;
 
 class NodeStatistics {
 public:
@@ -44,6 +46,32 @@ private:
     int64_t peak_memory_bytes;
 };
 
+// The I/O of a query by where the data was read from, see io::IOStatistics.
+struct QueryIOStatistics {
+    int64_t local_read_requests = 0;
+    int64_t local_bytes_read_from_page_cache = 0;
+    int64_t local_bytes_read_from_disk = 0;
+    int64_t storage_page_cache_hits = 0;
+    int64_t storage_page_cache_misses = 0;
+    int64_t file_cache_hits = 0;
+    int64_t file_cache_misses = 0;
+    int64_t file_cache_bytes_read = 0;
+    int64_t remote_read_requests = 0;
+    int64_t remote_bytes_read = 0;
+    int64_t remote_read_ns = 0;
+
+    void add(const io::IOStatistics& io_statistics);
+
+    void merge(const QueryIOStatistics& other);
+
+    void to_pb(PQueryIOStatistics* io_statistics) const;
+
+    void from_pb(const PQueryIOStatistics& io_statistics);
+
+    // Sets the counters under "IOStatistics" of the profile.
+    void update_profile(RuntimeProfile* profile) const;
+};
+
 // This is responsible for collecting query statistics, usually it consists of
 // two parts, one is current fragment or plan's statistics, the other is sub fragment
 // or plan's statistics and QueryStatisticsRecvr is responsible for collecting it.
@@ -61,6 +89,10 @@ public:
 
     void add_cpu_ms(int64_t cpu_ms) { this->cpu_ms += cpu_ms; }
 
+    void add_io_statistics(const io::IOStatistics& io_statistics) {
+        this->io_statistics.add(io_statistics);
+    }
+
     NodeStatistics* add_nodes_statistics(int64_t node_id) {
         NodeStatistics* nodeStatistics = nullptr;
         auto iter = _nodes_statistics_map.find(node_id);
@@ -92,6 +124,7 @@ public:
         cpu_ms = 0;
         returned_rows = 0;
         max_peak_memory_bytes = 0;
+        io_statistics = QueryIOStatistics();
         clearNodeStatistics();
     }
 
@@ -109,6 +142,7 @@ private:
     // Maximum memory peak for all backends.
     // only set once by result sink when closing.
     int64_t max_peak_memory_bytes;
+    QueryIOStatistics io_statistics;
     // The statistics of the query on each backend.
     typedef std::unordered_map<int64_t, NodeStatistics*> NodeStatisticsMap;
     NodeStatisticsMap _nodes_statistics_map;
@@ -22,6 +22,7 @@
 #include <string>
 #include <vector>
 
+#include "common/config.h"
 #include "common/status.h"
 #include "gen_cpp/internal_service.pb.h"
 #include "gutil/strings/split.h"
@@ -183,6 +184,21 @@ Status KafkaDataConsumer::group_consume(BlockingQueue<RdKafka::Message*>* queue,
     int64_t put_rows = 0;
     int32_t retry_times = 0;
     Status st = Status::OK();
+    // the received msgs not put into the queue yet, which are deleted if the queue is shutdown
+    const size_t batch_size = std::max(config::routine_load_kafka_consume_batch_size, 1);
+    std::vector<RdKafka::Message*> batch;
+    Defer delete_batch {[&batch]() {
+        for (auto* msg : batch) {
+            delete msg;
+        }
+    }};
+    // put the batch into the queue, returns false if the queue is shutdown
+    auto flush_batch = [&]() {
+        size_t num_msgs = batch.size();
+        bool res = queue->blocking_put_batch(&batch);
+        put_rows += num_msgs - batch.size();
+        return res;
+    };
     MonotonicStopWatch consumer_watch;
     MonotonicStopWatch watch;
     watch.start();
@@ -195,13 +211,16 @@ Status KafkaDataConsumer::group_consume(BlockingQueue<RdKafka::Message*>* queue,
         }
 
         if (left_time <= 0) {
+            flush_batch();
             break;
         }
 
         bool done = false;
-        // consume 1 message at a time
+        // consume 1 message at a time, only the first one of a batch is waited for, and the
+        // rest are the ones already fetched by librdkafka
         consumer_watch.start();
-        std::unique_ptr<RdKafka::Message> msg(_k_consumer->consume(1000 /* timeout, ms */));
+        std::unique_ptr<RdKafka::Message> msg(
+                _k_consumer->consume(batch.empty() ? 1000 : 0 /* timeout, ms */));
         consumer_watch.stop();
         switch (msg->err()) {
         case RdKafka::ERR_NO_ERROR:
@@ -209,16 +228,21 @@ Status KafkaDataConsumer::group_consume(BlockingQueue<RdKafka::Message*>* queue,
                 // ignore msg with length 0.
                 // put empty msg into queue will cause the load process shutting down.
                 break;
-            } else if (!queue->blocking_put(msg.get())) {
+            }
+            // release the ownership, msg will be deleted after being processed
+            batch.push_back(msg.release());
+            if (batch.size() >= batch_size && !flush_batch()) {
                 // queue is shutdown
                 done = true;
-            } else {
-                ++put_rows;
-                msg.release(); // release the ownership, msg will be deleted after being processed
             }
             ++received_rows;
             break;
         case RdKafka::ERR__TIMED_OUT:
+            if (!batch.empty()) {
+                // no more fetched msgs
+                done = !flush_batch();
+                break;
+            }
             // leave the status as OK, because this may happened
             // if there is no data in kafka.
             LOG(INFO) << "kafka consume timeout: " << _id;
@@ -227,6 +251,7 @@ Status KafkaDataConsumer::group_consume(BlockingQueue<RdKafka::Message*>* queue,
             LOG(INFO) << "kafka consume Disconnected: " << _id
                       << ", retry times: " << retry_times++;
             if (retry_times <= MAX_RETRY_TIMES_FOR_TRANSPORT_FAILURE) {
+                done = !flush_batch();
                 std::this_thread::sleep_for(std::chrono::milliseconds(200));
                 break;
             }
@@ -16,11 +16,16 @@
 // under the License.
 #include "runtime/routine_load/data_consumer_group.h"
 
+#include <algorithm>
+#include <vector>
+
+#include "common/config.h"
 #include "io/fs/kafka_consumer_pipe.h"
 #include "librdkafka/rdkafka.h"
 #include "librdkafka/rdkafkacpp.h"
 #include "runtime/routine_load/data_consumer.h"
 #include "runtime/stream_load/stream_load_context.h"
+#include "util/defer_op.h"
 
 namespace doris {
 
@@ -114,6 +119,16 @@ Status KafkaDataConsumerGroup::start_all(std::shared_ptr<StreamLoadContext> ctx)
         append_data = &io::KafkaConsumerPipe::append_with_line_delimiter;
     }
 
+    const size_t batch_size = std::max(config::routine_load_kafka_consume_batch_size, 1);
+    // the msgs taken from the queue at a time, those from msgs_pos on are not processed yet
+    std::vector<RdKafka::Message*> msgs;
+    size_t msgs_pos = 0;
+    Defer delete_msgs {[&]() {
+        for (size_t i = msgs_pos; i < msgs.size(); ++i) {
+            delete msgs[i];
+        }
+    }};
+
     MonotonicStopWatch watch;
     watch.start();
     bool eos = false;
@@ -149,15 +164,19 @@ Status KafkaDataConsumerGroup::start_all(std::shared_ptr<StreamLoadContext> ctx)
             return Status::OK();
         }
 
-        RdKafka::Message* msg;
-        bool res = _queue.blocking_get(&msg);
-        if (res) {
+        if (msgs_pos == msgs.size()) {
+            msgs.clear();
+            msgs_pos = 0;
+            _queue.blocking_get_batch(&msgs, batch_size);
+        }
+        if (msgs_pos < msgs.size()) {
+            RdKafka::Message* msg = msgs[msgs_pos++];
             VLOG_NOTICE << "get kafka message"
                         << ", partition: " << msg->partition() << ", offset: " << msg->offset()
                         << ", len: " << msg->len();
 
-            Status st = (kafka_pipe.get()->*append_data)(static_cast<const char*>(msg->payload()),
-                                                         static_cast<size_t>(msg->len()));
+            Status st = (kafka_pipe->pipe_of_partition(msg->partition())->*append_data)(
+                    static_cast<const char*>(msg->payload()), static_cast<size_t>(msg->len()));
             if (st.ok()) {
                 left_rows--;
                 left_bytes -= msg->len();
@@ -17,8 +17,11 @@
 
 #include "runtime/routine_load/routine_load_task_executor.h"
 
+#include <algorithm>
 #include <thread>
+#include <vector>
 
+#include "common/config.h"
 #include "common/status.h"
 #include "gen_cpp/BackendService_types.h"
 #include "gen_cpp/FrontendService_types.h"
@@ -258,7 +261,19 @@ void RoutineLoadTaskExecutor::exec_task(std::shared_ptr<StreamLoadContext> ctx,
     std::shared_ptr<io::StreamLoadPipe> pipe;
     switch (ctx->load_src_type) {
     case TLoadSourceType::KAFKA: {
-        pipe = std::make_shared<io::KafkaConsumerPipe>();
+        std::vector<int32_t> partitions;
+        for (auto& kv : ctx->kafka_info->begin_offset) {
+            partitions.push_back(kv.first);
+        }
+        int parse_parallelism = std::min<int>(config::routine_load_max_parse_parallelism,
+                                              partitions.size());
+        if (parse_parallelism > 1) {
+            // the partitions are parsed by several scanners of the same load
+            pipe = std::make_shared<io::MultiPartitionKafkaConsumerPipe>(parse_parallelism,
+                                                                         partitions);
+        } else {
+            pipe = std::make_shared<io::KafkaConsumerPipe>();
+        }
         Status st = std::static_pointer_cast<KafkaDataConsumerGroup>(consumer_grp)
                             ->assign_topic_partitions(ctx);
         if (!st.ok()) {
@@ -196,13 +196,19 @@ Status RuntimeFilterMergeControllerEntity::merge(const PMergeFilterRequest* requ
             return Status::InvalidArgument("unknown filter id");
         }
         cntVal = iter->second;
+    }
+    // With many producers, the merge node is the bottleneck. So the filter of the producer is
+    // deserialized without any lock, and only the merge into the filter of the same filter id
+    // is serialized.
+    MergeRuntimeFilterParams params(request, attach_data);
+    RuntimeFilterWrapperHolder holder;
+    RETURN_IF_ERROR(IRuntimeFilter::create_wrapper(_state, &params, cntVal->pool.get(),
+                                                   holder.getHandle()));
+    {
+        std::lock_guard<std::mutex> guard(cntVal->mutex);
         if (auto bf = cntVal->filter->get_bloomfilter()) {
             RETURN_IF_ERROR(bf->init_with_fixed_length());
         }
-        MergeRuntimeFilterParams params(request, attach_data);
-        ObjectPool* pool = iter->second->pool.get();
-        RuntimeFilterWrapperHolder holder;
-        RETURN_IF_ERROR(IRuntimeFilter::create_wrapper(_state, &params, pool, holder.getHandle()));
         RETURN_IF_ERROR(cntVal->filter->merge_from(holder.getHandle()->get()));
         cntVal->arrive_id.insert(UniqueId(request->fragment_id()).to_string());
         merged_size = cntVal->arrive_id.size();
@@ -134,6 +134,8 @@ public:
         IRuntimeFilter* filter;
         std::unordered_set<std::string> arrive_id; // fragment_instance_id ?
         std::shared_ptr<ObjectPool> pool;
+        // protect filter and arrive_id, so that different filters are merged concurrently
+        std::mutex mutex;
     };
 
 public:
@@ -147,7 +149,7 @@ private:
 
     UniqueId _query_id;
     UniqueId _fragment_instance_id;
-    // protect _filter_map
+    // protect _filter_map, the merge of a filter is protected by RuntimeFilterCntlVal::mutex
     std::mutex _filter_map_mutex;
     std::shared_ptr<MemTracker> _mem_tracker;
     // TODO: convert filter id to i32
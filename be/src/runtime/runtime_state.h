@@ -27,6 +27,8 @@
 #include "common/object_pool.h"
 #include "gen_cpp/PaloInternalService_types.h" // for TQueryOptions
 #include "gen_cpp/Types_types.h"               // for TUniqueId
+#include "io/io_common.h"
+#include "runtime/load_statistics.h"
 #include "runtime/query_fragments_ctx.h"
 #include "util/runtime_profile.h"
 #include "util/telemetry/telemetry.h"
@@ -330,6 +332,8 @@ public:
 
     std::vector<TErrorTabletInfo>& error_tablet_infos() { return _error_tablet_infos; }
 
+    LoadStatistics& load_statistics() { return _load_statistics; }
+
     // get mem limit for load channel
     // if load mem limit is not set, or is zero, using query mem limit instead.
     int64_t get_load_mem_limit();
@@ -340,6 +344,8 @@ public:
 
     QueryFragmentsCtx* get_query_fragments_ctx() { return _query_ctx; }
 
+    io::IOStatistics* io_statistics() { return &_io_statistics; }
+
     void set_query_mem_tracker(const std::shared_ptr<MemTrackerLimiter>& tracker) {
         _query_mem_tracker = tracker;
     }
@@ -350,6 +356,20 @@ public:
 
     bool enable_profile() const { return _query_options.is_report_success; }
 
+    bool enable_hardware_counters() const {
+        return _query_options.__isset.enable_hardware_counters &&
+               _query_options.enable_hardware_counters;
+    }
+
+    bool enable_scan_cache() const {
+        return _query_options.__isset.enable_scan_cache && _query_options.enable_scan_cache;
+    }
+
+    bool enable_cross_query_shared_scan() const {
+        return _query_options.__isset.enable_cross_query_shared_scan &&
+               _query_options.enable_cross_query_shared_scan;
+    }
+
     bool enable_share_hash_table_for_broadcast_join() const {
         return _query_options.__isset.enable_share_hash_table_for_broadcast_join &&
                _query_options.enable_share_hash_table_for_broadcast_join;
@@ -373,6 +393,20 @@ public:
         return 0;
     }
 
+    int64_t external_agg_bytes_threshold() const {
+        if (_query_options.__isset.external_agg_bytes_threshold) {
+            return _query_options.external_agg_bytes_threshold;
+        }
+        return 0;
+    }
+
+    int64_t external_join_bytes_threshold() const {
+        if (_query_options.__isset.external_join_bytes_threshold) {
+            return _query_options.external_join_bytes_threshold;
+        }
+        return 0;
+    }
+
 private:
     Status create_error_log_file();
 
@@ -464,8 +498,13 @@ private:
     std::ofstream* _error_log_file = nullptr; // error file path, absolute path
     std::vector<TTabletCommitInfo> _tablet_commit_infos;
     std::vector<TErrorTabletInfo> _error_tablet_infos;
+    // the time of the tablet sink of this fragment instance spent on writing the tablets
+    LoadStatistics _load_statistics;
+
+    QueryFragmentsCtx* _query_ctx = nullptr;
 
-    QueryFragmentsCtx* _query_ctx;
+    // the I/O of the threads attached to this fragment instance
+    io::IOStatistics _io_statistics;
 
     // true if max_filter_ratio is 0
     bool _load_zero_tolerance = false;
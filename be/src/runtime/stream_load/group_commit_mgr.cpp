@@ -0,0 +1,219 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/stream_load/group_commit_mgr.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "common/config.h"
+#include "runtime/exec_env.h"
+#include "runtime/message_body_sink.h"
+#include "runtime/stream_load/new_load_stream_mgr.h"
+#include "runtime/stream_load/stream_load_context.h"
+#include "runtime/stream_load/stream_load_executor.h"
+#include "util/time.h"
+#include "util/uid_util.h"
+
+namespace doris {
+
+struct GroupCommitMgr::Group {
+    std::shared_ptr<StreamLoadContext> ctx;
+    int64_t deadline_ms = 0;
+    // serialize the appends to the body sink, so the lines of different loads are not mixed
+    std::mutex append_lock;
+
+    // the following members are protected by the lock of the group
+    std::mutex lock;
+    std::condition_variable cond;
+    // the load of the group is started, the bodies can be appended
+    bool started = false;
+    // the bytes of the loads which joined the group
+    size_t bytes = 0;
+    // the loads which joined the group but are not appended yet
+    int num_pending = 0;
+    bool full = false;
+    bool done = false;
+    Status status;
+};
+
+std::shared_ptr<GroupCommitMgr::Group> GroupCommitMgr::_new_group(const StreamLoadContext& ctx) {
+    auto group = std::make_shared<Group>();
+    group->ctx = std::make_shared<StreamLoadContext>(_exec_env);
+    auto& group_ctx = *group->ctx;
+    group_ctx.load_type = ctx.load_type;
+    group_ctx.load_src_type = ctx.load_src_type;
+    group_ctx.db = ctx.db;
+    group_ctx.table = ctx.table;
+    group_ctx.label = "group_commit_" + generate_uuid_string();
+    group_ctx.auth = ctx.auth;
+    group_ctx.timeout_second = ctx.timeout_second;
+    group_ctx.format = ctx.format;
+    group_ctx.compress_type = ctx.compress_type;
+    group_ctx.header_type = ctx.header_type;
+    group->deadline_ms = UnixMillis() + config::group_commit_interval_ms;
+    return group;
+}
+
+Status GroupCommitMgr::commit(const std::string& key, std::shared_ptr<StreamLoadContext> ctx,
+                              const std::string& body, const StartLoadFunc& start_load) {
+    std::shared_ptr<Group> group;
+    bool is_first = false;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        auto it = _groups.find(key);
+        if (it != _groups.end()) {
+            std::lock_guard<std::mutex> gl(it->second->lock);
+            if (!it->second->full && !it->second->done) {
+                group = it->second;
+            }
+        }
+        if (group == nullptr) {
+            // the full group is closed by its first load, and removed from the map then.
+            group = _new_group(*ctx);
+            _groups[key] = group;
+            is_first = true;
+        }
+        std::lock_guard<std::mutex> gl(group->lock);
+        group->bytes += body.size();
+        ++group->num_pending;
+        if (group->bytes >= static_cast<size_t>(config::group_commit_max_bytes)) {
+            group->full = true;
+            group->cond.notify_all();
+        }
+    }
+
+    if (is_first) {
+        LOG(INFO) << "start group commit, " << group->ctx->brief() << ", db=" << ctx->db
+                  << ", tbl=" << ctx->table;
+        Status st = start_load(group->ctx);
+        std::lock_guard<std::mutex> gl(group->lock);
+        if (st.ok()) {
+            group->started = true;
+        } else {
+            _finish(group.get(), st);
+        }
+        group->cond.notify_all();
+    }
+
+    Status append_st = _append(group.get(), body);
+    Status st;
+    if (is_first) {
+        st = _close_and_commit(key, group);
+    } else {
+        std::unique_lock<std::mutex> gl(group->lock);
+        group->cond.wait(gl, [&] { return group->done; });
+        st = group->status;
+    }
+    if (!append_st.ok()) {
+        st = append_st;
+    }
+
+    const auto& group_ctx = *group->ctx;
+    ctx->label = group_ctx.label;
+    ctx->txn_id = group_ctx.txn_id;
+    ctx->number_total_rows = group_ctx.number_total_rows;
+    ctx->number_loaded_rows = group_ctx.number_loaded_rows;
+    ctx->number_filtered_rows = group_ctx.number_filtered_rows;
+    ctx->number_unselected_rows = group_ctx.number_unselected_rows;
+    ctx->loaded_bytes = group_ctx.loaded_bytes;
+    ctx->error_url = group_ctx.error_url;
+    ctx->stream_load_put_cost_nanos = group_ctx.stream_load_put_cost_nanos;
+    ctx->commit_and_publish_txn_cost_nanos = group_ctx.commit_and_publish_txn_cost_nanos;
+    return st;
+}
+
+Status GroupCommitMgr::_append(Group* group, const std::string& body) {
+    Status st;
+    {
+        std::unique_lock<std::mutex> gl(group->lock);
+        group->cond.wait(gl, [&] { return group->started || group->done; });
+        if (group->done) {
+            st = group->status;
+        }
+    }
+    if (st.ok() && !body.empty()) {
+        // the append may wait for the scanner to consume the pipe
+        std::lock_guard<std::mutex> al(group->append_lock);
+        st = group->ctx->body_sink->append(body.data(), body.size());
+        group->ctx->receive_bytes += body.size();
+    }
+    std::lock_guard<std::mutex> gl(group->lock);
+    --group->num_pending;
+    group->cond.notify_all();
+    return st;
+}
+
+Status GroupCommitMgr::_close_and_commit(const std::string& key,
+                                         const std::shared_ptr<Group>& group) {
+    {
+        std::unique_lock<std::mutex> gl(group->lock);
+        auto timeout = std::max<int64_t>(group->deadline_ms - UnixMillis(), 0);
+        group->cond.wait_for(gl, std::chrono::milliseconds(timeout),
+                             [&] { return group->full || group->done; });
+    }
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        auto it = _groups.find(key);
+        if (it != _groups.end() && it->second == group) {
+            _groups.erase(it);
+        }
+    }
+    // no one can join the group now, wait until the loads which joined it are appended
+    std::unique_lock<std::mutex> gl(group->lock);
+    group->cond.wait(gl, [&] { return group->num_pending == 0; });
+    if (group->done) {
+        return group->status;
+    }
+    gl.unlock();
+
+    auto* ctx = group->ctx.get();
+    Status st = ctx->body_sink->finish();
+    if (st.ok()) {
+        st = ctx->future.get();
+    }
+    if (st.ok()) {
+        int64_t commit_and_publish_start_time = MonotonicNanos();
+        st = _exec_env->stream_load_executor()->commit_txn(ctx);
+        ctx->commit_and_publish_txn_cost_nanos = MonotonicNanos() - commit_and_publish_start_time;
+    }
+    LOG(INFO) << "finish group commit, " << ctx->brief() << ", bytes=" << ctx->receive_bytes
+              << ", rows=" << ctx->number_loaded_rows << ", status=" << st;
+    gl.lock();
+    _finish(group.get(), st);
+    return st;
+}
+
+// called with the lock of the group
+void GroupCommitMgr::_finish(Group* group, const Status& status) {
+    auto* ctx = group->ctx.get();
+    if (!status.ok()) {
+        if (ctx->need_rollback) {
+            _exec_env->stream_load_executor()->rollback_txn(ctx);
+            ctx->need_rollback = false;
+        }
+        if (ctx->body_sink != nullptr) {
+            ctx->body_sink->cancel(status.to_string());
+        }
+    }
+    _exec_env->new_load_stream_mgr()->remove(ctx->id);
+    group->status = status;
+    group->done = true;
+    group->cond.notify_all();
+}
+
+} // namespace doris
@@ -0,0 +1,74 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "common/status.h"
+
+namespace doris {
+
+class ExecEnv;
+class StreamLoadContext;
+
+// Group commit merges the small stream loads with the same table and load properties into
+// a single load, so they are committed in one transaction, and write one rowset for each
+// tablet instead of one for each load. This avoids the version explosion when many small
+// loads arrive per second.
+//
+// The first load of a group starts the load of the group, and the later ones of the same
+// key only append their bodies to it. A group is closed after group_commit_interval_ms, or
+// when it has received group_commit_max_bytes. And then it's committed, all the loads of
+// the group wait for the commit and share its result, so a load is durable as soon as it
+// returns, the same as a normal stream load.
+class GroupCommitMgr {
+public:
+    // begin the transaction of the group and execute its plan,
+    // which reads from the body_sink of the context
+    using StartLoadFunc = std::function<Status(std::shared_ptr<StreamLoadContext>)>;
+
+    GroupCommitMgr(ExecEnv* exec_env) : _exec_env(exec_env) {}
+
+    // Load the body of ctx in the open group of key, or in a new group started by
+    // start_load. The body should end with the line delimiter "\n". Return the status of
+    // the group after it's committed, and set its transaction and rows to ctx.
+    Status commit(const std::string& key, std::shared_ptr<StreamLoadContext> ctx,
+                  const std::string& body, const StartLoadFunc& start_load);
+
+private:
+    struct Group;
+
+    std::shared_ptr<Group> _new_group(const StreamLoadContext& ctx);
+    Status _append(Group* group, const std::string& body);
+    // close the group and commit its load, called by the first load of the group
+    Status _close_and_commit(const std::string& key, const std::shared_ptr<Group>& group);
+    void _finish(Group* group, const Status& status);
+
+    ExecEnv* _exec_env;
+
+    std::mutex _lock;
+    // the open groups
+    std::unordered_map<std::string, std::shared_ptr<Group>> _groups;
+};
+
+} // namespace doris
@@ -17,6 +17,9 @@
 
 #include "runtime/stream_load/stream_load_context.h"
 
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
 #include <sstream>
 
 namespace doris {
@@ -96,6 +99,35 @@ std::string StreamLoadContext::to_json() const {
         writer.Key("ErrorURL");
         writer.String(error_url.c_str());
     }
+    // the time of writing the tablets, summed over the tablets and the backends
+    writer.Key("LoadProfile");
+    writer.StartObject();
+    writer.Key("MemLimitWaitTimeMs");
+    writer.Int64(load_statistics.mem_limit_wait_ns / 1000000);
+    writer.Key("FlushWaitTimeMs");
+    writer.Int64(load_statistics.flush_wait_ns / 1000000);
+    writer.Key("FlushTimeMs");
+    writer.Int64(load_statistics.flush_ns / 1000000);
+    writer.Key("FlushCount");
+    writer.Int64(load_statistics.flush_count);
+    writer.Key("FlushBytes");
+    writer.Int64(load_statistics.flush_bytes);
+    writer.Key("ColumnEncodeTimeMs");
+    writer.StartObject();
+    for (const auto& [name, ns] : load_statistics.column_encode_ns) {
+        writer.Key(name.c_str());
+        writer.Int64(ns / 1000000);
+    }
+    writer.EndObject();
+    writer.Key("SegmentCloseTimeMs");
+    writer.Int64(load_statistics.segment_close_ns / 1000000);
+    writer.Key("SegcompactionTimeMs");
+    writer.Int64(load_statistics.segcompaction_ns / 1000000);
+    writer.Key("RpcTimeMs");
+    writer.Int64(load_statistics.rpc_ns / 1000000);
+    writer.Key("RpcPendingWaitTimeMs");
+    writer.Int64(load_statistics.rpc_pending_wait_ns / 1000000);
+    writer.EndObject();
     writer.EndObject();
     return s.GetString();
 }
@@ -262,6 +294,14 @@ void StreamLoadContext::parse_stream_load_record(const std::string& stream_load_
         ss << ", Comment: " << comment_value.GetString();
     }
 
+    if (document.HasMember("LoadProfile")) {
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        document["LoadProfile"].Accept(writer);
+        stream_load_item.__set_load_profile(buffer.GetString());
+        ss << ", LoadProfile: " << buffer.GetString();
+    }
+
     VLOG(1) << "parse json from rocksdb. " << ss.str();
 }
 
@@ -29,6 +29,7 @@
 #include "gen_cpp/FrontendService_types.h"
 #include "io/fs/stream_load_pipe.h"
 #include "runtime/exec_env.h"
+#include "runtime/load_statistics.h"
 #include "runtime/message_body_sink.h"
 #include "runtime/stream_load/new_load_stream_mgr.h"
 #include "runtime/stream_load/stream_load_executor.h"
@@ -132,6 +133,8 @@ public:
     int32_t timeout_second = -1;
     AuthInfo auth;
     bool two_phase_commit = false;
+    // the load is merged with the others by GroupCommitMgr
+    bool group_commit = false;
     std::string load_comment;
 
     // the following members control the max progress of a consuming
@@ -186,6 +189,8 @@ public:
     int64_t pre_commit_txn_cost_nanos = 0;
     int64_t read_data_cost_nanos = 0;
     int64_t write_data_cost_nanos = 0;
+    // the time of the tablet sink spent on writing the tablets
+    LoadStatistics load_statistics;
 
     std::string error_url = "";
     // if label already be used, set existing job's status here
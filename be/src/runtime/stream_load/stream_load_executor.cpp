@@ -49,6 +49,7 @@ Status StreamLoadExecutor::execute_plan_fragment(std::shared_ptr<StreamLoadConte
             ctx->put_result.params, [ctx, this](RuntimeState* state, Status* status) {
                 ctx->exec_env()->new_load_stream_mgr()->remove(ctx->id);
                 ctx->commit_infos = std::move(state->tablet_commit_infos());
+                ctx->load_statistics = state->load_statistics();
                 if (status->ok()) {
                     ctx->number_total_rows = state->num_rows_load_total();
                     ctx->number_loaded_rows = state->num_rows_load_success();
@@ -22,13 +22,16 @@
 #include "olap/memtable.h"
 #include "olap/storage_engine.h"
 #include "runtime/load_channel.h"
+#include "runtime/load_statistics.h"
 #include "util/doris_metrics.h"
 
 namespace doris {
 
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(tablet_writer_count, MetricUnit::NOUNIT);
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(tablet_writer_reducing_mem_count, MetricUnit::NOUNIT);
 
 std::atomic<uint64_t> TabletsChannel::_s_tablet_writer_count;
+std::atomic<uint64_t> TabletsChannel::_s_reducing_mem_tablet_count;
 
 TabletsChannel::TabletsChannel(const TabletsChannelKey& key, const UniqueId& load_id,
                                bool is_high_priority)
@@ -40,6 +43,8 @@ TabletsChannel::TabletsChannel(const TabletsChannelKey& key, const UniqueId& loa
     static std::once_flag once_flag;
     std::call_once(once_flag, [] {
         REGISTER_HOOK_METRIC(tablet_writer_count, [&]() { return _s_tablet_writer_count.load(); });
+        REGISTER_HOOK_METRIC(tablet_writer_reducing_mem_count,
+                             [&]() { return _s_reducing_mem_tablet_count.load(); });
     });
 }
 
@@ -82,7 +87,7 @@ Status TabletsChannel::close(
         google::protobuf::RepeatedPtrField<PTabletError>* tablet_errors,
         const google::protobuf::Map<int64_t, PSlaveTabletNodes>& slave_tablet_nodes,
         google::protobuf::Map<int64_t, PSuccessSlaveTabletNodeIds>* success_slave_tablet_node_ids,
-        const bool write_single_replica) {
+        const bool write_single_replica, PLoadStatistics* load_statistics) {
     std::lock_guard<std::mutex> l(_lock);
     if (_state == kFinished) {
         return _close_status;
@@ -102,6 +107,7 @@ Status TabletsChannel::close(
     *finished = (_num_remaining_senders == 0);
     if (*finished) {
         _state = kFinished;
+        _seq_cond.notify_all();
         // All senders are closed
         // 1. close all delta writers
         std::set<DeltaWriter*> need_wait_writers;
@@ -144,16 +150,37 @@ Status TabletsChannel::close(
 
         _write_single_replica = write_single_replica;
 
-        // 2. wait delta writers and build the tablet vector
+        // 2. wait delta writers, commit their rowsets together and build the tablet vector
+        std::vector<DeltaWriter*> built_writers;
+        std::vector<TabletTxnCommit> commits;
         for (auto writer : need_wait_writers) {
+            TabletTxnCommit commit;
+            auto st = writer->build_rowset(&commit);
+            if (!st.ok()) {
+                // close may return failed, but no need to handle it here.
+                // tablet_vec will only contains success tablet, and then let FE judge it.
+                _add_close_wait_result(writer, st, tablet_vec, tablet_errors);
+                continue;
+            }
+            built_writers.push_back(writer);
+            commits.push_back(std::move(commit));
+        }
+        StorageEngine::instance()->txn_manager()->commit_txns(_txn_id, &commits);
+        for (size_t i = 0; i < built_writers.size(); ++i) {
+            auto writer = built_writers[i];
             PSlaveTabletNodes slave_nodes;
             if (write_single_replica) {
                 slave_nodes = slave_tablet_nodes.at(writer->tablet_id());
             }
-            // close may return failed, but no need to handle it here.
-            // tablet_vec will only contains success tablet, and then let FE judge it.
-            _close_wait(writer, tablet_vec, tablet_errors, slave_nodes, write_single_replica);
+            auto st = writer->finish_commit(commits[i], slave_nodes, write_single_replica);
+            _add_close_wait_result(writer, st, tablet_vec, tablet_errors);
+        }
+
+        LoadStatistics statistics;
+        for (auto writer : built_writers) {
+            writer->collect_load_statistics(&statistics);
         }
+        statistics.to_pb(load_statistics);
 
         if (write_single_replica) {
             // The operation waiting for all slave replicas to complete must end before the timeout,
@@ -182,12 +209,10 @@ Status TabletsChannel::close(
     return Status::OK();
 }
 
-void TabletsChannel::_close_wait(DeltaWriter* writer,
-                                 google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec,
-                                 google::protobuf::RepeatedPtrField<PTabletError>* tablet_errors,
-                                 PSlaveTabletNodes slave_tablet_nodes,
-                                 const bool write_single_replica) {
-    Status st = writer->close_wait(slave_tablet_nodes, write_single_replica);
+void TabletsChannel::_add_close_wait_result(
+        DeltaWriter* writer, const Status& st,
+        google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec,
+        google::protobuf::RepeatedPtrField<PTabletError>* tablet_errors) {
     if (st.ok()) {
         PTabletInfo* tablet_info = tablet_vec->Add();
         tablet_info->set_tablet_id(writer->tablet_id());
@@ -274,6 +299,7 @@ Status TabletsChannel::cancel() {
         it.second->cancel();
     }
     _state = kFinished;
+    _seq_cond.notify_all();
     if (_write_single_replica) {
         StorageEngine::instance()->txn_manager()->clear_txn_tablet_delta_writer(_txn_id);
     }
@@ -370,10 +396,21 @@ Status TabletsChannel::add_batch(const TabletWriterAddRequest& request,
     {
         std::lock_guard<std::mutex> l(_lock);
         _next_seqs[request.sender_id()] = cur_seq + 1;
+        _seq_cond.notify_all();
     }
     return Status::OK();
 }
 
+void TabletsChannel::get_writers_with_aged_memtable(int64_t max_age_ms,
+                                                    std::vector<int64_t>* tablet_ids) {
+    std::lock_guard<SpinLock> l(_tablet_writers_lock);
+    for (auto& it : _tablet_writers) {
+        if (it.second->memtable_age_ms() >= max_age_ms) {
+            tablet_ids->push_back(it.first);
+        }
+    }
+}
+
 void TabletsChannel::flush_memtable_async(int64_t tablet_id) {
     std::lock_guard<std::mutex> l(_lock);
     if (_state == kFinished) {
@@ -392,6 +429,7 @@ void TabletsChannel::flush_memtable_async(int64_t tablet_id) {
     if (!(_reducing_tablets.insert(tablet_id).second)) {
         return;
     }
+    _s_reducing_mem_tablet_count++;
 
     Status st = iter->second->flush_memtable_and_wait(false);
     if (!st.ok()) {
@@ -434,7 +472,9 @@ void TabletsChannel::wait_flush(int64_t tablet_id) {
 
     {
         std::lock_guard<std::mutex> l(_lock);
-        _reducing_tablets.erase(tablet_id);
+        if (_reducing_tablets.erase(tablet_id) > 0) {
+            _s_reducing_mem_tablet_count--;
+        }
     }
 }
 void TabletsChannel::_add_broken_tablet(int64_t tablet_id) {
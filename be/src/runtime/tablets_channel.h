@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <map>
@@ -25,6 +27,7 @@
 #include <utility>
 #include <vector>
 
+#include "common/config.h"
 #include "gen_cpp/PaloInternalService_types.h"
 #include "gen_cpp/Types_types.h"
 #include "gen_cpp/internal_service.pb.h"
@@ -70,7 +73,8 @@ public:
 
     // Mark sender with 'sender_id' as closed.
     // If all senders are closed, close this channel, set '*finished' to true, update 'tablet_vec'
-    // to include all tablets written in this channel.
+    // to include all tablets written in this channel, and set the time spent on writing the
+    // tablets in 'load_statistics'.
     // no-op when this channel has been closed or cancelled
     Status
     close(LoadChannel* parent, int sender_id, int64_t backend_id, bool* finished,
@@ -79,7 +83,7 @@ public:
           google::protobuf::RepeatedPtrField<PTabletError>* tablet_error,
           const google::protobuf::Map<int64_t, PSlaveTabletNodes>& slave_tablet_nodes,
           google::protobuf::Map<int64_t, PSuccessSlaveTabletNodeIds>* success_slave_tablet_node_ids,
-          const bool write_single_replica);
+          const bool write_single_replica, PLoadStatistics* load_statistics);
 
     // no-op when this channel has been closed or cancelled
     Status cancel();
@@ -92,6 +96,9 @@ public:
         *mem_consumptions = _mem_consumptions;
     }
 
+    // the tablets whose memtable has been written for max_age_ms or longer
+    void get_writers_with_aged_memtable(int64_t max_age_ms, std::vector<int64_t>* tablet_ids);
+
     void flush_memtable_async(int64_t tablet_id);
     void wait_flush(int64_t tablet_id);
 
@@ -104,11 +111,11 @@ private:
 
     bool _try_to_wait_flushing();
 
-    // deal with DeltaWriter close_wait(), add tablet to list for return.
-    void _close_wait(DeltaWriter* writer,
-                     google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec,
-                     google::protobuf::RepeatedPtrField<PTabletError>* tablet_error,
-                     PSlaveTabletNodes slave_tablet_nodes, const bool write_single_replica);
+    // add the tablet of a closed DeltaWriter to the list for return, by the result `st` of
+    // closing it.
+    void _add_close_wait_result(DeltaWriter* writer, const Status& st,
+                                google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec,
+                                google::protobuf::RepeatedPtrField<PTabletError>* tablet_error);
 
     void _add_broken_tablet(int64_t tablet_id);
     bool _is_broken_tablet(int64_t tablet_id);
@@ -118,6 +125,8 @@ private:
 
     // make execute sequence
     std::mutex _lock;
+    // notified with _lock when _next_seqs or _state changes
+    std::condition_variable _seq_cond;
 
     SpinLock _tablet_writers_lock;
 
@@ -159,6 +168,8 @@ private:
     std::unordered_set<int64_t> _partition_ids;
 
     static std::atomic<uint64_t> _s_tablet_writer_count;
+    // the tablets flushing their memtables to reduce the load mem consumption
+    static std::atomic<uint64_t> _s_reducing_mem_tablet_count;
 
     bool _is_high_priority = false;
 
@@ -171,7 +182,19 @@ private:
 
 template <typename Request>
 Status TabletsChannel::_get_current_seq(int64_t& cur_seq, const Request& request) {
-    std::lock_guard<std::mutex> l(_lock);
+    std::unique_lock<std::mutex> l(_lock);
+    // A sender may have several packets in flight, and they may arrive out of order.
+    // Wait for the former packets of the sender to be written, so that the packets
+    // are always written in the order of their packet_seq.
+    auto former_packets_written = [&]() {
+        return _state != kOpened || request.packet_seq() <= _next_seqs[request.sender_id()];
+    };
+    if (!former_packets_written()) {
+        _seq_cond.wait_for(l,
+                           std::chrono::milliseconds(
+                                   config::tablet_writer_wait_former_packet_timeout_ms),
+                           former_packets_written);
+    }
     if (_state != kOpened) {
         return _state == kFinished ? _close_status
                                    : Status::InternalError("TabletsChannel {} state: {}",
@@ -39,6 +39,15 @@ TaskGroupPtr TaskGroupManager::get_task_group(uint64_t id) {
     }
 }
 
+uint64_t TaskGroupManager::total_cpu_share() {
+    std::shared_lock<std::shared_mutex> r_lock(_group_mutex);
+    uint64_t total_share = 0;
+    for (auto& [id, tg] : _task_groups) {
+        total_share += tg->share();
+    }
+    return total_share;
+}
+
 void TaskGroupManager::_create_default_task_group() {
     _task_groups[DEFAULT_TG_ID] =
             std::make_shared<TaskGroup>(DEFAULT_TG_ID, "default_tg", DEFAULT_TG_CPU_SHARE);
@@ -32,6 +32,9 @@ public:
     // TODO pipeline task group
     TaskGroupPtr get_task_group(uint64_t id);
 
+    // the sum of cpu share of all task groups
+    uint64_t total_cpu_share();
+
     static constexpr uint64_t DEFAULT_TG_ID = 0;
     static constexpr uint64_t DEFAULT_TG_CPU_SHARE = 64;
 
@@ -18,8 +18,10 @@
 #include "runtime/thread_context.h"
 
 #include "common/signal_handler.h"
+#include "runtime/query_fragments_ctx.h"
 #include "runtime/runtime_state.h"
 #include "util/doris_metrics.h"
+#include "util/query_cpu_sampler.h"
 
 namespace doris {
 
@@ -47,12 +49,24 @@ AttachTask::AttachTask(const std::shared_ptr<MemTrackerLimiter>& mem_tracker,
 AttachTask::AttachTask(RuntimeState* runtime_state) {
     doris::signal::query_id_hi = runtime_state->query_id().hi;
     doris::signal::query_id_lo = runtime_state->query_id().lo;
+    // the tag is pthread local, so a bthread which may be moved to other pthreads is not tagged
+    if (bthread_self() == 0 && !QueryCpuSampler::is_tagged()) {
+        QueryCpuSampler::set_tag(runtime_state->query_id(), runtime_state->fragment_instance_id());
+        _tag_cpu_samples = true;
+    }
     thread_context()->attach_task(print_id(runtime_state->query_id()),
                                   runtime_state->fragment_instance_id(),
                                   runtime_state->query_mem_tracker());
+    if (runtime_state->get_query_fragments_ctx() != nullptr) {
+        thread_context()->memory_region = runtime_state->get_query_fragments_ctx()->memory_region;
+    }
+    thread_context()->io_statistics = runtime_state->io_statistics();
 }
 
 AttachTask::~AttachTask() {
+    if (_tag_cpu_samples) {
+        QueryCpuSampler::clear_tag();
+    }
     thread_context()->detach_task();
 #ifndef NDEBUG
     DorisMetrics::instance()->attach_task_thread_count->increment(1);
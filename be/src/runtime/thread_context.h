@@ -25,6 +25,7 @@
 #include "common/logging.h"
 #include "gen_cpp/PaloInternalService_types.h" // for TQueryType
 #include "gutil/macros.h"
+#include "runtime/memory/memory_region.h"
 #include "runtime/memory/thread_mem_tracker_mgr.h"
 #include "runtime/threadlocal.h"
 #include "util/defer_op.h"
@@ -85,6 +86,9 @@ namespace doris {
 
 class TUniqueId;
 class ThreadContext;
+namespace io {
+struct IOStatistics;
+} // namespace io
 
 extern bthread_key_t btls_key;
 
@@ -162,6 +166,8 @@ public:
     }
 
     void detach_task() {
+        memory_region.reset();
+        io_statistics = nullptr;
         _task_id = "";
         _fragment_instance_id = TUniqueId();
         thread_mem_tracker_mgr->detach_limiter_tracker();
@@ -186,6 +192,12 @@ public:
         return thread_mem_tracker_mgr->limiter_mem_tracker_raw();
     }
 
+    // The memory region of the attached query, the Allocator keeps the freed buffers in it.
+    std::shared_ptr<MemoryRegion> memory_region;
+
+    // The I/O statistics of the attached fragment instance, which the file readers count into.
+    io::IOStatistics* io_statistics = nullptr;
+
 private:
     std::string _task_id = "";
     TUniqueId _fragment_instance_id;
@@ -245,6 +257,11 @@ public:
     explicit AttachTask(RuntimeState* runtime_state);
 
     ~AttachTask();
+
+private:
+    // whether the CPU samples of the thread are tagged by this, which are kept if the thread is
+    // already tagged, e.g. by the pipeline task scheduler
+    bool _tag_cpu_samples = false;
 };
 
 class SwitchThreadMemTrackerLimiter {
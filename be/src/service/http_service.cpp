@@ -17,18 +17,22 @@
 
 #include "service/http_service.h"
 
+#include "http/action/arrow_stream_action.h"
 #include "http/action/check_rpc_channel_action.h"
 #include "http/action/check_tablet_segment_action.h"
 #include "http/action/checksum_action.h"
 #include "http/action/compaction_action.h"
 #include "http/action/config_action.h"
 #include "http/action/download_action.h"
+#include "http/action/file_cache_action.h"
+#include "http/action/fragment_replay_action.h"
 #include "http/action/health_action.h"
 #include "http/action/jeprofile_actions.h"
 #include "http/action/meta_action.h"
 #include "http/action/metrics_action.h"
 #include "http/action/pad_rowset_action.h"
 #include "http/action/pprof_actions.h"
+#include "http/action/query_cpu_profile_action.h"
 #include "http/action/reload_tablet_action.h"
 #include "http/action/reset_rpc_channel_action.h"
 #include "http/action/restore_tablet_action.h"
@@ -101,6 +105,28 @@ Status HttpService::start() {
     HealthAction* health_action = _pool.add(new HealthAction());
     _ev_http_server->register_handler(HttpMethod::GET, "/api/health", health_action);
 
+    // Register the summary of the files in the block file cache
+    FileCacheSummaryAction* file_cache_summary_action = _pool.add(new FileCacheSummaryAction());
+    _ev_http_server->register_handler(HttpMethod::GET, "/api/file_cache/summary",
+                                      file_cache_summary_action);
+
+    // Register the CPU samples of the queries
+    QueryCpuProfileAction* query_cpu_profile_action = _pool.add(new QueryCpuProfileAction());
+    _ev_http_server->register_handler(HttpMethod::GET, "/api/query_cpu_profile",
+                                      query_cpu_profile_action);
+
+    // Register the replay of the captured query fragments
+    FragmentReplayAction* fragment_replay_action = _pool.add(new FragmentReplayAction(_env));
+    _ev_http_server->register_handler(HttpMethod::GET, "/api/fragment_replay",
+                                      fragment_replay_action);
+    _ev_http_server->register_handler(HttpMethod::POST, "/api/fragment_replay",
+                                      fragment_replay_action);
+
+    // Register the arrow stream of the results of the external scans
+    ArrowStreamAction* arrow_stream_action = _pool.add(new ArrowStreamAction(_env));
+    _ev_http_server->register_handler(HttpMethod::GET, "/api/arrow_stream/{ticket}",
+                                      arrow_stream_action);
+
     // Register Tablets Info action
     TabletsInfoAction* tablets_info_action = _pool.add(new TabletsInfoAction());
     _ev_http_server->register_handler(HttpMethod::GET, "/tablets_json", tablets_info_action);
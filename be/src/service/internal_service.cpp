@@ -19,6 +19,7 @@
 
 #include <butil/iobuf.h>
 
+#include <numeric>
 #include <string>
 
 #include "common/config.h"
@@ -46,7 +47,9 @@
 #include "service/point_query_executor.h"
 #include "util/async_io.h"
 #include "util/brpc_client_cache.h"
+#include "util/countdown_latch.h"
 #include "util/defer_op.h"
+#include "util/doris_metrics.h"
 #include "util/md5.h"
 #include "util/proto_util.h"
 #include "util/ref_count_closure.h"
@@ -54,7 +57,10 @@
 #include "util/string_util.h"
 #include "util/telemetry/brpc_carrier.h"
 #include "util/telemetry/telemetry.h"
+#include "util/thread.h"
+#include "util/threadpool.h"
 #include "util/thrift_util.h"
+#include "util/time.h"
 #include "util/uid_util.h"
 #include "vec/core/block.h"
 #include "vec/data_types/data_type_string.h"
@@ -311,6 +317,8 @@ void PInternalServiceImpl::_tablet_writer_add_block(google::protobuf::RpcControl
         }
         response->set_execution_time_us(execution_time_ns / NANOS_PER_MICRO);
         response->set_wait_execution_time_us(wait_execution_time_ns / NANOS_PER_MICRO);
+        DorisMetrics::instance()->tablet_writer_add_block_latency_us->add(
+                (wait_execution_time_ns + execution_time_ns) / NANOS_PER_MICRO);
     });
     if (!ret) {
         LOG(WARNING) << "fail to offer request to the work pool";
@@ -836,13 +844,17 @@ void PInternalServiceImpl::transmit_block(google::protobuf::RpcController* contr
                                           const PTransmitDataParams* request,
                                           PTransmitDataResult* response,
                                           google::protobuf::Closure* done) {
-    bool ret = _heavy_work_pool.try_offer([this, controller, request, response, done]() {
+    int64_t receive_time_ns = MonotonicNanos();
+    bool ret = _heavy_work_pool.try_offer([this, controller, request, response, done,
+                                           receive_time_ns]() {
         // TODO(zxy) delete in 1.2 version
         google::protobuf::Closure* new_done = new NewHttpClosure<PTransmitDataParams>(done);
         brpc::Controller* cntl = static_cast<brpc::Controller*>(controller);
         attachment_transfer_request_block<PTransmitDataParams>(request, cntl);
 
         _transmit_block(controller, request, response, new_done, Status::OK());
+        DorisMetrics::instance()->transmit_block_latency_us->add(
+                (MonotonicNanos() - receive_time_ns) / NANOS_PER_MICRO);
     });
     if (!ret) {
         LOG(WARNING) << "fail to offer request to the work pool";
@@ -856,7 +868,8 @@ void PInternalServiceImpl::transmit_block_by_http(google::protobuf::RpcControlle
                                                   const PEmptyRequest* request,
                                                   PTransmitDataResult* response,
                                                   google::protobuf::Closure* done) {
-    bool ret = _heavy_work_pool.try_offer([this, controller, response, done]() {
+    int64_t receive_time_ns = MonotonicNanos();
+    bool ret = _heavy_work_pool.try_offer([this, controller, response, done, receive_time_ns]() {
         PTransmitDataParams* new_request = new PTransmitDataParams();
         google::protobuf::Closure* new_done =
                 new NewHttpClosure<PTransmitDataParams>(new_request, done);
@@ -864,6 +877,8 @@ void PInternalServiceImpl::transmit_block_by_http(google::protobuf::RpcControlle
         Status st =
                 attachment_extract_request_contain_block<PTransmitDataParams>(new_request, cntl);
         _transmit_block(controller, new_request, response, new_done, st);
+        DorisMetrics::instance()->transmit_block_latency_us->add(
+                (MonotonicNanos() - receive_time_ns) / NANOS_PER_MICRO);
     });
     if (!ret) {
         LOG(WARNING) << "fail to offer request to the work pool";
@@ -1239,74 +1254,146 @@ void PInternalServiceImpl::response_slave_tablet_pull_rowset(
     }
 }
 
+// Reads the columns of the rows in one segment, whose ordinal ids are sorted, so that every
+// column is read by one iterator and the adjacent rows share the pages.
+static Status read_segment_by_rowids(const TupleDescriptor& desc,
+                                     const PMultiGetRequest_RowId& first_row_id,
+                                     const std::vector<segment_v2::rowid_t>& ordinals,
+                                     vectorized::Block* sub_block) {
+    TabletSharedPtr tablet = StorageEngine::instance()->tablet_manager()->get_tablet(
+            first_row_id.tablet_id(), true /*include deleted*/);
+    if (!tablet) {
+        // the tablet is on another backend
+        return Status::OK();
+    }
+    RowsetId rowset_id;
+    rowset_id.init(first_row_id.rowset_id());
+    BetaRowsetSharedPtr rowset =
+            std::static_pointer_cast<BetaRowset>(tablet->get_rowset(rowset_id));
+    if (!rowset) {
+        LOG(INFO) << "no such rowset " << rowset_id;
+        return Status::OK();
+    }
+    const TabletSchemaSPtr tablet_schema = rowset->tablet_schema();
+    SegmentCacheHandle segment_cache;
+    RETURN_IF_ERROR(SegmentLoader::instance()->load_segments(rowset, &segment_cache, true));
+    // find segment
+    auto it = std::find_if(segment_cache.get_segments().begin(),
+                           segment_cache.get_segments().end(),
+                           [&first_row_id](const segment_v2::SegmentSharedPtr& seg) {
+                               return seg->id() == first_row_id.segment_id();
+                           });
+    if (it == segment_cache.get_segments().end()) {
+        return Status::OK();
+    }
+    segment_v2::SegmentSharedPtr segment = *it;
+    for (int x = 0; x < desc.slots().size() - 1; ++x) {
+        int index = tablet_schema->field_index(desc.slots()[x]->col_unique_id());
+        vectorized::MutableColumnPtr column =
+                sub_block->get_by_position(x).column->assume_mutable();
+        if (index < 0) {
+            column->insert_many_defaults(ordinals.size());
+            continue;
+        }
+        segment_v2::ColumnIterator* column_iterator = nullptr;
+        RETURN_IF_ERROR(
+                segment->new_column_iterator(tablet_schema->column(index), &column_iterator));
+        std::unique_ptr<segment_v2::ColumnIterator> ptr_guard(column_iterator);
+        segment_v2::ColumnIteratorOptions opt;
+        OlapReaderStatistics stats;
+        opt.file_reader = segment->file_reader().get();
+        opt.stats = &stats;
+        opt.use_page_cache = !config::disable_storage_page_cache;
+        RETURN_IF_ERROR(column_iterator->init(opt));
+        RETURN_IF_ERROR(column_iterator->read_by_rowids(ordinals.data(), ordinals.size(), column));
+    }
+    auto row_location_column = sub_block->get_columns().back()->assume_mutable();
+    for (auto ordinal : ordinals) {
+        GlobalRowLoacation row_location(first_row_id.tablet_id(), rowset->rowset_id(),
+                                        first_row_id.segment_id(), ordinal);
+        row_location_column->insert_data(reinterpret_cast<const char*>(&row_location),
+                                         sizeof(GlobalRowLoacation));
+    }
+    return Status::OK();
+}
+
+// Reads the rows grouped by the segments, and the segments are read in parallel.
 static Status read_by_rowids(
-        std::pair<size_t, size_t> row_range_idx, const TupleDescriptor& desc,
+        const TupleDescriptor& desc,
         const google::protobuf::RepeatedPtrField<PMultiGetRequest_RowId>& rowids,
-        vectorized::Block* sub_block) {
-    //read from row_range.first to row_range.second
-    for (size_t i = row_range_idx.first; i < row_range_idx.second; ++i) {
-        MonotonicStopWatch watch;
-        watch.start();
-        auto row_id = rowids[i];
-        TabletSharedPtr tablet = StorageEngine::instance()->tablet_manager()->get_tablet(
-                row_id.tablet_id(), true /*include deleted*/);
-        RowsetId rowset_id;
-        rowset_id.init(row_id.rowset_id());
-        if (!tablet) {
-            continue;
+        vectorized::Block* block) {
+    std::vector<int> sorted(rowids.size());
+    std::iota(sorted.begin(), sorted.end(), 0);
+    auto same_segment = [&rowids](int lhs, int rhs) {
+        return rowids[lhs].tablet_id() == rowids[rhs].tablet_id() &&
+               rowids[lhs].rowset_id() == rowids[rhs].rowset_id() &&
+               rowids[lhs].segment_id() == rowids[rhs].segment_id();
+    };
+    std::sort(sorted.begin(), sorted.end(), [&rowids](int lhs, int rhs) {
+        const auto& l = rowids[lhs];
+        const auto& r = rowids[rhs];
+        if (l.tablet_id() != r.tablet_id()) {
+            return l.tablet_id() < r.tablet_id();
         }
-        BetaRowsetSharedPtr rowset =
-                std::static_pointer_cast<BetaRowset>(tablet->get_rowset(rowset_id));
-        if (!rowset) {
-            LOG(INFO) << "no such rowset " << rowset_id;
-            continue;
+        if (l.rowset_id() != r.rowset_id()) {
+            return l.rowset_id() < r.rowset_id();
+        }
+        if (l.segment_id() != r.segment_id()) {
+            return l.segment_id() < r.segment_id();
+        }
+        return l.ordinal_id() < r.ordinal_id();
+    });
+
+    struct SegmentRows {
+        int first;
+        std::vector<segment_v2::rowid_t> ordinals;
+        std::unique_ptr<vectorized::Block> block;
+        Status status;
+    };
+    std::vector<SegmentRows> segments;
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        if (i == 0 || !same_segment(sorted[i], sorted[i - 1])) {
+            segments.push_back({sorted[i], {}, nullptr, Status::OK()});
+        }
+        auto ordinal = static_cast<segment_v2::rowid_t>(rowids[sorted[i]].ordinal_id());
+        auto& ordinals = segments.back().ordinals;
+        if (ordinals.empty() || ordinals.back() != ordinal) {
+            ordinals.push_back(ordinal);
         }
-        const TabletSchemaSPtr tablet_schema = rowset->tablet_schema();
-        VLOG_DEBUG << "get tablet schema column_num:" << tablet_schema->num_columns()
-                   << ", version:" << tablet_schema->schema_version()
-                   << ", cost(us):" << watch.elapsed_time() / 1000;
-        SegmentCacheHandle segment_cache;
-        RETURN_IF_ERROR(SegmentLoader::instance()->load_segments(rowset, &segment_cache, true));
-        // find segment
-        auto it = std::find_if(segment_cache.get_segments().begin(),
-                               segment_cache.get_segments().end(),
-                               [&row_id](const segment_v2::SegmentSharedPtr& seg) {
-                                   return seg->id() == row_id.segment_id();
-                               });
-        if (it == segment_cache.get_segments().end()) {
+    }
+
+    CountDownLatch latch(segments.size());
+    auto read_segment = [&](SegmentRows& rows) {
+        rows.block = std::make_unique<vectorized::Block>(desc.slots(), rows.ordinals.size());
+        rows.status = read_segment_by_rowids(desc, rowids[rows.first], rows.ordinals,
+                                             rows.block.get());
+        latch.count_down();
+    };
+    auto* thread_pool = ExecEnv::GetInstance()->multiget_thread_pool();
+    for (size_t i = 0; i < segments.size(); ++i) {
+        // the last segment and the ones can not be submitted are read by this thread
+        bool submitted = false;
+        if (thread_pool != nullptr && i + 1 < segments.size()) {
+            submitted = thread_pool->submit_func([&, i]() { read_segment(segments[i]); }).ok();
+        }
+        if (!submitted) {
+            read_segment(segments[i]);
+        }
+    }
+    latch.wait();
+
+    auto columns = block->mutate_columns();
+    for (auto& rows : segments) {
+        RETURN_IF_ERROR(rows.status);
+        size_t num_rows = rows.block->rows();
+        if (num_rows == 0) {
             continue;
         }
-        segment_v2::SegmentSharedPtr segment = *it;
-        for (int x = 0; x < desc.slots().size() - 1; ++x) {
-            int index = tablet_schema->field_index(desc.slots()[x]->col_unique_id());
-            segment_v2::ColumnIterator* column_iterator = nullptr;
-            vectorized::MutableColumnPtr column =
-                    sub_block->get_by_position(x).column->assume_mutable();
-            if (index < 0) {
-                column->insert_default();
-                continue;
-            } else {
-                RETURN_IF_ERROR(segment->new_column_iterator(tablet_schema->column(index),
-                                                             &column_iterator));
-            }
-            std::unique_ptr<segment_v2::ColumnIterator> ptr_guard(column_iterator);
-            segment_v2::ColumnIteratorOptions opt;
-            OlapReaderStatistics stats;
-            opt.file_reader = segment->file_reader().get();
-            opt.stats = &stats;
-            opt.use_page_cache = !config::disable_storage_page_cache;
-            column_iterator->init(opt);
-            std::vector<segment_v2::rowid_t> rowids {
-                    static_cast<segment_v2::rowid_t>(row_id.ordinal_id())};
-            RETURN_IF_ERROR(column_iterator->read_by_rowids(rowids.data(), 1, column));
+        for (size_t x = 0; x < columns.size(); ++x) {
+            columns[x]->insert_range_from(*rows.block->get_by_position(x).column, 0, num_rows);
         }
-        LOG_EVERY_N(INFO, 100) << "multiget_data single_row, cost(us):"
-                               << watch.elapsed_time() / 1000;
-        GlobalRowLoacation row_location(row_id.tablet_id(), rowset->rowset_id(),
-                                        row_id.segment_id(), row_id.ordinal_id());
-        sub_block->get_columns().back()->assume_mutable()->insert_data(
-                reinterpret_cast<const char*>(&row_location), sizeof(GlobalRowLoacation));
     }
+    block->set_columns(std::move(columns));
     return Status::OK();
 }
 
@@ -1321,8 +1408,7 @@ Status PInternalServiceImpl::_multi_get(const PMultiGetRequest* request,
     }
     assert(desc.slots().back()->col_name() == BeConsts::ROWID_COL);
     vectorized::Block block(desc.slots(), request->rowids().size());
-    RETURN_IF_ERROR(
-            read_by_rowids(std::pair {0, request->rowids_size()}, desc, request->rowids(), &block));
+    RETURN_IF_ERROR(read_by_rowids(desc, request->rowids(), &block));
     std::vector<size_t> char_type_idx;
     for (size_t i = 0; i < desc.slots().size(); i++) {
         auto column_desc = desc.slots()[i];
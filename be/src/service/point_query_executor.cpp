@@ -17,16 +17,24 @@
 
 #include "service/point_query_executor.h"
 
+#include <algorithm>
+#include <map>
+#include <thread>
+#include <unordered_set>
+
 #include "olap/lru_cache.h"
 #include "olap/row_cursor.h"
 #include "olap/storage_engine.h"
 #include "service/internal_service.h"
 #include "util/defer_op.h"
 #include "util/key_util.h"
+#include "util/murmur_hash3.h"
 #include "util/runtime_profile.h"
+#include "util/threadpool.h"
 #include "util/thrift_util.h"
 #include "vec/exprs/vexpr.h"
 #include "vec/exprs/vliteral.h"
+#include "vec/exprs/vslot_ref.h"
 #include "vec/jsonb/serialize.h"
 #include "vec/sink/vmysql_result_writer.cpp"
 
@@ -36,6 +44,28 @@ Reusable::~Reusable() {
     for (vectorized::VExprContext* ctx : _output_exprs_ctxs) {
         ctx->close(_runtime_state.get());
     }
+    if (_block_pool != nullptr) {
+        for (size_t i = 0; i < kMaxPooledBlocks; ++i) {
+            delete _block_pool[i].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// the slot to start with when taking or returning a pooled block, different threads start with
+// different slots, so they seldom race for the same one
+static size_t block_pool_start_slot() {
+    static thread_local const size_t start_slot =
+            std::hash<std::thread::id>()(std::this_thread::get_id());
+    return start_slot;
+}
+
+static void collect_slot_ids(const vectorized::VExpr* expr, std::unordered_set<int>* slot_ids) {
+    if (expr->is_slot_ref()) {
+        slot_ids->insert(static_cast<const vectorized::VSlotRef*>(expr)->slot_id());
+    }
+    for (const auto* child : expr->children()) {
+        collect_slot_ids(child, slot_ids);
+    }
 }
 
 Status Reusable::init(const TDescriptorTable& t_desc_tbl, const std::vector<TExpr>& output_exprs,
@@ -43,9 +73,11 @@ Status Reusable::init(const TDescriptorTable& t_desc_tbl, const std::vector<TExp
     _runtime_state.reset(new RuntimeState());
     RETURN_IF_ERROR(DescriptorTbl::create(_runtime_state->obj_pool(), t_desc_tbl, &_desc_tbl));
     _runtime_state->set_desc_tbl(_desc_tbl);
-    _block_pool.resize(block_size);
-    for (int i = 0; i < _block_pool.size(); ++i) {
-        _block_pool[i] = std::make_unique<vectorized::Block>(tuple_desc()->slots(), 10);
+    _block_pool.reset(new std::atomic<vectorized::Block*>[kMaxPooledBlocks]);
+    for (size_t i = 0; i < kMaxPooledBlocks; ++i) {
+        _block_pool[i].store(i < block_size ? new vectorized::Block(tuple_desc()->slots(), 10)
+                                            : nullptr,
+                             std::memory_order_relaxed);
     }
 
     RETURN_IF_ERROR(vectorized::VExpr::create_expr_trees(_runtime_state->obj_pool(), output_exprs,
@@ -53,28 +85,54 @@ Status Reusable::init(const TDescriptorTable& t_desc_tbl, const std::vector<TExp
     RowDescriptor row_desc(tuple_desc(), false);
     // Prepare the exprs to run.
     RETURN_IF_ERROR(vectorized::VExpr::prepare(_output_exprs_ctxs, _runtime_state.get(), row_desc));
+    std::unordered_set<int> output_slot_ids;
+    for (auto* ctx : _output_exprs_ctxs) {
+        collect_slot_ids(ctx->root(), &output_slot_ids);
+    }
+    for (int i = 0; i < tuple_desc()->slots().size(); ++i) {
+        const SlotDescriptor* slot = tuple_desc()->slots()[i];
+        int32_t col_uid = slot->col_unique_id();
+        if (output_slot_ids.count(slot->id()) == 0 || col_uid < 0) {
+            continue;
+        }
+        if (col_uid >= _col_uid_to_pos.size()) {
+            _col_uid_to_pos.resize(col_uid + 1, -1);
+        }
+        _col_uid_to_pos[col_uid] = i;
+    }
     _create_timestamp = butil::gettimeofday_ms();
     return Status::OK();
 }
 
 std::unique_ptr<vectorized::Block> Reusable::get_block() {
-    std::lock_guard lock(_block_mutex);
-    if (_block_pool.empty()) {
-        return std::make_unique<vectorized::Block>(tuple_desc()->slots(), 4);
+    size_t start_slot = block_pool_start_slot();
+    for (size_t i = 0; i < kMaxPooledBlocks; ++i) {
+        auto& slot = _block_pool[(start_slot + i) % kMaxPooledBlocks];
+        if (slot.load(std::memory_order_relaxed) == nullptr) {
+            continue;
+        }
+        vectorized::Block* block = slot.exchange(nullptr, std::memory_order_acquire);
+        if (block != nullptr) {
+            return std::unique_ptr<vectorized::Block>(block);
+        }
     }
-    auto block = std::move(_block_pool.back());
-    CHECK(block != nullptr);
-    _block_pool.pop_back();
-    return block;
+    return std::make_unique<vectorized::Block>(tuple_desc()->slots(), 4);
 }
 
 void Reusable::return_block(std::unique_ptr<vectorized::Block>& block) {
-    std::lock_guard lock(_block_mutex);
-    if (_block_pool.size() > 128) {
-        return;
-    }
     block->clear_column_data();
-    _block_pool.push_back(std::move(block));
+    size_t start_slot = block_pool_start_slot();
+    for (size_t i = 0; i < kMaxPooledBlocks; ++i) {
+        auto& slot = _block_pool[(start_slot + i) % kMaxPooledBlocks];
+        vectorized::Block* expected = nullptr;
+        if (slot.load(std::memory_order_relaxed) == nullptr &&
+            slot.compare_exchange_strong(expected, block.get(), std::memory_order_release,
+                                         std::memory_order_relaxed)) {
+            block.release();
+            return;
+        }
+    }
+    // the pool is full, the block is freed by the caller
 }
 
 RowCache* RowCache::_s_instance = nullptr;
@@ -82,7 +140,8 @@ RowCache* RowCache::_s_instance = nullptr;
 RowCache::RowCache(int64_t capacity, int num_shards) {
     // Create Row Cache
     _cache = std::unique_ptr<Cache>(
-            new_lru_cache("RowCache", capacity, LRUCacheType::SIZE, num_shards));
+            new_lru_cache("RowCache", capacity, LRUCacheType::SIZE, num_shards, 0,
+                          config::enable_cache_clock_eviction));
 }
 
 // Create global instance of this class
@@ -132,6 +191,15 @@ Status PointQueryExecutor::init(const PTabletKeyLookupRequest* request,
                   static_cast<uint64_t>(request->uuid().uuid_low())};
     auto cache_handle = LookupCache::instance().get(uuid);
     _binary_row_format = request->is_binary_row();
+    uint128 fingerprint = 0;
+    if (cache_handle == nullptr && !request->desc_tbl().empty()) {
+        // the same statement may be prepared by other connections
+        fingerprint = _plan_fingerprint(request);
+        cache_handle = LookupCache::instance().get(fingerprint);
+        if (cache_handle != nullptr && uuid != 0) {
+            LookupCache::instance().add(uuid, cache_handle);
+        }
+    }
     if (cache_handle != nullptr) {
         _reusable = cache_handle;
         _hit_lookup_cache = true;
@@ -149,12 +217,13 @@ Status PointQueryExecutor::init(const PTabletKeyLookupRequest* request,
                 reinterpret_cast<const uint8_t*>(request->output_expr().data()), &len, false,
                 &t_output_exprs));
         _reusable = reusable_ptr;
+        // could be reused by requests after, pre allocte more blocks
+        RETURN_IF_ERROR(reusable_ptr->init(t_desc_tbl, t_output_exprs.exprs, 128));
         if (uuid != 0) {
-            // could be reused by requests after, pre allocte more blocks
-            RETURN_IF_ERROR(reusable_ptr->init(t_desc_tbl, t_output_exprs.exprs, 128));
             LookupCache::instance().add(uuid, reusable_ptr);
-        } else {
-            RETURN_IF_ERROR(reusable_ptr->init(t_desc_tbl, t_output_exprs.exprs, 1));
+        }
+        if (fingerprint != 0) {
+            LookupCache::instance().add(fingerprint, reusable_ptr);
         }
     }
     _tablet = StorageEngine::instance()->tablet_manager()->get_tablet(request->tablet_id());
@@ -169,7 +238,18 @@ Status PointQueryExecutor::init(const PTabletKeyLookupRequest* request,
     return Status::OK();
 }
 
+uint128 PointQueryExecutor::_plan_fingerprint(const PTabletKeyLookupRequest* request) {
+    uint64_t desc_tbl_hash[2];
+    murmur_hash3_x64_128(request->desc_tbl().data(), request->desc_tbl().size(), 0,
+                         desc_tbl_hash);
+    uint64_t hash[2];
+    murmur_hash3_x64_128(request->output_expr().data(), request->output_expr().size(),
+                         static_cast<uint32_t>(desc_tbl_hash[0]), hash);
+    return uint128(hash[0] ^ desc_tbl_hash[1], hash[1]);
+}
+
 Status PointQueryExecutor::lookup_up() {
+    RETURN_IF_ERROR(_lookup_row_cache());
     RETURN_IF_ERROR(_lookup_row_key());
     RETURN_IF_ERROR(_lookup_row_data());
     RETURN_IF_ERROR(_output_data());
@@ -179,17 +259,21 @@ Status PointQueryExecutor::lookup_up() {
 std::string PointQueryExecutor::print_profile() {
     auto init_us = _profile_metrics.init_ns.value() / 1000;
     auto init_key_us = _profile_metrics.init_key_ns.value() / 1000;
+    auto lookup_row_cache_us = _profile_metrics.lookup_row_cache_ns.value() / 1000;
     auto lookup_key_us = _profile_metrics.lookup_key_ns.value() / 1000;
     auto lookup_data_us = _profile_metrics.lookup_data_ns.value() / 1000;
+    auto read_rows_us = _profile_metrics.read_rows_ns.value() / 1000;
     auto output_data_us = _profile_metrics.output_data_ns.value() / 1000;
-    auto total_us = init_us + lookup_key_us + lookup_data_us + output_data_us;
+    auto total_us =
+            init_us + lookup_row_cache_us + lookup_key_us + lookup_data_us + output_data_us;
     auto read_stats = _profile_metrics.read_stats;
     return fmt::format(
             ""
-            "[lookup profile:{}us] init:{}us, init_key:{}us,"
+            "[lookup profile:{}us] init:{}us, init_key:{}us, lookup_row_cache:{}us, "
             ""
             ""
-            "lookup_key:{}us, lookup_data:{}us, output_data:{}us, hit_lookup_cache:{}"
+            "lookup_key:{}us, lookup_key_tasks:{}, lookup_data:{}us, read_rows:{}us, "
+            "output_data:{}us, hit_lookup_cache:{}"
             ""
             ""
             ", is_binary_row:{}, output_columns:{}, total_keys:{}, row_cache_hits:{}"
@@ -197,11 +281,11 @@ std::string PointQueryExecutor::print_profile() {
             "io_latency:{}ns, "
             "uncompressed_bytes_read:{}"
             "",
-            total_us, init_us, init_key_us, lookup_key_us, lookup_data_us, output_data_us,
-            _hit_lookup_cache, _binary_row_format, _reusable->output_exprs().size(),
-            _row_read_ctxs.size(), _row_cache_hits, read_stats.cached_pages_num,
-            read_stats.total_pages_num, read_stats.compressed_bytes_read, read_stats.io_ns,
-            read_stats.uncompressed_bytes_read);
+            total_us, init_us, init_key_us, lookup_row_cache_us, lookup_key_us, _lookup_key_tasks,
+            lookup_data_us, read_rows_us, output_data_us, _hit_lookup_cache, _binary_row_format,
+            _reusable->output_exprs().size(), _row_read_ctxs.size(), _row_cache_hits,
+            read_stats.cached_pages_num, read_stats.total_pages_num,
+            read_stats.compressed_bytes_read, read_stats.io_ns, read_stats.uncompressed_bytes_read);
 }
 
 Status PointQueryExecutor::_init_keys(const PTabletKeyLookupRequest* request) {
@@ -228,35 +312,81 @@ Status PointQueryExecutor::_init_keys(const PTabletKeyLookupRequest* request) {
     return Status::OK();
 }
 
+Status PointQueryExecutor::_lookup_row_cache() {
+    SCOPED_TIMER(&_profile_metrics.lookup_row_cache_ns);
+    if (config::disable_storage_row_cache) {
+        return Status::OK();
+    }
+    for (size_t i = 0; i < _row_read_ctxs.size(); ++i) {
+        RowCache::CacheHandle cache_handle;
+        auto hit_cache = RowCache::instance()->lookup(
+                {_tablet->tablet_id(), _row_read_ctxs[i]._primary_key}, &cache_handle);
+        if (hit_cache) {
+            _row_read_ctxs[i]._cached_row_data = std::move(cache_handle);
+            ++_row_cache_hits;
+        }
+    }
+    return Status::OK();
+}
+
 Status PointQueryExecutor::_lookup_row_key() {
     SCOPED_TIMER(&_profile_metrics.lookup_key_ns);
     // 2. lookup row location
-    Status st;
+    std::vector<size_t> indices;
     for (size_t i = 0; i < _row_read_ctxs.size(); ++i) {
-        RowLocation location;
-        if (!config::disable_storage_row_cache) {
-            RowCache::CacheHandle cache_handle;
-            auto hit_cache = RowCache::instance()->lookup(
-                    {_tablet->tablet_id(), _row_read_ctxs[i]._primary_key}, &cache_handle);
-            if (hit_cache) {
-                _row_read_ctxs[i]._cached_row_data = std::move(cache_handle);
-                ++_row_cache_hits;
-                continue;
-            }
+        if (!_row_read_ctxs[i]._cached_row_data.valid()) {
+            indices.push_back(i);
         }
+    }
+    size_t batch_size = std::max(config::point_query_lookup_batch_size, 1);
+    auto* thread_pool = StorageEngine::instance()->get_bg_multiget_threadpool();
+    if (indices.size() <= batch_size || thread_pool == nullptr) {
+        return _lookup_row_keys(indices, 0, indices.size());
+    }
+    // Lookup the keys of an IN list in parallel. They are sorted first, so the keys of a task
+    // are close to each other and likely to share the index pages.
+    std::sort(indices.begin(), indices.end(), [this](size_t lhs, size_t rhs) {
+        return _row_read_ctxs[lhs]._primary_key < _row_read_ctxs[rhs]._primary_key;
+    });
+    _lookup_key_tasks = (indices.size() + batch_size - 1) / batch_size;
+    std::vector<Status> statuses(_lookup_key_tasks);
+    auto token = thread_pool->new_token(ThreadPool::ExecutionMode::CONCURRENT);
+    for (size_t i = 0; i < _lookup_key_tasks; ++i) {
+        size_t begin = i * batch_size;
+        size_t end = std::min(begin + batch_size, indices.size());
+        Status st = token->submit_func([this, &indices, &statuses, i, begin, end]() {
+            statuses[i] = _lookup_row_keys(indices, begin, end);
+        });
+        if (!st.ok()) {
+            token->shutdown();
+            return st;
+        }
+    }
+    token->wait();
+    for (auto& st : statuses) {
+        RETURN_IF_ERROR(st);
+    }
+    return Status::OK();
+}
+
+Status PointQueryExecutor::_lookup_row_keys(const std::vector<size_t>& indices, size_t begin,
+                                            size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        RowReadContext& ctx = _row_read_ctxs[indices[i]];
+        RowLocation location;
         // Get rowlocation and rowset, ctx._rowset_ptr will acquire wrap this ptr
         auto rowset_ptr = std::make_unique<RowsetSharedPtr>();
-        st = (_tablet->lookup_row_key(_row_read_ctxs[i]._primary_key, nullptr, &location,
-                                      INT32_MAX /*rethink?*/, rowset_ptr.get()));
+        Status st = _tablet->lookup_row_key(ctx._primary_key, nullptr, &location,
+                                            INT32_MAX /*rethink?*/, rowset_ptr.get());
         if (st.is_not_found()) {
             continue;
         }
         RETURN_IF_ERROR(st);
-        _row_read_ctxs[i]._row_location = location;
+        ctx._row_location = location;
         // acquire and wrap this rowset
         (*rowset_ptr)->acquire();
         VLOG_DEBUG << "aquire rowset " << (*rowset_ptr)->unique_id();
-        _row_read_ctxs[i]._rowset_ptr = std::unique_ptr<RowsetSharedPtr, decltype(&release_rowset)>(
+        ctx._rowset_ptr = std::unique_ptr<RowsetSharedPtr, decltype(&release_rowset)>(
                 rowset_ptr.release(), &release_rowset);
     }
     return Status::OK();
@@ -265,21 +395,62 @@ Status PointQueryExecutor::_lookup_row_key() {
 Status PointQueryExecutor::_lookup_row_data() {
     // 3. get values
     SCOPED_TIMER(&_profile_metrics.lookup_data_ns);
+    // the rows of a segment are read at once, in the order of row ids
+    std::map<std::pair<RowsetId, uint32_t>, std::vector<size_t>> segment_rows;
+    for (size_t i = 0; i < _row_read_ctxs.size(); ++i) {
+        const RowReadContext& ctx = _row_read_ctxs[i];
+        if (!ctx._cached_row_data.valid() && ctx._row_location.has_value()) {
+            auto& location = ctx._row_location.value();
+            segment_rows[{location.rowset_id, location.segment_id}].push_back(i);
+        }
+    }
+    std::vector<vectorized::MutableColumnPtr> row_columns;
+    // the row of _row_read_ctxs[i] is row_columns[row_positions[i].first][row_positions[i].second]
+    std::vector<std::pair<size_t, size_t>> row_positions(_row_read_ctxs.size());
+    {
+        SCOPED_TIMER(&_profile_metrics.read_rows_ns);
+        for (auto& [segment, rows] : segment_rows) {
+            std::sort(rows.begin(), rows.end(), [this](size_t lhs, size_t rhs) {
+                return _row_read_ctxs[lhs]._row_location->row_id <
+                       _row_read_ctxs[rhs]._row_location->row_id;
+            });
+            std::vector<segment_v2::rowid_t> rowids;
+            for (size_t i : rows) {
+                auto row_id = _row_read_ctxs[i]._row_location->row_id;
+                // the same key may be in the IN list more than once
+                if (rowids.empty() || rowids.back() != row_id) {
+                    rowids.push_back(row_id);
+                }
+                row_positions[i] = {row_columns.size(), rowids.size() - 1};
+            }
+            vectorized::MutableColumnPtr column = vectorized::ColumnString::create();
+            RETURN_IF_ERROR(_tablet->read_row_store_column(*(_row_read_ctxs[rows[0]]._rowset_ptr),
+                                                           segment.second, rowids,
+                                                           _profile_metrics.read_stats, column));
+            DCHECK_EQ(column->size(), rowids.size());
+            row_columns.emplace_back(std::move(column));
+        }
+    }
     for (size_t i = 0; i < _row_read_ctxs.size(); ++i) {
         if (_row_read_ctxs[i]._cached_row_data.valid()) {
             vectorized::JsonbSerializeUtil::jsonb_to_block(
                     *_reusable->tuple_desc(), _row_read_ctxs[i]._cached_row_data.data().data,
-                    _row_read_ctxs[i]._cached_row_data.data().size, *_result_block);
+                    _row_read_ctxs[i]._cached_row_data.data().size, _reusable->col_uid_to_pos(),
+                    *_result_block);
             continue;
         }
         if (!_row_read_ctxs[i]._row_location.has_value()) {
             continue;
         }
-        RETURN_IF_ERROR(_tablet->lookup_row_data(
-                _row_read_ctxs[i]._primary_key, _row_read_ctxs[i]._row_location.value(),
-                *(_row_read_ctxs[i]._rowset_ptr), _reusable->tuple_desc(),
-                _profile_metrics.read_stats, _result_block.get(),
-                !config::disable_storage_row_cache /*whether write row cache*/));
+        auto [column_idx, row_idx] = row_positions[i];
+        StringRef value = row_columns[column_idx]->get_data_at(row_idx);
+        if (!config::disable_storage_row_cache) {
+            RowCache::instance()->insert({_tablet->tablet_id(), _row_read_ctxs[i]._primary_key},
+                                         Slice {value.data, value.size});
+        }
+        vectorized::JsonbSerializeUtil::jsonb_to_block(*_reusable->tuple_desc(), value.data,
+                                                       value.size, _reusable->col_uid_to_pos(),
+                                                       *_result_block);
     }
     return Status::OK();
 }
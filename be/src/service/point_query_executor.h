@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 
 #include "butil/containers/doubly_buffered_data.h"
@@ -46,6 +47,7 @@ public:
     Status init(const TDescriptorTable& t_desc_tbl, const std::vector<TExpr>& output_exprs,
                 size_t block_size = 1);
 
+    // thread safe and lock free
     std::unique_ptr<vectorized::Block> get_block();
 
     // do not touch block after returned
@@ -55,14 +57,21 @@ public:
 
     const std::vector<vectorized::VExprContext*>& output_exprs() { return _output_exprs_ctxs; }
 
+    // map from the col_unique_id of a slot to its position in the block, or -1 if the column is
+    // not used by the output exprs, so it's not decoded from the row store
+    const std::vector<int>& col_uid_to_pos() const { return _col_uid_to_pos; }
+
 private:
     // caching TupleDescriptor, output_expr, etc...
     std::unique_ptr<RuntimeState> _runtime_state;
     DescriptorTbl* _desc_tbl;
-    std::mutex _block_mutex;
     // prevent from allocte too many tmp blocks
-    std::vector<std::unique_ptr<vectorized::Block>> _block_pool;
+    static constexpr size_t kMaxPooledBlocks = 128;
+    // each slot holds a pooled block or nullptr, the blocks are taken and returned by atomic
+    // exchanges, so that the concurrent requests of a hot statement don't contend on a lock
+    std::unique_ptr<std::atomic<vectorized::Block*>[]> _block_pool;
     std::vector<vectorized::VExprContext*> _output_exprs_ctxs;
+    std::vector<int> _col_uid_to_pos;
     int64_t _create_timestamp = 0;
 };
 
@@ -150,7 +159,9 @@ private:
 };
 
 // A cache used for prepare stmt.
-// One connection per stmt perf uuid
+// One connection per stmt perf uuid. The items are also added by the fingerprints of their
+// descriptor tables and output exprs, so the same statement of other connections, or of the
+// connections after a FE failover, reuses them without parsing and preparing again.
 // Use DoublyBufferedData to wrap Cache for performance and thread safe,
 // since it's barely modified
 class LookupCache {
@@ -227,13 +238,18 @@ struct Metrics {
     Metrics()
             : init_ns(TUnit::TIME_NS),
               init_key_ns(TUnit::TIME_NS),
+              lookup_row_cache_ns(TUnit::TIME_NS),
               lookup_key_ns(TUnit::TIME_NS),
               lookup_data_ns(TUnit::TIME_NS),
+              read_rows_ns(TUnit::TIME_NS),
               output_data_ns(TUnit::TIME_NS) {}
     RuntimeProfile::Counter init_ns;
     RuntimeProfile::Counter init_key_ns;
+    RuntimeProfile::Counter lookup_row_cache_ns;
     RuntimeProfile::Counter lookup_key_ns;
     RuntimeProfile::Counter lookup_data_ns;
+    // the part of lookup_data_ns reading the row store columns of the segments
+    RuntimeProfile::Counter read_rows_ns;
     RuntimeProfile::Counter output_data_ns;
     OlapReaderStatistics read_stats;
 };
@@ -248,10 +264,18 @@ public:
     std::string print_profile();
 
 private:
+    // the fingerprint of the plan of the request, the same for all the connections
+    static uint128 _plan_fingerprint(const PTabletKeyLookupRequest* request);
+
     Status _init_keys(const PTabletKeyLookupRequest* request);
 
+    Status _lookup_row_cache();
+
     Status _lookup_row_key();
 
+    // lookup the keys of _row_read_ctxs[indices[begin, end)]
+    Status _lookup_row_keys(const std::vector<size_t>& indices, size_t begin, size_t end);
+
     Status _lookup_row_data();
 
     Status _output_data();
@@ -282,6 +306,7 @@ private:
     std::unique_ptr<vectorized::Block> _result_block;
     Metrics _profile_metrics;
     size_t _row_cache_hits = 0;
+    size_t _lookup_key_tasks = 0;
     bool _hit_lookup_cache = false;
     bool _binary_row_format = false;
 };
@@ -0,0 +1,62 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace doris {
+
+// A token bucket shared by threads to limit the total rate of the bytes they transfer. The
+// bucket holds the tokens of at most one second, and a thread taking more tokens than there are
+// sleeps until the debt is repaid, so the rate is kept while the threads transfer any sizes.
+class BandwidthLimiter {
+public:
+    // Takes `bytes` from the bucket refilled with `bytes_per_sec`, which is unlimited if it's not
+    // positive.
+    void acquire(int64_t bytes, int64_t bytes_per_sec) {
+        if (bytes_per_sec <= 0) {
+            return;
+        }
+        double debt_sec = 0;
+        {
+            std::lock_guard<std::mutex> l(_lock);
+            auto now = std::chrono::steady_clock::now();
+            double elapsed_sec = std::chrono::duration<double>(now - _last_refill).count();
+            _last_refill = now;
+            _tokens = std::min<double>(_tokens + elapsed_sec * bytes_per_sec, bytes_per_sec);
+            _tokens -= bytes;
+            if (_tokens < 0) {
+                debt_sec = -_tokens / bytes_per_sec;
+            }
+        }
+        if (debt_sec > 0) {
+            std::this_thread::sleep_for(std::chrono::duration<double>(debt_sec));
+        }
+    }
+
+private:
+    std::mutex _lock;
+    double _tokens = 0;
+    std::chrono::steady_clock::time_point _last_refill = std::chrono::steady_clock::now();
+};
+
+} // namespace doris
@@ -21,6 +21,12 @@
 
 #include "util/bit_packing.h"
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 namespace doris {
 
 inline int64_t BitPacking::NumValuesToUnpack(int bit_width, int64_t in_bytes, int64_t num_values) {
@@ -231,6 +237,79 @@ void DecodeValue(OutType* __restrict__ dict, int64_t dict_len, uint32_t idx,
     }
 }
 
+#if defined(__AVX2__) || defined(__aarch64__)
+// The byte shuffle and the shifts to unpack 8 values of BIT_WIDTH <= 16 bits from 16 bytes.
+// The 32-bit lane i gets the 4 bytes from the byte of its first bit, which is then shifted
+// right by the offset of the bit in the byte and masked. The bytes past the 16 loaded bytes
+// never hold bits of the 8 values, they are zeroed by a shuffle index with the high bit set.
+template <int BIT_WIDTH>
+struct SimdUnpackTable {
+    uint8_t shuffle[32];
+    int32_t shifts[8];
+
+    constexpr SimdUnpackTable() : shuffle(), shifts() {
+        for (int i = 0; i < 8; ++i) {
+            int first_bit = i * BIT_WIDTH;
+            for (int j = 0; j < 4; ++j) {
+                int byte = first_bit / CHAR_BIT + j;
+                shuffle[i * 4 + j] = byte < 16 ? byte : 0x80;
+            }
+            shifts[i] = first_bit % CHAR_BIT;
+        }
+    }
+};
+
+template <int BIT_WIDTH>
+inline constexpr SimdUnpackTable<BIT_WIDTH> SIMD_UNPACK_TABLE{};
+
+// Unpacks 8 values of BIT_WIDTH bits, which are in the first BIT_WIDTH bytes of 'in'. Reads
+// 16 bytes from 'in'.
+template <int BIT_WIDTH>
+inline void SimdUnpack8Values(const uint8_t* __restrict__ in, uint32_t* __restrict__ out) {
+    static_assert(BIT_WIDTH > 0 && BIT_WIDTH <= 16, "Unsupported bit width");
+    const auto& table = SIMD_UNPACK_TABLE<BIT_WIDTH>;
+#ifdef __AVX2__
+    // _mm256_shuffle_epi8 shuffles within each 128-bit half, so both halves get the 16 bytes.
+    __m256i bytes = _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(in)));
+    __m256i words = _mm256_shuffle_epi8(
+            bytes, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(table.shuffle)));
+    words = _mm256_srlv_epi32(
+            words, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(table.shifts)));
+    words = _mm256_and_si256(words, _mm256_set1_epi32(static_cast<int>(GetMask(BIT_WIDTH))));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), words);
+#else
+    uint8x16_t bytes = vld1q_u8(in);
+    uint32x4_t mask = vdupq_n_u32(static_cast<uint32_t>(GetMask(BIT_WIDTH)));
+    for (int i = 0; i < 2; ++i) {
+        uint32x4_t words =
+                vreinterpretq_u32_u8(vqtbl1q_u8(bytes, vld1q_u8(table.shuffle + i * 16)));
+        // shift right by shifting left by the negative amounts
+        words = vshlq_u32(words, vnegq_s32(vld1q_s32(table.shifts + i * 4)));
+        vst1q_u32(out + i * 4, vandq_u32(words, mask));
+    }
+#endif
+}
+
+// Unpacks 32 values of BIT_WIDTH bits with SIMD instructions. Reads 3 * BIT_WIDTH + 16 bytes
+// from 'in', which is more than the 4 * BIT_WIDTH bytes of the values unless BIT_WIDTH is 16.
+template <typename OutType, int BIT_WIDTH>
+inline void SimdUnpack32Values(const uint8_t* __restrict__ in, OutType* __restrict__ out) {
+    // 8 values take exactly BIT_WIDTH bytes
+    for (int i = 0; i < 4; ++i) {
+        if constexpr (std::is_same_v<OutType, uint32_t>) {
+            SimdUnpack8Values<BIT_WIDTH>(in + i * BIT_WIDTH, out + i * 8);
+        } else {
+            uint32_t values[8];
+            SimdUnpack8Values<BIT_WIDTH>(in + i * BIT_WIDTH, values);
+            for (int j = 0; j < 8; ++j) {
+                out[i * 8 + j] = static_cast<OutType>(values[j]);
+            }
+        }
+    }
+}
+#endif
+
 template <typename OutType, int BIT_WIDTH>
 const uint8_t* BitPacking::Unpack32Values(const uint8_t* __restrict__ in, int64_t in_bytes,
                                           OutType* __restrict__ out) {
@@ -240,6 +319,17 @@ const uint8_t* BitPacking::Unpack32Values(const uint8_t* __restrict__ in, int64_
     constexpr int BYTES_TO_READ = BitUtil::RoundUpNumBytes(32 * BIT_WIDTH);
     DCHECK_GE(in_bytes, BYTES_TO_READ);
 
+#if defined(__AVX2__) || defined(__aarch64__)
+    // The SIMD unpacking reads past the values, so the last batches of the input are unpacked
+    // by the scalar code below.
+    if constexpr (BIT_WIDTH > 0 && BIT_WIDTH <= 16 && sizeof(OutType) <= sizeof(uint32_t)) {
+        if (in_bytes >= 3 * BIT_WIDTH + 16) {
+            SimdUnpack32Values<OutType, BIT_WIDTH>(in, out);
+            return in + BYTES_TO_READ;
+        }
+    }
+#endif
+
     // Call UnpackValue for 0 <= i < 32.
 #pragma push_macro("UNPACK_VALUE_CALL")
 #define UNPACK_VALUE_CALL(ignore1, i, ignore2) \
@@ -102,6 +102,12 @@ public:
     template <typename T>
     bool GetValue(int num_bits, T* v);
 
+    // Gets the next 'num_values' values of 'num_bits' bits into 'v'. Once the stream is at a
+    // byte boundary, the values are unpacked in batches by BitPacking. Returns the number of
+    // values read, which is less than 'num_values' if there are not enough bytes left.
+    template <typename T>
+    int UnpackBatch(int num_bits, int num_values, T* v);
+
     // Reads a 'num_bytes'-sized value from the buffer and stores it in 'v'. T needs to be a
     // little-endian native type and big enough to store 'num_bytes'. The value is assumed
     // to be byte-aligned so the stream will be advanced to the start of the next byte
@@ -135,6 +135,35 @@ bool BitReader::GetValue(int num_bits, T* v) {
     return true;
 }
 
+template <typename T>
+int BitReader::UnpackBatch(int num_bits, int num_values, T* v) {
+    int i = 0;
+    if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+        // read the values before the byte boundary one by one
+        for (; i < num_values && position() % 8 != 0; ++i) {
+            if (PREDICT_FALSE(!GetValue(num_bits, &v[i]))) {
+                return i;
+            }
+        }
+        if (i < num_values) {
+            int byte_pos = position() / 8;
+            using UnsignedT = std::make_unsigned_t<T>;
+            auto result = BitPacking::UnpackValues(num_bits, buffer_ + byte_pos,
+                                                   max_bytes_ - byte_pos, num_values - i,
+                                                   reinterpret_cast<UnsignedT*>(v + i));
+            Advance(result.second * num_bits);
+            i += static_cast<int>(result.second);
+        }
+    } else {
+        for (; i < num_values; ++i) {
+            if (PREDICT_FALSE(!GetValue(num_bits, &v[i]))) {
+                break;
+            }
+        }
+    }
+    return i;
+}
+
 inline void BitReader::Rewind(int num_bits) {
     bit_offset_ -= num_bits;
     if (bit_offset_ >= 0) {
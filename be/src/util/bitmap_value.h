@@ -31,6 +31,7 @@
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "common/logging.h"
 #include "gutil/integral_types.h"
@@ -131,7 +132,8 @@ public:
 
     Roaring64Map(const Roaring64Map& r) : roarings(r.roarings), copyOnWrite(r.copyOnWrite) {}
 
-    Roaring64Map(Roaring64Map&& r) : roarings(r.roarings), copyOnWrite(r.copyOnWrite) {}
+    Roaring64Map(Roaring64Map&& r) noexcept
+            : roarings(std::move(r.roarings)), copyOnWrite(r.copyOnWrite) {}
 
     /**
      * Assignment operator.
@@ -141,6 +143,14 @@ public:
         return *this;
     }
 
+    /**
+     * Move assignment operator, which takes the 32-bit bitmaps of r without copying them.
+     */
+    Roaring64Map& operator=(Roaring64Map&& r) noexcept {
+        roarings = std::move(r.roarings);
+        return *this;
+    }
+
     /**
      * Construct a bitmap from a list of integer values.
      */
@@ -906,10 +916,22 @@ public:
      * pointer).
      */
     static Roaring64Map fastunion(size_t n, const Roaring64Map** inputs) {
-        Roaring64Map ans;
-        // not particularly fast
+        // the 32-bit bitmaps of every high bytes are unioned at once by roaring_bitmap_or_many,
+        // which ORs the containers lazily and repairs their cardinalities only at the end
+        phmap::btree_map<uint32_t, std::vector<const roaring::Roaring*>> grouped;
         for (size_t lcv = 0; lcv < n; ++lcv) {
-            ans |= *(inputs[lcv]);
+            for (const auto& map_entry : inputs[lcv]->roarings) {
+                grouped[map_entry.first].push_back(&map_entry.second);
+            }
+        }
+        Roaring64Map ans;
+        for (auto& [key, bitmaps] : grouped) {
+            if (bitmaps.size() == 1) {
+                ans.emplaceOrInsert(key, *bitmaps[0]);
+            } else {
+                ans.emplaceOrInsert(key,
+                                    roaring::Roaring::fastunion(bitmaps.size(), bitmaps.data()));
+            }
         }
         return ans;
     }
@@ -952,7 +974,7 @@ private:
     }
 
     void emplaceOrInsert(const uint32_t key, roaring::Roaring&& value) {
-        roarings.emplace(key, value);
+        roarings.emplace(key, std::move(value));
     }
 };
 
@@ -1294,7 +1316,9 @@ public:
                 _type = BITMAP;
                 break;
             case BITMAP:
-                _bitmap |= detail::Roaring64Map::fastunion(bitmaps.size(), bitmaps.data());
+                // unioned with the others instead of with a temporary union of them
+                bitmaps.push_back(&_bitmap);
+                _bitmap = detail::Roaring64Map::fastunion(bitmaps.size(), bitmaps.data());
                 break;
             }
         }
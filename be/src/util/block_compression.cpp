@@ -21,6 +21,7 @@
 #include <lz4/lz4frame.h>
 #include <snappy/snappy-sinksource.h>
 #include <snappy/snappy.h>
+#include <zdict.h>
 #include <zlib.h>
 #include <zstd.h>
 #include <zstd_errors.h>
@@ -582,7 +583,7 @@ public:
 
 // for ZSTD compression and decompression, with BOTH fast and high compression ratio
 class ZstdBlockCompression : public BlockCompressionCodec {
-private:
+protected:
     struct CContext {
         CContext() : ctx(nullptr) {}
         ZSTD_CCtx* ctx;
@@ -656,6 +657,13 @@ public:
             return Status::InvalidArgument("ZSTD_CCtx_setParameter checksumFlag error: {}",
                                            ZSTD_getErrorString(ZSTD_getErrorCode(ret)));
         }
+        if (_cdict != nullptr) {
+            ret = ZSTD_CCtx_refCDict(context->ctx, _cdict);
+            if (ZSTD_isError(ret)) {
+                return Status::InvalidArgument("ZSTD_CCtx_refCDict error: {}",
+                                               ZSTD_getErrorString(ZSTD_getErrorCode(ret)));
+            }
+        }
 
         ZSTD_outBuffer out_buf = {compressed_buf.data, compressed_buf.size, 0};
 
@@ -709,6 +717,15 @@ public:
             }
         }};
 
+        if (_ddict != nullptr) {
+            auto ret = ZSTD_DCtx_refDDict(context->ctx, _ddict);
+            if (ZSTD_isError(ret)) {
+                compress_failed = true;
+                return Status::InvalidArgument("ZSTD_DCtx_refDDict error: {}",
+                                               ZSTD_getErrorString(ZSTD_getErrorCode(ret)));
+            }
+        }
+
         ZSTD_inBuffer in_buf = {input.data, input.size, 0};
         ZSTD_outBuffer out_buf = {output->data, output->size, 0};
 
@@ -800,6 +817,11 @@ private:
         delete context;
     }
 
+protected:
+    // the dictionary of the codecs of ZstdDictBlockCompression
+    ZSTD_CDict* _cdict = nullptr;
+    ZSTD_DDict* _ddict = nullptr;
+
 private:
     mutable std::mutex _ctx_c_mutex;
     mutable std::vector<CContext*> _ctx_c_pool;
@@ -808,6 +830,25 @@ private:
     mutable std::vector<DContext*> _ctx_d_pool;
 };
 
+// Compresses with a dictionary, the data is only decompressed by a codec of the same dictionary.
+class ZstdDictBlockCompression final : public ZstdBlockCompression {
+public:
+    ~ZstdDictBlockCompression() override {
+        ZSTD_freeCDict(_cdict);
+        ZSTD_freeDDict(_ddict);
+    }
+
+    Status init(const Slice& dict) {
+        _cdict = ZSTD_createCDict(dict.data, dict.size, ZSTD_CLEVEL_DEFAULT);
+        _ddict = ZSTD_createDDict(dict.data, dict.size);
+        if (_cdict == nullptr || _ddict == nullptr) {
+            return Status::InvalidArgument("failed to create ZSTD dictionary of {} bytes",
+                                           dict.size);
+        }
+        return Status::OK();
+    }
+};
+
 class GzipBlockCompression final : public ZlibBlockCompression {
 public:
     static GzipBlockCompression* instance() {
@@ -913,6 +954,36 @@ Status get_block_compression_codec(segment_v2::CompressionTypePB type,
     return Status::OK();
 }
 
+Status create_zstd_dict_compression_codec(const Slice& dict,
+                                          std::unique_ptr<BlockCompressionCodec>* codec) {
+    auto zstd_codec = std::make_unique<ZstdDictBlockCompression>();
+    RETURN_IF_ERROR(zstd_codec->init(dict));
+    *codec = std::move(zstd_codec);
+    return Status::OK();
+}
+
+Status train_zstd_dictionary(const std::vector<Slice>& samples, size_t max_dict_size,
+                             std::string* dict) {
+    std::string samples_buffer;
+    std::vector<size_t> sample_sizes;
+    for (const auto& sample : samples) {
+        if (sample.size > 0) {
+            samples_buffer.append(sample.data, sample.size);
+            sample_sizes.push_back(sample.size);
+        }
+    }
+    dict->resize(max_dict_size);
+    size_t dict_size = ZDICT_trainFromBuffer(dict->data(), dict->size(), samples_buffer.data(),
+                                             sample_sizes.data(), sample_sizes.size());
+    if (ZDICT_isError(dict_size)) {
+        dict->clear();
+        return Status::InvalidArgument("ZDICT_trainFromBuffer error: {}",
+                                       ZDICT_getErrorName(dict_size));
+    }
+    dict->resize(dict_size);
+    return Status::OK();
+}
+
 Status get_block_compression_codec(tparquet::CompressionCodec::type parquet_codec,
                                    BlockCompressionCodec** codec) {
     switch (parquet_codec) {
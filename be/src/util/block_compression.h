@@ -18,6 +18,8 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "common/status.h"
@@ -81,4 +83,15 @@ Status get_block_compression_codec(segment_v2::CompressionTypePB type,
 Status get_block_compression_codec(tparquet::CompressionCodec::type parquet_codec,
                                    BlockCompressionCodec** codec);
 
+// Creates a ZSTD codec of the dictionary, which is copied into the codec. The data compressed
+// by it are only decompressed by the codecs of the same dictionary. It's thread safe as the
+// ZSTD codec of get_block_compression_codec.
+Status create_zstd_dict_compression_codec(const Slice& dict,
+                                          std::unique_ptr<BlockCompressionCodec>* codec);
+
+// Trains a ZSTD dictionary of at most `max_dict_size` bytes from the samples, which fails if
+// the samples are too few or too small.
+Status train_zstd_dictionary(const std::vector<Slice>& samples, size_t max_dict_size,
+                             std::string* dict);
+
 } // namespace doris
@@ -26,6 +26,7 @@
 #include <condition_variable>
 #include <list>
 #include <mutex>
+#include <vector>
 
 #include "common/logging.h"
 #include "util/stopwatch.hpp"
@@ -64,6 +65,29 @@ public:
         }
     }
 
+    // Gets at most `max_elements` elements from the queue into `out` under one lock, waiting
+    // indefinitely for at least one to become available.
+    // Returns false if we were shut down prior to getting any element, and there
+    // are no more elements available.
+    bool blocking_get_batch(std::vector<T>* out, size_t max_elements) {
+        MonotonicStopWatch timer;
+        timer.start();
+        std::unique_lock<std::mutex> unique_lock(_lock);
+        _get_cv.wait(unique_lock, [this] { return _shutdown || !_list.empty(); });
+        _total_get_wait_time += timer.elapsed_time();
+
+        if (_list.empty()) {
+            assert(_shutdown);
+            return false;
+        }
+        while (!_list.empty() && max_elements-- > 0) {
+            out->push_back(std::move(_list.front()));
+            _list.pop_front();
+        }
+        _put_cv.notify_all();
+        return true;
+    }
+
     // Puts an element into the queue, waiting indefinitely until there is space.
     // If the queue is shut down, returns false.
     bool blocking_put(const T& val) {
@@ -82,6 +106,33 @@ public:
         return true;
     }
 
+    // Puts all the elements of `vals` into the queue, as many as there is space for under each
+    // lock, waiting indefinitely until there is space for the rest.
+    // If the queue is shut down, returns false and the elements not put are left in `vals`,
+    // otherwise `vals` is cleared.
+    bool blocking_put_batch(std::vector<T>* vals) {
+        MonotonicStopWatch timer;
+        timer.start();
+        std::unique_lock<std::mutex> unique_lock(_lock);
+        size_t num_put = 0;
+        while (num_put < vals->size()) {
+            _put_cv.wait(unique_lock,
+                         [this] { return _shutdown || _list.size() < _max_elements; });
+            if (_shutdown) {
+                _total_put_wait_time += timer.elapsed_time();
+                vals->erase(vals->begin(), vals->begin() + num_put);
+                return false;
+            }
+            while (num_put < vals->size() && _list.size() < _max_elements) {
+                _list.push_back((*vals)[num_put++]);
+            }
+            _get_cv.notify_all();
+        }
+        _total_put_wait_time += timer.elapsed_time();
+        vals->clear();
+        return true;
+    }
+
     // Shut down the queue. Wakes up all threads waiting on BlockingGet or BlockingPut.
     void shutdown() {
         {
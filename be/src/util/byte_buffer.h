@@ -21,6 +21,8 @@
 
 #include <cstddef>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "common/logging.h"
 
@@ -62,8 +64,72 @@ struct ByteBuffer {
     size_t capacity;
 
 private:
+    friend class ByteBufferPool;
+
     ByteBuffer(size_t capacity_)
             : ptr(new char[capacity_]), pos(0), limit(capacity_), capacity(capacity_) {}
 };
 
+// A pool of the buffers with the same capacity. A buffer goes back to the pool when its
+// last reference is released, so the chunks of the stream loads are reused instead of
+// allocated and freed for each chunk. At most max_free_buffers are kept in the pool, and
+// the pool must outlive all the buffers allocated from it.
+class ByteBufferPool {
+public:
+    ByteBufferPool(size_t buffer_capacity, size_t max_free_buffers)
+            : _buffer_capacity(buffer_capacity), _max_free_buffers(max_free_buffers) {}
+
+    ~ByteBufferPool() {
+        for (auto* buf : _free_buffers) {
+            delete buf;
+        }
+    }
+
+    ByteBufferPool(const ByteBufferPool&) = delete;
+    ByteBufferPool& operator=(const ByteBufferPool&) = delete;
+
+    // the returned buffer is cleared, like the one of ByteBuffer::allocate()
+    ByteBufferPtr allocate() {
+        ByteBuffer* buf = nullptr;
+        {
+            std::lock_guard<std::mutex> l(_lock);
+            if (!_free_buffers.empty()) {
+                buf = _free_buffers.back();
+                _free_buffers.pop_back();
+            }
+        }
+        if (buf == nullptr) {
+            buf = new ByteBuffer(_buffer_capacity);
+        } else {
+            buf->pos = 0;
+            buf->limit = buf->capacity;
+        }
+        return ByteBufferPtr(buf, [this](ByteBuffer* b) { _release(b); });
+    }
+
+    size_t buffer_capacity() const { return _buffer_capacity; }
+
+    size_t num_free_buffers() {
+        std::lock_guard<std::mutex> l(_lock);
+        return _free_buffers.size();
+    }
+
+private:
+    void _release(ByteBuffer* buf) {
+        {
+            std::lock_guard<std::mutex> l(_lock);
+            if (_free_buffers.size() < _max_free_buffers) {
+                _free_buffers.push_back(buf);
+                return;
+            }
+        }
+        delete buf;
+    }
+
+    const size_t _buffer_capacity;
+    const size_t _max_free_buffers;
+    std::mutex _lock;
+    std::vector<ByteBuffer*> _free_buffers;
+};
+
 } // namespace doris
@@ -0,0 +1,255 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/ddsketch.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "util/coding.h"
+
+namespace doris {
+
+namespace {
+
+uint32_t zigzag_encode(int32_t value) {
+    return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+}
+
+int32_t zigzag_decode(uint32_t value) {
+    return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+}
+
+uint8_t* encode_double(uint8_t* dst, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    encode_fixed64_le(dst, bits);
+    return dst + sizeof(bits);
+}
+
+const uint8_t* decode_double(const uint8_t* src, const uint8_t* end, double* value) {
+    if (src == nullptr || end - src < static_cast<ptrdiff_t>(sizeof(uint64_t))) {
+        return nullptr;
+    }
+    uint64_t bits = decode_fixed64_le(src);
+    memcpy(value, &bits, sizeof(bits));
+    return src + sizeof(bits);
+}
+
+} // namespace
+
+DDSketch::DDSketch(double relative_accuracy, uint32_t max_num_buckets)
+        : _max_num_buckets(std::max<uint32_t>(max_num_buckets, 1)) {
+    _init(relative_accuracy);
+}
+
+void DDSketch::_init(double relative_accuracy) {
+    _relative_accuracy =
+            std::clamp(relative_accuracy, MIN_RELATIVE_ACCURACY, MAX_RELATIVE_ACCURACY);
+    _gamma = (1 + _relative_accuracy) / (1 - _relative_accuracy);
+    _log_gamma = std::log(_gamma);
+    _inv_log_gamma = 1.0 / _log_gamma;
+    _min_indexable_value = std::numeric_limits<double>::min() * _gamma;
+}
+
+void DDSketch::add(double value, uint64_t count) {
+    if (count == 0 || !std::isfinite(value)) {
+        return;
+    }
+    if (value > _min_indexable_value) {
+        _positive.add(_index(value), count, _max_num_buckets);
+    } else if (value < -_min_indexable_value) {
+        _negative.add(_index(-value), count, _max_num_buckets);
+    } else {
+        _zero_count += count;
+    }
+    _min = std::min(_min, value);
+    _max = std::max(_max, value);
+}
+
+void DDSketch::merge(const DDSketch& other) {
+    if (other.empty()) {
+        return;
+    }
+    _negative.merge(other._negative, _max_num_buckets);
+    _positive.merge(other._positive, _max_num_buckets);
+    _zero_count += other._zero_count;
+    _min = std::min(_min, other._min);
+    _max = std::max(_max, other._max);
+}
+
+double DDSketch::quantile(double q) const {
+    if (empty()) {
+        return std::nan("");
+    }
+    // the extremes are exact
+    if (q <= 0) {
+        return _min;
+    } else if (q >= 1) {
+        return _max;
+    }
+    const double rank = q * (count() - 1);
+    double result = _max;
+    uint64_t n = 0;
+    for (size_t i = _negative.counts.size(); i > 0; --i) {
+        n += _negative.counts[i - 1];
+        if (n > rank) {
+            result = -_value(_negative.offset + i - 1);
+            return std::clamp(result, _min, _max);
+        }
+    }
+    n += _zero_count;
+    if (n > rank) {
+        return std::clamp(0.0, _min, _max);
+    }
+    for (size_t i = 0; i < _positive.counts.size(); ++i) {
+        n += _positive.counts[i];
+        if (n > rank) {
+            result = _value(_positive.offset + i);
+            break;
+        }
+    }
+    return std::clamp(result, _min, _max);
+}
+
+size_t DDSketch::serialized_size() const {
+    return sizeof(double) + varint_length(_max_num_buckets) + 2 * sizeof(double) +
+           varint_length(_zero_count) + _negative.serialized_size() + _positive.serialized_size();
+}
+
+size_t DDSketch::serialize(uint8_t* dst) const {
+    uint8_t* ptr = encode_double(dst, _relative_accuracy);
+    ptr = encode_varint32(ptr, _max_num_buckets);
+    ptr = encode_double(ptr, _min);
+    ptr = encode_double(ptr, _max);
+    ptr = encode_varint64(ptr, _zero_count);
+    ptr = _negative.serialize(ptr);
+    ptr = _positive.serialize(ptr);
+    return ptr - dst;
+}
+
+bool DDSketch::unserialize(const uint8_t* src, size_t size) {
+    const uint8_t* end = src + size;
+    double relative_accuracy = 0;
+    const uint8_t* ptr = decode_double(src, end, &relative_accuracy);
+    uint32_t max_num_buckets = 0;
+    if (ptr == nullptr || !(relative_accuracy >= MIN_RELATIVE_ACCURACY &&
+                            relative_accuracy <= MAX_RELATIVE_ACCURACY)) {
+        return false;
+    }
+    ptr = decode_varint32_ptr(ptr, end, &max_num_buckets);
+    if (ptr == nullptr || max_num_buckets == 0) {
+        return false;
+    }
+    _init(relative_accuracy);
+    _max_num_buckets = max_num_buckets;
+    ptr = decode_double(ptr, end, &_min);
+    ptr = decode_double(ptr, end, &_max);
+    ptr = ptr == nullptr ? nullptr : decode_varint64_ptr(ptr, end, &_zero_count);
+    ptr = ptr == nullptr ? nullptr : _negative.unserialize(ptr, end);
+    ptr = ptr == nullptr ? nullptr : _positive.unserialize(ptr, end);
+    if (ptr != end || _negative.counts.size() > _max_num_buckets ||
+        _positive.counts.size() > _max_num_buckets) {
+        *this = DDSketch(relative_accuracy, max_num_buckets);
+        return false;
+    }
+    return true;
+}
+
+int32_t DDSketch::Store::extend(int32_t lo, int32_t hi, int32_t index, uint32_t max_num_buckets) {
+    if (!counts.empty()) {
+        lo = std::min(lo, offset);
+        hi = std::max(hi, static_cast<int32_t>(offset + counts.size() - 1));
+    }
+    if (static_cast<int64_t>(hi) - lo + 1 > max_num_buckets) {
+        // the lowest buckets are collapsed into the lowest kept one
+        lo = hi - static_cast<int32_t>(max_num_buckets) + 1;
+    }
+    if (counts.empty() || lo != offset || hi != offset + static_cast<int32_t>(counts.size()) - 1) {
+        std::vector<uint64_t> new_counts(static_cast<size_t>(hi - lo) + 1, 0);
+        for (size_t i = 0; i < counts.size(); ++i) {
+            new_counts[std::max(static_cast<int32_t>(offset + i), lo) - lo] += counts[i];
+        }
+        counts.swap(new_counts);
+        offset = lo;
+    }
+    return std::max(index, lo);
+}
+
+void DDSketch::Store::add(int32_t index, uint64_t count, uint32_t max_num_buckets) {
+    if (counts.empty() || index < offset ||
+        index >= offset + static_cast<int32_t>(counts.size())) {
+        index = extend(index, index, index, max_num_buckets);
+    }
+    counts[index - offset] += count;
+    total += count;
+}
+
+void DDSketch::Store::merge(const Store& other, uint32_t max_num_buckets) {
+    if (other.total == 0) {
+        return;
+    }
+    const auto other_hi = static_cast<int32_t>(other.offset + other.counts.size() - 1);
+    extend(other.offset, other_hi, other.offset, max_num_buckets);
+    for (size_t i = 0; i < other.counts.size(); ++i) {
+        counts[std::max(static_cast<int32_t>(other.offset + i), offset) - offset] +=
+                other.counts[i];
+    }
+    total += other.total;
+}
+
+size_t DDSketch::Store::serialized_size() const {
+    size_t size = varint_length(zigzag_encode(offset)) + varint_length(counts.size());
+    for (auto count : counts) {
+        size += varint_length(count);
+    }
+    return size;
+}
+
+uint8_t* DDSketch::Store::serialize(uint8_t* dst) const {
+    dst = encode_varint32(dst, zigzag_encode(offset));
+    dst = encode_varint32(dst, counts.size());
+    for (auto count : counts) {
+        dst = encode_varint64(dst, count);
+    }
+    return dst;
+}
+
+const uint8_t* DDSketch::Store::unserialize(const uint8_t* src, const uint8_t* end) {
+    uint32_t encoded_offset = 0;
+    uint32_t num_buckets = 0;
+    src = decode_varint32_ptr(src, end, &encoded_offset);
+    src = src == nullptr ? nullptr : decode_varint32_ptr(src, end, &num_buckets);
+    // every count takes at least one byte
+    if (src == nullptr || num_buckets > end - src) {
+        return nullptr;
+    }
+    offset = zigzag_decode(encoded_offset);
+    counts.resize(num_buckets);
+    total = 0;
+    for (auto& count : counts) {
+        src = decode_varint64_ptr(src, end, &count);
+        if (src == nullptr) {
+            return nullptr;
+        }
+        total += count;
+    }
+    return src;
+}
+
+} // namespace doris
@@ -0,0 +1,133 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace doris {
+
+// DDSketch: a fast and fully-mergeable quantile sketch with relative-error guarantees.
+// See the paper by Charles Masson, Jee E. Rim and Homin K. Lee, VLDB 2019.
+//
+// A value v is counted in the bucket ceil(log(|v|) / log(gamma)) of the store of its sign, where
+// gamma = (1 + a) / (1 - a), so that any quantile is returned with a relative error of at most
+// the relative accuracy a. Merging two sketches of the same accuracy just adds up the counts of
+// their buckets, and the serialized state is the varint encoded counts of the buckets.
+//
+// A store keeps at most `max_num_buckets` buckets, beyond which the buckets of the values of the
+// lowest magnitudes are collapsed into one, so that the accuracy of the high quantiles is kept.
+class DDSketch {
+public:
+    static constexpr double DEFAULT_RELATIVE_ACCURACY = 0.01;
+    static constexpr double MIN_RELATIVE_ACCURACY = 0.0001;
+    static constexpr double MAX_RELATIVE_ACCURACY = 0.5;
+    static constexpr uint32_t DEFAULT_MAX_NUM_BUCKETS = 2048;
+
+    // `relative_accuracy` is clamped into [MIN_RELATIVE_ACCURACY, MAX_RELATIVE_ACCURACY].
+    explicit DDSketch(double relative_accuracy = DEFAULT_RELATIVE_ACCURACY,
+                      uint32_t max_num_buckets = DEFAULT_MAX_NUM_BUCKETS);
+
+    void add(double value, uint64_t count = 1);
+
+    // Both sketches should be of the same relative accuracy.
+    void merge(const DDSketch& other);
+
+    // Returns NaN if the sketch is empty.
+    double quantile(double q) const;
+
+    // Calls `func(value, count)` for the representative value of every non empty bucket, in
+    // ascending order of the values.
+    template <typename Func>
+    void for_each(Func func) const {
+        for (size_t i = _negative.counts.size(); i > 0; --i) {
+            if (_negative.counts[i - 1] > 0) {
+                func(-_value(_negative.offset + i - 1), _negative.counts[i - 1]);
+            }
+        }
+        if (_zero_count > 0) {
+            func(0.0, _zero_count);
+        }
+        for (size_t i = 0; i < _positive.counts.size(); ++i) {
+            if (_positive.counts[i] > 0) {
+                func(_value(_positive.offset + i), _positive.counts[i]);
+            }
+        }
+    }
+
+    uint64_t count() const { return _negative.total + _zero_count + _positive.total; }
+
+    bool empty() const { return count() == 0; }
+
+    double relative_accuracy() const { return _relative_accuracy; }
+
+    size_t serialized_size() const;
+
+    // Returns the number of bytes written, which is serialized_size().
+    size_t serialize(uint8_t* dst) const;
+
+    // Returns false if `src` of `size` bytes is not a serialized sketch.
+    bool unserialize(const uint8_t* src, size_t size);
+
+private:
+    // The counts of the buckets [offset, offset + counts.size()).
+    struct Store {
+        int32_t offset = 0;
+        std::vector<uint64_t> counts;
+        uint64_t total = 0;
+
+        // Grows the range of the buckets to cover [lo, hi], which is narrowed to the highest
+        // `max_num_buckets` ones, and returns the bucket which `index` is counted in.
+        int32_t extend(int32_t lo, int32_t hi, int32_t index, uint32_t max_num_buckets);
+        void add(int32_t index, uint64_t count, uint32_t max_num_buckets);
+        void merge(const Store& other, uint32_t max_num_buckets);
+        size_t serialized_size() const;
+        uint8_t* serialize(uint8_t* dst) const;
+        const uint8_t* unserialize(const uint8_t* src, const uint8_t* end);
+    };
+
+    int32_t _index(double value) const {
+        return static_cast<int32_t>(std::ceil(std::log(value) * _inv_log_gamma));
+    }
+
+    // The value of the bucket whose relative error to any value of the bucket is at most the
+    // relative accuracy.
+    double _value(int32_t index) const {
+        return 2.0 * std::exp(index * _log_gamma) / (1.0 + _gamma);
+    }
+
+    void _init(double relative_accuracy);
+
+    double _relative_accuracy;
+    uint32_t _max_num_buckets;
+    double _gamma;
+    double _log_gamma;
+    double _inv_log_gamma;
+    // the values of lower magnitudes are counted as zeros
+    double _min_indexable_value;
+
+    Store _negative;
+    Store _positive;
+    uint64_t _zero_count = 0;
+    double _min = INFINITY;
+    double _max = -INFINITY;
+};
+
+} // namespace doris
@@ -189,6 +189,38 @@ DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(broker_file_open_reading, MetricUnit::FILESYS
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(local_file_open_writing, MetricUnit::FILESYSTEM);
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(s3_file_open_writing, MetricUnit::FILESYSTEM);
 
+#define DEFINE_PIPELINE_TASK_BLOCKED_TIME_METRIC(name, reason)               \
+    DEFINE_COUNTER_METRIC_PROTOTYPE_5ARG(name, MetricUnit::MICROSECONDS, "", \
+                                         pipeline_task_blocked_time_us,      \
+                                         Labels({{"reason", #reason}}));
+
+DEFINE_PIPELINE_TASK_BLOCKED_TIME_METRIC(pipeline_task_blocked_by_source_time_us, source);
+DEFINE_PIPELINE_TASK_BLOCKED_TIME_METRIC(pipeline_task_blocked_by_sink_time_us, sink);
+DEFINE_PIPELINE_TASK_BLOCKED_TIME_METRIC(pipeline_task_blocked_by_runtime_filter_time_us,
+                                         runtime_filter);
+DEFINE_PIPELINE_TASK_BLOCKED_TIME_METRIC(pipeline_task_blocked_by_dependency_time_us,
+                                         dependency);
+
+DEFINE_HISTOGRAM_METRIC_PROTOTYPE_2ARG(transmit_block_latency_us, MetricUnit::MICROSECONDS);
+DEFINE_HISTOGRAM_METRIC_PROTOTYPE_2ARG(tablet_writer_add_block_latency_us,
+                                       MetricUnit::MICROSECONDS);
+DEFINE_HISTOGRAM_METRIC_PROTOTYPE_5ARG(local_page_read_latency_us, MetricUnit::MICROSECONDS, "",
+                                       page_read_latency_us, Labels({{"medium", "local"}}));
+DEFINE_HISTOGRAM_METRIC_PROTOTYPE_5ARG(remote_page_read_latency_us, MetricUnit::MICROSECONDS, "",
+                                       page_read_latency_us, Labels({{"medium", "remote"}}));
+DEFINE_HISTOGRAM_METRIC_PROTOTYPE_2ARG(file_cache_read_latency_us, MetricUnit::MICROSECONDS);
+DEFINE_HISTOGRAM_METRIC_PROTOTYPE_2ARG(s3_get_latency_us, MetricUnit::MICROSECONDS);
+DEFINE_HISTOGRAM_METRIC_PROTOTYPE_2ARG(memtable_flush_latency_us, MetricUnit::MICROSECONDS);
+DEFINE_HISTOGRAM_METRIC_PROTOTYPE_2ARG(publish_version_latency_us, MetricUnit::MICROSECONDS);
+DEFINE_HISTOGRAM_METRIC_PROTOTYPE_5ARG(base_compaction_latency_us, MetricUnit::MICROSECONDS, "",
+                                       compaction_latency_us, Labels({{"type", "base"}}));
+DEFINE_HISTOGRAM_METRIC_PROTOTYPE_5ARG(cumulative_compaction_latency_us,
+                                       MetricUnit::MICROSECONDS, "", compaction_latency_us,
+                                       Labels({{"type", "cumulative"}}));
+DEFINE_HISTOGRAM_METRIC_PROTOTYPE_5ARG(cold_data_compaction_latency_us,
+                                       MetricUnit::MICROSECONDS, "", compaction_latency_us,
+                                       Labels({{"type", "cold_data"}}));
+
 const std::string DorisMetrics::_s_registry_name = "doris_be";
 const std::string DorisMetrics::_s_hook_name = "doris_metrics";
 
@@ -321,6 +353,25 @@ DorisMetrics::DorisMetrics() : _metric_registry(_s_registry_name) {
     INT_GAUGE_METRIC_REGISTER(_server_metric_entity, broker_file_open_reading);
     INT_GAUGE_METRIC_REGISTER(_server_metric_entity, local_file_open_writing);
     INT_GAUGE_METRIC_REGISTER(_server_metric_entity, s3_file_open_writing);
+
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, pipeline_task_blocked_by_source_time_us);
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, pipeline_task_blocked_by_sink_time_us);
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity,
+                                pipeline_task_blocked_by_runtime_filter_time_us);
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity,
+                                pipeline_task_blocked_by_dependency_time_us);
+
+    HISTOGRAM_METRIC_REGISTER(_server_metric_entity, transmit_block_latency_us);
+    HISTOGRAM_METRIC_REGISTER(_server_metric_entity, tablet_writer_add_block_latency_us);
+    HISTOGRAM_METRIC_REGISTER(_server_metric_entity, local_page_read_latency_us);
+    HISTOGRAM_METRIC_REGISTER(_server_metric_entity, remote_page_read_latency_us);
+    HISTOGRAM_METRIC_REGISTER(_server_metric_entity, file_cache_read_latency_us);
+    HISTOGRAM_METRIC_REGISTER(_server_metric_entity, s3_get_latency_us);
+    HISTOGRAM_METRIC_REGISTER(_server_metric_entity, memtable_flush_latency_us);
+    HISTOGRAM_METRIC_REGISTER(_server_metric_entity, publish_version_latency_us);
+    HISTOGRAM_METRIC_REGISTER(_server_metric_entity, base_compaction_latency_us);
+    HISTOGRAM_METRIC_REGISTER(_server_metric_entity, cumulative_compaction_latency_us);
+    HISTOGRAM_METRIC_REGISTER(_server_metric_entity, cold_data_compaction_latency_us);
 }
 
 void DorisMetrics::initialize(bool init_system_metrics, const std::set<std::string>& disk_devices,
@@ -173,6 +173,25 @@ public:
     IntGauge* local_file_open_writing;
     IntGauge* s3_file_open_writing;
 
+    // The time the pipeline tasks are blocked in BlockedTaskScheduler, by the reasons
+    IntCounter* pipeline_task_blocked_by_source_time_us;
+    IntCounter* pipeline_task_blocked_by_sink_time_us;
+    IntCounter* pipeline_task_blocked_by_runtime_filter_time_us;
+    IntCounter* pipeline_task_blocked_by_dependency_time_us;
+
+    // The latency distributions of the RPCs and the storage operations
+    HistogramMetric* transmit_block_latency_us;
+    HistogramMetric* tablet_writer_add_block_latency_us;
+    HistogramMetric* local_page_read_latency_us;
+    HistogramMetric* remote_page_read_latency_us;
+    HistogramMetric* file_cache_read_latency_us;
+    HistogramMetric* s3_get_latency_us;
+    HistogramMetric* memtable_flush_latency_us;
+    HistogramMetric* publish_version_latency_us;
+    HistogramMetric* base_compaction_latency_us;
+    HistogramMetric* cumulative_compaction_latency_us;
+    HistogramMetric* cold_data_compaction_latency_us;
+
     // Size of some global containers
     UIntGauge* rowset_count_generated_and_in_use;
     UIntGauge* unused_rowsets_count;
@@ -64,8 +64,6 @@ void ForEncoder<T>::put_batch(const T* in_data, size_t count) {
     _values_num += count;
 }
 
-// todo(kks): improve this method by SIMD instructions
-
 // Use as few bit as possible to store a piece of integer data.
 // param[in] input: the integer list need to pack
 // param[in] in_num: the number integer need to pack
@@ -81,6 +79,25 @@ void ForEncoder<T>::bit_pack(const T* input, uint8_t in_num, int bit_width, uint
         return;
     }
 
+    if (bit_width <= MAX_WORD_BIT_WIDTH) {
+        // the pending bits are kept in the low bits of a word, and written a byte at a time
+        const uint64_t mask = (1ULL << bit_width) - 1;
+        uint64_t pending = 0;
+        int pending_bits = 0;
+        for (int i = 0; i < in_num; i++) {
+            pending = (pending << bit_width) | (static_cast<uint64_t>(input[i]) & mask);
+            pending_bits += bit_width;
+            while (pending_bits >= 8) {
+                pending_bits -= 8;
+                *output++ = static_cast<uint8_t>(pending >> pending_bits);
+            }
+        }
+        if (pending_bits > 0) {
+            *output = static_cast<uint8_t>(pending << (8 - pending_bits));
+        }
+        return;
+    }
+
     T in_mask = 0;
     int bit_index = 0;
     *output = 0;
@@ -149,7 +166,7 @@ void ForEncoder<T>::bit_packing_one_frame_value(const T* input) {
     // 3.1 save original value.
     if (is_keep_original_value) {
         bit_width = sizeof(T) * 8;
-        uint32_t len = _buffered_values_num * bit_width;
+        uint32_t len = BitUtil::Ceil(_buffered_values_num * bit_width, 8);
         _buffer->reserve(_buffer->size() + len);
         size_t origin_size = _buffer->size();
         _buffer->resize(origin_size + len);
@@ -262,7 +279,6 @@ bool ForDecoder<T>::init() {
     return true;
 }
 
-// todo(kks): improve this method by SIMD instructions
 // The reverse of bit_pack method, get original integer data list from packed bits
 // param[in] input: the packed bits need to unpack
 // param[in] in_num: the integer number in packed bits
@@ -270,6 +286,31 @@ bool ForDecoder<T>::init() {
 // param[out] output: the original integer data list
 template <typename T>
 void ForDecoder<T>::bit_unpack(const uint8_t* input, uint8_t in_num, int bit_width, T* output) {
+    if (bit_width <= MAX_WORD_BIT_WIDTH) {
+        if (bit_width == 0) {
+            for (int i = 0; i < in_num; i++) {
+                output[i] = 0;
+            }
+            return;
+        }
+        // every value is within the big endian word at the byte of its first bit, the packed
+        // bits are copied to be followed by a word of padding
+        uint8_t packed[MAX_FRAME_SIZE * MAX_WORD_BIT_WIDTH / 8 + sizeof(uint64_t)];
+        const size_t packed_len = BitUtil::Ceil(in_num * bit_width, 8);
+        memcpy(packed, input, packed_len);
+        memset(packed + packed_len, 0, sizeof(uint64_t));
+        const uint64_t mask = (1ULL << bit_width) - 1;
+        for (int i = 0; i < in_num; i++) {
+            const uint32_t bit = i * bit_width;
+            uint64_t word;
+            memcpy(&word, packed + bit / 8, sizeof(word));
+            word = BitUtil::big_endian(word);
+            uint64_t value = (word >> (64 - bit_width - bit % 8)) & mask;
+            output[i] = value;
+        }
+        return;
+    }
+
     unsigned char in_mask = 0x80;
     int bit_index = 0;
     while (in_num > 0) {
@@ -382,6 +423,10 @@ bool ForDecoder<T>::get_batch(T* val, size_t count) {
         _current_index += _max_frame_size;
         val += _max_frame_size;
     }
+    if (frame_count > 0) {
+        // the frames decoded into the output are not buffered
+        _current_decoded_frame = -1;
+    }
 
     // 3. process remaining value
     size_t remaining_num = (count - padding_num) % _max_frame_size;
@@ -116,6 +116,8 @@ private:
     uint32_t _values_num = 0;
     uint8_t _buffered_values_num = 0;
     static const uint8_t FRAME_VALUE_NUM = 128;
+    // the values of at most this bit width are packed through a 64 bit word
+    static constexpr int MAX_WORD_BIT_WIDTH = 56;
     T _buffered_values[FRAME_VALUE_NUM];
 
     faststring* _buffer;
@@ -170,6 +172,10 @@ private:
 
     T* copy_value(T* val, size_t count);
 
+    // the values of at most this bit width are unpacked through a 64 bit word
+    static constexpr int MAX_WORD_BIT_WIDTH = 56;
+    static constexpr size_t MAX_FRAME_SIZE = std::numeric_limits<uint8_t>::max();
+
     const uint8_t* _buffer = nullptr;
     size_t _buffer_len = 0;
     bool _parsed = false;
@@ -90,27 +90,25 @@ bool HistogramStat::is_empty() const {
 
 void HistogramStat::add(const uint64_t& value) {
     // This function is designed to be lock free, as it's in the critical path
-    // of any operation. Each individual value is atomic and the order of updates
-    // by concurrent threads is tolerable.
+    // of any operation. The histograms of the metrics are shared by the threads,
+    // so the values are updated with atomic read-modify-writes.
     const size_t index = bucket_mapper.index_for_value(value);
     DCHECK(index < _num_buckets);
-    _buckets[index].store(_buckets[index].load(std::memory_order_relaxed) + 1,
-                          std::memory_order_relaxed);
+    _buckets[index].fetch_add(1, std::memory_order_relaxed);
 
     uint64_t old_min = min();
-    if (value < old_min) {
-        _min.store(value, std::memory_order_relaxed);
+    while (value < old_min && !_min.compare_exchange_weak(old_min, value,
+                                                          std::memory_order_relaxed)) {
     }
 
     uint64_t old_max = max();
-    if (value > old_max) {
-        _max.store(value, std::memory_order_relaxed);
+    while (value > old_max && !_max.compare_exchange_weak(old_max, value,
+                                                          std::memory_order_relaxed)) {
     }
 
-    _num.store(_num.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
-    _sum.store(_sum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
-    _sum_squares.store(_sum_squares.load(std::memory_order_relaxed) + value * value,
-                       std::memory_order_relaxed);
+    _num.fetch_add(1, std::memory_order_relaxed);
+    _sum.fetch_add(value, std::memory_order_relaxed);
+    _sum_squares.fetch_add(value * value, std::memory_order_relaxed);
 }
 
 void HistogramStat::merge(const HistogramStat& other) {
@@ -72,7 +72,9 @@
 #include <string.h>
 
 #include <limits>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 // #include "util/string_parser.hpp"
 
@@ -85,6 +87,7 @@ namespace doris {
 // forward declaration
 class JsonbValue;
 class ObjectVal;
+class JsonbPath;
 
 const int MaxNestingLevel = 100;
 
@@ -399,6 +402,9 @@ public:
     // find the JSONB value by a key path string (with length)
     JsonbValue* findPath(const char* key_path, unsigned int len, const char* delim,
                          hDictFind handler);
+
+    // find the JSONB value by a compiled key path, the same as findPath() of its string
+    JsonbValue* findPath(const JsonbPath& path);
     friend class JsonbDocument;
 
 protected:
@@ -1170,6 +1176,117 @@ inline JsonbValue* JsonbValue::findPath(const char* key_path, unsigned int kp_le
 
 #pragma pack(pop)
 
+/*
+ * A key path of JsonbValue::findPath() parsed into its steps once, to find the values of many
+ * documents without parsing the path for each of them. A step is an object key, an array index,
+ * or a key followed by an index, e.g. "$.a.b[1]" is the steps "a" and "b[1]".
+ */
+class JsonbPath {
+public:
+    struct Step {
+        // empty if the step is an array index only
+        std::string key;
+        bool has_index = false;
+        int index = 0;
+    };
+
+    JsonbPath(const char* key_path, unsigned int kp_len, const char* delim = ".") {
+        valid_ = parse(key_path, kp_len, delim ? *delim : '.');
+    }
+
+    // whether findPath() of the path string may find any value with this path
+    bool isValid() const { return valid_; }
+
+    const std::vector<Step>& steps() const { return steps_; }
+
+private:
+    // the same as the parsing of JsonbValue::findPath()
+    bool parse(const char* key_path, unsigned int kp_len, char delim) {
+        if (!key_path) return false;
+
+        // skip $ and . at beginning
+        if (kp_len > 0 && *key_path == '$') {
+            key_path++;
+            kp_len--;
+            if (kp_len > 0 && *key_path == '.') {
+                key_path++;
+                kp_len--;
+            }
+        }
+
+        const char* fence = key_path + kp_len;
+        char idx_buf[21]; // buffer to parse array index (integer value)
+
+        while (key_path < fence) {
+            const char* key = key_path;
+            unsigned int klen = 0;
+            const char* left_bracket = nullptr;
+            const char* right_bracket = nullptr;
+            size_t idx_len = 0;
+            for (; key_path != fence && *key_path != delim; ++key_path, ++klen) {
+                if ('[' == *key_path) {
+                    left_bracket = key_path;
+                } else if (']' == *key_path) {
+                    right_bracket = key_path;
+                }
+            }
+
+            if (left_bracket || right_bracket) {
+                if (!left_bracket || !right_bracket) return false;
+                if (key + klen - 1 != right_bracket) return false;
+                klen = left_bracket - key;
+                idx_len = right_bracket - left_bracket - 1;
+            }
+
+            if (!klen && !idx_len) return false;
+
+            Step step;
+            step.key.assign(key, klen);
+            if (idx_len) {
+                if (idx_len >= sizeof(idx_buf)) return false;
+                memcpy(idx_buf, left_bracket + 1, idx_len);
+                idx_buf[idx_len] = 0;
+
+                char* end = nullptr;
+                step.index = (int)strtol(idx_buf, &end, 10);
+                if (!end || *end) return false;
+                step.has_index = true;
+            }
+            steps_.push_back(std::move(step));
+
+            // skip the delimiter
+            if (key_path < fence) {
+                ++key_path;
+                // we have a trailing delimiter at the end
+                if (key_path == fence) return false;
+            }
+        }
+        return true;
+    }
+
+    bool valid_;
+    std::vector<Step> steps_;
+};
+
+inline JsonbValue* JsonbValue::findPath(const JsonbPath& path) {
+    if (!path.isValid()) return nullptr;
+
+    JsonbValue* pval = this;
+    for (const auto& step : path.steps()) {
+        if (!step.key.empty()) {
+            if (pval->type_ != JsonbType::T_Object) return nullptr;
+            pval = ((ObjectVal*)pval)->find(step.key.data(), step.key.size());
+            if (!pval) return nullptr;
+        }
+        if (step.has_index) {
+            if (pval->type_ != JsonbType::T_Array) return nullptr;
+            pval = ((ArrayVal*)pval)->get(step.index);
+            if (!pval) return nullptr;
+        }
+    }
+    return pval;
+}
+
 } // namespace doris
 
 #endif // JSONB_JSONBDOCUMENT_H
@@ -36,6 +36,8 @@
 #include "gutil/strings/split.h"
 #include "olap/page_cache.h"
 #include "olap/segment_loader.h"
+#include "runtime/block_spill_manager.h"
+#include "runtime/exec_env.h"
 #include "util/cgroup_util.h"
 #include "util/parse_util.h"
 #include "util/pretty_printer.h"
@@ -108,7 +110,8 @@ void MemInfo::process_cache_gc(int64_t& freed_mem) {
 }
 
 // step1: free all cache
-// step2: free top overcommit query, if enable query memroy overcommit
+// step2: revoke the memory of the spilling operators
+// step3: free top overcommit query, if enable query memroy overcommit
 // TODO Now, the meaning is different from java minor gc + full gc, more like small gc + large gc.
 bool MemInfo::process_minor_gc() {
     MonotonicStopWatch watch;
@@ -130,6 +133,16 @@ bool MemInfo::process_minor_gc() {
     // TODO add freed_mem
     SegmentLoader::instance()->prune();
 
+    // The spilling operators release the memory at their next sink, so the requested bytes are
+    // counted as freed, the requests which are not served by the next GC are not counted again.
+    if (config::enable_spill_revoke_memory && ExecEnv::GetInstance()->block_spill_mgr()) {
+        freed_mem += ExecEnv::GetInstance()->block_spill_mgr()->revoke_memory(
+                _s_process_minor_gc_size - freed_mem);
+        if (freed_mem > _s_process_minor_gc_size) {
+            return true;
+        }
+    }
+
     if (config::enable_query_memroy_overcommit) {
         freed_mem += MemTrackerLimiter::free_top_overcommit_query(
                 _s_process_minor_gc_size - freed_mem, vm_rss_str, mem_available_str);
@@ -141,9 +154,10 @@ bool MemInfo::process_minor_gc() {
 }
 
 // step1: free all cache
-// step2: free top memory query
-// step3: free top overcommit load, load retries are more expensive, So cancel at the end.
-// step4: free top memory load
+// step2: revoke the memory of the spilling operators
+// step3: free top memory query
+// step4: free top overcommit load, load retries are more expensive, So cancel at the end.
+// step5: free top memory load
 bool MemInfo::process_full_gc() {
     MonotonicStopWatch watch;
     watch.start();
@@ -171,6 +185,14 @@ bool MemInfo::process_full_gc() {
         }
     }
 
+    if (config::enable_spill_revoke_memory && ExecEnv::GetInstance()->block_spill_mgr()) {
+        freed_mem += ExecEnv::GetInstance()->block_spill_mgr()->revoke_memory(
+                _s_process_full_gc_size - freed_mem);
+        if (freed_mem > _s_process_full_gc_size) {
+            return true;
+        }
+    }
+
     freed_mem += MemTrackerLimiter::free_top_memory_query(_s_process_full_gc_size - freed_mem,
                                                           vm_rss_str, mem_available_str);
     if (freed_mem > _s_process_full_gc_size) {
@@ -114,7 +114,8 @@ std::string Metric::to_prometheus(const std::string& display_name, const Labels&
 }
 
 std::map<std::string, double> HistogramMetric::_s_output_percentiles = {
-        {"0.50", 50.0}, {"0.75", 75.0}, {"0.90", 90.0}, {"0.95", 95.0}, {"0.99", 99.0}};
+        {"0.50", 50.0}, {"0.75", 75.0}, {"0.90", 90.0},
+        {"0.95", 95.0}, {"0.99", 99.0}, {"0.999", 99.9}};
 void HistogramMetric::clear() {
     std::lock_guard<SpinLock> l(_lock);
     _stats.clear();
@@ -440,19 +440,18 @@ int MysqlRowBuffer<is_binary_format>::push_datetime(const DateType& data) {
         pos[4] = (uchar)data.hour();
         pos[5] = (uchar)data.minute();
         pos[6] = (uchar)data.second();
+        uint32_t microsecond = 0;
         if constexpr (std::is_same_v<DateType,
                                      vectorized::DateV2Value<vectorized::DateV2ValueType>> ||
                       std::is_same_v<DateType,
                                      vectorized::DateV2Value<vectorized::DateTimeV2ValueType>>) {
-            int4store(pos + 7, data.microsecond());
-            if (data.microsecond()) {
-                length = 11;
-            }
-        } else {
-            int4store(pos + 7, 0);
+            microsecond = data.microsecond();
         }
+        int4store(pos + 7, microsecond);
 
-        if (data.hour() || data.minute() || data.second()) {
+        if (microsecond) {
+            length = 11;
+        } else if (data.hour() || data.minute() || data.second()) {
             length = 7;
         } else if (data.year() || data.month() || data.day()) {
             length = 4;
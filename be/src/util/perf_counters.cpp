@@ -25,14 +25,20 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/syscall.h>
+#include <unistd.h>
 
+#include <algorithm>
+#include <atomic>
 #include <boost/algorithm/string/trim.hpp>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <sstream>
 
+#include "common/logging.h"
 #include "gutil/strings/substitute.h"
+#include "util/binary_cast.hpp"
 #include "util/debug_util.h"
 #include "util/pretty_printer.h"
 #include "util/string_parser.hpp"
@@ -588,4 +594,110 @@ void PerfCounters::get_proc_status(ProcStatus* out) {
     out->vm_rss = parse_bytes("status/VmRSS");
 }
 
+// set once opening the counters fails for a reason which applies to all threads
+static std::atomic<bool> thread_perf_counters_unavailable {false};
+
+ThreadPerfCounters* ThreadPerfCounters::current() {
+    thread_local std::unique_ptr<ThreadPerfCounters> counters;
+    thread_local bool opened = false;
+    if (!opened && !thread_perf_counters_unavailable.load(std::memory_order_relaxed)) {
+        opened = true;
+        std::unique_ptr<ThreadPerfCounters> new_counters(new ThreadPerfCounters());
+        Status st = new_counters->_open();
+        if (st.ok()) {
+            counters = std::move(new_counters);
+        } else if (!thread_perf_counters_unavailable.exchange(true)) {
+            LOG(WARNING) << "hardware counters are not available: " << st;
+        }
+    }
+    return counters.get();
+}
+
+Status ThreadPerfCounters::_open() {
+    static const PerfCounters::Counter events[NUM_EVENTS] = {
+            PerfCounters::PERF_COUNTER_HW_CPU_CYCLES, PerfCounters::PERF_COUNTER_HW_INSTRUCTIONS,
+            PerfCounters::PERF_COUNTER_HW_CACHE_MISSES,
+            PerfCounters::PERF_COUNTER_HW_BRANCH_MISSES};
+    for (int i = 0; i < NUM_EVENTS; ++i) {
+        perf_event_attr attr;
+        init_event_attr(&attr, events[i]);
+        // only the user space is counted, which is allowed with kernel.perf_event_paranoid=2
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format =
+                PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        _fds[i] = sys_perf_event_open(&attr, 0, -1, i == 0 ? -1 : _fds[0], 0);
+        if (_fds[i] < 0) {
+            return Status::InternalError("failed to open {}: {}", get_counter_name(events[i]),
+                                         strerror(errno));
+        }
+    }
+    return Status::OK();
+}
+
+ThreadPerfCounters::~ThreadPerfCounters() {
+    for (int fd : _fds) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+}
+
+bool ThreadPerfCounters::read(Values* values) const {
+    struct {
+        uint64_t nr;
+        uint64_t time_enabled;
+        uint64_t time_running;
+        uint64_t values[NUM_EVENTS];
+    } data;
+    if (::read(_fds[0], &data, sizeof(data)) != sizeof(data) || data.nr != NUM_EVENTS) {
+        return false;
+    }
+    // the group is counted for time_running out of time_enabled if there are too many events
+    double scale = data.time_running == 0 ? 0 : double(data.time_enabled) / data.time_running;
+    for (int i = 0; i < NUM_EVENTS; ++i) {
+        (*values)[i] = static_cast<int64_t>(data.values[i] * scale);
+    }
+    return true;
+}
+
+HardwareCounterProfile::HardwareCounterProfile(RuntimeProfile* profile) {
+    static const char* hardware_counters = "HardwareCounters";
+    ADD_COUNTER(profile, hardware_counters, TUnit::NONE);
+    auto* cycles = ADD_CHILD_COUNTER(profile, "CpuCycles", TUnit::UNIT, hardware_counters);
+    auto* instructions = ADD_CHILD_COUNTER(profile, "Instructions", TUnit::UNIT, hardware_counters);
+    auto* llc_misses = ADD_CHILD_COUNTER(profile, "LLCMisses", TUnit::UNIT, hardware_counters);
+    auto* branch_misses =
+            ADD_CHILD_COUNTER(profile, "BranchMisses", TUnit::UNIT, hardware_counters);
+    _counters[ThreadPerfCounters::CPU_CYCLES] = cycles;
+    _counters[ThreadPerfCounters::INSTRUCTIONS] = instructions;
+    _counters[ThreadPerfCounters::LLC_MISSES] = llc_misses;
+    _counters[ThreadPerfCounters::BRANCH_MISSES] = branch_misses;
+
+    // the ratios are computed when the profile is reported
+    auto ratio = [](RuntimeProfile::Counter* numerator, RuntimeProfile::Counter* denominator,
+                    double multiplier) {
+        return [=]() {
+            double value = denominator->value() == 0
+                                   ? 0
+                                   : multiplier * numerator->value() / denominator->value();
+            return binary_cast<double, int64_t>(value);
+        };
+    };
+    profile->add_derived_counter("IPC", TUnit::DOUBLE_VALUE, ratio(instructions, cycles, 1),
+                                 hardware_counters);
+    profile->add_derived_counter("LLCMissesPerKiloInstructions", TUnit::DOUBLE_VALUE,
+                                 ratio(llc_misses, instructions, 1000), hardware_counters);
+    profile->add_derived_counter("BranchMissesPerKiloInstructions", TUnit::DOUBLE_VALUE,
+                                 ratio(branch_misses, instructions, 1000), hardware_counters);
+}
+
+void HardwareCounterProfile::update(const ThreadPerfCounters::Values& start,
+                                    const ThreadPerfCounters::Values& end) {
+    for (int i = 0; i < ThreadPerfCounters::NUM_EVENTS; ++i) {
+        // the scaled values may go backwards slightly
+        COUNTER_UPDATE(_counters[i], std::max<int64_t>(end[i] - start[i], 0));
+    }
+}
+
 } // namespace doris
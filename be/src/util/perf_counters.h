@@ -20,11 +20,14 @@
 
 #pragma once
 
+#include <array>
 #include <iostream>
 #include <string>
 #include <vector>
 
+#include "common/status.h"
 #include "util/debug_util.h"
+#include "util/runtime_profile.h"
 
 // This is a utility class that aggregates counters from the kernel.  These counters
 // come from different sources.
@@ -165,4 +168,43 @@ private:
     static std::string _vm_rss_str;
 };
 
+// The hardware counters of the current thread, which are opened as a group so that they are
+// scheduled onto the PMU together and read with one read(). The counters only count while the
+// thread is running, so the difference of the values read before and after a piece of work on
+// the thread gives its events.
+class ThreadPerfCounters {
+public:
+    enum Event { CPU_CYCLES = 0, INSTRUCTIONS, LLC_MISSES, BRANCH_MISSES, NUM_EVENTS };
+    using Values = std::array<int64_t, NUM_EVENTS>;
+
+    // Returns the counters of the current thread, which are opened on the first call, or nullptr
+    // if they can't be opened, e.g. in a VM without a virtual PMU or with a too high
+    // kernel.perf_event_paranoid.
+    static ThreadPerfCounters* current();
+
+    // Reads the counters, which are scaled if the kernel multiplexed them with other events.
+    bool read(Values* values) const;
+
+    ~ThreadPerfCounters();
+
+private:
+    ThreadPerfCounters() = default;
+
+    Status _open();
+
+    int _fds[NUM_EVENTS] = {-1, -1, -1, -1};
+};
+
+// The events of ThreadPerfCounters in a profile under "HardwareCounters", along with the IPC
+// and the misses per thousand instructions derived from them.
+class HardwareCounterProfile {
+public:
+    explicit HardwareCounterProfile(RuntimeProfile* profile);
+
+    void update(const ThreadPerfCounters::Values& start, const ThreadPerfCounters::Values& end);
+
+private:
+    RuntimeProfile::Counter* _counters[ThreadPerfCounters::NUM_EVENTS];
+};
+
 } // namespace doris
@@ -24,4 +24,24 @@ std::string PerfCounters::_vm_rss_str = "";
 
 void PerfCounters::refresh_proc_status() {}
 
+// the hardware counters are not supported on macOS
+ThreadPerfCounters* ThreadPerfCounters::current() {
+    return nullptr;
+}
+
+bool ThreadPerfCounters::read(Values* values) const {
+    return false;
+}
+
+ThreadPerfCounters::~ThreadPerfCounters() = default;
+
+Status ThreadPerfCounters::_open() {
+    return Status::NotSupported("hardware counters are not supported on macOS");
+}
+
+HardwareCounterProfile::HardwareCounterProfile(RuntimeProfile* profile) : _counters() {}
+
+void HardwareCounterProfile::update(const ThreadPerfCounters::Values& start,
+                                    const ThreadPerfCounters::Values& end) {}
+
 } // namespace doris
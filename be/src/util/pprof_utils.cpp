@@ -190,4 +190,37 @@ Status PprofUtils::generate_flamegraph(int32_t sample_seconds,
     return Status::OK();
 }
 
+Status PprofUtils::generate_flamegraph_of_folded_stacks(const std::string& folded_stacks,
+                                                        const std::string& flame_graph_tool_dir,
+                                                        const std::string& title,
+                                                        std::string* svg_content) {
+    std::string flamegraph_pl = flame_graph_tool_dir + "/flamegraph.pl";
+    bool exists = false;
+    RETURN_IF_ERROR(io::global_local_filesystem()->exists(flamegraph_pl, &exists));
+    if (!exists) {
+        return Status::InternalError("Missing flamegraph.pl in FlameGraph");
+    }
+
+    std::stringstream tmp_file;
+    tmp_file << config::pprof_profile_dir << "/folded_stacks." << getpid() << "." << rand();
+    std::ofstream outfile(tmp_file.str().c_str());
+    if (!outfile.is_open()) {
+        return Status::InternalError("failed to open tmp file: {}", tmp_file.str());
+    }
+    outfile << folded_stacks;
+    outfile.close();
+
+    std::stringstream gen_cmd;
+    gen_cmd << flamegraph_pl << " --title \"" << title << "\" " << tmp_file.str();
+    AgentUtils util;
+    std::string res_content;
+    bool rc = util.exec_cmd(gen_cmd.str(), &res_content, false);
+    io::global_local_filesystem()->delete_file(tmp_file.str());
+    if (!rc) {
+        return Status::InternalError("Failed to execute flamegraph.pl: {}", res_content);
+    }
+    *svg_content = res_content;
+    return Status::OK();
+}
+
 } // namespace doris
@@ -48,6 +48,13 @@ public:
     static Status generate_flamegraph(int32_t sample_seconds,
                                       const std::string& flame_graph_tool_dir, bool return_file,
                                       std::string* svg_file_or_content);
+
+    /// generate flame graph of the folded stacks, i.e. "a;b;c count" per line, by flamegraph.pl.
+    /// the svg content is returned via "svg_content".
+    static Status generate_flamegraph_of_folded_stacks(const std::string& folded_stacks,
+                                                       const std::string& flame_graph_tool_dir,
+                                                       const std::string& title,
+                                                       std::string* svg_content);
 };
 
 } // namespace doris
@@ -18,8 +18,13 @@
 #pragma once
 
 #include <brpc/http_method.h>
+#include <butil/iobuf.h>
 #include <gen_cpp/internal_service.pb.h>
 
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
 #include "common/config.h"
 #include "common/status.h"
 #include "network_util.h"
@@ -116,6 +121,73 @@ void request_block_transfer_attachment(Params* brpc_request, const std::string&
     closure->cntl.request_attachment().swap(attachment);
 }
 
+// Keeps the release functions of the data referenced by brpc attachments. The deleter of
+// butil::IOBuf::append_user_data is a plain function which only gets the data pointer, so the
+// release function is looked up by the data pointer. The same data may be referenced by several
+// attachments at the same time, e.g. a broadcast block.
+class AttachmentRefRegistry {
+public:
+    static void add(const void* data, std::function<void()> release) {
+        std::lock_guard<std::mutex> l(_lock());
+        _releases().emplace(data, std::move(release));
+    }
+
+    static void release(void* data) {
+        std::function<void()> release;
+        {
+            std::lock_guard<std::mutex> l(_lock());
+            auto it = _releases().find(data);
+            DCHECK(it != _releases().end());
+            release = std::move(it->second);
+            _releases().erase(it);
+        }
+        release();
+    }
+
+private:
+    static std::mutex& _lock() {
+        static std::mutex lock;
+        return lock;
+    }
+    static std::unordered_multimap<const void*, std::function<void()>>& _releases() {
+        static std::unordered_multimap<const void*, std::function<void()>> releases;
+        return releases;
+    }
+};
+
+// Transfer column_values of the block to the Controller Attachment by reference, column_values
+// is not copied. release is called when brpc does not reference column_values any more, which
+// may be later than the closure runs, e.g. the rpc times out while the attachment is still in
+// the write queue of the socket. So column_values must be kept alive until release is called.
+// The block in the request must not contain column_values, the receiver restores it from the
+// attachment in attachment_transfer_request_block.
+template <typename Params, typename Closure>
+void request_block_transfer_attachment_by_ref(Params* brpc_request,
+                                              const std::string& column_values,
+                                              std::function<void()> release, Closure* closure) {
+    DCHECK(!column_values.empty());
+    DCHECK(brpc_request->block().column_values().empty());
+    brpc_request->set_transfer_by_attachment(true);
+    void* data = const_cast<char*>(column_values.data());
+    AttachmentRefRegistry::add(data, std::move(release));
+    closure->cntl.request_attachment().append_user_data(data, column_values.size(),
+                                                        AttachmentRefRegistry::release);
+}
+
+// Copy the fields of block except column_values, which is sent by
+// request_block_transfer_attachment_by_ref.
+inline void copy_block_without_column_values(const PBlock& block, PBlock* block_meta) {
+    block_meta->mutable_column_metas()->CopyFrom(block.column_metas());
+    block_meta->set_column_values("");
+    block_meta->set_compressed(block.compressed());
+    if (block.has_uncompressed_size()) {
+        block_meta->set_uncompressed_size(block.uncompressed_size());
+    }
+    block_meta->set_compression_type(block.compression_type());
+    block_meta->set_be_exec_version(block.be_exec_version());
+    block_meta->mutable_column_values_metas()->CopyFrom(block.column_values_metas());
+}
+
 // TODO(zxy) delete in v1.3 version
 // Controller Attachment transferred to RowBatch in ProtoBuf Request.
 template <typename Params>
@@ -53,14 +53,16 @@ size_t QuantileState<T>::get_serialized_size() {
     case TDIGEST:
         size += _tdigest_ptr->serialized_size();
         break;
+    case DDSKETCH:
+        size += sizeof(uint32_t) + _ddsketch_ptr->serialized_size();
+        break;
     }
     return size;
 }
 
 template <typename T>
 void QuantileState<T>::set_compression(float compression) {
-    DCHECK(compression >= QUANTILE_STATE_COMPRESSION_MIN &&
-           compression <= QUANTILE_STATE_COMPRESSION_MAX);
+    DCHECK(is_valid_quantile_state_compression(compression));
     this->_compression = compression;
 }
 
@@ -72,8 +74,7 @@ bool QuantileState<T>::is_valid(const Slice& slice) {
     const uint8_t* ptr = (uint8_t*)slice.data;
     const uint8_t* end = (uint8_t*)slice.data + slice.size;
     float compress_value = *reinterpret_cast<const float*>(ptr);
-    if (compress_value < QUANTILE_STATE_COMPRESSION_MIN ||
-        compress_value > QUANTILE_STATE_COMPRESSION_MAX) {
+    if (!is_valid_quantile_state_compression(compress_value)) {
         return false;
     }
     ptr += sizeof(float);
@@ -106,6 +107,14 @@ bool QuantileState<T>::is_valid(const Slice& slice) {
         ptr += tdigest_serialized_length;
         break;
     }
+    case DDSKETCH: {
+        if ((ptr + sizeof(uint32_t)) > end) {
+            return false;
+        }
+        uint32_t ddsketch_serialized_length = decode_fixed32_le(ptr);
+        ptr += sizeof(uint32_t) + ddsketch_serialized_length;
+        break;
+    }
     default:
         return false;
     }
@@ -143,6 +152,9 @@ T QuantileState<T>::get_value_by_percentile(float percentile) const {
     case TDIGEST: {
         return _tdigest_ptr->quantile(percentile);
     }
+    case DDSKETCH: {
+        return _ddsketch_ptr->quantile(percentile);
+    }
     default:
         break;
     }
@@ -195,6 +207,18 @@ bool QuantileState<T>::deserialize(const Slice& slice) {
         _tdigest_ptr->unserialize(ptr);
         break;
     }
+    case DDSKETCH: {
+        // 5: length and DDSketch object value
+        uint32_t ddsketch_serialized_length = decode_fixed32_le(ptr);
+        ptr += sizeof(uint32_t);
+        _ddsketch_ptr = std::make_shared<DDSketch>(_compression);
+        if (!_ddsketch_ptr->unserialize(ptr, ddsketch_serialized_length)) {
+            _ddsketch_ptr.reset();
+            _type = EMPTY;
+            return false;
+        }
+        break;
+    }
     default:
         // revert type to EMPTY
         _type = EMPTY;
@@ -234,6 +258,13 @@ size_t QuantileState<T>::serialize(uint8_t* dst) const {
         ptr += tdigest_size;
         break;
     }
+    case DDSKETCH: {
+        *ptr++ = DDSKETCH;
+        size_t ddsketch_size = _ddsketch_ptr->serialize(ptr + sizeof(uint32_t));
+        encode_fixed32_le(ptr, ddsketch_size);
+        ptr += sizeof(uint32_t) + ddsketch_size;
+        break;
+    }
     default:
         break;
     }
@@ -262,13 +293,9 @@ void QuantileState<T>::merge(const QuantileState<T>& other) {
             break;
         case EXPLICIT:
             if (_explicit_data.size() + other._explicit_data.size() > QUANTILE_STATE_EXPLICIT_NUM) {
-                _type = TDIGEST;
-                _tdigest_ptr = std::make_shared<TDigest>(_compression);
-                for (int i = 0; i < _explicit_data.size(); i++) {
-                    _tdigest_ptr->add(_explicit_data[i]);
-                }
+                _explicit_to_sketch();
                 for (int i = 0; i < other._explicit_data.size(); i++) {
-                    _tdigest_ptr->add(other._explicit_data[i]);
+                    add_value(other._explicit_data[i]);
                 }
             } else {
                 _explicit_data.insert(_explicit_data.end(), other._explicit_data.begin(),
@@ -280,6 +307,11 @@ void QuantileState<T>::merge(const QuantileState<T>& other) {
                 _tdigest_ptr->add(other._explicit_data[i]);
             }
             break;
+        case DDSKETCH:
+            for (int i = 0; i < other._explicit_data.size(); i++) {
+                _ddsketch_ptr->add(other._explicit_data[i]);
+            }
+            break;
         default:
             break;
         }
@@ -306,6 +338,49 @@ void QuantileState<T>::merge(const QuantileState<T>& other) {
         case TDIGEST:
             _tdigest_ptr->merge(other._tdigest_ptr.get());
             break;
+        case DDSKETCH: {
+            // the states of different kinds of sketches are merged into a TDigest
+            auto ddsketch = std::move(_ddsketch_ptr);
+            _type = TDIGEST;
+            _tdigest_ptr = std::move(other._tdigest_ptr);
+            ddsketch->for_each([this](double value, uint64_t count) {
+                _tdigest_ptr->add(value, static_cast<double>(count));
+            });
+            break;
+        }
+        default:
+            break;
+        }
+        break;
+    }
+    case DDSKETCH: {
+        switch (_type) {
+        case EMPTY:
+            _type = DDSKETCH;
+            _ddsketch_ptr = std::make_shared<DDSketch>(*other._ddsketch_ptr);
+            break;
+        case SINGLE:
+            _type = DDSKETCH;
+            _ddsketch_ptr = std::make_shared<DDSketch>(*other._ddsketch_ptr);
+            _ddsketch_ptr->add(_single_data);
+            break;
+        case EXPLICIT:
+            _type = DDSKETCH;
+            _ddsketch_ptr = std::make_shared<DDSketch>(*other._ddsketch_ptr);
+            for (int i = 0; i < _explicit_data.size(); i++) {
+                _ddsketch_ptr->add(_explicit_data[i]);
+            }
+            _explicit_data.clear();
+            _explicit_data.shrink_to_fit();
+            break;
+        case TDIGEST:
+            other._ddsketch_ptr->for_each([this](double value, uint64_t count) {
+                _tdigest_ptr->add(value, static_cast<double>(count));
+            });
+            break;
+        case DDSKETCH:
+            _ddsketch_ptr->merge(*other._ddsketch_ptr);
+            break;
         default:
             break;
         }
@@ -330,14 +405,8 @@ void QuantileState<T>::add_value(const T& value) {
         break;
     case EXPLICIT:
         if (_explicit_data.size() == QUANTILE_STATE_EXPLICIT_NUM) {
-            _tdigest_ptr = std::make_shared<TDigest>(_compression);
-            for (int i = 0; i < _explicit_data.size(); i++) {
-                _tdigest_ptr->add(_explicit_data[i]);
-            }
-            _explicit_data.clear();
-            _explicit_data.shrink_to_fit();
-            _type = TDIGEST;
-
+            _explicit_to_sketch();
+            add_value(value);
         } else {
             _explicit_data.emplace_back(value);
         }
@@ -345,13 +414,37 @@ void QuantileState<T>::add_value(const T& value) {
     case TDIGEST:
         _tdigest_ptr->add(value);
         break;
+    case DDSKETCH:
+        _ddsketch_ptr->add(value);
+        break;
+    }
+}
+
+template <typename T>
+void QuantileState<T>::_explicit_to_sketch() {
+    DCHECK(_type == EXPLICIT);
+    if (is_quantile_state_sketch_compression(_compression)) {
+        _ddsketch_ptr = std::make_shared<DDSketch>(_compression);
+        for (int i = 0; i < _explicit_data.size(); i++) {
+            _ddsketch_ptr->add(_explicit_data[i]);
+        }
+        _type = DDSKETCH;
+    } else {
+        _tdigest_ptr = std::make_shared<TDigest>(_compression);
+        for (int i = 0; i < _explicit_data.size(); i++) {
+            _tdigest_ptr->add(_explicit_data[i]);
+        }
+        _type = TDIGEST;
     }
+    _explicit_data.clear();
+    _explicit_data.shrink_to_fit();
 }
 
 template <typename T>
 void QuantileState<T>::clear() {
     _type = EMPTY;
     _tdigest_ptr.reset();
+    _ddsketch_ptr.reset();
     _explicit_data.clear();
     _explicit_data.shrink_to_fit();
 }
@@ -21,6 +21,7 @@
 #include <string>
 #include <vector>
 
+#include "ddsketch.h"
 #include "slice.h"
 #include "tdigest.h"
 
@@ -37,9 +38,22 @@ enum QuantileStateType {
     EMPTY = 0,
     SINGLE = 1,   // single element
     EXPLICIT = 2, // more than one elements,stored in vector
-    TDIGEST = 3   // TDIGEST object
+    TDIGEST = 3,  // TDIGEST object
+    DDSKETCH = 4  // DDSketch object, of a compression in (0, 1)
 };
 
+// A compression in (0, 1) is the relative accuracy of a DDSketch, which is used instead of a
+// TDigest of a compression in [QUANTILE_STATE_COMPRESSION_MIN, QUANTILE_STATE_COMPRESSION_MAX].
+inline bool is_quantile_state_sketch_compression(float compression) {
+    return compression > 0 && compression < 1;
+}
+
+inline bool is_valid_quantile_state_compression(float compression) {
+    return is_quantile_state_sketch_compression(compression) ||
+           (compression >= QUANTILE_STATE_COMPRESSION_MIN &&
+            compression <= QUANTILE_STATE_COMPRESSION_MAX);
+}
+
 template <typename T>
 class QuantileState {
 public:
@@ -59,8 +73,12 @@ public:
     ~QuantileState() = default;
 
 private:
+    // Moves the explicit values into a TDigest or a DDSketch by the compression.
+    void _explicit_to_sketch();
+
     QuantileStateType _type = EMPTY;
     std::shared_ptr<TDigest> _tdigest_ptr;
+    std::shared_ptr<DDSketch> _ddsketch_ptr;
     T _single_data;
     std::vector<T> _explicit_data;
     float _compression;
@@ -0,0 +1,276 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/query_cpu_sampler.h"
+
+#include <execinfo.h>
+#include <fmt/format.h>
+#include <signal.h>
+#include <sys/time.h>
+
+#include <algorithm>
+#include <boost/stacktrace.hpp>
+#include <cerrno>
+#include <cstring>
+
+#include "common/config.h"
+#include "common/logging.h"
+
+namespace doris {
+
+namespace {
+
+// the frames of the signal handler and the signal trampoline
+constexpr int SKIPPED_FRAMES = 2;
+
+thread_local CpuSampleTag tls_tag;
+thread_local bool tls_tagged = false;
+
+void sigprof_handler(int, siginfo_t*, void*) {
+    if (!tls_tagged) {
+        return;
+    }
+    int saved_errno = errno;
+    void* frames[QueryCpuSampler::MAX_DEPTH + SKIPPED_FRAMES];
+    int depth = backtrace(frames, QueryCpuSampler::MAX_DEPTH + SKIPPED_FRAMES);
+    if (depth > SKIPPED_FRAMES) {
+        QueryCpuSampler::instance()->add_sample(tls_tag, frames + SKIPPED_FRAMES,
+                                                depth - SKIPPED_FRAMES);
+    }
+    errno = saved_errno;
+}
+
+} // namespace
+
+void QueryCpuSampler::set_tag(const TUniqueId& query_id, const TUniqueId& fragment_instance_id,
+                              int32_t pipeline_id, int32_t pipeline_task_index) {
+    // the handler runs on this thread, so it's enough to keep the compiler from reordering the
+    // writes of the tag and the flag
+    tls_tagged = false;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    tls_tag.query_id_hi = query_id.hi;
+    tls_tag.query_id_lo = query_id.lo;
+    tls_tag.fragment_instance_id_hi = fragment_instance_id.hi;
+    tls_tag.fragment_instance_id_lo = fragment_instance_id.lo;
+    tls_tag.pipeline_id = pipeline_id;
+    tls_tag.pipeline_task_index = pipeline_task_index;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    tls_tagged = true;
+}
+
+void QueryCpuSampler::clear_tag() {
+    tls_tagged = false;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+
+bool QueryCpuSampler::is_tagged() {
+    return tls_tagged;
+}
+
+void QueryCpuSampler::set_frequency(int32_t frequency) {
+    std::lock_guard<std::mutex> l(_lock);
+    frequency = std::clamp(frequency, 0, 1000);
+    if (frequency == _frequency) {
+        return;
+    }
+    _frequency = frequency;
+    if (_paused) {
+        return;
+    }
+    if (frequency > 0) {
+        _init_ring();
+        _install_handler();
+    }
+    _set_timer(frequency);
+    LOG(INFO) << "set query cpu sampling frequency to " << frequency;
+}
+
+void QueryCpuSampler::pause() {
+    std::lock_guard<std::mutex> l(_lock);
+    _paused = true;
+    if (_frequency > 0) {
+        _set_timer(0);
+    }
+}
+
+void QueryCpuSampler::resume() {
+    std::lock_guard<std::mutex> l(_lock);
+    _paused = false;
+    if (_frequency > 0) {
+        // the handler is replaced by the one of gperftools while paused
+        _install_handler();
+        _set_timer(_frequency);
+    }
+}
+
+void QueryCpuSampler::_init_ring() {
+    std::call_once(_ring_once, [this]() {
+        // the first call of backtrace() may allocate to load libgcc, which is not allowed in the
+        // signal handler
+        void* frames[1];
+        backtrace(frames, 1);
+        _ring.store(new Slot[RING_SIZE], std::memory_order_release);
+    });
+}
+
+void QueryCpuSampler::_install_handler() {
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    action.sa_sigaction = sigprof_handler;
+    if (sigaction(SIGPROF, &action, nullptr) != 0) {
+        LOG(WARNING) << "failed to install the SIGPROF handler, errno=" << errno;
+    }
+}
+
+void QueryCpuSampler::_set_timer(int32_t frequency) {
+    struct itimerval timer;
+    memset(&timer, 0, sizeof(timer));
+    if (frequency > 0) {
+        int64_t interval_us = 1000000 / frequency;
+        timer.it_interval.tv_sec = interval_us / 1000000;
+        timer.it_interval.tv_usec = interval_us % 1000000;
+        timer.it_value = timer.it_interval;
+    }
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+        LOG(WARNING) << "failed to set ITIMER_PROF, errno=" << errno;
+    }
+}
+
+void QueryCpuSampler::add_sample(const CpuSampleTag& tag, void* const* frames, int32_t depth) {
+    Slot* ring = _ring.load(std::memory_order_acquire);
+    if (ring == nullptr || _paused.load(std::memory_order_relaxed)) {
+        return;
+    }
+    Slot& slot = ring[_next_slot.fetch_add(1, std::memory_order_relaxed) % RING_SIZE];
+    int32_t expected = EMPTY;
+    if (!slot.state.compare_exchange_strong(expected, WRITING, std::memory_order_acquire)) {
+        // the ring is full since the collector is behind
+        _dropped_samples.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    slot.tag = tag;
+    slot.depth = std::min(depth, MAX_DEPTH);
+    std::copy(frames, frames + slot.depth, slot.frames);
+    slot.state.store(READY, std::memory_order_release);
+}
+
+void QueryCpuSampler::collect() {
+    Slot* ring = _ring.load(std::memory_order_acquire);
+    if (ring == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> l(_lock);
+    time_t now = time(nullptr);
+    for (size_t i = 0; i < RING_SIZE; ++i) {
+        Slot& slot = ring[i];
+        if (slot.state.load(std::memory_order_acquire) != READY) {
+            continue;
+        }
+        const auto& tag = slot.tag;
+        auto& profile = _profiles[UniqueId(tag.query_id_hi, tag.query_id_lo)];
+        StackKey key {UniqueId(tag.fragment_instance_id_hi, tag.fragment_instance_id_lo),
+                      tag.pipeline_id, tag.pipeline_task_index,
+                      std::vector<void*>(slot.frames, slot.frames + slot.depth)};
+        slot.state.store(EMPTY, std::memory_order_release);
+
+        ++profile.samples;
+        profile.last_sample_time = now;
+        auto it = profile.stacks.find(key);
+        if (it != profile.stacks.end()) {
+            ++it->second;
+        } else if (profile.stacks.size() < MAX_STACKS_PER_QUERY) {
+            profile.stacks.emplace(std::move(key), 1);
+        } else {
+            ++profile.truncated_samples;
+        }
+    }
+
+    // drop the least recently sampled queries
+    size_t max_queries = std::max(config::query_cpu_sampling_max_queries, 1);
+    while (_profiles.size() > max_queries) {
+        auto oldest = std::min_element(_profiles.begin(), _profiles.end(),
+                                       [](const auto& lhs, const auto& rhs) {
+                                           return lhs.second.last_sample_time <
+                                                  rhs.second.last_sample_time;
+                                       });
+        _profiles.erase(oldest);
+    }
+}
+
+std::vector<QueryCpuSampler::QuerySummary> QueryCpuSampler::list_queries() {
+    std::lock_guard<std::mutex> l(_lock);
+    std::vector<QuerySummary> queries;
+    queries.reserve(_profiles.size());
+    for (const auto& [query_id, profile] : _profiles) {
+        queries.push_back({query_id.to_thrift(), profile.samples, profile.last_sample_time});
+    }
+    std::sort(queries.begin(), queries.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.last_sample_time > rhs.last_sample_time;
+    });
+    return queries;
+}
+
+const std::string& QueryCpuSampler::_symbolize(void* addr) {
+    auto it = _symbols.find(addr);
+    if (it != _symbols.end()) {
+        return it->second;
+    }
+    std::string name = boost::stacktrace::frame(addr).name();
+    if (name.empty()) {
+        name = fmt::format("{}", addr);
+    }
+    // ';' separates the frames in the folded stacks
+    std::replace(name.begin(), name.end(), ';', ':');
+    return _symbols.emplace(addr, std::move(name)).first->second;
+}
+
+Status QueryCpuSampler::get_folded_stacks(const TUniqueId& query_id, std::string* result) {
+    std::lock_guard<std::mutex> l(_lock);
+    auto it = _profiles.find(UniqueId(query_id));
+    if (it == _profiles.end()) {
+        return Status::NotFound("no cpu samples of query {}", print_id(query_id));
+    }
+    // the stacks of different addresses in the same functions are merged
+    std::map<std::string, int64_t> stacks;
+    for (const auto& [key, count] : it->second.stacks) {
+        fmt::memory_buffer stack;
+        fmt::format_to(stack, "fragment {}", key.fragment_instance_id.to_string());
+        if (key.pipeline_id >= 0) {
+            fmt::format_to(stack, ";pipeline {} task {}", key.pipeline_id, key.pipeline_task_index);
+        }
+        // from the root frame, the first frame is the interrupted one and the others are the
+        // return addresses, which are moved back into the calls
+        for (size_t i = key.frames.size(); i > 0; --i) {
+            auto* addr = static_cast<char*>(key.frames[i - 1]) - (i > 1 ? 1 : 0);
+            fmt::format_to(stack, ";{}", _symbolize(addr));
+        }
+        stacks[fmt::to_string(stack)] += count;
+    }
+    if (it->second.truncated_samples > 0) {
+        stacks["[truncated]"] += it->second.truncated_samples;
+    }
+    fmt::memory_buffer buffer;
+    for (const auto& [stack, count] : stacks) {
+        fmt::format_to(buffer, "{} {}\n", stack, count);
+    }
+    *result = fmt::to_string(buffer);
+    return Status::OK();
+}
+
+} // namespace doris
@@ -0,0 +1,160 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <gen_cpp/Types_types.h>
+
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/status.h"
+#include "util/uid_util.h"
+
+namespace doris {
+
+// What the current thread is running for, read by the SIGPROF handler, so only PODs are kept.
+struct CpuSampleTag {
+    int64_t query_id_hi;
+    int64_t query_id_lo;
+    int64_t fragment_instance_id_hi;
+    int64_t fragment_instance_id_lo;
+    // -1 if the thread is not running a pipeline task
+    int32_t pipeline_id;
+    int32_t pipeline_task_index;
+};
+
+// Samples the stacks of the threads running queries on SIGPROF of ITIMER_PROF, which is delivered
+// to the thread consuming CPU, and aggregates them per query to be exported as the folded stacks
+// of a flame graph, whose roots are the fragment instances and the pipeline tasks.
+//
+// The signal handler only copies the tag and the stack of the thread into a preallocated ring,
+// which is drained by `collect()` on the daemon thread, so nothing is allocated or locked in the
+// handler.
+class QueryCpuSampler {
+public:
+    static QueryCpuSampler* instance() {
+        static QueryCpuSampler sampler;
+        return &sampler;
+    }
+
+    // Tags the samples of the current thread until clear_tag().
+    static void set_tag(const TUniqueId& query_id, const TUniqueId& fragment_instance_id,
+                        int32_t pipeline_id = -1, int32_t pipeline_task_index = -1);
+    static void clear_tag();
+    static bool is_tagged();
+
+    // Starts sampling at `frequency` samples per CPU second, or stops it if `frequency` is 0.
+    void set_frequency(int32_t frequency);
+    int32_t frequency() const { return _frequency; }
+
+    // Hands SIGPROF over to gperftools' CPU profiler and takes it back.
+    void pause();
+    void resume();
+
+    // Adds a sample, which is called by the signal handler and is async-signal-safe.
+    void add_sample(const CpuSampleTag& tag, void* const* frames, int32_t depth);
+
+    // Moves the samples in the ring into the profiles of the queries.
+    void collect();
+
+    struct QuerySummary {
+        TUniqueId query_id;
+        int64_t samples;
+        time_t last_sample_time;
+    };
+    std::vector<QuerySummary> list_queries();
+
+    // The sampled stacks of the query in the folded format of flamegraph.pl, i.e. "a;b;c count"
+    // per line from the root frame.
+    Status get_folded_stacks(const TUniqueId& query_id, std::string* result);
+
+    int64_t dropped_samples() const { return _dropped_samples.load(std::memory_order_relaxed); }
+
+    static constexpr int32_t MAX_DEPTH = 32;
+    static constexpr size_t RING_SIZE = 8192;
+
+private:
+    QueryCpuSampler() = default;
+
+    void _init_ring();
+    void _install_handler();
+    void _set_timer(int32_t frequency);
+    const std::string& _symbolize(void* addr);
+
+    // The slot of the ring is claimed by the handler with EMPTY -> WRITING and published with
+    // WRITING -> READY, then drained by collect() with READY -> EMPTY.
+    enum SlotState : int32_t { EMPTY = 0, WRITING = 1, READY = 2 };
+    struct Slot {
+        std::atomic<int32_t> state {EMPTY};
+        CpuSampleTag tag;
+        int32_t depth;
+        void* frames[MAX_DEPTH];
+    };
+
+    struct StackKey {
+        UniqueId fragment_instance_id;
+        int32_t pipeline_id;
+        int32_t pipeline_task_index;
+        std::vector<void*> frames;
+
+        bool operator<(const StackKey& rhs) const {
+            if (!(fragment_instance_id == rhs.fragment_instance_id)) {
+                return fragment_instance_id < rhs.fragment_instance_id;
+            }
+            if (pipeline_id != rhs.pipeline_id) {
+                return pipeline_id < rhs.pipeline_id;
+            }
+            if (pipeline_task_index != rhs.pipeline_task_index) {
+                return pipeline_task_index < rhs.pipeline_task_index;
+            }
+            return frames < rhs.frames;
+        }
+    };
+    struct QueryProfile {
+        std::map<StackKey, int64_t> stacks;
+        int64_t samples = 0;
+        // the samples not kept once the query has too many distinct stacks
+        int64_t truncated_samples = 0;
+        time_t last_sample_time = 0;
+    };
+    static constexpr size_t MAX_STACKS_PER_QUERY = 100000;
+
+    std::atomic<int32_t> _frequency {0};
+    std::atomic<bool> _paused {false};
+    std::atomic<bool> _handler_installed {false};
+
+    // allocated once sampling is started for the first time, and never freed since the handler
+    // may be running on any thread
+    std::atomic<Slot*> _ring {nullptr};
+    std::once_flag _ring_once;
+    std::atomic<size_t> _next_slot {0};
+    std::atomic<int64_t> _dropped_samples {0};
+
+    // protects the profiles, the symbols and the timer
+    std::mutex _lock;
+    std::unordered_map<UniqueId, QueryProfile> _profiles;
+    std::unordered_map<void*, std::string> _symbols;
+};
+
+} // namespace doris
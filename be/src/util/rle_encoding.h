@@ -356,13 +356,14 @@ size_t RleDecoder<T>::get_values(T* values, size_t num_values) {
             read_num += read_this_time;
         } else if (literal_count_ > 0) {
             read_this_time = std::min((size_t)literal_count_, read_this_time);
-            for (int i = 0; i < read_this_time; ++i) {
-                bool result = bit_reader_.GetValue(bit_width_, values);
-                DCHECK(result);
-                values++;
+            size_t num_read = bit_reader_.UnpackBatch(bit_width_, read_this_time, values);
+            DCHECK_EQ(num_read, read_this_time);
+            values += num_read;
+            literal_count_ -= num_read;
+            read_num += num_read;
+            if (PREDICT_FALSE(num_read < read_this_time)) {
+                return read_num;
             }
-            literal_count_ -= read_this_time;
-            read_num += read_this_time;
         } else {
             if (!ReadHeader()) {
                 return read_num;
@@ -219,6 +219,8 @@ void RuntimeProfile::divide(int n) {
         for (iter = _counter_map.begin(); iter != _counter_map.end(); ++iter) {
             if (iter->second->type() == TUnit::DOUBLE_VALUE) {
                 iter->second->set(iter->second->double_value() / n);
+            } else if (auto* counter = dynamic_cast<CoreLocalCounter*>(iter->second)) {
+                counter->set(counter->value() / n);
             } else {
                 int64_t value = iter->second->_value.load();
                 value = value / n;
@@ -374,6 +376,7 @@ const std::string* RuntimeProfile::get_info_string(const std::string& key) {
 
 //ADD_COUNTER_IMPL(AddCounter, Counter);
 ADD_COUNTER_IMPL(AddHighWaterMarkCounter, HighWaterMarkCounter);
+ADD_COUNTER_IMPL(add_core_local_counter, CoreLocalCounter);
 //ADD_COUNTER_IMPL(AddConcurrentTimerCounter, ConcurrentTimerCounter);
 
 std::shared_ptr<RuntimeProfile::HighWaterMarkCounter> RuntimeProfile::AddSharedHighWaterMarkCounter(
@@ -33,6 +33,7 @@
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
 #include "util/binary_cast.hpp"
+#include "util/core_local.h"
 #include "util/pretty_printer.h"
 #include "util/stopwatch.hpp"
 #include "util/telemetry/telemetry.h"
@@ -47,9 +48,12 @@ namespace doris {
 #define ADD_TIMER(profile, name) (profile)->add_counter(name, TUnit::TIME_NS)
 #define ADD_CHILD_COUNTER(profile, name, type, parent) (profile)->add_counter(name, type, parent)
 #define ADD_CHILD_TIMER(profile, name, parent) (profile)->add_counter(name, TUnit::TIME_NS, parent)
+#define ADD_CORE_LOCAL_COUNTER(profile, name, type) (profile)->add_core_local_counter(name, type)
+#define ADD_CORE_LOCAL_TIMER(profile, name) (profile)->add_core_local_counter(name, TUnit::TIME_NS)
 #define SCOPED_TIMER(c) ScopedTimer<MonotonicStopWatch> MACRO_CONCAT(SCOPED_TIMER, __COUNTER__)(c)
 #define SCOPED_TIMER_ATOMIC(c) \
     ScopedTimer<MonotonicStopWatch, std::atomic_bool> MACRO_CONCAT(SCOPED_TIMER, __COUNTER__)(c)
+#define SCOPED_TSC_TIMER(c) ScopedTimer<TscStopWatch> MACRO_CONCAT(SCOPED_TIMER, __COUNTER__)(c)
 #define SCOPED_CPU_TIMER(c) \
     ScopedTimer<ThreadCpuStopWatch> MACRO_CONCAT(SCOPED_TIMER, __COUNTER__)(c)
 #define CANCEL_SAFE_SCOPED_TIMER(c, is_cancelled) \
@@ -170,6 +174,40 @@ public:
         std::atomic<int64_t> current_value_;
     };
 
+    /// A counter of a slot per core, which is summed up when it's read. The threads on
+    /// different cores update it without bouncing a cache line between the cores, so it's for
+    /// the counters updated by many threads at once, e.g. the ones shared by the scanners of a
+    /// scan node. It takes a slot of every core, so the others should stay plain counters.
+    class CoreLocalCounter : public Counter {
+    public:
+        CoreLocalCounter(TUnit::type type) : Counter(type) {}
+
+        void update(int64_t delta) override { __sync_fetch_and_add(_values.access(), delta); }
+
+        /// Not atomic with the updates at the same time.
+        void set(int64_t value) override {
+            for (size_t i = 1; i < _values.size(); ++i) {
+                *_values.access_at_core(i) = 0;
+            }
+            *_values.access_at_core(0) = value;
+        }
+
+        void set(double value) override { set(binary_cast<double, int64_t>(value)); }
+
+        int64_t value() const override {
+            int64_t sum = 0;
+            for (size_t i = 0; i < _values.size(); ++i) {
+                sum += __atomic_load_n(_values.access_at_core(i), __ATOMIC_RELAXED);
+            }
+            return sum;
+        }
+
+        double double_value() const override { return binary_cast<int64_t, double>(value()); }
+
+    private:
+        CoreLocalValue<int64_t> _values;
+    };
+
     using DerivedCounterFunction = std::function<int64_t()>;
 
     // A DerivedCounter also has a name and type, but the value is computed.
@@ -181,6 +219,8 @@ public:
 
         int64_t value() const override { return _counter_fn(); }
 
+        double double_value() const override { return binary_cast<int64_t, double>(value()); }
+
     private:
         DerivedCounterFunction _counter_fn;
     };
@@ -279,6 +319,10 @@ public:
         return add_counter(name, type, "");
     }
 
+    // Same as add_counter(), but the counter is a CoreLocalCounter.
+    CoreLocalCounter* add_core_local_counter(const std::string& name, TUnit::type type,
+                                             const std::string& parent_counter_name = "");
+
     // Add a derived counter with 'name'/'type'. The counter is owned by the
     // RuntimeProfile object.
     // If parent_counter_name is a non-empty string, the counter is added as a child of
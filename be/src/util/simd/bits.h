@@ -61,6 +61,62 @@ inline uint32_t bytes32_mask_to_bits32_mask(const bool* data) {
     return bytes32_mask_to_bits32_mask(reinterpret_cast<const uint8_t*>(data));
 }
 
+/// Transform the 32 bytes equal to `byte` to a 32-bit mask
+inline uint32_t bytes32_eq_mask(const char* data, char byte) {
+#ifdef __AVX2__
+    uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)),
+                              _mm256_set1_epi8(byte))));
+#elif defined(__SSE2__) || defined(__aarch64__)
+    auto byte16 = _mm_set1_epi8(byte);
+    uint32_t mask =
+            (static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), byte16)))) |
+            ((static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(
+                      _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)), byte16)))
+              << 16) &
+             0xffff0000);
+#else
+    uint32_t mask = 0;
+    for (std::size_t i = 0; i < 32; ++i) {
+        mask |= static_cast<uint32_t>(byte == *(data + i)) << i;
+    }
+#endif
+    return mask;
+}
+
+// Append the offsets of the non zero flags, plus `first`, to sel.
+// Return the number of appended offsets.
+inline uint16_t flags_to_sel(const uint8_t* __restrict flags, uint16_t size, uint16_t first,
+                             uint16_t* __restrict sel) {
+    static constexpr uint16_t SIMD_BYTES = 32;
+    uint16_t new_size = 0;
+    uint16_t pos = 0;
+    const uint16_t end_simd = size / SIMD_BYTES * SIMD_BYTES;
+    for (; pos < end_simd; pos += SIMD_BYTES) {
+        auto mask = bytes32_mask_to_bits32_mask(flags + pos);
+        if (0 == mask) {
+            //pass
+        } else if (0xffffffff == mask) {
+            for (uint16_t i = 0; i < SIMD_BYTES; i++) {
+                sel[new_size++] = first + pos + i;
+            }
+        } else {
+            while (mask) {
+                const size_t bit_pos = __builtin_ctzll(mask);
+                sel[new_size++] = first + pos + bit_pos;
+                mask = mask & (mask - 1);
+            }
+        }
+    }
+    for (; pos < size; pos++) {
+        if (flags[pos]) {
+            sel[new_size++] = first + pos;
+        }
+    }
+    return new_size;
+}
+
 inline size_t count_zero_num(const int8_t* __restrict data, size_t size) {
     size_t num = 0;
     const int8_t* end = data + size;
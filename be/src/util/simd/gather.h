@@ -0,0 +1,58 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace doris {
+namespace simd {
+
+// out[i] = dict[indexes[i]] for 0 <= i < num_values, e.g. to decode dictionary encoded values.
+// The indexes must be less than the size of dict and INT32_MAX.
+template <typename T>
+inline void gather(const T* __restrict dict, const uint32_t* __restrict indexes, size_t num_values,
+                   T* __restrict out) {
+    size_t i = 0;
+#ifdef __AVX2__
+    if constexpr (sizeof(T) == 4) {
+        for (; i + 8 <= num_values; i += 8) {
+            __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indexes + i));
+            __m256i values = _mm256_i32gather_epi32(reinterpret_cast<const int*>(dict), idx, 4);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), values);
+        }
+    } else if constexpr (sizeof(T) == 8) {
+        for (; i + 4 <= num_values; i += 4) {
+            __m128i idx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indexes + i));
+            __m256i values =
+                    _mm256_i32gather_epi64(reinterpret_cast<const long long*>(dict), idx, 8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), values);
+        }
+    }
+#endif
+    for (; i < num_values; ++i) {
+        out[i] = dict[indexes[i]];
+    }
+}
+
+} // namespace simd
+} // namespace doris
@@ -19,6 +19,7 @@
 
 #include <unistd.h>
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
@@ -134,6 +135,52 @@ public:
         return !(or_code & 0x80);
     }
 
+    // Returns the count of the chars in `len` bytes, stepped by UTF8_BYTE_LENGTH from `src`.
+    static size_t get_char_len(const char* src, size_t len) {
+        const char* p = src;
+        const char* end = src + len;
+        size_t char_len = 0;
+#if defined(__SSE2__) || defined(__aarch64__)
+        while (p + REGISTER_SIZE <= end) {
+            size_t block_chars = 0;
+            size_t block_bytes = step_utf8_block(p, &block_chars);
+            if (block_bytes == 0) {
+                p += UTF8_BYTE_LENGTH[(unsigned char)*p];
+                ++char_len;
+            } else {
+                p += block_bytes;
+                char_len += block_chars;
+            }
+        }
+#endif
+        for (; p < end; p += UTF8_BYTE_LENGTH[(unsigned char)*p]) {
+            ++char_len;
+        }
+        return char_len;
+    }
+
+    // Returns the start of the char after stepping over `n` chars from `p` by UTF8_BYTE_LENGTH,
+    // or `end` if there are no more chars.
+    static const char* skip_chars(const char* p, const char* end, size_t n) {
+#if defined(__SSE2__) || defined(__aarch64__)
+        while (n >= REGISTER_SIZE && p + REGISTER_SIZE <= end) {
+            size_t block_chars = 0;
+            size_t block_bytes = step_utf8_block(p, &block_chars);
+            if (block_bytes == 0) {
+                p += UTF8_BYTE_LENGTH[(unsigned char)*p];
+                --n;
+            } else {
+                p += block_bytes;
+                n -= block_chars;
+            }
+        }
+#endif
+        for (; n > 0 && p < end; --n) {
+            p += UTF8_BYTE_LENGTH[(unsigned char)*p];
+        }
+        return std::min(p, end);
+    }
+
     static void reverse(const StringRef& str, StringRef dst) {
         if (is_ascii(str)) {
             int64_t begin = 0;
@@ -211,6 +258,47 @@ public:
         LowerUpperImpl<'a', 'z'> lowerUpper;
         lowerUpper.transfer(src, src + len, dst);
     }
+
+private:
+#if defined(__SSE2__) || defined(__aarch64__)
+    // Steps over the complete chars of the REGISTER_SIZE bytes from `p`, which is the start of a
+    // char. Returns the bytes stepped over and sets `chars` to the count of the chars, or returns
+    // 0 if the bytes are not well formed UTF-8, which may only be stepped one by one.
+    // In well formed bytes every char is a lead byte followed by exactly the continuation bytes
+    // of its UTF8_BYTE_LENGTH, so the chars are the bytes which are not continuation bytes.
+    static size_t step_utf8_block(const char* p, size_t* chars) {
+        const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const auto zero = _mm_setzero_si128();
+        // the bytes whose unsigned value is at least `bound`
+        auto at_least = [&](uint8_t bound) -> uint32_t {
+            return _mm_movemask_epi8(
+                    _mm_cmpeq_epi8(_mm_subs_epu8(_mm_set1_epi8(bound), bytes), zero));
+        };
+        uint32_t non_ascii = at_least(0x80);
+        if (non_ascii == 0) {
+            *chars = REGISTER_SIZE;
+            return REGISTER_SIZE;
+        }
+        if (at_least(0xF8) != 0) {
+            return 0;
+        }
+        uint32_t lead2 = at_least(0xC0);
+        uint32_t lead3 = at_least(0xE0);
+        uint32_t lead4 = at_least(0xF0);
+        uint32_t continuation = non_ascii & ~lead2;
+        // the leading bytes of the last char may be cut off at the end of the block
+        for (size_t tail = 0; tail < 4; ++tail) {
+            uint32_t region = (1U << (REGISTER_SIZE - tail)) - 1;
+            uint32_t expected = ((lead2 & region) << 1) | ((lead3 & region) << 2) |
+                                ((lead4 & region) << 3);
+            if (expected == (continuation & region)) {
+                *chars = __builtin_popcount(region & ~continuation);
+                return REGISTER_SIZE - tail;
+            }
+        }
+        return 0;
+    }
+#endif
 };
 } // namespace simd
 } // namespace doris
@@ -0,0 +1,86 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <parallel_hashmap/phmap.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace doris {
+
+// Space-Saving sketch of Metwally et al. ("Efficient Computation of Frequent and Top-k Elements
+// in Data Streams", ICDT 2005), which finds the heavy hitters of a stream of keys with a fixed
+// number of counters.
+//
+// When there is no free counter, a new key takes over the counter with the minimal count, and
+// the old count becomes the error of the new key. So a count overestimates the frequency of its
+// key by at most error, and error is at most total() / capacity.
+class SpaceSaving {
+public:
+    struct Counter {
+        uint64_t key;
+        uint64_t count;
+        uint64_t error;
+    };
+
+    explicit SpaceSaving(size_t capacity) : _capacity(capacity) { _counters.reserve(capacity); }
+
+    void insert(uint64_t key) {
+        ++_total;
+        auto it = _index.find(key);
+        if (it != _index.end()) {
+            ++_counters[it->second].count;
+            return;
+        }
+        if (_counters.size() < _capacity) {
+            _index.emplace(key, _counters.size());
+            _counters.push_back({key, 1, 0});
+            return;
+        }
+        auto min_it = std::min_element(
+                _counters.begin(), _counters.end(),
+                [](const Counter& a, const Counter& b) { return a.count < b.count; });
+        _index.erase(min_it->key);
+        _index.emplace(key, min_it - _counters.begin());
+        *min_it = {key, min_it->count + 1, min_it->count};
+    }
+
+    // The keys which occur at least min_count times for sure.
+    std::vector<Counter> heavy_hitters(uint64_t min_count) const {
+        std::vector<Counter> result;
+        for (const auto& counter : _counters) {
+            if (counter.count - counter.error >= min_count) {
+                result.push_back(counter);
+            }
+        }
+        return result;
+    }
+
+    uint64_t total() const { return _total; }
+
+private:
+    const size_t _capacity;
+    uint64_t _total = 0;
+    std::vector<Counter> _counters;
+    // key => index in _counters
+    phmap::flat_hash_map<uint64_t, size_t> _index;
+};
+
+} // namespace doris
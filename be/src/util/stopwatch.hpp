@@ -22,6 +22,13 @@
 
 #include <time.h>
 
+#include <cstdint>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
 namespace doris {
 
 // Stop watch for reporting elapsed time in nanosec based on CLOCK_MONOTONIC.
@@ -92,4 +99,99 @@ using MonotonicStopWatch = CustomStopWatch<CLOCK_MONOTONIC>;
 // Stop watch for reporting elapsed nanosec based on CLOCK_THREAD_CPUTIME_ID.
 using ThreadCpuStopWatch = CustomStopWatch<CLOCK_THREAD_CPUTIME_ID>;
 
+// The time stamp counter of x86, which is read by RDTSC in a few cycles without the call and
+// the conversion of clock_gettime(). It's only used if it's invariant, i.e. it ticks at a
+// constant rate whatever the frequency and the power state of the cpu are, and so it's
+// synchronized between the cores. Otherwise the ticks are the nanosec of CLOCK_MONOTONIC.
+class TscClock {
+public:
+    static uint64_t ticks() {
+#if defined(__x86_64__)
+        if (nanosec_per_tick() != 0) {
+            return __rdtsc();
+        }
+#endif
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return now.tv_sec * 1000L * 1000L * 1000L + now.tv_nsec;
+    }
+
+    static uint64_t to_nanosec(uint64_t ticks) {
+        double nanosec_per_tick = TscClock::nanosec_per_tick();
+        return nanosec_per_tick == 0 ? ticks : static_cast<uint64_t>(ticks * nanosec_per_tick);
+    }
+
+    // 0 if the TSC is not used. It's measured against CLOCK_MONOTONIC for 10ms by the first
+    // call, so call it once before the timers are on a hot path.
+    static double nanosec_per_tick() {
+        static const double s_nanosec_per_tick = _calibrate();
+        return s_nanosec_per_tick;
+    }
+
+private:
+    static double _calibrate() {
+#if defined(__x86_64__)
+        unsigned int eax, ebx, ecx, edx;
+        // CPUID.80000007H:EDX[8] is the invariant TSC
+        if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) == 0 || (edx & (1 << 8)) == 0) {
+            return 0;
+        }
+        timespec begin, end;
+        clock_gettime(CLOCK_MONOTONIC, &begin);
+        uint64_t begin_ticks = __rdtsc();
+        int64_t elapsed = 0;
+        do {
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            elapsed = (end.tv_sec - begin.tv_sec) * 1000L * 1000L * 1000L +
+                      (end.tv_nsec - begin.tv_nsec);
+        } while (elapsed < 10 * 1000L * 1000L);
+        uint64_t end_ticks = __rdtsc();
+        return end_ticks > begin_ticks ? static_cast<double>(elapsed) / (end_ticks - begin_ticks)
+                                       : 0;
+#else
+        return 0;
+#endif
+    }
+};
+
+// Stop watch for reporting elapsed nanosec based on TscClock, which is cheaper than the ones
+// above for the timers of the hot paths. The time is an estimation by the rate of the TSC, and
+// it includes the time the thread is descheduled, as the one of MonotonicStopWatch does.
+class TscStopWatch {
+public:
+    void start() {
+        if (!_running) {
+            _start = TscClock::ticks();
+            _running = true;
+        }
+    }
+
+    void stop() {
+        if (_running) {
+            _total_ticks += TscClock::ticks() - _start;
+            _running = false;
+        }
+    }
+
+    // Restarts the timer. Returns the elapsed time until this point.
+    uint64_t reset() {
+        uint64_t ret = elapsed_time();
+        if (_running) {
+            _start = TscClock::ticks();
+        }
+        return ret;
+    }
+
+    // Returns time in nanosecond.
+    uint64_t elapsed_time() const {
+        uint64_t ticks = _running ? _total_ticks + TscClock::ticks() - _start : _total_ticks;
+        return TscClock::to_nanosec(ticks);
+    }
+
+private:
+    uint64_t _start = 0;
+    uint64_t _total_ticks = 0;
+    bool _running = false;
+};
+
 } // namespace doris
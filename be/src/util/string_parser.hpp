@@ -199,6 +199,21 @@ private:
     // Return PARSE_FAILURE on leading whitespace. Trailing whitespace is allowed.
     static inline bool string_to_bool_internal(const char* s, int len, ParseResult* result);
 
+    // Returns true if the 8 bytes of the little endian `chunk` are all ascii digits.
+    static inline bool is_eight_digits(uint64_t chunk) {
+        return ((chunk & 0xF0F0F0F0F0F0F0F0) |
+                (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+               0x3333333333333333;
+    }
+
+    // Returns the value of the 8 ascii digits of the little endian `chunk`, the first digit is
+    // the most significant one.
+    static inline uint32_t parse_eight_digits(uint64_t chunk) {
+        chunk = ((chunk & 0x0F0F0F0F0F0F0F0F) * 2561) >> 8;
+        chunk = ((chunk & 0x00FF00FF00FF00FF) * 6553601) >> 16;
+        return static_cast<uint32_t>(((chunk & 0x0000FFFF0000FFFF) * 42949672960001) >> 32);
+    }
+
     // Returns true if s only contains whitespace.
     static inline bool is_all_whitespace(const char* s, int len) {
         for (int i = 0; i < len; ++i) {
@@ -395,14 +410,29 @@ T StringParser::string_to_int_no_overflow(const char* s, int len, ParseResult* r
         *result = PARSE_SUCCESS;
         return val;
     }
-    // Factor out the first char for error handling speeds up the loop.
-    if (LIKELY(s[0] >= '0' && s[0] <= '9')) {
-        val = s[0] - '0';
-    } else {
-        *result = PARSE_FAILURE;
-        return 0;
+    int i = 0;
+    if constexpr (sizeof(T) >= sizeof(uint32_t)) {
+        // 8 digits at a time, the value of less than max_ascii_len() digits fits in T
+        uint64_t chunk;
+        for (; len - i >= 8; i += 8) {
+            memcpy(&chunk, s + i, sizeof(chunk));
+            if (!is_eight_digits(chunk)) {
+                break;
+            }
+            val = val * 100000000 + parse_eight_digits(chunk);
+        }
+    }
+    if (i == 0) {
+        // Factor out the first char for error handling speeds up the loop.
+        if (LIKELY(s[0] >= '0' && s[0] <= '9')) {
+            val = s[0] - '0';
+        } else {
+            *result = PARSE_FAILURE;
+            return 0;
+        }
+        i = 1;
     }
-    for (int i = 1; i < len; ++i) {
+    for (; i < len; ++i) {
         if (LIKELY(s[i] >= '0' && s[i] <= '9')) {
             T digit = s[i] - '0';
             val = val * 10 + digit;
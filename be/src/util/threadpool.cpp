@@ -20,6 +20,9 @@
 
 #include "util/threadpool.h"
 
+#include <fmt/format.h>
+
+#include <algorithm>
 #include <cstdint>
 #include <limits>
 #include <ostream>
@@ -30,12 +33,23 @@
 #include "gutil/map-util.h"
 #include "gutil/strings/substitute.h"
 #include "util/debug/sanitizer_scopes.h"
+#include "util/doris_metrics.h"
 #include "util/scoped_cleanup.h"
 #include "util/thread.h"
 
 namespace doris {
 using namespace ErrorCode;
 
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(thread_pool_task_execution_count, MetricUnit::NOUNIT);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(thread_pool_task_execution_time_ns_total,
+                                     MetricUnit::NANOSECONDS);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(thread_pool_task_wait_worker_time_ns_total,
+                                     MetricUnit::NANOSECONDS);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(thread_pool_submit_failed, MetricUnit::NOUNIT);
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(thread_pool_queue_size, MetricUnit::NOUNIT);
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(thread_pool_active_threads, MetricUnit::NOUNIT);
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(thread_pool_max_threads, MetricUnit::NOUNIT);
+
 using std::string;
 using strings::Substitute;
 
@@ -224,7 +238,7 @@ const char* ThreadPoolToken::state_to_string(State s) {
 bool ThreadPoolToken::need_dispatch() {
     return _state == ThreadPoolToken::State::IDLE ||
            (_mode == ThreadPool::ExecutionMode::CONCURRENT &&
-            _num_submitted_tasks < _max_concurrency);
+            _num_submitted_tasks < std::min(_max_concurrency, _pool->max_queued_tasks_per_token()));
 }
 
 ThreadPool::ThreadPool(const ThreadPoolBuilder& builder)
@@ -245,6 +259,7 @@ ThreadPool::~ThreadPool() {
     CHECK_EQ(1, _tokens.size()) << strings::Substitute(
             "Threadpool $0 destroyed with $1 allocated tokens", _name, _tokens.size());
     shutdown();
+    deregister_metrics();
 }
 
 Status ThreadPool::init() {
@@ -252,6 +267,7 @@ Status ThreadPool::init() {
         return Status::NotSupported("The thread pool {} is already initialized", _name);
     }
     _pool_status = Status::OK();
+    register_metrics();
     _num_threads_pending_start = _min_threads;
     for (int i = 0; i < _min_threads; i++) {
         Status status = create_thread();
@@ -263,6 +279,33 @@ Status ThreadPool::init() {
     return Status::OK();
 }
 
+void ThreadPool::register_metrics() {
+    _metric_entity = DorisMetrics::instance()->metric_registry()->register_entity(
+            "thread_pool", {{"thread_pool_name", _name}});
+    INT_COUNTER_METRIC_REGISTER(_metric_entity, thread_pool_task_execution_count);
+    INT_COUNTER_METRIC_REGISTER(_metric_entity, thread_pool_task_execution_time_ns_total);
+    INT_COUNTER_METRIC_REGISTER(_metric_entity, thread_pool_task_wait_worker_time_ns_total);
+    INT_COUNTER_METRIC_REGISTER(_metric_entity, thread_pool_submit_failed);
+    INT_GAUGE_METRIC_REGISTER(_metric_entity, thread_pool_queue_size);
+    INT_GAUGE_METRIC_REGISTER(_metric_entity, thread_pool_active_threads);
+    INT_GAUGE_METRIC_REGISTER(_metric_entity, thread_pool_max_threads);
+    _metric_entity->register_hook(fmt::format("{}_{}", _name, static_cast<void*>(this)), [this]() {
+        std::lock_guard<std::mutex> l(_lock);
+        thread_pool_queue_size->set_value(_total_queued_tasks);
+        thread_pool_active_threads->set_value(_active_threads);
+        thread_pool_max_threads->set_value(_max_threads);
+    });
+}
+
+void ThreadPool::deregister_metrics() {
+    if (_metric_entity == nullptr) {
+        return;
+    }
+    _metric_entity->deregister_hook(fmt::format("{}_{}", _name, static_cast<void*>(this)));
+    DorisMetrics::instance()->metric_registry()->deregister_entity(_metric_entity);
+    _metric_entity.reset();
+}
+
 void ThreadPool::shutdown() {
     debug::ScopedTSANIgnoreReadsAndWrites ignore_tsan;
     std::unique_lock<std::mutex> l(_lock);
@@ -345,8 +388,8 @@ Status ThreadPool::submit_func(std::function<void()> f) {
 
 Status ThreadPool::do_submit(std::shared_ptr<Runnable> r, ThreadPoolToken* token) {
     DCHECK(token);
-    std::chrono::time_point<std::chrono::system_clock> submit_time =
-            std::chrono::system_clock::now();
+    std::chrono::time_point<std::chrono::steady_clock> submit_time =
+            std::chrono::steady_clock::now();
 
     std::unique_lock<std::mutex> l(_lock);
     if (PREDICT_FALSE(!_pool_status.ok())) {
@@ -361,6 +404,7 @@ Status ThreadPool::do_submit(std::shared_ptr<Runnable> r, ThreadPoolToken* token
     int64_t capacity_remaining = static_cast<int64_t>(_max_threads) - _active_threads +
                                  static_cast<int64_t>(_max_queue_size) - _total_queued_tasks;
     if (capacity_remaining < 1) {
+        thread_pool_submit_failed->increment(1);
         return Status::ServiceUnavailable(
                 "Thread pool {} is at capacity ({}/{} tasks running, {}/{} tasks queued)", _name,
                 _num_threads + _num_threads_pending_start, _max_threads, _total_queued_tasks,
@@ -525,8 +569,17 @@ void ThreadPool::dispatch_thread() {
 
         l.unlock();
 
+        auto start_time = std::chrono::steady_clock::now();
+        thread_pool_task_wait_worker_time_ns_total->increment(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(start_time - task.submit_time)
+                        .count());
         // Execute the task
         task.runnable->run();
+        thread_pool_task_execution_time_ns_total->increment(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - start_time)
+                        .count());
+        thread_pool_task_execution_count->increment(1);
 
         // Destruct the task while we do not hold the lock.
         //
@@ -33,6 +33,7 @@
 
 #include "common/status.h"
 #include "gutil/ref_counted.h"
+#include "util/metrics.h"
 #include "util/priority_thread_pool.hpp"
 
 namespace doris {
@@ -257,7 +258,7 @@ private:
         std::shared_ptr<Runnable> runnable;
 
         // Time at which the entry was submitted to the pool.
-        std::chrono::time_point<std::chrono::system_clock> submit_time;
+        std::chrono::time_point<std::chrono::steady_clock> submit_time;
     };
 
     // Creates a new thread pool using a builder.
@@ -284,6 +285,16 @@ private:
     // Releases token 't' and invalidates it.
     void release_token(ThreadPoolToken* t);
 
+    // The max number of tasks of a token in '_queue' at the same time, the others wait in the
+    // token until one of them is finished, then the token is queued again behind the other
+    // tokens, so that a token submitting many tasks does not hold the pool before the others.
+    //
+    // Protected by _lock.
+    int max_queued_tasks_per_token() const { return _max_threads; }
+
+    void register_metrics();
+    void deregister_metrics();
+
     const std::string _name;
     int _min_threads;
     int _max_threads;
@@ -368,6 +379,17 @@ private:
     // ExecutionMode::CONCURRENT token used by the pool for tokenless submission.
     std::unique_ptr<ThreadPoolToken> _tokenless;
 
+    // The metrics of the pools are labeled by their names, and the counters are shared by the
+    // pools of the same name.
+    std::shared_ptr<MetricEntity> _metric_entity;
+    IntCounter* thread_pool_task_execution_count = nullptr;
+    IntCounter* thread_pool_task_execution_time_ns_total = nullptr;
+    IntCounter* thread_pool_task_wait_worker_time_ns_total = nullptr;
+    IntCounter* thread_pool_submit_failed = nullptr;
+    IntGauge* thread_pool_queue_size = nullptr;
+    IntGauge* thread_pool_active_threads = nullptr;
+    IntGauge* thread_pool_max_threads = nullptr;
+
     ThreadPool(const ThreadPool&) = delete;
     void operator=(const ThreadPool&) = delete;
 };
@@ -18,6 +18,8 @@
 
 #include "util/timezone_utils.h"
 
+#include <limits>
+
 namespace doris {
 
 RE2 TimezoneUtils::time_zone_offset_format_reg("^[+-]{1}\\d{2}\\:\\d{2}$");
@@ -53,4 +55,24 @@ bool TimezoneUtils::find_cctz_time_zone(const std::string& timezone, cctz::time_
     }
 }
 
+void TimezoneOffsetCache::_refill(int64_t timestamp) {
+    const cctz::time_point<cctz::seconds> tp(cctz::seconds {timestamp});
+    _offset = _ctz.lookup(tp).offset;
+    _begin = std::numeric_limits<int64_t>::min();
+    _end = std::numeric_limits<int64_t>::max();
+    cctz::time_zone::civil_transition trans;
+    // the range starts from the transition at `timestamp` itself if any
+    if (_ctz.prev_transition(tp + cctz::seconds(1), &trans)) {
+        _begin = _ctz.lookup(trans.to).trans.time_since_epoch().count();
+    }
+    if (_ctz.next_transition(tp, &trans)) {
+        _end = _ctz.lookup(trans.to).trans.time_since_epoch().count();
+    }
+    if (timestamp < _begin || timestamp >= _end) {
+        // the transitions of the distant times are unspecified
+        _begin = timestamp;
+        _end = timestamp + 1;
+    }
+}
+
 } // namespace doris
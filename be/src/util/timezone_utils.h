@@ -20,6 +20,9 @@
 
 #include <re2/re2.h>
 
+#include <cstdint>
+#include <string>
+
 #include "cctz/time_zone.h"
 
 namespace doris {
@@ -35,4 +38,44 @@ private:
     // RE2 obj is thread safe
     static RE2 time_zone_offset_format_reg;
 };
+
+// Converts between the seconds since the epoch and the civil times of a time zone with the
+// offset of the last range of instants between two transitions of the zone, which covers most
+// of the values of a column, so that the transitions are only looked up by cctz when a value
+// falls out of the range.
+class TimezoneOffsetCache {
+public:
+    explicit TimezoneOffsetCache(const cctz::time_zone& ctz) : _ctz(ctz) {}
+
+    const cctz::time_zone& time_zone() const { return _ctz; }
+
+    cctz::civil_second to_civil(int64_t timestamp) {
+        if (timestamp < _begin || timestamp >= _end) {
+            _refill(timestamp);
+        }
+        return cctz::civil_second() + (timestamp + _offset);
+    }
+
+    int64_t to_timestamp(const cctz::civil_second& cs) {
+        int64_t timestamp = (cs - cctz::civil_second()) - _offset;
+        // the civil times around a transition may be skipped or repeated, which cctz resolves
+        if (timestamp - MAX_OFFSET_CHANGE >= _begin && timestamp + MAX_OFFSET_CHANGE < _end) {
+            return timestamp;
+        }
+        timestamp = cctz::convert(cs, _ctz).time_since_epoch().count();
+        _refill(timestamp);
+        return timestamp;
+    }
+
+private:
+    static constexpr int64_t MAX_OFFSET_CHANGE = 24 * 60 * 60;
+
+    void _refill(int64_t timestamp);
+
+    cctz::time_zone _ctz;
+    // the offset of the instants [_begin, _end)
+    int64_t _begin = 0;
+    int64_t _end = 0;
+    int64_t _offset = 0;
+};
 } // namespace doris
@@ -0,0 +1,145 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/logging.h"
+
+namespace doris {
+
+// Lock free work stealing deque of Chase and Lev, with the memory orders of
+// "Correct and Efficient Work-Stealing for Weak Memory Models" (Le et al, PPoPP 2013).
+//
+// Only the owner thread can call push() and pop(), which work on the bottom of the
+// deque (LIFO). Any thread can call steal(), which takes from the top (FIFO). steal()
+// may return nullptr when it loses the race with another thread, even if the deque
+// is not empty.
+//
+// The buffer grows when it is full. The old buffers are kept until the deque is
+// destroyed, because a concurrent steal() may still read them.
+template <typename T>
+class WorkStealingDeque {
+public:
+    explicit WorkStealingDeque(int64_t capacity = 1024) {
+        DCHECK(capacity > 0 && (capacity & (capacity - 1)) == 0) << "must be power of 2";
+        _buffers.emplace_back(new Buffer(capacity));
+        _buffer.store(_buffers.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // Owner only.
+    void push(T* item) {
+        int64_t b = _bottom.load(std::memory_order_relaxed);
+        int64_t t = _top.load(std::memory_order_acquire);
+        Buffer* buffer = _buffer.load(std::memory_order_relaxed);
+        if (b - t > buffer->capacity - 1) {
+            buffer = _grow(buffer, b, t);
+        }
+        buffer->put(b, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        _bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // Owner only.
+    T* pop() {
+        int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = _buffer.load(std::memory_order_relaxed);
+        _bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = _top.load(std::memory_order_relaxed);
+        if (t > b) {
+            // empty
+            _bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        T* item = buffer->get(b);
+        if (t == b) {
+            // the last item, race with the thieves
+            if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                              std::memory_order_relaxed)) {
+                item = nullptr;
+            }
+            _bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    // Any thread.
+    T* steal() {
+        int64_t t = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = _bottom.load(std::memory_order_acquire);
+        if (t >= b) {
+            return nullptr;
+        }
+        Buffer* buffer = _buffer.load(std::memory_order_acquire);
+        T* item = buffer->get(t);
+        if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return item;
+    }
+
+    // Not accurate when there are concurrent operations.
+    int64_t size() const {
+        int64_t b = _bottom.load(std::memory_order_relaxed);
+        int64_t t = _top.load(std::memory_order_relaxed);
+        return b > t ? b - t : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+
+private:
+    struct Buffer {
+        explicit Buffer(int64_t capacity_)
+                : capacity(capacity_), mask(capacity_ - 1), items(new std::atomic<T*>[capacity_]) {}
+
+        T* get(int64_t i) const { return items[i & mask].load(std::memory_order_relaxed); }
+        void put(int64_t i, T* item) { items[i & mask].store(item, std::memory_order_relaxed); }
+
+        const int64_t capacity;
+        const int64_t mask;
+        std::unique_ptr<std::atomic<T*>[]> items;
+    };
+
+    Buffer* _grow(Buffer* buffer, int64_t bottom, int64_t top) {
+        _buffers.emplace_back(new Buffer(buffer->capacity * 2));
+        Buffer* new_buffer = _buffers.back().get();
+        for (int64_t i = top; i < bottom; ++i) {
+            new_buffer->put(i, buffer->get(i));
+        }
+        _buffer.store(new_buffer, std::memory_order_release);
+        return new_buffer;
+    }
+
+    // _top and _bottom are written by different threads, keep them in different cache lines
+    alignas(64) std::atomic<int64_t> _top = 0;
+    alignas(64) std::atomic<int64_t> _bottom = 0;
+    alignas(64) std::atomic<Buffer*> _buffer;
+    // only accessed by the owner
+    std::vector<std::unique_ptr<Buffer>> _buffers;
+};
+
+} // namespace doris
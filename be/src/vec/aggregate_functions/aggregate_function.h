@@ -113,6 +113,11 @@ public:
                                     ConstAggregateDataPtr rhs, Arena* arena,
                                     const size_t num_rows) const = 0;
 
+    // same as merge_vec, but only for the `num_rows` rows numbered in `rows`
+    virtual void merge_vec_rows(const AggregateDataPtr* places, size_t offset,
+                                ConstAggregateDataPtr rhs, Arena* arena, const uint32_t* rows,
+                                const size_t num_rows) const = 0;
+
     /// Serializes state (to transmit it over the network, for example).
     virtual void serialize(ConstAggregateDataPtr __restrict place, BufferWritable& buf) const = 0;
 
@@ -363,6 +368,16 @@ public:
             }
         }
     }
+
+    void merge_vec_rows(const AggregateDataPtr* places, size_t offset, ConstAggregateDataPtr rhs,
+                        Arena* arena, const uint32_t* rows, const size_t num_rows) const override {
+        const auto size_of_data = static_cast<const Derived*>(this)->size_of_data();
+        for (size_t i = 0; i != num_rows; ++i) {
+            const auto row = rows[i];
+            static_cast<const Derived*>(this)->merge(places[row] + offset,
+                                                     rhs + size_of_data * row, arena);
+        }
+    }
 };
 
 /// Implements several methods for manipulation with data. T - type of structure with data for aggregation.
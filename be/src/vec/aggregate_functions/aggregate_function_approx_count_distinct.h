@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "olap/hll.h"
 #include "udf/udf.h"
 #include "vec/aggregate_functions/aggregate_function.h"
@@ -37,6 +39,10 @@ struct AggregateFunctionApproxCountDistinctData {
         }
     }
 
+    void add_batch(const std::vector<uint64_t>& hash_values) {
+        hll_data.update_batch(hash_values.data(), hash_values.size());
+    }
+
     void merge(const AggregateFunctionApproxCountDistinctData& rhs) {
         hll_data.merge(rhs.hll_data);
     }
@@ -78,17 +84,20 @@ public:
 
     void add(AggregateDataPtr __restrict place, const IColumn** columns, size_t row_num,
              Arena*) const override {
-        if constexpr (IsFixLenColumnType<ColumnDataType>::value) {
-            auto column = static_cast<const ColumnDataType*>(columns[0]);
-            auto value = column->get_element(row_num);
-            this->data(place).add(
-                    HashUtil::murmur_hash64A((char*)&value, sizeof(value), HashUtil::MURMUR_SEED));
-        } else {
-            auto value = static_cast<const ColumnDataType*>(columns[0])->get_data_at(row_num);
-            uint64_t hash_value =
-                    HashUtil::murmur_hash64A(value.data, value.size, HashUtil::MURMUR_SEED);
-            this->data(place).add(hash_value);
+        this->data(place).add(hash(columns, row_num));
+    }
+
+    void add_batch_single_place(size_t batch_size, AggregateDataPtr place, const IColumn** columns,
+                                Arena*) const override {
+        std::vector<uint64_t> hash_values;
+        hash_values.reserve(batch_size);
+        for (size_t i = 0; i < batch_size; ++i) {
+            uint64_t hash_value = hash(columns, i);
+            if (hash_value != 0) {
+                hash_values.push_back(hash_value);
+            }
         }
+        this->data(place).add_batch(hash_values);
     }
 
     void reset(AggregateDataPtr place) const override { this->data(place).reset(); }
@@ -111,6 +120,18 @@ public:
         auto& column = static_cast<ColumnInt64&>(to);
         column.get_data().push_back(this->data(place).get());
     }
+
+private:
+    static uint64_t hash(const IColumn** columns, size_t row_num) {
+        if constexpr (IsFixLenColumnType<ColumnDataType>::value) {
+            auto column = static_cast<const ColumnDataType*>(columns[0]);
+            auto value = column->get_element(row_num);
+            return HashUtil::murmur_hash64A((char*)&value, sizeof(value), HashUtil::MURMUR_SEED);
+        } else {
+            auto value = static_cast<const ColumnDataType*>(columns[0])->get_data_at(row_num);
+            return HashUtil::murmur_hash64A(value.data, value.size, HashUtil::MURMUR_SEED);
+        }
+    }
 };
 
 } // namespace doris::vectorized
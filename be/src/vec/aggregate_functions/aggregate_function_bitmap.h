@@ -23,6 +23,7 @@
 #include "vec/aggregate_functions/aggregate_function.h"
 #include "vec/columns/column_complex.h"
 #include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
 #include "vec/common/assert_cast.h"
 #include "vec/data_types/data_type_bitmap.h"
 #include "vec/data_types/data_type_nullable.h"
@@ -36,6 +37,11 @@ struct AggregateFunctionBitmapUnionOp {
 
     template <typename T>
     static void add(BitmapValue& res, const T& data, bool& is_first) {
+        if (UNLIKELY(is_first)) {
+            // the value may be left by the data before a reset
+            res = BitmapValue();
+            is_first = false;
+        }
         res.add(data);
     }
 
@@ -49,6 +55,10 @@ struct AggregateFunctionBitmapUnionOp {
     }
 
     static void add_batch(BitmapValue& res, std::vector<const BitmapValue*>& data, bool& is_first) {
+        if (UNLIKELY(is_first)) {
+            res = BitmapValue();
+            is_first = false;
+        }
         res.fastunion(data);
     }
 
@@ -124,6 +134,19 @@ struct AggregateFunctionBitmapData {
 
     void read(BufferReadable& buf) { DataTypeBitMap::deserialize_as_stream(value, buf); }
 
+    // Merges the serialized states of `column` by one union of all of them.
+    void read_and_merge_batch(const ColumnString& column) {
+        const size_t num_rows = column.size();
+        std::vector<BitmapValue> values(num_rows);
+        std::vector<const BitmapValue*> value_ptrs(num_rows);
+        for (size_t i = 0; i != num_rows; ++i) {
+            VectorBufferReader buffer_reader(column.get_data_at(i));
+            DataTypeBitMap::deserialize_as_stream(values[i], buffer_reader);
+            value_ptrs[i] = &values[i];
+        }
+        add_batch(value_ptrs);
+    }
+
     void reset() { is_first = true; }
 
     BitmapValue& get() { return value; }
@@ -164,12 +187,40 @@ public:
         }
     }
 
+    void add_batch_single_place(size_t batch_size, AggregateDataPtr place, const IColumn** columns,
+                                Arena* arena) const override {
+        if constexpr (std::is_same_v<Op, AggregateFunctionBitmapUnionOp>) {
+            const auto& column = static_cast<const ColVecType&>(*columns[0]);
+            std::vector<const BitmapValue*> values(batch_size);
+            for (size_t i = 0; i != batch_size; ++i) {
+                values[i] = &(column.get_data()[i]);
+            }
+            this->data(place).add_batch(values);
+        } else {
+            IAggregateFunctionDataHelper<
+                    AggregateFunctionBitmapData<Op>,
+                    AggregateFunctionBitmapOp<Op>>::add_batch_single_place(batch_size, place,
+                                                                           columns, arena);
+        }
+    }
+
     void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs,
                Arena*) const override {
         this->data(place).merge(
                 const_cast<AggregateFunctionBitmapData<Op>&>(this->data(rhs)).get());
     }
 
+    void deserialize_and_merge_from_column(AggregateDataPtr __restrict place, const IColumn& column,
+                                           Arena* arena) const override {
+        if constexpr (std::is_same_v<Op, AggregateFunctionBitmapUnionOp>) {
+            this->data(place).read_and_merge_batch(assert_cast<const ColumnString&>(column));
+        } else {
+            IAggregateFunctionDataHelper<AggregateFunctionBitmapData<Op>,
+                                         AggregateFunctionBitmapOp<Op>>::
+                    deserialize_and_merge_from_column(place, column, arena);
+        }
+    }
+
     void serialize(ConstAggregateDataPtr __restrict place, BufferWritable& buf) const override {
         this->data(place).write(buf);
     }
@@ -249,6 +300,11 @@ public:
         this->data(place).merge(const_cast<AggFunctionData&>(this->data(rhs)).get());
     }
 
+    void deserialize_and_merge_from_column(AggregateDataPtr __restrict place, const IColumn& column,
+                                           Arena*) const override {
+        this->data(place).read_and_merge_batch(assert_cast<const ColumnString&>(column));
+    }
+
     void serialize(ConstAggregateDataPtr __restrict place, BufferWritable& buf) const override {
         this->data(place).write(buf);
     }
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "util/counts.h"
+#include "util/ddsketch.h"
 #include "util/tdigest.h"
 #include "vec/aggregate_functions/aggregate_function.h"
 #include "vec/columns/column_array.h"
@@ -34,8 +35,20 @@ struct PercentileApproxState {
     PercentileApproxState() = default;
     ~PercentileApproxState() = default;
 
+    // A compression in (0, 1) is the relative accuracy of a DDSketch, which merges and serializes
+    // much cheaper than a TDigest.
+    static bool is_sketch_compression(double compression) {
+        return compression > 0 && compression < 1;
+    }
+
     void init(double compression = 10000) {
         if (!init_flag) {
+            if (is_sketch_compression(compression)) {
+                sketch.reset(new DDSketch(compression));
+                compressions = sketch->relative_accuracy();
+                init_flag = true;
+                return;
+            }
             //https://doris.apache.org/zh-CN/sql-reference/sql-functions/aggregate-functions/percentile_approx.html#description
             //The compression parameter setting range is [2048, 10000].
             //If the value of compression parameter is not specified set, or is outside the range of [2048, 10000],
@@ -56,11 +69,18 @@ struct PercentileApproxState {
         }
 
         write_binary(target_quantile, buf);
+        // the kind of the sketch is told by the compression
         write_binary(compressions, buf);
-        uint32_t serialize_size = digest->serialized_size();
-        std::string result(serialize_size, '0');
-        DCHECK(digest.get() != nullptr);
-        digest->serialize((uint8_t*)result.c_str());
+        std::string result;
+        if (sketch) {
+            result.resize(sketch->serialized_size());
+            sketch->serialize((uint8_t*)result.data());
+        } else {
+            uint32_t serialize_size = digest->serialized_size();
+            result.resize(serialize_size, '0');
+            DCHECK(digest.get() != nullptr);
+            digest->serialize((uint8_t*)result.c_str());
+        }
 
         write_binary(result, buf);
     }
@@ -75,13 +95,21 @@ struct PercentileApproxState {
         read_binary(compressions, buf);
         std::string str;
         read_binary(str, buf);
-        digest.reset(new TDigest(compressions));
-        digest->unserialize((uint8_t*)str.c_str());
+        if (is_sketch_compression(compressions)) {
+            digest.reset();
+            sketch.reset(new DDSketch(compressions));
+            bool res = sketch->unserialize((const uint8_t*)str.data(), str.size());
+            DCHECK(res) << "invalid serialized DDSketch";
+        } else {
+            sketch.reset();
+            digest.reset(new TDigest(compressions));
+            digest->unserialize((uint8_t*)str.c_str());
+        }
     }
 
     double get() const {
         if (init_flag) {
-            return digest->quantile(target_quantile);
+            return sketch ? sketch->quantile(target_quantile) : digest->quantile(target_quantile);
         } else {
             return std::nan("");
         }
@@ -91,32 +119,66 @@ struct PercentileApproxState {
         if (!rhs.init_flag) {
             return;
         }
-        if (init_flag) {
-            DCHECK(digest.get() != nullptr);
-            digest->merge(rhs.digest.get());
-        } else {
-            digest.reset(new TDigest(compressions));
-            digest->merge(rhs.digest.get());
+        if (!init_flag) {
+            compressions = rhs.compressions;
+            if (rhs.sketch) {
+                sketch.reset(new DDSketch(compressions));
+            } else {
+                digest.reset(new TDigest(compressions));
+            }
             init_flag = true;
         }
+        if (sketch && rhs.sketch) {
+            sketch->merge(*rhs.sketch);
+        } else {
+            // the states of different kinds, e.g. of different compression arguments, are
+            // merged into a TDigest
+            if (sketch) {
+                to_digest(rhs.compressions);
+            }
+            DCHECK(digest.get() != nullptr);
+            if (rhs.sketch) {
+                rhs.sketch->for_each([this](double value, uint64_t count) {
+                    digest->add(value, static_cast<double>(count));
+                });
+            } else {
+                digest->merge(rhs.digest.get());
+            }
+        }
         if (target_quantile == PercentileApproxState::INIT_QUANTILE) {
             target_quantile = rhs.target_quantile;
         }
     }
 
     void add(double source, double quantile) {
-        digest->add(source);
+        if (sketch) {
+            sketch->add(source);
+        } else {
+            digest->add(source);
+        }
         target_quantile = quantile;
     }
 
     void reset() {
         target_quantile = INIT_QUANTILE;
         init_flag = false;
+        sketch.reset();
         digest.reset(new TDigest(compressions));
     }
 
+    // Replaces the DDSketch by a TDigest of `compression` with the buckets of the sketch.
+    void to_digest(double compression) {
+        digest.reset(new TDigest(compression));
+        sketch->for_each([this](double value, uint64_t count) {
+            digest->add(value, static_cast<double>(count));
+        });
+        sketch.reset();
+        compressions = compression;
+    }
+
     bool init_flag = false;
     std::unique_ptr<TDigest> digest = nullptr;
+    std::unique_ptr<DDSketch> sketch = nullptr;
     double target_quantile = INIT_QUANTILE;
     double compressions = 10000;
 };
@@ -22,9 +22,17 @@
 
 #include <parallel_hashmap/phmap.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
 #include <type_traits>
 
 #include "gutil/hash/city.h"
+#include "runtime/exec_env.h"
+#include "runtime/thread_context.h"
+#include "util/threadpool.h"
 #include "vec/aggregate_functions/aggregate_function.h"
 #include "vec/columns/column_decimal.h"
 #include "vec/common/aggregation_common.h"
@@ -48,6 +56,14 @@ struct AggregateFunctionUniqExactData {
     using Hash = std::conditional_t<is_string_key, UInt128TrivialHash, HashCRC32<Key>>;
 
     using Set = phmap::flat_hash_set<Key, Hash>;
+    // The keys are partitioned into 2^TWO_LEVEL_BITS submaps by the bits of their hash values,
+    // so two sets are merged submap by submap, and the submaps in parallel.
+    static constexpr size_t TWO_LEVEL_BITS = 4;
+    using TwoLevelSet = phmap::parallel_flat_hash_set<Key, Hash, std::equal_to<Key>,
+                                                      std::allocator<Key>, TWO_LEVEL_BITS>;
+    // A set becomes two level beyond this, the small sets of the many groups of a query stay
+    // single level, which costs a fraction of the memory of the empty submaps.
+    static constexpr size_t TWO_LEVEL_THRESHOLD = 1 << 16;
 
     static UInt128 ALWAYS_INLINE get_key(const StringRef& value) {
         UInt128 key;
@@ -57,7 +73,148 @@ struct AggregateFunctionUniqExactData {
         return key;
     }
 
+    bool is_two_level() const { return two_level_set != nullptr; }
+
+    size_t size() const { return is_two_level() ? two_level_set->size() : set.size(); }
+
+    void ALWAYS_INLINE insert(const Key& key) {
+        if (is_two_level()) {
+            two_level_set->insert(key);
+        } else {
+            set.insert(key);
+            if (UNLIKELY(set.size() > TWO_LEVEL_THRESHOLD)) {
+                convert_to_two_level();
+            }
+        }
+    }
+
+    void ALWAYS_INLINE prefetch(const Key& key) const {
+        if (is_two_level()) {
+            two_level_set->prefetch(key);
+        } else {
+            set.prefetch(key);
+        }
+    }
+
+    void reserve(size_t size) {
+        if (size > TWO_LEVEL_THRESHOLD) {
+            convert_to_two_level();
+        }
+        if (is_two_level()) {
+            two_level_set->reserve(size);
+        } else {
+            set.reserve(size);
+        }
+    }
+
+    template <typename Func>
+    void for_each(Func&& func) const {
+        if (is_two_level()) {
+            for (const auto& key : *two_level_set) {
+                func(key);
+            }
+        } else {
+            for (const auto& key : set) {
+                func(key);
+            }
+        }
+    }
+
+    void convert_to_two_level() {
+        if (is_two_level()) {
+            return;
+        }
+        two_level_set = std::make_unique<TwoLevelSet>();
+        two_level_set->reserve(set.size());
+        for (const auto& key : set) {
+            two_level_set->insert(key);
+        }
+        Set().swap(set);
+    }
+
+    // Merges the submaps of two two level sets in parallel on the agg merge thread pool, if
+    // there are enough keys to merge.
+    void merge(const AggregateFunctionUniqExactData& rhs) {
+        if (rhs.size() == 0) {
+            return;
+        }
+        if (!rhs.is_two_level()) {
+            reserve(size() + rhs.size());
+            rhs.for_each([&](const Key& key) { insert(key); });
+            return;
+        }
+        convert_to_two_level();
+
+        auto merge_submap = [&](size_t idx) {
+            rhs.two_level_set->with_submap(idx, [&](const auto& rhs_submap) {
+                two_level_set->with_submap_m(idx, [&](auto& submap) {
+                    submap.reserve(submap.size() + rhs_submap.size());
+                    for (const auto& key : rhs_submap) {
+                        submap.insert(key);
+                    }
+                });
+            });
+        };
+        auto* thread_pool = ExecEnv::GetInstance()->agg_merge_thread_pool();
+        if (thread_pool == nullptr || rhs.size() < PARALLEL_MERGE_MIN_KEYS) {
+            for (size_t idx = 0; idx < TwoLevelSet::subcnt(); ++idx) {
+                merge_submap(idx);
+            }
+            return;
+        }
+        // The merging thread and the helpers take the submaps one by one, so the merge never
+        // waits for a helper which is still queued, e.g. when it runs on the pool itself.
+        auto state = std::make_shared<ParallelMergeState>();
+        auto run_submaps = [state, &merge_submap]() {
+            for (size_t idx = state->next++; idx < TwoLevelSet::subcnt(); idx = state->next++) {
+                std::exception_ptr error;
+                try {
+                    merge_submap(idx);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+                std::lock_guard<std::mutex> l(state->lock);
+                if (error) {
+                    state->error = error;
+                }
+                if (++state->done == TwoLevelSet::subcnt()) {
+                    state->finished.notify_all();
+                }
+            }
+        };
+        auto mem_tracker = thread_context()->thread_mem_tracker_mgr->limiter_mem_tracker();
+        for (size_t i = 0; i + 1 < TwoLevelSet::subcnt(); ++i) {
+            if (!thread_pool
+                         ->submit_func([run_submaps, mem_tracker]() {
+                             SCOPED_ATTACH_TASK(mem_tracker);
+                             run_submaps();
+                         })
+                         .ok()) {
+                break;
+            }
+        }
+        run_submaps();
+
+        std::unique_lock<std::mutex> l(state->lock);
+        state->finished.wait(l, [&]() { return state->done == TwoLevelSet::subcnt(); });
+        if (state->error) {
+            std::rethrow_exception(state->error);
+        }
+    }
+
+    // the keys of a merge from which the submaps are merged in parallel
+    static constexpr size_t PARALLEL_MERGE_MIN_KEYS = 1 << 20;
+
+    struct ParallelMergeState {
+        std::atomic<size_t> next {0};
+        std::mutex lock;
+        std::condition_variable finished;
+        size_t done = 0;
+        std::exception_ptr error;
+    };
+
     Set set;
+    std::unique_ptr<TwoLevelSet> two_level_set;
 
     static String get_name() { return "uniqExact"; }
 };
@@ -72,11 +229,11 @@ struct OneAdder {
     static void ALWAYS_INLINE add(Data& data, const IColumn& column, size_t row_num) {
         if constexpr (std::is_same_v<T, String>) {
             StringRef value = column.get_data_at(row_num);
-            data.set.insert(Data::get_key(value));
+            data.insert(Data::get_key(value));
         } else if constexpr (IsDecimalNumber<T>) {
-            data.set.insert(assert_cast<const ColumnDecimal<T>&>(column).get_data()[row_num]);
+            data.insert(assert_cast<const ColumnDecimal<T>&>(column).get_data()[row_num]);
         } else {
-            data.set.insert(assert_cast<const ColumnVector<T>&>(column).get_data()[row_num]);
+            data.insert(assert_cast<const ColumnVector<T>&>(column).get_data()[row_num]);
         }
     }
 };
@@ -122,10 +279,10 @@ public:
         std::vector<KeyType> keys_container;
         const KeyType* keys = get_keys(keys_container, *columns[0], batch_size);
 
-        std::vector<typename Data::Set*> array_of_data_set(batch_size);
+        std::vector<Data*> array_of_data_set(batch_size);
 
         for (size_t i = 0; i != batch_size; ++i) {
-            array_of_data_set[i] = &(this->data(places[i] + place_offset).set);
+            array_of_data_set[i] = &(this->data(places[i] + place_offset));
         }
 
         for (size_t i = 0; i != batch_size; ++i) {
@@ -140,22 +297,14 @@ public:
 
     void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs,
                Arena*) const override {
-        auto& rhs_set = this->data(rhs).set;
-        if (rhs_set.size() == 0) return;
-
-        auto& set = this->data(place).set;
-        set.rehash(set.size() + rhs_set.size());
-
-        for (auto elem : rhs_set) {
-            set.insert(elem);
-        }
+        this->data(place).merge(this->data(rhs));
     }
 
     void add_batch_single_place(size_t batch_size, AggregateDataPtr place, const IColumn** columns,
                                 Arena* arena) const override {
         std::vector<KeyType> keys_container;
         const KeyType* keys = get_keys(keys_container, *columns[0], batch_size);
-        auto& set = this->data(place).set;
+        auto& set = this->data(place);
 
         for (size_t i = 0; i != batch_size; ++i) {
             if (i + HASH_MAP_PREFETCH_DIST < batch_size) {
@@ -166,20 +315,19 @@ public:
     }
 
     void serialize(ConstAggregateDataPtr __restrict place, BufferWritable& buf) const override {
-        auto& set = this->data(place).set;
+        // the keys of a two level set are written submap by submap
+        auto& set = this->data(place);
         write_var_uint(set.size(), buf);
-        for (const auto& elem : set) {
-            write_pod_binary(elem, buf);
-        }
+        set.for_each([&](const KeyType& elem) { write_pod_binary(elem, buf); });
     }
 
     void deserialize_and_merge(AggregateDataPtr __restrict place, BufferReadable& buf,
                                Arena* arena) const override {
-        auto& set = this->data(place).set;
+        auto& set = this->data(place);
         UInt64 size;
         read_var_uint(size, buf);
 
-        set.rehash(size + set.size());
+        set.reserve(size + set.size());
 
         for (size_t i = 0; i < size; ++i) {
             KeyType ref;
@@ -194,7 +342,7 @@ public:
     }
 
     void insert_result_into(ConstAggregateDataPtr __restrict place, IColumn& to) const override {
-        assert_cast<ColumnInt64&>(to).get_data().push_back(this->data(place).set.size());
+        assert_cast<ColumnInt64&>(to).get_data().push_back(this->data(place).size());
     }
 };
 
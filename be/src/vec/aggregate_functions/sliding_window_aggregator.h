@@ -0,0 +1,154 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+
+#include "common/logging.h"
+#include "vec/aggregate_functions/aggregate_function.h"
+#include "vec/common/arena.h"
+
+namespace doris::vectorized {
+
+// Evaluates an aggregate function over a window which slides forward over rows, i.e. both ends
+// of the window never move backward, with amortized O(1) add and merge calls per row instead of
+// O(window size). It only needs add and merge of the function, so it works for any function
+// whose merge is correct, without an inverse of add.
+//
+// It is the two stacks algorithm: the window [start, end) is split into the front [start, mid)
+// and the back [mid, end). The state of each suffix of the front and the state of the whole back
+// are kept, so the state of the window is their merge. When a row is removed from an empty
+// front, the back becomes the front and the states of its suffixes are computed.
+class SlidingWindowAggregator {
+public:
+    SlidingWindowAggregator(const IAggregateFunction* function, Arena* arena)
+            : _function(function),
+              _arena(arena),
+              _align(function->align_of_data()),
+              _stride((function->size_of_data() + _align - 1) / _align * _align) {
+        _back_buffer.reset(new char[_stride + _align]);
+        _back_state = _aligned(_back_buffer.get());
+        _function->create(_back_state);
+    }
+
+    ~SlidingWindowAggregator() {
+        _destroy_front(_start);
+        _function->destroy(_back_state);
+    }
+
+    SlidingWindowAggregator(const SlidingWindowAggregator&) = delete;
+    SlidingWindowAggregator& operator=(const SlidingWindowAggregator&) = delete;
+
+    // Make the window empty at row pos.
+    void reset(int64_t pos) {
+        _destroy_front(_start);
+        _function->reset(_back_state);
+        _start = _mid = _end = pos;
+    }
+
+    // Move the window to [start, end). Neither start nor end can be less than the last one.
+    void slide(int64_t start, int64_t end, const IColumn** columns) {
+        DCHECK_GE(start, _start);
+        DCHECK_GE(end, _end);
+        if (start >= _end) {
+            // none of the rows in the window is kept
+            reset(start);
+        }
+        for (; _end < end; ++_end) {
+            _function->add(_back_state, columns, _end, _arena);
+        }
+        while (_start < start) {
+            if (_start == _mid) {
+                _flip(columns);
+            }
+            if (!_function->has_trivial_destructor()) {
+                _function->destroy(_front_state(_start));
+            }
+            ++_start;
+        }
+    }
+
+    // Merge the state of the window into place.
+    void merge_to(AggregateDataPtr place) const {
+        if (_start < _mid) {
+            _function->merge(place, _front_state(_start), _arena);
+        }
+        _function->merge(place, _back_state, _arena);
+    }
+
+private:
+    AggregateDataPtr _aligned(char* ptr) const {
+        auto addr = reinterpret_cast<uintptr_t>(ptr);
+        return reinterpret_cast<AggregateDataPtr>((addr + _align - 1) / _align * _align);
+    }
+
+    AggregateDataPtr _front_state(int64_t row) const {
+        return _front_states + (row - _front_base) * _stride;
+    }
+
+    void _destroy_front(int64_t from) {
+        if (_function->has_trivial_destructor()) {
+            return;
+        }
+        for (int64_t row = from; row < _mid; ++row) {
+            _function->destroy(_front_state(row));
+        }
+    }
+
+    // The front is empty, move the back to the front.
+    void _flip(const IColumn** columns) {
+        DCHECK_EQ(_start, _mid);
+        DCHECK_LT(_mid, _end);
+        size_t rows = _end - _mid;
+        if (rows > _front_capacity) {
+            _front_buffer.reset(new char[rows * _stride + _align]);
+            _front_states = _aligned(_front_buffer.get());
+            _front_capacity = rows;
+        }
+        _front_base = _mid;
+        for (int64_t row = _end - 1; row >= _mid; --row) {
+            auto* state = _front_state(row);
+            _function->create(state);
+            if (row + 1 < _end) {
+                _function->merge(state, _front_state(row + 1), _arena);
+            }
+            _function->add(state, columns, row, _arena);
+        }
+        _mid = _end;
+        _function->reset(_back_state);
+    }
+
+    const IAggregateFunction* _function;
+    Arena* _arena;
+    const size_t _align;
+    const size_t _stride;
+
+    std::unique_ptr<char[]> _back_buffer;
+    AggregateDataPtr _back_state;
+    std::unique_ptr<char[]> _front_buffer;
+    // states of the suffixes of the front, the row of _front_states[0] is _front_base
+    AggregateDataPtr _front_states = nullptr;
+    size_t _front_capacity = 0;
+    int64_t _front_base = 0;
+
+    int64_t _start = 0;
+    int64_t _mid = 0;
+    int64_t _end = 0;
+};
+
+} // namespace doris::vectorized
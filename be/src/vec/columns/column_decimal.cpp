@@ -180,6 +180,22 @@ void ColumnDecimal<T>::update_hashes_with_value(uint64_t* __restrict hashes,
 template <typename T>
 void ColumnDecimal<T>::get_permutation(bool reverse, size_t limit, int,
                                        IColumn::Permutation& res) const {
+    if constexpr (is_radix_sortable_v<T>) {
+        size_t s = data.size();
+        if ((limit == 0 || limit >= s) && s >= RADIX_SORT_MIN_ROWS &&
+            s <= std::numeric_limits<UInt32>::max()) {
+            PermutationForColumn<T> pairs(s);
+            for (UInt32 i = 0; i < s; ++i) {
+                pairs[i] = {data[i], i};
+            }
+            radix_sort_permutation(pairs.data(), s, reverse);
+            res.resize(s);
+            for (size_t i = 0; i < s; ++i) {
+                res[i] = pairs[i].row_id;
+            }
+            return;
+        }
+    }
 #if 1 /// TODO: perf test
     if (data.size() <= std::numeric_limits<UInt32>::max()) {
         PaddedPODArray<UInt32> tmp_res;
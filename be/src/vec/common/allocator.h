@@ -29,6 +29,8 @@
 #include "common/status.h"
 #include "runtime/memory/chunk.h"
 #include "runtime/memory/chunk_allocator.h"
+#include "runtime/memory/huge_page_pool.h"
+#include "runtime/memory/memory_region.h"
 #include "runtime/thread_context.h"
 
 #ifdef NDEBUG
@@ -127,8 +129,9 @@ static constexpr size_t MALLOC_MIN_ALIGNMENT = 8;
   * - the possibility of zeroing memory (used in hash tables);
   * - random hint address for mmap
   * - mmap_threshold for using mmap less or more
+  * - huge pages for the large allocations if use_huge_pages, see HugePagePool
   */
-template <bool clear_memory_, bool mmap_populate>
+template <bool clear_memory_, bool mmap_populate, bool use_huge_pages>
 class Allocator {
 public:
     void sys_memory_check(size_t size) {
@@ -167,12 +170,69 @@ public:
         }
     }
 
+    /// Whether the allocation is backed by huge pages, the huge page buffers are allocated and
+    /// freed by HugePagePool only.
+    static bool is_huge_page_alloc(size_t size) {
+        if constexpr (use_huge_pages) {
+            return doris::config::madvise_huge_pages &&
+                   size >= doris::HugePagePool::HUGE_PAGE_SIZE &&
+                   size >= doris::config::huge_page_alloc_min_bytes;
+        } else {
+            return false;
+        }
+    }
+
+    /// The memory region of the query attached to the thread, see MemoryRegion.
+    static doris::MemoryRegion* memory_region(size_t size) {
+        if (!doris::config::enable_query_memory_region || !doris::thread_context_ptr.init ||
+            !doris::MemoryRegion::is_cacheable(size) || is_huge_page_alloc(size)) {
+            return nullptr;
+        }
+        return doris::thread_context()->memory_region.get();
+    }
+
     /// Allocate memory range.
     void* alloc(size_t size, size_t alignment = 0) {
+        // The kept buffers are aligned to MALLOC_MIN_ALIGNMENT at least.
+        if (alignment <= MALLOC_MIN_ALIGNMENT) {
+            if (auto* region = memory_region(size)) {
+                if (void* buf = region->allocate(size)) {
+                    if constexpr (clear_memory) memset(buf, 0, size);
+                    return buf;
+                }
+            }
+        }
         sys_memory_check(size);
         void* buf;
 
-        if (size >= MMAP_THRESHOLD) {
+        if (is_huge_page_alloc(size)) {
+            if (alignment > doris::HugePagePool::HUGE_PAGE_SIZE)
+                throw doris::Exception(
+                        doris::ErrorCode::INVALID_ARGUMENT,
+                        "Too large alignment {}: more than huge page size when allocating {}.",
+                        alignment, size);
+
+            if (!TRY_CONSUME_THREAD_MEM_TRACKER(size)) {
+                RETURN_BAD_ALLOC_IF_PRE_CATCH(
+                        fmt::format("Allocator Pre Catch: Cannot allocate huge pages {}.", size));
+                CONSUME_THREAD_MEM_TRACKER(size);
+            }
+            bool zeroed = false;
+            buf = doris::HugePagePool::instance()->allocate(size, &zeroed);
+            if (nullptr == buf) {
+                RELEASE_THREAD_MEM_TRACKER(size);
+                RETURN_BAD_ALLOC(fmt::format("Allocator: Cannot allocate huge pages {}.", size));
+            }
+            // The reused buffers should be cleared, and the fresh ones are pre-faulted by
+            // writing them instead of MAP_POPULATE, which is before madvise and faults in the
+            // small pages.
+            if constexpr (clear_memory) {
+                if (!zeroed) memset(buf, 0, size);
+            }
+            if constexpr (mmap_populate) {
+                if (zeroed) memset(buf, 0, size);
+            }
+        } else if (size >= MMAP_THRESHOLD) {
             if (alignment > MMAP_MIN_ALIGNMENT)
                 throw doris::Exception(
                         doris::ErrorCode::INVALID_ARGUMENT,
@@ -227,7 +287,15 @@ public:
 
     /// Free memory range.
     void free(void* buf, size_t size) {
-        if (size >= MMAP_THRESHOLD) {
+        if (auto* region = memory_region(size)) {
+            if (region->free(buf, size)) {
+                return;
+            }
+        }
+        if (is_huge_page_alloc(size)) {
+            doris::HugePagePool::instance()->free(buf, size);
+            RELEASE_THREAD_MEM_TRACKER(size);
+        } else if (size >= MMAP_THRESHOLD) {
             if (0 != munmap(buf, size)) {
                 auto err = fmt::format("Allocator: Cannot munmap {}.", size);
                 LOG(ERROR) << err;
@@ -268,7 +336,8 @@ public:
             if constexpr (clear_memory)
                 if (new_size > old_size)
                     memset(reinterpret_cast<char*>(buf) + old_size, 0, new_size - old_size);
-        } else if (old_size >= MMAP_THRESHOLD && new_size >= MMAP_THRESHOLD) {
+        } else if (old_size >= MMAP_THRESHOLD && new_size >= MMAP_THRESHOLD &&
+                   !is_huge_page_alloc(old_size) && !is_huge_page_alloc(new_size)) {
             sys_memory_check(new_size);
             /// Resize mmap'd memory region.
             if (!TRY_CONSUME_THREAD_MEM_TRACKER(new_size - old_size)) {
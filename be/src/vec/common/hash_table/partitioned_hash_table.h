@@ -209,6 +209,29 @@ public:
     bool has_null_key_data() const { return false; }
     char* get_null_key_data() { return nullptr; }
 
+    static constexpr size_t num_sub_tables() { return NUM_LEVEL1_SUB_TABLES; }
+
+    /// NOTE Bad for hash tables with more than 2^32 cells.
+    static size_t get_sub_table_from_hash(size_t hash_value) {
+        return (hash_value >> (32 - BITS_FOR_SUB_TABLE)) & MAX_SUB_TABLE;
+    }
+
+    bool is_partitioned() const { return _is_partitioned; }
+
+    /// Convert to the sub tables now, e.g. to fill them from different threads: the keys with
+    /// different sub table index never touch the same sub table.
+    void partition() {
+        if (!_is_partitioned) {
+            convert_to_partitioned();
+        }
+    }
+
+    /// Only valid after the table is partitioned.
+    Impl& get_sub_table(size_t sub_table_idx) {
+        DCHECK(_is_partitioned);
+        return level1_sub_tables[sub_table_idx];
+    }
+
 protected:
     typename Impl::iterator begin_of_next_non_empty_sub_table_idx(size_t& sub_table_idx) {
         while (sub_table_idx != NUM_LEVEL1_SUB_TABLES && level1_sub_tables[sub_table_idx].empty())
@@ -587,9 +610,4 @@ private:
         _is_partitioned = true;
         level0_sub_table.clear_and_shrink();
     }
-
-    /// NOTE Bad for hash tables with more than 2^32 cells.
-    static size_t get_sub_table_from_hash(size_t hash_value) {
-        return (hash_value >> (32 - BITS_FOR_SUB_TABLE)) & MAX_SUB_TABLE;
-    }
 };
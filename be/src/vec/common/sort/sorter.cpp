@@ -49,28 +49,46 @@ Status MergeSorterState::add_sorted_block(Block& block) {
 
     auto bytes_used = data_size();
     auto total_bytes_used = bytes_used + block.bytes();
+    if (!is_spilled_ && revocable_memory_ && revocable_memory_->revoke_requested()) {
+        // Each sorted block in memory is a sorted run of its own, so they are spilled as they
+        // are and merged with the others later.
+        is_spilled_ = true;
+        for (const auto& sorted_block : sorted_blocks_) {
+            RETURN_IF_ERROR(_spill_sorted_block(sorted_block));
+        }
+        sorted_blocks_.clear();
+        revocable_memory_->revoked();
+    }
     if (is_spilled_ || (external_sort_bytes_threshold_ > 0 &&
                         total_bytes_used >= external_sort_bytes_threshold_)) {
         is_spilled_ = true;
-        BlockSpillWriterUPtr spill_block_writer;
-        RETURN_IF_ERROR(ExecEnv::GetInstance()->block_spill_mgr()->get_writer(
-                spill_block_batch_size_, spill_block_writer, block_spill_profile_));
-
-        RETURN_IF_ERROR(spill_block_writer->write(block));
-        spilled_sorted_block_streams_.emplace_back(spill_block_writer->get_id());
-
-        COUNTER_UPDATE(spilled_block_count_, 1);
-        COUNTER_UPDATE(spilled_original_block_size_, spill_block_writer->get_written_bytes());
-        RETURN_IF_ERROR(spill_block_writer->close());
-
-        if (init_merge_sorted_block_) {
-            init_merge_sorted_block_ = false;
-            merge_sorted_block_ = block.clone_empty();
-        }
+        RETURN_IF_ERROR(_spill_sorted_block(block));
     } else {
         sorted_blocks_.emplace_back(std::move(block));
     }
     num_rows_ += rows;
+    if (revocable_memory_ && !is_spilled_) {
+        revocable_memory_->set_bytes(data_size());
+    }
+    return Status::OK();
+}
+
+Status MergeSorterState::_spill_sorted_block(const Block& block) {
+    BlockSpillWriterUPtr spill_block_writer;
+    RETURN_IF_ERROR(ExecEnv::GetInstance()->block_spill_mgr()->get_writer(
+            spill_block_batch_size_, spill_block_writer, block_spill_profile_));
+
+    RETURN_IF_ERROR(spill_block_writer->write(block));
+    spilled_sorted_block_streams_.emplace_back(spill_block_writer->get_id());
+
+    COUNTER_UPDATE(spilled_block_count_, 1);
+    COUNTER_UPDATE(spilled_original_block_size_, spill_block_writer->get_written_bytes());
+    RETURN_IF_ERROR(spill_block_writer->close());
+
+    if (init_merge_sorted_block_) {
+        init_merge_sorted_block_ = false;
+        merge_sorted_block_ = block.clone_empty();
+    }
     return Status::OK();
 }
 
@@ -22,6 +22,7 @@
 #include "common/status.h"
 #include "vec/common/sort/vsort_exec_exprs.h"
 #include "vec/core/block.h"
+#include "runtime/block_spill_manager.h"
 #include "vec/core/block_spill_reader.h"
 #include "vec/core/sort_block.h"
 #include "vec/core/sort_cursor.h"
@@ -51,6 +52,10 @@ public:
         spilled_block_count_ = ADD_COUNTER(block_spill_profile_, "BlockCount", TUnit::UNIT);
         spilled_original_block_size_ =
                 ADD_COUNTER(block_spill_profile_, "BlockBytes", TUnit::BYTES);
+        if (external_sort_bytes_threshold_ > 0) {
+            revocable_memory_ = std::make_unique<RevocableMemory>(
+                    fmt::format("Sorter ({})", profile->name()), state);
+        }
     }
 
     ~MergeSorterState() = default;
@@ -80,6 +85,8 @@ public:
 private:
     int _calc_spill_blocks_to_merge() const;
 
+    Status _spill_sorted_block(const Block& block);
+
     void _build_merge_tree_not_spilled(const SortDescription& sort_description);
 
     Status _merge_sort_read_not_spilled(int batch_size, doris::vectorized::Block* block, bool* eos);
@@ -99,6 +106,8 @@ private:
     size_t avg_row_bytes_ = 0;
     int spill_block_batch_size_ = 0;
     int64_t external_sort_bytes_threshold_;
+    // the sorted blocks in memory, which the memory GC may ask to spill
+    std::unique_ptr<RevocableMemory> revocable_memory_;
 
     bool is_spilled_ = false;
     bool init_merge_sorted_block_ = true;
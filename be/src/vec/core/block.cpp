@@ -25,6 +25,7 @@
 #include <snappy.h>
 
 #include "agent/be_exec_version_manager.h"
+#include "common/config.h"
 #include "common/status.h"
 #include "runtime/descriptors.h"
 #include "udf/udf.h"
@@ -42,6 +43,7 @@
 #include "vec/common/string_ref.h"
 #include "vec/common/typeid_cast.h"
 #include "vec/data_types/data_type_factory.hpp"
+#include "vec/data_types/data_type_nullable.h"
 
 namespace doris::vectorized {
 
@@ -67,9 +69,25 @@ Block::Block(const std::vector<SlotDescriptor*>& slots, size_t block_size,
 }
 
 Block::Block(const PBlock& pblock) {
+    deserialize(pblock);
+}
+
+void Block::deserialize(const PBlock& pblock) {
+    Container reusable_data;
+    reusable_data.swap(data);
+    index_by_name.clear();
+    row_same_bit.clear();
+    _decompress_time_ns = 0;
+    _decompressed_bytes = 0;
+
     int be_exec_version = pblock.has_be_exec_version() ? pblock.be_exec_version() : 0;
     CHECK(BeExecVersionManager::check_be_exec_version(be_exec_version));
 
+    if (pblock.column_values_metas_size() > 0) {
+        _deserialize_columns(pblock, reusable_data);
+        return;
+    }
+
     const char* buf = nullptr;
     std::string compression_scratch;
     if (pblock.compressed()) {
@@ -101,15 +119,63 @@ Block::Block(const PBlock& pblock) {
         buf = pblock.column_values().data();
     }
 
-    for (const auto& pcol_meta : pblock.column_metas()) {
+    for (int i = 0; i < pblock.column_metas_size(); ++i) {
+        const auto& pcol_meta = pblock.column_metas(i);
         DataTypePtr type = DataTypeFactory::instance().create_data_type(pcol_meta);
-        MutableColumnPtr data_column = type->create_column();
+        MutableColumnPtr data_column = _create_column(reusable_data, i, type);
         buf = type->deserialize(buf, data_column.get(), pblock.be_exec_version());
         data.emplace_back(data_column->get_ptr(), type, pcol_meta.name());
     }
     initialize_index_by_name();
 }
 
+MutableColumnPtr Block::_create_column(Container& reusable_data, size_t position,
+                                       const DataTypePtr& type) {
+    if (position < reusable_data.size()) {
+        auto& reusable = reusable_data[position];
+        // The deserialization of variant columns does not expect the existing sub columns.
+        if (reusable.column != nullptr && reusable.column->is_exclusive() &&
+            reusable.type->equals(*type) &&
+            remove_nullable(type)->get_type_id() != TypeIndex::VARIANT) {
+            auto column = (*std::move(reusable.column)).mutate();
+            column->clear();
+            if (column->empty()) {
+                return column;
+            }
+        }
+    }
+    return type->create_column();
+}
+
+void Block::_deserialize_columns(const PBlock& pblock, Container& reusable_data) {
+    DCHECK_EQ(pblock.column_metas_size(), pblock.column_values_metas_size());
+    const char* buf = pblock.column_values().data();
+    std::string compression_scratch;
+    for (int i = 0; i < pblock.column_metas_size(); ++i) {
+        const auto& pcol_meta = pblock.column_metas(i);
+        const auto& values_meta = pblock.column_values_metas(i);
+        const char* column_buf = buf;
+        if (values_meta.compression_type() != segment_v2::CompressionTypePB::NO_COMPRESSION) {
+            SCOPED_RAW_TIMER(&_decompress_time_ns);
+            BlockCompressionCodec* codec;
+            get_block_compression_codec(values_meta.compression_type(), &codec);
+            compression_scratch.resize(values_meta.uncompressed_size());
+            Slice decompressed_slice(compression_scratch);
+            codec->decompress(Slice(buf, values_meta.compressed_size()), &decompressed_slice);
+            DCHECK(values_meta.uncompressed_size() == decompressed_slice.size);
+            _decompressed_bytes += values_meta.uncompressed_size();
+            column_buf = compression_scratch.data();
+        }
+        buf += values_meta.compressed_size();
+
+        DataTypePtr type = DataTypeFactory::instance().create_data_type(pcol_meta);
+        MutableColumnPtr data_column = _create_column(reusable_data, i, type);
+        type->deserialize(column_buf, data_column.get(), pblock.be_exec_version());
+        data.emplace_back(data_column->get_ptr(), type, pcol_meta.name());
+    }
+    initialize_index_by_name();
+}
+
 void Block::initialize_index_by_name() {
     for (size_t i = 0, size = data.size(); i < size; ++i) {
         index_by_name[data[i].name] = i;
@@ -643,7 +709,11 @@ void Block::clear_column_data(int column_size) noexcept {
         }
     }
     for (auto& d : data) {
-        DCHECK_EQ(d.column->use_count(), 1);
+        // the column may be shared with the block it comes from, e.g. the repeats of a block
+        if (d.column->use_count() > 1) {
+            d.column = d.column->clone_empty();
+            continue;
+        }
         (*std::move(d.column)).assume_mutable()->clear();
     }
     row_same_bit.clear();
@@ -670,6 +740,33 @@ void Block::update_hash(SipHash& hash) const {
     }
 }
 
+bool Block::merge_filter(const IColumn& filter_column, IColumn::Filter* filter) {
+    auto* __restrict filter_data = filter->data();
+    const size_t size = filter->size();
+    if (const auto* nullable_column = check_and_get_column<ColumnNullable>(filter_column)) {
+        const auto* __restrict nested_data =
+                assert_cast<const ColumnUInt8&>(nullable_column->get_nested_column())
+                        .get_data()
+                        .data();
+        const auto* __restrict null_map = nullable_column->get_null_map_data().data();
+        for (size_t i = 0; i < size; ++i) {
+            filter_data[i] &= (!null_map[i]) & nested_data[i];
+        }
+    } else if (const auto* const_column = check_and_get_column<ColumnConst>(filter_column)) {
+        if (!const_column->get_bool(0)) {
+            memset(filter_data, 0, size);
+            return false;
+        }
+    } else {
+        const auto* __restrict column_data =
+                assert_cast<const ColumnUInt8&>(filter_column).get_data().data();
+        for (size_t i = 0; i < size; ++i) {
+            filter_data[i] &= column_data[i];
+        }
+    }
+    return memchr(filter_data, 0x1, size) != nullptr;
+}
+
 void Block::filter_block_internal(Block* block, const std::vector<uint32_t>& columns_to_filter,
                                   const IColumn::Filter& filter) {
     size_t count = filter.size() - simd::count_zero_num((int8_t*)filter.data(), filter.size());
@@ -772,6 +869,18 @@ Status Block::serialize(int be_exec_version, PBlock* pblock,
                         bool allow_transfer_large_data) const {
     pblock->set_be_exec_version(be_exec_version);
 
+    if (be_exec_version >= 2) {
+        RETURN_IF_ERROR(_serialize_columns(pblock, uncompressed_bytes, compressed_bytes,
+                                           compression_type));
+        if (!allow_transfer_large_data &&
+            *compressed_bytes >= std::numeric_limits<int32_t>::max()) {
+            return Status::InternalError(
+                    "The block is large than 2GB({}), can not send by Protobuf.",
+                    *compressed_bytes);
+        }
+        return Status::OK();
+    }
+
     // calc uncompressed size for allocation
     size_t content_uncompressed_size = 0;
     for (const auto& c : *this) {
@@ -835,6 +944,63 @@ Status Block::serialize(int be_exec_version, PBlock* pblock,
     return Status::OK();
 }
 
+Status Block::_serialize_columns(PBlock* pblock, size_t* uncompressed_bytes,
+                                 size_t* compressed_bytes,
+                                 segment_v2::CompressionTypePB compression_type) const {
+    BlockCompressionCodec* codec = nullptr;
+    if (config::compress_rowbatches) {
+        RETURN_IF_ERROR(get_block_compression_codec(compression_type, &codec));
+    }
+
+    // Columns of a block compress very differently. E.g. random ints or hashes do not compress,
+    // but low cardinality strings compress well. So every column picks its own codec by the
+    // ratio it actually gets, and the receiver only decompresses the columns which shrink.
+    std::string column_values;
+    std::string column_buffer;
+    faststring buf_compressed;
+    *uncompressed_bytes = 0;
+    for (const auto& c : *this) {
+        c.to_pb_column_meta(pblock->add_column_metas());
+        // when data type is HLL, the estimated size maybe larger than real size.
+        size_t estimated_size =
+                c.type->get_uncompressed_serialized_bytes(*(c.column), pblock->be_exec_version());
+        try {
+            column_buffer.resize(estimated_size);
+        } catch (...) {
+            std::string msg = fmt::format("Try to alloc {} bytes for pblock column values failed.",
+                                          estimated_size);
+            LOG(WARNING) << msg;
+            return Status::BufferAllocFailed(msg);
+        }
+        size_t uncompressed_size =
+                c.type->serialize(*(c.column), column_buffer.data(), pblock->be_exec_version()) -
+                column_buffer.data();
+        *uncompressed_bytes += uncompressed_size;
+
+        PColumnValuesMeta* values_meta = pblock->add_column_values_metas();
+        values_meta->set_uncompressed_size(uncompressed_size);
+        if (codec != nullptr && uncompressed_size >= config::block_column_compression_min_bytes) {
+            SCOPED_RAW_TIMER(&_compress_time_ns);
+            RETURN_IF_ERROR(codec->compress(Slice(column_buffer.data(), uncompressed_size),
+                                            &buf_compressed));
+            if (buf_compressed.size() * config::block_column_compression_min_ratio <
+                uncompressed_size) {
+                values_meta->set_compression_type(compression_type);
+                values_meta->set_compressed_size(buf_compressed.size());
+                column_values.append(reinterpret_cast<const char*>(buf_compressed.data()),
+                                     buf_compressed.size());
+                continue;
+            }
+        }
+        values_meta->set_compression_type(segment_v2::CompressionTypePB::NO_COMPRESSION);
+        values_meta->set_compressed_size(uncompressed_size);
+        column_values.append(column_buffer.data(), uncompressed_size);
+    }
+    *compressed_bytes = column_values.size();
+    pblock->set_column_values(std::move(column_values));
+    return Status::OK();
+}
+
 MutableBlock::MutableBlock(const std::vector<TupleDescriptor*>& tuple_descs, int reserve_size,
                            bool ignore_trivial_slot) {
     for (auto tuple_desc : tuple_descs) {
@@ -264,6 +264,10 @@ public:
 
     void append_block_by_selector(MutableBlock* dst, const IColumn::Selector& selector) const;
 
+    // ANDs the filter column, which may be nullable or const, into `filter`. Returns false if no
+    // row passes afterwards.
+    static bool merge_filter(const IColumn& filter_column, IColumn::Filter* filter);
+
     static void filter_block_internal(Block* block, const std::vector<uint32_t>& columns_to_filter,
                                       const IColumn::Filter& filter);
 
@@ -279,6 +283,10 @@ public:
         block->erase_tail(column_to_keep);
     }
 
+    // deserialize PBlock to this block, the columns of this block are cleared and reused for the
+    // columns of the same types, so that their allocated memory is kept.
+    void deserialize(const PBlock& pblock);
+
     // serialize block to PBlock
     Status serialize(int be_exec_version, PBlock* pblock, size_t* uncompressed_bytes,
                      size_t* compressed_bytes, segment_v2::CompressionTypePB compression_type,
@@ -372,6 +380,14 @@ public:
 
 private:
     void erase_impl(size_t position);
+
+    // Serialize and deserialize the columns compressed separately, since be_exec_version 2.
+    Status _serialize_columns(PBlock* pblock, size_t* uncompressed_bytes,
+                              size_t* compressed_bytes,
+                              segment_v2::CompressionTypePB compression_type) const;
+    void _deserialize_columns(const PBlock& pblock, Container& reusable_data);
+    static MutableColumnPtr _create_column(Container& reusable_data, size_t position,
+                                           const DataTypePtr& type);
 };
 
 using Blocks = std::vector<Block>;
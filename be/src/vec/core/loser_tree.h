@@ -0,0 +1,171 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "common/logging.h"
+
+namespace doris::vectorized {
+
+// A tournament tree of losers to merge k sorted inputs, which takes ceil(log2(k)) comparisons to
+// replace the top, while a binary heap takes up to 2 * log2(k) for a pop and a push.
+//
+// Besides, the input winning twice in a row is likely to keep winning, e.g. the rowsets or the
+// runs with few overlaps, so the runner-up among the others is found once and the next elements
+// of the top are only compared with it until it loses, which takes one comparison per element.
+//
+// `Greater(a, b)` returns true if `a` comes after `b`. It's called once for a pair of elements
+// compared, so it may record the result in them, e.g. to mark the duplicated keys.
+template <typename T, typename Greater>
+class LoserTree {
+public:
+    explicit LoserTree(Greater greater = Greater()) : _greater(std::move(greater)) {}
+
+    // Builds the tree of the current elements of the inputs.
+    void init(std::vector<T> inputs) {
+        _inputs = std::move(inputs);
+        _num = _inputs.size();
+        _num_alive = _num;
+        _exhausted.assign(_num, false);
+        _losers.assign(_num, NONE);
+        _runner_up = NONE;
+        _in_run = false;
+        if (_num == 0) {
+            _winner = NONE;
+            return;
+        }
+        // the leaves are at [_num, 2 * _num), so every internal node in [1, _num) has two children
+        std::vector<size_t> winners(2 * _num);
+        for (size_t i = 0; i < _num; ++i) {
+            winners[_num + i] = i;
+        }
+        for (size_t node = _num - 1; node > 0; --node) {
+            size_t lhs = winners[2 * node];
+            size_t rhs = winners[2 * node + 1];
+            if (_beats(lhs, rhs)) {
+                winners[node] = lhs;
+                _losers[node] = rhs;
+            } else {
+                winners[node] = rhs;
+                _losers[node] = lhs;
+            }
+        }
+        _winner = _num > 1 ? winners[1] : 0;
+    }
+
+    bool empty() const { return _winner == NONE || _exhausted[_winner]; }
+
+    // The number of the inputs not exhausted.
+    size_t size() const { return _num_alive; }
+
+    T& top() {
+        DCHECK(!empty());
+        return _inputs[_winner];
+    }
+
+    size_t top_index() const { return _winner; }
+
+    bool exhausted(size_t index) const { return _exhausted[index]; }
+
+    // Called after the current element of the top input is replaced by its next one, and returns
+    // true if the same input is still the top.
+    bool update_top() {
+        DCHECK(!empty());
+        if (_in_run) {
+            if (_runner_up == NONE || _beats(_winner, _runner_up)) {
+                return true;
+            }
+            _in_run = false;
+        }
+        size_t last_winner = _winner;
+        _replay(_winner);
+        if (_winner != last_winner) {
+            return false;
+        }
+        _find_runner_up();
+        _in_run = true;
+        return true;
+    }
+
+    // Called after the top input is exhausted.
+    void pop_top() {
+        DCHECK(!empty());
+        _exhausted[_winner] = true;
+        --_num_alive;
+        _in_run = false;
+        _replay(_winner);
+    }
+
+    std::vector<T>& inputs() { return _inputs; }
+
+private:
+    static constexpr size_t NONE = static_cast<size_t>(-1);
+
+    // The exhausted inputs lose to all the others.
+    bool _beats(size_t lhs, size_t rhs) {
+        if (_exhausted[lhs]) {
+            return false;
+        }
+        if (_exhausted[rhs]) {
+            return true;
+        }
+        return !_greater(_inputs[lhs], _inputs[rhs]);
+    }
+
+    // Plays the matches on the path from the leaf to the root again.
+    void _replay(size_t input) {
+        size_t winner = input;
+        for (size_t node = (_num + input) / 2; node > 0; node /= 2) {
+            if (_beats(_losers[node], winner)) {
+                std::swap(_losers[node], winner);
+            }
+        }
+        _winner = winner;
+    }
+
+    // The runner-up is the best of the ones lost to the winner on its path.
+    void _find_runner_up() {
+        _runner_up = NONE;
+        for (size_t node = (_num + _winner) / 2; node > 0; node /= 2) {
+            size_t loser = _losers[node];
+            if (_exhausted[loser]) {
+                continue;
+            }
+            if (_runner_up == NONE || _beats(loser, _runner_up)) {
+                _runner_up = loser;
+            }
+        }
+    }
+
+    Greater _greater;
+    std::vector<T> _inputs;
+    size_t _num = 0;
+    size_t _num_alive = 0;
+    std::vector<bool> _exhausted;
+    // the loser of the match at each internal node, where the root is 1
+    std::vector<size_t> _losers;
+    size_t _winner = NONE;
+    size_t _runner_up = NONE;
+    // whether the top is only compared with the runner-up
+    bool _in_run = false;
+};
+
+} // namespace doris::vectorized
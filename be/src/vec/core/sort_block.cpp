@@ -20,8 +20,10 @@
 
 #include "vec/core/sort_block.h"
 
+#include "common/config.h"
 #include "vec/columns/column_string.h"
 #include "vec/common/typeid_cast.h"
+#include "vec/core/sort_key_normalizer.h"
 
 namespace doris::vectorized {
 
@@ -99,7 +101,15 @@ void sort_block(Block& src_block, Block& dest_block, const SortDescription& desc
 
         ColumnsWithSortDescriptions columns_with_sort_desc =
                 get_columns_with_sort_description(src_block, description);
-        {
+        ColumnRawPtrs sort_columns;
+        for (const auto& column_with_sort_desc : columns_with_sort_desc) {
+            sort_columns.push_back(column_with_sort_desc.first);
+        }
+        auto keys = ColumnString::create();
+        if (config::enable_sort_normalized_key && SortKeyNormalizer::can_normalize(sort_columns) &&
+            SortKeyNormalizer::normalize(sort_columns, description, keys.get())) {
+            SortKeyNormalizer::get_permutation(*keys, limit, perm);
+        } else {
             EqualFlags flags(size, 1);
             EqualRange range {0, size};
 
@@ -22,6 +22,7 @@
 #include <pdqsort.h>
 
 #include "util/simd/bits.h"
+#include "vec/common/radix_sort.h"
 #include "vec/core/block.h"
 #include "vec/core/sort_description.h"
 
@@ -135,6 +136,46 @@ struct PermutationWithInlineValue {
 template <typename T>
 using PermutationForColumn = std::vector<PermutationWithInlineValue<T>>;
 
+// The inlined values of integer, date and decimal columns are sorted by LSD radix sort, whose
+// key is the native integer of the value. Floats are not, because radix sort orders the NaNs
+// differently from the comparators.
+template <typename T, typename = void>
+struct RadixSortKey {
+    using Type = T;
+    static Type& get(T& value) { return value; }
+};
+
+template <typename T>
+struct RadixSortKey<T, std::enable_if_t<IsDecimalNumber<T>>> {
+    using Type = typename T::NativeType;
+    static Type& get(T& value) { return value.value; }
+};
+
+template <typename T>
+constexpr bool is_radix_sortable_v =
+        std::is_integral_v<typename RadixSortKey<T>::Type> && sizeof(T) <= sizeof(Int64);
+
+// Radix sort is slower than pdqsort for small ranges.
+static constexpr size_t RADIX_SORT_MIN_ROWS = 256;
+
+template <typename T>
+struct PermutationRadixSortTraits : RadixSortNumTraits<typename RadixSortKey<T>::Type> {
+    using Element = PermutationWithInlineValue<T>;
+    static typename RadixSortKey<T>::Type& extract_key(Element& elem) {
+        return RadixSortKey<T>::get(elem.inline_value);
+    }
+};
+
+// Sort by the inlined values, in the descending order if reverse.
+template <typename T>
+void radix_sort_permutation(PermutationWithInlineValue<T>* permutation, size_t size,
+                            bool reverse) {
+    RadixSort<PermutationRadixSortTraits<T>>::execute_lsd(permutation, size);
+    if (reverse) {
+        std::reverse(permutation, permutation + size);
+    }
+}
+
 class ColumnSorter {
 public:
     explicit ColumnSorter(const ColumnWithSortDescription& column, const int limit)
@@ -429,6 +470,12 @@ private:
                 }
                 new_limit = _limit + equal_count;
             } else {
+                if constexpr (is_radix_sortable_v<InlineType>) {
+                    if (last_iter - first_iter >= RADIX_SORT_MIN_ROWS) {
+                        radix_sort_permutation(&*begin, last_iter - first_iter, _direction < 0);
+                        return;
+                    }
+                }
                 pdqsort(begin, end, sort_comparator);
             }
         };
@@ -20,9 +20,11 @@
 
 #pragma once
 
+#include "common/config.h"
 #include "vec/columns/column.h"
 #include "vec/core/block.h"
 #include "vec/core/sort_description.h"
+#include "vec/core/sort_key_normalizer.h"
 #include "vec/exprs/vexpr_context.h"
 
 namespace doris::vectorized {
@@ -152,6 +154,9 @@ private:
 struct MergeSortCursorImpl {
     ColumnRawPtrs all_columns;
     ColumnRawPtrs sort_columns;
+    // The normalized keys of the rows, used to compare with the cursors which also have them.
+    // Only built for more than one sort column.
+    ColumnPtr normalized_keys;
     SortDescription desc;
     size_t sort_columns_size = 0;
     size_t pos = 0;
@@ -191,10 +196,23 @@ struct MergeSortCursorImpl {
             sort_columns.push_back(columns[column_number].get());
         }
 
+        normalized_keys = nullptr;
+        if (sort_columns.size() > 1 && config::enable_sort_normalized_key &&
+            SortKeyNormalizer::can_normalize(sort_columns)) {
+            auto keys = ColumnString::create();
+            if (SortKeyNormalizer::normalize(sort_columns, desc, keys.get())) {
+                normalized_keys = std::move(keys);
+            }
+        }
+
         pos = 0;
         rows = all_columns[0]->size();
     }
 
+    const ColumnString* normalized_keys_column() const {
+        return static_cast<const ColumnString*>(normalized_keys.get());
+    }
+
     bool isFirst() const { return pos == 0; }
     bool isLast() const { return pos + 1 >= rows; }
     void next() { ++pos; }
@@ -277,6 +295,11 @@ struct MergeSortCursor {
 
     /// The specified row of this cursor is greater than the specified row of another cursor.
     int8_t greater_at(const MergeSortCursor& rhs, size_t lhs_pos, size_t rhs_pos) const {
+        if (impl->normalized_keys && rhs.impl->normalized_keys) {
+            int res = SortKeyNormalizer::compare(*impl->normalized_keys_column(), lhs_pos,
+                                                 *rhs.impl->normalized_keys_column(), rhs_pos);
+            return res > 0 ? 1 : (res < 0 ? -1 : 0);
+        }
         for (size_t i = 0; i < impl->sort_columns_size; ++i) {
             int direction = impl->desc[i].direction;
             int nulls_direction = impl->desc[i].nulls_direction;
@@ -320,6 +343,12 @@ struct MergeSortBlockCursor {
 
     /// The specified row of this cursor is greater than the specified row of another cursor.
     int8_t less_at(const MergeSortBlockCursor& rhs, int rows) const {
+        if (impl->normalized_keys && rhs.impl->normalized_keys) {
+            int res = SortKeyNormalizer::compare(*impl->normalized_keys_column(), rows,
+                                                 *rhs.impl->normalized_keys_column(),
+                                                 rhs->rows - 1);
+            return res < 0 ? 1 : (res > 0 ? -1 : 0);
+        }
         for (size_t i = 0; i < impl->sort_columns_size; ++i) {
             int direction = impl->desc[i].direction;
             int nulls_direction = impl->desc[i].nulls_direction;
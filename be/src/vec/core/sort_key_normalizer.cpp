@@ -0,0 +1,229 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/core/sort_key_normalizer.h"
+
+#include <pdqsort.h>
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+
+#include "vec/columns/column_decimal.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+template <typename ColumnType, typename F>
+bool try_call(const IColumn& column, F& f) {
+    if (const auto* typed_column = check_and_get_column<ColumnType>(column)) {
+        f(*typed_column);
+        return true;
+    }
+    return false;
+}
+
+template <typename... ColumnTypes>
+struct ColumnTypeList {
+    // Call f with the typed column, false if the column is none of the types.
+    template <typename F>
+    static bool dispatch(const IColumn& column, F&& f) {
+        return (try_call<ColumnTypes>(column, f) || ...);
+    }
+};
+
+using NormalizableColumns =
+        ColumnTypeList<ColumnUInt8, ColumnUInt16, ColumnUInt32, ColumnUInt64, ColumnInt8,
+                       ColumnInt16, ColumnInt32, ColumnInt64, ColumnInt128, ColumnDecimal32,
+                       ColumnDecimal64, ColumnDecimal128, ColumnDecimal128I, ColumnString>;
+
+template <typename T>
+auto native_value(const T& value) {
+    if constexpr (IsDecimalNumber<T>) {
+        return value.value;
+    } else {
+        return value;
+    }
+}
+
+template <typename T>
+UInt8* write_integer(T value, UInt8* pos) {
+    using Unsigned = std::make_unsigned_t<T>;
+    auto bits = static_cast<Unsigned>(value);
+    if constexpr (std::is_signed_v<T>) {
+        bits ^= Unsigned(1) << (sizeof(T) * 8 - 1);
+    }
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        pos[i] = static_cast<UInt8>(bits >> ((sizeof(T) - 1 - i) * 8));
+    }
+    return pos + sizeof(T);
+}
+
+UInt8* write_string(StringRef value, UInt8* pos) {
+    for (size_t i = 0; i < value.size; ++i) {
+        auto c = static_cast<UInt8>(value.data[i]);
+        *pos++ = c;
+        if (c == 0) {
+            *pos++ = 0xff;
+        }
+    }
+    *pos++ = 0;
+    *pos++ = 0;
+    return pos;
+}
+
+template <typename ColumnType>
+void add_key_sizes(const ColumnType& column, const UInt8* null_map, std::vector<size_t>& sizes) {
+    size_t rows = sizes.size();
+    size_t marker_size = null_map ? 1 : 0;
+    for (size_t i = 0; i < rows; ++i) {
+        if (null_map && null_map[i]) {
+            sizes[i] += 1;
+        } else if constexpr (std::is_same_v<ColumnType, ColumnString>) {
+            auto value = column.get_data_at(i);
+            sizes[i] += marker_size + value.size + 2 + std::count(value.data, value.end(), 0);
+        } else {
+            sizes[i] += marker_size + sizeof(native_value(column.get_data()[0]));
+        }
+    }
+}
+
+template <typename ColumnType>
+void write_keys(const ColumnType& column, const UInt8* null_map,
+                const SortColumnDescription& desc, UInt8* chars, std::vector<size_t>& pos) {
+    // NULL is compared as the nulls_direction before the direction is applied
+    UInt8 null_marker = desc.nulls_direction > 0 ? 2 : 0;
+    size_t rows = pos.size();
+    for (size_t i = 0; i < rows; ++i) {
+        UInt8* start = chars + pos[i];
+        UInt8* end = start;
+        if (null_map && null_map[i]) {
+            *end++ = null_marker;
+        } else {
+            if (null_map) {
+                *end++ = 1;
+            }
+            if constexpr (std::is_same_v<ColumnType, ColumnString>) {
+                end = write_string(column.get_data_at(i), end);
+            } else {
+                end = write_integer(native_value(column.get_data()[i]), end);
+            }
+        }
+        if (desc.direction < 0) {
+            for (UInt8* p = start; p < end; ++p) {
+                *p = ~*p;
+            }
+        }
+        pos[i] = end - chars;
+    }
+}
+
+// the nested column and the null map of a nullable column
+std::pair<const IColumn*, const UInt8*> unwrap_nullable(const IColumn* column) {
+    if (const auto* nullable = check_and_get_column<ColumnNullable>(*column)) {
+        return {&nullable->get_nested_column(), nullable->get_null_map_data().data()};
+    }
+    return {column, nullptr};
+}
+
+} // namespace
+
+bool SortKeyNormalizer::can_normalize(const ColumnRawPtrs& columns) {
+    return std::all_of(columns.begin(), columns.end(), [](const IColumn* column) {
+        return NormalizableColumns::dispatch(*unwrap_nullable(column).first, [](const auto&) {});
+    });
+}
+
+bool SortKeyNormalizer::normalize(const ColumnRawPtrs& columns, const SortDescription& desc,
+                                  ColumnString* keys) {
+    DCHECK(can_normalize(columns));
+    DCHECK_EQ(columns.size(), desc.size());
+    if (columns.empty()) {
+        return true;
+    }
+    size_t rows = columns[0]->size();
+    std::vector<size_t> sizes(rows, 0);
+    for (const auto* column : columns) {
+        const UInt8* null_map = nullptr;
+        std::tie(column, null_map) = unwrap_nullable(column);
+        NormalizableColumns::dispatch(*column, [&](const auto& typed_column) {
+            add_key_sizes(typed_column, null_map, sizes);
+        });
+    }
+
+    auto& chars = keys->get_chars();
+    auto& offsets = keys->get_offsets();
+    size_t old_rows = offsets.size();
+    size_t total_size = chars.size();
+    for (size_t size : sizes) {
+        total_size += size;
+    }
+    if (total_size > std::numeric_limits<IColumn::Offset>::max()) {
+        return false;
+    }
+
+    // the start of the key of each row, then the end after the keys are written
+    std::vector<size_t> pos(rows);
+    size_t offset = chars.size();
+    offsets.resize(old_rows + rows);
+    for (size_t i = 0; i < rows; ++i) {
+        pos[i] = offset;
+        offset += sizes[i];
+        offsets[old_rows + i] = offset;
+    }
+    chars.resize(offset);
+
+    for (size_t i = 0; i < columns.size(); ++i) {
+        const IColumn* column = nullptr;
+        const UInt8* null_map = nullptr;
+        std::tie(column, null_map) = unwrap_nullable(columns[i]);
+        NormalizableColumns::dispatch(*column, [&](const auto& typed_column) {
+            write_keys(typed_column, null_map, desc[i], chars.data(), pos);
+        });
+    }
+    return true;
+}
+
+void SortKeyNormalizer::get_permutation(const ColumnString& keys, size_t limit,
+                                        IColumn::Permutation& perm) {
+    size_t rows = keys.size();
+    std::vector<std::pair<StringRef, size_t>> refs(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        refs[i] = {keys.get_data_at(i), i};
+    }
+    auto less = [](const std::pair<StringRef, size_t>& a, const std::pair<StringRef, size_t>& b) {
+        return memcmp_small_allow_overflow15(reinterpret_cast<const UInt8*>(a.first.data),
+                                             a.first.size,
+                                             reinterpret_cast<const UInt8*>(b.first.data),
+                                             b.first.size) < 0;
+    };
+    if (limit > 0 && limit < rows) {
+        std::partial_sort(refs.begin(), refs.begin() + limit, refs.end(), less);
+    } else {
+        pdqsort(refs.begin(), refs.end(), less);
+    }
+    perm.resize(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        perm[i] = refs[i].second;
+    }
+}
+
+} // namespace doris::vectorized
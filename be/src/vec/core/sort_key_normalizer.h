@@ -0,0 +1,54 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "vec/columns/column.h"
+#include "vec/columns/column_string.h"
+#include "vec/core/sort_description.h"
+
+namespace doris::vectorized {
+
+// Encodes the sort keys of each row into one normalized key, so that the order of the rows is
+// the memcmp order of their normalized keys, like the KeyCoder of the storage. The rows are
+// then compared without the virtual IColumn::compare_at of every sort column.
+//
+// The integer, date and decimal values are written in big endian with the sign bit flipped,
+// the strings are escaped: 0x00 becomes 0x00 0xff, and end with 0x00 0x00. A nullable value
+// starts with a marker byte. The bytes of a DESC column are inverted. Floats, constant and
+// complex columns can not be normalized.
+class SortKeyNormalizer {
+public:
+    static bool can_normalize(const ColumnRawPtrs& columns);
+
+    // Append the normalized key of every row of the columns to keys, false if the keys are too
+    // large for a ColumnString.
+    static bool normalize(const ColumnRawPtrs& columns, const SortDescription& desc,
+                          ColumnString* keys);
+
+    static int compare(const ColumnString& lhs, size_t lhs_row, const ColumnString& rhs,
+                       size_t rhs_row) {
+        return lhs.compare_at(lhs_row, rhs_row, rhs, 1);
+    }
+
+    // The permutation that sorts the rows by their normalized keys, only the first limit rows
+    // are sorted if limit is not 0.
+    static void get_permutation(const ColumnString& keys, size_t limit,
+                                IColumn::Permutation& perm);
+};
+
+} // namespace doris::vectorized
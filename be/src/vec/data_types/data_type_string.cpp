@@ -20,12 +20,19 @@
 
 #include "vec/data_types/data_type_string.h"
 
+#include <parallel_hashmap/phmap.h>
+
+#include <algorithm>
+#include <limits>
 #include <string_view>
+#include <vector>
 
+#include "common/config.h"
 #include "vec/columns/column.h"
 #include "vec/columns/column_const.h"
 #include "vec/columns/column_string.h"
 #include "vec/common/assert_cast.h"
+#include "vec/common/string_ref.h"
 #include "vec/core/field.h"
 
 #ifdef __SSE2__
@@ -71,9 +78,48 @@ bool DataTypeString::equals(const IDataType& rhs) const {
     return typeid(rhs) == typeid(*this);
 }
 
+namespace {
+// Since be_exec_version 4, the serialized strings start with an encoding tag. The columns of
+// few distinct values are sent as the dictionary of the values and the codes of the rows.
+enum class StringEncoding : uint8_t { PLAIN = 0, DICTIONARY = 1 };
+using DictCode = uint16_t;
+// the columns of fewer rows are not worth building a dictionary for
+constexpr size_t DICT_MIN_ROWS = 256;
+// a column is dictionary encoded only if every value repeats this many times on average
+constexpr size_t DICT_MIN_ROWS_PER_VALUE = 8;
+
+// Returns false if the column has too many distinct values to be dictionary encoded.
+bool build_dictionary(const ColumnString& column, std::vector<StringRef>& dict,
+                      PaddedPODArray<DictCode>& codes) {
+    size_t rows = column.size();
+    if (!config::enable_string_dictionary_serialization || rows < DICT_MIN_ROWS) {
+        return false;
+    }
+    size_t max_dict_size = std::min<size_t>(std::numeric_limits<DictCode>::max() + 1ULL,
+                                            rows / DICT_MIN_ROWS_PER_VALUE);
+    phmap::flat_hash_map<StringRef, DictCode, StringRefHash> value_to_code;
+    codes.resize(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        StringRef value = column.get_data_at(i);
+        auto it = value_to_code.find(value);
+        if (it == value_to_code.end()) {
+            if (dict.size() == max_dict_size) {
+                return false;
+            }
+            it = value_to_code.emplace(value, dict.size()).first;
+            dict.push_back(value);
+        }
+        codes[i] = it->second;
+    }
+    return true;
+}
+} // namespace
+
 // binary: <size array> | total length | <value array>
 //  <size array> : row num | offset1 |offset2 | ...
 //  <value array> : <value1> | <value2 | ...
+// since be_exec_version 4: PLAIN | <binary above>
+//  or DICTIONARY | row num | dict size | <dict size array> | dict length | <dict values> | codes
 int64_t DataTypeString::get_uncompressed_serialized_bytes(const IColumn& column,
                                                           int be_exec_version) const {
     auto ptr = column.convert_to_full_column_if_const();
@@ -84,7 +130,9 @@ int64_t DataTypeString::get_uncompressed_serialized_bytes(const IColumn& column,
                data_column.get_chars().size() + column.size();
     }
 
-    return sizeof(IColumn::Offset) * (column.size() + 1) + sizeof(uint64_t) +
+    // the dictionary is used only if it is smaller than the plain values
+    int64_t tag_size = be_exec_version >= 4 ? sizeof(StringEncoding) : 0;
+    return tag_size + sizeof(IColumn::Offset) * (column.size() + 1) + sizeof(uint64_t) +
            data_column.get_chars().size();
 }
 
@@ -115,6 +163,52 @@ char* DataTypeString::serialize(const IColumn& column, char* buf, int be_exec_ve
         return buf;
     }
 
+    if (be_exec_version >= 4) {
+        std::vector<StringRef> dict;
+        PaddedPODArray<DictCode> codes;
+        if (build_dictionary(data_column, dict, codes)) {
+            size_t dict_value_len = 0;
+            for (const auto& value : dict) {
+                dict_value_len += value.size;
+            }
+            size_t dict_bytes = sizeof(uint32_t) + sizeof(IColumn::Offset) * dict.size() +
+                                dict_value_len + sizeof(DictCode) * codes.size();
+            size_t plain_bytes =
+                    sizeof(IColumn::Offset) * column.size() + data_column.get_chars().size();
+            if (dict_bytes < plain_bytes) {
+                *reinterpret_cast<StringEncoding*>(buf) = StringEncoding::DICTIONARY;
+                buf += sizeof(StringEncoding);
+                // row num
+                *reinterpret_cast<IColumn::Offset*>(buf) = column.size();
+                buf += sizeof(IColumn::Offset);
+                // dict size
+                *reinterpret_cast<uint32_t*>(buf) = dict.size();
+                buf += sizeof(uint32_t);
+                // dict offsets
+                IColumn::Offset offset = 0;
+                for (const auto& value : dict) {
+                    offset += value.size;
+                    *reinterpret_cast<IColumn::Offset*>(buf) = offset;
+                    buf += sizeof(IColumn::Offset);
+                }
+                // dict length
+                *reinterpret_cast<uint64_t*>(buf) = dict_value_len;
+                buf += sizeof(uint64_t);
+                // dict values
+                for (const auto& value : dict) {
+                    memcpy(buf, value.data, value.size);
+                    buf += value.size;
+                }
+                // codes
+                memcpy(buf, codes.data(), sizeof(DictCode) * codes.size());
+                buf += sizeof(DictCode) * codes.size();
+                return buf;
+            }
+        }
+        *reinterpret_cast<StringEncoding*>(buf) = StringEncoding::PLAIN;
+        buf += sizeof(StringEncoding);
+    }
+
     // row num
     *reinterpret_cast<IColumn::Offset*>(buf) = column.size();
     buf += sizeof(IColumn::Offset);
@@ -161,6 +255,47 @@ const char* DataTypeString::deserialize(const char* buf, IColumn* column,
         return buf;
     }
 
+    if (be_exec_version >= 4) {
+        auto encoding = *reinterpret_cast<const StringEncoding*>(buf);
+        buf += sizeof(StringEncoding);
+        if (encoding == StringEncoding::DICTIONARY) {
+            // row num
+            IColumn::Offset row_num = *reinterpret_cast<const IColumn::Offset*>(buf);
+            buf += sizeof(IColumn::Offset);
+            // dict size
+            uint32_t dict_size = *reinterpret_cast<const uint32_t*>(buf);
+            buf += sizeof(uint32_t);
+            // dict offsets
+            const auto* dict_offsets = reinterpret_cast<const IColumn::Offset*>(buf);
+            buf += sizeof(IColumn::Offset) * dict_size;
+            // dict values
+            uint64_t dict_value_len = *reinterpret_cast<const uint64_t*>(buf);
+            buf += sizeof(uint64_t);
+            const char* dict_values = buf;
+            buf += dict_value_len;
+            // codes
+            const auto* codes = reinterpret_cast<const DictCode*>(buf);
+            buf += sizeof(DictCode) * row_num;
+
+            auto value_begin = [&](DictCode code) {
+                return code == 0 ? 0 : dict_offsets[code - 1];
+            };
+            offsets.resize(row_num);
+            IColumn::Offset offset = 0;
+            for (size_t i = 0; i < row_num; ++i) {
+                offset += dict_offsets[codes[i]] - value_begin(codes[i]);
+                offsets[i] = offset;
+            }
+            data.resize(offset);
+            for (size_t i = 0; i < row_num; ++i) {
+                size_t begin = value_begin(codes[i]);
+                memcpy(data.data() + offsets[i - 1], dict_values + begin,
+                       dict_offsets[codes[i]] - begin);
+            }
+            return buf;
+        }
+    }
+
     // row num
     IColumn::Offset row_num = *reinterpret_cast<const IColumn::Offset*>(buf);
     buf += sizeof(IColumn::Offset);
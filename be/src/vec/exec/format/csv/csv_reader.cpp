@@ -28,6 +28,7 @@
 #include "io/file_factory.h"
 #include "olap/iterators.h"
 #include "olap/olap_common.h"
+#include "util/simd/bits.h"
 #include "util/string_util.h"
 #include "util/utf8_check.h"
 #include "vec/core/block.h"
@@ -453,41 +454,45 @@ void CsvReader::_split_line_for_single_char_delimiter(const Slice& line) {
         _split_line_for_proto_format(line);
     } else {
         const char* value = line.data;
+        const char separator = _value_separator[0];
         size_t cur_pos = 0;
         size_t start_field = 0;
         const size_t size = line.size;
+        // find the separators of 32 bytes at a time
+        for (; cur_pos + 32 <= size; cur_pos += 32) {
+            uint32_t mask = simd::bytes32_eq_mask(value + cur_pos, separator);
+            while (mask != 0) {
+                size_t separator_pos = cur_pos + __builtin_ctz(mask);
+                _add_split_value(value, start_field, separator_pos);
+                start_field = separator_pos + 1;
+                mask &= mask - 1;
+            }
+        }
         for (; cur_pos < size; ++cur_pos) {
-            if (*(value + cur_pos) == _value_separator[0]) {
-                size_t non_space = cur_pos;
-                if (_state != nullptr && _state->trim_tailing_spaces_for_external_table_query()) {
-                    while (non_space > start_field && *(value + non_space - 1) == ' ') {
-                        non_space--;
-                    }
-                }
-                if (_trim_double_quotes && non_space > (start_field + 1) &&
-                    *(value + start_field) == '\"' && *(value + non_space - 1) == '\"') {
-                    start_field++;
-                    non_space--;
-                }
-                _split_values.emplace_back(value + start_field, non_space - start_field);
+            if (*(value + cur_pos) == separator) {
+                _add_split_value(value, start_field, cur_pos);
                 start_field = cur_pos + 1;
             }
         }
 
         CHECK(cur_pos == line.size) << cur_pos << " vs " << line.size;
-        size_t non_space = cur_pos;
-        if (_state != nullptr && _state->trim_tailing_spaces_for_external_table_query()) {
-            while (non_space > start_field && *(value + non_space - 1) == ' ') {
-                non_space--;
-            }
-        }
-        if (_trim_double_quotes && non_space > (start_field + 1) &&
-            *(value + start_field) == '\"' && *(value + non_space - 1) == '\"') {
-            start_field++;
+        _add_split_value(value, start_field, cur_pos);
+    }
+}
+
+void CsvReader::_add_split_value(const char* value, size_t start_field, size_t end_field) {
+    size_t non_space = end_field;
+    if (_state != nullptr && _state->trim_tailing_spaces_for_external_table_query()) {
+        while (non_space > start_field && *(value + non_space - 1) == ' ') {
             non_space--;
         }
-        _split_values.emplace_back(value + start_field, non_space - start_field);
     }
+    if (_trim_double_quotes && non_space > (start_field + 1) && *(value + start_field) == '\"' &&
+        *(value + non_space - 1) == '\"') {
+        start_field++;
+        non_space--;
+    }
+    _split_values.emplace_back(value + start_field, non_space - start_field);
 }
 
 void CsvReader::_split_line(const Slice& line) {
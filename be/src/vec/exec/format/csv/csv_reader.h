@@ -64,6 +64,8 @@ private:
     Status _line_split_to_values(const Slice& line, bool* success);
     void _split_line(const Slice& line);
     void _split_line_for_single_char_delimiter(const Slice& line);
+    // add the field [start_field, end_field) of the line to _split_values
+    void _add_split_value(const char* value, size_t start_field, size_t end_field);
     void _split_line_for_proto_format(const Slice& line);
     Status _check_array_format(std::vector<Slice>& split_values, bool* is_success);
     bool _is_null(const Slice& slice);
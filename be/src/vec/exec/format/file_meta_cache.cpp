@@ -0,0 +1,56 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/format/file_meta_cache.h"
+
+#include <fmt/format.h>
+
+#include "common/config.h"
+
+namespace doris::vectorized {
+
+FileMetaCache* FileMetaCache::_s_instance = nullptr;
+
+void FileMetaCache::create_global_instance(size_t capacity) {
+    DCHECK(_s_instance == nullptr);
+    if (capacity == 0) {
+        return;
+    }
+    static FileMetaCache instance(capacity);
+    _s_instance = &instance;
+}
+
+FileMetaCache::FileMetaCache(size_t capacity) {
+    _cache = std::unique_ptr<Cache>(new_lru_cache("FileMetaCache", capacity, LRUCacheType::SIZE,
+                                                  16, 0, config::enable_cache_clock_eviction));
+}
+
+std::string FileMetaCache::get_key(const std::string& format, const TFileRangeDesc& range,
+                                   int64_t file_size) {
+    int64_t modification_time =
+            range.__isset.modification_time ? range.modification_time : 0;
+    if (modification_time <= 0) {
+        bool immutable = range.__isset.table_format_params &&
+                         range.table_format_params.table_format_type == "iceberg";
+        if (!immutable) {
+            return "";
+        }
+    }
+    return fmt::format("{}:{}:{}:{}", format, modification_time, file_size, range.path);
+}
+
+} // namespace doris::vectorized
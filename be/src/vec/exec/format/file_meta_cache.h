@@ -0,0 +1,107 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "gen_cpp/PlanNodes_types.h"
+#include "olap/lru_cache.h"
+
+namespace doris::vectorized {
+
+// A LRU cache of the parsed metadata of the external files, e.g. the parquet footers and the orc
+// file tails. It's shared by the scans of all the queries, so the repeated scans of a file don't
+// read and parse its metadata again.
+//
+// A file is identified by its path, modification time and size, which change when the file is
+// rewritten. The files of unknown modification time are only cached if they are immutable, i.e.
+// the data files of iceberg tables.
+class FileMetaCache {
+public:
+    // Pins a cache entry until it's destroyed.
+    class Handle {
+    public:
+        Handle() = default;
+        Handle(Cache* cache, Cache::Handle* handle) : _cache(cache), _handle(handle) {}
+        ~Handle() {
+            if (_handle != nullptr) {
+                _cache->release(_handle);
+            }
+        }
+
+        Handle(Handle&& other) noexcept {
+            std::swap(_cache, other._cache);
+            std::swap(_handle, other._handle);
+        }
+
+        Handle& operator=(Handle&& other) noexcept {
+            std::swap(_cache, other._cache);
+            std::swap(_handle, other._handle);
+            return *this;
+        }
+
+        bool valid() const { return _handle != nullptr; }
+
+        template <typename T>
+        T* data() const {
+            return static_cast<T*>(_cache->value(_handle));
+        }
+
+    private:
+        Cache* _cache = nullptr;
+        Cache::Handle* _handle = nullptr;
+    };
+
+    explicit FileMetaCache(size_t capacity);
+
+    // The cache is disabled if capacity is 0.
+    static void create_global_instance(size_t capacity);
+
+    // Returns nullptr if the cache is disabled.
+    static FileMetaCache* instance() { return _s_instance; }
+
+    // Returns the key of the metadata of the file of the range in the format, or an empty string
+    // if it's not cacheable.
+    static std::string get_key(const std::string& format, const TFileRangeDesc& range,
+                               int64_t file_size);
+
+    bool lookup(const std::string& key, Handle* handle) {
+        auto lru_handle = _cache->lookup(key);
+        if (lru_handle == nullptr) {
+            return false;
+        }
+        *handle = Handle(_cache.get(), lru_handle);
+        return true;
+    }
+
+    // Caches the value, it's deleted when evicted. charge is its memory size.
+    template <typename T>
+    void insert(const std::string& key, T* value, size_t charge, Handle* handle) {
+        auto deleter = [](const CacheKey& key, void* value) { delete static_cast<T*>(value); };
+        *handle = Handle(_cache.get(), _cache->insert(key, value, charge, deleter));
+    }
+
+private:
+    static FileMetaCache* _s_instance;
+
+    std::unique_ptr<Cache> _cache;
+};
+
+} // namespace doris::vectorized
@@ -20,6 +20,7 @@
 #include "common/status.h"
 #include "exec/decompressor.h"
 #include "io/fs/file_reader.h"
+#include "io/fs/stream_load_pipe.h"
 #include "olap/iterators.h"
 
 // INPUT_CHUNK must
@@ -67,6 +68,9 @@ NewPlainTextLineReader::NewPlainTextLineReader(RuntimeProfile* profile,
     _read_timer = ADD_TIMER(_profile, "FileReadTime");
     _bytes_decompress_counter = ADD_COUNTER(_profile, "BytesDecompressed", TUnit::BYTES);
     _decompress_timer = ADD_TIMER(_profile, "DecompressTime");
+    if (_decompressor == nullptr) {
+        _pipe = dynamic_cast<io::StreamLoadPipe*>(_file_reader.get());
+    }
 }
 
 NewPlainTextLineReader::~NewPlainTextLineReader() {
@@ -74,6 +78,7 @@ NewPlainTextLineReader::~NewPlainTextLineReader() {
 }
 
 void NewPlainTextLineReader::close() {
+    _pipe_buf.reset();
     if (_input_buf != nullptr) {
         delete[] _input_buf;
         _input_buf = nullptr;
@@ -97,6 +102,9 @@ inline bool NewPlainTextLineReader::update_eof() {
 uint8_t* NewPlainTextLineReader::update_field_pos_and_find_line_delimiter(const uint8_t* start,
                                                                           size_t len) {
     // TODO: meanwhile find and save field pos
+    if (_line_delimiter_length == 1) {
+        return (uint8_t*)memchr(start, _line_delimiter[0], len);
+    }
     return (uint8_t*)memmem(start, len, _line_delimiter.c_str(), _line_delimiter_length);
 }
 
@@ -181,6 +189,9 @@ Status NewPlainTextLineReader::read_line(const uint8_t** ptr, size_t* size, bool
         *eof = true;
         return Status::OK();
     }
+    if (_pipe != nullptr) {
+        return _read_line_from_pipe(ptr, size, eof);
+    }
     int found_line_delimiter = 0;
     size_t offset = 0;
     while (!done()) {
@@ -339,4 +350,92 @@ Status NewPlainTextLineReader::read_line(const uint8_t** ptr, size_t* size, bool
 
     return Status::OK();
 }
+
+Status NewPlainTextLineReader::_read_line_from_pipe(const uint8_t** ptr, size_t* size,
+                                                    bool* eof) {
+    while (true) {
+        if (output_buf_read_remaining() == 0 && _pipe_buf != nullptr &&
+            _pipe_buf->has_remaining()) {
+            // the line starts in the buffer of the pipe, return it in place if it ends there
+            auto* start = reinterpret_cast<uint8_t*>(_pipe_buf->ptr + _pipe_buf->pos);
+            size_t len = _pipe_buf->remaining();
+            uint8_t* pos = update_field_pos_and_find_line_delimiter(start, len);
+            if (pos != nullptr) {
+                *ptr = start;
+                *size = pos - start;
+                *eof = false;
+                _pipe_buf->pos += *size + _line_delimiter_length;
+                _total_read_bytes += *size + _line_delimiter_length;
+                return Status::OK();
+            }
+            // the head of a line which ends in the next buffers
+            _append_to_output_buf(start, len);
+            _pipe_buf->pos = _pipe_buf->limit;
+        }
+
+        if (output_buf_read_remaining() > 0) {
+            uint8_t* cur_ptr = _output_buf + _output_buf_pos;
+            uint8_t* pos =
+                    update_field_pos_and_find_line_delimiter(cur_ptr, output_buf_read_remaining());
+            if (pos != nullptr) {
+                *ptr = cur_ptr;
+                *size = pos - cur_ptr;
+                *eof = false;
+                _output_buf_pos += *size + _line_delimiter_length;
+                _total_read_bytes += *size + _line_delimiter_length;
+                return Status::OK();
+            }
+            if (_pipe_buf != nullptr && _pipe_buf->has_remaining()) {
+                // Only copy the buffer until the end of its first line delimiter. A delimiter
+                // spanning the two buffers ends before it, so it's found in the output buf.
+                auto* start = reinterpret_cast<uint8_t*>(_pipe_buf->ptr + _pipe_buf->pos);
+                size_t len = _pipe_buf->remaining();
+                uint8_t* next = update_field_pos_and_find_line_delimiter(start, len);
+                size_t copy_len = next == nullptr ? len : next - start + _line_delimiter_length;
+                _append_to_output_buf(start, copy_len);
+                _pipe_buf->pos += copy_len;
+                continue;
+            }
+        }
+
+        // the buffer is consumed, take the next one
+        {
+            SCOPED_TIMER(_read_timer);
+            RETURN_IF_ERROR(_pipe->read_buffer(&_pipe_buf));
+        }
+        if (_pipe_buf == nullptr) {
+            _file_eof = true;
+            // the last line may not end with the line delimiter
+            *ptr = _output_buf + _output_buf_pos;
+            *size = output_buf_read_remaining();
+            *eof = *size == 0;
+            _output_buf_pos = _output_buf_limit;
+            _total_read_bytes += *size;
+            return Status::OK();
+        }
+        _current_offset += _pipe_buf->remaining();
+        COUNTER_UPDATE(_bytes_read_counter, _pipe_buf->remaining());
+    }
+}
+
+void NewPlainTextLineReader::_append_to_output_buf(const uint8_t* data, size_t len) {
+    if (_output_buf_size - _output_buf_limit < len) {
+        size_t remaining = output_buf_read_remaining();
+        if (_output_buf_size - remaining < len) {
+            while (_output_buf_size - remaining < len) {
+                _output_buf_size = _output_buf_size * 2;
+            }
+            uint8_t* new_output_buf = new uint8_t[_output_buf_size];
+            memcpy(new_output_buf, _output_buf + _output_buf_pos, remaining);
+            delete[] _output_buf;
+            _output_buf = new_output_buf;
+        } else {
+            memmove(_output_buf, _output_buf + _output_buf_pos, remaining);
+        }
+        _output_buf_pos = 0;
+        _output_buf_limit = remaining;
+    }
+    memcpy(_output_buf + _output_buf_limit, data, len);
+    _output_buf_limit += len;
+}
 } // namespace doris
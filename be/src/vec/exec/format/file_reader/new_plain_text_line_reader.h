@@ -19,12 +19,14 @@
 
 #include "exec/line_reader.h"
 #include "io/fs/file_reader.h"
+#include "util/byte_buffer.h"
 #include "util/runtime_profile.h"
 
 namespace doris {
 namespace io {
 class IOContext;
-}
+class StreamLoadPipe;
+} // namespace io
 
 class Decompressor;
 class Status;
@@ -61,6 +63,12 @@ private:
     void extend_input_buf();
     void extend_output_buf();
 
+    // Read the line from the buffers of an uncompressed stream load pipe. The line is
+    // returned from the buffer of the pipe without copying, only the lines which span two
+    // buffers are copied into the output buf.
+    Status _read_line_from_pipe(const uint8_t** ptr, size_t* size, bool* eof);
+    void _append_to_output_buf(const uint8_t* data, size_t len);
+
     RuntimeProfile* _profile;
     io::FileReaderSPtr _file_reader;
     Decompressor* _decompressor;
@@ -92,6 +100,11 @@ private:
 
     size_t _current_offset;
 
+    // not null if the file reader is an uncompressed stream load pipe
+    io::StreamLoadPipe* _pipe = nullptr;
+    // the buffer taken from the pipe, which holds the line returned last time
+    ByteBufferPtr _pipe_buf;
+
     // Profile counters
     RuntimeProfile::Counter* _bytes_read_counter;
     RuntimeProfile::Counter* _read_timer;
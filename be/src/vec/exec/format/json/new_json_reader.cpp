@@ -111,20 +111,21 @@ void NewJsonReader::_init_file_description() {
 }
 
 Status NewJsonReader::init_reader() {
-    if (config::enable_simdjson_reader) {
+    RETURN_IF_ERROR(_get_range_params());
+
+    // generate _parsed_jsonpaths and _parsed_json_root
+    RETURN_IF_ERROR(_parse_jsonpath_and_json_root());
+
+    if (config::enable_simdjson_reader && _simdjson_support_jsonpaths()) {
         RETURN_IF_ERROR(_simdjson_init_reader());
         return Status::OK();
     }
-    RETURN_IF_ERROR(_get_range_params());
 
     RETURN_IF_ERROR(_open_file_reader());
     if (_read_json_by_line) {
         RETURN_IF_ERROR(_open_line_reader());
     }
 
-    // generate _parsed_jsonpaths and _parsed_json_root
-    RETURN_IF_ERROR(_parse_jsonpath_and_json_root());
-
     //improve performance
     if (_parsed_jsonpaths.empty()) { // input is a simple json-string
         _vhandle_json_callback = _is_dynamic_schema ? &NewJsonReader::_vhandle_dynamic_json
@@ -1030,17 +1031,35 @@ Status NewJsonReader::_read_one_message(std::unique_ptr<uint8_t[]>* file_buf, si
 }
 // ---------SIMDJSON----------
 // simdjson, replace none simdjson function if it is ready
-Status NewJsonReader::_simdjson_init_reader() {
-    RETURN_IF_ERROR(_get_range_params());
+bool NewJsonReader::_simdjson_support_jsonpaths() const {
+    // The paths are extracted from an ondemand object, so they must start with a key of
+    // the object, like "$.k1". And only the last key can be followed by [*], which selects
+    // the array itself. The others are parsed by rapidjson.
+    auto is_supported = [](const std::vector<JsonPath>& path, bool allow_last_wildcard) {
+        if (path.size() <= 1 || path[0].idx != -1) {
+            return false;
+        }
+        for (size_t i = 1; i < path.size(); ++i) {
+            if (!path[i].is_valid ||
+                (path[i].idx == -2 && (!allow_last_wildcard || i + 1 != path.size()))) {
+                return false;
+            }
+        }
+        return true;
+    };
+    if (!_parsed_json_root.empty() && !is_supported(_parsed_json_root, false)) {
+        return false;
+    }
+    return std::all_of(_parsed_jsonpaths.begin(), _parsed_jsonpaths.end(),
+                       [&](const auto& path) { return is_supported(path, true); });
+}
 
+Status NewJsonReader::_simdjson_init_reader() {
     RETURN_IF_ERROR(_open_file_reader());
     if (_read_json_by_line) {
         RETURN_IF_ERROR(_open_line_reader());
     }
 
-    // generate _parsed_jsonpaths and _parsed_json_root
-    RETURN_IF_ERROR(_parse_jsonpath_and_json_root());
-
     //improve performance
     if (_parsed_jsonpaths.empty() || _is_dynamic_schema) { // input is a simple json-string
         _vhandle_json_callback = _is_dynamic_schema ? &NewJsonReader::_vhandle_dynamic_json
@@ -1342,6 +1361,15 @@ size_t NewJsonReader::_column_index(const StringRef& name, size_t key_index) {
     }
 }
 
+void NewJsonReader::_pop_back_partial_row(Block& block, size_t num_rows) {
+    for (int i = 0; i < block.columns(); ++i) {
+        auto column = block.get_by_position(i).column->assume_mutable();
+        if (column->size() > num_rows) {
+            column->pop_back(column->size() - num_rows);
+        }
+    }
+}
+
 Status NewJsonReader::_simdjson_set_column_value(simdjson::ondemand::object* value, Block& block,
                                                  const std::vector<SlotDescriptor*>& slot_descs,
                                                  bool* valid) {
@@ -1359,11 +1387,16 @@ Status NewJsonReader::_simdjson_set_column_value(simdjson::ondemand::object* val
             // This key is not exist in slot desc, just ignore
             continue;
         }
+        if (_seen_columns[column_index]) {
+            // the duplicated key, only the first one is taken
+            continue;
+        }
         simdjson::ondemand::value val = field.value();
         auto* column_ptr = block.get_by_position(column_index).column->assume_mutable().get();
         RETURN_IF_ERROR(
                 _simdjson_write_data_to_column(val, slot_descs[column_index], column_ptr, valid));
         if (!(*valid)) {
+            _pop_back_partial_row(block, cur_row_count);
             return Status::OK();
         }
         _seen_columns[column_index] = true;
@@ -1385,6 +1418,13 @@ Status NewJsonReader::_simdjson_set_column_value(simdjson::ondemand::object* val
         if (!slot_desc->is_materialized()) {
             continue;
         }
+        if (!slot_desc->is_nullable()) {
+            RETURN_IF_ERROR(_append_error_msg(
+                    value, "The column `{}` is not nullable, but it's not found in jsondata.",
+                    slot_desc->col_name(), valid));
+            _pop_back_partial_row(block, cur_row_count);
+            return Status::OK();
+        }
         auto* column_ptr = block.get_by_position(i).column->assume_mutable().get();
         if (column_ptr->size() < cur_row_count + 1) {
             DCHECK(column_ptr->size() == cur_row_count);
@@ -1411,29 +1451,32 @@ Status NewJsonReader::_simdjson_write_data_to_column(simdjson::ondemand::value&
                                                      vectorized::IColumn* column, bool* valid) {
     // write
     vectorized::ColumnNullable* nullable_column = nullptr;
-    vectorized::IColumn* column_ptr = nullptr;
+    vectorized::IColumn* column_ptr = column;
     if (slot_desc->is_nullable()) {
         nullable_column = assert_cast<vectorized::ColumnNullable*>(column);
         column_ptr = &nullable_column->get_nested_column();
     }
-    // TODO: if the vexpr can support another 'slot_desc type' than 'TYPE_VARCHAR',
-    // we need use a function to support these types to insert data in columns.
-    ColumnString* column_string = assert_cast<ColumnString*>(column_ptr);
-    switch (value.type()) {
-    case simdjson::ondemand::json_type::null: {
-        if (column->is_nullable()) {
-            // insert_default already push 1 to null_map
-            nullable_column->insert_default();
-        } else {
+    auto json_type = value.type().value();
+    if (json_type == simdjson::ondemand::json_type::null) {
+        if (nullable_column == nullptr) {
             RETURN_IF_ERROR(_append_error_msg(
                     nullptr, "Json value is null, but the column `{}` is not nullable.",
                     slot_desc->col_name(), valid));
             return Status::OK();
         }
-        break;
+        // insert_default already push 1 to null_map
+        nullable_column->insert_default();
+        *valid = true;
+        return Status::OK();
     }
-    case simdjson::ondemand::json_type::boolean: {
+    if (nullable_column != nullptr) {
         nullable_column->get_null_map_data().push_back(0);
+    }
+    // TODO: if the vexpr can support another 'slot_desc type' than 'TYPE_VARCHAR',
+    // we need use a function to support these types to insert data in columns.
+    ColumnString* column_string = assert_cast<ColumnString*>(column_ptr);
+    switch (json_type) {
+    case simdjson::ondemand::json_type::boolean: {
         if (value.get_bool()) {
             column_string->insert_data("1", 1);
         } else {
@@ -1441,15 +1484,16 @@ Status NewJsonReader::_simdjson_write_data_to_column(simdjson::ondemand::value&
         }
         break;
     }
+    case simdjson::ondemand::json_type::string: {
+        // unescape the string, it's copied to the string buffer of the parser
+        std::string_view str_view = value.get_string();
+        column_string->insert_data(str_view.data(), str_view.length());
+        break;
+    }
     default: {
+        // number, array and object, they are written as the raw json text,
+        // and the nested ones are converted to the complex column types later
         auto str_view = simdjson::to_json_string(value).value();
-        if (value.type() == simdjson::ondemand::json_type::string) {
-            nullable_column->get_null_map_data().push_back(0);
-            // trim
-            column_string->insert_data(str_view.data() + 1, str_view.length() - 2);
-            break;
-        }
-        nullable_column->get_null_map_data().push_back(0);
         column_string->insert_data(str_view.data(), str_view.length());
     }
     }
@@ -1513,8 +1557,20 @@ Status NewJsonReader::_simdjson_parse_json_doc(size_t* size, bool* eof) {
     SCOPED_TIMER(_file_read_timer);
     const uint8_t* json_str = nullptr;
     std::unique_ptr<uint8_t[]> json_str_ptr;
+    ByteBufferPtr json_buf;
     if (_line_reader != nullptr) {
         RETURN_IF_ERROR(_line_reader->read_line(&json_str, size, eof, _io_ctx));
+    } else if (_params.file_type == TFileType::FILE_STREAM) {
+        // the message is copied into the padding buffer below anyway, so it's taken from the
+        // pipe without another copy
+        RETURN_IF_ERROR((dynamic_cast<io::StreamLoadPipe*>(_file_reader.get()))
+                                ->read_one_message(&json_buf));
+        *size = json_buf == nullptr ? 0 : json_buf->remaining();
+        if (*size == 0) {
+            *eof = true;
+        } else {
+            json_str = reinterpret_cast<const uint8_t*>(json_buf->ptr + json_buf->pos);
+        }
     } else {
         size_t length = 0;
         RETURN_IF_ERROR(_read_one_message(&json_str_ptr, &length));
@@ -1623,12 +1679,14 @@ Status NewJsonReader::_simdjson_write_columns_by_jsonpath(
                 RETURN_IF_ERROR(_append_error_msg(
                         value, "The column `{}` is not nullable, but it's not found in jsondata.",
                         slot_descs[i]->col_name(), valid));
+                _pop_back_partial_row(block, cur_row_count);
                 return Status::OK();
             }
         } else {
             RETURN_IF_ERROR(
                     _simdjson_write_data_to_column(json_value, slot_descs[i], column_ptr, valid));
             if (!(*valid)) {
+                _pop_back_partial_row(block, cur_row_count);
                 return Status::OK();
             }
             has_valid_value = true;
@@ -110,6 +110,8 @@ private:
     Status _read_one_message(std::unique_ptr<uint8_t[]>* file_buf, size_t* read_size);
 
     // simdjson, replace none simdjson function if it is ready
+    // return false if the jsonpaths or json_root can not be extracted by simdjson
+    bool _simdjson_support_jsonpaths() const;
     Status _simdjson_init_reader();
     Status _simdjson_parse_json(bool* is_empty_row, bool* eof);
     Status _simdjson_parse_json_doc(size_t* size, bool* eof);
@@ -136,6 +138,8 @@ private:
     Status _simdjson_write_columns_by_jsonpath(simdjson::ondemand::object* value,
                                                const std::vector<SlotDescriptor*>& slot_descs,
                                                Block& block, bool* valid);
+    // remove the values of an invalid row which were written before it's found invalid
+    void _pop_back_partial_row(Block& block, size_t num_rows);
     Status _append_error_msg(simdjson::ondemand::object* obj, std::string error_msg,
                              std::string col_name, bool* valid);
 
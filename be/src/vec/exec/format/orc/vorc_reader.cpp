@@ -24,14 +24,20 @@
 #include "gutil/strings/substitute.h"
 #include "io/fs/file_reader.h"
 #include "olap/iterators.h"
+#include "util/simd/bits.h"
 #include "util/slice.h"
 #include "vec/columns/column_array.h"
+#include "vec/columns/column_const.h"
 #include "vec/columns/column_map.h"
 #include "vec/columns/column_struct.h"
 #include "vec/data_types/data_type_array.h"
 #include "vec/data_types/data_type_map.h"
 #include "vec/data_types/data_type_nullable.h"
 #include "vec/data_types/data_type_struct.h"
+#include "vec/exprs/vbloom_predicate.h"
+#include "vec/exprs/vin_predicate.h"
+#include "vec/exprs/vruntimefilter_wrapper.h"
+#include "vec/exprs/vslot_ref.h"
 
 namespace doris::vectorized {
 
@@ -125,8 +131,10 @@ void OrcReader::_collect_profile_on_close() {
         COUNTER_UPDATE(_orc_profile.column_read_time, _statistics.column_read_time);
         COUNTER_UPDATE(_orc_profile.get_batch_time, _statistics.get_batch_time);
         COUNTER_UPDATE(_orc_profile.parse_meta_time, _statistics.parse_meta_time);
+        COUNTER_UPDATE(_orc_profile.meta_cache_hit, _statistics.meta_cache_hit);
         COUNTER_UPDATE(_orc_profile.decode_value_time, _statistics.decode_value_time);
         COUNTER_UPDATE(_orc_profile.decode_null_map_time, _statistics.decode_null_map_time);
+        COUNTER_UPDATE(_orc_profile.lazy_read_filtered_rows, _statistics.lazy_read_filtered_rows);
     }
 }
 
@@ -144,9 +152,13 @@ void OrcReader::_init_profile() {
         _orc_profile.column_read_time = ADD_CHILD_TIMER(_profile, "ColumnReadTime", orc_profile);
         _orc_profile.get_batch_time = ADD_CHILD_TIMER(_profile, "GetBatchTime", orc_profile);
         _orc_profile.parse_meta_time = ADD_CHILD_TIMER(_profile, "ParseMetaTime", orc_profile);
+        _orc_profile.meta_cache_hit =
+                ADD_CHILD_COUNTER(_profile, "FileMetaCacheHit", TUnit::UNIT, orc_profile);
         _orc_profile.decode_value_time = ADD_CHILD_TIMER(_profile, "DecodeValueTime", orc_profile);
         _orc_profile.decode_null_map_time =
                 ADD_CHILD_TIMER(_profile, "DecodeNullMapTime", orc_profile);
+        _orc_profile.lazy_read_filtered_rows =
+                ADD_CHILD_COUNTER(_profile, "FilteredRowsByLazyRead", TUnit::UNIT, orc_profile);
     }
 }
 
@@ -161,11 +173,31 @@ Status OrcReader::_create_file_reader() {
     if (_file_input_stream->getLength() == 0) {
         return Status::EndOfFile("empty orc file: " + _scan_range.path);
     }
+    // The serialized file tail has the footer and the stripe metadata, with it the orc reader
+    // doesn't read them from the file.
+    std::string meta_cache_key;
+    if (FileMetaCache::instance() != nullptr) {
+        meta_cache_key =
+                FileMetaCache::get_key("orc", _scan_range, _file_input_stream->getLength());
+    }
+    FileMetaCache::Handle meta_cache_handle;
+    bool meta_cache_hit = !meta_cache_key.empty() &&
+                          FileMetaCache::instance()->lookup(meta_cache_key, &meta_cache_handle);
     // create orc reader
     try {
         orc::ReaderOptions options;
+        if (meta_cache_hit) {
+            options.setSerializedFileTail(*meta_cache_handle.data<std::string>());
+            ++_statistics.meta_cache_hit;
+        }
         _reader = orc::createReader(
                 std::unique_ptr<ORCFileInputStream>(_file_input_stream.release()), options);
+        if (!meta_cache_key.empty() && !meta_cache_hit) {
+            auto* file_tail = new std::string(_reader->getSerializedFileTail());
+            FileMetaCache::instance()->insert(meta_cache_key, file_tail,
+                                              sizeof(std::string) + file_tail->size(),
+                                              &meta_cache_handle);
+        }
     } catch (std::exception& e) {
         return Status::InternalError("Init OrcReader failed. reason = {}", e.what());
     }
@@ -173,7 +205,13 @@ Status OrcReader::_create_file_reader() {
 }
 
 Status OrcReader::init_reader(
-        std::unordered_map<std::string, ColumnValueRangeType>* colname_to_value_range) {
+        std::unordered_map<std::string, ColumnValueRangeType>* colname_to_value_range,
+        VExprContext* vconjunct_ctx,
+        const std::vector<VExprContext*>* not_single_slot_filter_conjuncts,
+        const std::unordered_map<int, std::vector<VExprContext*>>* slot_id_to_filter_conjuncts) {
+    _lazy_read_ctx.vconjunct_ctx = vconjunct_ctx;
+    _not_single_slot_filter_conjuncts = not_single_slot_filter_conjuncts;
+    _slot_id_to_filter_conjuncts = slot_id_to_filter_conjuncts;
     SCOPED_RAW_TIMER(&_statistics.parse_meta_time);
     RETURN_IF_ERROR(_create_file_reader());
     // _init_bloom_filter(colname_to_value_range);
@@ -183,15 +221,24 @@ Status OrcReader::init_reader(
     _row_reader_options.setTimezoneName(_ctz);
     RETURN_IF_ERROR(_init_read_columns());
     _init_search_argument(colname_to_value_range);
-    _row_reader_options.include(_read_cols);
+    return _create_row_reader(_read_cols, &_row_reader, &_batch, &_colname_to_idx, &_col_orc_type);
+}
+
+Status OrcReader::_create_row_reader(const std::list<std::string>& orc_columns,
+                                     std::unique_ptr<orc::RowReader>* row_reader,
+                                     std::unique_ptr<orc::ColumnVectorBatch>* batch,
+                                     std::unordered_map<std::string, int>* colname_to_idx,
+                                     std::vector<const orc::Type*>* col_orc_type) {
+    _row_reader_options.include(orc_columns);
     try {
-        _row_reader = _reader->createRowReader(_row_reader_options);
-        _batch = _row_reader->createRowBatch(_batch_size);
+        *row_reader = _reader->createRowReader(_row_reader_options);
+        *batch = (*row_reader)->createRowBatch(_batch_size);
     } catch (std::exception& e) {
         return Status::InternalError("Failed to create orc row reader. reason = {}", e.what());
     }
-    auto& selected_type = _row_reader->getSelectedType();
-    _col_orc_type.resize(selected_type.getSubtypeCount());
+    auto& selected_type = (*row_reader)->getSelectedType();
+    colname_to_idx->clear();
+    col_orc_type->resize(selected_type.getSubtypeCount());
     for (int i = 0; i < selected_type.getSubtypeCount(); ++i) {
         std::string name;
         // For hive engine, translate the column name in orc file to schema column name.
@@ -201,9 +248,178 @@ Status OrcReader::init_reader(
         } else {
             name = _get_field_name_lower_case(&selected_type, i);
         }
-        _colname_to_idx[name] = i;
-        _col_orc_type[i] = selected_type.getSubtype(i);
+        (*colname_to_idx)[name] = i;
+        (*col_orc_type)[i] = selected_type.getSubtype(i);
+    }
+    return Status::OK();
+}
+
+Status OrcReader::set_fill_columns(
+        const std::unordered_map<std::string, std::tuple<std::string, const SlotDescriptor*>>&
+                partition_columns,
+        const std::unordered_map<std::string, VExprContext*>& missing_columns) {
+    SCOPED_RAW_TIMER(&_statistics.parse_meta_time);
+    // std::unordered_map<column_name, std::pair<col_id, slot_id>>
+    std::unordered_map<std::string, std::pair<uint32_t, int>> predicate_columns;
+    std::function<void(VExpr * expr)> visit_slot = [&](VExpr* expr) {
+        if (VSlotRef* slot_ref = typeid_cast<VSlotRef*>(expr)) {
+            predicate_columns.emplace(slot_ref->expr_name(),
+                                      std::make_pair(slot_ref->column_id(), slot_ref->slot_id()));
+            if (slot_ref->column_id() == 0) {
+                _lazy_read_ctx.resize_first_column = false;
+            }
+            return;
+        } else if (VRuntimeFilterWrapper* runtime_filter =
+                           typeid_cast<VRuntimeFilterWrapper*>(expr)) {
+            VExpr* filter_impl = const_cast<VExpr*>(runtime_filter->get_impl());
+            if (VBloomPredicate* bloom_predicate = typeid_cast<VBloomPredicate*>(filter_impl)) {
+                for (VExpr* child : bloom_predicate->children()) {
+                    visit_slot(child);
+                }
+            } else if (VInPredicate* in_predicate = typeid_cast<VInPredicate*>(filter_impl)) {
+                if (in_predicate->children().size() > 0) {
+                    visit_slot(in_predicate->children()[0]);
+                }
+            } else {
+                for (VExpr* child : filter_impl->children()) {
+                    visit_slot(child);
+                }
+            }
+        } else {
+            for (VExpr* child : expr->children()) {
+                visit_slot(child);
+            }
+        }
+    };
+    if (_lazy_read_ctx.vconjunct_ctx != nullptr) {
+        visit_slot(_lazy_read_ctx.vconjunct_ctx->root());
+    }
+
+    bool has_complex_type = false;
+    auto orc_col = _read_cols.begin();
+    for (auto& col : _read_cols_lower_case) {
+        auto kind = _col_orc_type[_colname_to_idx[col]]->getKind();
+        if (kind == orc::TypeKind::LIST || kind == orc::TypeKind::MAP ||
+            kind == orc::TypeKind::STRUCT) {
+            has_complex_type = true;
+        }
+        auto iter = predicate_columns.find(col);
+        if (iter == predicate_columns.end()) {
+            _lazy_read_ctx.lazy_read_columns.emplace_back(col);
+            _lazy_read_ctx.lazy_read_orc_columns.emplace_back(*orc_col);
+        } else {
+            _lazy_read_ctx.predicate_columns.emplace_back(col);
+            _lazy_read_ctx.predicate_orc_columns.emplace_back(*orc_col);
+            _lazy_read_ctx.all_predicate_col_ids.emplace_back(iter->second.first);
+        }
+        ++orc_col;
+    }
+
+    for (auto& kv : partition_columns) {
+        auto iter = predicate_columns.find(kv.first);
+        if (iter == predicate_columns.end()) {
+            _lazy_read_ctx.partition_columns.emplace(kv.first, kv.second);
+        } else {
+            _lazy_read_ctx.predicate_partition_columns.emplace(kv.first, kv.second);
+            _lazy_read_ctx.all_predicate_col_ids.emplace_back(iter->second.first);
+        }
+    }
+
+    for (auto& kv : missing_columns) {
+        auto iter = predicate_columns.find(kv.first);
+        if (iter == predicate_columns.end()) {
+            _lazy_read_ctx.missing_columns.emplace(kv.first, kv.second);
+        } else {
+            _lazy_read_ctx.predicate_missing_columns.emplace(kv.first, kv.second);
+            _lazy_read_ctx.all_predicate_col_ids.emplace_back(iter->second.first);
+        }
+    }
+
+    if (!has_complex_type && _lazy_read_ctx.predicate_columns.size() > 0 &&
+        _lazy_read_ctx.lazy_read_columns.size() > 0) {
+        _lazy_read_ctx.can_lazy_read = true;
+    }
+
+    if (_lazy_read_ctx.can_lazy_read) {
+        _init_dict_filter_columns(predicate_columns);
+        RETURN_IF_ERROR(_init_lazy_read());
+    } else {
+        for (auto& kv : _lazy_read_ctx.predicate_partition_columns) {
+            _lazy_read_ctx.partition_columns.emplace(kv.first, kv.second);
+        }
+        for (auto& kv : _lazy_read_ctx.predicate_missing_columns) {
+            _lazy_read_ctx.missing_columns.emplace(kv.first, kv.second);
+        }
+    }
+
+    _text_converter.reset(new TextConverter('\\'));
+    _fill_all_columns = true;
+    return Status::OK();
+}
+
+void OrcReader::_init_dict_filter_columns(
+        const std::unordered_map<std::string, std::pair<uint32_t, int>>& predicate_columns) {
+    if (_slot_id_to_filter_conjuncts == nullptr) {
+        _filter_conjuncts.push_back(_lazy_read_ctx.vconjunct_ctx);
+        return;
+    }
+    // The dictionaries are only in the stripes of STRING and VARCHAR columns, CHAR values are
+    // trimmed after they are read.
+    std::unordered_set<int> dict_filter_slots;
+    for (auto& col : _lazy_read_ctx.predicate_columns) {
+        auto kind = _col_orc_type[_colname_to_idx[col]]->getKind();
+        int slot_id = predicate_columns.at(col).second;
+        if ((kind == orc::TypeKind::STRING || kind == orc::TypeKind::VARCHAR) &&
+            _slot_id_to_filter_conjuncts->find(slot_id) != _slot_id_to_filter_conjuncts->end()) {
+            _dict_filter_cols.push_back({col, slot_id, nullptr, {}});
+            dict_filter_slots.insert(slot_id);
+        }
+    }
+    if (_dict_filter_cols.empty()) {
+        _filter_conjuncts.push_back(_lazy_read_ctx.vconjunct_ctx);
+        return;
+    }
+    if (_not_single_slot_filter_conjuncts != nullptr) {
+        _filter_conjuncts.insert(_filter_conjuncts.end(),
+                                 _not_single_slot_filter_conjuncts->begin(),
+                                 _not_single_slot_filter_conjuncts->end());
+    }
+    for (auto& kv : *_slot_id_to_filter_conjuncts) {
+        if (dict_filter_slots.find(kv.first) == dict_filter_slots.end()) {
+            _filter_conjuncts.insert(_filter_conjuncts.end(), kv.second.begin(), kv.second.end());
+        }
+    }
+    // The string columns are returned as the dictionary indexes, if they are dictionary encoded.
+    _row_reader_options.setEnableLazyDecoding(true);
+}
+
+Status OrcReader::_init_lazy_read() {
+    RETURN_IF_ERROR(_create_row_reader(_lazy_read_ctx.predicate_orc_columns, &_row_reader,
+                                       &_batch, &_colname_to_idx, &_col_orc_type));
+    // The lazy read columns are positioned by the row numbers of the predicate batches, so
+    // the row groups are not skipped by the search argument in the lazy row reader.
+    _row_reader_options.searchArgument(nullptr);
+    _row_reader_options.setEnableLazyDecoding(false);
+    RETURN_IF_ERROR(_create_row_reader(_lazy_read_ctx.lazy_read_orc_columns, &_lazy_row_reader,
+                                       &_lazy_batch, &_lazy_colname_to_idx,
+                                       &_lazy_col_orc_type));
+    // The same stripes as RowReaderOptions::range() selects.
+    uint64_t first_row = 0;
+    for (uint64_t i = 0; i < _reader->getNumberOfStripes(); ++i) {
+        auto stripe = _reader->getStripe(i);
+        int64_t offset = stripe->getOffset();
+        if (offset >= _range_start_offset && offset < _range_start_offset + _range_size) {
+            if (_stripe_first_rows.empty()) {
+                _stripe_first_rows.push_back(first_row);
+            } else if (_stripe_first_rows.back() != first_row) {
+                return Status::Corruption("Discontinuous stripes in orc file {}",
+                                          _scan_range.path);
+            }
+            _stripe_first_rows.push_back(first_row + stripe->getNumberOfRows());
+        }
+        first_row += stripe->getNumberOfRows();
     }
+    _lazy_next_row = _stripe_first_rows.empty() ? 0 : _stripe_first_rows.front();
     return Status::OK();
 }
 
@@ -654,7 +870,24 @@ Status OrcReader::_decode_string_column(const std::string& col_name,
     }
     std::vector<StringRef> string_values;
     string_values.reserve(num_values);
-    if (type_kind == orc::TypeKind::CHAR) {
+    if (cvb->isEncoded) {
+        // The values of the dictionary encoded columns are in the dictionary,
+        // see RowReaderOptions::setEnableLazyDecoding().
+        auto* encoded = down_cast<orc::EncodedStringVectorBatch*>(cvb);
+        for (int i = 0; i < num_values; ++i) {
+            if (cvb->notNull[i]) {
+                char* value = nullptr;
+                int64_t length = 0;
+                encoded->dictionary->getValueByIndex(encoded->index[i], value, length);
+                if (type_kind == orc::TypeKind::CHAR) {
+                    length = trim_right(value, length);
+                }
+                string_values.emplace_back(value, length);
+            } else {
+                string_values.emplace_back(empty_string.data(), 0);
+            }
+        }
+    } else if (type_kind == orc::TypeKind::CHAR) {
         // Possibly there are some zero padding characters in CHAR type, we have to strip them off.
         for (int i = 0; i < num_values; ++i) {
             if (cvb->notNull[i]) {
@@ -848,6 +1081,9 @@ std::string OrcReader::_get_field_name_lower_case(const orc::Type* orc_type, int
 
 Status OrcReader::get_next_block(Block* block, size_t* read_rows, bool* eof) {
     SCOPED_RAW_TIMER(&_statistics.column_read_time);
+    if (_lazy_read_ctx.can_lazy_read) {
+        return _do_lazy_read(block, read_rows, eof);
+    }
     {
         SCOPED_RAW_TIMER(&_statistics.get_batch_time);
         if (!_row_reader->next(*_batch)) {
@@ -856,20 +1092,369 @@ Status OrcReader::get_next_block(Block* block, size_t* read_rows, bool* eof) {
             return Status::OK();
         }
     }
-    const auto& batch_vec = down_cast<orc::StructVectorBatch*>(_batch.get())->fields;
-    for (auto& col : _read_cols_lower_case) {
+    RETURN_IF_ERROR(_convert_columns(block, _read_cols_lower_case, _batch.get(), _colname_to_idx,
+                                     _col_orc_type));
+    *read_rows = _batch->numElements;
+    if (_fill_all_columns) {
+        RETURN_IF_ERROR(
+                _fill_partition_columns(block, *read_rows, _lazy_read_ctx.partition_columns));
+        RETURN_IF_ERROR(_fill_missing_columns(block, *read_rows, _lazy_read_ctx.missing_columns));
+        if (_lazy_read_ctx.vconjunct_ctx != nullptr) {
+            RETURN_IF_ERROR(VExprContext::filter_block(_lazy_read_ctx.vconjunct_ctx, block,
+                                                       block->columns()));
+            *read_rows = block->rows();
+        }
+    }
+    return Status::OK();
+}
+
+Status OrcReader::_convert_columns(Block* block, const std::list<std::string>& columns,
+                                   orc::ColumnVectorBatch* batch,
+                                   const std::unordered_map<std::string, int>& colname_to_idx,
+                                   const std::vector<const orc::Type*>& col_orc_type) {
+    const auto& batch_vec = down_cast<orc::StructVectorBatch*>(batch)->fields;
+    for (auto& col : columns) {
         auto& column_with_type_and_name = block->get_by_name(col);
         auto& column_ptr = column_with_type_and_name.column;
         auto& column_type = column_with_type_and_name.type;
-        auto orc_col_idx = _colname_to_idx.find(col);
-        if (orc_col_idx == _colname_to_idx.end()) {
+        auto orc_col_idx = colname_to_idx.find(col);
+        if (orc_col_idx == colname_to_idx.end()) {
             return Status::InternalError("Wrong read column '{}' in orc file", col);
         }
         RETURN_IF_ERROR(_orc_column_to_doris_column(
-                col, column_ptr, column_type, _col_orc_type[orc_col_idx->second],
-                batch_vec[orc_col_idx->second], _batch->numElements));
+                col, column_ptr, column_type, col_orc_type[orc_col_idx->second],
+                batch_vec[orc_col_idx->second], batch->numElements));
+    }
+    return Status::OK();
+}
+
+Status OrcReader::_do_lazy_read(Block* block, size_t* read_rows, bool* eof) {
+    size_t origin_column_num = block->columns();
+    size_t pre_read_rows = 0;
+    IColumn::Filter result_filter;
+    while (true) {
+        {
+            SCOPED_RAW_TIMER(&_statistics.get_batch_time);
+            if (!_row_reader->next(*_batch)) {
+                *eof = true;
+                *read_rows = 0;
+                return Status::OK();
+            }
+        }
+        pre_read_rows = _batch->numElements;
+        result_filter.assign(pre_read_rows, static_cast<unsigned char>(1));
+
+        // The rows filtered by the dictionaries are known before the predicate columns are
+        // converted, the batch is skipped if all of them are filtered.
+        std::vector<VExprContext*> batch_conjuncts = _filter_conjuncts;
+        const auto& batch_vec = down_cast<orc::StructVectorBatch*>(_batch.get())->fields;
+        for (auto& dict_col : _dict_filter_cols) {
+            RETURN_IF_ERROR(_filter_by_dict(block, dict_col,
+                                            batch_vec[_colname_to_idx[dict_col.col_name]],
+                                            &result_filter, &batch_conjuncts));
+        }
+        bool can_filter_all = !_dict_filter_cols.empty() &&
+                              simd::count_zero_num((int8_t*)result_filter.data(),
+                                                   pre_read_rows) == pre_read_rows;
+        if (can_filter_all) {
+            _statistics.lazy_read_filtered_rows += pre_read_rows;
+            continue;
+        }
+
+        RETURN_IF_ERROR(_convert_columns(block, _lazy_read_ctx.predicate_columns, _batch.get(),
+                                         _colname_to_idx, _col_orc_type));
+        RETURN_IF_ERROR(_fill_partition_columns(block, pre_read_rows,
+                                                _lazy_read_ctx.predicate_partition_columns));
+        RETURN_IF_ERROR(_fill_missing_columns(block, pre_read_rows,
+                                              _lazy_read_ctx.predicate_missing_columns));
+        if (_lazy_read_ctx.resize_first_column) {
+            // VExprContext.execute has an optimization, the filtering is executed when
+            // block->rows() > 0, so the first column is resized to the rows temporarily.
+            block->get_by_position(0).column->assume_mutable()->resize(pre_read_rows);
+        }
+        RETURN_IF_ERROR(_execute_conjuncts(batch_conjuncts, block, &result_filter,
+                                           &can_filter_all));
+        if (_lazy_read_ctx.resize_first_column) {
+            // We have to clean the first column to insert right data.
+            block->get_by_position(0).column->assume_mutable()->clear();
+        }
+        if (!can_filter_all) {
+            can_filter_all = simd::count_zero_num((int8_t*)result_filter.data(),
+                                                  pre_read_rows) == pre_read_rows;
+        }
+        if (!can_filter_all) {
+            break;
+        }
+        _statistics.lazy_read_filtered_rows += pre_read_rows;
+        for (auto& col_id : _lazy_read_ctx.all_predicate_col_ids) {
+            block->get_by_position(col_id).column->assume_mutable()->clear();
+        }
+        Block::erase_useless_column(block, origin_column_num);
+    }
+
+    uint64_t first_row = _row_reader->getRowNumber();
+    orc::ColumnVectorBatch* lazy_batch = nullptr;
+    RETURN_IF_ERROR(_seek_lazy_row_reader(first_row));
+    RETURN_IF_ERROR(_next_lazy_batch(pre_read_rows, &lazy_batch));
+    RETURN_IF_ERROR(_convert_columns(block, _lazy_read_ctx.lazy_read_columns, lazy_batch,
+                                     _lazy_colname_to_idx, _lazy_col_orc_type));
+
+    // All the columns read from the file and the predicate columns have pre_read_rows rows.
+    size_t column_size = pre_read_rows - simd::count_zero_num((int8_t*)result_filter.data(),
+                                                              pre_read_rows);
+    if (column_size != pre_read_rows) {
+        for (size_t i = 0; i < origin_column_num; ++i) {
+            auto& column = block->get_by_position(i).column;
+            if (column->size() != pre_read_rows) {
+                continue;
+            }
+            if (column->use_count() == 1) {
+                const auto result_size = column->assume_mutable()->filter(result_filter);
+                CHECK_EQ(result_size, column_size);
+            } else {
+                column = column->filter(result_filter, column_size);
+            }
+        }
+    }
+    Block::erase_useless_column(block, origin_column_num);
+    _statistics.lazy_read_filtered_rows += pre_read_rows - column_size;
+    *read_rows = column_size;
+    RETURN_IF_ERROR(_fill_partition_columns(block, column_size, _lazy_read_ctx.partition_columns));
+    return _fill_missing_columns(block, column_size, _lazy_read_ctx.missing_columns);
+}
+
+Status OrcReader::_filter_by_dict(Block* block, DictFilterColumn& dict_col,
+                                  orc::ColumnVectorBatch* cvb, IColumn::Filter* result_filter,
+                                  std::vector<VExprContext*>* batch_conjuncts) {
+    auto* encoded = dynamic_cast<orc::EncodedStringVectorBatch*>(cvb);
+    if (encoded == nullptr || !encoded->isEncoded || encoded->dictionary == nullptr ||
+        !is_string(remove_nullable(block->get_by_name(dict_col.col_name).type))) {
+        // Direct encoded stripe, evaluate the conjuncts on the values.
+        auto& ctxs = _slot_id_to_filter_conjuncts->at(dict_col.slot_id);
+        batch_conjuncts->insert(batch_conjuncts->end(), ctxs.begin(), ctxs.end());
+        return Status::OK();
+    }
+    if (encoded->dictionary != dict_col.dictionary) {
+        RETURN_IF_ERROR(_build_dict_filter(block, dict_col, encoded->dictionary));
+    }
+    const uint8_t* __restrict dict_filter = dict_col.filter.data();
+    const uint8_t null_filter = dict_col.filter.back();
+    const int64_t* __restrict index = encoded->index.data();
+    auto* __restrict result_filter_data = result_filter->data();
+    size_t num_values = encoded->numElements;
+    if (encoded->hasNulls) {
+        const char* not_null = encoded->notNull.data();
+        for (size_t i = 0; i < num_values; ++i) {
+            result_filter_data[i] &= not_null[i] ? dict_filter[index[i]] : null_filter;
+        }
+    } else {
+        for (size_t i = 0; i < num_values; ++i) {
+            result_filter_data[i] &= dict_filter[index[i]];
+        }
+    }
+    return Status::OK();
+}
+
+Status OrcReader::_build_dict_filter(Block* block, DictFilterColumn& dict_col,
+                                     std::shared_ptr<orc::StringDictionary> dictionary) {
+    // Build a temp block with the same columns as the block, and the dictionary entries in the
+    // dict filter column, then execute the conjuncts on it.
+    size_t dict_size = dictionary->dictionaryOffset.size() - 1;
+    Block temp_block = block->clone_empty();
+    size_t dict_pos = temp_block.get_position_by_name(dict_col.col_name);
+    auto& dict_column_with_type = temp_block.get_by_position(dict_pos);
+    MutableColumnPtr dict_column = std::move(*dict_column_with_type.column).mutate();
+    size_t temp_rows = dict_size;
+    for (size_t i = 0; i < dict_size; ++i) {
+        char* value = nullptr;
+        int64_t length = 0;
+        dictionary->getValueByIndex(i, value, length);
+        dict_column->insert_data(value, length);
+    }
+    if (dict_column->is_nullable()) {
+        dict_column->insert_default();
+        ++temp_rows;
+    }
+    dict_column_with_type.column = std::move(dict_column);
+    if (dict_pos != 0) {
+        // VExprContext.execute has an optimization, the filtering is executed when
+        // block->rows() > 0, so the first column is resized to the rows.
+        temp_block.get_by_position(0).column->assume_mutable()->resize(temp_rows);
+    }
+
+    IColumn::Filter filter(temp_rows, 1);
+    bool can_filter_all = false;
+    RETURN_IF_ERROR(_execute_conjuncts(_slot_id_to_filter_conjuncts->at(dict_col.slot_id),
+                                       &temp_block, &filter, &can_filter_all));
+    if (can_filter_all) {
+        memset(filter.data(), 0, temp_rows);
+    }
+    dict_col.filter.assign(filter.begin(), filter.end());
+    if (temp_rows == dict_size) {
+        // not nullable, the null filter is never used
+        dict_col.filter.push_back(0);
+    }
+    dict_col.dictionary = std::move(dictionary);
+    return Status::OK();
+}
+
+Status OrcReader::_execute_conjuncts(const std::vector<VExprContext*>& ctxs, Block* block,
+                                     IColumn::Filter* result_filter, bool* can_filter_all) {
+    *can_filter_all = false;
+    auto* __restrict result_filter_data = result_filter->data();
+    for (auto* ctx : ctxs) {
+        int result_column_id = -1;
+        RETURN_IF_ERROR(ctx->execute(block, &result_column_id));
+        ColumnPtr& filter_column = block->get_by_position(result_column_id).column;
+        if (auto* nullable_column = check_and_get_column<ColumnNullable>(*filter_column)) {
+            size_t column_size = nullable_column->size();
+            if (column_size == 0) {
+                *can_filter_all = true;
+                return Status::OK();
+            } else {
+                const ColumnPtr& nested_column = nullable_column->get_nested_column_ptr();
+                const IColumn::Filter& filter =
+                        assert_cast<const ColumnUInt8&>(*nested_column).get_data();
+                auto* __restrict filter_data = filter.data();
+                const size_t size = filter.size();
+                auto* __restrict null_map_data = nullable_column->get_null_map_data().data();
+
+                for (size_t i = 0; i < size; ++i) {
+                    result_filter_data[i] &= (!null_map_data[i]) & filter_data[i];
+                }
+                if (memchr(filter_data, 0x1, size) == nullptr) {
+                    *can_filter_all = true;
+                    return Status::OK();
+                }
+            }
+        } else if (auto* const_column = check_and_get_column<ColumnConst>(*filter_column)) {
+            // filter all
+            if (!const_column->get_bool(0)) {
+                *can_filter_all = true;
+                return Status::OK();
+            }
+        } else {
+            const IColumn::Filter& filter =
+                    assert_cast<const ColumnUInt8&>(*filter_column).get_data();
+            auto* __restrict filter_data = filter.data();
+
+            const size_t size = filter.size();
+            for (size_t i = 0; i < size; ++i) {
+                result_filter_data[i] &= filter_data[i];
+            }
+
+            if (memchr(filter_data, 0x1, size) == nullptr) {
+                *can_filter_all = true;
+                return Status::OK();
+            }
+        }
+    }
+    return Status::OK();
+}
+
+Status OrcReader::_seek_lazy_row_reader(uint64_t row) {
+    if (row == _lazy_next_row) {
+        return Status::OK();
+    }
+    // The rows are skipped by reading them if they are in the same stripe and row group,
+    // because seekToRow() reloads the stripe.
+    auto stripe_of = [&](uint64_t r) {
+        return std::upper_bound(_stripe_first_rows.begin(), _stripe_first_rows.end(), r);
+    };
+    uint64_t stride = _reader->getRowIndexStride();
+    if (row < _lazy_next_row || (stride != 0 && row - _lazy_next_row >= stride) ||
+        stripe_of(row) != stripe_of(_lazy_next_row)) {
+        try {
+            _lazy_row_reader->seekToRow(row);
+        } catch (std::exception& e) {
+            return Status::InternalError("Failed to seek to row {} in orc file {}: {}", row,
+                                         _scan_range.path, e.what());
+        }
+        _lazy_next_row = row;
+        return Status::OK();
+    }
+    while (_lazy_next_row < row) {
+        orc::ColumnVectorBatch* batch = nullptr;
+        RETURN_IF_ERROR(_next_lazy_batch(std::min<uint64_t>(row - _lazy_next_row, _batch_size),
+                                         &batch));
+    }
+    return Status::OK();
+}
+
+Status OrcReader::_next_lazy_batch(size_t num_rows, orc::ColumnVectorBatch** batch) {
+    SCOPED_RAW_TIMER(&_statistics.get_batch_time);
+    // The row reader reads at most the capacity of the batch.
+    *batch = _lazy_batch.get();
+    try {
+        if (num_rows < _lazy_batch->capacity) {
+            _lazy_tail_batch = _lazy_row_reader->createRowBatch(num_rows);
+            *batch = _lazy_tail_batch.get();
+        }
+        if (!_lazy_row_reader->next(**batch) || (*batch)->numElements != num_rows ||
+            _lazy_row_reader->getRowNumber() != _lazy_next_row) {
+            return Status::Corruption(
+                    "Can't read the same rows when doing lazy read at row {} in orc file {}",
+                    _lazy_next_row, _scan_range.path);
+        }
+    } catch (std::exception& e) {
+        return Status::InternalError("Failed to read orc file {}: {}", _scan_range.path,
+                                     e.what());
+    }
+    _lazy_next_row += num_rows;
+    return Status::OK();
+}
+
+Status OrcReader::_fill_partition_columns(
+        Block* block, size_t rows,
+        const std::unordered_map<std::string, std::tuple<std::string, const SlotDescriptor*>>&
+                partition_columns) {
+    for (auto& kv : partition_columns) {
+        auto doris_column = block->get_by_name(kv.first).column;
+        IColumn* col_ptr = const_cast<IColumn*>(doris_column.get());
+        auto& [value, slot_desc] = kv.second;
+        if (!_text_converter->write_vec_column(slot_desc, col_ptr, const_cast<char*>(value.c_str()),
+                                               value.size(), true, false, rows)) {
+            return Status::InternalError("Failed to fill partition column: {}={}",
+                                         slot_desc->col_name(), value);
+        }
+    }
+    return Status::OK();
+}
+
+Status OrcReader::_fill_missing_columns(
+        Block* block, size_t rows,
+        const std::unordered_map<std::string, VExprContext*>& missing_columns) {
+    for (auto& kv : missing_columns) {
+        if (kv.second == nullptr) {
+            // no default column, fill with null
+            auto nullable_column = reinterpret_cast<vectorized::ColumnNullable*>(
+                    (*std::move(block->get_by_name(kv.first).column)).mutate().get());
+            nullable_column->insert_many_defaults(rows);
+        } else {
+            // fill with default value
+            auto* ctx = kv.second;
+            auto origin_column_num = block->columns();
+            int result_column_id = -1;
+            // PT1 => dest primitive type
+            RETURN_IF_ERROR(ctx->execute(block, &result_column_id));
+            bool is_origin_column = result_column_id < origin_column_num;
+            if (!is_origin_column) {
+                // call resize because the first column of the block may not be filled by reader,
+                // so block->rows() may return wrong result, cause the column created by
+                // `ctx->execute()` has only one row.
+                std::move(*block->get_by_position(result_column_id).column).mutate()->resize(rows);
+                auto result_column_ptr = block->get_by_position(result_column_id).column;
+                // result_column_ptr maybe a ColumnConst, convert it to a normal column
+                result_column_ptr = result_column_ptr->convert_to_full_column_if_const();
+                auto origin_column_type = block->get_by_name(kv.first).type;
+                bool is_nullable = origin_column_type->is_nullable();
+                block->replace_by_position(
+                        block->get_position_by_name(kv.first),
+                        is_nullable ? make_nullable(result_column_ptr) : result_column_ptr);
+                block->erase(result_column_id);
+            }
+        }
     }
-    *read_rows = _batch->numElements;
     return Status::OK();
 }
 
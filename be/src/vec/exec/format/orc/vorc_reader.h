@@ -21,13 +21,16 @@
 
 #include "common/config.h"
 #include "exec/olap_common.h"
+#include "exec/text_converter.h"
 #include "io/file_factory.h"
 #include "io/fs/file_reader.h"
 #include "vec/columns/column_array.h"
 #include "vec/core/block.h"
 #include "vec/data_types/data_type_decimal.h"
+#include "vec/exec/format/file_meta_cache.h"
 #include "vec/exec/format/format_common.h"
 #include "vec/exec/format/generic_reader.h"
+#include "vec/exprs/vexpr_context.h"
 
 namespace doris::vectorized {
 
@@ -41,8 +44,10 @@ public:
         int64_t column_read_time = 0;
         int64_t get_batch_time = 0;
         int64_t parse_meta_time = 0;
+        int64_t meta_cache_hit = 0;
         int64_t decode_value_time = 0;
         int64_t decode_null_map_time = 0;
+        int64_t lazy_read_filtered_rows = 0;
     };
 
     OrcReader(RuntimeProfile* profile, const TFileScanRangeParams& params,
@@ -55,8 +60,19 @@ public:
 
     ~OrcReader() override;
 
+    // vconjunct_ctx is evaluated by the reader when it is set, and the conjuncts split by slot
+    // are used to filter the string predicate columns by their dictionaries.
     Status init_reader(
-            std::unordered_map<std::string, ColumnValueRangeType>* colname_to_value_range);
+            std::unordered_map<std::string, ColumnValueRangeType>* colname_to_value_range,
+            VExprContext* vconjunct_ctx = nullptr,
+            const std::vector<VExprContext*>* not_single_slot_filter_conjuncts = nullptr,
+            const std::unordered_map<int, std::vector<VExprContext*>>* slot_id_to_filter_conjuncts =
+                    nullptr);
+
+    Status set_fill_columns(
+            const std::unordered_map<std::string, std::tuple<std::string, const SlotDescriptor*>>&
+                    partition_columns,
+            const std::unordered_map<std::string, VExprContext*>& missing_columns) override;
 
     Status get_next_block(Block* block, size_t* read_rows, bool* eof) override;
 
@@ -79,8 +95,46 @@ private:
         RuntimeProfile::Counter* column_read_time;
         RuntimeProfile::Counter* get_batch_time;
         RuntimeProfile::Counter* parse_meta_time;
+        RuntimeProfile::Counter* meta_cache_hit;
         RuntimeProfile::Counter* decode_value_time;
         RuntimeProfile::Counter* decode_null_map_time;
+        RuntimeProfile::Counter* lazy_read_filtered_rows;
+    };
+
+    // The predicate columns are read by _row_reader, and the other columns are read by
+    // _lazy_row_reader only for the batches that have rows left after the conjuncts are applied.
+    struct LazyReadContext {
+        VExprContext* vconjunct_ctx = nullptr;
+        bool can_lazy_read = false;
+        // block->rows() returns the number of rows of the first column,
+        // so we should check and resize the first column
+        bool resize_first_column = true;
+        // names in the block, and the orc column names to include in the row readers
+        std::list<std::string> predicate_columns;
+        std::list<std::string> predicate_orc_columns;
+        std::list<std::string> lazy_read_columns;
+        std::list<std::string> lazy_read_orc_columns;
+        // include predicate_partition_columns & predicate_missing_columns
+        std::vector<uint32_t> all_predicate_col_ids;
+        std::unordered_map<std::string, std::tuple<std::string, const SlotDescriptor*>>
+                predicate_partition_columns;
+        // lazy read partition columns or all partition columns
+        std::unordered_map<std::string, std::tuple<std::string, const SlotDescriptor*>>
+                partition_columns;
+        std::unordered_map<std::string, VExprContext*> predicate_missing_columns;
+        // lazy read missing columns or all missing columns
+        std::unordered_map<std::string, VExprContext*> missing_columns;
+    };
+
+    // A string predicate column whose single slot conjuncts are evaluated once for each stripe
+    // dictionary, instead of for each row.
+    struct DictFilterColumn {
+        std::string col_name;
+        int slot_id;
+        // the dictionary that filter is built from
+        std::shared_ptr<orc::StringDictionary> dictionary;
+        // whether the conjuncts pass for each dictionary entry, the last one is for null
+        std::vector<uint8_t> filter;
     };
 
     // Create inner orc file,
@@ -90,6 +144,35 @@ private:
 
     void _init_profile();
     Status _init_read_columns();
+    Status _create_row_reader(const std::list<std::string>& orc_columns,
+                              std::unique_ptr<orc::RowReader>* row_reader,
+                              std::unique_ptr<orc::ColumnVectorBatch>* batch,
+                              std::unordered_map<std::string, int>* colname_to_idx,
+                              std::vector<const orc::Type*>* col_orc_type);
+    Status _init_lazy_read();
+    void _init_dict_filter_columns(
+            const std::unordered_map<std::string, std::pair<uint32_t, int>>& predicate_columns);
+    Status _convert_columns(Block* block, const std::list<std::string>& columns,
+                            orc::ColumnVectorBatch* batch,
+                            const std::unordered_map<std::string, int>& colname_to_idx,
+                            const std::vector<const orc::Type*>& col_orc_type);
+    Status _do_lazy_read(Block* block, size_t* read_rows, bool* eof);
+    Status _filter_by_dict(Block* block, DictFilterColumn& dict_col, orc::ColumnVectorBatch* cvb,
+                           IColumn::Filter* result_filter,
+                           std::vector<VExprContext*>* batch_conjuncts);
+    Status _build_dict_filter(Block* block, DictFilterColumn& dict_col,
+                              std::shared_ptr<orc::StringDictionary> dictionary);
+    Status _execute_conjuncts(const std::vector<VExprContext*>& ctxs, Block* block,
+                              IColumn::Filter* result_filter, bool* can_filter_all);
+    Status _seek_lazy_row_reader(uint64_t row);
+    Status _next_lazy_batch(size_t num_rows, orc::ColumnVectorBatch** batch);
+    Status _fill_partition_columns(
+            Block* block, size_t rows,
+            const std::unordered_map<std::string, std::tuple<std::string, const SlotDescriptor*>>&
+                    partition_columns);
+    Status _fill_missing_columns(
+            Block* block, size_t rows,
+            const std::unordered_map<std::string, VExprContext*>& missing_columns);
     TypeDescriptor _convert_to_doris_type(const orc::Type* orc_type);
     void _init_search_argument(
             std::unordered_map<std::string, ColumnValueRangeType>* colname_to_value_range);
@@ -279,6 +362,26 @@ private:
 
     io::IOContext* _io_ctx;
 
+    LazyReadContext _lazy_read_ctx;
+    const std::vector<VExprContext*>* _not_single_slot_filter_conjuncts = nullptr;
+    const std::unordered_map<int, std::vector<VExprContext*>>* _slot_id_to_filter_conjuncts =
+            nullptr;
+    // the conjuncts evaluated on the converted predicate columns
+    std::vector<VExprContext*> _filter_conjuncts;
+    std::vector<DictFilterColumn> _dict_filter_cols;
+    std::unique_ptr<TextConverter> _text_converter;
+
+    std::unique_ptr<orc::RowReader> _lazy_row_reader;
+    std::unique_ptr<orc::ColumnVectorBatch> _lazy_batch;
+    // for the batches that are shorter than _lazy_batch
+    std::unique_ptr<orc::ColumnVectorBatch> _lazy_tail_batch;
+    std::unordered_map<std::string, int> _lazy_colname_to_idx;
+    std::vector<const orc::Type*> _lazy_col_orc_type;
+    // the row in file that _lazy_row_reader reads next
+    uint64_t _lazy_next_row = 0;
+    // the first rows of the stripes in the range, and the end row of the last one
+    std::vector<uint64_t> _stripe_first_rows;
+
     // only for decimal
     DecimalScaleParams _decimal_scale_params;
 };
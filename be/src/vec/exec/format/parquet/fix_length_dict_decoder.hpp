@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "util/simd/gather.h"
 #include "vec/columns/column_dictionary.h"
 #include "vec/columns/column_nullable.h"
 #include "vec/data_types/data_type_nullable.h"
@@ -174,9 +175,17 @@ protected:
         while (size_t run_length = select_vector.get_next_run(&read_type)) {
             switch (read_type) {
             case ColumnSelectVector::CONTENT: {
-                for (size_t i = 0; i < run_length; ++i) {
-                    column_data[data_index++] =
-                            static_cast<Numeric>(_dict_items[_indexes[dict_index++]]);
+                if constexpr (sizeof(Numeric) == sizeof(T)) {
+                    // the same bits, e.g. Int32 from INT32 or UInt64 from INT64
+                    simd::gather(_dict_items.data(), &_indexes[dict_index], run_length,
+                                 reinterpret_cast<T*>(&column_data[data_index]));
+                    data_index += run_length;
+                    dict_index += run_length;
+                } else {
+                    for (size_t i = 0; i < run_length; ++i) {
+                        column_data[data_index++] =
+                                static_cast<Numeric>(_dict_items[_indexes[dict_index++]]);
+                    }
                 }
                 break;
             }
@@ -17,7 +17,10 @@
 
 #pragma once
 
+#include <xxhash.h>
+
 #include <cstring>
+#include <functional>
 #include <vector>
 
 #include "exec/olap_common.h"
@@ -130,11 +133,14 @@ private:
         CppType max_value;
         tparquet::Type::type physical_type = col_schema->physical_type;
         switch (col_val_range.type()) {
-#define DISPATCH(REINTERPRET_TYPE, PARQUET_TYPE)                           \
-    case REINTERPRET_TYPE:                                                 \
-        if (col_schema->physical_type != PARQUET_TYPE) return false;       \
-        min_value = *reinterpret_cast<const CppType*>(encoded_min.data()); \
-        max_value = *reinterpret_cast<const CppType*>(encoded_max.data()); \
+#define DISPATCH(REINTERPRET_TYPE, PARQUET_TYPE)                                           \
+    case REINTERPRET_TYPE:                                                                 \
+        if (col_schema->physical_type != PARQUET_TYPE) return false;                       \
+        if (encoded_min.size() < sizeof(CppType) || encoded_max.size() < sizeof(CppType)) { \
+            return false;                                                                  \
+        }                                                                                  \
+        min_value = *reinterpret_cast<const CppType*>(encoded_min.data());                 \
+        max_value = *reinterpret_cast<const CppType*>(encoded_max.data());                 \
         break;
             FOR_REINTERPRET_TYPES(DISPATCH)
 #undef DISPATCH
@@ -367,7 +373,71 @@ private:
         return predicates;
     }
 
+    template <PrimitiveType primitive_type>
+    static bool _filter_by_bloom_filter(const ColumnValueRange<primitive_type>& col_val_range,
+                                        const FieldSchema* col_schema,
+                                        const std::function<bool(uint64_t)>& test_hash) {
+        if (!col_val_range.is_fixed_value_range() || col_val_range.contain_null()) {
+            return false;
+        }
+        tparquet::Type::type physical_type = col_schema->physical_type;
+        for (const auto& value : col_val_range.get_fixed_value_set()) {
+            uint64_t hash;
+            if constexpr (primitive_type == TYPE_TINYINT || primitive_type == TYPE_SMALLINT ||
+                          primitive_type == TYPE_INT) {
+                if (physical_type != tparquet::Type::INT32) {
+                    return false;
+                }
+                int32_t plain_value = value;
+                hash = XXH64(&plain_value, sizeof(plain_value), 0);
+            } else if constexpr (primitive_type == TYPE_BIGINT) {
+                if (physical_type != tparquet::Type::INT64) {
+                    return false;
+                }
+                int64_t plain_value = value;
+                hash = XXH64(&plain_value, sizeof(plain_value), 0);
+            } else if constexpr (primitive_type == TYPE_VARCHAR || primitive_type == TYPE_STRING) {
+                if (physical_type != tparquet::Type::BYTE_ARRAY) {
+                    return false;
+                }
+                // the length of a plain-encoded byte array is not hashed
+                hash = XXH64(value.data, value.size, 0);
+            } else {
+                return false;
+            }
+            if (test_hash(hash)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
 public:
+    // Whether the page whose values are all null can be filtered.
+    static bool filter_null_page(const ColumnValueRangeType& col_val_range) {
+        bool need_filter = false;
+        std::visit(
+                [&](auto&& range) {
+                    need_filter = !range.contain_null() && !range.is_whole_value_range();
+                },
+                col_val_range);
+        return need_filter;
+    }
+
+    // Whether none of the values of an IN or EQ predicate is in the bloom filter of a column
+    // chunk. test_hash tests the xxHash64 of a plain-encoded value in the bloom filter.
+    static bool filter_by_bloom_filter(const ColumnValueRangeType& col_val_range,
+                                       const FieldSchema* col_schema,
+                                       const std::function<bool(uint64_t)>& test_hash) {
+        bool need_filter = false;
+        std::visit(
+                [&](auto&& range) {
+                    need_filter = _filter_by_bloom_filter(range, col_schema, test_hash);
+                },
+                col_val_range);
+        return need_filter;
+    }
+
     static bool filter_by_min_max(const ColumnValueRangeType& col_val_range,
                                   const FieldSchema* col_schema, const std::string& encoded_min,
                                   const std::string& encoded_max, const cctz::time_zone& ctz) {
@@ -420,6 +420,40 @@ Status ScalarColumnReader::_try_load_dict_page(bool* loaded, bool* has_dict) {
     return Status::OK();
 }
 
+void ScalarColumnReader::_seek_to_selected_page() {
+    // the dictionary page is before the first data page, so only seek after the first page
+    if (_offset_index == nullptr || _nested_column || _current_row_index == 0) {
+        return;
+    }
+    const auto& locations = _offset_index->page_locations;
+    auto cur_page = std::lower_bound(locations.begin(), locations.end(), _current_row_index,
+                                     [](const tparquet::PageLocation& location, int64_t row) {
+                                         return location.first_row_index < row;
+                                     });
+    if (cur_page == locations.end() || cur_page->first_row_index != _current_row_index) {
+        return;
+    }
+    int index = _row_range_index;
+    while (index < _row_ranges.size() && _row_ranges[index].last_row <= _current_row_index) {
+        index++;
+    }
+    if (index == _row_ranges.size()) {
+        // no more rows to read, the remaining pages are skipped one by one
+        return;
+    }
+    int64_t next_row = std::max(_row_ranges[index].first_row, _current_row_index);
+    // the last page starting at or before the next row
+    auto next_page = std::upper_bound(cur_page, locations.end(), next_row,
+                                      [](int64_t row, const tparquet::PageLocation& location) {
+                                          return row < location.first_row_index;
+                                      }) -
+                     1;
+    if (next_page != cur_page) {
+        _current_row_index = next_page->first_row_index;
+        _chunk_reader->seek_to_page(next_page->offset);
+    }
+}
+
 Status ScalarColumnReader::read_column_data(ColumnPtr& doris_column, DataTypePtr& type,
                                             ColumnSelectVector& select_vector, size_t batch_size,
                                             size_t* read_rows, bool* eof, bool is_dict_filter) {
@@ -429,6 +463,7 @@ Status ScalarColumnReader::read_column_data(ColumnPtr& doris_column, DataTypePtr
             *read_rows = 0;
             return Status::OK();
         }
+        _seek_to_selected_page();
         RETURN_IF_ERROR(_chunk_reader->next_page());
     }
     if (_nested_column) {
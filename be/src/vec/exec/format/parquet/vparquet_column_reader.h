@@ -117,7 +117,7 @@ protected:
     bool _nested_column = false;
     const std::vector<RowRange>& _row_ranges;
     cctz::time_zone* _ctz;
-    tparquet::OffsetIndex* _offset_index;
+    tparquet::OffsetIndex* _offset_index = nullptr;
     int64_t _current_row_index = 0;
     int _row_range_index = 0;
     int64_t _decode_null_map_time = 0;
@@ -159,6 +159,9 @@ private:
                                ColumnSelectVector& select_vector, size_t batch_size,
                                size_t* read_rows, bool* eof, bool is_dict_filter);
     Status _try_load_dict_page(bool* loaded, bool* has_dict);
+    // Seek to the page having the next row to read by the offset index, so the pages out of the
+    // row ranges are skipped without reading their headers.
+    void _seek_to_selected_page();
 };
 
 class ArrayColumnReader : public ParquetColumnReader {
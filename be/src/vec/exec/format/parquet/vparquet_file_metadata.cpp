@@ -37,6 +37,33 @@ const tparquet::FileMetaData& FileMetaData::to_thrift() {
     return _metadata;
 }
 
+size_t FileMetaData::get_mem_size() const {
+    size_t size = sizeof(FileMetaData) + _metadata.created_by.size();
+    for (auto& element : _metadata.schema) {
+        size += sizeof(element) + element.name.size();
+    }
+    for (auto& key_value : _metadata.key_value_metadata) {
+        size += sizeof(key_value) + key_value.key.size() + key_value.value.size();
+    }
+    for (auto& row_group : _metadata.row_groups) {
+        size += sizeof(row_group);
+        for (auto& chunk : row_group.columns) {
+            const tparquet::ColumnMetaData& column = chunk.meta_data;
+            const tparquet::Statistics& statistics = column.statistics;
+            size += sizeof(chunk) + chunk.file_path.size() +
+                    column.encodings.size() * sizeof(tparquet::Encoding::type) +
+                    statistics.max.size() + statistics.min.size() +
+                    statistics.max_value.size() + statistics.min_value.size();
+            for (auto& path : column.path_in_schema) {
+                size += sizeof(path) + path.size();
+            }
+        }
+    }
+    // the parsed schema
+    size += _metadata.schema.size() * sizeof(FieldSchema);
+    return size;
+}
+
 std::string FileMetaData::debug_string() const {
     std::stringstream out;
     out << "Parquet Metadata(";
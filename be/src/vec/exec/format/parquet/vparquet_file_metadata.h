@@ -29,6 +29,8 @@ public:
     Status init_schema();
     const FieldDescriptor& schema() const { return _schema; }
     const tparquet::FileMetaData& to_thrift();
+    // The estimated memory size of the parsed metadata.
+    size_t get_mem_size() const;
     std::string debug_string() const;
 
 private:
@@ -18,6 +18,8 @@
 #include "vparquet_group_reader.h"
 
 #include "exprs/create_predicate_function.h"
+#include "io/fs/buffered_reader.h"
+#include "io/fs/file_system.h"
 #include "schema_desc.h"
 #include "util/simd/bits.h"
 #include "vec/columns/column_const.h"
@@ -81,20 +83,31 @@ Status RowGroupReader::init(
     const size_t MAX_GROUP_BUF_SIZE = config::parquet_rowgroup_max_buffer_mb << 20;
     const size_t MAX_COLUMN_BUF_SIZE = config::parquet_column_max_buffer_mb << 20;
     size_t max_buf_size = std::min(MAX_COLUMN_BUF_SIZE, MAX_GROUP_BUF_SIZE / _read_columns.size());
+    std::vector<FieldSchema*> fields;
     for (auto& read_col : _read_columns) {
-        auto field = const_cast<FieldSchema*>(schema.get_column(read_col._file_slot_name));
+        fields.push_back(const_cast<FieldSchema*>(schema.get_column(read_col._file_slot_name)));
+    }
+    io::FileReaderSPtr file_reader = _file_reader;
+    if (config::enable_parquet_merge_range_read && _file_reader->fs() != nullptr &&
+        _file_reader->fs()->type() != io::FileSystemType::LOCAL) {
+        file_reader = _create_merge_range_reader(fields, MAX_GROUP_BUF_SIZE);
+    }
+    for (size_t i = 0; i < _read_columns.size(); ++i) {
+        auto& read_col = _read_columns[i];
+        auto field = fields[i];
         std::unique_ptr<ParquetColumnReader> reader;
-        RETURN_IF_ERROR(ParquetColumnReader::create(_file_reader, field, _row_group_meta,
+        RETURN_IF_ERROR(ParquetColumnReader::create(file_reader, field, _row_group_meta,
                                                     _read_ranges, _ctz, reader, max_buf_size));
-        auto col_iter = col_offsets.find(read_col._parquet_col_id);
-        if (col_iter != col_offsets.end()) {
-            tparquet::OffsetIndex oi = col_iter->second;
-            reader->add_offset_index(&oi);
-        }
         if (reader == nullptr) {
             VLOG_DEBUG << "Init row group(" << _row_group_id << ") reader failed";
             return Status::Corruption("Init row group reader failed");
         }
+        auto col_iter = col_offsets.find(read_col._parquet_col_id);
+        if (col_iter != col_offsets.end()) {
+            auto& offset_index = _col_offsets[read_col._parquet_col_id];
+            offset_index = col_iter->second;
+            reader->add_offset_index(&offset_index);
+        }
         _column_readers[read_col._file_slot_name] = std::move(reader);
     }
     // Check if single slot can be filtered by dict.
@@ -123,6 +136,33 @@ Status RowGroupReader::init(
     return Status::OK();
 }
 
+io::FileReaderSPtr RowGroupReader::_create_merge_range_reader(
+        const std::vector<FieldSchema*>& fields, size_t max_buffer_bytes) {
+    std::vector<io::PrefetchRange> ranges;
+    std::vector<const FieldSchema*> pending(fields.begin(), fields.end());
+    while (!pending.empty()) {
+        const FieldSchema* field = pending.back();
+        pending.pop_back();
+        if (!field->children.empty()) {
+            for (auto& child : field->children) {
+                pending.push_back(&child);
+            }
+            continue;
+        }
+        if (field->physical_column_index < 0 ||
+            field->physical_column_index >= static_cast<int>(_row_group_meta.columns.size())) {
+            continue;
+        }
+        auto& chunk_meta = _row_group_meta.columns[field->physical_column_index].meta_data;
+        int64_t chunk_start = chunk_meta.__isset.dictionary_page_offset
+                                      ? chunk_meta.dictionary_page_offset
+                                      : chunk_meta.data_page_offset;
+        ranges.emplace_back(chunk_start, chunk_start + chunk_meta.total_compressed_size);
+    }
+    return std::make_shared<io::MergeRangeFileReader>(_file_reader, std::move(ranges),
+                                                      max_buffer_bytes);
+}
+
 bool RowGroupReader::_can_filter_by_dict(int slot_id,
                                          const tparquet::ColumnMetaData& column_metadata) {
     SlotDescriptor* slot = nullptr;
@@ -126,6 +126,9 @@ public:
 
 private:
     void _merge_read_ranges(std::vector<RowRange>& row_ranges);
+    // Wraps the file by a MergeRangeFileReader of the column chunks of the fields.
+    io::FileReaderSPtr _create_merge_range_reader(const std::vector<FieldSchema*>& fields,
+                                                  size_t max_buffer_bytes);
     Status _read_empty_batch(size_t batch_size, size_t* read_rows, bool* batch_eof);
     Status _read_column_data(Block* block, const std::vector<std::string>& columns,
                              size_t batch_size, size_t* read_rows, bool* batch_eof,
@@ -161,6 +164,8 @@ private:
                                                int column_to_keep);
 
     io::FileReaderSPtr _file_reader;
+    // the offset indexes referenced by the column readers
+    std::unordered_map<int, tparquet::OffsetIndex> _col_offsets;
     std::unordered_map<std::string, std::unique_ptr<ParquetColumnReader>> _column_readers;
     const std::vector<ParquetReadColumn>& _read_columns;
     const int32_t _row_group_id;
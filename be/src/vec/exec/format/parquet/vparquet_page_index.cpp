@@ -48,6 +48,16 @@ Status PageIndex::collect_skipped_page_range(tparquet::ColumnIndex* column_index
 
     const int num_of_pages = column_index->null_pages.size();
     for (int page_id = 0; page_id < num_of_pages; page_id++) {
+        if (column_index->null_pages[page_id]) {
+            // the min and max of a page of nulls are meaningless
+            if (ParquetPredicate::filter_null_page(col_val_range)) {
+                skipped_ranges.emplace_back(page_id);
+            }
+            continue;
+        }
+        if (page_id >= static_cast<int>(encoded_min_vals.size())) {
+            break;
+        }
         if (ParquetPredicate::filter_by_min_max(col_val_range, col_schema,
                                                 encoded_min_vals[page_id],
                                                 encoded_max_vals[page_id], ctz)) {
@@ -22,6 +22,7 @@
 #include "common/status.h"
 #include "io/file_factory.h"
 #include "olap/iterators.h"
+#include "olap/rowset/segment_v2/block_split_bloom_filter.h"
 #include "parquet_pred_cmp.h"
 #include "parquet_thrift_util.h"
 #include "rapidjson/document.h"
@@ -32,6 +33,10 @@
 
 namespace doris::vectorized {
 
+// the thrift encoded BloomFilterHeader takes about 15 bytes
+static constexpr size_t BLOOM_FILTER_MAX_HEADER_SIZE = 64;
+static constexpr int32_t BLOOM_FILTER_BYTES_PER_BLOCK = 32;
+
 ParquetReader::ParquetReader(RuntimeProfile* profile, const TFileScanRangeParams& params,
                              const TFileRangeDesc& range, size_t batch_size, cctz::time_zone* ctz,
                              io::IOContext* io_ctx, RuntimeState* state, ShardedKVCache* kv_cache)
@@ -72,6 +77,8 @@ void ParquetReader::_init_profile() {
 
         _parquet_profile.filtered_row_groups =
                 ADD_CHILD_COUNTER(_profile, "FilteredGroups", TUnit::UNIT, parquet_profile);
+        _parquet_profile.filtered_row_groups_by_bloom_filter = ADD_CHILD_COUNTER(
+                _profile, "FilteredGroupsByBloomFilter", TUnit::UNIT, parquet_profile);
         _parquet_profile.to_read_row_groups =
                 ADD_CHILD_COUNTER(_profile, "ReadGroups", TUnit::UNIT, parquet_profile);
         _parquet_profile.filtered_group_rows =
@@ -92,6 +99,8 @@ void ParquetReader::_init_profile() {
                 ADD_CHILD_TIMER(_profile, "ParseMetaTime", parquet_profile);
         _parquet_profile.parse_footer_time =
                 ADD_CHILD_TIMER(_profile, "ParseFooterTime", parquet_profile);
+        _parquet_profile.meta_cache_hit =
+                ADD_CHILD_COUNTER(_profile, "FileMetaCacheHit", TUnit::UNIT, parquet_profile);
         _parquet_profile.open_file_time =
                 ADD_CHILD_TIMER(_profile, "FileOpenTime", parquet_profile);
         _parquet_profile.open_file_num =
@@ -125,6 +134,8 @@ void ParquetReader::close() {
     if (!_closed) {
         if (_profile != nullptr) {
             COUNTER_UPDATE(_parquet_profile.filtered_row_groups, _statistics.filtered_row_groups);
+            COUNTER_UPDATE(_parquet_profile.filtered_row_groups_by_bloom_filter,
+                           _statistics.filtered_row_groups_by_bloom_filter);
             COUNTER_UPDATE(_parquet_profile.to_read_row_groups, _statistics.read_row_groups);
             COUNTER_UPDATE(_parquet_profile.filtered_group_rows, _statistics.filtered_group_rows);
             COUNTER_UPDATE(_parquet_profile.filtered_page_rows, _statistics.filtered_page_rows);
@@ -136,6 +147,7 @@ void ParquetReader::close() {
             COUNTER_UPDATE(_parquet_profile.column_read_time, _statistics.column_read_time);
             COUNTER_UPDATE(_parquet_profile.parse_meta_time, _statistics.parse_meta_time);
             COUNTER_UPDATE(_parquet_profile.parse_footer_time, _statistics.parse_footer_time);
+            COUNTER_UPDATE(_parquet_profile.meta_cache_hit, _statistics.meta_cache_hit);
             COUNTER_UPDATE(_parquet_profile.open_file_time, _statistics.open_file_time);
             COUNTER_UPDATE(_parquet_profile.open_file_num, _statistics.open_file_num);
             COUNTER_UPDATE(_parquet_profile.page_index_filter_time,
@@ -178,7 +190,22 @@ Status ParquetReader::_open_file() {
         if (_file_reader->size() == 0) {
             return Status::EndOfFile("open file failed, empty parquet file: " + _scan_range.path);
         }
-        if (_kv_cache == nullptr) {
+        std::string meta_cache_key;
+        if (FileMetaCache::instance() != nullptr) {
+            meta_cache_key = FileMetaCache::get_key("parquet", _scan_range, _file_reader->size());
+        }
+        if (!meta_cache_key.empty()) {
+            _is_file_metadata_owned = false;
+            if (FileMetaCache::instance()->lookup(meta_cache_key, &_meta_cache_handle)) {
+                ++_statistics.meta_cache_hit;
+            } else {
+                FileMetaData* meta = nullptr;
+                RETURN_IF_ERROR(parse_thrift_footer(_file_reader, &meta));
+                FileMetaCache::instance()->insert(meta_cache_key, meta, meta->get_mem_size(),
+                                                  &_meta_cache_handle);
+            }
+            _file_metadata = _meta_cache_handle.data<FileMetaData>();
+        } else if (_kv_cache == nullptr) {
             _is_file_metadata_owned = true;
             RETURN_IF_ERROR(parse_thrift_footer(_file_reader, &_file_metadata));
         } else {
@@ -596,6 +623,7 @@ bool ParquetReader::_has_page_index(const std::vector<tparquet::ColumnChunk>& co
 Status ParquetReader::_process_page_index(const tparquet::RowGroup& row_group,
                                           std::vector<RowRange>& candidate_row_ranges) {
     SCOPED_RAW_TIMER(&_statistics.page_index_filter_time);
+    _col_offsets.clear();
 
     std::function<void()> read_whole_row_group = [&]() {
         candidate_row_ranges.emplace_back(0, row_group.num_rows);
@@ -612,14 +640,17 @@ Status ParquetReader::_process_page_index(const tparquet::RowGroup& row_group,
         read_whole_row_group();
         return Status::OK();
     }
-    uint8_t col_index_buff[page_index._column_index_size];
+    // the page indexes may be large, keep them off the stack
+    std::vector<uint8_t> col_index_buffer(page_index._column_index_size);
+    uint8_t* col_index_buff = col_index_buffer.data();
     size_t bytes_read = 0;
     Slice result(col_index_buff, page_index._column_index_size);
     RETURN_IF_ERROR(
             _file_reader->read_at(page_index._column_index_start, result, &bytes_read, _io_ctx));
     auto& schema_desc = _file_metadata->schema();
     std::vector<RowRange> skipped_row_ranges;
-    uint8_t off_index_buff[page_index._offset_index_size];
+    std::vector<uint8_t> off_index_buffer(page_index._offset_index_size);
+    uint8_t* off_index_buff = off_index_buffer.data();
     Slice res(off_index_buff, page_index._offset_index_size);
     RETURN_IF_ERROR(
             _file_reader->read_at(page_index._offset_index_start, res, &bytes_read, _io_ctx));
@@ -661,6 +692,18 @@ Status ParquetReader::_process_page_index(const tparquet::RowGroup& row_group,
         read_whole_row_group();
         return Status::OK();
     }
+    // the other columns also skip the pages out of the candidate ranges by their offset indexes,
+    // instead of reading the page headers
+    for (auto& read_col : _read_columns) {
+        auto& chunk = row_group.columns[read_col._parquet_col_id];
+        if (_col_offsets.find(read_col._parquet_col_id) != _col_offsets.end() ||
+            !chunk.__isset.offset_index_offset || chunk.offset_index_length <= 0) {
+            continue;
+        }
+        tparquet::OffsetIndex offset_index;
+        RETURN_IF_ERROR(page_index.parse_offset_index(chunk, off_index_buff, &offset_index));
+        _col_offsets.emplace(read_col._parquet_col_id, std::move(offset_index));
+    }
 
     std::sort(skipped_row_ranges.begin(), skipped_row_ranges.end(),
               [](const RowRange& lhs, const RowRange& rhs) {
@@ -694,10 +737,18 @@ Status ParquetReader::_process_page_index(const tparquet::RowGroup& row_group,
 Status ParquetReader::_process_row_group_filter(const tparquet::RowGroup& row_group,
                                                 bool* filter_group) {
     _process_column_stat_filter(row_group.columns, filter_group);
+    if (*filter_group) {
+        return Status::OK();
+    }
     _init_chunk_dicts();
     RETURN_IF_ERROR(_process_dict_filter(filter_group));
-    _init_bloom_filter();
-    RETURN_IF_ERROR(_process_bloom_filter(filter_group));
+    if (*filter_group) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(_process_bloom_filter(row_group, filter_group));
+    if (*filter_group) {
+        _statistics.filtered_row_groups_by_bloom_filter++;
+    }
     return Status::OK();
 }
 
@@ -738,9 +789,76 @@ Status ParquetReader::_process_dict_filter(bool* filter_group) {
     return Status::OK();
 }
 
-void ParquetReader::_init_bloom_filter() {}
+Status ParquetReader::_process_bloom_filter(const tparquet::RowGroup& row_group,
+                                            bool* filter_group) {
+    if (!config::enable_parquet_bloom_filter || _colname_to_value_range == nullptr ||
+        _colname_to_value_range->empty()) {
+        return Status::OK();
+    }
+    auto& schema_desc = _file_metadata->schema();
+    for (auto& col_name : *_column_names) {
+        auto col_iter = _map_column.find(col_name);
+        if (col_iter == _map_column.end()) {
+            continue;
+        }
+        auto slot_iter = _colname_to_value_range->find(col_name);
+        if (slot_iter == _colname_to_value_range->end()) {
+            continue;
+        }
+        auto& chunk_meta = row_group.columns[col_iter->second].meta_data;
+        if (!chunk_meta.__isset.bloom_filter_offset) {
+            continue;
+        }
+        const FieldSchema* col_schema = schema_desc.get_column(col_name);
+        if (col_schema == nullptr || !col_schema->children.empty()) {
+            continue;
+        }
+        // check whether the predicate can be tested by a bloom filter before reading it
+        bool supported = false;
+        ParquetPredicate::filter_by_bloom_filter(slot_iter->second, col_schema,
+                                                 [&](uint64_t) { return supported = true; });
+        if (!supported) {
+            continue;
+        }
 
-Status ParquetReader::_process_bloom_filter(bool* filter_group) {
+        // the header is at the start of the bloom filter, followed by the bitset
+        const size_t bf_offset = chunk_meta.bloom_filter_offset;
+        if (bf_offset >= _file_reader->size()) {
+            continue;
+        }
+        uint8_t header_buf[BLOOM_FILTER_MAX_HEADER_SIZE];
+        size_t bytes_read = 0;
+        size_t header_read_size =
+                std::min(BLOOM_FILTER_MAX_HEADER_SIZE, _file_reader->size() - bf_offset);
+        Slice header_slice(header_buf, header_read_size);
+        RETURN_IF_ERROR(_file_reader->read_at(bf_offset, header_slice, &bytes_read, _io_ctx));
+        tparquet::BloomFilterHeader header;
+        uint32_t header_size = bytes_read;
+        if (!deserialize_thrift_msg(header_buf, &header_size, true, &header).ok() ||
+            !header.algorithm.__isset.BLOCK || !header.hash.__isset.XXHASH ||
+            !header.compression.__isset.UNCOMPRESSED || header.numBytes <= 0 ||
+            header.numBytes % BLOOM_FILTER_BYTES_PER_BLOCK != 0 ||
+            header.numBytes > config::parquet_bloom_filter_max_size_mb << 20 ||
+            bf_offset + header_size + header.numBytes > _file_reader->size()) {
+            // not supported or broken, don't use it
+            continue;
+        }
+        std::unique_ptr<uint8_t[]> bitset(new uint8_t[header.numBytes]);
+        Slice bitset_slice(bitset.get(), header.numBytes);
+        RETURN_IF_ERROR(_file_reader->read_at(bf_offset + header_size, bitset_slice, &bytes_read,
+                                              _io_ctx));
+        if (bytes_read != static_cast<size_t>(header.numBytes)) {
+            continue;
+        }
+        if (ParquetPredicate::filter_by_bloom_filter(
+                    slot_iter->second, col_schema, [&](uint64_t hash) {
+                        return segment_v2::BlockSplitBloomFilter::test_parquet_hash(
+                                bitset.get(), header.numBytes, hash);
+                    })) {
+            *filter_group = true;
+            return Status::OK();
+        }
+    }
     return Status::OK();
 }
 
@@ -30,6 +30,7 @@
 #include "io/fs/file_reader.h"
 #include "io/fs/file_system.h"
 #include "vec/core/block.h"
+#include "vec/exec/format/file_meta_cache.h"
 #include "vec/exec/format/generic_reader.h"
 #include "vec/exprs/vexpr_context.h"
 #include "vparquet_column_reader.h"
@@ -43,6 +44,7 @@ class ParquetReader : public GenericReader {
 public:
     struct Statistics {
         int32_t filtered_row_groups = 0;
+        int32_t filtered_row_groups_by_bloom_filter = 0;
         int32_t read_row_groups = 0;
         int64_t filtered_group_rows = 0;
         int64_t filtered_page_rows = 0;
@@ -53,6 +55,7 @@ public:
         int64_t column_read_time = 0;
         int64_t parse_meta_time = 0;
         int64_t parse_footer_time = 0;
+        int64_t meta_cache_hit = 0;
         int64_t open_file_time = 0;
         int64_t open_file_num = 0;
         int64_t row_group_filter_time = 0;
@@ -118,6 +121,7 @@ public:
 private:
     struct ParquetProfile {
         RuntimeProfile::Counter* filtered_row_groups;
+        RuntimeProfile::Counter* filtered_row_groups_by_bloom_filter;
         RuntimeProfile::Counter* to_read_row_groups;
         RuntimeProfile::Counter* filtered_group_rows;
         RuntimeProfile::Counter* filtered_page_rows;
@@ -128,6 +132,7 @@ private:
         RuntimeProfile::Counter* column_read_time;
         RuntimeProfile::Counter* parse_meta_time;
         RuntimeProfile::Counter* parse_footer_time;
+        RuntimeProfile::Counter* meta_cache_hit;
         RuntimeProfile::Counter* open_file_time;
         RuntimeProfile::Counter* open_file_num;
         RuntimeProfile::Counter* row_group_filter_time;
@@ -167,8 +172,9 @@ private:
     Status _process_row_group_filter(const tparquet::RowGroup& row_group, bool* filter_group);
     void _init_chunk_dicts();
     Status _process_dict_filter(bool* filter_group);
-    void _init_bloom_filter();
-    Status _process_bloom_filter(bool* filter_group);
+    // Filter the row group if none of the values of an IN or EQ predicate is in the bloom filter
+    // of its column chunk.
+    Status _process_bloom_filter(const tparquet::RowGroup& row_group, bool* filter_group);
     int64_t _get_column_start_offset(const tparquet::ColumnMetaData& column_init_column_readers);
     std::string _meta_cache_key(const std::string& path) { return "meta_" + path; }
 
@@ -181,8 +187,10 @@ private:
     io::FileReaderSPtr _file_reader = nullptr;
     FileMetaData* _file_metadata = nullptr;
     // set to true if _file_metadata is owned by this reader.
-    // otherwise, it is owned by someone else, such as _kv_cache
+    // otherwise, it is owned by someone else, such as _kv_cache or FileMetaCache
     bool _is_file_metadata_owned = false;
+    // pins _file_metadata in FileMetaCache
+    FileMetaCache::Handle _meta_cache_handle;
     const tparquet::FileMetaData* _t_metadata;
     std::unique_ptr<RowGroupReader> _current_group_reader = nullptr;
     // read to the end of current reader
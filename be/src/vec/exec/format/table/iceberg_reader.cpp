@@ -21,6 +21,7 @@
 #include "olap/iterators.h"
 #include "vec/common/assert_cast.h"
 #include "vec/core/column_with_type_and_name.h"
+#include "vec/core/loser_tree.h"
 #include "vec/data_types/data_type_factory.hpp"
 #include "vec/exec/format/parquet/vparquet_reader.h"
 
@@ -385,33 +386,37 @@ void IcebergTableReader::_sort_delete_rows(std::vector<std::vector<int64_t>*>& d
         return;
     }
 
-    using vec_pair = std::pair<std::vector<int64_t>::iterator, std::vector<int64_t>::iterator>;
-    _delete_rows.resize(num_delete_rows);
-    auto row_id_iter = _delete_rows.begin();
-    auto iter_end = _delete_rows.end();
-    std::vector<vec_pair> rows_array;
+    // merge the sorted rows of the delete files by a loser tree, the rows deleted by a file are
+    // usually not interleaved with the others, so most of them take one comparison
+    struct RowsCursor {
+        const int64_t* pos;
+        const int64_t* end;
+    };
+    struct RowsCursorGreater {
+        bool operator()(const RowsCursor& lhs, const RowsCursor& rhs) const {
+            return *lhs.pos > *rhs.pos;
+        }
+    };
+    std::vector<RowsCursor> cursors;
     for (auto rows : delete_rows_array) {
         if (rows->size() > 0) {
-            rows_array.push_back({rows->begin(), rows->end()});
+            cursors.push_back({rows->data(), rows->data() + rows->size()});
         }
     }
-    int array_size = rows_array.size();
-    while (row_id_iter != iter_end) {
-        int min_index = 0;
-        int min = *rows_array[0].first;
-        for (int i = 0; i < array_size; ++i) {
-            if (*rows_array[i].first < min) {
-                min_index = i;
-                min = *rows_array[i].first;
-            }
-        }
-        *row_id_iter++ = min;
-        rows_array[min_index].first++;
-        if (UNLIKELY(rows_array[min_index].first == rows_array[min_index].second)) {
-            rows_array.erase(rows_array.begin() + min_index);
-            array_size--;
+    LoserTree<RowsCursor, RowsCursorGreater> rows_tree;
+    rows_tree.init(std::move(cursors));
+    _delete_rows.resize(num_delete_rows);
+    int64_t* dest = _delete_rows.data();
+    while (!rows_tree.empty()) {
+        RowsCursor& top = rows_tree.top();
+        *dest++ = *top.pos++;
+        if (top.pos == top.end) {
+            rows_tree.pop_top();
+        } else {
+            rows_tree.update_top();
         }
     }
+    DCHECK_EQ(dest, _delete_rows.data() + num_delete_rows);
 }
 
 /*
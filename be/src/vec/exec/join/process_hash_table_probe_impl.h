@@ -148,6 +148,23 @@ void ProcessHashTableProbe<JoinOpType>::probe_side_output_column(
     }
 }
 
+template <int JoinOpType>
+template <typename KeyGetter, typename HashTable>
+void ProcessHashTableProbe<JoinOpType>::_init_probe_side_hash_values(KeyGetter& key_getter,
+                                                                     const HashTable& hash_table,
+                                                                     size_t probe_rows) {
+    if (_probe_side_hash_values.size() < probe_rows) {
+        _probe_side_hash_values.resize(probe_rows);
+    }
+    for (size_t k = 0; k < probe_rows; ++k) {
+        if constexpr (ColumnsHashing::IsPreSerializedKeysHashMethodTraits<KeyGetter>::value) {
+            _probe_side_hash_values[k] = hash_table.hash(key_getter.get_key_holder(k, *_arena).key);
+        } else {
+            _probe_side_hash_values[k] = hash_table.hash(key_getter.get_key_holder(k, *_arena));
+        }
+    }
+}
+
 template <int JoinOpType>
 template <bool need_null_map_for_probe, bool ignore_null, typename HashTableType>
 Status ProcessHashTableProbe<JoinOpType>::do_process(HashTableType& hash_table_ctx,
@@ -197,6 +214,9 @@ Status ProcessHashTableProbe<JoinOpType>::do_process(HashTableType& hash_table_c
     if constexpr (ColumnsHashing::IsPreSerializedKeysHashMethodTraits<KeyGetter>::value) {
         key_getter.set_serialized_keys(_probe_keys.data());
     }
+    if (probe_index == 0) {
+        _init_probe_side_hash_values(key_getter, hash_table_ctx.hash_table, probe_rows);
+    }
 
     auto& mcol = mutable_block.mutable_columns();
     int current_offset = 0;
@@ -265,19 +285,25 @@ Status ProcessHashTableProbe<JoinOpType>::do_process(HashTableType& hash_table_c
                     }
                 }
                 int last_offset = current_offset;
-                auto find_result = !need_null_map_for_probe
-                                           ? key_getter.find_key(hash_table_ctx.hash_table,
-                                                                 probe_index, *_arena)
-                                   : (*null_map)[probe_index]
-                                           ? decltype(key_getter.find_key(hash_table_ctx.hash_table,
-                                                                          probe_index,
-                                                                          *_arena)) {nullptr, false}
-                                           : key_getter.find_key(hash_table_ctx.hash_table,
-                                                                 probe_index, *_arena);
                 if (probe_index + PREFETCH_STEP < probe_rows) {
-                    key_getter.template prefetch<true>(hash_table_ctx.hash_table,
-                                                       probe_index + PREFETCH_STEP, *_arena);
+                    key_getter.template prefetch_by_hash<true>(
+                            hash_table_ctx.hash_table,
+                            _probe_side_hash_values[probe_index + PREFETCH_STEP]);
                 }
+                auto find_result =
+                        !need_null_map_for_probe
+                                ? key_getter.find_key_with_hash(
+                                          hash_table_ctx.hash_table,
+                                          _probe_side_hash_values[probe_index], probe_index,
+                                          *_arena)
+                        : (*null_map)[probe_index]
+                                ? decltype(key_getter.find_key(hash_table_ctx.hash_table,
+                                                               probe_index, *_arena)) {nullptr,
+                                                                                       false}
+                                : key_getter.find_key_with_hash(
+                                          hash_table_ctx.hash_table,
+                                          _probe_side_hash_values[probe_index], probe_index,
+                                          *_arena);
 
                 auto current_probe_index = probe_index;
                 if constexpr (JoinOpType == TJoinOp::LEFT_ANTI_JOIN ||
@@ -447,6 +473,9 @@ Status ProcessHashTableProbe<JoinOpType>::do_process_with_other_join_conjuncts(
         if constexpr (ColumnsHashing::IsPreSerializedKeysHashMethodTraits<KeyGetter>::value) {
             key_getter.set_serialized_keys(_probe_keys.data());
         }
+        if (probe_index == 0) {
+            _init_probe_side_hash_values(key_getter, hash_table_ctx.hash_table, probe_rows);
+        }
 
         int right_col_idx = _join_node->_left_table_data_types.size();
         int right_col_len = _join_node->_right_table_data_types.size();
@@ -531,19 +560,25 @@ Status ProcessHashTableProbe<JoinOpType>::do_process_with_other_join_conjuncts(
                 }
 
                 auto last_offset = current_offset;
-                auto find_result = !need_null_map_for_probe
-                                           ? key_getter.find_key(hash_table_ctx.hash_table,
-                                                                 probe_index, *_arena)
-                                   : (*null_map)[probe_index]
-                                           ? decltype(key_getter.find_key(hash_table_ctx.hash_table,
-                                                                          probe_index,
-                                                                          *_arena)) {nullptr, false}
-                                           : key_getter.find_key(hash_table_ctx.hash_table,
-                                                                 probe_index, *_arena);
                 if (probe_index + PREFETCH_STEP < probe_rows) {
-                    key_getter.template prefetch<true>(hash_table_ctx.hash_table,
-                                                       probe_index + PREFETCH_STEP, *_arena);
+                    key_getter.template prefetch_by_hash<true>(
+                            hash_table_ctx.hash_table,
+                            _probe_side_hash_values[probe_index + PREFETCH_STEP]);
                 }
+                auto find_result =
+                        !need_null_map_for_probe
+                                ? key_getter.find_key_with_hash(
+                                          hash_table_ctx.hash_table,
+                                          _probe_side_hash_values[probe_index], probe_index,
+                                          *_arena)
+                        : (*null_map)[probe_index]
+                                ? decltype(key_getter.find_key(hash_table_ctx.hash_table,
+                                                               probe_index, *_arena)) {nullptr,
+                                                                                       false}
+                                : key_getter.find_key_with_hash(
+                                          hash_table_ctx.hash_table,
+                                          _probe_side_hash_values[probe_index], probe_index,
+                                          *_arena);
 
                 auto current_probe_index = probe_index;
                 if (find_result.is_found()) {
@@ -977,6 +1012,21 @@ Status ProcessHashTableProbe<JoinOpType>::do_process_with_other_join_conjuncts(
                 }
                 if (is_mark_join) {
                     Block::filter_block(output_block, result_column_id, output_block->columns());
+                } else if (JoinOpType == TJoinOp::INNER_JOIN &&
+                           _join_node->_filter_conjuncts_in_probe()) {
+                    SCOPED_TIMER(_join_node->_join_filter_timer);
+                    IColumn::Filter filter(row_count, 1);
+                    bool can_filter_all = !Block::merge_filter(*column, &filter);
+                    if (!can_filter_all) {
+                        RETURN_IF_ERROR(VExprContext::execute_conjuncts(
+                                {*_join_node->_vconjunct_ctx_ptr}, output_block, &filter,
+                                &can_filter_all));
+                    }
+                    if (can_filter_all) {
+                        memset(filter.data(), 0, row_count);
+                    }
+                    Block::filter_block_internal(output_block, filter, orig_columns);
+                    Block::erase_useless_column(output_block, orig_columns);
                 } else {
                     Block::filter_block(output_block, result_column_id, orig_columns);
                 }
@@ -0,0 +1,81 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "util/interval_tree-inl.h"
+#include "util/interval_tree.h"
+
+namespace doris::vectorized {
+
+// The build rows of a nested loop join indexed by the closed ranges of the probe values they may
+// join, e.g. [b.lower, b.upper] of the conjunct `a.v >= b.lower and a.v < b.upper`. The values of
+// all the comparable types are mapped to doubles, which keeps their order but may merge the close
+// ones, so the rows found are the candidates and the whole conjunct still decides the matches.
+class RangeJoinIndex {
+public:
+    struct Range {
+        double lower;
+        double upper;
+        int row;
+    };
+
+    // The ranges with `lower > upper` never match and are dropped.
+    explicit RangeJoinIndex(std::vector<Range> ranges) {
+        ranges.erase(std::remove_if(ranges.begin(), ranges.end(),
+                                    [](const Range& range) { return range.lower > range.upper; }),
+                     ranges.end());
+        _num_ranges = ranges.size();
+        _tree = std::make_unique<IntervalTree<Traits>>(ranges);
+    }
+
+    // Sets the rows whose range contains the value in the ascending order.
+    void find(double value, std::vector<int>* rows) const {
+        _found.clear();
+        rows->clear();
+        _tree->FindContainingPoint(value, &_found);
+        for (const auto& range : _found) {
+            rows->push_back(range.row);
+        }
+        std::sort(rows->begin(), rows->end());
+    }
+
+    size_t num_ranges() const { return _num_ranges; }
+
+private:
+    struct Traits {
+        using point_type = double;
+        using interval_type = Range;
+
+        static point_type get_left(const interval_type& range) { return range.lower; }
+        static point_type get_right(const interval_type& range) { return range.upper; }
+        static int compare(const point_type& a, const point_type& b) {
+            return a < b ? -1 : (a > b ? 1 : 0);
+        }
+    };
+
+    std::unique_ptr<IntervalTree<Traits>> _tree;
+    size_t _num_ranges = 0;
+    mutable std::vector<Range> _found;
+};
+
+} // namespace doris::vectorized
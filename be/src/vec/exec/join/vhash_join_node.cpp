@@ -21,7 +21,13 @@
 #include "exprs/runtime_filter_slots.h"
 #include "gen_cpp/PlanNodes_types.h"
 #include "gutil/strings/substitute.h"
+#include "runtime/exec_env.h"
+#include "runtime/thread_context.h"
+#include "util/countdown_latch.h"
 #include "util/defer_op.h"
+#include "util/threadpool.h"
+#include "vec/core/block_spill_reader.h"
+#include "vec/core/block_spill_writer.h"
 #include "vec/data_types/data_type_number.h"
 #include "vec/exprs/vexpr.h"
 #include "vec/exprs/vexpr_context.h"
@@ -56,7 +62,8 @@ Overload(Callables&&... callables) -> Overload<Callables...>;
 template <class HashTableContext>
 struct ProcessHashTableBuild {
     ProcessHashTableBuild(int rows, Block& acquired_block, ColumnRawPtrs& build_raw_ptrs,
-                          HashJoinNode* join_node, int batch_size, uint8_t offset)
+                          HashJoinNode* join_node, int batch_size, uint8_t offset,
+                          RuntimeState* state)
             : _rows(rows),
               _skip_rows(0),
               _acquired_block(acquired_block),
@@ -64,6 +71,7 @@ struct ProcessHashTableBuild {
               _join_node(join_node),
               _batch_size(batch_size),
               _offset(offset),
+              _state(state),
               _build_side_compute_hash_timer(join_node->_build_side_compute_hash_timer) {}
 
     template <bool ignore_null, bool short_circuit_for_null>
@@ -99,6 +107,16 @@ struct ProcessHashTableBuild {
         SCOPED_TIMER(_join_node->_build_table_insert_timer);
         hash_table_ctx.hash_table.reset_resize_timer();
 
+        // fill the sub tables in parallel for a big block, unless the session disables them
+        // keys of a direct mapping hash table are all in the same sub table
+        bool parallel_build = !IsDirectMappingHashTableContext<HashTableContext>::value &&
+                              config::hash_join_parallel_build_min_rows > 0 &&
+                              _rows >= config::hash_join_parallel_build_min_rows &&
+                              _state->partitioned_hash_join_rows_threshold() > 0;
+        if (parallel_build) {
+            RETURN_IF_CATCH_BAD_ALLOC(hash_table_ctx.hash_table.partition());
+        }
+
         // only not build_unique, we need expanse hash table before insert data
         // 1. There are fewer duplicate keys, reducing the number of resize hash tables
         // can improve performance to a certain extent, about 2%-5%
@@ -155,6 +173,15 @@ struct ProcessHashTableBuild {
             }
         }
 
+        if (parallel_build) {
+            RETURN_IF_ERROR(_parallel_emplace<ignore_null>(hash_table_ctx, null_map));
+            COUNTER_UPDATE(_join_node->_build_table_expanse_timer,
+                           hash_table_ctx.hash_table.get_resize_timer_value());
+            COUNTER_UPDATE(_join_node->_build_table_convert_timer,
+                           hash_table_ctx.hash_table.get_convert_timer_value());
+            return Status::OK();
+        }
+
         bool build_unique = _join_node->_build_unique;
 #define EMPLACE_IMPL(stmt)                                                                  \
     for (size_t k = 0; k < _rows; ++k) {                                                    \
@@ -213,6 +240,145 @@ struct ProcessHashTableBuild {
     }
 
 private:
+    // Radix partition the rows by the sub tables of their keys, then fill the sub tables in
+    // parallel. A sub table is only touched by one thread and only allocates from its own
+    // arena. The rows of a key are still inserted in their order, so the hash table is the same
+    // as the one built serially.
+    template <bool ignore_null>
+    Status _parallel_emplace(HashTableContext& hash_table_ctx, ConstNullMapPtr null_map) {
+        using KeyGetter = typename HashTableContext::State;
+        using Mapped = typename HashTableContext::Mapped;
+        using HashTable = typename HashTableContext::HashTable;
+        constexpr size_t num_partitions = HashTable::num_sub_tables();
+
+        std::vector<uint32_t> partition_offsets(num_partitions + 1, 0);
+        for (size_t k = 0; k < _rows; ++k) {
+            if constexpr (ignore_null) {
+                if ((*null_map)[k]) {
+                    continue;
+                }
+            }
+            ++partition_offsets[HashTable::get_sub_table_from_hash(_build_side_hash_values[k]) +
+                                1];
+        }
+        for (size_t i = 0; i < num_partitions; ++i) {
+            partition_offsets[i + 1] += partition_offsets[i];
+        }
+        std::vector<uint32_t> partition_rows(partition_offsets[num_partitions]);
+        {
+            std::vector<uint32_t> positions(partition_offsets.begin(), partition_offsets.end());
+            for (size_t k = 0; k < _rows; ++k) {
+                if constexpr (ignore_null) {
+                    if ((*null_map)[k]) {
+                        continue;
+                    }
+                }
+                auto idx = HashTable::get_sub_table_from_hash(_build_side_hash_values[k]);
+                partition_rows[positions[idx]++] = k;
+            }
+        }
+
+        auto& arenas = _join_node->_partition_arenas;
+        if (arenas.empty()) {
+            for (size_t i = 0; i < num_partitions; ++i) {
+                arenas.emplace_back(std::make_shared<Arena>());
+            }
+        }
+        size_t old_arenas_memory = 0;
+        for (auto& arena : arenas) {
+            old_arenas_memory += arena->size();
+        }
+
+        bool has_runtime_filter = !_join_node->_runtime_filter_descs.empty();
+        bool build_unique = _join_node->_build_unique;
+        std::vector<std::vector<int>> partition_inserted_rows(num_partitions);
+        std::vector<int> partition_skip_rows(num_partitions, 0);
+        std::vector<Status> statuses(num_partitions);
+
+        auto build_partition = [&](size_t p) {
+            KeyGetter key_getter(_build_raw_ptrs, _join_node->_build_key_sz, nullptr);
+            if constexpr (ColumnsHashing::IsPreSerializedKeysHashMethodTraits<KeyGetter>::value) {
+                key_getter.set_serialized_keys(hash_table_ctx.keys.data());
+            }
+            auto& sub_table = hash_table_ctx.hash_table.get_sub_table(p);
+            auto& arena = *arenas[p];
+            auto& inserted_rows = partition_inserted_rows[p];
+            const uint32_t end = partition_offsets[p + 1];
+            for (uint32_t i = partition_offsets[p]; i < end; ++i) {
+                uint32_t k = partition_rows[i];
+                auto emplace_result =
+                        key_getter.emplace_key(sub_table, _build_side_hash_values[k], k, arena);
+                if (i + PREFETCH_STEP < end) {
+                    key_getter.template prefetch_by_hash<false>(
+                            sub_table, _build_side_hash_values[partition_rows[i + PREFETCH_STEP]]);
+                }
+                if (emplace_result.is_inserted()) {
+                    new (&emplace_result.get_mapped()) Mapped({k, _offset});
+                } else if (build_unique) {
+                    partition_skip_rows[p]++;
+                    continue;
+                } else {
+                    emplace_result.get_mapped().insert({k, _offset}, arena);
+                }
+                if (has_runtime_filter) {
+                    inserted_rows.push_back(k);
+                }
+            }
+        };
+
+        std::vector<size_t> partitions;
+        for (size_t p = 0; p < num_partitions; ++p) {
+            if (partition_offsets[p + 1] > partition_offsets[p]) {
+                partitions.push_back(p);
+            }
+        }
+        CountDownLatch latch(partitions.size());
+        auto run_partition = [&](size_t p) {
+            statuses[p] = [&]() -> Status {
+                RETURN_IF_CATCH_BAD_ALLOC(build_partition(p));
+                return Status::OK();
+            }();
+            latch.count_down();
+        };
+        auto* thread_pool = ExecEnv::GetInstance()->hash_join_build_thread_pool();
+        for (size_t i = 0; i < partitions.size(); ++i) {
+            size_t p = partitions[i];
+            // the building thread fills the last partition itself, and the partitions which
+            // can not be submitted
+            bool submitted = false;
+            if (thread_pool != nullptr && i + 1 < partitions.size()) {
+                submitted = thread_pool
+                                    ->submit_func([&, p]() {
+                                        SCOPED_ATTACH_TASK(_state);
+                                        run_partition(p);
+                                    })
+                                    .ok();
+            }
+            if (!submitted) {
+                run_partition(p);
+            }
+        }
+        latch.wait();
+
+        size_t arenas_memory = 0;
+        for (auto& arena : arenas) {
+            arenas_memory += arena->size();
+        }
+        _join_node->_build_arena_memory_usage->add(arenas_memory - old_arenas_memory);
+
+        for (size_t p = 0; p < num_partitions; ++p) {
+            RETURN_IF_ERROR(statuses[p]);
+            _skip_rows += partition_skip_rows[p];
+        }
+        if (has_runtime_filter) {
+            auto& inserted_rows = _join_node->_inserted_rows[&_acquired_block];
+            for (auto& rows : partition_inserted_rows) {
+                inserted_rows.insert(inserted_rows.end(), rows.begin(), rows.end());
+            }
+        }
+        return Status::OK();
+    }
+
     const int _rows;
     int _skip_rows;
     Block& _acquired_block;
@@ -220,6 +386,7 @@ private:
     HashJoinNode* _join_node;
     int _batch_size;
     uint8_t _offset;
+    RuntimeState* _state;
 
     ProfileCounter* _build_side_compute_hash_timer;
     std::vector<size_t> _build_side_hash_values;
@@ -418,6 +585,23 @@ Status HashJoinNode::prepare(RuntimeState* state) {
         }
     }
 
+    _external_join_bytes_threshold = state->external_join_bytes_threshold();
+    if (_external_join_bytes_threshold > 0) {
+        _block_spill_profile = runtime_profile()->create_child("BlockSpill", true, true);
+        runtime_profile()->add_child(_block_spill_profile, false, nullptr);
+        _spill_timer = ADD_TIMER(_block_spill_profile, "SpillTime");
+        _spill_build_rows = ADD_COUNTER(_block_spill_profile, "SpillBuildRows", TUnit::UNIT);
+        _spill_probe_rows = ADD_COUNTER(_block_spill_profile, "SpillProbeRows", TUnit::UNIT);
+        _spill_partition_count =
+                ADD_COUNTER(_block_spill_profile, "SpillPartitionCount", TUnit::UNIT);
+        _spill_repartition_count =
+                ADD_COUNTER(_block_spill_profile, "SpillRepartitionCount", TUnit::UNIT);
+        if (_should_build_hash_table) {
+            _revocable_memory = std::make_unique<RevocableMemory>(
+                    fmt::format("HashJoinNode (id={})", id()), state);
+        }
+    }
+
     RETURN_IF_ERROR(VExpr::prepare(_build_expr_ctxs, state, child(1)->row_desc()));
     RETURN_IF_ERROR(VExpr::prepare(_probe_expr_ctxs, state, child(0)->row_desc()));
 
@@ -464,6 +648,14 @@ void HashJoinNode::prepare_for_next() {
 }
 
 Status HashJoinNode::pull(doris::RuntimeState* state, vectorized::Block* output_block, bool* eos) {
+    if (_is_spilled) {
+        return _pull_spilled(state, output_block, eos);
+    }
+    return _pull_in_memory(state, output_block, eos, _probe_eos);
+}
+
+Status HashJoinNode::_pull_in_memory(RuntimeState* state, Block* output_block, bool* eos,
+                                     bool probe_eos) {
     SCOPED_TIMER(_probe_timer);
     if (_short_circuit_for_null_in_probe_side) {
         // If we use a short-circuit strategy for null value in build side (e.g. if join operator is
@@ -519,7 +711,7 @@ Status HashJoinNode::pull(doris::RuntimeState* state, vectorized::Block* output_
         } catch (const doris::Exception& e) {
             return Status::Error(e.code(), e.to_string());
         }
-    } else if (_probe_eos) {
+    } else if (probe_eos) {
         if (_is_right_semi_anti || (_is_outer_join && _join_op != TJoinOp::LEFT_OUTER_JOIN)) {
             std::visit(
                     [&](auto&& arg, auto&& process_hashtable_ctx) {
@@ -552,7 +744,7 @@ Status HashJoinNode::pull(doris::RuntimeState* state, vectorized::Block* output_
     }
     auto output_rows = temp_block.rows();
     DCHECK(output_rows <= state->batch_size());
-    {
+    if (!_filter_conjuncts_in_probe()) {
         SCOPED_TIMER(_join_filter_timer);
         RETURN_IF_ERROR(
                 VExprContext::filter_block(_vconjunct_ctx_ptr, &temp_block, temp_block.columns()));
@@ -563,8 +755,24 @@ Status HashJoinNode::pull(doris::RuntimeState* state, vectorized::Block* output_
     return Status::OK();
 }
 
-Status HashJoinNode::push(RuntimeState* /*state*/, vectorized::Block* input_block, bool eos) {
+Status HashJoinNode::push(RuntimeState* state, vectorized::Block* input_block, bool eos) {
     _probe_eos = eos;
+    if (_is_spilled) {
+        if (input_block->rows() > 0) {
+            COUNTER_UPDATE(_spill_probe_rows, input_block->rows());
+            RETURN_IF_ERROR(_spill_block(state, *input_block, _probe_expr_ctxs,
+                                         *_probe_expr_call_timer, _probe_spill_writers, 0));
+            input_block->clear_column_data();
+        }
+        if (eos) {
+            RETURN_IF_ERROR(_finish_probe_spill(state));
+        }
+        return Status::OK();
+    }
+    return _push_probe_block(input_block);
+}
+
+Status HashJoinNode::_push_probe_block(Block* input_block) {
     if (input_block->rows() > 0) {
         COUNTER_UPDATE(_probe_rows_counter, input_block->rows());
         int probe_expr_ctxs_sz = _probe_expr_ctxs.size();
@@ -609,7 +817,7 @@ Status HashJoinNode::get_next(RuntimeState* state, Block* output_block, bool* eo
         return Status::OK();
     }
 
-    if (_join_op == TJoinOp::RIGHT_OUTER_JOIN) {
+    if (_join_op == TJoinOp::RIGHT_OUTER_JOIN && !_is_spilled) {
         const auto hash_table_empty = std::visit(
                 Overload {[&](std::monostate&) -> bool {
                               LOG(FATAL) << "FATAL: uninited hash table";
@@ -700,6 +908,10 @@ Status HashJoinNode::alloc_resource(doris::RuntimeState* state) {
     RETURN_IF_ERROR(VJoinNodeBase::alloc_resource(state));
     SCOPED_TIMER(_runtime_profile->total_time_counter());
     for (size_t i = 0; i < _runtime_filter_descs.size(); i++) {
+        // the bloom filter sized by build side is allocated when the hash table is built
+        if (_runtime_filters[i]->is_bloom_filter_sized_by_build()) {
+            continue;
+        }
         if (auto bf = _runtime_filters[i]->get_bloomfilter()) {
             RETURN_IF_ERROR(bf->init_with_fixed_length());
         }
@@ -720,6 +932,7 @@ void HashJoinNode::release_resource(RuntimeState* state) {
     if (_vother_join_conjunct_ptr) {
         (*_vother_join_conjunct_ptr)->close(state);
     }
+    _revocable_memory.reset();
     _release_mem();
     VJoinNodeBase::release_resource(state);
 }
@@ -767,6 +980,18 @@ Status HashJoinNode::sink(doris::RuntimeState* state, vectorized::Block* in_bloc
         DCHECK(state->enable_pipeline_exec());
         return Status::OK();
     }
+    if (_is_spilled) {
+        if (in_block->rows() != 0) {
+            COUNTER_UPDATE(_spill_build_rows, in_block->rows());
+            RETURN_IF_ERROR(_spill_block(state, *in_block, _build_expr_ctxs,
+                                         *_build_expr_call_timer, _build_spill_writers, 0));
+        }
+        if (eos) {
+            RETURN_IF_ERROR(_finish_build_spill(state));
+        }
+        return Status::OK();
+    }
+
     if (_should_build_hash_table) {
         // If eos or have already met a null value using short-circuit strategy, we do not need to pull
         // data from probe side.
@@ -777,6 +1002,18 @@ Status HashJoinNode::sink(doris::RuntimeState* state, vectorized::Block* in_bloc
             RETURN_IF_CATCH_BAD_ALLOC(_build_side_mutable_block.merge(*in_block));
         }
 
+        if (_revocable_memory) {
+            _revocable_memory->set_bytes(_build_side_mem_used);
+        }
+        if (_can_spill() && (_build_side_mem_used >= _external_join_bytes_threshold ||
+                             (_revocable_memory && _revocable_memory->revoke_requested()))) {
+            RETURN_IF_ERROR(_start_spill(state));
+            if (eos) {
+                RETURN_IF_ERROR(_finish_build_spill(state));
+            }
+            return Status::OK();
+        }
+
         if (UNLIKELY(_build_side_mem_used - _build_side_last_mem_used > BUILD_BLOCK_MAX_SIZE)) {
             if (_build_blocks->size() == _MAX_BUILD_BLOCK_COUNT) {
                 return Status::NotSupported(
@@ -790,7 +1027,7 @@ Status HashJoinNode::sink(doris::RuntimeState* state, vectorized::Block* in_bloc
             // TODO:: Rethink may we should do the process after we receive all build blocks ?
             // which is better.
             RETURN_IF_ERROR(_process_build_block(state, (*_build_blocks)[_build_block_idx],
-                                                 _build_block_idx));
+                                                 _build_block_idx, false));
 
             _build_side_mutable_block = MutableBlock();
             ++_build_block_idx;
@@ -809,7 +1046,7 @@ Status HashJoinNode::sink(doris::RuntimeState* state, vectorized::Block* in_bloc
             _build_blocks->emplace_back(_build_side_mutable_block.to_block());
             COUNTER_UPDATE(_build_blocks_memory_usage, (*_build_blocks)[_build_block_idx].bytes());
             RETURN_IF_ERROR(_process_build_block(state, (*_build_blocks)[_build_block_idx],
-                                                 _build_block_idx));
+                                                 _build_block_idx, _build_block_idx == 0));
         }
         auto ret = std::visit(Overload {[&](std::monostate&) -> Status {
                                             LOG(FATAL) << "FATAL: uninited hash table";
@@ -833,6 +1070,7 @@ Status HashJoinNode::sink(doris::RuntimeState* state, vectorized::Block* in_bloc
             _shared_hash_table_context->status = Status::OK();
             // arena will be shared with other instances.
             _shared_hash_table_context->arena = _arena;
+            _shared_hash_table_context->partition_arenas = _partition_arenas;
             _shared_hash_table_context->blocks = _build_blocks;
             _shared_hash_table_context->hash_table_variants = _hash_table_variants;
             _shared_hash_table_context->short_circuit_for_null_in_probe_side =
@@ -908,6 +1146,300 @@ void HashJoinNode::debug_string(int indentation_level, std::stringstream* out) c
     *out << ")";
 }
 
+// Spilling is only supported when the hash table is private to this instance and
+// nothing has been inserted into it yet. Joins whose result depends on the whole
+// build side (null aware anti join, mark join, cross join) can not be partitioned.
+bool HashJoinNode::_can_spill() const {
+    return _external_join_bytes_threshold > 0 && _should_build_hash_table &&
+           !_shared_hashtable_controller && _build_blocks->empty() && !_is_mark_join &&
+           !_short_circuit_for_null_in_build_side && _join_op != TJoinOp::CROSS_JOIN &&
+           _join_op != TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN;
+}
+
+Status HashJoinNode::_init_spill_writers(std::vector<BlockSpillWriterUPtr>& writers,
+                                         RuntimeState* state) {
+    writers.resize(SPILL_PARTITION_COUNT);
+    for (auto& writer : writers) {
+        RETURN_IF_ERROR(ExecEnv::GetInstance()->block_spill_mgr()->get_writer(
+                state->batch_size(), writer, _block_spill_profile));
+    }
+    return Status::OK();
+}
+
+// Hash partition the block by the join keys and append the rows to the spill
+// stream of each partition. The seed of the hash depends on the partition level,
+// so rows of one partition are spread again when it is partitioned recursively.
+Status HashJoinNode::_spill_block(RuntimeState* state, Block& block,
+                                  std::vector<VExprContext*>& exprs,
+                                  RuntimeProfile::Counter& expr_call_timer,
+                                  std::vector<BlockSpillWriterUPtr>& writers, int level) {
+    SCOPED_TIMER(_spill_timer);
+    auto rows = block.rows();
+    if (rows == 0) {
+        return Status::OK();
+    }
+    if (writers.empty()) {
+        RETURN_IF_ERROR(_init_spill_writers(writers, state));
+    }
+
+    auto origin_columns = block.columns();
+    std::vector<int> res_col_ids(exprs.size());
+    RETURN_IF_ERROR(_do_evaluate(block, exprs, expr_call_timer, res_col_ids));
+
+    // The seed must also differ from the one used by data stream sender, otherwise the
+    // rows shuffled to this instance would fall into a few partitions.
+    std::vector<uint64_t> hash_vals(rows, 0x9E3779B97F4A7C15ULL + level);
+    for (auto col_id : res_col_ids) {
+        block.get_by_position(col_id).column->update_hashes_with_value(hash_vals.data());
+    }
+    Block::erase_useless_column(&block, origin_columns);
+
+    std::vector<IColumn::Selector> selectors(SPILL_PARTITION_COUNT);
+    for (size_t i = 0; i < rows; ++i) {
+        selectors[hash_vals[i] % SPILL_PARTITION_COUNT].push_back(i);
+    }
+
+    _spill_partition_blocks.resize(SPILL_PARTITION_COUNT);
+    for (int i = 0; i < SPILL_PARTITION_COUNT; ++i) {
+        if (selectors[i].empty()) {
+            continue;
+        }
+        if (!_spill_partition_blocks[i]) {
+            _spill_partition_blocks[i].reset(new MutableBlock(block.clone_empty()));
+        }
+        block.append_block_by_selector(_spill_partition_blocks[i].get(), selectors[i]);
+    }
+    return _flush_spill_partition_blocks(writers, state->batch_size());
+}
+
+Status HashJoinNode::_spill_stream(RuntimeState* state, int64_t stream_id,
+                                   std::vector<VExprContext*>& exprs,
+                                   RuntimeProfile::Counter& expr_call_timer,
+                                   std::vector<BlockSpillWriterUPtr>& writers, int level) {
+    BlockSpillReaderUPtr reader;
+    RETURN_IF_ERROR(ExecEnv::GetInstance()->block_spill_mgr()->get_reader(stream_id, reader,
+                                                                          _block_spill_profile));
+    bool eos = false;
+    Block block;
+    while (!eos) {
+        RETURN_IF_ERROR(reader->read(&block, &eos));
+        RETURN_IF_ERROR(_spill_block(state, block, exprs, expr_call_timer, writers, level));
+    }
+    RETURN_IF_ERROR(reader->close());
+    // all the rows of current side must be written before another side reuses the buffer
+    RETURN_IF_ERROR(_flush_spill_partition_blocks(writers, 0));
+    _spill_partition_blocks.clear();
+    return Status::OK();
+}
+
+// Small partition blocks are buffered until there are at least `min_rows` rows,
+// to avoid writing lots of tiny blocks to disk.
+Status HashJoinNode::_flush_spill_partition_blocks(std::vector<BlockSpillWriterUPtr>& writers,
+                                                   size_t min_rows) {
+    for (int i = 0; i < _spill_partition_blocks.size(); ++i) {
+        auto& mutable_block = _spill_partition_blocks[i];
+        if (!mutable_block || mutable_block->rows() == 0 || mutable_block->rows() < min_rows) {
+            continue;
+        }
+        auto block = mutable_block->to_block();
+        RETURN_IF_ERROR(writers[i]->write(block));
+        block.clear_column_data();
+        mutable_block.reset(new MutableBlock(std::move(block)));
+    }
+    return Status::OK();
+}
+
+Status HashJoinNode::_start_spill(RuntimeState* state) {
+    _is_spilled = true;
+    runtime_profile()->add_info_string("Spilled", "true");
+    RETURN_IF_ERROR(_init_spill_writers(_build_spill_writers, state));
+    if (!_build_side_mutable_block.empty()) {
+        auto block = _build_side_mutable_block.to_block();
+        _build_side_mutable_block = MutableBlock();
+        COUNTER_UPDATE(_spill_build_rows, block.rows());
+        RETURN_IF_ERROR(_spill_block(state, block, _build_expr_ctxs, *_build_expr_call_timer,
+                                     _build_spill_writers, 0));
+    }
+    _build_side_mem_used = 0;
+    _build_side_last_mem_used = 0;
+    // the rest of the build side goes to the spill streams directly
+    if (_revocable_memory) {
+        _revocable_memory->revoked();
+        _revocable_memory.reset();
+    }
+    return Status::OK();
+}
+
+Status HashJoinNode::_finish_build_spill(RuntimeState* state) {
+    RETURN_IF_ERROR(_flush_spill_partition_blocks(_build_spill_writers, 0));
+    _spill_partition_blocks.clear();
+    for (auto& writer : _build_spill_writers) {
+        _spill_partitions.push_back({writer->get_id(), -1, writer->get_written_bytes(), 0});
+        RETURN_IF_ERROR(writer->close());
+    }
+    _build_spill_writers.clear();
+
+    // runtime filters can not be built without the whole hash table
+    _ignore_runtime_filters(state);
+    _process_hashtable_ctx_variants_init(state);
+    return Status::OK();
+}
+
+Status HashJoinNode::_finish_probe_spill(RuntimeState* state) {
+    if (_probe_spill_writers.empty()) {
+        RETURN_IF_ERROR(_init_spill_writers(_probe_spill_writers, state));
+    }
+    RETURN_IF_ERROR(_flush_spill_partition_blocks(_probe_spill_writers, 0));
+    _spill_partition_blocks.clear();
+    DCHECK_EQ(_spill_partitions.size(), _probe_spill_writers.size());
+    for (int i = 0; i < _probe_spill_writers.size(); ++i) {
+        _spill_partitions[i].probe_stream = _probe_spill_writers[i]->get_id();
+        RETURN_IF_ERROR(_probe_spill_writers[i]->close());
+    }
+    _probe_spill_writers.clear();
+    return Status::OK();
+}
+
+Status HashJoinNode::_repartition(RuntimeState* state, const SpillPartition& partition) {
+    COUNTER_UPDATE(_spill_repartition_count, 1);
+    std::vector<BlockSpillWriterUPtr> build_writers;
+    std::vector<BlockSpillWriterUPtr> probe_writers;
+    RETURN_IF_ERROR(_init_spill_writers(build_writers, state));
+    RETURN_IF_ERROR(_init_spill_writers(probe_writers, state));
+    RETURN_IF_ERROR(_spill_stream(state, partition.build_stream, _build_expr_ctxs,
+                                  *_build_expr_call_timer, build_writers, partition.level + 1));
+    RETURN_IF_ERROR(_spill_stream(state, partition.probe_stream, _probe_expr_ctxs,
+                                  *_probe_expr_call_timer, probe_writers, partition.level + 1));
+
+    for (int i = SPILL_PARTITION_COUNT - 1; i >= 0; --i) {
+        _spill_partitions.push_front({build_writers[i]->get_id(), probe_writers[i]->get_id(),
+                                      build_writers[i]->get_written_bytes(),
+                                      partition.level + 1});
+        RETURN_IF_ERROR(build_writers[i]->close());
+        RETURN_IF_ERROR(probe_writers[i]->close());
+    }
+    return Status::OK();
+}
+
+// Load the build side of the partition into a new hash table and open the
+// probe side of it for reading.
+Status HashJoinNode::_build_spilled_partition(RuntimeState* state,
+                                              const SpillPartition& partition) {
+    SCOPED_TIMER(_build_timer);
+    COUNTER_UPDATE(_spill_partition_count, 1);
+    _hash_table_variants = std::make_shared<HashTableVariants>();
+    _hash_table_init(state);
+    _arena = std::make_shared<Arena>();
+    _partition_arenas.clear();
+    _build_blocks.reset(new std::vector<Block>());
+    _build_blocks->reserve(_MAX_BUILD_BLOCK_COUNT);
+    _inserted_rows.clear();
+
+    BlockSpillReaderUPtr reader;
+    RETURN_IF_ERROR(ExecEnv::GetInstance()->block_spill_mgr()->get_reader(
+            partition.build_stream, reader, _block_spill_profile));
+    MutableBlock mutable_block;
+    bool eos = false;
+    Block block;
+    while (!eos) {
+        RETURN_IF_ERROR(reader->read(&block, &eos));
+        if (block.rows() > 0) {
+            SCOPED_TIMER(_build_side_merge_block_timer);
+            RETURN_IF_CATCH_BAD_ALLOC(mutable_block.merge(block));
+        }
+    }
+    RETURN_IF_ERROR(reader->close());
+
+    if (!mutable_block.empty()) {
+        _build_blocks->emplace_back(mutable_block.to_block());
+        COUNTER_UPDATE(_build_blocks_memory_usage, (*_build_blocks)[0].bytes());
+        RETURN_IF_ERROR(_process_build_block(state, (*_build_blocks)[0], 0, true));
+    }
+    _process_hashtable_ctx_variants_init(state);
+
+    return ExecEnv::GetInstance()->block_spill_mgr()->get_reader(
+            partition.probe_stream, _spill_probe_reader, _block_spill_profile);
+}
+
+// Join the spilled partitions one by one after all the probe rows are spilled.
+Status HashJoinNode::_pull_spilled(RuntimeState* state, Block* output_block, bool* eos) {
+    if (!_probe_eos) {
+        return Status::OK();
+    }
+
+    while (!*eos) {
+        if (!_spill_partition_opened) {
+            if (_spill_partitions.empty()) {
+                *eos = true;
+                break;
+            }
+            auto partition = _spill_partitions.front();
+            _spill_partitions.pop_front();
+            if (partition.level < SPILL_MAX_LEVEL &&
+                static_cast<int64_t>(partition.build_bytes) > _external_join_bytes_threshold) {
+                RETURN_IF_ERROR(_repartition(state, partition));
+                continue;
+            }
+            RETURN_IF_ERROR(_build_spilled_partition(state, partition));
+            _spill_partition_opened = true;
+            _spill_probe_eos = false;
+        }
+
+        if (!_spill_probe_eos &&
+            (_probe_block.rows() == 0 || _probe_index == _probe_block.rows())) {
+            prepare_for_next();
+            Block block;
+            RETURN_IF_ERROR(_spill_probe_reader->read(&block, &_spill_probe_eos));
+            if (_spill_probe_eos) {
+                RETURN_IF_ERROR(_spill_probe_reader->close());
+                _spill_probe_reader.reset();
+            } else {
+                RETURN_IF_ERROR(_push_probe_block(&block));
+            }
+        }
+
+        bool partition_eos = false;
+        RETURN_IF_ERROR(_pull_in_memory(state, output_block, &partition_eos, _spill_probe_eos));
+        if (reached_limit()) {
+            *eos = true;
+            break;
+        }
+        if (partition_eos) {
+            _spill_partition_opened = false;
+        }
+        if (output_block->rows() > 0) {
+            break;
+        }
+    }
+    return Status::OK();
+}
+
+void HashJoinNode::_ignore_runtime_filters(RuntimeState* state) {
+    for (auto& filter_desc : _runtime_filter_descs) {
+        IRuntimeFilter* runtime_filter = nullptr;
+        if (!state->runtime_filter_mgr()
+                     ->get_producer_filter(filter_desc.filter_id, &runtime_filter)
+                     .ok()) {
+            continue;
+        }
+        if (runtime_filter->has_remote_target()) {
+            runtime_filter->set_ignored();
+            std::string msg = "hash join spilled";
+            runtime_filter->set_ignored_msg(msg);
+            runtime_filter->publish();
+            runtime_filter->publish_finally();
+        } else {
+            IRuntimeFilter* consumer_filter = nullptr;
+            state->runtime_filter_mgr()->get_consume_filter(filter_desc.filter_id,
+                                                            &consumer_filter);
+            if (consumer_filter) {
+                consumer_filter->set_ignored();
+                consumer_filter->signal();
+            }
+        }
+    }
+}
+
 template <bool BuildSide>
 Status HashJoinNode::_extract_join_column(Block& block, ColumnUInt8::MutablePtr& null_map,
                                           ColumnRawPtrs& raw_ptrs,
@@ -988,7 +1520,8 @@ void HashJoinNode::_set_build_ignore_flag(Block& block, const std::vector<int>&
     }
 }
 
-Status HashJoinNode::_process_build_block(RuntimeState* state, Block& block, uint8_t offset) {
+Status HashJoinNode::_process_build_block(RuntimeState* state, Block& block, uint8_t offset,
+                                          bool try_direct_mapping) {
     SCOPED_TIMER(_build_table_timer);
     size_t rows = block.rows();
     if (UNLIKELY(rows == 0)) {
@@ -1017,6 +1550,10 @@ Status HashJoinNode::_process_build_block(RuntimeState* state, Block& block, uin
 
     // Get the key column that needs to be built
     Status st = _extract_join_column<true>(block, null_map_val, raw_ptrs, res_col_ids);
+    if (try_direct_mapping && raw_ptrs.size() == 1) {
+        RETURN_IF_ERROR(_try_convert_to_direct_mapping(
+                raw_ptrs[0], null_map_val ? &null_map_val->get_data() : nullptr, rows));
+    }
 
     st = std::visit(
             Overload {
@@ -1030,7 +1567,8 @@ Status HashJoinNode::_process_build_block(RuntimeState* state, Block& block, uin
                         auto short_circuit_for_null_in_build_side) -> Status {
                         using HashTableCtxType = std::decay_t<decltype(arg)>;
                         ProcessHashTableBuild<HashTableCtxType> hash_table_build_process(
-                                rows, block, raw_ptrs, this, state->batch_size(), offset);
+                                rows, block, raw_ptrs, this, state->batch_size(), offset,
+                                state);
                         return hash_table_build_process
                                 .template run<has_null_value, short_circuit_for_null_in_build_side>(
                                         arg,
@@ -1045,6 +1583,66 @@ Status HashJoinNode::_process_build_block(RuntimeState* state, Block& block, uin
     return st;
 }
 
+Status HashJoinNode::_try_convert_to_direct_mapping(const IColumn* key_column,
+                                                    ConstNullMapPtr null_map, size_t rows) {
+    if (config::hash_join_direct_mapping_max_range_ratio <= 0) {
+        return Status::OK();
+    }
+    std::shared_ptr<HashTableVariants> direct_variants;
+    auto st = std::visit(
+            Overload {[&](std::monostate& arg) -> Status {
+                          LOG(FATAL) << "FATAL: uninited hash table";
+                          __builtin_unreachable();
+                      },
+                      [&](auto&& arg) -> Status {
+                          using HashTableCtxType = std::decay_t<decltype(arg)>;
+                          using Mapped = typename HashTableCtxType::Mapped;
+                          if constexpr (std::is_same_v<HashTableCtxType,
+                                                       I32HashTableContext<Mapped>> ||
+                                        std::is_same_v<HashTableCtxType,
+                                                       I64HashTableContext<Mapped>>) {
+                              using KeyType = typename HashTableCtxType::HashTable::key_type;
+                              if (arg.hash_table.size() != 0) {
+                                  return Status::OK();
+                              }
+                              const auto* keys = reinterpret_cast<const KeyType*>(
+                                      key_column->get_raw_data().data);
+                              KeyType min_key = std::numeric_limits<KeyType>::max();
+                              KeyType max_key = std::numeric_limits<KeyType>::min();
+                              for (size_t i = 0; i < rows; ++i) {
+                                  if (null_map && (*null_map)[i]) {
+                                      continue;
+                                  }
+                                  min_key = std::min(min_key, keys[i]);
+                                  max_key = std::max(max_key, keys[i]);
+                              }
+                              if (min_key > max_key) {
+                                  return Status::OK();
+                              }
+                              UInt64 range = max_key - min_key;
+                              if (range / config::hash_join_direct_mapping_max_range_ratio >=
+                                  rows) {
+                                  return Status::OK();
+                              }
+                              direct_variants = std::make_shared<HashTableVariants>();
+                              auto& direct_ctx = direct_variants->template emplace<
+                                      DirectPrimaryTypeHashTableContext<KeyType, Mapped>>();
+                              direct_ctx.hash_table.set_key_range(min_key, max_key);
+                              // a bucket for every key of the range
+                              RETURN_IF_CATCH_BAD_ALLOC(
+                                      direct_ctx.hash_table.expanse_for_add_elem(range + 1));
+                          }
+                          return Status::OK();
+                      }},
+            *_hash_table_variants);
+    RETURN_IF_ERROR(st);
+    if (direct_variants) {
+        _hash_table_variants = direct_variants;
+        _build_phase_profile->add_info_string("HashTableType", "DirectMapping");
+    }
+    return Status::OK();
+}
+
 void HashJoinNode::_hash_table_init(RuntimeState* state) {
     std::visit(
             [&](auto&& join_op_variants, auto have_other_join_conjunct) {
@@ -1215,6 +1813,7 @@ HashJoinNode::~HashJoinNode() {
 
 void HashJoinNode::_release_mem() {
     _arena = nullptr;
+    _partition_arenas.clear();
     _hash_table_variants = nullptr;
     _process_hashtable_ctx_variants = nullptr;
     _null_map_column = nullptr;
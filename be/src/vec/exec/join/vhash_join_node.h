@@ -17,12 +17,14 @@
 
 #pragma once
 
+#include <deque>
 #include <future>
 #include <variant>
 
 #include "exprs/runtime_filter_slots.h"
 #include "join_op.h"
 #include "process_hash_table_probe.h"
+#include "runtime/block_spill_manager.h"
 #include "vec/common/columns_hashing.h"
 #include "vec/common/hash_table/hash_map.h"
 #include "vec/common/hash_table/partitioned_hash_map.h"
@@ -112,6 +114,69 @@ using I128HashTableContext = PrimaryTypeHashTableContext<UInt128, RowRefListType
 template <typename RowRefListType>
 using I256HashTableContext = PrimaryTypeHashTableContext<UInt256, RowRefListType>;
 
+// The hash table of a single integer key with dense values. The hash of a key is the key
+// itself, and the table is created with a bucket for every value in [min_key, max_key], so
+// every key has a bucket of its own: there are no hash calculations and no collisions, and a
+// lookup is a range check and a bucket access.
+template <typename T, typename Mapped>
+class DirectMappingHashMap : public PartitionedHashMap<T, Mapped, TrivialHash> {
+public:
+    using Base = PartitionedHashMap<T, Mapped, TrivialHash>;
+    using LookupResult = typename Base::LookupResult;
+
+    void set_key_range(T min_key, T max_key) {
+        _min_key = min_key;
+        _max_key = max_key;
+    }
+
+    LookupResult ALWAYS_INLINE find(T x, size_t hash_value) {
+        // a key out of the range would start a probe in the middle of the filled buckets
+        if (x < _min_key || x > _max_key) {
+            return nullptr;
+        }
+        return Base::find(x, hash_value);
+    }
+
+    LookupResult ALWAYS_INLINE find(T x) { return find(x, this->hash(x)); }
+
+private:
+    T _min_key = 0;
+    T _max_key = 0;
+};
+
+// T should be UInt32 UInt64
+template <class T, typename RowRefListType>
+struct DirectPrimaryTypeHashTableContext {
+    using Mapped = RowRefListType;
+    using HashTable = DirectMappingHashMap<T, Mapped>;
+    using State =
+            ColumnsHashing::HashMethodOneNumber<typename HashTable::value_type, Mapped, T, false>;
+    using Iter = typename HashTable::iterator;
+
+    HashTable hash_table;
+    Iter iter;
+    bool inited = false;
+
+    void init_once() {
+        if (!inited) {
+            inited = true;
+            iter = hash_table.begin();
+        }
+    }
+};
+
+template <typename RowRefListType>
+using I32DirectHashTableContext = DirectPrimaryTypeHashTableContext<UInt32, RowRefListType>;
+template <typename RowRefListType>
+using I64DirectHashTableContext = DirectPrimaryTypeHashTableContext<UInt64, RowRefListType>;
+
+template <typename HashTableContext>
+struct IsDirectMappingHashTableContext : std::false_type {};
+
+template <class T, typename RowRefListType>
+struct IsDirectMappingHashTableContext<DirectPrimaryTypeHashTableContext<T, RowRefListType>>
+        : std::true_type {};
+
 template <class T, bool has_null, typename RowRefListType>
 struct FixedKeyHashTableContext {
     using Mapped = RowRefListType;
@@ -151,6 +216,7 @@ using HashTableVariants = std::variant<
         I128FixedKeyHashTableContext<false, RowRefList>,
         I256FixedKeyHashTableContext<true, RowRefList>,
         I256FixedKeyHashTableContext<false, RowRefList>,
+        I32DirectHashTableContext<RowRefList>, I64DirectHashTableContext<RowRefList>,
         SerializedHashTableContext<RowRefListWithFlag>, I8HashTableContext<RowRefListWithFlag>,
         I16HashTableContext<RowRefListWithFlag>, I32HashTableContext<RowRefListWithFlag>,
         I64HashTableContext<RowRefListWithFlag>, I128HashTableContext<RowRefListWithFlag>,
@@ -161,6 +227,8 @@ using HashTableVariants = std::variant<
         I128FixedKeyHashTableContext<false, RowRefListWithFlag>,
         I256FixedKeyHashTableContext<true, RowRefListWithFlag>,
         I256FixedKeyHashTableContext<false, RowRefListWithFlag>,
+        I32DirectHashTableContext<RowRefListWithFlag>,
+        I64DirectHashTableContext<RowRefListWithFlag>,
         SerializedHashTableContext<RowRefListWithFlags>, I8HashTableContext<RowRefListWithFlags>,
         I16HashTableContext<RowRefListWithFlags>, I32HashTableContext<RowRefListWithFlags>,
         I64HashTableContext<RowRefListWithFlags>, I128HashTableContext<RowRefListWithFlags>,
@@ -170,7 +238,9 @@ using HashTableVariants = std::variant<
         I128FixedKeyHashTableContext<true, RowRefListWithFlags>,
         I128FixedKeyHashTableContext<false, RowRefListWithFlags>,
         I256FixedKeyHashTableContext<true, RowRefListWithFlags>,
-        I256FixedKeyHashTableContext<false, RowRefListWithFlags>>;
+        I256FixedKeyHashTableContext<false, RowRefListWithFlags>,
+        I32DirectHashTableContext<RowRefListWithFlags>,
+        I64DirectHashTableContext<RowRefListWithFlags>>;
 
 class VExprContext;
 class HashJoinNode;
@@ -191,6 +261,11 @@ using HashTableIteratorVariants =
         std::variant<std::monostate, ForwardIterator<RowRefList>,
                      ForwardIterator<RowRefListWithFlag>, ForwardIterator<RowRefListWithFlags>>;
 
+// When `external_join_bytes_threshold` is set and the build side exceeds it,
+// the join becomes a grace hash join: build and probe blocks are hash partitioned
+// by the join keys into spill streams, then each pair of partitions is joined in
+// memory. A build partition that is still too big is partitioned again with a
+// different hash seed, up to `SPILL_MAX_LEVEL` times.
 class HashJoinNode final : public VJoinNodeBase {
 public:
     // TODO: Best prefetch step is decided by machine. We should also provide a
@@ -273,6 +348,8 @@ private:
     RuntimeProfile* _build_phase_profile;
 
     std::shared_ptr<Arena> _arena;
+    // one for each sub table of the hash table, when the sub tables are filled in parallel
+    std::vector<std::shared_ptr<Arena>> _partition_arenas;
 
     // maybe share hash table with other fragment instances
     std::shared_ptr<HashTableVariants> _hash_table_variants;
@@ -317,9 +394,74 @@ private:
 
     SharedHashTableContextPtr _shared_hash_table_context = nullptr;
 
+    // spill to disk
+    struct SpillPartition {
+        int64_t build_stream;
+        int64_t probe_stream;
+        size_t build_bytes;
+        int level;
+    };
+    static constexpr int SPILL_PARTITION_COUNT = 16;
+    static constexpr int SPILL_MAX_LEVEL = 3;
+
+    int64_t _external_join_bytes_threshold = 0;
+    // the build side, which the memory GC may ask to spill until the join is spilled
+    std::unique_ptr<RevocableMemory> _revocable_memory;
+    bool _is_spilled = false;
+    std::vector<BlockSpillWriterUPtr> _build_spill_writers;
+    std::vector<BlockSpillWriterUPtr> _probe_spill_writers;
+    // rows of each partition waiting to be written to its spill stream
+    std::vector<std::unique_ptr<MutableBlock>> _spill_partition_blocks;
+    // partitions waiting to be joined
+    std::deque<SpillPartition> _spill_partitions;
+    BlockSpillReaderUPtr _spill_probe_reader;
+    bool _spill_partition_opened = false;
+    bool _spill_probe_eos = false;
+
+    RuntimeProfile* _block_spill_profile = nullptr;
+    RuntimeProfile::Counter* _spill_timer = nullptr;
+    RuntimeProfile::Counter* _spill_build_rows = nullptr;
+    RuntimeProfile::Counter* _spill_probe_rows = nullptr;
+    RuntimeProfile::Counter* _spill_partition_count = nullptr;
+    RuntimeProfile::Counter* _spill_repartition_count = nullptr;
+
     Status _materialize_build_side(RuntimeState* state) override;
 
-    Status _process_build_block(RuntimeState* state, Block& block, uint8_t offset);
+    Status _push_probe_block(Block* input_block);
+    Status _pull_in_memory(RuntimeState* state, Block* output_block, bool* eos, bool probe_eos);
+
+    bool _can_spill() const;
+    // The conjuncts of an inner join are evaluated with its other join conjuncts in the probe,
+    // so that the joined block is filtered only once.
+    bool _filter_conjuncts_in_probe() const {
+        return _join_op == TJoinOp::INNER_JOIN && _have_other_join_conjunct && !_is_mark_join &&
+               _vconjunct_ctx_ptr != nullptr;
+    }
+    Status _init_spill_writers(std::vector<BlockSpillWriterUPtr>& writers, RuntimeState* state);
+    Status _spill_block(RuntimeState* state, Block& block, std::vector<VExprContext*>& exprs,
+                        RuntimeProfile::Counter& expr_call_timer,
+                        std::vector<BlockSpillWriterUPtr>& writers, int level);
+    Status _spill_stream(RuntimeState* state, int64_t stream_id,
+                         std::vector<VExprContext*>& exprs,
+                         RuntimeProfile::Counter& expr_call_timer,
+                         std::vector<BlockSpillWriterUPtr>& writers, int level);
+    Status _flush_spill_partition_blocks(std::vector<BlockSpillWriterUPtr>& writers,
+                                         size_t min_rows);
+    Status _start_spill(RuntimeState* state);
+    Status _finish_build_spill(RuntimeState* state);
+    Status _finish_probe_spill(RuntimeState* state);
+    Status _repartition(RuntimeState* state, const SpillPartition& partition);
+    Status _build_spilled_partition(RuntimeState* state, const SpillPartition& partition);
+    Status _pull_spilled(RuntimeState* state, Block* output_block, bool* eos);
+    void _ignore_runtime_filters(RuntimeState* state);
+
+    // try_direct_mapping: the block is the only build block, so the hash table may be turned
+    // into a direct mapping one by the range of its keys
+    Status _process_build_block(RuntimeState* state, Block& block, uint8_t offset,
+                                bool try_direct_mapping);
+
+    Status _try_convert_to_direct_mapping(const IColumn* key_column, ConstNullMapPtr null_map,
+                                          size_t rows);
 
     Status _do_evaluate(Block& block, std::vector<VExprContext*>& exprs,
                         RuntimeProfile::Counter& expr_call_timer, std::vector<int>& res_col_ids);
@@ -0,0 +1,486 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/join/vmerge_join_node.h"
+
+#include <glog/logging.h>
+
+#include "common/status.h"
+#include "runtime/runtime_state.h"
+#include "util/runtime_profile.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/exprs/vexpr_context.h"
+
+namespace doris::vectorized {
+
+// Appends the rows to a column of the join block, which may be the nullable one of the column of
+// an input.
+template <typename Insert>
+static void insert_join_column(IColumn& dst, const IColumn& src, Insert&& insert) {
+    if (dst.is_nullable() && !src.is_nullable()) {
+        auto& nullable_column = assert_cast<ColumnNullable&>(dst);
+        insert(nullable_column.get_nested_column());
+        nullable_column.get_null_map_data().resize_fill(nullable_column.get_nested_column().size(),
+                                                        0);
+    } else {
+        insert(dst);
+    }
+}
+
+VMergeJoinNode::VMergeJoinNode(ObjectPool* pool, const TPlanNode& tnode,
+                               const DescriptorTbl& descs)
+        : VJoinNodeBase(pool, tnode, descs) {}
+
+Status VMergeJoinNode::init(const TPlanNode& tnode, RuntimeState* state) {
+    RETURN_IF_ERROR(VJoinNodeBase::init(tnode, state));
+    if (!tnode.__isset.hash_join_node) {
+        return Status::InternalError("merge join node {} has no join conditions", id());
+    }
+    if ((_join_op != TJoinOp::INNER_JOIN && _join_op != TJoinOp::LEFT_OUTER_JOIN &&
+         _join_op != TJoinOp::LEFT_SEMI_JOIN && _join_op != TJoinOp::LEFT_ANTI_JOIN) ||
+        _is_mark_join) {
+        return Status::NotSupported("merge join doesn't support the join op {}",
+                                    static_cast<int>(_join_op));
+    }
+
+    for (const auto& eq_join_conjunct : tnode.hash_join_node.eq_join_conjuncts) {
+        if (eq_join_conjunct.__isset.opcode &&
+            eq_join_conjunct.opcode == TExprOpcode::EQ_FOR_NULL) {
+            return Status::NotSupported("merge join doesn't support the null safe equal");
+        }
+        VExprContext* ctx = nullptr;
+        RETURN_IF_ERROR(VExpr::create_expr_tree(_pool, eq_join_conjunct.left, &ctx));
+        _probe_expr_ctxs.push_back(ctx);
+        RETURN_IF_ERROR(VExpr::create_expr_tree(_pool, eq_join_conjunct.right, &ctx));
+        _build_expr_ctxs.push_back(ctx);
+    }
+    if (_probe_expr_ctxs.empty()) {
+        return Status::InternalError("merge join node {} has no equal join conditions", id());
+    }
+
+    if (tnode.hash_join_node.__isset.vother_join_conjunct) {
+        // the pairs of the other join ops are filtered after they decide the unmatched rows
+        if (_join_op != TJoinOp::INNER_JOIN) {
+            return Status::NotSupported("merge join only supports other join conjuncts for inner "
+                                        "joins");
+        }
+        _vother_join_conjunct_ptr.reset(new VExprContext*);
+        RETURN_IF_ERROR(VExpr::create_expr_tree(_pool, tnode.hash_join_node.vother_join_conjunct,
+                                                _vother_join_conjunct_ptr.get()));
+    }
+    return Status::OK();
+}
+
+Status VMergeJoinNode::prepare(RuntimeState* state) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    RETURN_IF_ERROR(VJoinNodeBase::prepare(state));
+
+    _build_rows_counter = ADD_COUNTER(runtime_profile(), "BuildRows", TUnit::UNIT);
+    _probe_rows_counter = ADD_COUNTER(runtime_profile(), "ProbeRows", TUnit::UNIT);
+    _probe_timer = ADD_TIMER(runtime_profile(), "ProbeTime");
+    _join_filter_timer = ADD_TIMER(runtime_profile(), "JoinFilterTimer");
+    _group_rows_counter = ADD_COUNTER(runtime_profile(), "MatchedBuildRows", TUnit::UNIT);
+
+    RETURN_IF_ERROR(VExpr::prepare(_probe_expr_ctxs, state, child(0)->row_desc()));
+    RETURN_IF_ERROR(VExpr::prepare(_build_expr_ctxs, state, child(1)->row_desc()));
+    for (size_t i = 0; i < _probe_expr_ctxs.size(); ++i) {
+        // the keys are compared by their columns
+        const auto& probe_type = remove_nullable(_probe_expr_ctxs[i]->root()->data_type());
+        const auto& build_type = remove_nullable(_build_expr_ctxs[i]->root()->data_type());
+        if (!probe_type->equals(*build_type)) {
+            return Status::InternalError("merge join keys of different types {} and {}",
+                                         probe_type->get_name(), build_type->get_name());
+        }
+    }
+    if (_vother_join_conjunct_ptr) {
+        RETURN_IF_ERROR((*_vother_join_conjunct_ptr)->prepare(state, *_intermediate_row_desc));
+    }
+    RETURN_IF_ERROR(VExpr::prepare(_output_expr_ctxs, state, *_intermediate_row_desc));
+
+    _num_probe_side_columns = child(0)->row_desc().num_materialized_slots();
+    _num_build_side_columns = child(1)->row_desc().num_materialized_slots();
+    _construct_mutable_join_block();
+    // the intermediate rows of the semi and the anti joins may not have the build side
+    _output_build_side =
+            !_is_left_semi_anti &&
+            _join_block.columns() >= _num_probe_side_columns + _num_build_side_columns;
+    return Status::OK();
+}
+
+Status VMergeJoinNode::alloc_resource(RuntimeState* state) {
+    RETURN_IF_ERROR(VJoinNodeBase::alloc_resource(state));
+    RETURN_IF_ERROR(VExpr::open(_probe_expr_ctxs, state));
+    RETURN_IF_ERROR(VExpr::open(_build_expr_ctxs, state));
+    if (_vother_join_conjunct_ptr) {
+        RETURN_IF_ERROR((*_vother_join_conjunct_ptr)->open(state));
+    }
+    return Status::OK();
+}
+
+void VMergeJoinNode::release_resource(RuntimeState* state) {
+    VExpr::close(_probe_expr_ctxs, state);
+    VExpr::close(_build_expr_ctxs, state);
+    if (_vother_join_conjunct_ptr) {
+        (*_vother_join_conjunct_ptr)->close(state);
+    }
+    VJoinNodeBase::release_resource(state);
+}
+
+Status VMergeJoinNode::close(RuntimeState* state) {
+    if (is_closed()) {
+        return Status::OK();
+    }
+    START_AND_SCOPE_SPAN(state->get_tracer(), span, "VMergeJoinNode::close");
+    for (auto& side : _sides) {
+        side.block.clear();
+        side.key_holders.clear();
+        side.keys.clear();
+    }
+    _group_keys.clear();
+    _group_key_ptrs.clear();
+    _group_columns.clear();
+    return VJoinNodeBase::close(state);
+}
+
+Status VMergeJoinNode::_materialize_build_side(RuntimeState* state) {
+    return child(1)->open(state);
+}
+
+Status VMergeJoinNode::get_next(RuntimeState* state, Block* block, bool* eos) {
+    INIT_AND_SCOPE_GET_NEXT_SPAN(state->get_tracer(), _get_next_span, "VMergeJoinNode::get_next");
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    do {
+        RETURN_IF_CANCELLED(state);
+        for (int side : {PROBE_SIDE, BUILD_SIDE}) {
+            while (need_more_input_data(side)) {
+                Block input_block;
+                bool input_eos = false;
+                RETURN_IF_ERROR_AND_CHECK_SPAN(
+                        child(side)->get_next_after_projects(
+                                state, &input_block, &input_eos,
+                                std::bind((Status(ExecNode::*)(RuntimeState*, vectorized::Block*,
+                                                               bool*)) &
+                                                  ExecNode::get_next,
+                                          _children[side], std::placeholders::_1,
+                                          std::placeholders::_2, std::placeholders::_3)),
+                        child(side)->get_next_span(), input_eos);
+                RETURN_IF_ERROR(push(state, side, &input_block, input_eos));
+            }
+        }
+        RETURN_IF_ERROR(pull(state, block, eos));
+    } while (block->rows() == 0 && !*eos);
+    return Status::OK();
+}
+
+Status VMergeJoinNode::push(RuntimeState* state, int side, Block* block, bool eos) {
+    auto& input = _sides[side];
+    DCHECK(input.exhausted());
+    input.block.swap(*block);
+    block->clear_column_data();
+    input.pos = 0;
+    input.eos = eos;
+    input.need_more = false;
+    COUNTER_UPDATE(side == PROBE_SIDE ? _probe_rows_counter : _build_rows_counter,
+                   input.block.rows());
+    return _eval_keys(side);
+}
+
+Status VMergeJoinNode::_eval_keys(int side) {
+    auto& input = _sides[side];
+    auto& ctxs = side == PROBE_SIDE ? _probe_expr_ctxs : _build_expr_ctxs;
+    const size_t num_columns = input.block.columns();
+    const size_t rows = input.block.rows();
+    input.key_holders.clear();
+    input.keys.clear();
+    input.null_keys.clear();
+    if (rows == 0) {
+        return Status::OK();
+    }
+    for (auto* ctx : ctxs) {
+        int result_column_id = -1;
+        RETURN_IF_ERROR(ctx->execute(&input.block, &result_column_id));
+        auto column = input.block.get_by_position(result_column_id)
+                              .column->convert_to_full_column_if_const();
+        if (auto* nullable_column = check_and_get_column<ColumnNullable>(*column)) {
+            input.null_keys.resize(rows, 0);
+            const auto* __restrict null_map = nullable_column->get_null_map_data().data();
+            auto* __restrict null_keys = input.null_keys.data();
+            for (size_t i = 0; i < rows; ++i) {
+                null_keys[i] |= null_map[i];
+            }
+            input.key_holders.push_back(nullable_column->get_nested_column_ptr());
+        } else {
+            input.key_holders.push_back(column);
+        }
+        input.keys.push_back(input.key_holders.back().get());
+    }
+    Block::erase_useless_column(&input.block, num_columns);
+    return Status::OK();
+}
+
+int VMergeJoinNode::_compare(const Side& lhs, size_t lhs_row, const ColumnRawPtrs& rhs_keys,
+                             size_t rhs_row) const {
+    for (size_t i = 0; i < lhs.keys.size(); ++i) {
+        int res = lhs.keys[i]->compare_at(lhs_row, rhs_row, *rhs_keys[i], 1);
+        if (res != 0) {
+            return res;
+        }
+    }
+    return 0;
+}
+
+bool VMergeJoinNode::_wait_for(int side) {
+    auto& input = _sides[side];
+    if (input.exhausted() && !input.eos) {
+        input.need_more = true;
+        return true;
+    }
+    return false;
+}
+
+bool VMergeJoinNode::_collect_group() {
+    auto& build = _sides[BUILD_SIDE];
+    while (!_wait_for(BUILD_SIDE)) {
+        const size_t rows = build.block.rows();
+        size_t end = build.pos;
+        while (end < rows && !build.has_null_key(end) &&
+               _compare(build, end, _group_key_ptrs, 0) == 0) {
+            ++end;
+        }
+        if (_output_build_side && end > build.pos) {
+            if (_group_columns.empty()) {
+                for (size_t i = 0; i < _num_build_side_columns; ++i) {
+                    _group_columns.push_back(build.block.get_by_position(i).column->clone_empty());
+                }
+            }
+            for (size_t i = 0; i < _num_build_side_columns; ++i) {
+                _group_columns[i]->insert_range_from(*build.block.get_by_position(i).column,
+                                                     build.pos, end - build.pos);
+            }
+        }
+        _group_rows += end - build.pos;
+        build.pos = end;
+        if (end < rows || build.eos) {
+            _group_open = false;
+            COUNTER_UPDATE(_group_rows_counter, _group_rows);
+            return true;
+        }
+    }
+    return false;
+}
+
+void VMergeJoinNode::_resize_tuple_is_null_columns(size_t new_size, int right_flag) {
+    if (_is_outer_join) {
+        assert_cast<ColumnUInt8*>(_tuple_is_null_left_flag_column.get())
+                ->get_data()
+                .resize_fill(new_size, 0);
+        assert_cast<ColumnUInt8*>(_tuple_is_null_right_flag_column.get())
+                ->get_data()
+                .resize_fill(new_size, right_flag);
+    }
+}
+
+void VMergeJoinNode::_output_unmatched(MutableColumns& dst_columns, size_t begin, size_t end) {
+    if (_join_op != TJoinOp::LEFT_OUTER_JOIN && _join_op != TJoinOp::LEFT_ANTI_JOIN) {
+        return;
+    }
+    const auto& probe = _sides[PROBE_SIDE];
+    const size_t rows = end - begin;
+    for (size_t i = 0; i < _num_probe_side_columns; ++i) {
+        const auto& src_column = *probe.block.get_by_position(i).column;
+        insert_join_column(*dst_columns[i], src_column, [&](IColumn& column) {
+            column.insert_range_from(src_column, begin, rows);
+        });
+    }
+    for (size_t i = _num_probe_side_columns; i < dst_columns.size(); ++i) {
+        dst_columns[i]->insert_many_defaults(rows);
+    }
+    _resize_tuple_is_null_columns(dst_columns[0]->size(), 1);
+}
+
+void VMergeJoinNode::_output_matched(MutableColumns& dst_columns, size_t begin, size_t end) {
+    if (_join_op == TJoinOp::LEFT_ANTI_JOIN) {
+        return;
+    }
+    const auto& probe = _sides[PROBE_SIDE];
+    if (_join_op == TJoinOp::LEFT_SEMI_JOIN) {
+        const size_t rows = end - begin;
+        for (size_t i = 0; i < _num_probe_side_columns; ++i) {
+            const auto& src_column = *probe.block.get_by_position(i).column;
+            insert_join_column(*dst_columns[i], src_column, [&](IColumn& column) {
+                column.insert_range_from(src_column, begin, rows);
+            });
+        }
+        for (size_t i = _num_probe_side_columns; i < dst_columns.size(); ++i) {
+            dst_columns[i]->insert_many_defaults(rows);
+        }
+        return;
+    }
+
+    // each probe row with all the build rows of the key
+    for (size_t row = begin; row < end; ++row) {
+        for (size_t i = 0; i < _num_probe_side_columns; ++i) {
+            const auto& src_column = *probe.block.get_by_position(i).column;
+            insert_join_column(*dst_columns[i], src_column, [&](IColumn& column) {
+                column.insert_many_from(src_column, row, _group_rows);
+            });
+        }
+        for (size_t i = 0; i < _num_build_side_columns; ++i) {
+            const auto& src_column = *_group_columns[i];
+            insert_join_column(*dst_columns[_num_probe_side_columns + i], src_column,
+                               [&](IColumn& column) {
+                                   column.insert_range_from(src_column, 0, _group_rows);
+                               });
+        }
+    }
+    _resize_tuple_is_null_columns(dst_columns[0]->size(), 0);
+}
+
+Status VMergeJoinNode::pull(RuntimeState* state, Block* output_block, bool* eos) {
+    SCOPED_TIMER(_probe_timer);
+    auto& probe = _sides[PROBE_SIDE];
+    auto& build = _sides[BUILD_SIDE];
+    *eos = false;
+    {
+        MutableBlock mutable_block(&_join_block);
+        auto& dst_columns = mutable_block.mutable_columns();
+        while (_join_block.rows() < state->batch_size()) {
+            if (_group_open && !_collect_group()) {
+                break;
+            }
+            if (_wait_for(PROBE_SIDE)) {
+                break;
+            }
+            if (probe.exhausted()) {
+                *eos = true;
+                break;
+            }
+            const size_t probe_rows = probe.block.rows();
+
+            if (_has_group) {
+                size_t end = probe.pos;
+                while (end < probe_rows && !probe.has_null_key(end) &&
+                       _compare(probe, end, _group_key_ptrs, 0) == 0) {
+                    ++end;
+                }
+                if (end > probe.pos) {
+                    _output_matched(dst_columns, probe.pos, end);
+                    probe.pos = end;
+                    continue;
+                }
+                // the probe rows went past the key
+                _has_group = false;
+                _group_rows = 0;
+                for (auto& column : _group_columns) {
+                    column->clear();
+                }
+            }
+
+            // the probe rows with a null key match nothing
+            if (probe.has_null_key(probe.pos)) {
+                size_t end = probe.pos + 1;
+                while (end < probe_rows && probe.has_null_key(end)) {
+                    ++end;
+                }
+                _output_unmatched(dst_columns, probe.pos, end);
+                probe.pos = end;
+                continue;
+            }
+
+            // skips the build rows less than the probe key
+            while (!build.exhausted() && (build.has_null_key(build.pos) ||
+                                          _compare(probe, probe.pos, build.keys, build.pos) > 0)) {
+                ++build.pos;
+            }
+            if (_wait_for(BUILD_SIDE)) {
+                break;
+            }
+            if (build.exhausted()) {
+                // nothing else matches
+                if (_join_op == TJoinOp::INNER_JOIN || _join_op == TJoinOp::LEFT_SEMI_JOIN) {
+                    *eos = true;
+                    break;
+                }
+                _output_unmatched(dst_columns, probe.pos, probe_rows);
+                probe.pos = probe_rows;
+                continue;
+            }
+
+            if (_compare(probe, probe.pos, build.keys, build.pos) < 0) {
+                size_t end = probe.pos + 1;
+                while (end < probe_rows && (probe.has_null_key(end) ||
+                                            _compare(probe, end, build.keys, build.pos) < 0)) {
+                    ++end;
+                }
+                _output_unmatched(dst_columns, probe.pos, end);
+                probe.pos = end;
+                continue;
+            }
+
+            // the build rows of the key of the probe row
+            _group_keys.clear();
+            _group_key_ptrs.clear();
+            for (const auto* key : build.keys) {
+                _group_keys.push_back(key->clone_empty());
+                _group_keys.back()->insert_from(*key, build.pos);
+                _group_key_ptrs.push_back(_group_keys.back().get());
+            }
+            _has_group = true;
+            _group_open = true;
+        }
+    }
+
+    if (_vother_join_conjunct_ptr && _join_block.rows() > 0) {
+        SCOPED_TIMER(_join_filter_timer);
+        RETURN_IF_ERROR(VExprContext::filter_block(*_vother_join_conjunct_ptr, &_join_block,
+                                                   _join_block.columns()));
+    }
+    {
+        Block tmp_block = _join_block;
+        _add_tuple_is_null_column(&tmp_block);
+        {
+            SCOPED_TIMER(_join_filter_timer);
+            RETURN_IF_ERROR(VExprContext::filter_block(_vconjunct_ctx_ptr, &tmp_block,
+                                                       tmp_block.columns()));
+        }
+        RETURN_IF_ERROR(_build_output_block(&tmp_block, output_block));
+        _reset_tuple_is_null_column();
+    }
+    _join_block.clear_column_data();
+
+    reached_limit(output_block, eos);
+    if (*eos) {
+        _merge_finished = true;
+    }
+    return Status::OK();
+}
+
+void VMergeJoinNode::_add_tuple_is_null_column(Block* block) {
+    if (_is_outer_join) {
+        auto p0 = _tuple_is_null_left_flag_column->assume_mutable();
+        auto p1 = _tuple_is_null_right_flag_column->assume_mutable();
+        block->insert({std::move(p0), std::make_shared<vectorized::DataTypeUInt8>(),
+                       "left_tuples_is_null"});
+        block->insert({std::move(p1), std::make_shared<vectorized::DataTypeUInt8>(),
+                       "right_tuples_is_null"});
+    }
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,132 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "gen_cpp/PlanNodes_types.h"
+#include "vec/core/block.h"
+#include "vec/exec/join/vjoin_node_base.h"
+
+namespace doris::vectorized {
+
+// Node for the merge joins of two inputs sorted on the join keys in the ascending order with
+// the nulls first, e.g. the key ordered scans of the colocated tables sorted on the join keys.
+//
+// It streams both inputs and only keeps their current blocks and the build rows of the current
+// key, so unlike a hash join its memory doesn't grow with the build side. The rows with a null
+// key never match. It supports the inner joins, the left outer joins and the left semi and anti
+// joins, where only an inner join may have other join conjuncts, and doesn't build any runtime
+// filter.
+class VMergeJoinNode final : public VJoinNodeBase {
+public:
+    static constexpr int PROBE_SIDE = 0;
+    static constexpr int BUILD_SIDE = 1;
+
+    VMergeJoinNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
+
+    Status init(const TPlanNode& tnode, RuntimeState* state = nullptr) override;
+
+    Status prepare(RuntimeState* state) override;
+
+    Status alloc_resource(RuntimeState* state) override;
+
+    void release_resource(RuntimeState* state) override;
+
+    Status get_next(RuntimeState* state, Block* block, bool* eos) override;
+
+    Status close(RuntimeState* state) override;
+
+    // Whether the merge needs the next block of the side to go on.
+    bool need_more_input_data(int side) const { return _sides[side].need_more; }
+
+    // Gives the next block of the side, which is empty at its end.
+    Status push(RuntimeState* state, int side, Block* block, bool eos);
+
+    // Merges the current blocks until the output is full or a side needs more input.
+    Status pull(RuntimeState* state, Block* output_block, bool* eos) override;
+
+    // Whether the output is done before the ends of the inputs, so the rest of them is dropped.
+    bool merge_finished() const { return _merge_finished; }
+
+private:
+    struct Side {
+        Block block;
+        // the join keys of the block without the null maps
+        std::vector<ColumnPtr> key_holders;
+        ColumnRawPtrs keys;
+        // whether a row has a null key, empty if no key is nullable
+        std::vector<uint8_t> null_keys;
+        size_t pos = 0;
+        bool eos = false;
+        bool need_more = true;
+
+        bool exhausted() const { return pos == block.rows(); }
+        bool has_null_key(size_t row) const { return !null_keys.empty() && null_keys[row]; }
+    };
+
+    // The build side is only opened, it's read along with the probe side.
+    Status _materialize_build_side(RuntimeState* state) override;
+
+    void _add_tuple_is_null_column(Block* block) override;
+
+    Status _eval_keys(int side);
+
+    int _compare(const Side& lhs, size_t lhs_row, const ColumnRawPtrs& rhs_keys,
+                 size_t rhs_row) const;
+
+    // Sets need_more of the side if its block is exhausted before its end, and returns whether
+    // the merge has to wait for it.
+    bool _wait_for(int side);
+
+    // Collects the build rows of the current key, and returns false if it waits for the input.
+    bool _collect_group();
+
+    // Outputs the probe rows in [begin, end) without a match for the outer and the anti joins.
+    void _output_unmatched(MutableColumns& dst_columns, size_t begin, size_t end);
+    // Outputs the probe rows in [begin, end) with the build rows of the current key.
+    void _output_matched(MutableColumns& dst_columns, size_t begin, size_t end);
+
+    void _resize_tuple_is_null_columns(size_t new_size, int right_flag);
+
+    std::vector<VExprContext*> _probe_expr_ctxs;
+    std::vector<VExprContext*> _build_expr_ctxs;
+    std::unique_ptr<VExprContext*> _vother_join_conjunct_ptr;
+
+    std::array<Side, 2> _sides;
+    // the key and the build rows of the current key if they're needed by the join op
+    MutableColumns _group_keys;
+    ColumnRawPtrs _group_key_ptrs;
+    MutableColumns _group_columns;
+    size_t _group_rows = 0;
+    bool _has_group = false;
+    // whether the build rows of the current key may continue in the next build block
+    bool _group_open = false;
+
+    size_t _num_probe_side_columns = 0;
+    size_t _num_build_side_columns = 0;
+    bool _output_build_side = false;
+    std::atomic<bool> _merge_finished {false};
+
+    RuntimeProfile::Counter* _group_rows_counter = nullptr;
+};
+
+} // namespace doris::vectorized
@@ -19,8 +19,11 @@
 
 #include <glog/logging.h>
 
+#include <cmath>
+#include <limits>
 #include <sstream>
 
+#include "common/config.h"
 #include "common/status.h"
 #include "exprs/runtime_filter_slots_cross.h"
 #include "gen_cpp/PlanNodes_types.h"
@@ -29,7 +32,9 @@
 #include "util/simd/bits.h"
 #include "vec/columns/column_const.h"
 #include "vec/common/typeid_cast.h"
+#include "vec/data_types/data_type_nullable.h"
 #include "vec/data_types/data_type_number.h"
+#include "vec/exprs/vslot_ref.h"
 #include "vec/utils/template_helpers.hpp"
 #include "vec/utils/util.hpp"
 
@@ -65,6 +70,57 @@ private:
     VNestedLoopJoinNode* _join_node;
 };
 
+// The side of the join whose slots an expr references.
+enum class RangeJoinSide { NONE, PROBE, BUILD, BOTH };
+
+static RangeJoinSide range_join_side(const VExpr* expr, size_t num_probe_side_columns) {
+    if (auto* slot_ref = dynamic_cast<const VSlotRef*>(expr)) {
+        return slot_ref->column_id() < num_probe_side_columns ? RangeJoinSide::PROBE
+                                                              : RangeJoinSide::BUILD;
+    }
+    auto side = RangeJoinSide::NONE;
+    for (const auto* child : expr->children()) {
+        auto child_side = range_join_side(child, num_probe_side_columns);
+        if (side == RangeJoinSide::NONE) {
+            side = child_side;
+        } else if (child_side != RangeJoinSide::NONE && child_side != side) {
+            side = RangeJoinSide::BOTH;
+        }
+    }
+    return side;
+}
+
+// The slot refs or the casts of the same slot ref, e.g. `a.v` of `a.v between b.x and b.y`.
+static bool is_same_range_join_expr(VExpr* lhs, VExpr* rhs) {
+    auto* lhs_slot_ref = dynamic_cast<VSlotRef*>(lhs);
+    auto* rhs_slot_ref = dynamic_cast<VSlotRef*>(rhs);
+    if (lhs_slot_ref != nullptr || rhs_slot_ref != nullptr) {
+        return lhs_slot_ref != nullptr && rhs_slot_ref != nullptr &&
+               lhs_slot_ref->column_id() == rhs_slot_ref->column_id();
+    }
+    return lhs->node_type() == TExprNodeType::CAST_EXPR &&
+           rhs->node_type() == TExprNodeType::CAST_EXPR &&
+           lhs->data_type()->equals(*rhs->data_type()) &&
+           is_same_range_join_expr(lhs->children()[0], rhs->children()[0]);
+}
+
+// The types whose values keep their order as doubles.
+static bool is_range_join_type(const DataTypePtr& type) {
+    switch (remove_nullable(type)->get_type_as_primitive_type()) {
+    case TYPE_TINYINT:
+    case TYPE_SMALLINT:
+    case TYPE_INT:
+    case TYPE_BIGINT:
+    case TYPE_FLOAT:
+    case TYPE_DOUBLE:
+    case TYPE_DATEV2:
+    case TYPE_DATETIMEV2:
+        return true;
+    default:
+        return false;
+    }
+}
+
 VNestedLoopJoinNode::VNestedLoopJoinNode(ObjectPool* pool, const TPlanNode& tnode,
                                          const DescriptorTbl& descs)
         : VJoinNodeBase(pool, tnode, descs),
@@ -110,6 +166,8 @@ Status VNestedLoopJoinNode::prepare(RuntimeState* state) {
     _push_down_timer = ADD_TIMER(runtime_profile(), "PushDownTime");
     _push_compute_timer = ADD_TIMER(runtime_profile(), "PushDownComputeTime");
     _join_filter_timer = ADD_TIMER(runtime_profile(), "JoinFilterTimer");
+    _range_join_candidate_rows =
+            ADD_COUNTER(runtime_profile(), "RangeJoinCandidateRows", TUnit::UNIT);
 
     // pre-compute the tuple index of build tuples in the output row
     int num_build_tuples = child(1)->row_desc().tuple_descriptors().size();
@@ -129,6 +187,154 @@ Status VNestedLoopJoinNode::prepare(RuntimeState* state) {
     RETURN_IF_ERROR(VExpr::prepare(_filter_src_expr_ctxs, state, child(1)->row_desc()));
 
     _construct_mutable_join_block();
+    _init_range_join();
+    return Status::OK();
+}
+
+void VNestedLoopJoinNode::_init_range_join() {
+    // the build rows not found are neither visited nor matched, which is only right for the joins
+    // outputting the matches of the probe rows
+    if (!config::enable_nested_loop_range_join || _vjoin_conjunct_ptr == nullptr ||
+        _is_mark_join || _is_output_left_side_only || _match_all_build || _is_right_semi_anti ||
+        (_join_op != TJoinOp::INNER_JOIN && _join_op != TJoinOp::CROSS_JOIN &&
+         _join_op != TJoinOp::LEFT_OUTER_JOIN && _join_op != TJoinOp::LEFT_SEMI_JOIN)) {
+        return;
+    }
+    std::vector<VExpr*> conjuncts;
+    std::vector<VExpr*> exprs {(*_vjoin_conjunct_ptr)->root()};
+    while (!exprs.empty()) {
+        auto* expr = exprs.back();
+        exprs.pop_back();
+        if (expr->node_type() == TExprNodeType::COMPOUND_PRED &&
+            expr->op() == TExprOpcode::COMPOUND_AND) {
+            exprs.insert(exprs.end(), expr->children().begin(), expr->children().end());
+        } else {
+            conjuncts.push_back(expr);
+        }
+    }
+
+    for (auto* conjunct : conjuncts) {
+        auto op = conjunct->op();
+        if (conjunct->node_type() != TExprNodeType::BINARY_PRED ||
+            conjunct->children().size() != 2 ||
+            (op != TExprOpcode::GE && op != TExprOpcode::GT && op != TExprOpcode::LE &&
+             op != TExprOpcode::LT)) {
+            continue;
+        }
+        auto* probe_expr = conjunct->children()[0];
+        auto* build_expr = conjunct->children()[1];
+        auto probe_side = range_join_side(probe_expr, _num_probe_side_columns);
+        auto build_side = range_join_side(build_expr, _num_probe_side_columns);
+        if (probe_side == RangeJoinSide::BUILD && build_side == RangeJoinSide::PROBE) {
+            std::swap(probe_expr, build_expr);
+            op = op == TExprOpcode::GE   ? TExprOpcode::LE
+                 : op == TExprOpcode::GT ? TExprOpcode::LT
+                 : op == TExprOpcode::LE ? TExprOpcode::GE
+                                         : TExprOpcode::GT;
+        } else if (probe_side != RangeJoinSide::PROBE || build_side != RangeJoinSide::BUILD) {
+            continue;
+        }
+        if (!is_range_join_type(probe_expr->data_type()) ||
+            remove_nullable(probe_expr->data_type())->get_type_as_primitive_type() !=
+                    remove_nullable(build_expr->data_type())->get_type_as_primitive_type()) {
+            continue;
+        }
+        if (_range_probe_expr != nullptr &&
+            !is_same_range_join_expr(_range_probe_expr, probe_expr)) {
+            continue;
+        }
+        auto*& bound_expr = op == TExprOpcode::GE || op == TExprOpcode::GT ? _range_lower_expr
+                                                                           : _range_upper_expr;
+        if (bound_expr == nullptr) {
+            bound_expr = build_expr;
+            _range_probe_expr = probe_expr;
+        }
+    }
+}
+
+Status VNestedLoopJoinNode::_eval_range_join_values(const Block& side_block, bool probe_side,
+                                                    VExpr* expr, std::vector<double>* values,
+                                                    std::vector<uint8_t>* valid) {
+    // the expr is evaluated on a block of the intermediate row with the defaults of the other side
+    const size_t rows = side_block.rows();
+    const size_t begin = probe_side ? 0 : _num_probe_side_columns;
+    const size_t end = probe_side ? _num_probe_side_columns
+                                  : _num_probe_side_columns + _num_build_side_columns;
+    Block block;
+    for (size_t i = 0; i < _join_block.columns(); ++i) {
+        const auto& join_column = _join_block.get_by_position(i);
+        if (i >= begin && i < end) {
+            ColumnPtr column = side_block.get_by_position(i - begin).column;
+            if (join_column.type->is_nullable() && !column->is_nullable()) {
+                column = make_nullable(column);
+            }
+            block.insert({column, join_column.type, join_column.name});
+        } else {
+            block.insert({join_column.type->create_column_const_with_default_value(rows),
+                          join_column.type, join_column.name});
+        }
+    }
+    int result_column_id = -1;
+    RETURN_IF_ERROR(expr->execute(*_vjoin_conjunct_ptr, &block, &result_column_id));
+    auto result = block.get_by_position(result_column_id).column->convert_to_full_column_if_const();
+
+    const IColumn* nested_column = result.get();
+    const NullMap* null_map = nullptr;
+    if (auto* nullable_column = check_and_get_column<ColumnNullable>(*result)) {
+        nested_column = &nullable_column->get_nested_column();
+        null_map = &nullable_column->get_null_map_data();
+    }
+    const bool is_float = check_and_get_column<ColumnFloat32>(*nested_column) != nullptr ||
+                          check_and_get_column<ColumnFloat64>(*nested_column) != nullptr;
+    values->resize(rows);
+    valid->resize(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        double value = is_float ? nested_column->get_float64(i)
+                                : static_cast<double>(nested_column->get_int(i));
+        (*values)[i] = value;
+        (*valid)[i] = (null_map == nullptr || !(*null_map)[i]) && !std::isnan(value);
+    }
+    return Status::OK();
+}
+
+Status VNestedLoopJoinNode::_build_range_join() {
+    if (_range_probe_expr == nullptr || _build_blocks.empty() ||
+        _build_rows > std::numeric_limits<int>::max()) {
+        return Status::OK();
+    }
+    // the rows found are in one block
+    if (_build_blocks.size() > 1) {
+        MutableBlock mutable_block;
+        for (auto& block : _build_blocks) {
+            RETURN_IF_ERROR(mutable_block.merge(std::move(block)));
+        }
+        _build_blocks.clear();
+        _build_blocks.emplace_back(mutable_block.to_block());
+    }
+
+    const auto& build_block = _build_blocks[0];
+    const size_t rows = build_block.rows();
+    std::vector<double> lower(rows, -std::numeric_limits<double>::infinity());
+    std::vector<double> upper(rows, std::numeric_limits<double>::infinity());
+    std::vector<uint8_t> lower_valid(rows, 1);
+    std::vector<uint8_t> upper_valid(rows, 1);
+    if (_range_lower_expr != nullptr) {
+        RETURN_IF_ERROR(_eval_range_join_values(build_block, false, _range_lower_expr, &lower,
+                                                &lower_valid));
+    }
+    if (_range_upper_expr != nullptr) {
+        RETURN_IF_ERROR(_eval_range_join_values(build_block, false, _range_upper_expr, &upper,
+                                                &upper_valid));
+    }
+    // the rows with a null bound match nothing
+    std::vector<RangeJoinIndex::Range> ranges;
+    ranges.reserve(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        if (lower_valid[i] && upper_valid[i]) {
+            ranges.push_back({lower[i], upper[i], static_cast<int>(i)});
+        }
+    }
+    _range_join_index = std::make_unique<RangeJoinIndex>(std::move(ranges));
     return Status::OK();
 }
 
@@ -187,6 +393,7 @@ Status VNestedLoopJoinNode::sink(doris::RuntimeState* state, vectorized::Block*
 
     if (eos) {
         COUNTER_UPDATE(_build_rows_counter, _build_rows);
+        RETURN_IF_ERROR(_build_range_join());
         RuntimeFilterBuild(this)(state);
 
         // optimize `in bitmap`, see https://github.com/apache/doris/issues/14338
@@ -205,6 +412,11 @@ Status VNestedLoopJoinNode::push(doris::RuntimeState* state, vectorized::Block*
     _need_more_input_data = false;
     _left_side_eos = eos;
 
+    if (_range_join_index && _left_block.rows() > 0) {
+        RETURN_IF_ERROR(_eval_range_join_values(_left_block, true, _range_probe_expr,
+                                                &_range_probe_values, &_range_probe_valid));
+    }
+
     if (!_is_output_left_side_only) {
         auto func = [&](auto&& join_op_variants, auto set_build_side_flag,
                         auto set_probe_side_flag) {
@@ -280,9 +492,26 @@ void VNestedLoopJoinNode::_append_left_data_with_null(MutableBlock& mutable_bloc
 }
 
 void VNestedLoopJoinNode::_process_left_child_block(MutableBlock& mutable_block,
-                                                    const Block& now_process_build_block) const {
+                                                    const Block& now_process_build_block) {
     auto& dst_columns = mutable_block.mutable_columns();
-    const int max_added_rows = now_process_build_block.rows();
+    int max_added_rows = now_process_build_block.rows();
+    if (_range_join_index) {
+        _range_build_rows.clear();
+        if (_range_probe_valid[_left_block_pos]) {
+            _range_join_index->find(_range_probe_values[_left_block_pos], &_range_build_rows);
+        }
+        max_added_rows = _range_build_rows.size();
+        COUNTER_UPDATE(_range_join_candidate_rows, max_added_rows);
+    }
+    // inserts all the build rows or the ones found by the range join index
+    auto insert_build_rows = [&](IColumn& dst_column, const IColumn& src_column) {
+        if (_range_join_index) {
+            dst_column.insert_indices_from(src_column, _range_build_rows.data(),
+                                           _range_build_rows.data() + _range_build_rows.size());
+        } else {
+            dst_column.insert_range_from(src_column, 0, max_added_rows);
+        }
+    };
     for (size_t i = 0; i < _num_probe_side_columns; ++i) {
         const ColumnWithTypeAndName& src_column = _left_block.get_by_position(i);
         if (!src_column.column->is_nullable() && dst_columns[i]->is_nullable()) {
@@ -305,16 +534,16 @@ void VNestedLoopJoinNode::_process_left_child_block(MutableBlock& mutable_block,
             dst_columns[_num_probe_side_columns + i]->is_nullable()) {
             auto origin_sz = dst_columns[_num_probe_side_columns + i]->size();
             DCHECK(_join_op == TJoinOp::LEFT_OUTER_JOIN || _join_op == TJoinOp::FULL_OUTER_JOIN);
-            assert_cast<ColumnNullable*>(dst_columns[_num_probe_side_columns + i].get())
-                    ->get_nested_column_ptr()
-                    ->insert_range_from(*src_column.column.get(), 0, max_added_rows);
+            insert_build_rows(
+                    assert_cast<ColumnNullable*>(dst_columns[_num_probe_side_columns + i].get())
+                            ->get_nested_column(),
+                    *src_column.column);
             assert_cast<ColumnNullable*>(dst_columns[_num_probe_side_columns + i].get())
                     ->get_null_map_column()
                     .get_data()
                     .resize_fill(origin_sz + max_added_rows, 0);
         } else {
-            dst_columns[_num_probe_side_columns + i]->insert_range_from(*src_column.column.get(), 0,
-                                                                        max_added_rows);
+            insert_build_rows(*dst_columns[_num_probe_side_columns + i], *src_column.column);
         }
     }
 }
@@ -657,6 +886,10 @@ void VNestedLoopJoinNode::_release_mem() {
 
     _tuple_is_null_left_flag_column = nullptr;
     _tuple_is_null_right_flag_column = nullptr;
+
+    _range_join_index.reset();
+    std::vector<double>().swap(_range_probe_values);
+    std::vector<uint8_t>().swap(_range_probe_valid);
 }
 
 Status VNestedLoopJoinNode::pull(RuntimeState* state, vectorized::Block* block, bool* eos) {
@@ -26,6 +26,7 @@
 #include "gen_cpp/PlanNodes_types.h"
 #include "runtime/descriptors.h"
 #include "vec/core/block.h"
+#include "vec/exec/join/range_join_index.h"
 #include "vec/exec/join/vjoin_node_base.h"
 
 namespace doris::vectorized {
@@ -166,7 +167,16 @@ private:
     //  dst_columns: left_child_row and now_process_build_block to construct a bundle column of new block
     //  now_process_build_block: right child block now to process
     void _process_left_child_block(MutableBlock& mutable_block,
-                                   const Block& now_process_build_block) const;
+                                   const Block& now_process_build_block);
+
+    // Finds the range predicates on a probe value in the join conjunct to join the probe rows with
+    // the build rows found by a RangeJoinIndex instead of all of them, see _build_range_join.
+    void _init_range_join();
+    Status _build_range_join();
+    // Evaluates the probe value or a bound of the build rows on a block of a side, where the
+    // nulls and the NaNs are invalid.
+    Status _eval_range_join_values(const Block& side_block, bool probe_side, VExpr* expr,
+                                   std::vector<double>* values, std::vector<uint8_t>* valid);
 
     template <bool SetBuildSideFlag, bool SetProbeSideFlag, bool IgnoreNull>
     Status _do_filtering_and_update_visited_flags(Block* block, bool materialize);
@@ -233,6 +243,19 @@ private:
     std::stack<uint16_t> _offset_stack;
     std::unique_ptr<VExprContext*> _vjoin_conjunct_ptr;
 
+    // the range join of `probe >= build_lower and probe <= build_upper` in the join conjunct,
+    // where either bound may be absent
+    VExpr* _range_probe_expr = nullptr;
+    VExpr* _range_lower_expr = nullptr;
+    VExpr* _range_upper_expr = nullptr;
+    std::unique_ptr<RangeJoinIndex> _range_join_index;
+    // the probe values of _left_block and the build rows found for the current probe row
+    std::vector<double> _range_probe_values;
+    std::vector<uint8_t> _range_probe_valid;
+    std::vector<int> _range_build_rows;
+
+    RuntimeProfile::Counter* _range_join_candidate_rows = nullptr;
+
     friend struct RuntimeFilterBuild;
 };
 
@@ -17,6 +17,7 @@
 
 #include "vec/exec/scan/new_es_scan_node.h"
 
+#include "common/config.h"
 #include "exec/es/es_scroll_query.h"
 #include "vec/exec/scan/new_es_scanner.h"
 #include "vec/utils/util.hpp"
@@ -142,17 +143,30 @@ Status NewEsScanNode::_init_scanners(std::list<VScanner*>* scanners) {
             properties[ESScanReader::KEY_TERMINATE_AFTER] = std::to_string(limit());
         }
 
-        bool doc_value_mode = false;
-        properties[ESScanReader::KEY_QUERY] = ESScrollQueryBuilder::build(
-                properties, _column_names, _docvalue_context, &doc_value_mode);
-
-        NewEsScanner* scanner =
-                new NewEsScanner(_state, this, _limit_per_scanner, _tuple_id, properties,
-                                 _docvalue_context, doc_value_mode, _state->runtime_profile());
-
-        _scanner_pool.add(scanner);
-        RETURN_IF_ERROR(scanner->prepare(_state, _vconjunct_ctx_ptr.get()));
-        scanners->push_back(static_cast<VScanner*>(scanner));
+        // the scroll of the shard is split into the slices read in parallel, except for a small
+        // limit, which is reached by one scroll
+        int num_slices = 1;
+        if (properties.find(ESScanReader::KEY_TERMINATE_AFTER) == properties.end()) {
+            num_slices = std::max(config::es_scroll_slices_per_shard, 1);
+        }
+        for (int slice = 0; slice < num_slices; ++slice) {
+            std::map<std::string, std::string> slice_properties(properties);
+            if (num_slices > 1) {
+                slice_properties[ESScanReader::KEY_SLICE_ID] = std::to_string(slice);
+                slice_properties[ESScanReader::KEY_SLICE_MAX] = std::to_string(num_slices);
+            }
+            bool doc_value_mode = false;
+            slice_properties[ESScanReader::KEY_QUERY] = ESScrollQueryBuilder::build(
+                    slice_properties, _column_names, _docvalue_context, &doc_value_mode);
+
+            NewEsScanner* scanner = new NewEsScanner(_state, this, _limit_per_scanner, _tuple_id,
+                                                     slice_properties, _docvalue_context,
+                                                     doc_value_mode, _state->runtime_profile());
+
+            _scanner_pool.add(scanner);
+            RETURN_IF_ERROR(scanner->prepare(_state, _vconjunct_ctx_ptr.get()));
+            scanners->push_back(static_cast<VScanner*>(scanner));
+        }
     }
     return Status::OK();
 }
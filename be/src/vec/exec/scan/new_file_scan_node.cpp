@@ -17,6 +17,10 @@
 
 #include "vec/exec/scan/new_file_scan_node.h"
 
+#include "io/fs/stream_load_pipe.h"
+#include "runtime/exec_env.h"
+#include "runtime/stream_load/new_load_stream_mgr.h"
+#include "runtime/stream_load/stream_load_context.h"
 #include "vec/exec/scan/vfile_scanner.h"
 
 namespace doris::vectorized {
@@ -92,17 +96,89 @@ Status NewFileScanNode::_init_scanners(std::list<VScanner*>* scanners) {
             std::min<size_t>(config::doris_scanner_thread_pool_thread_num, _scan_ranges.size());
     _kv_cache.reset(new ShardedKVCache(shard_num));
     for (auto& scan_range : _scan_ranges) {
-        VScanner* scanner = new VFileScanner(_state, this, _limit_per_scanner,
-                                             scan_range.scan_range.ext_scan_range.file_scan_range,
-                                             runtime_profile(), _kv_cache.get());
-        _scanner_pool.add(scanner);
-        RETURN_IF_ERROR(((VFileScanner*)scanner)
-                                ->prepare(_vconjunct_ctx_ptr.get(), &_colname_to_value_range,
-                                          &_colname_to_slot_id));
-        scanners->push_back(scanner);
+        const auto& file_scan_range = scan_range.scan_range.ext_scan_range.file_scan_range;
+        int num_scanners = 1;
+        std::shared_ptr<FileRangeSource> range_source;
+        std::vector<TFileRangeDesc> split_ranges;
+        if (_split_ranges(file_scan_range, &split_ranges)) {
+            range_source = std::make_shared<FileRangeSource>(std::move(split_ranges));
+            num_scanners = std::min<size_t>(range_source->ranges.size(),
+                                            config::doris_scanner_thread_pool_thread_num);
+        } else {
+            num_scanners = _num_scanners_of_range(file_scan_range);
+        }
+        for (int i = 0; i < num_scanners; ++i) {
+            VScanner* scanner =
+                    new VFileScanner(_state, this, _limit_per_scanner, file_scan_range,
+                                     runtime_profile(), _kv_cache.get(), range_source);
+            _scanner_pool.add(scanner);
+            RETURN_IF_ERROR(((VFileScanner*)scanner)
+                                    ->prepare(_vconjunct_ctx_ptr.get(), &_colname_to_value_range,
+                                              &_colname_to_slot_id));
+            scanners->push_back(scanner);
+        }
     }
 
     return Status::OK();
 }
 
+bool NewFileScanNode::_split_ranges(const TFileScanRange& file_scan_range,
+                                    std::vector<TFileRangeDesc>* split_ranges) {
+    const int64_t split_size = config::file_scan_split_size_bytes;
+    const auto& params = file_scan_range.params;
+    if (split_size <= 0 || params.file_type == TFileType::FILE_STREAM) {
+        return false;
+    }
+    switch (params.format_type) {
+    case TFileFormatType::FORMAT_PARQUET:
+    case TFileFormatType::FORMAT_ORC:
+        // the readers read the row groups or the stripes whose offsets are in the range
+        break;
+    case TFileFormatType::FORMAT_CSV_PLAIN:
+        // the reader skips the first line of a range not at the start of the file
+        if (params.__isset.compress_type && params.compress_type != TFileCompressType::UNKNOWN &&
+            params.compress_type != TFileCompressType::PLAIN) {
+            return false;
+        }
+        break;
+    default:
+        return false;
+    }
+
+    bool split = false;
+    for (const auto& range : file_scan_range.ranges) {
+        // the delete files of the table formats are applied by the position in the whole range
+        if (range.__isset.table_format_params || range.size < 2 * split_size) {
+            split_ranges->push_back(range);
+            continue;
+        }
+        split = true;
+        const int64_t end = range.start_offset + range.size;
+        int64_t start = range.start_offset;
+        while (start < end) {
+            // the last one takes the tail shorter than the split size
+            int64_t size = end - start < 2 * split_size ? end - start : split_size;
+            TFileRangeDesc sub_range = range;
+            sub_range.__set_start_offset(start);
+            sub_range.__set_size(size);
+            split_ranges->push_back(std::move(sub_range));
+            start += size;
+        }
+    }
+    return split;
+}
+
+int NewFileScanNode::_num_scanners_of_range(const TFileScanRange& file_scan_range) {
+    auto* load_stream_mgr = _state->exec_env()->new_load_stream_mgr();
+    if (file_scan_range.params.file_type != TFileType::FILE_STREAM ||
+        file_scan_range.ranges.size() != 1 || load_stream_mgr == nullptr) {
+        return 1;
+    }
+    auto stream_load_ctx = load_stream_mgr->get(file_scan_range.ranges[0].load_id);
+    if (stream_load_ctx == nullptr || stream_load_ctx->pipe == nullptr) {
+        return 1;
+    }
+    return std::max(stream_load_ctx->pipe->num_sub_pipes(), 1);
+}
+
 }; // namespace doris::vectorized
@@ -38,6 +38,15 @@ protected:
     Status _init_scanners(std::list<VScanner*>* scanners) override;
 
 private:
+    // the number of scanners to read the file scan range, it's more than 1 only if the range
+    // is the body of a load whose pipe has sub pipes, see StreamLoadPipe::num_sub_pipes()
+    int _num_scanners_of_range(const TFileScanRange& file_scan_range);
+
+    // Splits the large ranges of the file scan range into the ranges of
+    // config::file_scan_split_size_bytes, returns false if none of them is split.
+    bool _split_ranges(const TFileScanRange& file_scan_range,
+                       std::vector<TFileRangeDesc>* split_ranges);
+
     std::vector<TScanRangeParams> _scan_ranges;
     // A in memory cache to save some common components
     // of the this scan node. eg:
@@ -18,15 +18,20 @@
 #include "vec/exec/scan/new_olap_scan_node.h"
 
 #include <charconv>
+#include <unordered_set>
 
 #include "common/status.h"
 #include "olap/storage_engine.h"
 #include "olap/tablet.h"
 #include "pipeline/pipeline.h"
 #include "pipeline/pipeline_fragment_context.h"
+#include "util/md5.h"
+#include "util/thrift_util.h"
 #include "util/to_string.h"
 #include "vec/columns/column_const.h"
 #include "vec/exec/scan/new_olap_scanner.h"
+#include "vec/exec/scan/scan_cache.h"
+#include "vec/exprs/vslot_ref.h"
 
 namespace doris::vectorized {
 
@@ -47,6 +52,75 @@ Status NewOlapScanNode::collect_query_statistics(QueryStatistics* statistics) {
     return Status::OK();
 }
 
+Status NewOlapScanNode::init(const TPlanNode& tnode, RuntimeState* state) {
+    RETURN_IF_ERROR(VScanNode::init(tnode, state));
+    _use_scan_cache = state->enable_scan_cache() && ScanCache::instance() != nullptr &&
+                      ScanCache::instance()->enabled();
+    if (_use_scan_cache || state->enable_cross_query_shared_scan()) {
+        _init_scan_cache_digest(tnode, state);
+    }
+    return Status::OK();
+}
+
+// The functions whose results are not decided by their arguments.
+static const std::unordered_set<std::string> NONDETERMINISTIC_FUNCTIONS = {
+        "rand", "random", "uuid", "uuid_numeric", "now", "localtime", "localtimestamp",
+        "current_timestamp", "curdate", "current_date", "curtime", "current_time",
+        "utc_timestamp", "unix_timestamp", "sleep", "connection_id", "current_user", "user",
+        "database", "schema"};
+
+static bool is_deterministic(const TExpr& expr) {
+    for (const auto& node : expr.nodes) {
+        if (node.__isset.fn && NONDETERMINISTIC_FUNCTIONS.count(node.fn.name.function_name)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void NewOlapScanNode::_init_scan_cache_digest(const TPlanNode& tnode, RuntimeState* state) {
+    // the runtime filters depend on the other side of the joins, and the scanners with a limit
+    // may stop early
+    if (!tnode.runtime_filters.empty() || tnode.limit >= 0 || _limit_per_scanner >= 0) {
+        return;
+    }
+    for (const auto& conjunct : tnode.conjuncts) {
+        if (!is_deterministic(conjunct)) {
+            return;
+        }
+    }
+    if (tnode.__isset.vconjunct && !is_deterministic(tnode.vconjunct)) {
+        return;
+    }
+
+    TPlanNode plan_node = tnode;
+    // the ids of the node and the fragment are not part of the plan
+    plan_node.node_id = 0;
+    ThriftSerializer serializer(false, 4096);
+    std::string plan_str;
+    if (!serializer.serialize(&plan_node, &plan_str).ok()) {
+        return;
+    }
+    std::stringstream ss;
+    ss << plan_str;
+    const TupleDescriptor* tuple_desc = state->desc_tbl().get_tuple_descriptor(_output_tuple_id);
+    for (const auto* slot : tuple_desc->slots()) {
+        ss << "|" << slot->id() << "," << slot->col_unique_id() << "," << slot->col_name() << ","
+           << slot->type().debug_string() << "," << slot->is_nullable() << ","
+           << slot->need_materialize();
+    }
+    const TQueryOptions& query_options = state->query_options();
+    ss << "|" << state->timezone() << "," << state->be_exec_version() << ","
+       << state->skip_storage_engine_merge() << "," << state->skip_delete_predicate() << ","
+       << state->skip_delete_bitmap() << "," << query_options.enable_common_expr_pushdown << ","
+       << config::enable_offsets_only_nested_read;
+    Md5Digest digest;
+    std::string str = ss.str();
+    digest.update(str.data(), str.size());
+    digest.digest();
+    _scan_cache_digest = digest.hex();
+}
+
 Status NewOlapScanNode::prepare(RuntimeState* state) {
     RETURN_IF_ERROR(VScanNode::prepare(state));
     return Status::OK();
@@ -56,6 +130,13 @@ Status NewOlapScanNode::_init_profile() {
     RETURN_IF_ERROR(VScanNode::_init_profile());
 
     _tablet_counter = ADD_COUNTER(_runtime_profile, "TabletNum", TUnit::UNIT);
+    _scan_cache_hit_counter = ADD_COUNTER(_runtime_profile, "ScanCacheHitScanners", TUnit::UNIT);
+    _scan_cache_insert_counter =
+            ADD_COUNTER(_runtime_profile, "ScanCacheInsertScanners", TUnit::UNIT);
+    _shared_scan_follower_counter =
+            ADD_COUNTER(_runtime_profile, "SharedScanFollowerScanners", TUnit::UNIT);
+    _shared_scan_rows_counter =
+            ADD_COUNTER(_runtime_profile, "SharedScanRowsFromLeaders", TUnit::UNIT);
 
     // 1. init segment profile
     _segment_profile.reset(new RuntimeProfile("SegmentIterator"));
@@ -86,6 +167,8 @@ Status NewOlapScanNode::_init_profile() {
             ADD_COUNTER(_segment_profile, "RowsVectorPredInput", TUnit::UNIT);
     _rows_short_circuit_cond_input_counter =
             ADD_COUNTER(_segment_profile, "RowsShortCircuitPredInput", TUnit::UNIT);
+    _predicate_reorder_counter =
+            ADD_COUNTER(_segment_profile, "PredicateReorderCount", TUnit::UNIT);
     _vec_cond_timer = ADD_TIMER(_segment_profile, "VectorPredEvalTime");
     _short_cond_timer = ADD_TIMER(_segment_profile, "ShortPredEvalTime");
     _expr_filter_timer = ADD_TIMER(_segment_profile, "ExprFilterEvalTime");
@@ -113,6 +196,15 @@ Status NewOlapScanNode::_init_profile() {
 
     _total_pages_num_counter = ADD_COUNTER(_segment_profile, "TotalPagesNum", TUnit::UNIT);
     _cached_pages_num_counter = ADD_COUNTER(_segment_profile, "CachedPagesNum", TUnit::UNIT);
+    _compressed_cached_pages_num_counter =
+            ADD_COUNTER(_segment_profile, "CompressedCachedPagesNum", TUnit::UNIT);
+    _mapped_pages_num_counter = ADD_COUNTER(_segment_profile, "MappedPagesNum", TUnit::UNIT);
+    _remote_page_prefetch_hit_counter =
+            ADD_COUNTER(_segment_profile, "RemotePagePrefetchHit", TUnit::UNIT);
+    _remote_page_prefetch_miss_counter =
+            ADD_COUNTER(_segment_profile, "RemotePagePrefetchMiss", TUnit::UNIT);
+    _merged_page_read_counter = ADD_COUNTER(_segment_profile, "MergedPageReadNum", TUnit::UNIT);
+    _merged_pages_num_counter = ADD_COUNTER(_segment_profile, "MergedPagesNum", TUnit::UNIT);
 
     _bitmap_index_filter_counter =
             ADD_COUNTER(_segment_profile, "RowsBitmapIndexFiltered", TUnit::UNIT);
@@ -139,6 +231,8 @@ Status NewOlapScanNode::_init_profile() {
 
     _filtered_segment_counter = ADD_COUNTER(_segment_profile, "NumSegmentFiltered", TUnit::UNIT);
     _total_segment_counter = ADD_COUNTER(_segment_profile, "NumSegmentTotal", TUnit::UNIT);
+    _pruned_delete_condition_counter =
+            ADD_COUNTER(_segment_profile, "NumDeleteConditionPruned", TUnit::UNIT);
 
     // for the purpose of debugging or profiling
     for (int i = 0; i < GENERAL_DEBUG_COUNT; ++i) {
@@ -211,6 +305,50 @@ Status NewOlapScanNode::_process_conjuncts() {
     return Status::OK();
 }
 
+Status NewOlapScanNode::_push_down_late_arrival_runtime_filters(
+        const std::vector<VExpr*>& vexprs) {
+    if (_olap_scan_node.__isset.push_down_agg_type_opt &&
+        _olap_scan_node.push_down_agg_type_opt != TPushAggOp::NONE) {
+        return Status::OK();
+    }
+
+    // Normalize the newly arrived filters into the value ranges of their slots, then push the
+    // narrowed ranges down as olap filters, so that the scanners which are not initialized yet
+    // can prune segments and pages by zone map, bloom filter and bitmap index.
+    // The filters are still kept in the conjuncts, because the scanners which are already opened
+    // can not see them, and their key ranges are not re-planned.
+    bool eos = _eos;
+    std::set<SlotId> slot_ids;
+    for (auto* vexpr : vexprs) {
+        VExpr* output_expr = nullptr;
+        RETURN_IF_ERROR(_normalize_predicate(vexpr, &output_expr));
+        const VExpr* impl = vexpr->get_impl() ? vexpr->get_impl() : vexpr;
+        for (const auto* child : impl->children()) {
+            if (VExpr::expr_without_cast(child)->node_type() == TExprNodeType::SLOT_REF) {
+                slot_ids.insert(static_cast<const VSlotRef*>(VExpr::expr_without_cast(child))
+                                        ->slot_id());
+                break;
+            }
+        }
+    }
+    // An empty value range only means there is no row left after the filter, which is handled by
+    // the conjuncts. Do not stop the running scanners here.
+    _eos = eos;
+
+    for (auto slot_id : slot_ids) {
+        auto iter = _slot_id_to_value_range.find(slot_id);
+        if (iter == _slot_id_to_value_range.end()) {
+            continue;
+        }
+        std::vector<TCondition> filters;
+        std::visit([&](auto&& range) { range.to_olap_filter(filters); }, iter->second.second);
+        for (const auto& filter : filters) {
+            _olap_filters.push_back(filter);
+        }
+    }
+    return Status::OK();
+}
+
 Status NewOlapScanNode::_build_key_ranges_and_filters() {
     if (!_olap_scan_node.__isset.push_down_agg_type_opt ||
         _olap_scan_node.push_down_agg_type_opt == TPushAggOp::NONE) {
@@ -381,6 +519,51 @@ std::string NewOlapScanNode::get_name() {
     return fmt::format("VNewOlapScanNode({0})", _olap_scan_node.table_name);
 }
 
+namespace {
+
+// Collects the slots referred by `expr`, into `size_only_slots` if they are the arguments of the
+// size functions, otherwise into `other_slots`.
+void collect_slots(const VExpr* expr, bool size_argument, std::set<SlotId>* size_only_slots,
+                   std::set<SlotId>* other_slots) {
+    if (expr->is_slot_ref()) {
+        auto slot_id = static_cast<const VSlotRef*>(expr)->slot_id();
+        (size_argument ? size_only_slots : other_slots)->insert(slot_id);
+        return;
+    }
+    const auto& function_name = expr->fn().name.function_name;
+    bool is_size = expr->node_type() == TExprNodeType::FUNCTION_CALL &&
+                   expr->get_num_children() == 1 &&
+                   (function_name == "size" || function_name == "array_size" ||
+                    function_name == "cardinality" || function_name == "map_size");
+    for (const auto* child : expr->children()) {
+        collect_slots(child, is_size, size_only_slots, other_slots);
+    }
+}
+
+} // namespace
+
+void NewOlapScanNode::_collect_offsets_only_column_ids() {
+    // without the projections, the slots are the output of the node
+    if (!has_output_row_descriptor()) {
+        return;
+    }
+    std::set<SlotId> size_only_slots;
+    std::set<SlotId> other_slots;
+    for (auto* projection : _projections) {
+        collect_slots(projection->root(), false, &size_only_slots, &other_slots);
+    }
+    if (_vconjunct_ctx_ptr && (*_vconjunct_ctx_ptr)->root()) {
+        collect_slots((*_vconjunct_ctx_ptr)->root(), false, &size_only_slots, &other_slots);
+    }
+    for (const auto* slot : _output_tuple_desc->slots()) {
+        auto type = slot->type().type;
+        if ((type == TYPE_ARRAY || type == TYPE_MAP) && slot->col_unique_id() >= 0 &&
+            size_only_slots.count(slot->id()) > 0 && other_slots.count(slot->id()) == 0) {
+            _offsets_only_column_ids.insert(slot->col_unique_id());
+        }
+    }
+}
+
 Status NewOlapScanNode::_init_scanners(std::list<VScanner*>* scanners) {
     if (_scan_ranges.empty()) {
         _eos = true;
@@ -402,6 +585,9 @@ Status NewOlapScanNode::_init_scanners(std::list<VScanner*>* scanners) {
             _maybe_read_column_ids.emplace(uid);
         }
     }
+    if (config::enable_offsets_only_nested_read) {
+        _collect_offsets_only_column_ids();
+    }
 
     // ranges constructed from scan keys
     RETURN_IF_ERROR(_scan_keys.get_key_range(&_cond_ranges));
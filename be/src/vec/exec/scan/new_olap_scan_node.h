@@ -32,6 +32,7 @@ public:
     friend class NewOlapScanner;
     friend class doris::pipeline::OlapScanOperator;
 
+    Status init(const TPlanNode& tnode, RuntimeState* state) override;
     Status prepare(RuntimeState* state) override;
     Status collect_query_statistics(QueryStatistics* statistics) override;
 
@@ -59,20 +60,33 @@ protected:
 
     Status _init_scanners(std::list<VScanner*>* scanners) override;
 
+    Status _push_down_late_arrival_runtime_filters(const std::vector<VExpr*>& vexprs) override;
+
 private:
     Status _build_key_ranges_and_filters();
+    void _collect_offsets_only_column_ids();
+    void _init_scan_cache_digest(const TPlanNode& tnode, RuntimeState* state);
 
 private:
     TOlapScanNode _olap_scan_node;
     std::vector<std::unique_ptr<TPaloScanRange>> _scan_ranges;
     std::vector<std::unique_ptr<doris::OlapScanRange>> _cond_ranges;
     OlapScanKeys _scan_keys;
+    // Protected by `_rf_locks`, because late arrival runtime filters are appended to it
+    // when the scanners are running.
     std::vector<TCondition> _olap_filters;
     // _compound_filters store conditions in the one compound relationship in conjunct expr tree except leaf node of `and` node,
     // such as: "(a or b) and (c or d)", conditions for a,b,c,d will be stored
     std::vector<TCondition> _compound_filters;
     // If column id in this set, indicate that we need to read data after index filtering
     std::set<int32_t> _maybe_read_column_ids;
+    // The array and map columns whose sizes are the only use of the projections and the
+    // conjuncts, of which only the offsets are read.
+    std::set<int32_t> _offsets_only_column_ids;
+    // The digest of everything but the tablets which decides the output of the scanners, empty
+    // if their output is neither cached nor shared, see ScanCache and SharedTabletScan.
+    std::string _scan_cache_digest;
+    bool _use_scan_cache = false;
 
 private:
     std::unique_ptr<RuntimeProfile> _segment_profile;
@@ -80,6 +94,10 @@ private:
     RuntimeProfile::Counter* _num_disks_accessed_counter = nullptr;
 
     RuntimeProfile::Counter* _tablet_counter = nullptr;
+    RuntimeProfile::Counter* _scan_cache_hit_counter = nullptr;
+    RuntimeProfile::Counter* _scan_cache_insert_counter = nullptr;
+    RuntimeProfile::Counter* _shared_scan_follower_counter = nullptr;
+    RuntimeProfile::Counter* _shared_scan_rows_counter = nullptr;
     RuntimeProfile::Counter* _rows_pushed_cond_filtered_counter = nullptr;
     RuntimeProfile::Counter* _reader_init_timer = nullptr;
     RuntimeProfile::Counter* _scanner_init_timer = nullptr;
@@ -95,6 +113,7 @@ private:
     RuntimeProfile::Counter* _rows_short_circuit_cond_filtered_counter = nullptr;
     RuntimeProfile::Counter* _rows_vec_cond_input_counter = nullptr;
     RuntimeProfile::Counter* _rows_short_circuit_cond_input_counter = nullptr;
+    RuntimeProfile::Counter* _predicate_reorder_counter = nullptr;
     RuntimeProfile::Counter* _vec_cond_timer = nullptr;
     RuntimeProfile::Counter* _short_cond_timer = nullptr;
     RuntimeProfile::Counter* _expr_filter_timer = nullptr;
@@ -131,6 +150,14 @@ private:
     // page read from cache
     // used by segment v2
     RuntimeProfile::Counter* _cached_pages_num_counter = nullptr;
+    RuntimeProfile::Counter* _compressed_cached_pages_num_counter = nullptr;
+    RuntimeProfile::Counter* _mapped_pages_num_counter = nullptr;
+    // data pages of remote segments found prefetched or not when they are read
+    RuntimeProfile::Counter* _remote_page_prefetch_hit_counter = nullptr;
+    RuntimeProfile::Counter* _remote_page_prefetch_miss_counter = nullptr;
+    // reads loading the data pages of several columns, and the pages loaded by them
+    RuntimeProfile::Counter* _merged_page_read_counter = nullptr;
+    RuntimeProfile::Counter* _merged_pages_num_counter = nullptr;
 
     // row count filtered by bitmap inverted index
     RuntimeProfile::Counter* _bitmap_index_filter_counter = nullptr;
@@ -154,6 +181,7 @@ private:
 
     // number of segment filtered by column stat when creating seg iterator
     RuntimeProfile::Counter* _filtered_segment_counter = nullptr;
+    RuntimeProfile::Counter* _pruned_delete_condition_counter = nullptr;
     // total number of segment related to this scan node
     RuntimeProfile::Counter* _total_segment_counter = nullptr;
 
@@ -17,6 +17,10 @@
 
 #include "vec/exec/scan/new_olap_scanner.h"
 
+#include <limits>
+#include <sstream>
+
+#include "common/config.h"
 #include "olap/storage_engine.h"
 #include "vec/exec/scan/new_olap_scan_node.h"
 #include "vec/olap/block_reader.h"
@@ -143,13 +147,17 @@ Status NewOlapScanner::init() {
                 }
             }
 
-            // Initialize tablet_reader_params
+            // Initialize tablet_reader_params. The pushed down filters of the scan node may be
+            // appended by late arrival runtime filters concurrently.
+            std::unique_lock rf_lock(parent->_rf_locks);
             RETURN_IF_ERROR(_init_tablet_reader_params(_key_ranges, parent->_olap_filters,
                                                        parent->_filter_predicates,
                                                        parent->_push_down_functions));
         }
     }
 
+    _init_scan_cache();
+
     // add read columns in profile
     if (_state->enable_profile()) {
         _profile->add_info_string("ReadColumns",
@@ -161,7 +169,14 @@ Status NewOlapScanner::init() {
 
 Status NewOlapScanner::open(RuntimeState* state) {
     RETURN_IF_ERROR(VScanner::open(state));
+    // a follower of a shared scan reads the tablet after the leader
+    if (_scan_cache_handle.valid() || _shared_scan_follower != nullptr) {
+        return Status::OK();
+    }
+    return _init_tablet_reader();
+}
 
+Status NewOlapScanner::_init_tablet_reader() {
     auto res = _tablet_reader->init(_tablet_reader_params);
     if (!res.ok()) {
         std::stringstream ss;
@@ -228,6 +243,8 @@ Status NewOlapScanner::_init_tablet_reader_params(
                     : _common_vexpr_ctxs_pushdown->root();
     _tablet_reader_params.common_vexpr_ctxs_pushdown = _common_vexpr_ctxs_pushdown;
     _tablet_reader_params.output_columns = ((NewOlapScanNode*)_parent)->_maybe_read_column_ids;
+    _tablet_reader_params.offsets_only_columns =
+            ((NewOlapScanNode*)_parent)->_offsets_only_column_ids;
 
     // Condition
     for (auto& filter : filters) {
@@ -339,6 +356,9 @@ Status NewOlapScanner::_init_tablet_reader_params(
 
     if (!config::disable_storage_page_cache) {
         _tablet_reader_params.use_page_cache = true;
+        // a load reads its source once, don't let it evict the pages of queries
+        _tablet_reader_params.fill_page_cache = _state->query_type() != TQueryType::LOAD ||
+                                                config::enable_page_cache_fill_for_load;
     }
 
     if (_tablet->enable_unique_key_merge_on_write() && !_state->skip_delete_bitmap()) {
@@ -415,6 +435,18 @@ doris::TabletStorageType NewOlapScanner::get_storage_type() {
 }
 
 Status NewOlapScanner::_get_block_impl(RuntimeState* state, Block* block, bool* eof) {
+    if (_scan_cache_handle.valid()) {
+        return _get_block_from_scan_cache(block, eof);
+    }
+    if (_shared_scan_follower != nullptr) {
+        return _get_block_from_shared_scan(block, eof);
+    }
+    if (_shared_rows_end == std::numeric_limits<int64_t>::max() &&
+        _tablet_rows_read >= _shared_rows_begin) {
+        // the rest is taken from the leader
+        *eof = true;
+        return Status::OK();
+    }
     // Read one block from block reader
     // ATTN: Here we need to let the _get_block_impl method guarantee the semantics of the interface,
     // that is, eof can be set to true only when the returned block is empty.
@@ -426,9 +458,140 @@ Status NewOlapScanner::_get_block_impl(RuntimeState* state, Block* block, bool*
         *eof = false;
     }
     _update_realtime_counters();
+    _skip_rows_from_shared_scan(block);
+    if (_scan_cache_value != nullptr) {
+        _append_to_scan_cache(*block, *eof);
+    }
+    if (_shared_scan != nullptr) {
+        if (block->rows() > 0) {
+            _shared_scan->publish(*block);
+        }
+        if (*eof) {
+            _shared_scan->finish(true);
+            _shared_scan.reset();
+        }
+    }
     return Status::OK();
 }
 
+void NewOlapScanner::_init_scan_cache() {
+    auto parent = static_cast<NewOlapScanNode*>(_parent);
+    // the scanners of the segments of a tablet are not cached, since the splits change with
+    // the number of the tablets
+    if (parent->_scan_cache_digest.empty() ||
+        !_tablet_reader_params.rs_readers_segment_offsets.empty()) {
+        return;
+    }
+    std::stringstream key_ranges;
+    for (const auto* key_range : _key_ranges) {
+        key_ranges << (key_range->begin_include ? "[" : "(") << key_range->begin_scan_range
+                   << ";" << key_range->end_scan_range << (key_range->end_include ? "]" : ")");
+    }
+    _scan_cache_key = {parent->_scan_cache_digest, _tablet->tablet_id(), _version,
+                       key_ranges.str()};
+    if (parent->_use_scan_cache) {
+        if (ScanCache::instance()->lookup(_scan_cache_key, &_scan_cache_handle)) {
+            COUNTER_UPDATE(parent->_scan_cache_hit_counter, 1);
+            // the rowsets are not read
+            _tablet_reader_params.rs_readers.clear();
+            return;
+        }
+        _scan_cache_value = std::make_unique<ScanCache::CacheValue>();
+    }
+    if (_state->enable_cross_query_shared_scan()) {
+        _init_shared_scan();
+    }
+}
+
+void NewOlapScanner::_init_shared_scan() {
+    bool leader = false;
+    _shared_scan = SharedTabletScans::instance()->lead_or_follow(_scan_cache_key.encode(), &leader);
+    if (leader) {
+        return;
+    }
+    _shared_scan_follower = _shared_scan->attach();
+    if (_shared_scan_follower == nullptr) {
+        // the leader just finished
+        _shared_scan.reset();
+        return;
+    }
+    COUNTER_UPDATE(static_cast<NewOlapScanNode*>(_parent)->_shared_scan_follower_counter, 1);
+    // the order of the blocks is not the one of the tablet
+    _scan_cache_value.reset();
+}
+
+Status NewOlapScanner::_get_block_from_shared_scan(Block* block, bool* eof) {
+    auto follower = _shared_scan_follower;
+    std::shared_ptr<const Block> shared_block;
+    *eof = false;
+    if (_shared_scan->next(follower.get(), config::shared_scan_max_wait_ms, &shared_block)) {
+        if (shared_block == nullptr) {
+            // the leader is slower than this one, which reads by itself rather than holding the
+            // scan thread
+            _shared_scan->detach(follower.get());
+            return Status::OK();
+        }
+        Block shared_copy = ScanCache::copy_block(*shared_block);
+        block->swap(shared_copy);
+        COUNTER_UPDATE(static_cast<NewOlapScanNode*>(_parent)->_shared_scan_rows_counter,
+                       block->rows());
+        return Status::OK();
+    }
+    _shared_scan_follower.reset();
+    _shared_scan.reset();
+    _shared_rows_begin = follower->start_row;
+    _shared_rows_end = follower->finished ? std::numeric_limits<int64_t>::max()
+                                          : follower->start_row + follower->received_rows;
+    if (follower->finished && follower->start_row == 0) {
+        *eof = true;
+        return Status::OK();
+    }
+    return _init_tablet_reader();
+}
+
+void NewOlapScanner::_skip_rows_from_shared_scan(Block* block) {
+    int64_t first_row = _tablet_rows_read;
+    int64_t rows = block->rows();
+    _tablet_rows_read += rows;
+    int64_t skip_begin = std::max(_shared_rows_begin, first_row);
+    int64_t skip_end = std::min(_shared_rows_end, first_row + rows);
+    if (skip_begin >= skip_end) {
+        return;
+    }
+    IColumn::Filter filter(rows, 1);
+    std::fill(filter.begin() + (skip_begin - first_row), filter.begin() + (skip_end - first_row),
+              0);
+    Block::filter_block_internal(block, filter, block->columns());
+}
+
+Status NewOlapScanner::_get_block_from_scan_cache(Block* block, bool* eof) {
+    const auto& blocks = _scan_cache_handle.value()->blocks;
+    if (_scan_cache_block_idx == blocks.size()) {
+        *eof = true;
+        return Status::OK();
+    }
+    Block cached_block = ScanCache::copy_block(blocks[_scan_cache_block_idx++]);
+    block->swap(cached_block);
+    *eof = false;
+    return Status::OK();
+}
+
+void NewOlapScanner::_append_to_scan_cache(const Block& block, bool eof) {
+    if (block.rows() > 0) {
+        _scan_cache_bytes += block.allocated_bytes();
+        if (_scan_cache_bytes > config::scan_cache_max_bytes_per_scanner) {
+            _scan_cache_value.reset();
+            return;
+        }
+        _scan_cache_value->blocks.push_back(ScanCache::copy_block(block));
+    }
+    if (eof) {
+        ScanCache::instance()->insert(_scan_cache_key, _scan_cache_value.release(),
+                                      _scan_cache_bytes);
+        COUNTER_UPDATE(static_cast<NewOlapScanNode*>(_parent)->_scan_cache_insert_counter, 1);
+    }
+}
+
 Status NewOlapScanner::close(RuntimeState* state) {
     if (_is_closed) {
         return Status::OK();
@@ -440,6 +603,14 @@ Status NewOlapScanner::close(RuntimeState* state) {
     // readers will be release when runtime state deconstructed but
     // deconstructor in reader references runtime state
     // so that it will core
+    if (_shared_scan_follower != nullptr) {
+        _shared_scan->detach(_shared_scan_follower.get());
+    } else if (_shared_scan != nullptr) {
+        _shared_scan->finish(false);
+    }
+    _shared_scan_follower.reset();
+    _shared_scan.reset();
+
     _tablet_reader_params.rs_readers.clear();
     _tablet_reader.reset();
 
@@ -471,6 +642,11 @@ void NewOlapScanner::_update_counters_before_close() {
     // Update counters for NewOlapScanner
     NewOlapScanNode* olap_parent = (NewOlapScanNode*)_parent;
 
+    // Update the predicates info with the final order and statistics
+    if (_profile_updated) {
+        _tablet_reader->update_profile(_profile);
+    }
+
     // Update counters from tablet reader's stats
     auto& stats = _tablet_reader->stats();
     COUNTER_UPDATE(olap_parent->_io_timer, stats.io_ns);
@@ -509,6 +685,7 @@ void NewOlapScanner::_update_counters_before_close() {
     COUNTER_UPDATE(olap_parent->_rows_vec_cond_input_counter, stats.vec_cond_input_rows);
     COUNTER_UPDATE(olap_parent->_rows_short_circuit_cond_input_counter,
                    stats.short_circuit_cond_input_rows);
+    COUNTER_UPDATE(olap_parent->_predicate_reorder_counter, stats.predicate_reorder_num);
 
     COUNTER_UPDATE(olap_parent->_stats_filtered_counter, stats.rows_stats_filtered);
     COUNTER_UPDATE(olap_parent->_bf_filtered_counter, stats.rows_bf_filtered);
@@ -521,6 +698,15 @@ void NewOlapScanner::_update_counters_before_close() {
 
     COUNTER_UPDATE(olap_parent->_total_pages_num_counter, stats.total_pages_num);
     COUNTER_UPDATE(olap_parent->_cached_pages_num_counter, stats.cached_pages_num);
+    COUNTER_UPDATE(olap_parent->_compressed_cached_pages_num_counter,
+                   stats.compressed_cached_pages_num);
+    COUNTER_UPDATE(olap_parent->_mapped_pages_num_counter, stats.mapped_pages_num);
+    COUNTER_UPDATE(olap_parent->_remote_page_prefetch_hit_counter,
+                   stats.remote_page_prefetch_hit_num);
+    COUNTER_UPDATE(olap_parent->_remote_page_prefetch_miss_counter,
+                   stats.remote_page_prefetch_miss_num);
+    COUNTER_UPDATE(olap_parent->_merged_page_read_counter, stats.merged_page_read_num);
+    COUNTER_UPDATE(olap_parent->_merged_pages_num_counter, stats.merged_pages_num);
 
     COUNTER_UPDATE(olap_parent->_bitmap_index_filter_counter, stats.rows_bitmap_index_filtered);
     COUNTER_UPDATE(olap_parent->_bitmap_index_filter_timer, stats.bitmap_index_filter_timer);
@@ -545,6 +731,8 @@ void NewOlapScanner::_update_counters_before_close() {
                    stats.output_index_result_column_timer);
 
     COUNTER_UPDATE(olap_parent->_filtered_segment_counter, stats.filtered_segment_number);
+    COUNTER_UPDATE(olap_parent->_pruned_delete_condition_counter,
+                   stats.pruned_delete_condition_number);
     COUNTER_UPDATE(olap_parent->_total_segment_counter, stats.total_segment_number);
 
     // Update metrics
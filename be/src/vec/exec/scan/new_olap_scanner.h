@@ -21,6 +21,8 @@
 #include "exprs/function_filter.h"
 #include "olap/reader.h"
 #include "util/runtime_profile.h"
+#include "vec/exec/scan/scan_cache.h"
+#include "vec/exec/scan/shared_tablet_scan.h"
 #include "vec/exec/scan/vscanner.h"
 
 namespace doris {
@@ -65,6 +67,13 @@ private:
                                       const std::vector<FunctionFilter>& function_filters);
 
     Status _init_return_columns();
+    Status _init_tablet_reader();
+    void _init_scan_cache();
+    void _init_shared_scan();
+    Status _get_block_from_shared_scan(Block* block, bool* eof);
+    void _skip_rows_from_shared_scan(Block* block);
+    Status _get_block_from_scan_cache(Block* block, bool* eof);
+    void _append_to_scan_cache(const Block& block, bool eof);
 
     bool _aggregation;
     bool _need_agg_finalize;
@@ -82,6 +91,23 @@ private:
     std::unordered_set<uint32_t> _tablet_columns_convert_to_null_set;
     std::vector<TCondition> _compound_filters;
 
+    // The output of the tablet is read from the cache if `_scan_cache_handle` is valid, otherwise
+    // it is cached at eof if `_scan_cache_value` is not null.
+    ScanCache::CacheKey _scan_cache_key;
+    ScanCacheHandle _scan_cache_handle;
+    size_t _scan_cache_block_idx = 0;
+    std::unique_ptr<ScanCache::CacheValue> _scan_cache_value;
+    size_t _scan_cache_bytes = 0;
+
+    // This scanner leads `_shared_scan` if `_shared_scan_follower` is null, otherwise it takes the
+    // blocks of the leader. Then the rows in [_shared_rows_begin, _shared_rows_end) of the tablet
+    // are the ones taken, which are skipped when read.
+    std::shared_ptr<SharedTabletScan> _shared_scan;
+    std::shared_ptr<SharedTabletScan::Follower> _shared_scan_follower;
+    int64_t _shared_rows_begin = 0;
+    int64_t _shared_rows_end = 0;
+    int64_t _tablet_rows_read = 0;
+
     // ========= profiles ==========
     int64_t _compressed_bytes_read = 0;
     int64_t _raw_rows_read = 0;
@@ -31,7 +31,9 @@ public:
                       const std::list<vectorized::VScanner*>& scanners, int64_t limit,
                       int64_t max_bytes_in_blocks_queue)
             : vectorized::ScannerContext(state, parent, input_tuple_desc, output_tuple_desc,
-                                         scanners, limit, max_bytes_in_blocks_queue) {}
+                                         scanners, limit, max_bytes_in_blocks_queue) {
+        _read_dependency = std::make_unique<Dependency>();
+    }
 
     Status get_block_from_queue(RuntimeState* state, vectorized::BlockUPtr* block, bool* eos,
                                 int id, bool wait = false) override {
@@ -52,6 +54,7 @@ public:
                 *block = std::move(_blocks_queues[id].front());
                 _blocks_queues[id].pop_front();
             } else {
+                _consumer_starved = true;
                 *eos = _is_finished || _should_stop;
                 return Status::OK();
             }
@@ -82,6 +85,7 @@ public:
             _next_queue_to_feed = queue + 1 < queue_size ? queue + 1 : 0;
         }
         _current_used_bytes += local_bytes;
+        _notify_read_dependency();
     }
 
     bool empty_in_queue(int id) override {
@@ -0,0 +1,76 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/scan/scan_cache.h"
+
+#include "common/config.h"
+
+namespace doris::vectorized {
+
+ScanCache* ScanCache::_s_instance = nullptr;
+
+std::string ScanCache::CacheKey::encode() const {
+    std::string key_buf(plan_digest);
+    key_buf.append("/");
+    key_buf.append(std::to_string(tablet_id));
+    key_buf.append("/");
+    key_buf.append(std::to_string(version));
+    key_buf.append("/");
+    key_buf.append(key_ranges);
+    return key_buf;
+}
+
+void ScanCache::create_global_cache(size_t capacity, uint32_t num_shards) {
+    DCHECK(_s_instance == nullptr);
+    static ScanCache instance(capacity, num_shards);
+    _s_instance = &instance;
+}
+
+ScanCache::ScanCache(size_t capacity, uint32_t num_shards) {
+    if (capacity > 0) {
+        _cache = std::unique_ptr<Cache>(new_lru_cache("ScanCache", capacity, LRUCacheType::SIZE,
+                                                      num_shards, 0,
+                                                      config::enable_cache_clock_eviction));
+    }
+}
+
+bool ScanCache::lookup(const CacheKey& key, ScanCacheHandle* handle) {
+    auto lru_handle = _cache->lookup(key.encode());
+    if (lru_handle == nullptr) {
+        return false;
+    }
+    *handle = ScanCacheHandle(_cache.get(), lru_handle);
+    return true;
+}
+
+void ScanCache::insert(const CacheKey& key, CacheValue* value, size_t bytes) {
+    auto deleter = [](const doris::CacheKey& key, void* value) { delete (CacheValue*)value; };
+    auto lru_handle = _cache->insert(key.encode(), value, bytes, deleter, CachePriority::NORMAL);
+    _cache->release(lru_handle);
+}
+
+Block ScanCache::copy_block(const Block& block) {
+    MutableColumns columns;
+    columns.reserve(block.columns());
+    for (size_t i = 0; i < block.columns(); ++i) {
+        const auto& column = block.get_by_position(i).column;
+        columns.push_back(column->clone_resized(column->size()));
+    }
+    return block.clone_with_columns(std::move(columns));
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,118 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gutil/macros.h"
+#include "olap/lru_cache.h"
+#include "vec/core/block.h"
+
+namespace doris::vectorized {
+
+class ScanCacheHandle;
+
+// Caches the output blocks of the olap scanners, i.e. the rows of a tablet read by a scan with
+// its pushed down predicates and aggregated by the storage for the aggregate keys, so that the
+// repeated queries only read the tablets changed since, e.g. the dashboards on the rollups of
+// an append-only table.
+//
+// An entry is keyed by the digest of the scan node, see NewOlapScanNode::_init_scan_cache_digest,
+// and the tablet, the version and the key ranges of the scanner. A new version gets a new key,
+// and the old entries are evicted by LRU.
+class ScanCache {
+public:
+    struct CacheKey {
+        std::string plan_digest;
+        int64_t tablet_id;
+        int64_t version;
+        std::string key_ranges;
+
+        // Encode to a flat binary which can be used as LRUCache's key
+        std::string encode() const;
+    };
+
+    struct CacheValue {
+        std::vector<Block> blocks;
+    };
+
+    // Create global instance of this class, "capacity" is the bytes of the cached blocks and 0
+    // disables it.
+    static void create_global_cache(size_t capacity, uint32_t num_shards = 16);
+
+    // Return global instance.
+    // Client should call create_global_cache before.
+    static ScanCache* instance() { return _s_instance; }
+
+    ScanCache(size_t capacity, uint32_t num_shards);
+
+    bool enabled() const { return _cache != nullptr; }
+
+    bool lookup(const CacheKey& key, ScanCacheHandle* handle);
+
+    // The cache takes the ownership of value.
+    void insert(const CacheKey& key, CacheValue* value, size_t bytes);
+
+    // A deep copy of the block, the cached blocks are shared by the scanners and never mutated.
+    static Block copy_block(const Block& block);
+
+private:
+    static ScanCache* _s_instance;
+    std::unique_ptr<Cache> _cache;
+};
+
+class ScanCacheHandle {
+public:
+    ScanCacheHandle() = default;
+
+    ScanCacheHandle(Cache* cache, Cache::Handle* handle) : _cache(cache), _handle(handle) {}
+
+    ~ScanCacheHandle() {
+        if (_handle != nullptr) {
+            _cache->release(_handle);
+        }
+    }
+
+    ScanCacheHandle(ScanCacheHandle&& other) noexcept {
+        std::swap(_cache, other._cache);
+        std::swap(_handle, other._handle);
+    }
+
+    ScanCacheHandle& operator=(ScanCacheHandle&& other) noexcept {
+        std::swap(_cache, other._cache);
+        std::swap(_handle, other._handle);
+        return *this;
+    }
+
+    bool valid() const { return _handle != nullptr; }
+
+    const ScanCache::CacheValue* value() const {
+        return (const ScanCache::CacheValue*)_cache->value(_handle);
+    }
+
+private:
+    Cache* _cache = nullptr;
+    Cache::Handle* _handle = nullptr;
+
+    // Don't allow copy and assign
+    DISALLOW_COPY_AND_ASSIGN(ScanCacheHandle);
+};
+
+} // namespace doris::vectorized
@@ -20,6 +20,7 @@
 #include <mutex>
 
 #include "common/config.h"
+#include "runtime/memory/mem_tracker_limiter.h"
 #include "runtime/runtime_state.h"
 #include "util/threadpool.h"
 #include "vec/core/block.h"
@@ -40,6 +41,7 @@ ScannerContext::ScannerContext(doris::RuntimeState* state_, doris::vectorized::V
           _process_status(Status::OK()),
           _batch_size(state_->batch_size()),
           limit(limit_),
+          _adaptive_concurrency(config::enable_adaptive_scanner_concurrency),
           _max_bytes_in_queue(max_bytes_in_blocks_queue_),
           _scanner_scheduler(state_->exec_env()->scanner_scheduler()),
           _scanners(scanners_) {
@@ -53,15 +55,25 @@ ScannerContext::ScannerContext(doris::RuntimeState* state_, doris::vectorized::V
 Status ScannerContext::init() {
     _real_tuple_desc = _input_tuple_desc != nullptr ? _input_tuple_desc : _output_tuple_desc;
     // 1. Calculate max concurrency
-    // TODO: now the max thread num <= config::doris_scanner_thread_pool_thread_num / 4
+    // TODO: now the default thread num <= config::doris_scanner_thread_pool_thread_num / 4
     // should find a more reasonable value.
-    _max_thread_num = _state->shared_scan_opt() ? config::doris_scanner_thread_pool_thread_num
-                                                : config::doris_scanner_thread_pool_thread_num / 4;
+    int32_t default_thread_num = _state->shared_scan_opt()
+                                         ? config::doris_scanner_thread_pool_thread_num
+                                         : config::doris_scanner_thread_pool_thread_num / 4;
+    // With adaptive concurrency, start from the default thread num, and grow up to
+    // the whole scanner thread pool if the consumer is waiting for blocks.
+    _max_thread_num = _adaptive_concurrency ? config::doris_scanner_thread_pool_thread_num
+                                            : default_thread_num;
     _max_thread_num = std::min(_max_thread_num, (int32_t)_scanners.size());
     // For select * from table limit 10; should just use one thread.
     if (_parent->should_run_serial()) {
         _max_thread_num = 1;
     }
+    _current_thread_num = std::max(1, std::min(default_thread_num, _max_thread_num));
+    // A limit query usually does not need many scanners, start from one scanner.
+    if (_adaptive_concurrency && limit != -1) {
+        _current_thread_num = 1;
+    }
 
     _scanner_profile = _parent->_scanner_profile;
     _scanner_sched_counter = _parent->_scanner_sched_counter;
@@ -70,19 +82,23 @@ Status ScannerContext::init() {
     _newly_create_free_blocks_num = _parent->_newly_create_free_blocks_num;
     _queued_blocks_memory_usage = _parent->_queued_blocks_memory_usage;
     _scanner_wait_batch_timer = _parent->_scanner_wait_batch_timer;
+    _scanner_concurrency_up_counter = _parent->_scanner_concurrency_up_counter;
+    _scanner_concurrency_down_counter = _parent->_scanner_concurrency_down_counter;
+    _peak_scanner_concurrency = _parent->_peak_scanner_concurrency;
     // 2. Calculate how many blocks need to be preallocated.
     // The calculation logic is as follows:
     //  1. Assuming that at most M rows can be scanned in one scan(config::doris_scanner_row_num),
     //     then figure out how many blocks are required for one scan(_block_per_scanner).
-    //  2. The maximum number of concurrency * the blocks required for one scan,
-    //     that is, the number of blocks that need to be pre-allocated
+    //  2. The initial number of concurrency * the blocks required for one scan,
+    //     that is, the number of blocks that need to be pre-allocated.
+    //     More blocks are created on demand if the concurrency grows.
     auto doris_scanner_row_num =
             limit == -1 ? config::doris_scanner_row_num
                         : std::min(static_cast<int64_t>(config::doris_scanner_row_num), limit);
     int real_block_size =
             limit == -1 ? _batch_size : std::min(static_cast<int64_t>(_batch_size), limit);
     _block_per_scanner = (doris_scanner_row_num + (real_block_size - 1)) / real_block_size;
-    auto pre_alloc_block_count = _max_thread_num * _block_per_scanner;
+    auto pre_alloc_block_count = _current_thread_num * _block_per_scanner;
 
     // The free blocks is used for final output block of scanners.
     // So use _output_tuple_desc;
@@ -96,8 +112,9 @@ Status ScannerContext::init() {
     _free_blocks_memory_usage->add(free_blocks_memory_usage);
 
 #ifndef BE_TEST
-    // 3. get thread token
+    // 3. get thread token and task group
     thread_token = _state->get_query_fragments_ctx()->get_token();
+    task_group = _state->get_query_fragments_ctx()->get_task_group();
 #endif
 
     // 4. This ctx will be submitted to the scanner scheduler right after init.
@@ -108,6 +125,7 @@ Status ScannerContext::init() {
 
     COUNTER_SET(_parent->_pre_alloc_free_blocks_num, (int64_t)pre_alloc_block_count);
     COUNTER_SET(_parent->_max_scanner_thread_num, (int64_t)_max_thread_num);
+    _peak_scanner_concurrency->set((int64_t)_current_thread_num);
     _parent->_runtime_profile->add_info_string("UseSpecificThreadToken",
                                                thread_token == nullptr ? "False" : "True");
 
@@ -147,6 +165,7 @@ void ScannerContext::append_blocks_to_queue(std::vector<vectorized::BlockUPtr>&
     }
     blocks.clear();
     _blocks_queue_added_cv.notify_one();
+    _notify_read_dependency();
     _queued_blocks_memory_usage->add(_cur_bytes_in_queue - old_bytes_in_queue);
 }
 
@@ -168,6 +187,9 @@ Status ScannerContext::get_block_from_queue(RuntimeState* state, vectorized::Blo
         _num_scheduling_ctx++;
         _scanner_scheduler->submit(this);
     }
+    if (_blocks_queue.empty()) {
+        _consumer_starved = true;
+    }
     // Wait for block from queue
     if (wait) {
         SCOPED_TIMER(_scanner_wait_batch_timer);
@@ -204,6 +226,7 @@ bool ScannerContext::set_status_on_error(const Status& status) {
         _process_status = status;
         _status_error = true;
         _blocks_queue_added_cv.notify_one();
+        _notify_read_dependency();
         return true;
     }
     return false;
@@ -282,10 +305,12 @@ std::string ScannerContext::debug_string() {
             "id: {}, sacnners: {}, blocks in queue: {},"
             " status: {}, _should_stop: {}, _is_finished: {}, free blocks: {},"
             " limit: {}, _num_running_scanners: {}, _num_scheduling_ctx: {}, _max_thread_num: {},"
-            " _block_per_scanner: {}, _cur_bytes_in_queue: {}, MAX_BYTE_OF_QUEUE: {}",
+            " _current_thread_num: {}, _block_per_scanner: {}, _cur_bytes_in_queue: {},"
+            " MAX_BYTE_OF_QUEUE: {}",
             ctx_id, _scanners.size(), _blocks_queue.size(), _process_status.ok(), _should_stop,
             _is_finished, _free_blocks.size(), limit, _num_running_scanners, _num_scheduling_ctx,
-            _max_thread_num, _block_per_scanner, _cur_bytes_in_queue, _max_bytes_in_queue);
+            _max_thread_num, _current_thread_num, _block_per_scanner, _cur_bytes_in_queue,
+            _max_bytes_in_queue);
 }
 
 void ScannerContext::reschedule_scanner_ctx() {
@@ -321,13 +346,50 @@ void ScannerContext::push_back_scanner_and_reschedule(VScanner* scanner) {
         (--_num_unfinished_scanners) == 0) {
         _is_finished = true;
         _blocks_queue_added_cv.notify_one();
+        _notify_read_dependency();
     }
     // In pipeline engine, doris will close scanners when `no_schedule`.
     _num_running_scanners--;
     _ctx_finish_cv.notify_one();
 }
 
+bool ScannerContext::_has_enough_query_memory() {
+    auto query_mem_tracker = _state->query_mem_tracker();
+    if (query_mem_tracker == nullptr || !query_mem_tracker->has_limit()) {
+        return true;
+    }
+    // keep at least 10% of the query memory limit for the other operators
+    return query_mem_tracker->spare_capacity() >
+           std::max(_max_bytes_in_queue, query_mem_tracker->limit() / 10);
+}
+
+void ScannerContext::_adjust_scanner_concurrency() {
+    bool queue_full = false;
+    {
+        std::lock_guard l(_transfer_lock);
+        queue_full = !has_enough_space_in_blocks_queue();
+    }
+    int32_t current_thread_num = _current_thread_num;
+    if (queue_full || !_has_enough_query_memory()) {
+        // the consumer is slower than the scanners, or the query is short of memory
+        if (current_thread_num > 1) {
+            _current_thread_num = current_thread_num - 1;
+            COUNTER_UPDATE(_scanner_concurrency_down_counter, 1);
+        }
+        _consumer_starved = false;
+    } else if (_consumer_starved.exchange(false) && current_thread_num < _max_thread_num) {
+        // the consumer is waiting for blocks
+        _current_thread_num = current_thread_num + 1;
+        COUNTER_UPDATE(_scanner_concurrency_up_counter, 1);
+        _peak_scanner_concurrency->set((int64_t)current_thread_num + 1);
+    }
+}
+
 void ScannerContext::get_next_batch_of_scanners(std::list<VScanner*>* current_run) {
+    if (_adaptive_concurrency) {
+        _adjust_scanner_concurrency();
+    }
+
     // 1. Calculate how many scanners should be scheduled at this run.
     int thread_slot_num = 0;
     {
@@ -336,9 +398,12 @@ void ScannerContext::get_next_batch_of_scanners(std::list<VScanner*>* current_ru
         std::lock_guard f(_free_blocks_lock);
         thread_slot_num = _free_blocks.size() / _block_per_scanner;
         thread_slot_num += (_free_blocks.size() % _block_per_scanner != 0);
-        thread_slot_num = std::min(thread_slot_num, _max_thread_num - _num_running_scanners);
+        thread_slot_num = std::min(thread_slot_num, _current_thread_num - _num_running_scanners);
+        // The scanner which reschedules this ctx is still counted in _num_running_scanners.
+        // Only if the other running scanners exceed the concurrency, schedule nothing and
+        // let them reschedule this ctx later. Otherwise schedule at least one scanner.
         if (thread_slot_num <= 0) {
-            thread_slot_num = 1;
+            thread_slot_num = _num_running_scanners > _current_thread_num ? 0 : 1;
         }
     }
 
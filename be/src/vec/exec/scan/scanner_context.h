@@ -22,6 +22,7 @@
 #include <mutex>
 
 #include "common/status.h"
+#include "pipeline/dependency.h"
 #include "runtime/descriptors.h"
 #include "util/lock.h"
 #include "util/uid_util.h"
@@ -29,6 +30,10 @@
 
 namespace doris {
 
+namespace taskgroup {
+class TaskGroup;
+}
+
 class PriorityThreadPool;
 class ThreadPool;
 class ThreadPoolToken;
@@ -83,6 +88,7 @@ public:
         std::lock_guard l(_transfer_lock);
         _should_stop = true;
         _blocks_queue_added_cv.notify_one();
+        _notify_read_dependency();
     }
 
     // Return true if this ScannerContext need no more process
@@ -97,6 +103,7 @@ public:
         _num_running_scanners += scanner_inc;
         _num_scheduling_ctx += sched_inc;
         _blocks_queue_added_cv.notify_one();
+        _notify_read_dependency();
         _ctx_finish_cv.notify_one();
     }
 
@@ -130,14 +137,22 @@ public:
 
     void reschedule_scanner_ctx();
 
+    // notified when there are new blocks or the context is done, only for pipeline
+    pipeline::Dependency* read_dependency() { return _read_dependency.get(); }
+
     // the unique id of this context
     std::string ctx_id;
     int32_t queue_idx = -1;
     ThreadPoolToken* thread_token;
+    // the task group of the query, only set for pipeline queries
+    taskgroup::TaskGroup* task_group = nullptr;
     std::vector<bthread_t> _btids;
 
 private:
     Status _close_and_clear_scanners(VScanNode* node, RuntimeState* state);
+    // Grow or shrink _current_thread_num by one, called before each scheduling.
+    void _adjust_scanner_concurrency();
+    bool _has_enough_query_memory();
 
 protected:
     RuntimeState* _state;
@@ -162,6 +177,14 @@ protected:
     doris::ConditionVariable _blocks_queue_added_cv;
     // Wait in clear_and_join(), by ScanNode.
     doris::ConditionVariable _ctx_finish_cv;
+    // Wakes up the pipeline tasks waiting for blocks, same as `_blocks_queue_added_cv`.
+    std::unique_ptr<pipeline::Dependency> _read_dependency;
+
+    void _notify_read_dependency() {
+        if (_read_dependency) {
+            _read_dependency->notify();
+        }
+    }
 
     // The following 3 variables control the process of the scanner scheduling.
     // Use _transfer_lock to protect them.
@@ -201,6 +224,13 @@ protected:
     int32_t _num_unfinished_scanners = 0;
     // Max number of scan thread for this scanner context.
     int32_t _max_thread_num = 0;
+    // If true, _current_thread_num is adjusted between 1 and _max_thread_num at runtime.
+    // Otherwise it is always _max_thread_num.
+    const bool _adaptive_concurrency;
+    // Number of scanners allowed to run concurrently now, only changed by the scheduler
+    std::atomic_int32_t _current_thread_num = 0;
+    // Set by the consumer if it finds the blocks queue empty
+    std::atomic_bool _consumer_starved = false;
     // How many blocks a scanner can use in one task.
     int32_t _block_per_scanner = 0;
 
@@ -226,6 +256,9 @@ protected:
     RuntimeProfile::HighWaterMarkCounter* _queued_blocks_memory_usage = nullptr;
     RuntimeProfile::Counter* _newly_create_free_blocks_num = nullptr;
     RuntimeProfile::Counter* _scanner_wait_batch_timer = nullptr;
+    RuntimeProfile::Counter* _scanner_concurrency_up_counter = nullptr;
+    RuntimeProfile::Counter* _scanner_concurrency_down_counter = nullptr;
+    RuntimeProfile::HighWaterMarkCounter* _peak_scanner_concurrency = nullptr;
 };
 } // namespace vectorized
 } // namespace doris
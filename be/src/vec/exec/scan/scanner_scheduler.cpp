@@ -18,6 +18,7 @@
 #include "scanner_scheduler.h"
 
 #include "common/config.h"
+#include "runtime/task_group/task_group_manager.h"
 #include "util/async_io.h"
 #include "util/priority_thread_pool.hpp"
 #include "util/priority_work_stealing_thread_pool.hpp"
@@ -50,8 +51,16 @@ ScannerScheduler::~ScannerScheduler() {
     _remote_scan_thread_pool->shutdown();
     _limited_scan_thread_pool->shutdown();
 
+    for (auto& [id, pools] : _task_group_scan_pools) {
+        pools->local_scan_thread_pool->shutdown();
+        pools->remote_scan_thread_pool->shutdown();
+    }
+
     _scheduler_pool->wait();
     _local_scan_thread_pool->join();
+    for (auto& [id, pools] : _task_group_scan_pools) {
+        pools->local_scan_thread_pool->join();
+    }
 
     for (int i = 0; i < QUEUE_NUM; i++) {
         delete _pending_queues[i];
@@ -73,6 +82,7 @@ Status ScannerScheduler::init(ExecEnv* env) {
     }
 
     // 2. local scan thread pool
+    _num_store_paths = std::max<size_t>(1, env->store_paths().size());
     _local_scan_thread_pool.reset(new PriorityWorkStealingThreadPool(
             config::doris_scanner_thread_pool_thread_num, env->store_paths().size(),
             config::doris_scanner_thread_pool_queue_size, "local_scan"));
@@ -105,6 +115,48 @@ Status ScannerScheduler::submit(ScannerContext* ctx) {
     return Status::OK();
 }
 
+ScannerScheduler::TaskGroupScanPools* ScannerScheduler::_get_task_group_scan_pools(
+        taskgroup::TaskGroup* task_group) {
+    {
+        std::shared_lock<std::shared_mutex> r_lock(_task_group_pools_lock);
+        auto it = _task_group_scan_pools.find(task_group->id());
+        if (it != _task_group_scan_pools.end()) {
+            return it->second.get();
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> w_lock(_task_group_pools_lock);
+    auto it = _task_group_scan_pools.find(task_group->id());
+    if (it != _task_group_scan_pools.end()) {
+        return it->second.get();
+    }
+    auto total_share = std::max<uint64_t>(
+            1, taskgroup::TaskGroupManager::instance()->total_cpu_share());
+    auto share_of = [&](int thread_num) {
+        return std::max<int>(1, (int)(thread_num * task_group->share() / total_share));
+    };
+    auto pools = std::make_unique<TaskGroupScanPools>();
+    auto name = fmt::format("tg_{}", task_group->id());
+    pools->local_scan_thread_pool.reset(new PriorityWorkStealingThreadPool(
+            share_of(config::doris_scanner_thread_pool_thread_num), _num_store_paths,
+            config::doris_scanner_thread_pool_queue_size, "local_scan_" + name));
+    auto st = ThreadPoolBuilder("RemoteScanThreadPool_" + name)
+                      .set_min_threads(share_of(config::doris_scanner_thread_pool_thread_num))
+                      .set_max_threads(
+                              share_of(config::doris_max_remote_scanner_thread_pool_thread_num))
+                      .set_max_queue_size(config::doris_scanner_thread_pool_queue_size)
+                      .build(&pools->remote_scan_thread_pool);
+    if (!st.ok()) {
+        LOG(WARNING) << "failed to create remote scan thread pool of task group "
+                     << task_group->debug_string() << ", error: " << st;
+        return nullptr;
+    }
+    LOG(INFO) << "create scan thread pools for task group " << task_group->debug_string();
+    auto* res = pools.get();
+    _task_group_scan_pools.emplace(task_group->id(), std::move(pools));
+    return res;
+}
+
 std::unique_ptr<ThreadPoolToken> ScannerScheduler::new_limited_scan_pool_token(
         ThreadPool::ExecutionMode mode, int max_concurrency) {
     return _limited_scan_thread_pool->new_token(mode, max_concurrency);
@@ -174,6 +226,14 @@ void ScannerScheduler::_schedule_scanners(ScannerContext* ctx) {
                 }
             }
         } else {
+            PriorityThreadPool* local_scan_thread_pool = _local_scan_thread_pool.get();
+            ThreadPool* remote_scan_thread_pool = _remote_scan_thread_pool.get();
+            if (config::enable_task_group_scan_thread_pool && ctx->task_group != nullptr) {
+                if (auto* pools = _get_task_group_scan_pools(ctx->task_group)) {
+                    local_scan_thread_pool = pools->local_scan_thread_pool.get();
+                    remote_scan_thread_pool = pools->remote_scan_thread_pool.get();
+                }
+            }
             while (iter != this_run.end()) {
                 (*iter)->start_wait_worker_timer();
                 TabletStorageType type = (*iter)->get_storage_type();
@@ -185,9 +245,9 @@ void ScannerScheduler::_schedule_scanners(ScannerContext* ctx) {
                     };
                     task.priority = nice;
                     task.queue_id = (*iter)->queue_id();
-                    ret = _local_scan_thread_pool->offer(task);
+                    ret = local_scan_thread_pool->offer(task);
                 } else {
-                    ret = _remote_scan_thread_pool->submit_func([this, scanner = *iter, ctx] {
+                    ret = remote_scan_thread_pool->submit_func([this, scanner = *iter, ctx] {
                         this->_scanner_scan(this, ctx, scanner);
                     });
                 }
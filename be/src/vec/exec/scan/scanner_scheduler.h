@@ -17,6 +17,9 @@
 
 #pragma once
 
+#include <shared_mutex>
+#include <unordered_map>
+
 #include "common/status.h"
 #include "util/blocking_queue.hpp"
 #include "util/threadpool.h"
@@ -41,6 +44,9 @@ namespace doris::vectorized {
 //     Each Scanner will act as a producer, read a group of blocks and put them into
 //     the corresponding block queue.
 //     The corresponding ScanNode will act as a consumer to consume blocks from the block queue.
+//
+//     If config::enable_task_group_scan_thread_pool is true, each task group has its own
+//     local and remote scan thread pools for pipeline queries, sized by its cpu share.
 class ScannerScheduler {
 public:
     ScannerScheduler();
@@ -54,6 +60,14 @@ public:
                                                                  int max_concurrency);
 
 private:
+    struct TaskGroupScanPools {
+        std::unique_ptr<PriorityThreadPool> local_scan_thread_pool;
+        std::unique_ptr<ThreadPool> remote_scan_thread_pool;
+    };
+
+    // Return the scan thread pools of the task group, create them if not exist.
+    // Return nullptr if failed to create them, then the shared pools should be used.
+    TaskGroupScanPools* _get_task_group_scan_pools(taskgroup::TaskGroup* task_group);
     // scheduling thread function
     void _schedule_thread(int queue_id);
     // schedule scanners in a certain ScannerContext
@@ -83,6 +97,11 @@ private:
     std::unique_ptr<ThreadPool> _remote_scan_thread_pool;
     std::unique_ptr<ThreadPool> _limited_scan_thread_pool;
 
+    // task group id -> the scan thread pools of the task group
+    std::shared_mutex _task_group_pools_lock;
+    std::unordered_map<uint64_t, std::unique_ptr<TaskGroupScanPools>> _task_group_scan_pools;
+    size_t _num_store_paths = 1;
+
     // true is the scheduler is closed.
     std::atomic_bool _is_closed = {false};
     bool _is_init = false;
@@ -0,0 +1,123 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/scan/shared_tablet_scan.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "common/config.h"
+#include "vec/exec/scan/scan_cache.h"
+
+namespace doris::vectorized {
+
+void SharedTabletScan::publish(const Block& block) {
+    {
+        std::lock_guard l(_lock);
+        if (_followers.empty()) {
+            _rows += block.rows();
+            return;
+        }
+    }
+    // the followers attached meanwhile also get the block
+    auto shared_block = std::make_shared<const Block>(ScanCache::copy_block(block));
+    size_t bytes = shared_block->allocated_bytes();
+    std::lock_guard l(_lock);
+    for (auto& follower : _followers) {
+        if (follower->queued_bytes + bytes > config::shared_scan_max_queued_bytes) {
+            follower->detached = true;
+            continue;
+        }
+        follower->blocks.push_back(shared_block);
+        follower->queued_bytes += bytes;
+        follower->received_rows += block.rows();
+    }
+    _followers.erase(std::remove_if(_followers.begin(), _followers.end(),
+                                    [](const auto& follower) { return follower->detached; }),
+                     _followers.end());
+    _rows += block.rows();
+    _cv.notify_all();
+}
+
+void SharedTabletScan::finish(bool eof) {
+    SharedTabletScans::instance()->remove(_key, this);
+    std::lock_guard l(_lock);
+    _finished = true;
+    for (auto& follower : _followers) {
+        follower->detached = true;
+        follower->finished = eof;
+    }
+    _followers.clear();
+    _cv.notify_all();
+}
+
+std::shared_ptr<SharedTabletScan::Follower> SharedTabletScan::attach() {
+    std::lock_guard l(_lock);
+    if (_finished) {
+        return nullptr;
+    }
+    auto follower = std::make_shared<Follower>();
+    follower->start_row = _rows;
+    _followers.push_back(follower);
+    return follower;
+}
+
+void SharedTabletScan::detach(Follower* follower) {
+    std::lock_guard l(_lock);
+    if (follower->detached) {
+        return;
+    }
+    follower->detached = true;
+    _followers.erase(std::find_if(_followers.begin(), _followers.end(),
+                                  [&](const auto& other) { return other.get() == follower; }));
+}
+
+bool SharedTabletScan::next(Follower* follower, int64_t timeout_ms,
+                            std::shared_ptr<const Block>* block) {
+    std::unique_lock l(_lock);
+    _cv.wait_for(l, std::chrono::milliseconds(timeout_ms),
+                 [&] { return !follower->blocks.empty() || follower->detached; });
+    if (follower->blocks.empty()) {
+        block->reset();
+        return !follower->detached;
+    }
+    *block = std::move(follower->blocks.front());
+    follower->blocks.pop_front();
+    follower->queued_bytes -= (*block)->allocated_bytes();
+    return true;
+}
+
+std::shared_ptr<SharedTabletScan> SharedTabletScans::lead_or_follow(const std::string& key,
+                                                                    bool* leader) {
+    std::lock_guard l(_lock);
+    auto& scan = _scans[key];
+    *leader = scan == nullptr;
+    if (*leader) {
+        scan = std::make_shared<SharedTabletScan>(key);
+    }
+    return scan;
+}
+
+void SharedTabletScans::remove(const std::string& key, const SharedTabletScan* scan) {
+    std::lock_guard l(_lock);
+    auto it = _scans.find(key);
+    if (it != _scans.end() && it->second.get() == scan) {
+        _scans.erase(it);
+    }
+}
+
+} // namespace doris::vectorized
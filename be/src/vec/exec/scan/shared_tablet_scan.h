@@ -0,0 +1,104 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "vec/core/block.h"
+
+namespace doris::vectorized {
+
+// A scan of a tablet in progress whose blocks are taken by the scanners of the other queries
+// reading the same rows, i.e. with the same key of ScanCache, e.g. the dashboards refreshed at
+// the same moment.
+//
+// The first scanner is the leader which reads the tablet. A follower attached later takes the
+// blocks of the leader from where it is, and when the leader finishes, reads by itself the rows
+// before that, like a circular scan. The leader never waits for the followers: a follower whose
+// blocks are not taken in time is detached, and then reads by itself all the rows not taken.
+// Since the same rows are read in the same order, a follower knows them by their positions.
+class SharedTabletScan {
+public:
+    struct Follower {
+        // the number of the rows read by the leader when attached
+        int64_t start_row = 0;
+        // the number of the rows given since, including the queued ones
+        int64_t received_rows = 0;
+        std::deque<std::shared_ptr<const Block>> blocks;
+        size_t queued_bytes = 0;
+        // no more blocks are given, and `finished` is true if the leader read all the rows
+        bool detached = false;
+        bool finished = false;
+    };
+
+    explicit SharedTabletScan(std::string key) : _key(std::move(key)) {}
+
+    // Called by the leader for each block read.
+    void publish(const Block& block);
+
+    // Called by the leader when it stops, `eof` is true if it read all the rows.
+    void finish(bool eof);
+
+    // Returns null if the leader finished.
+    std::shared_ptr<Follower> attach();
+
+    // Stops giving blocks to the follower, which may still take the queued ones.
+    void detach(Follower* follower);
+
+    // Waits up to `timeout_ms` for the next block of the follower, `*block` is null if there is
+    // none in time. Returns false if the follower is detached and all its blocks are taken.
+    bool next(Follower* follower, int64_t timeout_ms, std::shared_ptr<const Block>* block);
+
+private:
+    const std::string _key;
+
+    std::mutex _lock;
+    std::condition_variable _cv;
+    int64_t _rows = 0;
+    bool _finished = false;
+    std::vector<std::shared_ptr<Follower>> _followers;
+};
+
+// The shared scans in progress of this backend.
+class SharedTabletScans {
+public:
+    static SharedTabletScans* instance() {
+        static SharedTabletScans scans;
+        return &scans;
+    }
+
+    // Returns the scan in progress of the key with `*leader` false if any, otherwise registers a
+    // new one led by the caller.
+    std::shared_ptr<SharedTabletScan> lead_or_follow(const std::string& key, bool* leader);
+
+    void remove(const std::string& key, const SharedTabletScan* scan);
+
+private:
+    SharedTabletScans() = default;
+
+    std::mutex _lock;
+    std::unordered_map<std::string, std::shared_ptr<SharedTabletScan>> _scans;
+};
+
+} // namespace doris::vectorized
@@ -43,10 +43,12 @@ using namespace ErrorCode;
 
 VFileScanner::VFileScanner(RuntimeState* state, NewFileScanNode* parent, int64_t limit,
                            const TFileScanRange& scan_range, RuntimeProfile* profile,
-                           ShardedKVCache* kv_cache)
+                           ShardedKVCache* kv_cache,
+                           std::shared_ptr<FileRangeSource> range_source)
         : VScanner(state, static_cast<VScanNode*>(parent), limit, profile),
           _params(scan_range.params),
-          _ranges(scan_range.ranges),
+          _range_source(std::move(range_source)),
+          _ranges(_range_source ? _range_source->ranges : scan_range.ranges),
           _next_range(0),
           _cur_reader(nullptr),
           _cur_reader_eof(false),
@@ -523,6 +525,10 @@ Status VFileScanner::_get_next_reader() {
     while (true) {
         _cur_reader.reset(nullptr);
         _src_block_init = false;
+        if (_range_source != nullptr) {
+            int index = _range_source->next();
+            _next_range = index < 0 ? _ranges.size() : index;
+        }
         if (_next_range >= _ranges.size()) {
             _scanner_eof = true;
             return Status::OK();
@@ -569,7 +575,14 @@ Status VFileScanner::_get_next_reader() {
             _cur_reader.reset(new OrcReader(_profile, _params, range, _file_col_names,
                                             _state->query_options().batch_size, _state->timezone(),
                                             _io_ctx.get()));
-            init_status = ((OrcReader*)(_cur_reader.get()))->init_reader(_colname_to_value_range);
+            if (!_is_load && _push_down_expr == nullptr && _vconjunct_ctx != nullptr) {
+                RETURN_IF_ERROR(_vconjunct_ctx->clone(_state, &_push_down_expr));
+                _discard_conjuncts();
+            }
+            init_status = ((OrcReader*)(_cur_reader.get()))
+                                  ->init_reader(_colname_to_value_range, _push_down_expr,
+                                                &_not_single_slot_filter_conjuncts,
+                                                &_slot_id_to_filter_conjuncts);
             break;
         }
         case TFileFormatType::FORMAT_CSV_PLAIN:
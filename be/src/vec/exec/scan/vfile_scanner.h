@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "exec/olap_common.h"
 #include "exec/text_converter.h"
 #include "exprs/function_filter.h"
@@ -30,11 +32,29 @@ namespace doris::vectorized {
 
 class NewFileScanNode;
 
+// The ranges of a file scan range shared by the scanners reading it, each scanner takes the next
+// range when it finishes the last one, so the ones reading smaller ranges take more of them.
+struct FileRangeSource {
+    explicit FileRangeSource(std::vector<TFileRangeDesc> ranges_) : ranges(std::move(ranges_)) {}
+
+    // returns -1 if all the ranges are taken
+    int next() {
+        int index = _next.fetch_add(1);
+        return static_cast<size_t>(index) < ranges.size() ? index : -1;
+    }
+
+    const std::vector<TFileRangeDesc> ranges;
+
+private:
+    std::atomic<int> _next {0};
+};
+
 class VFileScanner : public VScanner {
 public:
     VFileScanner(RuntimeState* state, NewFileScanNode* parent, int64_t limit,
                  const TFileScanRange& scan_range, RuntimeProfile* profile,
-                 ShardedKVCache* kv_cache);
+                 ShardedKVCache* kv_cache,
+                 std::shared_ptr<FileRangeSource> range_source = nullptr);
 
     Status open(RuntimeState* state) override;
 
@@ -56,6 +76,8 @@ protected:
 protected:
     std::unique_ptr<TextConverter> _text_converter;
     const TFileScanRangeParams& _params;
+    // the ranges taken from the source if it's set, otherwise the ranges of the scan range
+    std::shared_ptr<FileRangeSource> _range_source;
     const std::vector<TFileRangeDesc>& _ranges;
     int _next_range;
 
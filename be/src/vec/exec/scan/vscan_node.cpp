@@ -17,6 +17,8 @@
 
 #include "vec/exec/scan/vscan_node.h"
 
+#include <unordered_set>
+
 #include "common/consts.h"
 #include "common/status.h"
 #include "exprs/bloom_filter_func.h"
@@ -63,6 +65,122 @@ static bool ignore_cast(SlotDescriptor* slot, VExpr* expr) {
     return false;
 }
 
+static bool is_monotonic_function(const std::string& fn_name) {
+    static const std::unordered_set<std::string> monotonic_functions = {
+            "date_trunc", "seconds_add", "seconds_sub", "minutes_add", "minutes_sub", "hours_add",
+            "hours_sub",  "days_add",    "days_sub",    "weeks_add",   "weeks_sub"};
+    return monotonic_functions.count(fn_name) > 0;
+}
+
+// Return the slot which the monotonic `expr' is applied on, or nullptr. The integer casts,
+// date_trunc and adding intervals of fixed length are handled.
+static const VSlotRef* monotonic_function_arg(const VExpr* expr) {
+    if (expr->children().empty() ||
+        expr->children()[0]->node_type() != TExprNodeType::SLOT_REF) {
+        return nullptr;
+    }
+    if (expr->node_type() == TExprNodeType::CAST_EXPR ||
+        (expr->node_type() == TExprNodeType::FUNCTION_CALL &&
+         is_monotonic_function(expr->fn().name.function_name))) {
+        return reinterpret_cast<const VSlotRef*>(expr->children()[0]);
+    }
+    return nullptr;
+}
+
+// Return the size of integer type, or 0 if it is not an integer type.
+static size_t integer_size(PrimitiveType type) {
+    switch (type) {
+    case TYPE_TINYINT:
+        return 1;
+    case TYPE_SMALLINT:
+        return 2;
+    case TYPE_INT:
+        return 4;
+    case TYPE_BIGINT:
+        return 8;
+    case TYPE_LARGEINT:
+        return 16;
+    default:
+        return 0;
+    }
+}
+
+static __int128 read_integer(PrimitiveType type, const char* data) {
+    switch (type) {
+    case TYPE_TINYINT:
+        return *reinterpret_cast<const int8_t*>(data);
+    case TYPE_SMALLINT:
+        return *reinterpret_cast<const int16_t*>(data);
+    case TYPE_INT:
+        return *reinterpret_cast<const int32_t*>(data);
+    case TYPE_BIGINT:
+        return *reinterpret_cast<const int64_t*>(data);
+    default: {
+        DCHECK_EQ(type, TYPE_LARGEINT);
+        __int128 value;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+    }
+}
+
+// Set `value' to the start of the `unit' next to it, e.g. 2026-10-02 00:00:00 for day and
+// 2026-10-01 12:00:00.
+template <TimeUnit unit>
+static bool next_time_unit_start(DateV2Value<DateTimeV2ValueType>* value) {
+    if (!value->template datetime_trunc<unit>()) {
+        return false;
+    }
+    if constexpr (unit == QUARTER) {
+        return value->template date_add_interval<MONTH>(TimeInterval(MONTH, 3, false));
+    } else {
+        return value->template date_add_interval<unit>(TimeInterval(unit, 1, false));
+    }
+}
+
+// The units are the same as the function date_trunc.
+static bool next_time_unit_start(const StringRef& unit, DateV2Value<DateTimeV2ValueType>* value) {
+    if (unit.size >= 4 && std::strncmp("year", unit.data, 4) == 0) {
+        return next_time_unit_start<YEAR>(value);
+    } else if (unit.size >= 7 && std::strncmp("quarter", unit.data, 7) == 0) {
+        return next_time_unit_start<QUARTER>(value);
+    } else if (unit.size >= 5 && std::strncmp("month", unit.data, 5) == 0) {
+        return next_time_unit_start<MONTH>(value);
+    } else if (unit.size >= 3 && std::strncmp("day", unit.data, 3) == 0) {
+        return next_time_unit_start<DAY>(value);
+    } else if (unit.size >= 4 && std::strncmp("hour", unit.data, 4) == 0) {
+        return next_time_unit_start<HOUR>(value);
+    } else if (unit.size >= 6 && std::strncmp("minute", unit.data, 6) == 0) {
+        return next_time_unit_start<MINUTE>(value);
+    } else if (unit.size >= 6 && std::strncmp("second", unit.data, 6) == 0) {
+        return next_time_unit_start<SECOND>(value);
+    }
+    return false;
+}
+
+// Add `count' units of the function `fn_name', e.g. days_add, to `value'.
+template <typename DateValueType>
+static bool add_time_interval(const std::string& fn_name, __int128 count, DateValueType* value) {
+    if (count > std::numeric_limits<int32_t>::max() ||
+        count < std::numeric_limits<int32_t>::min()) {
+        return false;
+    }
+    bool is_neg = count < 0;
+    int64_t abs_count = is_neg ? -(int64_t)count : (int64_t)count;
+    if (fn_name.compare(0, 8, "seconds_") == 0) {
+        return value->template date_add_interval<SECOND>(TimeInterval(SECOND, abs_count, is_neg));
+    } else if (fn_name.compare(0, 8, "minutes_") == 0) {
+        return value->template date_add_interval<MINUTE>(TimeInterval(MINUTE, abs_count, is_neg));
+    } else if (fn_name.compare(0, 6, "hours_") == 0) {
+        return value->template date_add_interval<HOUR>(TimeInterval(HOUR, abs_count, is_neg));
+    } else if (fn_name.compare(0, 5, "days_") == 0) {
+        return value->template date_add_interval<DAY>(TimeInterval(DAY, abs_count, is_neg));
+    } else if (fn_name.compare(0, 6, "weeks_") == 0) {
+        return value->template date_add_interval<WEEK>(TimeInterval(WEEK, abs_count, is_neg));
+    }
+    return false;
+}
+
 Status VScanNode::init(const TPlanNode& tnode, RuntimeState* state) {
     RETURN_IF_ERROR(ExecNode::init(tnode, state));
     _state = state;
@@ -243,11 +361,12 @@ Status VScanNode::_init_profile() {
     _scanner_sched_counter = ADD_COUNTER(_scanner_profile, "ScannerSchedCount", TUnit::UNIT);
     _scanner_ctx_sched_counter = ADD_COUNTER(_scanner_profile, "ScannerCtxSchedCount", TUnit::UNIT);
 
-    _scan_timer = ADD_TIMER(_scanner_profile, "ScannerGetBlockTime");
+    // updated by all the scanners at once
+    _scan_timer = ADD_CORE_LOCAL_TIMER(_scanner_profile, "ScannerGetBlockTime");
     _scan_cpu_timer = ADD_TIMER(_scanner_profile, "ScannerCpuTime");
     _prefilter_timer = ADD_TIMER(_scanner_profile, "ScannerPrefilterTime");
     _convert_block_timer = ADD_TIMER(_scanner_profile, "ScannerConvertBlockTime");
-    _filter_timer = ADD_TIMER(_scanner_profile, "ScannerFilterTime");
+    _filter_timer = ADD_CORE_LOCAL_TIMER(_scanner_profile, "ScannerFilterTime");
 
     // time of scan thread to wait for worker thread of the thread pool
     _scanner_wait_worker_timer = ADD_TIMER(_runtime_profile, "ScannerWorkerWaitTime");
@@ -255,6 +374,12 @@ Status VScanNode::_init_profile() {
     _pre_alloc_free_blocks_num =
             ADD_COUNTER(_runtime_profile, "PreAllocFreeBlocksNum", TUnit::UNIT);
     _max_scanner_thread_num = ADD_COUNTER(_runtime_profile, "MaxScannerThreadNum", TUnit::UNIT);
+    _scanner_concurrency_up_counter =
+            ADD_COUNTER(_scanner_profile, "ScannerConcurrencyUpCount", TUnit::UNIT);
+    _scanner_concurrency_down_counter =
+            ADD_COUNTER(_scanner_profile, "ScannerConcurrencyDownCount", TUnit::UNIT);
+    _peak_scanner_concurrency =
+            _scanner_profile->AddHighWaterMarkCounter("PeakScannerConcurrency", TUnit::UNIT);
 
     return Status::OK();
 }
@@ -277,6 +402,9 @@ Status VScanNode::_register_runtime_filter() {
     int filter_size = _runtime_filter_descs.size();
     _runtime_filter_ctxs.reserve(filter_size);
     _runtime_filter_ready_flag.reserve(filter_size);
+    if (_is_pipeline_scan && filter_size > 0) {
+        _rf_dependency = std::make_shared<pipeline::Dependency>();
+    }
     for (int i = 0; i < filter_size; ++i) {
         IRuntimeFilter* runtime_filter = nullptr;
         const auto& filter_desc = _runtime_filter_descs[i];
@@ -284,6 +412,9 @@ Status VScanNode::_register_runtime_filter() {
                 RuntimeFilterRole::CONSUMER, filter_desc, _state->query_options(), id()));
         RETURN_IF_ERROR(_state->runtime_filter_mgr()->get_consume_filter(filter_desc.filter_id,
                                                                          &runtime_filter));
+        if (_rf_dependency) {
+            runtime_filter->add_ready_dependency(_rf_dependency);
+        }
         _runtime_filter_ctxs.emplace_back(runtime_filter);
         _runtime_filter_ready_flag.emplace_back(false);
     }
@@ -549,6 +680,17 @@ Status VScanNode::_normalize_predicate(VExpr* conjunct_expr_root, VExpr** output
         }
         return false;
     };
+    auto monotonic_function_checker = [](const std::vector<VExpr*>& children,
+                                         const VSlotRef** slot, VExpr** child_contains_slot) {
+        for (const VExpr* child : children) {
+            if (const VSlotRef* slot_ref = monotonic_function_arg(child)) {
+                *slot = slot_ref;
+                *child_contains_slot = const_cast<VSlotRef*>(slot_ref);
+                return true;
+            }
+        }
+        return false;
+    };
 
     if (conjunct_expr_root != nullptr) {
         if (is_leaf(conjunct_expr_root)) {
@@ -600,6 +742,15 @@ Status VScanNode::_normalize_predicate(VExpr* conjunct_expr_root, VExpr** output
                             }
                         },
                         *range);
+            } else if (_is_predicate_acting_on_slot(cur_expr, monotonic_function_checker, &slot,
+                                                    &range)) {
+                std::visit(
+                        [&](auto& value_range) {
+                            RETURN_IF_PUSH_DOWN(_normalize_monotonic_function_predicate(
+                                    cur_expr, *(_vconjunct_ctx_ptr.get()), slot, value_range,
+                                    &pdt));
+                        },
+                        *range);
             }
 
             if (pdt == PushDownType::UNACCEPTABLE &&
@@ -1207,6 +1358,122 @@ Status VScanNode::_normalize_match_predicate(VExpr* expr, VExprContext* expr_ctx
     return Status::OK();
 }
 
+// `f(col) op constant', where f is monotonic, implies a range of col. The range is pushed
+// down so that the zone maps of segments and pages can be used, and the predicate is kept.
+template <PrimitiveType T>
+Status VScanNode::_normalize_monotonic_function_predicate(VExpr* expr, VExprContext* expr_ctx,
+                                                          SlotDescriptor* slot,
+                                                          ColumnValueRange<T>& range,
+                                                          PushDownType* pdt) {
+    if (TExprNodeType::BINARY_PRED != expr->node_type()) {
+        return Status::OK();
+    }
+    DCHECK(expr->children().size() == 2);
+    const std::string& fn_name = expr->fn().name.function_name;
+    if (fn_name != "eq" && fn_name != "lt" && fn_name != "le" && fn_name != "gt" &&
+        fn_name != "ge") {
+        return Status::OK();
+    }
+    int fn_child = monotonic_function_arg(expr->children()[0]) != nullptr ? 0 : 1;
+    VExpr* fn_expr = expr->children()[fn_child];
+    auto get_const_value = [&](VExpr* const_expr, StringRef* value) -> Status {
+        *value = StringRef();
+        if (!const_expr->is_constant()) {
+            return Status::OK();
+        }
+        std::shared_ptr<ColumnPtrWrapper> const_col_wrapper;
+        RETURN_IF_ERROR(const_expr->get_const_col(expr_ctx, &const_col_wrapper));
+        if (const ColumnConst* const_column =
+                    check_and_get_column<ColumnConst>(const_col_wrapper->column_ptr)) {
+            *value = const_column->get_data_at(0);
+        }
+        return Status::OK();
+    };
+    StringRef value;
+    RETURN_IF_ERROR(get_const_value(expr->children()[1 - fn_child], &value));
+    if (value.data == nullptr) {
+        return Status::OK();
+    }
+
+    using CppType = typename PrimitiveTypeTraits<T>::CppType;
+    // the op on col, FILTER_IN means eq
+    SQLFilterOp op = fn_name == "eq" ? FILTER_IN : to_olap_filter_type(fn_name, fn_child == 1);
+    bool pushed = false;
+    auto add_range = [&](SQLFilterOp filter_op, const CppType& bound) -> Status {
+        if (filter_op == FILTER_IN) {
+            RETURN_IF_ERROR(range.add_range(FILTER_LARGER_OR_EQUAL, bound));
+            RETURN_IF_ERROR(range.add_range(FILTER_LESS_OR_EQUAL, bound));
+        } else {
+            RETURN_IF_ERROR(range.add_range(filter_op, bound));
+        }
+        pushed = true;
+        return Status::OK();
+    };
+
+    if (fn_expr->node_type() == TExprNodeType::CAST_EXPR) {
+        if constexpr (T == TYPE_TINYINT || T == TYPE_SMALLINT || T == TYPE_INT ||
+                      T == TYPE_BIGINT) {
+            // a widening cast keeps the order and the values
+            PrimitiveType cast_type = fn_expr->type().type;
+            if (integer_size(cast_type) >= sizeof(CppType)) {
+                __int128 v = read_integer(cast_type, value.data);
+                if (v >= std::numeric_limits<CppType>::min() &&
+                    v <= std::numeric_limits<CppType>::max()) {
+                    RETURN_IF_ERROR(add_range(op, static_cast<CppType>(v)));
+                }
+            }
+        }
+    } else if (fn_expr->fn().name.function_name == "date_trunc") {
+        if constexpr (T == TYPE_DATETIMEV2) {
+            StringRef unit;
+            RETURN_IF_ERROR(get_const_value(fn_expr->children()[1], &unit));
+            if (unit.data == nullptr) {
+                return Status::OK();
+            }
+            // date_trunc(col) <= col < the start of the unit next to date_trunc(col), so
+            // date_trunc(col) < v, or <= v, implies col < the start of the unit next to v
+            CppType v;
+            memcpy(&v, value.data, sizeof(CppType));
+            CppType upper = v;
+            bool has_upper = next_time_unit_start(unit, &upper);
+            if (op == FILTER_IN || op == FILTER_LARGER_OR_EQUAL || op == FILTER_LARGER) {
+                RETURN_IF_ERROR(add_range(op == FILTER_IN ? FILTER_LARGER_OR_EQUAL : op, v));
+            }
+            if (has_upper &&
+                (op == FILTER_IN || op == FILTER_LESS || op == FILTER_LESS_OR_EQUAL)) {
+                RETURN_IF_ERROR(add_range(FILTER_LESS, upper));
+            }
+        }
+    } else {
+        if constexpr (T == TYPE_DATETIMEV2 || T == TYPE_DATEV2) {
+            // e.g. hours_add(datev2) returns datetimev2
+            if (fn_expr->type().type != T) {
+                return Status::OK();
+            }
+            StringRef delta;
+            RETURN_IF_ERROR(get_const_value(fn_expr->children()[1], &delta));
+            PrimitiveType delta_type = fn_expr->children()[1]->type().type;
+            if (delta.data == nullptr || integer_size(delta_type) == 0) {
+                return Status::OK();
+            }
+            // col + delta op v <=> col op v - delta
+            const std::string& interval_fn = fn_expr->fn().name.function_name;
+            __int128 count = read_integer(delta_type, delta.data);
+            bool is_sub = interval_fn.size() > 4 &&
+                          interval_fn.compare(interval_fn.size() - 4, 4, "_sub") == 0;
+            CppType v;
+            memcpy(&v, value.data, sizeof(CppType));
+            if (add_time_interval(interval_fn, is_sub ? count : -count, &v)) {
+                RETURN_IF_ERROR(add_range(op, v));
+            }
+        }
+    }
+    if (pushed) {
+        *pdt = PushDownType::PARTIAL_ACCEPTABLE;
+    }
+    return Status::OK();
+}
+
 template <bool IsFixed, PrimitiveType PrimitiveType, typename ChangeFixedValueRangeFunc>
 Status VScanNode::_change_value_range(ColumnValueRange<PrimitiveType>& temp_range, void* value,
                                       const ChangeFixedValueRangeFunc& func,
@@ -1291,6 +1558,7 @@ Status VScanNode::try_append_late_arrival_runtime_filter(int* arrived_rf_num) {
     // 2. Append unapplied runtime filters to vconjunct_ctx_ptr
     if (!vexprs.empty()) {
         RETURN_IF_ERROR(_append_rf_into_conjuncts(vexprs));
+        RETURN_IF_ERROR(_push_down_late_arrival_runtime_filters(vexprs));
     }
     if (current_arrived_rf_num == _runtime_filter_descs.size()) {
         _is_all_rf_applied = true;
@@ -99,6 +99,8 @@ public:
     Status alloc_resource(RuntimeState* state) override;
     void release_resource(RuntimeState* state) override;
     bool runtime_filters_are_ready_or_timeout();
+    // notified when any runtime filter is ready, only for pipeline scan
+    pipeline::Dependency* runtime_filter_dependency() { return _rf_dependency.get(); }
 
     Status try_close();
 
@@ -135,6 +137,13 @@ protected:
         return Status::OK();
     }
 
+    // Push down the runtime filters which arrive after the conjuncts have been normalized.
+    // Called with `_rf_locks` held. The filters are already appended to `_vconjunct_ctx_ptr`,
+    // so a data source only needs to implement this when it can make use of them earlier.
+    virtual Status _push_down_late_arrival_runtime_filters(const std::vector<VExpr*>& vexprs) {
+        return Status::OK();
+    }
+
     // Create a list of scanners.
     // The number of scanners is related to the implementation of the data source,
     // predicate conditions, and scheduling strategy.
@@ -210,6 +219,7 @@ protected:
     std::vector<TRuntimeFilterDesc> _runtime_filter_descs;
     // Set to true if the runtime filter is ready.
     std::vector<bool> _runtime_filter_ready_flag;
+    std::shared_ptr<pipeline::Dependency> _rf_dependency;
     doris::Mutex _rf_locks;
     std::map<int, RuntimeFilterContext*> _conjunct_id_to_runtime_filter_ctxs;
     phmap::flat_hash_set<VExpr*> _rf_vexpr_set;
@@ -307,6 +317,10 @@ protected:
     RuntimeProfile::Counter* _newly_create_free_blocks_num = nullptr;
     // Max num of scanner thread
     RuntimeProfile::Counter* _max_scanner_thread_num = nullptr;
+    // Times of the adaptive scanner concurrency grows or shrinks
+    RuntimeProfile::Counter* _scanner_concurrency_up_counter = nullptr;
+    RuntimeProfile::Counter* _scanner_concurrency_down_counter = nullptr;
+    RuntimeProfile::HighWaterMarkCounter* _peak_scanner_concurrency = nullptr;
 
     RuntimeProfile::HighWaterMarkCounter* _queued_blocks_memory_usage;
     RuntimeProfile::HighWaterMarkCounter* _free_blocks_memory_usage;
@@ -381,6 +395,11 @@ private:
                                       SlotDescriptor* slot, ColumnValueRange<T>& range,
                                       PushDownType* pdt);
 
+    template <PrimitiveType T>
+    Status _normalize_monotonic_function_predicate(vectorized::VExpr* expr,
+                                                   VExprContext* expr_ctx, SlotDescriptor* slot,
+                                                   ColumnValueRange<T>& range, PushDownType* pdt);
+
     template <bool IsFixed, PrimitiveType PrimitiveType, typename ChangeFixedValueRangeFunc>
     static Status _change_value_range(ColumnValueRange<PrimitiveType>& range, void* value,
                                       const ChangeFixedValueRangeFunc& func,
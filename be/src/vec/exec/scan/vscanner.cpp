@@ -65,7 +65,7 @@ Status VScanner::get_block(RuntimeState* state, Block* block, bool* eof) {
             block->clear_same_bit();
             // 1. Get input block from scanner
             {
-                SCOPED_TIMER(_parent->_scan_timer);
+                SCOPED_TSC_TIMER(_parent->_scan_timer);
                 RETURN_IF_ERROR(_get_block_impl(state, block, eof));
                 if (*eof) {
                     DCHECK(block->rows() == 0);
@@ -76,7 +76,7 @@ Status VScanner::get_block(RuntimeState* state, Block* block, bool* eof) {
 
             // 2. Filter the output block finally.
             {
-                SCOPED_TIMER(_parent->_filter_timer);
+                SCOPED_TSC_TIMER(_parent->_filter_timer);
                 RETURN_IF_ERROR(_filter_output_block(block));
             }
             // record rows return (after filter) for _limit check
@@ -20,7 +20,13 @@
 #include <memory>
 
 #include "exec/exec_node.h"
+#include "runtime/exec_env.h"
+#include "runtime/thread_context.h"
+#include "util/countdown_latch.h"
+#include "util/threadpool.h"
 #include "vec/core/block.h"
+#include "vec/core/block_spill_reader.h"
+#include "vec/core/block_spill_writer.h"
 #include "vec/data_types/data_type_nullable.h"
 #include "vec/data_types/data_type_string.h"
 #include "vec/exprs/vexpr.h"
@@ -32,6 +38,10 @@ namespace doris::vectorized {
 // Here is an empirical value.
 static constexpr size_t HASH_MAP_PREFETCH_DIST = 16;
 
+/// The keys of a block are checked for runs only if at most half of the first rows start new
+/// runs, e.g. the input is sorted by the keys, so that the unsorted input does not pay for it.
+static constexpr size_t KEY_RUNS_SAMPLE_ROWS = 64;
+
 /// The minimum reduction factor (input rows divided by output rows) to grow hash tables
 /// in a streaming preaggregation, given that the hash tables are currently the given
 /// size or above. The sizes roughly correspond to hash table sizes where the bucket
@@ -75,6 +85,15 @@ static constexpr StreamingHtMinReductionEntry STREAMING_HT_MIN_REDUCTION[] = {
 static constexpr int STREAMING_HT_MIN_REDUCTION_SIZE =
         sizeof(STREAMING_HT_MIN_REDUCTION) / sizeof(STREAMING_HT_MIN_REDUCTION[0]);
 
+// The number of partitions the hash table is splitted into when spilling.
+// Every partition is read back and aggregated in memory separately, so the
+// memory needed by final aggregation is about 1 / SPILL_PARTITION_COUNT of
+// the memory needed by the whole hash table.
+static constexpr int SPILL_PARTITION_COUNT = 16;
+// Seed of the partition hash, must differ from the one used by data stream sender,
+// otherwise the rows shuffled to this instance would fall into a few partitions.
+static constexpr uint64_t SPILL_PARTITION_HASH_SEED = 0x9E3779B97F4A7C15ULL;
+
 AggregationNode::AggregationNode(ObjectPool* pool, const TPlanNode& tnode,
                                  const DescriptorTbl& descs)
         : ExecNode(pool, tnode, descs),
@@ -139,7 +158,9 @@ Status AggregationNode::init(const TPlanNode& tnode, RuntimeState* state) {
         _aggregate_evaluators.push_back(evaluator);
     }
 
-    _partitioned_hash_table_enabled = state->partitioned_hash_agg_rows_threshold() > 0;
+    _partitioned_hash_agg_rows_threshold = state->partitioned_hash_agg_rows_threshold();
+    _partitioned_hash_table_enabled = _partitioned_hash_agg_rows_threshold > 0;
+    _external_agg_bytes_threshold = state->external_agg_bytes_threshold();
     _agg_data->set_enable_partitioned_hash_table(_partitioned_hash_table_enabled);
 
     const auto& agg_functions = tnode.agg_node.aggregate_functions;
@@ -284,12 +305,38 @@ void AggregationNode::_init_hash_method(std::vector<VExprContext*>& probe_exprs)
                         _agg_data->init(AggregatedDataVariants::Type::int256_keys_phase2, has_null);
                 }
             }
+        } else if (_use_short_serialized_key(probe_exprs)) {
+            _agg_data->init(AggregatedDataVariants::Type::serialized_short_key);
         } else {
             _agg_data->init(AggregatedDataVariants::Type::serialized);
         }
     }
 }
 
+// Whether the keys serialized from the group by columns are likely to have at most 24 bytes,
+// e.g. an int and a short string. Every column must be of a fixed size or a string.
+bool AggregationNode::_use_short_serialized_key(std::vector<VExprContext*>& probe_exprs) {
+    // the terminator appended to every key
+    size_t fixed_byte_size = 1;
+    for (auto* ctx : probe_exprs) {
+        const auto& data_type = ctx->root()->data_type();
+        auto nested_type = remove_nullable(data_type);
+        if (data_type->is_nullable()) {
+            // the null flag
+            fixed_byte_size += 1;
+        }
+        if (WhichDataType(nested_type).is_string()) {
+            // the length of the string
+            fixed_byte_size += sizeof(UInt32);
+        } else if (nested_type->have_maximum_size_of_value()) {
+            fixed_byte_size += nested_type->get_maximum_size_of_value_in_memory();
+        } else {
+            return false;
+        }
+    }
+    return fixed_byte_size < sizeof(StringKey24);
+}
+
 Status AggregationNode::prepare_profile(RuntimeState* state) {
     auto* memory_usage = runtime_profile()->create_child("MemoryUsage", true, true);
     runtime_profile()->add_child(memory_usage, false, nullptr);
@@ -311,8 +358,12 @@ Status AggregationNode::prepare_profile(RuntimeState* state) {
     _hash_table_iterate_timer = ADD_TIMER(runtime_profile(), "HashTableIterateTime");
     _insert_keys_to_column_timer = ADD_TIMER(runtime_profile(), "InsertKeysToColumnTime");
     _streaming_agg_timer = ADD_TIMER(runtime_profile(), "StreamingAggTime");
+    _pass_through_rows_counter = ADD_COUNTER(runtime_profile(), "PassThroughRows", TUnit::UNIT);
+    _streaming_agg_bypass_counter =
+            ADD_COUNTER(runtime_profile(), "StreamingAggBypassCount", TUnit::UNIT);
     _hash_table_size_counter = ADD_COUNTER(runtime_profile(), "HashTableSize", TUnit::UNIT);
     _hash_table_input_counter = ADD_COUNTER(runtime_profile(), "HashTableInputCount", TUnit::UNIT);
+    _hash_table_run_rows_counter = ADD_COUNTER(runtime_profile(), "HashTableRunRows", TUnit::UNIT);
     _max_row_size_counter = ADD_COUNTER(runtime_profile(), "MaxRowSizeInBytes", TUnit::UNIT);
     COUNTER_SET(_max_row_size_counter, (int64_t)0);
     _intermediate_tuple_desc = state->desc_tbl().get_tuple_descriptor(_intermediate_tuple_id);
@@ -401,24 +452,8 @@ Status AggregationNode::prepare_profile(RuntimeState* state) {
         _executor.close = std::bind<void>(&AggregationNode::_close_without_key, this);
     } else {
         _init_hash_method(_probe_expr_ctxs);
-
-        std::visit(
-                [&](auto&& agg_method) {
-                    using HashTableType = std::decay_t<decltype(agg_method.data)>;
-                    using KeyType = typename HashTableType::key_type;
-
-                    /// some aggregate functions (like AVG for decimal) have align issues.
-                    _aggregate_data_container.reset(new AggregateDataContainer(
-                            sizeof(KeyType),
-                            ((_total_size_of_aggregate_states + _align_aggregate_states - 1) /
-                             _align_aggregate_states) *
-                                    _align_aggregate_states));
-                    if constexpr (HashTableTraits<HashTableType>::is_partitioned_table) {
-                        agg_method.data.set_partitioned_threshold(
-                                state->partitioned_hash_agg_rows_threshold());
-                    }
-                },
-                _agg_data->_aggregated_method_variant);
+        _init_aggregate_data_container();
+        _init_key_runs();
         if (_is_merge) {
             _executor.execute = std::bind<Status>(&AggregationNode::_merge_with_serialized_key,
                                                   this, std::placeholders::_1);
@@ -450,11 +485,57 @@ Status AggregationNode::prepare_profile(RuntimeState* state) {
         _should_limit_output = _limit != -1 &&        // has limit
                                !_vconjunct_ctx_ptr && // no having conjunct
                                _needs_finalize;       // agg's finalize step
+
+        if (_external_agg_bytes_threshold > 0 && !_is_streaming_preagg && !_should_limit_output) {
+            _block_spill_profile = runtime_profile()->create_child("BlockSpill", true, true);
+            runtime_profile()->add_child(_block_spill_profile, false, nullptr);
+            _spill_timer = ADD_TIMER(_block_spill_profile, "SpillTime");
+            _spill_read_timer = ADD_TIMER(_block_spill_profile, "SpillReadTime");
+            _spill_count = ADD_COUNTER(_block_spill_profile, "SpillCount", TUnit::UNIT);
+            _spill_rows = ADD_COUNTER(_block_spill_profile, "SpillRows", TUnit::UNIT);
+            _revocable_memory = std::make_unique<RevocableMemory>(
+                    fmt::format("AggregationNode (id={})", id()), state);
+        } else {
+            _external_agg_bytes_threshold = 0;
+        }
+
+        // the states of a group must be merged by one thread in order, and udafs may not
+        // be called from other threads
+        bool can_merge_in_parallel = _is_merge && !_is_streaming_preagg && !_should_limit_output;
+        for (auto* evaluator : _aggregate_evaluators) {
+            if (!evaluator->is_merge() || evaluator->is_udaf()) {
+                can_merge_in_parallel = false;
+            }
+        }
+        if (can_merge_in_parallel && config::agg_parallel_merge_min_rows > 0) {
+            _parallel_merge_min_rows = config::agg_parallel_merge_min_rows;
+            _runtime_state = state;
+            runtime_profile()->append_exec_option("Parallel Merge");
+        }
     }
 
     return Status::OK();
 }
 
+void AggregationNode::_init_aggregate_data_container() {
+    std::visit(
+            [&](auto&& agg_method) {
+                using HashTableType = std::decay_t<decltype(agg_method.data)>;
+                using KeyType = typename HashTableType::key_type;
+
+                /// some aggregate functions (like AVG for decimal) have align issues.
+                _aggregate_data_container.reset(new AggregateDataContainer(
+                        sizeof(KeyType),
+                        ((_total_size_of_aggregate_states + _align_aggregate_states - 1) /
+                         _align_aggregate_states) *
+                                _align_aggregate_states));
+                if constexpr (HashTableTraits<HashTableType>::is_partitioned_table) {
+                    agg_method.data.set_partitioned_threshold(_partitioned_hash_agg_rows_threshold);
+                }
+            },
+            _agg_data->_aggregated_method_variant);
+}
+
 Status AggregationNode::prepare(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
 
@@ -555,7 +636,11 @@ Status AggregationNode::get_next(RuntimeState* state, Block* block, bool* eos) {
 }
 
 Status AggregationNode::pull(doris::RuntimeState* state, vectorized::Block* block, bool* eos) {
-    RETURN_IF_ERROR(_executor.get_result(state, block, eos));
+    if (_is_spilled) {
+        RETURN_IF_ERROR(_get_spilled_result(state, block, eos));
+    } else {
+        RETURN_IF_ERROR(_executor.get_result(state, block, eos));
+    }
     _make_nullable_output_key(block);
     // dispose the having clause, should not be execute in prestreaming agg
     RETURN_IF_ERROR(VExprContext::filter_block(_vconjunct_ctx_ptr, block, block->columns()));
@@ -565,11 +650,36 @@ Status AggregationNode::pull(doris::RuntimeState* state, vectorized::Block* bloc
 }
 
 Status AggregationNode::sink(doris::RuntimeState* state, vectorized::Block* in_block, bool eos) {
+    Block buffered_block;
+    if (_parallel_merge_min_rows > 0) {
+        // merge small blocks together, so that a parallel merge has enough rows
+        if (in_block->rows() > 0) {
+            RETURN_IF_CATCH_BAD_ALLOC(_merge_buffer_block.merge(*in_block));
+        }
+        if (_merge_buffer_block.rows() < _parallel_merge_min_rows && !eos) {
+            return Status::OK();
+        }
+        buffered_block = _merge_buffer_block.to_block();
+        _merge_buffer_block = MutableBlock();
+        in_block = &buffered_block;
+    }
     if (in_block->rows() > 0) {
         RETURN_IF_ERROR(_executor.execute(in_block));
         _executor.update_memusage();
+        if (_revocable_memory) {
+            _revocable_memory->set_bytes(_mem_usage_record.used_in_arena +
+                                         _mem_usage_record.used_in_state);
+        }
+        if (_should_spill()) {
+            RETURN_IF_ERROR(_spill_hash_table(state));
+        }
+    }
+    if (eos) {
+        if (_is_spilled) {
+            RETURN_IF_ERROR(_finish_spill(state));
+        }
+        _can_read = true;
     }
-    if (eos) _can_read = true;
     return Status::OK();
 }
 
@@ -591,6 +701,7 @@ void AggregationNode::release_resource(RuntimeState* state) {
                 },
                 _agg_data->_aggregated_method_variant);
     }
+    _revocable_memory.reset();
     _release_mem();
     ExecNode::release_resource(state);
 }
@@ -852,6 +963,54 @@ size_t AggregationNode::_get_hash_table_size() {
                       _agg_data->_aggregated_method_variant);
 }
 
+void AggregationNode::_init_key_runs() {
+    // The rows of a run share the place of its first row, so the keys must compare equal only if
+    // the hash table takes them as the same key, which does not hold for e.g. 0.0 and -0.0.
+    _key_runs_enabled = true;
+    for (const auto* ctx : _probe_expr_ctxs) {
+        WhichDataType which(remove_nullable(ctx->root()->data_type()));
+        if (!which.is_int_or_uint() && !which.is_decimal() && !which.is_date_or_datetime() &&
+            !which.is_date_v2_or_datetime_v2() && !which.is_string()) {
+            _key_runs_enabled = false;
+            return;
+        }
+    }
+}
+
+bool AggregationNode::_find_key_runs(const ColumnRawPtrs& key_columns, size_t num_rows) {
+    if (!_key_runs_enabled || num_rows < KEY_RUNS_SAMPLE_ROWS) {
+        return false;
+    }
+    auto same_keys = [&](size_t row) {
+        for (const auto* column : key_columns) {
+            if (column->compare_at(row, row - 1, *column, 1) != 0) {
+                return false;
+            }
+        }
+        return true;
+    };
+    size_t sampled_runs = 1;
+    for (size_t i = 1; i < KEY_RUNS_SAMPLE_ROWS; ++i) {
+        sampled_runs += !same_keys(i);
+    }
+    if (sampled_runs * 2 > KEY_RUNS_SAMPLE_ROWS) {
+        return false;
+    }
+
+    _same_keys_as_prev.resize(num_rows);
+    _same_keys_as_prev[0] = 0;
+    memset(_same_keys_as_prev.data() + 1, 1, num_rows - 1);
+    // column by column, so that a run break found in the first columns skips the others
+    for (const auto* column : key_columns) {
+        for (size_t i = 1; i < num_rows; ++i) {
+            if (_same_keys_as_prev[i] && column->compare_at(i, i - 1, *column, 1) != 0) {
+                _same_keys_as_prev[i] = 0;
+            }
+        }
+    }
+    return true;
+}
+
 void AggregationNode::_emplace_into_hash_table(AggregateDataPtr* places, ColumnRawPtrs& key_columns,
                                                const size_t num_rows) {
     std::visit(
@@ -864,17 +1023,26 @@ void AggregationNode::_emplace_into_hash_table(AggregateDataPtr* places, ColumnR
 
                 _pre_serialize_key_if_need(state, agg_method, key_columns, num_rows);
 
+                // The rows which have the same keys as their previous rows reuse their places,
+                // e.g. the leading key columns of a scan sorted by them.
+                const bool has_key_runs = _find_key_runs(key_columns, num_rows);
+                auto in_run = [&](size_t row) { return has_key_runs && _same_keys_as_prev[row]; };
+
                 if constexpr (HashTableTraits<HashTableType>::is_phmap) {
                     if (_hash_values.size() < num_rows) _hash_values.resize(num_rows);
                     if constexpr (ColumnsHashing::IsPreSerializedKeysHashMethodTraits<
                                           AggState>::value) {
                         for (size_t i = 0; i < num_rows; ++i) {
-                            _hash_values[i] = agg_method.data.hash(agg_method.keys[i]);
+                            if (!in_run(i)) {
+                                _hash_values[i] = agg_method.data.hash(agg_method.keys[i]);
+                            }
                         }
                     } else {
                         for (size_t i = 0; i < num_rows; ++i) {
-                            _hash_values[i] =
-                                    agg_method.data.hash(state.get_key_holder(i, *_agg_arena_pool));
+                            if (!in_run(i)) {
+                                _hash_values[i] = agg_method.data.hash(
+                                        state.get_key_holder(i, *_agg_arena_pool));
+                            }
                         }
                     }
                 }
@@ -902,9 +1070,16 @@ void AggregationNode::_emplace_into_hash_table(AggregateDataPtr* places, ColumnR
                     _create_agg_status(mapped);
                 };
 
+                size_t run_rows = 0;
+
                 /// For all rows.
                 COUNTER_UPDATE(_hash_table_input_counter, num_rows);
                 for (size_t i = 0; i < num_rows; ++i) {
+                    if (in_run(i)) {
+                        places[i] = places[i - 1];
+                        ++run_rows;
+                        continue;
+                    }
                     AggregateDataPtr mapped = nullptr;
                     if constexpr (HashTableTraits<HashTableType>::is_phmap) {
                         if (LIKELY(i + HASH_MAP_PREFETCH_DIST < num_rows)) {
@@ -935,6 +1110,7 @@ void AggregationNode::_emplace_into_hash_table(AggregateDataPtr* places, ColumnR
                     places[i] = mapped;
                     assert(places[i] != nullptr);
                 }
+                COUNTER_UPDATE(_hash_table_run_rows_counter, run_rows);
             },
             _agg_data->_aggregated_method_variant);
 }
@@ -990,6 +1166,116 @@ void AggregationNode::_find_in_hash_table(AggregateDataPtr* places, ColumnRawPtr
             _agg_data->_aggregated_method_variant);
 }
 
+// Serialize the input rows as one row aggregate states without aggregating them.
+Status AggregationNode::_streaming_agg_pass_through(Block* in_block, Block* out_block,
+                                                    const ColumnRawPtrs& key_columns,
+                                                    size_t rows) {
+    SCOPED_TIMER(_streaming_agg_timer);
+    COUNTER_UPDATE(_pass_through_rows_counter, rows);
+    size_t key_size = key_columns.size();
+
+    // will serialize value data to string column.
+    // non-nullable column(id in `_make_nullable_keys`)
+    // will be converted to nullable.
+    bool mem_reuse = _make_nullable_keys.empty() && out_block->mem_reuse();
+
+    std::vector<DataTypePtr> data_types;
+    MutableColumns value_columns;
+    if (_use_fixed_length_serialization_opt) {
+        for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
+            auto data_type = _aggregate_evaluators[i]->function()->get_serialized_type();
+            if (mem_reuse) {
+                value_columns.emplace_back(
+                        std::move(*out_block->get_by_position(i + key_size).column).mutate());
+            } else {
+                // slot type of value it should always be string type
+                value_columns.emplace_back(
+                        _aggregate_evaluators[i]->function()->create_serialize_column());
+            }
+            data_types.emplace_back(data_type);
+        }
+
+        for (int i = 0; i != _aggregate_evaluators.size(); ++i) {
+            SCOPED_TIMER(_serialize_data_timer);
+            RETURN_IF_ERROR(_aggregate_evaluators[i]->streaming_agg_serialize_to_column(
+                    in_block, value_columns[i], rows, _agg_arena_pool.get()));
+        }
+    } else {
+        std::vector<VectorBufferWriter> value_buffer_writers;
+        auto serialize_string_type = std::make_shared<DataTypeString>();
+        for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
+            if (mem_reuse) {
+                value_columns.emplace_back(
+                        std::move(*out_block->get_by_position(i + key_size).column).mutate());
+            } else {
+                // slot type of value it should always be string type
+                value_columns.emplace_back(serialize_string_type->create_column());
+            }
+            data_types.emplace_back(serialize_string_type);
+            value_buffer_writers.emplace_back(
+                    *reinterpret_cast<ColumnString*>(value_columns[i].get()));
+        }
+
+        for (int i = 0; i != _aggregate_evaluators.size(); ++i) {
+            SCOPED_TIMER(_serialize_data_timer);
+            RETURN_IF_ERROR(_aggregate_evaluators[i]->streaming_agg_serialize(
+                    in_block, value_buffer_writers[i], rows, _agg_arena_pool.get()));
+        }
+    }
+
+    if (!mem_reuse) {
+        ColumnsWithTypeAndName columns_with_schema;
+        for (int i = 0; i < key_size; ++i) {
+            columns_with_schema.emplace_back(key_columns[i]->clone_resized(rows),
+                                             _probe_expr_ctxs[i]->root()->data_type(),
+                                             _probe_expr_ctxs[i]->root()->expr_name());
+        }
+        for (int i = 0; i < value_columns.size(); ++i) {
+            columns_with_schema.emplace_back(std::move(value_columns[i]), data_types[i], "");
+        }
+        out_block->swap(Block(columns_with_schema));
+    } else {
+        for (int i = 0; i < key_size; ++i) {
+            std::move(*out_block->get_by_position(i).column)
+                    .mutate()
+                    ->insert_range_from(*key_columns[i], 0, rows);
+        }
+    }
+    return Status::OK();
+}
+
+// Sample the reduction of the rows aggregated into the hash table. When a sample of
+// `streaming_agg_bypass_sample_rows` rows does not reach `streaming_agg_bypass_min_reduction`,
+// the following rows are passed through, until `streaming_agg_bypass_reprobe_rows` rows have
+// been passed through and a new sample is taken.
+void AggregationNode::_update_streaming_agg_bypass(size_t rows, size_t new_groups) {
+    if (_streaming_agg_bypass) {
+        _bypass_rows += rows;
+        if (_bypass_rows >= config::streaming_agg_bypass_reprobe_rows) {
+            _streaming_agg_bypass = false;
+            _bypass_rows = 0;
+        }
+        return;
+    }
+    if (config::streaming_agg_bypass_sample_rows <= 0) {
+        return;
+    }
+    _sampled_input_rows += rows;
+    _sampled_new_groups += new_groups;
+    if (_sampled_input_rows < config::streaming_agg_bypass_sample_rows) {
+        return;
+    }
+    double reduction = _sampled_new_groups == 0
+                               ? std::numeric_limits<double>::max()
+                               : static_cast<double>(_sampled_input_rows) / _sampled_new_groups;
+    if (reduction < config::streaming_agg_bypass_min_reduction) {
+        _streaming_agg_bypass = true;
+        COUNTER_UPDATE(_streaming_agg_bypass_counter, 1);
+    }
+    _sampled_input_rows = 0;
+    _sampled_new_groups = 0;
+}
+
 Status AggregationNode::_pre_agg_with_serialized_key(doris::vectorized::Block* in_block,
                                                      doris::vectorized::Block* out_block) {
     SCOPED_TIMER(_build_timer);
@@ -1014,115 +1300,38 @@ Status AggregationNode::_pre_agg_with_serialized_key(doris::vectorized::Block* i
         _places.resize(rows);
     }
 
+    if (_streaming_agg_bypass) {
+        RETURN_IF_ERROR(_streaming_agg_pass_through(in_block, out_block, key_columns, rows));
+        _update_streaming_agg_bypass(rows, 0);
+        return Status::OK();
+    }
+
     // Stop expanding hash tables if we're not reducing the input sufficiently. As our
     // hash tables expand out of each level of cache hierarchy, every hash table lookup
     // will take longer. We also may not be able to expand hash tables because of memory
     // pressure. In either case we should always use the remaining space in the hash table
     // to avoid wasting memory.
     // But for fixed hash map, it never need to expand
-    bool ret_flag = false;
-    RETURN_IF_ERROR(std::visit(
-            [&](auto&& agg_method) -> Status {
-                if (auto& hash_tbl = agg_method.data; hash_tbl.add_elem_size_overflow(rows)) {
-                    // do not try to do agg, just init and serialize directly return the out_block
-                    if (!_should_expand_preagg_hash_tables()) {
-                        SCOPED_TIMER(_streaming_agg_timer);
-                        ret_flag = true;
-
-                        // will serialize value data to string column.
-                        // non-nullable column(id in `_make_nullable_keys`)
-                        // will be converted to nullable.
-                        bool mem_reuse = _make_nullable_keys.empty() && out_block->mem_reuse();
-
-                        std::vector<DataTypePtr> data_types;
-                        MutableColumns value_columns;
-                        if (_use_fixed_length_serialization_opt) {
-                            for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
-                                auto data_type =
-                                        _aggregate_evaluators[i]->function()->get_serialized_type();
-                                if (mem_reuse) {
-                                    value_columns.emplace_back(
-                                            std::move(*out_block->get_by_position(i + key_size)
-                                                               .column)
-                                                    .mutate());
-                                } else {
-                                    // slot type of value it should always be string type
-                                    value_columns.emplace_back(_aggregate_evaluators[i]
-                                                                       ->function()
-                                                                       ->create_serialize_column());
-                                }
-                                data_types.emplace_back(data_type);
-                            }
-
-                            for (int i = 0; i != _aggregate_evaluators.size(); ++i) {
-                                SCOPED_TIMER(_serialize_data_timer);
-                                RETURN_IF_ERROR(
-                                        _aggregate_evaluators[i]->streaming_agg_serialize_to_column(
-                                                in_block, value_columns[i], rows,
-                                                _agg_arena_pool.get()));
-                            }
-                        } else {
-                            std::vector<VectorBufferWriter> value_buffer_writers;
-                            auto serialize_string_type = std::make_shared<DataTypeString>();
-                            for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
-                                if (mem_reuse) {
-                                    value_columns.emplace_back(
-                                            std::move(*out_block->get_by_position(i + key_size)
-                                                               .column)
-                                                    .mutate());
-                                } else {
-                                    // slot type of value it should always be string type
-                                    value_columns.emplace_back(
-                                            serialize_string_type->create_column());
-                                }
-                                data_types.emplace_back(serialize_string_type);
-                                value_buffer_writers.emplace_back(
-                                        *reinterpret_cast<ColumnString*>(value_columns[i].get()));
-                            }
-
-                            for (int i = 0; i != _aggregate_evaluators.size(); ++i) {
-                                SCOPED_TIMER(_serialize_data_timer);
-                                RETURN_IF_ERROR(_aggregate_evaluators[i]->streaming_agg_serialize(
-                                        in_block, value_buffer_writers[i], rows,
-                                        _agg_arena_pool.get()));
-                            }
-                        }
-
-                        if (!mem_reuse) {
-                            ColumnsWithTypeAndName columns_with_schema;
-                            for (int i = 0; i < key_size; ++i) {
-                                columns_with_schema.emplace_back(
-                                        key_columns[i]->clone_resized(rows),
-                                        _probe_expr_ctxs[i]->root()->data_type(),
-                                        _probe_expr_ctxs[i]->root()->expr_name());
-                            }
-                            for (int i = 0; i < value_columns.size(); ++i) {
-                                columns_with_schema.emplace_back(std::move(value_columns[i]),
-                                                                 data_types[i], "");
-                            }
-                            out_block->swap(Block(columns_with_schema));
-                        } else {
-                            for (int i = 0; i < key_size; ++i) {
-                                std::move(*out_block->get_by_position(i).column)
-                                        .mutate()
-                                        ->insert_range_from(*key_columns[i], 0, rows);
-                            }
-                        }
-                    }
-                }
-                return Status::OK();
+    bool ret_flag = std::visit(
+            [&](auto&& agg_method) -> bool {
+                // do not try to do agg, just init and serialize directly return the out_block
+                return agg_method.data.add_elem_size_overflow(rows) &&
+                       !_should_expand_preagg_hash_tables();
             },
-            _agg_data->_aggregated_method_variant));
+            _agg_data->_aggregated_method_variant);
+    if (ret_flag) {
+        return _streaming_agg_pass_through(in_block, out_block, key_columns, rows);
+    }
 
-    if (!ret_flag) {
-        RETURN_IF_CATCH_BAD_ALLOC(_emplace_into_hash_table(_places.data(), key_columns, rows));
+    size_t old_groups = _get_hash_table_size();
+    RETURN_IF_CATCH_BAD_ALLOC(_emplace_into_hash_table(_places.data(), key_columns, rows));
 
-        for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
-            RETURN_IF_ERROR(_aggregate_evaluators[i]->execute_batch_add(
-                    in_block, _offsets_of_aggregate_states[i], _places.data(),
-                    _agg_arena_pool.get(), _should_expand_hash_table));
-        }
+    for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
+        RETURN_IF_ERROR(_aggregate_evaluators[i]->execute_batch_add(
+                in_block, _offsets_of_aggregate_states[i], _places.data(), _agg_arena_pool.get(),
+                _should_expand_hash_table));
     }
+    _update_streaming_agg_bypass(rows, _get_hash_table_size() - old_groups);
 
     return Status::OK();
 }
@@ -1374,7 +1583,7 @@ void AggregationNode::_update_memusage_with_serialized_key() {
     std::visit(
             [&](auto&& agg_method) -> void {
                 auto& data = agg_method.data;
-                auto arena_memory_usage = _agg_arena_pool->size() +
+                auto arena_memory_usage = _agg_arena_pool->size() + _merge_arenas_memory_usage() +
                                           _aggregate_data_container->memory_usage() -
                                           _mem_usage_record.used_in_arena;
                 mem_tracker()->consume(arena_memory_usage);
@@ -1384,12 +1593,103 @@ void AggregationNode::_update_memusage_with_serialized_key() {
                 COUNTER_UPDATE(_hash_table_memory_usage,
                                data.get_buffer_size_in_bytes() - _mem_usage_record.used_in_state);
                 _mem_usage_record.used_in_state = data.get_buffer_size_in_bytes();
-                _mem_usage_record.used_in_arena =
-                        _agg_arena_pool->size() + _aggregate_data_container->memory_usage();
+                _mem_usage_record.used_in_arena = _agg_arena_pool->size() +
+                                                  _merge_arenas_memory_usage() +
+                                                  _aggregate_data_container->memory_usage();
             },
             _agg_data->_aggregated_method_variant);
 }
 
+size_t AggregationNode::_merge_arenas_memory_usage() const {
+    size_t usage = 0;
+    for (auto& arena : _merge_arenas) {
+        usage += arena->size();
+    }
+    return usage;
+}
+
+static constexpr size_t PARALLEL_MERGE_PARTITION_COUNT = 16;
+
+void AggregationNode::_partition_merge_rows(size_t rows) {
+    // all the rows of a group have the same place, so they are in the same partition
+    _merge_row_partitions.resize(rows);
+    _merge_partition_offsets.assign(PARALLEL_MERGE_PARTITION_COUNT + 1, 0);
+    for (size_t i = 0; i < rows; ++i) {
+        auto hash = int_hash64(reinterpret_cast<uintptr_t>(_places[i]));
+        auto partition = hash % PARALLEL_MERGE_PARTITION_COUNT;
+        _merge_row_partitions[i] = partition;
+        ++_merge_partition_offsets[partition + 1];
+    }
+    for (size_t i = 0; i < PARALLEL_MERGE_PARTITION_COUNT; ++i) {
+        _merge_partition_offsets[i + 1] += _merge_partition_offsets[i];
+    }
+    _merge_partition_rows.resize(rows);
+    std::vector<uint32_t> positions(_merge_partition_offsets.begin(),
+                                    _merge_partition_offsets.end() - 1);
+    for (size_t i = 0; i < rows; ++i) {
+        _merge_partition_rows[positions[_merge_row_partitions[i]]++] = i;
+    }
+}
+
+// Merge the deserialized states in _deserialize_buffer to _places, one partition per thread.
+// The rows of a partition are merged in their order, so the result is the same as merge_vec.
+Status AggregationNode::_parallel_merge_vec(const AggregateFunctionPtr& function, size_t offset) {
+    if (_merge_arenas.empty()) {
+        for (size_t i = 0; i < PARALLEL_MERGE_PARTITION_COUNT; ++i) {
+            _merge_arenas.emplace_back(std::make_unique<Arena>());
+        }
+    }
+
+    std::vector<size_t> partitions;
+    for (size_t p = 0; p < PARALLEL_MERGE_PARTITION_COUNT; ++p) {
+        if (_merge_partition_offsets[p + 1] > _merge_partition_offsets[p]) {
+            partitions.push_back(p);
+        }
+    }
+    std::vector<Status> statuses(PARALLEL_MERGE_PARTITION_COUNT);
+    CountDownLatch latch(partitions.size());
+    auto run_partition = [&](size_t p) {
+        statuses[p] = [&]() -> Status {
+            try {
+                RETURN_IF_CATCH_BAD_ALLOC(function->merge_vec_rows(
+                        _places.data(), offset, _deserialize_buffer.data(), _merge_arenas[p].get(),
+                        _merge_partition_rows.data() + _merge_partition_offsets[p],
+                        _merge_partition_offsets[p + 1] - _merge_partition_offsets[p]));
+            } catch (const std::exception& e) {
+                return Status::InternalError("merge {} failed: {}", function->get_name(),
+                                             e.what());
+            }
+            return Status::OK();
+        }();
+        latch.count_down();
+    };
+    auto* thread_pool = ExecEnv::GetInstance()->agg_merge_thread_pool();
+    RuntimeState* state = _runtime_state;
+    for (size_t i = 0; i < partitions.size(); ++i) {
+        size_t p = partitions[i];
+        // the aggregating thread merges the last partition itself, and the partitions which
+        // can not be submitted
+        bool submitted = false;
+        if (thread_pool != nullptr && i + 1 < partitions.size()) {
+            submitted = thread_pool
+                                ->submit_func([&, p]() {
+                                    SCOPED_ATTACH_TASK(state);
+                                    run_partition(p);
+                                })
+                                .ok();
+        }
+        if (!submitted) {
+            run_partition(p);
+        }
+    }
+    latch.wait();
+
+    for (auto& status : statuses) {
+        RETURN_IF_ERROR(status);
+    }
+    return Status::OK();
+}
+
 void AggregationNode::_close_with_serialized_key() {
     std::visit(
             [&](auto&& agg_method) -> void {
@@ -1405,6 +1705,199 @@ void AggregationNode::_close_with_serialized_key() {
     release_tracker();
 }
 
+bool AggregationNode::_should_spill() const {
+    return _external_agg_bytes_threshold > 0 &&
+           (_mem_usage_record.used_in_arena + _mem_usage_record.used_in_state >=
+                    _external_agg_bytes_threshold ||
+            (_revocable_memory && _revocable_memory->revoke_requested()));
+}
+
+// Serialize all the aggregate states in the hash table, hash partition them by the
+// group by keys, append them to the spill stream of each partition and then reset
+// the hash table. The same key may be spilled several times, these rows will be
+// merged when the partition is read back.
+Status AggregationNode::_spill_hash_table(RuntimeState* state) {
+    SCOPED_TIMER(_spill_timer);
+    if (!_is_spilled) {
+        _is_spilled = true;
+        _spill_writers.resize(SPILL_PARTITION_COUNT);
+        _spill_partition_blocks.resize(SPILL_PARTITION_COUNT);
+        for (int i = 0; i < SPILL_PARTITION_COUNT; ++i) {
+            RETURN_IF_ERROR(ExecEnv::GetInstance()->block_spill_mgr()->get_writer(
+                    state->batch_size(), _spill_writers[i], _block_spill_profile));
+        }
+    }
+
+    size_t key_size = _probe_expr_ctxs.size();
+    std::vector<uint64_t> hash_vals;
+    std::vector<IColumn::Selector> selectors(SPILL_PARTITION_COUNT);
+    bool eos = false;
+    while (!eos) {
+        Block block;
+        RETURN_IF_ERROR(_serialize_with_serialized_key_result(state, &block, &eos));
+        auto rows = block.rows();
+        if (rows == 0) {
+            continue;
+        }
+        COUNTER_UPDATE(_spill_rows, rows);
+
+        hash_vals.assign(rows, SPILL_PARTITION_HASH_SEED);
+        for (size_t i = 0; i < key_size; ++i) {
+            block.get_by_position(i).column->update_hashes_with_value(hash_vals.data());
+        }
+        for (auto& selector : selectors) {
+            selector.clear();
+        }
+        for (size_t i = 0; i < rows; ++i) {
+            selectors[hash_vals[i] % SPILL_PARTITION_COUNT].push_back(i);
+        }
+
+        for (int i = 0; i < SPILL_PARTITION_COUNT; ++i) {
+            if (selectors[i].empty()) {
+                continue;
+            }
+            if (!_spill_partition_blocks[i]) {
+                _spill_partition_blocks[i].reset(new MutableBlock(block.clone_empty()));
+            }
+            block.append_block_by_selector(_spill_partition_blocks[i].get(), selectors[i]);
+            RETURN_IF_ERROR(_spill_partition_block(i, state->batch_size()));
+        }
+    }
+    COUNTER_UPDATE(_spill_count, 1);
+    if (_revocable_memory) {
+        _revocable_memory->revoked();
+    }
+    return _reset_hash_table();
+}
+
+// Write the buffered rows of the partition to its spill stream if there are
+// at least `min_rows` rows, small partition blocks are buffered to avoid writing
+// lots of tiny blocks to disk.
+Status AggregationNode::_spill_partition_block(int partition, size_t min_rows) {
+    auto& mutable_block = _spill_partition_blocks[partition];
+    if (!mutable_block || mutable_block->rows() == 0 || mutable_block->rows() < min_rows) {
+        return Status::OK();
+    }
+    auto block = mutable_block->to_block();
+    RETURN_IF_ERROR(_spill_writers[partition]->write(block));
+    block.clear_column_data();
+    mutable_block.reset(new MutableBlock(std::move(block)));
+    return Status::OK();
+}
+
+// Called when all the input is consumed, spill the rest of hash table so all
+// the data is in the spill streams.
+Status AggregationNode::_finish_spill(RuntimeState* state) {
+    RETURN_IF_ERROR(_spill_hash_table(state));
+    for (int i = 0; i < SPILL_PARTITION_COUNT; ++i) {
+        RETURN_IF_ERROR(_spill_partition_block(i, 0));
+        _spill_streams.emplace_back(_spill_writers[i]->get_id());
+        RETURN_IF_ERROR(_spill_writers[i]->close());
+    }
+    _spill_writers.clear();
+    _spill_partition_blocks.clear();
+    return Status::OK();
+}
+
+Status AggregationNode::_reset_hash_table() {
+    _close_with_serialized_key();
+    _mem_usage_record = MemoryRecord();
+
+    _agg_data = std::make_unique<AggregatedDataVariants>();
+    _agg_data->set_enable_partitioned_hash_table(_partitioned_hash_table_enabled);
+    _init_hash_method(_probe_expr_ctxs);
+    _init_aggregate_data_container();
+    _agg_arena_pool = std::make_unique<Arena>();
+    _merge_arenas.clear();
+    return Status::OK();
+}
+
+Status AggregationNode::_load_spilled_partition(int64_t stream_id) {
+    SCOPED_TIMER(_spill_read_timer);
+    BlockSpillReaderUPtr reader;
+    RETURN_IF_ERROR(ExecEnv::GetInstance()->block_spill_mgr()->get_reader(stream_id, reader,
+                                                                          _block_spill_profile));
+    bool eos = false;
+    Block block;
+    while (!eos) {
+        RETURN_IF_ERROR(reader->read(&block, &eos));
+        if (block.rows() > 0) {
+            RETURN_IF_ERROR(_merge_spilled_block(&block));
+            _executor.update_memusage();
+        }
+    }
+    return reader->close();
+}
+
+// The spilled block is the output of `_serialize_with_serialized_key_result`:
+// group by keys followed by the serialized aggregate states.
+Status AggregationNode::_merge_spilled_block(Block* block) {
+    SCOPED_TIMER(_merge_timer);
+    size_t key_size = _probe_expr_ctxs.size();
+    ColumnRawPtrs key_columns(key_size);
+    for (size_t i = 0; i < key_size; ++i) {
+        key_columns[i] = block->get_by_position(i).column.get();
+    }
+
+    int rows = block->rows();
+    if (_places.size() < rows) {
+        _places.resize(rows);
+    }
+    RETURN_IF_CATCH_BAD_ALLOC(_emplace_into_hash_table(_places.data(), key_columns, rows));
+
+    for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
+        const auto& function = _aggregate_evaluators[i]->function();
+        auto column = block->get_by_position(key_size + i).column;
+        size_t buffer_size = function->size_of_data() * rows;
+        if (_deserialize_buffer.size() < buffer_size) {
+            _deserialize_buffer.resize(buffer_size);
+        }
+
+        {
+            SCOPED_TIMER(_deserialize_data_timer);
+            if (_use_fixed_length_serialization_opt) {
+                function->deserialize_from_column(_deserialize_buffer.data(), *column,
+                                                  _agg_arena_pool.get(), rows);
+            } else {
+                function->deserialize_vec(_deserialize_buffer.data(),
+                                          (ColumnString*)(column.get()), _agg_arena_pool.get(),
+                                          rows);
+            }
+        }
+        function->merge_vec(_places.data(), _offsets_of_aggregate_states[i],
+                            _deserialize_buffer.data(), _agg_arena_pool.get(), rows);
+        function->destroy_vec(_deserialize_buffer.data(), rows);
+    }
+    return Status::OK();
+}
+
+// Read back and aggregate the spilled partitions one by one, the result of each
+// partition is output by the normal get result function.
+Status AggregationNode::_get_spilled_result(RuntimeState* state, Block* block, bool* eos) {
+    while (!*eos) {
+        if (!_spill_partition_loaded) {
+            if (_spill_read_partition_index >= _spill_streams.size()) {
+                *eos = true;
+                break;
+            }
+            RETURN_IF_ERROR(_reset_hash_table());
+            RETURN_IF_ERROR(_load_spilled_partition(_spill_streams[_spill_read_partition_index]));
+            _spill_partition_loaded = true;
+        }
+
+        bool partition_eos = false;
+        RETURN_IF_ERROR(_executor.get_result(state, block, &partition_eos));
+        if (partition_eos) {
+            _spill_partition_loaded = false;
+            ++_spill_read_partition_index;
+        }
+        if (block->rows() > 0) {
+            break;
+        }
+    }
+    return Status::OK();
+}
+
 void AggregationNode::release_tracker() {
     mem_tracker()->release(_mem_usage_record.used_in_state + _mem_usage_record.used_in_arena);
 }
@@ -1414,6 +1907,7 @@ void AggregationNode::_release_mem() {
     _aggregate_data_container = nullptr;
     _agg_profile_arena = nullptr;
     _agg_arena_pool = nullptr;
+    _merge_arenas.clear();
     _preagg_block.clear();
 
     PODArray<AggregateDataPtr> tmp_places;
@@ -22,6 +22,7 @@
 
 #include "common/object_pool.h"
 #include "exec/exec_node.h"
+#include "runtime/block_spill_manager.h"
 #include "vec/aggregate_functions/aggregate_function.h"
 #include "vec/common/columns_hashing.h"
 #include "vec/common/hash_table/fixed_hash_map.h"
@@ -66,6 +67,13 @@ struct AggregationMethodSerialized {
 
     using State = ColumnsHashing::HashMethodSerialized<typename Data::value_type, Mapped, true>;
 
+    // StringHashMap keeps the keys of at most 24 bytes in sub tables of fixed size keys, which are
+    // hashed and compared as integers, except for the keys ending with zero. The serialized keys
+    // of integers mostly end with zero, so a non zero byte is appended to every key. The byte is
+    // ignored when the keys are deserialized.
+    static constexpr bool append_key_terminator = HashTableTraits<Data>::is_string_hash_table;
+    static constexpr char KEY_TERMINATOR = 1;
+
     template <typename Other>
     explicit AggregationMethodSerialized(const Other& other) : data(other.data) {}
 
@@ -74,7 +82,7 @@ struct AggregationMethodSerialized {
             keys.resize(num_rows);
         }
 
-        size_t max_one_row_byte_size = 0;
+        size_t max_one_row_byte_size = append_key_terminator ? 1 : 0;
         for (const auto& column : key_columns) {
             max_one_row_byte_size += column->get_max_row_byte_size();
         }
@@ -87,6 +95,10 @@ struct AggregationMethodSerialized {
             size_t keys_size = key_columns.size();
             for (size_t i = 0; i < num_rows; ++i) {
                 keys[i] = serialize_keys_to_pool_contiguous(i, keys_size, key_columns, *_arena);
+                if constexpr (append_key_terminator) {
+                    *_arena->alloc_continue(1, keys[i].data) = KEY_TERMINATOR;
+                    ++keys[i].size;
+                }
             }
             keys_memory_usage = _arena->size();
         } else {
@@ -107,6 +119,11 @@ struct AggregationMethodSerialized {
             for (const auto& column : key_columns) {
                 column->serialize_vec(keys, num_rows, max_one_row_byte_size);
             }
+            if constexpr (append_key_terminator) {
+                for (size_t i = 0; i < num_rows; ++i) {
+                    const_cast<char*>(keys[i].data)[keys[i].size++] = KEY_TERMINATOR;
+                }
+            }
             keys_memory_usage = _serialized_key_buffer_size;
         }
         return max_one_row_byte_size;
@@ -521,7 +538,8 @@ using AggregatedMethodVariants = std::variant<
         AggregationMethodKeysFixed<PartitionedAggregatedDataWithUInt128KeyPhase2, false>,
         AggregationMethodKeysFixed<PartitionedAggregatedDataWithUInt128KeyPhase2, true>,
         AggregationMethodKeysFixed<PartitionedAggregatedDataWithUInt256KeyPhase2, false>,
-        AggregationMethodKeysFixed<PartitionedAggregatedDataWithUInt256KeyPhase2, true>>;
+        AggregationMethodKeysFixed<PartitionedAggregatedDataWithUInt256KeyPhase2, true>,
+        AggregationMethodSerialized<AggregatedDataWithShortStringKey>>;
 
 struct AggregatedDataVariants {
     AggregatedDataVariants() = default;
@@ -551,6 +569,8 @@ struct AggregatedDataVariants {
         int256_keys,
         int256_keys_phase2,
         string_key,
+        // multiple columns serialized into keys which are mostly short
+        serialized_short_key,
     };
 
     Type _type = Type::EMPTY;
@@ -844,6 +864,10 @@ struct AggregatedDataVariants {
                         AggregationMethodStringNoCache<AggregatedDataWithShortStringKey>>();
             }
             break;
+        case Type::serialized_short_key:
+            _aggregated_method_variant
+                    .emplace<AggregationMethodSerialized<AggregatedDataWithShortStringKey>>();
+            break;
         default:
             DCHECK(false) << "Do not have a rigth agg data type";
         }
@@ -974,7 +998,11 @@ private:
     bool _inited = false;
 };
 
-// not support spill
+// When `external_agg_bytes_threshold` is set, the hash table of a blocking
+// aggregation (with group by keys) is spilled to disk once its memory usage
+// exceeds the threshold, grace hash style: the serialized aggregate states are
+// hash partitioned by group by keys into several spill streams, and after all the
+// input is consumed every partition is read back and re-aggregated one at a time.
 class AggregationNode final : public ::doris::ExecNode {
 public:
     using Sizes = std::vector<size_t>;
@@ -1046,8 +1074,11 @@ private:
     RuntimeProfile::Counter* _hash_table_iterate_timer;
     RuntimeProfile::Counter* _insert_keys_to_column_timer;
     RuntimeProfile::Counter* _streaming_agg_timer;
+    RuntimeProfile::Counter* _pass_through_rows_counter;
+    RuntimeProfile::Counter* _streaming_agg_bypass_counter;
     RuntimeProfile::Counter* _hash_table_size_counter;
     RuntimeProfile::Counter* _hash_table_input_counter;
+    RuntimeProfile::Counter* _hash_table_run_rows_counter;
     RuntimeProfile::Counter* _max_row_size_counter;
 
     RuntimeProfile::Counter* _hash_table_memory_usage;
@@ -1056,6 +1087,12 @@ private:
     bool _is_streaming_preagg;
     Block _preagg_block = Block();
     bool _should_expand_hash_table = true;
+    // the streaming preaggregation passes through all the rows, because the last sample of
+    // the aggregated rows was not reduced enough
+    bool _streaming_agg_bypass = false;
+    int64_t _sampled_input_rows = 0;
+    int64_t _sampled_new_groups = 0;
+    int64_t _bypass_rows = 0;
     bool _child_eos = false;
 
     bool _should_limit_output = false;
@@ -1065,9 +1102,45 @@ private:
     PODArray<AggregateDataPtr> _places;
     std::vector<char> _deserialize_buffer;
     std::vector<size_t> _hash_values;
+    // whether the keys can be checked for runs, and the rows with the keys of their previous rows
+    bool _key_runs_enabled = false;
+    PaddedPODArray<UInt8> _same_keys_as_prev;
     std::vector<AggregateDataPtr> _values;
     std::unique_ptr<AggregateDataContainer> _aggregate_data_container;
 
+    // parallel merge of aggregate states, 0 if it is not used
+    int64_t _parallel_merge_min_rows = 0;
+    RuntimeState* _runtime_state = nullptr;
+    // input blocks waiting to be merged together
+    MutableBlock _merge_buffer_block;
+    // rows of the buffered block partitioned by their groups: the rows of partition i are
+    // _merge_partition_rows[_merge_partition_offsets[i], _merge_partition_offsets[i + 1])
+    std::vector<uint32_t> _merge_partition_offsets;
+    std::vector<uint32_t> _merge_partition_rows;
+    std::vector<uint8_t> _merge_row_partitions;
+    // one for each partition, the states are merged with them
+    std::vector<ArenaUPtr> _merge_arenas;
+
+    // spill to disk
+    int64_t _external_agg_bytes_threshold = 0;
+    int _partitioned_hash_agg_rows_threshold = 0;
+    bool _is_spilled = false;
+    // one writer per partition, kept open until all input is consumed
+    std::vector<BlockSpillWriterUPtr> _spill_writers;
+    // rows of each partition waiting to be written to its spill stream
+    std::vector<std::unique_ptr<MutableBlock>> _spill_partition_blocks;
+    std::vector<int64_t> _spill_streams;
+    size_t _spill_read_partition_index = 0;
+    bool _spill_partition_loaded = false;
+    // the hash table, which the memory GC may ask to spill
+    std::unique_ptr<RevocableMemory> _revocable_memory;
+
+    RuntimeProfile* _block_spill_profile = nullptr;
+    RuntimeProfile::Counter* _spill_timer = nullptr;
+    RuntimeProfile::Counter* _spill_count = nullptr;
+    RuntimeProfile::Counter* _spill_rows = nullptr;
+    RuntimeProfile::Counter* _spill_read_timer = nullptr;
+
 private:
     void _release_self_resource(RuntimeState* state);
     /// Return true if we should keep expanding hash tables in the preagg. If false,
@@ -1091,11 +1164,31 @@ private:
     Status _get_with_serialized_key_result(RuntimeState* state, Block* block, bool* eos);
     Status _serialize_with_serialized_key_result(RuntimeState* state, Block* block, bool* eos);
     Status _pre_agg_with_serialized_key(Block* in_block, Block* out_block);
+    Status _streaming_agg_pass_through(Block* in_block, Block* out_block,
+                                       const ColumnRawPtrs& key_columns, size_t rows);
+    void _update_streaming_agg_bypass(size_t rows, size_t new_groups);
     Status _execute_with_serialized_key(Block* block);
     Status _merge_with_serialized_key(Block* block);
+    void _partition_merge_rows(size_t rows);
+    Status _parallel_merge_vec(const AggregateFunctionPtr& function, size_t offset);
+    size_t _merge_arenas_memory_usage() const;
     void _update_memusage_with_serialized_key();
     void _close_with_serialized_key();
     void _init_hash_method(std::vector<VExprContext*>& probe_exprs);
+    void _init_key_runs();
+    // Returns false if the keys are not checked for runs.
+    bool _find_key_runs(const ColumnRawPtrs& key_columns, size_t num_rows);
+    bool _use_short_serialized_key(std::vector<VExprContext*>& probe_exprs);
+    void _init_aggregate_data_container();
+
+    bool _should_spill() const;
+    Status _spill_hash_table(RuntimeState* state);
+    Status _spill_partition_block(int partition, size_t min_rows);
+    Status _finish_spill(RuntimeState* state);
+    Status _reset_hash_table();
+    Status _load_spilled_partition(int64_t stream_id);
+    Status _merge_spilled_block(Block* block);
+    Status _get_spilled_result(RuntimeState* state, Block* block, bool* eos);
 
     template <typename AggState, typename AggMethod>
     void _pre_serialize_key_if_need(AggState& state, AggMethod& agg_method,
@@ -1233,6 +1326,11 @@ private:
         } else {
             _emplace_into_hash_table(_places.data(), key_columns, rows);
 
+            bool parallel_merge = _parallel_merge_min_rows > 0 && rows >= _parallel_merge_min_rows;
+            if (parallel_merge) {
+                _partition_merge_rows(rows);
+            }
+
             for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
                 if (_aggregate_evaluators[i]->is_merge()) {
                     int col_id = _get_slot_column_id(_aggregate_evaluators[i]);
@@ -1257,9 +1355,14 @@ private:
                                 _deserialize_buffer.data(), (ColumnString*)(column.get()),
                                 _agg_arena_pool.get(), rows);
                     }
-                    _aggregate_evaluators[i]->function()->merge_vec(
-                            _places.data(), _offsets_of_aggregate_states[i],
-                            _deserialize_buffer.data(), _agg_arena_pool.get(), rows);
+                    if (parallel_merge) {
+                        RETURN_IF_ERROR(_parallel_merge_vec(_aggregate_evaluators[i]->function(),
+                                                            _offsets_of_aggregate_states[i]));
+                    } else {
+                        _aggregate_evaluators[i]->function()->merge_vec(
+                                _places.data(), _offsets_of_aggregate_states[i],
+                                _deserialize_buffer.data(), _agg_arena_pool.get(), rows);
+                    }
 
                     _aggregate_evaluators[i]->function()->destroy_vec(_deserialize_buffer.data(),
                                                                       rows);
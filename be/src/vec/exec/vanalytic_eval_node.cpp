@@ -17,12 +17,29 @@
 
 #include "vec/exec/vanalytic_eval_node.h"
 
+#include <algorithm>
+#include <unordered_set>
+
+#include "common/config.h"
+#include "runtime/block_spill_manager.h"
 #include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
 #include "runtime/runtime_state.h"
+#include "vec/core/block_spill_reader.h"
+#include "vec/core/block_spill_writer.h"
 #include "vec/exprs/vexpr.h"
 
 namespace doris::vectorized {
 
+// The functions whose merge is correct, which can be evaluated over sliding frames by
+// SlidingWindowAggregator. The window functions such as lead and first_value are not.
+static bool can_slide(const IAggregateFunction* function) {
+    static const std::unordered_set<std::string> names = {
+            "sum", "count", "avg", "min", "max", "stddev", "stddev_samp", "variance",
+            "variance_samp"};
+    return !function->allocates_memory_in_arena() && names.count(function->get_name());
+}
+
 VAnalyticEvalNode::VAnalyticEvalNode(ObjectPool* pool, const TPlanNode& tnode,
                                      const DescriptorTbl& descs)
         : ExecNode(pool, tnode, descs),
@@ -150,6 +167,14 @@ Status VAnalyticEvalNode::prepare(RuntimeState* state) {
     _evaluation_timer = ADD_TIMER(runtime_profile(), "EvaluationTime");
     SCOPED_TIMER(_evaluation_timer);
 
+    _enable_spill = state->enable_spill() && config::analytic_spill_bytes_threshold > 0;
+    if (_enable_spill) {
+        _block_spill_profile = runtime_profile()->create_child("BlockSpill", true, true);
+        runtime_profile()->add_child(_block_spill_profile, false, nullptr);
+        _spilled_block_count = ADD_COUNTER(_block_spill_profile, "BlockCount", TUnit::UNIT);
+        _spilled_block_bytes = ADD_COUNTER(_block_spill_profile, "BlockBytes", TUnit::BYTES);
+    }
+
     _intermediate_tuple_desc = state->desc_tbl().get_tuple_descriptor(_intermediate_tuple_id);
     _output_tuple_desc = state->desc_tbl().get_tuple_descriptor(_output_tuple_id);
     for (size_t i = 0; i < _agg_functions_size; ++i) {
@@ -184,6 +209,14 @@ Status VAnalyticEvalNode::prepare(RuntimeState* state) {
     _fn_place_ptr = _agg_arena_pool->aligned_alloc(_total_size_of_aggregate_states,
                                                    _align_aggregate_states);
     _create_agg_status();
+    if (_fn_scope == AnalyticFnScope::ROWS &&
+        std::all_of(_agg_functions.begin(), _agg_functions.end(),
+                    [](AggFnEvaluator* fn) { return can_slide(fn->function()); })) {
+        for (auto* agg_function : _agg_functions) {
+            _sliding_window_aggregators.emplace_back(std::make_unique<SlidingWindowAggregator>(
+                    agg_function->function(), _agg_arena_pool.get()));
+        }
+    }
     _executor.insert_result =
             std::bind<void>(&VAnalyticEvalNode::_insert_result_info, this, std::placeholders::_1);
     _executor.execute =
@@ -284,6 +317,8 @@ void VAnalyticEvalNode::release_resource(RuntimeState* state) {
     }
 
     _destroy_agg_status();
+    _sliding_window_aggregators.clear();
+    _remove_spilled_blocks();
     _release_mem();
     return ExecNode::release_resource(state);
 }
@@ -371,6 +406,11 @@ Status VAnalyticEvalNode::_get_next_for_rows(size_t current_block_rows) {
                 range_start = _current_row_position + _rows_start_offset;
             }
             range_end = _current_row_position + _rows_end_offset + 1;
+            if (!_sliding_window_aggregators.empty()) {
+                _execute_for_sliding_window(range_start, range_end);
+                _executor.insert_result(current_block_rows);
+                continue;
+            }
         }
         _executor.execute(_partition_by_start.pos, _partition_by_end.pos, range_start, range_end);
         _executor.insert_result(current_block_rows);
@@ -578,6 +618,12 @@ Status VAnalyticEvalNode::sink(doris::RuntimeState* /*state*/, vectorized::Block
     //TODO: if need improvement, the is a tips to maintain a free queue,
     //so the memory could reuse, no need to new/delete again;
     _input_blocks.emplace_back(std::move(*input_block));
+    _spilled_block_streams.emplace_back(-1);
+    // the block being output is never spilled
+    if (_enable_spill && _input_blocks.size() > _output_block_index + 1 &&
+        _blocks_memory_usage->current_value() > config::analytic_spill_bytes_threshold) {
+        RETURN_IF_ERROR(_spill_block(_input_blocks.size() - 1));
+    }
     _found_partition_end = _get_partition_by_end();
     _need_more_input = whether_need_next_partition(_found_partition_end);
     return Status::OK();
@@ -633,6 +679,9 @@ void VAnalyticEvalNode::_insert_result_info(int64_t current_block_rows) {
 }
 
 Status VAnalyticEvalNode::_output_current_block(Block* block) {
+    if (_spilled_block_streams[_output_block_index] >= 0) {
+        RETURN_IF_ERROR(_restore_spilled_block(_output_block_index));
+    }
     block->swap(std::move(_input_blocks[_output_block_index]));
     _blocks_memory_usage->add(-block->allocated_bytes());
     mem_tracker()->consume(-block->allocated_bytes());
@@ -657,6 +706,74 @@ Status VAnalyticEvalNode::_output_current_block(Block* block) {
     return Status::OK();
 }
 
+// Write the block to disk, and replace all the columns except the partition by and order by
+// columns with constant columns, so that the boundaries can still be found in memory.
+Status VAnalyticEvalNode::_spill_block(size_t block_index) {
+    Block& block = _input_blocks[block_index];
+    BlockSpillWriterUPtr writer;
+    RETURN_IF_ERROR(ExecEnv::GetInstance()->block_spill_mgr()->get_writer(block.rows(), writer,
+                                                                          _block_spill_profile));
+    RETURN_IF_ERROR(writer->write(block));
+    RETURN_IF_ERROR(writer->close());
+    _spilled_block_streams[block_index] = writer->get_id();
+    COUNTER_UPDATE(_spilled_block_count, 1);
+    COUNTER_UPDATE(_spilled_block_bytes, writer->get_written_bytes());
+
+    std::unordered_set<int64_t> key_columns(_partition_by_column_idxs.begin(),
+                                            _partition_by_column_idxs.end());
+    key_columns.insert(_ordey_by_column_idxs.begin(), _ordey_by_column_idxs.end());
+    int64_t allocated_bytes = block.allocated_bytes();
+    for (size_t i = 0; i < block.columns(); ++i) {
+        if (!key_columns.count(i)) {
+            auto& column = block.get_by_position(i);
+            column.column = column.type->create_column_const_with_default_value(block.rows());
+        }
+    }
+    int64_t released_bytes = allocated_bytes - block.allocated_bytes();
+    mem_tracker()->consume(-released_bytes);
+    _blocks_memory_usage->add(-released_bytes);
+    return Status::OK();
+}
+
+Status VAnalyticEvalNode::_restore_spilled_block(size_t block_index) {
+    BlockSpillReaderUPtr reader;
+    RETURN_IF_ERROR(ExecEnv::GetInstance()->block_spill_mgr()->get_reader(
+            _spilled_block_streams[block_index], reader, _block_spill_profile));
+    _spilled_block_streams[block_index] = -1;
+
+    Block sub_block;
+    MutableBlock mutable_block;
+    bool eos = false;
+    while (!eos) {
+        RETURN_IF_ERROR(reader->read(&sub_block, &eos));
+        if (sub_block.rows() > 0) {
+            RETURN_IF_ERROR(mutable_block.merge(sub_block));
+        }
+    }
+    Block block = mutable_block.to_block();
+    DCHECK_EQ(block.rows(), _input_blocks[block_index].rows());
+
+    int64_t restored_bytes =
+            block.allocated_bytes() - _input_blocks[block_index].allocated_bytes();
+    mem_tracker()->consume(restored_bytes);
+    _blocks_memory_usage->add(restored_bytes);
+    _input_blocks[block_index].swap(block);
+    return Status::OK();
+}
+
+void VAnalyticEvalNode::_remove_spilled_blocks() {
+    for (auto& stream_id : _spilled_block_streams) {
+        if (stream_id >= 0) {
+            // the file is deleted when the reader is closed
+            BlockSpillReaderUPtr reader;
+            static_cast<void>(ExecEnv::GetInstance()->block_spill_mgr()->get_reader(
+                    stream_id, reader, _block_spill_profile));
+            stream_id = -1;
+        }
+    }
+    _spilled_block_streams.clear();
+}
+
 //now is execute for lead/lag row_number/rank/dense_rank/ntile functions
 //sum min max count avg first_value last_value functions
 void VAnalyticEvalNode::_execute_for_win_func(int64_t partition_start, int64_t partition_end,
@@ -672,6 +789,27 @@ void VAnalyticEvalNode::_execute_for_win_func(int64_t partition_start, int64_t p
     }
 }
 
+// The frames of the rows slide forward, so only the rows entering and leaving the frame are
+// processed, instead of all the rows in the frame.
+void VAnalyticEvalNode::_execute_for_sliding_window(int64_t frame_start, int64_t frame_end) {
+    frame_start = std::min(std::max(frame_start, _partition_by_start.pos), _partition_by_end.pos);
+    frame_end = std::max(std::min(frame_end, _partition_by_end.pos), frame_start);
+    if (_sliding_window_partition_start != _partition_by_start.pos) {
+        for (auto& aggregator : _sliding_window_aggregators) {
+            aggregator->reset(_partition_by_start.pos);
+        }
+        _sliding_window_partition_start = _partition_by_start.pos;
+    }
+    for (size_t i = 0; i < _agg_functions_size; ++i) {
+        std::vector<const IColumn*> agg_columns;
+        for (int j = 0; j < _agg_intput_columns[i].size(); ++j) {
+            agg_columns.push_back(_agg_intput_columns[i][j].get());
+        }
+        _sliding_window_aggregators[i]->slide(frame_start, frame_end, agg_columns.data());
+        _sliding_window_aggregators[i]->merge_to(_fn_place_ptr + _offsets_of_aggregate_states[i]);
+    }
+}
+
 //binary search for range to calculate peer group
 void VAnalyticEvalNode::_update_order_by_range() {
     _order_by_start = _order_by_end;
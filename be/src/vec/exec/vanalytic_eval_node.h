@@ -23,6 +23,7 @@
 #include <string>
 
 #include "exec/exec_node.h"
+#include "vec/aggregate_functions/sliding_window_aggregator.h"
 #include "vec/common/arena.h"
 #include "vec/core/block.h"
 #include "vec/exprs/vectorized_agg_fn.h"
@@ -75,6 +76,7 @@ private:
     void _execute_for_win_func(int64_t partition_start, int64_t partition_end, int64_t frame_start,
                                int64_t frame_end);
 
+    void _execute_for_sliding_window(int64_t frame_start, int64_t frame_end);
     Status _reset_agg_status();
     Status _init_result_columns();
     Status _create_agg_status();
@@ -86,6 +88,9 @@ private:
     bool _init_next_partition(BlockRowPos found_partition_end);
     void _insert_result_info(int64_t current_block_rows);
     Status _output_current_block(Block* block);
+    Status _spill_block(size_t block_index);
+    Status _restore_spilled_block(size_t block_index);
+    void _remove_spilled_blocks();
     BlockRowPos _get_partition_by_end();
     BlockRowPos _compare_row_to_find_end(int idx, BlockRowPos start, BlockRowPos end,
                                          bool need_check_first = false);
@@ -151,6 +156,10 @@ private:
     size_t _align_aggregate_states = 1;
     std::unique_ptr<Arena> _agg_arena_pool;
     AggregateDataPtr _fn_place_ptr;
+    // Not empty if the ROWS frames are evaluated incrementally, one for each function.
+    std::vector<std::unique_ptr<SlidingWindowAggregator>> _sliding_window_aggregators;
+    // the partition which _sliding_window_aggregators are sliding over
+    int64_t _sliding_window_partition_start = -1;
 
     TTupleId _buffered_tuple_id = 0;
     TupleId _intermediate_tuple_id;
@@ -164,6 +173,15 @@ private:
     RuntimeProfile::Counter* _evaluation_timer;
     RuntimeProfile::HighWaterMarkCounter* _blocks_memory_usage;
 
+    bool _enable_spill = false;
+    // The stream ids of the spilled blocks in _input_blocks, -1 if the block is in memory.
+    // Only the partition by and order by columns of a spilled block are kept in memory, the
+    // other columns are constant placeholders until the block is read back to be output.
+    std::vector<int64_t> _spilled_block_streams;
+    RuntimeProfile* _block_spill_profile = nullptr;
+    RuntimeProfile::Counter* _spilled_block_count = nullptr;
+    RuntimeProfile::Counter* _spilled_block_bytes = nullptr;
+
     std::vector<bool> _change_to_nullable_flags;
 };
 } // namespace doris::vectorized
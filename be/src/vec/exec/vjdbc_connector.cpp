@@ -206,6 +206,11 @@ Status JdbcConnector::_check_column_type() {
     RETURN_IF_ERROR(JniUtil::GetJNIEnv(&env));
     jobject type_lists =
             env->CallNonvirtualObjectMethod(_executor_obj, _executor_clazz, _executor_get_types_id);
+    // the columns of a block have the same rows
+    jint num_rows =
+            env->CallNonvirtualIntMethod(_executor_obj, _executor_clazz, _executor_block_rows_id);
+    RETURN_IF_ERROR(JniUtil::GetJniExceptionMsg(env));
+
     auto column_size = _tuple_desc->slots().size();
     for (int column_index = 0, materialized_column_index = 0; column_index < column_size;
          ++column_index) {
@@ -369,6 +374,11 @@ Status JdbcConnector::get_next(bool* eos, std::vector<MutableColumnPtr>& columns
 
     RETURN_IF_ERROR(JniUtil::GetJniExceptionMsg(env));
 
+    // the columns of a block have the same rows
+    jint num_rows =
+            env->CallNonvirtualIntMethod(_executor_obj, _executor_clazz, _executor_block_rows_id);
+    RETURN_IF_ERROR(JniUtil::GetJniExceptionMsg(env));
+
     auto column_size = _tuple_desc->slots().size();
     for (int column_index = 0, materialized_column_index = 0; column_index < column_size;
          ++column_index) {
@@ -379,8 +389,6 @@ Status JdbcConnector::get_next(bool* eos, std::vector<MutableColumnPtr>& columns
         }
         jobject column_data =
                 env->CallObjectMethod(block_obj, _executor_get_list_id, materialized_column_index);
-        jint num_rows = env->CallNonvirtualIntMethod(_executor_obj, _executor_clazz,
-                                                     _executor_block_rows_id);
         RETURN_IF_ERROR(_convert_batch_result_set(
                 env, column_data, slot_desc, columns[column_index].get(), num_rows, column_index));
         env->DeleteLocalRef(column_data);
@@ -20,6 +20,7 @@
 #include "gutil/strings/join.h"
 #include "runtime/runtime_state.h"
 #include "util/runtime_profile.h"
+#include "vec/columns/column_nullable.h"
 #include "vec/exprs/vexpr.h"
 
 namespace doris::vectorized {
@@ -82,16 +83,12 @@ Status VRepeatNode::get_repeated_block(Block* child_block, int repeat_id_idx, Bl
 
     size_t child_column_size = child_block->columns();
     size_t column_size = _output_slots.size();
-    bool mem_reuse = output_block->mem_reuse();
+    size_t rows = child_block->rows();
     DCHECK_LT(child_column_size, column_size);
-    std::vector<vectorized::MutableColumnPtr> columns(column_size);
-    for (size_t i = 0; i < column_size; i++) {
-        if (mem_reuse) {
-            columns[i] = std::move(*output_block->get_by_position(i).column).mutate();
-        } else {
-            columns[i] = _output_slots[i]->get_empty_mutable_column();
-        }
-    }
+    // The columns of the child are shared by the output blocks of all the repeats instead of
+    // copied for each one, and the slots set to null and the grouping ids are const columns.
+    ColumnsWithTypeAndName columns;
+    columns.reserve(column_size);
 
     /* Fill all slots according to child, for example:select tc1,tc2,sum(tc3) from t1 group by grouping sets((tc1),(tc2));
      * insert into t1 values(1,2,1),(1,3,1),(2,1,1),(3,1,1);
@@ -99,72 +96,44 @@ Status VRepeatNode::get_repeated_block(Block* child_block, int repeat_id_idx, Bl
      * child_block 1,2,1 | 1,3,1 | 2,1,1 | 3,1,1
      * output_block 1,null,1,1 | 1,null,1,1 | 2,nul,1,1 | 3,null,1,1
      */
-    size_t cur_col = 0;
+    const std::set<SlotId>& repeat_ids = _slot_id_set_list[repeat_id_idx];
     for (size_t i = 0; i < child_column_size; i++) {
         const ColumnWithTypeAndName& src_column = child_block->get_by_position(i);
-
-        std::set<SlotId>& repeat_ids = _slot_id_set_list[repeat_id_idx];
-        bool is_repeat_slot =
-                _all_slot_ids.find(_output_slots[cur_col]->id()) != _all_slot_ids.end();
-        bool is_set_null_slot = repeat_ids.find(_output_slots[cur_col]->id()) == repeat_ids.end();
-        const auto row_size = src_column.column->size();
-
-        if (is_repeat_slot) {
-            DCHECK(_output_slots[cur_col]->is_nullable());
-            auto* nullable_column = reinterpret_cast<ColumnNullable*>(columns[cur_col].get());
-            auto& null_map = nullable_column->get_null_map_data();
-            auto* column_ptr = columns[cur_col].get();
-
+        const SlotDescriptor* slot_desc = _output_slots[i];
+        bool is_repeat_slot = _all_slot_ids.find(slot_desc->id()) != _all_slot_ids.end();
+        bool is_set_null_slot = repeat_ids.find(slot_desc->id()) == repeat_ids.end();
+
+        ColumnPtr column;
+        if (!is_repeat_slot) {
+            column = src_column.column;
+        } else if (is_set_null_slot) {
             // set slot null not in repeat_ids
-            if (is_set_null_slot) {
-                nullable_column->resize(row_size);
-                memset(nullable_column->get_null_map_data().data(), 1, sizeof(UInt8) * row_size);
-            } else {
-                if (!src_column.type->is_nullable()) {
-                    for (size_t j = 0; j < row_size; ++j) {
-                        null_map.push_back(0);
-                    }
-                    column_ptr = &nullable_column->get_nested_column();
-                }
-                column_ptr->insert_range_from(*src_column.column, 0, row_size);
-            }
+            DCHECK(slot_desc->is_nullable());
+            column = slot_desc->get_data_type_ptr()->create_column_const_with_default_value(rows);
         } else {
-            columns[cur_col]->insert_range_from(*src_column.column, 0, row_size);
+            DCHECK(slot_desc->is_nullable());
+            column = make_nullable(src_column.column);
         }
-        cur_col++;
+        columns.emplace_back(std::move(column), slot_desc->get_data_type_ptr(),
+                             slot_desc->col_name());
     }
 
     // Fill grouping ID to block
     for (auto slot_idx = 0; slot_idx < _grouping_list.size(); slot_idx++) {
+        size_t cur_col = child_column_size + slot_idx;
         DCHECK_LT(slot_idx, _output_tuple_desc->slots().size());
         const SlotDescriptor* _virtual_slot_desc = _output_tuple_desc->slots()[cur_col];
         DCHECK_EQ(_virtual_slot_desc->type().type, _output_slots[cur_col]->type().type);
         DCHECK_EQ(_virtual_slot_desc->col_name(), _output_slots[cur_col]->col_name());
-        int64_t val = _grouping_list[slot_idx][repeat_id_idx];
-        auto* column_ptr = columns[cur_col].get();
         DCHECK(!_output_slots[cur_col]->is_nullable());
-
-        auto* col = assert_cast<ColumnVector<Int64>*>(column_ptr);
-        for (size_t i = 0; i < child_block->rows(); ++i) {
-            col->insert_value(val);
-        }
-        cur_col++;
+        int64_t val = _grouping_list[slot_idx][repeat_id_idx];
+        const auto& type = _output_slots[cur_col]->get_data_type_ptr();
+        columns.emplace_back(type->create_column_const(rows, Field(val)), type,
+                             _output_slots[cur_col]->col_name());
     }
 
-    DCHECK_EQ(cur_col, column_size);
-
-    if (!columns.empty() && !columns[0]->empty()) {
-        auto n_columns = 0;
-        if (!mem_reuse) {
-            for (const auto slot_desc : _output_slots) {
-                output_block->insert(ColumnWithTypeAndName(std::move(columns[n_columns++]),
-                                                           slot_desc->get_data_type_ptr(),
-                                                           slot_desc->col_name()));
-            }
-        } else {
-            columns.clear();
-        }
-    }
+    DCHECK_EQ(columns.size(), column_size);
+    output_block->swap(Block(columns));
     return Status::OK();
 }
 
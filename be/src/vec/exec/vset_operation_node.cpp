@@ -17,20 +17,31 @@
 
 #include "vec/exec/vset_operation_node.h"
 
+#include <future>
+
+#include "common/config.h"
+#include "runtime/exec_env.h"
+#include "runtime/thread_context.h"
+#include "util/countdown_latch.h"
 #include "util/defer_op.h"
+#include "util/threadpool.h"
 #include "vec/exprs/vexpr.h"
 namespace doris {
 namespace vectorized {
 
+static constexpr int PREFETCH_STEP = HashJoinNode::PREFETCH_STEP;
+
 //build hash table for operation node, intersect/except node
 template <class HashTableContext, bool is_intersect>
 struct HashTableBuild {
     HashTableBuild(int rows, ColumnRawPtrs& build_raw_ptrs,
-                   VSetOperationNode<is_intersect>* operation_node, uint8_t offset)
+                   VSetOperationNode<is_intersect>* operation_node, uint8_t offset,
+                   RuntimeState* state)
             : _rows(rows),
               _offset(offset),
               _build_raw_ptrs(build_raw_ptrs),
-              _operation_node(operation_node) {}
+              _operation_node(operation_node),
+              _state(state) {}
 
     Status operator()(HashTableContext& hash_table_ctx) {
         using KeyGetter = typename HashTableContext::State;
@@ -49,6 +60,12 @@ struct HashTableBuild {
             key_getter.set_serialized_keys(hash_table_ctx.keys.data());
         }
 
+        if (config::set_operation_parallel_build_min_rows > 0 &&
+            _rows >= config::set_operation_parallel_build_min_rows) {
+            RETURN_IF_CATCH_BAD_ALLOC(hash_table_ctx.hash_table.partition());
+            return _parallel_emplace(hash_table_ctx, key_getter);
+        }
+
         for (size_t k = 0; k < _rows; ++k) {
             auto emplace_result = key_getter.emplace_key(hash_table_ctx.hash_table, k,
                                                          *(_operation_node->_arena));
@@ -65,10 +82,114 @@ struct HashTableBuild {
     }
 
 private:
+    // Radix partition the rows by the sub tables of their keys, then fill the sub tables in
+    // parallel like the build of HashJoinNode. A sub table is only touched by one thread and only
+    // allocates from its own arena. The rows of a sub table are inserted in their order, so the
+    // first row of a key is kept as in the serial build.
+    template <typename KeyGetter>
+    Status _parallel_emplace(HashTableContext& hash_table_ctx, KeyGetter& key_getter) {
+        using Mapped = typename HashTableContext::Mapped;
+        using HashTable = typename HashTableContext::HashTable;
+        constexpr size_t num_partitions = HashTable::num_sub_tables();
+
+        auto& arena = *(_operation_node->_arena);
+        std::vector<size_t> hash_values(_rows);
+        for (size_t k = 0; k < _rows; ++k) {
+            if constexpr (ColumnsHashing::IsPreSerializedKeysHashMethodTraits<KeyGetter>::value) {
+                hash_values[k] =
+                        hash_table_ctx.hash_table.hash(key_getter.get_key_holder(k, arena).key);
+            } else {
+                hash_values[k] =
+                        hash_table_ctx.hash_table.hash(key_getter.get_key_holder(k, arena));
+            }
+        }
+
+        std::vector<uint32_t> partition_offsets(num_partitions + 1, 0);
+        for (size_t k = 0; k < _rows; ++k) {
+            ++partition_offsets[HashTable::get_sub_table_from_hash(hash_values[k]) + 1];
+        }
+        for (size_t i = 0; i < num_partitions; ++i) {
+            partition_offsets[i + 1] += partition_offsets[i];
+        }
+        std::vector<uint32_t> partition_rows(_rows);
+        {
+            std::vector<uint32_t> positions(partition_offsets.begin(), partition_offsets.end());
+            for (size_t k = 0; k < _rows; ++k) {
+                partition_rows[positions[HashTable::get_sub_table_from_hash(hash_values[k])]++] = k;
+            }
+        }
+
+        auto& arenas = _operation_node->_partition_arenas;
+        if (arenas.empty()) {
+            for (size_t i = 0; i < num_partitions; ++i) {
+                arenas.emplace_back(std::make_unique<Arena>());
+            }
+        }
+
+        auto build_partition = [&](size_t p) {
+            auto& sub_table = hash_table_ctx.hash_table.get_sub_table(p);
+            auto& sub_arena = *arenas[p];
+            const uint32_t end = partition_offsets[p + 1];
+            for (uint32_t i = partition_offsets[p]; i < end; ++i) {
+                uint32_t k = partition_rows[i];
+                auto emplace_result =
+                        key_getter.emplace_key(sub_table, hash_values[k], k, sub_arena);
+                if (i + PREFETCH_STEP < end) {
+                    key_getter.template prefetch_by_hash<false>(
+                            sub_table, hash_values[partition_rows[i + PREFETCH_STEP]]);
+                }
+                if (emplace_result.is_inserted()) {
+                    new (&emplace_result.get_mapped()) Mapped({k, _offset});
+                }
+            }
+        };
+
+        std::vector<size_t> partitions;
+        for (size_t p = 0; p < num_partitions; ++p) {
+            if (partition_offsets[p + 1] > partition_offsets[p]) {
+                partitions.push_back(p);
+            }
+        }
+        std::vector<Status> statuses(num_partitions);
+        CountDownLatch latch(partitions.size());
+        auto run_partition = [&](size_t p) {
+            statuses[p] = [&]() -> Status {
+                RETURN_IF_CATCH_BAD_ALLOC(build_partition(p));
+                return Status::OK();
+            }();
+            latch.count_down();
+        };
+        auto* thread_pool = ExecEnv::GetInstance()->hash_join_build_thread_pool();
+        for (size_t i = 0; i < partitions.size(); ++i) {
+            size_t p = partitions[i];
+            // the building thread fills the last partition itself, and the partitions which
+            // can not be submitted
+            bool submitted = false;
+            if (thread_pool != nullptr && i + 1 < partitions.size()) {
+                submitted = thread_pool
+                                    ->submit_func([&, p]() {
+                                        SCOPED_ATTACH_TASK(_state);
+                                        run_partition(p);
+                                    })
+                                    .ok();
+            }
+            if (!submitted) {
+                run_partition(p);
+            }
+        }
+        latch.wait();
+
+        for (size_t p = 0; p < num_partitions; ++p) {
+            RETURN_IF_ERROR(statuses[p]);
+        }
+        return Status::OK();
+    }
+
     const int _rows;
     const uint8_t _offset;
     ColumnRawPtrs& _build_raw_ptrs;
     VSetOperationNode<is_intersect>* _operation_node;
+    RuntimeState* _state;
 };
 
 template <class HashTableContext, bool is_intersected>
@@ -195,15 +316,43 @@ Status VSetOperationNode<is_intersect>::open(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
     RETURN_IF_ERROR(ExecNode::open(state));
 
-    // TODO: build the hash table in a thread to open other children asynchronously.
-    RETURN_IF_ERROR(hash_table_build(state));
-    bool eos = false;
-    Status st = Status::OK();
+    // Open the probe children in parallel with the build so that they may perform any
+    // initialisation meanwhile, e.g. their scanners start reading. The children which can not be
+    // opened in the pool are opened when probed.
+    std::vector<std::promise<Status>> open_statuses(_children.size());
+    std::vector<bool> opening(_children.size(), false);
     for (int i = 1; i < _children.size(); ++i) {
-        RETURN_IF_ERROR(child(i)->open(state));
+        opening[i] = state->exec_env()
+                             ->join_node_thread_pool()
+                             ->submit_func([this, state, i, status = &open_statuses[i],
+                                            parent_span = opentelemetry::trace::Tracer::
+                                                    GetCurrentSpan()] {
+                                 OpentelemetryScope scope {parent_span};
+                                 SCOPED_ATTACH_TASK(state);
+                                 status->set_value(child(i)->open(state));
+                             })
+                             .ok();
+    }
+    // wait for the children being opened even on error, since they use `open_statuses`
+    Status st = hash_table_build(state);
+    for (int i = 1; i < _children.size(); ++i) {
+        if (opening[i]) {
+            auto open_status = open_statuses[i].get_future().get();
+            if (st.ok()) {
+                st = open_status;
+            }
+        }
+    }
+    RETURN_IF_ERROR(st);
+
+    bool eos = false;
+    for (int i = 1; i < _children.size() && !_result_empty; ++i) {
+        if (!opening[i]) {
+            RETURN_IF_ERROR(child(i)->open(state));
+        }
         eos = false;
 
-        while (!eos) {
+        while (!eos && !_result_empty) {
             release_block_memory(_probe_block, i);
             RETURN_IF_CANCELLED(state);
             RETURN_IF_ERROR_AND_CHECK_SPAN(
@@ -237,6 +386,8 @@ Status VSetOperationNode<is_intersect>::prepare(RuntimeState* state) {
     _build_timer = ADD_TIMER(runtime_profile(), "BuildTime");
     _probe_timer = ADD_TIMER(runtime_profile(), "ProbeTime");
     _pull_timer = ADD_TIMER(runtime_profile(), "PullTime");
+    _skipped_probe_rows_counter =
+            ADD_COUNTER(runtime_profile(), "ProbeRowsSkippedForEmptyResult", TUnit::UNIT);
 
     // Prepare result expr lists.
     vector<bool> nullable_flags;
@@ -351,7 +502,7 @@ void VSetOperationNode<is_intersect>::hash_table_init() {
 }
 
 template <bool is_intersect>
-Status VSetOperationNode<is_intersect>::sink(RuntimeState*, Block* block, bool eos) {
+Status VSetOperationNode<is_intersect>::sink(RuntimeState* state, Block* block, bool eos) {
     constexpr static auto BUILD_BLOCK_MAX_SIZE = 4 * 1024UL * 1024UL * 1024UL;
 
     if (block->rows() != 0) {
@@ -361,7 +512,8 @@ Status VSetOperationNode<is_intersect>::sink(RuntimeState*, Block* block, bool e
 
     if (eos || _mutable_block.allocated_bytes() >= BUILD_BLOCK_MAX_SIZE) {
         _build_blocks.emplace_back(_mutable_block.to_block());
-        RETURN_IF_ERROR(process_build_block(_build_blocks[_build_block_index], _build_block_index));
+        RETURN_IF_ERROR(process_build_block(state, _build_blocks[_build_block_index],
+                                            _build_block_index));
         _mutable_block.clear();
         ++_build_block_index;
 
@@ -379,6 +531,9 @@ Status VSetOperationNode<is_intersect>::sink(RuntimeState*, Block* block, bool e
                         *_hash_table_variants);
             }
             _build_finished = true;
+            if (hash_table_size() == 0) {
+                set_result_empty();
+            }
         }
     }
     return Status::OK();
@@ -427,14 +582,15 @@ Status VSetOperationNode<is_intersect>::hash_table_build(RuntimeState* state) {
         if (eos) {
             child(0)->close(state);
         }
-        sink(state, &block, eos);
+        RETURN_IF_ERROR(sink(state, &block, eos));
     }
 
     return Status::OK();
 }
 
 template <bool is_intersect>
-Status VSetOperationNode<is_intersect>::process_build_block(Block& block, uint8_t offset) {
+Status VSetOperationNode<is_intersect>::process_build_block(RuntimeState* state, Block& block,
+                                                             uint8_t offset) {
     size_t rows = block.rows();
     if (rows == 0) {
         return Status::OK();
@@ -444,20 +600,18 @@ Status VSetOperationNode<is_intersect>::process_build_block(Block& block, uint8_
     ColumnRawPtrs raw_ptrs(_child_expr_lists[0].size());
     RETURN_IF_ERROR(extract_build_column(block, raw_ptrs));
 
-    std::visit(
-            [&](auto&& arg) {
+    return std::visit(
+            [&](auto&& arg) -> Status {
                 using HashTableCtxType = std::decay_t<decltype(arg)>;
                 if constexpr (!std::is_same_v<HashTableCtxType, std::monostate>) {
                     HashTableBuild<HashTableCtxType, is_intersect> hash_table_build_process(
-                            rows, raw_ptrs, this, offset);
-                    hash_table_build_process(arg);
+                            rows, raw_ptrs, this, offset, state);
+                    return hash_table_build_process(arg);
                 } else {
                     LOG(FATAL) << "FATAL: uninited hash table";
                 }
             },
             *_hash_table_variants);
-
-    return Status::OK();
 }
 
 template <bool is_intersect>
@@ -488,7 +642,10 @@ Status VSetOperationNode<is_intersect>::sink_probe(RuntimeState* state, int chil
                 << fmt::format("child with id: {} should be probed first", child_id);
     }
     auto probe_rows = block->rows();
-    if (probe_rows > 0) {
+    if (_result_empty) {
+        // the rows are only drained
+        COUNTER_UPDATE(_skipped_probe_rows_counter, probe_rows);
+    } else if (probe_rows > 0) {
         RETURN_IF_ERROR(extract_probe_column(*block, _probe_columns, child_id));
         RETURN_IF_ERROR(std::visit(
                 [&](auto&& arg) -> Status {
@@ -502,6 +659,10 @@ Status VSetOperationNode<is_intersect>::sink_probe(RuntimeState* state, int chil
                     }
                 },
                 *_hash_table_variants));
+        // every row of the hash table is found by EXCEPT
+        if (!is_intersect && _valid_element_in_hash_tbl == 0) {
+            set_result_empty();
+        }
     }
 
     return eos ? finalize_probe(state, child_id) : Status::OK();
@@ -509,6 +670,15 @@ Status VSetOperationNode<is_intersect>::sink_probe(RuntimeState* state, int chil
 
 template <bool is_intersect>
 Status VSetOperationNode<is_intersect>::finalize_probe(RuntimeState* /*state*/, int child_id) {
+    // no row of the hash table is found by INTERSECT
+    if (is_intersect && !_result_empty && _valid_element_in_hash_tbl == 0) {
+        set_result_empty();
+    }
+    if (_result_empty) {
+        // the hash table is left as it is for the rows being pulled
+        _probe_finished_children_index[child_id] = true;
+        return Status::OK();
+    }
     if (child_id != (_children.size() - 1)) {
         refresh_hash_table();
         if constexpr (is_intersect) {
@@ -531,6 +701,28 @@ Status VSetOperationNode<is_intersect>::finalize_probe(RuntimeState* /*state*/,
     return Status::OK();
 }
 
+template <bool is_intersect>
+size_t VSetOperationNode<is_intersect>::hash_table_size() {
+    return std::visit(
+            [&](auto&& arg) -> size_t {
+                using HashTableCtxType = std::decay_t<decltype(arg)>;
+                if constexpr (!std::is_same_v<HashTableCtxType, std::monostate>) {
+                    return arg.hash_table.size();
+                } else {
+                    return 0;
+                }
+            },
+            *_hash_table_variants);
+}
+
+template <bool is_intersect>
+void VSetOperationNode<is_intersect>::set_result_empty() {
+    // the rows left in the hash table are not in the result: the visited ones by EXCEPT and the
+    // ones not visited by INTERSECT
+    _result_empty = true;
+    _can_read = true;
+}
+
 template <bool is_intersect>
 bool VSetOperationNode<is_intersect>::is_child_finished(int child_id) const {
     if (child_id == 0) {
@@ -632,6 +824,7 @@ template <bool is_intersect>
 void VSetOperationNode<is_intersect>::release_mem() {
     _hash_table_variants = nullptr;
     _arena = nullptr;
+    _partition_arenas.clear();
 
     std::vector<Block> tmp_build_blocks;
     _build_blocks.swap(tmp_build_blocks);
@@ -60,10 +60,13 @@ private:
     //It's time to abstract out the same methods and provide them directly to others;
     void hash_table_init();
     Status hash_table_build(RuntimeState* state);
-    Status process_build_block(Block& block, uint8_t offset);
+    Status process_build_block(RuntimeState* state, Block& block, uint8_t offset);
     Status extract_build_column(Block& block, ColumnRawPtrs& raw_ptrs);
     Status extract_probe_column(Block& block, ColumnRawPtrs& raw_ptrs, int child_id);
     void refresh_hash_table();
+    size_t hash_table_size();
+    // Called when the result is known to be empty, the rest of the probe children are not read.
+    void set_result_empty();
 
     template <typename HashTableContext>
     Status get_data_in_hashtable(HashTableContext& hash_table_ctx, Block* output_block,
@@ -81,6 +84,8 @@ private:
     std::vector<bool> _build_not_ignore_null;
 
     std::unique_ptr<Arena> _arena;
+    // the arenas of the sub tables filled in parallel
+    std::vector<std::unique_ptr<Arena>> _partition_arenas;
     //record element size in hashtable
     int64_t _valid_element_in_hash_tbl;
 
@@ -103,10 +108,13 @@ private:
     int _build_block_index;
     bool _build_finished;
     std::vector<bool> _probe_finished_children_index;
+    // no row is in the hash table, or no row is left by INTERSECT or EXCEPT
+    bool _result_empty = false;
     MutableBlock _mutable_block;
     RuntimeProfile::Counter* _build_timer; // time to build hash table
     RuntimeProfile::Counter* _probe_timer; // time to probe
     RuntimeProfile::Counter* _pull_timer;  // time to pull data
+    RuntimeProfile::Counter* _skipped_probe_rows_counter = nullptr;
 
     template <class HashTableContext, bool is_intersected>
     friend struct HashTableBuild;
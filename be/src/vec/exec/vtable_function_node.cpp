@@ -177,6 +177,9 @@ Status VTableFunctionNode::_get_expanded_block(RuntimeState* state, Block* outpu
                 if (_cur_child_offset == -1) {
                     break;
                 }
+                if (_fn_num == 1 && _expand_child_rows(columns, state->batch_size())) {
+                    continue;
+                }
             } else if (idx < _fn_num && idx != -1) {
                 // some of table functions' results are exhausted.
                 if (!_roll_table_functions(idx)) {
@@ -252,6 +255,34 @@ Status VTableFunctionNode::_process_next_child_row() {
     return Status::OK();
 }
 
+bool VTableFunctionNode::_expand_child_rows(std::vector<MutableColumnPtr>& columns,
+                                            size_t batch_size) {
+    auto& fn_column = columns[_child_slots.size()];
+    if (fn_column->size() >= batch_size) {
+        return false;
+    }
+    _result_ends.clear();
+    size_t num_rows =
+            _fns[0]->get_values_of_rows(_cur_child_offset, _child_block.rows(),
+                                        batch_size - fn_column->size(), fn_column, &_result_ends);
+    if (num_rows == 0) {
+        return false;
+    }
+
+    _replicate_indices.clear();
+    for (size_t i = 0; i < num_rows; ++i) {
+        _replicate_indices.resize(_result_ends[i], _cur_child_offset + i);
+    }
+    for (auto index : _output_slot_indexs) {
+        columns[index]->insert_indices_from(*_child_block.get_by_position(index).column,
+                                            _replicate_indices.data(),
+                                            _replicate_indices.data() + _replicate_indices.size());
+    }
+    // the function is eos, so the next child row is processed then
+    _cur_child_offset += num_rows - 1;
+    return true;
+}
+
 // Returns the index of fn of the last eos counted from back to front
 // eg: there are 3 functions in `_fns`
 //      eos:    false, true, true
@@ -82,6 +82,10 @@ private:
 
     Status _process_next_child_row();
 
+    // Appends the results of the child rows from the current one at once, if the only table
+    // function can, and moves to the last row appended. Returns false if no row is appended.
+    bool _expand_child_rows(std::vector<MutableColumnPtr>& columns, size_t batch_size);
+
     /*  Now the output tuples for table function node is base_table_tuple + tf1 + tf2 + ...
         But not all slots are used, the real used slots are inside table_function_node.outputSlotIds.
         For case like explode_bitmap:
@@ -116,6 +120,9 @@ private:
         _current_row_insert_times = 0;
     }
     int _current_row_insert_times = 0;
+    // the ends of the results of the child rows expanded at once, and the child row of each result
+    IColumn::Offsets _result_ends;
+    std::vector<int> _replicate_indices;
 
     Block _child_block;
     std::vector<SlotDescriptor*> _child_slots;
@@ -64,6 +64,16 @@ public:
         return i;
     }
 
+    // Appends the whole results of as many rows from start_row of the block given to
+    // process_init() as fit in max_results to column at once, and the end of the results of each
+    // row to result_ends, e.g. the outer columns are replicated by them. start_row must be the
+    // current row, and it's eos afterwards if any row is appended. Returns the number of the rows
+    // appended, 0 if the function can't, then the rows are processed one by one.
+    virtual size_t get_values_of_rows(size_t start_row, size_t end_row, size_t max_results,
+                                      MutableColumnPtr& column, IColumn::Offsets* result_ends) {
+        return 0;
+    }
+
     virtual Status close() { return Status::OK(); }
 
     virtual Status forward(int step = 1) {
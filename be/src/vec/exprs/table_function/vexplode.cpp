@@ -74,4 +74,74 @@ void VExplodeTableFunction::get_value(MutableColumnPtr& column) {
     }
 }
 
+size_t VExplodeTableFunction::get_values_of_rows(size_t start_row, size_t end_row,
+                                                 size_t max_results, MutableColumnPtr& column,
+                                                 IColumn::Offsets* result_ends) {
+    if (!_is_nullable && _detail.nested_nullmap_data != nullptr) {
+        // the null elements are inserted as defaults one by one
+        return 0;
+    }
+    IColumn* nested_column = column.get();
+    NullMap* null_map = nullptr;
+    if (_is_nullable) {
+        auto* nullable_column = assert_cast<ColumnNullable*>(column.get());
+        nested_column = &nullable_column->get_nested_column();
+        null_map = &nullable_column->get_null_map_data();
+    }
+
+    // the elements of the consecutive arrays are appended as one range
+    size_t range_start = 0;
+    size_t range_end = 0;
+    auto append_range = [&]() {
+        size_t length = range_end - range_start;
+        if (length == 0) {
+            return;
+        }
+        nested_column->insert_range_from(*_detail.nested_col, range_start, length);
+        if (null_map != nullptr) {
+            if (_detail.nested_nullmap_data != nullptr) {
+                null_map->insert(_detail.nested_nullmap_data + range_start,
+                                 _detail.nested_nullmap_data + range_end);
+            } else {
+                null_map->resize_fill(null_map->size() + length, 0);
+            }
+        }
+        range_start = range_end;
+    };
+
+    const auto& offsets = *_detail.offsets_ptr;
+    size_t num_results = 0;
+    size_t row = start_row;
+    for (; row < end_row; ++row) {
+        size_t begin = offsets[row - 1];
+        size_t size = 0;
+        if (!_detail.array_nullmap_data || !_detail.array_nullmap_data[row]) {
+            size = offsets[row] - begin;
+        }
+        // an empty row of an outer function has a default result
+        if (num_results + std::max<size_t>(size, _is_outer) > max_results) {
+            break;
+        }
+        if (size > 0) {
+            if (begin != range_end) {
+                append_range();
+                range_start = begin;
+            }
+            range_end = begin + size;
+            num_results += size;
+        } else if (_is_outer) {
+            append_range();
+            column->insert_default();
+            ++num_results;
+        }
+        result_ends->push_back(num_results);
+    }
+    append_range();
+
+    if (row > start_row) {
+        _eos = true;
+    }
+    return row - start_row;
+}
+
 } // namespace doris::vectorized
@@ -36,6 +36,8 @@ public:
     Status process_row(size_t row_idx) override;
     Status process_close() override;
     void get_value(MutableColumnPtr& column) override;
+    size_t get_values_of_rows(size_t start_row, size_t end_row, size_t max_results,
+                              MutableColumnPtr& column, IColumn::Offsets* result_ends) override;
 
 private:
     ColumnPtr _array_column;
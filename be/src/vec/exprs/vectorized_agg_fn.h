@@ -80,6 +80,10 @@ public:
     static std::string debug_string(const std::vector<AggFnEvaluator*>& exprs);
     std::string debug_string() const;
     bool is_merge() const { return _is_merge; }
+    bool is_udaf() const {
+        return _fn.binary_type == TFunctionBinaryType::JAVA_UDF ||
+               _fn.binary_type == TFunctionBinaryType::RPC;
+    }
     const std::vector<VExprContext*>& input_exprs_ctxs() const { return _input_exprs_ctxs; }
 
 private:
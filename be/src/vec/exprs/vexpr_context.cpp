@@ -17,9 +17,12 @@
 
 #include "vec/exprs/vexpr_context.h"
 
+#include "common/config.h"
 #include "udf/udf.h"
 #include "util/stack_util.h"
 #include "vec/exprs/vexpr.h"
+#include "vec/exprs/vfused_expr.h"
+#include "vec/exprs/vmulti_match_predicate.h"
 
 namespace doris::vectorized {
 VExprContext::VExprContext(VExpr* expr)
@@ -50,7 +53,14 @@ doris::Status VExprContext::execute(doris::vectorized::Block* block, int* result
 doris::Status VExprContext::prepare(doris::RuntimeState* state,
                                     const doris::RowDescriptor& row_desc) {
     _prepared = true;
-    return _root->prepare(state, row_desc, this);
+    RETURN_IF_ERROR(_root->prepare(state, row_desc, this));
+    if (config::enable_multi_match_predicate) {
+        _root = VMultiMatchPredicate::rewrite(state, _root);
+    }
+    if (config::enable_fused_expr) {
+        _root = VFusedExpr::fuse(state, _root);
+    }
+    return Status::OK();
 }
 
 doris::Status VExprContext::open(doris::RuntimeState* state) {
@@ -125,6 +135,22 @@ Status VExprContext::filter_block(const std::unique_ptr<VExprContext*>& vexpr_ct
     return Block::filter_block(block, result_column_id, column_to_keep);
 }
 
+Status VExprContext::execute_conjuncts(const std::vector<VExprContext*>& ctxs, Block* block,
+                                       IColumn::Filter* result_filter, bool* can_filter_all) {
+    DCHECK_EQ(result_filter->size(), block->rows());
+    *can_filter_all = false;
+    for (auto* ctx : ctxs) {
+        int result_column_id = -1;
+        RETURN_IF_ERROR(ctx->execute(block, &result_column_id));
+        if (!Block::merge_filter(*block->get_by_position(result_column_id).column,
+                                 result_filter)) {
+            *can_filter_all = true;
+            return Status::OK();
+        }
+    }
+    return Status::OK();
+}
+
 Block VExprContext::get_output_block_after_execute_exprs(
         const std::vector<vectorized::VExprContext*>& output_vexpr_ctxs, const Block& input_block,
         Status& status) {
@@ -57,6 +57,13 @@ public:
     [[nodiscard]] static Status filter_block(const std::unique_ptr<VExprContext*>& vexpr_ctx_ptr,
                                              Block* block, int column_to_keep);
 
+    // Executes the conjuncts on the block and ANDs their results into `result_filter`, which is
+    // sized to the rows of the block. It stops at the first conjunct which leaves no row, and
+    // sets `can_filter_all` then.
+    [[nodiscard]] static Status execute_conjuncts(const std::vector<VExprContext*>& ctxs,
+                                                  Block* block, IColumn::Filter* result_filter,
+                                                  bool* can_filter_all);
+
     static Block get_output_block_after_execute_exprs(const std::vector<vectorized::VExprContext*>&,
                                                       const Block&, Status&);
 
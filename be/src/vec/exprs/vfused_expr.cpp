@@ -0,0 +1,328 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exprs/vfused_expr.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+#include "common/config.h"
+#include "runtime/runtime_state.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/assert_cast.h"
+#include "vec/data_types/data_type.h"
+#include "vec/exprs/vliteral.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+using OpCode = FusedProgram::OpCode;
+using Operand = FusedProgram::Operand;
+using OperandKind = FusedProgram::OperandKind;
+
+// the cached programs are dropped all together beyond this
+constexpr size_t MAX_CACHED_PROGRAMS = 4096;
+
+bool is_double(VExpr* expr) {
+    return !expr->data_type()->is_nullable() && WhichDataType(expr->data_type()).is_float64();
+}
+
+bool is_double_literal(VExpr* expr) {
+    return expr->node_type() == TExprNodeType::FLOAT_LITERAL && is_double(expr);
+}
+
+// Returns the op of a function whose arguments are non-nullable doubles, if it can be fused.
+std::optional<OpCode> fusable_op(VExpr* expr) {
+    switch (expr->node_type()) {
+    case TExprNodeType::ARITHMETIC_EXPR:
+    case TExprNodeType::BINARY_PRED:
+    case TExprNodeType::FUNCTION_CALL:
+    case TExprNodeType::COMPUTE_FUNCTION_CALL:
+        break;
+    default:
+        return std::nullopt;
+    }
+    if (expr->get_num_children() != 2 || !is_double(expr->get_child(0)) ||
+        !is_double(expr->get_child(1))) {
+        return std::nullopt;
+    }
+    // divide is not here, since it returns null for the zero divisors
+    static const std::unordered_map<std::string, OpCode> arithmetic_ops = {
+            {"add", OpCode::ADD}, {"subtract", OpCode::SUB}, {"multiply", OpCode::MUL}};
+    static const std::unordered_map<std::string, OpCode> comparison_ops = {
+            {"eq", OpCode::EQ}, {"ne", OpCode::NE}, {"lt", OpCode::LT},
+            {"le", OpCode::LE}, {"gt", OpCode::GT}, {"ge", OpCode::GE}};
+    const auto& name = expr->fn().name.function_name;
+    if (auto it = arithmetic_ops.find(name); it != arithmetic_ops.end() && is_double(expr)) {
+        return it->second;
+    }
+    if (auto it = comparison_ops.find(name); it != comparison_ops.end() &&
+                                             !expr->data_type()->is_nullable() &&
+                                             WhichDataType(expr->data_type()).is_uint8()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+// The arguments of the fused functions are doubles, so only the arithmetic ones are fused below
+// the root of a tree.
+bool is_fused_child(VExpr* expr) {
+    auto op = fusable_op(expr);
+    return op.has_value() && !FusedProgram::is_comparison(*op);
+}
+
+size_t count_ops(VExpr* expr) {
+    size_t ops = 1;
+    for (auto* child : expr->children()) {
+        if (is_fused_child(child)) {
+            ops += count_ops(child);
+        }
+    }
+    return ops;
+}
+
+double literal_value(VExpr* expr) {
+    return (*assert_cast<VLiteral*>(expr)->get_column_ptr())[0].get<Float64>();
+}
+
+// Collects the inputs and the fingerprint of a tree, the inputs are fused as well.
+void collect(RuntimeState* state, VExpr* expr, std::vector<VExpr*>& inputs,
+             fmt::memory_buffer& fingerprint) {
+    fmt::format_to(fingerprint, "{}(", expr->fn().name.function_name);
+    for (auto* child : expr->children()) {
+        if (is_fused_child(child)) {
+            collect(state, child, inputs, fingerprint);
+        } else if (is_double_literal(child)) {
+            fmt::format_to(fingerprint, "#{:a}", literal_value(child));
+        } else {
+            fmt::format_to(fingerprint, "${}", inputs.size());
+            inputs.push_back(VFusedExpr::fuse(state, child));
+        }
+        fmt::format_to(fingerprint, ",");
+    }
+    fmt::format_to(fingerprint, ")");
+}
+
+// Emits the instructions of a tree in the order of collect(), and returns the operand of its
+// result. The registers of the arguments are reused for the results.
+Operand emit(VExpr* expr, FusedProgram& program, uint32_t& next_input,
+             std::vector<uint32_t>& free_registers) {
+    Operand args[2];
+    for (int i = 0; i < 2; ++i) {
+        VExpr* child = expr->get_child(i);
+        if (is_fused_child(child)) {
+            args[i] = emit(child, program, next_input, free_registers);
+        } else if (is_double_literal(child)) {
+            args[i] = {OperandKind::CONSTANT, static_cast<uint32_t>(program.constants.size())};
+            program.constants.push_back(literal_value(child));
+        } else {
+            args[i] = {OperandKind::INPUT, next_input++};
+        }
+    }
+    for (const auto& arg : args) {
+        if (arg.kind == OperandKind::REGISTER) {
+            free_registers.push_back(arg.index);
+        }
+    }
+    uint32_t dst;
+    if (free_registers.empty()) {
+        dst = program.num_registers++;
+    } else {
+        dst = free_registers.back();
+        free_registers.pop_back();
+    }
+    program.instructions.push_back({*fusable_op(expr), args[0], args[1], dst});
+    return {OperandKind::REGISTER, dst};
+}
+
+std::shared_ptr<const FusedProgram> get_or_compile(VExpr* root, const std::string& fingerprint) {
+    static std::mutex lock;
+    static std::unordered_map<std::string, std::shared_ptr<const FusedProgram>> programs;
+    {
+        std::lock_guard<std::mutex> l(lock);
+        auto it = programs.find(fingerprint);
+        if (it != programs.end()) {
+            return it->second;
+        }
+    }
+    auto program = std::make_shared<FusedProgram>();
+    uint32_t next_input = 0;
+    std::vector<uint32_t> free_registers;
+    emit(root, *program, next_input, free_registers);
+
+    std::lock_guard<std::mutex> l(lock);
+    if (programs.size() >= MAX_CACHED_PROGRAMS) {
+        programs.clear();
+    }
+    return programs.emplace(fingerprint, std::move(program)).first->second;
+}
+
+template <typename T, typename Op>
+void execute_batch(const double* __restrict lhs, const double* __restrict rhs, T* dst,
+                   size_t rows, Op op) {
+    for (size_t i = 0; i < rows; ++i) {
+        dst[i] = op(lhs[i], rhs[i]);
+    }
+}
+
+template <typename T>
+void execute_instruction(OpCode op, const double* lhs, const double* rhs, T* dst, size_t rows) {
+    switch (op) {
+    case OpCode::ADD:
+        return execute_batch(lhs, rhs, dst, rows, [](double a, double b) { return a + b; });
+    case OpCode::SUB:
+        return execute_batch(lhs, rhs, dst, rows, [](double a, double b) { return a - b; });
+    case OpCode::MUL:
+        return execute_batch(lhs, rhs, dst, rows, [](double a, double b) { return a * b; });
+    case OpCode::EQ:
+        return execute_batch(lhs, rhs, dst, rows, [](double a, double b) { return a == b; });
+    case OpCode::NE:
+        return execute_batch(lhs, rhs, dst, rows, [](double a, double b) { return a != b; });
+    case OpCode::LT:
+        return execute_batch(lhs, rhs, dst, rows, [](double a, double b) { return a < b; });
+    case OpCode::LE:
+        return execute_batch(lhs, rhs, dst, rows, [](double a, double b) { return a <= b; });
+    case OpCode::GT:
+        return execute_batch(lhs, rhs, dst, rows, [](double a, double b) { return a > b; });
+    case OpCode::GE:
+        return execute_batch(lhs, rhs, dst, rows, [](double a, double b) { return a >= b; });
+    }
+}
+
+} // namespace
+
+void FusedProgram::execute(const std::vector<const double*>& inputs, size_t rows,
+                           void* output) const {
+    std::vector<double> registers(num_registers * BATCH_SIZE);
+    std::vector<double> constant_batches(constants.size() * BATCH_SIZE);
+    for (size_t i = 0; i < constants.size(); ++i) {
+        std::fill_n(constant_batches.data() + i * BATCH_SIZE, BATCH_SIZE, constants[i]);
+    }
+    for (size_t begin = 0; begin < rows; begin += BATCH_SIZE) {
+        size_t batch_rows = std::min(BATCH_SIZE, rows - begin);
+        auto operand_data = [&](const Operand& operand) -> const double* {
+            switch (operand.kind) {
+            case OperandKind::INPUT:
+                return inputs[operand.index] + begin;
+            case OperandKind::CONSTANT:
+                return constant_batches.data() + operand.index * BATCH_SIZE;
+            case OperandKind::REGISTER:
+                return registers.data() + operand.index * BATCH_SIZE;
+            }
+            __builtin_unreachable();
+        };
+        for (size_t i = 0; i < instructions.size(); ++i) {
+            const auto& instruction = instructions[i];
+            const double* lhs = operand_data(instruction.lhs);
+            const double* rhs = operand_data(instruction.rhs);
+            if (i + 1 < instructions.size()) {
+                execute_instruction(instruction.op, lhs, rhs,
+                                    registers.data() + instruction.dst * BATCH_SIZE, batch_rows);
+            } else if (is_comparison(instruction.op)) {
+                execute_instruction(instruction.op, lhs, rhs, static_cast<UInt8*>(output) + begin,
+                                    batch_rows);
+            } else {
+                execute_instruction(instruction.op, lhs, rhs, static_cast<double*>(output) + begin,
+                                    batch_rows);
+            }
+        }
+    }
+}
+
+VExpr* VFusedExpr::fuse(RuntimeState* state, VExpr* expr) {
+    if (fusable_op(expr).has_value() && count_ops(expr) >= MIN_FUSED_OPS) {
+        RuntimeProfile* profile = state->runtime_profile();
+        SCOPED_TIMER(ADD_TIMER(profile, "FusedExprCompileTime"));
+        std::vector<VExpr*> inputs;
+        fmt::memory_buffer fingerprint;
+        collect(state, expr, inputs, fingerprint);
+        // a tree of constants only is folded by the planner, and needs no batches of rows
+        if (!inputs.empty()) {
+            COUNTER_UPDATE(ADD_COUNTER(profile, "FusedExprCount", TUnit::UNIT), 1);
+            std::string fingerprint_str = fmt::to_string(fingerprint);
+            auto program = get_or_compile(expr, fingerprint_str);
+            return state->obj_pool()->add(
+                    new VFusedExpr(expr, std::move(program), std::move(fingerprint_str),
+                                   std::move(inputs),
+                                   ADD_COUNTER(profile, "FusedExprSavedBytes", TUnit::BYTES)));
+        }
+    }
+    std::vector<VExpr*> children;
+    for (auto* child : expr->children()) {
+        children.push_back(fuse(state, child));
+    }
+    expr->set_children(std::move(children));
+    return expr;
+}
+
+VFusedExpr::VFusedExpr(VExpr* root, std::shared_ptr<const FusedProgram> program,
+                       std::string fingerprint, std::vector<VExpr*> inputs,
+                       RuntimeProfile::Counter* saved_bytes_counter)
+        : VExpr(root->type(), false, false),
+          _program(std::move(program)),
+          _fingerprint(std::move(fingerprint)),
+          _expr_name("VFusedExpr"),
+          _saved_bytes_counter(saved_bytes_counter) {
+    // not FUNCTION_CALL or BINARY_PRED, whose exprs are taken as VectorizedFnCall by the scan nodes
+    _node_type = TExprNodeType::COMPUTE_FUNCTION_CALL;
+    _children = std::move(inputs);
+    // the inputs are prepared with the root
+    _prepared = true;
+}
+
+Status VFusedExpr::execute(VExprContext* context, Block* block, int* result_column_id) {
+    std::vector<ColumnPtr> input_columns(_children.size());
+    std::vector<const double*> inputs(_children.size());
+    for (size_t i = 0; i < _children.size(); ++i) {
+        int column_id = -1;
+        RETURN_IF_ERROR(_children[i]->execute(context, block, &column_id));
+        input_columns[i] =
+                block->get_by_position(column_id).column->convert_to_full_column_if_const();
+        inputs[i] = assert_cast<const ColumnFloat64&>(*input_columns[i]).get_data().data();
+    }
+    size_t rows = input_columns[0]->size();
+
+    MutableColumnPtr result;
+    if (_program->is_predicate()) {
+        auto column = ColumnUInt8::create(rows);
+        _program->execute(inputs, rows, column->get_data().data());
+        result = std::move(column);
+    } else {
+        auto column = ColumnFloat64::create(rows);
+        _program->execute(inputs, rows, column->get_data().data());
+        result = std::move(column);
+    }
+    // every function but the last one and every literal would have materialized a column
+    COUNTER_UPDATE(_saved_bytes_counter,
+                   rows * sizeof(double) *
+                           (_program->instructions.size() - 1 + _program->constants.size()));
+
+    block->insert({std::move(result), _data_type, _expr_name});
+    *result_column_id = block->columns() - 1;
+    return Status::OK();
+}
+
+std::string VFusedExpr::debug_string() const {
+    return fmt::format("VFusedExpr({}, {})", _fingerprint, VExpr::debug_string());
+}
+
+} // namespace doris::vectorized
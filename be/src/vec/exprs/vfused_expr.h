@@ -0,0 +1,96 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "util/runtime_profile.h"
+#include "vec/exprs/vexpr.h"
+
+namespace doris {
+class RuntimeState;
+
+namespace vectorized {
+
+// The program of a tree of arithmetic (+, -, *) and comparison functions on non-nullable doubles.
+// It is evaluated over the rows in batches of BATCH_SIZE, so that the intermediate results stay
+// in a few registers of a batch each, instead of a materialized column per function.
+struct FusedProgram {
+    static constexpr size_t BATCH_SIZE = 1024;
+
+    enum class OpCode : uint8_t { ADD, SUB, MUL, EQ, NE, LT, LE, GT, GE };
+    enum class OperandKind : uint8_t { INPUT, CONSTANT, REGISTER };
+
+    struct Operand {
+        OperandKind kind;
+        uint32_t index;
+    };
+
+    struct Instruction {
+        OpCode op;
+        Operand lhs;
+        Operand rhs;
+        // the register of the result, unused by the last instruction which writes the output
+        uint32_t dst;
+    };
+
+    static bool is_comparison(OpCode op) { return op >= OpCode::EQ; }
+
+    // Whether the output is UInt8, otherwise Float64.
+    bool is_predicate() const { return is_comparison(instructions.back().op); }
+
+    // Writes the results of the rows into `output`, which is either Float64 or UInt8.
+    void execute(const std::vector<const double*>& inputs, size_t rows, void* output) const;
+
+    std::vector<Instruction> instructions;
+    std::vector<double> constants;
+    uint32_t num_registers = 0;
+};
+
+// Replaces the maximal trees of at least MIN_FUSED_OPS fusable functions of a prepared expr tree.
+// The subtrees of the other exprs, whose results are non-nullable doubles, are the children of
+// VFusedExpr and evaluated as usual, and the double literals become the constants of the program.
+// The programs are cached by the fingerprints of the trees, since the same exprs are prepared by
+// every fragment instance.
+class VFusedExpr final : public VExpr {
+public:
+    static constexpr size_t MIN_FUSED_OPS = 2;
+
+    // Returns the expr to use instead of `expr`, which may be itself with fused subtrees.
+    static VExpr* fuse(RuntimeState* state, VExpr* expr);
+
+    VFusedExpr(VExpr* root, std::shared_ptr<const FusedProgram> program, std::string fingerprint,
+               std::vector<VExpr*> inputs, RuntimeProfile::Counter* saved_bytes_counter);
+
+    Status execute(VExprContext* context, Block* block, int* result_column_id) override;
+    const std::string& expr_name() const override { return _expr_name; }
+    VExpr* clone(ObjectPool* pool) const override { return pool->add(new VFusedExpr(*this)); }
+    std::string debug_string() const override;
+
+private:
+    std::shared_ptr<const FusedProgram> _program;
+    const std::string _fingerprint;
+    const std::string _expr_name;
+    // the bytes of the intermediate columns which are not materialized
+    RuntimeProfile::Counter* _saved_bytes_counter;
+};
+
+} // namespace vectorized
+} // namespace doris
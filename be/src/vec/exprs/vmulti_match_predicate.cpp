@@ -0,0 +1,244 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exprs/vmulti_match_predicate.h"
+
+#include <fmt/format.h>
+
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+
+#include "runtime/runtime_state.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/common/assert_cast.h"
+#include "vec/exprs/vliteral.h"
+#include "vec/exprs/vslot_ref.h"
+#include "vec/functions/like.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+// the cached databases are dropped all together beyond this
+constexpr size_t MAX_CACHED_DATABASES = 1024;
+
+bool is_or(VExpr* expr) {
+    return expr->node_type() == TExprNodeType::COMPOUND_PRED &&
+           expr->fn().name.function_name == "or" && expr->get_num_children() == 2;
+}
+
+void collect_disjuncts(VExpr* expr, std::vector<VExpr*>& disjuncts) {
+    if (is_or(expr)) {
+        collect_disjuncts(expr->get_child(0), disjuncts);
+        collect_disjuncts(expr->get_child(1), disjuncts);
+    } else {
+        disjuncts.push_back(expr);
+    }
+}
+
+// Returns the hyperscan regex of a LIKE or REGEXP predicate with a constant pattern on the slot
+// of `*slot_ref`, which is set by the first predicate.
+bool to_regex(VExpr* expr, VExpr** slot_ref, std::string* regex) {
+    const auto& name = expr->fn().name.function_name;
+    if ((name != FunctionLike::name && name != FunctionRegexp::name) ||
+        expr->get_num_children() != 2) {
+        return false;
+    }
+    VExpr* slot = expr->get_child(0);
+    VExpr* pattern = expr->get_child(1);
+    if (!slot->is_slot_ref() || pattern->node_type() != TExprNodeType::STRING_LITERAL ||
+        !WhichDataType(remove_nullable(slot->data_type())).is_string() ||
+        slot->data_type()->is_nullable() != expr->data_type()->is_nullable()) {
+        return false;
+    }
+    if (*slot_ref == nullptr) {
+        *slot_ref = slot;
+    } else if (assert_cast<VSlotRef*>(*slot_ref)->slot_id() !=
+               assert_cast<VSlotRef*>(slot)->slot_id()) {
+        return false;
+    }
+    std::string pattern_str =
+            assert_cast<VLiteral*>(pattern)->get_column_ptr()->get_data_at(0).to_string();
+    if (name == FunctionLike::name) {
+        LikeSearchState search_state;
+        FunctionLike::convert_like_pattern(&search_state, pattern_str, regex);
+    } else {
+        *regex = std::move(pattern_str);
+    }
+    return true;
+}
+
+} // namespace
+
+VExpr* VMultiMatchPredicate::rewrite(RuntimeState* state, VExpr* expr) {
+    if (is_or(expr)) {
+        std::vector<VExpr*> disjuncts;
+        collect_disjuncts(expr, disjuncts);
+        VExpr* slot_ref = nullptr;
+        std::vector<std::string> regexes;
+        for (auto* disjunct : disjuncts) {
+            std::string regex;
+            if (!to_regex(disjunct, &slot_ref, &regex)) {
+                break;
+            }
+            regexes.push_back(std::move(regex));
+        }
+        if (regexes.size() == disjuncts.size() && regexes.size() >= MIN_PATTERNS) {
+            std::shared_ptr<const multiregexps::Regexps> regexps;
+            Status st = compile(regexes, &regexps);
+            if (st.ok()) {
+                return state->obj_pool()->add(
+                        new VMultiMatchPredicate(expr, slot_ref, std::move(regexps),
+                                                 regexes.size()));
+            }
+            // the predicates compile their patterns one by one as before
+            LOG(WARNING) << "failed to compile the patterns of " << expr->debug_string()
+                         << " into one database: " << st;
+        }
+    }
+    std::vector<VExpr*> children;
+    for (auto* child : expr->children()) {
+        children.push_back(rewrite(state, child));
+    }
+    expr->set_children(std::move(children));
+    return expr;
+}
+
+Status VMultiMatchPredicate::compile(const std::vector<std::string>& regexes,
+                                     std::shared_ptr<const multiregexps::Regexps>* regexps) {
+    static std::mutex lock;
+    static std::unordered_map<std::string, std::shared_ptr<const multiregexps::Regexps>>
+            databases;
+
+    fmt::memory_buffer key_buffer;
+    for (const auto& regex : regexes) {
+        fmt::format_to(key_buffer, "{}:{}", regex.size(), regex);
+    }
+    std::string key = fmt::to_string(key_buffer);
+    {
+        std::lock_guard<std::mutex> l(lock);
+        auto it = databases.find(key);
+        if (it != databases.end()) {
+            *regexps = it->second;
+            return Status::OK();
+        }
+    }
+
+    std::vector<const char*> expressions;
+    // the flags of FunctionLikeBase::hs_prepare, the predicates only need the first match
+    std::vector<unsigned int> flags(regexes.size(),
+                                    HS_FLAG_DOTALL | HS_FLAG_ALLOWEMPTY | HS_FLAG_SINGLEMATCH);
+    for (const auto& regex : regexes) {
+        expressions.push_back(regex.c_str());
+    }
+    hs_database_t* database = nullptr;
+    hs_compile_error_t* compile_err = nullptr;
+    if (hs_compile_multi(expressions.data(), flags.data(), nullptr, regexes.size(), HS_MODE_BLOCK,
+                         nullptr, &database, &compile_err) != HS_SUCCESS) {
+        multiregexps::CompilerError error(compile_err);
+        return Status::InvalidArgument("hs_compile_multi regex pattern error: {}",
+                                       error->message);
+    }
+    hs_scratch_t* scratch = nullptr;
+    if (hs_alloc_scratch(database, &scratch) != HS_SUCCESS) {
+        hs_free_database(database);
+        return Status::InternalError("hs_alloc_scratch allocate scratch space error");
+    }
+
+    auto compiled = std::make_shared<const multiregexps::Regexps>(database, scratch);
+    std::lock_guard<std::mutex> l(lock);
+    if (databases.size() >= MAX_CACHED_DATABASES) {
+        databases.clear();
+    }
+    *regexps = databases.emplace(std::move(key), std::move(compiled)).first->second;
+    return Status::OK();
+}
+
+Status VMultiMatchPredicate::match(const multiregexps::Regexps& regexps,
+                                   const ColumnString& values, ColumnUInt8::Container& result) {
+    // the scratch space is not thread safe, while the database is
+    hs_scratch_t* scratch = nullptr;
+    if (hs_clone_scratch(regexps.getScratch(), &scratch) != HS_SUCCESS) {
+        return Status::InternalError("could not clone scratch space for hyperscan");
+    }
+    multiregexps::ScratchPtr smart_scratch(scratch);
+
+    result.resize(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        StringRef value = values.get_data_at(i);
+        if (value.size > std::numeric_limits<UInt32>::max()) {
+            return Status::InternalError("too long string to search");
+        }
+        result[i] = 0;
+        auto err = hs_scan(regexps.getDB(), value.data, value.size, 0, smart_scratch.get(),
+                           LikeSearchState::hs_match_handler, &result[i]);
+        if (err != HS_SUCCESS && err != HS_SCAN_TERMINATED) {
+            return Status::InternalError("hyperscan match error: {}", err);
+        }
+    }
+    return Status::OK();
+}
+
+VMultiMatchPredicate::VMultiMatchPredicate(VExpr* root, VExpr* slot_ref,
+                                           std::shared_ptr<const multiregexps::Regexps> regexps,
+                                           size_t num_patterns)
+        : VExpr(root->type(), false, root->data_type()->is_nullable()),
+          _regexps(std::move(regexps)),
+          _num_patterns(num_patterns),
+          _expr_name("VMultiMatchPredicate") {
+    // not FUNCTION_CALL, whose exprs are taken as VectorizedFnCall by the scan nodes
+    _node_type = TExprNodeType::COMPUTE_FUNCTION_CALL;
+    _children = {slot_ref};
+    // the slot ref is prepared with the root
+    _prepared = true;
+}
+
+Status VMultiMatchPredicate::execute(VExprContext* context, Block* block, int* result_column_id) {
+    int column_id = -1;
+    RETURN_IF_ERROR(_children[0]->execute(context, block, &column_id));
+    ColumnPtr column = block->get_by_position(column_id).column->convert_to_full_column_if_const();
+
+    const IColumn* values = column.get();
+    const NullMap* null_map = nullptr;
+    if (const auto* nullable = check_and_get_column<ColumnNullable>(values)) {
+        values = &nullable->get_nested_column();
+        null_map = &nullable->get_null_map_data();
+    }
+    auto result = ColumnUInt8::create();
+    RETURN_IF_ERROR(
+            match(*_regexps, assert_cast<const ColumnString&>(*values), result->get_data()));
+
+    ColumnPtr result_column = std::move(result);
+    if (_data_type->is_nullable()) {
+        auto result_null_map = ColumnUInt8::create(result_column->size(), 0);
+        if (null_map != nullptr) {
+            result_null_map->get_data().assign(*null_map);
+        }
+        result_column = ColumnNullable::create(result_column, std::move(result_null_map));
+    }
+    block->insert({std::move(result_column), _data_type, _expr_name});
+    *result_column_id = block->columns() - 1;
+    return Status::OK();
+}
+
+std::string VMultiMatchPredicate::debug_string() const {
+    return fmt::format("VMultiMatchPredicate(patterns={}, {})", _num_patterns,
+                       VExpr::debug_string());
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,70 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/functions/regexps.h"
+
+namespace doris {
+class RuntimeState;
+
+namespace vectorized {
+
+// Replaces a tree of OR'ed LIKE and REGEXP predicates on the same string slot with constant
+// patterns, e.g. `url LIKE '%a%' OR url REGEXP 'b+c' OR ...`, by one predicate which scans every
+// row once with a hyperscan database of all the patterns. The only child is the slot ref.
+class VMultiMatchPredicate final : public VExpr {
+public:
+    static constexpr size_t MIN_PATTERNS = 2;
+
+    // Returns the expr to use instead of `expr`, which may be itself with rewritten subtrees.
+    static VExpr* rewrite(RuntimeState* state, VExpr* expr);
+
+    // Compiles the hyperscan regexes into one database, the compiled ones are cached.
+    static Status compile(const std::vector<std::string>& regexes,
+                          std::shared_ptr<const multiregexps::Regexps>* regexps);
+
+    // Sets the result of a row to 1 if it matches any regex of `regexps`.
+    static Status match(const multiregexps::Regexps& regexps, const ColumnString& values,
+                        ColumnUInt8::Container& result);
+
+    VMultiMatchPredicate(VExpr* root, VExpr* slot_ref,
+                         std::shared_ptr<const multiregexps::Regexps> regexps, size_t num_patterns);
+
+    Status execute(VExprContext* context, Block* block, int* result_column_id) override;
+    const std::string& expr_name() const override { return _expr_name; }
+    VExpr* clone(ObjectPool* pool) const override {
+        return pool->add(new VMultiMatchPredicate(*this));
+    }
+    std::string debug_string() const override;
+
+private:
+    std::shared_ptr<const multiregexps::Regexps> _regexps;
+    const size_t _num_patterns;
+    const std::string _expr_name;
+};
+
+} // namespace vectorized
+} // namespace doris
@@ -305,6 +305,26 @@ struct TransformerToStringTwoArgument {
     }
 };
 
+// The transforms whose results only depend on the date part of the value, and go through the
+// day number or the week tables, which are computed once for a run of the rows of the same date.
+template <typename Transform>
+struct IsDatePartTransform : std::false_type {};
+
+template <typename ArgType>
+struct IsDatePartTransform<WeekOfYearImpl<ArgType>> : std::true_type {};
+template <typename ArgType>
+struct IsDatePartTransform<DayOfYearImpl<ArgType>> : std::true_type {};
+template <typename ArgType>
+struct IsDatePartTransform<DayOfWeekImpl<ArgType>> : std::true_type {};
+template <typename ArgType>
+struct IsDatePartTransform<WeekDayImpl<ArgType>> : std::true_type {};
+template <typename ArgType>
+struct IsDatePartTransform<ToDaysImpl<ArgType>> : std::true_type {};
+template <typename ArgType>
+struct IsDatePartTransform<ToWeekOneArgImpl<ArgType>> : std::true_type {};
+template <typename ArgType>
+struct IsDatePartTransform<ToYearWeekOneArgImpl<ArgType>> : std::true_type {};
+
 template <typename FromType, typename ToType, typename Transform>
 struct Transformer {
     static void vector(const PaddedPODArray<FromType>& vec_from, PaddedPODArray<ToType>& vec_to,
@@ -313,8 +333,13 @@ struct Transformer {
         vec_to.resize(size);
         null_map.resize(size);
 
+        [[maybe_unused]] DatePartRunCache<FromType, ToType> cache;
         for (size_t i = 0; i < size; ++i) {
-            vec_to[i] = Transform::execute(vec_from[i]);
+            if constexpr (IsDatePartTransform<Transform>::value) {
+                vec_to[i] = cache.get(vec_from[i], Transform::execute);
+            } else {
+                vec_to[i] = Transform::execute(vec_from[i]);
+            }
             null_map[i] = !((typename DateTraits<typename Transform::OpArgType>::T&)(vec_from[i]))
                                    .is_valid_date();
         }
@@ -324,8 +349,13 @@ struct Transformer {
         size_t size = vec_from.size();
         vec_to.resize(size);
 
+        [[maybe_unused]] DatePartRunCache<FromType, ToType> cache;
         for (size_t i = 0; i < size; ++i) {
-            vec_to[i] = Transform::execute(vec_from[i]);
+            if constexpr (IsDatePartTransform<Transform>::value) {
+                vec_to[i] = cache.get(vec_from[i], Transform::execute);
+            } else {
+                vec_to[i] = Transform::execute(vec_from[i]);
+            }
             DCHECK(((typename DateTraits<typename Transform::OpArgType>::T&)(vec_from[i]))
                            .is_valid_date());
         }
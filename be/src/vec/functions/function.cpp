@@ -41,10 +41,14 @@ ColumnPtr wrap_in_nullable(const ColumnPtr& src, const Block& block, const Colum
     /// If result is already nullable.
     ColumnPtr src_not_nullable = src;
     MutableColumnPtr mutable_result_null_map_column;
+    // the null map of an argument without null, shared by the result if no argument has null
+    ColumnPtr no_null_map_column;
 
     if (auto* nullable = check_and_get_column<ColumnNullable>(*src)) {
         src_not_nullable = nullable->get_nested_column_ptr();
         result_null_map_column = nullable->get_null_map_column_ptr();
+        // the result is made by the function, so its null map could be changed in place
+        mutable_result_null_map_column = (*std::move(result_null_map_column)).assume_mutable();
     }
 
     for (const auto& arg : args) {
@@ -65,24 +69,45 @@ ColumnPtr wrap_in_nullable(const ColumnPtr& src, const Block& block, const Colum
 
         if (auto* nullable = assert_cast<const ColumnNullable*>(elem.column.get())) {
             const ColumnPtr& null_map_column = nullable->get_null_map_column_ptr();
-            if (!result_null_map_column) {
-                result_null_map_column = null_map_column->clone_resized(input_rows_count);
-            } else {
-                if (!mutable_result_null_map_column) {
+            if (null_map_column->size() == input_rows_count && !nullable->has_null()) {
+                if (!no_null_map_column) {
+                    no_null_map_column = null_map_column;
+                }
+                continue;
+            }
+            const NullMap& src_null_map =
+                    assert_cast<const ColumnUInt8&>(*null_map_column).get_data();
+            if (mutable_result_null_map_column) {
+                VectorizedUtils::update_null_map(
+                        assert_cast<ColumnUInt8&>(*mutable_result_null_map_column).get_data(),
+                        src_null_map);
+            } else if (!result_null_map_column) {
+                if (null_map_column->size() == input_rows_count) {
+                    // shared with the argument until another null map is merged into it
+                    result_null_map_column = null_map_column;
+                } else {
                     mutable_result_null_map_column =
-                            (*std::move(result_null_map_column)).assume_mutable();
+                            null_map_column->clone_resized(input_rows_count);
                 }
-
-                NullMap& result_null_map =
-                        assert_cast<ColumnUInt8&>(*mutable_result_null_map_column).get_data();
-                const NullMap& src_null_map =
-                        assert_cast<const ColumnUInt8&>(*null_map_column).get_data();
-
-                VectorizedUtils::update_null_map(result_null_map, src_null_map);
+            } else {
+                auto merged = ColumnUInt8::create();
+                VectorizedUtils::merge_null_maps(
+                        merged->get_data(),
+                        assert_cast<const ColumnUInt8&>(*result_null_map_column).get_data(),
+                        src_null_map);
+                result_null_map_column = nullptr;
+                mutable_result_null_map_column = std::move(merged);
             }
         }
     }
 
+    if (mutable_result_null_map_column) {
+        result_null_map_column = std::move(mutable_result_null_map_column);
+    }
+    if (!result_null_map_column && no_null_map_column) {
+        result_null_map_column = no_null_map_column;
+    }
+
     if (!result_null_map_column) {
         if (is_column_const(*src)) {
             return ColumnConst::create(
@@ -17,6 +17,11 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
+#include <string>
+
+#include "util/timezone_utils.h"
 #include "vec/columns/columns_number.h"
 #include "vec/common/string_ref.h"
 #include "vec/core/types.h"
@@ -27,7 +32,8 @@
 namespace doris::vectorized {
 
 struct ConvertTzCtx {
-    std::map<std::string, cctz::time_zone> time_zone_cache;
+    // nullptr for the invalid time zones
+    std::map<std::string, std::unique_ptr<TimezoneOffsetCache>> time_zone_cache;
 };
 
 template <typename DateValueType, typename ArgType>
@@ -46,6 +52,22 @@ struct ConvertTZImpl {
             std::conditional_t<std::is_same_v<VecDateTimeValue, DateValueType>, Int64, UInt64>;
     using ReturnColumnType = std::conditional_t<std::is_same_v<VecDateTimeValue, DateValueType>,
                                                 ColumnDateTime, ColumnDateTimeV2>;
+    using TimeZoneCache = std::map<std::string, std::unique_ptr<TimezoneOffsetCache>>;
+
+    static TimezoneOffsetCache* find_time_zone(TimeZoneCache& time_zone_cache,
+                                               const StringRef& name) {
+        auto name_str = name.to_string();
+        auto it = time_zone_cache.find(name_str);
+        if (it == time_zone_cache.end()) {
+            cctz::time_zone ctz;
+            std::unique_ptr<TimezoneOffsetCache> zone;
+            if (TimezoneUtils::find_cctz_time_zone(name_str, ctz)) {
+                zone = std::make_unique<TimezoneOffsetCache>(ctz);
+            }
+            it = time_zone_cache.emplace(std::move(name_str), std::move(zone)).first;
+        }
+        return it->second.get();
+    }
 
     static void execute(FunctionContext* context, const ColumnType* date_column,
                         const ColumnString* from_tz_column, const ColumnString* to_tz_column,
@@ -53,50 +75,58 @@ struct ConvertTZImpl {
                         size_t input_rows_count) {
         auto convert_ctx = reinterpret_cast<ConvertTzCtx*>(
                 context->get_function_state(FunctionContext::FunctionStateScope::THREAD_LOCAL));
-        std::map<std::string, cctz::time_zone> time_zone_cache_;
+        TimeZoneCache time_zone_cache_;
         auto& time_zone_cache = convert_ctx ? convert_ctx->time_zone_cache : time_zone_cache_;
+        // the time zones are mostly constants, which are only looked up when they change
+        StringRef last_from_tz;
+        StringRef last_to_tz;
+        TimezoneOffsetCache* from_zone = nullptr;
+        TimezoneOffsetCache* to_zone = nullptr;
+        bool resolved = false;
+        result_column->reserve(input_rows_count);
         for (size_t i = 0; i < input_rows_count; i++) {
             if (result_null_map[i]) {
                 result_column->insert_default();
                 continue;
             }
 
-            auto from_tz = from_tz_column->get_data_at(i).to_string();
-            auto to_tz = to_tz_column->get_data_at(i).to_string();
-
-            DateValueType ts_value =
-                    binary_cast<NativeType, DateValueType>(date_column->get_element(i));
-            int64_t timestamp;
-
-            if (time_zone_cache.find(from_tz) == time_zone_cache.cend()) {
-                if (!TimezoneUtils::find_cctz_time_zone(from_tz, time_zone_cache[from_tz])) {
-                    result_null_map[i] = true;
-                    result_column->insert_default();
-                    continue;
-                }
+            auto from_tz = from_tz_column->get_data_at(i);
+            auto to_tz = to_tz_column->get_data_at(i);
+            if (!resolved || from_tz != last_from_tz) {
+                from_zone = find_time_zone(time_zone_cache, from_tz);
+                last_from_tz = from_tz;
             }
-
-            if (time_zone_cache.find(to_tz) == time_zone_cache.cend()) {
-                if (!TimezoneUtils::find_cctz_time_zone(to_tz, time_zone_cache[to_tz])) {
-                    result_null_map[i] = true;
-                    result_column->insert_default();
-                    continue;
-                }
+            if (!resolved || to_tz != last_to_tz) {
+                to_zone = find_time_zone(time_zone_cache, to_tz);
+                last_to_tz = to_tz;
             }
-
-            if (!ts_value.unix_timestamp(&timestamp, time_zone_cache[from_tz])) {
+            resolved = true;
+            if (from_zone == nullptr || to_zone == nullptr) {
                 result_null_map[i] = true;
                 result_column->insert_default();
                 continue;
             }
 
-            ReturnDateType ts_value2;
-            if (!ts_value2.from_unixtime(timestamp, time_zone_cache[to_tz])) {
-                result_null_map[i] = true;
-                result_column->insert_default();
-                continue;
+            DateValueType ts_value =
+                    binary_cast<NativeType, DateValueType>(date_column->get_element(i));
+            cctz::civil_second cs;
+            if constexpr (std::is_same_v<DateV2Value<DateV2ValueType>, DateValueType>) {
+                cs = cctz::civil_second(ts_value.year(), ts_value.month(), ts_value.day(), 0, 0,
+                                        0);
+            } else {
+                cs = cctz::civil_second(ts_value.year(), ts_value.month(), ts_value.day(),
+                                        ts_value.hour(), ts_value.minute(), ts_value.second());
             }
+            const auto converted = to_zone->to_civil(from_zone->to_timestamp(cs));
 
+            ReturnDateType ts_value2;
+            if constexpr (std::is_same_v<VecDateTimeValue, ReturnDateType>) {
+                ts_value2.set_time(converted.year(), converted.month(), converted.day(),
+                                   converted.hour(), converted.minute(), converted.second());
+            } else {
+                ts_value2.set_time(converted.year(), converted.month(), converted.day(),
+                                   converted.hour(), converted.minute(), converted.second(), 0);
+            }
             result_column->insert(binary_cast<ReturnDateType, ReturnNativeType>(ts_value2));
         }
     }
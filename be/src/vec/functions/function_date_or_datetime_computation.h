@@ -296,8 +296,41 @@ TIME_DIFF_FUNCTION_IMPL(SecondsDiffImpl, seconds_diff, SECOND);
 TIME_FUNCTION_TWO_ARGS_IMPL(ToYearWeekTwoArgsImpl, yearweek, year_week(mysql_week_mode(mode)));
 TIME_FUNCTION_TWO_ARGS_IMPL(ToWeekTwoArgsImpl, week, week(mysql_week_mode(mode)));
 
+template <typename Transform>
+struct IsDateDiffImpl : std::false_type {};
+
+template <typename DateType1, typename DateType2>
+struct IsDateDiffImpl<DateDiffImpl<DateType1, DateType2>> : std::true_type {};
+
 template <typename FromType1, typename FromType2, typename ToType, typename Transform>
 struct DateTimeOp {
+    // datediff only needs the day numbers of the dates, which are computed once for a run of the
+    // rows of the same date, `step1` is 0 if the second argument is a constant
+    template <typename ArgType2>
+    static void date_diff(const FromType1* from0, const ArgType2* from1, size_t step1,
+                          size_t size, ToType* to, UInt8* null_map) {
+        using DateValueType1 = typename Transform::DateValueType1;
+        using DateValueType2 = typename Transform::DateValueType2;
+        DatePartRunCache<FromType1, Int32> daynr0;
+        DatePartRunCache<ArgType2, Int32> daynr1;
+        auto get_daynr0 = [](FromType1 t) {
+            return (Int32)reinterpret_cast<const DateValueType1&>(t).daynr();
+        };
+        auto get_daynr1 = [](ArgType2 t) {
+            return (Int32)reinterpret_cast<const DateValueType2&>(t).daynr();
+        };
+        for (size_t i = 0; i < size; ++i, from1 += step1) {
+            bool is_null = !reinterpret_cast<const DateValueType1&>(from0[i]).is_valid_date() ||
+                           !reinterpret_cast<const DateValueType2&>(*from1).is_valid_date();
+            to[i] = daynr0.get(from0[i], get_daynr0) - daynr1.get(*from1, get_daynr1);
+            if (null_map != nullptr) {
+                null_map[i] = is_null;
+            } else {
+                DCHECK(!is_null);
+            }
+        }
+    }
+
     // use for (DateTime, DateTime) -> other_type
     static void vector_vector(const PaddedPODArray<FromType1>& vec_from0,
                               const PaddedPODArray<FromType2>& vec_from1,
@@ -306,6 +339,11 @@ struct DateTimeOp {
         vec_to.resize(size);
         null_map.resize_fill(size, false);
 
+        if constexpr (IsDateDiffImpl<Transform>::value) {
+            date_diff(vec_from0.data(), vec_from1.data(), 1, size, vec_to.data(),
+                      null_map.data());
+            return;
+        }
         for (size_t i = 0; i < size; ++i) {
             // here reinterpret_cast is used to convert uint8& to bool&,
             // otherwise it will be implicitly converted to bool, causing the rvalue to fail to match the lvalue.
@@ -320,6 +358,10 @@ struct DateTimeOp {
         size_t size = vec_from0.size();
         vec_to.resize(size);
 
+        if constexpr (IsDateDiffImpl<Transform>::value) {
+            date_diff(vec_from0.data(), vec_from1.data(), 1, size, vec_to.data(), nullptr);
+            return;
+        }
         bool invalid = true;
         for (size_t i = 0; i < size; ++i) {
             // here reinterpret_cast is used to convert uint8& to bool&,
@@ -362,6 +404,12 @@ struct DateTimeOp {
         vec_to.resize(size);
         null_map.resize_fill(size, false);
 
+        if constexpr (IsDateDiffImpl<Transform>::value) {
+            const auto from1 = static_cast<typename Transform::ArgType2>(delta);
+            date_diff(vec_from.data(), &from1, 0, size, vec_to.data(), null_map.data());
+            return;
+        }
+
         for (size_t i = 0; i < size; ++i) {
             vec_to[i] =
                     Transform::execute(vec_from[i], delta, reinterpret_cast<bool&>(null_map[i]));
@@ -372,6 +420,12 @@ struct DateTimeOp {
         size_t size = vec_from.size();
         vec_to.resize(size);
 
+        if constexpr (IsDateDiffImpl<Transform>::value) {
+            const auto from1 = static_cast<typename Transform::ArgType2>(delta);
+            date_diff(vec_from.data(), &from1, 0, size, vec_to.data(), nullptr);
+            return;
+        }
+
         bool invalid = true;
         for (size_t i = 0; i < size; ++i) {
             vec_to[i] = Transform::execute(vec_from[i], delta, invalid);
@@ -386,6 +440,12 @@ struct DateTimeOp {
         vec_to.resize(size);
         null_map.resize_fill(size, false);
 
+        if constexpr (IsDateDiffImpl<Transform>::value) {
+            const auto from1 = static_cast<typename Transform::ArgType2>(delta);
+            date_diff(vec_from.data(), &from1, 0, size, vec_to.data(), null_map.data());
+            return;
+        }
+
         for (size_t i = 0; i < size; ++i) {
             vec_to[i] =
                     Transform::execute(vec_from[i], delta, reinterpret_cast<bool&>(null_map[i]));
@@ -395,6 +455,12 @@ struct DateTimeOp {
                                 PaddedPODArray<ToType>& vec_to, Int64 delta) {
         size_t size = vec_from.size();
         vec_to.resize(size);
+
+        if constexpr (IsDateDiffImpl<Transform>::value) {
+            const auto from1 = static_cast<typename Transform::ArgType2>(delta);
+            date_diff(vec_from.data(), &from1, 0, size, vec_to.data(), nullptr);
+            return;
+        }
         bool invalid = true;
 
         for (size_t i = 0; i < size; ++i) {
@@ -305,6 +305,20 @@ public:
 
     bool use_default_implementation_for_constants() const override { return true; }
 
+    // The constant path is parsed once, instead of for every row.
+    Status open(FunctionContext* context, FunctionContext::FunctionStateScope scope) override {
+        if (scope != FunctionContext::THREAD_LOCAL || !context->is_col_constant(1)) {
+            return Status::OK();
+        }
+        const auto& path_column = context->get_constant_col(1)->column_ptr;
+        if (path_column->is_null_at(0)) {
+            return Status::OK();
+        }
+        StringRef path = path_column->get_data_at(0);
+        context->set_function_state(scope, std::make_shared<JsonbPath>(path.data, path.size));
+        return Status::OK();
+    }
+
     Status execute_impl(FunctionContext* context, Block& block, const ColumnNumbers& arguments,
                         size_t result, size_t input_rows_count) override {
         auto null_map = ColumnUInt8::create(input_rows_count, 0);
@@ -334,16 +348,19 @@ public:
         auto& rdata = jsonb_path_column->get_chars();
         auto& roffsets = jsonb_path_column->get_offsets();
 
+        const auto* const_path = reinterpret_cast<const JsonbPath*>(
+                context->get_function_state(FunctionContext::THREAD_LOCAL));
+
         // execute Impl
         if constexpr (std::is_same_v<typename Impl::ReturnType, DataTypeString> ||
                       std::is_same_v<typename Impl::ReturnType, DataTypeJsonb>) {
             auto& res_data = res->get_chars();
             auto& res_offsets = res->get_offsets();
-            Impl::vector_vector(context, ldata, loffsets, rdata, roffsets, res_data, res_offsets,
-                                null_map->get_data());
+            Impl::vector_vector(context, ldata, loffsets, rdata, roffsets, const_path, res_data,
+                                res_offsets, null_map->get_data());
         } else {
-            Impl::vector_vector(context, ldata, loffsets, rdata, roffsets, res->get_data(),
-                                null_map->get_data());
+            Impl::vector_vector(context, ldata, loffsets, rdata, roffsets, const_path,
+                                res->get_data(), null_map->get_data());
         }
         block.get_by_position(result).column =
                 ColumnNullable::create(std::move(res), std::move(null_map));
@@ -361,8 +378,9 @@ struct JsonbExtractStringImpl {
     static void vector_vector(FunctionContext* context, const ColumnString::Chars& ldata,
                               const ColumnString::Offsets& loffsets,
                               const ColumnString::Chars& rdata,
-                              const ColumnString::Offsets& roffsets, ColumnString::Chars& res_data,
-                              ColumnString::Offsets& res_offsets, NullMap& null_map) {
+                              const ColumnString::Offsets& roffsets, const JsonbPath* const_path,
+                              ColumnString::Chars& res_data, ColumnString::Offsets& res_offsets,
+                              NullMap& null_map) {
         size_t input_rows_count = loffsets.size();
         res_offsets.resize(input_rows_count);
 
@@ -379,7 +397,6 @@ struct JsonbExtractStringImpl {
 
             int r_size = roffsets[i] - roffsets[i - 1];
             const auto r_raw = reinterpret_cast<const char*>(&rdata[roffsets[i - 1]]);
-            String path(r_raw, r_size);
 
             if (null_map[i]) {
                 StringOP::push_null_string(i, res_data, res_offsets, null_map);
@@ -394,7 +411,8 @@ struct JsonbExtractStringImpl {
             }
 
             // value is NOT necessary to be deleted since JsonbValue will not allocate memory
-            JsonbValue* value = doc->getValue()->findPath(r_raw, r_size, ".", nullptr);
+            JsonbValue* value = const_path ? doc->getValue()->findPath(*const_path)
+                                           : doc->getValue()->findPath(r_raw, r_size, ".", nullptr);
             if (UNLIKELY(!value)) {
                 StringOP::push_null_string(i, res_data, res_offsets, null_map);
                 continue;
@@ -462,8 +480,8 @@ struct JsonbExtractImpl {
     static void vector_vector(FunctionContext* context, const ColumnString::Chars& ldata,
                               const ColumnString::Offsets& loffsets,
                               const ColumnString::Chars& rdata,
-                              const ColumnString::Offsets& roffsets, Container& res,
-                              NullMap& null_map) {
+                              const ColumnString::Offsets& roffsets, const JsonbPath* const_path,
+                              Container& res, NullMap& null_map) {
         size_t size = loffsets.size();
         res.resize(size);
 
@@ -492,7 +510,9 @@ struct JsonbExtractImpl {
             }
 
             // value is NOT necessary to be deleted since JsonbValue will not allocate memory
-            JsonbValue* value = doc->getValue()->findPath(r_raw_str, r_str_size, ".", nullptr);
+            JsonbValue* value =
+                    const_path ? doc->getValue()->findPath(*const_path)
+                               : doc->getValue()->findPath(r_raw_str, r_str_size, ".", nullptr);
             if (UNLIKELY(!value)) {
                 if constexpr (!only_check_exists) {
                     null_map[i] = 1;
@@ -145,8 +145,7 @@ public:
                 block.get_by_position(arguments.back()).column);
         if (compression_arg) {
             auto compression_arg_val = compression_arg->get_value<Float32>();
-            if (compression_arg_val && compression_arg_val >= QUANTILE_STATE_COMPRESSION_MIN &&
-                compression_arg_val <= QUANTILE_STATE_COMPRESSION_MAX) {
+            if (is_valid_quantile_state_compression(compression_arg_val)) {
                 this->compression = compression_arg_val;
             }
         }
@@ -89,12 +89,7 @@ inline size_t get_char_len(const StringRef& str, std::vector<size_t>* str_index)
 }
 
 inline size_t get_char_len(const StringRef& str, size_t end_pos) {
-    size_t char_len = 0;
-    for (size_t i = 0, char_size = 0; i < std::min(str.size, end_pos); i += char_size) {
-        char_size = UTF8_BYTE_LENGTH[(unsigned char)(str.data)[i]];
-        ++char_len;
-    }
-    return char_len;
+    return simd::VStringFunctions::get_char_len(str.data, std::min(str.size, end_pos));
 }
 
 struct StringOP {
@@ -166,7 +161,6 @@ private:
 
         std::array<std::byte, 128 * 1024> buf;
         PMR::monotonic_buffer_resource pool {buf.data(), buf.size()};
-        PMR::vector<size_t> index {&pool};
 
         PMR::vector<std::pair<const unsigned char*, int>> strs(&pool);
         strs.resize(size);
@@ -185,35 +179,27 @@ private:
                 continue;
             }
             // reference to string_function.cpp: substring
-            size_t byte_pos = 0;
-            index.clear();
-            for (size_t j = 0, char_size = 0; j < str_size; j += char_size) {
-                char_size = UTF8_BYTE_LENGTH[(unsigned char)(raw_str)[j]];
-                index.push_back(j);
-                if (start[i] > 0 && index.size() > start[i] + len[i]) {
-                    break;
-                }
-            }
-
+            const char* str_begin = reinterpret_cast<const char*>(raw_str);
+            const char* str_end = str_begin + str_size;
             int fixed_pos = start[i];
-            if (fixed_pos < -(int)index.size()) {
-                StringOP::push_empty_string(i, res_chars, res_offsets);
-                continue;
-            }
             if (fixed_pos < 0) {
-                fixed_pos = index.size() + fixed_pos + 1;
+                size_t char_len = simd::VStringFunctions::get_char_len(str_begin, str_size);
+                if (fixed_pos < -(int)char_len) {
+                    StringOP::push_empty_string(i, res_chars, res_offsets);
+                    continue;
+                }
+                fixed_pos = char_len + fixed_pos + 1;
             }
-            if (fixed_pos > index.size()) {
+            const char* sub_begin =
+                    simd::VStringFunctions::skip_chars(str_begin, str_end, fixed_pos - 1);
+            if (sub_begin == str_end) {
                 StringOP::push_null_string(i, res_chars, res_offsets, null_map);
                 continue;
             }
 
-            byte_pos = index[fixed_pos - 1];
-            int fixed_len = str_size - byte_pos;
-            if (fixed_pos + len[i] <= index.size()) {
-                fixed_len = index[fixed_pos + len[i] - 1] - byte_pos;
-            }
-
+            size_t byte_pos = sub_begin - str_begin;
+            int fixed_len = simd::VStringFunctions::skip_chars(sub_begin, str_end, len[i]) -
+                            sub_begin;
             if (byte_pos <= str_size && fixed_len > 0) {
                 // return StringRef(str.data + byte_pos, fixed_len);
                 StringOP::push_value_string(
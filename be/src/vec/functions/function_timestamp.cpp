@@ -252,17 +252,23 @@ struct DateTrunc {
         auto null_map = ColumnUInt8::create(input_rows_count, 0);
         argument_columns[0] =
                 block.get_by_position(arguments[0]).column->convert_to_full_column_if_const();
-        argument_columns[1] =
-                block.get_by_position(arguments[1]).column->convert_to_full_column_if_const();
         auto datetime_column = static_cast<const ColumnVector<ArgType>*>(argument_columns[0].get());
-        auto str_column = static_cast<const ColumnString*>(argument_columns[1].get());
-        auto& rdata = str_column->get_chars();
-        auto& roffsets = str_column->get_offsets();
-
         ColumnPtr res = ColumnVector<ArgType>::create();
-        executeImpl(datetime_column->get_data(), rdata, roffsets,
-                    static_cast<ColumnVector<ArgType>*>(res->assume_mutable().get())->get_data(),
-                    null_map->get_data(), input_rows_count);
+        auto& res_data =
+                static_cast<ColumnVector<ArgType>*>(res->assume_mutable().get())->get_data();
+
+        const auto& unit_column = block.get_by_position(arguments[1]).column;
+        if (const auto* const_unit = check_and_get_column<ColumnConst>(unit_column.get())) {
+            // the unit is mostly a constant, which is only parsed once
+            execute_const_unit(datetime_column->get_data(), const_unit->get_data_at(0), res_data,
+                               null_map->get_data(), input_rows_count);
+        } else {
+            argument_columns[1] = unit_column->convert_to_full_column_if_const();
+            auto str_column = static_cast<const ColumnString*>(argument_columns[1].get());
+            executeImpl(datetime_column->get_data(), str_column->get_chars(),
+                        str_column->get_offsets(), res_data, null_map->get_data(),
+                        input_rows_count);
+        }
 
         block.get_by_position(result).column =
                 ColumnNullable::create(std::move(res), std::move(null_map));
@@ -296,6 +302,56 @@ struct DateTrunc {
             res[i] = binary_cast<DateValueType, ArgType>(dt);
         }
     }
+
+    static void execute_const_unit(const PaddedPODArray<ArgType>& ldata, StringRef unit,
+                                   PaddedPODArray<ArgType>& res, NullMap& null_map,
+                                   size_t input_rows_count) {
+        const char* str_data = unit.data;
+        if (std::strncmp("year", str_data, 4) == 0) {
+            execute_unit<YEAR>(ldata, res, null_map, input_rows_count);
+        } else if (std::strncmp("quarter", str_data, 7) == 0) {
+            execute_unit<QUARTER>(ldata, res, null_map, input_rows_count);
+        } else if (std::strncmp("month", str_data, 5) == 0) {
+            execute_unit<MONTH>(ldata, res, null_map, input_rows_count);
+        } else if (std::strncmp("day", str_data, 3) == 0) {
+            execute_unit<DAY>(ldata, res, null_map, input_rows_count);
+        } else if (std::strncmp("hour", str_data, 4) == 0) {
+            execute_unit<HOUR>(ldata, res, null_map, input_rows_count);
+        } else if (std::strncmp("minute", str_data, 6) == 0) {
+            execute_unit<MINUTE>(ldata, res, null_map, input_rows_count);
+        } else if (std::strncmp("second", str_data, 6) == 0) {
+            execute_unit<SECOND>(ldata, res, null_map, input_rows_count);
+        } else {
+            res.resize_fill(input_rows_count, 0);
+            null_map.assign(input_rows_count, (UInt8)1);
+        }
+    }
+
+    template <TimeUnit unit>
+    static void execute_unit(const PaddedPODArray<ArgType>& ldata, PaddedPODArray<ArgType>& res,
+                             NullMap& null_map, size_t input_rows_count) {
+        res.resize(input_rows_count);
+        // truncating to a day or a coarser unit only depends on the date part, which is only
+        // done once for a run of the rows of the same date
+        constexpr bool date_part_unit = unit == DAY || unit == MONTH || unit == QUARTER ||
+                                        unit == YEAR;
+        DatePartRunCache<ArgType, ArgType> cache;
+        auto trunc = [](ArgType t) {
+            auto dt = binary_cast<ArgType, DateValueType>(t);
+            dt.template datetime_trunc<unit>();
+            return binary_cast<DateValueType, ArgType>(dt);
+        };
+        for (size_t i = 0; i < input_rows_count; ++i) {
+            auto dt = binary_cast<ArgType, DateValueType>(ldata[i]);
+            if constexpr (date_part_unit) {
+                null_map[i] = !dt.is_valid_date();
+                res[i] = null_map[i] ? ldata[i] : cache.get(ldata[i], trunc);
+            } else {
+                null_map[i] = !dt.template datetime_trunc<unit>();
+                res[i] = binary_cast<DateValueType, ArgType>(dt);
+            }
+        }
+    }
 };
 
 class FromDays : public IFunction {
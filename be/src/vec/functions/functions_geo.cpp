@@ -184,10 +184,9 @@ struct StDistanceSphere {
 
         for (int row = 0; row < size; ++row) {
             double distance = 0;
-            if (!GeoPoint::ComputeDistance(x_lng->operator[](row).get<Float64>(),
-                                           x_lat->operator[](row).get<Float64>(),
-                                           y_lng->operator[](row).get<Float64>(),
-                                           y_lat->operator[](row).get<Float64>(), &distance)) {
+            if (!GeoPoint::ComputeDistance(x_lng->get_float64(row), x_lat->get_float64(row),
+                                           y_lng->get_float64(row), y_lat->get_float64(row),
+                                           &distance)) {
                 res->insert_data(nullptr, 0);
                 continue;
             }
@@ -218,10 +217,9 @@ struct StAngleSphere {
 
         for (int row = 0; row < size; ++row) {
             double angle = 0;
-            if (!GeoPoint::ComputeAngle(x_lng->operator[](row).get<Float64>(),
-                                        x_lat->operator[](row).get<Float64>(),
-                                        y_lng->operator[](row).get<Float64>(),
-                                        y_lat->operator[](row).get<Float64>(), &angle)) {
+            if (!GeoPoint::ComputeAngle(x_lng->get_float64(row), x_lat->get_float64(row),
+                                        y_lng->get_float64(row), y_lat->get_float64(row),
+                                        &angle)) {
                 res->insert_data(nullptr, 0);
                 continue;
             }
@@ -358,29 +356,53 @@ struct StContains {
                           size_t result) {
         DCHECK_EQ(arguments.size(), 2);
         auto return_type = block.get_data_type(result);
-        auto shape1 = block.get_by_position(arguments[0]).column->convert_to_full_column_if_const();
-        auto shape2 = block.get_by_position(arguments[1]).column->convert_to_full_column_if_const();
+        auto* state = reinterpret_cast<StContainsState*>(
+                context->get_function_state(FunctionContext::THREAD_LOCAL));
 
-        const auto size = shape1->size();
+        const auto size = block.get_by_position(arguments[0]).column->size();
         MutableColumnPtr res = return_type->create_column();
+        if (state != nullptr && state->is_null) {
+            res->insert_many_defaults(size);
+            block.replace_by_position(result, std::move(res));
+            return Status::OK();
+        }
+
+        ColumnPtr columns[2];
+        const GeoShape* shapes[2] = {nullptr, nullptr};
+        for (int i = 0; i < 2; ++i) {
+            if (state != nullptr && state->shapes[i] != nullptr) {
+                shapes[i] = state->shapes[i].get();
+            } else {
+                columns[i] = block.get_by_position(arguments[i])
+                                     .column->convert_to_full_column_if_const();
+            }
+        }
 
+        // the points, which are the most common shapes in a column, are decoded into the same
+        // object instead of a new shape for each row
+        GeoPoint points[2];
+        std::unique_ptr<GeoShape> decoded[2];
         int i;
-        std::vector<std::shared_ptr<GeoShape>> shapes = {nullptr, nullptr};
         for (int row = 0; row < size; ++row) {
-            auto lhs_value = shape1->get_data_at(row);
-            auto rhs_value = shape2->get_data_at(row);
-            StringRef* strs[2] = {&lhs_value, &rhs_value};
             for (i = 0; i < 2; ++i) {
-                shapes[i] = std::shared_ptr<GeoShape>(
-                        GeoShape::from_encoded(strs[i]->data, strs[i]->size));
-                if (shapes[i] == nullptr) {
+                if (columns[i] == nullptr) {
+                    continue;
+                }
+                auto value = columns[i]->get_data_at(row);
+                if (points[i].decode_from(value.data, value.size)) {
+                    shapes[i] = &points[i];
+                    continue;
+                }
+                decoded[i].reset(GeoShape::from_encoded(value.data, value.size));
+                if (decoded[i] == nullptr) {
                     res->insert_data(nullptr, 0);
                     break;
                 }
+                shapes[i] = decoded[i].get();
             }
 
             if (i == 2) {
-                auto contains_value = shapes[0]->contains(shapes[1].get());
+                auto contains_value = shapes[0]->contains(shapes[1]);
                 res->insert_data(const_cast<const char*>((char*)&contains_value), 0);
             }
         }
@@ -388,14 +410,37 @@ struct StContains {
         return Status::OK();
     }
 
+    // The constant shapes, e.g. the fence of a geo-fence query, are decoded once instead of for
+    // each row.
     static Status open(FunctionContext* context, FunctionContext::FunctionStateScope scope) {
+        if (scope != FunctionContext::THREAD_LOCAL) {
+            return Status::OK();
+        }
+        std::shared_ptr<StContainsState> state = std::make_shared<StContainsState>();
+        context->set_function_state(scope, state);
+        for (int i = 0; i < 2; ++i) {
+            if (!context->is_col_constant(i)) {
+                continue;
+            }
+            const auto& column = context->get_constant_col(i)->column_ptr;
+            if (column->is_null_at(0)) {
+                state->is_null = true;
+                return Status::OK();
+            }
+            auto value = column->get_data_at(0);
+            state->shapes[i].reset(GeoShape::from_encoded(value.data, value.size));
+            if (state->shapes[i] == nullptr) {
+                state->is_null = true;
+                return Status::OK();
+            }
+        }
         return Status::OK();
     }
 
     static Status close(FunctionContext* context, FunctionContext::FunctionStateScope scope) {
         return Status::OK();
     }
-}; // namespace doris::vectorized
+};
 
 struct StGeometryFromText {
     static constexpr auto NAME = "st_geometryfromtext";
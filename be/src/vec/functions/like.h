@@ -228,6 +228,10 @@ public:
 
     friend struct LikeSearchState;
 
+    // Converts a LIKE pattern to the regex matched by hyperscan.
+    static void convert_like_pattern(LikeSearchState* state, const std::string& pattern,
+                                     std::string* re_pattern);
+
 private:
     static Status like_fn(LikeSearchState* state, const ColumnString& val, const StringRef& pattern,
                           ColumnUInt8::Container& result);
@@ -240,9 +244,6 @@ private:
     static Status like_fn_scalar(LikeSearchState* state, const StringRef& val,
                                  const StringRef& pattern, unsigned char* result);
 
-    static void convert_like_pattern(LikeSearchState* state, const std::string& pattern,
-                                     std::string* re_pattern);
-
     static void remove_escape_character(std::string* search_string);
 };
 
@@ -330,4 +330,35 @@ void JsonbSerializeUtil::jsonb_to_block(const TupleDescriptor& desc, const char*
     }
 }
 
+// single row, projected
+void JsonbSerializeUtil::jsonb_to_block(const TupleDescriptor& desc, const char* data, size_t size,
+                                        const std::vector<int>& col_uid_to_pos, Block& dst) {
+    size_t num_rows = dst.rows();
+    auto pdoc = JsonbDocument::createDocument(data, size);
+    JsonbDocument& doc = *pdoc;
+    // walk through the fields once instead of searching the fields of each slot
+    for (auto it = doc->begin(); it != doc->end(); ++it) {
+        if (it->klen()) {
+            continue;
+        }
+        auto col_uid = it->getKeyId();
+        if (col_uid >= col_uid_to_pos.size() || col_uid_to_pos[col_uid] < 0) {
+            continue;
+        }
+        int pos = col_uid_to_pos[col_uid];
+        JsonbValue* slot_value = it->value();
+        if (slot_value->isNull()) {
+            continue;
+        }
+        MutableColumnPtr dst_column = dst.get_by_position(pos).column->assume_mutable();
+        deserialize_column(desc.slots()[pos]->type().type, slot_value, dst_column);
+    }
+    // null, not exist or not needed
+    for (int j = 0; j < desc.slots().size(); ++j) {
+        if (dst.get_by_position(j).column->size() == num_rows) {
+            dst.get_by_position(j).column->assume_mutable()->insert_default();
+        }
+    }
+}
+
 } // namespace doris::vectorized
\ No newline at end of file
@@ -31,5 +31,10 @@ public:
     // single row
     static void jsonb_to_block(const TupleDescriptor& desc, const char* data, size_t size,
                                Block& dst);
+    // single row, only decode the fields of the columns in col_uid_to_pos, which maps from the
+    // col_unique_id of a slot to its position in dst, or -1 if the column is not needed.
+    // The other columns are filled with default values.
+    static void jsonb_to_block(const TupleDescriptor& desc, const char* data, size_t size,
+                               const std::vector<int>& col_uid_to_pos, Block& dst);
 };
 } // namespace doris::vectorized
\ No newline at end of file
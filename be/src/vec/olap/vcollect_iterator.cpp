@@ -17,6 +17,9 @@
 
 #include "vec/olap/vcollect_iterator.h"
 
+#include <algorithm>
+#include <string>
+
 #include "common/status.h"
 #include "util/defer_op.h"
 
@@ -33,6 +36,51 @@ namespace vectorized {
         }                                                              \
     } while (false)
 
+// Groups the rowsets by the overlaps of their key ranges, then the groups are in the order of the
+// keys and can be read one by one. Returns false if the key range of any rowset is unknown.
+static bool group_by_key_bounds(const std::vector<RowsetReaderSharedPtr>& rs_readers,
+                                std::vector<std::vector<size_t>>* groups) {
+    struct KeyRange {
+        std::string min_key;
+        std::string max_key;
+        size_t index;
+    };
+    std::vector<KeyRange> ranges;
+    for (size_t i = 0; i < rs_readers.size(); ++i) {
+        std::vector<KeyBoundsPB> segments_key_bounds;
+        rs_readers[i]->rowset()->rowset_meta()->get_segments_key_bounds(&segments_key_bounds);
+        if (segments_key_bounds.empty()) {
+            return false;
+        }
+        // the segments may overlap with each other
+        KeyRange range {segments_key_bounds[0].min_key(), segments_key_bounds[0].max_key(), i};
+        for (const auto& key_bounds : segments_key_bounds) {
+            range.min_key = std::min(range.min_key, key_bounds.min_key());
+            range.max_key = std::max(range.max_key, key_bounds.max_key());
+        }
+        ranges.push_back(std::move(range));
+    }
+    std::sort(ranges.begin(), ranges.end(),
+              [](const KeyRange& lhs, const KeyRange& rhs) { return lhs.min_key < rhs.min_key; });
+
+    const std::string* group_max_key = nullptr;
+    for (const auto& range : ranges) {
+        // the same key in two rowsets has to be merged
+        if (group_max_key == nullptr || range.min_key > *group_max_key) {
+            groups->emplace_back();
+            group_max_key = &range.max_key;
+        } else if (range.max_key > *group_max_key) {
+            group_max_key = &range.max_key;
+        }
+        groups->back().push_back(range.index);
+    }
+    // the rowsets of the same group are kept in the order of the versions
+    for (auto& group : *groups) {
+        std::sort(group.begin(), group.end());
+    }
+    return true;
+}
+
 VCollectIterator::~VCollectIterator() {
     for (auto child : _children) {
         delete child;
@@ -112,9 +160,33 @@ Status VCollectIterator::build_heap(std::vector<RowsetReaderSharedPtr>& rs_reade
             }
         }
 
-        // build merge heap with two children, a base rowset as level0iterator and
-        // other cumulative rowsets as a level1iterator
-        if (_children.size() > 1) {
+        std::vector<std::vector<size_t>> groups;
+        if (_children.size() > 1 && group_by_key_bounds(rs_readers, &groups) &&
+            groups.size() > 1) {
+            // only the rowsets overlapping with each other are merged, and the groups of
+            // them are read one after another
+            std::vector<LevelIterator*> children(_children.begin(), _children.end());
+            if (_is_reverse) {
+                std::reverse(groups.begin(), groups.end());
+            }
+            std::list<std::vector<LevelIterator*>> pending_groups;
+            for (const auto& group : groups) {
+                auto& group_children = pending_groups.emplace_back();
+                for (size_t index : group) {
+                    group_children.push_back(children[index]);
+                }
+            }
+            std::list<LevelIterator*> first_group(pending_groups.front().begin(),
+                                                  pending_groups.front().end());
+            pending_groups.pop_front();
+            auto level1_iter =
+                    new Level1Iterator(first_group, _reader, _merge, _is_reverse, _skip_same);
+            level1_iter->set_pending_groups(std::move(pending_groups));
+            _inner_iter.reset(level1_iter);
+            _children.clear();
+        } else if (_children.size() > 1) {
+            // build merge heap with two children, a base rowset as level0iterator and
+            // other cumulative rowsets as a level1iterator
             // find 'base rowset', 'base rowset' is the rowset which contains the max row number
             int64_t max_row_num = 0;
             int base_reader_idx = 0;
@@ -545,14 +617,19 @@ VCollectIterator::Level1Iterator::~Level1Iterator() {
     }
 
     if (_heap) {
-        while (!_heap->empty()) {
-            auto child = _heap->top();
-            _heap->pop();
-            if (child) {
-                delete child;
+        // the exhausted children have been deleted
+        auto& children = _heap->inputs();
+        for (size_t i = 0; i < children.size(); ++i) {
+            if (!_heap->exhausted(i)) {
+                delete children[i];
             }
         }
     }
+    for (auto& group : _pending_groups) {
+        for (auto child : group) {
+            delete child;
+        }
+    }
 }
 
 // Read next row into *row.
@@ -601,7 +678,7 @@ Status VCollectIterator::Level1Iterator::init(bool get_data_by_ref) {
     }
 
     // Only when there are multiple children that need to be merged
-    if (_merge && _children.size() > 1) {
+    if (_merge && (_children.size() > 1 || !_pending_groups.empty())) {
         auto sequence_loc = -1;
         for (int loc = 0; loc < _reader->_return_columns.size(); loc++) {
             if (_reader->_return_columns[loc] == _reader->_sequence_col_idx) {
@@ -609,12 +686,8 @@ Status VCollectIterator::Level1Iterator::init(bool get_data_by_ref) {
                 break;
             }
         }
-        _heap.reset(new MergeHeap {LevelIteratorComparator(sequence_loc, _is_reverse)});
-        for (auto child : _children) {
-            DCHECK(child != nullptr);
-            //DCHECK(child->current_row().ok());
-            _heap->push(child);
-        }
+        _heap.reset(new MergeTree {LevelIteratorComparator(sequence_loc, _is_reverse)});
+        _heap->init(std::vector<LevelIterator*>(_children.begin(), _children.end()));
         _cur_child = _heap->top();
         // Clear _children earlier to release any related references
         _children.clear();
@@ -649,14 +722,19 @@ Status VCollectIterator::Level1Iterator::init_level0_iterators_for_union() {
 }
 
 Status VCollectIterator::Level1Iterator::_merge_next(IteratorRowRef* ref) {
-    _heap->pop();
     auto res = _cur_child->next(ref);
     if (LIKELY(res.ok())) {
-        _heap->push(_cur_child);
-        _cur_child = _heap->top();
+        if (!_heap->update_top()) {
+            _cur_child = _heap->top();
+        }
     } else if (res.is<END_OF_FILE>()) {
         // current child has been read, to read next
+        _heap->pop_top();
         delete _cur_child;
+        if (_heap->empty() && !_pending_groups.empty()) {
+            _heap->init(std::move(_pending_groups.front()));
+            _pending_groups.pop_front();
+        }
         if (!_heap->empty()) {
             _cur_child = _heap->top();
         } else {
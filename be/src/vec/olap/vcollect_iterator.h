@@ -18,15 +18,10 @@
 #pragma once
 
 #include "common/status.h"
-#ifdef USE_LIBCPP
-#include <queue>
-#else
-#include <ext/pb_ds/priority_queue.hpp>
-#endif
-
 #include "olap/reader.h"
 #include "olap/rowset/rowset_reader.h"
 #include "vec/core/block.h"
+#include "vec/core/loser_tree.h"
 
 namespace doris {
 
@@ -97,7 +92,7 @@ private:
     // This interface is the actual implementation of the new version of iterator.
     // It currently contains two implementations, one is Level0Iterator,
     // which only reads data from the rowset reader, and the other is Level1Iterator,
-    // which can read merged data from multiple LevelIterators through MergeHeap.
+    // which can read merged data from multiple LevelIterators through MergeTree.
     // By using Level1Iterator, some rowset readers can be merged in advance and
     // then merged with other rowset readers.
     class LevelIterator {
@@ -156,13 +151,7 @@ private:
         bool _is_reverse = false;
     };
 
-#ifdef USE_LIBCPP
-    using MergeHeap = std::priority_queue<LevelIterator*, std::vector<LevelIterator*>,
-                                          LevelIteratorComparator>;
-#else
-    using MergeHeap = __gnu_pbds::priority_queue<LevelIterator*, LevelIteratorComparator,
-                                                 __gnu_pbds::pairing_heap_tag>;
-#endif
+    using MergeTree = LoserTree<LevelIterator*, LevelIteratorComparator>;
 
     // Iterate from rowset reader. This Iterator usually like a leaf node
     class Level0Iterator : public LevelIterator {
@@ -270,6 +259,12 @@ private:
 
         Status init_level0_iterators_for_union();
 
+        // The groups of children merged after the current ones, whose keys are all greater (or
+        // less if reversed) than the keys of the former groups.
+        void set_pending_groups(std::list<std::vector<LevelIterator*>> groups) {
+            _pending_groups = std::move(groups);
+        }
+
     private:
         Status _merge_next(IteratorRowRef* ref);
 
@@ -298,7 +293,8 @@ private:
 
         bool _skip_same;
         // used when `_merge == true`
-        std::unique_ptr<MergeHeap> _heap;
+        std::unique_ptr<MergeTree> _heap;
+        std::list<std::vector<LevelIterator*>> _pending_groups;
 
         std::vector<RowLocation> _block_row_locations;
     };
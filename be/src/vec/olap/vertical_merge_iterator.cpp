@@ -67,16 +67,28 @@ Status RowSourcesBuffer::append(const std::vector<RowSource>& row_sources) {
 Status RowSourcesBuffer::seek_to_begin() {
     _buf_idx = 0;
     if (_fd > 0) {
-        auto offset = lseek(_fd, 0, SEEK_SET);
-        if (offset != 0) {
-            LOG(WARNING) << "failed to seek to 0";
-            return Status::InternalError("failed to seek to 0");
-        }
+        _read_offset = 0;
         _reset_buffer();
     }
     return Status::OK();
 }
 
+Status RowSourcesBuffer::create_reader(std::unique_ptr<RowSourcesBuffer>* reader) const {
+    reader->reset(new RowSourcesBuffer(_tablet_id, _tablet_path, _reader_type));
+    (*reader)->_total_size = _total_size;
+    if (_fd > 0) {
+        DCHECK(_buffer->empty()) << "row sources buffer is not flushed";
+        (*reader)->_fd = ::dup(_fd);
+        if ((*reader)->_fd < 0) {
+            LOG(WARNING) << "failed to dup row sources buffer file, errno=" << errno;
+            return Status::InternalError("failed to dup row sources buffer file");
+        }
+    } else {
+        (*reader)->_buffer->insert_range_from(*_buffer, 0, _buffer->size());
+    }
+    return Status::OK();
+}
+
 Status RowSourcesBuffer::has_remaining() {
     if (_buf_idx < _buffer->size()) {
         return Status::OK();
@@ -191,7 +203,7 @@ Status RowSourcesBuffer::_serialize() {
 
 Status RowSourcesBuffer::_deserialize() {
     size_t rows = 0;
-    ssize_t bytes_read = ::read(_fd, &rows, sizeof(rows));
+    ssize_t bytes_read = ::pread(_fd, &rows, sizeof(rows), _read_offset);
     if (bytes_read == 0) {
         LOG(WARNING) << "end of row source buffer file";
         return Status::EndOfFile("end of row source buffer file");
@@ -201,12 +213,14 @@ Status RowSourcesBuffer::_deserialize() {
     }
     _buffer->resize(rows);
     auto& internal_data = _buffer->get_data();
-    bytes_read = ::read(_fd, internal_data.data(), rows * sizeof(UInt16));
+    _read_offset += sizeof(rows);
+    bytes_read = ::pread(_fd, internal_data.data(), rows * sizeof(UInt16), _read_offset);
     if (bytes_read != rows * sizeof(UInt16)) {
         LOG(WARNING) << "failed to read buffer data from file, bytes_read=" << bytes_read
                      << ", expect bytes=" << rows * sizeof(UInt16);
         return Status::InternalError("failed to read buffer data from file");
     }
+    _read_offset += bytes_read;
     return Status::OK();
 }
 
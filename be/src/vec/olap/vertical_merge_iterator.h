@@ -102,6 +102,10 @@ public:
 
     Status seek_to_begin();
 
+    // Create a reader from the begin of the flushed row sources, which reads independently
+    // of this buffer, so the value column groups can be merged concurrently.
+    Status create_reader(std::unique_ptr<RowSourcesBuffer>* reader) const;
+
     size_t same_source_count(uint16_t source, size_t limit);
 
     // return continous agg_flag=true count from index
@@ -122,6 +126,8 @@ private:
     ReaderType _reader_type;
     uint64_t _buf_idx = 0;
     int _fd = -1;
+    // the file is read by pread, so the readers sharing the file have their own offsets
+    off_t _read_offset = 0;
     ColumnUInt16::MutablePtr _buffer;
     uint64_t _total_size = 0;
 };
@@ -53,6 +53,7 @@ struct SharedHashTableContext {
 
     Status status;
     std::shared_ptr<Arena> arena;
+    std::vector<std::shared_ptr<Arena>> partition_arenas;
     std::shared_ptr<void> hash_table_variants;
     std::shared_ptr<std::vector<Block>> blocks;
     std::map<int, SharedRuntimeFilterContext> runtime_filters;
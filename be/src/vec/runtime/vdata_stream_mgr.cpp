@@ -114,6 +114,12 @@ Status VDataStreamMgr::transmit_block(const PTransmitDataParams* request,
         recvr->add_block(request->block(), request->sender_id(), request->be_number(),
                          request->packet_seq(), eos ? nullptr : done);
     }
+    for (int i = 0; i < request->blocks_size(); ++i) {
+        // only the last block can delay the response
+        bool last = i == request->blocks_size() - 1;
+        recvr->add_block(request->blocks(i), request->sender_id(), request->be_number(),
+                         request->packet_seq() + i, (eos || !last) ? nullptr : done);
+    }
 
     if (eos) {
         recvr->remove_sender(request->sender_id(), request->be_number());
@@ -95,11 +95,51 @@ Status VDataStreamRecvr::SenderQueue::_inner_get_batch(Block* block, bool* eos)
         closure_pair.second.stop();
         _recvr->_buffer_full_total_timer->update(closure_pair.second.elapsed_time());
     }
+    // The columns of a broadcast local block are shared by the local receivers, copy them if
+    // they are still shared, so that they can be mutated in place after they are returned.
+    for (size_t i = 0; i < next_block->columns(); ++i) {
+        auto& column = next_block->get_by_position(i).column;
+        if (!column->is_exclusive()) {
+            column = std::move(*column).mutate();
+        }
+    }
     block->swap(*next_block);
+    // The consumer gives back its previous block by the swap.
+    _return_free_block(std::move(next_block));
     *eos = false;
     return Status::OK();
 }
 
+BlockUPtr VDataStreamRecvr::SenderQueue::_get_free_block() {
+    {
+        std::lock_guard<std::mutex> l(_free_blocks_lock);
+        if (!_free_blocks.empty()) {
+            auto block = std::move(_free_blocks.back());
+            _free_blocks.pop_back();
+            return block;
+        }
+    }
+    return std::make_unique<Block>();
+}
+
+void VDataStreamRecvr::SenderQueue::_return_free_block(BlockUPtr block) {
+    if (block->columns() == 0) {
+        return;
+    }
+    // The columns still referenced by the consumer can not be reused.
+    for (size_t i = 0; i < block->columns(); ++i) {
+        const auto& column = block->get_by_position(i).column;
+        if (column == nullptr || !column->is_exclusive()) {
+            return;
+        }
+    }
+    block->clear_column_data();
+    std::lock_guard<std::mutex> l(_free_blocks_lock);
+    if (_free_blocks.size() < MAX_FREE_BLOCKS) {
+        _free_blocks.emplace_back(std::move(block));
+    }
+}
+
 void VDataStreamRecvr::SenderQueue::add_block(const PBlock& pblock, int be_number,
                                               int64_t packet_seq,
                                               ::google::protobuf::Closure** done) {
@@ -136,11 +176,11 @@ void VDataStreamRecvr::SenderQueue::add_block(const PBlock& pblock, int be_numbe
         }
     }
 
-    BlockUPtr block = nullptr;
+    BlockUPtr block = _get_free_block();
     int64_t deserialize_time = 0;
     {
         SCOPED_RAW_TIMER(&deserialize_time);
-        block.reset(new Block(pblock));
+        block->deserialize(pblock);
     }
 
     auto block_byte_size = block->allocated_bytes();
@@ -167,6 +207,7 @@ void VDataStreamRecvr::SenderQueue::add_block(const PBlock& pblock, int be_numbe
     }
     _recvr->_blocks_memory_usage->add(block_byte_size);
     _data_arrival_cv.notify_one();
+    _notify_read_dependency();
 }
 
 void VDataStreamRecvr::SenderQueue::add_block(Block* block, bool use_move) {
@@ -206,6 +247,7 @@ void VDataStreamRecvr::SenderQueue::add_block(Block* block, bool use_move) {
     _block_queue.emplace_back(std::move(nblock), block_mem_size);
     _update_block_queue_empty();
     _data_arrival_cv.notify_one();
+    _notify_read_dependency();
 
     if (_recvr->exceeds_limit(block_mem_size)) {
         // yiguolei
@@ -237,6 +279,7 @@ void VDataStreamRecvr::SenderQueue::decrement_senders(int be_number) {
               << " node_id=" << _recvr->dest_node_id() << " #senders=" << _num_remaining_senders;
     if (_num_remaining_senders == 0) {
         _data_arrival_cv.notify_one();
+        _notify_read_dependency();
     }
 }
 
@@ -253,6 +296,7 @@ void VDataStreamRecvr::SenderQueue::cancel() {
     // Wake up all threads waiting to produce/consume batches.  They will all
     // notice that the stream is cancelled and handle it.
     _data_arrival_cv.notify_all();
+    _notify_read_dependency();
     // _data_removal_cv.notify_all();
     // PeriodicCounterUpdater::StopTimeSeriesCounter(
     //         _recvr->_bytes_received_time_series_counter);
@@ -308,6 +352,10 @@ VDataStreamRecvr::VDataStreamRecvr(
                                          _profile, nullptr, "PeakMemoryUsage");
     SCOPED_CONSUME_MEM_TRACKER(_mem_tracker.get());
 
+    if (_enable_pipeline) {
+        _read_dependency = std::make_unique<pipeline::Dependency>();
+    }
+
     // Create one queue per sender if is_merging is true.
     int num_queues = is_merging ? num_senders : 1;
     _sender_queues.reserve(num_queues);
@@ -27,6 +27,7 @@
 #include "common/object_pool.h"
 #include "common/status.h"
 #include "gen_cpp/Types_types.h"
+#include "pipeline/dependency.h"
 #include "runtime/descriptors.h"
 #include "runtime/query_statistics.h"
 #include "util/runtime_profile.h"
@@ -72,6 +73,9 @@ public:
 
     bool ready_to_read();
 
+    // notified when ready_to_read() may change, only for pipeline
+    pipeline::Dependency* read_dependency() { return _read_dependency.get(); }
+
     Status get_next(Block* block, bool* eos);
 
     const TUniqueId& fragment_instance_id() const { return _fragment_instance_id; }
@@ -144,6 +148,7 @@ private:
     std::shared_ptr<QueryStatisticsRecvr> _sub_plan_query_statistics_recvr;
 
     bool _enable_pipeline;
+    std::unique_ptr<pipeline::Dependency> _read_dependency;
 };
 
 class ThreadClosure : public google::protobuf::Closure {
@@ -180,8 +185,20 @@ public:
 
 protected:
     virtual void _update_block_queue_empty() {}
+
+    void _notify_read_dependency() {
+        if (auto* dependency = _recvr->read_dependency()) {
+            dependency->notify();
+        }
+    }
+
     Status _inner_get_batch(Block* block, bool* eos);
 
+    // The blocks given back by the consumer in get_batch(), emptied with the memory of their
+    // columns kept, the later received blocks are deserialized into them.
+    BlockUPtr _get_free_block();
+    void _return_free_block(BlockUPtr block);
+
     // Not managed by this class
     VDataStreamRecvr* _recvr;
     std::mutex _lock;
@@ -199,6 +216,10 @@ protected:
     std::unordered_map<int, int64_t> _packet_seq_map;
     std::deque<std::pair<google::protobuf::Closure*, MonotonicStopWatch>> _pending_closures;
     std::unordered_map<std::thread::id, std::unique_ptr<ThreadClosure>> _local_closure;
+
+    static constexpr size_t MAX_FREE_BLOCKS = 4;
+    std::mutex _free_blocks_lock;
+    std::vector<BlockUPtr> _free_blocks;
 };
 
 class VDataStreamRecvr::PipSenderQueue : public SenderQueue {
@@ -251,6 +272,7 @@ public:
         _recvr->_blocks_memory_usage->add(block_mem_size);
         _update_block_queue_empty();
         _data_arrival_cv.notify_one();
+        _notify_read_dependency();
     }
 };
 } // namespace vectorized
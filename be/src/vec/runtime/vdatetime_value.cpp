@@ -28,6 +28,7 @@
 #include "common/config.h"
 #include "runtime/datetime_value.h"
 #include "util/timezone_utils.h"
+#include "vec/common/int_exp.h"
 
 namespace doris::vectorized {
 
@@ -64,6 +65,54 @@ bool VecDateTimeValue::check_date(uint32_t year, uint32_t month, uint32_t day) {
     return false;
 }
 
+static inline bool is_digits(const char* s, int n) {
+    bool digits = true;
+    for (int i = 0; i < n; ++i) {
+        digits &= static_cast<unsigned char>(s[i] - '0') < 10;
+    }
+    return digits;
+}
+
+static inline uint32_t to_digits_value(const char* s, int n) {
+    uint32_t value = 0;
+    for (int i = 0; i < n; ++i) {
+        value = value * 10 + (s[i] - '0');
+    }
+    return value;
+}
+
+// Parses the canonical format "yyyy-MM-dd[ HH:mm:ss[.f{1,6}]]", which most of the strings cast to
+// the dates are in, without the generic scanning of the fields. Returns the number of the parsed
+// fields of `date_val`, or 0 if `date_str` is not in the format, which is parsed as before.
+static int parse_canonical_date_str(const char* s, int len, uint32_t* date_val) {
+    if (len < 10 || s[4] != '-' || s[7] != '-' ||
+        !(is_digits(s, 4) & is_digits(s + 5, 2) & is_digits(s + 8, 2))) {
+        return 0;
+    }
+    date_val[0] = to_digits_value(s, 4);
+    date_val[1] = to_digits_value(s + 5, 2);
+    date_val[2] = to_digits_value(s + 8, 2);
+    if (len == 10) {
+        return 3;
+    }
+    if (len < 19 || s[10] != ' ' || s[13] != ':' || s[16] != ':' ||
+        !(is_digits(s + 11, 2) & is_digits(s + 14, 2) & is_digits(s + 17, 2))) {
+        return 0;
+    }
+    date_val[3] = to_digits_value(s + 11, 2);
+    date_val[4] = to_digits_value(s + 14, 2);
+    date_val[5] = to_digits_value(s + 17, 2);
+    if (len == 19) {
+        return 6;
+    }
+    const int frac_len = len - 20;
+    if (s[19] != '.' || frac_len < 1 || frac_len > 6 || !is_digits(s + 20, frac_len)) {
+        return 0;
+    }
+    date_val[6] = to_digits_value(s + 20, frac_len) * common::exp10_i32(6 - frac_len);
+    return 7;
+}
+
 // The interval format is that with no delimiters
 // YYYY-MM-DD HH-MM-DD.FFFFFF AM in default format
 // 0    1  2  3  4  5  6      7
@@ -77,6 +126,17 @@ bool VecDateTimeValue::from_date_str(const char* date_str, int len) {
     int32_t date_len[MAX_DATE_PARTS];
 
     _neg = false;
+
+    uint32_t canonical_val[MAX_DATE_PARTS - 1];
+    if (int num_field = parse_canonical_date_str(date_str, len, canonical_val); num_field > 0) {
+        _type = num_field <= 3 ? TIME_DATE : TIME_DATETIME;
+        if (num_field == 3) {
+            canonical_val[3] = canonical_val[4] = canonical_val[5] = 0;
+        }
+        return check_range_and_set_time(canonical_val[0], canonical_val[1], canonical_val[2],
+                                        canonical_val[3], canonical_val[4], canonical_val[5],
+                                        _type);
+    }
     // Skip space character
     while (ptr < end && isspace(*ptr)) {
         ptr++;
@@ -1799,6 +1859,17 @@ bool DateV2Value<T>::from_date_str(const char* date_str, int len, int scale) {
     uint32_t date_val[MAX_DATE_PARTS] = {0};
     int32_t date_len[MAX_DATE_PARTS] = {0};
 
+    if (int num_field = parse_canonical_date_str(date_str, len, date_val); num_field > 0) {
+        if constexpr (is_datetime) {
+            if (num_field == 7 && scale >= 0 && scale < 6) {
+                const uint32_t factor = common::exp10_i32(6 - scale);
+                date_val[6] = date_val[6] / factor * factor;
+            }
+        }
+        return check_range_and_set_time(date_val[0], date_val[1], date_val[2], date_val[3],
+                                        date_val[4], date_val[5], date_val[6]);
+    }
+
     // Skip space character
     while (ptr < end && isspace(*ptr)) {
         ptr++;
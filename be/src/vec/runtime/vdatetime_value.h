@@ -1459,6 +1459,42 @@ struct DateTraits<uint64_t> {
     using DateType = DataTypeDateTimeV2;
 };
 
+// The date part of a value of a date column, the functions of the date only are computed once
+// for a run of the rows of the same date, which are common in the columns clustered by time.
+inline uint32_t date_part_key(int64_t t) {
+    const auto& dt = reinterpret_cast<const VecDateTimeValue&>(t);
+    return (dt.year() << 9) | (dt.month() << 5) | dt.day();
+}
+
+inline uint32_t date_part_key(uint32_t t) {
+    return t;
+}
+
+inline uint32_t date_part_key(uint64_t t) {
+    return t >> TIME_PART_LENGTH;
+}
+
+// Memoizes the result of a function of the date part of the last value.
+template <typename ArgType, typename ResultType>
+class DatePartRunCache {
+public:
+    template <typename Func>
+    ResultType get(ArgType t, Func&& func) {
+        uint32_t key = date_part_key(t);
+        if (!_cached || key != _key) {
+            _result = func(t);
+            _key = key;
+            _cached = true;
+        }
+        return _result;
+    }
+
+private:
+    bool _cached = false;
+    uint32_t _key = 0;
+    ResultType _result {};
+};
+
 } // namespace vectorized
 } // namespace doris
 
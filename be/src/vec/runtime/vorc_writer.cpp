@@ -18,6 +18,7 @@
 #include "vec/runtime/vorc_writer.h"
 
 #include "io/fs/file_writer.h"
+#include "util/defer_op.h"
 #include "vec/columns/column_complex.h"
 #include "vec/columns/column_nullable.h"
 #include "vec/columns/column_string.h"
@@ -255,126 +256,116 @@ Status VOrcWriterWrapper::write(const Block& block) {
         return Status::OK();
     }
 
-    // Buffer used by date type
-    char* ptr = (char*)malloc(BUFFER_UNIT_SIZE);
-    StringRef buffer(ptr, BUFFER_UNIT_SIZE);
-
     size_t sz = block.rows();
     auto row_batch = _create_row_batch(sz);
     orc::StructVectorBatch* root = dynamic_cast<orc::StructVectorBatch*>(row_batch.get());
+    // Buffers used by date type, one for each column, as the columns may be written in parallel
+    std::vector<StringRef> buffers;
+    Defer free_buffers {[&]() {
+        for (auto& buffer : buffers) {
+            free(const_cast<char*>(buffer.data));
+        }
+    }};
+    for (size_t i = 0; i < block.columns(); i++) {
+        buffers.emplace_back((char*)malloc(BUFFER_UNIT_SIZE), BUFFER_UNIT_SIZE);
+    }
+    RETURN_IF_ERROR(_write_columns(
+            block, [&](size_t i) { return _write_column(block, i, root, buffers[i]); }));
+    root->numElements = sz;
+
+    _writer->add(*row_batch);
+    _cur_written_rows += sz;
+    return Status::OK();
+}
+
+Status VOrcWriterWrapper::_write_column(const Block& block, size_t i,
+                                        orc::StructVectorBatch* root, StringRef& buffer) {
+    size_t sz = block.rows();
     try {
-        for (size_t i = 0; i < block.columns(); i++) {
-            auto& raw_column = block.get_by_position(i).column;
-            auto nullable = raw_column->is_nullable();
-            const auto col = nullable ? reinterpret_cast<const ColumnNullable*>(
-                                                block.get_by_position(i).column.get())
-                                                ->get_nested_column_ptr()
-                                                .get()
-                                      : block.get_by_position(i).column.get();
-            auto null_map = nullable && reinterpret_cast<const ColumnNullable*>(
-                                                block.get_by_position(i).column.get())
-                                                    ->has_null()
-                                    ? reinterpret_cast<const ColumnNullable*>(
-                                              block.get_by_position(i).column.get())
-                                              ->get_null_map_column_ptr()
-                                    : nullptr;
-            switch (_output_vexpr_ctxs[i]->root()->type().type) {
-            case TYPE_BOOLEAN: {
-                WRITE_SINGLE_ELEMENTS_INTO_BATCH(orc::LongVectorBatch, ColumnVector<UInt8>)
-                SET_NUM_ELEMENTS
-                break;
-            }
-            case TYPE_TINYINT: {
-                WRITE_SINGLE_ELEMENTS_INTO_BATCH(orc::LongVectorBatch, ColumnVector<Int8>)
-                SET_NUM_ELEMENTS
-                break;
-            }
-            case TYPE_SMALLINT: {
-                WRITE_SINGLE_ELEMENTS_INTO_BATCH(orc::LongVectorBatch, ColumnVector<Int16>)
-                SET_NUM_ELEMENTS
-                break;
-            }
-            case TYPE_INT: {
-                WRITE_SINGLE_ELEMENTS_INTO_BATCH(orc::LongVectorBatch, ColumnVector<Int32>)
-                SET_NUM_ELEMENTS
-                break;
-            }
-            case TYPE_BIGINT: {
-                WRITE_CONTINUOUS_ELEMENTS_INTO_BATCH(orc::LongVectorBatch, ColumnVector<Int64>,
-                                                     Int64)
-                SET_NUM_ELEMENTS
-                break;
-            }
-            case TYPE_LARGEINT: {
-                return Status::InvalidArgument("do not support large int type.");
-            }
-            case TYPE_FLOAT: {
-                WRITE_SINGLE_ELEMENTS_INTO_BATCH(orc::DoubleVectorBatch, ColumnVector<Float32>)
-                SET_NUM_ELEMENTS
-                break;
-            }
-            case TYPE_DOUBLE: {
-                WRITE_CONTINUOUS_ELEMENTS_INTO_BATCH(orc::DoubleVectorBatch, ColumnVector<Float64>,
-                                                     Float64)
-                SET_NUM_ELEMENTS
-                break;
-            }
-            case TYPE_DATETIME:
-            case TYPE_DATE: {
-                WRITE_DATE_STRING_INTO_BATCH(Int64, VecDateTimeValue)
-                SET_NUM_ELEMENTS
-                break;
-            }
-            case TYPE_DATEV2: {
-                WRITE_DATE_STRING_INTO_BATCH(UInt32, DateV2Value<DateV2ValueType>)
-                SET_NUM_ELEMENTS
-                break;
-            }
-            case TYPE_DATETIMEV2: {
-                orc::StringVectorBatch* cur_batch =
-                        dynamic_cast<orc::StringVectorBatch*>(root->fields[i]);
-                size_t offset = 0;
-                if (null_map != nullptr) {
-                    cur_batch->hasNulls = true;
-                    auto& null_data = assert_cast<const ColumnUInt8&>(*null_map).get_data();
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        if (null_data[row_id] != 0) {
-                            cur_batch->notNull[row_id] = 0;
-                        } else {
-                            cur_batch->notNull[row_id] = 1;
-                            int output_scale = _output_vexpr_ctxs[i]->root()->type().scale;
-                            int len = binary_cast<UInt64, DateV2Value<DateTimeV2ValueType>>(
-                                              assert_cast<const ColumnVector<UInt64>&>(*col)
-                                                      .get_data()[row_id])
-                                              .to_buffer(const_cast<char*>(buffer.data),
-                                                         output_scale);
-                            while (buffer.size < offset + len) {
-                                char* new_ptr = (char*)malloc(buffer.size + BUFFER_UNIT_SIZE);
-                                memcpy(new_ptr, buffer.data, buffer.size);
-                                free(const_cast<char*>(buffer.data));
-                                buffer.data = new_ptr;
-                                buffer.size = buffer.size + BUFFER_UNIT_SIZE;
-                            }
-                            cur_batch->length[row_id] = len;
-                            offset += len;
-                        }
-                    }
-                    offset = 0;
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        if (null_data[row_id] != 0) {
-                            cur_batch->notNull[row_id] = 0;
-                        } else {
-                            cur_batch->data[row_id] = const_cast<char*>(buffer.data) + offset;
-                            offset += cur_batch->length[row_id];
-                        }
-                    }
-                } else if (const auto& not_null_column =
-                                   check_and_get_column<const ColumnVector<UInt64>>(col)) {
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
+        auto& raw_column = block.get_by_position(i).column;
+        auto nullable = raw_column->is_nullable();
+        const auto col = nullable ? reinterpret_cast<const ColumnNullable*>(
+                                            block.get_by_position(i).column.get())
+                                            ->get_nested_column_ptr()
+                                            .get()
+                                  : block.get_by_position(i).column.get();
+        auto null_map = nullable && reinterpret_cast<const ColumnNullable*>(
+                                            block.get_by_position(i).column.get())
+                                                ->has_null()
+                                ? reinterpret_cast<const ColumnNullable*>(
+                                          block.get_by_position(i).column.get())
+                                          ->get_null_map_column_ptr()
+                                : nullptr;
+        switch (_output_vexpr_ctxs[i]->root()->type().type) {
+        case TYPE_BOOLEAN: {
+            WRITE_SINGLE_ELEMENTS_INTO_BATCH(orc::LongVectorBatch, ColumnVector<UInt8>)
+            SET_NUM_ELEMENTS
+            break;
+        }
+        case TYPE_TINYINT: {
+            WRITE_SINGLE_ELEMENTS_INTO_BATCH(orc::LongVectorBatch, ColumnVector<Int8>)
+            SET_NUM_ELEMENTS
+            break;
+        }
+        case TYPE_SMALLINT: {
+            WRITE_SINGLE_ELEMENTS_INTO_BATCH(orc::LongVectorBatch, ColumnVector<Int16>)
+            SET_NUM_ELEMENTS
+            break;
+        }
+        case TYPE_INT: {
+            WRITE_SINGLE_ELEMENTS_INTO_BATCH(orc::LongVectorBatch, ColumnVector<Int32>)
+            SET_NUM_ELEMENTS
+            break;
+        }
+        case TYPE_BIGINT: {
+            WRITE_CONTINUOUS_ELEMENTS_INTO_BATCH(orc::LongVectorBatch, ColumnVector<Int64>,
+                                                 Int64)
+            SET_NUM_ELEMENTS
+            break;
+        }
+        case TYPE_LARGEINT: {
+            return Status::InvalidArgument("do not support large int type.");
+        }
+        case TYPE_FLOAT: {
+            WRITE_SINGLE_ELEMENTS_INTO_BATCH(orc::DoubleVectorBatch, ColumnVector<Float32>)
+            SET_NUM_ELEMENTS
+            break;
+        }
+        case TYPE_DOUBLE: {
+            WRITE_CONTINUOUS_ELEMENTS_INTO_BATCH(orc::DoubleVectorBatch, ColumnVector<Float64>,
+                                                 Float64)
+            SET_NUM_ELEMENTS
+            break;
+        }
+        case TYPE_DATETIME:
+        case TYPE_DATE: {
+            WRITE_DATE_STRING_INTO_BATCH(Int64, VecDateTimeValue)
+            SET_NUM_ELEMENTS
+            break;
+        }
+        case TYPE_DATEV2: {
+            WRITE_DATE_STRING_INTO_BATCH(UInt32, DateV2Value<DateV2ValueType>)
+            SET_NUM_ELEMENTS
+            break;
+        }
+        case TYPE_DATETIMEV2: {
+            orc::StringVectorBatch* cur_batch =
+                    dynamic_cast<orc::StringVectorBatch*>(root->fields[i]);
+            size_t offset = 0;
+            if (null_map != nullptr) {
+                cur_batch->hasNulls = true;
+                auto& null_data = assert_cast<const ColumnUInt8&>(*null_map).get_data();
+                for (size_t row_id = 0; row_id < sz; row_id++) {
+                    if (null_data[row_id] != 0) {
+                        cur_batch->notNull[row_id] = 0;
+                    } else {
+                        cur_batch->notNull[row_id] = 1;
                         int output_scale = _output_vexpr_ctxs[i]->root()->type().scale;
                         int len = binary_cast<UInt64, DateV2Value<DateTimeV2ValueType>>(
-                                          not_null_column->get_data()[row_id])
-                                          .to_buffer(const_cast<char*>(buffer.data), output_scale);
+                                          assert_cast<const ColumnVector<UInt64>&>(*col)
+                                                  .get_data()[row_id])
+                                          .to_buffer(const_cast<char*>(buffer.data),
+                                                     output_scale);
                         while (buffer.size < offset + len) {
                             char* new_ptr = (char*)malloc(buffer.size + BUFFER_UNIT_SIZE);
                             memcpy(new_ptr, buffer.data, buffer.size);
@@ -385,130 +376,150 @@ Status VOrcWriterWrapper::write(const Block& block) {
                         cur_batch->length[row_id] = len;
                         offset += len;
                     }
-                    offset = 0;
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
+                }
+                offset = 0;
+                for (size_t row_id = 0; row_id < sz; row_id++) {
+                    if (null_data[row_id] != 0) {
+                        cur_batch->notNull[row_id] = 0;
+                    } else {
                         cur_batch->data[row_id] = const_cast<char*>(buffer.data) + offset;
                         offset += cur_batch->length[row_id];
                     }
-                } else {
-                    RETURN_WRONG_TYPE
                 }
-                SET_NUM_ELEMENTS
-                break;
-            }
-            case TYPE_OBJECT: {
-                if (_output_object_data) {
-                    WRITE_COMPLEX_TYPE_INTO_BATCH(orc::StringVectorBatch, ColumnBitmap)
-                    SET_NUM_ELEMENTS
-                } else {
-                    RETURN_WRONG_TYPE
+            } else if (const auto& not_null_column =
+                               check_and_get_column<const ColumnVector<UInt64>>(col)) {
+                for (size_t row_id = 0; row_id < sz; row_id++) {
+                    int output_scale = _output_vexpr_ctxs[i]->root()->type().scale;
+                    int len = binary_cast<UInt64, DateV2Value<DateTimeV2ValueType>>(
+                                      not_null_column->get_data()[row_id])
+                                      .to_buffer(const_cast<char*>(buffer.data), output_scale);
+                    while (buffer.size < offset + len) {
+                        char* new_ptr = (char*)malloc(buffer.size + BUFFER_UNIT_SIZE);
+                        memcpy(new_ptr, buffer.data, buffer.size);
+                        free(const_cast<char*>(buffer.data));
+                        buffer.data = new_ptr;
+                        buffer.size = buffer.size + BUFFER_UNIT_SIZE;
+                    }
+                    cur_batch->length[row_id] = len;
+                    offset += len;
                 }
-                break;
-            }
-            case TYPE_HLL: {
-                if (_output_object_data) {
-                    WRITE_COMPLEX_TYPE_INTO_BATCH(orc::StringVectorBatch, ColumnHLL)
-                    SET_NUM_ELEMENTS
-                } else {
-                    RETURN_WRONG_TYPE
+                offset = 0;
+                for (size_t row_id = 0; row_id < sz; row_id++) {
+                    cur_batch->data[row_id] = const_cast<char*>(buffer.data) + offset;
+                    offset += cur_batch->length[row_id];
                 }
-                break;
-            }
-            case TYPE_CHAR:
-            case TYPE_VARCHAR:
-            case TYPE_STRING: {
-                WRITE_COMPLEX_TYPE_INTO_BATCH(orc::StringVectorBatch, ColumnString)
-                SET_NUM_ELEMENTS
-                break;
+            } else {
+                RETURN_WRONG_TYPE
             }
-            case TYPE_DECIMAL32: {
-                WRITE_DECIMAL_INTO_BATCH(orc::Decimal64VectorBatch, ColumnDecimal32)
+            SET_NUM_ELEMENTS
+            break;
+        }
+        case TYPE_OBJECT: {
+            if (_output_object_data) {
+                WRITE_COMPLEX_TYPE_INTO_BATCH(orc::StringVectorBatch, ColumnBitmap)
                 SET_NUM_ELEMENTS
-                break;
+            } else {
+                RETURN_WRONG_TYPE
             }
-            case TYPE_DECIMAL64: {
-                WRITE_DECIMAL_INTO_BATCH(orc::Decimal64VectorBatch, ColumnDecimal64)
+            break;
+        }
+        case TYPE_HLL: {
+            if (_output_object_data) {
+                WRITE_COMPLEX_TYPE_INTO_BATCH(orc::StringVectorBatch, ColumnHLL)
                 SET_NUM_ELEMENTS
-                break;
+            } else {
+                RETURN_WRONG_TYPE
             }
-            case TYPE_DECIMALV2: {
-                orc::Decimal128VectorBatch* cur_batch =
-                        dynamic_cast<orc::Decimal128VectorBatch*>(root->fields[i]);
-                if (null_map != nullptr) {
-                    cur_batch->hasNulls = true;
-                    auto& null_data = assert_cast<const ColumnUInt8&>(*null_map).get_data();
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        if (null_data[row_id] != 0) {
-                            cur_batch->notNull[row_id] = 0;
-                        } else {
-                            cur_batch->notNull[row_id] = 1;
-                            auto& v = assert_cast<const ColumnDecimal128&>(*col).get_data()[row_id];
-                            orc::Int128 value(v >> 64, (uint64_t)v);
-                            cur_batch->values[row_id] = value;
-                        }
-                    }
-                } else if (const auto& not_null_column =
-                                   check_and_get_column<const ColumnDecimal128>(col)) {
-                    auto col_ptr = not_null_column->get_data().data();
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        auto v = col_ptr[row_id];
+            break;
+        }
+        case TYPE_CHAR:
+        case TYPE_VARCHAR:
+        case TYPE_STRING: {
+            WRITE_COMPLEX_TYPE_INTO_BATCH(orc::StringVectorBatch, ColumnString)
+            SET_NUM_ELEMENTS
+            break;
+        }
+        case TYPE_DECIMAL32: {
+            WRITE_DECIMAL_INTO_BATCH(orc::Decimal64VectorBatch, ColumnDecimal32)
+            SET_NUM_ELEMENTS
+            break;
+        }
+        case TYPE_DECIMAL64: {
+            WRITE_DECIMAL_INTO_BATCH(orc::Decimal64VectorBatch, ColumnDecimal64)
+            SET_NUM_ELEMENTS
+            break;
+        }
+        case TYPE_DECIMALV2: {
+            orc::Decimal128VectorBatch* cur_batch =
+                    dynamic_cast<orc::Decimal128VectorBatch*>(root->fields[i]);
+            if (null_map != nullptr) {
+                cur_batch->hasNulls = true;
+                auto& null_data = assert_cast<const ColumnUInt8&>(*null_map).get_data();
+                for (size_t row_id = 0; row_id < sz; row_id++) {
+                    if (null_data[row_id] != 0) {
+                        cur_batch->notNull[row_id] = 0;
+                    } else {
+                        cur_batch->notNull[row_id] = 1;
+                        auto& v = assert_cast<const ColumnDecimal128&>(*col).get_data()[row_id];
                         orc::Int128 value(v >> 64, (uint64_t)v);
                         cur_batch->values[row_id] = value;
                     }
-                } else {
-                    RETURN_WRONG_TYPE
                 }
-                SET_NUM_ELEMENTS
-                break;
+            } else if (const auto& not_null_column =
+                               check_and_get_column<const ColumnDecimal128>(col)) {
+                auto col_ptr = not_null_column->get_data().data();
+                for (size_t row_id = 0; row_id < sz; row_id++) {
+                    auto v = col_ptr[row_id];
+                    orc::Int128 value(v >> 64, (uint64_t)v);
+                    cur_batch->values[row_id] = value;
+                }
+            } else {
+                RETURN_WRONG_TYPE
             }
-            case TYPE_DECIMAL128I: {
-                orc::Decimal128VectorBatch* cur_batch =
-                        dynamic_cast<orc::Decimal128VectorBatch*>(root->fields[i]);
-                if (null_map != nullptr) {
-                    cur_batch->hasNulls = true;
-                    auto& null_data = assert_cast<const ColumnUInt8&>(*null_map).get_data();
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        if (null_data[row_id] != 0) {
-                            cur_batch->notNull[row_id] = 0;
-                        } else {
-                            cur_batch->notNull[row_id] = 1;
-                            auto& v =
-                                    assert_cast<const ColumnDecimal128I&>(*col).get_data()[row_id];
-                            orc::Int128 value(v.value >> 64, (uint64_t)v.value);
-                            cur_batch->values[row_id] = value;
-                        }
-                    }
-                } else if (const auto& not_null_column =
-                                   check_and_get_column<const ColumnDecimal128I>(col)) {
-                    auto col_ptr = not_null_column->get_data().data();
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        auto v = col_ptr[row_id].value;
-                        orc::Int128 value(v >> 64, (uint64_t)v);
+            SET_NUM_ELEMENTS
+            break;
+        }
+        case TYPE_DECIMAL128I: {
+            orc::Decimal128VectorBatch* cur_batch =
+                    dynamic_cast<orc::Decimal128VectorBatch*>(root->fields[i]);
+            if (null_map != nullptr) {
+                cur_batch->hasNulls = true;
+                auto& null_data = assert_cast<const ColumnUInt8&>(*null_map).get_data();
+                for (size_t row_id = 0; row_id < sz; row_id++) {
+                    if (null_data[row_id] != 0) {
+                        cur_batch->notNull[row_id] = 0;
+                    } else {
+                        cur_batch->notNull[row_id] = 1;
+                        auto& v =
+                                assert_cast<const ColumnDecimal128I&>(*col).get_data()[row_id];
+                        orc::Int128 value(v.value >> 64, (uint64_t)v.value);
                         cur_batch->values[row_id] = value;
                     }
-                } else {
-                    RETURN_WRONG_TYPE
                 }
-                SET_NUM_ELEMENTS
-                break;
-            }
-            default: {
-                return Status::InvalidArgument(
-                        "Invalid expression type: {}",
-                        _output_vexpr_ctxs[i]->root()->type().debug_string());
-            }
+            } else if (const auto& not_null_column =
+                               check_and_get_column<const ColumnDecimal128I>(col)) {
+                auto col_ptr = not_null_column->get_data().data();
+                for (size_t row_id = 0; row_id < sz; row_id++) {
+                    auto v = col_ptr[row_id].value;
+                    orc::Int128 value(v >> 64, (uint64_t)v);
+                    cur_batch->values[row_id] = value;
+                }
+            } else {
+                RETURN_WRONG_TYPE
             }
+            SET_NUM_ELEMENTS
+            break;
+        }
+        default: {
+            return Status::InvalidArgument(
+                    "Invalid expression type: {}",
+                    _output_vexpr_ctxs[i]->root()->type().debug_string());
+        }
         }
     } catch (const std::exception& e) {
         LOG(WARNING) << "Parquet write error: " << e.what();
         return Status::InternalError(e.what());
     }
-    root->numElements = sz;
-
-    _writer->add(*row_batch);
-    _cur_written_rows += sz;
-
-    free(const_cast<char*>(buffer.data));
     return Status::OK();
 }
 
@@ -77,6 +77,10 @@ public:
 private:
     std::unique_ptr<orc::ColumnVectorBatch> _create_row_batch(size_t sz);
 
+    // writes the i-th column of the block into its field of the row batch
+    Status _write_column(const Block& block, size_t i, orc::StructVectorBatch* root,
+                         StringRef& buffer);
+
     doris::io::FileWriter* _file_writer;
     std::unique_ptr<orc::OutputStream> _output_stream;
     std::unique_ptr<orc::WriterOptions> _write_options;
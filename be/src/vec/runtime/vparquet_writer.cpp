@@ -21,8 +21,13 @@
 #include <arrow/status.h>
 #include <time.h>
 
+#include "common/config.h"
 #include "io/fs/file_writer.h"
+#include "runtime/exec_env.h"
+#include "runtime/thread_context.h"
+#include "util/countdown_latch.h"
 #include "util/mysql_global.h"
+#include "util/threadpool.h"
 #include "util/types.h"
 #include "vec/columns/column_complex.h"
 #include "vec/columns/column_nullable.h"
@@ -204,6 +209,50 @@ void ParquetBuildHelper::build_version(parquet::WriterProperties::Builder& build
     }
 }
 
+Status VFileWriterWrapper::_write_columns(const Block& block,
+                                          const std::function<Status(size_t)>& write_column) {
+    size_t num_columns = block.columns();
+    auto* thread_pool = ExecEnv::GetInstance()->outfile_encode_thread_pool();
+    if (thread_pool == nullptr || num_columns < 2 ||
+        config::outfile_parallel_encode_min_rows <= 0 ||
+        static_cast<int64_t>(block.rows()) < config::outfile_parallel_encode_min_rows) {
+        for (size_t i = 0; i < num_columns; ++i) {
+            RETURN_IF_ERROR(write_column(i));
+        }
+        return Status::OK();
+    }
+
+    std::vector<Status> statuses(num_columns);
+    CountDownLatch latch(num_columns);
+    auto run_column = [&](size_t i) {
+        statuses[i] = write_column(i);
+        latch.count_down();
+    };
+    auto mem_tracker = thread_context()->thread_mem_tracker_mgr->limiter_mem_tracker();
+    for (size_t i = 0; i < num_columns; ++i) {
+        // the writing thread writes the last column itself, and the columns which can not be
+        // submitted
+        bool submitted = false;
+        if (i + 1 < num_columns) {
+            submitted = thread_pool
+                                ->submit_func([&, i]() {
+                                    SCOPED_ATTACH_TASK(mem_tracker);
+                                    run_column(i);
+                                })
+                                .ok();
+        }
+        if (!submitted) {
+            run_column(i);
+        }
+    }
+    latch.wait();
+
+    for (auto& st : statuses) {
+        RETURN_IF_ERROR(st);
+    }
+    return Status::OK();
+}
+
 VParquetWriterWrapper::VParquetWriterWrapper(doris::io::FileWriter* file_writer,
                                              const std::vector<VExprContext*>& output_vexpr_ctxs,
                                              const std::vector<TParquetSchema>& parquet_schemas,
@@ -252,7 +301,7 @@ void VParquetWriterWrapper::parse_schema(const std::vector<TParquetSchema>& parq
     return Status::InvalidArgument("Invalid column type: {}", raw_column->get_name());
 
 #define DISPATCH_PARQUET_NUMERIC_WRITER(WRITER, COLUMN_TYPE, NATIVE_TYPE)                         \
-    parquet::RowGroupWriter* rgWriter = get_rg_writer();                                          \
+    parquet::RowGroupWriter* rgWriter = rg_writer;                                                \
     parquet::WRITER* col_writer = static_cast<parquet::WRITER*>(rgWriter->column(i));             \
     if (null_map != nullptr) {                                                                    \
         auto& null_data = assert_cast<const ColumnUInt8&>(*null_map).get_data();                  \
@@ -271,7 +320,7 @@ void VParquetWriterWrapper::parse_schema(const std::vector<TParquetSchema>& parq
     }
 
 #define DISPATCH_PARQUET_DECIMAL_WRITER(DECIMAL_TYPE)                                            \
-    parquet::RowGroupWriter* rgWriter = get_rg_writer();                                         \
+    parquet::RowGroupWriter* rgWriter = rg_writer;                                               \
     parquet::ByteArrayWriter* col_writer =                                                       \
             static_cast<parquet::ByteArrayWriter*>(rgWriter->column(i));                         \
     parquet::ByteArray value;                                                                    \
@@ -302,7 +351,7 @@ void VParquetWriterWrapper::parse_schema(const std::vector<TParquetSchema>& parq
     }
 
 #define DISPATCH_PARQUET_COMPLEX_WRITER(COLUMN_TYPE)                                             \
-    parquet::RowGroupWriter* rgWriter = get_rg_writer();                                         \
+    parquet::RowGroupWriter* rgWriter = rg_writer;                                               \
     parquet::ByteArrayWriter* col_writer =                                                       \
             static_cast<parquet::ByteArrayWriter*>(rgWriter->column(i));                         \
     if (null_map != nullptr) {                                                                   \
@@ -338,310 +387,323 @@ Status VParquetWriterWrapper::write(const Block& block) {
         return Status::OK();
     }
     size_t sz = block.rows();
+    parquet::RowGroupWriter* rg_writer = nullptr;
     try {
-        for (size_t i = 0; i < block.columns(); i++) {
-            auto& raw_column = block.get_by_position(i).column;
-            auto nullable = raw_column->is_nullable();
-            const auto col = nullable ? reinterpret_cast<const ColumnNullable*>(
-                                                block.get_by_position(i).column.get())
-                                                ->get_nested_column_ptr()
-                                                .get()
-                                      : block.get_by_position(i).column.get();
-            auto null_map = nullable && reinterpret_cast<const ColumnNullable*>(
-                                                block.get_by_position(i).column.get())
-                                                    ->has_null()
-                                    ? reinterpret_cast<const ColumnNullable*>(
-                                              block.get_by_position(i).column.get())
-                                              ->get_null_map_column_ptr()
-                                    : nullptr;
-            auto& type = block.get_by_position(i).type;
-
-            std::vector<int16_t> def_level(sz);
-            // For scalar type, definition level == 1 means this value is not NULL.
-            std::fill(def_level.begin(), def_level.end(), 1);
-            int16_t single_def_level = 1;
-            switch (_output_vexpr_ctxs[i]->root()->type().type) {
-            case TYPE_BOOLEAN: {
-                DISPATCH_PARQUET_NUMERIC_WRITER(BoolWriter, ColumnVector<UInt8>, bool)
-                break;
-            }
-            case TYPE_BIGINT: {
-                DISPATCH_PARQUET_NUMERIC_WRITER(Int64Writer, ColumnVector<Int64>, int64_t)
-                break;
-            }
-            case TYPE_LARGEINT: {
-                return Status::InvalidArgument("do not support large int type.");
-            }
-            case TYPE_FLOAT: {
-                DISPATCH_PARQUET_NUMERIC_WRITER(FloatWriter, ColumnVector<Float32>, float_t)
-                break;
-            }
-            case TYPE_DOUBLE: {
-                DISPATCH_PARQUET_NUMERIC_WRITER(DoubleWriter, ColumnVector<Float64>, double_t)
-                break;
-            }
-            case TYPE_TINYINT:
-            case TYPE_SMALLINT: {
-                parquet::RowGroupWriter* rgWriter = get_rg_writer();
-                parquet::Int32Writer* col_writer =
-                        static_cast<parquet::Int32Writer*>(rgWriter->column(i));
-                if (null_map != nullptr) {
-                    auto& null_data = assert_cast<const ColumnUInt8&>(*null_map).get_data();
-                    if (const auto* int16_column =
-                                check_and_get_column<const ColumnVector<Int16>>(col)) {
-                        for (size_t row_id = 0; row_id < sz; row_id++) {
-                            if (null_data[row_id] != 0) {
-                                single_def_level = 0;
-                            }
-                            const int32_t tmp = int16_column->get_data()[row_id];
-                            col_writer->WriteBatch(1, &single_def_level, nullptr,
-                                                   reinterpret_cast<const int32_t*>(&tmp));
-                            single_def_level = 1;
-                        }
-                    } else if (const auto* int8_column =
-                                       check_and_get_column<const ColumnVector<Int8>>(col)) {
-                        for (size_t row_id = 0; row_id < sz; row_id++) {
-                            if (null_data[row_id] != 0) {
-                                single_def_level = 0;
-                            }
-                            const int32_t tmp = int8_column->get_data()[row_id];
-                            col_writer->WriteBatch(1, &single_def_level, nullptr,
-                                                   reinterpret_cast<const int32_t*>(&tmp));
-                            single_def_level = 1;
-                        }
-                    } else {
-                        RETURN_WRONG_TYPE
-                    }
-                } else if (const auto& int16_column =
-                                   check_and_get_column<const ColumnVector<Int16>>(col)) {
+        rg_writer = get_rg_writer();
+    } catch (const std::exception& e) {
+        LOG(WARNING) << "Parquet write error: " << e.what();
+        return Status::InternalError(e.what());
+    }
+    RETURN_IF_ERROR(_write_columns(
+            block, [&](size_t i) { return _write_column(block, i, rg_writer); }));
+    _cur_written_rows += sz;
+    return Status::OK();
+}
+
+Status VParquetWriterWrapper::_write_column(const Block& block, size_t i,
+                                            parquet::RowGroupWriter* rg_writer) {
+    size_t sz = block.rows();
+    try {
+        auto& raw_column = block.get_by_position(i).column;
+        auto nullable = raw_column->is_nullable();
+        const auto col = nullable ? reinterpret_cast<const ColumnNullable*>(
+                                            block.get_by_position(i).column.get())
+                                            ->get_nested_column_ptr()
+                                            .get()
+                                  : block.get_by_position(i).column.get();
+        auto null_map = nullable && reinterpret_cast<const ColumnNullable*>(
+                                            block.get_by_position(i).column.get())
+                                                ->has_null()
+                                ? reinterpret_cast<const ColumnNullable*>(
+                                          block.get_by_position(i).column.get())
+                                          ->get_null_map_column_ptr()
+                                : nullptr;
+        auto& type = block.get_by_position(i).type;
+
+        std::vector<int16_t> def_level(sz);
+        // For scalar type, definition level == 1 means this value is not NULL.
+        std::fill(def_level.begin(), def_level.end(), 1);
+        int16_t single_def_level = 1;
+        switch (_output_vexpr_ctxs[i]->root()->type().type) {
+        case TYPE_BOOLEAN: {
+            DISPATCH_PARQUET_NUMERIC_WRITER(BoolWriter, ColumnVector<UInt8>, bool)
+            break;
+        }
+        case TYPE_BIGINT: {
+            DISPATCH_PARQUET_NUMERIC_WRITER(Int64Writer, ColumnVector<Int64>, int64_t)
+            break;
+        }
+        case TYPE_LARGEINT: {
+            return Status::InvalidArgument("do not support large int type.");
+        }
+        case TYPE_FLOAT: {
+            DISPATCH_PARQUET_NUMERIC_WRITER(FloatWriter, ColumnVector<Float32>, float_t)
+            break;
+        }
+        case TYPE_DOUBLE: {
+            DISPATCH_PARQUET_NUMERIC_WRITER(DoubleWriter, ColumnVector<Float64>, double_t)
+            break;
+        }
+        case TYPE_TINYINT:
+        case TYPE_SMALLINT: {
+            parquet::RowGroupWriter* rgWriter = rg_writer;
+            parquet::Int32Writer* col_writer =
+                    static_cast<parquet::Int32Writer*>(rgWriter->column(i));
+            if (null_map != nullptr) {
+                auto& null_data = assert_cast<const ColumnUInt8&>(*null_map).get_data();
+                if (const auto* int16_column =
+                            check_and_get_column<const ColumnVector<Int16>>(col)) {
                     for (size_t row_id = 0; row_id < sz; row_id++) {
+                        if (null_data[row_id] != 0) {
+                            single_def_level = 0;
+                        }
                         const int32_t tmp = int16_column->get_data()[row_id];
-                        col_writer->WriteBatch(1, nullable ? def_level.data() : nullptr, nullptr,
+                        col_writer->WriteBatch(1, &single_def_level, nullptr,
                                                reinterpret_cast<const int32_t*>(&tmp));
+                        single_def_level = 1;
                     }
-                } else if (const auto& int8_column =
+                } else if (const auto* int8_column =
                                    check_and_get_column<const ColumnVector<Int8>>(col)) {
                     for (size_t row_id = 0; row_id < sz; row_id++) {
+                        if (null_data[row_id] != 0) {
+                            single_def_level = 0;
+                        }
                         const int32_t tmp = int8_column->get_data()[row_id];
-                        col_writer->WriteBatch(1, nullable ? def_level.data() : nullptr, nullptr,
+                        col_writer->WriteBatch(1, &single_def_level, nullptr,
                                                reinterpret_cast<const int32_t*>(&tmp));
+                        single_def_level = 1;
                     }
                 } else {
                     RETURN_WRONG_TYPE
                 }
-                break;
-            }
-            case TYPE_INT: {
-                DISPATCH_PARQUET_NUMERIC_WRITER(Int32Writer, ColumnVector<Int32>, Int32)
-                break;
+            } else if (const auto& int16_column =
+                               check_and_get_column<const ColumnVector<Int16>>(col)) {
+                for (size_t row_id = 0; row_id < sz; row_id++) {
+                    const int32_t tmp = int16_column->get_data()[row_id];
+                    col_writer->WriteBatch(1, nullable ? def_level.data() : nullptr, nullptr,
+                                           reinterpret_cast<const int32_t*>(&tmp));
+                }
+            } else if (const auto& int8_column =
+                               check_and_get_column<const ColumnVector<Int8>>(col)) {
+                for (size_t row_id = 0; row_id < sz; row_id++) {
+                    const int32_t tmp = int8_column->get_data()[row_id];
+                    col_writer->WriteBatch(1, nullable ? def_level.data() : nullptr, nullptr,
+                                           reinterpret_cast<const int32_t*>(&tmp));
+                }
+            } else {
+                RETURN_WRONG_TYPE
             }
-            case TYPE_DATETIME:
-            case TYPE_DATE: {
-                parquet::RowGroupWriter* rgWriter = get_rg_writer();
-                parquet::Int64Writer* col_writer =
-                        static_cast<parquet::Int64Writer*>(rgWriter->column(i));
-                uint64_t default_int64 = 0;
-                if (null_map != nullptr) {
-                    auto& null_data = assert_cast<const ColumnUInt8&>(*null_map).get_data();
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        def_level[row_id] = null_data[row_id] == 0;
-                    }
-                    uint64_t tmp_data[sz];
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        if (null_data[row_id] != 0) {
-                            tmp_data[row_id] = default_int64;
-                        } else {
-                            tmp_data[row_id] = binary_cast<Int64, VecDateTimeValue>(
-                                                       assert_cast<const ColumnVector<Int64>&>(*col)
-                                                               .get_data()[row_id])
-                                                       .to_olap_datetime();
-                        }
-                    }
-                    col_writer->WriteBatch(sz, def_level.data(), nullptr,
-                                           reinterpret_cast<const int64_t*>(tmp_data));
-                } else if (const auto* not_nullable_column =
-                                   check_and_get_column<const ColumnVector<Int64>>(col)) {
-                    std::vector<uint64_t> res(sz);
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        res[row_id] = binary_cast<Int64, VecDateTimeValue>(
-                                              not_nullable_column->get_data()[row_id])
-                                              .to_olap_datetime();
+            break;
+        }
+        case TYPE_INT: {
+            DISPATCH_PARQUET_NUMERIC_WRITER(Int32Writer, ColumnVector<Int32>, Int32)
+            break;
+        }
+        case TYPE_DATETIME:
+        case TYPE_DATE: {
+            parquet::RowGroupWriter* rgWriter = rg_writer;
+            parquet::Int64Writer* col_writer =
+                    static_cast<parquet::Int64Writer*>(rgWriter->column(i));
+            uint64_t default_int64 = 0;
+            if (null_map != nullptr) {
+                auto& null_data = assert_cast<const ColumnUInt8&>(*null_map).get_data();
+                for (size_t row_id = 0; row_id < sz; row_id++) {
+                    def_level[row_id] = null_data[row_id] == 0;
+                }
+                uint64_t tmp_data[sz];
+                for (size_t row_id = 0; row_id < sz; row_id++) {
+                    if (null_data[row_id] != 0) {
+                        tmp_data[row_id] = default_int64;
+                    } else {
+                        tmp_data[row_id] = binary_cast<Int64, VecDateTimeValue>(
+                                                   assert_cast<const ColumnVector<Int64>&>(*col)
+                                                           .get_data()[row_id])
+                                                   .to_olap_datetime();
                     }
-                    col_writer->WriteBatch(sz, nullable ? def_level.data() : nullptr, nullptr,
-                                           reinterpret_cast<const int64_t*>(res.data()));
-                } else {
-                    RETURN_WRONG_TYPE
                 }
-                break;
+                col_writer->WriteBatch(sz, def_level.data(), nullptr,
+                                       reinterpret_cast<const int64_t*>(tmp_data));
+            } else if (const auto* not_nullable_column =
+                               check_and_get_column<const ColumnVector<Int64>>(col)) {
+                std::vector<uint64_t> res(sz);
+                for (size_t row_id = 0; row_id < sz; row_id++) {
+                    res[row_id] = binary_cast<Int64, VecDateTimeValue>(
+                                          not_nullable_column->get_data()[row_id])
+                                          .to_olap_datetime();
+                }
+                col_writer->WriteBatch(sz, nullable ? def_level.data() : nullptr, nullptr,
+                                       reinterpret_cast<const int64_t*>(res.data()));
+            } else {
+                RETURN_WRONG_TYPE
             }
-            case TYPE_DATEV2: {
-                parquet::RowGroupWriter* rgWriter = get_rg_writer();
-                parquet::ByteArrayWriter* col_writer =
-                        static_cast<parquet::ByteArrayWriter*>(rgWriter->column(i));
-                parquet::ByteArray value;
-                if (null_map != nullptr) {
-                    auto& null_data = assert_cast<const ColumnUInt8&>(*null_map).get_data();
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        if (null_data[row_id] != 0) {
-                            single_def_level = 0;
-                            col_writer->WriteBatch(1, &single_def_level, nullptr, &value);
-                            single_def_level = 1;
-                        } else {
-                            char buffer[30];
-                            int output_scale = _output_vexpr_ctxs[i]->root()->type().scale;
-                            value.ptr = reinterpret_cast<const uint8_t*>(buffer);
-                            value.len = binary_cast<UInt32, DateV2Value<DateV2ValueType>>(
-                                                assert_cast<const ColumnVector<UInt32>&>(*col)
-                                                        .get_data()[row_id])
-                                                .to_buffer(buffer, output_scale);
-                            col_writer->WriteBatch(1, &single_def_level, nullptr, &value);
-                        }
-                    }
-                } else if (const auto* not_nullable_column =
-                                   check_and_get_column<const ColumnVector<UInt32>>(col)) {
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
+            break;
+        }
+        case TYPE_DATEV2: {
+            parquet::RowGroupWriter* rgWriter = rg_writer;
+            parquet::ByteArrayWriter* col_writer =
+                    static_cast<parquet::ByteArrayWriter*>(rgWriter->column(i));
+            parquet::ByteArray value;
+            if (null_map != nullptr) {
+                auto& null_data = assert_cast<const ColumnUInt8&>(*null_map).get_data();
+                for (size_t row_id = 0; row_id < sz; row_id++) {
+                    if (null_data[row_id] != 0) {
+                        single_def_level = 0;
+                        col_writer->WriteBatch(1, &single_def_level, nullptr, &value);
+                        single_def_level = 1;
+                    } else {
                         char buffer[30];
                         int output_scale = _output_vexpr_ctxs[i]->root()->type().scale;
                         value.ptr = reinterpret_cast<const uint8_t*>(buffer);
                         value.len = binary_cast<UInt32, DateV2Value<DateV2ValueType>>(
-                                            not_nullable_column->get_data()[row_id])
+                                            assert_cast<const ColumnVector<UInt32>&>(*col)
+                                                    .get_data()[row_id])
                                             .to_buffer(buffer, output_scale);
-                        col_writer->WriteBatch(1, nullable ? &single_def_level : nullptr, nullptr,
-                                               &value);
+                        col_writer->WriteBatch(1, &single_def_level, nullptr, &value);
                     }
-                } else {
-                    RETURN_WRONG_TYPE
                 }
-                break;
+            } else if (const auto* not_nullable_column =
+                               check_and_get_column<const ColumnVector<UInt32>>(col)) {
+                for (size_t row_id = 0; row_id < sz; row_id++) {
+                    char buffer[30];
+                    int output_scale = _output_vexpr_ctxs[i]->root()->type().scale;
+                    value.ptr = reinterpret_cast<const uint8_t*>(buffer);
+                    value.len = binary_cast<UInt32, DateV2Value<DateV2ValueType>>(
+                                        not_nullable_column->get_data()[row_id])
+                                        .to_buffer(buffer, output_scale);
+                    col_writer->WriteBatch(1, nullable ? &single_def_level : nullptr, nullptr,
+                                           &value);
+                }
+            } else {
+                RETURN_WRONG_TYPE
             }
-            case TYPE_DATETIMEV2: {
-                parquet::RowGroupWriter* rgWriter = get_rg_writer();
-                parquet::ByteArrayWriter* col_writer =
-                        static_cast<parquet::ByteArrayWriter*>(rgWriter->column(i));
-                parquet::ByteArray value;
-                if (null_map != nullptr) {
-                    auto& null_data = assert_cast<const ColumnUInt8&>(*null_map).get_data();
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        if (null_data[row_id] != 0) {
-                            single_def_level = 0;
-                            col_writer->WriteBatch(1, &single_def_level, nullptr, &value);
-                            single_def_level = 1;
-                        } else {
-                            char buffer[30];
-                            int output_scale = _output_vexpr_ctxs[i]->root()->type().scale;
-                            value.ptr = reinterpret_cast<const uint8_t*>(buffer);
-                            value.len = binary_cast<UInt64, DateV2Value<DateTimeV2ValueType>>(
-                                                assert_cast<const ColumnVector<UInt64>&>(*col)
-                                                        .get_data()[row_id])
-                                                .to_buffer(buffer, output_scale);
-                            col_writer->WriteBatch(1, &single_def_level, nullptr, &value);
-                        }
-                    }
-                } else if (const auto* not_nullable_column =
-                                   check_and_get_column<const ColumnVector<UInt64>>(col)) {
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
+            break;
+        }
+        case TYPE_DATETIMEV2: {
+            parquet::RowGroupWriter* rgWriter = rg_writer;
+            parquet::ByteArrayWriter* col_writer =
+                    static_cast<parquet::ByteArrayWriter*>(rgWriter->column(i));
+            parquet::ByteArray value;
+            if (null_map != nullptr) {
+                auto& null_data = assert_cast<const ColumnUInt8&>(*null_map).get_data();
+                for (size_t row_id = 0; row_id < sz; row_id++) {
+                    if (null_data[row_id] != 0) {
+                        single_def_level = 0;
+                        col_writer->WriteBatch(1, &single_def_level, nullptr, &value);
+                        single_def_level = 1;
+                    } else {
                         char buffer[30];
                         int output_scale = _output_vexpr_ctxs[i]->root()->type().scale;
                         value.ptr = reinterpret_cast<const uint8_t*>(buffer);
                         value.len = binary_cast<UInt64, DateV2Value<DateTimeV2ValueType>>(
-                                            not_nullable_column->get_data()[row_id])
+                                            assert_cast<const ColumnVector<UInt64>&>(*col)
+                                                    .get_data()[row_id])
                                             .to_buffer(buffer, output_scale);
-                        col_writer->WriteBatch(1, nullable ? &single_def_level : nullptr, nullptr,
-                                               &value);
+                        col_writer->WriteBatch(1, &single_def_level, nullptr, &value);
                     }
-                } else {
-                    RETURN_WRONG_TYPE
                 }
-                break;
-            }
-            case TYPE_OBJECT: {
-                if (_output_object_data) {
-                    DISPATCH_PARQUET_COMPLEX_WRITER(ColumnBitmap)
-                } else {
-                    RETURN_WRONG_TYPE
+            } else if (const auto* not_nullable_column =
+                               check_and_get_column<const ColumnVector<UInt64>>(col)) {
+                for (size_t row_id = 0; row_id < sz; row_id++) {
+                    char buffer[30];
+                    int output_scale = _output_vexpr_ctxs[i]->root()->type().scale;
+                    value.ptr = reinterpret_cast<const uint8_t*>(buffer);
+                    value.len = binary_cast<UInt64, DateV2Value<DateTimeV2ValueType>>(
+                                        not_nullable_column->get_data()[row_id])
+                                        .to_buffer(buffer, output_scale);
+                    col_writer->WriteBatch(1, nullable ? &single_def_level : nullptr, nullptr,
+                                           &value);
                 }
-                break;
+            } else {
+                RETURN_WRONG_TYPE
             }
-            case TYPE_HLL: {
-                if (_output_object_data) {
-                    DISPATCH_PARQUET_COMPLEX_WRITER(ColumnHLL)
-                } else {
-                    RETURN_WRONG_TYPE
-                }
-                break;
+            break;
+        }
+        case TYPE_OBJECT: {
+            if (_output_object_data) {
+                DISPATCH_PARQUET_COMPLEX_WRITER(ColumnBitmap)
+            } else {
+                RETURN_WRONG_TYPE
             }
-            case TYPE_CHAR:
-            case TYPE_VARCHAR:
-            case TYPE_STRING: {
-                DISPATCH_PARQUET_COMPLEX_WRITER(ColumnString)
-                break;
+            break;
+        }
+        case TYPE_HLL: {
+            if (_output_object_data) {
+                DISPATCH_PARQUET_COMPLEX_WRITER(ColumnHLL)
+            } else {
+                RETURN_WRONG_TYPE
             }
-            case TYPE_DECIMALV2: {
-                parquet::RowGroupWriter* rgWriter = get_rg_writer();
-                parquet::ByteArrayWriter* col_writer =
-                        static_cast<parquet::ByteArrayWriter*>(rgWriter->column(i));
-                parquet::ByteArray value;
-                if (null_map != nullptr) {
-                    auto& null_data = assert_cast<const ColumnUInt8&>(*null_map).get_data();
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        if (null_data[row_id] != 0) {
-                            single_def_level = 0;
-                            col_writer->WriteBatch(1, &single_def_level, nullptr, &value);
-                            single_def_level = 1;
-                        } else {
-                            const DecimalV2Value decimal_val(reinterpret_cast<const PackedInt128*>(
-                                                                     col->get_data_at(row_id).data)
-                                                                     ->value);
-                            char decimal_buffer[MAX_DECIMAL_WIDTH];
-                            int output_scale = _output_vexpr_ctxs[i]->root()->type().scale;
-                            value.ptr = reinterpret_cast<const uint8_t*>(decimal_buffer);
-                            value.len = decimal_val.to_buffer(decimal_buffer, output_scale);
-                            col_writer->WriteBatch(1, &single_def_level, nullptr, &value);
-                        }
-                    }
-                } else if (const auto* not_nullable_column =
-                                   check_and_get_column<const ColumnDecimal128>(col)) {
-                    for (size_t row_id = 0; row_id < sz; row_id++) {
-                        const DecimalV2Value decimal_val(
-                                reinterpret_cast<const PackedInt128*>(
-                                        not_nullable_column->get_data_at(row_id).data)
-                                        ->value);
+            break;
+        }
+        case TYPE_CHAR:
+        case TYPE_VARCHAR:
+        case TYPE_STRING: {
+            DISPATCH_PARQUET_COMPLEX_WRITER(ColumnString)
+            break;
+        }
+        case TYPE_DECIMALV2: {
+            parquet::RowGroupWriter* rgWriter = rg_writer;
+            parquet::ByteArrayWriter* col_writer =
+                    static_cast<parquet::ByteArrayWriter*>(rgWriter->column(i));
+            parquet::ByteArray value;
+            if (null_map != nullptr) {
+                auto& null_data = assert_cast<const ColumnUInt8&>(*null_map).get_data();
+                for (size_t row_id = 0; row_id < sz; row_id++) {
+                    if (null_data[row_id] != 0) {
+                        single_def_level = 0;
+                        col_writer->WriteBatch(1, &single_def_level, nullptr, &value);
+                        single_def_level = 1;
+                    } else {
+                        const DecimalV2Value decimal_val(reinterpret_cast<const PackedInt128*>(
+                                                                 col->get_data_at(row_id).data)
+                                                                 ->value);
                         char decimal_buffer[MAX_DECIMAL_WIDTH];
                         int output_scale = _output_vexpr_ctxs[i]->root()->type().scale;
                         value.ptr = reinterpret_cast<const uint8_t*>(decimal_buffer);
                         value.len = decimal_val.to_buffer(decimal_buffer, output_scale);
-                        col_writer->WriteBatch(1, nullable ? &single_def_level : nullptr, nullptr,
-                                               &value);
+                        col_writer->WriteBatch(1, &single_def_level, nullptr, &value);
                     }
-                } else {
-                    RETURN_WRONG_TYPE
                 }
-                break;
-            }
-            case TYPE_DECIMAL32: {
-                DISPATCH_PARQUET_DECIMAL_WRITER(Decimal32)
-                break;
-            }
-            case TYPE_DECIMAL64: {
-                DISPATCH_PARQUET_DECIMAL_WRITER(Decimal64)
-                break;
-            }
-            case TYPE_DECIMAL128I: {
-                DISPATCH_PARQUET_DECIMAL_WRITER(Decimal128I)
-                break;
-            }
-            default: {
-                return Status::InvalidArgument(
-                        "Invalid expression type: {}",
-                        _output_vexpr_ctxs[i]->root()->type().debug_string());
-            }
+            } else if (const auto* not_nullable_column =
+                               check_and_get_column<const ColumnDecimal128>(col)) {
+                for (size_t row_id = 0; row_id < sz; row_id++) {
+                    const DecimalV2Value decimal_val(
+                            reinterpret_cast<const PackedInt128*>(
+                                    not_nullable_column->get_data_at(row_id).data)
+                                    ->value);
+                    char decimal_buffer[MAX_DECIMAL_WIDTH];
+                    int output_scale = _output_vexpr_ctxs[i]->root()->type().scale;
+                    value.ptr = reinterpret_cast<const uint8_t*>(decimal_buffer);
+                    value.len = decimal_val.to_buffer(decimal_buffer, output_scale);
+                    col_writer->WriteBatch(1, nullable ? &single_def_level : nullptr, nullptr,
+                                           &value);
+                }
+            } else {
+                RETURN_WRONG_TYPE
             }
+            break;
+        }
+        case TYPE_DECIMAL32: {
+            DISPATCH_PARQUET_DECIMAL_WRITER(Decimal32)
+            break;
+        }
+        case TYPE_DECIMAL64: {
+            DISPATCH_PARQUET_DECIMAL_WRITER(Decimal64)
+            break;
+        }
+        case TYPE_DECIMAL128I: {
+            DISPATCH_PARQUET_DECIMAL_WRITER(Decimal128I)
+            break;
+        }
+        default: {
+            return Status::InvalidArgument(
+                    "Invalid expression type: {}",
+                    _output_vexpr_ctxs[i]->root()->type().debug_string());
+        }
         }
     } catch (const std::exception& e) {
         LOG(WARNING) << "Parquet write error: " << e.what();
         return Status::InternalError(e.what());
     }
-    _cur_written_rows += sz;
     return Status::OK();
 }
 
@@ -30,6 +30,7 @@
 #include <parquet/exception.h>
 #include <stdint.h>
 
+#include <functional>
 #include <map>
 #include <string>
 
@@ -98,6 +99,12 @@ public:
     virtual int64_t written_len() = 0;
 
 protected:
+    // Calls write_column for each column of the block and returns the first error. The columns
+    // are written in parallel on the outfile encode thread pool if the block has at least
+    // config::outfile_parallel_encode_min_rows rows, so write_column may only change the state
+    // of the column it writes.
+    Status _write_columns(const Block& block, const std::function<Status(size_t)>& write_column);
+
     const std::vector<VExprContext*>& _output_vexpr_ctxs;
     int64_t _cur_written_rows;
     bool _output_object_data;
@@ -126,6 +133,9 @@ public:
 private:
     parquet::RowGroupWriter* get_rg_writer();
 
+    // writes the i-th column of the block into its column writer of the row group
+    Status _write_column(const Block& block, size_t i, parquet::RowGroupWriter* rg_writer);
+
     void parse_schema(const std::vector<TParquetSchema>& parquet_schemas);
 
     void parse_properties(const TParquetCompressionType::type& compression_type,
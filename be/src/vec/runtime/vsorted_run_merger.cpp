@@ -67,11 +67,13 @@ Status VSortedRunMerger::prepare(const vector<BlockSupplier>& input_runs) {
         }
     }
 
+    std::vector<MergeSortCursor> cursors;
     for (auto& _cursor : _cursors) {
         if (!_cursor._is_eof) {
-            _priority_queue.push(MergeSortCursor(&_cursor));
+            cursors.emplace_back(&_cursor);
         }
     }
+    _merge_tree.init(std::move(cursors));
 
     for (const auto& cursor : _cursors) {
         if (!cursor._is_eof) {
@@ -88,8 +90,8 @@ Status VSortedRunMerger::get_next(Block* output_block, bool* eos) {
     // Only have one receive data queue of data, no need to do merge and
     // copy the data of block.
     // return the data in receive data directly
-    if (_priority_queue.size() == 1) {
-        auto current = _priority_queue.top();
+    if (_merge_tree.size() == 1) {
+        auto current = _merge_tree.top();
         while (_offset != 0 && current->block_ptr() != nullptr) {
             if (_offset >= current->rows - current->pos) {
                 _offset -= (current->rows - current->pos);
@@ -126,21 +128,46 @@ Status VSortedRunMerger::get_next(Block* output_block, bool* eos) {
         MutableColumns merged_columns =
                 mem_reuse ? output_block->mutate_columns() : _empty_block.clone_empty_columns();
 
-        /// Take rows from queue in right order and push to 'merged'.
+        /// Take rows from the tree in right order and push to 'merged'.
         size_t merged_rows = 0;
-        while (!_priority_queue.empty()) {
-            auto current = _priority_queue.top();
-            _priority_queue.pop();
-
-            if (_offset > 0) {
-                _offset--;
+        while (!_merge_tree.empty() && merged_rows < _batch_size) {
+            auto current = _merge_tree.top();
+            // the rows of the top run are copied as a range until another run wins
+            size_t start = current->pos;
+            size_t num_rows = 0;
+            bool stay_top = true;
+            while (stay_top) {
+                if (_offset > 0) {
+                    _offset--;
+                    start = current->pos + 1;
+                } else {
+                    ++num_rows;
+                }
+                if (current->isLast() || merged_rows + num_rows == _batch_size) {
+                    break;
+                }
+                current->next();
+                stay_top = _merge_tree.update_top();
+            }
+            if (num_rows > 0) {
+                for (size_t i = 0; i < num_columns; ++i) {
+                    merged_columns[i]->insert_range_from(*current->all_columns[i], start,
+                                                         num_rows);
+                }
+                merged_rows += num_rows;
+            }
+            if (!stay_top) {
+                continue;
+            }
+            // the last copied row is still the current one of the top run
+            if (!current->isLast()) {
+                current->next();
+                _merge_tree.update_top();
+            } else if (has_next_block(current)) {
+                _merge_tree.update_top();
             } else {
-                for (size_t i = 0; i < num_columns; ++i)
-                    merged_columns[i]->insert_from(*current->all_columns[i], current->pos);
-                ++merged_rows;
+                _merge_tree.pop_top();
             }
-            next_heap(current);
-            if (merged_rows == _batch_size) break;
         }
 
         if (merged_rows == 0) {
@@ -162,15 +189,6 @@ Status VSortedRunMerger::get_next(Block* output_block, bool* eos) {
     return Status::OK();
 }
 
-void VSortedRunMerger::next_heap(MergeSortCursor& current) {
-    if (!current->isLast()) {
-        current->next();
-        _priority_queue.push(current);
-    } else if (has_next_block(current)) {
-        _priority_queue.push(current);
-    }
-}
-
 inline bool VSortedRunMerger::has_next_block(doris::vectorized::MergeSortCursor& current) {
     ScopedTimer<MonotonicStopWatch> timer(_get_next_block_timer);
     return current->has_next_block();
@@ -17,8 +17,7 @@
 
 #pragma once
 
-#include <queue>
-
+#include "vec/core/loser_tree.h"
 #include "vec/core/sort_cursor.h"
 
 namespace doris {
@@ -29,8 +28,9 @@ namespace vectorized {
 class Block;
 // VSortedRunMerger is used to merge multiple sorted runs of blocks. A run is a sorted
 // sequence of blocks, which are fetched from a BlockSupplier function object.
-// Merging is implemented using a binary min-heap that maintains the run with the next
-// rows in sorted order at the top of the heap.
+// Merging is implemented using a tree of losers that maintains the run with the next
+// rows in sorted order at the top of the tree, and the consecutive rows of the same run
+// are copied as a range.
 //
 // Merged block of rows are retrieved from VSortedRunMerger via calls to get_next().
 class VSortedRunMerger {
@@ -68,8 +68,14 @@ protected:
     int64_t _limit = -1;
     size_t _offset = 0;
 
+    struct CursorGreater {
+        bool operator()(const MergeSortCursor& lhs, const MergeSortCursor& rhs) const {
+            return lhs.greater(rhs);
+        }
+    };
+
     std::vector<BlockSupplierSortCursorImpl> _cursors;
-    std::priority_queue<MergeSortCursor> _priority_queue;
+    LoserTree<MergeSortCursor, CursorGreater> _merge_tree;
 
     Block _empty_block;
 
@@ -81,7 +87,6 @@ protected:
 
 private:
     void init_timers(RuntimeProfile* profile);
-    void next_heap(MergeSortCursor& current);
     bool has_next_block(MergeSortCursor& current);
 };
 
@@ -128,7 +128,10 @@ Status Channel::send_local_block(Block* block) {
         COUNTER_UPDATE(_parent->_local_bytes_send_counter, block->bytes());
         COUNTER_UPDATE(_parent->_local_sent_rows, block->rows());
         COUNTER_UPDATE(_parent->_blocks_sent_counter, 1);
-        _local_recvr->add_block(block, _parent->_sender_id, false);
+        // The columns are not copied but shared by all the local receivers of the block, and
+        // the receiver copies them when it gets the block only if they are still shared then.
+        Block shared_block(block->get_columns_with_type_and_name());
+        _local_recvr->add_block(&shared_block, _parent->_sender_id, true);
     }
     return Status::OK();
 }
@@ -457,6 +460,14 @@ Status VDataStreamSender::prepare(RuntimeState* state) {
                                profile()->total_time_counter()),
             "");
     _local_bytes_send_counter = ADD_COUNTER(profile(), "LocalBytesSent", TUnit::BYTES);
+    _hot_keys_counter = ADD_COUNTER(profile(), "HotKeys", TUnit::UNIT);
+    _hot_key_rows_counter = ADD_COUNTER(profile(), "HotKeyRows", TUnit::UNIT);
+    _max_channel_rows_percent_counter =
+            ADD_COUNTER(profile(), "MaxChannelRowsPercentOfAvg", TUnit::UNIT);
+    _hot_key_sample_interval = config::exchange_hot_key_sample_interval;
+    if (_part_type == TPartitionType::HASH_PARTITIONED && _hot_key_sample_interval > 0) {
+        _hot_key_sketch = std::make_unique<SpaceSaving>(HOT_KEY_SKETCH_CAPACITY);
+    }
     return Status::OK();
 }
 
@@ -471,6 +482,7 @@ Status VDataStreamSender::open(RuntimeState* state) {
         }
     }
     _only_local_exchange = local_size == _channels.size();
+    _has_local_exchange = local_size > 0;
     SCOPED_CONSUME_MEM_TRACKER(_mem_tracker.get());
     RETURN_IF_ERROR(VExpr::open(_partition_expr_ctxs, state));
 
@@ -496,6 +508,11 @@ Status VDataStreamSender::send(RuntimeState* state, Block* block, bool eos) {
                 SCOPED_CONSUME_MEM_TRACKER(_mem_tracker.get());
                 RETURN_IF_ERROR(
                         serialize_block(block, block_holder->get_block(), _channels.size()));
+                if (config::exchange_transfer_block_by_attachment_ref) {
+                    block_holder->detach_column_values();
+                } else {
+                    block_holder->reset_column_values();
+                }
             }
 
             for (auto channel : _channels) {
@@ -523,6 +540,11 @@ Status VDataStreamSender::send(RuntimeState* state, Block* block, bool eos) {
             // rollover
             _roll_pb_block();
         }
+        if (_has_local_exchange) {
+            // The columns of block are shared by the local receivers, the caller must not
+            // clear them in place when it reuses block.
+            block->set_columns(block->clone_empty_columns());
+        }
     } else if (_part_type == TPartitionType::RANDOM) {
         // 1. select channel
         Channel* current_channel = _channels[_current_channel_idx];
@@ -566,7 +588,11 @@ Status VDataStreamSender::send(RuntimeState* state, Block* block, bool eos) {
                     block->get_by_position(result[j]).column->update_hashes_with_value(siphashs);
                 }
                 for (int i = 0; i < rows; i++) {
-                    hashes[i] = siphashs[i].get64() % element_size;
+                    hashes[i] = siphashs[i].get64();
+                }
+                _sample_hot_keys(hashes, rows);
+                for (int i = 0; i < rows; i++) {
+                    hashes[i] = hashes[i] % element_size;
                 }
             } else {
                 SCOPED_TIMER(_split_block_hash_compute_timer);
@@ -574,6 +600,7 @@ Status VDataStreamSender::send(RuntimeState* state, Block* block, bool eos) {
                 for (int j = 0; j < result_size; ++j) {
                     block->get_by_position(result[j]).column->update_hashes_with_value(hashes);
                 }
+                _sample_hot_keys(hashes, rows);
 
                 for (int i = 0; i < rows; i++) {
                     hashes[i] = hashes[i] % element_size;
@@ -611,10 +638,48 @@ Status VDataStreamSender::send(RuntimeState* state, Block* block, bool eos) {
     return Status::OK();
 }
 
+void VDataStreamSender::_sample_hot_keys(const uint64_t* hashes, int rows) {
+    if (!_hot_key_sketch) {
+        return;
+    }
+    int i = _hot_key_sample_next;
+    for (; i < rows; i += _hot_key_sample_interval) {
+        _hot_key_sketch->insert(hashes[i]);
+    }
+    _hot_key_sample_next = i - rows;
+}
+
+void VDataStreamSender::_update_skew_counters() {
+    if (_channel_rows.empty()) {
+        return;
+    }
+    int64_t total_rows = 0;
+    int64_t max_rows = 0;
+    for (auto rows : _channel_rows) {
+        total_rows += rows;
+        max_rows = std::max(max_rows, rows);
+    }
+    if (total_rows > 0) {
+        COUNTER_SET(_max_channel_rows_percent_counter,
+                    max_rows * 100 * (int64_t)_channel_rows.size() / total_rows);
+    }
+    if (_hot_key_sketch && _hot_key_sketch->total() > 0) {
+        auto hot_keys = _hot_key_sketch->heavy_hitters(
+                std::max<uint64_t>(1, _hot_key_sketch->total() / _channel_rows.size()));
+        int64_t hot_key_rows = 0;
+        for (const auto& key : hot_keys) {
+            hot_key_rows += (key.count - key.error) * _hot_key_sample_interval;
+        }
+        COUNTER_SET(_hot_keys_counter, (int64_t)hot_keys.size());
+        COUNTER_SET(_hot_key_rows_counter, hot_key_rows);
+    }
+}
+
 Status VDataStreamSender::close(RuntimeState* state, Status exec_status) {
     if (_closed) {
         return Status::OK();
     }
+    _update_skew_counters();
 
     START_AND_SCOPE_SPAN(state->get_tracer(), span, "VDataStreamSender::close");
     Status final_st = Status::OK();
@@ -28,6 +28,7 @@
 #include "runtime/descriptors.h"
 #include "service/backend_options.h"
 #include "util/ref_count_closure.h"
+#include "util/space_saving.h"
 #include "util/uid_util.h"
 #include "vec/exprs/vexpr.h"
 #include "vec/exprs/vexpr_context.h"
@@ -80,9 +81,23 @@ public:
 
     PBlock* get_block() { return &pblock; }
 
+    // Move column_values out of pblock after it is serialized, so that brpc attachments can
+    // reference it without copy, even after this holder is reused or destroyed.
+    void detach_column_values() {
+        auto column_values = std::make_shared<std::string>();
+        column_values->swap(*pblock.mutable_column_values());
+        _column_values = std::move(column_values);
+    }
+
+    // nullptr if column_values is not detached from pblock.
+    std::shared_ptr<const std::string> column_values() const { return _column_values; }
+
+    void reset_column_values() { _column_values.reset(); }
+
 private:
     AtomicWrapper<uint32_t> _ref_count;
     PBlock pblock;
+    std::shared_ptr<const std::string> _column_values;
 };
 
 class VDataStreamSender : public DataSink {
@@ -151,6 +166,10 @@ protected:
 
     Status handle_unpartitioned(Block* block);
 
+    // hashes are the hash values of the partition columns before modulo
+    void _sample_hot_keys(const uint64_t* hashes, int rows);
+    void _update_skew_counters();
+
     // Sender instance id, unique within a fragment.
     int _sender_id;
 
@@ -199,6 +218,20 @@ protected:
     RuntimeProfile::Counter* _overall_throughput;
     // Used to counter send bytes under local data exchange
     RuntimeProfile::Counter* _local_bytes_send_counter;
+    // Keys which alone send more rows than the average rows of the channels
+    RuntimeProfile::Counter* _hot_keys_counter;
+    // Estimated rows of the hot keys
+    RuntimeProfile::Counter* _hot_key_rows_counter;
+    // Max rows sent to a channel, in percent of the average rows of the channels
+    RuntimeProfile::Counter* _max_channel_rows_percent_counter;
+
+    static constexpr size_t HOT_KEY_SKETCH_CAPACITY = 64;
+    // Sampled partition hash values of hash partitioned exchange, nullptr if not detected
+    std::unique_ptr<SpaceSaving> _hot_key_sketch;
+    int _hot_key_sample_interval = 0;
+    int _hot_key_sample_next = 0;
+    // rows sent to each channel by hash partitioned exchange
+    std::vector<int64_t> _channel_rows;
     // Identifier of the destination plan node.
     PlanNodeId _dest_node_id;
 
@@ -209,6 +242,7 @@ protected:
 
     bool _new_shuffle_hash_method = false;
     bool _only_local_exchange = false;
+    bool _has_local_exchange = false;
     bool _enable_pipeline_exec = false;
 };
 
@@ -385,7 +419,9 @@ Status VDataStreamSender::channel_add_rows(Channels& channels, int num_channels,
         channel2rows[channel_ids[i]].emplace_back(i);
     }
 
+    _channel_rows.resize(num_channels);
     for (int i = 0; i < num_channels; ++i) {
+        _channel_rows[i] += channel2rows[i].size();
         if (!channel2rows[i].empty()) {
             RETURN_IF_ERROR(channels[i]->add_rows(block, channel2rows[i]));
         }
@@ -434,8 +470,14 @@ public:
             }
         }
         if (eos || block->column_metas_size()) {
-            RETURN_IF_ERROR(_buffer->add_block(
-                    {this, block ? std::make_unique<PBlock>(*block) : nullptr, eos}));
+            std::unique_ptr<PBlock> pblock;
+            if (block) {
+                // block is serialized again before it is sent next time, so take its
+                // content instead of copying it.
+                pblock = std::make_unique<PBlock>();
+                pblock->Swap(block);
+            }
+            RETURN_IF_ERROR(_buffer->add_block({this, std::move(pblock), eos}));
         }
         return Status::OK();
     }
@@ -460,15 +502,15 @@ public:
             return send_local_block(eos);
         }
 
-        PBlock* block_ptr = nullptr;
+        std::unique_ptr<PBlock> block_ptr;
         if (_mutable_block) {
-            block_ptr = new PBlock(); // TODO: need a pool of PBlock()
+            block_ptr = std::make_unique<PBlock>(); // TODO: need a pool of PBlock()
             auto block = _mutable_block->to_block();
-            RETURN_IF_ERROR(_parent->serialize_block(&block, block_ptr));
+            RETURN_IF_ERROR(_parent->serialize_block(&block, block_ptr.get()));
             block.clear_column_data();
             _mutable_block->set_muatable_columns(block.mutate_columns());
         }
-        RETURN_IF_ERROR(send_block(block_ptr, eos));
+        RETURN_IF_ERROR(send_block(block_ptr.get(), eos));
         return Status::OK();
     }
 
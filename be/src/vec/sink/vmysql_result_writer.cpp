@@ -81,8 +81,12 @@ Status VMysqlResultWriter<is_binary_format>::_add_one_column(
     }
 
     doris::vectorized::ColumnPtr column;
+    // read the null map directly instead of a virtual call per cell
+    [[maybe_unused]] const UInt8* null_map = nullptr;
     if constexpr (is_nullable) {
-        column = assert_cast<const ColumnNullable&>(*column_ptr).get_nested_column_ptr();
+        const auto& nullable_column = assert_cast<const ColumnNullable&>(*column_ptr);
+        column = nullable_column.get_nested_column_ptr();
+        null_map = nullable_column.get_null_map_data().data();
     } else {
         column = column_ptr;
     }
@@ -97,7 +101,7 @@ Status VMysqlResultWriter<is_binary_format>::_add_one_column(
             }
 
             if constexpr (is_nullable) {
-                if (column_ptr->is_null_at(i)) {
+                if (null_map[i]) {
                     buf_ret = rows_buffer[i].push_null();
                     continue;
                 }
@@ -173,7 +177,7 @@ Status VMysqlResultWriter<is_binary_format>::_add_one_column(
             }
 
             if constexpr (is_nullable) {
-                if (column_ptr->is_null_at(i)) {
+                if (null_map[i]) {
                     buf_ret = rows_buffer[i].push_null();
                     continue;
                 }
@@ -212,7 +216,7 @@ Status VMysqlResultWriter<is_binary_format>::_add_one_column(
             }
 
             if constexpr (is_nullable) {
-                if (column_ptr->is_null_at(i)) {
+                if (null_map[i]) {
                     buf_ret = rows_buffer[i].push_null();
                     continue;
                 }
@@ -232,7 +236,7 @@ Status VMysqlResultWriter<is_binary_format>::_add_one_column(
             }
 
             if constexpr (is_nullable) {
-                if (column_ptr->is_null_at(i)) {
+                if (null_map[i]) {
                     buf_ret = rows_buffer[i].push_null();
                     continue;
                 }
@@ -271,7 +275,7 @@ Status VMysqlResultWriter<is_binary_format>::_add_one_column(
             }
 
             if constexpr (is_nullable) {
-                if (column_ptr->is_null_at(i)) {
+                if (null_map[i]) {
                     buf_ret = rows_buffer[i].push_null();
                     continue;
                 }
@@ -289,7 +293,7 @@ Status VMysqlResultWriter<is_binary_format>::_add_one_column(
             }
 
             if constexpr (is_nullable) {
-                if (column_ptr->is_null_at(i)) {
+                if (null_map[i]) {
                     buf_ret = rows_buffer[i].push_null();
                     continue;
                 }
@@ -312,8 +316,7 @@ Status VMysqlResultWriter<is_binary_format>::_add_one_column(
                 buf_ret = rows_buffer[i].push_bigint(data[i]);
             }
             if constexpr (type == TYPE_LARGEINT) {
-                auto v = LargeIntValue::to_string(data[i]);
-                buf_ret = rows_buffer[i].push_string(v.c_str(), v.size());
+                buf_ret = rows_buffer[i].push_largeint(data[i]);
             }
             if constexpr (type == TYPE_FLOAT) {
                 buf_ret = rows_buffer[i].push_float(data[i]);
@@ -337,16 +340,19 @@ Status VMysqlResultWriter<is_binary_format>::_add_one_column(
             }
             if constexpr (type == TYPE_DATETIMEV2) {
                 auto time_num = data[i];
-                char buf[64];
                 DateV2Value<DateTimeV2ValueType> date_val =
                         binary_cast<UInt64, DateV2Value<DateTimeV2ValueType>>(time_num);
-                char* pos = date_val.to_string(buf, scale);
-                buf_ret = rows_buffer[i].push_string(buf, pos - buf - 1);
+                if constexpr (is_binary_format) {
+                    buf_ret = rows_buffer[i].push_vec_datetime(date_val);
+                } else {
+                    char buf[64];
+                    char* pos = date_val.to_string(buf, scale);
+                    buf_ret = rows_buffer[i].push_string(buf, pos - buf - 1);
+                }
             }
             if constexpr (type == TYPE_DECIMALV2) {
                 DecimalV2Value decimal_val(data[i]);
-                auto decimal_str = decimal_val.to_string(scale);
-                buf_ret = rows_buffer[i].push_string(decimal_str.c_str(), decimal_str.length());
+                buf_ret = rows_buffer[i].push_decimal(decimal_val, scale);
             }
         }
     }
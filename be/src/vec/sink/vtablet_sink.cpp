@@ -198,10 +198,10 @@ VNodeChannel::~VNodeChannel() {
         }
         _open_closure = nullptr;
     }
-    if (_add_block_closure != nullptr) {
-        delete _add_block_closure;
-        _add_block_closure = nullptr;
+    for (auto* closure : _add_block_closures) {
+        delete closure;
     }
+    _add_block_closures.clear();
     if (_open_closure != nullptr) {
         delete _open_closure;
     }
@@ -330,9 +330,17 @@ Status VNodeChannel::open_wait() {
         return status;
     }
 
-    // add block closure
-    _add_block_closure = ReusableClosure<PTabletWriterAddBlockResult>::create();
-    _add_block_closure->addFailedHandler([this](bool is_last_rpc) {
+    // add block closures, one for each rpc in flight
+    int max_in_flight = std::max(config::tablet_writer_add_block_max_in_flight, 1);
+    for (int i = 0; i < max_in_flight; ++i) {
+        _add_block_closures.push_back(_create_add_block_closure());
+    }
+    return status;
+}
+
+ReusableClosure<PTabletWriterAddBlockResult>* VNodeChannel::_create_add_block_closure() {
+    auto* closure = ReusableClosure<PTabletWriterAddBlockResult>::create();
+    closure->addFailedHandler([this, closure](bool is_last_rpc) {
         SCOPED_ATTACH_TASK(_state);
         std::lock_guard<std::mutex> l(this->_closed_lock);
         if (this->_is_closed) {
@@ -343,8 +351,8 @@ Status VNodeChannel::open_wait() {
         // If rpc failed, mark all tablets on this node channel as failed
         _index_channel->mark_as_failed(this->node_id(), this->host(),
                                        fmt::format("rpc failed, error coed:{}, error text:{}",
-                                                   _add_block_closure->cntl.ErrorCode(),
-                                                   _add_block_closure->cntl.ErrorText()),
+                                                   closure->cntl.ErrorCode(),
+                                                   closure->cntl.ErrorText()),
                                        -1);
         Status st = _index_channel->check_intolerable_failure();
         if (!st.ok()) {
@@ -356,8 +364,8 @@ Status VNodeChannel::open_wait() {
         }
     });
 
-    _add_block_closure->addSuccessHandler([this](const PTabletWriterAddBlockResult& result,
-                                                 bool is_last_rpc) {
+    closure->addSuccessHandler([this, closure](const PTabletWriterAddBlockResult& result,
+                                               bool is_last_rpc) {
         SCOPED_ATTACH_TASK(_state);
         std::lock_guard<std::mutex> l(this->_closed_lock);
         if (this->_is_closed) {
@@ -419,8 +427,15 @@ Status VNodeChannel::open_wait() {
             _add_batch_counter.add_batch_wait_execution_time_us += result.wait_execution_time_us();
             _add_batch_counter.add_batch_num++;
         }
+        _load_statistics.rpc_ns += closure->cntl.latency_us() * NANOS_PER_MICRO;
+        _load_statistics.mem_limit_wait_ns += result.mem_limit_wait_time_us() * NANOS_PER_MICRO;
+        if (result.has_load_statistics()) {
+            LoadStatistics writer_statistics;
+            writer_statistics.from_pb(result.load_statistics());
+            _load_statistics.merge(writer_statistics);
+        }
     });
-    return status;
+    return closure;
 }
 
 Status VNodeChannel::add_block(vectorized::Block* block, const Payload* payload, bool is_append) {
@@ -549,27 +564,58 @@ int VNodeChannel::try_send_and_fetch_status(RuntimeState* state,
         return 0;
     }
 
-    if (!_add_block_closure->try_set_in_flight()) {
-        return _send_finished ? 0 : 1;
-    }
-
-    // We are sure that try_send_batch is not running
-    if (_pending_batches_num > 0) {
-        auto s = thread_pool_token->submit_func(
-                std::bind(&VNodeChannel::try_send_block, this, state));
+    // Send a pending block with each closure not in flight. The receiver writes the blocks
+    // of this sender in the order of packet_seq, even if the rpcs arrive out of order.
+    for (auto* closure : _add_block_closures) {
+        if (!closure->try_set_in_flight()) {
+            continue;
+        }
+        // We are sure that try_send_block is not running with this closure
+        auto send_block = _pop_pending_block(closure);
+        if (send_block == nullptr) {
+            // clear in flight
+            closure->clear_in_flight();
+            break;
+        }
+        auto s = thread_pool_token->submit_func([this, state, closure, send_block]() {
+            try_send_block(state, closure, send_block);
+        });
         if (!s.ok()) {
             _cancel_with_msg("submit send_batch task to send_batch_thread_pool failed");
             // clear in flight
-            _add_block_closure->clear_in_flight();
+            closure->clear_in_flight();
+            break;
         }
         // in_flight is cleared in closure::Run
-    } else {
-        // clear in flight
-        _add_block_closure->clear_in_flight();
     }
     return _send_finished ? 0 : 1;
 }
 
+std::shared_ptr<VNodeChannel::AddBlockReq> VNodeChannel::_pop_pending_block(
+        ReusableClosure<PTabletWriterAddBlockResult>* closure) {
+    debug::ScopedTSANIgnoreReadsAndWrites ignore_tsan;
+    std::lock_guard<std::mutex> l(_pending_batches_lock);
+    if (_pending_blocks.empty()) {
+        return nullptr;
+    }
+    // eos request must be the last request, the receiver closes the tablets channel
+    // of this sender on it, so send it after all the former ones are responded.
+    if (_pending_blocks.front().second.eos() &&
+        std::any_of(_add_block_closures.begin(), _add_block_closures.end(),
+                    [closure](auto* other) {
+                        return other != closure && other->is_packet_in_flight();
+                    })) {
+        return nullptr;
+    }
+    auto send_block = std::make_shared<AddBlockReq>(std::move(_pending_blocks.front()));
+    _pending_blocks.pop();
+    _pending_batches_num--;
+    _pending_batches_bytes -= send_block->first->allocated_bytes();
+    // tablet_ids has already set when add row
+    send_block->second.set_packet_seq(_next_packet_seq++);
+    return send_block;
+}
+
 void VNodeChannel::_cancel_with_msg(const std::string& msg) {
     LOG(WARNING) << "cancel node channel " << channel_info() << ", error message: " << msg;
     {
@@ -597,26 +643,16 @@ Status VNodeChannel::none_of(std::initializer_list<bool> vars) {
     return st;
 }
 
-void VNodeChannel::try_send_block(RuntimeState* state) {
+void VNodeChannel::try_send_block(RuntimeState* state,
+                                  ReusableClosure<PTabletWriterAddBlockResult>* closure,
+                                  std::shared_ptr<AddBlockReq> send_block) {
     SCOPED_ATTACH_TASK(state);
     SCOPED_CONSUME_MEM_TRACKER(_node_channel_tracker);
     SCOPED_ATOMIC_TIMER(&_actual_consume_ns);
-    AddBlockReq send_block;
-    {
-        debug::ScopedTSANIgnoreReadsAndWrites ignore_tsan;
-        std::lock_guard<std::mutex> l(_pending_batches_lock);
-        DCHECK(!_pending_blocks.empty());
-        send_block = std::move(_pending_blocks.front());
-        _pending_blocks.pop();
-        _pending_batches_num--;
-        _pending_batches_bytes -= send_block.first->allocated_bytes();
-    }
+    auto mutable_block = std::move(send_block->first);
+    auto request = std::move(send_block->second); // doesn't need to be saved in heap
+    send_block.reset();
 
-    auto mutable_block = std::move(send_block.first);
-    auto request = std::move(send_block.second); // doesn't need to be saved in heap
-
-    // tablet_ids has already set when add row
-    request.set_packet_seq(_next_packet_seq);
     auto block = mutable_block->to_block();
     if (block.rows() > 0) {
         SCOPED_ATOMIC_TIMER(&_serialize_batch_ns);
@@ -627,7 +663,7 @@ void VNodeChannel::try_send_block(RuntimeState* state) {
                                     _parent->_transfer_large_data_by_brpc);
         if (!st.ok()) {
             cancel(fmt::format("{}, err: {}", channel_info(), st.to_string()));
-            _add_block_closure->clear_in_flight();
+            closure->clear_in_flight();
             return;
         }
         if (compressed_bytes >= double(config::brpc_max_body_size) * 0.95f) {
@@ -641,17 +677,17 @@ void VNodeChannel::try_send_block(RuntimeState* state) {
     if (UNLIKELY(remain_ms < config::min_load_rpc_timeout_ms)) {
         if (remain_ms <= 0 && !request.eos()) {
             cancel(fmt::format("{}, err: timeout", channel_info()));
-            _add_block_closure->clear_in_flight();
+            closure->clear_in_flight();
             return;
         } else {
             remain_ms = config::min_load_rpc_timeout_ms;
         }
     }
 
-    _add_block_closure->reset();
-    _add_block_closure->cntl.set_timeout_ms(remain_ms);
+    closure->reset();
+    closure->cntl.set_timeout_ms(remain_ms);
     if (config::tablet_writer_ignore_eovercrowded) {
-        _add_block_closure->cntl.ignore_eovercrowded();
+        closure->cntl.ignore_eovercrowded();
     }
 
     if (request.eos()) {
@@ -682,7 +718,7 @@ void VNodeChannel::try_send_block(RuntimeState* state) {
         }
 
         // eos request must be the last request
-        _add_block_closure->end_mark();
+        closure->end_mark();
         _send_finished = true;
         CHECK(_pending_batches_num == 0) << _pending_batches_num;
     }
@@ -691,10 +727,10 @@ void VNodeChannel::try_send_block(RuntimeState* state) {
         request.block().has_column_values() && request.ByteSizeLong() > MIN_HTTP_BRPC_SIZE) {
         Status st = request_embed_attachment_contain_block<
                 PTabletWriterAddBlockRequest, ReusableClosure<PTabletWriterAddBlockResult>>(
-                &request, _add_block_closure);
+                &request, closure);
         if (!st.ok()) {
             cancel(fmt::format("{}, err: {}", channel_info(), st.to_string()));
-            _add_block_closure->clear_in_flight();
+            closure->clear_in_flight();
             return;
         }
 
@@ -703,27 +739,24 @@ void VNodeChannel::try_send_block(RuntimeState* state) {
         std::shared_ptr<PBackendService_Stub> _brpc_http_stub =
                 _state->exec_env()->brpc_internal_client_cache()->get_new_client_no_cache(brpc_url,
                                                                                           "http");
-        _add_block_closure->cntl.http_request().uri() =
+        closure->cntl.http_request().uri() =
                 brpc_url + "/PInternalServiceImpl/tablet_writer_add_block_by_http";
-        _add_block_closure->cntl.http_request().set_method(brpc::HTTP_METHOD_POST);
-        _add_block_closure->cntl.http_request().set_content_type("application/json");
+        closure->cntl.http_request().set_method(brpc::HTTP_METHOD_POST);
+        closure->cntl.http_request().set_content_type("application/json");
 
         {
             SCOPED_SWITCH_THREAD_MEM_TRACKER_LIMITER(ExecEnv::GetInstance()->orphan_mem_tracker());
-            _brpc_http_stub->tablet_writer_add_block_by_http(&_add_block_closure->cntl, nullptr,
-                                                             &_add_block_closure->result,
-                                                             _add_block_closure);
+            _brpc_http_stub->tablet_writer_add_block_by_http(&closure->cntl, nullptr,
+                                                             &closure->result, closure);
         }
     } else {
-        _add_block_closure->cntl.http_request().Clear();
+        closure->cntl.http_request().Clear();
         {
             SCOPED_SWITCH_THREAD_MEM_TRACKER_LIMITER(ExecEnv::GetInstance()->orphan_mem_tracker());
-            _stub->tablet_writer_add_block(&_add_block_closure->cntl, &request,
-                                           &_add_block_closure->result, _add_block_closure);
+            _stub->tablet_writer_add_block(&closure->cntl, &request, &closure->result,
+                                           closure);
         }
     }
-
-    _next_packet_seq++;
 }
 
 void VNodeChannel::cancel(const std::string& cancel_msg) {
@@ -1049,11 +1082,11 @@ Status VOlapTableSink::find_tablet(RuntimeState* state, vectorized::Block* block
                                    const VOlapTablePartition** partition, uint32_t& tablet_index,
                                    bool& stop_processing, bool& is_continue) {
     Status status = Status::OK();
-    *partition = nullptr;
+    *partition = _row_partitions[row_index];
     tablet_index = 0;
     BlockRow block_row;
     block_row = {block, row_index};
-    if (!_vpartition->find_partition(&block_row, partition)) {
+    if (*partition == nullptr) {
         RETURN_IF_ERROR(state->append_error_msg_to_file(
                 []() -> std::string { return ""; },
                 [&]() -> std::string {
@@ -1084,7 +1117,7 @@ Status VOlapTableSink::find_tablet(RuntimeState* state, vectorized::Block* block
             tablet_index = _partition_to_tablet_map[(*partition)->id];
         }
     } else {
-        tablet_index = _vpartition->find_tablet(&block_row, **partition);
+        tablet_index = _row_tablet_indexes[row_index];
     }
 
     return status;
@@ -1100,14 +1133,12 @@ void VOlapTableSink::_generate_row_distribution_payload(
         DCHECK(it != _channels[j]->_channels_by_tablet.end())
                 << "unknown tablet, tablet_id=" << tablet_index;
         for (const auto& channel : it->second) {
-            if (channel_to_payload[j].count(channel.get()) < 1) {
-                channel_to_payload[j].insert(
-                        {channel.get(), Payload {std::unique_ptr<vectorized::IColumn::Selector>(
-                                                         new vectorized::IColumn::Selector()),
-                                                 std::vector<int64_t>()}});
+            auto& payload = channel_to_payload[j][channel.get()];
+            if (payload.first == nullptr) {
+                payload.first.reset(new vectorized::IColumn::Selector());
             }
-            channel_to_payload[j][channel.get()].first->push_back(row_idx);
-            channel_to_payload[j][channel.get()].second.push_back(tid);
+            payload.first->push_back(row_idx);
+            payload.second.push_back(tid);
         }
         _number_output_rows += row_cnt;
     }
@@ -1168,6 +1199,10 @@ Status VOlapTableSink::send(RuntimeState* state, vectorized::Block* input_block,
         // Recaculate is needed
         _partition_to_tablet_map.clear();
     }
+    _vpartition->find_partitions(&block, num_rows, &_row_partitions);
+    if (findTabletMode == FindTabletMode::FIND_TABLET_EVERY_ROW) {
+        _vpartition->find_tablets(&block, num_rows, _row_partitions, &_row_tablet_indexes);
+    }
     for (int i = 0; i < num_rows; ++i) {
         if (UNLIKELY(filtered_rows) > 0 && _filter_bitmap.Get(i)) {
             continue;
@@ -1241,6 +1276,7 @@ Status VOlapTableSink::close(RuntimeState* state, Status exec_status) {
         int64_t serialize_batch_ns = 0, mem_exceeded_block_ns = 0, queue_push_lock_ns = 0,
                 actual_consume_ns = 0, total_add_batch_exec_time_ns = 0,
                 max_add_batch_exec_time_ns = 0, total_add_batch_num = 0, num_node_channels = 0;
+        LoadStatistics load_statistics;
         {
             SCOPED_TIMER(_close_timer);
             for (auto index_channel : _channels) {
@@ -1254,8 +1290,8 @@ Status VOlapTableSink::close(RuntimeState* state, Status exec_status) {
                 index_channel->for_each_node_channel(
                         [&index_channel, &state, &node_add_batch_counter_map, &serialize_batch_ns,
                          &mem_exceeded_block_ns, &queue_push_lock_ns, &actual_consume_ns,
-                         &total_add_batch_exec_time_ns, &add_batch_exec_time,
-                         &total_add_batch_num](const std::shared_ptr<VNodeChannel>& ch) {
+                         &total_add_batch_exec_time_ns, &add_batch_exec_time, &total_add_batch_num,
+                         &load_statistics](const std::shared_ptr<VNodeChannel>& ch) {
                             auto s = ch->close_wait(state);
                             if (!s.ok()) {
                                 auto err_msg = s.to_string();
@@ -1270,6 +1306,7 @@ Status VOlapTableSink::close(RuntimeState* state, Status exec_status) {
                                             &mem_exceeded_block_ns, &queue_push_lock_ns,
                                             &actual_consume_ns, &total_add_batch_exec_time_ns,
                                             &add_batch_exec_time, &total_add_batch_num);
+                            ch->collect_load_statistics(&load_statistics);
                         });
 
                 if (add_batch_exec_time > max_add_batch_exec_time_ns) {
@@ -1304,6 +1341,8 @@ Status VOlapTableSink::close(RuntimeState* state, Status exec_status) {
         COUNTER_SET(_max_add_batch_exec_timer, max_add_batch_exec_time_ns);
         COUNTER_SET(_add_batch_number, total_add_batch_num);
         COUNTER_SET(_num_node_channels, num_node_channels);
+        load_statistics.update_profile(_profile);
+        state->load_statistics().merge(load_statistics);
         // _number_input_rows don't contain num_rows_load_filtered and num_rows_load_unselected in scan node
         int64_t num_rows_load_total = _number_input_rows + state->num_rows_load_filtered() +
                                       state->num_rows_load_unselected();
@@ -32,6 +32,7 @@
 #include "exec/tablet_info.h"
 #include "gen_cpp/Types_types.h"
 #include "gen_cpp/internal_service.pb.h"
+#include "runtime/load_statistics.h"
 #include "runtime/thread_context.h"
 #include "util/bitmap.h"
 #include "util/countdown_latch.h"
@@ -186,7 +187,11 @@ public:
     int try_send_and_fetch_status(RuntimeState* state,
                                   std::unique_ptr<ThreadPoolToken>& thread_pool_token);
 
-    void try_send_block(RuntimeState* state);
+    using AddBlockReq =
+            std::pair<std::unique_ptr<vectorized::MutableBlock>, PTabletWriterAddBlockRequest>;
+
+    void try_send_block(RuntimeState* state, ReusableClosure<PTabletWriterAddBlockResult>* closure,
+                        std::shared_ptr<AddBlockReq> send_block);
 
     void clear_all_blocks();
 
@@ -218,6 +223,12 @@ public:
         *total_add_batch_num += _add_batch_counter.add_batch_num;
     }
 
+    // Adds the time of the rpcs and of the backend writing the tablets, after close_wait().
+    void collect_load_statistics(LoadStatistics* statistics) const {
+        statistics->merge(_load_statistics);
+        statistics->rpc_pending_wait_ns += _mem_exceeded_block_ns;
+    }
+
     int64_t node_id() const { return _node_id; }
     std::string host() const { return _node_info.host; }
     std::string name() const { return _name; }
@@ -234,6 +245,11 @@ public:
 protected:
     void _close_check();
     void _cancel_with_msg(const std::string& msg);
+    // pop the next pending block to send with the closure, it's nullptr if there is none
+    // or the next one is the eos request while other rpcs are still in flight.
+    ReusableClosure<PTabletWriterAddBlockResult>* _create_add_block_closure();
+    std::shared_ptr<AddBlockReq> _pop_pending_block(
+            ReusableClosure<PTabletWriterAddBlockResult>* closure);
 
     VOlapTableSink* _parent = nullptr;
     IndexChannel* _index_channel = nullptr;
@@ -289,6 +305,8 @@ protected:
     std::atomic<int64_t> _mem_exceeded_block_ns {0};
     std::atomic<int64_t> _queue_push_lock_ns {0};
     std::atomic<int64_t> _actual_consume_ns {0};
+    // updated in the rpc callbacks with _closed_lock held
+    LoadStatistics _load_statistics;
 
     // lock to protect _is_closed.
     // The methods in the IndexChannel are called back in the RpcClosure in the NodeChannel.
@@ -308,10 +326,9 @@ protected:
     std::unique_ptr<vectorized::MutableBlock> _cur_mutable_block;
     PTabletWriterAddBlockRequest _cur_add_block_request;
 
-    using AddBlockReq =
-            std::pair<std::unique_ptr<vectorized::MutableBlock>, PTabletWriterAddBlockRequest>;
     std::queue<AddBlockReq> _pending_blocks;
-    ReusableClosure<PTabletWriterAddBlockResult>* _add_block_closure = nullptr;
+    // one closure for each add_block rpc in flight, see tablet_writer_add_block_max_in_flight
+    std::vector<ReusableClosure<PTabletWriterAddBlockResult>*> _add_block_closures;
 };
 
 class IndexChannel {
@@ -494,6 +511,10 @@ private:
     std::map<int64_t, int64_t> _partition_to_tablet_map;
 
     Bitmap _filter_bitmap;
+    // the partition and the tablet index of each row of the block being sent, found a block
+    // at a time before the rows are distributed to the node channels
+    std::vector<const VOlapTablePartition*> _row_partitions;
+    std::vector<uint32_t> _row_tablet_indexes;
 
     // index_channel
     std::vector<std::shared_ptr<IndexChannel>> _channels;
@@ -74,6 +74,18 @@ public:
         }
     }
 
+    // dst = lhs | rhs by one pass, instead of copying lhs and then merging rhs into it
+    static void merge_null_maps(NullMap& dst, const NullMap& lhs, const NullMap& rhs) {
+        size_t size = lhs.size();
+        dst.resize(size);
+        auto* __restrict d = dst.data();
+        const auto* __restrict l = lhs.data();
+        const auto* __restrict r = rhs.data();
+        for (size_t i = 0; i < size; ++i) {
+            d[i] = l[i] | r[i];
+        }
+    }
+
     static DataTypes get_data_types(const RowDescriptor& row_desc) {
         DataTypes data_types;
         for (const auto& tuple_desc : row_desc.tuple_descriptors()) {
@@ -15,7 +15,9 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include "exprs/create_predicate_function.h"
 #include "gtest/gtest.h"
@@ -108,4 +110,85 @@ TEST_F(BloomFilterPredicateTest, bloom_filter_size_test) {
     EXPECT_EQ(length, len);
 }
 
+TEST_F(BloomFilterPredicateTest, bloom_filter_cardinality_size_test) {
+    std::unique_ptr<BloomFilterFuncBase> func(create_bloom_filter(PrimitiveType::TYPE_INT));
+    EXPECT_TRUE(func->init_with_cardinality(1024, 0.05, 1 << 20).ok());
+    char* data = nullptr;
+    int len;
+    func->get_data(&data, &len);
+    EXPECT_EQ(BloomFilterAdaptor::optimal_bit_num(1024, 0.05), len);
+
+    // limited by the max length
+    func.reset(create_bloom_filter(PrimitiveType::TYPE_INT));
+    EXPECT_TRUE(func->init_with_cardinality(1 << 24, 0.05, 1 << 20).ok());
+    func->get_data(&data, &len);
+    EXPECT_EQ(1 << 20, len);
+
+    const int data_size = 1024;
+    for (int i = 0; i < data_size; i++) {
+        func->insert((const void*)&i);
+    }
+    for (int i = 0; i < data_size; i++) {
+        EXPECT_TRUE(func->find((const void*)&i));
+    }
+}
+
+TEST_F(BloomFilterPredicateTest, block_bloom_filter_find_batch_test) {
+    BlockBloomFilter bloom_filter;
+    EXPECT_TRUE(bloom_filter.init(12, 0).ok());
+    const int data_size = 1000;
+    std::vector<uint32_t> hashes(data_size * 2);
+    for (int i = 0; i < data_size * 2; i++) {
+        hashes[i] = HashUtil::fixed_len_to_uint32(i * 7919);
+        if (i < data_size) {
+            bloom_filter.insert(hashes[i]);
+        }
+    }
+    std::vector<uint8_t> results(hashes.size());
+    bloom_filter.find_batch(hashes.data(), hashes.size(), results.data());
+    for (int i = 0; i < hashes.size(); i++) {
+        EXPECT_EQ(bloom_filter.find(hashes[i]), results[i]);
+    }
+    for (int i = 0; i < data_size; i++) {
+        EXPECT_TRUE(results[i]);
+    }
+}
+
+TEST_F(BloomFilterPredicateTest, bloom_filter_find_fixed_len_test) {
+    std::unique_ptr<BloomFilterFuncBase> func(create_bloom_filter(PrimitiveType::TYPE_BIGINT));
+    EXPECT_TRUE(func->init(1024, 0.05).ok());
+    const int data_size = 1000;
+    std::vector<int64_t> data(data_size);
+    std::vector<uint8> nullmap(data_size);
+    for (int i = 0; i < data_size; i++) {
+        data[i] = i;
+        nullmap[i] = i % 10 == 0;
+        if (i % 2 == 0) {
+            func->insert_fixed_len((const char*)&data[i]);
+        }
+    }
+    std::vector<uint8> results(data_size);
+    func->find_fixed_len((const char*)data.data(), nullmap.data(), data_size, results.data());
+    for (int i = 0; i < data_size; i++) {
+        if (nullmap[i]) {
+            EXPECT_FALSE(results[i]);
+        } else if (i % 2 == 0) {
+            EXPECT_TRUE(results[i]);
+        }
+    }
+
+    std::vector<uint16_t> offsets(data_size);
+    for (int i = 0; i < data_size; i++) {
+        offsets[i] = i;
+    }
+    uint16_t new_size = func->find_fixed_len_olap_engine((const char*)data.data(), nullmap.data(),
+                                                         offsets.data(), data_size);
+    EXPECT_EQ(std::count(results.begin(), results.end(), 1), new_size);
+    for (int i = 0, j = 0; i < data_size && j < new_size; i++) {
+        if (results[i]) {
+            EXPECT_EQ(i, offsets[j++]);
+        }
+    }
+}
+
 } // namespace doris
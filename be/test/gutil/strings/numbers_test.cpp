@@ -17,9 +17,12 @@
 
 #include "gutil/strings/numbers.h"
 
+#include <fmt/format.h>
 #include <gtest/gtest.h>
 
+#include <cstdlib>
 #include <limits>
+#include <random>
 
 #include "util/mysql_global.h"
 
@@ -131,4 +134,47 @@ TEST_F(NumbersTest, test_double_to_buffer) {
     EXPECT_EQ(std::string("-1.7976931348623157e+308"), std::string(buffer2, len2));
 }
 
+// The values are formatted as they were by "%.15g" or "%.17g" if the former doesn't parse back to
+// the same value, and "%.6g" or "%.8g" for float.
+TEST_F(NumbersTest, test_to_buffer_round_trip) {
+    auto expected_double = [](double value) {
+        std::string str = fmt::format("{:.15g}", value);
+        if (strtod(str.c_str(), nullptr) != value) {
+            str = fmt::format("{:.17g}", value);
+        }
+        return str;
+    };
+    auto expected_float = [](float value) {
+        std::string str = fmt::format("{:.6g}", value);
+        if (strtof(str.c_str(), nullptr) != value) {
+            str = fmt::format("{:.8g}", value);
+        }
+        return str;
+    };
+    char buffer[100];
+    std::mt19937_64 rng(0);
+    for (int i = 0; i < 100000; ++i) {
+        uint64_t bits = rng();
+        double random_double;
+        memcpy(&random_double, &bits, sizeof(random_double));
+        float random_float;
+        memcpy(&random_float, &bits, sizeof(random_float));
+        double decimal = static_cast<int64_t>(bits % 2000001 - 1000000) / 1000.0;
+        for (double value : {random_double, decimal, decimal * 1e-7, decimal * 1e12}) {
+            int len = FastDoubleToBuffer(value, buffer);
+            EXPECT_EQ(expected_double(value), std::string(buffer, len));
+        }
+        for (float value : {random_float, static_cast<float>(decimal)}) {
+            int len = FastFloatToBuffer(value, buffer);
+            EXPECT_EQ(expected_float(value), std::string(buffer, len));
+        }
+    }
+    for (double value : {1e15, 1e16, 1e-4, 1e-5, 123456789012345.0, 0.1 + 0.2, -0.0,
+                         std::numeric_limits<double>::denorm_min(),
+                         std::numeric_limits<double>::infinity()}) {
+        int len = FastDoubleToBuffer(value, buffer);
+        EXPECT_EQ(expected_double(value), std::string(buffer, len));
+    }
+}
+
 } // namespace doris
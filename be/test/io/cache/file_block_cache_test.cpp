@@ -27,6 +27,7 @@
 #include "io/cache/block/block_file_cache.h"
 #include "io/cache/block/block_file_cache_settings.h"
 #include "io/cache/block/block_file_segment.h"
+#include "io/cache/block/block_file_cache_factory.h"
 #include "io/cache/block/block_lru_file_cache.h"
 #include "olap/options.h"
 #include "util/slice.h"
@@ -547,4 +548,154 @@ TEST(LRUFileCache, normal) {
     test_file_cache(true);
 }
 
+TEST(LRUFileCache, shards) {
+    if (fs::exists(cache_base_path)) {
+        fs::remove_all(cache_base_path);
+    }
+    fs::create_directories(cache_base_path);
+
+    TUniqueId query_id;
+    query_id.hi = 1;
+    query_id.lo = 1;
+    io::FileCacheSettings settings;
+    settings.max_size = 30;
+    settings.max_elements = 5;
+    settings.persistent_max_size = 30;
+    settings.persistent_max_elements = 5;
+    settings.max_file_segment_size = 100;
+    auto key = io::IFileCache::hash("key1");
+    size_t shard_idx = io::IFileCache::shard_of(key, 2);
+    {
+        io::LRUFileCache cache(cache_base_path, settings, shard_idx, 2);
+        ASSERT_TRUE(cache.initialize().ok());
+        auto holder = cache.get_or_set(key, 0, 10, false, query_id);
+        complete(holder);
+        ASSERT_EQ(cache.get_used_cache_size(false), 10);
+    }
+    {
+        // the shards of the path only load their own keys
+        io::LRUFileCache cache(cache_base_path, settings, shard_idx, 2);
+        io::LRUFileCache other_cache(cache_base_path, settings, 1 - shard_idx, 2);
+        ASSERT_TRUE(cache.initialize().ok());
+        ASSERT_TRUE(other_cache.initialize().ok());
+        ASSERT_EQ(cache.get_used_cache_size(false), 10);
+        ASSERT_EQ(other_cache.get_used_cache_size(false), 0);
+        ASSERT_TRUE(fs::exists(getFileBlockPath(cache_base_path, key, 0)));
+
+        auto holder = cache.get_or_set(key, 0, 10, false, query_id);
+        auto segments = fromHolder(holder);
+        ASSERT_EQ(segments.size(), 1);
+        assert_range(1, segments[0], io::FileBlock::Range(0, 9), io::FileBlock::State::DOWNLOADED);
+    }
+}
+
+TEST(LRUFileCache, meta_log) {
+    if (fs::exists(cache_base_path)) {
+        fs::remove_all(cache_base_path);
+    }
+    fs::create_directories(cache_base_path);
+
+    TUniqueId query_id;
+    query_id.hi = 1;
+    query_id.lo = 1;
+    io::FileCacheSettings settings;
+    settings.max_size = 30;
+    settings.max_elements = 5;
+    settings.persistent_max_size = 30;
+    settings.persistent_max_elements = 5;
+    settings.max_file_segment_size = 10;
+    auto key = io::IFileCache::hash("key1");
+    {
+        io::LRUFileCache cache(cache_base_path, settings);
+        ASSERT_TRUE(cache.initialize().ok());
+        auto holder = cache.get_or_set(key, 0, 20, false, query_id); /// Get [0, 19]
+        complete(holder);
+    }
+    ASSERT_TRUE(fs::exists(fs::path(cache_base_path) / "meta_log.0.1"));
+    // the directory is not scanned when the log exists, drop a block file the log has
+    fs::remove(getFileBlockPath(cache_base_path, key, 10));
+    {
+        io::LRUFileCache cache(cache_base_path, settings);
+        ASSERT_TRUE(cache.initialize().ok());
+        ASSERT_EQ(cache.get_file_segments_num(false), 2);
+
+        // the block of the dropped file is removed when it is first read
+        auto holder = cache.get_or_set(key, 0, 20, false, query_id);
+        auto segments = fromHolder(holder);
+        ASSERT_EQ(segments.size(), 2);
+        assert_range(1, segments[0], io::FileBlock::Range(0, 9), io::FileBlock::State::DOWNLOADED);
+        assert_range(2, segments[1], io::FileBlock::Range(10, 19), io::FileBlock::State::EMPTY);
+        ASSERT_TRUE(segments[1]->get_or_set_downloader() == io::FileBlock::get_caller_id());
+        download(segments[1]);
+    }
+    {
+        // the block downloaded again is appended to the log
+        io::LRUFileCache cache(cache_base_path, settings);
+        ASSERT_TRUE(cache.initialize().ok());
+        auto holder = cache.get_or_set(key, 0, 20, false, query_id);
+        auto segments = fromHolder(holder);
+        ASSERT_EQ(segments.size(), 2);
+        assert_range(3, segments[0], io::FileBlock::Range(0, 9), io::FileBlock::State::DOWNLOADED);
+        assert_range(4, segments[1], io::FileBlock::Range(10, 19),
+                     io::FileBlock::State::DOWNLOADED);
+    }
+}
+
+TEST(LRUFileCache, cached_key_summary) {
+    if (fs::exists(cache_base_path)) {
+        fs::remove_all(cache_base_path);
+    }
+    fs::create_directories(cache_base_path);
+
+    TUniqueId query_id;
+    query_id.hi = 1;
+    query_id.lo = 1;
+    io::FileCacheSettings settings;
+    settings.max_size = 30;
+    settings.max_elements = 5;
+    settings.persistent_max_size = 30;
+    settings.persistent_max_elements = 5;
+    settings.max_file_segment_size = 100;
+    auto key1 = io::IFileCache::hash("key1");
+    auto key2 = io::IFileCache::hash("key2");
+    io::LRUFileCache cache(cache_base_path, settings);
+    ASSERT_TRUE(cache.initialize().ok());
+    {
+        auto holder = cache.get_or_set(key1, 0, 10, false, query_id);
+        complete(holder);
+    }
+    // not downloaded
+    auto holder2 = cache.get_or_set(key2, 0, 10, false, query_id);
+    std::vector<io::IFileCache::Key> keys;
+    cache.get_cached_keys(&keys);
+    ASSERT_EQ(keys.size(), 1);
+    ASSERT_TRUE(keys[0] == key1);
+
+    std::vector<io::IFileCache::Key> many_keys;
+    for (int i = 0; i < 1000; ++i) {
+        many_keys.push_back(io::IFileCache::hash("file" + std::to_string(i)));
+    }
+    auto summary = io::FileCacheFactory::build_cached_key_summary(many_keys, 0.01);
+    ASSERT_EQ(summary.num_keys, 1000);
+    ASSERT_EQ(summary.num_hashes, 7);
+    auto contains = [&summary](const io::IFileCache::Key& key) {
+        uint64_t total_bits = summary.bits.size() * 8;
+        for (size_t i = 0; i < summary.num_hashes; ++i) {
+            uint64_t bit = (key.key.low + i * key.key.high) % total_bits;
+            if (((summary.bits[bit / 8] >> (bit % 8)) & 1) == 0) {
+                return false;
+            }
+        }
+        return true;
+    };
+    for (auto& key : many_keys) {
+        ASSERT_TRUE(contains(key));
+    }
+    int false_positives = 0;
+    for (int i = 0; i < 1000; ++i) {
+        false_positives += contains(io::IFileCache::hash("other" + std::to_string(i)));
+    }
+    ASSERT_LT(false_positives, 50);
+}
+
 } // namespace doris::io
@@ -0,0 +1,169 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#include "io/fs/buffered_reader.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+
+namespace doris {
+namespace io {
+
+// Serves a generated content from memory and records the reads.
+class MockFileReader : public FileReader {
+public:
+    explicit MockFileReader(size_t size) : _path("mock_file") {
+        _data.resize(size);
+        for (size_t i = 0; i < size; ++i) {
+            _data[i] = static_cast<char>(i % 251);
+        }
+    }
+
+    Status close() override {
+        _closed = true;
+        return Status::OK();
+    }
+    const Path& path() const override { return _path; }
+    size_t size() const override { return _data.size(); }
+    bool closed() const override { return _closed; }
+    std::shared_ptr<FileSystem> fs() const override { return nullptr; }
+
+    const std::string& data() const { return _data; }
+    const std::vector<std::pair<size_t, size_t>>& reads() const { return _reads; }
+
+protected:
+    Status read_at_impl(size_t offset, Slice result, size_t* bytes_read,
+                        const IOContext* /*io_ctx*/) override {
+        size_t n = std::min(result.size, _data.size() - offset);
+        memcpy(result.data, _data.data() + offset, n);
+        *bytes_read = n;
+        _reads.emplace_back(offset, n);
+        return Status::OK();
+    }
+
+private:
+    Path _path;
+    std::string _data;
+    bool _closed = false;
+    std::vector<std::pair<size_t, size_t>> _reads;
+};
+
+class MergeRangeFileReaderTest : public testing::Test {
+public:
+    void SetUp() override {
+        _saved_gap_kb = config::merge_range_read_max_gap_kb;
+        _saved_request_mb = config::merge_range_read_max_request_mb;
+        config::merge_range_read_max_gap_kb = 1;
+        config::merge_range_read_max_request_mb = 1;
+    }
+
+    void TearDown() override {
+        config::merge_range_read_max_gap_kb = _saved_gap_kb;
+        config::merge_range_read_max_request_mb = _saved_request_mb;
+    }
+
+private:
+    int32_t _saved_gap_kb;
+    int32_t _saved_request_mb;
+};
+
+TEST_F(MergeRangeFileReaderTest, merge_and_read) {
+    auto file = std::make_shared<MockFileReader>(4 << 20);
+    // the first two ranges are merged, the third is too far, the fourth is split
+    std::vector<PrefetchRange> ranges {{0, 1000},
+                                       {1500, 3000},
+                                       {100000, 101000},
+                                       {(2 << 20), (2 << 20) + (1 << 20) + 100}};
+    MergeRangeFileReader reader(file, ranges, 64 << 20);
+    EXPECT_EQ(4, reader.num_requests());
+
+    std::string buf(2000, '\0');
+    size_t bytes_read = 0;
+    EXPECT_TRUE(reader.read_at(0, Slice(buf.data(), 1000), &bytes_read).ok());
+    EXPECT_EQ(1000, bytes_read);
+    EXPECT_EQ(file->data().substr(0, 1000), buf.substr(0, 1000));
+    ASSERT_EQ(1, file->reads().size());
+    EXPECT_EQ(0, file->reads()[0].first);
+    EXPECT_EQ(3000, file->reads()[0].second);
+
+    // served from the buffer of the merged request
+    EXPECT_TRUE(reader.read_at(1500, Slice(buf.data(), 1500), &bytes_read).ok());
+    EXPECT_EQ(file->data().substr(1500, 1500), buf.substr(0, 1500));
+    EXPECT_EQ(1, file->reads().size());
+
+    // a read out of the ranges goes to the file directly
+    EXPECT_TRUE(reader.read_at(50000, Slice(buf.data(), 100), &bytes_read).ok());
+    EXPECT_EQ(file->data().substr(50000, 100), buf.substr(0, 100));
+    EXPECT_EQ(2, file->reads().size());
+
+    // a read across the split requests
+    size_t offset = (2 << 20) + (1 << 20) - 1000;
+    EXPECT_TRUE(reader.read_at(offset, Slice(buf.data(), 1100), &bytes_read).ok());
+    EXPECT_EQ(1100, bytes_read);
+    EXPECT_EQ(file->data().substr(offset, 1100), buf.substr(0, 1100));
+    EXPECT_EQ(4, file->reads().size());
+
+    auto stats = reader.statistics();
+    EXPECT_EQ(3, stats.request_count);
+    EXPECT_EQ(1, stats.direct_read_count);
+    EXPECT_EQ(100, stats.direct_read_bytes);
+}
+
+TEST_F(MergeRangeFileReaderTest, release_read_request) {
+    auto file = std::make_shared<MockFileReader>(100000);
+    MergeRangeFileReader reader(file, {{0, 1000}, {1200, 2000}}, 64 << 20);
+    EXPECT_EQ(1, reader.num_requests());
+
+    std::string buf(1000, '\0');
+    size_t bytes_read = 0;
+    EXPECT_TRUE(reader.read_at(0, Slice(buf.data(), 1000), &bytes_read).ok());
+    EXPECT_TRUE(reader.read_at(1200, Slice(buf.data(), 800), &bytes_read).ok());
+    EXPECT_EQ(file->data().substr(1200, 800), buf.substr(0, 800));
+    EXPECT_EQ(1, file->reads().size());
+
+    // all the ranges are read, the buffer is released and the request is fetched again
+    EXPECT_TRUE(reader.read_at(0, Slice(buf.data(), 10), &bytes_read).ok());
+    EXPECT_EQ(file->data().substr(0, 10), buf.substr(0, 10));
+    EXPECT_EQ(2, file->reads().size());
+    EXPECT_EQ(2, reader.statistics().request_count);
+}
+
+TEST(RangeFileReaderTest, read_in_range) {
+    auto file = std::make_shared<MockFileReader>(1 << 20);
+    RangeFileReader reader(file, 1000, 5000);
+    EXPECT_EQ(5000, reader.size());
+
+    std::string buf(4000, 0);
+    size_t bytes_read = 0;
+    ASSERT_TRUE(reader.read_at(2000, Slice(buf), &bytes_read).ok());
+    // the read stops at the end of the range
+    EXPECT_EQ(3000, bytes_read);
+    EXPECT_EQ(file->data().substr(3000, 3000), buf.substr(0, 3000));
+    ASSERT_TRUE(reader.read_at(5000, Slice(buf), &bytes_read).ok());
+    EXPECT_EQ(0, bytes_read);
+
+    ASSERT_TRUE(reader.close().ok());
+    EXPECT_TRUE(file->closed());
+}
+
+} // namespace io
+} // namespace doris
@@ -23,11 +23,15 @@
 #include <set>
 #include <vector>
 
+#include "common/config.h"
 #include "common/status.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "io/fs/file_reader.h"
+#include "io/fs/local_file_reader.h"
 #include "io/fs/file_writer.h"
+#include "io/io_common.h"
+#include "runtime/thread_context.h"
 
 namespace doris {
 
@@ -559,6 +563,96 @@ TEST_F(LocalFileSystemTest, TestRandomAccess) {
     }
 }
 
+TEST_F(LocalFileSystemTest, TestMap) {
+    std::string fname = "./ut_dir/local_filesystem/map";
+    EXPECT_TRUE(io::global_local_filesystem()->create_directory("./ut_dir/local_filesystem/").ok());
+    io::FileWriterPtr file_writer;
+    EXPECT_TRUE(io::global_local_filesystem()->create_file(fname, &file_writer).ok());
+    EXPECT_TRUE(file_writer->append(Slice("123456789")).ok());
+    EXPECT_TRUE(file_writer->close().ok());
+
+    io::FileReaderSPtr file_reader;
+    EXPECT_TRUE(io::global_local_filesystem()->open_file(fname, &file_reader).ok());
+    EXPECT_EQ(nullptr, file_reader->mapped_data());
+    auto local_reader = dynamic_cast<io::LocalFileReader*>(file_reader.get());
+    ASSERT_NE(nullptr, local_reader);
+    EXPECT_TRUE(local_reader->map().ok());
+    ASSERT_NE(nullptr, file_reader->mapped_data());
+    EXPECT_EQ("123456789", std::string(file_reader->mapped_data(), 9));
+
+    // the mapping is kept after close
+    EXPECT_TRUE(file_reader->close().ok());
+    EXPECT_EQ("123456789", std::string(file_reader->mapped_data(), 9));
+}
+
+TEST_F(LocalFileSystemTest, TestIOStatistics) {
+    std::string fname = "./ut_dir/local_filesystem/io_statistics";
+    EXPECT_TRUE(io::global_local_filesystem()->create_directory("./ut_dir/local_filesystem/").ok());
+    io::FileWriterPtr file_writer;
+    EXPECT_TRUE(io::global_local_filesystem()->create_file(fname, &file_writer).ok());
+    EXPECT_TRUE(file_writer->append(Slice("123456789")).ok());
+    EXPECT_TRUE(file_writer->close().ok());
+
+    io::FileReaderSPtr file_reader;
+    EXPECT_TRUE(io::global_local_filesystem()->open_file(fname, &file_reader).ok());
+    char buf[9];
+    size_t bytes_read = 0;
+    // not counted if the thread is not attached to a query
+    EXPECT_TRUE(file_reader->read_at(0, Slice(buf, 4), &bytes_read).ok());
+
+    io::IOStatistics io_statistics;
+    thread_context()->io_statistics = &io_statistics;
+    EXPECT_TRUE(file_reader->read_at(0, Slice(buf, 9), &bytes_read).ok());
+    EXPECT_TRUE(file_reader->read_at(4, Slice(buf, 5), &bytes_read).ok());
+    thread_context()->io_statistics = nullptr;
+    EXPECT_EQ("56789", std::string(buf, 5));
+
+    EXPECT_EQ(2, io_statistics.local_read_requests.load());
+    // the file was just written, so it's usually in the page cache, but may be not
+    EXPECT_EQ(14, io_statistics.local_bytes_read_from_page_cache.load() +
+                          io_statistics.local_bytes_read_from_disk.load());
+    EXPECT_TRUE(file_reader->close().ok());
+}
+
+TEST_F(LocalFileSystemTest, TestReadRanges) {
+    std::string fname = "./ut_dir/local_filesystem/read_ranges";
+    EXPECT_TRUE(io::global_local_filesystem()->create_directory("./ut_dir/local_filesystem/").ok());
+    io::FileWriterPtr file_writer;
+    EXPECT_TRUE(io::global_local_filesystem()->create_file(fname, &file_writer).ok());
+    EXPECT_TRUE(file_writer->append(Slice("123456789")).ok());
+    EXPECT_TRUE(file_writer->close().ok());
+
+    io::FileReaderSPtr file_reader;
+    EXPECT_TRUE(io::global_local_filesystem()->open_file(fname, &file_reader).ok());
+    // read one by one if io_uring is not supported
+    for (bool enable_io_uring : {false, true}) {
+        config::enable_io_uring = enable_io_uring;
+        char buf[3][4];
+        std::vector<io::FileReader::ReadRange> ranges {
+                {0, Slice(buf[0], 2)}, {6, Slice(buf[1], 3)}, {3, Slice(buf[2], 4)}};
+        EXPECT_TRUE(file_reader->read_ranges(&ranges).ok());
+        EXPECT_EQ(2, ranges[0].bytes_read);
+        EXPECT_EQ("12", std::string(buf[0], 2));
+        EXPECT_EQ(3, ranges[1].bytes_read);
+        EXPECT_EQ("789", std::string(buf[1], 3));
+        EXPECT_EQ(4, ranges[2].bytes_read);
+        EXPECT_EQ("4567", std::string(buf[2], 4));
+
+        // cut at the end of the file
+        std::vector<io::FileReader::ReadRange> tail {{0, Slice(buf[0], 1)},
+                                                     {7, Slice(buf[1], 4)}};
+        EXPECT_TRUE(file_reader->read_ranges(&tail).ok());
+        EXPECT_EQ(2, tail[1].bytes_read);
+        EXPECT_EQ("89", std::string(buf[1], 2));
+
+        std::vector<io::FileReader::ReadRange> out_of_file {{0, Slice(buf[0], 1)},
+                                                            {10, Slice(buf[1], 1)}};
+        EXPECT_FALSE(file_reader->read_ranges(&out_of_file).ok());
+    }
+    config::enable_io_uring = false;
+    EXPECT_TRUE(file_reader->close().ok());
+}
+
 TEST_F(LocalFileSystemTest, TestRandomWrite) {
     std::string fname = "./ut_dir/env_posix/random_rw";
     EXPECT_TRUE(io::global_local_filesystem()->create_directory("./ut_dir/env_posix").ok());
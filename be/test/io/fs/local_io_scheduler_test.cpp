@@ -0,0 +1,119 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "io/fs/local_io_scheduler.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/config.h"
+
+namespace doris::io {
+
+TEST(LocalIOSchedulerTest, Find) {
+    auto dir = std::make_shared<LocalIOScheduler>("/data/be", nullptr);
+    auto nested = std::make_shared<LocalIOScheduler>("/data/be/nested/", nullptr);
+    LocalIOScheduler::register_scheduler(dir);
+    LocalIOScheduler::register_scheduler(nested);
+
+    EXPECT_EQ(dir, LocalIOScheduler::find("/data/be/data/10/1234/0200.dat"));
+    EXPECT_EQ(nested, LocalIOScheduler::find("/data/be/nested/data/10/1234/0200.dat"));
+    EXPECT_EQ(nullptr, LocalIOScheduler::find("/data/be2/data/10/1234/0200.dat"));
+    EXPECT_EQ(nullptr, LocalIOScheduler::find("/tmp/0200.dat"));
+
+    LocalIOScheduler::deregister_scheduler(nested.get());
+    EXPECT_EQ(dir, LocalIOScheduler::find("/data/be/nested/data/10/1234/0200.dat"));
+    LocalIOScheduler::deregister_scheduler(dir.get());
+    EXPECT_EQ(nullptr, LocalIOScheduler::find("/data/be/data/10/1234/0200.dat"));
+}
+
+TEST(LocalIOSchedulerTest, Unlimited) {
+    LocalIOScheduler scheduler("/data/be", nullptr);
+    EXPECT_FALSE(scheduler.start(LocalIOScheduler::QUERY, 4096));
+    EXPECT_FALSE(scheduler.start(LocalIOScheduler::OTHER, 4096));
+    EXPECT_EQ(0, scheduler.num_running());
+}
+
+TEST(LocalIOSchedulerTest, Priority) {
+    auto old_concurrency = config::local_io_max_concurrency_per_dir;
+    config::local_io_max_concurrency_per_dir = 1;
+    LocalIOScheduler scheduler("/data/be", nullptr);
+
+    EXPECT_TRUE(scheduler.start(LocalIOScheduler::QUERY, 4096));
+    std::mutex lock;
+    std::vector<LocalIOScheduler::IOClass> started;
+    auto run = [&](LocalIOScheduler::IOClass io_class) {
+        EXPECT_TRUE(scheduler.start(io_class, 4096));
+        {
+            std::lock_guard<std::mutex> l(lock);
+            started.push_back(io_class);
+        }
+        scheduler.finish();
+    };
+    // the query waiting after the compaction is started before it
+    std::thread compaction(run, LocalIOScheduler::COMPACTION);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    std::thread query(run, LocalIOScheduler::QUERY);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(1, scheduler.num_running());
+    scheduler.finish();
+    compaction.join();
+    query.join();
+
+    EXPECT_EQ((std::vector<LocalIOScheduler::IOClass> {LocalIOScheduler::QUERY,
+                                                       LocalIOScheduler::COMPACTION}),
+              started);
+    EXPECT_EQ(0, scheduler.num_running());
+    config::local_io_max_concurrency_per_dir = old_concurrency;
+}
+
+TEST(LocalIOSchedulerTest, NotStarved) {
+    auto old_concurrency = config::local_io_max_concurrency_per_dir;
+    config::local_io_max_concurrency_per_dir = 1;
+    LocalIOScheduler scheduler("/data/be", nullptr);
+
+    EXPECT_TRUE(scheduler.start(LocalIOScheduler::QUERY, 4096));
+    std::atomic<bool> started = false;
+    std::thread compaction([&]() {
+        EXPECT_TRUE(scheduler.start(LocalIOScheduler::COMPACTION, 4096));
+        started = true;
+        scheduler.finish();
+    });
+    // the queries keep running one after another
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(3 * LocalIOScheduler::MAX_PRIORITY_WAIT_MS);
+    std::thread query([&]() {
+        while (!started && std::chrono::steady_clock::now() < deadline) {
+            EXPECT_TRUE(scheduler.start(LocalIOScheduler::QUERY, 4096));
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            scheduler.finish();
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    scheduler.finish();
+    compaction.join();
+    query.join();
+    EXPECT_TRUE(started);
+    config::local_io_max_concurrency_per_dir = old_concurrency;
+}
+
+} // namespace doris::io
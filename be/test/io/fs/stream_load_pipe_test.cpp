@@ -0,0 +1,173 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "io/fs/stream_load_pipe.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "io/fs/kafka_consumer_pipe.h"
+#include "util/runtime_profile.h"
+#include "vec/exec/format/file_reader/new_plain_text_line_reader.h"
+
+namespace doris {
+
+class StreamLoadPipeTest : public testing::Test {
+public:
+    static std::string read_all(const io::FileReaderSPtr& reader) {
+        std::string content;
+        char buf[100];
+        while (true) {
+            size_t bytes_read = 0;
+            EXPECT_TRUE(reader->read_at(0, Slice(buf, sizeof(buf)), &bytes_read).ok());
+            if (bytes_read == 0) {
+                break;
+            }
+            content.append(buf, bytes_read);
+        }
+        return content;
+    }
+
+    static std::vector<std::string> split_lines(const std::string& content) {
+        std::vector<std::string> lines;
+        size_t start = 0;
+        while (start < content.size()) {
+            size_t end = content.find('\n', start);
+            if (end == std::string::npos) {
+                end = content.size();
+            }
+            lines.push_back(content.substr(start, end - start));
+            start = end + 1;
+        }
+        return lines;
+    }
+};
+
+TEST_F(StreamLoadPipeTest, line_split) {
+    io::LineSplitStreamLoadPipe pipe(3, "\n", 64);
+    std::vector<std::string> lines;
+    std::string body;
+    for (int i = 0; i < 200; ++i) {
+        lines.push_back("line," + std::to_string(i) + "," + std::string(i % 50, 'x'));
+        body += lines.back() + "\n";
+    }
+    // the last line has no line delimiter
+    lines.push_back("last line");
+    body += lines.back();
+    // append the body in pieces which do not end at the line delimiter
+    for (size_t pos = 0; pos < body.size(); pos += 37) {
+        auto len = std::min<size_t>(37, body.size() - pos);
+        ASSERT_TRUE(pipe.append(body.data() + pos, len).ok());
+    }
+    ASSERT_TRUE(pipe.finish().ok());
+
+    ASSERT_EQ(3, pipe.num_sub_pipes());
+    std::vector<std::string> read_lines;
+    for (int i = 0; i < pipe.num_sub_pipes(); ++i) {
+        io::FileReaderSPtr reader;
+        ASSERT_TRUE(pipe.take_sub_pipe(&reader).ok());
+        auto content = read_all(reader);
+        EXPECT_FALSE(content.empty());
+        auto sub_lines = split_lines(content);
+        read_lines.insert(read_lines.end(), sub_lines.begin(), sub_lines.end());
+    }
+    io::FileReaderSPtr reader;
+    EXPECT_FALSE(pipe.take_sub_pipe(&reader).ok());
+
+    std::sort(lines.begin(), lines.end());
+    std::sort(read_lines.begin(), read_lines.end());
+    EXPECT_EQ(lines, read_lines);
+}
+
+TEST_F(StreamLoadPipeTest, line_split_cancel) {
+    io::LineSplitStreamLoadPipe pipe(2, "\n", 64);
+    ASSERT_TRUE(pipe.append("a\nb\n", 4).ok());
+    pipe.cancel("test");
+    EXPECT_FALSE(pipe.append("c\n", 2).ok());
+    for (int i = 0; i < pipe.num_sub_pipes(); ++i) {
+        io::FileReaderSPtr reader;
+        ASSERT_TRUE(pipe.take_sub_pipe(&reader).ok());
+        char buf[10];
+        size_t bytes_read = 0;
+        EXPECT_FALSE(reader->read_at(0, Slice(buf, sizeof(buf)), &bytes_read).ok());
+    }
+}
+
+TEST_F(StreamLoadPipeTest, multi_partition_kafka) {
+    io::MultiPartitionKafkaConsumerPipe pipe(2, {0, 1, 2});
+    ASSERT_EQ(2, pipe.num_sub_pipes());
+    // the partitions 0 and 2 share the first sub pipe
+    EXPECT_EQ(pipe.pipe_of_partition(0), pipe.pipe_of_partition(2));
+    EXPECT_NE(pipe.pipe_of_partition(0), pipe.pipe_of_partition(1));
+    for (int i = 0; i < 4; ++i) {
+        for (int32_t partition = 0; partition < 3; ++partition) {
+            std::string msg = std::to_string(partition) + "-" + std::to_string(i);
+            ASSERT_TRUE(pipe.pipe_of_partition(partition)
+                                ->append_with_line_delimiter(msg.data(), msg.size())
+                                .ok());
+        }
+    }
+    ASSERT_TRUE(pipe.finish().ok());
+
+    io::FileReaderSPtr reader;
+    ASSERT_TRUE(pipe.take_sub_pipe(&reader).ok());
+    EXPECT_EQ("0-0\n2-0\n0-1\n2-1\n0-2\n2-2\n0-3\n2-3\n", read_all(reader));
+    ASSERT_TRUE(pipe.take_sub_pipe(&reader).ok());
+    EXPECT_EQ("1-0\n1-1\n1-2\n1-3\n", read_all(reader));
+    EXPECT_FALSE(pipe.take_sub_pipe(&reader).ok());
+}
+
+TEST_F(StreamLoadPipeTest, read_lines_from_buffers) {
+    std::vector<std::string> lines;
+    std::string body;
+    for (int i = 0; i < 100; ++i) {
+        lines.push_back(i % 10 == 0 ? "" : "line," + std::to_string(i) + std::string(i, 'x'));
+        body += lines.back() + "\r\n";
+    }
+    lines.push_back("last line");
+    body += lines.back();
+
+    auto pipe = std::make_shared<io::StreamLoadPipe>();
+    // each piece is a buffer of the pipe, so the lines and delimiters span the buffers
+    for (size_t pos = 0; pos < body.size(); pos += 23) {
+        auto len = std::min<size_t>(23, body.size() - pos);
+        ASSERT_TRUE(pipe->append_and_flush(body.data() + pos, len).ok());
+    }
+    ASSERT_TRUE(pipe->finish().ok());
+
+    RuntimeProfile profile("test");
+    NewPlainTextLineReader line_reader(&profile, pipe, nullptr, -1, "\r\n", 2, 0);
+    std::vector<std::string> read_lines;
+    while (true) {
+        const uint8_t* ptr = nullptr;
+        size_t size = 0;
+        bool eof = false;
+        ASSERT_TRUE(line_reader.read_line(&ptr, &size, &eof, nullptr).ok());
+        if (eof) {
+            break;
+        }
+        read_lines.emplace_back(reinterpret_cast<const char*>(ptr), size);
+    }
+    EXPECT_EQ(lines, read_lines);
+    EXPECT_EQ(0, pipe->buffered_bytes());
+}
+
+} // namespace doris
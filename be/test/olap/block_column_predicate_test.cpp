@@ -23,6 +23,7 @@
 #include "olap/column_predicate.h"
 #include "olap/comparison_predicate.h"
 #include "olap/field.h"
+#include "olap/null_predicate.h"
 #include "olap/wrapper_field.h"
 #include "vec/columns/predicate_column.h"
 #include "vec/common/string_ref.h"
@@ -82,6 +83,34 @@ TEST_F(BlockColumnPredicateTest, SINGLE_COLUMN_VEC) {
     EXPECT_EQ(pred_col->get_data()[sel_idx[0]], value);
 }
 
+TEST_F(BlockColumnPredicateTest, SINGLE_COLUMN_DENSE_SEL) {
+    int rows = 4096;
+    auto column = vectorized::PredicateColumnType<TYPE_INT>::create();
+    column->reserve(rows);
+    for (int i = 0; i < rows; i++) {
+        int value = i % 100;
+        column->insert_data((char*)&value, 0);
+    }
+
+    for (bool opposite : {false, true}) {
+        ComparisonPredicateBase<TYPE_INT, PredicateType::LT> pred(0, 10, opposite);
+        // step 1 is a dense sel evaluated by SIMD, step 2 is half dense, step 3 is sparse
+        for (int step = 1; step <= 3; step++) {
+            std::vector<uint16_t> sel;
+            std::vector<uint16_t> expected;
+            for (int i = 0; i < rows; i += step) {
+                sel.push_back(i);
+                if (opposite ^ (i % 100 < 10)) {
+                    expected.push_back(i);
+                }
+            }
+            uint16_t selected_size = pred.evaluate(*column, sel.data(), sel.size());
+            sel.resize(selected_size);
+            EXPECT_EQ(sel, expected) << "opposite: " << opposite << ", step: " << step;
+        }
+    }
+}
+
 TEST_F(BlockColumnPredicateTest, AND_MUTI_COLUMN_VEC) {
     vectorized::MutableColumns block;
     block.push_back(vectorized::PredicateColumnType<TYPE_INT>::create());
@@ -268,4 +297,35 @@ TEST_F(BlockColumnPredicateTest, AND_OR_MUTI_COLUMN_VEC) {
     EXPECT_EQ(pred_col->get_data()[sel_idx[0]], 4);
 }
 
+TEST_F(BlockColumnPredicateTest, DELETE_PREDICATE_MAY_DELETE) {
+    std::unique_ptr<WrapperField> min_value(WrapperField::create_by_type(OLAP_FIELD_TYPE_INT));
+    std::unique_ptr<WrapperField> max_value(WrapperField::create_by_type(OLAP_FIELD_TYPE_INT));
+    min_value->set_not_null();
+    max_value->set_not_null();
+    min_value->from_string("10");
+    max_value->from_string("20");
+
+    // the delete predicates are the opposite of the delete conditions
+    ComparisonPredicateBase<TYPE_INT, PredicateType::EQ> eq_5(0, 5, true);
+    ComparisonPredicateBase<TYPE_INT, PredicateType::EQ> eq_15(0, 15, true);
+    ComparisonPredicateBase<TYPE_INT, PredicateType::GT> gt_20(0, 20, true);
+    EXPECT_FALSE(eq_5.may_delete({min_value.get(), max_value.get()}));
+    EXPECT_TRUE(eq_15.may_delete({min_value.get(), max_value.get()}));
+    EXPECT_FALSE(gt_20.may_delete({min_value.get(), max_value.get()}));
+
+    NullPredicate is_null(0, true, true);
+    NullPredicate is_not_null(0, false, true);
+    EXPECT_FALSE(is_null.may_delete({min_value.get(), max_value.get()}));
+    EXPECT_TRUE(is_not_null.may_delete({min_value.get(), max_value.get()}));
+
+    // there are nulls in the zone
+    min_value->set_null();
+    EXPECT_TRUE(is_null.may_delete({min_value.get(), max_value.get()}));
+    EXPECT_TRUE(is_not_null.may_delete({min_value.get(), max_value.get()}));
+    // all are nulls
+    max_value->set_null();
+    EXPECT_TRUE(is_null.may_delete({min_value.get(), max_value.get()}));
+    EXPECT_FALSE(is_not_null.may_delete({min_value.get(), max_value.get()}));
+}
+
 } // namespace doris
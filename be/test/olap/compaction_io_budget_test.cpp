@@ -0,0 +1,72 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/compaction_io_budget.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "common/config.h"
+#include "util/doris_metrics.h"
+
+namespace doris {
+
+class CompactionIOBudgetTest : public testing::Test {
+public:
+    void SetUp() override {
+        config::compaction_io_budget_mb_per_sec_per_disk = 1;
+        config::compaction_io_budget_min_ratio = 0.2;
+        config::compaction_io_budget_full_query_load_mb_per_sec = 100;
+        DorisMetrics::instance()->query_scan_bytes_per_second->set_value(0);
+    }
+    void TearDown() override {
+        config::compaction_io_budget_mb_per_sec_per_disk = 0;
+        DorisMetrics::instance()->query_scan_bytes_per_second->set_value(0);
+    }
+};
+
+TEST_F(CompactionIOBudgetTest, bytes_per_sec) {
+    EXPECT_EQ(1 << 20, CompactionIOBudget::bytes_per_sec());
+    DorisMetrics::instance()->query_scan_bytes_per_second->set_value(50 << 20);
+    EXPECT_EQ(static_cast<int64_t>((1 << 20) * 0.6), CompactionIOBudget::bytes_per_sec());
+    DorisMetrics::instance()->query_scan_bytes_per_second->set_value(500 << 20);
+    EXPECT_EQ(static_cast<int64_t>((1 << 20) * 0.2), CompactionIOBudget::bytes_per_sec());
+    config::compaction_io_budget_mb_per_sec_per_disk = 0;
+    EXPECT_EQ(0, CompactionIOBudget::bytes_per_sec());
+}
+
+TEST_F(CompactionIOBudgetTest, budget) {
+    CompactionIOBudget budget;
+    auto* disk1 = reinterpret_cast<DataDir*>(1);
+    auto* disk2 = reinterpret_cast<DataDir*>(2);
+    EXPECT_TRUE(budget.has_budget(disk1));
+    // a task larger than the budget is still started
+    budget.consume(disk1, 2 << 20);
+    EXPECT_FALSE(budget.has_budget(disk1));
+    EXPECT_TRUE(budget.has_budget(disk2));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+    EXPECT_TRUE(budget.has_budget(disk1));
+
+    // unlimited
+    config::compaction_io_budget_mb_per_sec_per_disk = 0;
+    budget.consume(disk2, 100 << 20);
+    EXPECT_TRUE(budget.has_budget(disk2));
+}
+
+} // namespace doris
@@ -35,6 +35,9 @@ public:
         config::compaction_promotion_ratio = 0.05;
         config::compaction_promotion_min_size_mbytes = 64;
         config::compaction_min_size_mbytes = 64;
+        config::time_series_compaction_goal_size_mbytes = 64;
+        config::time_series_compaction_file_count_threshold = 2000;
+        config::time_series_compaction_time_threshold_seconds = 3600;
 
         _tablet_meta = static_cast<TabletMetaSharedPtr>(new TabletMeta(
                 1, 2, 15673, 15674, 4, 5, TTabletSchema(), 6, {{7, 8}}, UniqueId(9, 10),
@@ -314,6 +317,37 @@ public:
         rs_metas->push_back(ptr5);
     }
 
+    void init_rs_meta_time_series(std::vector<RowsetMetaSharedPtr>* rs_metas) {
+        RowsetMetaSharedPtr ptr1(new RowsetMeta());
+        init_rs_meta(ptr1, 0, 1);
+        ptr1->set_total_disk_size(1024 * 1024 * 1024);
+        ptr1->set_segments_overlap(NONOVERLAPPING);
+        rs_metas->push_back(ptr1);
+
+        RowsetMetaSharedPtr ptr2(new RowsetMeta());
+        init_rs_meta(ptr2, 2, 3);
+        ptr2->set_segments_overlap(NONOVERLAPPING);
+        rs_metas->push_back(ptr2);
+
+        RowsetMetaSharedPtr ptr3(new RowsetMeta());
+        init_rs_meta(ptr3, 4, 4);
+        rs_metas->push_back(ptr3);
+
+        RowsetMetaSharedPtr ptr4(new RowsetMeta());
+        init_rs_meta(ptr4, 5, 5);
+        ptr4->set_total_disk_size(100 * 1024 * 1024);
+        ptr4->set_segments_overlap(NONOVERLAPPING);
+        rs_metas->push_back(ptr4);
+
+        RowsetMetaSharedPtr ptr5(new RowsetMeta());
+        init_rs_meta(ptr5, 6, 6);
+        rs_metas->push_back(ptr5);
+
+        RowsetMetaSharedPtr ptr6(new RowsetMeta());
+        init_rs_meta(ptr6, 7, 7);
+        rs_metas->push_back(ptr6);
+    }
+
 protected:
     std::string _json_rowset_meta;
     TabletMetaSharedPtr _tablet_meta;
@@ -695,6 +729,97 @@ TEST_F(TestSizeBasedCumulativeCompactionPolicy, _pick_missing_version_cumulative
     compaction.find_longest_consecutive_version(&rowsets3, nullptr);
     EXPECT_EQ(0, rowsets3.size());
 }
+
+TEST_F(TestSizeBasedCumulativeCompactionPolicy, time_series_calculate_cumulative_point) {
+    std::vector<RowsetMetaSharedPtr> rs_metas;
+    init_rs_meta_time_series(&rs_metas);
+
+    for (auto& rowset : rs_metas) {
+        _tablet_meta->add_rs_meta(rowset);
+    }
+
+    TabletSharedPtr _tablet(new Tablet(_tablet_meta, nullptr, CUMULATIVE_TIME_SERIES_POLICY));
+    _tablet->init();
+    _tablet->calculate_cumulative_point();
+
+    // [2-3] has been compacted
+    EXPECT_EQ(4, _tablet->cumulative_layer_point());
+    EXPECT_EQ(CUMULATIVE_TIME_SERIES_POLICY, _tablet->_cumulative_compaction_policy->name());
+}
+
+TEST_F(TestSizeBasedCumulativeCompactionPolicy, time_series_pick_input_rowsets) {
+    std::vector<RowsetMetaSharedPtr> rs_metas;
+    init_rs_meta_time_series(&rs_metas);
+
+    for (auto& rowset : rs_metas) {
+        _tablet_meta->add_rs_meta(rowset);
+    }
+
+    TabletSharedPtr _tablet(new Tablet(_tablet_meta, nullptr, CUMULATIVE_TIME_SERIES_POLICY));
+    _tablet->init();
+    _tablet->calculate_cumulative_point();
+
+    std::vector<RowsetSharedPtr> input_rowsets;
+    Version last_delete_version {-1, -1};
+    size_t compaction_score = 0;
+    // the rowset before the big rowset [5-5] has waited long enough
+    auto candidate_rowsets = _tablet->pick_candidate_rowsets_to_cumulative_compaction();
+    _tablet->_cumulative_compaction_policy->pick_input_rowsets(
+            _tablet.get(), candidate_rowsets, 100, 5, &input_rowsets, &last_delete_version,
+            &compaction_score);
+    EXPECT_EQ(1, input_rowsets.size());
+    EXPECT_EQ(4, input_rowsets[0]->start_version());
+    EXPECT_EQ(3, compaction_score);
+
+    // the big rowset is given to base without compaction
+    _tablet->set_cumulative_layer_point(5);
+    input_rowsets.clear();
+    candidate_rowsets = _tablet->pick_candidate_rowsets_to_cumulative_compaction();
+    _tablet->_cumulative_compaction_policy->pick_input_rowsets(
+            _tablet.get(), candidate_rowsets, 100, 5, &input_rowsets, &last_delete_version,
+            &compaction_score);
+    EXPECT_EQ(6, _tablet->cumulative_layer_point());
+    EXPECT_EQ(2, input_rowsets.size());
+    EXPECT_EQ(6, compaction_score);
+    EXPECT_EQ(-1, last_delete_version.first);
+}
+
+TEST_F(TestSizeBasedCumulativeCompactionPolicy, time_series_wait_for_threshold) {
+    config::time_series_compaction_time_threshold_seconds = INT64_MAX;
+    std::vector<RowsetMetaSharedPtr> rs_metas;
+    init_rs_meta_time_series(&rs_metas);
+
+    for (auto& rowset : rs_metas) {
+        _tablet_meta->add_rs_meta(rowset);
+    }
+
+    TabletSharedPtr _tablet(new Tablet(_tablet_meta, nullptr, CUMULATIVE_TIME_SERIES_POLICY));
+    _tablet->init();
+    _tablet->calculate_cumulative_point();
+    _tablet->set_cumulative_layer_point(6);
+
+    std::shared_ptr<CumulativeCompactionPolicy> cumulative_compaction_policy =
+            CumulativeCompactionPolicyFactory::create_cumulative_compaction_policy(
+                    CUMULATIVE_TIME_SERIES_POLICY);
+    EXPECT_EQ(0, _tablet->calc_compaction_score(CompactionType::CUMULATIVE_COMPACTION,
+                                                cumulative_compaction_policy));
+    // no base compaction under time series policy
+    EXPECT_EQ(0, _tablet->calc_compaction_score(CompactionType::BASE_COMPACTION,
+                                                cumulative_compaction_policy));
+
+    std::vector<RowsetSharedPtr> input_rowsets;
+    Version last_delete_version {-1, -1};
+    size_t compaction_score = 0;
+    auto candidate_rowsets = _tablet->pick_candidate_rowsets_to_cumulative_compaction();
+    _tablet->_cumulative_compaction_policy->pick_input_rowsets(
+            _tablet.get(), candidate_rowsets, 100, 5, &input_rowsets, &last_delete_version,
+            &compaction_score);
+    EXPECT_EQ(0, input_rowsets.size());
+
+    // the number of rowsets reaches the threshold
+    TimeSeriesCumulativeCompactionPolicy policy(64 * 1024 * 1024, 2, INT64_MAX);
+    EXPECT_EQ(6, policy.calc_cumulative_compaction_score(_tablet.get()));
+}
 } // namespace doris
 
 // @brief Test Stub
@@ -0,0 +1,67 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/task/engine_publish_version_task.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace doris {
+
+TEST(TabletPublishQueueTest, OrderedByVersion) {
+    TabletPublishQueue queue;
+    std::vector<int64_t> published;
+    auto task = [&published](int64_t version) {
+        return [&published, version]() { published.push_back(version); };
+    };
+
+    // the previous version is not in progress
+    EXPECT_FALSE(queue.enqueue(10001, 3, task(3)));
+
+    queue.start(10001, 2);
+    EXPECT_TRUE(queue.enqueue(10001, 3, task(3)));
+    // queued after the queued version
+    EXPECT_TRUE(queue.enqueue(10001, 4, task(4)));
+    EXPECT_FALSE(queue.enqueue(10001, 4, task(4)));
+    // another tablet isn't ordered after it
+    EXPECT_FALSE(queue.enqueue(10002, 3, task(3)));
+
+    auto next = queue.finish(10001, 2);
+    ASSERT_TRUE(next);
+    next();
+    next = queue.finish(10001, 3);
+    ASSERT_TRUE(next);
+    next();
+    EXPECT_FALSE(queue.finish(10001, 4));
+    EXPECT_EQ(std::vector<int64_t>({3, 4}), published);
+
+    // all the versions of the tablet are finished
+    EXPECT_FALSE(queue.enqueue(10001, 5, task(5)));
+}
+
+TEST(TabletPublishQueueTest, DuplicatePublish) {
+    TabletPublishQueue queue;
+    queue.start(10001, 2);
+    queue.start(10001, 2);
+    EXPECT_FALSE(queue.finish(10001, 2));
+    // the other publish of the version is still in progress
+    EXPECT_TRUE(queue.enqueue(10001, 3, []() {}));
+    EXPECT_TRUE(queue.finish(10001, 2));
+}
+
+} // namespace doris
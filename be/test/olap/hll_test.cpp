@@ -19,6 +19,9 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+#include <vector>
+
 #include "util/hash_util.hpp"
 #include "util/slice.h"
 
@@ -204,4 +207,34 @@ TEST_F(TestHll, InvalidPtr) {
     }
 }
 
+TEST_F(TestHll, UpdateBatch) {
+    std::vector<uint64_t> hash_values;
+    for (uint64_t i = 0; i < 100000; ++i) {
+        hash_values.push_back(hash(i));
+    }
+    // the hash values of all the trailing zeros
+    hash_values.push_back(0);
+    hash_values.push_back(1ULL << 63);
+
+    for (size_t num_values : {10UL, 200UL, 5000UL, hash_values.size()}) {
+        HyperLogLog hll;
+        HyperLogLog batch_hll;
+        for (size_t i = 0; i < num_values; ++i) {
+            hll.update(hash_values[i]);
+        }
+        // the first batch turns the explicit values into registers
+        batch_hll.update_batch(hash_values.data(), num_values / 2);
+        batch_hll.update_batch(hash_values.data() + num_values / 2, num_values - num_values / 2);
+        EXPECT_EQ(hll.estimate_cardinality(), batch_hll.estimate_cardinality());
+
+        std::string buf(hll.max_serialized_size(), '\0');
+        std::string batch_buf(batch_hll.max_serialized_size(), '\0');
+        buf.resize(hll.serialize((uint8_t*)buf.data()));
+        batch_buf.resize(batch_hll.serialize((uint8_t*)batch_buf.data()));
+        if (num_values > HLL_EXPLICIT_INT64_NUM) {
+            EXPECT_EQ(buf, batch_buf);
+        }
+    }
+}
+
 } // namespace doris
@@ -364,6 +364,114 @@ TEST_F(CacheTest, PruneIfLazyMode) {
     EXPECT_EQ(4, cache.get_usage());
 }
 
+TEST_F(CacheTest, SegmentedLRU) {
+    LRUCache cache(LRUCacheType::NUMBER);
+    cache.set_capacity(5);
+    cache.set_protected_capacity(2);
+    auto lookup = [&cache](int k) {
+        CacheKey key {std::to_string(k)};
+        Cache::Handle* handle = cache.lookup(key, key.hash(key.data(), key.size(), 0));
+        cache.release(handle);
+        return handle != nullptr;
+    };
+
+    for (int i = 1; i <= 5; ++i) {
+        insert_LRUCache(cache, CacheKey {std::to_string(i)}, i, CachePriority::NORMAL);
+    }
+    // 1 and 2 are hit, and protected
+    EXPECT_TRUE(lookup(1));
+    EXPECT_TRUE(lookup(2));
+    EXPECT_EQ(2, cache.get_protected_usage());
+    EXPECT_EQ(2, cache.get_promotion_count());
+
+    // a scan only evicts the probation entries
+    for (int i = 6; i <= 8; ++i) {
+        insert_LRUCache(cache, CacheKey {std::to_string(i)}, i, CachePriority::NORMAL);
+    }
+    EXPECT_EQ(5, cache.get_usage());
+    EXPECT_TRUE(lookup(1));
+    EXPECT_TRUE(lookup(2));
+    EXPECT_FALSE(lookup(3));
+    EXPECT_FALSE(lookup(4));
+    EXPECT_FALSE(lookup(5));
+
+    // the protected entries exceed the protected capacity, the oldest one is evicted
+    EXPECT_TRUE(lookup(6));
+    EXPECT_EQ(3, cache.get_protected_usage());
+    insert_LRUCache(cache, CacheKey {std::to_string(9)}, 9, CachePriority::NORMAL);
+    EXPECT_FALSE(lookup(1));
+    EXPECT_TRUE(lookup(2));
+    EXPECT_TRUE(lookup(6));
+    EXPECT_EQ(2, cache.get_protected_usage());
+    EXPECT_EQ(3, cache.get_promotion_count());
+    EXPECT_TRUE(lookup(7));
+    EXPECT_EQ(3, cache.get_protected_usage());
+    EXPECT_EQ(4, cache.get_promotion_count());
+
+    cache.prune();
+    EXPECT_EQ(0, cache.get_usage());
+    EXPECT_EQ(0, cache.get_protected_usage());
+}
+
+TEST_F(CacheTest, ClockEviction) {
+    LRUCache cache(LRUCacheType::NUMBER);
+    cache.set_capacity(3);
+    cache.set_clock_eviction(true);
+    auto hash_of = [](const CacheKey& key) { return key.hash(key.data(), key.size(), 0); };
+    auto acquire = [&](int k) {
+        CacheKey key {std::to_string(k)};
+        return cache.lookup(key, hash_of(key));
+    };
+    auto lookup = [&](int k) {
+        Cache::Handle* handle = acquire(k);
+        cache.release(handle);
+        return handle != nullptr;
+    };
+
+    for (int i = 1; i <= 3; ++i) {
+        insert_LRUCache(cache, CacheKey {std::to_string(i)}, i, CachePriority::NORMAL);
+    }
+    // 1 is visited and gets a second chance
+    EXPECT_TRUE(lookup(1));
+    insert_LRUCache(cache, CacheKey {std::to_string(4)}, 4, CachePriority::NORMAL);
+    EXPECT_EQ(3, cache.get_usage());
+    EXPECT_FALSE(lookup(2));
+    // 3 is the oldest one not visited
+    insert_LRUCache(cache, CacheKey {std::to_string(5)}, 5, CachePriority::NORMAL);
+    EXPECT_FALSE(lookup(3));
+    EXPECT_TRUE(lookup(1));
+    EXPECT_TRUE(lookup(4));
+
+    // 1, 4 and 5 are visited, and 5 is in use
+    Cache::Handle* handle = acquire(5);
+    ASSERT_NE(nullptr, handle);
+    insert_LRUCache(cache, CacheKey {std::to_string(6)}, 6, CachePriority::NORMAL);
+    EXPECT_EQ(3, cache.get_usage());
+    cache.release(handle);
+    EXPECT_FALSE(lookup(1));
+    EXPECT_TRUE(lookup(4));
+    EXPECT_TRUE(lookup(5));
+    EXPECT_TRUE(lookup(6));
+
+    // erase an entry in use, it is freed when released
+    handle = acquire(4);
+    ASSERT_NE(nullptr, handle);
+    CacheKey key4 {std::to_string(4)};
+    cache.erase(key4, hash_of(key4));
+    EXPECT_EQ(2, cache.get_usage());
+    EXPECT_FALSE(lookup(4));
+    cache.release(handle);
+
+    // the entries in use are not pruned
+    handle = acquire(5);
+    EXPECT_EQ(1, cache.prune());
+    EXPECT_EQ(1, cache.get_usage());
+    cache.release(handle);
+    EXPECT_EQ(1, cache.prune());
+    EXPECT_EQ(0, cache.get_usage());
+    EXPECT_EQ(cache.get_lookup_count() - 4, cache.get_hit_count());
+}
+
 TEST_F(CacheTest, HeavyEntries) {
     // Add a bunch of light and heavy entries and then count the combined
     // size of items still in the cache, which must be approximately the
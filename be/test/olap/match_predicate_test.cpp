@@ -0,0 +1,127 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/match_predicate.h"
+
+#include <gtest/gtest.h>
+
+#include "exec/olap_utils.h"
+#include "olap/itoken_extractor.h"
+#include "olap/rowset/segment_v2/ngram_bloom_filter.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+
+namespace doris {
+
+class MatchPredicateTest : public testing::Test {
+public:
+    void SetUp() override {
+        auto values = vectorized::ColumnString::create();
+        auto null_map = vectorized::ColumnUInt8::create();
+        for (const std::string value :
+             {"hello world", "Hello Doris", "world of doris", "", "hello world"}) {
+            values->insert_data(value.data(), value.size());
+            null_map->insert_value(0);
+        }
+        // the last row is null
+        null_map->get_data().back() = 1;
+        _column = vectorized::ColumnNullable::create(std::move(values), std::move(null_map));
+    }
+
+    roaring::Roaring evaluate(const std::string& value, MatchType match_type,
+                              InvertedIndexParserType parser_type) {
+        MatchPredicate pred(0, value, match_type);
+        roaring::Roaring bitmap;
+        EXPECT_TRUE(pred.evaluate_without_index("c", parser_type, *_column, _rowids, 5, &bitmap)
+                            .ok());
+        return bitmap;
+    }
+
+protected:
+    vectorized::ColumnPtr _column;
+    const rowid_t _rowids[5] = {1, 3, 5, 7, 9};
+};
+
+TEST_F(MatchPredicateTest, without_parser) {
+    auto parser_type = InvertedIndexParserType::PARSER_NONE;
+    EXPECT_EQ(roaring::Roaring::bitmapOf(1, 1),
+              evaluate("hello world", MatchType::MATCH_ANY, parser_type));
+    EXPECT_TRUE(evaluate("hello", MatchType::MATCH_ALL, parser_type).isEmpty());
+}
+
+TEST_F(MatchPredicateTest, english_parser) {
+    auto parser_type = InvertedIndexParserType::PARSER_ENGLISH;
+    EXPECT_EQ(roaring::Roaring::bitmapOf(2, 1, 3),
+              evaluate("hello", MatchType::MATCH_ANY, parser_type));
+    EXPECT_EQ(roaring::Roaring::bitmapOf(3, 1, 3, 5),
+              evaluate("hello doris", MatchType::MATCH_ANY, parser_type));
+    EXPECT_EQ(roaring::Roaring::bitmapOf(1, 5),
+              evaluate("doris world", MatchType::MATCH_ALL, parser_type));
+    EXPECT_EQ(roaring::Roaring::bitmapOf(1, 5),
+              evaluate("of doris", MatchType::MATCH_PHRASE, parser_type));
+    EXPECT_TRUE(evaluate("doris of", MatchType::MATCH_PHRASE, parser_type).isEmpty());
+}
+
+TEST_F(MatchPredicateTest, no_terms) {
+    MatchPredicate pred(0, ",", MatchType::MATCH_ANY);
+    roaring::Roaring bitmap;
+    auto st = pred.evaluate_without_index("c", InvertedIndexParserType::PARSER_ENGLISH, *_column,
+                                          _rowids, 5, &bitmap);
+    EXPECT_EQ(ErrorCode::INVERTED_INDEX_NO_TERMS, st.code());
+}
+
+TEST_F(MatchPredicateTest, ngram_bloom_filter) {
+    // the filters of the pages of one value, as written for the string columns
+    auto page_filter = [](const std::string& value, bool ignore_case) {
+        auto bf = std::make_unique<segment_v2::NGramBloomFilter>(256);
+        bf->set_gram_options(3, ignore_case);
+        std::string lowered = value;
+        if (ignore_case) {
+            segment_v2::NGramBloomFilter::to_lower_ascii(value.data(), value.size(), &lowered);
+        }
+        NgramTokenExtractor(3).string_to_bloom_filter(lowered.data(), lowered.size(), *bf);
+        return bf;
+    };
+    auto hello = page_filter("Hello World", true);
+    auto doris = page_filter("ERROR of Doris", true);
+    auto english = InvertedIndexParserType::PARSER_ENGLISH;
+
+    MatchPredicate all(0, "doris, Error", MatchType::MATCH_ALL, english);
+    EXPECT_FALSE(all.evaluate_and(hello.get()));
+    EXPECT_TRUE(all.evaluate_and(doris.get()));
+    MatchPredicate any(0, "hello doris", MatchType::MATCH_ANY, english);
+    EXPECT_TRUE(any.evaluate_and(hello.get()));
+    EXPECT_TRUE(any.evaluate_and(doris.get()));
+    // the terms shorter than a gram are in any page
+    MatchPredicate phrase(0, "of doris", MatchType::MATCH_PHRASE, english);
+    EXPECT_FALSE(phrase.evaluate_and(hello.get()));
+    EXPECT_TRUE(phrase.evaluate_and(doris.get()));
+    MatchPredicate short_any(0, "of world", MatchType::MATCH_ANY, english);
+    EXPECT_TRUE(short_any.evaluate_and(doris.get()));
+
+    MatchPredicate whole(0, "Hello World", MatchType::MATCH_ANY,
+                         InvertedIndexParserType::PARSER_NONE);
+    EXPECT_TRUE(whole.evaluate_and(hello.get()));
+    EXPECT_FALSE(whole.evaluate_and(doris.get()));
+
+    // the terms are lowercased, so the filters of the case can't be tested
+    EXPECT_TRUE(all.evaluate_and(page_filter("Hello World", false).get()));
+    MatchPredicate unknown(0, "doris", MatchType::MATCH_ALL);
+    EXPECT_TRUE(unknown.evaluate_and(hello.get()));
+}
+
+} // namespace doris
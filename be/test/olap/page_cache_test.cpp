@@ -245,4 +245,38 @@ TEST(StoragePageCacheTest, mixed_pages) {
     }
 }
 
+// Compressed pages are kept in a separate tier
+TEST(StoragePageCacheTest, compressed_page) {
+    StoragePageCache cache(kNumShards * 2048, 0, kNumShards, 0, kNumShards * 2048);
+    EXPECT_TRUE(cache.is_compressed_cache_available());
+
+    StoragePageCache::CacheKey key("abc", 0);
+    {
+        std::string raw(1024, 'a');
+        cache.insert_compressed(key, Slice(raw));
+
+        PageCacheHandle handle;
+        // not in the decompressed tier
+        EXPECT_FALSE(cache.lookup(key, &handle, segment_v2::DATA_PAGE));
+        EXPECT_TRUE(cache.lookup_compressed(key, &handle));
+        // a copy is cached
+        EXPECT_NE(raw.data(), handle.data().data);
+        EXPECT_EQ(raw, handle.data().to_string());
+    }
+
+    // put too many page to eliminate first page
+    for (int i = 1; i <= 10 * kNumShards; ++i) {
+        StoragePageCache::CacheKey key("bcd", i);
+        std::string raw(1024, 'b');
+        cache.insert_compressed(key, Slice(raw));
+    }
+    {
+        PageCacheHandle handle;
+        EXPECT_FALSE(cache.lookup_compressed(key, &handle));
+    }
+
+    StoragePageCache no_compressed_cache(kNumShards * 2048, 0, kNumShards);
+    EXPECT_FALSE(no_compressed_cache.is_compressed_cache_available());
+}
+
 } // namespace doris
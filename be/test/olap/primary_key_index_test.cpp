@@ -156,4 +156,65 @@ TEST_F(PrimaryKeyIndexTest, builder) {
     }
 }
 
+TEST_F(PrimaryKeyIndexTest, memory_index) {
+    std::string filename = kTestDir + "/memory_index";
+    io::FileWriterPtr file_writer;
+    auto fs = io::global_local_filesystem();
+    EXPECT_TRUE(fs->create_file(filename, &file_writer).ok());
+
+    // the keys share a common prefix, and some of them share the following 8 bytes
+    PrimaryKeyIndexBuilder builder(file_writer.get(), 0);
+    builder.init();
+    std::vector<std::string> keys;
+    for (int i = 1000; i < 10000; i += 2) {
+        std::string key = "common_" + std::to_string(i);
+        keys.push_back(key);
+        keys.push_back(key + "_and_a_long_suffix_" + std::to_string(i));
+    }
+    for (auto& key : keys) {
+        EXPECT_TRUE(builder.add_item(key).ok());
+    }
+    segment_v2::PrimaryKeyIndexMetaPB index_meta;
+    EXPECT_TRUE(builder.finalize(&index_meta));
+    EXPECT_TRUE(file_writer->close().ok());
+
+    PrimaryKeyIndexReader index_reader;
+    io::FileReaderSPtr file_reader;
+    EXPECT_TRUE(fs->open_file(filename, &file_reader).ok());
+    EXPECT_TRUE(index_reader.parse_index(file_reader, index_meta).ok());
+
+    {
+        PrimaryKeyMemoryIndex memory_index;
+        EXPECT_TRUE(memory_index.build(index_reader, 1024).is<MEM_LIMIT_EXCEEDED>());
+    }
+    PrimaryKeyMemoryIndex memory_index;
+    EXPECT_TRUE(memory_index.build(index_reader, 64 * 1024 * 1024).ok());
+    EXPECT_EQ(keys.size(), memory_index.num_rows());
+    EXPECT_GT(memory_index.memory_size(), 0);
+
+    bool exact_match = false;
+    for (size_t i = 0; i < keys.size(); i++) {
+        EXPECT_EQ(keys[i], memory_index.key_at(i).to_string());
+        EXPECT_EQ(i, memory_index.seek_at_or_after(keys[i], &exact_match));
+        EXPECT_TRUE(exact_match);
+    }
+
+    // the same results as the iterator for the non-existing keys
+    std::unique_ptr<segment_v2::IndexedColumnIterator> index_iterator;
+    EXPECT_TRUE(index_reader.new_iterator(&index_iterator).ok());
+    for (std::string key : {"common_8701", "common_87", "common_1000_", "common_1000_b", "a",
+                            "common", "common_0", "common_1000"}) {
+        Slice slice(key);
+        uint32_t row_id = memory_index.seek_at_or_after(slice, &exact_match);
+        bool iterator_exact_match = false;
+        EXPECT_TRUE(index_iterator->seek_at_or_after(&slice, &iterator_exact_match).ok());
+        EXPECT_EQ(index_iterator->get_current_ordinal(), row_id) << key;
+        EXPECT_EQ(iterator_exact_match, exact_match) << key;
+    }
+    for (std::string key : {"common_9999", "d"}) {
+        EXPECT_EQ(keys.size(), memory_index.seek_at_or_after(key, &exact_match));
+        EXPECT_FALSE(exact_match);
+    }
+}
+
 } // namespace doris
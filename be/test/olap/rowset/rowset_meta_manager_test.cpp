@@ -109,6 +109,27 @@ TEST_F(RowsetMetaManagerTest, TestSaveAndGetAndRemove) {
     EXPECT_TRUE(status != Status::OK());
 }
 
+TEST_F(RowsetMetaManagerTest, TestBatchSave) {
+    std::vector<std::pair<TabletUid, RowsetMetaSharedPtr>> rowset_metas;
+    for (int64_t i = 0; i < 3; ++i) {
+        RowsetMetaSharedPtr rowset_meta(new RowsetMeta());
+        rowset_meta->init_from_json(_json_rowset_meta);
+        RowsetId rowset_id;
+        rowset_id.init(20000 + i);
+        rowset_meta->set_rowset_id(rowset_id);
+        rowset_metas.emplace_back(TabletUid(10, 10 + i), rowset_meta);
+    }
+    Status status = RowsetMetaManager::save(_meta, rowset_metas);
+    EXPECT_TRUE(status == Status::OK());
+    for (auto& [tablet_uid, rowset_meta] : rowset_metas) {
+        RowsetMetaSharedPtr rowset_meta_read(new RowsetMeta());
+        status = RowsetMetaManager::get_rowset_meta(_meta, tablet_uid, rowset_meta->rowset_id(),
+                                                    rowset_meta_read);
+        EXPECT_TRUE(status == Status::OK());
+        EXPECT_EQ(rowset_meta->rowset_id(), rowset_meta_read->rowset_id());
+    }
+}
+
 TEST_F(RowsetMetaManagerTest, TestLoad) {
     RowsetId rowset_id;
     rowset_id.init(10000);
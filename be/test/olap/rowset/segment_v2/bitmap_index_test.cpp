@@ -21,11 +21,13 @@
 #include <string>
 
 #include "common/logging.h"
+#include "exec/olap_utils.h"
 #include "io/fs/file_reader.h"
 #include "io/fs/file_system.h"
 #include "io/fs/file_writer.h"
 #include "io/fs/local_file_system.h"
 #include "olap/key_coder.h"
+#include "olap/match_predicate.h"
 #include "olap/olap_common.h"
 #include "olap/rowset/segment_v2/bitmap_index_reader.h"
 #include "olap/rowset/segment_v2/bitmap_index_writer.h"
@@ -232,5 +234,31 @@ TEST_F(BitmapIndexTest, test_null) {
     delete[] val;
 }
 
+// the bitmap index of the untokenized inverted index, see enable_native_inverted_index
+TEST_F(BitmapIndexTest, test_match) {
+    std::vector<Slice> values = {"doris", "hello", "doris", "hello world"};
+    std::string file_name = kTestDir + "/match";
+    ColumnIndexMetaPB meta;
+    write_index_file<OLAP_FIELD_TYPE_VARCHAR>(file_name, io::global_local_filesystem(),
+                                              values.data(), values.size(), 1, &meta);
+
+    BitmapIndexReader* reader = nullptr;
+    BitmapIndexIterator* iter = nullptr;
+    get_bitmap_reader_iter<OLAP_FIELD_TYPE_VARCHAR>(file_name, meta, &reader, &iter);
+    auto match = [&](const std::string& value, MatchType match_type) {
+        MatchPredicate pred(0, value, match_type);
+        Roaring bitmap;
+        bitmap.addRange(0, values.size() + 1);
+        EXPECT_TRUE(pred.evaluate(iter, values.size() + 1, &bitmap).ok());
+        return bitmap;
+    };
+    EXPECT_EQ(Roaring::bitmapOf(2, 0, 2), match("doris", MatchType::MATCH_ANY));
+    EXPECT_EQ(Roaring::bitmapOf(1, 3), match("hello world", MatchType::MATCH_PHRASE));
+    EXPECT_TRUE(match("hello doris", MatchType::MATCH_ALL).isEmpty());
+    EXPECT_TRUE(match("world", MatchType::MATCH_ANY).isEmpty());
+    delete reader;
+    delete iter;
+}
+
 } // namespace segment_v2
 } // namespace doris
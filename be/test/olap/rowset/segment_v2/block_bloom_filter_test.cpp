@@ -18,7 +18,9 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <vector>
 
+#include "olap/rowset/segment_v2/block_split_bloom_filter.h"
 #include "olap/rowset/segment_v2/bloom_filter.h"
 #include "util/slice.h"
 
@@ -204,5 +206,37 @@ TEST_F(BlockBloomFilterTest, contains) {
     ASSERT_FALSE(bf2->contains(*bf1));
 }
 
+// the insertion of the split block bloom filter in the parquet format spec
+static void parquet_insert(uint32_t* bitset, uint32_t num_blocks, uint64_t hash) {
+    static const uint32_t salt[8] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                     0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+    uint32_t block = static_cast<uint32_t>(((hash >> 32) * num_blocks) >> 32);
+    uint32_t key = static_cast<uint32_t>(hash);
+    for (int i = 0; i < 8; ++i) {
+        bitset[block * 8 + i] |= 1U << ((key * salt[i]) >> 27);
+    }
+}
+
+TEST_F(BlockBloomFilterTest, parquet_hash) {
+    // the number of blocks of a parquet bloom filter doesn't need to be a power of 2
+    const uint32_t num_blocks = 100;
+    std::vector<uint32_t> bitset(num_blocks * 8, 0);
+    std::vector<uint64_t> hashes;
+    for (int i = 0; i < 200; ++i) {
+        hashes.push_back((static_cast<uint64_t>(random()) << 32) | random());
+        parquet_insert(bitset.data(), num_blocks, hashes.back());
+    }
+    const auto* data = reinterpret_cast<const uint8_t*>(bitset.data());
+    for (uint64_t hash : hashes) {
+        EXPECT_TRUE(BlockSplitBloomFilter::test_parquet_hash(data, num_blocks * 32, hash));
+    }
+    int false_positives = 0;
+    for (int i = 0; i < 1000; ++i) {
+        uint64_t hash = (static_cast<uint64_t>(random()) << 32) | random();
+        false_positives += BlockSplitBloomFilter::test_parquet_hash(data, num_blocks * 32, hash);
+    }
+    EXPECT_LT(false_positives, 50);
+}
+
 } // namespace segment_v2
 } // namespace doris
@@ -26,6 +26,7 @@
 #include "olap/rowset/segment_v2/bloom_filter.h"
 #include "olap/rowset/segment_v2/bloom_filter_index_reader.h"
 #include "olap/rowset/segment_v2/bloom_filter_index_writer.h"
+#include "olap/rowset/segment_v2/ngram_bloom_filter.h"
 #include "olap/types.h"
 
 namespace doris {
@@ -279,5 +280,51 @@ TEST_F(BloomFilterIndexReaderWriterTest, test_decimal) {
     delete[] val;
 }
 
+TEST_F(BloomFilterIndexReaderWriterTest, test_ngram_ignore_case) {
+    std::string file_name = "bloom_filter_ngram";
+    ColumnIndexMetaPB meta;
+    {
+        io::FileWriterPtr file_writer;
+        auto fs = io::global_local_filesystem();
+        EXPECT_TRUE(fs->create_file(dname + "/" + file_name, &file_writer).ok());
+        NGramBloomFilterIndexWriterImpl writer(BloomFilterOptions(), 3, 256, true);
+        // one value of each page
+        for (std::string value : {"Hello World", "ERROR of Doris"}) {
+            Slice slice(value);
+            writer.add_values(&slice, 1);
+            EXPECT_TRUE(writer.flush().ok());
+        }
+        EXPECT_TRUE(writer.finish(file_writer.get(), &meta).ok());
+        EXPECT_TRUE(file_writer->close().ok());
+        EXPECT_EQ(3, meta.bloom_filter_index().gram_size());
+        EXPECT_TRUE(meta.bloom_filter_index().ignore_case());
+    }
+
+    BloomFilterIndexReader* reader = nullptr;
+    std::unique_ptr<BloomFilterIndexIterator> iter;
+    get_bloom_filter_reader_iter(file_name, meta, &reader, &iter);
+    std::unique_ptr<BloomFilter> bfs[2];
+    for (int i = 0; i < 2; ++i) {
+        EXPECT_TRUE(iter->read_bloom_filter(i, &bfs[i]).ok());
+        ASSERT_TRUE(bfs[i]->is_ngram_bf());
+    }
+    const auto& page0 = static_cast<const NGramBloomFilter&>(*bfs[0]);
+    EXPECT_EQ(3, page0.gram_size());
+    EXPECT_TRUE(page0.ignore_case());
+
+    auto error = page0.create_query_filter("%Error%", true);
+    ASSERT_NE(nullptr, error);
+    EXPECT_FALSE(bfs[0]->contains(*error));
+    EXPECT_TRUE(bfs[1]->contains(*error));
+    auto hello = page0.create_query_filter("hello wor", false);
+    ASSERT_NE(nullptr, hello);
+    EXPECT_TRUE(bfs[0]->contains(*hello));
+    EXPECT_FALSE(bfs[1]->contains(*hello));
+    // no gram in the pattern
+    EXPECT_EQ(nullptr, page0.create_query_filter("%he%", true));
+    EXPECT_EQ(nullptr, page0.create_query_filter("he", false));
+    delete reader;
+}
+
 } // namespace segment_v2
 } // namespace doris
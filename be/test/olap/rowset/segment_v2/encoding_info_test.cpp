@@ -49,5 +49,23 @@ TEST_F(EncodingInfoTest, no_encoding) {
     EXPECT_FALSE(status.ok());
 }
 
+TEST_F(EncodingInfoTest, field_type) {
+    // the encodings of the pages which are not of their columns are resolved by the field types
+    const EncodingInfo* encoding_info = nullptr;
+    auto status = EncodingInfo::get(OLAP_FIELD_TYPE_INT, FOR_ENCODING, &encoding_info);
+    EXPECT_TRUE(status.ok());
+    EXPECT_EQ(FOR_ENCODING, encoding_info->encoding());
+    EXPECT_EQ(OLAP_FIELD_TYPE_INT, encoding_info->type());
+
+    const EncodingInfo* same_encoding_info = nullptr;
+    status = EncodingInfo::get(get_scalar_type_info<OLAP_FIELD_TYPE_INT>(), FOR_ENCODING,
+                               &same_encoding_info);
+    EXPECT_TRUE(status.ok());
+    EXPECT_EQ(encoding_info, same_encoding_info);
+
+    status = EncodingInfo::get(OLAP_FIELD_TYPE_DOUBLE, FOR_ENCODING, &encoding_info);
+    EXPECT_FALSE(status.ok());
+}
+
 } // namespace segment_v2
 } // namespace doris
@@ -0,0 +1,166 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/inverted_index_scorer.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+
+namespace doris {
+namespace segment_v2 {
+
+namespace {
+
+struct Posting {
+    rowid_t row;
+    uint32_t freq;
+};
+
+class VectorPostingCursor : public PostingCursor {
+public:
+    explicit VectorPostingCursor(const std::vector<Posting>* postings) : _postings(postings) {}
+
+    rowid_t row() const override {
+        return _pos < _postings->size() ? (*_postings)[_pos].row : NO_MORE_ROWS;
+    }
+    uint32_t freq() const override { return (*_postings)[_pos].freq; }
+    void advance(rowid_t target) override {
+        EXPECT_GT(target, row());
+        while (_pos < _postings->size() && (*_postings)[_pos].row < target) {
+            ++_pos;
+        }
+        ++num_advances;
+    }
+
+    size_t num_advances = 0;
+
+private:
+    const std::vector<Posting>* _postings;
+    size_t _pos = 0;
+};
+
+} // namespace
+
+class InvertedIndexScorerTest : public testing::Test {
+public:
+    void SetUp() override {
+        std::mt19937 rng(20231014);
+        // the terms of different frequencies
+        for (uint32_t percent : {1, 5, 30, 60}) {
+            std::vector<Posting> postings;
+            for (rowid_t row = 0; row < NUM_ROWS; ++row) {
+                if (rng() % 100 < percent) {
+                    postings.push_back({row, 1 + static_cast<uint32_t>(rng() % 5)});
+                }
+            }
+            _scorers.emplace_back(NUM_ROWS, postings.size());
+            _postings.push_back(std::move(postings));
+        }
+        for (rowid_t row = 0; row < NUM_ROWS; row += 3) {
+            _filter.add(row);
+        }
+    }
+
+    std::vector<ScoredRow> collect(bool all_terms, size_t k, const roaring::Roaring* filter) {
+        std::vector<std::unique_ptr<PostingCursor>> cursors;
+        for (const auto& postings : _postings) {
+            cursors.emplace_back(new VectorPostingCursor(&postings));
+        }
+        std::vector<ScoredRow> result;
+        collect_top_k(cursors, _scorers, all_terms, k, filter, &result);
+        return result;
+    }
+
+    std::vector<ScoredRow> brute_force(bool all_terms, size_t k, const roaring::Roaring* filter) {
+        std::map<rowid_t, std::pair<size_t, float>> rows;
+        for (size_t i = 0; i < _postings.size(); ++i) {
+            for (auto posting : _postings[i]) {
+                rows[posting.row].first++;
+                rows[posting.row].second += _scorers[i].score(posting.freq);
+            }
+        }
+        std::vector<ScoredRow> result;
+        for (auto& [row, entry] : rows) {
+            if ((!all_terms || entry.first == _postings.size()) &&
+                (filter == nullptr || filter->contains(row))) {
+                result.push_back({row, entry.second});
+            }
+        }
+        std::stable_sort(result.begin(), result.end(),
+                         [](const ScoredRow& lhs, const ScoredRow& rhs) {
+                             return lhs.score > rhs.score;
+                         });
+        result.resize(std::min(k, result.size()));
+        return result;
+    }
+
+    void check(bool all_terms, size_t k, const roaring::Roaring* filter) {
+        auto expected = brute_force(all_terms, k, filter);
+        auto actual = collect(all_terms, k, filter);
+        ASSERT_EQ(expected.size(), actual.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_NEAR(expected[i].score, actual[i].score, 1e-4) << i;
+        }
+    }
+
+protected:
+    static constexpr rowid_t NUM_ROWS = 20000;
+    std::vector<std::vector<Posting>> _postings;
+    std::vector<BM25Scorer> _scorers;
+    roaring::Roaring _filter;
+};
+
+TEST_F(InvertedIndexScorerTest, bm25) {
+    BM25Scorer rare(1000, 1);
+    BM25Scorer common(1000, 500);
+    EXPECT_GT(rare.score(1), common.score(1));
+    EXPECT_GT(rare.score(2), rare.score(1));
+    EXPECT_LT(rare.score(100), rare.max_score());
+}
+
+TEST_F(InvertedIndexScorerTest, any_terms) {
+    for (size_t k : {1, 10, 100, 100000}) {
+        check(false, k, nullptr);
+        check(false, k, &_filter);
+    }
+}
+
+TEST_F(InvertedIndexScorerTest, all_terms) {
+    for (size_t k : {1, 10, 100000}) {
+        check(true, k, nullptr);
+        check(true, k, &_filter);
+    }
+}
+
+TEST_F(InvertedIndexScorerTest, skip_non_essential_terms) {
+    std::vector<std::unique_ptr<PostingCursor>> cursors;
+    for (const auto& postings : _postings) {
+        cursors.emplace_back(new VectorPostingCursor(&postings));
+    }
+    std::vector<ScoredRow> result;
+    collect_top_k(cursors, _scorers, false, 10, nullptr, &result);
+    EXPECT_EQ(10, result.size());
+    // the most frequent term is advanced only to the rows of the others
+    auto* frequent = static_cast<VectorPostingCursor*>(cursors.back().get());
+    EXPECT_LT(frequent->num_advances, _postings.back().size() / 2);
+}
+
+} // namespace segment_v2
+} // namespace doris
@@ -17,8 +17,10 @@
 
 #include <gtest/gtest.h>
 
+#include "common/config.h"
 #include "io/fs/local_file_system.h"
 #include "olap/rowset/segment_v2/inverted_index_cache.h"
+#include "olap/rowset/segment_v2/inverted_index_reader.h"
 #include "util/time.h"
 
 namespace doris {
@@ -358,5 +360,32 @@ TEST_F(InvertedIndexSearcherCacheTest, remove_element_only_in_table) {
     delete index_searcher_cache;
 }
 
+TEST_F(InvertedIndexSearcherCacheTest, query_cache_admission) {
+    InvertedIndexQueryCache query_cache(1024 * 1024, 10, 1);
+    InvertedIndexQueryCache::CacheKey key {kTestDir + "/test_1.idx", "c1",
+                                           InvertedIndexQueryType::EQUAL_QUERY, L"doris"};
+    auto insert = [&]() {
+        auto* bitmap = new roaring::Roaring();
+        bitmap->addRange(0, 100);
+        InvertedIndexQueryCacheHandle handle;
+        query_cache.insert(key, bitmap, &handle);
+        EXPECT_EQ(100, handle.match_bitmap()->cardinality());
+    };
+
+    InvertedIndexQueryCacheHandle handle;
+    // admitted on the second miss
+    insert();
+    EXPECT_FALSE(query_cache.lookup(key, &handle));
+    insert();
+    EXPECT_TRUE(query_cache.lookup(key, &handle));
+    EXPECT_EQ(100, handle.match_bitmap()->cardinality());
+
+    config::enable_inverted_index_query_cache_admission = false;
+    key.value = L"apache";
+    insert();
+    EXPECT_TRUE(query_cache.lookup(key, &handle));
+    config::enable_inverted_index_query_cache_admission = true;
+}
+
 } // namespace segment_v2
 } // namespace doris
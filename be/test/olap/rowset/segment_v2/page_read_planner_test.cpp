@@ -0,0 +1,164 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#include "olap/rowset/segment_v2/page_read_planner.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "io/fs/file_reader.h"
+#include "io/fs/file_writer.h"
+#include "io/fs/local_file_system.h"
+#include "olap/olap_common.h"
+#include "olap/page_cache.h"
+
+namespace doris {
+namespace segment_v2 {
+
+class PageReadPlannerTest : public testing::Test {
+public:
+    const std::string kTestDir = "./ut_dir/page_read_planner_test";
+
+    void SetUp() override {
+        EXPECT_TRUE(io::global_local_filesystem()->delete_and_create_directory(kTestDir).ok());
+    }
+    void TearDown() override {
+        EXPECT_TRUE(io::global_local_filesystem()->delete_directory(kTestDir).ok());
+    }
+
+    static void write_page(io::FileWriter* writer, const std::string& body, PagePointer* pp) {
+        PageFooterPB footer;
+        footer.set_type(DATA_PAGE);
+        footer.set_uncompressed_size(body.size());
+        footer.mutable_data_page_footer()->set_num_values(body.size());
+        EXPECT_TRUE(PageIO::write_page(writer, {Slice(body)}, footer, pp).ok());
+    }
+
+    static bool in_cache(const io::FileReader* reader, const PagePointer& pp) {
+        PageCacheHandle handle;
+        StoragePageCache::CacheKey key(reader->path().native(), pp.offset);
+        return StoragePageCache::instance()->lookup(key, &handle, DATA_PAGE);
+    }
+};
+
+TEST_F(PageReadPlannerTest, merge_adjacent_pages) {
+    std::string filename = kTestDir + "/merge_adjacent_pages.dat";
+    auto fs = io::global_local_filesystem();
+
+    // page 0, 1 and 2 are adjacent, page 3 is 1KB after page 2
+    std::vector<PagePointer> pages(4);
+    {
+        io::FileWriterPtr file_writer;
+        EXPECT_TRUE(fs->create_file(filename, &file_writer).ok());
+        for (int i = 0; i < 3; ++i) {
+            write_page(file_writer.get(), std::string(100 + i, 'a' + i), &pages[i]);
+        }
+        EXPECT_TRUE(file_writer->append(Slice(std::string(1024, 'x'))).ok());
+        write_page(file_writer.get(), std::string(200, 'd'), &pages[3]);
+        EXPECT_TRUE(file_writer->close().ok());
+    }
+    EXPECT_EQ(pages[0].offset + pages[0].size, pages[1].offset);
+    EXPECT_EQ(pages[1].offset + pages[1].size, pages[2].offset);
+
+    io::FileReaderSPtr file_reader;
+    EXPECT_TRUE(fs->open_file(filename, &file_reader).ok());
+    OlapReaderStatistics stats;
+    PageReadOptions opts;
+    opts.file_reader = file_reader.get();
+    opts.stats = &stats;
+    opts.type = DATA_PAGE;
+
+    {
+        // gap of page 3 is too large, page 1 is added twice
+        PageReadPlanner planner(512, 1 << 20);
+        for (int i : {3, 1, 0, 1}) {
+            opts.page_pointer = pages[i];
+            planner.add_page(opts);
+        }
+        EXPECT_TRUE(planner.read_pages(&stats).ok());
+        EXPECT_EQ(1, stats.merged_page_read_num);
+        EXPECT_EQ(2, stats.merged_pages_num);
+        EXPECT_TRUE(in_cache(file_reader.get(), pages[0]));
+        EXPECT_TRUE(in_cache(file_reader.get(), pages[1]));
+        EXPECT_FALSE(in_cache(file_reader.get(), pages[2]));
+        EXPECT_FALSE(in_cache(file_reader.get(), pages[3]));
+    }
+    {
+        // page 0 is in cache already, page 2 and 3 are merged across the gap
+        PageReadPlanner planner(1024, 1 << 20);
+        for (int i : {0, 2, 3}) {
+            opts.page_pointer = pages[i];
+            planner.add_page(opts);
+        }
+        EXPECT_TRUE(planner.read_pages(&stats).ok());
+        EXPECT_EQ(2, stats.merged_page_read_num);
+        EXPECT_EQ(4, stats.merged_pages_num);
+        EXPECT_TRUE(in_cache(file_reader.get(), pages[2]));
+        EXPECT_TRUE(in_cache(file_reader.get(), pages[3]));
+    }
+
+    // the pages are read from cache
+    opts.page_pointer = pages[3];
+    PageHandle handle;
+    Slice body;
+    PageFooterPB footer;
+    EXPECT_TRUE(PageIO::read_and_decompress_page(opts, &handle, &body, &footer).ok());
+    EXPECT_EQ(1, stats.cached_pages_num);
+    EXPECT_EQ(std::string(200, 'd'), body.to_string());
+}
+
+TEST_F(PageReadPlannerTest, max_read_size) {
+    std::string filename = kTestDir + "/max_read_size.dat";
+    auto fs = io::global_local_filesystem();
+
+    std::vector<PagePointer> pages(3);
+    {
+        io::FileWriterPtr file_writer;
+        EXPECT_TRUE(fs->create_file(filename, &file_writer).ok());
+        for (int i = 0; i < 3; ++i) {
+            write_page(file_writer.get(), std::string(1000, 'a' + i), &pages[i]);
+        }
+        EXPECT_TRUE(file_writer->close().ok());
+    }
+
+    io::FileReaderSPtr file_reader;
+    EXPECT_TRUE(fs->open_file(filename, &file_reader).ok());
+    OlapReaderStatistics stats;
+    PageReadOptions opts;
+    opts.file_reader = file_reader.get();
+    opts.stats = &stats;
+    opts.type = DATA_PAGE;
+
+    // only 2 pages fit into one read, the last page is left to the caller
+    PageReadPlanner planner(0, 2100);
+    for (auto& pp : pages) {
+        opts.page_pointer = pp;
+        planner.add_page(opts);
+    }
+    EXPECT_TRUE(planner.read_pages(&stats).ok());
+    EXPECT_EQ(1, stats.merged_page_read_num);
+    EXPECT_EQ(2, stats.merged_pages_num);
+    EXPECT_TRUE(in_cache(file_reader.get(), pages[1]));
+    EXPECT_FALSE(in_cache(file_reader.get(), pages[2]));
+}
+
+} // namespace segment_v2
+} // namespace doris
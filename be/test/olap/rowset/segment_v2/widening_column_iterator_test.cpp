@@ -0,0 +1,140 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "olap/rowset/segment_v2/column_reader.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+
+namespace doris {
+namespace segment_v2 {
+
+namespace {
+
+// Reads INT values, the rows of which divisible by 3 are null if read into a nullable column.
+class IntColumnIterator : public ColumnIterator {
+public:
+    explicit IntColumnIterator(std::vector<int32_t> values) : _values(std::move(values)) {}
+
+    Status seek_to_first() override { return seek_to_ordinal(0); }
+
+    Status seek_to_ordinal(ordinal_t ord) override {
+        _ordinal = ord;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, vectorized::MutableColumnPtr& dst, bool* has_null) override {
+        *n = std::min(*n, _values.size() - _ordinal);
+        std::vector<rowid_t> rowids;
+        for (size_t i = 0; i < *n; ++i) {
+            rowids.push_back(_ordinal + i);
+        }
+        _ordinal += *n;
+        *has_null = dst->is_nullable();
+        return read_by_rowids(rowids.data(), rowids.size(), dst);
+    }
+
+    Status read_by_rowids(const rowid_t* rowids, const size_t count,
+                          vectorized::MutableColumnPtr& dst) override {
+        for (size_t i = 0; i < count; ++i) {
+            if (dst->is_nullable() && rowids[i] % 3 == 0) {
+                dst->insert_default();
+            } else {
+                dst->insert_many_fix_len_data(
+                        reinterpret_cast<const char*>(&_values[rowids[i]]), 1);
+            }
+        }
+        return Status::OK();
+    }
+
+    ordinal_t get_current_ordinal() const override { return _ordinal; }
+
+private:
+    std::vector<int32_t> _values;
+    ordinal_t _ordinal = 0;
+};
+
+} // namespace
+
+TEST(WideningColumnIteratorTest, can_widen) {
+    EXPECT_TRUE(WideningColumnIterator::can_widen(OLAP_FIELD_TYPE_TINYINT, OLAP_FIELD_TYPE_INT));
+    EXPECT_TRUE(
+            WideningColumnIterator::can_widen(OLAP_FIELD_TYPE_BIGINT, OLAP_FIELD_TYPE_LARGEINT));
+    EXPECT_FALSE(WideningColumnIterator::can_widen(OLAP_FIELD_TYPE_INT, OLAP_FIELD_TYPE_INT));
+    EXPECT_FALSE(WideningColumnIterator::can_widen(OLAP_FIELD_TYPE_INT, OLAP_FIELD_TYPE_SMALLINT));
+    EXPECT_FALSE(WideningColumnIterator::can_widen(OLAP_FIELD_TYPE_INT, OLAP_FIELD_TYPE_DOUBLE));
+    EXPECT_FALSE(
+            WideningColumnIterator::can_widen(OLAP_FIELD_TYPE_VARCHAR, OLAP_FIELD_TYPE_STRING));
+}
+
+TEST(WideningColumnIteratorTest, next_batch) {
+    std::vector<int32_t> values {INT32_MIN, -1, 0, 1, INT32_MAX};
+    WideningColumnIterator iter(std::make_unique<IntColumnIterator>(values), OLAP_FIELD_TYPE_INT,
+                                OLAP_FIELD_TYPE_BIGINT);
+    ASSERT_TRUE(iter.init(ColumnIteratorOptions()).ok());
+    ASSERT_TRUE(iter.seek_to_ordinal(1).ok());
+
+    vectorized::MutableColumnPtr dst = vectorized::ColumnInt64::create();
+    size_t n = 3;
+    bool has_null = false;
+    ASSERT_TRUE(iter.next_batch(&n, dst, &has_null).ok());
+    n = 10;
+    ASSERT_TRUE(iter.next_batch(&n, dst, &has_null).ok());
+    EXPECT_EQ(1, n);
+    EXPECT_EQ(5, iter.get_current_ordinal());
+
+    const auto& data = assert_cast<const vectorized::ColumnInt64&>(*dst).get_data();
+    ASSERT_EQ(4, data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        EXPECT_EQ(values[i + 1], data[i]);
+    }
+}
+
+TEST(WideningColumnIteratorTest, read_by_rowids_nullable) {
+    std::vector<int32_t> values {10, -20, 30, -40, 50, -60, 70};
+    WideningColumnIterator iter(std::make_unique<IntColumnIterator>(values), OLAP_FIELD_TYPE_INT,
+                                OLAP_FIELD_TYPE_LARGEINT);
+    ASSERT_TRUE(iter.init(ColumnIteratorOptions()).ok());
+
+    vectorized::MutableColumnPtr dst = vectorized::ColumnNullable::create(
+            vectorized::ColumnInt128::create(), vectorized::ColumnUInt8::create());
+    std::vector<rowid_t> rowids {0, 1, 3, 5, 6};
+    ASSERT_TRUE(iter.read_by_rowids(rowids.data(), rowids.size(), dst).ok());
+    // read again into the reused column of the type in the file
+    ASSERT_TRUE(iter.read_by_rowids(rowids.data(), 2, dst).ok());
+
+    const auto& nullable = assert_cast<const vectorized::ColumnNullable&>(*dst);
+    const auto& data =
+            assert_cast<const vectorized::ColumnInt128&>(nullable.get_nested_column()).get_data();
+    ASSERT_EQ(7, nullable.size());
+    rowids.push_back(0);
+    rowids.push_back(1);
+    for (size_t i = 0; i < rowids.size(); ++i) {
+        EXPECT_EQ(rowids[i] % 3 == 0, nullable.is_null_at(i)) << i;
+        if (!nullable.is_null_at(i)) {
+            EXPECT_EQ(values[rowids[i]], data[i]) << i;
+        }
+    }
+}
+
+} // namespace segment_v2
+} // namespace doris
@@ -26,6 +26,7 @@
 #include "io/fs/file_system.h"
 #include "io/fs/file_writer.h"
 #include "io/fs/local_file_system.h"
+#include "olap/field.h"
 #include "olap/page_cache.h"
 #include "olap/tablet_schema_helper.h"
 
@@ -225,5 +226,27 @@ TEST_F(ColumnZoneMapTest, ZoneMapCut) {
     delete field;
 }
 
+// Test for the upper bound of a cut max value
+TEST_F(ColumnZoneMapTest, TruncatedMaxUpperBound) {
+    char buf[MAX_ZONE_MAP_INDEX_SIZE];
+    memset(buf, 'a', MAX_ZONE_MAP_INDEX_SIZE);
+    buf[MAX_ZONE_MAP_INDEX_SIZE - 2] = '\xFF';
+    buf[MAX_ZONE_MAP_INDEX_SIZE - 1] = '\xFF';
+    Slice slice(buf, MAX_ZONE_MAP_INDEX_SIZE);
+    EXPECT_TRUE(make_truncated_max_upper_bound(&slice));
+    EXPECT_EQ(MAX_ZONE_MAP_INDEX_SIZE - 2U, slice.size);
+    EXPECT_EQ('b', slice.data[slice.size - 1]);
+
+    // a value which is not cut is kept
+    Slice short_slice(buf, 10);
+    EXPECT_TRUE(make_truncated_max_upper_bound(&short_slice));
+    EXPECT_EQ(10U, short_slice.size);
+    EXPECT_EQ('a', short_slice.data[9]);
+
+    memset(buf, 0xFF, MAX_ZONE_MAP_INDEX_SIZE);
+    slice = Slice(buf, MAX_ZONE_MAP_INDEX_SIZE);
+    EXPECT_FALSE(make_truncated_max_upper_bound(&slice));
+}
+
 } // namespace segment_v2
 } // namespace doris
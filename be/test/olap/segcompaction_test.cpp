@@ -15,6 +15,7 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include <fmt/format.h>
 #include <gtest/gtest.h>
 
 #include <memory>
@@ -600,6 +601,59 @@ TEST_F(SegCompactionTest, SegCompactionInterleaveWithBig_OoOoO) {
     }
 }
 
+TEST_F(SegCompactionTest, SegCompactionSkipNonOverlapping) {
+    config::enable_segcompaction = true;
+    Status s;
+    TabletSchemaSPtr tablet_schema = std::make_shared<TabletSchema>();
+    create_tablet_schema(tablet_schema, DUP_KEYS);
+
+    RowsetSharedPtr rowset;
+    const int num_segments = 6;
+    const uint32_t rows_per_segment = 4096;
+    config::segcompaction_small_threshold = 6000; // set threshold above
+                                                  // rows_per_segment
+    config::segcompaction_threshold_segment_num = 5;
+    { // write `num_segments * rows_per_segment` rows to rowset
+        RowsetWriterContext writer_context;
+        create_rowset_writer_context(10050, tablet_schema, &writer_context);
+
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        s = RowsetFactory::create_rowset_writer(writer_context, false, &rowset_writer);
+        EXPECT_EQ(Status::OK(), s);
+
+        RowCursor input_row;
+        input_row.init(tablet_schema);
+
+        // for segment "i", row "rid"
+        // k1 := rows_per_segment * i + rid, the segments are in order
+        for (int i = 0; i < num_segments; ++i) {
+            vectorized::Arena arena;
+            for (int rid = 0; rid < rows_per_segment; ++rid) {
+                uint32_t k1 = rows_per_segment * i + rid;
+                uint32_t k2 = i;
+                uint32_t k3 = rid;
+                input_row.set_field_content(0, reinterpret_cast<char*>(&k1), &arena);
+                input_row.set_field_content(1, reinterpret_cast<char*>(&k2), &arena);
+                input_row.set_field_content(2, reinterpret_cast<char*>(&k3), &arena);
+                s = rowset_writer->add_row(input_row);
+                EXPECT_EQ(Status::OK(), s);
+            }
+            s = rowset_writer->flush();
+            EXPECT_EQ(Status::OK(), s);
+            sleep(1);
+        }
+
+        rowset = rowset_writer->build();
+        // no segment is compacted
+        std::vector<std::string> ls;
+        for (int i = 0; i < num_segments; ++i) {
+            ls.push_back(fmt::format("10050_{}.dat", i));
+        }
+        EXPECT_TRUE(check_dir(ls));
+        EXPECT_EQ(NONOVERLAPPING, rowset->rowset_meta()->segments_overlap());
+    }
+}
+
 TEST_F(SegCompactionTest, SegCompactionThenReadUniqueTableSmall) {
     config::enable_segcompaction = true;
     Status s;
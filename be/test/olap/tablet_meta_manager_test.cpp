@@ -100,4 +100,48 @@ TEST_F(TabletMetaManagerTest, TestLoad) {
     EXPECT_EQ(_json_header, json_meta_read);
 }
 
+TEST_F(TabletMetaManagerTest, TestDeleteBitmap) {
+    const TTabletId tablet_id = 15672;
+    RowsetId rowset_id;
+    rowset_id.init(10000);
+    for (int64_t version : {3, 12, 100, 101}) {
+        DeleteBitmap delete_bitmap(tablet_id);
+        delete_bitmap.add({rowset_id, 0, 0}, version);
+        EXPECT_EQ(Status::OK(), TabletMetaManager::save_delete_bitmap(_data_dir, tablet_id,
+                                                                      version, delete_bitmap));
+    }
+    // the deltas of another tablet
+    DeleteBitmap delete_bitmap(tablet_id + 1);
+    delete_bitmap.add({rowset_id, 0, 0}, 1);
+    EXPECT_EQ(Status::OK(), TabletMetaManager::save_delete_bitmap(_data_dir, tablet_id + 1, 5,
+                                                                  delete_bitmap));
+
+    auto traverse = [this](TTabletId expected_tablet_id) {
+        std::vector<int64_t> versions;
+        auto func = [&](int64_t tablet_id, int64_t version, const std::string& value) -> bool {
+            if (tablet_id != expected_tablet_id) {
+                return true;
+            }
+            DeleteBitmapPB delete_bitmap_pb;
+            EXPECT_TRUE(delete_bitmap_pb.ParseFromString(value));
+            EXPECT_EQ(1, delete_bitmap_pb.versions_size());
+            EXPECT_EQ(version, delete_bitmap_pb.versions(0));
+            auto bitmap =
+                    roaring::Roaring::read(delete_bitmap_pb.segment_delete_bitmaps(0).data());
+            EXPECT_TRUE(bitmap.contains(version));
+            versions.push_back(version);
+            return true;
+        };
+        EXPECT_EQ(Status::OK(),
+                  TabletMetaManager::traverse_delete_bitmap(_data_dir->get_meta(), func));
+        return versions;
+    };
+    EXPECT_EQ(std::vector<int64_t>({3, 12, 100, 101}), traverse(tablet_id));
+
+    EXPECT_EQ(Status::OK(),
+              TabletMetaManager::remove_old_version_delete_bitmap(_data_dir, tablet_id, 100));
+    EXPECT_EQ(std::vector<int64_t>({101}), traverse(tablet_id));
+    EXPECT_EQ(std::vector<int64_t>({5}), traverse(tablet_id + 1));
+}
+
 } // namespace doris
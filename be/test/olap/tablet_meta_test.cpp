@@ -241,4 +241,34 @@ TEST(TabletMetaTest, TestDeleteBitmap) {
     }
 }
 
+TEST(TabletMetaTest, TestDeleteBitmapAggregate) {
+    DeleteBitmap dbmp(10087);
+    RowsetId rowset_id {2, 0, 1, 1};
+    RowsetId other_rowset_id {2, 0, 1, 2};
+    for (uint64_t version = 1; version <= 6; ++version) {
+        dbmp.add({rowset_id, 0, version}, version);
+        dbmp.add({rowset_id, 1, version}, version + 100);
+    }
+    dbmp.add({other_rowset_id, 0, 2}, 2);
+    ASSERT_EQ(dbmp.delete_bitmap.size(), 13);
+
+    // merge [2, 5) into 5
+    ASSERT_EQ(dbmp.aggregate(2, 5), 7);
+    ASSERT_EQ(dbmp.delete_bitmap.size(), 7);
+    for (uint32_t row_id : {2, 3, 4, 5}) {
+        ASSERT_TRUE(dbmp.contains({rowset_id, 0, 5}, row_id));
+        ASSERT_TRUE(dbmp.contains({rowset_id, 1, 5}, row_id + 100));
+    }
+    ASSERT_TRUE(dbmp.contains({rowset_id, 0, 1}, 1));
+    ASSERT_TRUE(dbmp.contains({rowset_id, 0, 6}, 6));
+    ASSERT_FALSE(dbmp.contains({rowset_id, 0, 6}, 5));
+    // the target version doesn't exist before
+    ASSERT_TRUE(dbmp.contains({other_rowset_id, 0, 5}, 2));
+    ASSERT_EQ(dbmp.get({other_rowset_id, 0, 2}), nullptr);
+
+    // nothing to merge
+    ASSERT_EQ(dbmp.aggregate(2, 5), 0);
+    ASSERT_EQ(dbmp.delete_bitmap.size(), 7);
+}
+
 } // namespace doris
@@ -0,0 +1,64 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/block_spill_manager.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+#include "runtime/runtime_state.h"
+
+namespace doris {
+
+TEST(BlockSpillManagerTest, RevokeMemory) {
+    int64_t old_min_bytes = config::spill_revocable_min_bytes;
+    config::spill_revocable_min_bytes = 1024;
+
+    RuntimeState state;
+    BlockSpillManager spill_mgr({});
+    RevocableMemory small("small", &state);
+    RevocableMemory medium("medium", &state);
+    RevocableMemory large("large", &state);
+    small.set_bytes(512);
+    medium.set_bytes(4096);
+    large.set_bytes(8192);
+    for (auto* memory : {&small, &medium, &large}) {
+        spill_mgr.register_revocable_memory(memory);
+    }
+
+    // the largest one first
+    EXPECT_EQ(8192, spill_mgr.revoke_memory(2048));
+    EXPECT_TRUE(large.revoke_requested());
+    EXPECT_FALSE(medium.revoke_requested());
+
+    // the pending request is not counted again, and the small one is never asked
+    EXPECT_EQ(4096, spill_mgr.revoke_memory(1 << 20));
+    EXPECT_TRUE(medium.revoke_requested());
+    EXPECT_FALSE(small.revoke_requested());
+    EXPECT_EQ(0, spill_mgr.revoke_memory(1 << 20));
+
+    large.revoked();
+    EXPECT_FALSE(large.revoke_requested());
+    EXPECT_EQ(0, large.bytes());
+
+    for (auto* memory : {&small, &medium, &large}) {
+        spill_mgr.deregister_revocable_memory(memory);
+    }
+    config::spill_revocable_min_bytes = old_min_bytes;
+}
+
+} // namespace doris
@@ -0,0 +1,97 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/fragment_replayer.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+#include "common/config.h"
+#include "util/uid_util.h"
+
+namespace doris {
+
+class FragmentReplayerTest : public testing::Test {
+public:
+    void SetUp() override {
+        _saved_dir = config::fragment_capture_dir;
+        config::fragment_capture_dir = "./ut_dir/fragment_capture";
+        std::filesystem::remove_all(config::fragment_capture_dir);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(config::fragment_capture_dir);
+        config::fragment_capture_dir = _saved_dir;
+    }
+
+    static TExecPlanFragmentParams make_params(const TUniqueId& query_id, int64_t instance,
+                                               TDataSinkType::type sink_type) {
+        TExecPlanFragmentParams params;
+        params.params.query_id = query_id;
+        params.params.fragment_instance_id.__set_hi(query_id.hi);
+        params.params.fragment_instance_id.__set_lo(query_id.lo + instance);
+        params.fragment.output_sink.type = sink_type;
+        params.fragment.__isset.output_sink = true;
+        return params;
+    }
+
+private:
+    std::string _saved_dir;
+};
+
+TEST_F(FragmentReplayerTest, capture_and_init) {
+    TUniqueId query_id = UniqueId::gen_uid().to_thrift();
+    auto root = make_params(query_id, 1, TDataSinkType::RESULT_SINK);
+    auto child = make_params(query_id, 2, TDataSinkType::DATA_STREAM_SINK);
+    TPlanFragmentDestination destination;
+    destination.fragment_instance_id = root.params.fragment_instance_id;
+    child.params.destinations.push_back(destination);
+    child.__set_is_simplified_param(true);
+    // the loads are not captured
+    auto load = make_params(query_id, 3, TDataSinkType::OLAP_TABLE_SINK);
+
+    auto* capturer = FragmentCapturer::instance();
+    capturer->capture(root);
+    capturer->capture(child);
+    capturer->capture(load);
+    auto queries = capturer->list_queries();
+    ASSERT_EQ(1, queries.size());
+    EXPECT_EQ(print_id(query_id), queries[0]);
+
+    FragmentReplayer replayer(nullptr, config::fragment_capture_dir + "/" + queries[0]);
+    ASSERT_TRUE(replayer.init().ok());
+    EXPECT_EQ(2, replayer.num_instances());
+}
+
+TEST_F(FragmentReplayerTest, missing_destination) {
+    TUniqueId query_id = UniqueId::gen_uid().to_thrift();
+    auto child = make_params(query_id, 2, TDataSinkType::DATA_STREAM_SINK);
+    TPlanFragmentDestination destination;
+    destination.fragment_instance_id.__set_hi(query_id.hi);
+    destination.fragment_instance_id.__set_lo(query_id.lo + 1);
+    child.params.destinations.push_back(destination);
+    FragmentCapturer::instance()->capture(child);
+
+    FragmentReplayer replayer(nullptr, config::fragment_capture_dir + "/" + print_id(query_id));
+    ASSERT_TRUE(replayer.init().ok());
+    // the ids are checked before running any fragment
+    FragmentReplayer::Result result;
+    EXPECT_TRUE(replayer.replay(false, 1, &result).is_not_found());
+}
+
+} // namespace doris
@@ -0,0 +1,87 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/load_statistics.h"
+
+#include <gtest/gtest.h>
+
+#include "gen_cpp/internal_service.pb.h"
+#include "util/runtime_profile.h"
+
+namespace doris {
+
+class LoadStatisticsTest : public testing::Test {};
+
+TEST_F(LoadStatisticsTest, merge_and_pb) {
+    LoadStatistics lhs;
+    lhs.mem_limit_wait_ns = 1;
+    lhs.flush_wait_ns = 2;
+    lhs.flush_ns = 3;
+    lhs.flush_count = 1;
+    lhs.flush_bytes = 100;
+    lhs.column_encode_ns["k1"] = 10;
+    lhs.segment_close_ns = 4;
+    lhs.rpc_ns = 5;
+
+    LoadStatistics rhs;
+    rhs.flush_ns = 7;
+    rhs.flush_count = 2;
+    rhs.column_encode_ns["k1"] = 20;
+    rhs.column_encode_ns["v1"] = 30;
+    rhs.segcompaction_ns = 6;
+    rhs.rpc_pending_wait_ns = 8;
+
+    PLoadStatistics pb;
+    rhs.to_pb(&pb);
+    LoadStatistics from_pb;
+    from_pb.from_pb(pb);
+    lhs.merge(from_pb);
+
+    EXPECT_EQ(1, lhs.mem_limit_wait_ns);
+    EXPECT_EQ(2, lhs.flush_wait_ns);
+    EXPECT_EQ(10, lhs.flush_ns);
+    EXPECT_EQ(3, lhs.flush_count);
+    EXPECT_EQ(100, lhs.flush_bytes);
+    EXPECT_EQ(2, lhs.column_encode_ns.size());
+    EXPECT_EQ(30, lhs.column_encode_ns["k1"]);
+    EXPECT_EQ(30, lhs.column_encode_ns["v1"]);
+    EXPECT_EQ(4, lhs.segment_close_ns);
+    EXPECT_EQ(6, lhs.segcompaction_ns);
+    EXPECT_EQ(5, lhs.rpc_ns);
+    EXPECT_EQ(8, lhs.rpc_pending_wait_ns);
+}
+
+TEST_F(LoadStatisticsTest, update_profile) {
+    LoadStatistics statistics;
+    statistics.flush_ns = 3;
+    statistics.column_encode_ns["k1"] = 10;
+    statistics.column_encode_ns["FlushTime"] = 20;
+
+    RuntimeProfile profile("sink");
+    statistics.update_profile(&profile);
+    EXPECT_EQ(3, profile.get_counter("FlushTime")->value());
+    EXPECT_EQ(30, profile.get_counter("ColumnEncodeTime")->value());
+    EXPECT_EQ(10, profile.get_counter("Column:k1")->value());
+    EXPECT_EQ(20, profile.get_counter("Column:FlushTime")->value());
+
+    // the counters are set again when the profile is updated
+    statistics.flush_ns = 5;
+    statistics.update_profile(&profile);
+    EXPECT_EQ(5, profile.get_counter("FlushTime")->value());
+}
+
+} // namespace doris
@@ -0,0 +1,92 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/memory/huge_page_pool.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+#include "vec/common/hash_table/hash_table_allocator.h"
+
+namespace doris {
+
+TEST(HugePagePoolTest, RoundUp) {
+    EXPECT_EQ(HugePagePool::HUGE_PAGE_SIZE, HugePagePool::round_up(1));
+    EXPECT_EQ(HugePagePool::HUGE_PAGE_SIZE, HugePagePool::round_up(HugePagePool::HUGE_PAGE_SIZE));
+    EXPECT_EQ(2 * HugePagePool::HUGE_PAGE_SIZE,
+              HugePagePool::round_up(HugePagePool::HUGE_PAGE_SIZE + 1));
+}
+
+TEST(HugePagePoolTest, AllocateAndReuse) {
+    auto* pool = HugePagePool::instance();
+    pool->clear();
+    size_t size = 3 * (1ULL << 20);
+    bool zeroed = false;
+    void* buf = pool->allocate(size, &zeroed);
+    ASSERT_NE(nullptr, buf);
+    EXPECT_TRUE(zeroed);
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(buf) % HugePagePool::HUGE_PAGE_SIZE);
+    memset(buf, 1, HugePagePool::round_up(size));
+
+    pool->free(buf, size);
+    EXPECT_EQ(HugePagePool::round_up(size), pool->pooled_bytes());
+    // the same rounded size reuses the buffer
+    void* reused = pool->allocate(4 * (1ULL << 20), &zeroed);
+    EXPECT_EQ(buf, reused);
+    EXPECT_FALSE(zeroed);
+    EXPECT_EQ(0, pool->pooled_bytes());
+    pool->free(reused, 4 * (1ULL << 20));
+    pool->clear();
+    EXPECT_EQ(0, pool->pooled_bytes());
+}
+
+TEST(HugePagePoolTest, PoolLimit) {
+    auto* pool = HugePagePool::instance();
+    pool->clear();
+    int64_t max_bytes = config::huge_page_pool_max_bytes;
+    config::huge_page_pool_max_bytes = HugePagePool::HUGE_PAGE_SIZE;
+    bool zeroed = false;
+    void* buf1 = pool->allocate(HugePagePool::HUGE_PAGE_SIZE, &zeroed);
+    void* buf2 = pool->allocate(HugePagePool::HUGE_PAGE_SIZE, &zeroed);
+    pool->free(buf1, HugePagePool::HUGE_PAGE_SIZE);
+    // unmapped since the pool is full
+    pool->free(buf2, HugePagePool::HUGE_PAGE_SIZE);
+    EXPECT_EQ(HugePagePool::HUGE_PAGE_SIZE, pool->pooled_bytes());
+    pool->clear();
+    config::huge_page_pool_max_bytes = max_bytes;
+}
+
+TEST(HugePagePoolTest, HashTableAllocator) {
+    bool madvise_huge_pages = config::madvise_huge_pages;
+    config::madvise_huge_pages = true;
+    HashTableAllocator allocator;
+    size_t size = 8 * (1ULL << 20);
+    auto* buf = reinterpret_cast<char*>(allocator.alloc(size));
+    // cleared and aligned to the huge page
+    EXPECT_EQ(0, buf[0]);
+    EXPECT_EQ(0, buf[size - 1]);
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(buf) % HugePagePool::HUGE_PAGE_SIZE);
+    buf[0] = 1;
+    buf = reinterpret_cast<char*>(allocator.realloc(buf, size, 2 * size));
+    EXPECT_EQ(1, buf[0]);
+    EXPECT_EQ(0, buf[2 * size - 1]);
+    allocator.free(buf, 2 * size);
+    HugePagePool::instance()->clear();
+    config::madvise_huge_pages = madvise_huge_pages;
+}
+
+} // namespace doris
@@ -0,0 +1,75 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/memory/memory_region.h"
+
+#include <gtest/gtest.h>
+
+#include "runtime/memory/mem_tracker_limiter.h"
+#include "vec/common/allocator.h"
+
+namespace doris {
+
+TEST(MemoryRegionTest, Cacheable) {
+    EXPECT_FALSE(MemoryRegion::is_cacheable(256));
+    EXPECT_TRUE(MemoryRegion::is_cacheable(512));
+    EXPECT_FALSE(MemoryRegion::is_cacheable(4000));
+    EXPECT_TRUE(MemoryRegion::is_cacheable(4096));
+    EXPECT_TRUE(MemoryRegion::is_cacheable(32 << 20));
+    EXPECT_FALSE(MemoryRegion::is_cacheable(64 << 20));
+}
+
+TEST(MemoryRegionTest, Reuse) {
+    auto tracker = std::make_shared<MemTrackerLimiter>(MemTrackerLimiter::Type::GLOBAL);
+    MemoryRegion region(tracker, 1 << 20);
+    Allocator<false> allocator;
+    EXPECT_EQ(nullptr, region.allocate(4096));
+
+    void* buf = allocator.alloc(4096);
+    EXPECT_TRUE(region.free(buf, 4096));
+    EXPECT_EQ(4096, region.cached_bytes());
+    // another size class
+    EXPECT_EQ(nullptr, region.allocate(8192));
+    // the buffer may be kept in the shard of another core
+    void* reused = region.allocate(4096);
+    if (reused != nullptr) {
+        EXPECT_EQ(buf, reused);
+        EXPECT_EQ(0, region.cached_bytes());
+        memset(reused, 1, 4096);
+        allocator.free(reused, 4096);
+    }
+    region.release();
+    EXPECT_EQ(0, region.cached_bytes());
+}
+
+TEST(MemoryRegionTest, Capacity) {
+    auto tracker = std::make_shared<MemTrackerLimiter>(MemTrackerLimiter::Type::GLOBAL);
+    MemoryRegion region(tracker, 8192);
+    Allocator<false> allocator;
+    std::vector<void*> bufs;
+    for (int i = 0; i < 3; ++i) {
+        bufs.push_back(allocator.alloc(4096));
+    }
+    EXPECT_TRUE(region.free(bufs[0], 4096));
+    EXPECT_TRUE(region.free(bufs[1], 4096));
+    EXPECT_FALSE(region.free(bufs[2], 4096));
+    EXPECT_EQ(8192, region.cached_bytes());
+    allocator.free(bufs[2], 4096);
+    // the kept buffers are freed with the region
+}
+
+} // namespace doris
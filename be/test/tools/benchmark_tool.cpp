@@ -16,54 +16,106 @@
 // under the License.
 
 #include <benchmark/benchmark.h>
+#include <fcntl.h>
 #include <gflags/gflags.h>
+#include <unistd.h>
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <fstream>
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <queue>
 #include <random>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "agent/be_exec_version_manager.h"
 #include "common/compiler_util.h"
 #include "common/logging.h"
+#include "exprs/create_predicate_function.h"
+#include "gen_cpp/data.pb.h"
+#include "gen_cpp/segment_v2.pb.h"
 #include "gutil/strings/split.h"
 #include "gutil/strings/substitute.h"
 #include "io/fs/file_system.h"
 #include "io/fs/file_writer.h"
 #include "io/fs/local_file_system.h"
+#include "io/fs/remote_file_system.h"
 #include "olap/comparison_predicate.h"
 #include "olap/data_dir.h"
 #include "olap/in_list_predicate.h"
 #include "olap/olap_common.h"
 #include "olap/row_cursor.h"
+#include "olap/rowset/beta_rowset.h"
+#include "olap/rowset/rowset_factory.h"
+#include "olap/rowset/rowset_writer.h"
+#include "olap/rowset/rowset_writer_context.h"
 #include "olap/rowset/segment_v2/binary_dict_page.h"
 #include "olap/rowset/segment_v2/binary_plain_page.h"
 #include "olap/rowset/segment_v2/page_builder.h"
 #include "olap/rowset/segment_v2/page_decoder.h"
 #include "olap/rowset/segment_v2/segment_iterator.h"
 #include "olap/rowset/segment_v2/segment_writer.h"
+#include "olap/segment_loader.h"
+#include "olap/tablet.h"
+#include "olap/tablet_meta.h"
 #include "olap/tablet_schema.h"
 #include "olap/tablet_schema_helper.h"
 #include "olap/types.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "testutil/desc_tbl_builder.h"
+#include "testutil/function_utils.h"
 #include "testutil/test_util.h"
 #include "util/debug_util.h"
+#include "util/runtime_profile.h"
+#include "util/work_stealing_deque.h"
+#include "vec/columns/column_const.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/common/hash_table/hash.h"
+#include "vec/common/hash_table/hash_map.h"
+#include "vec/common/sort/heap_sorter.h"
+#include "vec/common/sort/sorter.h"
+#include "vec/common/sort/topn_sorter.h"
+#include "vec/common/sort/vsort_exec_exprs.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/exec/join/vhash_join_node.h"
+#include "vec/exec/vaggregation_node.h"
+#include "vec/exprs/vexpr_context.h"
+#include "vec/exprs/vslot_ref.h"
+#include "vec/functions/simple_function_factory.h"
+#include "vec/olap/block_reader.h"
 
 DEFINE_string(operation, "Custom",
               "valid operation: Custom, BinaryDictPageEncode, BinaryDictPageDecode, SegmentScan, "
               "SegmentWrite, "
-              "SegmentScanByFile, SegmentWriteByFile");
+              "SegmentScanByFile, SegmentWriteByFile, TaskQueue, ColumnPredicate, "
+              "HashTableProbe, HashJoin, AggregationHashTable, Sort, BlockSerialize, "
+              "ColumnString, Function, StorageRead");
 DEFINE_string(input_file, "./sample.dat", "input file directory");
 DEFINE_string(column_type, "int,varchar", "valid type: int, char, varchar, string");
 DEFINE_string(rows_number, "10000", "rows number");
+DEFINE_string(threads_number, "8", "threads number");
 DEFINE_string(iterations, "10",
               "run times, this is set to 0 means the number of iterations is automatically set ");
+DEFINE_string(cardinality, "100000", "distinct values of the columns of the operator benchmarks");
+DEFINE_string(seed, "0", "seed of the random data of the operator benchmarks");
+DEFINE_string(rowsets_number, "4", "rowsets number of the tablet of StorageRead");
+DEFINE_string(segments_number, "2", "segments number of each rowset of StorageRead");
 
 const std::string kSegmentDir = "./segment_benchmark";
+const std::string kStorageReadDir = "storage_read_benchmark";
 
 std::string get_usage(const std::string& progname) {
     std::stringstream ss;
@@ -84,6 +136,20 @@ std::string get_usage(const std::string& progname) {
           "--iterations=10\n";
     ss << "./benchmark_tool --operation=SegmentWriteByFile --input_file=./sample.dat "
           "--iterations=10\n";
+    ss << "./benchmark_tool --operation=TaskQueue --threads_number=8 "
+          "--rows_number=1000000 --iterations=10\n";
+    ss << "./benchmark_tool --operation=ColumnPredicate --rows_number=4096 --iterations=0\n";
+    ss << "./benchmark_tool --operation=HashTableProbe --rows_number=1000000 --iterations=0\n";
+    ss << "./benchmark_tool --operation=HashJoin --rows_number=1000000 --cardinality=100000 "
+          "--iterations=0\n";
+    ss << "./benchmark_tool --operation=AggregationHashTable --rows_number=1000000 "
+          "--cardinality=100000 --iterations=0\n";
+    ss << "./benchmark_tool --operation=Sort --rows_number=1000000 --iterations=0\n";
+    ss << "./benchmark_tool --operation=BlockSerialize --rows_number=4096 --iterations=0\n";
+    ss << "./benchmark_tool --operation=ColumnString --rows_number=4096 --iterations=0\n";
+    ss << "./benchmark_tool --operation=Function --rows_number=4096 --iterations=0\n";
+    ss << "./benchmark_tool --operation=StorageRead --rows_number=1000000 --rowsets_number=4 "
+          "--segments_number=2 --iterations=10\n";
 
     ss << "Sampe data file format: \n"
        << "The first line defines Shcema\n"
@@ -495,6 +561,335 @@ private:
     OlapReaderStatistics stats;
 };
 
+// A remote file system on a local directory, whose files are read through the file cache of
+// `cache_type` as the ones of S3 are.
+class MockRemoteFileSystem : public io::RemoteFileSystem {
+public:
+    MockRemoteFileSystem(const std::string& root_path, io::FileCachePolicy cache_type)
+            : RemoteFileSystem(root_path, "storage_read_benchmark", io::FileSystemType::S3),
+              _cache_type(cache_type) {}
+
+protected:
+    Status create_file_impl(const io::Path& file, io::FileWriterPtr* writer) override {
+        return _local_fs->create_file(file, writer);
+    }
+    Status open_file_impl(const io::Path& file, const io::FileReaderOptions& reader_options,
+                          io::FileReaderSPtr* reader) override {
+        // config::file_cache_type makes the BE_TEST build open the segments as local files, so
+        // the cache is set up here
+        io::FileReaderOptions cached_options = reader_options;
+        cached_options.cache_type = _cache_type;
+        return RemoteFileSystem::open_file_impl(file, cached_options, reader);
+    }
+    Status open_file_internal(const io::Path& file, int64_t file_size,
+                              io::FileReaderSPtr* reader) override {
+        return _local_fs->open_file(file, reader);
+    }
+    Status create_directory_impl(const io::Path& dir, bool failed_if_exists) override {
+        return _local_fs->create_directory(dir, failed_if_exists);
+    }
+    Status delete_file_impl(const io::Path& file) override { return _local_fs->delete_file(file); }
+    Status batch_delete_impl(const std::vector<io::Path>& files) override {
+        return _local_fs->batch_delete(files);
+    }
+    Status delete_directory_impl(const io::Path& dir) override {
+        return _local_fs->delete_directory(dir);
+    }
+    Status exists_impl(const io::Path& path, bool* res) const override {
+        return _local_fs->exists(path, res);
+    }
+    Status file_size_impl(const io::Path& file, int64_t* file_size) const override {
+        return _local_fs->file_size(file, file_size);
+    }
+    Status list_impl(const io::Path& dir, bool only_file, std::vector<io::FileInfo>* files,
+                     bool* exists) override {
+        return _local_fs->list(dir, only_file, files, exists);
+    }
+    Status rename_impl(const io::Path& orig_name, const io::Path& new_name) override {
+        return _local_fs->rename(orig_name, new_name);
+    }
+    Status rename_dir_impl(const io::Path& orig_name, const io::Path& new_name) override {
+        return _local_fs->rename_dir(orig_name, new_name);
+    }
+    Status connect_impl() override { return Status::OK(); }
+    Status upload_impl(const io::Path& local_file, const io::Path& remote_file) override {
+        return _local_fs->link_file(local_file, remote_file);
+    }
+    Status batch_upload_impl(const std::vector<io::Path>& local_files,
+                             const std::vector<io::Path>& remote_files) override {
+        for (size_t i = 0; i < local_files.size(); ++i) {
+            RETURN_IF_ERROR(upload_impl(local_files[i], remote_files[i]));
+        }
+        return Status::OK();
+    }
+    Status direct_upload_impl(const io::Path& remote_file, const std::string& content) override {
+        return Status::NotSupported("direct upload");
+    }
+    Status upload_with_checksum_impl(const io::Path& local_file, const io::Path& remote_file,
+                                     const std::string& checksum) override {
+        return upload_impl(local_file, remote_file);
+    }
+    Status download_impl(const io::Path& remote_file, const io::Path& local_file) override {
+        return _local_fs->link_file(remote_file, local_file);
+    }
+    Status direct_download_impl(const io::Path& remote_file, std::string* content) override {
+        return Status::NotSupported("direct download");
+    }
+
+private:
+    std::shared_ptr<io::LocalFileSystem> _local_fs = io::global_local_filesystem();
+    io::FileCachePolicy _cache_type;
+};
+
+// Merges the overlapping rowsets of a tablet with BlockReader, whose VCollectIterator merges
+// them by the keys model of the tablet as a query does. The cache modes are:
+//  - cold: the page cache is skipped and the segment files are dropped from the OS cache
+//  - warm: the pages are read from the page cache, which is filled by the first run
+//  - remote: the rowsets are cooled down to a mock S3 and read through the sub file cache
+// The columns are an INT key, a VARCHAR key, a BIGINT value and a low cardinality VARCHAR
+// value, which are written with the default encodings of segment_v2, i.e. bitshuffle for the
+// numbers and dictionary for the strings.
+class StorageReadBenchmark : public BaseBenchmark {
+public:
+    enum CacheMode { COLD, WARM, REMOTE };
+
+    StorageReadBenchmark(const std::string& name, int iterations, KeysType keys_type,
+                         bool enable_mow, CacheMode cache_mode, int rows_number,
+                         int rowsets_number, int segments_number)
+            : BaseBenchmark(name, iterations),
+              _keys_type(keys_type),
+              _enable_mow(enable_mow),
+              _cache_mode(cache_mode),
+              _tablet_id(++_s_next_tablet_id) {
+        const char* keys_names[] = {"DUP", "UNIQUE", "AGG"};
+        const char* cache_names[] = {"cold", "warm", "remote"};
+        add_name(fmt::format("/keys_type:{}/cache:{}/rows_number:{}/rowsets:{}/segments:{}",
+                             enable_mow ? "MOW" : keys_names[keys_type], cache_names[cache_mode],
+                             rows_number, rowsets_number, segments_number));
+        Status st = _build(rows_number, rowsets_number, segments_number);
+        CHECK(st.ok()) << st;
+    }
+    ~StorageReadBenchmark() override {
+        _reader.reset();
+        _tablet.reset();
+        io::global_local_filesystem()->delete_directory(_dir);
+    }
+
+    void init() override {
+        _reader.reset();
+        if (_cache_mode == COLD) {
+            SegmentLoader::instance()->prune_all();
+            for (auto& path : _segment_paths) {
+                int fd = ::open(path.c_str(), O_RDONLY);
+                CHECK_GE(fd, 0) << path;
+                ::fdatasync(fd);
+                ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+                ::close(fd);
+            }
+        }
+        // the rowset readers are used up by a read
+        TabletReader::ReaderParams params;
+        params.tablet = _tablet;
+        params.tablet_schema = _tablet->tablet_schema();
+        params.reader_type = READER_QUERY;
+        params.version = Version(0, _tablet->max_version().second);
+        Status st = _tablet->capture_rs_readers(params.version, &params.rs_readers);
+        CHECK(st.ok()) << st;
+        params.direct_mode = false;
+        params.aggregation = false;
+        params.use_page_cache = _cache_mode == WARM;
+        params.fill_page_cache = _cache_mode == WARM;
+        params.return_columns = _return_columns;
+        params.origin_return_columns = &_return_columns;
+        if (_enable_mow) {
+            params.delete_bitmap = &_tablet->tablet_meta()->delete_bitmap();
+        }
+        _reader = std::make_unique<vectorized::BlockReader>();
+        st = _reader->init(params);
+        CHECK(st.ok()) << st;
+    }
+
+    void run() override {
+        vectorized::Block block = _tablet->tablet_schema()->create_block(_return_columns);
+        bool eof = false;
+        while (!eof) {
+            Status st = _reader->next_block_with_aggregation(&block, &eof);
+            CHECK(st.ok()) << st;
+            benchmark::DoNotOptimize(block.rows());
+            block.clear_column_data();
+        }
+    }
+
+private:
+    Status _build(int rows_number, int rowsets_number, int segments_number) {
+        char cwd[PATH_MAX];
+        if (getcwd(cwd, sizeof(cwd)) == nullptr) {
+            return Status::IOError("failed to get the current directory");
+        }
+        _dir = fmt::format("{}/{}/{}", cwd, kStorageReadDir, _tablet_id);
+        std::string tablet_path = _dir + "/tablet";
+        RETURN_IF_ERROR(io::global_local_filesystem()->delete_and_create_directory(_dir));
+        RETURN_IF_ERROR(io::global_local_filesystem()->create_directory(tablet_path));
+        io::RemoteFileSystemSPtr remote_fs;
+        if (_cache_mode == REMOTE) {
+            remote_fs = std::make_shared<MockRemoteFileSystem>(_dir + "/remote",
+                                                               io::FileCachePolicy::SUB_FILE_CACHE);
+            RETURN_IF_ERROR(remote_fs->create_directory(remote_tablet_path(_tablet_id)));
+        }
+        _create_tablet(tablet_path);
+
+        // every rowset has about a half of the keys, so the rowsets overlap each other
+        std::mt19937_64 rng(_tablet_id);
+        int rows_per_rowset = std::max(1, rows_number / rowsets_number);
+        int max_rows_per_segment = std::max(1, rows_per_rowset / segments_number);
+        for (int version = 0; version < rowsets_number; ++version) {
+            RowsetWriterContext context;
+            context.rowset_id.init(++_s_next_rowset_id);
+            context.tablet_id = _tablet_id;
+            context.tablet_schema_hash = _tablet->schema_hash();
+            context.tablet_uid = _tablet->tablet_uid();
+            context.rowset_type = BETA_ROWSET;
+            context.rowset_state = VISIBLE;
+            context.rowset_dir = tablet_path;
+            context.tablet_schema = _tablet->tablet_schema();
+            context.version = Version(version, version);
+            context.segments_overlap = NONOVERLAPPING;
+            context.max_rows_per_segment = max_rows_per_segment;
+            context.enable_unique_key_merge_on_write = _enable_mow;
+            std::unique_ptr<RowsetWriter> writer;
+            RETURN_IF_ERROR(RowsetFactory::create_rowset_writer(context, false, &writer));
+
+            vectorized::Block block = _tablet->tablet_schema()->create_block();
+            auto columns = block.mutate_columns();
+            for (int32_t key = 0; key < rows_per_rowset * 2; ++key) {
+                if (rng() % 2 != 0) {
+                    continue;
+                }
+                std::string key_str = fmt::format("key_{:08}", rng() % 100000000);
+                auto value = static_cast<int64_t>(rng());
+                std::string value_str = fmt::format("value_{}", rng() % 64);
+                int8_t delete_sign = 0;
+                columns[0]->insert_data(reinterpret_cast<const char*>(&key), sizeof(key));
+                columns[1]->insert_data(key_str.data(), key_str.size());
+                columns[2]->insert_data(reinterpret_cast<const char*>(&value), sizeof(value));
+                columns[3]->insert_data(value_str.data(), value_str.size());
+                if (columns.size() > 4) {
+                    columns[4]->insert_data(reinterpret_cast<const char*>(&delete_sign),
+                                            sizeof(delete_sign));
+                }
+            }
+            RETURN_IF_ERROR(writer->add_block(&block));
+            RETURN_IF_ERROR(writer->flush());
+            RowsetSharedPtr rowset = writer->build();
+            if (rowset == nullptr) {
+                return Status::InternalError("failed to build rowset {}", version);
+            }
+            if (remote_fs != nullptr) {
+                RETURN_IF_ERROR(_cooldown(remote_fs, tablet_path, &rowset));
+            } else {
+                for (int i = 0; i < rowset->num_segments(); ++i) {
+                    _segment_paths.push_back(BetaRowset::segment_file_path(
+                            tablet_path, rowset->rowset_id(), i));
+                }
+            }
+            RETURN_IF_ERROR(_tablet->add_rowset(rowset));
+            if (_enable_mow) {
+                RETURN_IF_ERROR(_tablet->update_delete_bitmap_without_lock(rowset));
+            }
+        }
+        // the hidden delete sign is not returned to the query
+        for (uint32_t i = 0; i < _tablet->tablet_schema()->num_columns(); ++i) {
+            if (static_cast<int32_t>(i) != _tablet->tablet_schema()->delete_sign_idx()) {
+                _return_columns.push_back(i);
+            }
+        }
+        return Status::OK();
+    }
+
+    void _create_tablet(const std::string& tablet_path) {
+        auto make_column = [](const std::string& name, TPrimitiveType::type type, int32_t len,
+                              bool is_key, TAggregationType::type aggregation) {
+            TColumn column;
+            column.__set_column_name(name);
+            column.column_type.__set_type(type);
+            column.column_type.__set_len(len);
+            column.__set_is_key(is_key);
+            column.__set_aggregation_type(aggregation);
+            column.__set_is_allow_null(false);
+            return column;
+        };
+        TAggregationType::type number_aggregation = TAggregationType::NONE;
+        TAggregationType::type string_aggregation = TAggregationType::NONE;
+        TTabletSchema schema;
+        schema.__set_short_key_column_count(2);
+        schema.__set_schema_hash(_tablet_id);
+        schema.__set_storage_type(TStorageType::COLUMN);
+        if (_keys_type == DUP_KEYS) {
+            schema.__set_keys_type(TKeysType::DUP_KEYS);
+        } else if (_keys_type == UNIQUE_KEYS) {
+            schema.__set_keys_type(TKeysType::UNIQUE_KEYS);
+            number_aggregation = TAggregationType::REPLACE;
+            string_aggregation = TAggregationType::REPLACE;
+        } else {
+            schema.__set_keys_type(TKeysType::AGG_KEYS);
+            number_aggregation = TAggregationType::SUM;
+            string_aggregation = TAggregationType::REPLACE;
+        }
+        std::vector<TColumn> columns;
+        columns.push_back(make_column("k1", TPrimitiveType::INT, 4, true, TAggregationType::NONE));
+        columns.push_back(
+                make_column("k2", TPrimitiveType::VARCHAR, 32, true, TAggregationType::NONE));
+        columns.push_back(make_column("v1", TPrimitiveType::BIGINT, 8, false, number_aggregation));
+        columns.push_back(
+                make_column("v2", TPrimitiveType::VARCHAR, 32, false, string_aggregation));
+        if (_keys_type == UNIQUE_KEYS) {
+            schema.__set_delete_sign_idx(columns.size());
+            columns.push_back(make_column(DELETE_SIGN, TPrimitiveType::TINYINT, 1, false,
+                                          TAggregationType::REPLACE));
+        }
+        schema.__set_columns(columns);
+        std::unordered_map<uint32_t, uint32_t> col_ordinal_to_unique_id;
+        for (uint32_t i = 0; i < columns.size(); ++i) {
+            col_ordinal_to_unique_id[i] = i;
+        }
+
+        TabletMetaSharedPtr tablet_meta(new TabletMeta(
+                1, 1, _tablet_id, 1, _tablet_id, 1, schema, columns.size(),
+                col_ordinal_to_unique_id, UniqueId(1, _tablet_id), TTabletType::TABLET_TYPE_DISK,
+                TCompressionType::LZ4F, 0, _enable_mow));
+        _tablet.reset(new Tablet(tablet_meta, nullptr));
+        _tablet->init();
+        // the file cache of the remote rowsets is under the tablet path
+        _tablet->_tablet_path = tablet_path;
+    }
+
+    // Replaces `rowset` with its copy on `remote_fs`, as Tablet::_cooldown_data does.
+    Status _cooldown(const io::RemoteFileSystemSPtr& remote_fs, const std::string& tablet_path,
+                     RowsetSharedPtr* rowset) {
+        RowsetId remote_rowset_id;
+        remote_rowset_id.init(++_s_next_rowset_id);
+        RETURN_IF_ERROR((*rowset)->upload_to(remote_fs.get(), remote_rowset_id, nullptr));
+        auto rowset_meta = std::make_shared<RowsetMeta>(*(*rowset)->rowset_meta());
+        rowset_meta->set_rowset_id(remote_rowset_id);
+        rowset_meta->set_fs(remote_fs);
+        return RowsetFactory::create_rowset(_tablet->tablet_schema(), tablet_path, rowset_meta,
+                                            rowset);
+    }
+
+    static inline int64_t _s_next_tablet_id = 0;
+    static inline int64_t _s_next_rowset_id = 0;
+
+    KeysType _keys_type;
+    bool _enable_mow;
+    CacheMode _cache_mode;
+    int64_t _tablet_id;
+    std::string _dir;
+    TabletSharedPtr _tablet;
+    std::vector<std::string> _segment_paths;
+    std::vector<uint32_t> _return_columns;
+    std::unique_ptr<vectorized::BlockReader> _reader;
+};
+
 // This is sample custom test. User can write custom test code at custom_init()&custom_run().
 // Call method: ./benchmark_tool --operation=Custom
 class CustomBenchmark : public BaseBenchmark {
@@ -529,6 +924,979 @@ void custom_run_mod() {
     }
 }
 
+// Simulate the pipeline workers: each worker takes a task from its own queue, runs it
+// and pushes it back, and steals from the other queues when its own queue is empty.
+// Compare the mutex protected std::queue, which pipeline SubWorkTaskQueue used to be,
+// with WorkStealingDeque.
+// Call method: ./benchmark_tool --operation=TaskQueue --threads_number=8 --rows_number=1000000
+template <typename Queue>
+class TaskQueueBenchmark : public BaseBenchmark {
+public:
+    TaskQueueBenchmark(const std::string& name, int iterations, int threads_number,
+                       int task_runs)
+            : BaseBenchmark(name, iterations),
+              _threads_number(threads_number),
+              _task_runs(task_runs),
+              _tasks(threads_number * 4) {}
+
+    void init() override {
+        _queues.clear();
+        for (int i = 0; i < _threads_number; ++i) {
+            _queues.emplace_back(new Queue());
+        }
+        for (size_t i = 0; i < _tasks.size(); ++i) {
+            _queues[i % _threads_number]->push(&_tasks[i]);
+        }
+        _left_runs = _task_runs;
+    }
+
+    void run() override {
+        std::vector<std::thread> workers;
+        for (int i = 0; i < _threads_number; ++i) {
+            workers.emplace_back([this, i]() {
+                while (_left_runs > 0) {
+                    int* task = _queues[i]->take();
+                    for (int j = 1; task == nullptr && j < _threads_number; ++j) {
+                        task = _queues[(i + j) % _threads_number]->take();
+                    }
+                    if (task == nullptr) {
+                        continue;
+                    }
+                    ++*task;
+                    _left_runs--;
+                    _queues[i]->push(task);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+private:
+    int _threads_number;
+    int _task_runs;
+    std::vector<int> _tasks;
+    std::vector<std::unique_ptr<Queue>> _queues;
+    std::atomic<int64_t> _left_runs = 0;
+};
+
+struct MutexTaskQueue {
+    void push(int* task) {
+        std::unique_lock<std::mutex> lock(mutex);
+        queue.push(task);
+    }
+    int* take() {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (queue.empty()) {
+            return nullptr;
+        }
+        auto* task = queue.front();
+        queue.pop();
+        return task;
+    }
+    std::mutex mutex;
+    std::queue<int*> queue;
+};
+
+struct WorkStealingTaskQueue {
+    void push(int* task) { deque.push(task); }
+    int* take() { return deque.steal(); }
+    WorkStealingDeque<int> deque;
+};
+
+// Evaluate a comparison predicate and an in list predicate on an int column with a sel.
+// The sel of step 1 and 2 are dense and evaluated by SIMD, the sel of step 3 is sparse and
+// evaluated row by row.
+// Call method: ./benchmark_tool --operation=ColumnPredicate --rows_number=4096
+class ColumnPredicateBenchmark : public BaseBenchmark {
+public:
+    ColumnPredicateBenchmark(const std::string& name, int iterations, int rows_number, int step)
+            : BaseBenchmark(name, iterations), _rows_number(std::min(rows_number, 65535)) {
+        add_name("/step:" + std::to_string(step));
+        _column = vectorized::PredicateColumnType<TYPE_INT>::create();
+        std::mt19937 rng(0);
+        for (int i = 0; i < _rows_number; ++i) {
+            int value = rng() % 100;
+            _column->insert_data((char*)&value, 0);
+        }
+        for (int i = 0; i < _rows_number; i += step) {
+            _row_ids.push_back(i);
+        }
+        _comparison_pred.reset(new ComparisonPredicateBase<TYPE_INT, PredicateType::LT>(0, 50));
+        std::shared_ptr<HybridSetBase> set(create_set(TYPE_INT));
+        for (int value : {1, 3, 5, 7, 11, 13, 17, 19}) {
+            set->insert(&value);
+        }
+        _in_list_pred.reset(create_in_list_predicate<TYPE_INT, PredicateType::IN_LIST>(0, set));
+    }
+
+    void init() override { _sel = _row_ids; }
+
+    void run() override {
+        // evaluate 1000 times, to make the time measurable
+        uint16_t size = 0;
+        for (int i = 0; i < 1000; ++i) {
+            memcpy(_sel.data(), _row_ids.data(), _row_ids.size() * sizeof(uint16_t));
+            size = _comparison_pred->evaluate(*_column, _sel.data(), _row_ids.size());
+            size = _in_list_pred->evaluate(*_column, _sel.data(), size);
+        }
+        benchmark::DoNotOptimize(size);
+    }
+
+private:
+    int _rows_number;
+    vectorized::MutableColumnPtr _column;
+    std::vector<uint16_t> _row_ids;
+    std::vector<uint16_t> _sel;
+    std::unique_ptr<ColumnPredicate> _comparison_pred;
+    std::unique_ptr<ColumnPredicate> _in_list_pred;
+};
+
+// Probe a hash table of table_size keys with batches of 4096 random keys, like the probe
+// loop of hash join: hash the whole batch first, then find each row by its hash, with or
+// without prefetching the bucket of the row PREFETCH_STEP rows ahead.
+// Call method: ./benchmark_tool --operation=HashTableProbe --rows_number=1000000
+template <bool prefetch>
+class HashTableProbeBenchmark : public BaseBenchmark {
+public:
+    HashTableProbeBenchmark(const std::string& name, int iterations, int probe_rows,
+                            size_t table_size)
+            : BaseBenchmark(name, iterations), _probe_keys(probe_rows) {
+        add_name(std::string(prefetch ? "/prefetch" : "/no_prefetch") +
+                 "/table_size:" + std::to_string(table_size));
+        std::mt19937_64 rng(0);
+        for (size_t i = 0; i < table_size; ++i) {
+            Table::LookupResult it;
+            bool inserted;
+            _hash_table.emplace(rng() % (table_size * 2), it, inserted);
+            if (inserted) {
+                it->get_second() = i;
+            }
+        }
+        for (auto& key : _probe_keys) {
+            key = rng() % (table_size * 2);
+        }
+    }
+
+    void run() override {
+        constexpr size_t BATCH_SIZE = 4096;
+        constexpr size_t PREFETCH_STEP = 64;
+        size_t hash_values[BATCH_SIZE];
+        uint64_t sum = 0;
+        for (size_t start = 0; start < _probe_keys.size(); start += BATCH_SIZE) {
+            size_t rows = std::min(BATCH_SIZE, _probe_keys.size() - start);
+            const uint64_t* keys = _probe_keys.data() + start;
+            for (size_t i = 0; i < rows; ++i) {
+                hash_values[i] = _hash_table.hash(keys[i]);
+            }
+            for (size_t i = 0; i < rows; ++i) {
+                if constexpr (prefetch) {
+                    if (i + PREFETCH_STEP < rows) {
+                        _hash_table.prefetch_by_hash<true>(hash_values[i + PREFETCH_STEP]);
+                    }
+                }
+                auto it = _hash_table.find(keys[i], hash_values[i]);
+                if (it != nullptr) {
+                    sum += it->get_second();
+                }
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+private:
+    using Table = HashMap<uint64_t, uint64_t, HashCRC32<uint64_t>>;
+    Table _hash_table;
+    std::vector<uint64_t> _probe_keys;
+};
+
+namespace vectorized {
+
+// The rows of a block of the operator benchmarks, like the batch size of a query.
+static constexpr size_t BENCHMARK_BATCH_SIZE = 4096;
+
+// Generates the columns of random values for the operator benchmarks. The values only depend on
+// the seed, so the runs of a benchmark on the same seed are comparable. The columns are made of
+// the ids of the rows, so that the columns of the same ids make the keys of the same cardinality
+// as the ids.
+class SyntheticData {
+public:
+    explicit SyntheticData(uint64_t seed) : _rng(seed) {}
+
+    // `rows` ids of `cardinality` distinct values.
+    std::vector<uint64_t> ids(size_t rows, size_t cardinality) {
+        std::vector<uint64_t> ids(rows);
+        for (auto& id : ids) {
+            id = _rng() % cardinality;
+        }
+        return ids;
+    }
+
+    template <typename T>
+    static ColumnWithTypeAndName numbers(const std::vector<uint64_t>& ids) {
+        auto column = ColumnVector<T>::create(ids.size());
+        auto& data = column->get_data();
+        for (size_t i = 0; i < ids.size(); ++i) {
+            data[i] = static_cast<T>(ids[i]);
+        }
+        return {std::move(column), std::make_shared<DataTypeNumber<T>>(), ""};
+    }
+
+    // The strings of the digits of the ids, padded by letters to 1 to `max_length` characters.
+    static ColumnWithTypeAndName strings(const std::vector<uint64_t>& ids, size_t max_length) {
+        auto column = ColumnString::create();
+        std::string value;
+        for (auto id : ids) {
+            uint64_t hash = (id + 1) * 0x9E3779B97F4A7C15ULL;
+            size_t length = 1 + hash % max_length;
+            value = std::to_string(id);
+            while (value.size() < length) {
+                hash = hash * 6364136223846793005ULL + 1442695040888963407ULL;
+                value += static_cast<char>('a' + (hash >> 32) % 26);
+            }
+            column->insert_data(value.data(), value.size());
+        }
+        return {std::move(column), std::make_shared<DataTypeString>(), ""};
+    }
+
+    // Makes `null_percent` percent of the rows of `column` null.
+    ColumnWithTypeAndName nullable(const ColumnWithTypeAndName& column, int null_percent) {
+        auto null_map = ColumnUInt8::create(column.column->size());
+        for (auto& is_null : null_map->get_data()) {
+            is_null = _rng() % 100 < null_percent;
+        }
+        return {ColumnNullable::create(column.column, std::move(null_map)),
+                make_nullable(column.type), column.name};
+    }
+
+    uint64_t next() { return _rng(); }
+
+private:
+    std::mt19937_64 _rng;
+};
+
+using ColumnsMaker = std::function<ColumnsWithTypeAndName(SyntheticData* data, size_t rows)>;
+
+// The blocks of `rows` rows in total made by `maker`.
+std::vector<ColumnsWithTypeAndName> make_blocks(const ColumnsMaker& maker, size_t rows,
+                                                size_t block_rows, uint64_t seed) {
+    SyntheticData data(seed);
+    std::vector<ColumnsWithTypeAndName> blocks;
+    for (size_t start = 0; start < rows; start += block_rows) {
+        blocks.push_back(maker(&data, std::min(block_rows, rows - start)));
+    }
+    return blocks;
+}
+
+ColumnRawPtrs raw_columns(const ColumnsWithTypeAndName& columns) {
+    ColumnRawPtrs raw_ptrs;
+    for (const auto& column : columns) {
+        raw_ptrs.push_back(column.column.get());
+    }
+    return raw_ptrs;
+}
+
+// The key sizes of the fixed keys, the sizes of the nested values of the nullable keys.
+Sizes key_sizes(const ColumnsWithTypeAndName& columns) {
+    Sizes sizes;
+    for (const auto& column : columns) {
+        auto type = remove_nullable(column.type);
+        sizes.push_back(type->have_maximum_size_of_value()
+                                ? type->get_maximum_size_of_value_in_memory()
+                                : 0);
+    }
+    return sizes;
+}
+
+// Build the hash table of a join on the build keys like ProcessHashTableBuild, or probe it by
+// the blocks of the probe keys like ProcessHashTableProbe, with a hash table context of
+// HashJoinNode. The build keys are in one block, as the build side of a join is merged into one
+// block before the build.
+// Call method: ./benchmark_tool --operation=HashJoin --rows_number=1000000 --cardinality=100000
+template <typename HashTableContext>
+class HashJoinBenchmark : public BaseBenchmark {
+public:
+    HashJoinBenchmark(const std::string& name, int iterations, bool probe,
+                      const ColumnsWithTypeAndName& build_keys,
+                      const std::vector<ColumnsWithTypeAndName>& probe_blocks)
+            : BaseBenchmark(name, iterations),
+              _probe(probe),
+              _build_keys(build_keys),
+              _probe_blocks(probe_blocks),
+              _key_sizes(key_sizes(build_keys)) {
+        add_name(probe ? "/probe" : "/build");
+        if (_probe) {
+            _reset();
+            _build();
+        }
+    }
+
+    void init() override {
+        if (!_probe) {
+            _reset();
+        }
+    }
+
+    void run() override {
+        if (_probe) {
+            _probe_blocks_by_hash();
+        } else {
+            _build();
+        }
+    }
+
+private:
+    using KeyGetter = typename HashTableContext::State;
+    using Mapped = typename HashTableContext::Mapped;
+    static constexpr bool pre_serialized =
+            ColumnsHashing::IsPreSerializedKeysHashMethodTraits<KeyGetter>::value;
+    static constexpr int PREFETCH_STEP = HashJoinNode::PREFETCH_STEP;
+
+    void _reset() {
+        _ctx.reset(new HashTableContext());
+        _arena.reset(new Arena());
+    }
+
+    size_t _hash(KeyGetter& key_getter, size_t row, Arena& arena) {
+        if constexpr (pre_serialized) {
+            return _ctx->hash_table.hash(key_getter.get_key_holder(row, arena).key);
+        } else {
+            return _ctx->hash_table.hash(key_getter.get_key_holder(row, arena));
+        }
+    }
+
+    void _build() {
+        auto key_columns = raw_columns(_build_keys);
+        size_t rows = key_columns[0]->size();
+        KeyGetter key_getter(key_columns, _key_sizes, nullptr);
+        if constexpr (pre_serialized) {
+            _ctx->serialize_keys(key_columns, rows);
+            key_getter.set_serialized_keys(_ctx->keys.data());
+        }
+        auto& hash_table = _ctx->hash_table;
+        hash_table.expanse_for_add_elem(rows);
+
+        _hash_values.resize(rows);
+        for (size_t k = 0; k < rows; ++k) {
+            _hash_values[k] = _hash(key_getter, k, *_arena);
+        }
+        for (size_t k = 0; k < rows; ++k) {
+            auto emplace_result = key_getter.emplace_key(hash_table, _hash_values[k], k, *_arena);
+            if (k + PREFETCH_STEP < rows) {
+                key_getter.template prefetch_by_hash<false>(hash_table,
+                                                            _hash_values[k + PREFETCH_STEP]);
+            }
+            if (emplace_result.is_inserted()) {
+                new (&emplace_result.get_mapped()) Mapped({k, 0});
+            } else {
+                emplace_result.get_mapped().insert({k, 0}, *_arena);
+            }
+        }
+    }
+
+    void _probe_blocks_by_hash() {
+        auto& hash_table = _ctx->hash_table;
+        std::vector<StringRef> probe_keys;
+        std::unique_ptr<Arena> probe_arena(new Arena());
+        size_t matched_rows = 0;
+        for (const auto& block : _probe_blocks) {
+            auto key_columns = raw_columns(block);
+            size_t rows = key_columns[0]->size();
+            KeyGetter key_getter(key_columns, _key_sizes, nullptr);
+            if constexpr (pre_serialized) {
+                probe_arena.reset(new Arena());
+                probe_keys.resize(rows);
+                for (size_t i = 0; i < rows; ++i) {
+                    probe_keys[i] = serialize_keys_to_pool_contiguous(i, key_columns.size(),
+                                                                      key_columns, *probe_arena);
+                }
+                key_getter.set_serialized_keys(probe_keys.data());
+            }
+
+            _hash_values.resize(rows);
+            for (size_t k = 0; k < rows; ++k) {
+                _hash_values[k] = _hash(key_getter, k, *probe_arena);
+            }
+            for (size_t k = 0; k < rows; ++k) {
+                if (k + PREFETCH_STEP < rows) {
+                    key_getter.template prefetch_by_hash<true>(hash_table,
+                                                               _hash_values[k + PREFETCH_STEP]);
+                }
+                auto find_result = key_getter.find_key_with_hash(hash_table, _hash_values[k], k,
+                                                                 *probe_arena);
+                if (find_result.is_found()) {
+                    matched_rows += find_result.get_mapped().get_row_count();
+                }
+            }
+        }
+        benchmark::DoNotOptimize(matched_rows);
+    }
+
+    bool _probe;
+    ColumnsWithTypeAndName _build_keys;
+    std::vector<ColumnsWithTypeAndName> _probe_blocks;
+    Sizes _key_sizes;
+    std::unique_ptr<HashTableContext> _ctx;
+    std::unique_ptr<Arena> _arena;
+    std::vector<size_t> _hash_values;
+};
+
+// Emplace the blocks of keys into the hash table of a type of AggregatedDataVariants like
+// AggregationNode::_emplace_into_hash_table, with a place of 8 bytes for the aggregate states of
+// each key.
+// Call method: ./benchmark_tool --operation=AggregationHashTable --rows_number=1000000
+class AggregationHashTableBenchmark : public BaseBenchmark {
+public:
+    AggregationHashTableBenchmark(const std::string& name, int iterations,
+                                  AggregatedDataVariants::Type type, bool is_nullable,
+                                  bool partitioned,
+                                  const std::vector<ColumnsWithTypeAndName>& blocks)
+            : BaseBenchmark(name, iterations),
+              _type(type),
+              _is_nullable(is_nullable),
+              _partitioned(partitioned),
+              _blocks(blocks),
+              _key_sizes(key_sizes(blocks[0])) {
+        if (_is_nullable) {
+            add_name("/nullable");
+        }
+        if (_partitioned) {
+            add_name("/partitioned");
+        }
+    }
+
+    void init() override {
+        _agg_data.reset(new AggregatedDataVariants());
+        _agg_data->set_enable_partitioned_hash_table(_partitioned);
+        _agg_data->init(_type, _is_nullable);
+        _arena.reset(new Arena());
+    }
+
+    void run() override {
+        for (const auto& block : _blocks) {
+            auto key_columns = raw_columns(block);
+            _emplace_into_hash_table(key_columns, key_columns[0]->size());
+        }
+    }
+
+private:
+    static constexpr size_t PLACE_SIZE = 8;
+    // the same as AggregationNode
+    static constexpr size_t HASH_MAP_PREFETCH_DIST = 16;
+
+    void _emplace_into_hash_table(ColumnRawPtrs& key_columns, size_t num_rows) {
+        std::visit(
+                [&](auto&& agg_method) -> void {
+                    using HashMethodType = std::decay_t<decltype(agg_method)>;
+                    using HashTableType = std::decay_t<decltype(agg_method.data)>;
+                    using AggState = typename HashMethodType::State;
+                    AggState state(key_columns, _key_sizes, nullptr);
+                    if constexpr (ColumnsHashing::IsPreSerializedKeysHashMethodTraits<
+                                          AggState>::value) {
+                        agg_method.serialize_keys(key_columns, num_rows);
+                        state.set_serialized_keys(agg_method.keys.data());
+                    }
+
+                    if constexpr (HashTableTraits<HashTableType>::is_phmap) {
+                        _hash_values.resize(num_rows);
+                        for (size_t i = 0; i < num_rows; ++i) {
+                            if constexpr (ColumnsHashing::IsPreSerializedKeysHashMethodTraits<
+                                                  AggState>::value) {
+                                _hash_values[i] = agg_method.data.hash(agg_method.keys[i]);
+                            } else {
+                                _hash_values[i] =
+                                        agg_method.data.hash(state.get_key_holder(i, *_arena));
+                            }
+                        }
+                    }
+
+                    auto creator = [this](const auto& ctor, const auto& key) {
+                        ctor(key, _arena->aligned_alloc(PLACE_SIZE, PLACE_SIZE));
+                    };
+                    auto creator_for_null_key = [this](auto& mapped) {
+                        mapped = _arena->aligned_alloc(PLACE_SIZE, PLACE_SIZE);
+                    };
+
+                    AggregateDataPtr mapped = nullptr;
+                    for (size_t i = 0; i < num_rows; ++i) {
+                        if constexpr (HashTableTraits<HashTableType>::is_phmap) {
+                            if (LIKELY(i + HASH_MAP_PREFETCH_DIST < num_rows)) {
+                                agg_method.data.prefetch_by_hash(
+                                        _hash_values[i + HASH_MAP_PREFETCH_DIST]);
+                            }
+                            if constexpr (ColumnsHashing::IsSingleNullableColumnMethod<
+                                                  AggState>::value) {
+                                mapped = state.lazy_emplace_key(agg_method.data, i, *_arena,
+                                                                _hash_values[i], creator,
+                                                                creator_for_null_key);
+                            } else {
+                                mapped = state.lazy_emplace_key(agg_method.data, _hash_values[i],
+                                                                i, *_arena, creator);
+                            }
+                        } else {
+                            if constexpr (ColumnsHashing::IsSingleNullableColumnMethod<
+                                                  AggState>::value) {
+                                mapped = state.lazy_emplace_key(agg_method.data, i, *_arena,
+                                                                creator, creator_for_null_key);
+                            } else {
+                                mapped = state.lazy_emplace_key(agg_method.data, i, *_arena,
+                                                                creator);
+                            }
+                        }
+                    }
+                    benchmark::DoNotOptimize(mapped);
+                },
+                _agg_data->_aggregated_method_variant);
+    }
+
+    AggregatedDataVariants::Type _type;
+    bool _is_nullable;
+    bool _partitioned;
+    std::vector<ColumnsWithTypeAndName> _blocks;
+    Sizes _key_sizes;
+    std::unique_ptr<AggregatedDataVariants> _agg_data;
+    std::unique_ptr<Arena> _arena;
+    std::vector<size_t> _hash_values;
+};
+
+// Sort the blocks of a nullable bigint column and a nullable string column by both columns with
+// a FullSorter, a TopNSorter or a HeapSorter, and read the sorted rows, like VSortNode.
+// Call method: ./benchmark_tool --operation=Sort --rows_number=1000000
+template <typename SorterType>
+class SortBenchmark : public BaseBenchmark {
+public:
+    SortBenchmark(const std::string& name, int iterations, int limit,
+                  const std::vector<ColumnsWithTypeAndName>& blocks)
+            : BaseBenchmark(name, iterations), _limit(limit), _blocks(blocks) {
+        add_name("/limit:" + std::to_string(limit));
+        DescriptorTblBuilder builder(&_pool);
+        builder.declare_tuple() << TYPE_BIGINT << TYPE_STRING;
+        DescriptorTbl* desc_tbl = builder.build();
+        auto* tuple_desc = const_cast<TupleDescriptor*>(desc_tbl->get_tuple_descriptor(0));
+        _row_desc.reset(new RowDescriptor(tuple_desc, false));
+
+        std::vector<VExprContext*> ordering_expr_ctxs;
+        for (int i = 0; i < tuple_desc->slots().size(); ++i) {
+            auto* slot_ref = _pool.add(new VSlotRef(tuple_desc->slots()[i]));
+            slot_ref->_column_id = i;
+            ordering_expr_ctxs.push_back(_pool.add(new VExprContext(slot_ref)));
+        }
+        _sort_exprs.init(ordering_expr_ctxs, ordering_expr_ctxs);
+        _sort_exprs._materialize_tuple = false;
+        _is_asc_order = {true, false};
+        _nulls_first = {false, true};
+    }
+
+    void init() override {
+        // the sorter clears the appended blocks, so sort the copies of them
+        _input_blocks.clear();
+        for (const auto& columns : _blocks) {
+            Block block;
+            for (const auto& column : columns) {
+                block.insert({column.column->clone_resized(column.column->size()), column.type,
+                              column.name});
+            }
+            _input_blocks.push_back(std::move(block));
+        }
+        _sorter_pool.reset(new ObjectPool());
+        _profile.reset(new RuntimeProfile("SortBenchmark"));
+        if constexpr (std::is_same_v<SorterType, HeapSorter>) {
+            _sorter.reset(new HeapSorter(_sort_exprs, _limit, 0, _sorter_pool.get(),
+                                         _is_asc_order, _nulls_first, *_row_desc));
+        } else {
+            _sorter.reset(new SorterType(_sort_exprs, _limit, 0, _sorter_pool.get(),
+                                         _is_asc_order, _nulls_first, *_row_desc, &_state,
+                                         _profile.get()));
+        }
+        _sorter->init_profile(_profile.get());
+    }
+
+    void run() override {
+        for (auto& block : _input_blocks) {
+            CHECK(_sorter->append_block(&block).ok());
+        }
+        CHECK(_sorter->prepare_for_read().ok());
+        size_t rows = 0;
+        bool eos = false;
+        while (!eos) {
+            Block block;
+            CHECK(_sorter->get_next(&_state, &block, &eos).ok());
+            rows += block.rows();
+        }
+        benchmark::DoNotOptimize(rows);
+    }
+
+private:
+    int _limit;
+    std::vector<ColumnsWithTypeAndName> _blocks;
+    ObjectPool _pool;
+    RuntimeState _state;
+    std::unique_ptr<RowDescriptor> _row_desc;
+    VSortExecExprs _sort_exprs;
+    std::vector<bool> _is_asc_order;
+    std::vector<bool> _nulls_first;
+    std::vector<Block> _input_blocks;
+    std::unique_ptr<ObjectPool> _sorter_pool;
+    std::unique_ptr<RuntimeProfile> _profile;
+    std::unique_ptr<Sorter> _sorter;
+};
+
+// Serialize a block to PBlock with a compression type, or deserialize the PBlock into a block
+// whose columns are reused, like the senders and the receivers of the data streams.
+// Call method: ./benchmark_tool --operation=BlockSerialize --rows_number=4096
+class BlockSerializeBenchmark : public BaseBenchmark {
+public:
+    BlockSerializeBenchmark(const std::string& name, int iterations, bool deserialize,
+                            segment_v2::CompressionTypePB compression_type,
+                            const ColumnsWithTypeAndName& columns)
+            : BaseBenchmark(name, iterations),
+              _deserialize(deserialize),
+              _compression_type(compression_type),
+              _block(columns) {
+        add_name(std::string(deserialize ? "/deserialize/" : "/serialize/") +
+                 segment_v2::CompressionTypePB_Name(compression_type));
+        _serialize();
+    }
+
+    void run() override {
+        if (_deserialize) {
+            _output.deserialize(_pblock);
+        } else {
+            _serialize();
+        }
+    }
+
+private:
+    void _serialize() {
+        _pblock.Clear();
+        size_t uncompressed_bytes = 0;
+        size_t compressed_bytes = 0;
+        CHECK(_block.serialize(BeExecVersionManager::get_newest_version(), &_pblock,
+                               &uncompressed_bytes, &compressed_bytes, _compression_type, true)
+                      .ok());
+        benchmark::DoNotOptimize(compressed_bytes);
+    }
+
+    bool _deserialize;
+    segment_v2::CompressionTypePB _compression_type;
+    Block _block;
+    PBlock _pblock;
+    Block _output;
+};
+
+// Filter a string column by the filters of a selectivity, or replicate every row of it by 0 to
+// `max_count` times, like the output of the probe of hash join.
+// Call method: ./benchmark_tool --operation=ColumnString --rows_number=4096
+class ColumnStringBenchmark : public BaseBenchmark {
+public:
+    ColumnStringBenchmark(const std::string& name, int iterations, bool replicate, int param,
+                          const ColumnWithTypeAndName& column, SyntheticData* data)
+            : BaseBenchmark(name, iterations), _replicate(replicate), _column(column.column) {
+        size_t rows = _column->size();
+        if (_replicate) {
+            add_name("/replicate/max_count:" + std::to_string(param));
+            _offsets.resize(rows);
+            IColumn::Offset offset = 0;
+            for (size_t i = 0; i < rows; ++i) {
+                offset += data->next() % (param + 1);
+                _offsets[i] = offset;
+            }
+        } else {
+            add_name("/filter/selectivity:" + std::to_string(param));
+            _filter.resize(rows);
+            for (size_t i = 0; i < rows; ++i) {
+                _filter[i] = data->next() % 100 < param;
+            }
+        }
+    }
+
+    void run() override {
+        // run 100 times, to make the time measurable
+        for (int i = 0; i < 100; ++i) {
+            auto result = _replicate ? _column->replicate(_offsets) : _column->filter(_filter, -1);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+
+private:
+    bool _replicate;
+    ColumnPtr _column;
+    IColumn::Filter _filter;
+    IColumn::Offsets _offsets;
+};
+
+// Execute a function of SimpleFunctionFactory on a block of arguments, like VectorizedFnCall.
+// Call method: ./benchmark_tool --operation=Function --rows_number=4096
+class FunctionBenchmark : public BaseBenchmark {
+public:
+    FunctionBenchmark(const std::string& name, int iterations, const std::string& function_name,
+                      const ColumnsWithTypeAndName& arguments, const DataTypePtr& return_type)
+            : BaseBenchmark(name, iterations),
+              _arguments(arguments),
+              _return_type(return_type),
+              _rows(arguments[0].column->size()) {
+        add_name("/" + function_name);
+        std::vector<TypeDescriptor> arg_types;
+        for (size_t i = 0; i < arguments.size(); ++i) {
+            _argument_ids.push_back(i);
+            arg_types.emplace_back(
+                    remove_nullable(arguments[i].type)->get_type_as_primitive_type());
+        }
+        _function = SimpleFunctionFactory::instance().get_function(function_name, arguments,
+                                                                     return_type);
+        CHECK(_function != nullptr) << function_name;
+        _fn_utils.reset(new FunctionUtils(
+                TypeDescriptor(remove_nullable(return_type)->get_type_as_primitive_type()),
+                arg_types, 0));
+        CHECK(_function->open(_fn_utils->get_fn_ctx(), FunctionContext::FRAGMENT_LOCAL).ok());
+        CHECK(_function->open(_fn_utils->get_fn_ctx(), FunctionContext::THREAD_LOCAL).ok());
+    }
+
+    ~FunctionBenchmark() override {
+        _function->close(_fn_utils->get_fn_ctx(), FunctionContext::THREAD_LOCAL);
+        _function->close(_fn_utils->get_fn_ctx(), FunctionContext::FRAGMENT_LOCAL);
+    }
+
+    void init() override {
+        _block = Block(_arguments);
+        _block.insert({nullptr, _return_type, "result"});
+    }
+
+    void run() override {
+        CHECK(_function
+                      ->execute(_fn_utils->get_fn_ctx(), _block, _argument_ids,
+                                _arguments.size(), _rows)
+                      .ok());
+    }
+
+private:
+    ColumnsWithTypeAndName _arguments;
+    DataTypePtr _return_type;
+    size_t _rows;
+    ColumnNumbers _argument_ids;
+    FunctionBasePtr _function;
+    std::unique_ptr<FunctionUtils> _fn_utils;
+    Block _block;
+};
+
+struct OperatorBenchmarkOptions {
+    int iterations;
+    size_t rows;
+    size_t cardinality;
+    uint64_t seed;
+};
+
+// The keys of a column of each of the types, of the same ids.
+template <typename... T>
+ColumnsMaker number_keys(size_t cardinality) {
+    return [cardinality](SyntheticData* data, size_t rows) {
+        auto ids = data->ids(rows, cardinality);
+        return ColumnsWithTypeAndName {SyntheticData::numbers<T>(ids)...};
+    };
+}
+
+ColumnsMaker serialized_keys(size_t cardinality) {
+    return [cardinality](SyntheticData* data, size_t rows) {
+        auto ids = data->ids(rows, cardinality);
+        return ColumnsWithTypeAndName {SyntheticData::numbers<Int64>(ids),
+                                       SyntheticData::strings(ids, 16)};
+    };
+}
+
+ColumnsMaker string_keys(size_t cardinality) {
+    return [cardinality](SyntheticData* data, size_t rows) {
+        return ColumnsWithTypeAndName {
+                SyntheticData::strings(data->ids(rows, cardinality), 16)};
+    };
+}
+
+// The keys of `maker` of 10 percent of nulls.
+ColumnsMaker nullable_keys(const ColumnsMaker& maker) {
+    return [maker](SyntheticData* data, size_t rows) {
+        auto columns = maker(data, rows);
+        for (auto& column : columns) {
+            column = data->nullable(column, 10);
+        }
+        return columns;
+    };
+}
+
+template <typename HashTableContext>
+void add_hash_join_benchmark(const std::string& name, const ColumnsMaker& maker,
+                             const OperatorBenchmarkOptions& options,
+                             std::vector<BaseBenchmark*>* benchmarks) {
+    auto build_keys = make_blocks(maker, options.rows, options.rows, options.seed)[0];
+    // the probe keys of other seed, most of which are found if `rows` > `cardinality`
+    auto probe_blocks = make_blocks(maker, options.rows, BENCHMARK_BATCH_SIZE, options.seed + 1);
+    for (bool probe : {false, true}) {
+        benchmarks->push_back(new HashJoinBenchmark<HashTableContext>(
+                name, options.iterations, probe, build_keys, probe_blocks));
+    }
+}
+
+void add_hash_join_benchmarks(const OperatorBenchmarkOptions& options,
+                              std::vector<BaseBenchmark*>* benchmarks) {
+    size_t cardinality = options.cardinality;
+    add_hash_join_benchmark<I8HashTableContext<RowRefList>>(
+            "HashJoin/int8_key", number_keys<Int8>(cardinality), options, benchmarks);
+    add_hash_join_benchmark<I16HashTableContext<RowRefList>>(
+            "HashJoin/int16_key", number_keys<Int16>(cardinality), options, benchmarks);
+    add_hash_join_benchmark<I32HashTableContext<RowRefList>>(
+            "HashJoin/int32_key", number_keys<Int32>(cardinality), options, benchmarks);
+    add_hash_join_benchmark<I64HashTableContext<RowRefList>>(
+            "HashJoin/int64_key", number_keys<Int64>(cardinality), options, benchmarks);
+    add_hash_join_benchmark<I128HashTableContext<RowRefList>>(
+            "HashJoin/int128_key", number_keys<Int128>(cardinality), options, benchmarks);
+    add_hash_join_benchmark<I64FixedKeyHashTableContext<false, RowRefList>>(
+            "HashJoin/int64_keys", number_keys<Int32, Int32>(cardinality), options, benchmarks);
+    add_hash_join_benchmark<I128FixedKeyHashTableContext<false, RowRefList>>(
+            "HashJoin/int128_keys", number_keys<Int64, Int32>(cardinality), options, benchmarks);
+    add_hash_join_benchmark<SerializedHashTableContext<RowRefList>>(
+            "HashJoin/serialized", serialized_keys(cardinality), options, benchmarks);
+}
+
+void add_aggregation_hash_table_benchmarks(const OperatorBenchmarkOptions& options,
+                                           std::vector<BaseBenchmark*>* benchmarks) {
+    using Type = AggregatedDataVariants::Type;
+    struct Method {
+        std::string name;
+        Type type;
+        ColumnsMaker maker;
+        // whether there are the partitioned hash tables of the type
+        bool partitioned;
+    };
+    size_t cardinality = options.cardinality;
+    std::vector<Method> methods = {
+            {"serialized", Type::serialized, serialized_keys(cardinality), true},
+            {"int8_key", Type::int8_key, number_keys<Int8>(cardinality), false},
+            {"int16_key", Type::int16_key, number_keys<Int16>(cardinality), false},
+            {"int32_key", Type::int32_key, number_keys<Int32>(cardinality), true},
+            {"int32_key_phase2", Type::int32_key_phase2, number_keys<Int32>(cardinality), true},
+            {"int64_key", Type::int64_key, number_keys<Int64>(cardinality), true},
+            {"int64_key_phase2", Type::int64_key_phase2, number_keys<Int64>(cardinality), true},
+            {"int128_key", Type::int128_key, number_keys<Int128>(cardinality), true},
+            {"int128_key_phase2", Type::int128_key_phase2, number_keys<Int128>(cardinality),
+             true},
+            {"int64_keys", Type::int64_keys, number_keys<Int32, Int16>(cardinality), true},
+            {"int64_keys_phase2", Type::int64_keys_phase2, number_keys<Int32, Int16>(cardinality),
+             true},
+            {"int128_keys", Type::int128_keys, number_keys<Int64, Int32>(cardinality), true},
+            {"int128_keys_phase2", Type::int128_keys_phase2,
+             number_keys<Int64, Int32>(cardinality), true},
+            {"int256_keys", Type::int256_keys, number_keys<Int64, Int64, Int64>(cardinality),
+             true},
+            {"int256_keys_phase2", Type::int256_keys_phase2,
+             number_keys<Int64, Int64, Int64>(cardinality), true},
+            {"string_key", Type::string_key, string_keys(cardinality), false},
+            {"serialized_short_key", Type::serialized_short_key, serialized_keys(cardinality),
+             false},
+    };
+    for (const auto& method : methods) {
+        auto blocks = make_blocks(method.maker, options.rows, BENCHMARK_BATCH_SIZE, options.seed);
+        auto nullable_blocks = make_blocks(nullable_keys(method.maker), options.rows,
+                                           BENCHMARK_BATCH_SIZE, options.seed);
+        std::string name = "AggregationHashTable/" + method.name;
+        for (bool partitioned : {false, true}) {
+            if (partitioned && !method.partitioned) {
+                continue;
+            }
+            benchmarks->push_back(new AggregationHashTableBenchmark(
+                    name, options.iterations, method.type, false, partitioned, blocks));
+            benchmarks->push_back(new AggregationHashTableBenchmark(
+                    name, options.iterations, method.type, true, partitioned, nullable_blocks));
+        }
+    }
+}
+
+void add_sort_benchmarks(const OperatorBenchmarkOptions& options,
+                         std::vector<BaseBenchmark*>* benchmarks) {
+    size_t cardinality = options.cardinality;
+    auto blocks = make_blocks(
+            [cardinality](SyntheticData* data, size_t rows) {
+                return ColumnsWithTypeAndName {
+                        data->nullable(
+                                SyntheticData::numbers<Int64>(data->ids(rows, cardinality)), 10),
+                        data->nullable(
+                                SyntheticData::strings(data->ids(rows, cardinality), 16), 10)};
+            },
+            options.rows, BENCHMARK_BATCH_SIZE, options.seed);
+    benchmarks->push_back(
+            new SortBenchmark<FullSorter>("Sort/FullSorter", options.iterations, -1, blocks));
+    benchmarks->push_back(
+            new SortBenchmark<FullSorter>("Sort/FullSorter", options.iterations, 1000, blocks));
+    benchmarks->push_back(
+            new SortBenchmark<TopNSorter>("Sort/TopNSorter", options.iterations, 100, blocks));
+    benchmarks->push_back(
+            new SortBenchmark<HeapSorter>("Sort/HeapSorter", options.iterations, 100, blocks));
+}
+
+void add_block_serialize_benchmarks(const OperatorBenchmarkOptions& options,
+                                    std::vector<BaseBenchmark*>* benchmarks) {
+    size_t cardinality = options.cardinality;
+    auto columns = make_blocks(
+            [cardinality](SyntheticData* data, size_t rows) {
+                auto ids = data->ids(rows, cardinality);
+                return ColumnsWithTypeAndName {
+                        SyntheticData::numbers<Int32>(ids),
+                        data->nullable(SyntheticData::numbers<Int64>(ids), 10),
+                        SyntheticData::numbers<Float64>(data->ids(rows, cardinality)),
+                        SyntheticData::strings(ids, 16),
+                        data->nullable(SyntheticData::strings(data->ids(rows, cardinality), 64),
+                                       10)};
+            },
+            options.rows, options.rows, options.seed)[0];
+    for (auto compression_type : {segment_v2::NO_COMPRESSION, segment_v2::SNAPPY,
+                                  segment_v2::LZ4, segment_v2::LZ4F, segment_v2::ZLIB,
+                                  segment_v2::ZSTD}) {
+        for (bool deserialize : {false, true}) {
+            benchmarks->push_back(new BlockSerializeBenchmark(
+                    "BlockSerialize", options.iterations, deserialize, compression_type, columns));
+        }
+    }
+}
+
+void add_column_string_benchmarks(const OperatorBenchmarkOptions& options,
+                                  std::vector<BaseBenchmark*>* benchmarks) {
+    SyntheticData data(options.seed);
+    auto column = SyntheticData::strings(data.ids(options.rows, options.cardinality), 32);
+    for (int selectivity : {1, 10, 50, 90, 100}) {
+        benchmarks->push_back(new ColumnStringBenchmark("ColumnString", options.iterations,
+                                                        false, selectivity, column, &data));
+    }
+    for (int max_count : {1, 3, 10}) {
+        benchmarks->push_back(new ColumnStringBenchmark("ColumnString", options.iterations, true,
+                                                        max_count, column, &data));
+    }
+}
+
+void add_function_benchmarks(const OperatorBenchmarkOptions& options,
+                             std::vector<BaseBenchmark*>* benchmarks) {
+    SyntheticData data(options.seed);
+    size_t rows = options.rows;
+    auto strings = SyntheticData::strings(data.ids(rows, options.cardinality), 32);
+    auto other_strings = SyntheticData::strings(data.ids(rows, options.cardinality), 32);
+    auto numbers = SyntheticData::numbers<Float64>(data.ids(rows, options.cardinality));
+    auto constant = [rows](Int32 value) {
+        auto column = ColumnInt32::create();
+        column->insert_value(value);
+        return ColumnWithTypeAndName {ColumnConst::create(std::move(column), rows),
+                                      std::make_shared<DataTypeInt32>(), ""};
+    };
+    auto string_type = std::make_shared<DataTypeString>();
+    benchmarks->push_back(new FunctionBenchmark("Function", options.iterations, "lower",
+                                                {strings}, string_type));
+    benchmarks->push_back(new FunctionBenchmark("Function", options.iterations, "concat",
+                                                {strings, other_strings}, string_type));
+    benchmarks->push_back(new FunctionBenchmark("Function", options.iterations, "substring",
+                                                {strings, constant(2), constant(8)},
+                                                string_type));
+    benchmarks->push_back(new FunctionBenchmark("Function", options.iterations, "abs",
+                                                {numbers}, std::make_shared<DataTypeFloat64>()));
+}
+
+} // namespace vectorized
+
 class MultiBenchmark {
 public:
     MultiBenchmark() {}
@@ -566,6 +1934,57 @@ public:
         } else if (equal_ignore_case(FLAGS_operation, "SegmentWriteByFile")) {
             benchmarks.emplace_back(new doris::SegmentWriteByFileBenchmark(
                     FLAGS_operation, std::stoi(FLAGS_iterations), FLAGS_input_file));
+        } else if (equal_ignore_case(FLAGS_operation, "TaskQueue")) {
+            benchmarks.emplace_back(new doris::TaskQueueBenchmark<doris::MutexTaskQueue>(
+                    "MutexTaskQueue", std::stoi(FLAGS_iterations), std::stoi(FLAGS_threads_number),
+                    std::stoi(FLAGS_rows_number)));
+            benchmarks.emplace_back(new doris::TaskQueueBenchmark<doris::WorkStealingTaskQueue>(
+                    "WorkStealingTaskQueue", std::stoi(FLAGS_iterations),
+                    std::stoi(FLAGS_threads_number), std::stoi(FLAGS_rows_number)));
+        } else if (equal_ignore_case(FLAGS_operation, "ColumnPredicate")) {
+            for (int step = 1; step <= 3; ++step) {
+                benchmarks.emplace_back(new doris::ColumnPredicateBenchmark(
+                        FLAGS_operation, std::stoi(FLAGS_iterations),
+                        std::stoi(FLAGS_rows_number), step));
+            }
+        } else if (equal_ignore_case(FLAGS_operation, "HashTableProbe")) {
+            // from fitting in L2 to far bigger than LLC
+            for (size_t table_size : {1UL << 14, 1UL << 18, 1UL << 22, 1UL << 25}) {
+                benchmarks.emplace_back(new doris::HashTableProbeBenchmark<false>(
+                        FLAGS_operation, std::stoi(FLAGS_iterations),
+                        std::stoi(FLAGS_rows_number), table_size));
+                benchmarks.emplace_back(new doris::HashTableProbeBenchmark<true>(
+                        FLAGS_operation, std::stoi(FLAGS_iterations),
+                        std::stoi(FLAGS_rows_number), table_size));
+            }
+        } else if (equal_ignore_case(FLAGS_operation, "HashJoin")) {
+            vectorized::add_hash_join_benchmarks(operator_options(), &benchmarks);
+        } else if (equal_ignore_case(FLAGS_operation, "AggregationHashTable")) {
+            vectorized::add_aggregation_hash_table_benchmarks(operator_options(), &benchmarks);
+        } else if (equal_ignore_case(FLAGS_operation, "Sort")) {
+            vectorized::add_sort_benchmarks(operator_options(), &benchmarks);
+        } else if (equal_ignore_case(FLAGS_operation, "BlockSerialize")) {
+            vectorized::add_block_serialize_benchmarks(operator_options(), &benchmarks);
+        } else if (equal_ignore_case(FLAGS_operation, "ColumnString")) {
+            vectorized::add_column_string_benchmarks(operator_options(), &benchmarks);
+        } else if (equal_ignore_case(FLAGS_operation, "Function")) {
+            vectorized::add_function_benchmarks(operator_options(), &benchmarks);
+        } else if (equal_ignore_case(FLAGS_operation, "StorageRead")) {
+            using CacheMode = doris::StorageReadBenchmark::CacheMode;
+            // the keys models and whether they are merge-on-write
+            const std::pair<KeysType, bool> keys_models[] = {
+                    {DUP_KEYS, false},
+                    {AGG_KEYS, false},
+                    {UNIQUE_KEYS, false},
+                    {UNIQUE_KEYS, true}};
+            for (auto cache_mode : {CacheMode::COLD, CacheMode::WARM, CacheMode::REMOTE}) {
+                for (auto [keys_type, enable_mow] : keys_models) {
+                    benchmarks.emplace_back(new doris::StorageReadBenchmark(
+                            FLAGS_operation, std::stoi(FLAGS_iterations), keys_type, enable_mow,
+                            cache_mode, std::stoi(FLAGS_rows_number),
+                            std::stoi(FLAGS_rowsets_number), std::stoi(FLAGS_segments_number)));
+                }
+            }
         } else {
             std::cout << "operation invalid!" << std::endl;
         }
@@ -577,6 +1996,11 @@ public:
     }
 
 private:
+    static vectorized::OperatorBenchmarkOptions operator_options() {
+        return {std::stoi(FLAGS_iterations), std::stoul(FLAGS_rows_number),
+                std::stoul(FLAGS_cardinality), std::stoull(FLAGS_seed)};
+    }
+
     std::vector<doris::BaseBenchmark*> benchmarks;
 };
 
@@ -587,6 +2011,7 @@ int main(int argc, char** argv) {
     google::ParseCommandLineFlags(&argc, &argv, true);
 
     doris::StoragePageCache::create_global_cache(1 << 30, 10);
+    doris::SegmentLoader::create_global_instance(1000);
 
     doris::MultiBenchmark multi_bm;
     multi_bm.add_bm();
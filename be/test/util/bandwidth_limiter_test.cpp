@@ -0,0 +1,55 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/bandwidth_limiter.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace doris {
+
+TEST(BandwidthLimiterTest, Unlimited) {
+    BandwidthLimiter limiter;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 1000; ++i) {
+        limiter.acquire(1 << 20, 0);
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(100));
+}
+
+TEST(BandwidthLimiterTest, SharedByThreads) {
+    BandwidthLimiter limiter;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    // 800KB at 1MB/s in total
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&limiter]() {
+            for (int j = 0; j < 20; ++j) {
+                limiter.acquire(10000, 1000000);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(750));
+}
+
+} // namespace doris
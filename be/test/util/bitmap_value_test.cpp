@@ -21,6 +21,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "util/coding.h"
 
@@ -101,6 +102,45 @@ TEST(BitmapValueTest, bitmap_union) {
     EXPECT_EQ(5, bitmap3.cardinality());
 }
 
+TEST(BitmapValueTest, bitmap_fastunion_many) {
+    // the bitmaps span several high bytes, which are unioned separately
+    std::vector<BitmapValue> values(8);
+    BitmapValue expected;
+    for (uint64_t i = 0; i < values.size(); ++i) {
+        for (uint64_t j = 0; j < 1000; ++j) {
+            uint64_t value = ((j % 3) << 32) + i * 500 + j * 7;
+            values[i].add(value);
+            expected.add(value);
+        }
+    }
+    std::vector<const BitmapValue*> value_ptrs;
+    for (const auto& value : values) {
+        value_ptrs.push_back(&value);
+    }
+
+    BitmapValue empty;
+    empty.fastunion(value_ptrs);
+    EXPECT_EQ(expected.cardinality(), empty.cardinality());
+    EXPECT_EQ(expected.to_string(), empty.to_string());
+
+    BitmapValue bitmap({1, (5ULL << 32) + 1});
+    bitmap.fastunion(value_ptrs);
+    expected.add(1);
+    expected.add((5ULL << 32) + 1);
+    EXPECT_EQ(expected.cardinality(), bitmap.cardinality());
+    EXPECT_EQ(expected.to_string(), bitmap.to_string());
+    EXPECT_TRUE(bitmap.contains((5ULL << 32) + 1));
+
+    // the inputs are not modified
+    EXPECT_EQ(1000, values[0].cardinality());
+
+    BitmapValue moved(std::move(bitmap));
+    EXPECT_EQ(expected.cardinality(), moved.cardinality());
+    BitmapValue assigned;
+    assigned = std::move(moved);
+    EXPECT_EQ(expected.to_string(), assigned.to_string());
+}
+
 TEST(BitmapValueTest, bitmap_intersect) {
     BitmapValue empty;
     BitmapValue single(1024);
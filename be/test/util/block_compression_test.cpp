@@ -142,4 +142,49 @@ TEST_F(BlockCompressionTest, multi) {
     test_multi_slices(segment_v2::CompressionTypePB::ZSTD);
 }
 
+TEST_F(BlockCompressionTest, zstd_dict) {
+    std::vector<std::string> pages;
+    for (int i = 0; i < 64; ++i) {
+        std::string page;
+        for (int j = 0; j < 100; ++j) {
+            page.append("https://doris.apache.org/docs/" + std::to_string(i * 100 + j) +
+                        "/sql-manual?lang=en&version=" + generate_str(4));
+        }
+        pages.push_back(std::move(page));
+    }
+    std::vector<Slice> samples(pages.begin(), pages.end());
+    std::string dict;
+    EXPECT_TRUE(train_zstd_dictionary(samples, 16384, &dict).ok());
+    EXPECT_FALSE(dict.empty());
+    EXPECT_LE(dict.size(), 16384);
+
+    std::unique_ptr<BlockCompressionCodec> codec;
+    EXPECT_TRUE(create_zstd_dict_compression_codec(dict, &codec).ok());
+    BlockCompressionCodec* plain_codec = nullptr;
+    auto st = get_block_compression_codec(segment_v2::CompressionTypePB::ZSTD, &plain_codec);
+    EXPECT_TRUE(st.ok());
+    size_t dict_compressed_size = 0;
+    size_t plain_compressed_size = 0;
+    for (auto& page : pages) {
+        faststring compressed;
+        EXPECT_TRUE(codec->compress(page, &compressed).ok());
+        dict_compressed_size += compressed.size();
+
+        std::string uncompressed(page.size(), '\0');
+        Slice uncompressed_slice(uncompressed);
+        EXPECT_TRUE(codec->decompress(Slice(compressed), &uncompressed_slice).ok());
+        EXPECT_EQ(page, uncompressed);
+        // the pages are not decompressed without the dictionary
+        EXPECT_FALSE(plain_codec->decompress(Slice(compressed), &uncompressed_slice).ok());
+
+        EXPECT_TRUE(plain_codec->compress(page, &compressed).ok());
+        plain_compressed_size += compressed.size();
+    }
+    EXPECT_LT(dict_compressed_size, plain_compressed_size);
+
+    // too few samples
+    std::vector<Slice> few_samples(samples.begin(), samples.begin() + 1);
+    EXPECT_FALSE(train_zstd_dictionary(few_samples, 16384, &dict).ok());
+}
+
 } // namespace doris
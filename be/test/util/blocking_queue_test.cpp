@@ -23,6 +23,7 @@
 
 #include <mutex>
 #include <thread>
+#include <vector>
 
 namespace doris {
 
@@ -51,6 +52,35 @@ TEST(BlockingQueueTest, TestGetFromShutdownQueue) {
     EXPECT_FALSE(test_queue.blocking_get(&i));
 }
 
+TEST(BlockingQueueTest, TestBatch) {
+    BlockingQueue<int32_t> test_queue(3);
+    std::vector<int32_t> vals {1, 2, 3, 4, 5};
+    // the batch is larger than the queue, so it's put in two rounds
+    std::thread putter([&]() { EXPECT_TRUE(test_queue.blocking_put_batch(&vals)); });
+
+    std::vector<int32_t> out;
+    while (out.size() < 5) {
+        EXPECT_TRUE(test_queue.blocking_get_batch(&out, 2));
+    }
+    putter.join();
+    EXPECT_TRUE(vals.empty());
+    EXPECT_EQ((std::vector<int32_t> {1, 2, 3, 4, 5}), out);
+
+    std::vector<int32_t> left {6, 7, 8, 9};
+    std::thread blocked_putter([&]() { EXPECT_FALSE(test_queue.blocking_put_batch(&left)); });
+    while (test_queue.get_size() < 3) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    test_queue.shutdown();
+    blocked_putter.join();
+    // the elements not put are left to the caller
+    EXPECT_EQ((std::vector<int32_t> {9}), left);
+    out.clear();
+    EXPECT_TRUE(test_queue.blocking_get_batch(&out, 10));
+    EXPECT_EQ((std::vector<int32_t> {6, 7, 8}), out);
+    EXPECT_FALSE(test_queue.blocking_get_batch(&out, 10));
+}
+
 class MultiThreadTest {
 public:
     MultiThreadTest()
@@ -49,4 +49,29 @@ TEST_F(ByteBufferTest, normal) {
     EXPECT_EQ(3, buf->remaining());
 }
 
+TEST_F(ByteBufferTest, pool) {
+    ByteBufferPool pool(16, 1);
+    char* kept_ptr = nullptr;
+    {
+        auto buf1 = pool.allocate();
+        EXPECT_EQ(16, buf1->capacity);
+        EXPECT_EQ(16, buf1->limit);
+        buf1->put_bytes("abc", 3);
+        buf1->flip();
+        kept_ptr = buf1->ptr;
+        auto buf2 = pool.allocate();
+        // buf1 is kept by the pool, and buf2 is freed as the pool is full
+        buf1.reset();
+    }
+    EXPECT_EQ(1, pool.num_free_buffers());
+
+    auto buf = pool.allocate();
+    EXPECT_EQ(0, pool.num_free_buffers());
+    EXPECT_EQ(kept_ptr, buf->ptr);
+    // the reused buffer is cleared
+    EXPECT_EQ(0, buf->pos);
+    EXPECT_EQ(16, buf->limit);
+    EXPECT_EQ(16, buf->remaining());
+}
+
 } // namespace doris
@@ -0,0 +1,110 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/ddsketch.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace doris {
+
+static double exact_quantile(double q, const std::vector<double>& sorted) {
+    return sorted[static_cast<size_t>(q * (sorted.size() - 1))];
+}
+
+TEST(DDSketchTest, empty) {
+    DDSketch sketch;
+    EXPECT_TRUE(sketch.empty());
+    EXPECT_TRUE(std::isnan(sketch.quantile(0.5)));
+}
+
+TEST(DDSketchTest, relative_accuracy) {
+    std::mt19937_64 gen(42);
+    std::lognormal_distribution<double> dist(3, 2);
+    std::vector<double> values;
+    DDSketch lhs;
+    DDSketch rhs;
+    for (int i = 0; i < 100000; ++i) {
+        double value = dist(gen);
+        if (i % 7 == 0) {
+            value = -value;
+        } else if (i % 11 == 0) {
+            value = 0;
+        }
+        values.push_back(value);
+        (i % 2 ? lhs : rhs).add(value);
+    }
+    lhs.merge(rhs);
+    EXPECT_EQ(values.size(), lhs.count());
+    std::sort(values.begin(), values.end());
+
+    EXPECT_EQ(values.front(), lhs.quantile(0));
+    EXPECT_EQ(values.back(), lhs.quantile(1));
+    for (double q : {0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999}) {
+        double exact = exact_quantile(q, values);
+        double estimate = lhs.quantile(q);
+        if (exact == 0) {
+            EXPECT_EQ(0, estimate) << q;
+        } else {
+            EXPECT_LE(std::abs(estimate - exact), std::abs(exact) * lhs.relative_accuracy()) << q;
+        }
+    }
+}
+
+TEST(DDSketchTest, serialize) {
+    DDSketch sketch(0.02);
+    for (int i = 1; i <= 10000; ++i) {
+        sketch.add(i * 0.5, i % 3 + 1);
+    }
+    std::vector<uint8_t> buf(sketch.serialized_size());
+    EXPECT_EQ(buf.size(), sketch.serialize(buf.data()));
+
+    DDSketch other;
+    EXPECT_TRUE(other.unserialize(buf.data(), buf.size()));
+    EXPECT_EQ(0.02, other.relative_accuracy());
+    EXPECT_EQ(sketch.count(), other.count());
+    for (double q : {0.0, 0.3, 0.5, 0.99, 1.0}) {
+        EXPECT_EQ(sketch.quantile(q), other.quantile(q));
+    }
+
+    DDSketch truncated;
+    EXPECT_FALSE(truncated.unserialize(buf.data(), buf.size() - 1));
+    EXPECT_TRUE(truncated.empty());
+}
+
+TEST(DDSketchTest, collapse_lowest_buckets) {
+    DDSketch sketch(0.01, 100);
+    std::vector<double> values;
+    for (int i = 1; i <= 100000; ++i) {
+        values.push_back(i);
+        sketch.add(i);
+    }
+    size_t num_buckets = 0;
+    sketch.for_each([&](double, uint64_t) { ++num_buckets; });
+    EXPECT_LE(num_buckets, 100);
+    EXPECT_EQ(values.size(), sketch.count());
+    // the high quantiles keep their accuracy
+    for (double q : {0.9, 0.99}) {
+        double exact = exact_quantile(q, values);
+        EXPECT_LE(std::abs(sketch.quantile(q) - exact), exact * 0.01) << q;
+    }
+}
+
+} // namespace doris
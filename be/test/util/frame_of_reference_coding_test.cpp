@@ -19,6 +19,9 @@
 
 #include <gtest/gtest.h>
 
+#include <limits>
+#include <vector>
+
 namespace doris {
 class TestForCoding : public testing::Test {
 public:
@@ -243,4 +246,52 @@ TEST_F(TestForCoding, TestValueSeek) {
     EXPECT_EQ(found, false);
 }
 
+TEST_F(TestForCoding, TestAllBitWidths) {
+    // every bit width of the packed deltas from 0 to 64 bits
+    for (int bit_width = 0; bit_width <= 64; ++bit_width) {
+        faststring buffer(1);
+        ForEncoder<int64_t> encoder(&buffer);
+        std::vector<int64_t> data;
+        for (int64_t i = 0; i < 300; ++i) {
+            uint64_t delta = bit_width == 0 ? 0 : (i * 0x9E3779B97F4A7C15ULL) >> (64 - bit_width);
+            if (bit_width > 0 && i % 2 == 0) {
+                delta = bit_width == 64 ? ~0ULL : (1ULL << bit_width) - 1;
+            }
+            data.push_back(std::numeric_limits<int64_t>::min() + delta);
+        }
+        encoder.put_batch(data.data(), data.size());
+        encoder.flush();
+
+        ForDecoder<int64_t> decoder(buffer.data(), buffer.length());
+        EXPECT_TRUE(decoder.init());
+        std::vector<int64_t> actual_result(data.size());
+        EXPECT_TRUE(decoder.get_batch(actual_result.data(), data.size()));
+        EXPECT_EQ(data, actual_result) << "bit width " << bit_width;
+    }
+}
+
+TEST_F(TestForCoding, TestSkipBackAfterBatch) {
+    faststring buffer(1);
+    ForEncoder<int32_t> encoder(&buffer);
+    std::vector<int32_t> data;
+    for (int32_t i = 0; i < 400; ++i) {
+        data.push_back(i * 7 - 1000);
+    }
+    encoder.put_batch(data.data(), data.size());
+    encoder.flush();
+
+    ForDecoder<int32_t> decoder(buffer.data(), buffer.length());
+    EXPECT_TRUE(decoder.init());
+    // the second frame is decoded into the output directly
+    std::vector<int32_t> actual_result(256);
+    EXPECT_TRUE(decoder.get_batch(actual_result.data(), 256));
+    EXPECT_TRUE(decoder.skip(-100));
+    int32_t value = 0;
+    EXPECT_TRUE(decoder.get(&value));
+    EXPECT_EQ(data[156], value);
+    EXPECT_TRUE(decoder.skip(243 - decoder.current_index()));
+    EXPECT_TRUE(decoder.get(&value));
+    EXPECT_EQ(data[243], value);
+}
+
 } // namespace doris
@@ -20,6 +20,8 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <thread>
+#include <vector>
 
 namespace doris {
 
@@ -92,4 +94,19 @@ TEST_F(HistogramTest, Clear) {
     EXPECT_EQ(hist.average(), 0.0);
 }
 
+TEST_F(HistogramTest, ConcurrentAdd) {
+    HistogramStat hist;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([&hist]() { populate_histogram(hist, 1, 1000); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(hist.num(), 8000);
+    EXPECT_EQ(hist.sum(), 8 * 500500);
+    EXPECT_EQ(hist.min(), 1);
+    EXPECT_EQ(hist.max(), 1000);
+}
+
 } // namespace doris
@@ -429,6 +429,7 @@ test_registry_task_duration{quantile="0.75"} 75
 test_registry_task_duration{quantile="0.90"} 95.8333
 test_registry_task_duration{quantile="0.95"} 100
 test_registry_task_duration{quantile="0.99"} 100
+test_registry_task_duration{quantile="0.999"} 100
 test_registry_task_duration_sum 5050
 test_registry_task_duration_count 100
 test_registry_task_duration_max 100
@@ -441,7 +442,7 @@ test_registry_task_duration_standard_deviation 28.8661
         EXPECT_EQ(
                 R"*([{"tags":{"metric":"task_duration"},"unit":"milliseconds",)*"
                 R"*("value":{"total_count":100,"min":1,"average":50.5,"median":50.0,)*"
-                R"*("percentile_50":50.0,"percentile_75":75.0,"percentile_90":95.83333333333334,"percentile_95":100.0,"percentile_99":100.0,)*"
+                R"*("percentile_50":50.0,"percentile_75":75.0,"percentile_90":95.83333333333334,"percentile_95":100.0,"percentile_99":100.0,"percentile_999":100.0,)*"
                 R"*("standard_deviation":28.86607004772212,"max":100,"total_sum":5050}}])*",
                 registry.to_json());
         registry.deregister_entity(entity);
@@ -465,6 +466,7 @@ test_registry_task_duration{instance="test",type="create_tablet",quantile="0.75"
 test_registry_task_duration{instance="test",type="create_tablet",quantile="0.90"} 95.8333
 test_registry_task_duration{instance="test",type="create_tablet",quantile="0.95"} 100
 test_registry_task_duration{instance="test",type="create_tablet",quantile="0.99"} 100
+test_registry_task_duration{instance="test",type="create_tablet",quantile="0.999"} 100
 test_registry_task_duration_sum{instance="test",type="create_tablet"} 5050
 test_registry_task_duration_count{instance="test",type="create_tablet"} 100
 test_registry_task_duration_max{instance="test",type="create_tablet"} 100
@@ -477,7 +479,7 @@ test_registry_task_duration_standard_deviation{instance="test",type="create_tabl
         EXPECT_EQ(
                 R"*([{"tags":{"metric":"task_duration","type":"create_tablet","instance":"test"},"unit":"milliseconds",)*"
                 R"*("value":{"total_count":100,"min":1,"average":50.5,"median":50.0,)*"
-                R"*("percentile_50":50.0,"percentile_75":75.0,"percentile_90":95.83333333333334,"percentile_95":100.0,"percentile_99":100.0,)*"
+                R"*("percentile_50":50.0,"percentile_75":75.0,"percentile_90":95.83333333333334,"percentile_95":100.0,"percentile_99":100.0,"percentile_999":100.0,)*"
                 R"*("standard_deviation":28.86607004772212,"max":100,"total_sum":5050}}])*",
                 registry.to_json());
         registry.deregister_entity(entity);
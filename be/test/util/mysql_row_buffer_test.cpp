@@ -24,6 +24,7 @@
 #include <string>
 
 #include "gutil/strings/util.h"
+#include "vec/runtime/vdatetime_value.h"
 
 namespace doris {
 
@@ -117,4 +118,28 @@ TEST(MysqlRowBufferTest, dynamic_mode) {
     EXPECT_EQ(0, strncmp(buf + 43, "test", 4));
 }
 
+TEST(MysqlRowBufferTest, binary_datetime) {
+    MysqlRowBuffer<true> mrb;
+    mrb.start_binary_row(2);
+    // the bitmap of the nulls takes (2 + 9) / 8 + 1 bytes
+    EXPECT_EQ(2, mrb.length());
+
+    vectorized::DateV2Value<vectorized::DateTimeV2ValueType> with_microsecond;
+    with_microsecond.set_time(2023, 1, 2, 3, 4, 5, 678);
+    mrb.push_vec_datetime(with_microsecond);
+    vectorized::DateV2Value<vectorized::DateTimeV2ValueType> without_microsecond;
+    without_microsecond.set_time(2023, 1, 2, 3, 4, 5, 0);
+    mrb.push_vec_datetime(without_microsecond);
+
+    // length-year(2b)-month-day-hour-minute-second-microsecond(4b)
+    const char* buf = mrb.buf();
+    EXPECT_EQ(2 + 12 + 8, mrb.length());
+    EXPECT_EQ(11, *((int8_t*)(buf + 2)));
+    EXPECT_EQ(2023, *((int16_t*)(buf + 3)));
+    EXPECT_EQ(5, *((int8_t*)(buf + 9)));
+    EXPECT_EQ(678, *((int32_t*)(buf + 10)));
+    EXPECT_EQ(7, *((int8_t*)(buf + 14)));
+    EXPECT_EQ(5, *((int8_t*)(buf + 21)));
+}
+
 } // namespace doris
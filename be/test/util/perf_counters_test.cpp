@@ -0,0 +1,59 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/perf_counters.h"
+
+#include <gtest/gtest.h>
+
+namespace doris {
+
+TEST(PerfCountersTest, ThreadPerfCounters) {
+    auto* counters = ThreadPerfCounters::current();
+    if (counters == nullptr) {
+        // not available, e.g. in a VM without a virtual PMU
+        return;
+    }
+    EXPECT_EQ(counters, ThreadPerfCounters::current());
+    ThreadPerfCounters::Values start;
+    ThreadPerfCounters::Values end;
+    ASSERT_TRUE(counters->read(&start));
+    volatile int64_t sum = 0;
+    for (int i = 0; i < 1000000; ++i) {
+        sum = sum + i;
+    }
+    ASSERT_TRUE(counters->read(&end));
+    EXPECT_GT(end[ThreadPerfCounters::INSTRUCTIONS], start[ThreadPerfCounters::INSTRUCTIONS]);
+    EXPECT_GT(end[ThreadPerfCounters::CPU_CYCLES], start[ThreadPerfCounters::CPU_CYCLES]);
+}
+
+TEST(PerfCountersTest, HardwareCounterProfile) {
+    RuntimeProfile profile("test");
+    HardwareCounterProfile hw_profile(&profile);
+    hw_profile.update({0, 0, 0, 0}, {1000, 2000, 10, 4});
+    // the scaled values may go backwards, which is not counted
+    hw_profile.update({1000, 2000, 10, 4}, {3000, 4000, 8, 6});
+
+    EXPECT_EQ(3000, profile.get_counter("CpuCycles")->value());
+    EXPECT_EQ(4000, profile.get_counter("Instructions")->value());
+    EXPECT_EQ(10, profile.get_counter("LLCMisses")->value());
+    EXPECT_EQ(6, profile.get_counter("BranchMisses")->value());
+    EXPECT_DOUBLE_EQ(4000.0 / 3000, profile.get_counter("IPC")->double_value());
+    EXPECT_DOUBLE_EQ(2.5, profile.get_counter("LLCMissesPerKiloInstructions")->double_value());
+    EXPECT_DOUBLE_EQ(1.5, profile.get_counter("BranchMissesPerKiloInstructions")->double_value());
+}
+
+} // namespace doris
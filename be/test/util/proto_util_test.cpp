@@ -0,0 +1,70 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/proto_util.h"
+
+#include <brpc/controller.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+namespace doris {
+
+struct TestClosure {
+    brpc::Controller cntl;
+};
+
+TEST(ProtoUtilTest, BlockTransferAttachmentByRef) {
+    PTransmitDataParams request;
+    auto* block = request.mutable_block();
+    block->add_column_metas()->set_name("k1");
+    block->set_be_exec_version(2);
+    block->add_column_values_metas()->set_uncompressed_size(3);
+
+    auto column_values = std::make_shared<std::string>(4096, 'a');
+    PTransmitDataParams meta_request;
+    copy_block_without_column_values(*block, meta_request.mutable_block());
+    EXPECT_TRUE(meta_request.block().column_values().empty());
+    EXPECT_EQ(1, meta_request.block().column_metas_size());
+    EXPECT_EQ(2, meta_request.block().be_exec_version());
+    EXPECT_EQ(1, meta_request.block().column_values_metas_size());
+
+    bool released = false;
+    {
+        auto closure = std::make_unique<TestClosure>();
+        request_block_transfer_attachment_by_ref(
+                &meta_request, *column_values,
+                [column_values, &released]() { released = true; }, closure.get());
+        EXPECT_TRUE(meta_request.transfer_by_attachment());
+        EXPECT_EQ(column_values->size(), closure->cntl.request_attachment().size());
+        // the attachment references column_values instead of copying it
+        const butil::IOBuf& attachment = closure->cntl.request_attachment();
+        EXPECT_EQ(1, attachment.backing_block_num());
+        EXPECT_EQ(column_values->data(), attachment.backing_block(0).data());
+        EXPECT_FALSE(released);
+
+        // the receiver restores column_values from the attachment
+        PTransmitDataParams received = meta_request;
+        attachment_transfer_request_block(&received, &closure->cntl);
+        EXPECT_EQ(*column_values, received.block().column_values());
+    }
+    EXPECT_TRUE(released);
+    EXPECT_EQ(1, column_values.use_count());
+}
+
+} // namespace doris
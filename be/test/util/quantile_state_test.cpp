@@ -19,6 +19,8 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+
 namespace doris {
 using DoubleQuantileState = QuantileState<double>;
 
@@ -51,4 +53,43 @@ TEST(QuantileStateTest, merge) {
     EXPECT_EQ(10, another.get_value_by_percentile(1));
 }
 
+TEST(QuantileStateTest, ddsketch) {
+    DoubleQuantileState sketch(0.01);
+    for (int i = 1; i <= 5000; ++i) {
+        sketch.add_value(i);
+    }
+    EXPECT_EQ(DDSKETCH, sketch._type);
+    EXPECT_EQ(1, sketch.get_value_by_percentile(0));
+    EXPECT_EQ(5000, sketch.get_value_by_percentile(1));
+    EXPECT_NEAR(2500, sketch.get_value_by_percentile(0.5), 2500 * 0.01);
+
+    std::string buf(sketch.get_serialized_size(), '\0');
+    size_t size = sketch.serialize(reinterpret_cast<uint8_t*>(buf.data()));
+    EXPECT_EQ(buf.size(), size);
+    DoubleQuantileState deserialized;
+    EXPECT_TRUE(deserialized.deserialize(Slice(buf)));
+    EXPECT_EQ(DDSKETCH, deserialized._type);
+    EXPECT_EQ(sketch.get_value_by_percentile(0.9), deserialized.get_value_by_percentile(0.9));
+
+    DoubleQuantileState explicits(0.01);
+    for (int i = 5001; i <= 6000; ++i) {
+        explicits.add_value(i);
+    }
+    EXPECT_EQ(EXPLICIT, explicits._type);
+    explicits.merge(deserialized);
+    EXPECT_EQ(DDSKETCH, explicits._type);
+    EXPECT_EQ(6000, explicits.get_value_by_percentile(1));
+    EXPECT_NEAR(3000, explicits.get_value_by_percentile(0.5), 3000 * 0.01);
+
+    // the states of different kinds of sketches are merged into a TDigest
+    DoubleQuantileState digest;
+    for (int i = 6001; i <= 9000; ++i) {
+        digest.add_value(i);
+    }
+    EXPECT_EQ(TDIGEST, digest._type);
+    digest.merge(explicits);
+    EXPECT_EQ(TDIGEST, digest._type);
+    EXPECT_NEAR(4500, digest.get_value_by_percentile(0.5), 4500 * 0.02);
+}
+
 } // namespace doris
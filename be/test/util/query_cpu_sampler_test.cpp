@@ -0,0 +1,131 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/query_cpu_sampler.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "common/config.h"
+#include "util/stopwatch.hpp"
+
+namespace doris {
+
+class QueryCpuSamplerTest : public testing::Test {
+public:
+    void SetUp() override { _sampler->_init_ring(); }
+
+    static TUniqueId make_id(int64_t hi, int64_t lo) {
+        TUniqueId id;
+        id.__set_hi(hi);
+        id.__set_lo(lo);
+        return id;
+    }
+
+    static CpuSampleTag make_tag(const TUniqueId& query_id, const TUniqueId& fragment_instance_id,
+                                 int32_t pipeline_id, int32_t pipeline_task_index) {
+        return {query_id.hi, query_id.lo, fragment_instance_id.hi, fragment_instance_id.lo,
+                pipeline_id, pipeline_task_index};
+    }
+
+    // the count of the folded stacks with the prefix
+    static int64_t count_samples(const std::string& folded_stacks, const std::string& prefix) {
+        std::istringstream lines(folded_stacks);
+        std::string line;
+        int64_t samples = 0;
+        while (std::getline(lines, line)) {
+            if (line.compare(0, prefix.size(), prefix) == 0) {
+                samples += std::stoll(line.substr(line.rfind(' ') + 1));
+            }
+        }
+        return samples;
+    }
+
+protected:
+    QueryCpuSampler* _sampler = QueryCpuSampler::instance();
+};
+
+TEST_F(QueryCpuSamplerTest, aggregate) {
+    auto query_id = make_id(1, 1);
+    auto fragment_instance_id = make_id(1, 2);
+    void* frames[] = {reinterpret_cast<void*>(0x1000), reinterpret_cast<void*>(0x2000)};
+    for (int i = 0; i < 3; ++i) {
+        _sampler->add_sample(make_tag(query_id, fragment_instance_id, 1, 2), frames, 2);
+    }
+    _sampler->add_sample(make_tag(query_id, fragment_instance_id, 1, 3), frames, 2);
+    _sampler->add_sample(make_tag(query_id, fragment_instance_id, -1, -1), frames, 1);
+    _sampler->collect();
+
+    bool found = false;
+    for (const auto& query : _sampler->list_queries()) {
+        if (query.query_id == query_id) {
+            EXPECT_EQ(5, query.samples);
+            found = true;
+        }
+    }
+    EXPECT_TRUE(found);
+
+    std::string folded_stacks;
+    ASSERT_TRUE(_sampler->get_folded_stacks(query_id, &folded_stacks).ok());
+    std::string fragment = "fragment " + print_id(fragment_instance_id);
+    EXPECT_EQ(5, count_samples(folded_stacks, fragment));
+    EXPECT_EQ(3, count_samples(folded_stacks, fragment + ";pipeline 1 task 2;"));
+    EXPECT_EQ(1, count_samples(folded_stacks, fragment + ";pipeline 1 task 3;"));
+    EXPECT_EQ(4, count_samples(folded_stacks, fragment + ";pipeline 1 task"));
+
+    EXPECT_FALSE(_sampler->get_folded_stacks(make_id(1, 3), &folded_stacks).ok());
+}
+
+TEST_F(QueryCpuSamplerTest, max_queries) {
+    int32_t old_max_queries = config::query_cpu_sampling_max_queries;
+    config::query_cpu_sampling_max_queries = 2;
+    void* frames[] = {reinterpret_cast<void*>(0x1000)};
+    for (int64_t i = 0; i < 4; ++i) {
+        _sampler->add_sample(make_tag(make_id(2, i), make_id(2, i), -1, -1), frames, 1);
+        _sampler->collect();
+    }
+    EXPECT_EQ(2, _sampler->list_queries().size());
+    config::query_cpu_sampling_max_queries = old_max_queries;
+}
+
+TEST_F(QueryCpuSamplerTest, sample) {
+    auto query_id = make_id(3, 1);
+    auto fragment_instance_id = make_id(3, 2);
+    QueryCpuSampler::set_tag(query_id, fragment_instance_id, 0, 0);
+    _sampler->set_frequency(1000);
+    // burn 200ms of CPU
+    MonotonicStopWatch watch;
+    watch.start();
+    volatile int64_t sum = 0;
+    while (watch.elapsed_time() < 200 * 1000 * 1000) {
+        for (int i = 0; i < 1000; ++i) {
+            sum = sum + i;
+        }
+    }
+    _sampler->set_frequency(0);
+    QueryCpuSampler::clear_tag();
+    _sampler->collect();
+
+    std::string folded_stacks;
+    ASSERT_TRUE(_sampler->get_folded_stacks(query_id, &folded_stacks).ok());
+    EXPECT_GT(count_samples(folded_stacks, "fragment " + print_id(fragment_instance_id) +
+                                                   ";pipeline 0 task 0;"),
+              0);
+}
+
+} // namespace doris
@@ -361,6 +361,67 @@ TEST_F(TestRle, TestRoundTripRandomSequencesWithRuns) {
         EXPECT_EQ(string_rep, roundtrip_str);
     }
 }
+// The batches of BitReader::UnpackBatch() are unpacked by SIMD instructions if they are
+// available, they must read the same values as GetValue().
+TEST_F(TestRle, TestUnpackBatch) {
+    srand(time(nullptr));
+    for (int bit_width = 1; bit_width <= 32; ++bit_width) {
+        const int num_values = 1000 + random() % 100;
+        faststring buffer;
+        BitWriter writer(&buffer);
+        std::vector<uint32_t> values;
+        for (int i = 0; i < num_values; ++i) {
+            values.push_back(random() & ((1ULL << bit_width) - 1));
+            writer.PutValue(values.back(), bit_width);
+        }
+        writer.Flush();
+
+        BitReader reader(buffer.data(), buffer.size());
+        std::vector<uint32_t> read_values(num_values);
+        int num_read = 0;
+        while (num_read < num_values) {
+            // read a few values one by one to leave the byte boundary
+            int n = std::min<int>(random() % 3, num_values - num_read);
+            for (int i = 0; i < n; ++i) {
+                ASSERT_TRUE(reader.GetValue(bit_width, &read_values[num_read++]));
+            }
+            n = std::min<int>(random() % 200, num_values - num_read);
+            ASSERT_EQ(n, reader.UnpackBatch(bit_width, n, &read_values[num_read]));
+            num_read += n;
+        }
+        EXPECT_EQ(values, read_values) << "bit width " << bit_width;
+    }
+}
+
+TEST_F(TestRle, TestGetValues) {
+    srand(time(nullptr));
+    for (int bit_width = 1; bit_width <= 16; ++bit_width) {
+        faststring buffer;
+        RleEncoder<int16_t> encoder(&buffer, bit_width);
+        std::vector<int16_t> values;
+        while (values.size() < 5000) {
+            int16_t value = random() & ((1 << bit_width) - 1);
+            // mix the repeated runs with the literal runs
+            int repeat = random() % 4 == 0 ? random() % 50 + 1 : 1;
+            for (int i = 0; i < repeat; ++i) {
+                values.push_back(value);
+                encoder.Put(value);
+            }
+        }
+        encoder.Flush();
+
+        RleDecoder<int16_t> decoder(buffer.data(), buffer.size(), bit_width);
+        std::vector<int16_t> read_values(values.size());
+        size_t num_read = 0;
+        while (num_read < values.size()) {
+            size_t n = std::min<size_t>(random() % 100 + 1, values.size() - num_read);
+            ASSERT_EQ(n, decoder.get_values(&read_values[num_read], n));
+            num_read += n;
+        }
+        EXPECT_EQ(values, read_values) << "bit width " << bit_width;
+    }
+}
+
 TEST_F(TestRle, TestSkip) {
     faststring buffer(1);
     RleEncoder<bool> encoder(&buffer, 1);
@@ -0,0 +1,98 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "util/runtime_profile.h"
+#include "util/stopwatch.hpp"
+
+namespace doris {
+
+TEST(RuntimeProfileCounterTest, CoreLocalCounter) {
+    RuntimeProfile profile("test");
+    auto* counter = ADD_CORE_LOCAL_COUNTER(&profile, "Rows", TUnit::UNIT);
+    EXPECT_EQ(counter, profile.get_counter("Rows"));
+    EXPECT_EQ(counter, profile.add_core_local_counter("Rows", TUnit::UNIT));
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < 8; ++i) {
+        workers.emplace_back([counter]() {
+            for (int j = 0; j < 10000; ++j) {
+                COUNTER_UPDATE(counter, 1);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    EXPECT_EQ(80000, counter->value());
+
+    COUNTER_SET(counter, 10L);
+    EXPECT_EQ(10, counter->value());
+    COUNTER_UPDATE(counter, 5);
+    EXPECT_EQ(15, counter->value());
+
+    profile.divide(3);
+    EXPECT_EQ(5, counter->value());
+
+    RuntimeProfile merged("merged");
+    merged.merge(&profile);
+    merged.merge(&profile);
+    EXPECT_EQ(10, merged.get_counter("Rows")->value());
+
+    TRuntimeProfileTree tree;
+    profile.to_thrift(&tree);
+    ASSERT_EQ(1, tree.nodes.size());
+    bool found = false;
+    for (auto& thrift_counter : tree.nodes[0].counters) {
+        if (thrift_counter.name == "Rows") {
+            EXPECT_EQ(5, thrift_counter.value);
+            found = true;
+        }
+    }
+    EXPECT_TRUE(found);
+}
+
+TEST(RuntimeProfileCounterTest, TscTimer) {
+    RuntimeProfile profile("test");
+    auto* timer = ADD_CORE_LOCAL_TIMER(&profile, "Time");
+    MonotonicStopWatch watch;
+    watch.start();
+    {
+        SCOPED_TSC_TIMER(timer);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    watch.stop();
+    EXPECT_GE(timer->value(), 15 * 1000 * 1000);
+    EXPECT_LE(timer->value(), watch.elapsed_time() * 1.2);
+
+    TscStopWatch tsc_watch;
+    EXPECT_EQ(0, tsc_watch.elapsed_time());
+    tsc_watch.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    tsc_watch.stop();
+    uint64_t elapsed = tsc_watch.elapsed_time();
+    EXPECT_GE(elapsed, 4 * 1000 * 1000);
+    // not running
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_EQ(elapsed, tsc_watch.elapsed_time());
+}
+
+} // namespace doris
@@ -0,0 +1,60 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/space_saving.h"
+
+#include <gtest/gtest.h>
+
+namespace doris {
+
+TEST(SpaceSavingTest, HeavyHitters) {
+    SpaceSaving sketch(8);
+    // key 0 is 1/3 of the stream, key 1 is 1/6, the other keys are all distinct
+    for (uint64_t i = 0; i < 6000; ++i) {
+        if (i % 3 == 0) {
+            sketch.insert(0);
+        } else if (i % 6 == 1) {
+            sketch.insert(1);
+        } else {
+            sketch.insert(i + 100);
+        }
+    }
+    EXPECT_EQ(6000, sketch.total());
+
+    auto hot = sketch.heavy_hitters(6000 / 8);
+    ASSERT_EQ(2, hot.size());
+    std::sort(hot.begin(), hot.end(), [](const auto& a, const auto& b) { return a.key < b.key; });
+    EXPECT_EQ(0, hot[0].key);
+    EXPECT_EQ(1, hot[1].key);
+    // the count is overestimated by at most total / capacity
+    EXPECT_GE(hot[0].count, 2000);
+    EXPECT_LE(hot[0].count, 2000 + 6000 / 8);
+    EXPECT_GE(hot[1].count, 1000);
+    EXPECT_LE(hot[1].count, 1000 + 6000 / 8);
+
+    EXPECT_TRUE(sketch.heavy_hitters(3000).empty());
+}
+
+TEST(SpaceSavingTest, Uniform) {
+    SpaceSaving sketch(16);
+    for (uint64_t i = 0; i < 10000; ++i) {
+        sketch.insert(i % 1000);
+    }
+    EXPECT_TRUE(sketch.heavy_hitters(10000 / 16).empty());
+}
+
+} // namespace doris
@@ -190,6 +190,19 @@ TEST(StringToInt, Basic) {
     test_int_value<int64_t>("-0", 0, StringParser::PARSE_SUCCESS);
 }
 
+TEST(StringToInt, EightDigitChunks) {
+    test_int_value<int32_t>("123456789", 123456789, StringParser::PARSE_SUCCESS);
+    test_int_value<int32_t>("-87654321", -87654321, StringParser::PARSE_SUCCESS);
+    test_int_value<int64_t>("000000001234567890", 1234567890, StringParser::PARSE_SUCCESS);
+    test_int_value<int64_t>("123456789012345678", 123456789012345678,
+                            StringParser::PARSE_SUCCESS);
+    test_int_value<int64_t>("1234567x9012345678", 0, StringParser::PARSE_FAILURE);
+    test_int_value<int64_t>("12345678 90123456", 0, StringParser::PARSE_FAILURE);
+    test_int_value<int64_t>("x2345678", 0, StringParser::PARSE_FAILURE);
+    test_unsigned_int_value<uint64_t>("987654321098765432", 987654321098765432,
+                                      StringParser::PARSE_SUCCESS);
+}
+
 TEST(StringToInt, InvalidLeadingTrailing) {
     // Test that trailing garbage is not allowed.
     test_int_value<int8_t>("123xyz   ", 0, StringParser::PARSE_FAILURE);
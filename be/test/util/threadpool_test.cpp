@@ -945,4 +945,34 @@ TEST_F(ThreadPoolTest, TestThreadTokenConcurrent) {
     ASSERT_EQ(0, token1->num_tasks());
 }
 
+TEST_F(ThreadPoolTest, TestTokenFairness) {
+    ASSERT_TRUE(rebuild_pool_with_min_max(1, 1).ok());
+    std::unique_ptr<ThreadPoolToken> token1 =
+            _pool->new_token(ThreadPool::ExecutionMode::CONCURRENT);
+    std::unique_ptr<ThreadPoolToken> token2 =
+            _pool->new_token(ThreadPool::ExecutionMode::CONCURRENT);
+
+    CountDownLatch latch(1);
+    std::mutex lock;
+    std::vector<int> finished;
+    auto task = [&](int id) {
+        std::lock_guard<std::mutex> l(lock);
+        finished.push_back(id);
+    };
+    auto blocked_task = [&]() {
+        latch.wait();
+        task(10);
+    };
+    EXPECT_TRUE(token1->submit_func(blocked_task).ok());
+    EXPECT_TRUE(token1->submit_func(std::bind(task, 11)).ok());
+    EXPECT_TRUE(token1->submit_func(std::bind(task, 12)).ok());
+    EXPECT_TRUE(token2->submit_func(std::bind(task, 20)).ok());
+    latch.count_down();
+    token1->wait();
+    token2->wait();
+
+    // the tasks of token1 queued after the first one are run behind the task of token2
+    EXPECT_EQ((std::vector<int> {10, 20, 11, 12}), finished);
+}
+
 } // namespace doris
@@ -22,6 +22,7 @@
 #include "vec/aggregate_functions/aggregate_function.h"
 #include "vec/aggregate_functions/aggregate_function_simple_factory.h"
 #include "vec/aggregate_functions/aggregate_function_topn.h"
+#include "vec/aggregate_functions/aggregate_function_uniq.h"
 #include "vec/columns/column_vector.h"
 #include "vec/data_types/data_type.h"
 #include "vec/data_types/data_type_number.h"
@@ -60,6 +61,41 @@ TEST(AggTest, basic_test) {
     agg_function->destroy(place);
 }
 
+TEST(AggTest, merge_vec_rows_test) {
+    auto column_vector_int32 = ColumnVector<Int32>::create();
+    for (int i = 0; i < 4; i++) {
+        column_vector_int32->insert(cast_to_nearest_field_type(i + 1));
+    }
+    AggregateFunctionSimpleFactory factory;
+    register_aggregate_function_sum(factory);
+    DataTypes data_types = {std::make_shared<DataTypeInt32>()};
+    auto agg_function = factory.get("sum", data_types);
+    size_t size_of_data = agg_function->size_of_data();
+
+    // one state for each row to merge
+    std::unique_ptr<char[]> rhs(new char[size_of_data * 4]);
+    const IColumn* column[1] = {column_vector_int32.get()};
+    for (int i = 0; i < 4; i++) {
+        agg_function->create(rhs.get() + size_of_data * i);
+        agg_function->add(rhs.get() + size_of_data * i, column, i, nullptr);
+    }
+
+    // rows 0 and 2 go to the first place, rows 1 and 3 to the second one
+    std::unique_ptr<char[]> memory(new char[size_of_data * 2]);
+    AggregateDataPtr places[4] = {memory.get(), memory.get() + size_of_data, memory.get(),
+                                  memory.get() + size_of_data};
+    agg_function->create(places[0]);
+    agg_function->create(places[1]);
+    uint32_t rows[] = {1, 2, 3};
+    agg_function->merge_vec_rows(places, 0, rhs.get(), nullptr, rows, 3);
+    EXPECT_EQ(3, *reinterpret_cast<int32_t*>(places[0]));
+    EXPECT_EQ(2 + 4, *reinterpret_cast<int32_t*>(places[1]));
+
+    agg_function->destroy(places[0]);
+    agg_function->destroy(places[1]);
+    agg_function->destroy_vec(rhs.get(), 4);
+}
+
 TEST(AggTest, topn_test) {
     MutableColumns datas(2);
     datas[0] = ColumnString::create();
@@ -94,4 +130,32 @@ TEST(AggTest, topn_test) {
     EXPECT_EQ(result, expect_result);
     agg_function->destroy(place);
 }
+TEST(AggTest, uniq_exact_two_level_merge_test) {
+    using Data = AggregateFunctionUniqExactData<Int64>;
+    constexpr Int64 num_keys = Data::TWO_LEVEL_THRESHOLD * 2;
+    Data lhs;
+    Data rhs;
+    Data small;
+    for (Int64 i = 0; i < num_keys; ++i) {
+        lhs.insert(i);
+        rhs.insert(i + num_keys / 2);
+    }
+    small.insert(-1);
+    small.insert(0);
+    EXPECT_TRUE(lhs.is_two_level());
+    EXPECT_TRUE(rhs.is_two_level());
+    EXPECT_FALSE(small.is_two_level());
+
+    // submap by submap
+    lhs.merge(rhs);
+    EXPECT_EQ(num_keys * 3 / 2, lhs.size());
+    // a single level set into a two level one
+    lhs.merge(small);
+    EXPECT_EQ(num_keys * 3 / 2 + 1, lhs.size());
+    // a two level set into a single level one
+    small.merge(rhs);
+    EXPECT_TRUE(small.is_two_level());
+    EXPECT_EQ(num_keys + 2, small.size());
+}
+
 } // namespace doris::vectorized
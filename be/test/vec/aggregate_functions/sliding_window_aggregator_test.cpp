@@ -0,0 +1,93 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/aggregate_functions/sliding_window_aggregator.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+
+#include "vec/aggregate_functions/aggregate_function_simple_factory.h"
+#include "vec/columns/column_vector.h"
+#include "vec/data_types/data_type_number.h"
+
+namespace doris::vectorized {
+
+void register_aggregate_function_sum(AggregateFunctionSimpleFactory& factory);
+void register_aggregate_function_minmax(AggregateFunctionSimpleFactory& factory);
+
+// Compare with the brute force evaluation, for the frames [i + start_offset, i + end_offset].
+template <typename ResultColumn>
+void check_sliding_window(const std::string& name, int start_offset, int end_offset) {
+    constexpr int rows = 1000;
+    std::mt19937 rng(42);
+    auto column = ColumnVector<Int32>::create();
+    for (int i = 0; i < rows; i++) {
+        column->insert_value(rng() % 10000);
+    }
+    const IColumn* columns[1] = {column.get()};
+
+    AggregateFunctionSimpleFactory factory;
+    register_aggregate_function_sum(factory);
+    register_aggregate_function_minmax(factory);
+    auto function = factory.get(name, {std::make_shared<DataTypeInt32>()});
+    Arena arena;
+    SlidingWindowAggregator aggregator(function.get(), &arena);
+    aggregator.reset(0);
+
+    std::unique_ptr<char[]> memory(new char[function->size_of_data()]);
+    AggregateDataPtr place = memory.get();
+    function->create(place);
+    ResultColumn sliding;
+    ResultColumn brute_force;
+    for (int i = 0; i < rows; i++) {
+        int64_t start = std::min(std::max(i + start_offset, 0), rows);
+        int64_t end = std::max(std::min(i + end_offset + 1, rows), (int)start);
+        aggregator.slide(start, end, columns);
+        function->reset(place);
+        aggregator.merge_to(place);
+        function->insert_result_into(place, sliding);
+
+        function->reset(place);
+        function->add_range_single_place(0, rows, start, end, place, columns, &arena);
+        function->insert_result_into(place, brute_force);
+    }
+    function->destroy(place);
+
+    ASSERT_EQ(rows, sliding.size());
+    for (int i = 0; i < rows; i++) {
+        EXPECT_EQ(brute_force.get_element(i), sliding.get_element(i)) << name << " row " << i;
+    }
+}
+
+TEST(SlidingWindowAggregatorTest, Sum) {
+    check_sliding_window<ColumnInt64>("sum", -5, 3);
+    check_sliding_window<ColumnInt64>("sum", -100, 0);
+    check_sliding_window<ColumnInt64>("sum", 2, 7);
+    check_sliding_window<ColumnInt64>("sum", -7, -2);
+}
+
+TEST(SlidingWindowAggregatorTest, MinMax) {
+    check_sliding_window<ColumnInt32>("min", -5, 3);
+    check_sliding_window<ColumnInt32>("max", -5, 3);
+    check_sliding_window<ColumnInt32>("min", -300, -1);
+    check_sliding_window<ColumnInt32>("max", 0, 50);
+}
+
+} // namespace doris::vectorized
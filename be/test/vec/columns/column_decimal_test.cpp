@@ -21,9 +21,14 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <random>
 #include <string>
 
 #include "vec/columns/columns_number.h"
+#include "vec/core/block.h"
+#include "vec/core/sort_block.h"
+#include "vec/data_types/data_type_decimal.h"
+#include "vec/data_types/data_type_number.h"
 
 namespace doris::vectorized {
 
@@ -50,4 +55,50 @@ TEST(ColumnDecimalTest, CloneDecimalv2TypeTest) {
     EXPECT_EQ(true, column3->clone_resized(0)->is_decimalv2_type());
 }
 
+TEST(ColumnDecimalTest, GetPermutationTest) {
+    std::mt19937 rng(42);
+    auto column = ColumnDecimal64::create(0, 2);
+    for (int i = 0; i < 1000; ++i) {
+        column->get_data().push_back(Decimal64(static_cast<Int64>(rng() % 2000) - 1000));
+    }
+    for (bool reverse : {false, true}) {
+        IColumn::Permutation perm;
+        column->get_permutation(reverse, 0, 1, perm);
+        ASSERT_EQ(column->size(), perm.size());
+        for (size_t i = 1; i < perm.size(); ++i) {
+            int res = column->compare_at(perm[i - 1], perm[i], *column, 1);
+            EXPECT_TRUE(reverse ? res >= 0 : res <= 0) << "row " << i;
+        }
+    }
+}
+
+TEST(ColumnDecimalTest, SortBlockByTwoColumnsTest) {
+    std::mt19937 rng(42);
+    auto decimal_column = ColumnDecimal32::create(0, 2);
+    auto int_column = ColumnInt64::create();
+    for (int i = 0; i < 4000; ++i) {
+        // few distinct values, so the ranges of the second column are large
+        decimal_column->get_data().push_back(Decimal32(static_cast<Int32>(rng() % 4) - 2));
+        int_column->insert_value(static_cast<Int64>(rng()) - (1L << 31));
+    }
+    Block block;
+    block.insert({std::move(decimal_column), std::make_shared<DataTypeDecimal<Decimal32>>(9, 2),
+                  "k1"});
+    block.insert({std::move(int_column), std::make_shared<DataTypeInt64>(), "k2"});
+
+    SortDescription description {{0, -1, -1}, {1, 1, 1}};
+    Block sorted = block.clone_empty();
+    sort_block(block, sorted, description);
+    ASSERT_EQ(block.rows(), sorted.rows());
+    const auto& k1 = *sorted.get_by_position(0).column;
+    const auto& k2 = *sorted.get_by_position(1).column;
+    for (size_t i = 1; i < sorted.rows(); ++i) {
+        int res = k1.compare_at(i - 1, i, k1, 1);
+        EXPECT_GE(res, 0) << "row " << i;
+        if (res == 0) {
+            EXPECT_LE(k2.compare_at(i - 1, i, k2, 1), 0) << "row " << i;
+        }
+    }
+}
+
 } // namespace doris::vectorized
@@ -27,10 +27,12 @@
 #include "exec/schema_scanner.h"
 #include "gen_cpp/data.pb.h"
 #include "vec/columns/column_array.h"
+#include "vec/columns/column_const.h"
 #include "vec/columns/column_decimal.h"
 #include "vec/columns/column_nullable.h"
 #include "vec/columns/column_string.h"
 #include "vec/columns/column_vector.h"
+#include "vec/columns/columns_number.h"
 #include "vec/common/string_ref.h"
 #include "vec/data_types/data_type.h"
 #include "vec/data_types/data_type_array.h"
@@ -49,11 +51,12 @@ using vectorized::Int32;
 
 void block_to_pb(
         const vectorized::Block& block, PBlock* pblock,
-        segment_v2::CompressionTypePB compression_type = segment_v2::CompressionTypePB::SNAPPY) {
+        segment_v2::CompressionTypePB compression_type = segment_v2::CompressionTypePB::SNAPPY,
+        int be_exec_version = BeExecVersionManager::get_newest_version()) {
     size_t uncompressed_bytes = 0;
     size_t compressed_bytes = 0;
-    Status st = block.serialize(BeExecVersionManager::get_newest_version(), pblock,
-                                &uncompressed_bytes, &compressed_bytes, compression_type);
+    Status st = block.serialize(be_exec_version, pblock, &uncompressed_bytes, &compressed_bytes,
+                                compression_type);
     EXPECT_TRUE(st.ok());
     EXPECT_TRUE(uncompressed_bytes >= compressed_bytes);
     EXPECT_EQ(compressed_bytes, pblock->column_values().size());
@@ -107,7 +110,9 @@ void fill_block_with_array_string(vectorized::Block& block) {
     block.insert(test_array_string);
 }
 
-void serialize_and_deserialize_test(segment_v2::CompressionTypePB compression_type) {
+void serialize_and_deserialize_test(
+        segment_v2::CompressionTypePB compression_type,
+        int be_exec_version = BeExecVersionManager::get_newest_version()) {
     config::compress_rowbatches = true;
     // int
     {
@@ -120,12 +125,12 @@ void serialize_and_deserialize_test(segment_v2::CompressionTypePB compression_ty
         vectorized::ColumnWithTypeAndName type_and_name(vec->get_ptr(), data_type, "test_int");
         vectorized::Block block({type_and_name});
         PBlock pblock;
-        block_to_pb(block, &pblock, compression_type);
+        block_to_pb(block, &pblock, compression_type, be_exec_version);
         std::string s1 = pblock.DebugString();
 
         vectorized::Block block2(pblock);
         PBlock pblock2;
-        block_to_pb(block2, &pblock2, compression_type);
+        block_to_pb(block2, &pblock2, compression_type, be_exec_version);
         std::string s2 = pblock2.DebugString();
         EXPECT_EQ(s1, s2);
     }
@@ -141,12 +146,12 @@ void serialize_and_deserialize_test(segment_v2::CompressionTypePB compression_ty
                                                         "test_string");
         vectorized::Block block({type_and_name});
         PBlock pblock;
-        block_to_pb(block, &pblock, compression_type);
+        block_to_pb(block, &pblock, compression_type, be_exec_version);
         std::string s1 = pblock.DebugString();
 
         vectorized::Block block2(pblock);
         PBlock pblock2;
-        block_to_pb(block2, &pblock2, compression_type);
+        block_to_pb(block2, &pblock2, compression_type, be_exec_version);
         std::string s2 = pblock2.DebugString();
         EXPECT_EQ(s1, s2);
     }
@@ -165,12 +170,12 @@ void serialize_and_deserialize_test(segment_v2::CompressionTypePB compression_ty
                                                         decimal_data_type, "test_decimal");
         vectorized::Block block({type_and_name});
         PBlock pblock;
-        block_to_pb(block, &pblock, compression_type);
+        block_to_pb(block, &pblock, compression_type, be_exec_version);
         std::string s1 = pblock.DebugString();
 
         vectorized::Block block2(pblock);
         PBlock pblock2;
-        block_to_pb(block2, &pblock2, compression_type);
+        block_to_pb(block2, &pblock2, compression_type, be_exec_version);
         std::string s2 = pblock2.DebugString();
         EXPECT_EQ(s1, s2);
     }
@@ -191,12 +196,12 @@ void serialize_and_deserialize_test(segment_v2::CompressionTypePB compression_ty
                                                         "test_bitmap");
         vectorized::Block block({type_and_name});
         PBlock pblock;
-        block_to_pb(block, &pblock, compression_type);
+        block_to_pb(block, &pblock, compression_type, be_exec_version);
         std::string s1 = pblock.DebugString();
 
         vectorized::Block block2(pblock);
         PBlock pblock2;
-        block_to_pb(block2, &pblock2, compression_type);
+        block_to_pb(block2, &pblock2, compression_type, be_exec_version);
         std::string s2 = pblock2.DebugString();
         EXPECT_EQ(s1, s2);
     }
@@ -211,12 +216,12 @@ void serialize_and_deserialize_test(segment_v2::CompressionTypePB compression_ty
                                                         nullable_data_type, "test_nullable");
         vectorized::Block block({type_and_name});
         PBlock pblock;
-        block_to_pb(block, &pblock, compression_type);
+        block_to_pb(block, &pblock, compression_type, be_exec_version);
         std::string s1 = pblock.DebugString();
 
         vectorized::Block block2(pblock);
         PBlock pblock2;
-        block_to_pb(block2, &pblock2, compression_type);
+        block_to_pb(block2, &pblock2, compression_type, be_exec_version);
         std::string s2 = pblock2.DebugString();
         EXPECT_EQ(s1, s2);
     }
@@ -231,14 +236,14 @@ void serialize_and_deserialize_test(segment_v2::CompressionTypePB compression_ty
                 nullable_column->get_ptr(), nullable_data_type, "test_nullable_decimal");
         vectorized::Block block({type_and_name});
         PBlock pblock;
-        block_to_pb(block, &pblock, compression_type);
+        block_to_pb(block, &pblock, compression_type, be_exec_version);
         EXPECT_EQ(1, pblock.column_metas_size());
         EXPECT_TRUE(pblock.column_metas()[0].has_decimal_param());
         std::string s1 = pblock.DebugString();
 
         vectorized::Block block2(pblock);
         PBlock pblock2;
-        block_to_pb(block2, &pblock2, compression_type);
+        block_to_pb(block2, &pblock2, compression_type, be_exec_version);
         std::string s2 = pblock2.DebugString();
         EXPECT_EQ(s1, s2);
     }
@@ -255,12 +260,12 @@ void serialize_and_deserialize_test(segment_v2::CompressionTypePB compression_ty
                                                         data_type, "test_nullable_int32");
         vectorized::Block block({type_and_name});
         PBlock pblock;
-        block_to_pb(block, &pblock, compression_type);
+        block_to_pb(block, &pblock, compression_type, be_exec_version);
         std::string s1 = pblock.DebugString();
 
         vectorized::Block block2(pblock);
         PBlock pblock2;
-        block_to_pb(block2, &pblock2, compression_type);
+        block_to_pb(block2, &pblock2, compression_type, be_exec_version);
         std::string s2 = pblock2.DebugString();
         EXPECT_EQ(s1, s2);
     }
@@ -270,12 +275,12 @@ void serialize_and_deserialize_test(segment_v2::CompressionTypePB compression_ty
         fill_block_with_array_int(block);
         fill_block_with_array_string(block);
         PBlock pblock;
-        block_to_pb(block, &pblock, compression_type);
+        block_to_pb(block, &pblock, compression_type, be_exec_version);
         std::string s1 = pblock.DebugString();
 
         vectorized::Block block2(pblock);
         PBlock pblock2;
-        block_to_pb(block2, &pblock2, compression_type);
+        block_to_pb(block2, &pblock2, compression_type, be_exec_version);
         std::string s2 = pblock2.DebugString();
         EXPECT_EQ(s1, s2);
     }
@@ -285,6 +290,115 @@ TEST(BlockTest, SerializeAndDeserializeBlock) {
     config::compress_rowbatches = true;
     serialize_and_deserialize_test(segment_v2::CompressionTypePB::SNAPPY);
     serialize_and_deserialize_test(segment_v2::CompressionTypePB::LZ4);
+    // the whole block is compressed before be_exec_version 2
+    serialize_and_deserialize_test(segment_v2::CompressionTypePB::SNAPPY, 1);
+    serialize_and_deserialize_test(segment_v2::CompressionTypePB::LZ4, 1);
+}
+
+TEST(BlockTest, SerializeColumnsSeparately) {
+    config::compress_rowbatches = true;
+    // a compressible column and a column which is too small to be compressed
+    auto vec = vectorized::ColumnVector<Int32>::create();
+    auto small_vec = vectorized::ColumnVector<Int32>::create();
+    for (int i = 0; i < 4096; ++i) {
+        vec->get_data().push_back(i % 16);
+    }
+    small_vec->get_data().push_back(1);
+    vectorized::DataTypePtr data_type(std::make_shared<vectorized::DataTypeInt32>());
+    vectorized::Block block({{vec->get_ptr(), data_type, "test_int"},
+                             {small_vec->get_ptr(), data_type, "test_small_int"}});
+    PBlock pblock;
+    block_to_pb(block, &pblock, segment_v2::CompressionTypePB::LZ4);
+    EXPECT_EQ(2, pblock.column_values_metas_size());
+    EXPECT_EQ(segment_v2::CompressionTypePB::LZ4, pblock.column_values_metas(0).compression_type());
+    EXPECT_LT(pblock.column_values_metas(0).compressed_size(),
+              pblock.column_values_metas(0).uncompressed_size());
+    EXPECT_EQ(segment_v2::CompressionTypePB::NO_COMPRESSION,
+              pblock.column_values_metas(1).compression_type());
+
+    vectorized::Block block2(pblock);
+    EXPECT_EQ(block.dump_data(0, 4096), block2.dump_data(0, 4096));
+}
+
+TEST(BlockTest, DeserializeReuseColumns) {
+    auto vec = vectorized::ColumnVector<Int32>::create();
+    auto strings = vectorized::ColumnString::create();
+    for (int i = 0; i < 1024; ++i) {
+        vec->get_data().push_back(i);
+        std::string str = std::to_string(i);
+        strings->insert_data(str.c_str(), str.size());
+    }
+    vectorized::Block block({{vec->get_ptr(), std::make_shared<vectorized::DataTypeInt32>(), "a"},
+                             {strings->get_ptr(), std::make_shared<vectorized::DataTypeString>(),
+                              "b"}});
+    PBlock pblock;
+    block_to_pb(block, &pblock);
+
+    vectorized::Block block2(pblock);
+    EXPECT_EQ(block.dump_data(0, 1024), block2.dump_data(0, 1024));
+    const auto* int_column = block2.get_by_position(0).column.get();
+    block2.clear_column_data();
+    block2.deserialize(pblock);
+    // the columns of the same types are reused
+    EXPECT_EQ(int_column, block2.get_by_position(0).column.get());
+    EXPECT_EQ(block.dump_data(0, 1024), block2.dump_data(0, 1024));
+
+    // the shared columns are not reused
+    auto shared_column = block2.get_by_position(0).column;
+    block2.deserialize(pblock);
+    EXPECT_NE(shared_column.get(), block2.get_by_position(0).column.get());
+    EXPECT_EQ(1024, shared_column->size());
+    EXPECT_EQ(block.dump_data(0, 1024), block2.dump_data(0, 1024));
+}
+
+TEST(BlockTest, SerializeStringDictionary) {
+    config::enable_string_dictionary_serialization = true;
+    auto low_cardinality = vectorized::ColumnString::create();
+    auto high_cardinality = vectorized::ColumnString::create();
+    for (int i = 0; i < 4096; ++i) {
+        std::string value = "value_" + std::to_string(i % 10);
+        low_cardinality->insert_data(value.c_str(), value.size());
+        value = "value_" + std::to_string(i);
+        high_cardinality->insert_data(value.c_str(), value.size());
+    }
+    vectorized::DataTypePtr data_type(std::make_shared<vectorized::DataTypeString>());
+    vectorized::Block block({{low_cardinality->get_ptr(), data_type, "low"},
+                             {high_cardinality->get_ptr(), data_type, "high"}});
+    PBlock pblock;
+    block_to_pb(block, &pblock, segment_v2::CompressionTypePB::NO_COMPRESSION);
+    // the low cardinality column is sent as the codes of the rows
+    EXPECT_LT(pblock.column_values_metas(0).uncompressed_size(),
+              data_type->get_uncompressed_serialized_bytes(*low_cardinality, 4) / 2);
+    EXPECT_EQ(pblock.column_values_metas(1).uncompressed_size(),
+              data_type->get_uncompressed_serialized_bytes(*high_cardinality, 4));
+
+    vectorized::Block block2(pblock);
+    EXPECT_EQ(block.dump_data(0, 4096), block2.dump_data(0, 4096));
+}
+
+TEST(BlockTest, MergeFilter) {
+    auto filter_column = vectorized::ColumnUInt8::create();
+    auto nested = vectorized::ColumnUInt8::create();
+    auto null_map = vectorized::ColumnUInt8::create();
+    for (int i = 0; i < 8; ++i) {
+        filter_column->insert_value(i % 2);
+        nested->insert_value(1);
+        null_map->insert_value(i < 4);
+    }
+    auto nullable_column = vectorized::ColumnNullable::create(std::move(nested),
+                                                              std::move(null_map));
+
+    vectorized::IColumn::Filter filter(8, 1);
+    EXPECT_TRUE(vectorized::Block::merge_filter(*filter_column, &filter));
+    EXPECT_TRUE(vectorized::Block::merge_filter(*nullable_column, &filter));
+    // only the odd rows which are not null pass
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(i >= 4 && i % 2 == 1, filter[i]);
+    }
+
+    auto const_false = vectorized::ColumnConst::create(filter_column->clone_resized(1), 8);
+    EXPECT_FALSE(vectorized::Block::merge_filter(*const_false, &filter));
+    EXPECT_EQ(0, filter[5]);
 }
 
 TEST(BlockTest, dump_data) {
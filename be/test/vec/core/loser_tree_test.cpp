@@ -0,0 +1,106 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/core/loser_tree.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace doris::vectorized {
+
+namespace {
+
+struct SortedRun {
+    std::vector<int> values;
+    size_t pos = 0;
+};
+
+struct SortedRunGreater {
+    size_t* comparisons;
+
+    bool operator()(const SortedRun* lhs, const SortedRun* rhs) const {
+        ++*comparisons;
+        return lhs->values[lhs->pos] > rhs->values[rhs->pos];
+    }
+};
+
+// Merges the runs with the tree, and returns the number of comparisons.
+size_t merge_runs(std::vector<SortedRun>& runs, std::vector<int>* merged) {
+    size_t comparisons = 0;
+    LoserTree<SortedRun*, SortedRunGreater> tree(SortedRunGreater {&comparisons});
+    std::vector<SortedRun*> inputs;
+    for (auto& run : runs) {
+        if (!run.values.empty()) {
+            inputs.push_back(&run);
+        }
+    }
+    tree.init(inputs);
+    while (!tree.empty()) {
+        SortedRun* top = tree.top();
+        merged->push_back(top->values[top->pos]);
+        if (++top->pos < top->values.size()) {
+            tree.update_top();
+        } else {
+            tree.pop_top();
+        }
+    }
+    return comparisons;
+}
+
+} // namespace
+
+TEST(LoserTreeTest, merge) {
+    std::mt19937 rng(42);
+    for (size_t num_runs : {1, 2, 3, 7, 8, 100}) {
+        std::vector<SortedRun> runs(num_runs);
+        std::vector<int> expected;
+        for (auto& run : runs) {
+            size_t rows = rng() % 50;
+            for (size_t i = 0; i < rows; ++i) {
+                run.values.push_back(rng() % 1000);
+            }
+            std::sort(run.values.begin(), run.values.end());
+            expected.insert(expected.end(), run.values.begin(), run.values.end());
+        }
+        std::sort(expected.begin(), expected.end());
+
+        std::vector<int> merged;
+        merge_runs(runs, &merged);
+        EXPECT_EQ(expected, merged) << num_runs;
+    }
+}
+
+TEST(LoserTreeTest, runs) {
+    // the runs don't overlap, so the top is only compared with the runner-up
+    std::vector<SortedRun> runs(64);
+    for (size_t i = 0; i < runs.size(); ++i) {
+        for (int j = 0; j < 100; ++j) {
+            runs[i].values.push_back(i * 100 + j);
+        }
+    }
+    std::vector<int> merged;
+    size_t comparisons = merge_runs(runs, &merged);
+    ASSERT_EQ(6400, merged.size());
+    EXPECT_TRUE(std::is_sorted(merged.begin(), merged.end()));
+    // a heap takes about 2 * log2(64) comparisons per row
+    EXPECT_LT(comparisons, 2 * merged.size());
+}
+
+} // namespace doris::vectorized
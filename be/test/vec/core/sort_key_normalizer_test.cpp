@@ -0,0 +1,118 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/core/sort_key_normalizer.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+
+#include "vec/columns/column_decimal.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+
+namespace doris::vectorized {
+
+class SortKeyNormalizerTest : public testing::Test {
+protected:
+    void SetUp() override {
+        std::mt19937 rng(42);
+        auto ints = ColumnInt32::create();
+        auto null_map = ColumnUInt8::create();
+        auto strings = ColumnString::create();
+        auto decimals = ColumnDecimal64::create(0, 2);
+        for (size_t i = 0; i < ROWS; ++i) {
+            // few distinct values, so that the later columns are compared too
+            ints->insert_value(static_cast<Int32>(rng() % 5) - 2);
+            null_map->insert_value(rng() % 4 == 0);
+            std::string value(rng() % 3, 'a');
+            if (rng() % 2) {
+                value.push_back('\0');
+            }
+            if (rng() % 2) {
+                value.push_back('b');
+            }
+            strings->insert_data(value.data(), value.size());
+            decimals->get_data().push_back(Decimal64(static_cast<Int64>(rng() % 3) - 1));
+        }
+        _columns.push_back(ColumnNullable::create(std::move(ints), std::move(null_map)));
+        _columns.push_back(std::move(strings));
+        _columns.push_back(std::move(decimals));
+    }
+
+    // Check that the normalized keys are ordered as comparing the columns one by one.
+    void check(const SortDescription& desc) {
+        ColumnRawPtrs columns;
+        for (const auto& column : _columns) {
+            columns.push_back(column.get());
+        }
+        ASSERT_TRUE(SortKeyNormalizer::can_normalize(columns));
+        auto keys = ColumnString::create();
+        ASSERT_TRUE(SortKeyNormalizer::normalize(columns, desc, keys.get()));
+        ASSERT_EQ(ROWS, keys->size());
+        for (size_t a = 0; a < ROWS; ++a) {
+            for (size_t b = 0; b < ROWS; b += 7) {
+                int expected = 0;
+                for (size_t i = 0; i < columns.size() && expected == 0; ++i) {
+                    expected = desc[i].direction * columns[i]->compare_at(a, b, *columns[i],
+                                                                         desc[i].nulls_direction);
+                }
+                int res = SortKeyNormalizer::compare(*keys, a, *keys, b);
+                EXPECT_EQ(expected > 0, res > 0) << "rows " << a << " " << b;
+                EXPECT_EQ(expected < 0, res < 0) << "rows " << a << " " << b;
+            }
+        }
+    }
+
+    static constexpr size_t ROWS = 500;
+    Columns _columns;
+};
+
+TEST_F(SortKeyNormalizerTest, Ascending) {
+    check({{0, 1, 1}, {1, 1, 1}, {2, 1, 1}});
+    check({{0, 1, -1}, {1, 1, 1}, {2, 1, 1}});
+}
+
+TEST_F(SortKeyNormalizerTest, Descending) {
+    check({{0, -1, -1}, {1, -1, 1}, {2, -1, 1}});
+    check({{0, -1, 1}, {1, 1, 1}, {2, -1, 1}});
+}
+
+TEST_F(SortKeyNormalizerTest, GetPermutation) {
+    ColumnRawPtrs columns {_columns[1].get(), _columns[2].get()};
+    SortDescription desc {{1, 1, 1}, {2, -1, 1}};
+    auto keys = ColumnString::create();
+    ASSERT_TRUE(SortKeyNormalizer::normalize(columns, desc, keys.get()));
+    for (size_t limit : {0, 10}) {
+        IColumn::Permutation perm;
+        SortKeyNormalizer::get_permutation(*keys, limit, perm);
+        ASSERT_EQ(ROWS, perm.size());
+        size_t sorted_rows = limit ? limit : ROWS;
+        for (size_t i = 1; i < sorted_rows; ++i) {
+            EXPECT_LE(SortKeyNormalizer::compare(*keys, perm[i - 1], *keys, perm[i]), 0);
+        }
+    }
+}
+
+TEST_F(SortKeyNormalizerTest, CanNotNormalize) {
+    auto floats = ColumnFloat64::create();
+    floats->insert_value(1.0);
+    EXPECT_FALSE(SortKeyNormalizer::can_normalize({_columns[0].get(), floats.get()}));
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,80 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/format/file_meta_cache.h"
+
+#include <gtest/gtest.h>
+
+namespace doris::vectorized {
+
+TEST(FileMetaCacheTest, get_key) {
+    TFileRangeDesc range;
+    range.__set_path("s3://bucket/a.parquet");
+    // unknown modification time
+    EXPECT_EQ("", FileMetaCache::get_key("parquet", range, 100));
+
+    range.__set_modification_time(1000);
+    std::string key = FileMetaCache::get_key("parquet", range, 100);
+    EXPECT_NE("", key);
+    EXPECT_NE(key, FileMetaCache::get_key("orc", range, 100));
+    EXPECT_NE(key, FileMetaCache::get_key("parquet", range, 101));
+    range.__set_modification_time(1001);
+    EXPECT_NE(key, FileMetaCache::get_key("parquet", range, 100));
+
+    // the data files of iceberg are never rewritten
+    TFileRangeDesc iceberg_range;
+    iceberg_range.__set_path("s3://bucket/b.parquet");
+    TTableFormatFileDesc table_format;
+    table_format.__set_table_format_type("iceberg");
+    iceberg_range.__set_table_format_params(table_format);
+    EXPECT_NE("", FileMetaCache::get_key("parquet", iceberg_range, 100));
+}
+
+TEST(FileMetaCacheTest, insert_and_lookup) {
+    FileMetaCache cache(1024 * 1024);
+    FileMetaCache::Handle handle;
+    EXPECT_FALSE(cache.lookup("a", &handle));
+    EXPECT_FALSE(handle.valid());
+
+    cache.insert("a", new std::string("tail of a"), 100, &handle);
+    ASSERT_TRUE(handle.valid());
+    EXPECT_EQ("tail of a", *handle.data<std::string>());
+
+    FileMetaCache::Handle other;
+    ASSERT_TRUE(cache.lookup("a", &other));
+    EXPECT_EQ(handle.data<std::string>(), other.data<std::string>());
+}
+
+TEST(FileMetaCacheTest, evict) {
+    // 16 shards of 10000 bytes
+    FileMetaCache cache(16 * 10000);
+    for (int i = 0; i < 100; ++i) {
+        FileMetaCache::Handle handle;
+        cache.insert(std::to_string(i), new std::string(std::to_string(i)), 4000, &handle);
+    }
+    int num_cached = 0;
+    for (int i = 0; i < 100; ++i) {
+        FileMetaCache::Handle handle;
+        num_cached += cache.lookup(std::to_string(i), &handle);
+    }
+    EXPECT_LT(num_cached, 100);
+    FileMetaCache::Handle handle;
+    ASSERT_TRUE(cache.lookup("99", &handle));
+    EXPECT_EQ("99", *handle.data<std::string>());
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,65 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/join/range_join_index.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+namespace doris::vectorized {
+
+TEST(RangeJoinIndexTest, find) {
+    RangeJoinIndex index({{0, 10, 0}, {5, 5, 1}, {-3, 2, 2}, {20, 30, 3}, {8, 4, 4}});
+    // the empty range is dropped
+    EXPECT_EQ(4, index.num_ranges());
+
+    std::vector<int> rows;
+    index.find(5, &rows);
+    EXPECT_EQ(std::vector<int>({0, 1}), rows);
+    index.find(0, &rows);
+    EXPECT_EQ(std::vector<int>({0, 2}), rows);
+    index.find(10, &rows);
+    EXPECT_EQ(std::vector<int>({0}), rows);
+    index.find(15, &rows);
+    EXPECT_TRUE(rows.empty());
+    index.find(6, &rows);
+    EXPECT_EQ(std::vector<int>({0}), rows);
+}
+
+TEST(RangeJoinIndexTest, open_ranges) {
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    RangeJoinIndex index({{-inf, 3, 0}, {7, inf, 1}, {-inf, inf, 2}});
+
+    std::vector<int> rows;
+    index.find(-100, &rows);
+    EXPECT_EQ(std::vector<int>({0, 2}), rows);
+    index.find(5, &rows);
+    EXPECT_EQ(std::vector<int>({2}), rows);
+    index.find(1e18, &rows);
+    EXPECT_EQ(std::vector<int>({1, 2}), rows);
+}
+
+TEST(RangeJoinIndexTest, empty) {
+    RangeJoinIndex index({});
+    EXPECT_EQ(0, index.num_ranges());
+    std::vector<int> rows {1, 2};
+    index.find(0, &rows);
+    EXPECT_TRUE(rows.empty());
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,78 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/scan/scan_cache.h"
+
+#include <gtest/gtest.h>
+
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_number.h"
+
+namespace doris::vectorized {
+
+static Block make_block(std::vector<int32_t> values) {
+    auto column = ColumnInt32::create();
+    for (auto value : values) {
+        column->insert_value(value);
+    }
+    return Block({{std::move(column), std::make_shared<DataTypeInt32>(), "a"}});
+}
+
+TEST(ScanCacheTest, insert_and_lookup) {
+    ScanCache cache(1024 * 1024, 16);
+    ScanCache::CacheKey key {"digest", 10001, 5, "[(-oo);(+oo)]"};
+    ScanCacheHandle handle;
+    EXPECT_FALSE(cache.lookup(key, &handle));
+    EXPECT_FALSE(handle.valid());
+
+    auto value = std::make_unique<ScanCache::CacheValue>();
+    value->blocks.push_back(make_block({1, 2, 3}));
+    value->blocks.push_back(make_block({4}));
+    cache.insert(key, value.release(), 100);
+
+    ASSERT_TRUE(cache.lookup(key, &handle));
+    ASSERT_EQ(2, handle.value()->blocks.size());
+    EXPECT_EQ(3, handle.value()->blocks[0].rows());
+    EXPECT_EQ(1, handle.value()->blocks[1].rows());
+
+    // any part of the key differs
+    ScanCacheHandle other;
+    EXPECT_FALSE(cache.lookup({"digest2", 10001, 5, "[(-oo);(+oo)]"}, &other));
+    EXPECT_FALSE(cache.lookup({"digest", 10002, 5, "[(-oo);(+oo)]"}, &other));
+    EXPECT_FALSE(cache.lookup({"digest", 10001, 6, "[(-oo);(+oo)]"}, &other));
+    EXPECT_FALSE(cache.lookup({"digest", 10001, 5, "[(1);(+oo)]"}, &other));
+}
+
+TEST(ScanCacheTest, copy_block) {
+    Block block = make_block({1, 2, 3});
+    Block copy = ScanCache::copy_block(block);
+    ASSERT_EQ(3, copy.rows());
+    EXPECT_NE(block.get_by_position(0).column.get(), copy.get_by_position(0).column.get());
+
+    // the copy is mutated by the scanner without changing the cached block
+    copy.get_by_position(0).column->assume_mutable()->insert_default();
+    EXPECT_EQ(4, copy.rows());
+    EXPECT_EQ(3, block.rows());
+    EXPECT_EQ(1, block.get_by_position(0).column->get_int(0));
+}
+
+TEST(ScanCacheTest, disabled) {
+    ScanCache cache(0, 16);
+    EXPECT_FALSE(cache.enabled());
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,109 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/scan/shared_tablet_scan.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_number.h"
+
+namespace doris::vectorized {
+
+static Block make_block(int32_t rows) {
+    auto column = ColumnInt32::create();
+    for (int32_t i = 0; i < rows; ++i) {
+        column->insert_value(i);
+    }
+    return Block({{std::move(column), std::make_shared<DataTypeInt32>(), "a"}});
+}
+
+TEST(SharedTabletScanTest, lead_and_follow) {
+    bool leader = false;
+    auto scan = SharedTabletScans::instance()->lead_or_follow("lead_and_follow", &leader);
+    EXPECT_TRUE(leader);
+    scan->publish(make_block(10));
+
+    EXPECT_EQ(scan, SharedTabletScans::instance()->lead_or_follow("lead_and_follow", &leader));
+    EXPECT_FALSE(leader);
+    auto follower = scan->attach();
+    ASSERT_NE(nullptr, follower);
+    EXPECT_EQ(10, follower->start_row);
+
+    std::shared_ptr<const Block> block;
+    EXPECT_TRUE(scan->next(follower.get(), 1, &block));
+    EXPECT_EQ(nullptr, block);
+
+    scan->publish(make_block(3));
+    scan->publish(make_block(4));
+    scan->finish(true);
+    EXPECT_EQ(nullptr, scan->attach());
+
+    ASSERT_TRUE(scan->next(follower.get(), 1, &block));
+    EXPECT_EQ(3, block->rows());
+    ASSERT_TRUE(scan->next(follower.get(), 1, &block));
+    EXPECT_EQ(4, block->rows());
+    EXPECT_FALSE(scan->next(follower.get(), 1, &block));
+    EXPECT_TRUE(follower->finished);
+    EXPECT_EQ(7, follower->received_rows);
+
+    // a new scan of the key after the leader finished
+    EXPECT_NE(scan, SharedTabletScans::instance()->lead_or_follow("lead_and_follow", &leader));
+    EXPECT_TRUE(leader);
+}
+
+TEST(SharedTabletScanTest, detach) {
+    bool leader = false;
+    auto scan = SharedTabletScans::instance()->lead_or_follow("detach", &leader);
+    auto follower = scan->attach();
+    scan->publish(make_block(5));
+    scan->detach(follower.get());
+    scan->publish(make_block(6));
+
+    std::shared_ptr<const Block> block;
+    // the queued block is still taken
+    ASSERT_TRUE(scan->next(follower.get(), 1, &block));
+    EXPECT_EQ(5, block->rows());
+    EXPECT_FALSE(scan->next(follower.get(), 1, &block));
+    EXPECT_FALSE(follower->finished);
+    EXPECT_EQ(0, follower->start_row);
+    EXPECT_EQ(5, follower->received_rows);
+    scan->finish(false);
+}
+
+TEST(SharedTabletScanTest, max_queued_bytes) {
+    int64_t max_queued_bytes = config::shared_scan_max_queued_bytes;
+    Block block = make_block(1000);
+    config::shared_scan_max_queued_bytes = block.allocated_bytes() * 2;
+
+    bool leader = false;
+    auto scan = SharedTabletScans::instance()->lead_or_follow("max_queued_bytes", &leader);
+    auto follower = scan->attach();
+    for (int i = 0; i < 3; ++i) {
+        scan->publish(block);
+    }
+    EXPECT_TRUE(follower->detached);
+    EXPECT_EQ(2000, follower->received_rows);
+    scan->finish(true);
+    // the follower is detached before the leader finished
+    EXPECT_FALSE(follower->finished);
+
+    config::shared_scan_max_queued_bytes = max_queued_bytes;
+}
+
+} // namespace doris::vectorized
@@ -478,6 +478,13 @@ TEST_F(VOlapTableSinkTest, normal) {
     test_normal(1);
 }
 
+TEST_F(VOlapTableSinkTest, multiple_add_block_in_flight) {
+    auto max_in_flight = config::tablet_writer_add_block_max_in_flight;
+    config::tablet_writer_add_block_max_in_flight = 4;
+    test_normal(1);
+    config::tablet_writer_add_block_max_in_flight = max_in_flight;
+}
+
 TEST_F(VOlapTableSinkTest, fallback) {
     test_normal(0);
 }
@@ -0,0 +1,65 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exprs/vfused_expr.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "vec/core/types.h"
+
+namespace doris::vectorized {
+
+using OpCode = FusedProgram::OpCode;
+using OperandKind = FusedProgram::OperandKind;
+
+TEST(VFusedExprTest, ExecuteProgram) {
+    // ($0 + $1) * 2.0 > $1, over more rows than a batch
+    FusedProgram program;
+    program.constants = {2.0};
+    program.instructions = {
+            {OpCode::ADD, {OperandKind::INPUT, 0}, {OperandKind::INPUT, 1}, 0},
+            {OpCode::MUL, {OperandKind::REGISTER, 0}, {OperandKind::CONSTANT, 0}, 0},
+            {OpCode::GT, {OperandKind::REGISTER, 0}, {OperandKind::INPUT, 1}, 0}};
+    program.num_registers = 1;
+    EXPECT_TRUE(program.is_predicate());
+
+    size_t rows = FusedProgram::BATCH_SIZE * 2 + 7;
+    std::vector<double> a(rows);
+    std::vector<double> b(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        a[i] = static_cast<double>(i % 10) - 5;
+        b[i] = static_cast<double>(i % 7);
+    }
+    std::vector<UInt8> result(rows);
+    program.execute({a.data(), b.data()}, rows, result.data());
+    for (size_t i = 0; i < rows; ++i) {
+        EXPECT_EQ((a[i] + b[i]) * 2.0 > b[i], result[i]) << i;
+    }
+
+    // without the comparison the output is the doubles
+    program.instructions.pop_back();
+    EXPECT_FALSE(program.is_predicate());
+    std::vector<double> values(rows);
+    program.execute({a.data(), b.data()}, rows, values.data());
+    for (size_t i = 0; i < rows; ++i) {
+        EXPECT_EQ((a[i] + b[i]) * 2.0, values[i]) << i;
+    }
+}
+
+} // namespace doris::vectorized
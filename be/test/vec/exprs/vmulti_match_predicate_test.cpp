@@ -0,0 +1,56 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exprs/vmulti_match_predicate.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "vec/functions/like.h"
+
+namespace doris::vectorized {
+
+TEST(VMultiMatchPredicateTest, MatchAnyPattern) {
+    LikeSearchState search_state;
+    std::vector<std::string> regexes(2);
+    FunctionLike::convert_like_pattern(&search_state, "%ab_d%", &regexes[0]);
+    FunctionLike::convert_like_pattern(&search_state, "x%", &regexes[1]);
+    regexes.push_back("[0-9]{3}$");
+
+    std::shared_ptr<const multiregexps::Regexps> regexps;
+    EXPECT_TRUE(VMultiMatchPredicate::compile(regexes, &regexps).ok());
+    std::shared_ptr<const multiregexps::Regexps> cached;
+    EXPECT_TRUE(VMultiMatchPredicate::compile(regexes, &cached).ok());
+    EXPECT_EQ(regexps.get(), cached.get());
+
+    auto values = ColumnString::create();
+    std::vector<std::string> data = {"", "zabcdz", "abd", "xyz", "yx", "id 123", "12a"};
+    for (const auto& value : data) {
+        values->insert_data(value.data(), value.size());
+    }
+    ColumnUInt8::Container result;
+    EXPECT_TRUE(VMultiMatchPredicate::match(*regexps, *values, result).ok());
+    std::vector<UInt8> expected = {0, 1, 0, 1, 0, 1, 0};
+    EXPECT_EQ(expected, std::vector<UInt8>(result.begin(), result.end()));
+
+    // an invalid regex is an error instead of a crash
+    EXPECT_FALSE(VMultiMatchPredicate::compile({"(a"}, &regexps).ok());
+}
+
+} // namespace doris::vectorized
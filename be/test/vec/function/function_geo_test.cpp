@@ -189,6 +189,15 @@ TEST(VGeoFunctionsTest, function_geo_st_contains) {
                             {{Null(), buf3}, Null()}};
 
         check_function<DataTypeUInt8, true>(func_name, input_types, data_set);
+
+        // the constant polygon is decoded once
+        InputTypeSet const_input_types = {Consted {TypeIndex::String}, TypeIndex::String};
+        DataSet contained = {{{buf1, buf2}, (uint8_t)1}};
+        check_function<DataTypeUInt8, true>(func_name, const_input_types, contained);
+        DataSet not_contained = {{{buf1, buf3}, (uint8_t)0}};
+        check_function<DataTypeUInt8, true>(func_name, const_input_types, not_contained);
+        DataSet null_point = {{{buf1, Null()}, Null()}};
+        check_function<DataTypeUInt8, true>(func_name, const_input_types, null_point);
     }
 }
 
@@ -772,6 +772,26 @@ TEST(FunctionJsonbTEST, JsonbExtractStringTest) {
     };
 
     check_function<DataTypeString, true>(func_name, input_types, data_set);
+
+    // path is constant value
+    InputTypeSet const_path_input_types = {TypeIndex::JSONB, Consted {TypeIndex::String}};
+    data_set = {
+            {{STRING(R"([{"k1":"v41", "k2": 400}, 1, "a", 3.14])"), STRING("$[0].k1")},
+             STRING("v41")},
+            {{STRING(R"({"k1":"v31", "k2": [1, {"k3": 300}]})"), STRING("$.k2[1].k3")},
+             STRING("300")},
+            {{STRING(R"({"k1":"v31", "k2": 300})"), STRING("$.k2")}, STRING("300")},
+            {{STRING(R"({"k1":"v31", "k2": 300})"), STRING("$.k3")}, Null()},
+            {{STRING(R"({"k1":"v31", "k2": 300})"), STRING("$.k1.")}, Null()},
+            {{STRING(R"({"k1":"v31", "k2": 300})"), STRING("$[0")}, Null()},
+            {{STRING(R"({"k1":"v31", "k2": 300})"), STRING("$")},
+             STRING(R"({"k1":"v31","k2":300})")},
+    };
+    for (const auto& line : data_set) {
+        DataSet const_path_dataset = {line};
+        check_function<DataTypeString, true>(func_name, const_path_input_types,
+                                             const_path_dataset);
+    }
 }
 
 TEST(FunctionJsonbTEST, JsonbExtractIntTest) {
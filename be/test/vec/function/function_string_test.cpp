@@ -46,6 +46,9 @@ TEST(function_string_test, function_string_substr_test) {
                 {{std::string(""), 0, 4}, std::string("")},
                 {{std::string("123"), 0, 4}, std::string("")},
                 {{std::string("123"), 1, 0}, std::string("")},
+                {{std::string("你好世界你好世界你好世界"), 7, 3}, std::string("世界你")},
+                {{std::string("你好世界你好世界你好世界"), -10, 4}, std::string("世界你好")},
+                {{std::string("你好世界你好世界你好世界"), 13, 1}, Null()},
                 {{Null(), 5, 4}, Null()}};
 
         check_function<DataTypeString, true>(func_name, input_types, data_set);
@@ -306,6 +309,7 @@ TEST(function_string_test, function_char_length_test) {
     DataSet data_set = {{{std::string("")}, 0},    {{std::string("aa")}, 2},
                         {{std::string("我")}, 1},  {{std::string("我a")}, 2},
                         {{std::string("a我")}, 2}, {{std::string("123")}, 3},
+                        {{std::string("a你好世界你好世界你好世界b")}, 14},
                         {{Null()}, Null()}};
 
     check_function<DataTypeInt32, true>(func_name, input_types, data_set);
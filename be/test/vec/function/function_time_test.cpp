@@ -1659,6 +1659,60 @@ TEST(VTimestampFunctionsTest, datetrunc_test) {
 
         check_function<DataTypeDateTimeV2, true>(func_name, input_types, data_set);
     }
+
+    {
+        InputTypeSet input_types = {TypeIndex::DateTimeV2, Consted {TypeIndex::String}};
+
+        DataSet data_set = {{{std::string("2022-10-08 11:44:23"), std::string("minute")},
+                             str_to_datetime_v2("2022-10-08 11:44:00", "%Y-%m-%d %H:%i:%s")},
+                            {{std::string("2022-10-08 11:44:23"), std::string("day")},
+                             str_to_datetime_v2("2022-10-08 00:00:00", "%Y-%m-%d %H:%i:%s")},
+                            {{std::string("2022-10-08 11:44:23"), std::string("quarter")},
+                             str_to_datetime_v2("2022-10-01 00:00:00", "%Y-%m-%d %H:%i:%s")},
+                            {{std::string("2022-10-08 11:44:23"), std::string("week")}, Null()}};
+
+        for (const auto& line : data_set) {
+            DataSet const_unit_dataset = {line};
+            check_function<DataTypeDateTimeV2, true>(func_name, input_types, const_unit_dataset);
+        }
+    }
+}
+
+// the rows of the same date repeat in runs, which share the computed results
+TEST(VTimestampFunctionsTest, date_part_run_v2_test) {
+    {
+        InputTypeSet input_types = {TypeIndex::DateTimeV2};
+
+        DataSet data_set = {{{std::string("2020-02-29 01:00:00")}, 9},
+                            {{std::string("2020-02-29 23:00:00")}, 9},
+                            {{std::string("2020-00-01 01:00:00")}, Null()},
+                            {{std::string("2020-02-29 02:00:00")}, 9},
+                            {{std::string("2020-03-02 02:00:00")}, 10},
+                            {{std::string("2020-03-02 03:00:00")}, 10}};
+
+        check_function<DataTypeInt32, true>("weekofyear", input_types, data_set);
+    }
+
+    {
+        InputTypeSet input_types = {TypeIndex::DateTimeV2, TypeIndex::DateV2};
+
+        DataSet data_set = {
+                {{std::string("2019-07-18 01:00:00"), std::string("2019-07-17")}, 1},
+                {{std::string("2019-07-18 23:00:00"), std::string("2019-07-17")}, 1},
+                {{std::string("2019-07-18 23:00:00"), std::string("2019-07-00")}, Null()},
+                {{std::string("2019-07-19 00:00:00"), std::string("2019-07-17")}, 2},
+                {{std::string("2019-07-19 00:00:00"), std::string("2019-07-20")}, -1}};
+
+        check_function<DataTypeInt32, true>("datediff", input_types, data_set);
+    }
+
+    {
+        InputTypeSet input_types = {TypeIndex::DateV2, Consted {TypeIndex::DateV2}};
+
+        DataSet data_set = {{{std::string("2019-07-18"), std::string("2019-07-17")}, 1}};
+
+        check_function<DataTypeInt32, true>("datediff", input_types, data_set);
+    }
 }
 
 TEST(VTimestampFunctionsTest, hours_add_v2_test) {
@@ -1875,4 +1929,29 @@ TEST(VTimestampFunctionsTest, convert_tz_v2_test) {
     check_function<DataTypeDateTimeV2, true>(func_name, input_types, data_set);
 }
 
+// the rows around the transitions of a zone are converted with the offsets of their own
+TEST(VTimestampFunctionsTest, convert_tz_transition_v2_test) {
+    std::string func_name = "convert_tz";
+
+    InputTypeSet input_types = {TypeIndex::DateTimeV2, TypeIndex::String, TypeIndex::String};
+
+    DataSet data_set = {
+            {{DATETIME("2019-03-10 06:59:59"), STRING("UTC"), STRING("America/New_York")},
+             str_to_datetime_v2("2019-03-10 01:59:59", "%Y-%m-%d %H:%i:%s")},
+            {{DATETIME("2019-03-10 07:00:00"), STRING("UTC"), STRING("America/New_York")},
+             str_to_datetime_v2("2019-03-10 03:00:00", "%Y-%m-%d %H:%i:%s")},
+            {{DATETIME("2019-11-03 05:30:00"), STRING("UTC"), STRING("America/New_York")},
+             str_to_datetime_v2("2019-11-03 01:30:00", "%Y-%m-%d %H:%i:%s")},
+            {{DATETIME("2019-11-03 06:30:00"), STRING("UTC"), STRING("America/New_York")},
+             str_to_datetime_v2("2019-11-03 01:30:00", "%Y-%m-%d %H:%i:%s")},
+            {{DATETIME("2019-11-03 03:00:00"), STRING("America/New_York"), STRING("UTC")},
+             str_to_datetime_v2("2019-11-03 08:00:00", "%Y-%m-%d %H:%i:%s")},
+            {{DATETIME("2019-03-09 12:00:00"), STRING("America/New_York"), STRING("UTC")},
+             str_to_datetime_v2("2019-03-09 17:00:00", "%Y-%m-%d %H:%i:%s")},
+            {{DATETIME("2019-03-09 12:00:00"), STRING("Invalid/Zone"), STRING("UTC")}, Null()},
+            {{DATETIME("2019-03-09 12:00:00"), STRING("Invalid/Zone"), STRING("UTC")}, Null()}};
+
+    check_function<DataTypeDateTimeV2, true>(func_name, input_types, data_set);
+}
+
 } // namespace doris::vectorized
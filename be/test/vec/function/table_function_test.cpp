@@ -153,6 +153,47 @@ TEST_F(TableFunctionTest, vexplode) {
     }
 }
 
+TEST_F(TableFunctionTest, vexplode_rows) {
+    init_expr_context(1);
+    VExplodeTableFunction explode_outer;
+    explode_outer.set_outer();
+    explode_outer.set_vexpr_context(_ctx.get());
+
+    InputTypeSet input_types = {TypeIndex::Array, TypeIndex::Int32};
+    Array vec1 = {Int32(1), Null()};
+    Array vec2 = {Int32(2), Int32(3), Int32(4)};
+    InputDataSet input_set = {{vec1}, {Null()}, {vec2}, {Array()}, {vec1}};
+    std::unique_ptr<Block> input_block(create_block_from_inputset(input_types, input_set));
+    ASSERT_TRUE(input_block != nullptr);
+
+    InputTypeSet output_types = {TypeIndex::Int32};
+    InputDataSet output_set = {{Int32(1)}, {Null()}, {Null()}, {Int32(2)},
+                               {Int32(3)}, {Int32(4)}, {Null()}};
+    std::unique_ptr<Block> expect_block(create_block_from_inputset(output_types, output_set));
+    ASSERT_TRUE(expect_block != nullptr);
+    auto column = expect_block->get_by_position(0).type->create_column();
+    explode_outer.set_nullable();
+
+    ASSERT_TRUE(explode_outer.process_init(input_block.get()).ok());
+    ASSERT_TRUE(explode_outer.process_row(0).ok());
+    IColumn::Offsets result_ends;
+    // the last row does not fit in the results
+    EXPECT_EQ(4, explode_outer.get_values_of_rows(0, 5, 7, column, &result_ends));
+    EXPECT_TRUE(explode_outer.eos());
+    EXPECT_EQ((IColumn::Offsets {2, 3, 6, 7}), result_ends);
+    ASSERT_EQ(7, column->size());
+    for (size_t row = 0; row < column->size(); ++row) {
+        EXPECT_EQ(0, column->compare_at(row, row, *expect_block->get_by_position(0).column, 0));
+    }
+
+    // the first row does not fit either
+    ASSERT_TRUE(explode_outer.process_row(4).ok());
+    result_ends.clear();
+    EXPECT_EQ(0, explode_outer.get_values_of_rows(4, 5, 1, column, &result_ends));
+    EXPECT_FALSE(explode_outer.eos());
+    EXPECT_TRUE(explode_outer.process_close().ok());
+}
+
 TEST_F(TableFunctionTest, vexplode_numbers) {
     init_expr_context(1);
     VExplodeNumbersTableFunction tfn;
@@ -268,4 +268,59 @@ TEST(BlockSerializeTest, JsonbBlock) {
     std::cout << new_block.dump_data() << std::endl;
     EXPECT_EQ(block.dump_data(), new_block.dump_data());
 }
+TEST(BlockSerializeTest, Projection) {
+    vectorized::Block block;
+    TabletSchema schema;
+    std::vector<std::tuple<std::string, FieldType, int, PrimitiveType>> cols {
+            {"k1", OLAP_FIELD_TYPE_INT, 1, TYPE_INT},
+            {"k2", OLAP_FIELD_TYPE_STRING, 2, TYPE_STRING},
+            {"k3", OLAP_FIELD_TYPE_INT, 3, TYPE_INT}};
+    for (auto t : cols) {
+        TabletColumn c;
+        c.set_name(std::get<0>(t));
+        c.set_type(std::get<1>(t));
+        c.set_unique_id(std::get<2>(t));
+        schema.append_column(c);
+    }
+    vectorized::DataTypePtr int_type(std::make_shared<vectorized::DataTypeInt32>());
+    vectorized::DataTypePtr string_type(std::make_shared<vectorized::DataTypeString>());
+    auto k1 = vectorized::ColumnVector<Int32>::create();
+    auto k2 = vectorized::ColumnString::create();
+    auto k3 = vectorized::ColumnVector<Int32>::create();
+    for (int i = 0; i < 10; ++i) {
+        k1->get_data().push_back(i);
+        std::string is = std::to_string(i);
+        k2->insert_data(is.c_str(), is.size());
+        k3->get_data().push_back(i * 3);
+    }
+    block.insert({k1->get_ptr(), int_type, "k1"});
+    block.insert({k2->get_ptr(), string_type, "k2"});
+    block.insert({k3->get_ptr(), int_type, "k3"});
+    MutableColumnPtr col = ColumnString::create();
+    JsonbSerializeUtil::block_to_jsonb(schema, block, static_cast<ColumnString&>(*col.get()),
+                                       block.columns());
+
+    TupleDescriptor read_desc(PTupleDescriptor(), true);
+    for (auto t : cols) {
+        TSlotDescriptor tslot;
+        tslot.__set_colName(std::get<0>(t));
+        tslot.__set_slotType(TypeDescriptor(std::get<3>(t)).to_thrift());
+        tslot.__set_col_unique_id(std::get<2>(t));
+        read_desc.add_slot(new SlotDescriptor(tslot));
+    }
+    // decode k1 and k3 only
+    std::vector<int> col_uid_to_pos {-1, 0, -1, 2};
+    Block new_block = block.clone_empty();
+    for (size_t i = 0; i < col->size(); ++i) {
+        StringRef row = col->get_data_at(i);
+        JsonbSerializeUtil::jsonb_to_block(read_desc, row.data, row.size, col_uid_to_pos,
+                                           new_block);
+    }
+    EXPECT_EQ(10, new_block.rows());
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(i, new_block.get_by_position(0).column->get_int(i));
+        EXPECT_EQ("", new_block.get_by_position(1).column->get_data_at(i).to_string());
+        EXPECT_EQ(i * 3, new_block.get_by_position(2).column->get_int(i));
+    }
+}
 } // namespace doris::vectorized
@@ -417,6 +417,52 @@ TEST_F(VerticalCompactionTest, TestRowSourcesBuffer) {
     }
 }
 
+TEST_F(VerticalCompactionTest, TestRowSourcesBufferReader) {
+    std::vector<RowSource> tmp_row_source;
+    for (uint16_t i = 0; i < 6; ++i) {
+        tmp_row_source.emplace_back(i % 3, false);
+    }
+    auto read_all = [](RowSourcesBuffer* buffer, std::vector<uint16_t>* sources) {
+        while (buffer->has_remaining().ok()) {
+            sources->push_back(buffer->current().get_source_num());
+            buffer->advance();
+        }
+    };
+    auto origin_memory_mb = config::vertical_compaction_max_row_source_memory_mb;
+    // 0 spills the row sources into the file on every append
+    for (int32_t memory_mb : {origin_memory_mb, 0}) {
+        config::vertical_compaction_max_row_source_memory_mb = memory_mb;
+        RowSourcesBuffer buffer(102, absolute_dir, READER_BASE_COMPACTION);
+        EXPECT_TRUE(buffer.append(tmp_row_source).ok());
+        EXPECT_TRUE(buffer.append(tmp_row_source).ok());
+        EXPECT_TRUE(buffer.flush().ok());
+        EXPECT_TRUE(buffer.seek_to_begin().ok());
+
+        std::unique_ptr<RowSourcesBuffer> reader1;
+        std::unique_ptr<RowSourcesBuffer> reader2;
+        EXPECT_TRUE(buffer.create_reader(&reader1).ok());
+        EXPECT_TRUE(buffer.create_reader(&reader2).ok());
+        EXPECT_EQ(reader1->total_size(), 12);
+
+        // the readers and the buffer don't move the cursors of each other
+        std::vector<uint16_t> sources1;
+        EXPECT_TRUE(reader1->has_remaining().ok());
+        reader1->advance();
+        std::vector<uint16_t> sources2;
+        read_all(reader2.get(), &sources2);
+        read_all(reader1.get(), &sources1);
+        std::vector<uint16_t> sources;
+        read_all(&buffer, &sources);
+        EXPECT_EQ(sources.size(), 12);
+        for (size_t i = 0; i < sources.size(); ++i) {
+            EXPECT_EQ(sources[i], i % 3);
+        }
+        EXPECT_EQ(sources2, sources);
+        EXPECT_EQ(sources1, std::vector<uint16_t>(sources.begin() + 1, sources.end()));
+    }
+    config::vertical_compaction_max_row_source_memory_mb = origin_memory_mb;
+}
+
 TEST_F(VerticalCompactionTest, TestDupKeyVerticalMerge) {
     auto num_input_rowset = 2;
     auto num_segments = 2;
@@ -17,6 +17,7 @@
 
 #include <gtest/gtest.h>
 
+#include "agent/be_exec_version_manager.h"
 #include "common/object_pool.h"
 #include "gen_cpp/internal_service.pb.h"
 #include "google/protobuf/descriptor.h"
@@ -185,4 +186,116 @@ TEST_F(VDataStreamTest, BasicTest) {
     sender.close(&runtime_stat, exec_status);
     recv->close();
 }
+
+TEST_F(VDataStreamTest, LocalSharedBlockTest) {
+    doris::DescriptorTblBuilder builder(&_object_pool);
+    builder.declare_tuple() << doris::TYPE_INT;
+    doris::DescriptorTbl* desc_tbl = builder.build();
+    auto tuple_desc = const_cast<doris::TupleDescriptor*>(desc_tbl->get_tuple_descriptor(0));
+    doris::RowDescriptor row_desc(tuple_desc, false);
+
+    doris::RuntimeState runtime_stat(doris::TUniqueId(), doris::TQueryOptions(),
+                                     doris::TQueryGlobals(), nullptr);
+    runtime_stat.init_mem_trackers();
+    runtime_stat.set_desc_tbl(desc_tbl);
+    runtime_stat._exec_env = _object_pool.add(new ExecEnv);
+
+    TUniqueId uid;
+    RuntimeProfile profile("profile");
+    std::shared_ptr<QueryStatisticsRecvr> statistics = std::make_shared<QueryStatisticsRecvr>();
+    auto recv_1 = _instance.create_recvr(&runtime_stat, row_desc, uid, 1, 1, &profile, false,
+                                         statistics);
+    auto recv_2 = _instance.create_recvr(&runtime_stat, row_desc, uid, 2, 1, &profile, false,
+                                         statistics);
+
+    auto vec = vectorized::ColumnVector<Int32>::create();
+    for (int i = 0; i < 1024; ++i) {
+        vec->get_data().push_back(i);
+    }
+    vectorized::DataTypePtr data_type(std::make_shared<vectorized::DataTypeInt32>());
+    vectorized::Block block({{vec->get_ptr(), data_type, "test_int"}});
+
+    // a broadcast local block shares its columns with all the receivers
+    for (auto& recv : {recv_1, recv_2}) {
+        vectorized::Block shared_block(block.get_columns_with_type_and_name());
+        recv->add_block(&shared_block, 0, true);
+    }
+    const IColumn* shared_column = block.get_by_position(0).column.get();
+    block.clear();
+
+    bool eos = false;
+    Block block_1;
+    recv_1->get_next(&block_1, &eos);
+    EXPECT_EQ(1024, block_1.rows());
+    // the column is still shared by recv_2, so recv_1 gets a copy
+    EXPECT_NE(shared_column, block_1.get_by_position(0).column.get());
+    EXPECT_TRUE(block_1.get_by_position(0).column->is_exclusive());
+    std::move(*block_1.get_by_position(0).column).assume_mutable()->clear();
+
+    Block block_2;
+    recv_2->get_next(&block_2, &eos);
+    EXPECT_EQ(1024, block_2.rows());
+    // the last receiver takes the column without copy
+    EXPECT_EQ(shared_column, block_2.get_by_position(0).column.get());
+
+    recv_1->close();
+    recv_2->close();
+}
+TEST_F(VDataStreamTest, CoalescedBlocksTest) {
+    doris::DescriptorTblBuilder builder(&_object_pool);
+    builder.declare_tuple() << doris::TYPE_INT;
+    doris::DescriptorTbl* desc_tbl = builder.build();
+    auto tuple_desc = const_cast<doris::TupleDescriptor*>(desc_tbl->get_tuple_descriptor(0));
+    doris::RowDescriptor row_desc(tuple_desc, false);
+
+    doris::RuntimeState runtime_stat(doris::TUniqueId(), doris::TQueryOptions(),
+                                     doris::TQueryGlobals(), nullptr);
+    runtime_stat.init_mem_trackers();
+    runtime_stat.set_desc_tbl(desc_tbl);
+    runtime_stat._exec_env = _object_pool.add(new ExecEnv);
+
+    TUniqueId uid;
+    RuntimeProfile profile("profile");
+    std::shared_ptr<QueryStatisticsRecvr> statistics = std::make_shared<QueryStatisticsRecvr>();
+    auto recv = _instance.create_recvr(&runtime_stat, row_desc, uid, 1, 1, &profile, false,
+                                       statistics);
+
+    PTransmitDataParams request;
+    request.mutable_finst_id()->set_hi(uid.hi);
+    request.mutable_finst_id()->set_lo(uid.lo);
+    request.set_node_id(1);
+    request.set_sender_id(0);
+    request.set_be_number(1);
+    request.set_eos(true);
+    request.set_packet_seq(0);
+    for (int rows : {100, 200}) {
+        auto vec = vectorized::ColumnVector<Int32>::create();
+        for (int i = 0; i < rows; ++i) {
+            vec->get_data().push_back(i);
+        }
+        vectorized::DataTypePtr data_type(std::make_shared<vectorized::DataTypeInt32>());
+        vectorized::Block block({{vec->get_ptr(), data_type, "test_int"}});
+        size_t uncompressed_bytes = 0;
+        size_t compressed_bytes = 0;
+        EXPECT_TRUE(block.serialize(BeExecVersionManager::get_newest_version(),
+                                    request.add_blocks(), &uncompressed_bytes, &compressed_bytes,
+                                    segment_v2::CompressionTypePB::LZ4)
+                            .ok());
+    }
+    google::protobuf::Closure* done = nullptr;
+    EXPECT_TRUE(_instance.transmit_block(&request, &done).ok());
+
+    bool eos = false;
+    for (int rows : {100, 200}) {
+        Block block;
+        recv->get_next(&block, &eos);
+        EXPECT_FALSE(eos);
+        EXPECT_EQ(rows, block.rows());
+    }
+    Block block;
+    recv->get_next(&block, &eos);
+    EXPECT_TRUE(eos);
+    recv->close();
+}
+
 } // namespace doris::vectorized
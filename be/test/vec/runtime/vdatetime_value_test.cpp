@@ -268,6 +268,49 @@ TEST(VDateTimeValueTest, datetime_v2_from_date_format_str_test) {
     }
 }
 
+TEST(VDateTimeValueTest, from_canonical_date_str_test) {
+    {
+        std::string str = "2022-05-24";
+        DateV2Value<DateV2ValueType> date_v2;
+        EXPECT_TRUE(date_v2.from_date_str(str.data(), str.size()));
+        EXPECT_EQ(date_v2.year(), 2022);
+        EXPECT_EQ(date_v2.month(), 5);
+        EXPECT_EQ(date_v2.day(), 24);
+    }
+    {
+        std::string str = "2022-05-24 23:01:02.1234";
+        DateV2Value<DateTimeV2ValueType> datetime_v2;
+        EXPECT_TRUE(datetime_v2.from_date_str(str.data(), str.size(), 3));
+        EXPECT_EQ(datetime_v2.day(), 24);
+        EXPECT_EQ(datetime_v2.hour(), 23);
+        EXPECT_EQ(datetime_v2.minute(), 1);
+        EXPECT_EQ(datetime_v2.second(), 2);
+        EXPECT_EQ(datetime_v2.microsecond(), 123000);
+        EXPECT_TRUE(datetime_v2.from_date_str(str.data(), str.size(), -1));
+        EXPECT_EQ(datetime_v2.microsecond(), 123400);
+    }
+    {
+        std::string str = "2022-05-24 23:01:02";
+        VecDateTimeValue datetime;
+        EXPECT_TRUE(datetime.from_date_str(str.data(), str.size()));
+        EXPECT_EQ(datetime.type(), TIME_DATETIME);
+        EXPECT_EQ(datetime.hour(), 23);
+        str = "2022-05-24";
+        EXPECT_TRUE(datetime.from_date_str(str.data(), str.size()));
+        EXPECT_EQ(datetime.type(), TIME_DATE);
+        EXPECT_EQ(datetime.hour(), 0);
+    }
+    // the invalid values and the other formats go through the generic parser
+    for (std::string str : {"2022-02-30", "2022-05-24 24:00:00", "2022-05-24 23:01:02.",
+                            "2022-5-24", "20220524", " 2022-05-24", "2022/05/24 23:01:02"}) {
+        DateV2Value<DateTimeV2ValueType> datetime_v2;
+        VecDateTimeValue datetime;
+        bool valid = str != "2022-02-30" && str != "2022-05-24 24:00:00";
+        EXPECT_EQ(datetime_v2.from_date_str(str.data(), str.size()), valid) << str;
+        EXPECT_EQ(datetime.from_date_str(str.data(), str.size()), valid) << str;
+    }
+}
+
 TEST(VDateTimeValueTest, date_diff_test) {
     {
         DateV2Value<DateV2ValueType> date_v2_1;
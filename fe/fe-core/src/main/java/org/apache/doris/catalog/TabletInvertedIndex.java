@@ -118,7 +118,7 @@ public class TabletInvertedIndex {
         this.lock.unlockWrite(stamp);
     }
 
-    public void tabletReport(long backendId, Map<Long, TTablet> backendTablets,
+    public void tabletReport(long backendId, Map<Long, TTablet> backendTablets, boolean isIncrementalTablets,
                              final HashMap<Long, TStorageMedium> storageMediumMap,
                              ListMultimap<Long, Long> tabletSyncMap,
                              ListMultimap<Long, Long> tabletDeleteFromMeta,
@@ -300,9 +300,10 @@ public class TabletInvertedIndex {
                             if (backendTabletInfo.isSetVersionCount()) {
                                 replica.setVersionCount(backendTabletInfo.getVersionCount());
                             }
-                        } else {
+                        } else if (!isIncrementalTablets) {
                             // 2. (meta - be)
                             // may need delete from meta
+                            // an incremental report only has the changed tablets, so it finds none
                             LOG.debug("backend[{}] does not report tablet[{}-{}]", backendId, tabletId, tabletMeta);
                             synchronized (tabletDeleteFromMeta) {
                                 tabletDeleteFromMeta.put(tabletMeta.getDbId(), tabletId);
@@ -150,6 +150,7 @@ public class ReportHandler extends Daemon {
         Map<TTaskType, Set<Long>> tasks = null;
         Map<String, TDisk> disks = null;
         Map<Long, TTablet> tablets = null;
+        boolean isIncrementalTablets = false;
         long reportVersion = -1;
 
         ReportType reportType = ReportType.UNKNOWN;
@@ -174,12 +175,15 @@ public class ReportHandler extends Daemon {
             reportVersion = request.getReportVersion();
             reportType = ReportType.TABLET;
         }
+        if (tablets != null && request.isSetIsIncrementalTablets()) {
+            isIncrementalTablets = request.isIsIncrementalTablets();
+        }
 
         if (request.isSetTabletMaxCompactionScore()) {
             backend.setTabletMaxCompactionScore(request.getTabletMaxCompactionScore());
         }
 
-        ReportTask reportTask = new ReportTask(beId, tasks, disks, tablets, reportVersion,
+        ReportTask reportTask = new ReportTask(beId, tasks, disks, tablets, isIncrementalTablets, reportVersion,
                 request.getStoragePolicy(), request.getResource());
         try {
             putToQueue(reportTask);
@@ -226,6 +230,8 @@ public class ReportHandler extends Daemon {
         private Map<TTaskType, Set<Long>> tasks;
         private Map<String, TDisk> disks;
         private Map<Long, TTablet> tablets;
+        // the tablets are only the ones changed since the last full report
+        private boolean isIncrementalTablets;
         private long reportVersion;
 
         private List<TStoragePolicy> storagePolicies;
@@ -233,12 +239,13 @@ public class ReportHandler extends Daemon {
 
         public ReportTask(long beId, Map<TTaskType, Set<Long>> tasks,
                           Map<String, TDisk> disks,
-                          Map<Long, TTablet> tablets, long reportVersion,
+                          Map<Long, TTablet> tablets, boolean isIncrementalTablets, long reportVersion,
                           List<TStoragePolicy> storagePolicies, List<TStorageResource> storageResources) {
             this.beId = beId;
             this.tasks = tasks;
             this.disks = disks;
             this.tablets = tablets;
+            this.isIncrementalTablets = isIncrementalTablets;
             this.reportVersion = reportVersion;
             this.storagePolicies = storagePolicies;
             this.storageResources = storageResources;
@@ -262,7 +269,7 @@ public class ReportHandler extends Daemon {
                     LOG.warn("out of date report version {} from backend[{}]. current report version[{}]",
                             reportVersion, beId, backendReportVersion);
                 } else {
-                    ReportHandler.tabletReport(beId, tablets, reportVersion);
+                    ReportHandler.tabletReport(beId, tablets, isIncrementalTablets, reportVersion);
                 }
             }
         }
@@ -395,10 +402,11 @@ public class ReportHandler extends Daemon {
         }
     }
 
-    private static void tabletReport(long backendId, Map<Long, TTablet> backendTablets, long backendReportVersion) {
+    private static void tabletReport(long backendId, Map<Long, TTablet> backendTablets,
+            boolean isIncrementalTablets, long backendReportVersion) {
         long start = System.currentTimeMillis();
-        LOG.info("backend[{}] reports {} tablet(s). report version: {}",
-                backendId, backendTablets.size(), backendReportVersion);
+        LOG.info("backend[{}] reports {} tablet(s). incremental: {}. report version: {}",
+                backendId, backendTablets.size(), isIncrementalTablets, backendReportVersion);
 
         // storage medium map
         HashMap<Long, TStorageMedium> storageMediumMap = Config.disable_storage_medium_check
@@ -426,7 +434,8 @@ public class ReportHandler extends Daemon {
         List<CooldownConf> cooldownConfToUpdate = new LinkedList<>();
 
         // 1. do the diff. find out (intersection) / (be - meta) / (meta - be)
-        Env.getCurrentInvertedIndex().tabletReport(backendId, backendTablets, storageMediumMap,
+        Env.getCurrentInvertedIndex().tabletReport(backendId, backendTablets, isIncrementalTablets,
+                storageMediumMap,
                 tabletSyncMap,
                 tabletDeleteFromMeta,
                 tabletFoundInMeta,
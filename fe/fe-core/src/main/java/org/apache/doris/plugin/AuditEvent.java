@@ -88,6 +88,26 @@ public class AuditEvent {
     public String sqlHash = "";
     @AuditField(value = "peakMemoryBytes")
     public long peakMemoryBytes = -1;
+    @AuditField(value = "LocalBytesReadFromPageCache")
+    public long localBytesReadFromPageCache = -1;
+    @AuditField(value = "LocalBytesReadFromDisk")
+    public long localBytesReadFromDisk = -1;
+    @AuditField(value = "StoragePageCacheHits")
+    public long storagePageCacheHits = -1;
+    @AuditField(value = "StoragePageCacheMisses")
+    public long storagePageCacheMisses = -1;
+    @AuditField(value = "FileCacheHits")
+    public long fileCacheHits = -1;
+    @AuditField(value = "FileCacheMisses")
+    public long fileCacheMisses = -1;
+    @AuditField(value = "FileCacheBytesRead")
+    public long fileCacheBytesRead = -1;
+    @AuditField(value = "RemoteReadRequests")
+    public long remoteReadRequests = -1;
+    @AuditField(value = "RemoteBytesRead")
+    public long remoteBytesRead = -1;
+    @AuditField(value = "RemoteReadTimeMS")
+    public long remoteReadTimeMs = -1;
     @AuditField(value = "SqlDigest")
     public String sqlDigest = "";
     @AuditField(value = "TraceId")
@@ -166,6 +186,56 @@ public class AuditEvent {
             return this;
         }
 
+        public AuditEventBuilder setLocalBytesReadFromPageCache(long localBytesReadFromPageCache) {
+            auditEvent.localBytesReadFromPageCache = localBytesReadFromPageCache;
+            return this;
+        }
+
+        public AuditEventBuilder setLocalBytesReadFromDisk(long localBytesReadFromDisk) {
+            auditEvent.localBytesReadFromDisk = localBytesReadFromDisk;
+            return this;
+        }
+
+        public AuditEventBuilder setStoragePageCacheHits(long storagePageCacheHits) {
+            auditEvent.storagePageCacheHits = storagePageCacheHits;
+            return this;
+        }
+
+        public AuditEventBuilder setStoragePageCacheMisses(long storagePageCacheMisses) {
+            auditEvent.storagePageCacheMisses = storagePageCacheMisses;
+            return this;
+        }
+
+        public AuditEventBuilder setFileCacheHits(long fileCacheHits) {
+            auditEvent.fileCacheHits = fileCacheHits;
+            return this;
+        }
+
+        public AuditEventBuilder setFileCacheMisses(long fileCacheMisses) {
+            auditEvent.fileCacheMisses = fileCacheMisses;
+            return this;
+        }
+
+        public AuditEventBuilder setFileCacheBytesRead(long fileCacheBytesRead) {
+            auditEvent.fileCacheBytesRead = fileCacheBytesRead;
+            return this;
+        }
+
+        public AuditEventBuilder setRemoteReadRequests(long remoteReadRequests) {
+            auditEvent.remoteReadRequests = remoteReadRequests;
+            return this;
+        }
+
+        public AuditEventBuilder setRemoteBytesRead(long remoteBytesRead) {
+            auditEvent.remoteBytesRead = remoteBytesRead;
+            return this;
+        }
+
+        public AuditEventBuilder setRemoteReadTimeMs(long remoteReadTimeMs) {
+            auditEvent.remoteReadTimeMs = remoteReadTimeMs;
+            return this;
+        }
+
         public AuditEventBuilder setScanRows(long scanRows) {
             auditEvent.scanRows = scanRows;
             return this;
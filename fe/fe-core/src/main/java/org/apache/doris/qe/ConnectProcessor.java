@@ -260,6 +260,8 @@ public class ConnectProcessor {
         long endTime = System.currentTimeMillis();
         long elapseMs = endTime - ctx.getStartTime();
         SpanContext spanContext = Span.fromContext(Context.current()).getSpanContext();
+        Data.PQueryIOStatistics ioStatistics = statistics == null
+                ? Data.PQueryIOStatistics.getDefaultInstance() : statistics.getIoStatistics();
 
         ctx.getAuditEventBuilder().setEventType(EventType.AFTER_QUERY)
                 .setDb(ClusterNamespace.getNameFromFullName(ctx.getDatabase()))
@@ -272,6 +274,16 @@ public class ConnectProcessor {
                 .setScanRows(statistics == null ? 0 : statistics.getScanRows())
                 .setCpuTimeMs(statistics == null ? 0 : statistics.getCpuMs())
                 .setPeakMemoryBytes(statistics == null ? 0 : statistics.getMaxPeakMemoryBytes())
+                .setLocalBytesReadFromPageCache(ioStatistics.getLocalBytesReadFromPageCache())
+                .setLocalBytesReadFromDisk(ioStatistics.getLocalBytesReadFromDisk())
+                .setStoragePageCacheHits(ioStatistics.getStoragePageCacheHits())
+                .setStoragePageCacheMisses(ioStatistics.getStoragePageCacheMisses())
+                .setFileCacheHits(ioStatistics.getFileCacheHits())
+                .setFileCacheMisses(ioStatistics.getFileCacheMisses())
+                .setFileCacheBytesRead(ioStatistics.getFileCacheBytesRead())
+                .setRemoteReadRequests(ioStatistics.getRemoteReadRequests())
+                .setRemoteBytesRead(ioStatistics.getRemoteBytesRead())
+                .setRemoteReadTimeMs(ioStatistics.getRemoteReadNs() / 1000000)
                 .setReturnRows(ctx.getReturnRows())
                 .setStmtId(ctx.getStmtId())
                 .setQueryId(ctx.queryId() == null ? "NaN" : DebugUtil.printId(ctx.queryId()))
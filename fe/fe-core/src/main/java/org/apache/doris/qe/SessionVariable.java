@@ -275,6 +275,16 @@ public class SessionVariable implements Serializable, Writable {
 
     public static final String EXTERNAL_SORT_BYTES_THRESHOLD = "external_sort_bytes_threshold";
 
+    public static final String EXTERNAL_AGG_BYTES_THRESHOLD = "external_agg_bytes_threshold";
+
+    public static final String EXTERNAL_JOIN_BYTES_THRESHOLD = "external_join_bytes_threshold";
+
+    public static final String ENABLE_HARDWARE_COUNTERS = "enable_hardware_counters";
+
+    public static final String ENABLE_SCAN_CACHE = "enable_scan_cache";
+
+    public static final String ENABLE_CROSS_QUERY_SHARED_SCAN = "enable_cross_query_shared_scan";
+
     public static final String ENABLE_TWO_PHASE_READ_OPT = "enable_two_phase_read_opt";
     public static final String TOPN_OPT_LIMIT_THRESHOLD = "topn_opt_limit_threshold";
 
@@ -751,6 +761,35 @@ public class SessionVariable implements Serializable, Writable {
             checker = "checkExternalSortBytesThreshold", fuzzy = true)
     public long externalSortBytesThreshold = 0;
 
+    // If the memory consumption of agg node exceed this limit, will trigger spill to disk;
+    // Set to 0 to disable; min: 128M
+    public static final long MIN_EXTERNAL_AGG_BYTES_THRESHOLD = 134217728;
+    @VariableMgr.VarAttr(name = EXTERNAL_AGG_BYTES_THRESHOLD,
+            checker = "checkExternalAggBytesThreshold", fuzzy = true)
+    public long externalAggBytesThreshold = 0;
+
+    // If the build side of hash join exceed this limit, will trigger spill to disk;
+    // Set to 0 to disable; min: 128M
+    public static final long MIN_EXTERNAL_JOIN_BYTES_THRESHOLD = 134217728;
+    @VariableMgr.VarAttr(name = EXTERNAL_JOIN_BYTES_THRESHOLD,
+            checker = "checkExternalJoinBytesThreshold", fuzzy = true)
+    public long externalJoinBytesThreshold = 0;
+
+    // If true, the pipeline tasks count the cpu cycles, instructions, cache misses and branch misses
+    // with the hardware counters of the CPU, which are shown in the profile
+    @VariableMgr.VarAttr(name = ENABLE_HARDWARE_COUNTERS, needForward = true)
+    public boolean enableHardwareCounters = false;
+
+    // If true, the BE caches the output of the olap scans per tablet and version, so the repeated
+    // queries only scan the tablets changed since, e.g. the dashboards on append-only tables
+    @VariableMgr.VarAttr(name = ENABLE_SCAN_CACHE, needForward = true)
+    public boolean enableScanCache = false;
+
+    // If true, the olap scans of the concurrent queries on the same tablets share their reads,
+    // e.g. the dashboards refreshed at the same moment
+    @VariableMgr.VarAttr(name = ENABLE_CROSS_QUERY_SHARED_SCAN, needForward = true)
+    public boolean enableCrossQuerySharedScan = false;
+
     // Whether enable two phase read optimization
     // 1. read related rowids along with necessary column data
     // 2. spawn fetch RPC to other nodes to get related data by sorted rowids
@@ -813,15 +852,23 @@ public class SessionVariable implements Serializable, Writable {
         switch (randomInt) {
             case 0:
                 this.externalSortBytesThreshold = 0;
+                this.externalAggBytesThreshold = 0;
+                this.externalJoinBytesThreshold = 0;
                 break;
             case 1:
                 this.externalSortBytesThreshold = 1;
+                this.externalAggBytesThreshold = 1;
+                this.externalJoinBytesThreshold = 1;
                 break;
             case 2:
                 this.externalSortBytesThreshold = 1024 * 1024;
+                this.externalAggBytesThreshold = 1024 * 1024;
+                this.externalJoinBytesThreshold = 1024 * 1024;
                 break;
             default:
                 this.externalSortBytesThreshold = 100 * 1024 * 1024 * 1024;
+                this.externalAggBytesThreshold = 100 * 1024 * 1024 * 1024;
+                this.externalJoinBytesThreshold = 100 * 1024 * 1024 * 1024;
                 break;
         }
         // pull_request_id default value is 0
@@ -1584,6 +1631,22 @@ public class SessionVariable implements Serializable, Writable {
         }
     }
 
+    public void checkExternalAggBytesThreshold(String externalAggBytesThreshold) {
+        long value = Long.valueOf(externalAggBytesThreshold);
+        if (value > 0 && value < MIN_EXTERNAL_AGG_BYTES_THRESHOLD) {
+            LOG.warn("external agg bytes threshold: {}, min: {}", value, MIN_EXTERNAL_AGG_BYTES_THRESHOLD);
+            throw new UnsupportedOperationException("minimum value is " + MIN_EXTERNAL_AGG_BYTES_THRESHOLD);
+        }
+    }
+
+    public void checkExternalJoinBytesThreshold(String externalJoinBytesThreshold) {
+        long value = Long.valueOf(externalJoinBytesThreshold);
+        if (value > 0 && value < MIN_EXTERNAL_JOIN_BYTES_THRESHOLD) {
+            LOG.warn("external join bytes threshold: {}, min: {}", value, MIN_EXTERNAL_JOIN_BYTES_THRESHOLD);
+            throw new UnsupportedOperationException("minimum value is " + MIN_EXTERNAL_JOIN_BYTES_THRESHOLD);
+        }
+    }
+
     public boolean isEnableFileCache() {
         return enableFileCache;
     }
@@ -1673,6 +1736,15 @@ public class SessionVariable implements Serializable, Writable {
 
         tResult.setExternalSortBytesThreshold(externalSortBytesThreshold);
 
+        tResult.setExternalAggBytesThreshold(externalAggBytesThreshold);
+
+        tResult.setExternalJoinBytesThreshold(externalJoinBytesThreshold);
+
+        tResult.setEnableHardwareCounters(enableHardwareCounters);
+
+        tResult.setEnableScanCache(enableScanCache);
+        tResult.setEnableCrossQuerySharedScan(enableCrossQuerySharedScan);
+
         tResult.setEnableFileCache(enableFileCache);
 
         if (dryRunQuery) {
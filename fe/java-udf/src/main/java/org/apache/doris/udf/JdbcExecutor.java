@@ -1144,6 +1144,22 @@ public class JdbcExecutor {
         }
     }
 
+    // The bytes of the strings are copied into the chars of the column directly, without being
+    // gathered into one java array first.
+    private void copyStringsToColumn(byte[][] byteRes, int[] offsets, int numRows, long offsetsAddr,
+            long charsAddr) {
+        long bytesAddr = JNINativeMethod.resizeStringColumn(charsAddr, offsets[numRows - 1]);
+        int start = 0;
+        for (int i = 0; i < numRows; i++) {
+            int length = offsets[i] - start;
+            if (length > 0) {
+                UdfUtils.copyMemory(byteRes[i], UdfUtils.BYTE_ARRAY_OFFSET, null, bytesAddr + start, length);
+            }
+            start = offsets[i];
+        }
+        UdfUtils.copyMemory(offsets, UdfUtils.INT_ARRAY_OFFSET, null, offsetsAddr, numRows * 4L);
+    }
+
     private void objectPutToString(Object[] column, boolean isNullable, int numRows, long nullMapAddr,
             long offsetsAddr, long charsAddr) {
         int[] offsets = new int[numRows];
@@ -1169,16 +1185,7 @@ public class JdbcExecutor {
                 offsets[i] = offset;
             }
         }
-        byte[] bytes = new byte[offsets[numRows - 1]];
-        long bytesAddr = JNINativeMethod.resizeStringColumn(charsAddr, offsets[numRows - 1]);
-        int dst = 0;
-        for (int i = 0; i < numRows; i++) {
-            for (int j = 0; j < byteRes[i].length; j++) {
-                bytes[dst++] = byteRes[i][j];
-            }
-        }
-        UdfUtils.copyMemory(offsets, UdfUtils.INT_ARRAY_OFFSET, null, offsetsAddr, numRows * 4L);
-        UdfUtils.copyMemory(bytes, UdfUtils.BYTE_ARRAY_OFFSET, null, bytesAddr, offsets[numRows - 1]);
+        copyStringsToColumn(byteRes, offsets, numRows, offsetsAddr, charsAddr);
     }
 
     private void stringPutToString(Object[] column, boolean isNullable, int numRows, long nullMapAddr,
@@ -1204,16 +1211,7 @@ public class JdbcExecutor {
                 offsets[i] = offset;
             }
         }
-        byte[] bytes = new byte[offsets[numRows - 1]];
-        long bytesAddr = JNINativeMethod.resizeStringColumn(charsAddr, offsets[numRows - 1]);
-        int dst = 0;
-        for (int i = 0; i < numRows; i++) {
-            for (int j = 0; j < byteRes[i].length; j++) {
-                bytes[dst++] = byteRes[i][j];
-            }
-        }
-        UdfUtils.copyMemory(offsets, UdfUtils.INT_ARRAY_OFFSET, null, offsetsAddr, numRows * 4L);
-        UdfUtils.copyMemory(bytes, UdfUtils.BYTE_ARRAY_OFFSET, null, bytesAddr, offsets[numRows - 1]);
+        copyStringsToColumn(byteRes, offsets, numRows, offsetsAddr, charsAddr);
     }
 
     public void copyBatchStringResult(Object columnObj, boolean isNullable, int numRows, long nullMapAddr,
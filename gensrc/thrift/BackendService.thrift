@@ -104,6 +104,8 @@ struct TStreamLoadRecord {
     17: required i64 start_time
     18: required i64 finish_time
     19: optional string comment
+    // the json of the time of writing the tablets, see "LoadProfile" of the stream load response
+    20: optional string load_profile
 }
 
 struct TStreamLoadRecordResult {
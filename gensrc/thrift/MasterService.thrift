@@ -101,6 +101,9 @@ struct TReportRequest {
     8: optional i64 tablet_max_compaction_score
     9: optional list<AgentService.TStoragePolicy> storage_policy // only id and version
     10: optional list<AgentService.TStorageResource> resource // only id and version
+    // the tablets are only the ones changed since the last full tablet report,
+    // so the tablets not reported are not dropped
+    11: optional bool is_incremental_tablets
 }
 
 struct TMasterResult {
@@ -209,6 +209,25 @@ struct TQueryOptions {
   66: optional i32 parallel_instance = 1
   // Indicate where useServerPrepStmts enabled
   67: optional bool mysql_row_binary_format = false;
+
+  // If the memory consumption of aggregation node exceed this limit, will spill the
+  // hash table to disk partitions; 0 means disabled
+  68: optional i64 external_agg_bytes_threshold = 0
+
+  // If the build side of hash join exceed this limit, both sides will be hash
+  // partitioned to disk and joined partition by partition; 0 means disabled
+  69: optional i64 external_join_bytes_threshold = 0
+
+  // If true, the pipeline tasks read the hardware counters of the CPU into the profile
+  70: optional bool enable_hardware_counters = false
+
+  // If true, the olap scanners cache their output blocks per tablet and version, and the
+  // scanners of the same scan with the same tablet and version read them from the cache
+  71: optional bool enable_scan_cache = false
+
+  // If true, an olap scanner reading the same rows as a scanner of another query in progress
+  // takes the blocks of that one from where it is, and reads the rows it missed afterwards
+  72: optional bool enable_cross_query_shared_scan = false
 }
     
 
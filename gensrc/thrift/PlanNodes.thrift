@@ -57,6 +57,8 @@ enum TPlanNodeType {
   FILE_SCAN_NODE,
   JDBC_SCAN_NODE,
   TEST_EXTERNAL_SCAN_NODE,
+  // a join of the inputs sorted on the keys, described by hash_join_node
+  MERGE_JOIN_NODE,
 }
 
 // phases of an execution node
@@ -348,6 +350,8 @@ struct TFileRangeDesc {
     7: optional list<string> columns_from_path_keys;
     // For data lake table format
     8: optional TTableFormatFileDesc table_format_params
+    // modification time of the file, in milliseconds, 0 or unset means unknown
+    9: optional i64 modification_time
 }
 
 // TFileScanRange represents a set of descriptions of a file and the rules for reading and converting it.